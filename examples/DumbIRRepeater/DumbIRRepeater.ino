@@ -110,18 +110,14 @@ void loop() {
   if (irrecv.decode(&results)) {  // We have captured something.
     // The capture has stopped at this point.
 
-    // Convert the results into an array suitable for sendRaw().
-    // resultToRawArray() allocates the memory we need for the array.
-    uint16_t *raw_array = resultToRawArray(&results);
-    // Find out how many elements are in the array.
-    uint16_t length = getCorrectedRawLength(&results);
-    // Send it out via the IR LED circuit.
-    irsend.sendRaw(raw_array, length, kFrequency);
+    // Find out how many entries the message has, excluding rawbuf[0].
+    uint16_t length = results.rawlen - 1;
+    // Send it out via the IR LED circuit, straight from the capture buffer.
+    // i.e. No memory needs to be allocated to convert it for sendRaw().
+    irsend.sendRawTicks(results.rawbuf + 1, length, kFrequency, kRawTick);
     // Resume capturing IR messages. It was not restarted until after we sent
     // the message so we didn't capture our own message.
     irrecv.resume();
-    // Deallocate the memory allocated by resultToRawArray().
-    delete [] raw_array;
 
     // Display a crude timestamp & notification.
     uint32_t now = millis();
@@ -0,0 +1,263 @@
+/* IRremoteESP8266: IRBenchmark - Time the library on the device itself.
+ * Copyright 2026 The IRremoteESP8266 authors
+ *
+ * Runs a built-in corpus of messages through the decoders, the senders, the
+ * IRac class & the output formatters, & reports how many CPU cycles each
+ * operation took. Host benchmarks (e.g. tools/decode_bench) can't show what
+ * the flash cache, the lack of an FPU, or the cost of `micros()` do to them.
+ * It also checks how accurately `mark()` generates the carrier.
+ *
+ * The results are printed to the Serial port as comma separated lines, so
+ * runs on different boards, core versions & library releases can be
+ * compared. e.g. Capture it with `pio device monitor > board.csv`.
+ *   INFO,<key>,<value>
+ *     About the board, its core, & the library.
+ *   BENCH,<group>,<name>,<ops>,<cycles per op>,<uSeconds per op>
+ *     group: decode, send, irac, format, or overhead.
+ *   MARK,<requested uSeconds>,<actual uSeconds>,<expected pulses>,<pulses>
+ *     The carrier accuracy of `mark()`.
+ *   WARN,<group>,<name>,<message>
+ *     Something didn't work as it should have. e.g. A message didn't decode.
+ *   DONE
+ *
+ * Nothing needs to be connected to it. Only the carrier accuracy test uses
+ * the IR LED's GPIO (kIrLed), everything else is sent in a dry run. i.e. It is
+ * recorded rather than sent.
+ *
+ * Version 1.0 October, 2026
+ */
+
+#include <Arduino.h>
+#include <IRac.h>
+#include <IRrecv.h>
+#include <IRremoteESP8266.h>
+#include <IRsend.h>
+#include <IRutils.h>
+
+// ==================== start of TUNEABLE PARAMETERS ====================
+// The GPIO an IR LED is, or could be, connected to. e.g. D2 on a NodeMCU.
+const uint16_t kIrLed = 4;
+// The Serial connection baud rate.
+const uint32_t kBaudRate = 115200;
+// Nr. of times each operation is timed. The average is reported.
+const uint16_t kIterations = 20;
+// The largest message in the corpus. (Nr. of marks & spaces)
+const uint16_t kCaptureBufferSize = 1024;
+// The simple protocols in the corpus, if they are enabled.
+struct simple_code_t {
+  decode_type_t protocol;
+  uint64_t value;
+};
+const simple_code_t kSimpleCodes[] = {
+    {decode_type_t::NEC, 0x20DF10EF},
+    {decode_type_t::SONY, 0xA90},
+    {decode_type_t::RC5, 0x175},
+    {decode_type_t::RC6, 0x1000C},
+    {decode_type_t::SAMSUNG, 0xE0E040BF},
+    {decode_type_t::PANASONIC, 0x40040100BCBD},
+    {decode_type_t::JVC, 0xC2D0},
+    {decode_type_t::LG, 0x88C0051},
+    {decode_type_t::SHARP, 0x454A},
+};
+// The A/C protocols in the corpus, if they are enabled.
+const decode_type_t kAcProtocols[] = {
+    decode_type_t::COOLIX,
+    decode_type_t::DAIKIN,
+    decode_type_t::FUJITSU_AC,
+    decode_type_t::GREE,
+    decode_type_t::MITSUBISHI_AC,
+    decode_type_t::PANASONIC_AC,
+    decode_type_t::SAMSUNG_AC,
+    decode_type_t::TOSHIBA_AC,
+};
+// The carrier accuracy test. (uSeconds)
+const uint16_t kMarks[] = {100, 560, 1690, 4500, 9000};
+// ==================== end of TUNEABLE PARAMETERS ====================
+
+// A message of the corpus, as it would be captured.
+struct corpus_entry_t {
+  decode_type_t protocol;
+  uint16_t *rawbuf;  // kRawTick units, starting with the gap before it.
+  uint16_t rawlen;
+};
+const uint16_t kCorpusSize = (sizeof(kSimpleCodes) / sizeof(kSimpleCodes[0]) +
+                              sizeof(kAcProtocols) / sizeof(kAcProtocols[0]));
+corpus_entry_t corpus[kCorpusSize];
+uint16_t corpus_length = 0;
+
+IRsend irsend(kIrLed);
+IRac irac(kIrLed);
+IRdecoder decoder;
+IRsequence recording(kCaptureBufferSize);
+
+// The state of an A/C, for the IRac tests.
+stdAc::state_t acState(const decode_type_t protocol) {
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = protocol;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 24;
+  state.fanspeed = stdAc::fanspeed_t::kAuto;
+  return state;
+}
+
+// Add what was just recorded to the corpus.
+void addToCorpus(const decode_type_t protocol) {
+  uint16_t length = recording.length();
+  // A capture doesn't have the trailing gap.
+  if (length && length % 2 == 0) length--;
+  if (recording.overflowed() || !length || corpus_length >= kCorpusSize) {
+    Serial.println("WARN,corpus," + typeToString(protocol) + ",Too long");
+    return;
+  }
+  corpus_entry_t *entry = &corpus[corpus_length++];
+  entry->protocol = protocol;
+  entry->rawlen = length + 1;
+  entry->rawbuf = new uint16_t[entry->rawlen];
+  entry->rawbuf[0] = kDefaultMessageGap / kRawTick;
+  for (uint16_t i = 0; i < length; i++)
+    entry->rawbuf[i + 1] = recording.durations()[i] / kRawTick;
+}
+
+// Build the corpus, by recording what each protocol sends.
+void buildCorpus(void) {
+  for (const simple_code_t &code : kSimpleCodes) {
+    irsend.startRecording(&recording);
+    const bool sent = irsend.send(code.protocol, code.value,
+                                  IRsend::defaultBits(code.protocol));
+    if (irsend.stopRecording() && sent) addToCorpus(code.protocol);
+  }
+  for (const decode_type_t protocol : kAcProtocols) {
+    if (!IRac::isProtocolSupported(protocol)) continue;
+    IRsend::startRecordingAll(&recording);
+    const bool sent = irac.sendAc(acState(protocol));
+    if (IRsend::stopRecordingAll() && sent) addToCorpus(protocol);
+  }
+}
+
+// Report the timing of an operation.
+void report(const char *group, const String &name, const uint32_t ops,
+            const uint32_t cycles, const uint32_t usecs) {
+  Serial.println(String("BENCH,") + group + ',' + name + ',' + String(ops) +
+                 ',' + String(ops ? cycles / ops : 0) + ',' +
+                 String(ops ? usecs / ops : 0));
+}
+
+// Time some code. i.e. Run it kIterations times, & report the average.
+#define BENCH(group, name, code) do { \
+    const uint32_t usecs = micros(); \
+    const uint32_t cycles = ESP.getCycleCount(); \
+    for (uint16_t i = 0; i < kIterations; i++) { code; } \
+    const uint32_t elapsed = ESP.getCycleCount() - cycles; \
+    report(group, name, kIterations, elapsed, micros() - usecs); \
+    yield(); \
+  } while (0)
+
+void benchOverhead(void) {
+  volatile uint32_t sink;
+  BENCH("overhead", "micros", sink = micros());
+  BENCH("overhead", "getCycleCount", sink = ESP.getCycleCount());
+  (void)sink;
+}
+
+void benchDecode(void) {
+  decode_results results;
+  for (uint16_t n = 0; n < corpus_length; n++) {
+    const corpus_entry_t &entry = corpus[n];
+    const String name = typeToString(entry.protocol);
+    BENCH("decode", name,
+          decoder.decode(&results, entry.rawbuf, entry.rawlen));
+    if (results.decode_type != entry.protocol)
+      Serial.println("WARN,decode," + name + ",Decoded as " +
+                     typeToString(results.decode_type));
+  }
+}
+
+void benchSend(void) {
+  for (const simple_code_t &code : kSimpleCodes) {
+    if (!IRsend::defaultBits(code.protocol)) continue;
+    irsend.startRecording(&recording);  // A dry run.
+    BENCH("send", typeToString(code.protocol),
+          irsend.send(code.protocol, code.value,
+                      IRsend::defaultBits(code.protocol)));
+    irsend.stopRecording();
+  }
+}
+
+void benchIRac(void) {
+  for (const decode_type_t protocol : kAcProtocols) {
+    if (!IRac::isProtocolSupported(protocol)) continue;
+    const stdAc::state_t state = acState(protocol);
+    IRsend::startRecordingAll(&recording);  // A dry run.
+    BENCH("irac", typeToString(protocol), irac.sendAc(state));
+    IRsend::stopRecordingAll();
+  }
+}
+
+void benchFormat(void) {
+  decode_results results;
+  char json[256];
+  for (uint16_t n = 0; n < corpus_length; n++) {
+    const corpus_entry_t &entry = corpus[n];
+    if (!decoder.decode(&results, entry.rawbuf, entry.rawlen)) continue;
+    const String name = typeToString(entry.protocol);
+    BENCH("format", name + ":resultToSourceCode",
+          resultToSourceCode(&results));
+    BENCH("format", name + ":resultToHumanReadableBasic",
+          resultToHumanReadableBasic(&results));
+    BENCH("format", name + ":resultToJson",
+          resultToJson(&results, json, sizeof(json)));
+    BENCH("format", name + ":resultToPronto", resultToPronto(&results));
+    if (hasACState(results.decode_type))
+      BENCH("format", name + ":resultAcToString",
+            IRAcUtils::resultAcToString(&results));
+  }
+}
+
+// How long `mark()` actually takes, & how many carrier pulses it sends.
+void checkMarks(void) {
+  const uint32_t hz = 38000;
+  irsend.enableIROut(hz);
+  for (const uint16_t usecs : kMarks) {
+    const uint32_t start = micros();
+    const uint16_t pulses = irsend.mark(usecs);
+    const uint32_t elapsed = micros() - start;
+    irsend.space(0);
+    Serial.println("MARK," + String(usecs) + ',' + String(elapsed) + ',' +
+                   String((uint32_t)((uint64_t)usecs * hz / 1000000)) + ',' +
+                   String(pulses));
+    yield();
+  }
+}
+
+void setup() {
+  irsend.begin();
+  Serial.begin(kBaudRate, SERIAL_8N1);
+  while (!Serial)  // Wait for the serial connection to be establised.
+    delay(50);
+  delay(500);  // Let the other end catch up.
+  Serial.println();
+  Serial.println("INFO,library," _IRREMOTEESP8266_VERSION_);
+#if defined(ESP8266)
+  Serial.println("INFO,board,ESP8266");
+  Serial.println("INFO,core," + ESP.getCoreVersion());
+#elif defined(ESP32)
+  Serial.println("INFO,board,ESP32");
+#endif  // ESP8266
+  Serial.println(String("INFO,sdk,") + ESP.getSdkVersion());
+  Serial.println("INFO,cpu_mhz," + String(ESP.getCpuFreqMHz()));
+  Serial.println("INFO,iterations," + String(kIterations));
+  buildCorpus();
+  Serial.println("INFO,corpus," + String(corpus_length));
+  Serial.println("INFO,free_heap," + String(ESP.getFreeHeap()));
+  benchOverhead();
+  benchDecode();
+  benchSend();
+  benchIRac();
+  benchFormat();
+  checkMarks();
+  Serial.println("DONE");
+}
+
+void loop() {}
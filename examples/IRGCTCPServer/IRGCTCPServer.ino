@@ -1,7 +1,7 @@
 /*
  * IRremoteESP8266: IRGCTCPServer - send Global Cache-formatted codes via TCP.
  * An IR emitter must be connected to GPIO pin 4.
- * Version 0.2  May, 2017
+ * Version 0.3  2026
  * Copyright 2016 Hisham Khalifa, http://www.hishamkhalifa.com
  * Copyright 2017 David Conran
  *
@@ -33,8 +33,27 @@
  *   or:
  *     <control> + <d> might work.
  *
+ * It also understands the iTach (Global Cache) TCP API commands, so iTach
+ * compatible controllers & apps can use it. e.g.
+ *   sendir,1:1,<id>,<frequency>,<repeat>,<offset>,<on>,<off>,...
+ *     Replies "completeir,1:1,<id>" once it has actually been sent.
+ *   stopir,1:1     Stop sending the current message, & drop any queued ones.
+ *   getdevices     List the modules & connectors.
+ *   getversion     Report the firmware version.
+ * Several clients can be connected at once, & each can send commands without
+ * waiting for the previous ones to finish. They are queued, & sent in turn.
+ * Each frame of a repeated message is sent separately, so `stopir` (& other
+ * clients) only wait for the current frame to end.
+ *
  * This program will display the ESP's IP address on the serial console, or you
  * can check your wifi router for it's address.
+ *
+ * Changes:
+ *   Version 0.3: 2026
+ *     - Support several clients at once, iTach's `sendir`, `stopir` etc, a
+ *       queue of messages to send, & parse commands as they arrive.
+ *   Version 0.2: May, 2017
+ *     - Send straight from the text of the message.
  */
 
 #include <Arduino.h>
@@ -48,56 +67,358 @@
 #include <IRsend.h>
 #include <WiFiClient.h>
 #include <WiFiServer.h>
+#include <algorithm>
 
 const char* kSsid = "...";  // Put your WIFI SSID here.
 const char* kPassword = "...";  // Put your WIFI Password here.
 
-WiFiServer server(4998);  // Uses port 4998.
-WiFiClient client;
+const uint16_t kPort = 4998;  // The Global Cache/iTach TCP port.
+const uint8_t kMaxClients = 4;  // Nr. of clients that can connect at once.
+const uint8_t kQueueSize = 4;  // Nr. of messages that can wait to be sent.
+const uint16_t kMaxPulses = 512;  // Most on/off values a message can have.
+const uint8_t kMaxCommandLength = 12;  // e.g. "getdevices"
+const uint8_t kModule = 1;  // The module:connector of the IR LED.
+const uint8_t kConnector = 1;
+const uint32_t kMinFrequency = 15000;  // Hz
+const uint32_t kMaxFrequency = 500000;  // Hz
+const uint8_t kMaxRepeat = 50;
+const uint32_t kMinUsecs = 80;  // Shortest mark or space sent.
+const char* kVersion = "IRremoteESP8266-" _IRREMOTEESP8266_VERSION_;
+
+// Fields of a command line. The ':' between the module & connector counts as
+// a separator too. e.g. sendir,1:1,<id>,<frequency>,<repeat>,<offset>,...
+enum gc_field_t {
+  kFieldCommand = 0,
+  kFieldModule,
+  kFieldConnector,
+  kFieldId,
+  kFieldFrequency,  // Where a bare Global Cache code starts.
+  kFieldRepeat,
+  kFieldOffset,
+  kFieldPulses,  // The first of the on/off values.
+};
+
+// iTach error codes.
+const uint8_t kErrCommand = 1;  // Unknown command.
+const uint8_t kErrModule = 2;
+const uint8_t kErrConnector = 3;
+const uint8_t kErrId = 4;
+const uint8_t kErrFrequency = 5;
+const uint8_t kErrRepeat = 6;
+const uint8_t kErrOffset = 7;
+const uint8_t kErrPulses = 8;  // Too many, too few, or out of range.
+const uint8_t kErrOddPulses = 9;  // An odd nr. of on/off values.
+const uint8_t kErrBusy = 255;  // The queue is full. Reported as "busyIR".
+
+// A message to send.
+typedef struct {
+  bool used;
+  bool ready;  // Completely received, & waiting to be sent.
+  bool reply;  // Send "completeir" when done? i.e. Not a bare GC code.
+  uint8_t client;  // Which connection it came from.
+  uint32_t order;  // Earlier messages are sent first.
+  uint16_t id;
+  uint32_t frequency;
+  uint8_t repeat;
+  uint16_t offset;
+  uint16_t count;  // Nr. of on/off values.
+  uint16_t pulses[kMaxPulses];  // In periods of the carrier.
+} gc_message_t;
+
+// A client, & where it is up to in the command it is sending.
+typedef struct {
+  WiFiClient client;
+  uint8_t field;  // Which field is arriving. See gc_field_t.
+  uint32_t value;  // The number arriving.
+  bool digits;  // Has the number got any digits yet?
+  char command[kMaxCommandLength + 1];
+  uint8_t length;  // Of `command`.
+  int8_t message;  // Which queue entry a sendir is arriving in. -1 for none.
+  uint8_t error;  // The first error in the command. 0 for none.
+  uint16_t id;
+} gc_connection_t;
+
+WiFiServer server(kPort);
+gc_connection_t connections[kMaxClients];
+gc_message_t queue[kQueueSize];
+uint32_t queueOrder = 0;  // The order of the next message queued.
+int8_t sending = -1;  // The queue entry being sent. -1 for none.
+uint8_t framesSent = 0;  // Nr. of frames of it sent so far.
+bool stopRequested = false;
 
-uint16_t *code_array;
 #define IR_LED 4  // ESP8266 GPIO pin to use. Recommended: 4 (D2).
 
 IRsend irsend(IR_LED);  // Set the GPIO to be used to sending the message.
 
-void sendGCString(String str) {
-  int16_t index;
-  uint16_t count;
-
-  // Find out how many items there are in the string.
-  index = -1;
-  count = 1;
-  do {
-    index = str.indexOf(',', index + 1);
-    count++;
-  } while (index != -1);
-
-  // Now we know how many there are, allocate the memory to store them all.
-  code_array = reinterpret_cast<uint16_t*>(malloc(count * sizeof(uint16_t)));
-  // Check we malloc'ed successfully.
-  if (code_array == NULL) {  // malloc failed, so give up.
-    Serial.printf("\nCan't allocate %d bytes. (%d bytes free)\n",
-                  count * sizeof(uint16_t), ESP.getFreeHeap());
-    Serial.println("Giving up & forcing a reboot.");
-    ESP.restart();  // Reboot.
-    delay(500);  // Wait for the restart to happen.
-    return;  // Should never get here, but just in case.
+// Send a reply to a client, if it is still connected.
+void reply(const uint8_t client, const String str) {
+  if (connections[client].client.connected())
+    connections[client].client.print(str + '\r');
+}
+
+String connectorStr(void) {
+  return String(kModule) + ':' + String(kConnector);
+}
+
+// Report an error in a command to the client that sent it.
+void replyError(const uint8_t client, const uint8_t error, const uint16_t id) {
+  if (error == kErrBusy) {
+    reply(client, "busyIR," + connectorStr() + ',' + String(id));
+  } else {
+    char code[4];
+    snprintf(code, sizeof(code), "%03u", error);
+    reply(client, "ERR_" + connectorStr() + ',' + code);
+  }
+}
+
+// Start a fresh command on a connection.
+void resetCommand(gc_connection_t *conn) {
+  conn->field = kFieldCommand;
+  conn->value = 0;
+  conn->digits = false;
+  conn->length = 0;
+  conn->command[0] = '\0';
+  conn->message = -1;
+  conn->error = 0;
+  conn->id = 0;
+}
+
+// Find an unused queue entry.
+// Returns:
+//   The index of it, or -1 if the queue is full.
+int8_t allocMessage(const uint8_t client) {
+  for (uint8_t i = 0; i < kQueueSize; i++)
+    if (!queue[i].used) {
+      queue[i].used = true;
+      queue[i].ready = false;
+      queue[i].reply = true;
+      queue[i].client = client;
+      queue[i].count = 0;
+      queue[i].id = 0;
+      queue[i].offset = 1;
+      return i;
+    }
+  return -1;
+}
+
+// Flag the first error of a command. It is reported when the line ends.
+void setError(gc_connection_t *conn, const uint8_t error) {
+  if (!conn->error) conn->error = error;
+  if (conn->message >= 0) {  // Don't keep a message that won't be sent.
+    queue[conn->message].used = false;
+    conn->message = -1;
+  }
+}
+
+// A field of a command has arrived in full. Check & store it.
+void endField(const uint8_t client) {
+  gc_connection_t *conn = &connections[client];
+  const uint8_t field = conn->field++;
+  const uint32_t value = conn->value;
+  const bool digits = conn->digits;
+  conn->value = 0;
+  conn->digits = false;
+  if (field == kFieldId && digits && value <= UINT16_MAX)
+    conn->id = value;  // Even for a bad command. e.g. For "busyIR".
+  if (conn->error) return;  // Ignore the rest of a bad command.
+  switch (field) {
+    case kFieldCommand:
+      if (!strcmp(conn->command, "sendir")) {
+        conn->message = allocMessage(client);
+        if (conn->message < 0) setError(conn, kErrBusy);
+      }
+      return;
+    case kFieldModule:
+      if (!digits || value != kModule) setError(conn, kErrModule);
+      return;
+    case kFieldConnector:
+      if (!digits || value != kConnector) setError(conn, kErrConnector);
+      return;
+  }
+  if (conn->message < 0) return;  // Only sendir has more fields.
+  gc_message_t *message = &queue[conn->message];
+  switch (field) {
+    case kFieldId:
+      if (!digits || value > UINT16_MAX)
+        setError(conn, kErrId);
+      else
+        message->id = value;
+      break;
+    case kFieldFrequency:
+      if (value < kMinFrequency || value > kMaxFrequency)
+        setError(conn, kErrFrequency);
+      else
+        message->frequency = value;
+      break;
+    case kFieldRepeat:
+      if (value < 1 || value > kMaxRepeat)
+        setError(conn, kErrRepeat);
+      else
+        message->repeat = value;
+      break;
+    case kFieldOffset:
+      if (value < 1 || !(value & 1))
+        setError(conn, kErrOffset);
+      else
+        message->offset = value;
+      break;
+    default:  // The on/off values.
+      if (value < 1 || value > UINT16_MAX || message->count >= kMaxPulses)
+        setError(conn, kErrPulses);
+      else
+        message->pulses[message->count++] = value;
+  }
+}
+
+// A command line has arrived in full. Act on it, & start afresh.
+void endLine(const uint8_t client) {
+  gc_connection_t *conn = &connections[client];
+  endField(client);
+  if (conn->field == 1 && !conn->length && !conn->digits) {  // Empty line.
+    resetCommand(conn);
+    return;
+  }
+  if (!conn->error && conn->message >= 0) {
+    gc_message_t *message = &queue[conn->message];
+    if (conn->field <= kFieldPulses)
+      setError(conn, kErrPulses);
+    else if (message->count < 2)
+      setError(conn, kErrPulses);
+    else if (message->count & 1)
+      setError(conn, kErrOddPulses);
+    else if (message->offset > message->count)
+      setError(conn, kErrOffset);
+    if (!conn->error) {
+      message->order = queueOrder++;
+      message->ready = true;  // It can be sent now.
+      conn->message = -1;
+    }
+  } else if (!conn->error) {
+    if (!strcmp(conn->command, "stopir")) {
+      if (conn->field <= kFieldConnector) {
+        setError(conn, kErrConnector);
+      } else {
+        // Drop everything queued, & stop what is being sent after this frame.
+        for (uint8_t i = 0; i < kQueueSize; i++)
+          if (queue[i].ready && i != sending) queue[i].used = false;
+        stopRequested = (sending >= 0);
+        reply(client, "stopir," + connectorStr());
+      }
+    } else if (!strcmp(conn->command, "getdevices")) {
+      reply(client, "device,0,0 ETHERNET");
+      reply(client, "device," + String(kModule) + ",1 IR");
+      reply(client, "endlistdevices");
+    } else if (!strcmp(conn->command, "getversion")) {
+      reply(client, kVersion);
+    } else {
+      setError(conn, kErrCommand);
+    }
+  }
+  if (conn->error) replyError(client, conn->error, conn->id);
+  resetCommand(conn);
+}
+
+// Process the next character a client sent. i.e. Commands are tokenised as
+// they arrive, rather than buffered up first.
+void tokenise(const uint8_t client, const char c) {
+  gc_connection_t *conn = &connections[client];
+  switch (c) {
+    case '\r':
+    case '\n':
+      endLine(client);
+      return;
+    case ',':
+    case ':':
+      endField(client);
+      return;
   }
+  if (conn->field == kFieldCommand) {
+    if (isdigit(c) && !conn->length) {  // A bare Global Cache code.
+      conn->message = allocMessage(client);
+      if (conn->message < 0)
+        setError(conn, kErrBusy);
+      else
+        queue[conn->message].reply = false;
+      conn->field = kFieldFrequency;
+    } else {
+      if (conn->length < kMaxCommandLength) {
+        conn->command[conn->length++] = c;
+        conn->command[conn->length] = '\0';
+      } else {
+        setError(conn, kErrCommand);
+      }
+      return;
+    }
+  }
+  if (isdigit(c)) {
+    // Anything this large is out of range anyway. So just don't overflow.
+    if (conn->value < 100000000) conn->value = conn->value * 10 + (c - '0');
+    conn->digits = true;
+  } else if (c != ' ') {
+    setError(conn, kErrPulses);
+  }
+}
 
-  // Now convert the strings to integers and place them in code_array.
-  count = 0;
-  uint16_t start_from = 0;
-  do {
-    index = str.indexOf(',', start_from);
-    code_array[count] = str.substring(start_from, index).toInt();
-    start_from = index + 1;
-    count++;
-  } while (index != -1);
-
-#if SEND_GLOBALCACHE
-  irsend.sendGC(code_array, count);  // All done. Send it.
-#endif  // SEND_GLOBALCACHE
-  free(code_array);  // Free up the memory allocated.
+// Send one frame of a message. i.e. The whole thing the first time, & just
+// from its offset for each repeat.
+void sendFrame(const gc_message_t *message, const uint8_t frame) {
+  const uint32_t period = (1000000UL + message->frequency / 2) /
+      message->frequency;
+  irsend.enableIROut(message->frequency);
+  for (uint16_t i = frame ? message->offset - 1 : 0; i < message->count; i++) {
+    const uint32_t usecs = std::max(message->pulses[i] * period, kMinUsecs);
+    if (i & 1)
+      irsend.space(usecs);
+    else
+      irsend.mark(std::min(usecs, (uint32_t)UINT16_MAX));
+  }
+}
+
+// Send the next frame of the queued messages, if there is one.
+void handleSending(void) {
+  if (sending < 0) {  // Start on the earliest message queued.
+    for (uint8_t i = 0; i < kQueueSize; i++)
+      if (queue[i].used && queue[i].ready &&
+          (sending < 0 || queue[i].order < queue[sending].order))
+        sending = i;
+    if (sending < 0) return;  // Nothing to send.
+    framesSent = 0;
+    stopRequested = false;
+  }
+  gc_message_t *message = &queue[sending];
+  if (!stopRequested) sendFrame(message, framesSent++);
+  if (stopRequested || framesSent >= message->repeat) {
+    // It's been sent. i.e. Not just queued for sending.
+    if (!stopRequested && message->reply)
+      reply(message->client,
+            "completeir," + connectorStr() + ',' + String(message->id));
+    message->used = false;
+    sending = -1;
+  }
+}
+
+// Accept any new clients, & read what the connected ones have sent.
+void handleClients(void) {
+  while (server.hasClient()) {
+    uint8_t i = 0;
+    while (i < kMaxClients && connections[i].client.connected()) i++;
+    if (i < kMaxClients) {
+      connections[i].client = server.available();
+      resetCommand(&connections[i]);
+      Serial.println("Client connected: " +
+                     connections[i].client.remoteIP().toString());
+    } else {
+      server.available().stop();  // No room for it.
+    }
+  }
+  for (uint8_t i = 0; i < kMaxClients; i++) {
+    gc_connection_t *conn = &connections[i];
+    if (!conn->client.connected()) {
+      if (conn->message >= 0) setError(conn, kErrCommand);  // Unfinished.
+      continue;
+    }
+    while (conn->client.available()) tokenise(i, conn->client.read());
+  }
 }
 
 void setup() {
@@ -115,22 +436,12 @@ void setup() {
   server.begin();
   IPAddress myAddress = WiFi.localIP();
   Serial.println(myAddress.toString());
+  for (uint8_t i = 0; i < kMaxClients; i++) resetCommand(&connections[i]);
   irsend.begin();
 }
 
 void loop() {
-  while (!client)
-    client = server.available();
-
-  while (!client.connected()) {
-    delay(900);
-    client = server.available();
-  }
-
-  if (client.available()) {
-    String ir_code_str = client.readStringUntil('\r');  // Exclusive of \r
-    client.readStringUntil('\n');  // Skip new line as well
-    client.flush();
-    sendGCString(ir_code_str);
-  }
+  handleClients();
+  handleSending();
+  yield();
 }
@@ -20,6 +20,7 @@
 #include <IRtimer.h>
 #include <IRutils.h>
 #include <IRac.h>
+#include "web_assets.h"
 
 // ---------------- Start of User Configuration Section ------------------------
 
@@ -112,6 +113,17 @@ const IPAddress kSubnetMask = IPAddress(255, 255, 255, 0);
                                     // Note: OTA & GPIO updates are always
                                     //       passworded.
 // If you do not set a password, Firmware OTA & GPIO updates will be blocked.
+#define METRICS_ENABLE true  // Serve IR & system metrics, for Prometheus etc.
+                             // `false` to disable and save some program space.
+// Push what changes (climate states, & IR messages received) to the open web
+// pages over a WebSocket, rather than have them reload. Only their small,
+// static script is fetched from the device (once, as browsers cache it), so
+// more dashboards don't mean more pages to render.
+// Requires the "WebSockets" library by Markus Sattler. See platformio.ini.
+#ifndef WEBSOCKET_ENABLE
+#define WEBSOCKET_ENABLE false
+#endif  // WEBSOCKET_ENABLE
+const uint16_t kWebSocketPort = 81;  // The TCP port the WebSocket is on.
 
 // ----------------------- MQTT Related Settings -------------------------------
 #if MQTT_ENABLE
@@ -181,11 +193,15 @@ const uint8_t kCaptureTimeout = 50;  // Milliseconds
 // Suits most messages, while not swallowing many repeats.
 const uint8_t kCaptureTimeout = 15;  // Milliseconds
 #endif  // DECODE_AC
+#if ENABLE_BUDGETED_DECODE
+// The most time to spend decoding per loop(), so WiFi & the web server don't
+// stutter. A capture that takes longer is decoded over several loops.
+const uint32_t kDecodeBudget = 5000;  // uSeconds
+#endif  // ENABLE_BUDGETED_DECODE
 // Ignore unknown messages with <10 pulses (see also REPORT_UNKNOWNS)
 const uint16_t kMinUnknownSize = 2 * 10;
 #define REPORT_UNKNOWNS false  // Report inbound IR messages that we don't know.
-#define REPORT_RAW_UNKNOWNS false  // Report the whole buffer, recommended:
-                                   // MQTT_MAX_PACKET_SIZE of 1024 or more
+#define REPORT_RAW_UNKNOWNS false  // Report the whole buffer.
 
 // Should we use and report individual A/C settings we capture via IR if we
 // can understand the individual settings of the remote.
@@ -218,6 +234,47 @@ const uint16_t kMinUnknownSize = 2 * 10;
 // Note: Turning on the feature costs ~250 bytes of prog space.
 #define REPORT_VCC false  // Do we report Vcc via html info page & MQTT?
 
+// Save the climate (A/C) state of each channel to flash, and restore it at
+// boot. The states are then known straight away, without waiting for the MQTT
+// broker to return any retained ones. They are saved as a small binary file
+// with a CRC, rather than as JSON. To limit wear on the flash, a change is only
+// saved once things have been stable for `kClimateSaveDelayMs`.
+// Note: Costs ~1k of program space.
+#define CLIMATE_STATE_SAVE_ENABLE true
+
+// Share the air with other IRMQTTServers (nodes) whose IR LEDs reach the same
+// devices. e.g. Several in an open-plan office. Messages sent by two of them
+// at the same time collide, & repeating them blindly only wastes air time.
+// With it, each IR message is queued, & sent in this node's own time slot (if
+// `kAirtimeSlotMs` is set), clear of the times the other nodes have reserved
+// via the shared `MQTT_AIRTIME` topic. The nodes' clocks are set via NTP.
+// See `IRairtime` for how it works.
+// Note: Each node needs its own `kAirtimeNode`. Reservations need MQTT.
+#ifndef AIRTIME_ENABLE
+#define AIRTIME_ENABLE false
+#endif  // AIRTIME_ENABLE
+#if AIRTIME_ENABLE
+const uint8_t kAirtimeNode = 0;  // This node. 0 to `kAirtimeNodes` - 1.
+const uint8_t kAirtimeNodes = 1;  // Nr. of nodes sharing the air.
+const uint32_t kAirtimeSlotMs = 0;  // Length of each node's slot. 0 for none.
+#define MQTT_AIRTIME "ir_server/airtime"  // The topic all the nodes share.
+#define AIRTIME_NTP_SERVER "pool.ntp.org"
+const uint32_t kAirtimeSyncMs = 60 * 1000;  // How often to read the clock.
+const uint16_t kAirtimeFrameSize = 1024;  // Max. marks & spaces per message.
+// A time (seconds since the Unix epoch) the clock is past, once NTP set it.
+const uint32_t kAirtimeValidTime = 1600000000;
+#endif  // AIRTIME_ENABLE
+
+// Let the nodes learn simple (pulse-distance) protocols over MQTT, without new
+// firmware. Publish (retained) a protocol's `ircustom::add()` values, less its
+// name, to `MQTT_PROTOCOLS`/<name>. e.g.
+//   ir_server/protocols/GARAGE: "24,6000,3000,500,1500,500,500,500,30000"
+// An empty (retained) message removes it. Until then, it is sent & decoded like
+// the built-in protocols, via its number (1000 onwards) or name.
+#if MQTT_ENABLE && ENABLE_CUSTOM_PROTOCOLS
+#define MQTT_PROTOCOLS "ir_server/protocols"  // The topic all the nodes share.
+#endif  // MQTT_ENABLE && ENABLE_CUSTOM_PROTOCOLS
+
 // Keywords for MQTT topics, html arguments, or config file.
 #define KEY_PROTOCOL "protocol"
 #define KEY_MODEL "model"
@@ -281,6 +338,54 @@ const uint16_t kJsonAcStateMaxSize = 1024;  // Bytes
 const uint8_t kRebootTime = 15;  // Seconds
 const uint8_t kQuickDisplayTime = 2;  // Seconds
 
+// The climate stat topics, in the order they are published.
+// See `sendClimateField()`.
+enum climate_field_t {
+  kClimateProtocol = 0,
+  kClimateModel,
+  kClimatePower,
+  kClimateMode,
+  kClimateTemp,
+  kClimateCelsius,
+  kClimateFanspeed,
+  kClimateSwingv,
+  kClimateSwingh,
+  kClimateQuiet,
+  kClimateTurbo,
+  kClimateEcono,
+  kClimateLight,
+  kClimateFilter,
+  kClimateClean,
+  kClimateBeep,
+  kClimateSleep,  // The last of the fields of a climate state.
+#if REPORT_VCC
+  kClimateVcc,
+#endif  // REPORT_VCC
+#if MQTT_CLIMATE_JSON
+  kClimateJson,
+#endif  // MQTT_CLIMATE_JSON
+  kClimateFieldCount
+};
+// Web pages are sent in chunks of about this size, rather than all at once.
+const uint16_t kHtmlChunkSize = 1024;  // Bytes
+#if METRICS_ENABLE
+// Upper bounds of the buckets of the `/metrics` histograms. (uSeconds)
+const uint8_t kMetricsBuckets = 8;
+const uint32_t kLoopTimeBounds[kMetricsBuckets] = {
+    1000, 2000, 5000, 10000, 20000, 50000, 100000, 500000};
+const uint32_t kDecodeTimeBounds[kMetricsBuckets] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000};
+const uint32_t kSendTimeBounds[kMetricsBuckets] = {
+    10000, 25000, 50000, 100000, 200000, 500000, 1000000, 2000000};
+const uint32_t kSendJitterBounds[kMetricsBuckets] = {
+    2, 5, 10, 20, 50, 100, 200, 500};
+typedef struct {
+  const uint32_t *bounds;  // i.e. One of the above.
+  uint32_t counts[kMetricsBuckets + 1];  // The last is for everything larger.
+  uint64_t sum;  // uSeconds
+} metrics_histogram_t;
+#endif  // METRICS_ENABLE
+
 // Common bit sizes for the simple protocols.
 const uint8_t kCommonBitSizes[] = {
     12, 13, 15, 16, 20, 24, 28, 32, 35, 36, 42, 48, 56, 64};
@@ -299,6 +404,16 @@ const int8_t kRxGpios[] = {
     25, 26, 27, 32, 33, 34, 35, 36, 39};
 #endif  // ESP32
 
+#if CLIMATE_STATE_SAVE_ENABLE
+// Name of the binary climate state file. See `saveClimateStates()`.
+const char* kClimateStateFile = "/climate.bin";
+// Nr. of channels, each channel's state, then a CRC-16.
+const uint16_t kClimateStateFileSize =
+    1 + kNrOfIrTxGpios * kIRacStateBinaryLength + 2;
+// How long a climate state must be unchanged for before it is saved.
+const uint32_t kClimateSaveDelayMs = 10 * 1000;  // mSeconds
+#endif  // CLIMATE_STATE_SAVE_ENABLE
+
 // JSON stuff
 // Name of the json config file in SPIFFS.
 const char* kConfigFile = "/config.json";
@@ -321,16 +436,28 @@ const char* kUrlExamples = "/examples";
 const char* kUrlGpio = "/gpio";
 const char* kUrlGpioSet = "/gpio/set";
 const char* kUrlInfo = "/info";
+#if METRICS_ENABLE
+const char* kUrlMetrics = "/metrics";
+#endif  // METRICS_ENABLE
 const char* kUrlReboot = "/quitquitquit";
 const char* kUrlWipe = "/reset";
 const char* kUrlClearMqtt = "/clear_retained";
+#if WEBSOCKET_ENABLE
+const char* kUrlLiveJs = "/live.js";
+// Big enough for any WebSocket message. See `webSocketClimateMsg()`.
+const uint16_t kWebSocketMsgSize = kIRacStateJsonSize;
+#endif  // WEBSOCKET_ENABLE
 
 #if MQTT_ENABLE
 const uint32_t kBroadcastPeriodMs = MQTTbroadcastInterval * 1000;  // mSeconds.
 // How long should we listen to recover for previous states?
 // Default is 5 seconds per IR TX GPIOs (channels) used.
 const uint32_t kStatListenPeriodMs = 5 * 1000 * kNrOfIrTxGpios;  // mSeconds
+// Max. nr. of climate stat topics published per `loop()` by a broadcast.
+const uint8_t kBroadcastBudget = 8;
 const int32_t kMaxPauseMs = 10000;  // 10 Seconds.
+// Nr. of MQTT commands that can wait to be sent. See `handleMqttCommands()`.
+const uint8_t kMqttCommandQueueSize = 8;
 const char* kSequenceDelimiter = ";";
 const char kPauseChar = 'P';
 #if defined(ESP8266)
@@ -354,6 +481,97 @@ const char* kMqttTopics[] = {
     KEY_SWINGV, KEY_SWINGH, KEY_QUIET, KEY_TURBO, KEY_LIGHT, KEY_BEEP,
     KEY_ECONO, KEY_SLEEP, KEY_FILTER, KEY_CLEAN, KEY_CELSIUS, KEY_RESEND,
     KEY_JSON};  // KEY_JSON needs to be the last one.
+// The index of each of `kMqttTopics`.
+enum mqtt_climate_key_t {
+  kMqttKeyProtocol = 0,
+  kMqttKeyModel,
+  kMqttKeyPower,
+  kMqttKeyMode,
+  kMqttKeyTemp,
+  kMqttKeyFanspeed,
+  kMqttKeySwingv,
+  kMqttKeySwingh,
+  kMqttKeyQuiet,
+  kMqttKeyTurbo,
+  kMqttKeyLight,
+  kMqttKeyBeep,
+  kMqttKeyEcono,
+  kMqttKeySleep,
+  kMqttKeyFilter,
+  kMqttKeyClean,
+  kMqttKeyCelsius,
+  kMqttKeyResend,
+  kMqttKeyJson,
+  kMqttKeyCount
+};
+
+// What a topic we are subscribed to is for. See `buildMqttTopicTable()`.
+enum mqtt_topic_kind_t {
+  kMqttTopicNone = 0,  // Not one of ours. Also an empty slot of the table.
+  kMqttTopicSend,  // IR commands. e.g. ".../send_1"
+  kMqttTopicClimateCmnd,  // Climate commands. e.g. ".../ac_1/cmnd/power"
+  kMqttTopicClimateStat,  // Climate states. e.g. ".../ac_1/stat/power"
+};
+
+// A topic we are subscribed to, in the hashed table of them.
+typedef struct {
+  uint32_t hash;  // Of the topic. See `mqttTopicHash()`.
+  uint16_t text;  // Where the topic itself is in `mqttTopicText`.
+  uint8_t kind;  // A `mqtt_topic_kind_t`.
+  uint8_t channel;  // The transmit channel it is for.
+  uint8_t key;  // A `mqtt_climate_key_t`, for the climate topics.
+} mqtt_topic_t;
+
+// An MQTT command waiting to be sent.
+typedef struct {
+  mqtt_topic_t topic;  // What it was received on.
+  String payload;  // What is still to be done of it. e.g. Of a sequence.
+} mqtt_command_t;
+
+// How many chars of the last IR message received are kept for the web pages.
+const uint16_t kLastIrReceivedMaxLen = 128;
+
+// A `Print` stream that only counts what is printed to it, & optionally keeps
+// the first `kLastIrReceivedMaxLen` chars of it. i.e. To size an MQTT message
+// before it is streamed out, without having to store all of it.
+class PrintSizer : public Print {
+ public:
+  explicit PrintSizer(String *summary = NULL) : _summary(summary), _size(0) {}
+  size_t write(uint8_t c) {
+    if (_summary != NULL && _size < kLastIrReceivedMaxLen)
+      *_summary += static_cast<char>(c);
+    _size++;
+    return 1;
+  }
+  size_t size(void) const { return _size; }
+
+ private:
+  String *_summary;
+  size_t _size;
+};
+
+// A `Print` stream that collects what is printed to it in a small, fixed
+// size, buffer, & passes it on to another stream each time it fills up.
+// i.e. So many small prints don't each become a separate network write.
+class BufferedPrint : public Print {
+ public:
+  explicit BufferedPrint(Print *output) : _output(output), _length(0) {}
+  ~BufferedPrint(void) { sendBuffer(); }
+  size_t write(uint8_t c) {
+    if (_length >= sizeof(_buffer)) sendBuffer();
+    _buffer[_length++] = c;
+    return 1;
+  }
+  void sendBuffer(void) {
+    if (_length) _output->write(_buffer, _length);
+    _length = 0;
+  }
+
+ private:
+  Print *_output;
+  uint8_t _buffer[128];
+  size_t _length;
+};
 
 
 void mqttCallback(char* topic, byte* payload, unsigned int length);
@@ -364,15 +582,26 @@ void unsubscribing(const String topic_name);
 void mqttLog(const char* str);
 bool mountSpiffs(void);
 bool reconnect(void);
-void receivingMQTT(String const topic_name, String const callback_str);
+uint32_t mqttTopicHash(const char *topic);
+void addMqttTopic(const String topic, const mqtt_topic_kind_t kind,
+                  const uint8_t channel, const uint8_t key = 0);
+void buildMqttTopicTable(void);
+const mqtt_topic_t *mqttTopicLookup(const char *topic);
+void receivingMQTT(const char *topic, String const callback_str);
+bool handleMqttCommands(void);
+String doMqttCommand(const mqtt_topic_t topic, String const callback_str);
 void callback(char* topic, byte* payload, unsigned int length);
 void sendMQTTDiscovery(const char *topic);
+void printTemplate(Print *output, PGM_P tmpl, const char * const values[],
+                   const uint8_t nr_of_values);
+void printIrReceived(Print *output, const decode_results * const results);
 void doBroadcast(TimerMs *timer, const uint32_t interval,
                  IRac *climates[], const bool retain,
                  const bool force);
+void sendBroadcast(IRac *climates[], const uint8_t budget);
 #if MQTT_CLIMATE_JSON
 stdAc::state_t jsonToState(const stdAc::state_t current, const char *str);
-void sendJsonState(const stdAc::state_t state, const String topic,
+void sendJsonState(stdAc::state_t state, const String topic,
                    const bool retain = false,
                    const bool ha_mode = MQTT_CLIMATE_HA_MODE);
 #endif  // MQTT_CLIMATE_JSON
@@ -396,6 +625,11 @@ int8_t getDefaultTxGpio(void);
 String genStatTopic(const uint16_t channel = 0);
 String listOfTxGpios(void);
 bool hasUnsafeHTMLChars(String input);
+void htmlBegin(const char *content_type = "text/html");
+void htmlSend(const String &html);
+void htmlSend(const __FlashStringHelper *html);
+void htmlFlush(void);
+void htmlFinish(const bool close_html = true);
 String htmlHeader(const String title, const String h1_text = "");
 String htmlEnd(void);
 String htmlButton(const String url, const String button,
@@ -405,19 +639,38 @@ void handleRoot(void);
 String addJsReloadUrl(const String url, const uint16_t timeout_s,
                       const bool notify);
 void handleExamples(void);
-String htmlSelectBool(const String name, const bool def);
-String htmlSelectClimateProtocol(const String name, const decode_type_t def);
-String htmlSelectAcStateProtocol(const String name, const decode_type_t def,
-                                 const bool simple);
-String htmlSelectModel(const String name, const int16_t def);
-String htmlSelectMode(const String name, const stdAc::opmode_t def);
-String htmlSelectFanspeed(const String name, const stdAc::fanspeed_t def);
-String htmlSelectSwingv(const String name, const stdAc::swingv_t def);
-String htmlSelectSwingh(const String name, const stdAc::swingh_t def);
+void htmlOptionItem(const String value, const String text, bool selected);
+void htmlSelectBool(const String name, const bool def);
+void htmlSelectClimateProtocol(const String name, const decode_type_t def);
+void htmlSelectAcStateProtocol(const String name, const decode_type_t def,
+                               const bool simple);
+void htmlSelectModel(const String name, const int16_t def);
+void htmlSelectUint(const String name, const uint16_t max,
+                    const uint16_t def);
+void htmlSelectGpio(const String name, const int16_t def,
+                    const int8_t list[], const int16_t length);
+void htmlSelectMode(const String name, const stdAc::opmode_t def);
+void htmlSelectFanspeed(const String name, const stdAc::fanspeed_t def);
+void htmlSelectSwingv(const String name, const stdAc::swingv_t def);
+void htmlSelectSwingh(const String name, const stdAc::swingh_t def);
 void handleAirCon(void);
 void handleAirConSet(void);
 void handleAdmin(void);
 void handleInfo(void);
+#if METRICS_ENABLE
+void metricsObserve(metrics_histogram_t *histogram, const uint32_t usecs);
+String usecsToSeconds(const uint64_t usecs);
+void metricsHeader(const String name, const String type, const String help);
+void metricsValue(const String name, const String type, const String help,
+                  const uint64_t value);
+void metricsHistogram(const String name, const String help,
+                      const metrics_histogram_t *histogram);
+#if IR_RX && ENABLE_DECODE_PROFILING
+void metricsDecodeProfile(const String name, const String help,
+                          uint32_t decode_profile_t::*stat, const bool usecs);
+#endif  // IR_RX && ENABLE_DECODE_PROFILING
+void handleMetrics(void);
+#endif  // METRICS_ENABLE
 void handleReset(void);
 void handleReboot(void);
 bool parseStringAndSendAirCon(IRsend *irsend, const decode_type_t irType,
@@ -451,9 +704,45 @@ bool sendString(const String topic, const String str, const bool retain);
 bool sendFloat(const String topic, const float_t temp, const bool retain);
 void updateClimate(stdAc::state_t *current, const String str,
                    const String prefix, const String payload);
+void updateClimateKey(stdAc::state_t *state, const uint8_t key,
+                      const String payload);
 bool cmpClimate(const stdAc::state_t a, const stdAc::state_t b);
+bool climateFieldChanged(const uint8_t field, const stdAc::state_t a,
+                         const stdAc::state_t b);
+bool sendClimateField(const String topic_prefix, const uint8_t field,
+                      const stdAc::state_t state, const bool retain);
 bool sendClimate(const String topic_prefix, const bool retain,
                  const bool forceMQTT, const bool forceIR,
                  const bool enableIR = true, IRac *ac = NULL);
 bool decodeCommonAc(const decode_results *decode);
+#if AIRTIME_ENABLE
+void airtimeRecord(void);
+bool airtimeQueue(IRsend *irsend);
+IRsend *airtimeIrSend(const IRac *ac);
+void airtimeLoop(void);
+#if MQTT_ENABLE
+void airtimeReceived(const char *payload);
+#endif  // MQTT_ENABLE
+#endif  // AIRTIME_ENABLE
+#ifdef MQTT_PROTOCOLS
+void customProtocolReceived(const char *name, const char *values);
+#endif  // MQTT_PROTOCOLS
+void handleWebAsset(const web_asset_t *asset);
+#if WEBSOCKET_ENABLE
+String htmlLiveScript(void);
+void webSocketAddField(irutils::JsonWriter *json, const uint8_t field,
+                       const stdAc::state_t state);
+uint16_t webSocketClimateMsg(const uint16_t channel, const stdAc::state_t prev,
+                             const stdAc::state_t next, const bool full,
+                             char *msg, const uint16_t size);
+void webSocketPushClimate(void);
+#if IR_RX
+void webSocketPushIr(void);
+#endif  // IR_RX
+#endif  // WEBSOCKET_ENABLE
+#if CLIMATE_STATE_SAVE_ENABLE
+uint16_t crc16(const uint8_t *data, const uint16_t length);
+bool saveClimateStates(void);
+uint8_t loadClimateStates(void);
+#endif  // CLIMATE_STATE_SAVE_ENABLE
 #endif  // EXAMPLES_IRMQTTSERVER_IRMQTTSERVER_H_
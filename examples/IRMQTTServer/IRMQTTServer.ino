@@ -32,11 +32,10 @@
  * - Arduino IDE:
  *   o Install the following libraries via Library Manager
  *     - ArduinoJson (https://arduinojson.org/) (Version >= 6.0)
- *     - PubSubClient (https://pubsubclient.knolleary.net/)
+ *     - PubSubClient (https://pubsubclient.knolleary.net/) (Version >= 2.7)
  *     - WiFiManager (https://github.com/tzapu/WiFiManager)
  *                   (ESP8266: Version >= 0.14, ESP32: 'development' branch.)
  *   o You MUST change <PubSubClient.h> to have the following (or larger) value:
- *     (with REPORT_RAW_UNKNOWNS 1024 or more is recommended)
  *     #define MQTT_MAX_PACKET_SIZE 768
  *   o Use the smallest non-zero FILESYSTEM size you can for your board.
  *     (See the Tools -> Flash Size menu)
@@ -63,6 +62,8 @@
  * instructions there to send IR codes via HTTP/HTML.
  * Visit the http://<your_esp's_ip_address>/gpio page to configure the GPIOs
  * for the IR LED(s) and/or IR RX demodulator.
+ * Metrics on the IR receive & send pipelines, the heap, etc. are available in
+ * the Prometheus text format at http://<your_esp's_ip_address>/metrics
  *
  * You can send URLs like the following, with similar data type limitations as
  * the MQTT formating in the next section. e.g:
@@ -349,6 +350,9 @@
 #include <WiFiClient.h>
 #include <DNSServer.h>
 #include <WiFiManager.h>
+#if WEBSOCKET_ENABLE
+#include <WebSocketsServer.h>
+#endif  // WEBSOCKET_ENABLE
 #include <IRremoteESP8266.h>
 #include <IRrecv.h>
 #include <IRsend.h>
@@ -356,6 +360,12 @@
 #include <IRtimer.h>
 #include <IRutils.h>
 #include <IRac.h>
+#include <IRcustom.h>
+#if AIRTIME_ENABLE
+#include <IRairtime.h>
+#include <sys/time.h>
+#include <time.h>
+#endif  // AIRTIME_ENABLE
 #if MQTT_ENABLE
 #include <PubSubClient.h>
 // --------------------------------------------------------------------
@@ -387,6 +397,20 @@ ESP8266WebServer server(kHttpPort);
 #if defined(ESP32)
 WebServer server(kHttpPort);
 #endif  // ESP32
+#if WEBSOCKET_ENABLE
+WebSocketsServer webSocket(kWebSocketPort);
+// Each channel's climate state, as the web pages were last told it.
+stdAc::state_t webSocketState[kNrOfIrTxGpios];
+#endif  // WEBSOCKET_ENABLE
+String htmlChunk;  // The part of the current web page not yet sent.
+#if METRICS_ENABLE
+metrics_histogram_t loopTimeHistogram = {kLoopTimeBounds, {0}, 0};
+metrics_histogram_t decodeTimeHistogram = {kDecodeTimeBounds, {0}, 0};
+metrics_histogram_t sendTimeHistogram = {kSendTimeBounds, {0}, 0};
+metrics_histogram_t sendJitterHistogram = {kSendJitterBounds, {0}, 0};
+uint32_t captureOverflows = 0;
+uint32_t heapLowWater = UINT32_MAX;
+#endif  // METRICS_ENABLE
 #if MDNS_ENABLE
 MDNSResponder mdns;
 #endif  // MDNS_ENABLE
@@ -426,6 +450,15 @@ uint32_t irClimateCounter = 0;  // How many have we sent?
 // Store the success status of the last climate send.
 bool lastClimateSucceeded = false;
 bool hasClimateBeenSent = false;  // Has the Climate ever been sent?
+#if CLIMATE_STATE_SAVE_ENABLE
+bool climateStateDirty = false;  // Is there a change yet to be saved?
+TimerMs climateStateChanged = TimerMs();  // When the last change was.
+#endif  // CLIMATE_STATE_SAVE_ENABLE
+#if AIRTIME_ENABLE
+IRairtime airtime(kAirtimeNode);  // IR messages waiting for their time.
+IRsequence *airtimeFrame = NULL;  // Where a message is recorded.
+TimerMs airtimeSynced = TimerMs();  // When the clock was last read.
+#endif  // AIRTIME_ENABLE
 
 #if MQTT_ENABLE
 PubSubClient mqtt_client(espClient);
@@ -468,6 +501,25 @@ TimerMs lastDiscovery = TimerMs();  // When we last sent a Discovery.
 bool hasDiscoveryBeenSent = false;
 #endif  // MQTT_DISCOVERY_ENABLE
 TimerMs statListenTime = TimerMs();  // How long we've been listening for.
+// Climate stat topics a broadcast still has to publish. A bit per field.
+uint32_t broadcastPending[kNrOfIrTxGpios] = {0};
+// What each climate channel's stat topics were last published as.
+stdAc::state_t broadcastState[kNrOfIrTxGpios];
+bool broadcastRetain = false;  // Is the current broadcast to be retained?
+
+// MQTT commands waiting to be sent. See `handleMqttCommands()`.
+mqtt_command_t mqttCommandQueue[kMqttCommandQueueSize];
+uint8_t mqttCommandHead = 0;  // Where the next command to be done is.
+uint8_t mqttCommandCount = 0;  // How many commands are queued.
+uint32_t mqttCommandDrops = 0;  // How many didn't fit in the queue.
+// The topics we are subscribed to, hashed. See `buildMqttTopicTable()`.
+mqtt_topic_t *mqttTopicTable = NULL;
+uint16_t mqttTopicSlots = 0;  // Size of the table. A power of 2.
+uint16_t mqttTopicCount = 0;  // Nr. of topics in it.
+char *mqttTopicText = NULL;  // The topics themselves, each NUL terminated.
+uint16_t mqttTopicTextSize = 0;
+TimerMs mqttPauseTime = TimerMs();  // When the current sequence pause began.
+int32_t mqttPauseMs = 0;  // How long the current pause is. 0 if none.
 #endif  // MQTT_ENABLE
 
 bool isSerialGpioUsedByIr(void) {
@@ -626,6 +678,96 @@ bool loadConfigFile(void) {
   return success;
 }
 
+#if CLIMATE_STATE_SAVE_ENABLE
+// Calculate the CRC-16/CCITT-FALSE of some data.
+uint16_t crc16(const uint8_t *data, const uint16_t length) {
+  uint16_t crc = 0xFFFF;
+  for (uint16_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+// Save the climate state of every channel to flash.
+// The file is the nr. of channels, each channel's state in the compact binary
+// form (See `IRac::stateToBinary()`), then a CRC-16 of all of that.
+//
+// Returns:
+//   A boolean indicating success or failure.
+bool saveClimateStates(void) {
+  debug("Saving the climate states.");
+  uint8_t data[kClimateStateFileSize];
+  data[0] = kNrOfIrTxGpios;
+  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+    uint8_t *state = data + 1 + i * kIRacStateBinaryLength;
+    if (climate[i] == NULL ||
+        !IRac::stateToBinary(climate[i]->getState(), state))
+      memset(state, 0, kIRacStateBinaryLength);  // i.e. Not restored at boot.
+  }
+  const uint16_t crc = crc16(data, kClimateStateFileSize - 2);
+  data[kClimateStateFileSize - 2] = crc;
+  data[kClimateStateFileSize - 1] = crc >> 8;
+  climateStateDirty = false;  // Don't keep retrying if it fails.
+  bool success = false;
+  if (mountSpiffs()) {
+    File stateFile = FILESYSTEM.open(kClimateStateFile, "w");
+    if (!stateFile) {
+      debug("Failed to open climate state file for writing.");
+    } else {
+      success = stateFile.write(data, kClimateStateFileSize) ==
+          kClimateStateFileSize;
+      stateFile.close();
+      debug(success ? "Saved the climate states."
+                    : "Failed to write the climate state file.");
+    }
+    FILESYSTEM.end();
+  }
+  return success;
+}
+
+// Restore the climate state of every channel from flash.
+// See `saveClimateStates()`.
+//
+// Returns:
+//   The nr. of climate states restored.
+uint8_t loadClimateStates(void) {
+  uint8_t restored = 0;
+  if (!mountSpiffs()) return restored;
+  if (FILESYSTEM.exists(kClimateStateFile)) {
+    File stateFile = FILESYSTEM.open(kClimateStateFile, "r");
+    if (stateFile) {
+      uint8_t data[kClimateStateFileSize];
+      const size_t size = stateFile.read(data, kClimateStateFileSize);
+      stateFile.close();
+      // The channels may have changed since it was saved. If so, ignore it.
+      if (size != kClimateStateFileSize || data[0] != kNrOfIrTxGpios ||
+          crc16(data, kClimateStateFileSize - 2) !=
+              (data[kClimateStateFileSize - 2] |
+               (data[kClimateStateFileSize - 1] << 8))) {
+        debug("Climate state file is invalid. Ignoring it.");
+      } else {
+        for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+          const uint8_t *state = data + 1 + i * kIRacStateBinaryLength;
+          if (climate[i] != NULL &&
+              IRac::binaryToState(state, kIRacStateBinaryLength,
+                                  &(climate[i]->next))) {
+            climate[i]->markAsSent();  // It's what the A/C was last sent.
+            restored++;
+          }
+        }
+        debug(("Restored " + String(restored) + " climate state(s).").c_str());
+      }
+    }
+  } else {
+    debug("Climate state file doesn't exist!");
+  }
+  FILESYSTEM.end();
+  return restored;
+}
+#endif  // CLIMATE_STATE_SAVE_ENABLE
+
 String timeElapsed(uint32_t const msec) {
   String result = msToString(msec);
   if (result.equalsIgnoreCase(D_STR_NOW))
@@ -674,6 +816,51 @@ String listOfTxGpios(void) {
   return result;
 }
 
+// Start sending a web page, of as yet unknown length, in chunks.
+// This avoids having to build the entire page in memory first.
+void htmlBegin(const char *content_type) {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, content_type, "");
+  htmlChunk.reserve(kHtmlChunkSize);
+}
+
+// Add some html to the web page being sent.
+void htmlSend(const String &html) {
+  htmlChunk += html;
+  if (htmlChunk.length() >= kHtmlChunkSize) htmlFlush();
+}
+
+// Add some html, stored in flash, to the web page being sent.
+// Large blocks are sent directly from flash rather than copied to the heap.
+void htmlSend(const __FlashStringHelper *html) {
+  PGM_P str = reinterpret_cast<PGM_P>(html);
+  if (strlen_P(str) < kHtmlChunkSize) {
+    htmlChunk += html;
+    if (htmlChunk.length() >= kHtmlChunkSize) htmlFlush();
+  } else {
+    htmlFlush();
+    server.sendContent_P(str);
+  }
+}
+
+// Send whatever of the web page is still buffered.
+void htmlFlush(void) {
+  if (htmlChunk.length()) {
+    server.sendContent(htmlChunk);
+    htmlChunk = "";
+  }
+}
+
+// Finish sending the web page, and release the buffer.
+// Args:
+//   close_html: Add the closing html tags? i.e. `false` if not html.
+void htmlFinish(const bool close_html) {
+  if (close_html) htmlSend(htmlEnd());
+  htmlFlush();
+  server.sendContent("");  // An empty chunk marks the end of the page.
+  htmlChunk = String();
+}
+
 String htmlMenu(void) {
   String html = F("<center>");
   html += htmlButton(kUrlRoot, F("Home"));
@@ -687,9 +874,9 @@ String htmlMenu(void) {
   return html;
 }
 
-String htmlSelectAcStateProtocol(const String name, const decode_type_t def,
-                                 const bool simple) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectAcStateProtocol(const String name, const decode_type_t def,
+                               const bool simple) {
+  htmlSend("<select name='" + name + "'>");
   for (uint8_t i = 1; i <= decode_type_t::kLastDecodeType; i++) {
     if (simple ^ hasACState((decode_type_t)i)) {
       switch (i) {
@@ -698,13 +885,11 @@ String htmlSelectAcStateProtocol(const String name, const decode_type_t def,
         case decode_type_t::GLOBALCACHE:
           break;
         default:
-          html += htmlOptionItem(String(i), typeToString((decode_type_t)i),
-                                i == def);
+          htmlOptionItem(String(i), typeToString((decode_type_t)i), i == def);
       }
     }
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
 // Root web page with example usage etc.
@@ -715,29 +900,26 @@ void handleRoot(void) {
     return server.requestAuthentication();
   }
 #endif
-  String html = htmlHeader(F("ESP IR MQTT Server"));
-  html += F("<center><small><i>" _MY_VERSION_ "</i></small></center>");
-  html += htmlMenu();
-  html += F(
+  htmlBegin();
+  htmlSend(htmlHeader(F("ESP IR MQTT Server")));
+  htmlSend(F("<center><small><i>" _MY_VERSION_ "</i></small></center>"));
+  htmlSend(htmlMenu());
+  htmlSend(F(
     "<h3>Send a simple IR message</h3><p>"
     "<form method='POST' action='/ir' enctype='multipart/form-data'>"
-      D_STR_PROTOCOL ": ");
-  html += htmlSelectAcStateProtocol(KEY_TYPE, decode_type_t::NEC, true);
-  html += F(
+      D_STR_PROTOCOL ": "));
+  htmlSelectAcStateProtocol(KEY_TYPE, decode_type_t::NEC, true);
+  htmlSend(F(
       " " D_STR_CODE ": 0x<input type='text' name='" KEY_CODE "' min='0' "
         "value='0' size='16' maxlength='16'> "
       D_STR_BITS ": "
       "<select name='" KEY_BITS "'>"
-        "<option selected='selected' value='0'>Default</option>");  // Default
+        "<option selected='selected' value='0'>Default</option>"));
   for (uint8_t i = 0; i < sizeof(kCommonBitSizes); i++) {
     String num = String(kCommonBitSizes[i]);
-    html += F("<option value='");
-    html += num;
-    html += F("'>");
-    html += num;
-    html += F("</option>");
+    htmlOptionItem(num, num, false);
   }
-  html += F(
+  htmlSend(F(
       "</select>"
       " " D_STR_REPEAT ": <input type='number' name='" KEY_REPEAT "' min='0' "
         "max='99' value='0' size='2' maxlength='2'>"
@@ -746,15 +928,15 @@ void handleRoot(void) {
     "<br><hr>"
     "<h3>Send a complex (Air Conditioner) IR message</h3><p>"
     "<form method='POST' action='/ir' enctype='multipart/form-data'>"
-      D_STR_PROTOCOL ": ");
-  html += htmlSelectAcStateProtocol(KEY_TYPE, decode_type_t::KELVINATOR, false);
-  html += F(
+      D_STR_PROTOCOL ": "));
+  htmlSelectAcStateProtocol(KEY_TYPE, decode_type_t::KELVINATOR, false);
+  htmlSend(F(
       " State " D_STR_CODE ": 0x"
-      "<input type='text' name='" KEY_CODE "' size='");
-  html += String(kStateSizeMax * 2);
-  html += F("' maxlength='");
-  html += String(kStateSizeMax * 2);
-  html += F("'"
+      "<input type='text' name='" KEY_CODE "' size='"));
+  htmlSend(String(kSendStateSizeMax * 2));
+  htmlSend(F("' maxlength='"));
+  htmlSend(String(kSendStateSizeMax * 2));
+  htmlSend(F("'"
           " value='"
 #if EXAMPLES_ENABLE
                 "190B8050000000E0190B8070000010F0"
@@ -812,9 +994,8 @@ void handleRoot(void) {
           "max='99' value='0' size='2' maxlength='2'>"
       " <input type='submit' value='Send Pronto'>"
     "</form>"
-    "<br>");
-  html += htmlEnd();
-  server.send(200, "text/html", html);
+    "<br>"));
+  htmlFinish();
 }
 
 String addJsReloadUrl(const String url, const uint16_t timeout_s,
@@ -841,6 +1022,168 @@ String addJsReloadUrl(const String url, const uint16_t timeout_s,
   return html;
 }
 
+#if WEBSOCKET_ENABLE
+// The html to load the script of a live page. (web/live.js) Its version is in
+// the URL, so browsers can keep it for good, & only fetch a new one.
+String htmlLiveScript(void) {
+  String html = F("<script src='");
+  html += kUrlLiveJs;
+  for (uint8_t i = 0; i < kWebAssetCount; i++)
+    if (!strcmp(kWebAssets[i].path, kUrlLiveJs)) {
+      html += F("?v=");
+      html += kWebAssets[i].version;
+    }
+  html += F("' data-port='");
+  html += String(kWebSocketPort);
+  html += F("' data-channel='" KEY_CHANNEL "'></script>");
+  return html;
+}
+#endif  // WEBSOCKET_ENABLE
+
+// Send a static file of the web app, straight from flash, as it is. i.e.
+// gzip compressed. A browser that has the same version gets a 304 instead.
+// Asked for with its version, it can be cached forever, as that URL never
+// changes. Otherwise the browser checks it is still current each time.
+void handleWebAsset(const web_asset_t *asset) {
+  const String etag = String('"') + asset->version + '"';
+  server.sendHeader(F("ETag"), etag);
+  if (server.arg(F("v")) == asset->version)
+    server.sendHeader(F("Cache-Control"), F("max-age=31536000, immutable"));
+  else
+    server.sendHeader(F("Cache-Control"), F("no-cache"));
+  if (server.header(F("If-None-Match")) == etag) {
+    server.send(304);
+    return;
+  }
+  server.sendHeader(F("Content-Encoding"), F("gzip"));
+  server.send_P(200, asset->type, (PGM_P)asset->data, asset->size);
+}
+
+#if WEBSOCKET_ENABLE
+// Add the value of a climate field to a WebSocket message. The values are the
+// ones the /aircon form uses, so the page can set them as they are.
+void webSocketAddField(irutils::JsonWriter *json, const uint8_t field,
+                       const stdAc::state_t state) {
+  switch (field) {
+    case kClimateProtocol:
+      json->add(KEY_PROTOCOL, (int32_t)state.protocol);
+      break;
+    case kClimateModel: json->add(KEY_MODEL, (int32_t)state.model); break;
+    case kClimatePower:
+      json->add(KEY_POWER, IRac::boolToString(state.power).c_str());
+      break;
+    case kClimateMode:
+      json->add(KEY_MODE, IRac::opmodeToString(state.mode).c_str());
+      break;
+    case kClimateTemp: json->add(KEY_TEMP, state.degrees); break;
+    case kClimateCelsius:
+      json->add(KEY_CELSIUS, state.celsius ? "on" : "off");
+      break;
+    case kClimateFanspeed:
+      json->add(KEY_FANSPEED, IRac::fanspeedToString(state.fanspeed).c_str());
+      break;
+    case kClimateSwingv:
+      json->add(KEY_SWINGV, IRac::swingvToString(state.swingv).c_str());
+      break;
+    case kClimateSwingh:
+      json->add(KEY_SWINGH, IRac::swinghToString(state.swingh).c_str());
+      break;
+    case kClimateQuiet:
+      json->add(KEY_QUIET, IRac::boolToString(state.quiet).c_str());
+      break;
+    case kClimateTurbo:
+      json->add(KEY_TURBO, IRac::boolToString(state.turbo).c_str());
+      break;
+    case kClimateEcono:
+      json->add(KEY_ECONO, IRac::boolToString(state.econo).c_str());
+      break;
+    case kClimateLight:
+      json->add(KEY_LIGHT, IRac::boolToString(state.light).c_str());
+      break;
+    case kClimateFilter:
+      json->add(KEY_FILTER, IRac::boolToString(state.filter).c_str());
+      break;
+    case kClimateClean:
+      json->add(KEY_CLEAN, IRac::boolToString(state.clean).c_str());
+      break;
+    case kClimateBeep:
+      json->add(KEY_BEEP, IRac::boolToString(state.beep).c_str());
+      break;
+    case kClimateSleep: json->add(KEY_SLEEP, (int32_t)state.sleep); break;
+    default: break;
+  }
+}
+
+// Build the WebSocket message of what has changed in a climate state.
+//
+// Args:
+//   channel: The climate channel.
+//   prev: What the web pages were last told it was.
+//   next: What it is now.
+//   full: Include all of its fields, not just those that changed?
+//   msg: Where to build the message.
+//   size: The size of `msg`. `kWebSocketMsgSize` is big enough.
+// Returns:
+//   The length of the message, or 0 if nothing changed (or it didn't fit).
+uint16_t webSocketClimateMsg(const uint16_t channel, const stdAc::state_t prev,
+                             const stdAc::state_t next, const bool full,
+                             char *msg, const uint16_t size) {
+  irutils::JsonWriter json(msg, size);
+  bool changed = false;
+  json.begin();
+  json.add(KEY_CHANNEL, (int32_t)channel);
+  for (uint8_t field = 0; field <= kClimateSleep; field++) {
+    if (full || climateFieldChanged(field, prev, next)) {
+      changed = true;
+      webSocketAddField(&json, field, next);
+    }
+  }
+  json.end();
+  return (changed && !json.overflowed()) ? json.length() : 0;
+}
+
+// Tell the web pages about any climate changes since they were last told.
+void webSocketPushClimate(void) {
+  char msg[kWebSocketMsgSize];
+  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+    if (climate[i] == NULL) continue;
+    const stdAc::state_t next = climate[i]->getState();
+    if (webSocket.connectedClients() &&
+        webSocketClimateMsg(i, webSocketState[i], next, false, msg,
+                            sizeof(msg)))
+      webSocket.broadcastTXT(msg);
+    webSocketState[i] = next;
+  }
+}
+
+#if IR_RX
+// Tell the web pages about the IR message just received.
+void webSocketPushIr(void) {
+  if (!webSocket.connectedClients()) return;
+  char msg[kWebSocketMsgSize];
+  irutils::JsonWriter json(msg, sizeof(msg));
+  json.begin();
+  json.add("ir", lastIrReceived.c_str());
+  json.add("count", (uint64_t)irRecvCounter);
+  json.end();
+  if (!json.overflowed()) webSocket.broadcastTXT(msg);
+}
+#endif  // IR_RX
+
+void webSocketEvent(uint8_t num, WStype_t type, uint8_t *payload,
+                    size_t length) {
+  // Nothing is accepted from the pages. They only listen.
+  if (type != WStype_CONNECTED) return;
+  // Bring a new page up to date. e.g. It may be a cached copy.
+  char msg[kWebSocketMsgSize];
+  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++)
+    if (climate[i] != NULL &&
+        webSocketClimateMsg(i, webSocketState[i], webSocketState[i], true,
+                            msg, sizeof(msg)))
+      webSocket.sendTXT(num, msg);
+}
+#endif  // WEBSOCKET_ENABLE
+
 #if EXAMPLES_ENABLE
 // Web page with hardcoded example usage etc.
 void handleExamples(void) {
@@ -850,9 +1193,10 @@ void handleExamples(void) {
     return server.requestAuthentication();
   }
 #endif
-  String html = htmlHeader(F("IR MQTT examples"));
-  html += htmlMenu();
-  html += F(
+  htmlBegin();
+  htmlSend(htmlHeader(F("IR MQTT examples")));
+  htmlSend(htmlMenu());
+  htmlSend(F(
     "<h3>Hardcoded examples</h3>"
     "<p><a href=\"ir?" KEY_CODE "=38000,1,69,341,171,21,64,21,64,21,21,21,21,"
         "21,21,21,21,21,21,21,64,21,64,21,21,21,64,21,21,21,21,21,21,21,64,21,"
@@ -892,43 +1236,38 @@ void handleExamples(void) {
     "<p><a href=\"aircon/set?" KEY_POWER "=off&" KEY_MODE "=off\">"
       "Turn " D_STR_OFF " the current A/C <i>("
       "via HTTP aircon interface)</i></a></p>"
-    "<br><hr>");
-  html += htmlEnd();
-  server.send(200, "text/html", html);
+    "<br><hr>"));
+  htmlFinish();
 }
 #endif  // EXAMPLES_ENABLE
 
-String htmlOptionItem(const String value, const String text, bool selected) {
-  String html = F("<option value='");
-  html += value + '\'';
-  if (selected) html += F(" selected='selected'");
-  html += '>' + text + F("</option>");
-  return html;
+void htmlOptionItem(const String value, const String text, bool selected) {
+  htmlSend(F("<option value='"));
+  htmlSend(value);
+  htmlSend(selected ? F("' selected='selected'>") : F("'>"));
+  htmlSend(text);
+  htmlSend(F("</option>"));
 }
 
-String htmlSelectBool(const String name, const bool def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectBool(const String name, const bool def) {
+  htmlSend("<select name='" + name + "'>");
   for (uint16_t i = 0; i < 2; i++)
-    html += htmlOptionItem(IRac::boolToString(i), IRac::boolToString(i),
-                           i == def);
-  html += F("</select>");
-  return html;
+    htmlOptionItem(IRac::boolToString(i), IRac::boolToString(i), i == def);
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectClimateProtocol(const String name, const decode_type_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectClimateProtocol(const String name, const decode_type_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (uint8_t i = 1; i <= decode_type_t::kLastDecodeType; i++) {
     if (IRac::isProtocolSupported((decode_type_t)i)) {
-      html += htmlOptionItem(String(i), typeToString((decode_type_t)i),
-                             i == def);
+      htmlOptionItem(String(i), typeToString((decode_type_t)i), i == def);
     }
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectModel(const String name, const int16_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectModel(const String name, const int16_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (int16_t i = -1; i <= 6; i++) {
     String num = String(i);
     String text;
@@ -938,74 +1277,66 @@ String htmlSelectModel(const String name, const int16_t def) {
       text = F("Unknown");
     else
       text = num;
-    html += htmlOptionItem(num, text, i == def);
+    htmlOptionItem(num, text, i == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectUint(const String name, const uint16_t max,
-                      const uint16_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectUint(const String name, const uint16_t max,
+                    const uint16_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (uint16_t i = 0; i < max; i++) {
     String num = String(i);
-    html += htmlOptionItem(num, num, i == def);
+    htmlOptionItem(num, num, i == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectGpio(const String name, const int16_t def,
-                      const int8_t list[], const int16_t length) {
-  String html = ": <select name='" + name + "'>";
+void htmlSelectGpio(const String name, const int16_t def,
+                    const int8_t list[], const int16_t length) {
+  htmlSend(": <select name='" + name + "'>");
   for (int16_t i = 0; i < length; i++) {
     String num = String(list[i]);
-    html += htmlOptionItem(num, list[i] == kGpioUnused ? F("Unused") : num,
-                           list[i] == def);
-    html += F("</option>");
+    htmlOptionItem(num, list[i] == kGpioUnused ? F("Unused") : num,
+                   list[i] == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectMode(const String name, const stdAc::opmode_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectMode(const String name, const stdAc::opmode_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (int8_t i = -1; i <= (int8_t)stdAc::opmode_t::kLastOpmodeEnum; i++) {
     String mode = IRac::opmodeToString((stdAc::opmode_t)i);
-    html += htmlOptionItem(mode, mode, (stdAc::opmode_t)i == def);
+    htmlOptionItem(mode, mode, (stdAc::opmode_t)i == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectFanspeed(const String name, const stdAc::fanspeed_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectFanspeed(const String name, const stdAc::fanspeed_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (int8_t i = 0; i <= (int8_t)stdAc::fanspeed_t::kLastFanspeedEnum; i++) {
     String speed = IRac::fanspeedToString((stdAc::fanspeed_t)i);
-    html += htmlOptionItem(speed, speed, (stdAc::fanspeed_t)i == def);
+    htmlOptionItem(speed, speed, (stdAc::fanspeed_t)i == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectSwingv(const String name, const stdAc::swingv_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectSwingv(const String name, const stdAc::swingv_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (int8_t i = -1; i <= (int8_t)stdAc::swingv_t::kLastSwingvEnum; i++) {
     String swing = IRac::swingvToString((stdAc::swingv_t)i);
-    html += htmlOptionItem(swing, swing, (stdAc::swingv_t)i == def);
+    htmlOptionItem(swing, swing, (stdAc::swingv_t)i == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
-String htmlSelectSwingh(const String name, const stdAc::swingh_t def) {
-  String html = "<select name='" + name + "'>";
+void htmlSelectSwingh(const String name, const stdAc::swingh_t def) {
+  htmlSend("<select name='" + name + "'>");
   for (int8_t i = -1; i <= (int8_t)stdAc::swingh_t::kLastSwinghEnum; i++) {
     String swing = IRac::swinghToString((stdAc::swingh_t)i);
-    html += htmlOptionItem(swing, swing, (stdAc::swingh_t)i == def);
+    htmlOptionItem(swing, swing, (stdAc::swingh_t)i == def);
   }
-  html += F("</select>");
-  return html;
+  htmlSend(F("</select>"));
 }
 
 String htmlHeader(const String title, const String h1_text) {
@@ -1038,90 +1369,94 @@ String htmlButton(const String url, const String button, const String text) {
 
 // Admin web page
 void handleAirCon(void) {
-  String html = htmlHeader(F("Air Conditioner Control"));
-  html += htmlMenu();
+  htmlBegin();
+  htmlSend(htmlHeader(F("Air Conditioner Control")));
+  htmlSend(htmlMenu());
   if (kNrOfIrTxGpios > 1) {
-    html += "<form method='POST' action='/aircon/set'"
+    htmlSend(F("<form method='POST' action='/aircon/set'"
         " enctype='multipart/form-data'>"
         "<table>"
-        "<tr><td><b>Climate #</b></td><td>" +
-        htmlSelectUint(KEY_CHANNEL, kNrOfIrTxGpios, chan) +
-        "<input type='submit' value='Change'>"
+        "<tr><td><b>Climate #</b></td><td>"));
+    htmlSelectUint(KEY_CHANNEL, kNrOfIrTxGpios, chan);
+    htmlSend(F("<input type='submit' value='Change'>"
         "</td></tr>"
         "</table>"
         "</form>"
-        "<hr>";
+        "<hr>"));
   }
   if (climate[chan] != NULL) {
-    html += "<h3>Current Settings</h3>"
+    const stdAc::state_t *next = &(climate[chan]->next);
+    htmlSend(F("<h3>Current Settings</h3>"
         "<form method='POST' action='/aircon/set'"
-        " enctype='multipart/form-data'>"
-        "<input type='hidden' name='" KEY_CHANNEL "' value='" + String(chan) +
-            "'>" +
+        " enctype='multipart/form-data' id='ac"));
+    htmlSend(String(chan));
+    htmlSend(F("'>"
+        "<input type='hidden' name='" KEY_CHANNEL "' value='"));
+    htmlSend(String(chan));
+    htmlSend(F("'>"
         "<table style='width:33%'>"
-        "<tr><td>" D_STR_PROTOCOL "</td><td>" +
-            htmlSelectClimateProtocol(KEY_PROTOCOL,
-                                      climate[chan]->next.protocol) +
-            "</td></tr>"
-        "<tr><td>" D_STR_MODEL "</td><td>" +
-            htmlSelectModel(KEY_MODEL, climate[chan]->next.model) +
-            "</td></tr>"
-        "<tr><td>" D_STR_POWER "</td><td>" +
-            htmlSelectBool(KEY_POWER, climate[chan]->next.power) +
-            "</td></tr>"
-        "<tr><td>" D_STR_MODE "</td><td>" +
-            htmlSelectMode(KEY_MODE, climate[chan]->next.mode) +
-            "</td></tr>"
+        "<tr><td>" D_STR_PROTOCOL "</td><td>"));
+    htmlSelectClimateProtocol(KEY_PROTOCOL, next->protocol);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_MODEL "</td><td>"));
+    htmlSelectModel(KEY_MODEL, next->model);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_POWER "</td><td>"));
+    htmlSelectBool(KEY_POWER, next->power);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_MODE "</td><td>"));
+    htmlSelectMode(KEY_MODE, next->mode);
+    htmlSend(F("</td></tr>"
         "<tr><td>" D_STR_TEMP "</td><td>"
             "<input type='number' name='" KEY_TEMP "' min='16' max='90' "
-            "step='0.5' value='" + String(climate[chan]->next.degrees, 1) + "'>"
-            "<select name='" KEY_CELSIUS "'>"
-                "<option value='on'" +
-                (climate[chan]->next.celsius ? " selected='selected'" : "") +
-                ">C</option>"
-                "<option value='off'" +
-                (!climate[chan]->next.celsius ? " selected='selected'" : "") +
-                ">F</option>"
-            "</select></td></tr>"
-        "<tr><td>" D_STR_FAN "</td><td>" +
-            htmlSelectFanspeed(KEY_FANSPEED, climate[chan]->next.fanspeed) +
-            "</td></tr>"
-        "<tr><td>" D_STR_SWINGV "</td><td>" +
-            htmlSelectSwingv(KEY_SWINGV, climate[chan]->next.swingv) +
-            "</td></tr>"
-        "<tr><td>" D_STR_SWINGH "</td><td>" +
-            htmlSelectSwingh(KEY_SWINGH, climate[chan]->next.swingh) +
-            "</td></tr>"
-        "<tr><td>" D_STR_QUIET "</td><td>" +
-            htmlSelectBool(KEY_QUIET, climate[chan]->next.quiet) +
-            "</td></tr>"
-        "<tr><td>" D_STR_TURBO "</td><td>" +
-            htmlSelectBool(KEY_TURBO, climate[chan]->next.turbo) +
-            "</td></tr>"
-        "<tr><td>" D_STR_ECONO "</td><td>" +
-            htmlSelectBool(KEY_ECONO, climate[chan]->next.econo) +
-            "</td></tr>"
-        "<tr><td>" D_STR_LIGHT "</td><td>" +
-            htmlSelectBool(KEY_LIGHT, climate[chan]->next.light) +
-            "</td></tr>"
-        "<tr><td>" D_STR_FILTER "</td><td>" +
-            htmlSelectBool(KEY_FILTER, climate[chan]->next.filter) +
-            "</td></tr>"
-        "<tr><td>" D_STR_CLEAN "</td><td>" +
-            htmlSelectBool(KEY_CLEAN, climate[chan]->next.clean) +
-            "</td></tr>"
-        "<tr><td>" D_STR_BEEP "</td><td>" +
-            htmlSelectBool(KEY_BEEP, climate[chan]->next.beep) +
-            "</td></tr>"
-        "<tr><td>Force resend</td><td>" +
-            htmlSelectBool(KEY_RESEND, false) +
-            "</td></tr>"
+            "step='0.5' value='"));
+    htmlSend(String(next->degrees, 1));
+    htmlSend(F("'>"
+            "<select name='" KEY_CELSIUS "'>"));
+    htmlOptionItem(F("on"), F("C"), next->celsius);
+    htmlOptionItem(F("off"), F("F"), !next->celsius);
+    htmlSend(F("</select></td></tr>"
+        "<tr><td>" D_STR_FAN "</td><td>"));
+    htmlSelectFanspeed(KEY_FANSPEED, next->fanspeed);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_SWINGV "</td><td>"));
+    htmlSelectSwingv(KEY_SWINGV, next->swingv);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_SWINGH "</td><td>"));
+    htmlSelectSwingh(KEY_SWINGH, next->swingh);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_QUIET "</td><td>"));
+    htmlSelectBool(KEY_QUIET, next->quiet);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_TURBO "</td><td>"));
+    htmlSelectBool(KEY_TURBO, next->turbo);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_ECONO "</td><td>"));
+    htmlSelectBool(KEY_ECONO, next->econo);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_LIGHT "</td><td>"));
+    htmlSelectBool(KEY_LIGHT, next->light);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_FILTER "</td><td>"));
+    htmlSelectBool(KEY_FILTER, next->filter);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_CLEAN "</td><td>"));
+    htmlSelectBool(KEY_CLEAN, next->clean);
+    htmlSend(F("</td></tr>"
+        "<tr><td>" D_STR_BEEP "</td><td>"));
+    htmlSelectBool(KEY_BEEP, next->beep);
+    htmlSend(F("</td></tr>"
+        "<tr><td>Force resend</td><td>"));
+    htmlSelectBool(KEY_RESEND, false);
+    htmlSend(F("</td></tr>"
         "</table>"
         "<input type='submit' value='Update & Send'>"
-        "</form>";
+        "</form>"));
   }
-  html += htmlEnd();
-  server.send(200, "text/html", html);
+#if WEBSOCKET_ENABLE
+  htmlSend(htmlLiveScript());  // Keep the settings up to date.
+#endif  // WEBSOCKET_ENABLE
+  htmlFinish();
 }
 
 // Parse the URL args to find the Common A/C arguments.
@@ -1240,132 +1575,393 @@ String vccToString(void) { return String(ESP.getVcc() / 1000.0); }
 
 // Info web page
 void handleInfo(void) {
-  String html = htmlHeader(F("IR MQTT server info"));
-  html += htmlMenu();
-  html +=
-    "<h3>General</h3>"
-    "<p>Hostname: " + String(Hostname) + "<br>"
-    "IP address: " + WiFi.localIP().toString() + "<br>"
-    "MAC address: " + WiFi.macAddress() + "<br>"
-    "Booted: " + timeSince(1) + "<br>" +
+  htmlBegin();
+  htmlSend(htmlHeader(F("IR MQTT server info")));
+  htmlSend(htmlMenu());
+  htmlSend(F("<h3>General</h3>"
+    "<p>Hostname: "));
+  htmlSend(Hostname);
+  htmlSend(F("<br>IP address: "));
+  htmlSend(WiFi.localIP().toString());
+  htmlSend(F("<br>MAC address: "));
+  htmlSend(WiFi.macAddress());
+  htmlSend(F("<br>Booted: "));
+  htmlSend(timeSince(1));
+  htmlSend(F("<br>"
     "Version: " _MY_VERSION_ "<br>"
     "Built: " __DATE__
       " " __TIME__ "<br>"
-    "Period Offset: " + String(offset) + "us<br>"
-    "IR Lib Version: " _IRREMOTEESP8266_VERSION_ "<br>"
+    "Period Offset: "));
+  htmlSend(String(offset));
+  htmlSend(F("us<br>"
+    "IR Lib Version: " _IRREMOTEESP8266_VERSION_ "<br>"));
 #if defined(ESP8266)
-    "ESP8266 Core Version: " + ESP.getCoreVersion() + "<br>"
-    "Free Sketch Space: " + String(maxSketchSpace() >> 10) + "k<br>"
+  htmlSend(F("ESP8266 Core Version: "));
+  htmlSend(ESP.getCoreVersion());
+  htmlSend(F("<br>Free Sketch Space: "));
+  htmlSend(String(maxSketchSpace() >> 10));
+  htmlSend(F("k<br>"));
 #endif  // ESP8266
 #if defined(ESP32)
-    "ESP32 SDK Version: " + ESP.getSdkVersion() + "<br>"
+  htmlSend(F("ESP32 SDK Version: "));
+  htmlSend(ESP.getSdkVersion());
+  htmlSend(F("<br>"));
 #endif  // ESP32
-    "Cpu Freq: " + String(ESP.getCpuFreqMHz()) + "MHz<br>"
-    "Sanity Check: " + String((_sanity == 0) ? "Ok" : "FAILED") + "<br>"
-    "IR Send GPIO(s): " + listOfTxGpios() + "<br>"
-    + irutils::addBoolToString(kInvertTxOutput,
-                               "Inverting GPIO output", false) + "<br>"
-    "Total send requests: " + String(sendReqCounter) + "<br>"
-    "Last message sent: " + String(lastSendSucceeded ? "Ok" : "FAILED") +
-    " <i>(" + timeSince(lastSendTime) + ")</i><br>"
+  htmlSend(F("Cpu Freq: "));
+  htmlSend(String(ESP.getCpuFreqMHz()));
+  htmlSend(F("MHz<br>Sanity Check: "));
+  htmlSend((_sanity == 0) ? F("Ok") : F("FAILED"));
+  htmlSend(F("<br>IR Send GPIO(s): "));
+  htmlSend(listOfTxGpios());
+  htmlSend(F("<br>"));
+  htmlSend(irutils::addBoolToString(kInvertTxOutput,
+                                    "Inverting GPIO output", false));
+  htmlSend(F("<br>Total send requests: "));
+  htmlSend(String(sendReqCounter));
+  htmlSend(F("<br>Last message sent: "));
+  htmlSend(lastSendSucceeded ? F("Ok") : F("FAILED"));
+  htmlSend(F(" <i>("));
+  htmlSend(timeSince(lastSendTime));
+  htmlSend(F(")</i><br>"));
 #if IR_RX
-    "IR Recv GPIO: " + gpioToString(rx_gpio) +
+  htmlSend(F("IR Recv GPIO: "));
+  htmlSend(gpioToString(rx_gpio));
 #if IR_RX_PULLUP
-    " (pullup)"
+  htmlSend(F(" (pullup)"));
 #endif  // IR_RX_PULLUP
-    "<br>"
-    "Total IR Received: " + String(irRecvCounter) + "<br>"
-    "Last IR Received: " + lastIrReceived +
-    " <i>(" + timeSince(lastIrReceivedTime) + ")</i><br>"
+  htmlSend(F("<br>Total IR Received: <span id='irs'>"));
+  htmlSend(String(irRecvCounter));
+  htmlSend(F("</span><br>Last IR Received: <span id='ir'>"));
+  htmlSend(lastIrReceived);
+  htmlSend(F("</span> <i id='irt'>("));
+  htmlSend(timeSince(lastIrReceivedTime));
+  htmlSend(F(")</i><br>"));
 #endif  // IR_RX
-    "Duplicate " D_STR_WIFI " networks: " +
-        String(HIDE_DUPLICATE_NETWORKS ? "Hide" : "Show") + "<br>"
-    "Min " D_STR_WIFI " signal required: "
+#if AIRTIME_ENABLE
+  htmlSend(F("Air time node: "));
+  htmlSend(String(kAirtimeNode) + F(" of ") + String(kAirtimeNodes));
+  htmlSend(airtime.isSynced() ? F(" (clock set)") : F(" (clock NOT set)"));
+  htmlSend(F("<br>IR messages waiting for air time: "));
+  htmlSend(String(airtime.pending()));
+  htmlSend(F("<br>"));
+#endif  // AIRTIME_ENABLE
+  htmlSend(F("Duplicate " D_STR_WIFI " networks: "));
+  htmlSend(HIDE_DUPLICATE_NETWORKS ? F("Hide") : F("Show"));
+  htmlSend(F("<br>Min " D_STR_WIFI " signal required: "));
 #ifdef MIN_SIGNAL_STRENGTH
-        + String(static_cast<int>(MIN_SIGNAL_STRENGTH)) +
+  htmlSend(String(static_cast<int>(MIN_SIGNAL_STRENGTH)));
 #else  // MIN_SIGNAL_STRENGTH
-        "8"
+  htmlSend(F("8"));
 #endif  // MIN_SIGNAL_STRENGTH
-        "%<br>"
-    "Serial debugging: "
+  htmlSend(F("%<br>Serial debugging: "));
 #if DEBUG
-        + String(isSerialGpioUsedByIr() ? D_STR_OFF : D_STR_ON) +
+  htmlSend(isSerialGpioUsedByIr() ? F(D_STR_OFF) : F(D_STR_ON));
 #else  // DEBUG
-        D_STR_OFF
+  htmlSend(F(D_STR_OFF));
 #endif  // DEBUG
-        "<br>"
+  htmlSend(F("<br>"));
 #if REPORT_VCC
-    "Vcc: ";
-    html += vccToString();
-    html += "V<br>"
+  htmlSend(F("Vcc: "));
+  htmlSend(vccToString());
+  htmlSend(F("V<br>"));
 #endif  // REPORT_VCC
-    "</p>"
+  htmlSend(F("</p>"));
 #if MQTT_ENABLE
-    "<h4>MQTT Information</h4>"
-    "<p>Server: " + String(MqttServer) + ":" + String(MqttPort) + " <i>(" +
-    (mqtt_client.connected() ? "Connected " + timeSince(lastDisconnectedTime)
-                             : "Disconnected " + timeSince(lastConnectedTime)) +
-    ")</i><br>"
-    "Disconnections: " + String(mqttDisconnectCounter - 1) + "<br>"
-    "Max Packet Size: " + MQTT_MAX_PACKET_SIZE + " bytes<br>"
-    "Client id: " + MqttClientId + "<br>"
-    "Command topic(s): " + listOfCommandTopics() + "<br>"
-    "Acknowledgements topic: " + MqttAck + "<br>"
+  htmlSend(F("<h4>MQTT Information</h4>"
+    "<p>Server: "));
+  htmlSend(MqttServer);
+  htmlSend(F(":"));
+  htmlSend(MqttPort);
+  htmlSend(F(" <i>("));
+  if (mqtt_client.connected()) {
+    htmlSend(F("Connected "));
+    htmlSend(timeSince(lastDisconnectedTime));
+  } else {
+    htmlSend(F("Disconnected "));
+    htmlSend(timeSince(lastConnectedTime));
+  }
+  htmlSend(F(")</i><br>Disconnections: "));
+  htmlSend(String(mqttDisconnectCounter - 1));
+  htmlSend(F("<br>Max Packet Size: "));
+  htmlSend(String(MQTT_MAX_PACKET_SIZE));
+  htmlSend(F(" bytes<br>Client id: "));
+  htmlSend(MqttClientId);
+  htmlSend(F("<br>Command topic(s): "));
+  htmlSend(listOfCommandTopics());
+  htmlSend(F("<br>Acknowledgements topic: "));
+  htmlSend(MqttAck);
 #if IR_RX
-    "IR Received topic: " + MqttRecv + "<br>"
+  htmlSend(F("<br>IR Received topic: "));
+  htmlSend(MqttRecv);
 #endif  // IR_RX
-    "Log topic: " + MqttLog + "<br>"
-    "LWT topic: " + MqttLwt + "<br>"
-    "QoS: " + String(QOS) + "<br>"
-    // lastMqttCmd* is unescaped untrusted input.
-    // Avoid any possible HTML/XSS when displaying it.
-    "Last MQTT command seen: (topic) '" +
-        irutils::htmlEscape(lastMqttCmdTopic) +
-         "' (payload) '" + irutils::htmlEscape(lastMqttCmd) + "' <i>(" +
-         timeSince(lastMqttCmdTime) + ")</i><br>"
-    "Total published: " + String(mqttSentCounter) + "<br>"
-    "Total received: " + String(mqttRecvCounter) + "<br>"
-    "</p>"
+  htmlSend(F("<br>Log topic: "));
+  htmlSend(MqttLog);
+  htmlSend(F("<br>LWT topic: "));
+  htmlSend(MqttLwt);
+  htmlSend(F("<br>QoS: "));
+  htmlSend(String(QOS));
+  // lastMqttCmd* is unescaped untrusted input.
+  // Avoid any possible HTML/XSS when displaying it.
+  htmlSend(F("<br>Last MQTT command seen: (topic) '"));
+  htmlSend(irutils::htmlEscape(lastMqttCmdTopic));
+  htmlSend(F("' (payload) '"));
+  htmlSend(irutils::htmlEscape(lastMqttCmd));
+  htmlSend(F("' <i>("));
+  htmlSend(timeSince(lastMqttCmdTime));
+  htmlSend(F(")</i><br>Total published: "));
+  htmlSend(String(mqttSentCounter));
+  htmlSend(F("<br>Total received: "));
+  htmlSend(String(mqttRecvCounter));
+  htmlSend(F("<br>Commands queued: "));
+  htmlSend(String(mqttCommandCount));
+  htmlSend(F(" (" D_STR_MAX " "));
+  htmlSend(String(kMqttCommandQueueSize));
+  htmlSend(F(", dropped: "));
+  htmlSend(String(mqttCommandDrops));
+  htmlSend(F(")"));
+  htmlSend(F("<br></p>"));
 #endif  // MQTT_ENABLE
-    "<h4>Climate Information</h4>"
+  htmlSend(F("<h4>Climate Information</h4>"
     "<p>"
-    "IR Send GPIO: " + String(txGpioTable[0]) + "<br>"
-    "Last update source: " + lastClimateSource + "<br>"
-    "Total sent: " + String(irClimateCounter) + "<br>"
-    "Last send: " + String(hasClimateBeenSent ?
-        (String(lastClimateSucceeded ? "Ok" : "FAILED") +
-         " <i>(" + timeElapsed(lastClimateIr.elapsed()) + ")</i>") :
-        "<i>Never</i>") + "<br>"
+    "IR Send GPIO: "));
+  htmlSend(String(txGpioTable[0]));
+  htmlSend(F("<br>Last update source: "));
+  htmlSend(lastClimateSource);
+  htmlSend(F("<br>Total sent: "));
+  htmlSend(String(irClimateCounter));
+  htmlSend(F("<br>Last send: "));
+  if (hasClimateBeenSent) {
+    htmlSend(lastClimateSucceeded ? F("Ok") : F("FAILED"));
+    htmlSend(F(" <i>("));
+    htmlSend(timeElapsed(lastClimateIr.elapsed()));
+    htmlSend(F(")</i>"));
+  } else {
+    htmlSend(F("<i>Never</i>"));
+  }
+  htmlSend(F("<br>"));
+#if CLIMATE_STATE_SAVE_ENABLE
+  htmlSend(F("Saved to " FILESYSTEMSTR ": "));
+  htmlSend(climateStateDirty ? F("Pending") : F("Yes"));
+  htmlSend(F("<br>"));
+#endif  // CLIMATE_STATE_SAVE_ENABLE
 #if MQTT_ENABLE
-    "State listen period: " + msToString(kStatListenPeriodMs) + "<br>"
-    "State broadcast period: " + msToString(kBroadcastPeriodMs) + "<br>"
-    "Last state broadcast: " + (hasBroadcastBeenSent ?
-        timeElapsed(lastBroadcast.elapsed()) :
-        String("<i>Never</i>")) + "<br>"
+  htmlSend(F("State listen period: "));
+  htmlSend(msToString(kStatListenPeriodMs));
+  htmlSend(F("<br>State broadcast period: "));
+  htmlSend(msToString(kBroadcastPeriodMs));
+  htmlSend(F("<br>Last state broadcast: "));
+  if (hasBroadcastBeenSent)
+    htmlSend(timeElapsed(lastBroadcast.elapsed()));
+  else
+    htmlSend(F("<i>Never</i>"));
+  htmlSend(F("<br>"));
 #if MQTT_DISCOVERY_ENABLE
-    "Last discovery sent: " + (lockMqttBroadcast ?
-        String("<b>Locked</b>") :
-        (hasDiscoveryBeenSent ?
-            timeElapsed(lastDiscovery.elapsed()) :
-            String("<i>Never</i>"))) +
-        "<br>"
-    "Discovery topic: " + MqttDiscovery + "<br>" +
+  htmlSend(F("Last discovery sent: "));
+  if (lockMqttBroadcast)
+    htmlSend(F("<b>Locked</b>"));
+  else if (hasDiscoveryBeenSent)
+    htmlSend(timeElapsed(lastDiscovery.elapsed()));
+  else
+    htmlSend(F("<i>Never</i>"));
+  htmlSend(F("<br>Discovery topic: "));
+  htmlSend(MqttDiscovery);
+  htmlSend(F("<br>"));
 #endif  // MQTT_DISCOVERY_ENABLE
-    "Command topics: " + MqttClimate + channel_re + '/' + MQTT_CLIMATE_CMND +
-        '/' + kClimateTopics +
-    "State topics: " + MqttClimate + channel_re + '/' + MQTT_CLIMATE_STAT +
-        '/' + kClimateTopics +
+  htmlSend(F("Command topics: "));
+  htmlSend(MqttClimate + channel_re + '/' + MQTT_CLIMATE_CMND + '/' +
+           kClimateTopics);
+  htmlSend(F("State topics: "));
+  htmlSend(MqttClimate + channel_re + '/' + MQTT_CLIMATE_STAT + '/' +
+           kClimateTopics);
 #endif  // MQTT_ENABLE
-    "</p>"
+  htmlSend(F("</p>"
     // Page footer
     "<hr><p><small><center>"
+#if WEBSOCKET_ENABLE
+      "<i>(Note: IR messages are shown as they are received.)</i>"
+#else  // WEBSOCKET_ENABLE
       "<i>(Note: Page will refresh every 60 " D_STR_SECONDS ".)</i>"
-    "<centre></small></p>";
-  html += addJsReloadUrl(kUrlInfo, 60, false);
-  html += htmlEnd();
-  server.send(200, "text/html", html);
+#endif  // WEBSOCKET_ENABLE
+    "<centre></small></p>"));
+#if WEBSOCKET_ENABLE
+  htmlSend(htmlLiveScript());
+#else  // WEBSOCKET_ENABLE
+  htmlSend(addJsReloadUrl(kUrlInfo, 60, false));
+#endif  // WEBSOCKET_ENABLE
+  htmlFinish();
 }
 
+#if METRICS_ENABLE
+// Add a measurement to a histogram for the `/metrics` page.
+void metricsObserve(metrics_histogram_t *histogram, const uint32_t usecs) {
+  uint8_t i = 0;
+  while (i < kMetricsBuckets && usecs > histogram->bounds[i]) i++;
+  histogram->counts[i]++;
+  histogram->sum += usecs;
+}
+
+String usecsToSeconds(const uint64_t usecs) {
+  return String(usecs / 1000000.0, 6);
+}
+
+// Add the HELP & TYPE lines of a metric to the `/metrics` page.
+void metricsHeader(const String name, const String type, const String help) {
+  htmlSend("# HELP " + name + ' ' + help + '\n');
+  htmlSend("# TYPE " + name + ' ' + type + '\n');
+}
+
+// Add a metric with a single value to the `/metrics` page.
+void metricsValue(const String name, const String type, const String help,
+                  const uint64_t value) {
+  metricsHeader(name, type, help);
+  htmlSend(name + ' ' + uint64ToString(value) + '\n');
+}
+
+// Add a histogram to the `/metrics` page. Its buckets are cumulative there.
+void metricsHistogram(const String name, const String help,
+                      const metrics_histogram_t *histogram) {
+  metricsHeader(name, F("histogram"), help);
+  uint32_t total = 0;
+  for (uint8_t i = 0; i <= kMetricsBuckets; i++) {
+    total += histogram->counts[i];
+    htmlSend(name + F("_bucket{le=\""));
+    if (i < kMetricsBuckets)
+      htmlSend(usecsToSeconds(histogram->bounds[i]));
+    else
+      htmlSend(F("+Inf"));
+    htmlSend("\"} " + String(total) + '\n');
+  }
+  htmlSend(name + F("_sum ") + usecsToSeconds(histogram->sum) + '\n');
+  htmlSend(name + F("_count ") + String(total) + '\n');
+}
+
+#if IR_RX && ENABLE_DECODE_PROFILING
+// Add one of the per protocol decode statistics to the `/metrics` page.
+// Only protocols that have been attempted are listed.
+//
+// Args:
+//   name: The metric name.
+//   help: A description of it.
+//   stat: Which of the statistics in `decode_profile_t`.
+//   usecs: Is it a time in microseconds? It is listed in seconds if so.
+void metricsDecodeProfile(const String name, const String help,
+                          uint32_t decode_profile_t::*stat, const bool usecs) {
+  metricsHeader(name, F("counter"), help);
+  for (int16_t i = UNKNOWN; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    const decode_profile_t *profile = irrecv->getDecodeProfile(protocol);
+    if (profile == NULL || !profile->attempts) continue;
+    htmlSend(name + F("{protocol=\"") + typeToString(protocol) + F("\"} "));
+    htmlSend((usecs ? usecsToSeconds(profile->*stat)
+                    : String(profile->*stat)) + '\n');
+  }
+}
+#endif  // IR_RX && ENABLE_DECODE_PROFILING
+
+// Machine readable metrics, in the Prometheus text format.
+// Ref: https://prometheus.io/docs/instrumenting/exposition_formats/
+void handleMetrics(void) {
+#if HTML_PASSWORD_ENABLE
+  if (!server.authenticate(HttpUsername, HttpPassword)) {
+    debug("Basic HTTP authentication failure for /metrics.");
+    return server.requestAuthentication();
+  }
+#endif
+  htmlBegin("text/plain; version=0.0.4");
+  metricsValue(F("irmqtt_heap_free_bytes"), F("gauge"),
+               F("Free heap memory."), ESP.getFreeHeap());
+  metricsValue(F("irmqtt_heap_free_min_bytes"), F("gauge"),
+               F("Least free heap memory seen by loop()."), heapLowWater);
+  metricsHistogram(F("irmqtt_loop_seconds"),
+                   F("Time each loop() took, excluding its idle delay."),
+                   &loopTimeHistogram);
+#if IR_RX
+  if (irrecv != NULL) {
+    metricsValue(F("ir_receive_total"), F("counter"),
+                 F("Nr. of IR messages received & reported."), irRecvCounter);
+    metricsValue(F("ir_capture_overflows_total"), F("counter"),
+                 F("Nr. of captures that overflowed the capture buffer."),
+                 captureOverflows);
+#if ENABLE_CAPTURE_RING
+    metricsValue(F("ir_capture_ring_drops_total"), F("counter"),
+                 F("Nr. of captures dropped as the capture ring was full."),
+                 irrecv->getCaptureDrops());
+    metricsValue(F("ir_capture_ring_high_water"), F("gauge"),
+                 F("Most capture ring slots ever in use at once."),
+                 irrecv->getCaptureHighWater());
+#endif  // ENABLE_CAPTURE_RING
+    metricsHistogram(F("ir_decode_seconds"),
+                     F("Time each decode() of a capture took."),
+                     &decodeTimeHistogram);
+#if ENABLE_DECODE_PROFILING
+    metricsDecodeProfile(F("ir_decode_attempts_total"),
+                         F("Nr. of times each protocol was tried."),
+                         &decode_profile_t::attempts, false);
+    metricsDecodeProfile(F("ir_decode_rejects_total"),
+                         F("Nr. of tries rejected by the header alone."),
+                         &decode_profile_t::rejects, false);
+    metricsDecodeProfile(F("ir_decode_successes_total"),
+                         F("Nr. of times each protocol was decoded."),
+                         &decode_profile_t::successes, false);
+    metricsDecodeProfile(F("ir_decode_seconds_total"),
+                         F("Time spent trying each protocol."),
+                         &decode_profile_t::usecs, true);
+#endif  // ENABLE_DECODE_PROFILING
+  }
+#endif  // IR_RX
+  metricsValue(F("ir_send_requests_total"), F("counter"),
+               F("Nr. of IR messages sent."), sendReqCounter);
+  metricsValue(F("ir_climate_sends_total"), F("counter"),
+               F("Nr. of climate states sent."), irClimateCounter);
+  metricsHistogram(F("ir_send_seconds"),
+                   F("Time each IR message or climate state took to send."),
+                   &sendTimeHistogram);
+#if ENABLE_SEND_TIMING
+  metricsHistogram(F("ir_send_jitter_seconds"),
+                   F("Largest error of a mark or space of each IR message."),
+                   &sendJitterHistogram);
+#endif  // ENABLE_SEND_TIMING
+#if MQTT_ENABLE
+  metricsValue(F("mqtt_connected"), F("gauge"),
+               F("Is the MQTT broker connected?"), mqtt_client.connected());
+  metricsValue(F("mqtt_disconnects_total"), F("counter"),
+               F("Nr. of times the MQTT broker was disconnected."),
+               mqttDisconnectCounter - 1);
+  metricsValue(F("mqtt_published_total"), F("counter"),
+               F("Nr. of MQTT messages published."), mqttSentCounter);
+  metricsValue(F("mqtt_received_total"), F("counter"),
+               F("Nr. of MQTT messages received."), mqttRecvCounter);
+  metricsValue(F("mqtt_command_queue_depth"), F("gauge"),
+               F("Nr. of MQTT commands waiting to be sent."),
+               mqttCommandCount);
+  metricsValue(F("mqtt_command_queue_size"), F("gauge"),
+               F("Nr. of MQTT commands that can wait to be sent."),
+               kMqttCommandQueueSize);
+  metricsValue(F("mqtt_command_drops_total"), F("counter"),
+               F("Nr. of MQTT commands dropped as the queue was full."),
+               mqttCommandDrops);
+#endif  // MQTT_ENABLE
+#if ENABLE_MEMORY_PROFILING
+  const char* kMemProbeNames[kMemProbeCount] = {
+      "decode", "sendAc", "decodeToState", "resultAcToString",
+      "resultToSourceCode"};
+  metricsHeader(F("ir_stack_high_water_bytes"), F("gauge"),
+                F("Most stack used by each library entry point."));
+  for (uint8_t i = 0; i < kMemProbeCount; i++)
+    htmlSend(String(F("ir_stack_high_water_bytes{entry=\"")) +
+             String(kMemProbeNames[i]) + F("\"} ") +
+             String(getMemoryProfile((mem_probe_t)i)->stack) + '\n');
+  metricsHeader(F("ir_heap_high_water_bytes"), F("gauge"),
+                F("Most heap in use grew by over each library entry point."));
+  for (uint8_t i = 0; i < kMemProbeCount; i++)
+    htmlSend(String(F("ir_heap_high_water_bytes{entry=\"")) +
+             String(kMemProbeNames[i]) + F("\"} ") +
+             String(getMemoryProfile((mem_probe_t)i)->heap) + '\n');
+#endif  // ENABLE_MEMORY_PROFILING
+  htmlFinish(false);
+}
+#endif  // METRICS_ENABLE
+
 void doRestart(const char* str, const bool serial_only) {
 #if MQTT_ENABLE
   if (!serial_only)
@@ -1457,6 +2053,10 @@ void handleReset(void) {
   if (mountSpiffs()) {
     debug("Removing JSON config file");
     FILESYSTEM.remove(kConfigFile);
+#if CLIMATE_STATE_SAVE_ENABLE
+    debug("Removing climate state file");
+    FILESYSTEM.remove(kClimateStateFile);
+#endif  // CLIMATE_STATE_SAVE_ENABLE
     FILESYSTEM.end();
   }
   delay(1000);
@@ -1492,7 +2092,7 @@ void handleReboot() {
 bool parseStringAndSendAirCon(IRsend *irsend, const decode_type_t irType,
                               const String str) {
   uint8_t strOffset = 0;
-  uint8_t state[kStateSizeMax] = {0};  // All array elements are set to 0.
+  uint8_t state[kSendStateSizeMax] = {0};  // All array elements are set to 0.
   uint16_t stateSize = 0;
 
   if (str.startsWith("0x") || str.startsWith("0X"))
@@ -1564,7 +2164,7 @@ bool parseStringAndSendAirCon(IRsend *irsend, const decode_type_t irType,
       // Use at least the minimum size.
       stateSize = std::max(stateSize, (uint16_t) 3);
       // Cap the maximum size.
-      stateSize = std::min(stateSize, kStateSizeMax);
+      stateSize = std::min(stateSize, kSendStateSizeMax);
       break;
     case SAMSUNG_AC:
       // Samsung has two distinct & different size states, so make a best guess
@@ -1672,41 +2272,21 @@ uint16_t * newCodeArray(const uint16_t size) {
 // Returns:
 //   bool: Successfully sent or not.
 bool parseStringAndSendGC(IRsend *irsend, const String str) {
-  uint16_t count;
-  uint16_t *code_array;
-  String tmp_str;
-
-  // Remove the leading "1:1,1," if present.
-  if (str.startsWith("1:1,1,"))
-    tmp_str = str.substring(6);
-  else
-    tmp_str = str;
-
-  // Find out how many items there are in the string.
-  count = countValuesInStr(tmp_str, ',');
-
-  // Now we know how many there are, allocate the memory to store them all.
-  code_array = newCodeArray(count);
-
-  // Now convert the strings to integers and place them in code_array.
-  count = 0;
-  uint16_t start_from = 0;
-  int16_t index = -1;
-  do {
-    index = tmp_str.indexOf(',', start_from);
-    code_array[count] = tmp_str.substring(start_from, index).toInt();
-    start_from = index + 1;
-    count++;
-  } while (index != -1);
-  irsend->sendGC(code_array, count);  // All done. Send it.
-  free(code_array);  // Free up the memory allocated.
-  if (count > 0)
-    return true;  // We sent something.
-  return false;  // We probably didn't.
+  const char *code = str.c_str();
+  // Skip the leading "1:1,1," if present.
+  if (str.startsWith("1:1,1,")) code += 6;
+  // Send it straight from the text. No need to convert it to an array first.
+  return irsend->sendGC(code);
 }
 #endif  // SEND_GLOBALCACHE
 
 #if SEND_PRONTO
+// The last Pronto code that was sent, & it compiled. Sending the same code
+// again (e.g. Volume up, a few times) then only needs to replay it.
+String lastProntoCode = "";
+IRsequence *lastProntoIntro = NULL;
+IRsequence *lastProntoRepeats = NULL;
+
 // Parse a Pronto Hex String/code and send it.
 // Args:
 //   irsend: A ptr to the IRsend object to transmit via.
@@ -1725,46 +2305,26 @@ bool parseStringAndSendGC(IRsend *irsend, const String str) {
 //   bool: Successfully sent or not.
 bool parseStringAndSendPronto(IRsend *irsend, const String str,
                               uint16_t repeats) {
-  uint16_t count;
-  uint16_t *code_array;
-  int16_t index = -1;
-  uint16_t start_from = 0;
-
-  // Find out how many items there are in the string.
-  count = countValuesInStr(str, ',');
-
+  const char *code = str.c_str();
   // Check if we have the optional embedded repeats value in the code string.
   if (str.startsWith("R") || str.startsWith("r")) {
     // Grab the first value from the string, as it is the nr. of repeats.
-    index = str.indexOf(',', start_from);
-    repeats = str.substring(start_from + 1, index).toInt();  // Skip the 'R'.
-    start_from = index + 1;
-    count--;  // We don't count the repeats value as part of the code array.
+    int16_t index = str.indexOf(',');
+    if (index == -1) return false;
+    repeats = str.substring(1, index).toInt();  // Skip the 'R'.
+    code += index + 1;
   }
-
-  // We need at least kProntoMinLength values for the code part.
-  if (count < kProntoMinLength) return false;
-
-  // Now we know how many there are, allocate the memory to store them all.
-  code_array = newCodeArray(count);
-
-  // Rest of the string are values for the code array.
-  // Now convert the hex strings to integers and place them in code_array.
-  count = 0;
-  do {
-    index = str.indexOf(',', start_from);
-    // Convert the hexadecimal value string to an unsigned integer.
-    code_array[count] = strtoul(str.substring(start_from, index).c_str(),
-                                NULL, 16);
-    start_from = index + 1;
-    count++;
-  } while (index != -1);
-
-  irsend->sendPronto(code_array, count, repeats);  // All done. Send it.
-  free(code_array);  // Free up the memory allocated.
-  if (count > 0)
-    return true;  // We sent something.
-  return false;  // We probably didn't.
+  if (lastProntoIntro == NULL) lastProntoIntro = new IRsequence();
+  if (lastProntoRepeats == NULL) lastProntoRepeats = new IRsequence();
+  if (lastProntoCode != code) {
+    lastProntoCode = "";
+    // Too large to compile? Send it straight from the text instead.
+    if (!irsend->compilePronto(code, lastProntoIntro, lastProntoRepeats))
+      return irsend->sendPronto(code, repeats);
+    lastProntoCode = code;
+  }
+  irsend->sendPronto(lastProntoIntro, lastProntoRepeats, repeats);
+  return true;
 }
 #endif  // SEND_PRONTO
 
@@ -1876,34 +2436,33 @@ void handleGpio(void) {
     return server.requestAuthentication();
   }
 #endif
-  String html = htmlHeader(F("GPIO config"));
-  html += F(
-      "<form method='POST' action='/gpio/set' enctype='multipart/form-data'>");
-  html += htmlMenu();
-  html += F("<h2><mark>WARNING: Choose carefully! You can cause damage to your "
-            "hardware or make the device unresponsive.</mark></h2>");
-  html += F("<h3>Send</h3>IR LED");
+  htmlBegin();
+  htmlSend(htmlHeader(F("GPIO config")));
+  htmlSend(F(
+      "<form method='POST' action='/gpio/set' enctype='multipart/form-data'>"));
+  htmlSend(htmlMenu());
+  htmlSend(F("<h2><mark>WARNING: Choose carefully! You can cause damage to "
+             "your hardware or make the device unresponsive.</mark></h2>"));
+  htmlSend(F("<h3>Send</h3>IR LED"));
   for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
     if (kNrOfIrTxGpios > 1) {
-      html += F(" #");
-      html += String(i);
+      htmlSend(F(" #"));
+      htmlSend(String(i));
     }
-    html += htmlSelectGpio(KEY_TX_GPIO + String(i), txGpioTable[i], kTxGpios,
-                           sizeof(kTxGpios));
+    htmlSelectGpio(KEY_TX_GPIO + String(i), txGpioTable[i], kTxGpios,
+                   sizeof(kTxGpios));
   }
 #if IR_RX
-  html += F("<h3>Receive</h3>IR RX Module");
-  html += htmlSelectGpio(KEY_RX_GPIO, rx_gpio, kRxGpios,
-                         sizeof(kRxGpios));
+  htmlSend(F("<h3>Receive</h3>IR RX Module"));
+  htmlSelectGpio(KEY_RX_GPIO, rx_gpio, kRxGpios, sizeof(kRxGpios));
 #endif  // IR_RX
-  html += F("<br><br><hr>");
+  htmlSend(F("<br><br><hr>"));
   if (strlen(HttpPassword))  // Allow if password set
-    html += F("<input type='submit' value='Save & Reboot'>");
+    htmlSend(F("<input type='submit' value='Save & Reboot'>"));
   else
-    html += htmlDisabled();
-  html += F("</form>");
-  html += htmlEnd();
-  server.send(200, "text/html", html);
+    htmlSend(htmlDisabled());
+  htmlSend(F("</form>"));
+  htmlFinish();
 }
 
 // GPIO setting page
@@ -2117,14 +2676,28 @@ void setup(void) {
     } else {
       IrSendTable[i] = new IRsend(txGpioTable[i], kInvertTxOutput);
       if (IrSendTable[i] != NULL) {
+#if defined(ESP32) && ENABLE_ESP32_LEDC_SEND
+        // They all use the default LEDC channel, so share its carrier.
+        IrSendTable[i]->shareLedcCarrier();
+#endif  // defined(ESP32) && ENABLE_ESP32_LEDC_SEND
         IrSendTable[i]->begin();
         offset = IrSendTable[i]->calibrate();
+#if METRICS_ENABLE && ENABLE_SEND_TIMING
+        IrSendTable[i]->enableSendTiming();
+#endif  // METRICS_ENABLE && ENABLE_SEND_TIMING
       }
       climate[i] = new IRac(txGpioTable[i], kInvertTxOutput);
       if (climate[i] != NULL && i > 0) channel_re += '_' + String(i) + '|';
     }
   }
   lastClimateSource = F("None");
+#if CLIMATE_STATE_SAVE_ENABLE
+  if (loadClimateStates()) lastClimateSource = F("Flash");
+#endif  // CLIMATE_STATE_SAVE_ENABLE
+#if WEBSOCKET_ENABLE
+  for (uint8_t i = 0; i < kNrOfIrTxGpios; i++)
+    if (climate[i] != NULL) webSocketState[i] = climate[i]->getState();
+#endif  // WEBSOCKET_ENABLE
   if (channel_re.length() == 1) {
     channel_re = "";
   } else {
@@ -2139,9 +2712,18 @@ void setup(void) {
     // Ignore messages with less than minimum on or off pulses.
     irrecv->setUnknownThreshold(kMinUnknownSize);
 #endif  // DECODE_HASH
+#if METRICS_ENABLE && ENABLE_DECODE_PROFILING
+    irrecv->enableDecodeProfiling();
+#endif  // METRICS_ENABLE && ENABLE_DECODE_PROFILING
     irrecv->enableIRIn(IR_RX_PULLUP);  // Start the receiver
   }
 #endif  // IR_RX
+#if AIRTIME_ENABLE
+  configTime(0, 0, AIRTIME_NTP_SERVER);  // The time base all the nodes share.
+  airtimeFrame = new IRsequence(kAirtimeFrameSize);
+  airtime.setSlots(kAirtimeSlotMs, kAirtimeNodes, kAirtimeNode);
+  airtime.setReservations(MQTT_ENABLE);
+#endif  // AIRTIME_ENABLE
   // Wait a bit for things to settle.
   delay(500);
 
@@ -2171,6 +2753,20 @@ void setup(void) {
   server.on("/aircon/set", handleAirConSet);
   // Setup the info page.
   server.on(kUrlInfo, handleInfo);
+  // The static files of the web app. e.g. The script of the live pages.
+  for (uint8_t i = 0; i < kWebAssetCount; i++) {
+    const web_asset_t *asset = &kWebAssets[i];
+    server.on(asset->path, [asset]() { handleWebAsset(asset); });
+  }
+  const char *headers[] = {"If-None-Match"};
+  server.collectHeaders(headers, 1);
+#if METRICS_ENABLE
+  // Machine readable metrics.
+  server.on(kUrlMetrics, handleMetrics);
+#if ENABLE_MEMORY_PROFILING
+  enableMemoryProfiling();
+#endif  // ENABLE_MEMORY_PROFILING
+#endif  // METRICS_ENABLE
   // Setup the admin page.
   server.on(kUrlAdmin, handleAdmin);
   // Setup a reset page to cause WiFiManager information to be reset.
@@ -2195,6 +2791,7 @@ void setup(void) {
   mqtt_client.setCallback(mqttCallback);
   // Set various variables
   init_vars();
+  buildMqttTopicTable();
 #endif  // MQTT_ENABLE
 
 #if FIRMWARE_OTA
@@ -2262,6 +2859,14 @@ void setup(void) {
 
   server.begin();
   debug("HTTP server started");
+#if WEBSOCKET_ENABLE
+#if HTML_PASSWORD_ENABLE
+  webSocket.setAuthorization(HttpUsername, HttpPassword);
+#endif  // HTML_PASSWORD_ENABLE
+  webSocket.onEvent(webSocketEvent);
+  webSocket.begin();
+  debug("WebSocket server started");
+#endif  // WEBSOCKET_ENABLE
 }
 
 #if MQTT_ENABLE
@@ -2329,6 +2934,12 @@ bool reconnect(void) {
       // Subscribing to topic(s)
       subscribing(MqttSend);  // General base topic.
       subscribing(MqttClimateCmnd + '+');  // Base climate command topics
+#if AIRTIME_ENABLE
+      subscribing(MQTT_AIRTIME);  // The other nodes' reservations.
+#endif  // AIRTIME_ENABLE
+#ifdef MQTT_PROTOCOLS
+      subscribing(MQTT_PROTOCOLS "/+");  // Protocols learnt at run time.
+#endif  // MQTT_PROTOCOLS
       // Per channel topics
       for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
         // General
@@ -2383,145 +2994,318 @@ void handleSendMqttDiscovery(void) {
 }
 #endif  // MQTT_DISCOVERY_ENABLE
 
+// Start a broadcast of the climate state(s), if it is time to, & publish
+// some more of any broadcast that is under way. See `sendBroadcast()`.
+// Only the stat topics whose value differs from what was last published are
+// broadcast, unless `force` is set, or it is the first broadcast.
 void doBroadcast(TimerMs *timer, const uint32_t interval,
                  IRac *climate[], const bool retain,
                  const bool force) {
   if (force || (!lockMqttBroadcast && timer->elapsed() > interval)) {
-    debug("Sending MQTT stat update broadcast.");
+    debug("Starting MQTT stat update broadcast.");
     for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
-      String stat_topic = genStatTopic(i);
-      sendClimate(stat_topic, retain, true, false, true, climate[i]);
-#if REPORT_VCC
-      sendString(stat_topic + KEY_VCC, vccToString(), false);
-#endif  // REPORT_VCC
+      if (climate[i] == NULL) continue;
+      for (uint8_t field = 0; field <= kClimateSleep; field++)
+        if (force || !hasBroadcastBeenSent ||
+            climateFieldChanged(field, broadcastState[i], climate[i]->next))
+          broadcastPending[i] |= 1UL << field;
 #if MQTT_CLIMATE_JSON
-      sendJsonState(climate[i]->next, stat_topic + KEY_JSON);
+      if (broadcastPending[i]) broadcastPending[i] |= 1UL << kClimateJson;
 #endif  // MQTT_CLIMATE_JSON
+#if REPORT_VCC
+      broadcastPending[i] |= 1UL << kClimateVcc;  // It's always sent.
+#endif  // REPORT_VCC
     }
-    timer->reset();  // It's been sent, so reset the timer.
+    broadcastRetain = retain;
+    timer->reset();  // It's been started, so reset the timer.
     hasBroadcastBeenSent = true;
   }
+  sendBroadcast(climate, kBroadcastBudget);
 }
 
-void receivingMQTT(String const topic_name, String const callback_str) {
-  uint64_t code = 0;
-  uint16_t nbits = 0;
-  uint16_t repeat = 0;
-  uint8_t channel = getDefaultIrSendIdx();  // Default to first usable channel.
+// Publish the next part of a broadcast of the climate state(s).
+// This spreads a broadcast over several calls, so `loop()` isn't held up.
+//
+// Args:
+//   climate: The climate channels.
+//   budget: The most stat topics to publish in this call.
+void sendBroadcast(IRac *climate[], const uint8_t budget) {
+  uint8_t sent = 0;
+  for (uint16_t i = 0; i < kNrOfIrTxGpios && sent < budget; i++) {
+    if (!broadcastPending[i]) continue;
+    if (climate[i] == NULL) {
+      broadcastPending[i] = 0;
+      continue;
+    }
+    const String stat_topic = genStatTopic(i);
+    for (uint8_t field = 0; field < kClimateFieldCount && sent < budget;
+         field++) {
+      const uint32_t bit = 1UL << field;
+      if (!(broadcastPending[i] & bit)) continue;
+      // Leave it pending, & try again next time, if it fails.
+      if (!sendClimateField(stat_topic, field, climate[i]->next,
+                            broadcastRetain)) return;
+      broadcastPending[i] &= ~bit;
+      sent++;
+    }
+    if (!broadcastPending[i]) broadcastState[i] = climate[i]->next;
+  }
+}
+
+// Hash an MQTT topic. (FNV-1a)
+//
+// Args:
+//   topic: The topic.
+// Returns:
+//   uint32_t: Its hash.
+uint32_t mqttTopicHash(const char *topic) {
+  uint32_t hash = 2166136261UL;
+  for (; *topic; topic++) {
+    hash ^= static_cast<uint8_t>(*topic);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+// Add a topic to the table of topics we are subscribed to.
+// Until the table has been allocated, it only counts what it will need.
+//
+// Args:
+//   topic: The topic.
+//   kind: What it is for.
+//   channel: The transmit channel it is for.
+//   key: Which climate topic it is. See `kMqttTopics`.
+void addMqttTopic(const String topic, const mqtt_topic_kind_t kind,
+                  const uint8_t channel, const uint8_t key) {
+  if (mqttTopicTable == NULL) {  // Just counting.
+    mqttTopicCount++;
+    mqttTopicTextSize += topic.length() + 1;
+    return;
+  }
+  const uint32_t hash = mqttTopicHash(topic.c_str());
+  uint16_t slot = hash & (mqttTopicSlots - 1);
+  while (mqttTopicTable[slot].kind != kMqttTopicNone)
+    slot = (slot + 1) & (mqttTopicSlots - 1);
+  mqtt_topic_t *entry = &mqttTopicTable[slot];
+  entry->hash = hash;
+  entry->text = mqttTopicTextSize;
+  entry->kind = kind;
+  entry->channel = channel;
+  entry->key = key;
+  strcpy(mqttTopicText + mqttTopicTextSize, topic.c_str());
+  mqttTopicTextSize += topic.length() + 1;
+}
 
+// Build the hashed table of the topics we are subscribed to, so the topic of
+// each message received can be found with one hash & one compare, rather
+// than many String operations. It is done once, as they never change.
+// i.e. Twice. Once to count them, & then to add them.
+void buildMqttTopicTable(void) {
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    if (pass) {
+      // Never more than half full, so few topics need more than one probe.
+      mqttTopicSlots = 1;
+      while (mqttTopicSlots < mqttTopicCount * 2) mqttTopicSlots <<= 1;
+      mqttTopicTable = new mqtt_topic_t[mqttTopicSlots];
+      mqttTopicText = new char[mqttTopicTextSize];
+      for (uint16_t i = 0; i < mqttTopicSlots; i++)
+        mqttTopicTable[i].kind = kMqttTopicNone;
+      mqttTopicTextSize = 0;
+    }
+    // The general topics are for the default channel.
+    const uint8_t default_channel = getDefaultIrSendIdx();
+    addMqttTopic(MqttSend, kMqttTopicSend, default_channel);
+    for (uint8_t key = 0; key < kMqttKeyCount; key++)
+      addMqttTopic(MqttClimateCmnd + kMqttTopics[key], kMqttTopicClimateCmnd,
+                   default_channel, key);
+    for (uint8_t i = 0; i < kNrOfIrTxGpios; i++) {
+      if (IrSendTable[i] != NULL)
+        addMqttTopic(MqttSend + '_' + String(i), kMqttTopicSend, i);
+      if (climate[i] == NULL) continue;
+      const String cmnd_topic = MqttClimate + '_' + String(i) + '/' +
+          MQTT_CLIMATE_CMND + '/';
+      const String stat_topic = genStatTopic(i);
+      for (uint8_t key = 0; key < kMqttKeyCount; key++) {
+        addMqttTopic(cmnd_topic + kMqttTopics[key], kMqttTopicClimateCmnd, i,
+                     key);
+        addMqttTopic(stat_topic + kMqttTopics[key], kMqttTopicClimateStat, i,
+                     key);
+      }
+    }
+  }
+}
+
+// Find what an MQTT topic is for.
+//
+// Args:
+//   topic: The topic.
+// Returns:
+//   A ptr to its entry in the table of topics, or NULL if it isn't one of ours.
+const mqtt_topic_t *mqttTopicLookup(const char *topic) {
+  if (mqttTopicTable == NULL) return NULL;
+  const uint32_t hash = mqttTopicHash(topic);
+  for (uint16_t slot = hash & (mqttTopicSlots - 1);
+       mqttTopicTable[slot].kind != kMqttTopicNone;
+       slot = (slot + 1) & (mqttTopicSlots - 1)) {
+    const mqtt_topic_t *entry = &mqttTopicTable[slot];
+    if (entry->hash == hash && !strcmp(mqttTopicText + entry->text, topic))
+      return entry;
+  }
+  return NULL;
+}
+
+void receivingMQTT(const char *topic, String const callback_str) {
   debug("Receiving data by MQTT topic:");
-  debug(topic_name.c_str());
+  debug(topic);
   debug("with payload:");
   debug(callback_str.c_str());
   // Save the message as the last command seen (global).
-  lastMqttCmdTopic = topic_name;
+  lastMqttCmdTopic = topic;
   lastMqttCmd = callback_str;
   lastMqttCmdTime = millis();
   mqttRecvCounter++;
 
-  // Check if a specific channel was requested by looking for a "*_[0-9]" suffix
-  // Or is for a specific ac/climate channel. e.g. "*/ac_[1-9]"
-  debug(("Checking for channel number in " + topic_name).c_str());
-  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
-    if (topic_name.endsWith("_" + String(i)) ||
-        (i > 0 && topic_name.startsWith(MqttClimate + "_" + String(i)))) {
-      channel = i;
-      break;
-    }
+  const mqtt_topic_t *entry = mqttTopicLookup(topic);
+  if (entry == NULL) {
+    debug("It's not a topic we know. Ignoring it.");
+    return;
   }
-  debug(("Channel = " + String(channel)).c_str());
+  // A climate state topic only updates the internal state, so do it now.
+  // e.g. When recovering the retained state after a reboot.
+  if (entry->kind == kMqttTopicClimateStat) {
+    debug("It's a climate state topic. Update internal state and DON'T send");
+    updateClimateKey(&(climate[entry->channel]->next), entry->key,
+                     callback_str);
+    return;  // We are done for now.
+  }
+  // Anything else may need to be sent. That is done later, from `loop()`, so
+  // the MQTT client isn't held up for the time it takes to send it.
+  if (mqttCommandCount >= kMqttCommandQueueSize) {
+    mqttCommandDrops++;
+    mqttLog("MQTT command queue is full. Command dropped!");
+    return;
+  }
+  mqtt_command_t *cmd = &mqttCommandQueue[
+      (mqttCommandHead + mqttCommandCount) % kMqttCommandQueueSize];
+  cmd->topic = *entry;
+  cmd->payload = callback_str;
+  mqttCommandCount++;
+}
+
+// Do the next part of the queued MQTT commands, if it is time to.
+// i.e. At most one IR message, or one climate update, is sent per call.
+// Pauses in a sequence don't block. The queue just waits for them to pass.
+//
+// Returns:
+//   bool: true, if there is still more to do.
+bool handleMqttCommands(void) {
+  if (mqttPauseMs) {
+    if (mqttPauseTime.elapsed() < (uint32_t)mqttPauseMs) return true;
+    // The pause is over, so acknowledge it.
+    mqtt_client.publish(MqttAck.c_str(),
+                        String(kPauseChar + String(mqttPauseMs)).c_str());
+    mqttSentCounter++;
+    mqttPauseMs = 0;
+  }
+  if (!mqttCommandCount) return false;
+  mqtt_command_t *cmd = &mqttCommandQueue[mqttCommandHead];
+  cmd->payload = doMqttCommand(cmd->topic, cmd->payload);
+  if (!cmd->payload.length()) {  // It's all been done.
+    cmd->payload = String();  // Free the memory.
+    mqttCommandHead = (mqttCommandHead + 1) % kMqttCommandQueueSize;
+    mqttCommandCount--;
+  }
+  return mqttCommandCount || mqttPauseMs;
+}
+
+// Do the first part of an MQTT command.
+//
+// Args:
+//   topic:        What the topic it was received on is for.
+//   callback_str: What remains to be done of it. e.g. The rest of a sequence.
+// Returns:
+//   String: What is left to be done of it. "" if it is finished.
+String doMqttCommand(const mqtt_topic_t topic, String const callback_str) {
+  uint64_t code = 0;
+  uint16_t nbits = 0;
+  uint16_t repeat = 0;
+  uint8_t channel = topic.channel;
+
   // Is it a climate topic?
-  if (topic_name.startsWith(MqttClimate)) {
-    String alt_cmnd_topic = MqttClimate + "_" + String(channel) + '/' +
-        MQTT_CLIMATE_CMND + '/';
-    // Also accept climate commands on the '*_0' channel.
-    String cmnd_topic = topic_name.startsWith(alt_cmnd_topic) ? alt_cmnd_topic
-                                                              : MqttClimateCmnd;
-    String stat_topic = genStatTopic(channel);
-    if (topic_name.startsWith(cmnd_topic)) {
-      debug("It's a climate command topic");
-      updateClimate(&(climate[channel]->next), topic_name, cmnd_topic,
-                    callback_str);
-      // Handle the special command for forcing a resend of the state via IR.
-      bool force_resend = false;
-      if (topic_name.equals(cmnd_topic + KEY_RESEND) &&
-          callback_str.equalsIgnoreCase(KEY_RESEND)) {
-        force_resend = true;
-        mqttLog("Climate resend requested.");
-      }
-      if (sendClimate(stat_topic, true, false, force_resend, true,
-                      climate[channel]) && !force_resend)
-        lastClimateSource = F("MQTT");
-    } else if (topic_name.startsWith(stat_topic)) {
-      debug("It's a climate state topic. Update internal state and DON'T send");
-      updateClimate(&(climate[channel]->next), topic_name, stat_topic,
-                    callback_str);
+  if (topic.kind == kMqttTopicClimateCmnd) {
+    debug("It's a climate command topic");
+    updateClimateKey(&(climate[channel]->next), topic.key, callback_str);
+    // Handle the special command for forcing a resend of the state via IR.
+    bool force_resend = false;
+    if (topic.key == kMqttKeyResend &&
+        callback_str.equalsIgnoreCase(KEY_RESEND)) {
+      force_resend = true;
+      mqttLog("Climate resend requested.");
     }
-    return;  // We are done for now.
+    if (sendClimate(genStatTopic(channel), true, false, force_resend, true,
+                    climate[channel]) && !force_resend)
+      lastClimateSource = F("MQTT");
+    return "";  // We are done.
   }
 
   debug(("Using transmit channel " + String(static_cast<int>(channel)) +
          " / GPIO " + String(static_cast<int>(txGpioTable[channel]))).c_str());
-  // Make a copy of the callback string as strtok destroys it.
-  char* callback_c_str = strdup(callback_str.c_str());
   debug("MQTT Payload (raw):");
-  debug(callback_c_str);
-
-  // Chop up the str into command chunks.
-  // i.e. commands in a sequence are delimitered by ';'.
-  char* sequence_tok_ptr;
-  for (char* sequence_item = strtok_r(callback_c_str, kSequenceDelimiter,
-                                      &sequence_tok_ptr);
-       sequence_item != NULL;
-       sequence_item = strtok_r(NULL, kSequenceDelimiter, &sequence_tok_ptr)) {
-    // Now, process each command individually.
-    char* tok_ptr;
-    // Make a copy of the sequence_item str as strtok_r stomps on it.
-    char* ircommand = strdup(sequence_item);
-    // Check if it is a pause command.
-    switch (ircommand[0]) {
-      case kPauseChar:
-        {  // It's a pause. Everything after the 'P' should be a number.
-          int32_t msecs = std::min((int32_t) strtoul(ircommand + 1, NULL, 10),
-                                   kMaxPauseMs);
-          delay(msecs);
-          mqtt_client.publish(MqttAck.c_str(),
-                              String(kPauseChar + String(msecs)).c_str());
-          mqttSentCounter++;
+  debug(callback_str.c_str());
+
+  // Chop off the first command. i.e. commands in a sequence are delimitered
+  // by ';'. The rest are done on later calls.
+  int16_t end = callback_str.indexOf(kSequenceDelimiter);
+  String sequence_item = (end < 0) ? callback_str
+                                   : callback_str.substring(0, end);
+  String remaining = (end < 0) ? "" : callback_str.substring(end + 1);
+  if (!sequence_item.length()) return remaining;  // Nothing to do.
+  char* tok_ptr;
+  // Make a copy of the sequence_item str as strtok_r stomps on it.
+  char* ircommand = strdup(sequence_item.c_str());
+  // Check if it is a pause command.
+  switch (ircommand[0]) {
+    case kPauseChar:
+      {  // It's a pause. Everything after the 'P' should be a number.
+        // It is acknowledged once it is over. See `handleMqttCommands()`.
+        mqttPauseMs = std::min((int32_t) strtoul(ircommand + 1, NULL, 10),
+                               kMaxPauseMs);
+        mqttPauseTime.reset();
+        break;
+      }
+    default:  // It's an IR command.
+      {
+        // Get the numeric protocol type.
+        decode_type_t ir_type = (decode_type_t)atoi(strtok_r(
+            ircommand, kCommandDelimiter, &tok_ptr));
+        char* next = strtok_r(NULL, kCommandDelimiter, &tok_ptr);
+        // If there is unparsed string left, try to convert it assuming it's
+        // hex.
+        if (next != NULL) {
+          code = getUInt64fromHex(next);
+          next = strtok_r(NULL, kCommandDelimiter, &tok_ptr);
+        } else {
+          // We require at least two value in the string. Give up.
           break;
         }
-      default:  // It's an IR command.
-        {
-          // Get the numeric protocol type.
-          decode_type_t ir_type = (decode_type_t)atoi(strtok_r(
-              ircommand, kCommandDelimiter, &tok_ptr));
-          char* next = strtok_r(NULL, kCommandDelimiter, &tok_ptr);
-          // If there is unparsed string left, try to convert it assuming it's
-          // hex.
-          if (next != NULL) {
-            code = getUInt64fromHex(next);
-            next = strtok_r(NULL, kCommandDelimiter, &tok_ptr);
-          } else {
-            // We require at least two value in the string. Give up.
-            break;
-          }
-          // If there is still string left, assume it is the bit size.
-          if (next != NULL) {
-            nbits = atoi(next);
-            next = strtok_r(NULL, kCommandDelimiter, &tok_ptr);
-          }
-          // If there is still string left, assume it is the repeat count.
-          if (next != NULL)
-            repeat = atoi(next);
-          // send received MQTT value by IR signal
-          lastSendSucceeded = sendIRCode(
-              IrSendTable[channel], ir_type, code,
-              strchr(sequence_item, kCommandDelimiter[0]) + 1, nbits, repeat);
+        // If there is still string left, assume it is the bit size.
+        if (next != NULL) {
+          nbits = atoi(next);
+          next = strtok_r(NULL, kCommandDelimiter, &tok_ptr);
         }
-    }
-    free(ircommand);
+        // If there is still string left, assume it is the repeat count.
+        if (next != NULL)
+          repeat = atoi(next);
+        // send received MQTT value by IR signal. It is acknowledged once it
+        // has been sent.
+        lastSendSucceeded = sendIRCode(
+            IrSendTable[channel], ir_type, code,
+            strchr(sequence_item.c_str(), kCommandDelimiter[0]) + 1, nbits,
+            repeat);
+      }
   }
-  free(callback_c_str);
+  free(ircommand);
+  return remaining;
 }
 
 // Callback function, when we receive an MQTT value on the topics
@@ -2541,53 +3325,109 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
 
   // Conversion to a printable string
   payload_copy[length] = '\0';
+#if AIRTIME_ENABLE
+  if (!strcmp(topic, MQTT_AIRTIME)) {  // Not a command. Just note it.
+    airtimeReceived(reinterpret_cast<char*>(payload_copy));
+    free(payload_copy);
+    return;
+  }
+#endif  // AIRTIME_ENABLE
+#ifdef MQTT_PROTOCOLS
+  if (!strncmp(topic, MQTT_PROTOCOLS "/", sizeof(MQTT_PROTOCOLS))) {
+    customProtocolReceived(topic + sizeof(MQTT_PROTOCOLS),
+                           reinterpret_cast<char*>(payload_copy));
+    free(payload_copy);
+    return;
+  }
+#endif  // MQTT_PROTOCOLS
   String callback_string = String(reinterpret_cast<char*>(payload_copy));
-  String topic_name = String(reinterpret_cast<char*>(topic));
 
   // launch the function to treat received data
-  receivingMQTT(topic_name, callback_string);
+  receivingMQTT(topic, callback_string);
 
   // Free the memory
   free(payload_copy);
 }
 
 #if MQTT_DISCOVERY_ENABLE
+// Print a template stored in flash, replacing each "$<n>" in it with the n'th
+// value. e.g. "$0" with values[0]. Only the first 10 values can be used.
+//
+// Args:
+//   output: Where to print it.
+//   tmpl: A ptr to the template, in flash. (PROGMEM)
+//   values: The values to put into it.
+//   nr_of_values: How many there are of them.
+void printTemplate(Print *output, PGM_P tmpl, const char * const values[],
+                   const uint8_t nr_of_values) {
+  for (char c = pgm_read_byte(tmpl); c; c = pgm_read_byte(++tmpl)) {
+    if (c == '$') {
+      const uint8_t value = pgm_read_byte(tmpl + 1) - '0';
+      if (value < nr_of_values) {
+        output->print(values[value]);
+        tmpl++;
+        continue;
+      }
+    }
+    output->write(c);
+  }
+}
+
+// The Home Assistant discovery message. The "$<n>"s are filled in by
+// sendMQTTDiscovery(). (See printTemplate())
+// It stays in flash, rather than being built in memory each time it is sent.
+const char kMqttDiscoveryTemplate[] PROGMEM =
+    "{"
+    "\"~\":\"$0\","
+    "\"name\":\"$1\","
+    "\"pow_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_POWER "\","
+    "\"mode_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_MODE "\","
+    "\"mode_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_MODE "\","
+    // I don't know why, but the modes need to be lower case to work with
+    // Home Assistant & Google Home.
+    "\"modes\":[\"off\",\"auto\",\"cool\",\"heat\",\"dry\",\"fan_only\"],"
+    "\"temp_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_TEMP "\","
+    "\"temp_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_TEMP "\","
+    "\"min_temp\":\"16\","
+    "\"max_temp\":\"30\","
+    "\"temp_step\":\"1\","
+    "\"fan_mode_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_FANSPEED "\","
+    "\"fan_mode_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_FANSPEED "\","
+    "\"fan_modes\":[\"" D_STR_AUTO "\",\"" D_STR_MIN "\",\"" D_STR_LOW "\",\""
+                    D_STR_MEDIUM "\",\"" D_STR_HIGH "\",\"" D_STR_MAX "\"],"
+    "\"swing_mode_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_SWINGV "\","
+    "\"swing_mode_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_SWINGV "\","
+    "\"swing_modes\":[\"" D_STR_OFF "\",\"" D_STR_AUTO "\",\"" D_STR_HIGHEST
+                      "\",\"" D_STR_HIGH "\",\"" D_STR_MIDDLE "\",\""
+                      D_STR_LOW "\",\"" D_STR_LOWEST "\"],"
+    "\"uniq_id\":\"$2\","
+    "\"device\":{"
+      "\"identifiers\":[\"$2\"],"
+      "\"connections\":[[\"mac\",\"$3\"]],"
+      "\"manufacturer\":\"IRremoteESP8266\","
+      "\"model\":\"IRMQTTServer\","
+      "\"name\":\"$4\","
+      "\"sw_version\":\"" _MY_VERSION_ "\""
+      "}"
+    "}";
+
 void sendMQTTDiscovery(const char *topic) {
-  if (mqtt_client.publish(
-      topic, String(
-      "{"
-      "\"~\":\"" + MqttClimate + "\","
-      "\"name\":\"" + MqttHAName + "\","
-      "\"pow_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_POWER "\","
-      "\"mode_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_MODE "\","
-      "\"mode_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_MODE "\","
-      // I don't know why, but the modes need to be lower case to work with
-      // Home Assistant & Google Home.
-      "\"modes\":[\"off\",\"auto\",\"cool\",\"heat\",\"dry\",\"fan_only\"],"
-      "\"temp_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_TEMP "\","
-      "\"temp_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_TEMP "\","
-      "\"min_temp\":\"16\","
-      "\"max_temp\":\"30\","
-      "\"temp_step\":\"1\","
-      "\"fan_mode_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_FANSPEED "\","
-      "\"fan_mode_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_FANSPEED "\","
-      "\"fan_modes\":[\"" D_STR_AUTO "\",\"" D_STR_MIN "\",\"" D_STR_LOW "\",\""
-                      D_STR_MEDIUM "\",\"" D_STR_HIGH "\",\"" D_STR_MAX "\"],"
-      "\"swing_mode_cmd_t\":\"~/" MQTT_CLIMATE_CMND "/" KEY_SWINGV "\","
-      "\"swing_mode_stat_t\":\"~/" MQTT_CLIMATE_STAT "/" KEY_SWINGV "\","
-      "\"swing_modes\":[\"" D_STR_OFF "\",\"" D_STR_AUTO "\",\"" D_STR_HIGHEST
-                        "\",\"" D_STR_HIGH "\",\"" D_STR_MIDDLE "\",\""
-                        D_STR_LOW "\",\"" D_STR_LOWEST "\"],"
-      "\"uniq_id\":\"" + MqttUniqueId + "\","
-      "\"device\":{"
-        "\"identifiers\":[\"" + MqttUniqueId + "\"],"
-        "\"connections\":[[\"mac\",\"" + WiFi.macAddress() + "\"]],"
-        "\"manufacturer\":\"IRremoteESP8266\","
-        "\"model\":\"IRMQTTServer\","
-        "\"name\":\"" + Hostname + "\","
-        "\"sw_version\":\"" _MY_VERSION_ "\""
-        "}"
-      "}").c_str(), true)) {
+  const String mac = WiFi.macAddress();
+  const char * const values[] = {MqttClimate.c_str(), MqttHAName.c_str(),
+                                 MqttUniqueId.c_str(), mac.c_str(), Hostname};
+  const uint8_t nr_of_values = sizeof(values) / sizeof(values[0]);
+  // Size it first, so it can be streamed out, a small buffer at a time.
+  PrintSizer sizer;
+  printTemplate(&sizer, kMqttDiscoveryTemplate, values, nr_of_values);
+  bool success = mqtt_client.beginPublish(topic, sizer.size(), true);
+  if (success) {
+    {
+      BufferedPrint buffer(&mqtt_client);
+      printTemplate(&buffer, kMqttDiscoveryTemplate, values, nr_of_values);
+    }  // Sends what is left in the buffer.
+    success = mqtt_client.endPublish();
+  }
+  if (success) {
     mqttLog("MQTT climate discovery successful sent.");
     hasDiscoveryBeenSent = true;
     lastDiscovery.reset();
@@ -2599,7 +3439,45 @@ void sendMQTTDiscovery(const char *topic) {
 #endif  // MQTT_DISCOVERY_ENABLE
 #endif  // MQTT_ENABLE
 
+#if IR_RX
+// Print a received IR message in the format it is reported in.
+// i.e. "<type>,<value/state in hex>[;<raw timings>][,<bits>]"
+//
+// Args:
+//   output: Where to print it.
+//   results: The received IR message.
+void printIrReceived(Print *output, const decode_results * const results) {
+  output->print(static_cast<int>(results->decode_type));
+  output->print(kCommandDelimiter[0]);
+  resultToHexidecimal(output, results);
+#if REPORT_RAW_UNKNOWNS
+  if (results->decode_type == UNKNOWN) {
+    output->print(';');
+    for (uint16_t i = 1; i < results->rawlen; i++) {
+      uint32_t usecs;
+      for (usecs = results->rawbuf[i] * kRawTick; usecs > UINT16_MAX;
+           usecs -= UINT16_MAX) {
+        output->print(UINT16_MAX);
+        output->print(F(",0,"));
+      }
+      output->print(usecs);
+      if (i < results->rawlen - 1)
+        output->print(',');
+    }
+  }
+#endif  // REPORT_RAW_UNKNOWNS
+  // If it isn't an AC code, add the bits.
+  if (!hasACState(results->decode_type)) {
+    output->print(kCommandDelimiter[0]);
+    output->print(results->bits);
+  }
+}
+#endif  // IR_RX
+
 void loop(void) {
+#if METRICS_ENABLE
+  const uint32_t loopStart = micros();
+#endif  // METRICS_ENABLE
   server.handleClient();  // Handle any web activity
 
 #if MQTT_ENABLE
@@ -2661,39 +3539,45 @@ void loop(void) {
     // Periodically send all of the climate state via MQTT.
     doBroadcast(&lastBroadcast, kBroadcastPeriodMs, climate, false, false);
   }
+  // Send the next part of any queued MQTT commands.
+  const bool busy = handleMqttCommands();
 #endif  // MQTT_ENABLE
 #if IR_RX
   // Check if an IR code has been received via the IR RX module.
-#if REPORT_UNKNOWNS
-  if (irrecv != NULL && irrecv->decode(&capture)) {
-#else  // REPORT_UNKNOWNS
-  if (irrecv != NULL && irrecv->decode(&capture) &&
-      capture.decode_type != UNKNOWN) {
+#if METRICS_ENABLE
+  const uint32_t decodeStart = micros();
+#endif  // METRICS_ENABLE
+#if ENABLE_BUDGETED_DECODE
+  bool received = irrecv != NULL && irrecv->decodeBudget(&capture,
+                                                         kDecodeBudget);
+#else  // ENABLE_BUDGETED_DECODE
+  bool received = irrecv != NULL && irrecv->decode(&capture);
+#endif  // ENABLE_BUDGETED_DECODE
+#if METRICS_ENABLE
+  if (received) {
+    metricsObserve(&decodeTimeHistogram, micros() - decodeStart);
+    if (capture.overflow) captureOverflows++;
+  }
+#endif  // METRICS_ENABLE
+#if !REPORT_UNKNOWNS
+  received = received && capture.decode_type != UNKNOWN;
 #endif  // REPORT_UNKNOWNS
+  if (received) {
     lastIrReceivedTime = millis();
-    lastIrReceived = String(capture.decode_type) + kCommandDelimiter[0] +
-        resultToHexidecimal(&capture);
-#if REPORT_RAW_UNKNOWNS
-    if (capture.decode_type == UNKNOWN) {
-      lastIrReceived += ";";
-      for (uint16_t i = 1; i < capture.rawlen; i++) {
-        uint32_t usecs;
-        for (usecs = capture.rawbuf[i] * kRawTick; usecs > UINT16_MAX;
-             usecs -= UINT16_MAX) {
-          lastIrReceived += uint64ToString(UINT16_MAX);
-          lastIrReceived += ",0,";
-        }
-        lastIrReceived += uint64ToString(usecs, 10);
-        if (i < capture.rawlen - 1)
-          lastIrReceived += ",";
-      }
-    }
-#endif  // REPORT_RAW_UNKNOWNS
-    // If it isn't an AC code, add the bits.
-    if (!hasACState(capture.decode_type))
-      lastIrReceived += kCommandDelimiter[0] + String(capture.bits);
+    // Only the start of it is kept. It would need up to several kilobytes.
+    lastIrReceived = "";
+    PrintSizer sizer(&lastIrReceived);
+    printIrReceived(&sizer, &capture);
+    if (sizer.size() > kLastIrReceivedMaxLen) lastIrReceived += F("...");
 #if MQTT_ENABLE
-    mqtt_client.publish(MqttRecv.c_str(), lastIrReceived.c_str());
+    // Stream it straight into the MQTT message, rather than building it first.
+    if (mqtt_client.beginPublish(MqttRecv.c_str(), sizer.size(), false)) {
+      {
+        BufferedPrint buffer(&mqtt_client);
+        printIrReceived(&buffer, &capture);
+      }  // Sends what is left in the buffer.
+      mqtt_client.endPublish();
+    }
     mqttSentCounter++;
     debug("Incoming IR message sent to MQTT:");
     debug(lastIrReceived.c_str());
@@ -2702,8 +3586,35 @@ void loop(void) {
 #if USE_DECODED_AC_SETTINGS
     if (decodeCommonAc(&capture)) lastClimateSource = F("IR");
 #endif  // USE_DECODED_AC_SETTINGS
+#if WEBSOCKET_ENABLE
+    webSocketPushIr();
+#endif  // WEBSOCKET_ENABLE
   }
 #endif  // IR_RX
+#if CLIMATE_STATE_SAVE_ENABLE
+  // Save any changed climate states, once they have been stable for a while.
+  if (climateStateDirty && climateStateChanged.elapsed() > kClimateSaveDelayMs)
+    saveClimateStates();
+#endif  // CLIMATE_STATE_SAVE_ENABLE
+#if AIRTIME_ENABLE
+  airtimeLoop();
+#endif  // AIRTIME_ENABLE
+#if WEBSOCKET_ENABLE
+  webSocket.loop();
+  // Whatever changed them (HTTP, MQTT, or IR), the web pages hear of it.
+  webSocketPushClimate();
+#endif  // WEBSOCKET_ENABLE
+#if METRICS_ENABLE
+  metricsObserve(&loopTimeHistogram, micros() - loopStart);
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap < heapLowWater) heapLowWater = freeHeap;
+#endif  // METRICS_ENABLE
+#if MQTT_ENABLE
+  if (busy) return;  // Don't delay any queued MQTT commands.
+#endif  // MQTT_ENABLE
+#if AIRTIME_ENABLE
+  if (airtime.pending()) return;  // Don't miss a queued message's time.
+#endif  // AIRTIME_ENABLE
   delay(100);
 }
 
@@ -2756,6 +3667,12 @@ bool sendIRCode(IRsend *irsend, decode_type_t const ir_type,
   if (irrecv != NULL) irrecv->disableIRIn();  // Stop the IR receiver
 #endif  // IR_RX && DISABLE_CAPTURE_WHILE_TRANSMITTING
   // send the IR message.
+#if METRICS_ENABLE
+  const uint32_t sendStart = micros();
+#endif  // METRICS_ENABLE
+#if AIRTIME_ENABLE
+  airtimeRecord();
+#endif  // AIRTIME_ENABLE
   switch (ir_type) {
 #if SEND_PRONTO
     case decode_type_t::PRONTO:  // 25
@@ -2778,6 +3695,20 @@ bool sendIRCode(IRsend *irsend, decode_type_t const ir_type,
       else  // protocols with <= 64 bits
         success = irsend->send(ir_type, code, bits, repeat);
   }
+#if AIRTIME_ENABLE
+  const bool queued = airtimeQueue(irsend);
+  success = success && queued;
+#endif  // AIRTIME_ENABLE
+#if METRICS_ENABLE
+  if (success) {
+    metricsObserve(&sendTimeHistogram, micros() - sendStart);
+#if ENABLE_SEND_TIMING
+    const send_timing_t *timing = irsend->getSendTiming();
+    if (timing->marks)
+      metricsObserve(&sendJitterHistogram, timing->max_error);
+#endif  // ENABLE_SEND_TIMING
+  }
+#endif  // METRICS_ENABLE
 #if IR_RX && DISABLE_CAPTURE_WHILE_TRANSMITTING
   // Turn IR capture back on if we need to.
   if (irrecv != NULL) irrecv->enableIRIn();  // Restart the receiver
@@ -2873,36 +3804,17 @@ bool sendFloat(const String topic, const float_t temp, const bool retain) {
 }
 
 #if MQTT_CLIMATE_JSON
-void sendJsonState(const stdAc::state_t state, const String topic,
+void sendJsonState(stdAc::state_t state, const String topic,
                    const bool retain, const bool ha_mode) {
-  DynamicJsonDocument json(kJsonAcStateMaxSize);
-  json[KEY_PROTOCOL] = typeToString(state.protocol);
-  json[KEY_MODEL] = state.model;
-  json[KEY_POWER] = IRac::boolToString(state.power);
-  json[KEY_MODE] = IRac::opmodeToString(state.mode);
   // Home Assistant wants mode to be off if power is also off & vice-versa.
   if (ha_mode && (state.mode == stdAc::opmode_t::kOff || !state.power)) {
-    json[KEY_MODE] = IRac::opmodeToString(stdAc::opmode_t::kOff);
-    json[KEY_POWER] = IRac::boolToString(false);
-  }
-  json[KEY_CELSIUS] = IRac::boolToString(state.celsius);
-  json[KEY_TEMP] = state.degrees;
-  json[KEY_FANSPEED] = IRac::fanspeedToString(state.fanspeed);
-  json[KEY_SWINGV] = IRac::swingvToString(state.swingv);
-  json[KEY_SWINGH] = IRac::swinghToString(state.swingh);
-  json[KEY_QUIET] = IRac::boolToString(state.quiet);
-  json[KEY_TURBO] = IRac::boolToString(state.turbo);
-  json[KEY_ECONO] = IRac::boolToString(state.econo);
-  json[KEY_LIGHT] = IRac::boolToString(state.light);
-  json[KEY_FILTER] = IRac::boolToString(state.filter);
-  json[KEY_CLEAN] = IRac::boolToString(state.clean);
-  json[KEY_BEEP] = IRac::boolToString(state.beep);
-  json[KEY_SLEEP] = state.sleep;
-
-  String payload = "";
-  payload.reserve(200);
-  serializeJson(json, payload);
-  sendString(topic, payload, retain);
+    state.mode = stdAc::opmode_t::kOff;
+    state.power = false;
+  }
+  // Serialise it into a fixed buffer, rather than building a JSON document.
+  char payload[kIRacStateJsonSize];
+  if (IRac::stateToJson(state, payload, sizeof(payload)))
+    sendString(topic, payload, retain);
 }
 
 bool validJsonStr(DynamicJsonDocument doc, const char* key) {
@@ -2964,51 +3876,197 @@ stdAc::state_t jsonToState(const stdAc::state_t current, const char *str) {
 
 void updateClimate(stdAc::state_t *state, const String str,
                    const String prefix, const String payload) {
+  if (!str.startsWith(prefix)) return;
+  const char *key = str.c_str() + prefix.length();
+  for (uint8_t i = 0; i < kMqttKeyCount; i++)
+    if (!strcmp(key, kMqttTopics[i])) {
+      updateClimateKey(state, i, payload);
+      return;
+    }
+}
+
+// Update a climate state with the value of one of its topics.
+//
+// Args:
+//   state: The state to update.
+//   key: Which topic it is. See `kMqttTopics`.
+//   payload: The value.
+void updateClimateKey(stdAc::state_t *state, const uint8_t key,
+                      const String payload) {
+  switch (key) {
 #if MQTT_CLIMATE_JSON
-  if (str.equals(prefix + KEY_JSON))
-    *state = jsonToState(*state, payload.c_str());
-  else
+    case kMqttKeyJson:
+      *state = jsonToState(*state, payload.c_str());
+      break;
 #endif  // MQTT_CLIMATE_JSON
-  if (str.equals(prefix + KEY_PROTOCOL)) {
-    state->protocol = strToDecodeType(payload.c_str());
-  } else if (str.equals(prefix + KEY_MODEL)) {
-    state->model = IRac::strToModel(payload.c_str());
-  } else if (str.equals(prefix + KEY_POWER)) {
-    state->power = IRac::strToBool(payload.c_str());
+    case kMqttKeyProtocol:
+      state->protocol = strToDecodeType(payload.c_str());
+      break;
+    case kMqttKeyModel:
+      state->model = IRac::strToModel(payload.c_str());
+      break;
+    case kMqttKeyPower:
+      state->power = IRac::strToBool(payload.c_str());
 #if MQTT_CLIMATE_HA_MODE
-    if (!state->power) state->mode = stdAc::opmode_t::kOff;
+      if (!state->power) state->mode = stdAc::opmode_t::kOff;
 #endif  // MQTT_CLIMATE_HA_MODE
-  } else if (str.equals(prefix + KEY_MODE)) {
-    state->mode = IRac::strToOpmode(payload.c_str());
+      break;
+    case kMqttKeyMode:
+      state->mode = IRac::strToOpmode(payload.c_str());
 #if MQTT_CLIMATE_HA_MODE
-    state->power = (state->mode != stdAc::opmode_t::kOff);
+      state->power = (state->mode != stdAc::opmode_t::kOff);
+#endif  // MQTT_CLIMATE_HA_MODE
+      break;
+    case kMqttKeyTemp:
+      state->degrees = payload.toFloat();
+      break;
+    case kMqttKeyFanspeed:
+      state->fanspeed = IRac::strToFanspeed(payload.c_str());
+      break;
+    case kMqttKeySwingv:
+      state->swingv = IRac::strToSwingV(payload.c_str());
+      break;
+    case kMqttKeySwingh:
+      state->swingh = IRac::strToSwingH(payload.c_str());
+      break;
+    case kMqttKeyQuiet:
+      state->quiet = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyTurbo:
+      state->turbo = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyEcono:
+      state->econo = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyLight:
+      state->light = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyBeep:
+      state->beep = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyFilter:
+      state->filter = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyClean:
+      state->clean = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeyCelsius:
+      state->celsius = IRac::strToBool(payload.c_str());
+      break;
+    case kMqttKeySleep:
+      state->sleep = payload.toInt();
+      break;
+  }
+}
+
+// Has a climate stat topic's value changed between two states?
+//
+// Args:
+//   field: Which stat topic. See `climate_field_t`.
+//   a: A state to compare.
+//   b: The other state to compare.
+// Returns:
+//   bool: true, if the topic's value differs.
+bool climateFieldChanged(const uint8_t field, const stdAc::state_t a,
+                         const stdAc::state_t b) {
+  switch (field) {
+    case kClimateProtocol: return a.protocol != b.protocol;
+    case kClimateModel: return a.model != b.model;
+#if MQTT_CLIMATE_HA_MODE
+    // Home Assistant want's these two bound together.
+    case kClimatePower:
+    case kClimateMode: return a.power != b.power || a.mode != b.mode;
+#else  // MQTT_CLIMATE_HA_MODE
+    // In non-Home Assistant mode, power and mode are not bound together.
+    case kClimatePower: return a.power != b.power;
+    case kClimateMode: return a.mode != b.mode;
 #endif  // MQTT_CLIMATE_HA_MODE
-  } else if (str.equals(prefix + KEY_TEMP)) {
-    state->degrees = payload.toFloat();
-  } else if (str.equals(prefix + KEY_FANSPEED)) {
-    state->fanspeed = IRac::strToFanspeed(payload.c_str());
-  } else if (str.equals(prefix + KEY_SWINGV)) {
-    state->swingv = IRac::strToSwingV(payload.c_str());
-  } else if (str.equals(prefix + KEY_SWINGH)) {
-    state->swingh = IRac::strToSwingH(payload.c_str());
-  } else if (str.equals(prefix + KEY_QUIET)) {
-    state->quiet = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_TURBO)) {
-    state->turbo = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_ECONO)) {
-    state->econo = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_LIGHT)) {
-    state->light = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_BEEP)) {
-    state->beep = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_FILTER)) {
-    state->filter = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_CLEAN)) {
-    state->clean = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_CELSIUS)) {
-    state->celsius = IRac::strToBool(payload.c_str());
-  } else if (str.equals(prefix + KEY_SLEEP)) {
-    state->sleep = payload.toInt();
+    case kClimateTemp: return a.degrees != b.degrees;
+    case kClimateCelsius: return a.celsius != b.celsius;
+    case kClimateFanspeed: return a.fanspeed != b.fanspeed;
+    case kClimateSwingv: return a.swingv != b.swingv;
+    case kClimateSwingh: return a.swingh != b.swingh;
+    case kClimateQuiet: return a.quiet != b.quiet;
+    case kClimateTurbo: return a.turbo != b.turbo;
+    case kClimateEcono: return a.econo != b.econo;
+    case kClimateLight: return a.light != b.light;
+    case kClimateFilter: return a.filter != b.filter;
+    case kClimateClean: return a.clean != b.clean;
+    case kClimateBeep: return a.beep != b.beep;
+    case kClimateSleep: return a.sleep != b.sleep;
+    default: return false;
+  }
+}
+
+// Publish the value of a climate stat topic.
+//
+// Args:
+//   topic_prefix: The stat topic of the climate channel.
+//   field: Which stat topic. See `climate_field_t`.
+//   state: The state to publish it from.
+//   retain: Do we ask the MQTT broker to retain it?
+// Returns:
+//   bool: Successfully published or not.
+bool sendClimateField(const String topic_prefix, const uint8_t field,
+                      const stdAc::state_t state, const bool retain) {
+  switch (field) {
+    case kClimateProtocol:
+      return sendString(topic_prefix + KEY_PROTOCOL,
+                        typeToString(state.protocol), retain);
+    case kClimateModel:
+      return sendInt(topic_prefix + KEY_MODEL, state.model, retain);
+    case kClimatePower:
+      return sendBool(topic_prefix + KEY_POWER, state.power, retain);
+    case kClimateMode: {
+      String mode_str = IRac::opmodeToString(state.mode);
+      // I don't know why, but the modes need to be lower case to work with
+      // Home Assistant & Google Home.
+      mode_str.toLowerCase();
+#if MQTT_CLIMATE_HA_MODE
+      if (!state.power) mode_str = F("off");
+#endif  // MQTT_CLIMATE_HA_MODE
+      return sendString(topic_prefix + KEY_MODE, mode_str, retain);
+    }
+    case kClimateTemp:
+      return sendFloat(topic_prefix + KEY_TEMP, state.degrees, retain);
+    case kClimateCelsius:
+      return sendBool(topic_prefix + KEY_CELSIUS, state.celsius, retain);
+    case kClimateFanspeed:
+      return sendString(topic_prefix + KEY_FANSPEED,
+                        IRac::fanspeedToString(state.fanspeed), retain);
+    case kClimateSwingv:
+      return sendString(topic_prefix + KEY_SWINGV,
+                        IRac::swingvToString(state.swingv), retain);
+    case kClimateSwingh:
+      return sendString(topic_prefix + KEY_SWINGH,
+                        IRac::swinghToString(state.swingh), retain);
+    case kClimateQuiet:
+      return sendBool(topic_prefix + KEY_QUIET, state.quiet, retain);
+    case kClimateTurbo:
+      return sendBool(topic_prefix + KEY_TURBO, state.turbo, retain);
+    case kClimateEcono:
+      return sendBool(topic_prefix + KEY_ECONO, state.econo, retain);
+    case kClimateLight:
+      return sendBool(topic_prefix + KEY_LIGHT, state.light, retain);
+    case kClimateFilter:
+      return sendBool(topic_prefix + KEY_FILTER, state.filter, retain);
+    case kClimateClean:
+      return sendBool(topic_prefix + KEY_CLEAN, state.clean, retain);
+    case kClimateBeep:
+      return sendBool(topic_prefix + KEY_BEEP, state.beep, retain);
+    case kClimateSleep:
+      return sendInt(topic_prefix + KEY_SLEEP, state.sleep, retain);
+#if REPORT_VCC
+    case kClimateVcc:
+      return sendString(topic_prefix + KEY_VCC, vccToString(), false);
+#endif  // REPORT_VCC
+#if MQTT_CLIMATE_JSON
+    case kClimateJson:
+      sendJsonState(state, topic_prefix + KEY_JSON);
+      return true;
+#endif  // MQTT_CLIMATE_JSON
+    default:
+      return true;
   }
 }
 
@@ -3019,90 +4077,18 @@ bool sendClimate(const String topic_prefix, const bool retain,
   bool success = true;
   const stdAc::state_t next = ac->getState();
   const stdAc::state_t prev = ac->getStatePrev();
-  if (prev.protocol != next.protocol || forceMQTT) {
-    diff = true;
-    success &= sendString(topic_prefix + KEY_PROTOCOL,
-                          typeToString(next.protocol), retain);
-  }
-  if (prev.model != next.model || forceMQTT) {
-    diff = true;
-    success &= sendInt(topic_prefix + KEY_MODEL, next.model, retain);
-  }
-  String mode_str = IRac::opmodeToString(next.mode);
-  // I don't know why, but the modes need to be lower case to work with
-  // Home Assistant & Google Home.
-  mode_str.toLowerCase();
-#if MQTT_CLIMATE_HA_MODE
-  // Home Assistant want's these two bound together.
-  if (prev.power != next.power || prev.mode != next.mode || forceMQTT) {
-    success &= sendBool(topic_prefix + KEY_POWER, next.power, retain);
-    if (!next.power) mode_str = F("off");
-#else  // MQTT_CLIMATE_HA_MODE
-  // In non-Home Assistant mode, power and mode are not bound together.
-  if (prev.power != next.power || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_POWER, next.power, retain);
-  }
-  if (prev.mode != next.mode || forceMQTT) {
-#endif  // MQTT_CLIMATE_HA_MODE
-    success &= sendString(topic_prefix + KEY_MODE, mode_str, retain);
-    diff = true;
-  }
-  if (prev.degrees != next.degrees || forceMQTT) {
-    diff = true;
-    success &= sendFloat(topic_prefix + KEY_TEMP, next.degrees, retain);
-  }
-  if (prev.celsius != next.celsius || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_CELSIUS, next.celsius, retain);
-  }
-  if (prev.fanspeed != next.fanspeed || forceMQTT) {
-    diff = true;
-    success &= sendString(topic_prefix + KEY_FANSPEED,
-                          IRac::fanspeedToString(next.fanspeed), retain);
-  }
-  if (prev.swingv != next.swingv || forceMQTT) {
-    diff = true;
-    success &= sendString(topic_prefix + KEY_SWINGV,
-                          IRac::swingvToString(next.swingv), retain);
-  }
-  if (prev.swingh != next.swingh || forceMQTT) {
-    diff = true;
-    success &= sendString(topic_prefix + KEY_SWINGH,
-                          IRac::swinghToString(next.swingh), retain);
-  }
-  if (prev.quiet != next.quiet || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_QUIET, next.quiet, retain);
-  }
-  if (prev.turbo != next.turbo || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_TURBO, next.turbo, retain);
-  }
-  if (prev.econo != next.econo || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_ECONO, next.econo, retain);
-  }
-  if (prev.light != next.light || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_LIGHT, next.light, retain);
-  }
-  if (prev.filter != next.filter || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_FILTER, next.filter, retain);
-  }
-  if (prev.clean != next.clean || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_CLEAN, next.clean, retain);
-  }
-  if (prev.beep != next.beep || forceMQTT) {
-    diff = true;
-    success &= sendBool(topic_prefix + KEY_BEEP, next.beep, retain);
-  }
-  if (prev.sleep != next.sleep || forceMQTT) {
-    diff = true;
-    success &= sendInt(topic_prefix + KEY_SLEEP, next.sleep, retain);
+  for (uint8_t field = 0; field <= kClimateSleep; field++) {
+    if (forceMQTT || climateFieldChanged(field, prev, next)) {
+      diff = true;
+      success &= sendClimateField(topic_prefix, field, next, retain);
+    }
   }
+#if MQTT_ENABLE
+  // Note what the stat topics now hold, so broadcasts can skip them.
+  for (uint16_t i = 0; success && i < kNrOfIrTxGpios; i++)
+    if (climate[i] == ac && topic_prefix.equals(genStatTopic(i)))
+      broadcastState[i] = next;
+#endif  // MQTT_ENABLE
   if (diff && !forceMQTT) {
     debug("Difference in common A/C state detected.");
 #if MQTT_CLIMATE_JSON
@@ -3123,7 +4109,24 @@ bool sendClimate(const String topic_prefix, const bool retain,
     // Turn IR capture off if we need to.
     if (irrecv != NULL) irrecv->disableIRIn();  // Stop the IR receiver
 #endif  // IR_RX && DISABLE_CAPTURE_WHILE_TRANSMITTING
+#if METRICS_ENABLE
+    const uint32_t sendStart = micros();
+#endif  // METRICS_ENABLE
+#if AIRTIME_ENABLE
+    IRsend *climate_irsend = airtimeIrSend(ac);
+    if (climate_irsend != NULL) airtimeRecord();
+#endif  // AIRTIME_ENABLE
     lastClimateSucceeded = ac->sendAc();
+#if AIRTIME_ENABLE
+    if (climate_irsend != NULL) {
+      const bool queued = airtimeQueue(climate_irsend);
+      lastClimateSucceeded = lastClimateSucceeded && queued;
+    }
+#endif  // AIRTIME_ENABLE
+#if METRICS_ENABLE
+    if (lastClimateSucceeded)
+      metricsObserve(&sendTimeHistogram, micros() - sendStart);
+#endif  // METRICS_ENABLE
 #if IR_RX && DISABLE_CAPTURE_WHILE_TRANSMITTING
     // Turn IR capture back on if we need to.
     if (irrecv != NULL) irrecv->enableIRIn();  // Restart the receiver
@@ -3135,11 +4138,127 @@ bool sendClimate(const String topic_prefix, const bool retain,
   }
   // Mark the "next" value as old/previous.
   if (ac != NULL) {
+#if CLIMATE_STATE_SAVE_ENABLE
+    if (ac->hasStateChanged()) {  // Save it to flash once it has settled.
+      climateStateDirty = true;
+      climateStateChanged.reset();
+    }
+#endif  // CLIMATE_STATE_SAVE_ENABLE
     ac->markAsSent();
   }
   return success;
 }
 
+#if AIRTIME_ENABLE
+// Record the IR message about to be sent, rather than sending it. It is sent
+// later, in its time. See `airtimeQueue()`.
+void airtimeRecord(void) {
+  if (airtimeFrame != NULL) IRsend::startRecordingAll(airtimeFrame);
+}
+
+// Queue the IR message recorded since `airtimeRecord()`, for its time.
+//
+// Args:
+//   irsend: What to send it with.
+// Returns:
+//   bool: true, if it was queued (or sent, if it couldn't be recorded).
+bool airtimeQueue(IRsend *irsend) {
+  if (airtimeFrame == NULL) return true;  // It was sent as it was.
+  if (!IRsend::stopRecordingAll()) {
+    debug("IR message is too long for air time sharing. Not sent!");
+    return false;
+  }
+  if (!airtime.add(irsend, airtimeFrame)) {
+    debug("Too many IR messages are waiting for air time. Not sent!");
+    return false;
+  }
+  return true;
+}
+
+// Find the IR sender of a climate's GPIO.
+//
+// Args:
+//   ac: The climate.
+// Returns:
+//   A Ptr to it, or NULL if there isn't one.
+IRsend *airtimeIrSend(const IRac *ac) {
+  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++)
+    if (climate[i] == ac) return IrSendTable[i];
+  return NULL;
+}
+
+// Keep the shared clock in step, tell the other nodes when we will send, &
+// send what is due.
+void airtimeLoop(void) {
+  if (!airtime.isSynced() || airtimeSynced.elapsed() > kAirtimeSyncMs) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    if (now.tv_sec > (time_t)kAirtimeValidTime) {  // NTP has set it.
+      airtime.setTime((uint64_t)now.tv_sec * 1000 + now.tv_usec / 1000);
+      airtimeSynced.reset();
+    }
+  }
+#if MQTT_ENABLE
+  ir_airtime_reservation_t reservation;
+  while (mqtt_client.connected() && airtime.announce(&reservation)) {
+    // i.e. "<node>,<start>,<duration>"
+    mqtt_client.publish(MQTT_AIRTIME,
+                        (String(reservation.node) + kCommandDelimiter[0] +
+                         uint64ToString(reservation.start) +
+                         kCommandDelimiter[0] +
+                         String(reservation.duration)).c_str());
+    mqttSentCounter++;
+  }
+#endif  // MQTT_ENABLE
+  airtime.handle();
+}
+
+#if MQTT_ENABLE
+// Note the reservation another node published. See `airtimeLoop()`.
+//
+// Args:
+//   payload: The message. i.e. "<node>,<start>,<duration>"
+void airtimeReceived(const char *payload) {
+  uint64_t values[3] = {0, 0, 0};
+  uint8_t field = 0;
+  for (const char *c = payload; *c; c++) {
+    if (*c == kCommandDelimiter[0] && field < 2)
+      field++;
+    else if (*c >= '0' && *c <= '9')
+      values[field] = values[field] * 10 + (*c - '0');
+    else
+      return;  // It isn't one.
+  }
+  if (field != 2) return;
+  ir_airtime_reservation_t reservation;
+  reservation.node = values[0];
+  reservation.start = values[1];
+  reservation.duration = values[2];
+  airtime.addReservation(reservation);
+}
+#endif  // MQTT_ENABLE
+#endif  // AIRTIME_ENABLE
+
+#ifdef MQTT_PROTOCOLS
+// Register (or remove) a protocol published on the `MQTT_PROTOCOLS` topic.
+//
+// Args:
+//   name: The protocol's name. i.e. The last level of the topic.
+//   values: The message. Its `ircustom::add()` values. Empty to remove it.
+void customProtocolReceived(const char *name, const char *values) {
+  if (!*values) {
+    if (ircustom::remove(ircustom::find(name)))
+      mqttLog((String(F("Removed protocol: ")) + name).c_str());
+    return;
+  }
+  const String spec = String(name) + kCommandDelimiter[0] + values;
+  if (ircustom::add(spec.c_str()) != decode_type_t::UNKNOWN)
+    mqttLog((String(F("Registered protocol: ")) + spec).c_str());
+  else
+    mqttLog((String(F("Invalid protocol: ")) + spec).c_str());
+}
+#endif  // MQTT_PROTOCOLS
+
 #if USE_DECODED_AC_SETTINGS && IR_RX
 // Decode and use a valid IR A/C remote that we understand enough to convert
 // to a Common A/C format.
@@ -0,0 +1,36 @@
+// The script of the pages that are kept up to date over the WebSocket.
+// The messages it handles are:
+//   {"channel":0,"temp":24,"mode":"Cool"}  The climate fields that changed,
+//                                          with the values the forms use.
+//   {"ir":"...","count":12}  The IR message just received, & the total.
+(function() {
+  var script = document.currentScript;
+  var port = script.getAttribute('data-port');
+  var channel = script.getAttribute('data-channel');
+
+  function set(id, text) {
+    var e = document.getElementById(id);
+    if (e) e.textContent = text;
+  }
+
+  function connect() {
+    var ws = new WebSocket('ws://' + location.hostname + ':' + port + '/');
+    ws.onmessage = function(event) {
+      var msg = JSON.parse(event.data);
+      if ('ir' in msg) {
+        set('ir', msg.ir);
+        set('irs', msg.count);
+        set('irt', '');
+      }
+      var form = document.getElementById('ac' + msg[channel]);
+      if (!form) return;
+      for (var key in msg)
+        if (key != channel && form.elements[key])
+          form.elements[key].value = msg[key];
+    };
+    // Reconnect if the device restarts etc.
+    ws.onclose = function() { setTimeout(connect, 5000); };
+  }
+
+  connect();
+})();
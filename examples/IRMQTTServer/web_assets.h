@@ -0,0 +1,82 @@
+// Copyright 2026 The IRremoteESP8266 authors
+// The static files of the web app, gzip compressed. See `web_asset_t`.
+//
+// WARNING: Do not edit this file! This file is automatically generated by
+//          'tools/web_assets.py'. Regenerate it whenever the files change,
+//          with:
+//   tools/web_assets.py -o examples/IRMQTTServer/web_assets.h examples/IRMQTTServer/web/live.js
+
+#ifndef EXAMPLES_IRMQTTSERVER_WEB_ASSETS_H_
+#define EXAMPLES_IRMQTTSERVER_WEB_ASSETS_H_
+
+#include <Arduino.h>
+
+// A static file of the web app.
+typedef struct {
+  const char *path;  // Its URL.
+  const char *type;  // Its Content-Type.
+  const char *version;  // A hash of its contents.
+  const uint8_t *data;  // Its gzip compressed contents. (PROGMEM)
+  uint32_t size;  // Nr. of bytes of `data`.
+} web_asset_t;
+
+// /live.js: 1228 bytes, 596 compressed.
+const uint8_t kWebAsset0[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8D, 0x53,
+  0x3D, 0x6F, 0xDB, 0x30, 0x10, 0xDD, 0xFD, 0x2B, 0x2E, 0x1A, 0x2C, 0x19,
+  0x75, 0x69, 0x37, 0x68, 0x17, 0x19, 0x1E, 0xDA, 0xA0, 0x43, 0x3A, 0xB4,
+  0x40, 0x12, 0xA0, 0x43, 0x90, 0x81, 0xA1, 0xCE, 0x36, 0x6B, 0x49, 0x34,
+  0xC8, 0x93, 0xDD, 0x20, 0xF0, 0x7F, 0xEF, 0x1D, 0xF5, 0x61, 0x1B, 0x2D,
+  0x82, 0x7A, 0xB0, 0x24, 0xBE, 0x77, 0xEF, 0x3D, 0x1E, 0x8F, 0xB3, 0x19,
+  0x3C, 0x6C, 0x10, 0x82, 0xF1, 0x76, 0x47, 0xE0, 0x56, 0x40, 0xFC, 0xB5,
+  0xD3, 0x6B, 0x0C, 0xFC, 0xA6, 0x09, 0xB4, 0x47, 0xD8, 0x22, 0x43, 0xCD,
+  0x0E, 0xC8, 0x41, 0xA1, 0x09, 0xC1, 0xED, 0xD1, 0x47, 0xDE, 0x4F, 0x7C,
+  0xBE, 0x77, 0x66, 0x8B, 0xA4, 0x46, 0xB3, 0x56, 0xA7, 0xC2, 0x10, 0x62,
+  0xB1, 0x25, 0xD8, 0xE8, 0xBA, 0x28, 0xF9, 0x95, 0x25, 0x72, 0xC1, 0x01,
+  0x5E, 0x13, 0xC3, 0x8B, 0x35, 0x96, 0x49, 0x3E, 0x9F, 0x26, 0x84, 0xD5,
+  0x2E, 0xC9, 0xAF, 0x3F, 0x4E, 0x93, 0xCA, 0x15, 0x98, 0xE4, 0xC9, 0x8D,
+  0x73, 0x65, 0x72, 0x84, 0x28, 0x64, 0x4A, 0x5B, 0x89, 0xD7, 0xCA, 0x62,
+  0x59, 0x74, 0x59, 0xA4, 0x78, 0x8D, 0xC5, 0xB4, 0x15, 0xFB, 0xCF, 0xDF,
+  0xC1, 0xD2, 0x26, 0x86, 0xDD, 0xEB, 0xB2, 0x89, 0xBB, 0x62, 0x51, 0xE7,
+  0xAB, 0x00, 0x4D, 0x40, 0xD5, 0xE7, 0xB2, 0x9E, 0xFD, 0x95, 0x52, 0xC9,
+  0x34, 0x31, 0xAE, 0xA9, 0x29, 0xC9, 0x3F, 0x5C, 0x77, 0x49, 0x6E, 0xEF,
+  0xFA, 0x5D, 0xC1, 0xAF, 0x26, 0x10, 0x78, 0x34, 0x68, 0xF7, 0x1C, 0x03,
+  0xC6, 0x51, 0x8C, 0x1C, 0xE9, 0x52, 0x8D, 0xB2, 0x55, 0x53, 0x1B, 0xB2,
+  0xAE, 0xCE, 0x26, 0xF0, 0x3A, 0x02, 0xB6, 0xF3, 0x7D, 0x57, 0x97, 0x50,
+  0x38, 0xD3, 0x54, 0x58, 0x93, 0x32, 0x8D, 0xF7, 0xFC, 0xBC, 0x8F, 0xC0,
+  0xA2, 0xA3, 0xED, 0x9C, 0x17, 0x52, 0xCB, 0x56, 0x6B, 0xA4, 0xCF, 0x44,
+  0xDE, 0x3E, 0x37, 0x84, 0x59, 0xCA, 0x0D, 0xD7, 0xEF, 0x85, 0x90, 0x4E,
+  0x7A, 0x7A, 0xD7, 0xC3, 0x37, 0x2B, 0x3A, 0x8E, 0x14, 0x71, 0x55, 0x1F,
+  0x0D, 0x02, 0x52, 0x66, 0x39, 0x39, 0xE1, 0x6F, 0x6A, 0x63, 0xB6, 0x92,
+  0x78, 0x9E, 0x91, 0xE5, 0xBE, 0x96, 0x28, 0xAF, 0x5F, 0x5E, 0x6E, 0x0B,
+  0xE6, 0x47, 0x67, 0x00, 0xBB, 0x82, 0x0C, 0x27, 0x80, 0x4A, 0xAA, 0x6F,
+  0x5C, 0x4D, 0xCC, 0xE0, 0x3A, 0xF9, 0x12, 0xC2, 0xF1, 0xC2, 0xC9, 0x38,
+  0xF6, 0x37, 0x94, 0x9D, 0xBB, 0x1C, 0x02, 0xD3, 0x6B, 0x3C, 0x9C, 0xE6,
+  0x26, 0x4B, 0x0F, 0x21, 0x9F, 0xCD, 0x52, 0x78, 0x07, 0xA5, 0x33, 0x5A,
+  0x2A, 0xD5, 0xC6, 0x05, 0xAA, 0x75, 0x85, 0xBC, 0x96, 0xE6, 0x82, 0xC4,
+  0xF6, 0xF0, 0xC7, 0x2C, 0xED, 0x82, 0x1C, 0x82, 0x72, 0x75, 0x7F, 0x26,
+  0xCB, 0xC1, 0x33, 0xC3, 0x3D, 0x27, 0xEA, 0x0D, 0x5B, 0xCB, 0x2A, 0xAC,
+  0x99, 0xF1, 0xED, 0xFE, 0xC7, 0x77, 0xB5, 0xD3, 0x3E, 0x60, 0xCB, 0x51,
+  0xD2, 0xA3, 0x4E, 0xAC, 0xDD, 0x57, 0x6A, 0x7D, 0x0A, 0xB6, 0x16, 0xFE,
+  0x49, 0x00, 0x62, 0xBF, 0x04, 0x9A, 0x0A, 0xA0, 0xAC, 0x1F, 0x6A, 0x06,
+  0x28, 0x74, 0x58, 0x9C, 0x9A, 0xBF, 0x61, 0x62, 0x38, 0x4D, 0x87, 0xF5,
+  0xE3, 0x59, 0x34, 0x19, 0xC2, 0x37, 0xDA, 0x9E, 0x6A, 0x23, 0x9B, 0x67,
+  0xED, 0xC7, 0xEE, 0x30, 0x9F, 0x2E, 0x12, 0x5F, 0x49, 0xFD, 0x84, 0xA7,
+  0x91, 0x1A, 0x5F, 0xF7, 0x00, 0xAF, 0x41, 0x26, 0xE2, 0x5B, 0x7C, 0xE9,
+  0xB7, 0x33, 0x44, 0x92, 0x2A, 0x59, 0xBF, 0x5A, 0x0E, 0x23, 0x34, 0x1E,
+  0xC7, 0x18, 0x0A, 0x5B, 0xE3, 0xF0, 0xC8, 0xF8, 0xD3, 0xA9, 0x02, 0xFE,
+  0x81, 0xAA, 0x78, 0x8F, 0x38, 0xB8, 0x24, 0x93, 0x85, 0xD6, 0xFB, 0xD8,
+  0x3E, 0xF8, 0x3A, 0xDD, 0x61, 0x77, 0xF6, 0x62, 0x28, 0x17, 0xA4, 0xC0,
+  0xBD, 0x35, 0xC8, 0x49, 0x03, 0x69, 0x4F, 0x01, 0x90, 0x8C, 0x3A, 0x9D,
+  0xA3, 0x29, 0x5D, 0xB8, 0x38, 0x45, 0xEE, 0xBF, 0x74, 0xEF, 0xC1, 0x56,
+  0xE8, 0x1A, 0xCA, 0x3A, 0xB1, 0x29, 0x7C, 0x9A, 0xCF, 0xE7, 0x93, 0x45,
+  0x6B, 0x14, 0x67, 0x6D, 0x18, 0xB1, 0xC5, 0xE8, 0x38, 0x91, 0xFF, 0x3F,
+  0xDD, 0x54, 0xD7, 0x64, 0xCC, 0x04, 0x00, 0x00,
+};
+
+const web_asset_t kWebAssets[] = {
+  {"/live.js", "application/javascript", "a463ef59", kWebAsset0, 596},
+};
+const uint8_t kWebAssetCount = sizeof(kWebAssets) / sizeof(kWebAssets[0]);
+
+#endif  // EXAMPLES_IRMQTTSERVER_WEB_ASSETS_H_
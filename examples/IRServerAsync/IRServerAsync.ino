@@ -0,0 +1,293 @@
+/*
+ * IRremoteESP8266: IRServerAsync - send IR codes from an asynchronous webserver
+ * Version 0.1 October, 2026
+ * Copyright 2015 Mark Szabo
+ * Copyright 2019 David Conran
+ *
+ * The same as the IRServer example, but built on the ESPAsyncWebServer
+ * library. i.e. Requests are served in the background, by the TCP stack,
+ * rather than by polling `server.handleClient()` in `loop()`.
+ * A request to send a code only queues it, & returns straight away with an
+ * id for it. `loop()` sends the queued codes, one at a time. So neither a slow
+ * client, nor a long IR message, holds up any other request.
+ *
+ * Requires the ESPAsyncWebServer library, and ESPAsyncTCP (ESP8266) or
+ * AsyncTCP (ESP32). See platformio.ini.
+ *
+ * Endpoints:
+ *   /                 A demo page.
+ *   /ir?code=N        Queue NEC code N (in decimal) to be sent. The code arg.
+ *                     may be repeated to queue several. Replies 202 with
+ *                     {"id":<id of the last one>,"queued":<nr. waiting>}, or
+ *                     503 if the queue is full.
+ *   /status?id=N      Poll whether message N has been sent yet.
+ *                     Replies {"id":N,"status":"queued"|"sent"|"unknown"}
+ *   /events           A Server-Sent Events (EventSource) stream. A "sent"
+ *                     event, with the id as its data, is pushed as soon as
+ *                     each message has been sent. i.e. No need to poll.
+ *
+ * e.g.
+ *   curl -i 'http://esp8266.local/ir?code=16769055'
+ *   curl 'http://esp8266.local/status?id=1'
+ *   curl -N http://esp8266.local/events
+ *
+ * An IR LED circuit *MUST* be connected to the ESP on a pin
+ * as specified by kIrLed below.
+ *
+ * TL;DR: The IR LED needs to be driven by a transistor for a good result.
+ *
+ * Suggested circuit:
+ *     https://github.com/crankyoldgit/IRremoteESP8266/wiki#ir-sending
+ *
+ * Common mistakes & tips:
+ *   * Don't just connect the IR LED directly to the pin, it won't
+ *     have enough current to drive the IR LED effectively.
+ *   * Make sure you have the IR LED polarity correct.
+ *     See: https://learn.sparkfun.com/tutorials/polarity/diode-and-led-polarity
+ *   * Typical digital camera/phones can be used to see if the IR LED is flashed.
+ *     Replace the IR LED with a normal LED if you don't have a digital camera
+ *     when debugging.
+ *   * Avoid using the following pins unless you really know what you are doing:
+ *     * Pin 0/D3: Can interfere with the boot/program mode & support circuits.
+ *     * Pin 1/TX/TXD0: Any serial transmissions from the ESP8266 will interfere.
+ *     * Pin 3/RX/RXD0: Any serial transmissions to the ESP8266 will interfere.
+ *   * ESP-01 modules are tricky. We suggest you use a module with more GPIOs
+ *     for your first time. e.g. ESP-12 etc.
+ */
+#include <Arduino.h>
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#include <ESPAsyncTCP.h>
+#include <ESP8266mDNS.h>
+#endif  // ESP8266
+#if defined(ESP32)
+#include <WiFi.h>
+#include <AsyncTCP.h>
+#include <ESPmDNS.h>
+#endif  // ESP32
+#include <ESPAsyncWebServer.h>
+#include <IRremoteESP8266.h>
+#include <IRsend.h>
+
+const char* kSsid = ".....";
+const char* kPassword = ".....";
+MDNSResponder mdns;
+
+#if defined(ESP8266)
+#undef HOSTNAME
+#define HOSTNAME "esp8266"
+#endif  // ESP8266
+#if defined(ESP32)
+#undef HOSTNAME
+#define HOSTNAME "esp32"
+#endif  // ESP32
+
+const uint16_t kIrLed = 4;  // ESP GPIO pin to use. Recommended: 4 (D2).
+const uint8_t kQueueSize = 16;  // Max. nr. of codes waiting to be sent.
+
+IRsend irsend(kIrLed);  // Set the GPIO to be used to sending the message.
+AsyncWebServer server(80);
+AsyncEventSource events("/events");
+
+// A code waiting to be sent.
+typedef struct {
+  uint32_t id;
+  uint32_t code;
+} ir_job_t;
+
+// The queue is filled by the web server's handlers, & emptied by loop().
+// On the ESP32 they run in different tasks, so it needs a lock. On the
+// ESP8266, they never interrupt each other.
+ir_job_t queue[kQueueSize];
+uint8_t queueHead = 0;  // The next job to send.
+uint8_t queueLength = 0;
+uint32_t lastId = 0;  // The id of the last job queued.
+uint32_t sentId = 0;  // The id of the last job sent. Jobs are sent in order.
+#if defined(ESP32)
+portMUX_TYPE queueLock = portMUX_INITIALIZER_UNLOCKED;
+#define LOCK_QUEUE() portENTER_CRITICAL(&queueLock)
+#define UNLOCK_QUEUE() portEXIT_CRITICAL(&queueLock)
+#else  // ESP32
+#define LOCK_QUEUE()
+#define UNLOCK_QUEUE()
+#endif  // ESP32
+
+// Add a code to the queue of ones to send.
+//
+// Args:
+//   code: The NEC code to send.
+// Returns:
+//   The id of the job, or 0 if the queue is full.
+uint32_t enqueue(const uint32_t code) {
+  uint32_t id = 0;
+  LOCK_QUEUE();
+  if (queueLength < kQueueSize) {
+    id = ++lastId;
+    ir_job_t *job = &queue[(queueHead + queueLength) % kQueueSize];
+    job->id = id;
+    job->code = code;
+    queueLength++;
+  }
+  UNLOCK_QUEUE();
+  return id;
+}
+
+// Take the next code to send off the queue.
+//
+// Args:
+//   job: Where to put it.
+// Returns:
+//   true, if there was one.
+bool dequeue(ir_job_t *job) {
+  bool found = false;
+  LOCK_QUEUE();
+  if (queueLength) {
+    *job = queue[queueHead];
+    queueHead = (queueHead + 1) % kQueueSize;
+    queueLength--;
+    found = true;
+  }
+  UNLOCK_QUEUE();
+  return found;
+}
+
+void handleRoot(AsyncWebServerRequest *request) {
+  request->send(200, "text/html",
+                "<html>" \
+                  "<head><title>" HOSTNAME " Async Demo </title>" \
+                  "<meta http-equiv=\"Content-Type\" " \
+                      "content=\"text/html;charset=utf-8\">" \
+                  "<script>" \
+                    "function send(code) {" \
+                      "fetch('ir?code=' + code).then(r => r.json())" \
+                        ".then(j => log('Queued #' + j.id));" \
+                    "}" \
+                    "function log(text) {" \
+                      "var p = document.createElement('p');" \
+                      "p.textContent = text;" \
+                      "document.getElementById('log').appendChild(p);" \
+                    "}" \
+                    "new EventSource('events').addEventListener('sent'," \
+                      "e => log('Sent #' + e.data));" \
+                  "</script>" \
+                  "</head>" \
+                  "<body>" \
+                    "<h1>Hello from " HOSTNAME ", you can send NEC encoded " \
+                        "IR signals from here!</h1>" \
+                    "<p><a href=\"#\" onclick=\"send(16769055)\">" \
+                        "Send 0xFFE01F</a></p>" \
+                    "<p><a href=\"#\" onclick=\"send(16429347)\">" \
+                        "Send 0xFAB123</a></p>" \
+                    "<p><a href=\"#\" onclick=\"send(16771222)\">" \
+                        "Send 0xFFE896</a></p>" \
+                    "<div id=\"log\"></div>" \
+                  "</body>" \
+                "</html>");
+}
+
+void handleIr(AsyncWebServerRequest *request) {
+  uint32_t id = 0;
+  for (uint8_t i = 0; i < request->params(); i++) {
+    AsyncWebParameter *param = request->getParam(i);
+    if (param->name() == "code") {
+      id = enqueue(strtoul(param->value().c_str(), NULL, 10));
+      if (!id) {
+        request->send(503, "application/json", "{\"error\":\"queue full\"}");
+        return;
+      }
+    }
+  }
+  if (!id) {
+    request->send(400, "application/json", "{\"error\":\"no code\"}");
+    return;
+  }
+  request->send(202, "application/json",
+                "{\"id\":" + String(id) + ",\"queued\":" +
+                String(queueLength) + "}");
+}
+
+void handleStatus(AsyncWebServerRequest *request) {
+  uint32_t id = 0;
+  if (request->hasParam("id"))
+    id = strtoul(request->getParam("id")->value().c_str(), NULL, 10);
+  const char *status = "unknown";
+  LOCK_QUEUE();
+  if (id && id <= sentId)
+    status = "sent";
+  else if (id && id <= lastId)
+    status = "queued";
+  UNLOCK_QUEUE();
+  request->send(200, "application/json",
+                "{\"id\":" + String(id) + ",\"status\":\"" + status + "\"}");
+}
+
+void handleNotFound(AsyncWebServerRequest *request) {
+  String message = "File Not Found\n\n";
+  message += "URI: ";
+  message += request->url();
+  message += "\nMethod: ";
+  message += (request->method() == HTTP_GET)?"GET":"POST";
+  message += "\nArguments: ";
+  message += request->params();
+  message += "\n";
+  for (uint8_t i = 0; i < request->params(); i++) {
+    AsyncWebParameter *param = request->getParam(i);
+    message += " " + param->name() + ": " + param->value() + "\n";
+  }
+  request->send(404, "text/plain", message);
+}
+
+void setup(void) {
+  irsend.begin();
+
+  Serial.begin(115200);
+  WiFi.begin(kSsid, kPassword);
+  Serial.println("");
+
+  // Wait for connection
+  while (WiFi.status() != WL_CONNECTED) {
+    delay(500);
+    Serial.print(".");
+  }
+  Serial.println("");
+  Serial.print("Connected to ");
+  Serial.println(kSsid);
+  Serial.print("IP address: ");
+  Serial.println(WiFi.localIP().toString());
+
+#if defined(ESP8266)
+  if (mdns.begin(HOSTNAME, WiFi.localIP())) {
+#else  // ESP8266
+  if (mdns.begin(HOSTNAME)) {
+#endif  // ESP8266
+    Serial.println("MDNS responder started");
+  }
+
+  server.on("/", HTTP_GET, handleRoot);
+  server.on("/ir", HTTP_GET, handleIr);
+  server.on("/status", HTTP_GET, handleStatus);
+  server.addHandler(&events);
+
+  server.on("/inline", HTTP_GET, [](AsyncWebServerRequest *request) {
+    request->send(200, "text/plain", "this works as well");
+  });
+
+  server.onNotFound(handleNotFound);
+
+  server.begin();
+  Serial.println("HTTP server started");
+}
+
+void loop(void) {
+  // Send one queued code per loop, so anything else in loop() gets a turn.
+  ir_job_t job;
+  if (dequeue(&job)) {
+#if SEND_NEC
+    irsend.sendNEC(job.code, 32);
+#endif  // SEND_NEC
+    LOCK_QUEUE();
+    sentId = job.id;
+    UNLOCK_QUEUE();
+    events.send(String(job.id).c_str(), "sent", job.id);
+  }
+}
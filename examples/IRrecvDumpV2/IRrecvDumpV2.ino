@@ -9,6 +9,8 @@
  *  https://github.com/crankyoldgit/IRremoteESP8266/wiki#ir-receiving
  *
  * Changes:
+ *   Version 1.1 October, 2026
+ *     - Optional binary dump mode. (BINARY_DUMP)
  *   Version 1.0 October, 2019
  *     - Internationalisation (i18n) support.
  *     - Stop displaying the legacy raw timing info.
@@ -103,11 +105,24 @@ const uint16_t kMinUnknownSize = 12;
 //
 // Change to `true` if you miss/need the old "Raw Timing[]" display.
 #define LEGACY_TIMING_INFO false
+
+// Binary dump mode
+//
+// Change to `true` to write each capture to the serial port in a compact
+// binary form (A capture file. See `irutils::CaptureWriter`), rather than as
+// text. It takes a fraction of the time, so captures aren't lost during bursts
+// of messages. Record & read it on the PC with tools/capture_stream.py.
+// e.g. tools/capture_stream.py /dev/ttyUSB0 --baud 115200 -o captures.irc
+// A faster baud rate (e.g. 921600) is recommended too.
+#define BINARY_DUMP false
 // ==================== end of TUNEABLE PARAMETERS ====================
 
 // Use turn on the save buffer feature for more complete capture coverage.
 IRrecv irrecv(kRecvPin, kCaptureBufferSize, kTimeout, true);
 decode_results results;  // Somewhere to store the results
+#if BINARY_DUMP
+irutils::CaptureWriter dump(&Serial);  // Writes the captures in binary.
+#endif  // BINARY_DUMP
 
 // This section of code runs only once at start-up.
 void setup() {
@@ -122,7 +137,11 @@ void setup() {
   // packing as we expect and Endianness is as we expect.
   assert(irutils::lowLevelSanityCheck() == 0);
 
+#if BINARY_DUMP
+  dump.begin();  // The header of the capture file.
+#else  // BINARY_DUMP
   Serial.printf("\n" D_STR_IRRECVDUMP_STARTUP "\n", kRecvPin);
+#endif  // BINARY_DUMP
 #if DECODE_HASH
   // Ignore messages with less than minimum on or off pulses.
   irrecv.setUnknownThreshold(kMinUnknownSize);
@@ -134,6 +153,10 @@ void setup() {
 void loop() {
   // Check if the IR code has been received.
   if (irrecv.decode(&results)) {
+#if BINARY_DUMP
+    // The carrier frequency isn't known, as the demodulator removes it.
+    dump.add(&results, 38, millis());
+#else  // BINARY_DUMP
     // Display a crude timestamp.
     uint32_t now = millis();
     Serial.printf(D_STR_TIMESTAMP " : %06u.%03u\n", now / 1000, now % 1000);
@@ -157,5 +180,6 @@ void loop() {
     Serial.println(resultToSourceCode(&results));
     Serial.println();    // Blank line between entries
     yield();             // Feed the WDT (again)
+#endif  // BINARY_DUMP
   }
 }
@@ -9,6 +9,8 @@
  * duty cycles, and repeats as it thinks is required.
  * Anything it doesn't understand, it will try to replay back as best it can,
  * but at 38kHz.
+ * Optionally, it can instead repeat everything straight from the raw capture
+ * via the library's `IRrepeater`, for the least delay. See kLowLatency.
  * Note:
  *   That might NOT be the frequency of the incoming message, so some not
  *   recogised messages that are replayed may not work. The frequency & duty
@@ -48,12 +50,15 @@
  * Changes:
  *   Version 1.0: June, 2019
  *     - Initial version.
+ *   Version 1.1: 2026
+ *     - Add a low latency, raw passthrough mode, with optional cut-through.
  */
 
 #include <Arduino.h>
 #include <IRsend.h>
 #include <IRrecv.h>
 #include <IRremoteESP8266.h>
+#include <IRrepeater.h>
 #include <IRutils.h>
 
 // ==================== start of TUNEABLE PARAMETERS ====================
@@ -80,6 +85,18 @@ const uint8_t kTimeout = 50;  // Milli-Seconds
 // kFrequency is the modulation frequency all UNKNOWN messages will be sent at.
 const uint16_t kFrequency = 38000;  // in Hz. e.g. 38kHz.
 
+// kLowLatency repeats every message straight from the captured timings, before
+// it is decoded. Decoding is then only used to report what it was.
+// Everything is resent at kFrequency, known protocols included.
+const bool kLowLatency = false;
+
+// kCutThrough (with kLowLatency) starts repeating each message this many
+// micro-seconds after it starts, rather than after it has ended. It must be
+// longer than the longest mark of the messages. e.g. NEC's 9ms header mark.
+// 0 waits for each message to end. Note: The IR detector must not be able to
+// see the IR LED in this mode.
+const uint32_t kCutThrough = 0;  // Micro-Seconds. e.g. 15000
+
 // ==================== end of TUNEABLE PARAMETERS ====================
 
 // The IR transmitter.
@@ -88,11 +105,14 @@ IRsend irsend(kIrLedPin);
 IRrecv irrecv(kRecvPin, kCaptureBufferSize, kTimeout, false);
 // Somewhere to store the captured message.
 decode_results results;
+// Repeats the raw captures. (for kLowLatency)
+IRrepeater repeater(&irrecv, &irsend, kFrequency, kCaptureBufferSize);
 
 // This section of code runs only once at start-up.
 void setup() {
   irrecv.enableIRIn();  // Start up the IR receiver.
   irsend.begin();       // Start up the IR sender.
+  repeater.setCutThrough(kCutThrough);
 
   Serial.begin(kBaudRate, SERIAL_8N1);
   while (!Serial)  // Wait for the serial connection to be establised.
@@ -108,6 +128,18 @@ void setup() {
 
 // The repeating section of the code
 void loop() {
+  if (kLowLatency) {
+    // Repeat anything that has been received, then decode it to report it.
+    if (repeater.handle(&results)) {
+      uint32_t now = millis();
+      Serial.printf(
+          "%06u.%03u: A %d-bit %s message was retransmitted %uus after it "
+          "started.\n", now / 1000, now % 1000, results.bits,
+          typeToString(results.decode_type).c_str(), repeater.getLatency());
+    }
+    yield();
+    return;
+  }
   // Check if an IR message has been received.
   if (irrecv.decode(&results)) {  // We have captured something.
     // The capture has stopped at this point.
@@ -116,17 +148,13 @@ void loop() {
     bool success = true;
     // Is it a protocol we don't understand?
     if (protocol == decode_type_t::UNKNOWN) {  // Yes.
-      // Convert the results into an array suitable for sendRaw().
-      // resultToRawArray() allocates the memory we need for the array.
-      uint16_t *raw_array = resultToRawArray(&results);
-      // Find out how many elements are in the array.
-      size = getCorrectedRawLength(&results);
+      // Find out how many entries the message has, excluding rawbuf[0].
+      size = results.rawlen - 1;
 #if SEND_RAW
-      // Send it out via the IR LED circuit.
-      irsend.sendRaw(raw_array, size, kFrequency);
+      // Send it out via the IR LED circuit, straight from the capture buffer.
+      // i.e. No memory needs to be allocated to convert it for sendRaw().
+      irsend.sendRawTicks(results.rawbuf + 1, size, kFrequency, kRawTick);
 #endif  // SEND_RAW
-      // Deallocate the memory allocated by resultToRawArray().
-      delete [] raw_array;
     } else if (hasACState(protocol)) {  // Does the message require a state[]?
       // It does, so send with bytes instead.
       success = irsend.send(protocol, results.state, size / 8);
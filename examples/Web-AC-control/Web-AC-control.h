@@ -29,6 +29,32 @@
 #endif  // defined(ESP8266)
 #endif  // FILESYSTEM
 
+// Set to true to serve the web app with the asynchronous ESPAsyncWebServer
+//    library, rather than the built-in (synchronous) web server.
+// i.e. Requests are answered in the background, by the TCP stack, & a slow
+//    client can't stall the others. It also adds a "/ws" WebSocket, and an
+//    "/events" stream (Server-Sent Events), which push the new state each time
+//    it has been sent to the A/C. The web app uses the former, so it shows
+//    changes made by the other clients too, without polling. Requires the
+//    ESPAsyncWebServer library, and ESPAsyncTCP (ESP8266) or AsyncTCP (ESP32).
+//    See the "_async" envs in platformio.ini.
+// Note: Over the air updates (via ESP8266HTTPUpdateServer) are not available
+//    with it.
+#ifndef ASYNC_WEB_SERVER
+#define ASYNC_WEB_SERVER false
+#endif  // ASYNC_WEB_SERVER
+
+// Set to false to only serve the web app from the files uploaded to the
+//    FILESYSTEM. (See "/file-upload")
+// When true, the files in data/ are built into the firmware, gzip compressed
+//    (See web_assets.h), & sent from flash as they are. They are versioned,
+//    so browsers cache them for good, yet always get the newest ones.
+//    Uploading them isn't needed, & they take precedence over uploaded files
+//    of the same name. Regenerate web_assets.h after changing data/.
+#ifndef EMBEDDED_WEB_ASSETS
+#define EMBEDDED_WEB_ASSETS true
+#endif  // EMBEDDED_WEB_ASSETS
+
 #if (FILESYSTEM == LittleFS)
 #define FILESYSTEMSTR "LittleFS"
 #else
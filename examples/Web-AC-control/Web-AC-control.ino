@@ -10,23 +10,41 @@
 #if defined(ESP8266)
 #include <ESP8266WiFi.h>
 #include <ESP8266mDNS.h>
+#if ASYNC_WEB_SERVER
+#include <ESPAsyncTCP.h>
+#else  // ASYNC_WEB_SERVER
 #include <ESP8266HTTPUpdateServer.h>
 #include <ESP8266WebServer.h>
+#endif  // ASYNC_WEB_SERVER
 #endif  // ESP8266
 #if defined(ESP32)
 #include <ESPmDNS.h>
-#include <WebServer.h>
 #include <WiFi.h>
 #include <Update.h>
+#if ASYNC_WEB_SERVER
+#include <AsyncTCP.h>
+#else  // ASYNC_WEB_SERVER
+#include <WebServer.h>
+#endif  // ASYNC_WEB_SERVER
 #endif  // ESP32
 #include <WiFiUdp.h>
+#if ASYNC_WEB_SERVER
+// The synchronous WiFiManager's web server can't be used with this one.
+#include <DNSServer.h>
+#include <ESPAsyncWebServer.h>
+#include <ESPAsyncWiFiManager.h>
+#else  // ASYNC_WEB_SERVER
 #include <WiFiManager.h>
+#endif  // ASYNC_WEB_SERVER
 #include <ArduinoJson.h>
 #include <IRremoteESP8266.h>
 #include <IRsend.h>
 
 //// ###### User configuration space for AC library classes ##########
 
+#if EMBEDDED_WEB_ASSETS
+#include "web_assets.h"
+#endif  // EMBEDDED_WEB_ASSETS
 #include <ir_Coolix.h>  //  replace library based on your AC unit model, check https://github.com/crankyoldgit/IRremoteESP8266
 
 #define AUTO_MODE kCoolixAuto
@@ -54,14 +72,27 @@ struct state {
 };
 
 File fsUploadFile;
+bool uploadFailed = false;  // Couldn't the file being uploaded be created?
 
 // core
 
 state acState;
+// Has acState changed since it was last sent to the A/C?
+// The web server only updates acState. loop() sends it, so a request is never
+// held up by the IR message.
+bool stateChanged = false;
+bool restartPending = false;
 
 // settings
 char deviceName[] = "AC Remote Control";
 
+#if ASYNC_WEB_SERVER
+AsyncWebServer server(80);
+AsyncEventSource events("/events");
+// Pushes the state to the open web apps, whenever it changes.
+AsyncWebSocket ws("/ws");
+DNSServer dns;
+#else  // ASYNC_WEB_SERVER
 #if defined(ESP8266)
 ESP8266WebServer server(80);
 ESP8266HTTPUpdateServer httpUpdateServer;
@@ -69,6 +100,243 @@ ESP8266HTTPUpdateServer httpUpdateServer;
 #if defined(ESP32)
 WebServer server(80);
 #endif  // ESP32
+#endif  // ASYNC_WEB_SERVER
+
+// The current state, as JSON.
+String stateJson() {
+  DynamicJsonDocument root(1024);
+  root["mode"] = acState.operation;
+  root["fan"] = acState.fan;
+  root["temp"] = acState.temperature;
+  root["power"] = acState.powerStatus;
+  String output;
+  serializeJson(root, output);
+  return output;
+}
+
+// Update the state from a JSON request. e.g. {"temp":22}
+//
+// Args:
+//   json: The request.
+//   output: Where to echo the fields that changed, as JSON.
+// Returns:
+//   true, if the request was valid.
+bool updateState(const String &json, String *output) {
+  DynamicJsonDocument root(1024);
+  DeserializationError error = deserializeJson(root, json);
+  if (error) return false;
+  if (root.containsKey("temp")) {
+    acState.temperature = (uint8_t) root["temp"];
+  }
+
+  if (root.containsKey("fan")) {
+    acState.fan = (uint8_t) root["fan"];
+  }
+
+  if (root.containsKey("power")) {
+    acState.powerStatus = root["power"];
+  }
+
+  if (root.containsKey("mode")) {
+    acState.operation = root["mode"];
+  }
+
+  serializeJson(root, *output);
+  stateChanged = true;
+  return true;
+}
+
+// Send the current state to the A/C.
+void sendState() {
+  if (acState.powerStatus) {
+    ac.on();
+    ac.setTemp(acState.temperature);
+    if (acState.operation == 0) {
+      ac.setMode(AUTO_MODE);
+      ac.setFan(FAN_AUTO);
+      acState.fan = 0;
+    } else if (acState.operation == 1) {
+      ac.setMode(COOL_MODE);
+    } else if (acState.operation == 2) {
+      ac.setMode(DRY_MODE);
+    } else if (acState.operation == 3) {
+      ac.setMode(HEAT_MODE);
+    } else if (acState.operation == 4) {
+      ac.setMode(FAN_MODE);
+    }
+
+    if (acState.operation != 0) {
+      if (acState.fan == 0) {
+        ac.setFan(FAN_AUTO);
+      } else if (acState.fan == 1) {
+        ac.setFan(FAN_MIN);
+      } else if (acState.fan == 2) {
+        ac.setFan(FAN_MED);
+      } else if (acState.fan == 3) {
+        ac.setFan(FAN_HI);
+      }
+    }
+  } else {
+    ac.off();
+  }
+  ac.send();
+}
+
+String getContentType(String filename) {
+  // convert the file extension to the MIME type
+  if (filename.endsWith(".html")) return "text/html";
+  else if (filename.endsWith(".css")) return "text/css";
+  else if (filename.endsWith(".js")) return "application/javascript";
+  else if (filename.endsWith(".ico")) return "image/x-icon";
+  else if (filename.endsWith(".gz")) return "application/x-gzip";
+  return "text/plain";
+}
+
+#if ASYNC_WEB_SERVER
+void handleWebSocket(AsyncWebSocket *server, AsyncWebSocketClient *client,
+                     AwsEventType type, void *arg, uint8_t *data,
+                     size_t len) {
+  // Bring a new web app up to date, rather than it having to ask. The
+  // clients only listen. Changes are still made via "/state".
+  if (type == WS_EVT_CONNECT) client->text(stateJson());
+}
+
+void handleFileUpload(AsyncWebServerRequest *request, String filename,
+                      size_t index, uint8_t *data, size_t len, bool final) {
+  // upload a new file to the FILESYSTEM
+  if (!index) {
+    if (!filename.startsWith("/")) filename = "/" + filename;
+    fsUploadFile = FILESYSTEM.open(filename, "w");
+    // Open the file for writing in FILESYSTEM (create if it doesn't exist)
+    uploadFailed = !fsUploadFile;
+  }
+  if (fsUploadFile)
+    fsUploadFile.write(data, len);
+    // Write the received bytes to the file
+  if (final && fsUploadFile) fsUploadFile.close();
+}
+
+void handleNotFound(AsyncWebServerRequest *request) {
+  String message = "File Not Found\n\n";
+  message += "URI: ";
+  message += request->url();
+  message += "\nMethod: ";
+  message += (request->method() == HTTP_GET) ? "GET" : "POST";
+  message += "\nArguments: ";
+  message += request->params();
+  message += "\n";
+  for (uint8_t i = 0; i < request->params(); i++) {
+    AsyncWebParameter *param = request->getParam(i);
+    message += " " + param->name() + ": " + param->value() + "\n";
+  }
+  request->send(404, "text/plain", message);
+}
+
+#if EMBEDDED_WEB_ASSETS
+// Send a file of the web app, from flash, still gzip compressed. A browser
+// that already has this version of it gets a 304 instead. Asked for with its
+// version, it can be cached for good, as that URL is never reused.
+void handleWebAsset(AsyncWebServerRequest *request,
+                    const web_asset_t *asset) {
+  const String etag = String('"') + asset->version + '"';
+  AsyncWebServerResponse *response;
+  if (request->hasHeader("If-None-Match") &&
+      request->getHeader("If-None-Match")->value() == etag) {
+    response = request->beginResponse(304);
+  } else {
+    response = request->beginResponse_P(200, asset->type, asset->data,
+                                         asset->size);
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", etag);
+  if (request->arg("v") == asset->version)
+    response->addHeader("Cache-Control", "max-age=31536000, immutable");
+  else
+    response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+#endif  // EMBEDDED_WEB_ASSETS
+
+// Set up the asynchronous web server's handlers.
+void setupServer() {
+  server.on("/state", HTTP_PUT, [](AsyncWebServerRequest *request) {
+    // Called once the body has been received. It has answered it, if it fit.
+    if (request->_tempObject == NULL)
+      request->send(413, "text/plain", "FAIL. Too large");
+  },
+  NULL,
+  // The body is received in chunks. Only answer once it is all here.
+  [](AsyncWebServerRequest *request, uint8_t *data, size_t len,
+     size_t index, size_t total) {
+    // The server free()s _tempObject along with the request.
+    if (!index && total < 1024) request->_tempObject = malloc(total + 1);
+    char *body = reinterpret_cast<char *>(request->_tempObject);
+    if (body == NULL) return;
+    memcpy(body + index, data, len);
+    if (index + len < total) return;
+    body[total] = '\0';
+    String output;
+    if (updateState(body, &output))
+      request->send(200, "text/plain", output);
+    else
+      request->send(404, "text/plain", "FAIL. " + String(body));
+  });
+
+  server.on("/file-upload", HTTP_POST,
+  // if the client posts to the upload page
+  [](AsyncWebServerRequest *request) {
+    // Redirect the client to the success page, once it has been received.
+    if (uploadFailed) {
+      request->send(500, "text/plain", "500: couldn't create file");
+    } else {
+      request->redirect("/success.html");
+    }
+  },
+  handleFileUpload);  // Receive and save the file
+
+  server.on("/file-upload", HTTP_GET, [](AsyncWebServerRequest *request) {
+    // if the client requests the upload page
+
+    String html = "<form method=\"post\" enctype=\"multipart/form-data\">";
+    html += "<input type=\"file\" name=\"name\">";
+    html += "<input class=\"button\" type=\"submit\" value=\"Upload\">";
+    html += "</form>";
+    request->send(200, "text/html", html);
+  });
+
+  server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
+    request->redirect("ui.html");
+  });
+
+  server.on("/state", HTTP_GET, [](AsyncWebServerRequest *request) {
+    request->send(200, "text/plain", stateJson());
+  });
+
+  server.on("/reset", [](AsyncWebServerRequest *request) {
+    request->send(200, "text/html", "reset");
+    restartPending = true;  // Restart from loop(), once it has been sent.
+  });
+
+  server.addHandler(&events);
+  ws.onEvent(handleWebSocket);
+  server.addHandler(&ws);
+
+#if EMBEDDED_WEB_ASSETS
+  for (uint8_t i = 0; i < kWebAssetCount; i++) {
+    const web_asset_t *asset = &kWebAssets[i];
+    server.on(asset->path, HTTP_GET,
+              [asset](AsyncWebServerRequest *request) {
+      handleWebAsset(request, asset);
+    });
+  }
+#endif  // EMBEDDED_WEB_ASSETS
+
+  // Compressed (.gz) versions of the files are used if they exist.
+  server.serveStatic("/", FILESYSTEM, "/").setCacheControl("max-age=86400");
+
+  server.onNotFound(handleNotFound);
+}
+#else  // ASYNC_WEB_SERVER
 
 bool handleFileRead(String path) {
   //  send the right file to the client (if it exists)
@@ -97,16 +365,6 @@ bool handleFileRead(String path) {
   return false;
 }
 
-String getContentType(String filename) {
-  // convert the file extension to the MIME type
-  if (filename.endsWith(".html")) return "text/html";
-  else if (filename.endsWith(".css")) return "text/css";
-  else if (filename.endsWith(".js")) return "application/javascript";
-  else if (filename.endsWith(".ico")) return "image/x-icon";
-  else if (filename.endsWith(".gz")) return "application/x-gzip";
-  return "text/plain";
-}
-
 void handleFileUpload() {  // upload a new file to the FILESYSTEM
   HTTPUpload& upload = server.upload();
   if (upload.status == UPLOAD_FILE_START) {
@@ -152,98 +410,38 @@ void handleNotFound() {
   server.send(404, "text/plain", message);
 }
 
-void setup() {
-  // Serial.begin(115200);
-  // Serial.println();
-  ac.begin();
-
-
-  delay(1000);
-
-  Serial.println("mounting " FILESYSTEMSTR "...");
-
-  if (!FILESYSTEM.begin()) {
-    // Serial.println("Failed to mount file system");
+#if EMBEDDED_WEB_ASSETS
+// Send a file of the web app, from flash, still gzip compressed. A browser
+// that already has this version of it gets a 304 instead. Asked for with its
+// version, it can be cached for good, as that URL is never reused.
+void handleWebAsset(const web_asset_t *asset) {
+  const String etag = String('"') + asset->version + '"';
+  server.sendHeader("ETag", etag);
+  if (server.arg("v") == asset->version)
+    server.sendHeader("Cache-Control", "max-age=31536000, immutable");
+  else
+    server.sendHeader("Cache-Control", "no-cache");
+  if (server.header("If-None-Match") == etag) {
+    server.send(304);
     return;
   }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset->type, (PGM_P)asset->data, asset->size);
+}
+#endif  // EMBEDDED_WEB_ASSETS
 
-  WiFiManager wifiManager;
-
-
-  if (!wifiManager.autoConnect(deviceName)) {
-    delay(3000);
-    ESP.restart();
-    delay(5000);
-  }
-
-
+// Set up the web server's handlers.
+void setupServer() {
 #if defined(ESP8266)
   httpUpdateServer.setup(&server);
 #endif  // ESP8266
 
-
-
   server.on("/state", HTTP_PUT, []() {
-    DynamicJsonDocument root(1024);
-    DeserializationError error = deserializeJson(root, server.arg("plain"));
-    if (error) {
-      server.send(404, "text/plain", "FAIL. " + server.arg("plain"));
-    } else {
-      if (root.containsKey("temp")) {
-        acState.temperature = (uint8_t) root["temp"];
-      }
-
-      if (root.containsKey("fan")) {
-        acState.fan = (uint8_t) root["fan"];
-      }
-
-      if (root.containsKey("power")) {
-        acState.powerStatus = root["power"];
-      }
-
-      if (root.containsKey("mode")) {
-        acState.operation = root["mode"];
-      }
-
-      String output;
-      serializeJson(root, output);
+    String output;
+    if (updateState(server.arg("plain"), &output))
       server.send(200, "text/plain", output);
-
-      delay(200);
-
-      if (acState.powerStatus) {
-        ac.on();
-        ac.setTemp(acState.temperature);
-        if (acState.operation == 0) {
-          ac.setMode(AUTO_MODE);
-          ac.setFan(FAN_AUTO);
-          acState.fan = 0;
-        } else if (acState.operation == 1) {
-          ac.setMode(COOL_MODE);
-        } else if (acState.operation == 2) {
-          ac.setMode(DRY_MODE);
-        } else if (acState.operation == 3) {
-          ac.setMode(HEAT_MODE);
-        } else if (acState.operation == 4) {
-          ac.setMode(FAN_MODE);
-        }
-
-        if (acState.operation != 0) {
-          if (acState.fan == 0) {
-            ac.setFan(FAN_AUTO);
-          } else if (acState.fan == 1) {
-            ac.setFan(FAN_MIN);
-          } else if (acState.fan == 2) {
-            ac.setFan(FAN_MED);
-          } else if (acState.fan == 3) {
-            ac.setFan(FAN_HI);
-          }
-        }
-      } else {
-        ac.off();
-      }
-      ac.send();
-    }
+    else
+      server.send(404, "text/plain", "FAIL. " + server.arg("plain"));
   });
 
   server.on("/file-upload", HTTP_POST,
@@ -270,31 +468,84 @@ void setup() {
   });
 
   server.on("/state", HTTP_GET, []() {
-    DynamicJsonDocument root(1024);
-    root["mode"] = acState.operation;
-    root["fan"] = acState.fan;
-    root["temp"] = acState.temperature;
-    root["power"] = acState.powerStatus;
-    String output;
-    serializeJson(root, output);
-    server.send(200, "text/plain", output);
+    server.send(200, "text/plain", stateJson());
   });
 
 
   server.on("/reset", []() {
     server.send(200, "text/html", "reset");
-    delay(100);
-    ESP.restart();
+    restartPending = true;  // Restart from loop(), once it has been sent.
   });
 
+#if EMBEDDED_WEB_ASSETS
+  for (uint8_t i = 0; i < kWebAssetCount; i++) {
+    const web_asset_t *asset = &kWebAssets[i];
+    server.on(asset->path, HTTP_GET, [asset]() { handleWebAsset(asset); });
+  }
+  const char *headers[] = {"If-None-Match"};
+  server.collectHeaders(headers, 1);
+#endif  // EMBEDDED_WEB_ASSETS
+
   server.serveStatic("/", FILESYSTEM, "/", "max-age=86400");
 
   server.onNotFound(handleNotFound);
+}
+#endif  // ASYNC_WEB_SERVER
+
+void setup() {
+  // Serial.begin(115200);
+  // Serial.println();
+  ac.begin();
+
+
+  delay(1000);
+
+  Serial.println("mounting " FILESYSTEMSTR "...");
+
+  if (!FILESYSTEM.begin()) {
+    // Serial.println("Failed to mount file system");
+#if !EMBEDDED_WEB_ASSETS
+    return;  // There is no web app to serve.
+#endif  // !EMBEDDED_WEB_ASSETS
+  }
+
+#if ASYNC_WEB_SERVER
+  AsyncWiFiManager wifiManager(&server, &dns);
+#else  // ASYNC_WEB_SERVER
+  WiFiManager wifiManager;
+#endif  // ASYNC_WEB_SERVER
+
+
+  if (!wifiManager.autoConnect(deviceName)) {
+    delay(3000);
+    ESP.restart();
+    delay(5000);
+  }
+
+  setupServer();
 
   server.begin();
 }
 
 
 void loop() {
+#if ASYNC_WEB_SERVER
+  ws.cleanupClients();  // Drop any web apps that have gone away.
+#else  // ASYNC_WEB_SERVER
   server.handleClient();
+#endif  // ASYNC_WEB_SERVER
+  if (stateChanged) {
+    stateChanged = false;
+    sendState();
+#if ASYNC_WEB_SERVER
+    // Let any dashboards know it has been sent, & what it now is.
+    const String json = stateJson();
+    events.send(json.c_str(), "state", millis());
+    ws.textAll(json);
+#endif  // ASYNC_WEB_SERVER
+  }
+  if (restartPending) {
+    delay(100);
+    ESP.restart();
+  }
 }
@@ -9,24 +9,7 @@ function updateStatus() {
       name: "light",
       value: "1"
     }, ],
-    success: function(data) {
-      if (!data) {
-        return;
-      }
-      state = data;
-      if (state["power"] === true) {
-        $("#power").text(" ON");
-        $("#power-btn").addClass("btn-info");
-        $("#power-btn").removeClass("btn-default");
-      } else {
-        $("#power").text(" OFF");
-        $("#power-btn").addClass("btn-default");
-        $("#power-btn").removeClass("btn-info");
-      }
-      $("#target_temp").text(state["temp"] + " C");
-      setModeColor(state["mode"]);
-      setFanColor(state["fan"]);
-    },
+    success: showState,
     error: function() {
       console.log('error getting state');
     },
@@ -34,7 +17,45 @@ function updateStatus() {
   });
 }
 
+function showState(data) {
+  if (!data) {
+    return;
+  }
+  state = data;
+  if (state["power"] === true) {
+    $("#power").text(" ON");
+    $("#power-btn").addClass("btn-info");
+    $("#power-btn").removeClass("btn-default");
+  } else {
+    $("#power").text(" OFF");
+    $("#power-btn").addClass("btn-default");
+    $("#power-btn").removeClass("btn-info");
+  }
+  $("#target_temp").text(state["temp"] + " C");
+  setModeColor(state["mode"]);
+  setFanColor(state["fan"]);
+}
+
+// The asynchronous web server pushes the state each time it changes. e.g. By
+// another client. Without it, the state is only fetched when the page loads.
+function listenForState() {
+  var ws = new WebSocket("ws://" + location.host + "/ws");
+  var opened = false;
+  ws.onopen = function() {
+    opened = true;
+  };
+  ws.onmessage = function(event) {
+    showState(JSON.parse(event.data));
+  };
+  ws.onclose = function() {
+    if (opened) {  // Lost it. e.g. The device restarted.
+      setTimeout(listenForState, 5000);
+    }
+  };
+}
+
 updateStatus();
+listenForState();
 
 
 
@@ -0,0 +1,837 @@
+// Copyright 2026 The IRremoteESP8266 authors
+// The static files of the web app, gzip compressed. See `web_asset_t`.
+//
+// WARNING: Do not edit this file! This file is automatically generated by
+//          'tools/web_assets.py'. Regenerate it whenever the files change,
+//          with:
+//   tools/web_assets.py -o examples/Web-AC-control/web_assets.h examples/Web-AC-control/data/favicon.ico examples/Web-AC-control/data/level_1_off.svg examples/Web-AC-control/data/level_1_on.svg examples/Web-AC-control/data/level_2_off.svg examples/Web-AC-control/data/level_2_on.svg examples/Web-AC-control/data/level_3_off.svg examples/Web-AC-control/data/level_3_on.svg examples/Web-AC-control/data/level_4_off.svg examples/Web-AC-control/data/level_4_on.svg examples/Web-AC-control/data/ui.html examples/Web-AC-control/data/ui.js
+
+#ifndef EXAMPLES_WEB_AC_CONTROL_WEB_ASSETS_H_
+#define EXAMPLES_WEB_AC_CONTROL_WEB_ASSETS_H_
+
+#include <Arduino.h>
+
+// A static file of the web app.
+typedef struct {
+  const char *path;  // Its URL.
+  const char *type;  // Its Content-Type.
+  const char *version;  // A hash of its contents.
+  const uint8_t *data;  // Its gzip compressed contents. (PROGMEM)
+  uint32_t size;  // Nr. of bytes of `data`.
+} web_asset_t;
+
+// /favicon.ico: 16446 bytes, 878 compressed.
+const uint8_t kWebAsset0[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xED, 0x9B,
+  0x4D, 0x68, 0x13, 0x51, 0x10, 0x80, 0xB7, 0xD4, 0x9F, 0x2A, 0x0A, 0x05,
+  0xA9, 0x2D, 0xCD, 0xE6, 0xFD, 0xED, 0xBC, 0x24, 0xE4, 0xA0, 0x96, 0x82,
+  0xFF, 0x62, 0x10, 0xA4, 0x1E, 0xBC, 0x29, 0x2A, 0x2A, 0x78, 0xF1, 0x22,
+  0x7A, 0xF0, 0x24, 0x78, 0x50, 0x3C, 0x2A, 0x1E, 0xBC, 0xF9, 0x03, 0x82,
+  0x8A, 0x7A, 0x11, 0x51, 0xC1, 0x9B, 0x17, 0x6F, 0xA2, 0x08, 0x0A, 0x82,
+  0x20, 0x1E, 0xF4, 0xA0, 0x22, 0xA8, 0x94, 0x4A, 0xAD, 0x16, 0x51, 0xEA,
+  0x4C, 0x36, 0xDA, 0x64, 0xD9, 0xA4, 0xD9, 0x98, 0xA6, 0x9B, 0xCD, 0x4C,
+  0x99, 0xA4, 0x6C, 0x32, 0x79, 0xF3, 0xCD, 0xBE, 0xCC, 0xCE, 0x7B, 0x99,
+  0x75, 0x9C, 0x2E, 0xFC, 0x2B, 0x14, 0x1C, 0x7C, 0x54, 0x4E, 0x0E, 0x9F,
+  0x97, 0x3B, 0x8E, 0x93, 0x43, 0xC5, 0x7F, 0x9D, 0x53, 0x8E, 0x7F, 0x7C,
+  0x36, 0xC4, 0x08, 0xBB, 0x5D, 0x09, 0xF3, 0x5C, 0x4A, 0x58, 0x17, 0xD5,
+  0x36, 0x95, 0xCA, 0x2D, 0x53, 0x0A, 0x6E, 0x29, 0x61, 0x8F, 0x35, 0x32,
+  0xB6, 0x16, 0x76, 0xAB, 0x10, 0xF0, 0x44, 0xA7, 0x33, 0x9B, 0x9C, 0x39,
+  0x10, 0x29, 0xBD, 0x2D, 0xCA, 0x85, 0x1F, 0x4A, 0xC2, 0x54, 0xDA, 0xD5,
+  0x5F, 0x91, 0x65, 0x6D, 0xBD, 0xB6, 0xD9, 0x6C, 0x76, 0x29, 0xC6, 0xEC,
+  0x29, 0xD9, 0x92, 0x4A, 0x69, 0xCF, 0x46, 0x19, 0x5B, 0x08, 0x6F, 0x03,
+  0xDA, 0x4D, 0xF8, 0xF6, 0xE6, 0x5B, 0xAB, 0x63, 0x40, 0xAC, 0x52, 0xEA,
+  0xF1, 0xBF, 0xFE, 0x4F, 0xC7, 0xC0, 0xAE, 0x99, 0xD9, 0x56, 0xF5, 0xA8,
+  0x34, 0x3C, 0x2C, 0xB7, 0x8D, 0x12, 0x03, 0x8C, 0xDB, 0x50, 0xDA, 0x85,
+  0xB1, 0x4A, 0x5B, 0x3D, 0x6E, 0x84, 0xD9, 0xD8, 0x0A, 0x76, 0xAD, 0xF5,
+  0x0A, 0x1C, 0x73, 0x34, 0xE8, 0xBF, 0x1F, 0x03, 0x18, 0xD3, 0x3A, 0xB3,
+  0xBA, 0x9A, 0x6D, 0xC1, 0x29, 0xCC, 0x43, 0xFF, 0xEF, 0x87, 0xD9, 0xD6,
+  0x13, 0x03, 0xAD, 0xB3, 0x59, 0x64, 0xFD, 0x14, 0x6E, 0xAB, 0xC7, 0x69,
+  0x5E, 0xCC, 0x36, 0x3F, 0x8E, 0xF1, 0xAA, 0x9A, 0xFF, 0xBE, 0x7A, 0x1F,
+  0x6A, 0xCC, 0x9B, 0xA3, 0xB5, 0x6D, 0x61, 0xAA, 0xD6, 0x5C, 0x46, 0xFB,
+  0x07, 0xB5, 0x6C, 0xC9, 0xB7, 0xD9, 0x9F, 0xFB, 0xAA, 0x17, 0x75, 0x00,
+  0x7D, 0xB9, 0x56, 0xE1, 0xB7, 0xB4, 0x27, 0xFC, 0xE3, 0xAA, 0xB7, 0x9A,
+  0x2D, 0x00, 0x2C, 0xA4, 0xF7, 0x18, 0x63, 0x32, 0x81, 0xEF, 0xCE, 0x24,
+  0x1D, 0xC7, 0xB9, 0xD5, 0x5F, 0x6B, 0xEC, 0x7C, 0x5F, 0x7E, 0x49, 0x69,
+  0xEC, 0xE3, 0x15, 0xEC, 0x69, 0xB8, 0x49, 0xC7, 0x29, 0xAF, 0xB4, 0x2A,
+  0x07, 0x60, 0xAC, 0x2F, 0x56, 0xF8, 0x80, 0xE7, 0x36, 0x52, 0x0C, 0x03,
+  0xFC, 0x91, 0xBE, 0x83, 0xD2, 0x3B, 0x52, 0x19, 0x7B, 0x73, 0xB9, 0xD5,
+  0xF9, 0x9F, 0xF9, 0x99, 0x9F, 0xF9, 0x99, 0x9F, 0xF9, 0x99, 0x9F, 0xF9,
+  0x3B, 0x8F, 0x5F, 0x09, 0x38, 0x17, 0xE0, 0x3F, 0x54, 0xAF, 0xED, 0xE0,
+  0xE0, 0xE0, 0xE2, 0x40, 0xED, 0x3A, 0x1A, 0x8D, 0x1F, 0x0E, 0x06, 0xEC,
+  0xCF, 0xB7, 0x9C, 0x5F, 0xD9, 0x55, 0x4A, 0xEA, 0x2F, 0xC5, 0xF1, 0x5D,
+  0xF8, 0x88, 0xB5, 0xAB, 0x8C, 0x16, 0x3F, 0xEF, 0xCA, 0x74, 0xEC, 0xBC,
+  0x33, 0x11, 0x6B, 0xF0, 0x01, 0x95, 0xF2, 0xDE, 0x96, 0xEC, 0xBF, 0x63,
+  0xEC, 0x37, 0xCF, 0xC5, 0x1E, 0x00, 0xD5, 0xF3, 0xC4, 0x3D, 0x3C, 0x3C,
+  0x3C, 0xBF, 0xC1, 0xB5, 0x64, 0x3F, 0xB1, 0x34, 0x38, 0x7C, 0x37, 0xAE,
+  0x23, 0x04, 0xAD, 0x09, 0x1C, 0x16, 0x16, 0x16, 0x16, 0x16, 0x96, 0x88,
+  0xE2, 0xD7, 0x22, 0xE6, 0x7D, 0x27, 0x2A, 0x5D, 0xBF, 0x8B, 0x7B, 0x6A,
+  0x33, 0xEC, 0x49, 0x26, 0x56, 0x95, 0xEA, 0x61, 0xFE, 0x00, 0xBF, 0x82,
+  0xD7, 0x42, 0xC0, 0xBD, 0x24, 0x2A, 0xAE, 0x59, 0x1E, 0xD5, 0xC1, 0x7F,
+  0x3A, 0xA9, 0xB9, 0x0E, 0xD7, 0x19, 0xDB, 0x98, 0x9F, 0xF9, 0x99, 0x9F,
+  0xF9, 0x99, 0x9F, 0xF9, 0x99, 0xBF, 0x7E, 0x7E, 0xB4, 0x3D, 0x20, 0xA5,
+  0xB9, 0xAE, 0x25, 0xDC, 0x88, 0xB3, 0x16, 0x7D, 0x14, 0xB0, 0xBF, 0x99,
+  0xFC, 0xD4, 0x5B, 0xD2, 0x6E, 0xB5, 0x6D, 0x58, 0x1F, 0x4A, 0xA3, 0xFC,
+  0x14, 0xCF, 0xF6, 0xAB, 0xED, 0xBD, 0x3D, 0xCD, 0xE2, 0x97, 0x12, 0xF6,
+  0xB5, 0xDD, 0xF9, 0x17, 0xB0, 0xAB, 0x59, 0xFC, 0x4A, 0xE5, 0x54, 0xB0,
+  0xDF, 0x2B, 0xCE, 0x4A, 0xBD, 0x68, 0x90, 0x02, 0xB7, 0x99, 0xF9, 0x8F,
+  0xF6, 0xDA, 0xA5, 0xB4, 0x3B, 0x30, 0xAE, 0x3B, 0xE3, 0xAC, 0xE4, 0x63,
+  0x18, 0x3B, 0x5F, 0xFF, 0x98, 0x9F, 0xF9, 0x99, 0xBF, 0x51, 0x7E, 0x00,
+  0xE8, 0xC3, 0xD7, 0x46, 0x8A, 0x9F, 0x11, 0x6B, 0x85, 0x11, 0xEA, 0x2D,
+  0x6F, 0x26, 0x3F, 0xE5, 0xD3, 0x6A, 0x3D, 0xBF, 0x71, 0x54, 0xBC, 0x56,
+  0x7F, 0x0E, 0xFB, 0x5D, 0xB9, 0xF1, 0xFA, 0xC7, 0xEE, 0xED, 0xE4, 0xFA,
+  0xA7, 0xD3, 0xEB, 0x5F, 0xEA, 0xAF, 0x68, 0x37, 0x7E, 0x29, 0xBD, 0xF5,
+  0x4D, 0xCC, 0x7F, 0x5D, 0xB8, 0x06, 0x38, 0x8C, 0xAF, 0xDF, 0x8D, 0xFD,
+  0x1E, 0x3F, 0xFA, 0x58, 0xAD, 0x17, 0x89, 0xAF, 0x7F, 0xCC, 0xCF, 0xFC,
+  0xCC, 0x5F, 0x9B, 0xDF, 0x5E, 0x4A, 0x30, 0xFF, 0xEE, 0x99, 0x7F, 0xFF,
+  0x36, 0x6F, 0xF0, 0xAD, 0xDD, 0x49, 0xE4, 0x17, 0xC2, 0x5E, 0x0D, 0xF2,
+  0x87, 0xF4, 0xA2, 0x4E, 0x29, 0x01, 0x27, 0x93, 0x77, 0xEE, 0xA1, 0x80,
+  0x6C, 0xBF, 0xCA, 0x39, 0xF3, 0xF9, 0xFC, 0x02, 0xBF, 0xBE, 0x0D, 0xD9,
+  0xDB, 0x12, 0xDE, 0x85, 0xFF, 0xE8, 0xCD, 0x8C, 0x8D, 0xB8, 0xAE, 0xBB,
+  0xA8, 0xD4, 0x2F, 0x3D, 0x11, 0xDC, 0x23, 0xFB, 0x17, 0x9B, 0xB4, 0xBD,
+  0x53, 0xA5, 0x8E, 0xFA, 0x4D, 0xF7, 0xD4, 0x49, 0x69, 0x1E, 0xB7, 0xA3,
+  0x2A, 0x57, 0x3F, 0x0B, 0x72, 0x4F, 0xF7, 0x8C, 0xC3, 0xED, 0xB2, 0xFD,
+  0xDD, 0x21, 0x8C, 0xC7, 0xCF, 0x4E, 0xE9, 0x7B, 0x21, 0x56, 0xAD, 0x33,
+  0x2B, 0x83, 0xB9, 0xB1, 0x78, 0x1F, 0x62, 0xF2, 0xD9, 0x27, 0xC3, 0xD6,
+  0x86, 0xC5, 0x3D, 0x5E, 0xD7, 0x58, 0xEA, 0xA5, 0xC7, 0x5C, 0xF1, 0x02,
+  0x73, 0xC2, 0xBB, 0xA4, 0xF4, 0xB9, 0x95, 0x58, 0x5E, 0xD2, 0x3D, 0x1B,
+  0x74, 0xEF, 0x69, 0x39, 0xF3, 0x1F, 0x43, 0x54, 0x91, 0xBF, 0x3E, 0x40,
+  0x00, 0x00,
+};
+
+// /level_1_off.svg: 1384 bytes, 668 compressed.
+const uint8_t kWebAsset1[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xC9, 0x6E, 0xDB, 0x30, 0x10, 0xBD, 0xFB, 0x2B, 0x54, 0xFA, 0x92, 0xA0,
+  0x95, 0x48, 0xAD, 0x96, 0x14, 0xCB, 0x39, 0xB4, 0x48, 0x91, 0x6B, 0x17,
+  0xF4, 0xCC, 0x50, 0x94, 0xCD, 0x46, 0x22, 0x0D, 0x92, 0x8E, 0xE3, 0xBF,
+  0xEF, 0x50, 0xAB, 0x0D, 0x04, 0xA8, 0x2F, 0xE6, 0xBC, 0x79, 0xB3, 0xF2,
+  0x89, 0xDB, 0xC7, 0xF7, 0xAE, 0xF5, 0xDE, 0xB8, 0x36, 0x42, 0xC9, 0x0A,
+  0x85, 0x01, 0x41, 0x1E, 0x97, 0x4C, 0xD5, 0x42, 0xEE, 0x2B, 0xF4, 0xFB,
+  0xD7, 0x93, 0x9F, 0x23, 0xCF, 0x58, 0x2A, 0x6B, 0xDA, 0x2A, 0xC9, 0x2B,
+  0x24, 0x15, 0x7A, 0xDC, 0xAD, 0xB6, 0x9F, 0x7C, 0xDF, 0xFB, 0xAA, 0x39,
+  0xB5, 0xBC, 0xF6, 0xCE, 0xC2, 0x1E, 0xBC, 0x67, 0xF9, 0x6A, 0x18, 0x3D,
+  0x72, 0xEF, 0xEE, 0x60, 0xED, 0xB1, 0xC4, 0xF8, 0x7C, 0x3E, 0x07, 0x62,
+  0x04, 0x03, 0xA5, 0xF7, 0xF8, 0xDE, 0xF3, 0xFD, 0xDD, 0x6A, 0xB5, 0x35,
+  0x6F, 0xFB, 0x95, 0xE7, 0x79, 0x50, 0x57, 0x9A, 0xB2, 0x66, 0x15, 0x1A,
+  0x03, 0x8E, 0x27, 0xDD, 0xF6, 0xC4, 0x9A, 0x61, 0xDE, 0xF2, 0x8E, 0x4B,
+  0x6B, 0x70, 0x18, 0x84, 0x18, 0x2D, 0x74, 0xB6, 0xD0, 0x99, 0xAB, 0x2E,
+  0xDE, 0x38, 0x53, 0x5D, 0xA7, 0xA4, 0xE9, 0x23, 0xA5, 0x59, 0x5F, 0x91,
+  0x75, 0xDD, 0xCC, 0x6C, 0xD7, 0xCD, 0x39, 0xEE, 0x49, 0x61, 0x51, 0x14,
+  0x98, 0x44, 0x38, 0x8A, 0x7C, 0x60, 0xF8, 0xE6, 0x22, 0x2D, 0x7D, 0xF7,
+  0x6F, 0x43, 0xA1, 0xC7, 0x8F, 0x42, 0x23, 0x42, 0x08, 0x06, 0xDF, 0xC2,
+  0xFC, 0x2F, 0xEB, 0x6A, 0xB5, 0x61, 0x0F, 0x9C, 0x45, 0x6D, 0x0F, 0x15,
+  0x8A, 0x52, 0xD2, 0x9B, 0x07, 0x2E, 0xF6, 0x07, 0x5B, 0xA1, 0x94, 0x0C,
+  0xB6, 0xA8, 0x2B, 0x04, 0xB1, 0x11, 0xDA, 0x81, 0xB5, 0xAD, 0x79, 0x63,
+  0x1C, 0x3A, 0xE0, 0xCE, 0x4A, 0x7A, 0x07, 0xB8, 0x5A, 0x21, 0x39, 0xD5,
+  0xDF, 0x35, 0xAD, 0x05, 0x6C, 0x6A, 0x20, 0x0D, 0xB4, 0x5B, 0x4F, 0x92,
+  0xA4, 0x9B, 0x31, 0x06, 0xA2, 0x8C, 0x55, 0xC7, 0x89, 0x3B, 0x16, 0x03,
+  0x04, 0x38, 0x05, 0x5A, 0x60, 0x63, 0x2F, 0x2D, 0x1F, 0x3C, 0x3E, 0x53,
+  0xAD, 0xD2, 0xE5, 0x1A, 0x46, 0x22, 0x4D, 0xF3, 0xD0, 0x43, 0xEA, 0x48,
+  0x99, 0xB0, 0x97, 0x32, 0xBC, 0x0A, 0x51, 0x4D, 0x63, 0x38, 0x8C, 0x01,
+  0xF2, 0xC1, 0x63, 0x83, 0xF8, 0xB6, 0x8F, 0x7E, 0x1E, 0xEC, 0x46, 0xE8,
+  0x4F, 0x1D, 0xB7, 0xB4, 0xA6, 0x96, 0x2E, 0xD3, 0x4D, 0xC8, 0xD4, 0xED,
+  0x16, 0x6E, 0xA7, 0xFC, 0xF1, 0xED, 0x69, 0xEE, 0x9D, 0xB1, 0xF2, 0x8F,
+  0xD2, 0xAF, 0x4B, 0x51, 0x47, 0xA0, 0x2F, 0xEA, 0x04, 0x75, 0xE7, 0x09,
+  0xDD, 0xD2, 0x58, 0xD9, 0x28, 0xDD, 0x51, 0xBB, 0x13, 0x1D, 0xDD, 0x73,
+  0x77, 0x15, 0x9F, 0xE1, 0xB2, 0xA0, 0xF8, 0xEC, 0xB8, 0x21, 0xDB, 0xCB,
+  0x91, 0x2F, 0x49, 0x87, 0xB4, 0x9A, 0x1B, 0x75, 0xD2, 0x8C, 0x7F, 0xA8,
+  0xCE, 0x9A, 0x75, 0xC2, 0x05, 0xE1, 0x9F, 0x56, 0xB4, 0xED, 0xB3, 0x2B,
+  0x32, 0x8F, 0x3D, 0x27, 0x15, 0xB6, 0xE5, 0xBB, 0xBE, 0xE6, 0x70, 0x9C,
+  0xA6, 0xC0, 0xE3, 0x18, 0xD3, 0x96, 0xAE, 0xA6, 0xDC, 0xE2, 0x69, 0x07,
+  0xBD, 0xB5, 0x1F, 0x42, 0xAC, 0xA6, 0xD2, 0xB8, 0xBE, 0x2B, 0xD4, 0x1F,
+  0x5B, 0xF8, 0xE8, 0xEE, 0xC8, 0x17, 0x3F, 0x4D, 0xA3, 0x20, 0xCE, 0xA2,
+  0x30, 0xBF, 0x47, 0xCB, 0x12, 0x5B, 0x7A, 0xE1, 0x3A, 0x9C, 0x37, 0xC8,
+  0xD9, 0xAC, 0x8C, 0x49, 0x77, 0x71, 0x16, 0x64, 0x09, 0xC9, 0xA3, 0xF9,
+  0xF2, 0x26, 0x05, 0xE6, 0x83, 0x23, 0x5E, 0x94, 0xA0, 0xDF, 0x41, 0xB6,
+  0x69, 0x50, 0x24, 0x19, 0xD9, 0xA4, 0x0B, 0x7A, 0xE9, 0xD1, 0x2C, 0xCB,
+  0x52, 0x92, 0xCC, 0x28, 0x50, 0x21, 0x7E, 0x53, 0xA4, 0x39, 0x59, 0x52,
+  0x03, 0xB3, 0x48, 0x8B, 0x80, 0xC4, 0x39, 0x59, 0xB2, 0xBA, 0x36, 0x5D,
+  0x63, 0x51, 0x51, 0x2C, 0x49, 0x47, 0xC9, 0x4D, 0xD2, 0x22, 0x41, 0xBE,
+  0x29, 0xDC, 0x2F, 0x7F, 0x68, 0x60, 0xC5, 0xE5, 0x3A, 0xC9, 0x5E, 0xF2,
+  0x9A, 0xF6, 0xC6, 0xAC, 0x3F, 0x02, 0x72, 0xD4, 0xEA, 0x95, 0x0F, 0xEA,
+  0x24, 0x93, 0xE9, 0xF7, 0x93, 0x96, 0x61, 0x1C, 0xC4, 0x69, 0x11, 0x66,
+  0x24, 0x89, 0x26, 0x87, 0x13, 0x24, 0x3C, 0x47, 0xA5, 0x56, 0x27, 0x59,
+  0x5F, 0x83, 0x7F, 0x95, 0x90, 0xB7, 0x28, 0x5C, 0x30, 0xD7, 0xAD, 0x80,
+  0xBF, 0x32, 0x86, 0x0D, 0xB8, 0xF4, 0x61, 0x1A, 0x4F, 0xDE, 0xF9, 0x0B,
+  0x98, 0x80, 0x9A, 0x9A, 0x03, 0xD5, 0x9A, 0x5E, 0x4A, 0x09, 0xAF, 0xE4,
+  0x28, 0x86, 0x2D, 0xDE, 0xC3, 0x4B, 0xE9, 0xE4, 0xB7, 0x5B, 0xFD, 0x03,
+  0x73, 0xA9, 0x30, 0x8C, 0x68, 0x05, 0x00, 0x00,
+};
+
+// /level_1_on.svg: 1384 bytes, 667 compressed.
+const uint8_t kWebAsset2[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xC9, 0x6E, 0xDB, 0x30, 0x10, 0xBD, 0xFB, 0x2B, 0x54, 0xE6, 0x92, 0xA0,
+  0x95, 0x48, 0xAD, 0x96, 0x14, 0xCB, 0x39, 0xB4, 0x48, 0x90, 0x6B, 0x17,
+  0xF4, 0xCC, 0x88, 0x94, 0xCD, 0x46, 0x22, 0x0D, 0x92, 0x8E, 0xE3, 0xBF,
+  0xEF, 0x50, 0xAB, 0x5D, 0x04, 0xA8, 0x2F, 0xE6, 0xBC, 0x79, 0xB3, 0xF2,
+  0x89, 0x9B, 0x87, 0xF7, 0xAE, 0xF5, 0xDE, 0xB8, 0x36, 0x42, 0xC9, 0x0A,
+  0x85, 0x01, 0x41, 0x1E, 0x97, 0xB5, 0x62, 0x42, 0xEE, 0x2A, 0xF4, 0xEB,
+  0xE7, 0xA3, 0x9F, 0x23, 0xCF, 0x58, 0x2A, 0x19, 0x6D, 0x95, 0xE4, 0x15,
+  0x92, 0x0A, 0x3D, 0x6C, 0x57, 0x9B, 0x4F, 0xBE, 0xEF, 0x7D, 0xD5, 0x9C,
+  0x5A, 0xCE, 0xBC, 0x93, 0xB0, 0x7B, 0xEF, 0x59, 0xBE, 0x9A, 0x9A, 0x1E,
+  0xB8, 0x77, 0xBB, 0xB7, 0xF6, 0x50, 0x62, 0x7C, 0x3A, 0x9D, 0x02, 0x31,
+  0x82, 0x81, 0xD2, 0x3B, 0x7C, 0xE7, 0xF9, 0xFE, 0x76, 0xB5, 0xDA, 0x98,
+  0xB7, 0xDD, 0xCA, 0xF3, 0x3C, 0xA8, 0x2B, 0x4D, 0xC9, 0xEA, 0x0A, 0x8D,
+  0x01, 0x87, 0xA3, 0x6E, 0x7B, 0x22, 0xAB, 0x31, 0x6F, 0x79, 0xC7, 0xA5,
+  0x35, 0x38, 0x0C, 0x42, 0x8C, 0x16, 0x7A, 0xBD, 0xD0, 0x6B, 0x57, 0x5D,
+  0xBC, 0xF1, 0x5A, 0x75, 0x9D, 0x92, 0xA6, 0x8F, 0x94, 0xE6, 0xE6, 0x82,
+  0xAC, 0x59, 0x33, 0xB3, 0x5D, 0x37, 0xA7, 0xB8, 0x27, 0x85, 0x45, 0x51,
+  0x60, 0x12, 0xE1, 0x28, 0xF2, 0x81, 0xE1, 0x9B, 0xB3, 0xB4, 0xF4, 0xDD,
+  0xBF, 0x0E, 0x85, 0x1E, 0x3F, 0x0A, 0x8D, 0x08, 0x21, 0x18, 0x7C, 0x0B,
+  0xF3, 0xBF, 0xAC, 0x8B, 0xD5, 0x86, 0x3D, 0x70, 0x12, 0xCC, 0xEE, 0x2B,
+  0x14, 0xA5, 0xA4, 0x37, 0xF7, 0x5C, 0xEC, 0xF6, 0xB6, 0x42, 0x29, 0x19,
+  0x6C, 0xC1, 0x2A, 0x04, 0xB1, 0x11, 0xDA, 0x82, 0xB5, 0x61, 0xBC, 0x31,
+  0x0E, 0x1D, 0x70, 0x67, 0x25, 0xBD, 0x03, 0x5C, 0xAD, 0x90, 0x9C, 0xEA,
+  0x27, 0x4D, 0x99, 0x80, 0x4D, 0x0D, 0xA4, 0x81, 0x76, 0xED, 0x49, 0x92,
+  0x74, 0x3D, 0xC6, 0x40, 0x94, 0xB1, 0xEA, 0x30, 0x71, 0xC7, 0x62, 0x80,
+  0x00, 0xA7, 0x40, 0x0B, 0x6C, 0xEC, 0xB9, 0xE5, 0x83, 0xC7, 0xAF, 0x55,
+  0xAB, 0x74, 0x79, 0x03, 0x23, 0x91, 0xA6, 0xB9, 0xEF, 0x21, 0x75, 0xA0,
+  0xB5, 0xB0, 0xE7, 0x32, 0xBC, 0x08, 0x51, 0x4D, 0x63, 0x38, 0x8C, 0x01,
+  0xF2, 0xC1, 0x63, 0x83, 0xF8, 0xBA, 0x8F, 0x7E, 0x1E, 0xEC, 0x46, 0xE8,
+  0x4F, 0x1D, 0xB7, 0x94, 0x51, 0x4B, 0x97, 0xE9, 0x26, 0x64, 0xEA, 0x76,
+  0x03, 0xB7, 0x53, 0x7E, 0xFF, 0xF6, 0x38, 0xF7, 0x5E, 0xD7, 0xE5, 0x6F,
+  0xA5, 0x5F, 0x97, 0xA2, 0x8E, 0x40, 0x5F, 0xD4, 0x11, 0xEA, 0xCE, 0x13,
+  0xBA, 0xA5, 0xD5, 0x65, 0xA3, 0x74, 0x47, 0xED, 0x56, 0x74, 0x74, 0xC7,
+  0xDD, 0x55, 0x7C, 0x86, 0xCB, 0x82, 0xE2, 0xB3, 0xE3, 0x8A, 0x6C, 0xCF,
+  0x07, 0xBE, 0x24, 0x1D, 0xD2, 0x6A, 0x6E, 0xD4, 0x51, 0xD7, 0xFC, 0x43,
+  0x75, 0xB2, 0xBA, 0x13, 0x2E, 0x08, 0xFF, 0xB0, 0xA2, 0x6D, 0x9F, 0x5D,
+  0x91, 0x79, 0xEC, 0x39, 0xA9, 0xB0, 0x2D, 0xDF, 0xF6, 0x35, 0x87, 0xE3,
+  0x34, 0x05, 0x1E, 0xC7, 0x98, 0xB6, 0x74, 0x31, 0xE5, 0x06, 0x4F, 0x3B,
+  0xE8, 0xAD, 0xDD, 0x10, 0x62, 0x35, 0x95, 0xC6, 0xF5, 0x5D, 0xA1, 0xFE,
+  0xD8, 0xC2, 0x47, 0x77, 0x4B, 0xBE, 0xF8, 0x69, 0x1A, 0x05, 0x71, 0x16,
+  0x85, 0xF9, 0x1D, 0x5A, 0x96, 0xD8, 0xD2, 0x33, 0xD7, 0xE1, 0xBC, 0x41,
+  0x5E, 0xCF, 0xCA, 0x98, 0x74, 0x17, 0x67, 0x41, 0x96, 0x90, 0x3C, 0x9A,
+  0x2F, 0x6F, 0x52, 0x60, 0x3E, 0x38, 0xE2, 0x45, 0x09, 0xFA, 0x1D, 0x64,
+  0x9B, 0x06, 0x45, 0x92, 0x91, 0x75, 0xBA, 0xA0, 0xE7, 0x1E, 0xCD, 0xB2,
+  0x2C, 0x25, 0xC9, 0x8C, 0x02, 0x15, 0xE2, 0xD7, 0x45, 0x9A, 0x93, 0x25,
+  0x35, 0x30, 0x8B, 0xB4, 0x08, 0x48, 0x9C, 0x93, 0x25, 0xAB, 0x6B, 0xD3,
+  0x35, 0x16, 0x15, 0xC5, 0x92, 0x74, 0x94, 0xDC, 0x24, 0x2D, 0x12, 0xE4,
+  0xEB, 0xC2, 0xFD, 0xF2, 0xFB, 0x06, 0x56, 0x5C, 0xDE, 0x24, 0xD9, 0x4B,
+  0xCE, 0x68, 0x6F, 0x2C, 0xFA, 0x03, 0x39, 0x6A, 0xF5, 0xCA, 0x07, 0x75,
+  0x12, 0x32, 0x9A, 0x7E, 0x3F, 0x69, 0x19, 0xC6, 0x41, 0x9C, 0x16, 0x61,
+  0x46, 0x92, 0x68, 0x72, 0x38, 0x41, 0xC2, 0x73, 0x54, 0x6A, 0x75, 0x94,
+  0xEC, 0x12, 0xFC, 0xA3, 0x84, 0xBC, 0x46, 0xE1, 0x82, 0xB9, 0x6E, 0x05,
+  0xFC, 0x95, 0x31, 0x6C, 0xC0, 0xA5, 0x0F, 0xD3, 0x78, 0xF2, 0xFE, 0xDB,
+  0x81, 0xCF, 0xA8, 0xD9, 0x53, 0xAD, 0xE9, 0xB9, 0x94, 0xF0, 0x4A, 0x8E,
+  0x62, 0xD8, 0xE0, 0x1D, 0xBC, 0x94, 0x4E, 0x7E, 0xDB, 0xD5, 0x5F, 0xDF,
+  0xFD, 0xAA, 0x7C, 0x68, 0x05, 0x00, 0x00,
+};
+
+// /level_2_off.svg: 1384 bytes, 669 compressed.
+const uint8_t kWebAsset3[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xCB, 0x72, 0x9B, 0x30, 0x14, 0xDD, 0xFB, 0x2B, 0xA8, 0xBC, 0x49, 0xA6,
+  0x05, 0x09, 0x30, 0x36, 0x10, 0xE3, 0x2C, 0xDA, 0x49, 0x27, 0xDB, 0x3E,
+  0xA6, 0x6B, 0x45, 0x12, 0xB6, 0x1A, 0x90, 0x3C, 0x92, 0x1C, 0xC7, 0x7F,
+  0xDF, 0x2B, 0x9E, 0xF6, 0x4C, 0x66, 0x0A, 0x0B, 0x74, 0xCF, 0x3D, 0x57,
+  0xF7, 0xA1, 0x83, 0xB6, 0x8F, 0xEF, 0x6D, 0x13, 0xBC, 0x09, 0x63, 0xA5,
+  0x56, 0x15, 0x8A, 0x23, 0x82, 0x02, 0xA1, 0x98, 0xE6, 0x52, 0xED, 0x2B,
+  0xF4, 0xFB, 0xD7, 0x53, 0x98, 0xA3, 0xC0, 0x3A, 0xAA, 0x38, 0x6D, 0xB4,
+  0x12, 0x15, 0x52, 0x1A, 0x3D, 0xEE, 0x16, 0xDB, 0x4F, 0x61, 0x18, 0x7C,
+  0x35, 0x82, 0x3A, 0xC1, 0x83, 0xB3, 0x74, 0x87, 0xE0, 0x59, 0xBD, 0x5A,
+  0x46, 0x8F, 0x22, 0xB8, 0x3B, 0x38, 0x77, 0x2C, 0x31, 0x3E, 0x9F, 0xCF,
+  0x91, 0x1C, 0xC0, 0x48, 0x9B, 0x3D, 0xBE, 0x0F, 0xC2, 0x70, 0xB7, 0x58,
+  0x6C, 0xED, 0xDB, 0x7E, 0x11, 0x04, 0x01, 0xE4, 0x55, 0xB6, 0xE4, 0xAC,
+  0x42, 0x43, 0xC0, 0xF1, 0x64, 0x9A, 0x8E, 0xC8, 0x19, 0x16, 0x8D, 0x68,
+  0x85, 0x72, 0x16, 0xC7, 0x51, 0x8C, 0xD1, 0x4C, 0x67, 0x33, 0x9D, 0xF9,
+  0xEC, 0xF2, 0x4D, 0x30, 0xDD, 0xB6, 0x5A, 0xD9, 0x2E, 0x52, 0xD9, 0xE5,
+  0x15, 0xD9, 0xF0, 0x7A, 0x62, 0xFB, 0x6A, 0xCE, 0x69, 0x47, 0x8A, 0x8B,
+  0xA2, 0xC0, 0x24, 0xC1, 0x49, 0x12, 0x02, 0x23, 0xB4, 0x17, 0xE5, 0xE8,
+  0x7B, 0x78, 0x1B, 0x0A, 0x35, 0x7E, 0x14, 0x9A, 0x10, 0x42, 0x30, 0xF8,
+  0x66, 0xE6, 0x7F, 0x59, 0x57, 0xA3, 0x8D, 0x3B, 0xE0, 0x2C, 0xB9, 0x3B,
+  0x54, 0x28, 0xC9, 0x48, 0x67, 0x1E, 0x84, 0xDC, 0x1F, 0x5C, 0x85, 0x32,
+  0xD2, 0xDB, 0x92, 0x57, 0x08, 0x62, 0x13, 0xB4, 0x03, 0x6B, 0xCB, 0x45,
+  0x6D, 0x3D, 0xDA, 0xE3, 0xDE, 0x5A, 0x75, 0x0E, 0x70, 0x35, 0x52, 0x09,
+  0x6A, 0xBE, 0x1B, 0xCA, 0x25, 0x4C, 0xAA, 0x27, 0xF5, 0xB4, 0x5B, 0xCF,
+  0x6A, 0x95, 0x6D, 0x86, 0x18, 0x88, 0xB2, 0x4E, 0x1F, 0x47, 0xEE, 0x90,
+  0x0C, 0x10, 0xE0, 0x14, 0x68, 0x86, 0xAD, 0xBB, 0x34, 0xA2, 0xF7, 0x84,
+  0x4C, 0x37, 0xDA, 0x94, 0x4B, 0x68, 0x89, 0xD4, 0xF5, 0x43, 0x07, 0xE9,
+  0x23, 0x65, 0xD2, 0x5D, 0xCA, 0xF8, 0x2A, 0x44, 0xD7, 0xB5, 0x15, 0xD0,
+  0x06, 0xC8, 0x07, 0x0F, 0x05, 0xE2, 0xDB, 0x3A, 0xBA, 0x7E, 0xB0, 0x6F,
+  0xA1, 0x5B, 0xB5, 0xC2, 0x51, 0x4E, 0x1D, 0x9D, 0xBB, 0x1B, 0x91, 0xB1,
+  0xDA, 0x2D, 0x9C, 0x4E, 0xF9, 0xE3, 0xDB, 0xD3, 0x54, 0x3B, 0x63, 0xE5,
+  0x1F, 0x6D, 0x5E, 0xE7, 0xA4, 0x9E, 0x40, 0x5F, 0xF4, 0x09, 0xF2, 0x4E,
+  0x1D, 0xFA, 0xA1, 0xB1, 0xB2, 0xD6, 0xA6, 0xA5, 0x6E, 0x27, 0x5B, 0xBA,
+  0x17, 0xFE, 0x28, 0x3E, 0xC3, 0x61, 0x41, 0xF2, 0xC9, 0x71, 0x43, 0x76,
+  0x97, 0xA3, 0x98, 0x37, 0xED, 0xB7, 0x35, 0xC2, 0xEA, 0x93, 0x61, 0xE2,
+  0x43, 0x75, 0x72, 0xD6, 0x4A, 0x1F, 0x84, 0x7F, 0x3A, 0xD9, 0x34, 0xCF,
+  0x3E, 0xC9, 0xD4, 0xF6, 0xB4, 0xA9, 0x74, 0x8D, 0xD8, 0x75, 0x39, 0xFB,
+  0xE5, 0xD8, 0x05, 0x1E, 0xDA, 0x18, 0xA7, 0x74, 0xD5, 0xE5, 0x16, 0x8F,
+  0x33, 0xE8, 0xAC, 0x7D, 0x1F, 0xE2, 0x0C, 0x55, 0xD6, 0xD7, 0x5D, 0xA1,
+  0x6E, 0xD9, 0xC0, 0x4F, 0x77, 0x47, 0xBE, 0x84, 0x59, 0x96, 0x44, 0xE9,
+  0x3A, 0x89, 0xF3, 0x7B, 0x34, 0x0F, 0xB1, 0xA1, 0x17, 0x61, 0xE2, 0x69,
+  0x82, 0x82, 0x4D, 0xCA, 0x18, 0x75, 0x97, 0x92, 0xA8, 0x48, 0x8A, 0x64,
+  0x3D, 0x1D, 0xDE, 0xA8, 0xC0, 0x38, 0xEF, 0x3D, 0xB3, 0x12, 0xCC, 0x3B,
+  0xF0, 0x21, 0x49, 0x91, 0x24, 0xAB, 0x64, 0x46, 0x2F, 0x1D, 0x9A, 0x6C,
+  0x56, 0x59, 0x3A, 0xEF, 0x02, 0xD4, 0x22, 0xCA, 0x52, 0x78, 0xD7, 0xD9,
+  0x04, 0x02, 0x33, 0x5F, 0xC7, 0x51, 0x5E, 0x6C, 0xB2, 0x1C, 0x5D, 0x4B,
+  0xD4, 0x17, 0x96, 0x14, 0xC5, 0xCC, 0x1C, 0x24, 0x37, 0x4A, 0x8B, 0x44,
+  0xF9, 0xA6, 0xF0, 0x4F, 0xFE, 0x50, 0xC3, 0x88, 0xCB, 0xE5, 0x6A, 0xFD,
+  0x92, 0x73, 0xDA, 0x19, 0x93, 0xFE, 0x08, 0xC8, 0xD1, 0xE8, 0x57, 0xD1,
+  0xAB, 0x93, 0x8C, 0x66, 0xD8, 0x75, 0x5A, 0xC6, 0x45, 0x44, 0x36, 0x64,
+  0x13, 0xA7, 0x64, 0x35, 0x3A, 0xBC, 0x20, 0xE1, 0x3A, 0x2A, 0x8D, 0x3E,
+  0x29, 0x7E, 0x0D, 0xFE, 0xD5, 0x52, 0xDD, 0xA2, 0x70, 0xC0, 0xC2, 0x34,
+  0x12, 0x3E, 0x65, 0x9A, 0x45, 0x85, 0xDF, 0x3E, 0xCE, 0xD2, 0xD1, 0x3B,
+  0xFD, 0x01, 0x23, 0xC0, 0xA9, 0x3D, 0x50, 0x63, 0xE8, 0xA5, 0x54, 0x70,
+  0x4B, 0x0E, 0x62, 0xD8, 0xE2, 0x3D, 0xDC, 0x94, 0x5E, 0x7E, 0xBB, 0xC5,
+  0x3F, 0xB3, 0x37, 0x77, 0x74, 0x68, 0x05, 0x00, 0x00,
+};
+
+// /level_2_on.svg: 1384 bytes, 668 compressed.
+const uint8_t kWebAsset4[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xCB, 0x72, 0xDA, 0x30, 0x14, 0xDD, 0xF3, 0x15, 0xAE, 0xB2, 0x49, 0xA6,
+  0xB5, 0x25, 0xDB, 0x18, 0x6C, 0x07, 0x93, 0x45, 0x3B, 0xC9, 0x64, 0xDB,
+  0xC7, 0x74, 0xAD, 0x48, 0x32, 0xA8, 0xB1, 0x25, 0x46, 0x12, 0x21, 0xFC,
+  0x7D, 0xAF, 0xFC, 0x84, 0x4E, 0x66, 0x0A, 0x0B, 0x74, 0xCF, 0x3D, 0xF7,
+  0xA9, 0x83, 0x36, 0x0F, 0xEF, 0x6D, 0x13, 0xBC, 0x09, 0x63, 0xA5, 0x56,
+  0x15, 0x8A, 0x23, 0x82, 0x02, 0xA1, 0x98, 0xE6, 0x52, 0xED, 0x2A, 0xF4,
+  0xEB, 0xE7, 0x63, 0x98, 0xA3, 0xC0, 0x3A, 0xAA, 0x38, 0x6D, 0xB4, 0x12,
+  0x15, 0x52, 0x1A, 0x3D, 0x6C, 0x17, 0x9B, 0x4F, 0x61, 0x18, 0x7C, 0x35,
+  0x82, 0x3A, 0xC1, 0x83, 0x93, 0x74, 0xFB, 0xE0, 0x59, 0xBD, 0x5A, 0x46,
+  0x0F, 0x22, 0xB8, 0xDD, 0x3B, 0x77, 0x28, 0x31, 0x3E, 0x9D, 0x4E, 0x91,
+  0x1C, 0xC0, 0x48, 0x9B, 0x1D, 0xBE, 0x0B, 0xC2, 0x70, 0xBB, 0x58, 0x6C,
+  0xEC, 0xDB, 0x6E, 0x11, 0x04, 0x01, 0xD4, 0x55, 0xB6, 0xE4, 0xAC, 0x42,
+  0x43, 0xC0, 0xE1, 0x68, 0x9A, 0x8E, 0xC8, 0x19, 0x16, 0x8D, 0x68, 0x85,
+  0x72, 0x16, 0xC7, 0x51, 0x8C, 0xD1, 0x4C, 0x67, 0x33, 0x9D, 0xF9, 0xEA,
+  0xF2, 0x4D, 0x30, 0xDD, 0xB6, 0x5A, 0xD9, 0x2E, 0x52, 0xD9, 0x9B, 0x0B,
+  0xB2, 0xE1, 0xF5, 0xC4, 0xF6, 0xDD, 0x9C, 0xD2, 0x8E, 0x14, 0x17, 0x45,
+  0x81, 0x49, 0x82, 0x93, 0x24, 0x04, 0x46, 0x68, 0xCF, 0xCA, 0xD1, 0xF7,
+  0xF0, 0x3A, 0x14, 0x7A, 0xFC, 0x28, 0x34, 0x21, 0x84, 0x60, 0xF0, 0xCD,
+  0xCC, 0xFF, 0xB2, 0x2E, 0x56, 0x1B, 0x77, 0xC0, 0x49, 0x72, 0xB7, 0xAF,
+  0x50, 0x92, 0x91, 0xCE, 0xDC, 0x0B, 0xB9, 0xDB, 0xBB, 0x0A, 0x65, 0xA4,
+  0xB7, 0x25, 0xAF, 0x10, 0xC4, 0x26, 0x68, 0x0B, 0xD6, 0x86, 0x8B, 0xDA,
+  0x7A, 0xB4, 0xC7, 0xBD, 0xB5, 0xEC, 0x1C, 0xE0, 0x6A, 0xA4, 0x12, 0xD4,
+  0x3C, 0x19, 0xCA, 0x25, 0x6C, 0xAA, 0x27, 0xF5, 0xB4, 0x6B, 0xCF, 0x72,
+  0x99, 0xAD, 0x87, 0x18, 0x88, 0xB2, 0x4E, 0x1F, 0x46, 0xEE, 0x50, 0x0C,
+  0x10, 0xE0, 0x14, 0x68, 0x86, 0xAD, 0x3B, 0x37, 0xA2, 0xF7, 0x84, 0x4C,
+  0x37, 0xDA, 0x94, 0x37, 0x30, 0x12, 0xA9, 0xEB, 0xFB, 0x0E, 0xD2, 0x07,
+  0xCA, 0xA4, 0x3B, 0x97, 0xF1, 0x45, 0x88, 0xAE, 0x6B, 0x2B, 0x60, 0x0C,
+  0x90, 0x0F, 0x1E, 0x1A, 0xC4, 0xD7, 0x7D, 0x74, 0xF3, 0x60, 0x3F, 0x42,
+  0x77, 0x6A, 0x85, 0xA3, 0x9C, 0x3A, 0x3A, 0x4F, 0x37, 0x22, 0x63, 0xB7,
+  0x1B, 0xB8, 0x9D, 0xF2, 0xFB, 0xB7, 0xC7, 0xA9, 0x77, 0xC6, 0xCA, 0xDF,
+  0xDA, 0xBC, 0xCE, 0x45, 0x3D, 0x81, 0xBE, 0xE8, 0x23, 0xD4, 0x9D, 0x26,
+  0xF4, 0x4B, 0x63, 0x65, 0xAD, 0x4D, 0x4B, 0xDD, 0x56, 0xB6, 0x74, 0x27,
+  0xFC, 0x55, 0x7C, 0x86, 0xCB, 0x82, 0xE2, 0x93, 0xE3, 0x8A, 0xEC, 0xCE,
+  0x07, 0x31, 0x27, 0xED, 0xD3, 0x1A, 0x61, 0xF5, 0xD1, 0x30, 0xF1, 0xA1,
+  0x3A, 0x39, 0x6B, 0xA5, 0x0F, 0xC2, 0x3F, 0x9C, 0x6C, 0x9A, 0x67, 0x5F,
+  0x64, 0x1A, 0x7B, 0x4A, 0x2A, 0x5D, 0x23, 0xB6, 0x5D, 0xCD, 0xFE, 0x38,
+  0x4E, 0x81, 0x87, 0x31, 0xC6, 0x2D, 0x5D, 0x4C, 0xB9, 0xC1, 0xE3, 0x0E,
+  0x3A, 0x6B, 0xD7, 0x87, 0x38, 0x43, 0x95, 0xF5, 0x7D, 0x57, 0xA8, 0x3B,
+  0x36, 0xF0, 0xA7, 0xBB, 0x25, 0x5F, 0xC2, 0x2C, 0x4B, 0xA2, 0x74, 0x95,
+  0xC4, 0xF9, 0x1D, 0x9A, 0x97, 0xD8, 0xD0, 0xB3, 0x30, 0xF1, 0xB4, 0x41,
+  0xC1, 0x26, 0x65, 0x8C, 0xBA, 0x4B, 0x49, 0x54, 0x24, 0x45, 0xB2, 0x9A,
+  0x2E, 0x6F, 0x54, 0x60, 0x9C, 0xF7, 0x9E, 0x59, 0x09, 0xE6, 0x1D, 0xF8,
+  0x50, 0xA4, 0x48, 0x92, 0x65, 0x32, 0xA3, 0xE7, 0x0E, 0x4D, 0xD6, 0xCB,
+  0x2C, 0x9D, 0xB3, 0x00, 0xB5, 0x88, 0xB2, 0x14, 0xBE, 0xAB, 0x6C, 0x02,
+  0x81, 0x99, 0xAF, 0xE2, 0x28, 0x2F, 0xD6, 0x59, 0x8E, 0x2E, 0x25, 0xEA,
+  0x1B, 0x4B, 0x8A, 0x62, 0x66, 0x0E, 0x92, 0x1B, 0xA5, 0x45, 0xA2, 0x7C,
+  0x5D, 0xF8, 0x4F, 0x7E, 0x5F, 0xC3, 0x8A, 0xCB, 0x9B, 0xE5, 0xEA, 0x25,
+  0xE7, 0xB4, 0x33, 0x66, 0xFD, 0x81, 0x1C, 0x8D, 0x7E, 0x15, 0xBD, 0x3A,
+  0x09, 0x19, 0xCC, 0xB0, 0x9B, 0xB4, 0x8C, 0x8B, 0x88, 0xAC, 0xC9, 0x3A,
+  0x4E, 0xC9, 0x72, 0x74, 0x78, 0x41, 0xC2, 0x73, 0x54, 0x1A, 0x7D, 0x54,
+  0xFC, 0x12, 0xFC, 0xA3, 0xA5, 0xBA, 0x46, 0xE1, 0x82, 0x85, 0x69, 0x24,
+  0xFC, 0x94, 0x69, 0x16, 0x15, 0x3E, 0x7D, 0x9C, 0xA5, 0xA3, 0xF7, 0xDF,
+  0x0E, 0x42, 0x4E, 0xED, 0x9E, 0x1A, 0x43, 0xCF, 0xA5, 0x82, 0x57, 0x72,
+  0x10, 0xC3, 0x06, 0xEF, 0xE0, 0xA5, 0xF4, 0xF2, 0xDB, 0x2E, 0xFE, 0x02,
+  0x1F, 0x63, 0xED, 0x84, 0x68, 0x05, 0x00, 0x00,
+};
+
+// /level_3_off.svg: 1382 bytes, 669 compressed.
+const uint8_t kWebAsset5[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xCB, 0x72, 0xDB, 0x20, 0x14, 0xDD, 0xFB, 0x2B, 0x54, 0xB2, 0x49, 0xA6,
+  0x95, 0x40, 0xE8, 0xAD, 0x58, 0xCE, 0xA2, 0x9D, 0x74, 0xB2, 0xED, 0x63,
+  0xBA, 0x26, 0x80, 0x6C, 0x1A, 0x09, 0x3C, 0x40, 0xE2, 0xF8, 0xEF, 0x0B,
+  0x7A, 0xDA, 0x33, 0x99, 0xA9, 0x37, 0xE6, 0x9E, 0x7B, 0x2E, 0xF7, 0x75,
+  0xC4, 0xF6, 0xE1, 0xBD, 0xEF, 0x82, 0x37, 0xAE, 0x8D, 0x50, 0xB2, 0x01,
+  0x71, 0x84, 0x40, 0xC0, 0x25, 0x55, 0x4C, 0xC8, 0x7D, 0x03, 0x7E, 0xFF,
+  0x7A, 0x0C, 0x4B, 0x10, 0x18, 0x4B, 0x24, 0x23, 0x9D, 0x92, 0xBC, 0x01,
+  0x52, 0x81, 0x87, 0xDD, 0x66, 0xFB, 0x29, 0x0C, 0x83, 0xAF, 0x9A, 0x13,
+  0xCB, 0x59, 0x70, 0x12, 0xF6, 0x10, 0x3C, 0xC9, 0x17, 0x43, 0xC9, 0x91,
+  0x07, 0xB7, 0x07, 0x6B, 0x8F, 0x35, 0x84, 0xA7, 0xD3, 0x29, 0x12, 0x13,
+  0x18, 0x29, 0xBD, 0x87, 0x77, 0x41, 0x18, 0xEE, 0x36, 0x9B, 0xAD, 0x79,
+  0xDB, 0x6F, 0x82, 0x20, 0x70, 0x79, 0xA5, 0xA9, 0x19, 0x6D, 0xC0, 0x14,
+  0x70, 0x7C, 0xD5, 0xDD, 0x40, 0x64, 0x14, 0xF2, 0x8E, 0xF7, 0x5C, 0x5A,
+  0x03, 0xE3, 0x28, 0x86, 0x60, 0xA5, 0xD3, 0x95, 0x4E, 0x7D, 0x76, 0xF1,
+  0xC6, 0xA9, 0xEA, 0x7B, 0x25, 0xCD, 0x10, 0x29, 0xCD, 0xCD, 0x05, 0x59,
+  0xB3, 0x76, 0x61, 0xFB, 0x6A, 0x4E, 0xC9, 0x40, 0x8A, 0xAB, 0xAA, 0x82,
+  0x08, 0x43, 0x8C, 0x43, 0xC7, 0x08, 0xCD, 0x59, 0x5A, 0xF2, 0x1E, 0x5E,
+  0x87, 0xBA, 0x1A, 0x3F, 0x0A, 0xC5, 0x08, 0x21, 0xE8, 0x7C, 0x2B, 0xF3,
+  0xBF, 0xAC, 0x8B, 0xD1, 0xC6, 0x03, 0x70, 0x12, 0xCC, 0x1E, 0x1A, 0x80,
+  0x33, 0x34, 0x98, 0x07, 0x2E, 0xF6, 0x07, 0xDB, 0x80, 0x0C, 0x8D, 0xB6,
+  0x60, 0x0D, 0x70, 0xB1, 0x18, 0xEC, 0x9C, 0xB5, 0x65, 0xBC, 0x35, 0x1E,
+  0x1D, 0x71, 0x6F, 0xA5, 0x83, 0xC3, 0xB9, 0x3A, 0x21, 0x39, 0xD1, 0xDF,
+  0x35, 0x61, 0xC2, 0x4D, 0x6A, 0x24, 0x8D, 0xB4, 0x6B, 0x4F, 0x9A, 0x66,
+  0xC5, 0x14, 0xE3, 0xA2, 0x8C, 0x55, 0xC7, 0x99, 0x3B, 0x25, 0x73, 0x88,
+  0xE3, 0x54, 0x60, 0x85, 0x8D, 0x3D, 0x77, 0x7C, 0xF4, 0x84, 0x54, 0x75,
+  0x4A, 0xD7, 0x37, 0xAE, 0x25, 0xD4, 0xB6, 0xF7, 0x03, 0xA4, 0x8E, 0x84,
+  0x0A, 0x7B, 0xAE, 0xE3, 0x8B, 0x10, 0xD5, 0xB6, 0x86, 0xBB, 0x36, 0x9C,
+  0x7C, 0xE0, 0x54, 0x20, 0xBC, 0xAE, 0x63, 0xE8, 0x07, 0xFA, 0x16, 0x86,
+  0x53, 0xCF, 0x2D, 0x61, 0xC4, 0x92, 0xB5, 0xBB, 0x19, 0x99, 0xAB, 0xDD,
+  0xBA, 0xED, 0xD4, 0x3F, 0xBE, 0x3D, 0x2E, 0xB5, 0x53, 0x5A, 0xFF, 0x51,
+  0xFA, 0x65, 0x4D, 0xEA, 0x09, 0xE4, 0x59, 0xBD, 0xBA, 0xBC, 0x4B, 0x87,
+  0x7E, 0x68, 0xB4, 0x6E, 0x95, 0xEE, 0x89, 0xDD, 0x89, 0x9E, 0xEC, 0xB9,
+  0x5F, 0xC5, 0x67, 0xB7, 0x2C, 0x97, 0x7C, 0x71, 0x5C, 0x91, 0xED, 0xF9,
+  0xC8, 0xD7, 0x4B, 0xC7, 0x6B, 0x35, 0x37, 0xEA, 0x55, 0x53, 0xFE, 0xA1,
+  0x3A, 0x19, 0xED, 0x85, 0x0F, 0x82, 0x3F, 0xAD, 0xE8, 0xBA, 0x27, 0x9F,
+  0x64, 0x69, 0x7B, 0xB9, 0x54, 0xD8, 0x8E, 0xEF, 0x86, 0x9C, 0xE3, 0x71,
+  0xEE, 0x02, 0x4E, 0x6D, 0xCC, 0x53, 0xBA, 0xE8, 0x72, 0x0B, 0xE7, 0x19,
+  0x0C, 0xD6, 0x7E, 0x0C, 0xB1, 0x9A, 0x48, 0xE3, 0xEB, 0x6E, 0xC0, 0x70,
+  0xEC, 0xDC, 0x47, 0x77, 0x8B, 0xBE, 0x84, 0x59, 0x86, 0xA3, 0x24, 0xC7,
+  0x71, 0x79, 0x07, 0xD6, 0x21, 0x76, 0xE4, 0xCC, 0x75, 0xBC, 0x4C, 0x90,
+  0xD3, 0x45, 0x19, 0xB3, 0xEE, 0x70, 0x1E, 0xE5, 0x49, 0x59, 0x2C, 0xBB,
+  0x9B, 0x05, 0x88, 0x8B, 0xD1, 0x91, 0x2C, 0x1E, 0xFD, 0xDE, 0x80, 0xC4,
+  0x81, 0x55, 0x91, 0xAD, 0xAB, 0xD6, 0xE7, 0x06, 0xA4, 0x28, 0x8A, 0x8B,
+  0x24, 0xCD, 0xF1, 0x82, 0x3A, 0x66, 0x1C, 0x47, 0x79, 0x89, 0xF2, 0x64,
+  0xBD, 0xD9, 0x31, 0x8B, 0x3C, 0x8D, 0x50, 0x8A, 0xCB, 0x0C, 0x5C, 0x0A,
+  0xD4, 0x97, 0x85, 0xAB, 0x6A, 0x05, 0x27, 0xC1, 0xCD, 0xC2, 0x42, 0x51,
+  0x59, 0x54, 0xFE, 0x57, 0xDE, 0xB7, 0x6E, 0xC0, 0xF5, 0x4D, 0x9A, 0x3F,
+  0x97, 0x8C, 0x0C, 0xC6, 0xA2, 0x3E, 0xE4, 0xC4, 0xA8, 0xD5, 0x0B, 0x1F,
+  0xB5, 0x89, 0x66, 0x33, 0x1C, 0xFA, 0xAC, 0x71, 0xE2, 0x66, 0x13, 0xE3,
+  0x22, 0x2D, 0xF0, 0xEC, 0xF0, 0x72, 0x74, 0x8F, 0x51, 0xAD, 0xD5, 0xAB,
+  0x64, 0x97, 0xE0, 0x5F, 0x25, 0xE4, 0x35, 0xEA, 0xD6, 0xCB, 0x75, 0x27,
+  0xDC, 0x5F, 0x9D, 0x64, 0x51, 0xE5, 0xAF, 0x8F, 0xB3, 0x64, 0xF6, 0x2E,
+  0xFA, 0x9F, 0x01, 0x46, 0xCC, 0x81, 0x68, 0x4D, 0xCE, 0xB5, 0x74, 0x6F,
+  0xE4, 0x24, 0x85, 0x2D, 0xDC, 0xBB, 0x77, 0xD2, 0x8B, 0x6F, 0xB7, 0xF9,
+  0x07, 0x23, 0x48, 0x43, 0x0A, 0x66, 0x05, 0x00, 0x00,
+};
+
+// /level_3_on.svg: 1382 bytes, 669 compressed.
+const uint8_t kWebAsset6[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xCB, 0x72, 0xDB, 0x20, 0x14, 0xDD, 0xFB, 0x2B, 0x54, 0xB2, 0x49, 0xA6,
+  0x95, 0x40, 0xE8, 0xAD, 0x58, 0xCE, 0xA2, 0x9D, 0x76, 0xB2, 0xED, 0x63,
+  0xBA, 0x26, 0x80, 0x6C, 0x1A, 0x09, 0x3C, 0x40, 0xE2, 0xF8, 0xEF, 0x0B,
+  0x7A, 0xDA, 0x9D, 0xCC, 0xD4, 0x1B, 0x73, 0xCF, 0x3D, 0x97, 0xFB, 0x3A,
+  0x62, 0xFB, 0xF0, 0xD6, 0x77, 0xC1, 0x2B, 0xD7, 0x46, 0x28, 0xD9, 0x80,
+  0x38, 0x42, 0x20, 0xE0, 0x92, 0x2A, 0x26, 0xE4, 0xBE, 0x01, 0xBF, 0x7E,
+  0x7E, 0x0D, 0x4B, 0x10, 0x18, 0x4B, 0x24, 0x23, 0x9D, 0x92, 0xBC, 0x01,
+  0x52, 0x81, 0x87, 0xDD, 0x66, 0xFB, 0x21, 0x0C, 0x83, 0xCF, 0x9A, 0x13,
+  0xCB, 0x59, 0x70, 0x12, 0xF6, 0x10, 0x3C, 0xCA, 0x67, 0x43, 0xC9, 0x91,
+  0x07, 0xB7, 0x07, 0x6B, 0x8F, 0x35, 0x84, 0xA7, 0xD3, 0x29, 0x12, 0x13,
+  0x18, 0x29, 0xBD, 0x87, 0x77, 0x41, 0x18, 0xEE, 0x36, 0x9B, 0xAD, 0x79,
+  0xDD, 0x6F, 0x82, 0x20, 0x70, 0x79, 0xA5, 0xA9, 0x19, 0x6D, 0xC0, 0x14,
+  0x70, 0x7C, 0xD1, 0xDD, 0x40, 0x64, 0x14, 0xF2, 0x8E, 0xF7, 0x5C, 0x5A,
+  0x03, 0xE3, 0x28, 0x86, 0x60, 0xA5, 0xD3, 0x95, 0x4E, 0x7D, 0x76, 0xF1,
+  0xCA, 0xA9, 0xEA, 0x7B, 0x25, 0xCD, 0x10, 0x29, 0xCD, 0xCD, 0x05, 0x59,
+  0xB3, 0x76, 0x61, 0xFB, 0x6A, 0x4E, 0xC9, 0x40, 0x8A, 0xAB, 0xAA, 0x82,
+  0x08, 0x43, 0x8C, 0x43, 0xC7, 0x08, 0xCD, 0x59, 0x5A, 0xF2, 0x16, 0x5E,
+  0x87, 0xBA, 0x1A, 0xDF, 0x0B, 0xC5, 0x08, 0x21, 0xE8, 0x7C, 0x2B, 0xF3,
+  0xBF, 0xAC, 0x8B, 0xD1, 0xC6, 0x03, 0x70, 0x12, 0xCC, 0x1E, 0x1A, 0x80,
+  0x33, 0x34, 0x98, 0x07, 0x2E, 0xF6, 0x07, 0xDB, 0x80, 0x0C, 0x8D, 0xB6,
+  0x60, 0x0D, 0x70, 0xB1, 0x18, 0xEC, 0x9C, 0xB5, 0x65, 0xBC, 0x35, 0x1E,
+  0x1D, 0x71, 0x6F, 0xA5, 0x83, 0xC3, 0xB9, 0x3A, 0x21, 0x39, 0xD1, 0xDF,
+  0x34, 0x61, 0xC2, 0x4D, 0x6A, 0x24, 0x8D, 0xB4, 0x6B, 0x4F, 0x9A, 0x66,
+  0xC5, 0x14, 0xE3, 0xA2, 0x8C, 0x55, 0xC7, 0x99, 0x3B, 0x25, 0x73, 0x88,
+  0xE3, 0x54, 0x60, 0x85, 0x8D, 0x3D, 0x77, 0x7C, 0xF4, 0x84, 0x54, 0x75,
+  0x4A, 0xD7, 0x37, 0xAE, 0x25, 0xD4, 0xB6, 0xF7, 0x03, 0xA4, 0x8E, 0x84,
+  0x0A, 0x7B, 0xAE, 0xE3, 0x8B, 0x10, 0xD5, 0xB6, 0x86, 0xBB, 0x36, 0x9C,
+  0x7C, 0xE0, 0x54, 0x20, 0xBC, 0xAE, 0x63, 0xE8, 0x07, 0xFA, 0x16, 0x86,
+  0x53, 0xCF, 0x2D, 0x61, 0xC4, 0x92, 0xB5, 0xBB, 0x19, 0x99, 0xAB, 0xDD,
+  0xBA, 0xED, 0xD4, 0xDF, 0xBF, 0x7C, 0x5D, 0x6A, 0xA7, 0xB4, 0xFE, 0xAD,
+  0xF4, 0xF3, 0x9A, 0xD4, 0x13, 0xC8, 0x93, 0x7A, 0x71, 0x79, 0x97, 0x0E,
+  0xFD, 0xD0, 0x68, 0xDD, 0x2A, 0xDD, 0x13, 0xBB, 0x13, 0x3D, 0xD9, 0x73,
+  0xBF, 0x8A, 0x8F, 0x6E, 0x59, 0x2E, 0xF9, 0xE2, 0xB8, 0x22, 0xDB, 0xF3,
+  0x91, 0xAF, 0x97, 0x8E, 0xD7, 0x6A, 0x6E, 0xD4, 0x8B, 0xA6, 0xFC, 0x5D,
+  0x75, 0x32, 0xDA, 0x0B, 0x1F, 0x04, 0x7F, 0x58, 0xD1, 0x75, 0x8F, 0x3E,
+  0xC9, 0xD2, 0xF6, 0x72, 0xA9, 0xB0, 0x1D, 0xDF, 0x0D, 0x39, 0xC7, 0xE3,
+  0xDC, 0x05, 0x9C, 0xDA, 0x98, 0xA7, 0x74, 0xD1, 0xE5, 0x16, 0xCE, 0x33,
+  0x18, 0xAC, 0xFD, 0x18, 0x62, 0x35, 0x91, 0xC6, 0xD7, 0xDD, 0x80, 0xE1,
+  0xD8, 0xB9, 0x8F, 0xEE, 0x16, 0x7D, 0x0A, 0xB3, 0x0C, 0x47, 0x49, 0x8E,
+  0xE3, 0xF2, 0x0E, 0xAC, 0x43, 0xEC, 0xC8, 0x99, 0xEB, 0x78, 0x99, 0x20,
+  0xA7, 0x8B, 0x32, 0x66, 0xDD, 0xE1, 0x3C, 0xCA, 0x93, 0xB2, 0x58, 0x76,
+  0x37, 0x0B, 0x10, 0x17, 0xA3, 0x23, 0x59, 0x3C, 0xFA, 0xAD, 0x01, 0x89,
+  0x03, 0xAB, 0x22, 0x5B, 0x57, 0xAD, 0xCF, 0x0D, 0x48, 0x51, 0x14, 0x17,
+  0x49, 0x9A, 0xE3, 0x05, 0x75, 0xCC, 0x38, 0x8E, 0xF2, 0x12, 0xE5, 0xC9,
+  0x7A, 0xB3, 0x63, 0x16, 0x79, 0x1A, 0xA1, 0x14, 0x97, 0x19, 0xB8, 0x14,
+  0xA8, 0x2F, 0x0B, 0x57, 0xD5, 0x0A, 0x4E, 0x82, 0x9B, 0x85, 0x85, 0xA2,
+  0xB2, 0xA8, 0xFC, 0xAF, 0xBC, 0x6F, 0xDD, 0x80, 0xEB, 0x9B, 0x34, 0x7F,
+  0x2A, 0x19, 0x19, 0x8C, 0x55, 0x7D, 0x4E, 0x8C, 0x5A, 0x3D, 0xF3, 0x51,
+  0x9B, 0x08, 0x4D, 0x66, 0x38, 0xF4, 0x59, 0xE3, 0xC4, 0xCD, 0x26, 0xC6,
+  0x45, 0x5A, 0xE0, 0xD9, 0xE1, 0xE5, 0xE8, 0x1E, 0xA3, 0x5A, 0xAB, 0x17,
+  0xC9, 0x2E, 0xC1, 0x3F, 0x4A, 0xC8, 0x6B, 0xD4, 0xAD, 0x97, 0xEB, 0x4E,
+  0xB8, 0xBF, 0x3A, 0xC9, 0xA2, 0xCA, 0x5F, 0x1F, 0x67, 0xC9, 0xEC, 0xFD,
+  0xB7, 0x82, 0x90, 0x11, 0x73, 0x20, 0x5A, 0x93, 0x73, 0x2D, 0xDD, 0x1B,
+  0x39, 0x49, 0x61, 0x0B, 0xF7, 0xEE, 0x9D, 0xF4, 0xE2, 0xDB, 0x6D, 0xFE,
+  0x02, 0x8F, 0x1C, 0xD9, 0xFA, 0x66, 0x05, 0x00, 0x00,
+};
+
+// /level_4_off.svg: 1381 bytes, 669 compressed.
+const uint8_t kWebAsset7[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xC9, 0x6E, 0xDB, 0x30, 0x10, 0xBD, 0xFB, 0x2B, 0x54, 0xFA, 0x92, 0xA0,
+  0x95, 0x48, 0xAD, 0x96, 0x14, 0xCB, 0x39, 0xB4, 0x48, 0x91, 0x6B, 0x17,
+  0xF4, 0xCC, 0x88, 0x94, 0xCD, 0x46, 0x22, 0x0D, 0x92, 0x8E, 0xE3, 0xBF,
+  0xEF, 0x50, 0xAB, 0x0D, 0x04, 0xA8, 0x2F, 0xE6, 0xBC, 0x79, 0xC3, 0xD9,
+  0x9E, 0xB8, 0x7D, 0x7C, 0xEF, 0x5A, 0xEF, 0x8D, 0x6B, 0x23, 0x94, 0xAC,
+  0x50, 0x18, 0x10, 0xE4, 0x71, 0x59, 0x2B, 0x26, 0xE4, 0xBE, 0x42, 0xBF,
+  0x7F, 0x3D, 0xF9, 0x39, 0xF2, 0x8C, 0xA5, 0x92, 0xD1, 0x56, 0x49, 0x5E,
+  0x21, 0xA9, 0xD0, 0xE3, 0x6E, 0xB5, 0xFD, 0xE4, 0xFB, 0xDE, 0x57, 0xCD,
+  0xA9, 0xE5, 0xCC, 0x3B, 0x0B, 0x7B, 0xF0, 0x9E, 0xE5, 0xAB, 0xA9, 0xE9,
+  0x91, 0x7B, 0x77, 0x07, 0x6B, 0x8F, 0x25, 0xC6, 0xE7, 0xF3, 0x39, 0x10,
+  0x23, 0x18, 0x28, 0xBD, 0xC7, 0xF7, 0x9E, 0xEF, 0xEF, 0x56, 0xAB, 0xAD,
+  0x79, 0xDB, 0xAF, 0x3C, 0xCF, 0x83, 0xBC, 0xD2, 0x94, 0xAC, 0xAE, 0xD0,
+  0x18, 0x70, 0x3C, 0xE9, 0xB6, 0x27, 0xB2, 0x1A, 0xF3, 0x96, 0x77, 0x5C,
+  0x5A, 0x83, 0xC3, 0x20, 0xC4, 0x68, 0xA1, 0xD7, 0x0B, 0xBD, 0x76, 0xD9,
+  0xC5, 0x1B, 0xAF, 0x55, 0xD7, 0x29, 0x69, 0xFA, 0x48, 0x69, 0xD6, 0x57,
+  0x64, 0xCD, 0x9A, 0x99, 0xED, 0xAA, 0x39, 0xC7, 0x3D, 0x29, 0x2C, 0x8A,
+  0x02, 0x93, 0x08, 0x47, 0x91, 0x0F, 0x0C, 0xDF, 0x5C, 0xA4, 0xA5, 0xEF,
+  0xFE, 0x6D, 0x28, 0xD4, 0xF8, 0x51, 0x68, 0x44, 0x08, 0xC1, 0xE0, 0x5B,
+  0x98, 0xFF, 0x65, 0x5D, 0x8D, 0x36, 0xEC, 0x81, 0xB3, 0x60, 0xF6, 0x50,
+  0xA1, 0x28, 0x25, 0xBD, 0x79, 0xE0, 0x62, 0x7F, 0xB0, 0x15, 0x4A, 0xC9,
+  0x60, 0x0B, 0x56, 0x21, 0x88, 0x8D, 0xD0, 0x0E, 0xAC, 0x2D, 0xE3, 0x8D,
+  0x71, 0xE8, 0x80, 0x3B, 0x2B, 0xE9, 0x1D, 0xE0, 0x6A, 0x85, 0xE4, 0x54,
+  0x7F, 0xD7, 0x94, 0x09, 0x98, 0xD4, 0x40, 0x1A, 0x68, 0xB7, 0x9E, 0x24,
+  0x49, 0x37, 0x63, 0x0C, 0x44, 0x19, 0xAB, 0x8E, 0x13, 0x77, 0x4C, 0x06,
+  0x08, 0x70, 0x0A, 0xB4, 0xC0, 0xC6, 0x5E, 0x5A, 0x3E, 0x78, 0xFC, 0x5A,
+  0xB5, 0x4A, 0x97, 0x6B, 0x68, 0x89, 0x34, 0xCD, 0x43, 0x0F, 0xA9, 0x23,
+  0xAD, 0x85, 0xBD, 0x94, 0xE1, 0x55, 0x88, 0x6A, 0x1A, 0xC3, 0xA1, 0x0D,
+  0x90, 0x0F, 0x1E, 0x0B, 0xC4, 0xB7, 0x75, 0xF4, 0xFD, 0x60, 0xD7, 0x42,
+  0x7F, 0xEA, 0xB8, 0xA5, 0x8C, 0x5A, 0xBA, 0x74, 0x37, 0x21, 0x53, 0xB5,
+  0x5B, 0xD8, 0x4E, 0xF9, 0xE3, 0xDB, 0xD3, 0x5C, 0x7B, 0x5D, 0x97, 0x7F,
+  0x94, 0x7E, 0x5D, 0x92, 0x3A, 0x02, 0x7D, 0x51, 0x27, 0xC8, 0x3B, 0x77,
+  0xE8, 0x86, 0x56, 0x97, 0x8D, 0xD2, 0x1D, 0xB5, 0x3B, 0xD1, 0xD1, 0x3D,
+  0x77, 0xAB, 0xF8, 0x0C, 0xCB, 0x82, 0xE4, 0xB3, 0xE3, 0x86, 0x6C, 0x2F,
+  0x47, 0xBE, 0x5C, 0x3A, 0x5C, 0xAB, 0xB9, 0x51, 0x27, 0x5D, 0xF3, 0x0F,
+  0xD5, 0xC9, 0xEA, 0x4E, 0xB8, 0x20, 0xFC, 0xD3, 0x8A, 0xB6, 0x7D, 0x76,
+  0x49, 0xE6, 0xB6, 0xE7, 0x4B, 0x85, 0x6D, 0xF9, 0xAE, 0xCF, 0x39, 0x1C,
+  0xA7, 0x2E, 0xF0, 0xD8, 0xC6, 0x34, 0xA5, 0xAB, 0x2E, 0xB7, 0x78, 0x9A,
+  0x41, 0x6F, 0xED, 0x87, 0x10, 0xAB, 0xA9, 0x34, 0xAE, 0xEE, 0x0A, 0xF5,
+  0xC7, 0x16, 0x3E, 0xBA, 0x3B, 0xF2, 0xC5, 0x4F, 0xD3, 0x28, 0x88, 0xB3,
+  0x28, 0xCC, 0xEF, 0xD1, 0x32, 0xC4, 0x96, 0x5E, 0xB8, 0x0E, 0xE7, 0x09,
+  0xF2, 0x7A, 0x56, 0xC6, 0xA4, 0xBB, 0x28, 0x0E, 0x48, 0x1E, 0x17, 0xF9,
+  0xBC, 0xBC, 0x49, 0x81, 0xF1, 0xC6, 0x79, 0x12, 0xB2, 0xAC, 0x55, 0xBF,
+  0x57, 0x28, 0x21, 0x01, 0x49, 0x8B, 0xB0, 0xC8, 0x16, 0xF4, 0x02, 0x68,
+  0x06, 0xD4, 0x4D, 0x92, 0xC5, 0x33, 0x0A, 0xD4, 0x30, 0x0E, 0x92, 0x74,
+  0xB9, 0x17, 0x68, 0x59, 0x96, 0x06, 0x79, 0x44, 0xC2, 0x45, 0x5C, 0xAE,
+  0x46, 0x57, 0x55, 0x54, 0x14, 0xE9, 0x0C, 0x8E, 0x7A, 0x9B, 0x74, 0x45,
+  0x82, 0x7C, 0x53, 0xB8, 0x5F, 0xFE, 0xD0, 0xC0, 0x7C, 0xCB, 0x75, 0x92,
+  0xBD, 0xE4, 0x8C, 0xF6, 0xC6, 0x2C, 0x3E, 0x02, 0x5A, 0xD4, 0xEA, 0x95,
+  0x0F, 0xD2, 0x24, 0x93, 0xE9, 0xF7, 0x6D, 0x96, 0x51, 0x16, 0x14, 0x61,
+  0x06, 0x70, 0xBC, 0x99, 0x1C, 0x4E, 0x8D, 0xF0, 0x16, 0x95, 0x5A, 0x9D,
+  0x24, 0xBB, 0x06, 0xFF, 0x2A, 0x21, 0x6F, 0x51, 0xD8, 0x2E, 0xD7, 0xAD,
+  0x80, 0xBF, 0x32, 0x4E, 0x83, 0xC2, 0x5D, 0x1F, 0xA6, 0xF1, 0xE4, 0x9D,
+  0xE5, 0x3F, 0x01, 0x8C, 0x9A, 0x03, 0xD5, 0x9A, 0x5E, 0x4A, 0x09, 0x4F,
+  0xE4, 0xA8, 0x84, 0x2D, 0xDE, 0xC3, 0x33, 0xE9, 0xB4, 0xB7, 0x5B, 0xFD,
+  0x03, 0x22, 0x98, 0xA2, 0xB9, 0x65, 0x05, 0x00, 0x00,
+};
+
+// /level_4_on.svg: 1381 bytes, 669 compressed.
+const uint8_t kWebAsset8[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x54,
+  0xC9, 0x6E, 0xDB, 0x30, 0x10, 0xBD, 0xFB, 0x2B, 0x54, 0xE6, 0x92, 0xA0,
+  0x95, 0x48, 0xAD, 0x96, 0x14, 0xCB, 0x39, 0xB4, 0x48, 0x90, 0x6B, 0x17,
+  0xF4, 0xCC, 0x50, 0x94, 0xCD, 0x46, 0x22, 0x0D, 0x92, 0x8E, 0xE3, 0xBF,
+  0xEF, 0x50, 0xAB, 0x5D, 0x04, 0xA8, 0x2F, 0xE6, 0xBC, 0x79, 0xC3, 0xD9,
+  0x9E, 0xB8, 0x79, 0x78, 0xEF, 0x5A, 0xEF, 0x8D, 0x6B, 0x23, 0x94, 0xAC,
+  0x50, 0x18, 0x10, 0xE4, 0x71, 0xC9, 0x54, 0x2D, 0xE4, 0xAE, 0x42, 0xBF,
+  0x7E, 0x3E, 0xFA, 0x39, 0xF2, 0x8C, 0xA5, 0xB2, 0xA6, 0xAD, 0x92, 0xBC,
+  0x42, 0x52, 0xA1, 0x87, 0xED, 0x6A, 0xF3, 0xC9, 0xF7, 0xBD, 0xAF, 0x9A,
+  0x53, 0xCB, 0x6B, 0xEF, 0x24, 0xEC, 0xDE, 0x7B, 0x96, 0xAF, 0x86, 0xD1,
+  0x03, 0xF7, 0x6E, 0xF7, 0xD6, 0x1E, 0x4A, 0x8C, 0x4F, 0xA7, 0x53, 0x20,
+  0x46, 0x30, 0x50, 0x7A, 0x87, 0xEF, 0x3C, 0xDF, 0xDF, 0xAE, 0x56, 0x1B,
+  0xF3, 0xB6, 0x5B, 0x79, 0x9E, 0x07, 0x79, 0xA5, 0x29, 0x6B, 0x56, 0xA1,
+  0x31, 0xE0, 0x70, 0xD4, 0x6D, 0x4F, 0xAC, 0x19, 0xE6, 0x2D, 0xEF, 0xB8,
+  0xB4, 0x06, 0x87, 0x41, 0x88, 0xD1, 0x42, 0x67, 0x0B, 0x9D, 0xB9, 0xEC,
+  0xE2, 0x8D, 0x33, 0xD5, 0x75, 0x4A, 0x9A, 0x3E, 0x52, 0x9A, 0x9B, 0x0B,
+  0xB2, 0xAE, 0x9B, 0x99, 0xED, 0xAA, 0x39, 0xC5, 0x3D, 0x29, 0x2C, 0x8A,
+  0x02, 0x93, 0x08, 0x47, 0x91, 0x0F, 0x0C, 0xDF, 0x9C, 0xA5, 0xA5, 0xEF,
+  0xFE, 0x75, 0x28, 0xD4, 0xF8, 0x51, 0x68, 0x44, 0x08, 0xC1, 0xE0, 0x5B,
+  0x98, 0xFF, 0x65, 0x5D, 0x8C, 0x36, 0xEC, 0x81, 0x93, 0xA8, 0xED, 0xBE,
+  0x42, 0x51, 0x4A, 0x7A, 0x73, 0xCF, 0xC5, 0x6E, 0x6F, 0x2B, 0x94, 0x92,
+  0xC1, 0x16, 0x75, 0x85, 0x20, 0x36, 0x42, 0x5B, 0xB0, 0x36, 0x35, 0x6F,
+  0x8C, 0x43, 0x07, 0xDC, 0x59, 0x49, 0xEF, 0x00, 0x57, 0x2B, 0x24, 0xA7,
+  0xFA, 0x49, 0xD3, 0x5A, 0xC0, 0xA4, 0x06, 0xD2, 0x40, 0xBB, 0xF6, 0x24,
+  0x49, 0xBA, 0x1E, 0x63, 0x20, 0xCA, 0x58, 0x75, 0x98, 0xB8, 0x63, 0x32,
+  0x40, 0x80, 0x53, 0xA0, 0x05, 0x36, 0xF6, 0xDC, 0xF2, 0xC1, 0xE3, 0x33,
+  0xD5, 0x2A, 0x5D, 0xDE, 0x40, 0x4B, 0xA4, 0x69, 0xEE, 0x7B, 0x48, 0x1D,
+  0x28, 0x13, 0xF6, 0x5C, 0x86, 0x17, 0x21, 0xAA, 0x69, 0x0C, 0x87, 0x36,
+  0x40, 0x3E, 0x78, 0x2C, 0x10, 0x5F, 0xD7, 0xD1, 0xF7, 0x83, 0x5D, 0x0B,
+  0xFD, 0xA9, 0xE3, 0x96, 0xD6, 0xD4, 0xD2, 0xA5, 0xBB, 0x09, 0x99, 0xAA,
+  0xDD, 0xC0, 0x76, 0xCA, 0xEF, 0xDF, 0x1E, 0xE7, 0xDA, 0x19, 0x2B, 0x7F,
+  0x2B, 0xFD, 0xBA, 0x24, 0x75, 0x04, 0xFA, 0xA2, 0x8E, 0x90, 0x77, 0xEE,
+  0xD0, 0x0D, 0x8D, 0x95, 0x8D, 0xD2, 0x1D, 0xB5, 0x5B, 0xD1, 0xD1, 0x1D,
+  0x77, 0xAB, 0xF8, 0x0C, 0xCB, 0x82, 0xE4, 0xB3, 0xE3, 0x8A, 0x6C, 0xCF,
+  0x07, 0xBE, 0x5C, 0x3A, 0x5C, 0xAB, 0xB9, 0x51, 0x47, 0xCD, 0xF8, 0x87,
+  0xEA, 0xAC, 0x59, 0x27, 0x5C, 0x10, 0xFE, 0x61, 0x45, 0xDB, 0x3E, 0xBB,
+  0x24, 0x73, 0xDB, 0xF3, 0xA5, 0xC2, 0xB6, 0x7C, 0xDB, 0xE7, 0x1C, 0x8E,
+  0x53, 0x17, 0x78, 0x6C, 0x63, 0x9A, 0xD2, 0x45, 0x97, 0x1B, 0x3C, 0xCD,
+  0xA0, 0xB7, 0x76, 0x43, 0x88, 0xD5, 0x54, 0x1A, 0x57, 0x77, 0x85, 0xFA,
+  0x63, 0x0B, 0x1F, 0xDD, 0x2D, 0xF9, 0xE2, 0xA7, 0x69, 0x14, 0xC4, 0x59,
+  0x14, 0xE6, 0x77, 0x68, 0x19, 0x62, 0x4B, 0xCF, 0x5C, 0x87, 0xF3, 0x04,
+  0x39, 0x9B, 0x95, 0x31, 0xE9, 0x2E, 0x8A, 0x03, 0x92, 0xC7, 0x45, 0x3E,
+  0x2F, 0x6F, 0x52, 0x60, 0xBC, 0x76, 0x9E, 0x84, 0x2C, 0x6B, 0xD5, 0xEF,
+  0x15, 0x4A, 0x48, 0x40, 0xD2, 0x22, 0x2C, 0xB2, 0x05, 0x3D, 0x03, 0x9A,
+  0x01, 0x75, 0x9D, 0x64, 0xF1, 0x8C, 0x02, 0x35, 0x8C, 0x83, 0x24, 0x5D,
+  0xEE, 0x05, 0x5A, 0x96, 0xA5, 0x41, 0x1E, 0x91, 0x70, 0x11, 0x97, 0xAB,
+  0xD1, 0x55, 0x15, 0x15, 0x45, 0x3A, 0x83, 0xA3, 0xDE, 0x26, 0x5D, 0x91,
+  0x20, 0x5F, 0x17, 0xEE, 0x97, 0xDF, 0x37, 0x30, 0xDF, 0xF2, 0x26, 0xC9,
+  0x5E, 0xF2, 0x9A, 0xF6, 0xC6, 0x22, 0x3E, 0xD0, 0xA2, 0x56, 0xAF, 0x7C,
+  0x90, 0x26, 0x21, 0xA3, 0xE9, 0xF7, 0x6D, 0x96, 0x51, 0x16, 0x14, 0x61,
+  0x06, 0x70, 0xBC, 0x9E, 0x1C, 0x4E, 0x8D, 0xF0, 0x16, 0x95, 0x5A, 0x1D,
+  0x65, 0x7D, 0x09, 0xFE, 0x51, 0x42, 0x5E, 0xA3, 0xB0, 0x5D, 0xAE, 0x5B,
+  0x01, 0x7F, 0x65, 0x9C, 0x06, 0x85, 0xBB, 0x3E, 0x4C, 0xE3, 0xC9, 0xFB,
+  0x6F, 0x05, 0x7E, 0x4D, 0xCD, 0x9E, 0x6A, 0x4D, 0xCF, 0xA5, 0x84, 0x27,
+  0x72, 0x54, 0xC2, 0x06, 0xEF, 0xE0, 0x99, 0x74, 0xDA, 0xDB, 0xAE, 0xFE,
+  0x02, 0x8E, 0xCC, 0x38, 0x49, 0x65, 0x05, 0x00, 0x00,
+};
+
+// /ui.html: 4564 bytes, 1666 compressed.
+const uint8_t kWebAsset9[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xB5, 0x58,
+  0x59, 0x73, 0xDB, 0x36, 0x10, 0x7E, 0x96, 0x7F, 0x05, 0xC2, 0x87, 0xAA,
+  0x9D, 0x94, 0xA4, 0x2E, 0x5B, 0x8E, 0x2D, 0xA9, 0xA3, 0x3A, 0xBE, 0x9A,
+  0xC4, 0x77, 0xDC, 0x1C, 0xD3, 0xF1, 0x40, 0xC4, 0x92, 0x84, 0x4D, 0x12,
+  0x0C, 0x01, 0xEA, 0x48, 0xA7, 0xFD, 0xED, 0x5D, 0xF0, 0x90, 0xA8, 0xC3,
+  0x89, 0xDB, 0xA4, 0x0F, 0x92, 0x80, 0x05, 0xB0, 0xFB, 0xED, 0x87, 0xDD,
+  0x05, 0xA0, 0xAD, 0xDE, 0xB3, 0x97, 0xE7, 0x07, 0x37, 0xEF, 0x2F, 0x0E,
+  0x89, 0xAF, 0xC2, 0x60, 0xB0, 0xD5, 0xD3, 0x3F, 0x24, 0xA0, 0x91, 0xD7,
+  0x37, 0x20, 0x32, 0xB4, 0x00, 0x28, 0x1B, 0x6C, 0xD5, 0x7A, 0x21, 0x28,
+  0x4A, 0x1C, 0x9F, 0x26, 0x12, 0x54, 0xDF, 0x48, 0x95, 0x6B, 0xEE, 0x1A,
+  0x73, 0xB9, 0xAF, 0x54, 0x6C, 0xC2, 0xA7, 0x94, 0x8F, 0xFB, 0xC6, 0x3B,
+  0xF3, 0xED, 0xD0, 0x3C, 0x10, 0x61, 0x4C, 0x15, 0x1F, 0x05, 0x60, 0x10,
+  0x47, 0x44, 0x0A, 0x22, 0x5C, 0x74, 0x7A, 0xD8, 0x07, 0xE6, 0x41, 0xB6,
+  0x4C, 0x71, 0x15, 0xC0, 0xE0, 0x44, 0x84, 0x40, 0x6E, 0x20, 0x8C, 0x21,
+  0xA1, 0x2A, 0x4D, 0xA0, 0x67, 0xE7, 0xF2, 0x52, 0x6F, 0x44, 0x43, 0xE8,
+  0x1B, 0x63, 0x0E, 0x93, 0x58, 0x24, 0xAA, 0xA2, 0x6A, 0xC2, 0x99, 0xF2,
+  0xFB, 0x0C, 0xC6, 0xDC, 0x01, 0x33, 0xEB, 0xFC, 0x4C, 0x78, 0xC4, 0x15,
+  0xA7, 0x81, 0x29, 0x1D, 0x1A, 0x40, 0xBF, 0x69, 0x35, 0x32, 0x43, 0x01,
+  0x8F, 0x1E, 0x48, 0x02, 0x41, 0xBF, 0x2E, 0x7D, 0xD4, 0xE1, 0xA4, 0x8A,
+  0x70, 0x54, 0x53, 0x27, 0x6A, 0x16, 0x43, 0xBF, 0xCE, 0x43, 0xEA, 0x81,
+  0x3D, 0x35, 0x73, 0x99, 0x9F, 0x80, 0xDB, 0xAF, 0xBB, 0x74, 0xAC, 0xBB,
+  0x16, 0x7E, 0xFD, 0x32, 0xEE, 0x77, 0x1B, 0x5D, 0xD6, 0xA2, 0x3B, 0x9D,
+  0x3A, 0xB1, 0xB5, 0x3E, 0xA9, 0x66, 0x01, 0xE4, 0x8B, 0x0D, 0x05, 0x53,
+  0x65, 0x3B, 0x52, 0xA2, 0x21, 0x42, 0x48, 0x6D, 0x24, 0xD8, 0x8C, 0xFC,
+  0x49, 0x62, 0xCA, 0x18, 0x8F, 0x3C, 0x53, 0x89, 0x78, 0x8F, 0x74, 0x1B,
+  0xF1, 0x74, 0x9F, 0xFC, 0x85, 0x0B, 0xED, 0x6C, 0xE5, 0x60, 0x0B, 0x9B,
+  0xCF, 0x4C, 0x93, 0x1C, 0xA1, 0x2B, 0x64, 0x38, 0x91, 0x9A, 0x01, 0xD3,
+  0xD4, 0x0A, 0x72, 0xA8, 0x19, 0x04, 0x43, 0x13, 0x2A, 0xF7, 0x6C, 0x5C,
+  0x43, 0x9D, 0x07, 0x64, 0xD2, 0xB7, 0x46, 0x42, 0x28, 0xA9, 0x12, 0x1A,
+  0x3B, 0x2C, 0xB2, 0x1C, 0x11, 0xDA, 0x2E, 0x2A, 0x30, 0xE9, 0x04, 0xB4,
+  0x06, 0xBB, 0x63, 0x75, 0xAD, 0x86, 0x86, 0xB2, 0x24, 0xB6, 0x42, 0x8E,
+  0x73, 0x11, 0x5F, 0x46, 0x80, 0x91, 0x01, 0x90, 0x3E, 0x00, 0x32, 0xC9,
+  0x91, 0x48, 0x2F, 0xE1, 0x6A, 0x86, 0x62, 0x9F, 0xB6, 0x77, 0x3B, 0xE6,
+  0x64, 0xEC, 0xBE, 0x8B, 0x3F, 0xC5, 0x1F, 0x3E, 0xDC, 0x5E, 0x1E, 0xBF,
+  0xDA, 0xB9, 0x19, 0xFA, 0xDB, 0x17, 0xB7, 0xC1, 0xF1, 0xB9, 0x7B, 0x79,
+  0x76, 0x72, 0x2D, 0x5E, 0xB6, 0xA6, 0xA3, 0xC3, 0xE7, 0x97, 0x0F, 0x17,
+  0xD3, 0x83, 0xE1, 0x51, 0x70, 0x76, 0x08, 0x63, 0x71, 0x78, 0xD2, 0xBE,
+  0x0E, 0x1A, 0x92, 0x8F, 0x6E, 0x9D, 0xF3, 0xCB, 0xDB, 0xE8, 0x0C, 0x77,
+  0x27, 0x11, 0x52, 0x8A, 0x84, 0x7B, 0x3C, 0xEA, 0x1B, 0x34, 0x12, 0xD1,
+  0x2C, 0x14, 0xA9, 0x26, 0xA7, 0x70, 0xF9, 0x35, 0x55, 0x20, 0x15, 0x6E,
+  0x62, 0x18, 0xF3, 0x00, 0x18, 0xA1, 0x11, 0x23, 0x88, 0x90, 0xBB, 0x1C,
+  0x3B, 0x07, 0xD7, 0xD7, 0x19, 0x0F, 0x95, 0x1D, 0x5B, 0x02, 0xBC, 0xCC,
+  0x4B, 0x48, 0xA7, 0x9A, 0x87, 0x35, 0x52, 0xE6, 0x02, 0xBB, 0x6D, 0xB5,
+  0xAD, 0x6E, 0xC6, 0xC8, 0x5C, 0xB6, 0xA0, 0x63, 0xDD, 0xFB, 0x5F, 0x6F,
+  0xDF, 0x73, 0x7E, 0x7D, 0x7A, 0x04, 0xAF, 0x9A, 0xEC, 0x38, 0xFC, 0xED,
+  0x6A, 0xF8, 0x30, 0x73, 0xD2, 0x93, 0xE1, 0xC9, 0x95, 0xD7, 0x6E, 0x9D,
+  0x87, 0x6F, 0x9D, 0xC9, 0xA4, 0x2B, 0xA2, 0xF6, 0xD5, 0x7B, 0xE6, 0x75,
+  0x6E, 0xE9, 0xF3, 0x8B, 0xF0, 0xFA, 0x46, 0x7E, 0xB6, 0x5F, 0xED, 0xEC,
+  0x8E, 0x47, 0xEC, 0xF0, 0xDE, 0xEF, 0xA4, 0x5F, 0xF7, 0xFE, 0xE4, 0xE6,
+  0xCD, 0xEB, 0x6D, 0x72, 0xED, 0xF3, 0x30, 0x73, 0xFC, 0x0A, 0x64, 0x2C,
+  0x22, 0x66, 0xDD, 0x4B, 0x72, 0x7A, 0xB8, 0x4B, 0x64, 0x1A, 0xEB, 0x10,
+  0x27, 0xC2, 0x2D, 0x26, 0x42, 0x00, 0x21, 0x86, 0xBA, 0xCC, 0x59, 0x02,
+  0xC6, 0x29, 0xF9, 0x94, 0x42, 0xC2, 0x41, 0x16, 0x34, 0x69, 0x9D, 0xBF,
+  0x0F, 0xAF, 0xCE, 0x4E, 0xCF, 0x8E, 0xF7, 0xAA, 0xDA, 0x98, 0x00, 0x19,
+  0xD5, 0x15, 0x99, 0x88, 0xE4, 0x81, 0x70, 0x97, 0xCC, 0x44, 0x4A, 0x74,
+  0x06, 0x11, 0xE5, 0x03, 0xC6, 0xA6, 0x07, 0xD8, 0xA3, 0xC4, 0xC5, 0x1D,
+  0x40, 0x1E, 0x17, 0xBA, 0x3E, 0xE2, 0xD4, 0x40, 0x21, 0x16, 0xF2, 0xE2,
+  0x0F, 0x14, 0x61, 0xA0, 0x3B, 0x09, 0x8F, 0x15, 0x91, 0x89, 0xB3, 0xA0,
+  0x1D, 0x3D, 0xB4, 0x0A, 0xEA, 0x35, 0xDB, 0x01, 0x1F, 0x49, 0x5B, 0x57,
+  0x8C, 0x6D, 0xE9, 0xF3, 0x31, 0x52, 0xAE, 0x83, 0x70, 0xDE, 0x47, 0x30,
+  0xC6, 0x00, 0xC3, 0x3E, 0xD3, 0x83, 0x2A, 0x31, 0x45, 0x9E, 0xAC, 0x34,
+  0x99, 0xFB, 0x63, 0x37, 0x71, 0x23, 0x1B, 0x73, 0x81, 0xDE, 0xC2, 0x15,
+  0xBD, 0xBD, 0x67, 0x1F, 0x21, 0x62, 0xDC, 0xFD, 0x43, 0xFB, 0xD2, 0xB3,
+  0xCB, 0x82, 0x85, 0x3E, 0x65, 0xDE, 0x16, 0x35, 0x23, 0x1B, 0xD4, 0x19,
+  0xAA, 0xC7, 0x18, 0x1F, 0x13, 0x27, 0xA0, 0x52, 0xF6, 0xEB, 0x7A, 0x98,
+  0xF2, 0x08, 0x92, 0xBA, 0xDE, 0xA9, 0x5A, 0x2F, 0xA2, 0xE5, 0x90, 0x81,
+  0xCD, 0x11, 0x4D, 0x48, 0xFE, 0x63, 0x32, 0x70, 0x69, 0x8A, 0x0C, 0x15,
+  0x5D, 0x97, 0x4F, 0x81, 0xE9, 0x1C, 0xC7, 0xE4, 0x12, 0x58, 0x6F, 0xF4,
+  0x6C, 0xEE, 0x61, 0xCD, 0x13, 0xBA, 0x6C, 0xD6, 0xD0, 0xDB, 0x8A, 0x15,
+  0x63, 0x6E, 0xC5, 0x74, 0x83, 0x94, 0xB3, 0x6C, 0x46, 0x15, 0x46, 0x61,
+  0xCB, 0x1C, 0x25, 0xB8, 0xDD, 0xF9, 0x68, 0xAD, 0x17, 0x0F, 0x86, 0x07,
+  0xE4, 0x00, 0x57, 0xA2, 0x81, 0x9E, 0x1D, 0xE7, 0x6B, 0x6C, 0x5C, 0x94,
+  0xB7, 0xE2, 0x95, 0xB5, 0xBA, 0x1A, 0x95, 0xE8, 0x30, 0x0C, 0x7D, 0x4D,
+  0xB3, 0x29, 0xA2, 0x60, 0x86, 0xF1, 0xCE, 0x30, 0xD0, 0x63, 0x1E, 0x21,
+  0x00, 0xA4, 0x8E, 0x97, 0x0B, 0x5D, 0x8C, 0x03, 0x6A, 0x3A, 0x3C, 0x71,
+  0x02, 0x30, 0x85, 0x19, 0x09, 0xE5, 0xF8, 0x5A, 0xA2, 0xA7, 0xEA, 0xDF,
+  0xC0, 0xD3, 0x44, 0xF3, 0x41, 0x61, 0x1C, 0x5D, 0x2A, 0xAD, 0xF7, 0x6C,
+  0x34, 0x94, 0x13, 0xA6, 0x9D, 0x28, 0x15, 0x62, 0xE1, 0xC5, 0x18, 0xCE,
+  0xBE, 0x4D, 0x86, 0x87, 0x08, 0x24, 0xCB, 0x18, 0xB2, 0x91, 0xC2, 0xF9,
+  0x51, 0xAA, 0x94, 0x88, 0x8A, 0x4A, 0x9A, 0x77, 0x8C, 0x39, 0x5D, 0x81,
+  0x90, 0x78, 0x72, 0x30, 0xAA, 0xA8, 0xC9, 0xB8, 0x0C, 0xF9, 0x5C, 0xB9,
+  0x41, 0x68, 0xC2, 0xA9, 0xE9, 0x73, 0xC6, 0x00, 0xF3, 0x4C, 0x25, 0x29,
+  0x9E, 0x27, 0x3F, 0x28, 0x1E, 0x82, 0xDC, 0xEF, 0xD9, 0xB9, 0x9A, 0x82,
+  0x9E, 0x12, 0x76, 0x01, 0x7A, 0x6B, 0x99, 0xF0, 0xAF, 0xEE, 0x48, 0x22,
+  0x26, 0x59, 0xF2, 0xA2, 0xDB, 0xB5, 0x3C, 0xDB, 0xCE, 0xCF, 0xEC, 0xF3,
+  0xA3, 0xA3, 0x3C, 0x65, 0x72, 0xE9, 0x92, 0x3E, 0x3C, 0x79, 0x42, 0x53,
+  0xB8, 0x2E, 0x1E, 0x90, 0x66, 0xB3, 0x41, 0x0A, 0x41, 0x8B, 0xC4, 0x69,
+  0x10, 0xE4, 0x1B, 0x62, 0x94, 0x0B, 0x6B, 0x3D, 0x9A, 0xF1, 0x11, 0x8B,
+  0x09, 0x02, 0x18, 0xA9, 0x85, 0xE7, 0xD8, 0x26, 0xF8, 0x29, 0xA3, 0xCD,
+  0x20, 0x22, 0x72, 0x02, 0xEE, 0x3C, 0xF4, 0xEB, 0xD9, 0xDC, 0xBB, 0xA2,
+  0xFB, 0xE3, 0x4F, 0xFB, 0xF5, 0xB5, 0x8D, 0xCC, 0xB5, 0x21, 0x02, 0x83,
+  0x64, 0x95, 0x13, 0xE5, 0xFA, 0x30, 0x90, 0xFC, 0x33, 0xEC, 0x35, 0xAD,
+  0x1D, 0x08, 0xF7, 0x11, 0x93, 0x48, 0xF6, 0x46, 0x01, 0x1E, 0x2A, 0xFB,
+  0xC5, 0xD6, 0x8E, 0x36, 0xCD, 0xDD, 0xC6, 0xB9, 0xC6, 0x02, 0xA1, 0x31,
+  0x20, 0xE8, 0x38, 0xD2, 0x8B, 0x4B, 0xE8, 0xDC, 0xF9, 0x92, 0xD6, 0x4A,
+  0x27, 0xDB, 0xD7, 0xE4, 0x11, 0x2A, 0x75, 0x01, 0x58, 0xE7, 0x2C, 0x64,
+  0x66, 0xA7, 0xE4, 0x6A, 0xC7, 0xC8, 0xF5, 0x65, 0x0C, 0x69, 0xC6, 0xDF,
+  0x08, 0x06, 0x05, 0xDF, 0x5A, 0xE4, 0x77, 0x06, 0x5A, 0x82, 0x39, 0xDE,
+  0x29, 0x45, 0x15, 0x6D, 0x9A, 0x36, 0x2F, 0x11, 0x69, 0x5C, 0xE4, 0x4F,
+  0xC6, 0xF2, 0x66, 0x5A, 0x49, 0x88, 0x6A, 0x72, 0xDE, 0xB5, 0x93, 0xBA,
+  0x77, 0xE7, 0x08, 0x81, 0x27, 0x8F, 0x57, 0x61, 0x3C, 0x13, 0x97, 0x84,
+  0x37, 0x37, 0x31, 0x4E, 0xA5, 0xC2, 0x92, 0x2C, 0x1F, 0x74, 0xBB, 0x35,
+  0x2D, 0x93, 0x85, 0xFE, 0x27, 0xFB, 0x0C, 0xFC, 0x34, 0x34, 0x48, 0x6D,
+  0xB3, 0xF9, 0xD6, 0x26, 0xF3, 0x0A, 0xCF, 0xB1, 0xEF, 0x61, 0x1A, 0x4B,
+  0xA6, 0xFA, 0x82, 0xEB, 0xED, 0x4D, 0xB6, 0x65, 0x1A, 0x99, 0xE2, 0x7B,
+  0x18, 0x77, 0x29, 0xF6, 0x6A, 0x8F, 0xB8, 0xDD, 0xD9, 0x64, 0x3A, 0x01,
+  0x35, 0xC1, 0x3B, 0xC1, 0xF7, 0x30, 0x4E, 0x53, 0x25, 0x1E, 0xE5, 0xBC,
+  0xB1, 0xC9, 0xB8, 0x4E, 0x93, 0xCD, 0x96, 0x17, 0x75, 0x66, 0x29, 0x23,
+  0x9E, 0x16, 0xF4, 0xB5, 0x45, 0xD0, 0x1F, 0xD1, 0x68, 0x39, 0xE6, 0x51,
+  0xF0, 0x1D, 0x42, 0x1E, 0x79, 0x5E, 0x38, 0x8F, 0x9D, 0x35, 0xDF, 0xB5,
+  0xAC, 0x74, 0xDD, 0x68, 0x18, 0xFF, 0xCE, 0xF9, 0xC7, 0x0D, 0x57, 0xA2,
+  0xAA, 0x6A, 0xA1, 0xC8, 0xA7, 0xD0, 0xCB, 0x2F, 0x03, 0x01, 0x8C, 0x21,
+  0xB8, 0x6B, 0xDE, 0x61, 0xF5, 0xB2, 0xE4, 0xD8, 0xC3, 0x7B, 0x77, 0xBB,
+  0xD1, 0xE8, 0x8E, 0x9A, 0x8D, 0x6D, 0xBC, 0xFA, 0x81, 0x2E, 0x9E, 0x7D,
+  0xA3, 0xF5, 0x22, 0x9E, 0x2E, 0xE0, 0x07, 0x63, 0x9C, 0x6F, 0x7C, 0x0B,
+  0x84, 0xD6, 0x26, 0x08, 0xAD, 0x0A, 0x84, 0xA6, 0xDB, 0x75, 0xA1, 0xD9,
+  0x6C, 0x7E, 0x09, 0x42, 0xEB, 0x9B, 0x20, 0xB4, 0x37, 0x41, 0x68, 0x57,
+  0x20, 0x74, 0xA9, 0xB3, 0xBD, 0xF3, 0xA2, 0xDB, 0xFE, 0x12, 0x84, 0xB6,
+  0xF1, 0xA4, 0x28, 0x5C, 0x6A, 0xE7, 0x55, 0x7A, 0xB9, 0xB5, 0x5E, 0xB1,
+  0x9F, 0x10, 0xBC, 0x19, 0x12, 0x45, 0x13, 0x0F, 0xD4, 0x9D, 0xC2, 0x97,
+  0x1C, 0xD6, 0xD1, 0x60, 0x25, 0xA2, 0x6F, 0xB2, 0x51, 0xA2, 0x16, 0xEF,
+  0xBC, 0xA5, 0xF0, 0x5E, 0x1F, 0xFE, 0x6A, 0xB4, 0x93, 0x27, 0xF0, 0xBD,
+  0x76, 0xAC, 0xB5, 0xAC, 0x16, 0x1E, 0x6B, 0xD5, 0xD7, 0x59, 0xB3, 0x85,
+  0x8F, 0xB3, 0x52, 0x30, 0x12, 0x78, 0x77, 0x08, 0x73, 0x99, 0xA1, 0xCF,
+  0xC5, 0x15, 0xC7, 0xF0, 0x10, 0xFC, 0x9B, 0x1C, 0x54, 0x0E, 0xC1, 0x25,
+  0xB2, 0x1F, 0x83, 0x6A, 0x8E, 0xF1, 0xD2, 0xC2, 0xF1, 0x45, 0xFA, 0x84,
+  0x0C, 0x9D, 0x64, 0x30, 0xCA, 0x14, 0xAD, 0x72, 0xAA, 0x5D, 0x9E, 0xC7,
+  0x4F, 0x26, 0xA9, 0xA6, 0xD1, 0xA6, 0x13, 0xBC, 0xBB, 0xE2, 0x6A, 0x63,
+  0xDD, 0xD3, 0x46, 0xEE, 0xE8, 0xEA, 0x6D, 0xD0, 0x87, 0x71, 0x22, 0x22,
+  0x53, 0xD7, 0x94, 0x27, 0x57, 0xD6, 0x39, 0xF2, 0xDA, 0x2A, 0x72, 0x26,
+  0x26, 0xD1, 0x63, 0xD8, 0xCD, 0xFF, 0x0D, 0x7C, 0x66, 0xF5, 0x91, 0xF2,
+  0xBC, 0x9A, 0x1A, 0x4B, 0x69, 0x32, 0xDF, 0xD0, 0x52, 0x92, 0xA7, 0xC7,
+  0xC6, 0x77, 0x0B, 0x3E, 0x58, 0xEE, 0xA5, 0x85, 0x57, 0xD5, 0x94, 0xB9,
+  0x01, 0x4D, 0x20, 0x7B, 0xBD, 0xD0, 0x7B, 0x3A, 0xCD, 0x9F, 0x30, 0xF7,
+  0xFA, 0xB9, 0x36, 0xC3, 0xE7, 0x4B, 0xB3, 0x65, 0x75, 0x8A, 0xDE, 0xC6,
+  0xE7, 0x4B, 0xA1, 0xBB, 0xF2, 0x97, 0xC2, 0x3D, 0x1D, 0xD3, 0x5C, 0x6A,
+  0xE4, 0x26, 0x53, 0x8E, 0xAB, 0xB0, 0x1A, 0xB8, 0x2D, 0x0A, 0x8D, 0x9D,
+  0x36, 0x54, 0x15, 0x60, 0x44, 0x66, 0xAF, 0x9A, 0x9E, 0x9D, 0xFF, 0x85,
+  0xF3, 0x0F, 0xF8, 0x1B, 0x4F, 0x61, 0xD4, 0x11, 0x00, 0x00,
+};
+
+// /ui.js: 3618 bytes, 1120 compressed.
+const uint8_t kWebAsset10[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xC5, 0x56,
+  0x6D, 0x6F, 0xDB, 0x36, 0x10, 0xFE, 0x9E, 0x5F, 0x71, 0xD5, 0x0A, 0x44,
+  0x41, 0x1C, 0xD9, 0x69, 0x36, 0x14, 0xB0, 0xEB, 0x7D, 0x58, 0xB6, 0xAC,
+  0x18, 0xFA, 0x32, 0x2C, 0x19, 0x3A, 0xA0, 0x08, 0x02, 0x46, 0x3A, 0x59,
+  0x6A, 0x65, 0x52, 0x25, 0x29, 0xBB, 0x41, 0x91, 0xFF, 0xBE, 0x3B, 0x52,
+  0x92, 0x25, 0x2B, 0x5E, 0xE2, 0x7E, 0x99, 0x01, 0xC3, 0xE6, 0xF1, 0xDE,
+  0x5F, 0x1E, 0xDE, 0x4A, 0x68, 0x30, 0x56, 0x58, 0x84, 0x39, 0x7C, 0xBB,
+  0x3F, 0x38, 0x48, 0x2B, 0x19, 0xDB, 0x5C, 0x49, 0xA8, 0xCA, 0x84, 0xA8,
+  0x97, 0x74, 0x55, 0x99, 0xF0, 0x08, 0xBE, 0x1D, 0x00, 0x3C, 0x8F, 0xC4,
+  0x27, 0xF1, 0x35, 0xE4, 0xBF, 0x00, 0xF6, 0xAE, 0xC4, 0x29, 0x1C, 0xFE,
+  0xFE, 0xDB, 0xD5, 0xE1, 0xC8, 0x11, 0x2A, 0x5D, 0x4C, 0x21, 0x70, 0xBA,
+  0x02, 0x4F, 0x21, 0x05, 0xE2, 0xCA, 0xB1, 0x05, 0x9F, 0x8C, 0x92, 0x1D,
+  0xEA, 0x14, 0x3E, 0x7A, 0x2D, 0x00, 0x52, 0x2C, 0x99, 0xA1, 0xC8, 0x17,
+  0x99, 0xAD, 0x39, 0x00, 0x56, 0xA2, 0xA8, 0x98, 0x7A, 0x1A, 0x38, 0xC2,
+  0xFD, 0x08, 0xAE, 0xFD, 0x95, 0xA9, 0xE2, 0x18, 0x8D, 0x99, 0x82, 0xC9,
+  0xD4, 0x9A, 0x9D, 0x43, 0x4F, 0x47, 0xAD, 0x95, 0x9E, 0x42, 0xE3, 0x7D,
+  0xED, 0x30, 0x7F, 0x62, 0x25, 0x8D, 0x2A, 0x30, 0x2A, 0xD4, 0x22, 0x3C,
+  0x74, 0x6C, 0xB0, 0x40, 0x6B, 0x73, 0xB9, 0xF0, 0x71, 0x1F, 0x1E, 0xCD,
+  0x6A, 0x1B, 0x3E, 0xAC, 0x7C, 0x89, 0xAA, 0xB2, 0x53, 0x38, 0x9D, 0x4C,
+  0x26, 0x44, 0xB9, 0xA7, 0xEB, 0x6E, 0x5A, 0x5A, 0xBB, 0x21, 0xC7, 0xE1,
+  0xCD, 0xE4, 0x29, 0x84, 0xCF, 0x36, 0x47, 0x00, 0x8D, 0xB6, 0xD2, 0x92,
+  0xF5, 0xDE, 0xD3, 0xB7, 0x49, 0x2F, 0x73, 0xCC, 0x6A, 0x76, 0x47, 0xFB,
+  0x18, 0x94, 0x6A, 0x8D, 0x3A, 0xB8, 0x86, 0xF9, 0x7C, 0x0E, 0x56, 0x57,
+  0xD8, 0x28, 0x78, 0x1E, 0x06, 0x3F, 0xF8, 0xBB, 0xA3, 0xC8, 0xE2, 0x57,
+  0x1B, 0x06, 0xF0, 0xFE, 0x5D, 0x50, 0x7B, 0xDA, 0x5E, 0x9E, 0xDC, 0x5A,
+  0x49, 0x0C, 0x22, 0x49, 0xCE, 0x0B, 0x61, 0x4C, 0x18, 0xD0, 0xF9, 0x24,
+  0x97, 0xA9, 0xDA, 0xC5, 0xA9, 0x71, 0xA9, 0x56, 0xD8, 0x61, 0x4E, 0x30,
+  0x15, 0x55, 0x61, 0x3D, 0xFF, 0x3D, 0x60, 0x61, 0xF0, 0x3F, 0x3C, 0xB8,
+  0xB8, 0x78, 0x9A, 0x0B, 0x3D, 0xAD, 0x4F, 0xF0, 0x62, 0xE3, 0x32, 0xA7,
+  0x8B, 0xD9, 0xAD, 0xD0, 0x54, 0xA4, 0x1B, 0x8B, 0xCB, 0xB2, 0xB1, 0x5F,
+  0x67, 0xCC, 0x91, 0xAE, 0xE1, 0x18, 0x02, 0x38, 0xF7, 0x32, 0x06, 0xED,
+  0x5B, 0x95, 0xE0, 0xB9, 0x2A, 0x94, 0x6E, 0xB8, 0x96, 0x44, 0x08, 0xAE,
+  0x9B, 0xEB, 0x0B, 0x21, 0x7B, 0xB7, 0xA9, 0x90, 0xEE, 0x92, 0xEA, 0x3A,
+  0x1E, 0xC3, 0x55, 0x86, 0x20, 0xCC, 0x9D, 0x8C, 0x33, 0xAD, 0xA4, 0xAA,
+  0x0C, 0xAC, 0xF1, 0x96, 0xA4, 0xF4, 0x0A, 0x35, 0x94, 0x95, 0xC9, 0xD0,
+  0x80, 0x25, 0x16, 0x5F, 0x45, 0x14, 0x71, 0xE6, 0x7A, 0x04, 0x72, 0x0B,
+  0x71, 0x26, 0xE4, 0x02, 0x4D, 0x04, 0x18, 0x2D, 0x22, 0xF8, 0xE5, 0x8E,
+  0xB5, 0x09, 0xA9, 0x88, 0x5B, 0x43, 0x5C, 0xE4, 0x28, 0x6D, 0x04, 0x1F,
+  0x72, 0x9B, 0x51, 0x3F, 0x11, 0xFB, 0xA8, 0xA3, 0x26, 0x37, 0xA0, 0x64,
+  0x71, 0x07, 0x29, 0xDA, 0x38, 0xC3, 0x04, 0xD6, 0x19, 0x4A, 0x77, 0x5D,
+  0x8A, 0x05, 0x42, 0xA1, 0x44, 0x62, 0xA2, 0x4D, 0xCF, 0x15, 0xB9, 0xB1,
+  0x28, 0x2F, 0x94, 0xF6, 0x8D, 0xE7, 0x9B, 0x64, 0x45, 0x83, 0xBB, 0x36,
+  0xD4, 0x56, 0x12, 0xD7, 0xF0, 0x01, 0x6F, 0x2F, 0x55, 0xFC, 0x19, 0xA9,
+  0x4C, 0x6B, 0x33, 0x1D, 0x8F, 0x03, 0x4A, 0x50, 0xA1, 0x62, 0xC1, 0xE2,
+  0x51, 0xA6, 0x8C, 0xE5, 0x84, 0x8D, 0xD7, 0xC6, 0x67, 0x8C, 0x45, 0x55,
+  0x89, 0x92, 0x0C, 0xCF, 0x21, 0x15, 0x54, 0x74, 0xA6, 0xAE, 0x4D, 0x44,
+  0xF1, 0x13, 0x99, 0x89, 0xDB, 0x73, 0xD4, 0xB2, 0x73, 0x97, 0xBA, 0x4A,
+  0xB5, 0x22, 0x4B, 0x9A, 0x47, 0xF6, 0xBA, 0x23, 0x85, 0x2B, 0x8A, 0xBD,
+  0x11, 0xDD, 0x4C, 0xCC, 0x1F, 0x97, 0xEF, 0xDF, 0x45, 0xA5, 0xD0, 0x06,
+  0x3D, 0x47, 0xE4, 0x66, 0xE6, 0xA8, 0xAF, 0x2E, 0x2E, 0x94, 0xC1, 0x87,
+  0x5C, 0xE0, 0xB1, 0xF1, 0x6E, 0x10, 0x05, 0x80, 0x72, 0xFD, 0x86, 0x03,
+  0xCB, 0x6D, 0x9D, 0x7F, 0xAE, 0x63, 0x82, 0xAB, 0x3C, 0x46, 0x9A, 0x3F,
+  0x4A, 0xB3, 0xB6, 0x98, 0x44, 0x35, 0x08, 0x50, 0x13, 0x5C, 0xF9, 0xC1,
+  0x0E, 0xFB, 0xC9, 0x1C, 0xC1, 0x4F, 0x34, 0xE7, 0x0D, 0x04, 0x78, 0x47,
+  0xA8, 0x2D, 0xFA, 0xE0, 0x37, 0x3B, 0xD8, 0xAE, 0xC0, 0xEC, 0x80, 0x3F,
+  0x6D, 0x81, 0x4A, 0x72, 0xE4, 0x57, 0x8A, 0x25, 0xB4, 0x9B, 0xDA, 0x60,
+  0x5D, 0x9A, 0x7F, 0xDE, 0xBE, 0x79, 0x6D, 0x6D, 0xF9, 0x17, 0x7E, 0xA9,
+  0xC8, 0x2B, 0x36, 0x84, 0x51, 0x0D, 0x32, 0xC4, 0xF1, 0x82, 0xAC, 0x7B,
+  0x1A, 0x87, 0x16, 0x06, 0x7F, 0xFE, 0x7D, 0x15, 0x8C, 0x5A, 0x14, 0x85,
+  0x67, 0xDE, 0x35, 0x8C, 0x28, 0x80, 0x5A, 0xC3, 0x6B, 0x14, 0x09, 0xEA,
+  0x30, 0x38, 0x57, 0x92, 0x5C, 0xB2, 0x27, 0x0C, 0xB0, 0x2C, 0x22, 0xCA,
+  0xB2, 0xC8, 0x7D, 0xC5, 0xC7, 0x0E, 0x6D, 0x9D, 0x64, 0x17, 0xFD, 0x5C,
+  0xFA, 0x8D, 0xD5, 0x04, 0x7D, 0x79, 0x7A, 0x47, 0xBE, 0x1E, 0x8D, 0x9C,
+  0x66, 0x99, 0x3C, 0x70, 0xD5, 0x47, 0x3D, 0x9E, 0xA7, 0x1B, 0xAE, 0x4D,
+  0x1E, 0x7F, 0x0E, 0xF9, 0xE0, 0xE3, 0xEC, 0x4D, 0x1B, 0x45, 0xC3, 0x7F,
+  0x06, 0x23, 0xE9, 0xD8, 0x99, 0xDA, 0x66, 0xC9, 0x89, 0x79, 0x0B, 0x1D,
+  0x60, 0x1D, 0xC8, 0xF8, 0x37, 0x27, 0x0C, 0x22, 0x3E, 0x3D, 0x0E, 0x34,
+  0x5B, 0x9C, 0x3B, 0x51, 0xA6, 0x46, 0x60, 0x66, 0x75, 0xB8, 0x3B, 0xE9,
+  0x82, 0xAE, 0x0B, 0x54, 0x54, 0x56, 0x3D, 0x8A, 0x96, 0x43, 0xFE, 0xDD,
+  0x38, 0xDC, 0xC5, 0xA0, 0xA6, 0xD9, 0xBA, 0x58, 0x44, 0xA9, 0x9B, 0x74,
+  0x10, 0xB8, 0xE7, 0xDE, 0xE9, 0xC0, 0xBD, 0x58, 0xA9, 0x82, 0x0A, 0xB5,
+  0x8F, 0x87, 0x1B, 0x91, 0x5D, 0x4E, 0x3E, 0x64, 0xFA, 0xC5, 0xC0, 0x74,
+  0x82, 0x59, 0xB5, 0xDC, 0xC7, 0x70, 0x23, 0xB0, 0x8F, 0xD9, 0xB3, 0x81,
+  0xD9, 0x0C, 0x85, 0xDD, 0x33, 0xE2, 0x8D, 0xC8, 0x3E, 0xA6, 0x7F, 0x1C,
+  0x98, 0xE6, 0xFA, 0xEC, 0x61, 0xD6, 0xB3, 0xEF, 0x34, 0xD9, 0x5F, 0x25,
+  0x3A, 0x5D, 0x41, 0x72, 0x9B, 0x5D, 0x82, 0x0E, 0xB0, 0xDD, 0x98, 0x44,
+  0xDB, 0xA7, 0x2F, 0x3B, 0xEC, 0x8F, 0xC4, 0xFF, 0x34, 0x13, 0xDB, 0x5B,
+  0xC5, 0x4E, 0xFD, 0xFD, 0x8D, 0x82, 0xBE, 0x29, 0x2D, 0x5C, 0x21, 0x03,
+  0x62, 0x4E, 0x5D, 0x7E, 0x3A, 0xA3, 0x9F, 0x57, 0x54, 0xE2, 0x19, 0x1C,
+  0x1F, 0xE7, 0x5D, 0x64, 0x77, 0xE4, 0x36, 0x0B, 0x5D, 0x33, 0xC5, 0xAA,
+  0xB8, 0xE1, 0xF7, 0x2C, 0x27, 0x53, 0xD6, 0x12, 0xF2, 0x19, 0x1D, 0x33,
+  0xE0, 0x15, 0xF4, 0x86, 0xD4, 0x37, 0xFC, 0xBA, 0x11, 0x3C, 0x45, 0x66,
+  0xB5, 0x68, 0x9C, 0xEC, 0x45, 0xF7, 0x1D, 0xCA, 0xD2, 0xB4, 0xA7, 0x6D,
+  0x50, 0x3C, 0x56, 0xD6, 0x00, 0x62, 0xAF, 0x78, 0x7D, 0x4C, 0x7C, 0xD6,
+  0xAD, 0xE3, 0xD6, 0xC8, 0xD3, 0xEF, 0x10, 0x1E, 0x58, 0x97, 0xA7, 0x0E,
+  0xE0, 0x72, 0xDB, 0x05, 0xB7, 0x53, 0xB5, 0x4E, 0xB8, 0xD3, 0xC0, 0x8D,
+  0x7A, 0xC1, 0xDC, 0xF2, 0xA0, 0x5D, 0x3B, 0x37, 0xAF, 0xFF, 0xBE, 0x1B,
+  0xDF, 0xA3, 0x1D, 0xF2, 0xC4, 0xF5, 0xB0, 0x57, 0xA7, 0x81, 0x7B, 0xCD,
+  0xB6, 0xF1, 0x7F, 0x6D, 0xC4, 0x8F, 0xBE, 0x5A, 0xBC, 0x8E, 0xB6, 0x25,
+  0xE0, 0x43, 0xEF, 0x61, 0x6C, 0x96, 0xD5, 0xB9, 0xE3, 0xDB, 0xDA, 0xFD,
+  0xEB, 0xCB, 0x57, 0x70, 0xFA, 0x72, 0xAB, 0x3C, 0xF5, 0x0D, 0x8D, 0xCB,
+  0xCB, 0xC6, 0x8B, 0xA1, 0xDC, 0xCF, 0x70, 0x36, 0xD9, 0x25, 0x77, 0x36,
+  0xF9, 0xDE, 0x65, 0xFA, 0x81, 0x68, 0xFF, 0x05, 0x36, 0xFA, 0x97, 0x22,
+  0x22, 0x0E, 0x00, 0x00,
+};
+
+const web_asset_t kWebAssets[] = {
+  {"/favicon.ico", "image/x-icon", "707d2a64", kWebAsset0, 878},
+  {"/level_1_off.svg", "image/svg+xml", "3007b105", kWebAsset1, 668},
+  {"/level_1_on.svg", "image/svg+xml", "b8eccb29", kWebAsset2, 667},
+  {"/level_2_off.svg", "image/svg+xml", "1f7fe111", kWebAsset3, 669},
+  {"/level_2_on.svg", "image/svg+xml", "6d0f9833", kWebAsset4, 668},
+  {"/level_3_off.svg", "image/svg+xml", "7ac56973", kWebAsset5, 669},
+  {"/level_3_on.svg", "image/svg+xml", "473cbd61", kWebAsset6, 669},
+  {"/level_4_off.svg", "image/svg+xml", "c50007d0", kWebAsset7, 669},
+  {"/level_4_on.svg", "image/svg+xml", "cde50db2", kWebAsset8, 669},
+  {"/ui.html", "text/html", "617c9338", kWebAsset9, 1666},
+  {"/ui.js", "application/javascript", "f2ae063e", kWebAsset10, 1120},
+};
+const uint8_t kWebAssetCount = sizeof(kWebAssets) / sizeof(kWebAssets[0]);
+
+#endif  // EXAMPLES_WEB_AC_CONTROL_WEB_ASSETS_H_
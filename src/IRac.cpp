@@ -8,7 +8,9 @@
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif
+#include <stdlib.h>
 #include <string.h>
+#include <new>
 #ifndef ARDUINO
 #include <string>
 #endif
@@ -46,18 +48,116 @@
 #include "ir_Voltas.h"
 #include "ir_Whirlpool.h"
 
+using irutils::setBit;
+using irutils::setBits;
+
+/// The temperature of a state, in Celsius. Whatever units the state is in.
+/// @param[in] state The state_t to look at.
+/// @return The `degrees` of it, converted to Celsius if need be.
+static float celsiusOf(const stdAc::state_t &state) {
+  return state.celsius ? state.degrees : fahrenheitToCelsius(state.degrees);
+}
+
+#if defined(UNIT_TEST) && !defined(memcpy_P)
+#define memcpy_P memcpy  // Pretend we have memcpy_P() even if we really don't.
+#endif  // defined(UNIT_TEST) && !defined(memcpy_P)
+
 /// Class constructor
 /// @param[in] pin Gpio pin to use when transmitting IR messages.
 /// @param[in] inverted true, gpio output defaults to high. false, to low.
 /// @param[in] use_modulation true means use frequency modulation. false, don't.
-IRac::IRac(const uint16_t pin, const bool inverted, const bool use_modulation) {
+IRac::IRac(const uint16_t pin, const bool inverted, const bool use_modulation)
+#if ENABLE_IRAC_FRAME_CACHE
+    : _irsend(pin, inverted, use_modulation)
+#endif  // ENABLE_IRAC_FRAME_CACHE
+{  // NOLINT(whitespace/braces)
   _pin = pin;
   _inverted = inverted;
   _modulation = use_modulation;
+  _delta = false;
+  _burst = false;
+  _suppress = false;
+  _reassert = 0;
+  _hysteresis = 0;
+  _suppressed = 0;
   initState(&next);
   this->markAsSent();
+#if ENABLE_IRAC_FRAME_CACHE
+  _frames = NULL;
+  _frames_size = 0;
+  disableFrameCache();
+#endif  // ENABLE_IRAC_FRAME_CACHE
+#if ENABLE_IRAC_CACHE
+  _cache = NULL;
+  _cache_free = NULL;
+  _cache_protocol = decode_type_t::UNKNOWN;
+  _cache_model = -1;
+#endif  // ENABLE_IRAC_CACHE
+}
+
+#if ENABLE_IRAC_CACHE || ENABLE_IRAC_FRAME_CACHE
+/// Class destructor
+IRac::~IRac(void) {
+#if ENABLE_IRAC_CACHE
+  clearCache();
+#endif  // ENABLE_IRAC_CACHE
+#if ENABLE_IRAC_FRAME_CACHE
+  disableFrameCache();
+#endif  // ENABLE_IRAC_FRAME_CACHE
+}
+#endif  // ENABLE_IRAC_CACHE || ENABLE_IRAC_FRAME_CACHE
+
+#if ENABLE_IRAC_CACHE
+
+/// Free the protocol object kept from the last `sendAc()`, if any.
+/// The next `sendAc()` will start afresh with a new one.
+/// @note Only available if `ENABLE_IRAC_CACHE` is enabled.
+void IRac::clearCache(void) {
+  if (_cache != NULL) _cache_free(_cache);
+  _cache = NULL;
+  _cache_free = NULL;
+  _cache_protocol = decode_type_t::UNKNOWN;
+  _cache_model = -1;
+}
+
+/// Delete a protocol object created by `IRac::_cachedAc()`.
+/// @param[in] ac A Ptr to the object.
+template <typename AC>
+static void deleteAc(void *ac) {
+  static_cast<AC *>(ac)->~AC();
+  free(ac);
+}
+
+/// Get the kept protocol object for a protocol & model, creating it if needed.
+/// @param[in] protocol The protocol the object is for.
+/// @param[in] model The model the object is for.
+/// @param[in] args The arguments to construct a new object with.
+/// @return A Ptr to the object, or NULL if there isn't enough memory for it.
+template <typename AC, typename... Args>
+AC *IRac::_cachedAc(const decode_type_t protocol, const int16_t model,
+                    Args... args) {
+  if (_cache == NULL || protocol != _cache_protocol || model != _cache_model) {
+    clearCache();
+    void *memory = malloc(sizeof(AC));
+    if (memory == NULL) return NULL;
+    _cache = new (memory) AC(args...);
+    _cache_free = deleteAc<AC>;
+    _cache_protocol = protocol;
+    _cache_model = model;
+  }
+  return static_cast<AC *>(_cache);
 }
 
+// The protocol object `sendAc()` sends a state with.
+#define IRAC_OBJECT(TYPE, NAME, ...) \
+    TYPE *NAME##_ptr = _cachedAc<TYPE>(send.protocol, send.model, \
+                                       __VA_ARGS__); \
+    if (NAME##_ptr == NULL) return false; \
+    TYPE &NAME = *NAME##_ptr
+#else  // ENABLE_IRAC_CACHE
+#define IRAC_OBJECT(TYPE, NAME, ...) TYPE NAME(__VA_ARGS__)
+#endif  // ENABLE_IRAC_CACHE
+
 /// Initialse the given state with the supplied settings.
 /// @param[out] state A Ptr to where the settings will be stored.
 /// @param[in] vendor The vendor/protocol type.
@@ -288,18 +388,14 @@ bool IRac::isProtocolSupported(const decode_type_t protocol) {
 #if SEND_AIRWELL
 /// Send an Airwell A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRAirwellAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-void IRac::airwell(IRAirwellAc *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees, const stdAc::fanspeed_t fan) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees &
+///   fanspeed.
+void IRac::airwell(IRAirwellAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPowerToggle(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
+  ac->setPowerToggle(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
   // No Swing setting available.
   // No Quiet setting available.
   // No Light setting available.
@@ -316,18 +412,14 @@ void IRac::airwell(IRAirwellAc *ac,
 #if SEND_AMCOR
 /// Send an Amcor A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRAmcorAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-void IRac::amcor(IRAmcorAc *ac,
-                const bool on, const stdAc::opmode_t mode, const float degrees,
-                const stdAc::fanspeed_t fan) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees &
+///   fanspeed.
+void IRac::amcor(IRAmcorAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
   // No Swing setting available.
   // No Quiet setting available.
   // No Light setting available.
@@ -344,32 +436,23 @@ void IRac::amcor(IRAmcorAc *ac,
 #if SEND_ARGO
 /// Send an Argo A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRArgoAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] sleep Nr. of minutes for sleep mode.
-/// @note -1 is Off, >= 0 is on.
-void IRac::argo(IRArgoAC *ac,
-                const bool on, const stdAc::opmode_t mode, const float degrees,
-                const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                const bool turbo, const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, turbo & sleep.
+void IRac::argo(IRArgoAC *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setFlap(ac->convertSwingV(swingv));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setFlap(ac->convertSwingV(state.swingv));
   // No Quiet setting available.
   // No Light setting available.
   // No Filter setting available.
-  ac->setMax(turbo);
+  ac->setMax(state.turbo);
   // No Economy setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setNight(sleep >= 0);  // Convert to a boolean.
+  ac->setNight(state.sleep >= 0);  // Convert to a boolean.
   ac->send();
 }
 #endif  // SEND_ARGO
@@ -377,23 +460,15 @@ void IRac::argo(IRArgoAC *ac,
 #if SEND_CARRIER_AC64
 /// Send a Carrier 64-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRCarrierAc64 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] sleep Nr. of minutes for sleep mode.
-/// @note -1 is Off, >= 0 is on.
-void IRac::carrier64(IRCarrierAc64 *ac,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingv_t swingv, const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv & sleep.
+void IRac::carrier64(IRCarrierAc64 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV((int8_t)swingv >= 0);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV((int8_t)state.swingv >= 0);
   // No Quiet setting available.
   // No Light setting available.
   // No Filter setting available.
@@ -401,7 +476,7 @@ void IRac::carrier64(IRCarrierAc64 *ac,
   // No Economy setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Convert to a boolean.
+  ac->setSleep(state.sleep >= 0);  // Convert to a boolean.
   ac->send();
 }
 #endif  // SEND_CARRIER_AC64
@@ -410,65 +485,78 @@ void IRac::carrier64(IRCarrierAc64 *ac,
 /// Send a Coolix A/C message with the supplied settings.
 /// @note May result in multiple messages being sent.
 /// @param[in, out] ac A Ptr to an IRCoolixAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-/// @param[in] sleep Nr. of minutes for sleep mode.
-/// @note -1 is Off, >= 0 is on.
-void IRac::coolix(IRCoolixAC *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                  const bool turbo, const bool light, const bool clean,
-                  const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, turbo, light, clean & sleep.
+/// @param[in] burst Send the special commands & the state as one burst?
+///   See `setBurstSend()`.
+void IRac::coolix(IRCoolixAC *ac, const stdAc::state_t &state,
+                  const bool burst) {
   ac->begin();
-  ac->setPower(on);
-  if (!on) {
+  ac->setPower(state.power);
+  if (!state.power) {
       // after turn off AC no more commands should
       // be accepted
       ac->send();
       return;
   }
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
   // No Filter setting available.
   // No Beep setting available.
   // No Clock setting available.
   // No Econo setting available.
   // No Quiet setting available.
-  if (swingv != stdAc::swingv_t::kOff || swingh != stdAc::swingh_t::kOff) {
+  const uint32_t raw = ac->getRaw();
+  uint32_t codes[kCoolixMaxSequence];
+  uint16_t ncodes = 0;
+  if (state.swingv != stdAc::swingv_t::kOff ||
+      state.swingh != stdAc::swingh_t::kOff) {
     // Swing has a special command that needs to be sent independently.
     ac->setSwing();
-    ac->send();
+    if (burst)
+      codes[ncodes++] = ac->getRaw();
+    else
+      ac->send();
   }
-  if (turbo) {
+  if (state.turbo) {
     // Turbo has a special command that needs to be sent independently.
     ac->setTurbo();
-    ac->send();
+    if (burst)
+      codes[ncodes++] = ac->getRaw();
+    else
+      ac->send();
   }
-  if (sleep > 0) {
+  if (state.sleep > 0) {
     // Sleep has a special command that needs to be sent independently.
     ac->setSleep();
-    ac->send();
+    if (burst)
+      codes[ncodes++] = ac->getRaw();
+    else
+      ac->send();
   }
-  if (light) {
+  if (state.light) {
     // Light has a special command that needs to be sent independently.
     ac->setLed();
-    ac->send();
+    if (burst)
+      codes[ncodes++] = ac->getRaw();
+    else
+      ac->send();
   }
-  if (clean) {
+  if (state.clean) {
     // Clean has a special command that needs to be sent independently.
     ac->setClean();
+    if (burst)
+      codes[ncodes++] = ac->getRaw();
+    else
+      ac->send();
+  }
+  if (burst) {  // Only the protocol's minimum gap between the messages.
+    codes[ncodes++] = raw;
+    ac->sendSequence(codes, ncodes);
+  } else {
     ac->send();
   }
-  ac->send();
 }
 #endif  // SEND_COOLIX
 
@@ -476,27 +564,20 @@ void IRac::coolix(IRCoolixAC *ac,
 /// Send a Corona A/C message with the supplied settings.
 /// @note May result in multiple messages being sent.
 /// @param[in, out] ac A Ptr to an IRCoronaAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] econo Run the device in economical mode.
-void IRac::corona(IRCoronaAc *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv, const bool econo) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv & econo.
+void IRac::corona(IRCoronaAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVToggle(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVToggle(state.swingv != stdAc::swingv_t::kOff);
   // No Quiet setting available.
   // No Light setting available.
   // No Filter setting available.
   // No Turbo setting available.
-  ac->setEcono(econo);
+  ac->setEcono(state.econo);
   // No Clean setting available.
   // No Beep setting available.
   // No Sleep setting available.
@@ -507,35 +588,22 @@ void IRac::corona(IRCoronaAc *ac,
 #if SEND_DAIKIN
 /// Send a Daikin A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikinESP object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-void IRac::daikin(IRDaikinESP *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                  const bool quiet, const bool turbo, const bool econo,
-                  const bool clean) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet, turbo, econo & clean.
+void IRac::daikin(IRDaikinESP *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical((int8_t)swingv >= 0);
-  ac->setSwingHorizontal((int8_t)swingh >= 0);
-  ac->setQuiet(quiet);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical((int8_t)state.swingv >= 0);
+  ac->setSwingHorizontal((int8_t)state.swingh >= 0);
+  ac->setQuiet(state.quiet);
   // No Light setting available.
   // No Filter setting available.
-  ac->setPowerful(turbo);
-  ac->setEcono(econo);
-  ac->setMold(clean);
+  ac->setPowerful(state.turbo);
+  ac->setEcono(state.econo);
+  ac->setMold(state.clean);
   // No Beep setting available.
   // No Sleep setting available.
   // No Clock setting available.
@@ -546,39 +614,25 @@ void IRac::daikin(IRDaikinESP *ac,
 #if SEND_DAIKIN128
 /// Send a Daikin 128-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin128 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
-void IRac::daikin128(IRDaikin128 *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv,
-                  const bool quiet, const bool turbo, const bool light,
-                  const bool econo, const int16_t sleep, const int16_t clock) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, quiet, turbo, light, econo, sleep & clock.
+void IRac::daikin128(IRDaikin128 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPowerToggle(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical((int8_t)swingv >= 0);
+  ac->setPowerToggle(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical((int8_t)state.swingv >= 0);
   // No Horizontal Swing setting avaliable.
-  ac->setQuiet(quiet);
-  ac->setLightToggle(light ? kDaikin128BitWall : 0);
+  ac->setQuiet(state.quiet);
+  ac->setLightToggle(state.light ? kDaikin128BitWall : 0);
   // No Filter setting available.
-  ac->setPowerful(turbo);
-  ac->setEcono(econo);
+  ac->setPowerful(state.turbo);
+  ac->setEcono(state.econo);
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep > 0);
-  if (clock >= 0) ac->setClock(clock);
+  ac->setSleep(state.sleep > 0);
+  if (state.clock >= 0) ac->setClock(state.clock);
   ac->send();
 }
 #endif  // SEND_DAIKIN128
@@ -586,31 +640,21 @@ void IRac::daikin128(IRDaikin128 *ac,
 #if SEND_DAIKIN152
 /// Send a Daikin 152-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin152 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-void IRac::daikin152(IRDaikin152 *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv,
-                  const bool quiet, const bool turbo, const bool econo) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, quiet, turbo & econo.
+void IRac::daikin152(IRDaikin152 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV((int8_t)swingv >= 0);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV((int8_t)state.swingv >= 0);
   // No Horizontal Swing setting avaliable.
-  ac->setQuiet(quiet);
+  ac->setQuiet(state.quiet);
   // No Light setting available.
   // No Filter setting available.
-  ac->setPowerful(turbo);
-  ac->setEcono(econo);
+  ac->setPowerful(state.turbo);
+  ac->setEcono(state.econo);
   // No Clean setting available.
   // No Beep setting available.
   // No Sleep setting available.
@@ -622,21 +666,15 @@ void IRac::daikin152(IRDaikin152 *ac,
 #if SEND_DAIKIN160
 /// Send a Daikin 160-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin160 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-void IRac::daikin160(IRDaikin160 *ac,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingv_t swingv) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed & swingv.
+void IRac::daikin160(IRDaikin160 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(ac->convertSwingV(swingv));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(ac->convertSwingV(state.swingv));
   ac->send();
 }
 #endif  // SEND_DAIKIN160
@@ -644,21 +682,15 @@ void IRac::daikin160(IRDaikin160 *ac,
 #if SEND_DAIKIN176
 /// Send a Daikin 176-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin176 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingh The horizontal swing setting.
-void IRac::daikin176(IRDaikin176 *ac,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingh_t swingh) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed & swingh.
+void IRac::daikin176(IRDaikin176 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingHorizontal(ac->convertSwingH(swingh));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingHorizontal(ac->convertSwingH(state.swingh));
   ac->send();
 }
 #endif  // SEND_DAIKIN176
@@ -666,45 +698,27 @@ void IRac::daikin176(IRDaikin176 *ac,
 #if SEND_DAIKIN2
 /// Send a Daikin2 A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin2 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-/// @param[in] beep Enable/Disable beeps when receiving IR messages.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
-void IRac::daikin2(IRDaikin2 *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees, const stdAc::fanspeed_t fan,
-                   const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                   const bool quiet, const bool turbo, const bool light,
-                   const bool econo, const bool filter, const bool clean,
-                   const bool beep, const int16_t sleep, const int16_t clock) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet, turbo, light, econo, filter, clean, beep,
+///   sleep & clock.
+void IRac::daikin2(IRDaikin2 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(ac->convertSwingV(swingv));
-  ac->setSwingHorizontal(ac->convertSwingH(swingh));
-  ac->setQuiet(quiet);
-  ac->setLight(light ? 1 : 3);  // On/High is 1, Off is 3.
-  ac->setPowerful(turbo);
-  ac->setEcono(econo);
-  ac->setPurify(filter);
-  ac->setMold(clean);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(ac->convertSwingV(state.swingv));
+  ac->setSwingHorizontal(ac->convertSwingH(state.swingh));
+  ac->setQuiet(state.quiet);
+  ac->setLight(state.light ? 1 : 3);  // On/High is 1, Off is 3.
+  ac->setPowerful(state.turbo);
+  ac->setEcono(state.econo);
+  ac->setPurify(state.filter);
+  ac->setMold(state.clean);
   ac->setClean(true);  // Hardwire auto clean to be on per request (@sheppy99)
-  ac->setBeep(beep ? 2 : 3);  // On/Loud is 2, Off is 3.
-  if (sleep > 0) ac->enableSleepTimer(sleep);
-  if (clock >= 0) ac->setCurrentTime(clock);
+  ac->setBeep(state.beep ? 2 : 3);  // On/Loud is 2, Off is 3.
+  if (state.sleep > 0) ac->enableSleepTimer(state.sleep);
+  if (state.clock >= 0) ac->setCurrentTime(state.clock);
   ac->send();
 }
 #endif  // SEND_DAIKIN2
@@ -712,28 +726,18 @@ void IRac::daikin2(IRDaikin2 *ac,
 #if SEND_DAIKIN216
 /// Send a Daikin 216-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin216 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-void IRac::daikin216(IRDaikin216 *ac,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                     const bool quiet, const bool turbo) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet & turbo.
+void IRac::daikin216(IRDaikin216 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical((int8_t)swingv >= 0);
-  ac->setSwingHorizontal((int8_t)swingh >= 0);
-  ac->setQuiet(quiet);
-  ac->setPowerful(turbo);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical((int8_t)state.swingv >= 0);
+  ac->setSwingHorizontal((int8_t)state.swingh >= 0);
+  ac->setQuiet(state.quiet);
+  ac->setPowerful(state.turbo);
   ac->send();
 }
 #endif  // SEND_DAIKIN216
@@ -741,31 +745,19 @@ void IRac::daikin216(IRDaikin216 *ac,
 #if SEND_DAIKIN64
 /// Send a Daikin 64-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDaikin64 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
-void IRac::daikin64(IRDaikin64 *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv,
-                  const bool quiet, const bool turbo,
-                  const int16_t sleep, const int16_t clock) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, quiet, turbo, sleep & clock.
+void IRac::daikin64(IRDaikin64 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPowerToggle(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical((int8_t)swingv >= 0);
-  ac->setTurbo(turbo);
-  ac->setQuiet(quiet);
-  ac->setSleep(sleep >= 0);
-  ac->setClock(clock);
+  ac->setPowerToggle(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical((int8_t)state.swingv >= 0);
+  ac->setTurbo(state.turbo);
+  ac->setQuiet(state.quiet);
+  ac->setSleep(state.sleep >= 0);
+  ac->setClock(state.clock);
   ac->send();
 }
 #endif  // SEND_DAIKIN64
@@ -773,24 +765,16 @@ void IRac::daikin64(IRDaikin64 *ac,
 #if SEND_DELONGHI_AC
 /// Send a Delonghi A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRDelonghiAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] celsius Temperature units. True is Celsius, False is Fahrenheit.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::delonghiac(IRDelonghiAc *ac,
-                  const bool on, const stdAc::opmode_t mode, const bool celsius,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const bool turbo, const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, celsius,
+///   degrees, fanspeed, turbo & sleep.
+void IRac::delonghiac(IRDelonghiAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees, !celsius);
-  ac->setFan(ac->convertFan(fan));
-  ac->setBoost(turbo);
-  ac->setSleep(sleep >= 0);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(state.degrees, !state.celsius);
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setBoost(state.turbo);
+  ac->setSleep(state.sleep >= 0);
   ac->send();
 }
 #endif  // SEND_DELONGHI_AC
@@ -798,35 +782,23 @@ void IRac::delonghiac(IRDelonghiAc *ac,
 #if SEND_ELECTRA_AC
 /// Send an Electra A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRElectraAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] lighttoggle Should we toggle the LED/Display?
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-void IRac::electra(IRElectraAc *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees, const stdAc::fanspeed_t fan,
-                   const stdAc::swingv_t swingv,
-                   const stdAc::swingh_t swingh, const bool turbo,
-                   const bool lighttoggle, const bool clean) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, turbo, light & clean.
+void IRac::electra(IRElectraAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(swingv != stdAc::swingv_t::kOff);
-  ac->setSwingH(swingh != stdAc::swingh_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(state.swingv != stdAc::swingv_t::kOff);
+  ac->setSwingH(state.swingh != stdAc::swingh_t::kOff);
   // No Quiet setting available.
-  ac->setTurbo(turbo);
-  ac->setLightToggle(lighttoggle);
+  ac->setTurbo(state.turbo);
+  ac->setLightToggle(state.light);
   // No Light setting available.
   // No Econo setting available.
   // No Filter setting available.
-  ac->setClean(clean);
+  ac->setClean(state.clean);
   // No Beep setting available.
   // No Sleep setting available.
   // No Clock setting available.
@@ -837,38 +809,25 @@ void IRac::electra(IRElectraAc *ac,
 #if SEND_FUJITSU_AC
 /// Send a Fujitsu A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRFujitsuAC object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-void IRac::fujitsu(IRFujitsuAC *ac, const fujitsu_ac_remote_model_t model,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees, const stdAc::fanspeed_t fan,
-                   const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                   const bool quiet, const bool turbo, const bool econo,
-                   const bool filter, const bool clean) {
+/// @param[in] state The settings to send. i.e. Its model, power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet, turbo, econo, filter & clean.
+void IRac::fujitsu(IRFujitsuAC *ac, const stdAc::state_t &state) {
+  const fujitsu_ac_remote_model_t model =
+      (fujitsu_ac_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  if (on) {
+  if (state.power) {
     // Do all special messages (except "Off") first,
     // These need to be sent separately.
     switch (ac->getModel()) {
       // Some functions are only available on some models.
       case fujitsu_ac_remote_model_t::ARREB1E:
-        if (turbo) {
+        if (state.turbo) {
           ac->setCmd(kFujitsuAcCmdPowerful);
           // Powerful is a separate command.
           ac->send();
         }
-        if (econo) {
+        if (state.econo) {
           ac->setCmd(kFujitsuAcCmdEcono);
           // Econo is a separate command.
           ac->send();
@@ -878,17 +837,17 @@ void IRac::fujitsu(IRFujitsuAC *ac, const fujitsu_ac_remote_model_t model,
         {};
     }
     // Normal operation.
-    ac->setMode(ac->convertMode(mode));
-    ac->setTemp(degrees);
-    ac->setFanSpeed(ac->convertFan(fan));
+    ac->setMode(ac->convertMode(state.mode));
+    ac->setTemp(celsiusOf(state));
+    ac->setFanSpeed(ac->convertFan(state.fanspeed));
     uint8_t swing = kFujitsuAcSwingOff;
-    if (swingv > stdAc::swingv_t::kOff) swing |= kFujitsuAcSwingVert;
-    if (swingh > stdAc::swingh_t::kOff) swing |= kFujitsuAcSwingHoriz;
+    if (state.swingv > stdAc::swingv_t::kOff) swing |= kFujitsuAcSwingVert;
+    if (state.swingh > stdAc::swingh_t::kOff) swing |= kFujitsuAcSwingHoriz;
     ac->setSwing(swing);
-    if (quiet) ac->setFanSpeed(kFujitsuAcFanQuiet);
+    if (state.quiet) ac->setFanSpeed(kFujitsuAcFanQuiet);
     // No Light setting available.
-    ac->setFilter(filter);
-    ac->setClean(clean);
+    ac->setFilter(state.filter);
+    ac->setClean(state.clean);
     // No Beep setting available.
     // No Sleep setting available.
     // No Clock setting available.
@@ -904,38 +863,26 @@ void IRac::fujitsu(IRFujitsuAC *ac, const fujitsu_ac_remote_model_t model,
 #if SEND_GOODWEATHER
 /// Send a Goodweather A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRGoodweatherAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::goodweather(IRGoodweatherAc *ac,
-                       const bool on, const stdAc::opmode_t mode,
-                       const float degrees,
-                       const stdAc::fanspeed_t fan,
-                       const stdAc::swingv_t swingv,
-                       const bool turbo, const bool light,
-                       const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, turbo, light & sleep.
+void IRac::goodweather(IRGoodweatherAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(swingv == stdAc::swingv_t::kOff ? kGoodweatherSwingOff
-                                               : kGoodweatherSwingSlow);
-  ac->setTurbo(turbo);
-  ac->setLight(light);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(state.swingv == stdAc::swingv_t::kOff ? kGoodweatherSwingOff
+                                                     : kGoodweatherSwingSlow);
+  ac->setTurbo(state.turbo);
+  ac->setLight(state.light);
   // No Clean setting available.
-  ac->setSleep(sleep >= 0);  // Sleep on this A/C is either on or off.
+  ac->setSleep(state.sleep >= 0);  // Sleep on this A/C is either on or off.
   // No Horizontal Swing setting available.
   // No Econo setting available.
   // No Filter setting available.
   // No Beep setting available.
   // No Quiet setting available.
   // No Clock setting available.
-  ac->setPower(on);
+  ac->setPower(state.power);
   ac->send();
 }
 #endif  // SEND_GOODWEATHER
@@ -943,34 +890,22 @@ void IRac::goodweather(IRGoodweatherAc *ac,
 #if SEND_GREE
 /// Send a Gree A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRGreeAC object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] celsius Temperature units. True is Celsius, False is Fahrenheit.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::gree(IRGreeAC *ac, const gree_ac_remote_model_t model,
-                const bool on, const stdAc::opmode_t mode, const bool celsius,
-                const float degrees, const stdAc::fanspeed_t fan,
-                const stdAc::swingv_t swingv, const bool turbo,
-                const bool light, const bool clean, const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its model, power, mode, celsius,
+///   degrees, fanspeed, swingv, turbo, light, clean & sleep.
+void IRac::gree(IRGreeAC *ac, const stdAc::state_t &state) {
+  const gree_ac_remote_model_t model = (gree_ac_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees, !celsius);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(swingv == stdAc::swingv_t::kAuto,  // Set auto flag.
-                       ac->convertSwingV(swingv));
-  ac->setLight(light);
-  ac->setTurbo(turbo);
-  ac->setXFan(clean);
-  ac->setSleep(sleep >= 0);  // Sleep on this A/C is either on or off.
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(state.degrees, !state.celsius);
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(state.swingv == stdAc::swingv_t::kAuto,  // Auto flag.
+                       ac->convertSwingV(state.swingv));
+  ac->setLight(state.light);
+  ac->setTurbo(state.turbo);
+  ac->setXFan(state.clean);
+  ac->setSleep(state.sleep >= 0);  // Sleep on this A/C is either on or off.
   // No Horizontal Swing setting available.
   // No Econo setting available.
   // No Filter setting available.
@@ -984,33 +919,24 @@ void IRac::gree(IRGreeAC *ac, const gree_ac_remote_model_t model,
 #if SEND_HAIER_AC
 /// Send a Haier A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRGreeAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
-void IRac::haier(IRHaierAC *ac,
-                 const bool on, const stdAc::opmode_t mode, const float degrees,
-                 const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                 const bool filter, const int16_t sleep, const int16_t clock) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, filter, sleep & clock.
+void IRac::haier(IRHaierAC *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(ac->convertSwingV(swingv));
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(ac->convertSwingV(state.swingv));
   // No Horizontal Swing setting available.
   // No Quiet setting available.
   // No Turbo setting available.
   // No Light setting available.
-  ac->setHealth(filter);
+  ac->setHealth(state.filter);
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep on this A/C is either on or off.
-  if (clock >=0) ac->setCurrTime(clock);
-  if (on)
+  ac->setSleep(state.sleep >= 0);  // Sleep on this A/C is either on or off.
+  if (state.clock >=0) ac->setCurrTime(state.clock);
+  if (state.power)
     ac->setCommand(kHaierAcCmdOn);
   else
     ac->setCommand(kHaierAcCmdOff);
@@ -1021,33 +947,47 @@ void IRac::haier(IRHaierAC *ac,
 #if SEND_HAIER_AC_YRW02
 /// Send a Haier YRWO2 A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRHaierACYRW02 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::haierYrwo2(IRHaierACYRW02 *ac,
-                      const bool on, const stdAc::opmode_t mode,
-                      const float degrees, const stdAc::fanspeed_t fan,
-                      const stdAc::swingv_t swingv, const bool turbo,
-                      const bool filter, const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, turbo, filter & sleep.
+/// @param[in] prev A Ptr to the previous state, if known. It is used to set
+///   the button (that was "pressed") to the setting that changed. NULL if not.
+/// @note Without a previous state, or if the power changed, the button is
+///   always Power.
+void IRac::haierYrwo2(IRHaierACYRW02 *ac, const stdAc::state_t &state,
+                      const stdAc::state_t *prev) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(ac->convertSwingV(swingv));
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(ac->convertSwingV(state.swingv));
   // No Horizontal Swing setting available.
   // No Quiet setting available.
-  ac->setTurbo(turbo);
+  ac->setTurbo(state.turbo);
   // No Light setting available.
-  ac->setHealth(filter);
+  ac->setHealth(state.filter);
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep on this A/C is either on or off.
-  ac->setPower(on);
+  ac->setSleep(state.sleep >= 0);  // Sleep on this A/C is either on or off.
+  ac->setPower(state.power);
+  // Tell the A/C which setting changed, like the remote does.
+  if (prev != NULL && prev->power && state.power) {
+    const float prevC = celsiusOf(*prev);
+    if (prev->mode != state.mode)
+      ac->setButton(kHaierAcYrw02ButtonMode);
+    else if (prevC != celsiusOf(state))
+      ac->setButton(celsiusOf(state) > prevC ? kHaierAcYrw02ButtonTempUp
+                                             : kHaierAcYrw02ButtonTempDown);
+    else if (prev->fanspeed != state.fanspeed)
+      ac->setButton(kHaierAcYrw02ButtonFan);
+    else if (prev->swingv != state.swingv)
+      ac->setButton(kHaierAcYrw02ButtonSwing);
+    else if (prev->turbo != state.turbo)
+      ac->setButton(kHaierAcYrw02ButtonTurbo);
+    else if (prev->filter != state.filter)
+      ac->setButton(kHaierAcYrw02ButtonHealth);
+    else if ((prev->sleep >= 0) != (state.sleep >= 0))
+      ac->setButton(kHaierAcYrw02ButtonSleep);
+  }
   ac->send();
 }
 #endif  // SEND_HAIER_AC_YRW02
@@ -1055,23 +995,16 @@ void IRac::haierYrwo2(IRHaierACYRW02 *ac,
 #if SEND_HITACHI_AC
 /// Send a Hitachi A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRHitachiAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-void IRac::hitachi(IRHitachiAc *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees, const stdAc::fanspeed_t fan,
-                   const stdAc::swingv_t swingv, const stdAc::swingh_t swingh) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv & swingh.
+void IRac::hitachi(IRHitachiAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(swingv != stdAc::swingv_t::kOff);
-  ac->setSwingHorizontal(swingh != stdAc::swingh_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(state.swingv != stdAc::swingv_t::kOff);
+  ac->setSwingHorizontal(state.swingh != stdAc::swingh_t::kOff);
   // No Quiet setting available.
   // No Turbo setting available.
   // No Light setting available.
@@ -1087,34 +1020,26 @@ void IRac::hitachi(IRHitachiAc *ac,
 #if SEND_HITACHI_AC1
 /// Send a Hitachi1 A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRHitachiAc1 object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
+/// @param[in] state The settings to send. i.e. Its model, power, mode, degrees,
+///   fanspeed, swingv, swingh & sleep.
 /// @param[in] power_toggle The power toggle setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
 /// @param[in] swing_toggle The swing_toggle setting.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
 /// @note The sleep mode used is the "Sleep 2" setting.
-void IRac::hitachi1(IRHitachiAc1 *ac, const hitachi_ac1_remote_model_t model,
-                    const bool on, const bool power_toggle,
-                    const stdAc::opmode_t mode,
-                    const float degrees, const stdAc::fanspeed_t fan,
-                    const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                    const bool swing_toggle, const int16_t sleep) {
+void IRac::hitachi1(IRHitachiAc1 *ac, const stdAc::state_t &state,
+                    const bool power_toggle, const bool swing_toggle) {
+  const hitachi_ac1_remote_model_t model =
+      (hitachi_ac1_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  ac->setPower(on);
+  ac->setPower(state.power);
   ac->setPowerToggle(power_toggle);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(swingv != stdAc::swingv_t::kOff);
-  ac->setSwingH(swingh != stdAc::swingh_t::kOff);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(state.swingv != stdAc::swingv_t::kOff);
+  ac->setSwingH(state.swingh != stdAc::swingh_t::kOff);
   ac->setSwingToggle(swing_toggle);
-  ac->setSleep((sleep >= 0) ? kHitachiAc1Sleep2 : kHitachiAc1SleepOff);
+  ac->setSleep((state.sleep >= 0) ? kHitachiAc1Sleep2 : kHitachiAc1SleepOff);
   // No Sleep setting available.
   // No Swing(H) setting available.
   // No Quiet setting available.
@@ -1131,23 +1056,15 @@ void IRac::hitachi1(IRHitachiAc1 *ac, const hitachi_ac1_remote_model_t model,
 #if SEND_HITACHI_AC344
 /// Send a Hitachi 344-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRHitachiAc344 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-void IRac::hitachi344(IRHitachiAc344 *ac,
-                      const bool on, const stdAc::opmode_t mode,
-                      const float degrees, const stdAc::fanspeed_t fan,
-                      const stdAc::swingv_t swingv,
-                      const stdAc::swingh_t swingh) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv & swingh.
+void IRac::hitachi344(IRHitachiAc344 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingH(ac->convertSwingH(swingh));
-  ac->setPower(on);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingH(ac->convertSwingH(state.swingh));
+  ac->setPower(state.power);
   // No Quiet setting available.
   // No Turbo setting available.
   // No Light setting available.
@@ -1158,7 +1075,7 @@ void IRac::hitachi344(IRHitachiAc344 *ac,
   // No Clock setting available.
 
   // SwingVToggle is special. Needs to be last method called.
-  ac->setSwingVToggle(swingv != stdAc::swingv_t::kOff);
+  ac->setSwingVToggle(state.swingv != stdAc::swingv_t::kOff);
   ac->send();
 }
 #endif  // SEND_HITACHI_AC344
@@ -1166,22 +1083,16 @@ void IRac::hitachi344(IRHitachiAc344 *ac,
 #if SEND_HITACHI_AC424
 /// Send a Hitachi 424-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRHitachiAc424 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-void IRac::hitachi424(IRHitachiAc424 *ac,
-                      const bool on, const stdAc::opmode_t mode,
-                      const float degrees, const stdAc::fanspeed_t fan,
-                      const stdAc::swingv_t swingv) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed & swingv.
+void IRac::hitachi424(IRHitachiAc424 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setPower(on);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setPower(state.power);
   // SwingVToggle is special. Needs to be last method called.
-  ac->setSwingVToggle(swingv != stdAc::swingv_t::kOff);
+  ac->setSwingVToggle(state.swingv != stdAc::swingv_t::kOff);
   // No Swing(H) setting available.
   // No Quiet setting available.
   // No Turbo setting available.
@@ -1198,36 +1109,21 @@ void IRac::hitachi424(IRHitachiAc424 *ac,
 #if SEND_KELVINATOR
 /// Send a Kelvinator A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRKelvinatorAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. XFan, dry filters etc
-void IRac::kelvinator(IRKelvinatorAC *ac,
-                      const bool on, const stdAc::opmode_t mode,
-                      const float degrees, const stdAc::fanspeed_t fan,
-                      const stdAc::swingv_t swingv,
-                      const stdAc::swingh_t swingh,
-                      const bool quiet, const bool turbo, const bool light,
-                      const bool filter, const bool clean) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet, turbo, light, filter & clean.
+void IRac::kelvinator(IRKelvinatorAC *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan((uint8_t)fan);  // No conversion needed.
-  ac->setSwingVertical((int8_t)swingv >= 0);
-  ac->setSwingHorizontal((int8_t)swingh >= 0);
-  ac->setQuiet(quiet);
-  ac->setTurbo(turbo);
-  ac->setLight(light);
-  ac->setIonFilter(filter);
-  ac->setXFan(clean);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan((uint8_t)state.fanspeed);  // No conversion needed.
+  ac->setSwingVertical((int8_t)state.swingv >= 0);
+  ac->setSwingHorizontal((int8_t)state.swingh >= 0);
+  ac->setQuiet(state.quiet);
+  ac->setTurbo(state.turbo);
+  ac->setLight(state.light);
+  ac->setIonFilter(state.filter);
+  ac->setXFan(state.clean);
   // No Beep setting available.
   // No Sleep setting available.
   // No Clock setting available.
@@ -1238,20 +1134,16 @@ void IRac::kelvinator(IRKelvinatorAC *ac,
 #if SEND_LG
 /// Send a LG A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRLgAc object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-void IRac::lg(IRLgAc *ac, const lg_ac_remote_model_t model,
-              const bool on, const stdAc::opmode_t mode,
-              const float degrees, const stdAc::fanspeed_t fan) {
+/// @param[in] state The settings to send. i.e. Its model, power, mode, degrees
+///   & fanspeed.
+void IRac::lg(IRLgAc *ac, const stdAc::state_t &state) {
+  const lg_ac_remote_model_t model = (lg_ac_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(state.degrees);
+  ac->setFan(ac->convertFan(state.fanspeed));
   // No Vertical swing setting available.
   // No Horizontal swing setting available.
   // No Quiet setting available.
@@ -1269,36 +1161,26 @@ void IRac::lg(IRLgAc *ac, const lg_ac_remote_model_t model,
 #if SEND_MIDEA
 /// Send a Midea A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRMideaAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] celsius Temperature units. True is Celsius, False is Fahrenheit.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
+/// @param[in] state The settings to send. i.e. Its power, mode, celsius,
+///   degrees, fanspeed, swingv, econo & sleep.
 /// @note On Danby A/C units, swingv controls the Ion Filter instead.
-void IRac::midea(IRMideaAC *ac,
-                 const bool on, const stdAc::opmode_t mode, const bool celsius,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv, const bool econo,
-                 const int16_t sleep) {
+void IRac::midea(IRMideaAC *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setUseCelsius(celsius);
-  ac->setTemp(degrees, celsius);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVToggle(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setUseCelsius(state.celsius);
+  ac->setTemp(state.degrees, state.celsius);
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVToggle(state.swingv != stdAc::swingv_t::kOff);
   // No Horizontal swing setting available.
   // No Quiet setting available.
   // No Turbo setting available.
-  ac->setEconoToggle(econo);
+  ac->setEconoToggle(state.econo);
   // No Light setting available.
   // No Filter setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep on this A/C is either on or off.
+  ac->setSleep(state.sleep >= 0);  // Sleep on this A/C is either on or off.
   // No Clock setting available.
   ac->send();
 }
@@ -1307,36 +1189,26 @@ void IRac::midea(IRMideaAC *ac,
 #if SEND_MITSUBISHI_AC
 /// Send a Mitsubishi A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRMitsubishiAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet & clock.
 /// @note Clock can only be set in 10 minute increments. i.e. % 10.
-void IRac::mitsubishi(IRMitsubishiAC *ac,
-                      const bool on, const stdAc::opmode_t mode,
-                      const float degrees,
-                      const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                      const stdAc::swingh_t swingh,
-                      const bool quiet, const int16_t clock) {
+void IRac::mitsubishi(IRMitsubishiAC *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setVane(ac->convertSwingV(swingv));
-  ac->setWideVane(ac->convertSwingH(swingh));
-  if (quiet) ac->setFan(kMitsubishiAcFanSilent);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setVane(ac->convertSwingV(state.swingv));
+  ac->setWideVane(ac->convertSwingH(state.swingh));
+  if (state.quiet) ac->setFan(kMitsubishiAcFanSilent);
   // No Turbo setting available.
   // No Light setting available.
   // No Filter setting available.
   // No Clean setting available.
   // No Beep setting available.
   // No Sleep setting available.
-  if (clock >= 0) ac->setClock(clock / 10);  // Clock is in 10 min increments.
+  // Clock is in 10 min increments.
+  if (state.clock >= 0) ac->setClock(state.clock / 10);
   ac->send();
 }
 #endif  // SEND_MITSUBISHI_AC
@@ -1344,27 +1216,17 @@ void IRac::mitsubishi(IRMitsubishiAC *ac,
 #if SEND_MITSUBISHI112
 /// Send a Mitsubishi 112-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRMitsubishi112 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-void IRac::mitsubishi112(IRMitsubishi112 *ac,
-                         const bool on, const stdAc::opmode_t mode,
-                         const float degrees, const stdAc::fanspeed_t fan,
-                         const stdAc::swingv_t swingv,
-                         const stdAc::swingh_t swingh,
-                         const bool quiet) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh & quiet.
+void IRac::mitsubishi112(IRMitsubishi112 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(ac->convertSwingV(swingv));
-  ac->setSwingH(ac->convertSwingH(swingh));
-  ac->setQuiet(quiet);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(ac->convertSwingV(state.swingv));
+  ac->setSwingH(ac->convertSwingH(state.swingh));
+  ac->setQuiet(state.quiet);
   // FIXME - Econo
   // ac->setEcono(econo);
   // No Turbo setting available.
@@ -1381,24 +1243,17 @@ void IRac::mitsubishi112(IRMitsubishi112 *ac,
 #if SEND_MITSUBISHI136
 /// Send a Mitsubishi 136-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRMitsubishi136 object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-void IRac::mitsubishi136(IRMitsubishi136 *ac,
-                         const bool on, const stdAc::opmode_t mode,
-                         const float degrees, const stdAc::fanspeed_t fan,
-                         const stdAc::swingv_t swingv, const bool quiet) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv & quiet.
+void IRac::mitsubishi136(IRMitsubishi136 *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(ac->convertSwingV(swingv));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(ac->convertSwingV(state.swingv));
   // No Horizontal Swing setting available.
-  ac->setQuiet(quiet);
+  ac->setQuiet(state.quiet);
   // No Turbo setting available.
   // No Light setting available.
   // No Filter setting available.
@@ -1413,36 +1268,23 @@ void IRac::mitsubishi136(IRMitsubishi136 *ac,
 #if SEND_MITSUBISHIHEAVY
 /// Send a Mitsubishi Heavy 88-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRMitsubishiHeavy88Ac object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, turbo, econo & clean.
 void IRac::mitsubishiHeavy88(IRMitsubishiHeavy88Ac *ac,
-                             const bool on, const stdAc::opmode_t mode,
-                             const float degrees,
-                             const stdAc::fanspeed_t fan,
-                             const stdAc::swingv_t swingv,
-                             const stdAc::swingh_t swingh,
-                             const bool turbo, const bool econo,
-                             const bool clean) {
+                             const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(ac->convertSwingV(swingv));
-  ac->setSwingHorizontal(ac->convertSwingH(swingh));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(ac->convertSwingV(state.swingv));
+  ac->setSwingHorizontal(ac->convertSwingH(state.swingh));
   // No Quiet setting available.
-  ac->setTurbo(turbo);
+  ac->setTurbo(state.turbo);
   // No Light setting available.
-  ac->setEcono(econo);
+  ac->setEcono(state.econo);
   // No Filter setting available.
-  ac->setClean(clean);
+  ac->setClean(state.clean);
   // No Beep setting available.
   // No Sleep setting available.
   // No Clock setting available.
@@ -1451,42 +1293,25 @@ void IRac::mitsubishiHeavy88(IRMitsubishiHeavy88Ac *ac,
 
 /// Send a Mitsubishi Heavy 152-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRMitsubishiHeavy152Ac object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet, turbo, econo, filter, clean & sleep.
 void IRac::mitsubishiHeavy152(IRMitsubishiHeavy152Ac *ac,
-                              const bool on, const stdAc::opmode_t mode,
-                              const float degrees,
-                              const stdAc::fanspeed_t fan,
-                              const stdAc::swingv_t swingv,
-                              const stdAc::swingh_t swingh,
-                              const bool quiet, const bool turbo,
-                              const bool econo, const bool filter,
-                              const bool clean, const int16_t sleep) {
+                              const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(ac->convertSwingV(swingv));
-  ac->setSwingHorizontal(ac->convertSwingH(swingh));
-  ac->setSilent(quiet);
-  ac->setTurbo(turbo);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(ac->convertSwingV(state.swingv));
+  ac->setSwingHorizontal(ac->convertSwingH(state.swingh));
+  ac->setSilent(state.quiet);
+  ac->setTurbo(state.turbo);
   // No Light setting available.
-  ac->setEcono(econo);
-  ac->setClean(clean);
-  ac->setFilter(filter);
+  ac->setEcono(state.econo);
+  ac->setClean(state.clean);
+  ac->setFilter(state.filter);
   // No Beep setting available.
-  ac->setNight(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setNight(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
   ac->send();
 }
@@ -1495,38 +1320,25 @@ void IRac::mitsubishiHeavy152(IRMitsubishiHeavy152Ac *ac,
 #if SEND_NEOCLIMA
 /// Send a Neoclima A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRNeoclimaAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::neoclima(IRNeoclimaAc *ac,
-                    const bool on, const stdAc::opmode_t mode,
-                    const float degrees, const stdAc::fanspeed_t fan,
-                    const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                    const bool turbo, const bool light, const bool filter,
-                    const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, turbo, light, filter & sleep.
+void IRac::neoclima(IRNeoclimaAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(swingv != stdAc::swingv_t::kOff);
-  ac->setSwingH(swingh != stdAc::swingh_t::kOff);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(state.swingv != stdAc::swingv_t::kOff);
+  ac->setSwingH(state.swingh != stdAc::swingh_t::kOff);
   // No Quiet setting available.
-  ac->setTurbo(turbo);
-  ac->setLight(light);
+  ac->setTurbo(state.turbo);
+  ac->setLight(state.light);
   // No Econo setting available.
-  ac->setIon(filter);
+  ac->setIon(state.filter);
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
-  ac->setPower(on);
+  ac->setPower(state.power);
   ac->send();
 }
 #endif  // SEND_NEOCLIMA
@@ -1534,40 +1346,28 @@ void IRac::neoclima(IRNeoclimaAc *ac,
 #if SEND_PANASONIC_AC
 /// Send a Panasonic A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRPanasonicAc object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
-void IRac::panasonic(IRPanasonicAc *ac, const panasonic_ac_remote_model_t model,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                     const bool quiet, const bool turbo, const bool filter,
-                     const int16_t clock) {
+/// @param[in] state The settings to send. i.e. Its model, power, mode, degrees,
+///   fanspeed, swingv, swingh, quiet, turbo, filter & clock.
+void IRac::panasonic(IRPanasonicAc *ac, const stdAc::state_t &state) {
+  const panasonic_ac_remote_model_t model =
+      (panasonic_ac_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(ac->convertSwingV(swingv));
-  ac->setSwingHorizontal(ac->convertSwingH(swingh));
-  ac->setQuiet(quiet);
-  ac->setPowerful(turbo);
-  ac->setIon(filter);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(ac->convertSwingV(state.swingv));
+  ac->setSwingHorizontal(ac->convertSwingH(state.swingh));
+  ac->setQuiet(state.quiet);
+  ac->setPowerful(state.turbo);
+  ac->setIon(state.filter);
   // No Light setting available.
   // No Econo setting available.
   // No Clean setting available.
   // No Beep setting available.
   // No Sleep setting available.
-  if (clock >= 0) ac->setClock(clock);
+  if (state.clock >= 0) ac->setClock(state.clock);
   ac->send();
 }
 #endif  // SEND_PANASONIC_AC
@@ -1576,46 +1376,31 @@ void IRac::panasonic(IRPanasonicAc *ac, const panasonic_ac_remote_model_t model,
 /// Send a Samsung A/C message with the supplied settings.
 /// @note Multiple IR messages may be generated & sent.
 /// @param[in, out] ac A Ptr to an IRSamsungAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] quiet Run the device in quiet/silent mode.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-/// @param[in] beep Enable/Disable beeps when receiving IR messages.
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, quiet, turbo, light, filter, clean & beep.
 /// @param[in] prevpower The power setting from the previous A/C state.
 /// @param[in] forcepower Do we force send the special power message?
-void IRac::samsung(IRSamsungAc *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees,
-                   const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                   const bool quiet, const bool turbo, const bool light,
-                   const bool filter, const bool clean,
-                   const bool beep, const bool prevpower,
-                   const bool forcepower) {
+void IRac::samsung(IRSamsungAc *ac, const stdAc::state_t &state,
+                   const bool prevpower, const bool forcepower) {
   ac->begin();
   ac->stateReset(forcepower, prevpower);
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(state.swingv != stdAc::swingv_t::kOff);
   // No Horizontal swing setting available.
-  ac->setQuiet(quiet);
-  ac->setPowerful(turbo);
-  ac->setDisplay(light);
+  ac->setQuiet(state.quiet);
+  ac->setPowerful(state.turbo);
+  ac->setDisplay(state.light);
   // No Econo setting available.
-  ac->setIon(filter);
-  ac->setClean(clean);
-  ac->setBeep(beep);
+  ac->setIon(state.filter);
+  ac->setClean(state.clean);
+  ac->setBeep(state.beep);
   // No Sleep setting available.
   // No Clock setting available.
   // Do setMode() again as it can affect fan speed.
-  ac->setMode(ac->convertMode(mode));
+  ac->setMode(ac->convertMode(state.mode));
   ac->send();
 }
 #endif  // SEND_SAMSUNG_AC
@@ -1623,24 +1408,15 @@ void IRac::samsung(IRSamsungAc *ac,
 #if SEND_SANYO_AC
 /// Send a Toshiba A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRSanyoAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] beep Enable/Disable beeps when receiving IR messages.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::sanyo(IRSanyoAc *ac,
-                 const bool on, const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv, const bool beep,
-                 const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, beep & sleep.
+void IRac::sanyo(IRSanyoAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(ac->convertSwingV(swingv));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(ac->convertSwingV(state.swingv));
   // No Horizontal swing setting available.
   // No Quiet setting available.
   // No Turbo setting available.
@@ -1648,13 +1424,14 @@ void IRac::sanyo(IRSanyoAc *ac,
   // No Light setting available.
   // No Filter setting available.
   // No Clean setting available.
-  ac->setBeep(beep);
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setBeep(state.beep);
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
 
   // Extra
   ac->setSensor(true);  // Set the A/C to use the temp sensor in the Unit/Wall.
-  ac->setSensorTemp(degrees);  // Set the sensor temp to the desired temp.
+  // Set the sensor temp to the desired temp.
+  ac->setSensorTemp(celsiusOf(state));
   ac->send();
 }
 #endif  // SEND_SANYO_AC
@@ -1663,30 +1440,20 @@ void IRac::sanyo(IRSanyoAc *ac,
 /// Send a Sharp A/C message with the supplied settings.
 /// @note Multiple IR messages may be generated & sent.
 /// @param[in, out] ac A Ptr to an IRSharpAc object to use.
-/// @param[in] on The power setting.
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, turbo, filter & clean.
 /// @param[in] prev_power The power setting from the previous A/C state.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] clean Turn on the self-cleaning mode. e.g. Mould, dry filters etc
-void IRac::sharp(IRSharpAc *ac,
-                 const bool on, const bool prev_power,
-                 const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv, const bool turbo,
-                 const bool filter, const bool clean) {
+void IRac::sharp(IRSharpAc *ac, const stdAc::state_t &state,
+                 const bool prev_power) {
   ac->begin();
-  ac->setPower(on, prev_power);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingToggle(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power, prev_power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingToggle(state.swingv != stdAc::swingv_t::kOff);
   // Econo  deliberately not used as it cycles through 3 modes uncontrolably.
   // ac->setEconoToggle(econo);
-  ac->setIon(filter);
+  ac->setIon(state.filter);
   // No Horizontal swing setting available.
   // No Quiet setting available.
   // No Light setting available.
@@ -1694,15 +1461,15 @@ void IRac::sharp(IRSharpAc *ac,
   // No Sleep setting available.
   // No Clock setting available.
   // Do setMode() again as it can affect fan speed and temp.
-  ac->setMode(ac->convertMode(mode));
+  ac->setMode(ac->convertMode(state.mode));
   // Clean after mode, as it can affect the mode, temp & fan speed.
-  if (clean) {
+  if (state.clean) {
     // A/C needs to be off before we can enter clean mode.
     ac->setPower(false, prev_power);
     ac->send();
   }
-  ac->setClean(clean);
-  if (turbo) {
+  ac->setClean(state.clean);
+  if (state.turbo) {
     ac->send();  // Send the current state.
     // Set up turbo mode as it needs to be sent after everything else.
     ac->setTurbo(true);
@@ -1714,34 +1481,21 @@ void IRac::sharp(IRSharpAc *ac,
 #if SEND_TCL112AC
 /// Send a TCL 112-bit A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRTcl112Ac object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-void IRac::tcl112(IRTcl112Ac *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                  const bool turbo, const bool light, const bool econo,
-                  const bool filter) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, swingh, turbo, light, econo & filter.
+void IRac::tcl112(IRTcl112Ac *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingVertical(swingv != stdAc::swingv_t::kOff);
-  ac->setSwingHorizontal(swingh != stdAc::swingh_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingVertical(state.swingv != stdAc::swingv_t::kOff);
+  ac->setSwingHorizontal(state.swingh != stdAc::swingh_t::kOff);
   // No Quiet setting available.
-  ac->setTurbo(turbo);
-  ac->setLight(light);
-  ac->setEcono(econo);
-  ac->setHealth(filter);
+  ac->setTurbo(state.turbo);
+  ac->setLight(state.light);
+  ac->setEcono(state.econo);
+  ac->setHealth(state.filter);
   // No Clean setting available.
   // No Beep setting available.
   // No Sleep setting available.
@@ -1753,22 +1507,15 @@ void IRac::tcl112(IRTcl112Ac *ac,
 #if SEND_TECHNIBEL_AC
 /// Send a Technibel A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRTechnibelAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::technibel(IRTechnibelAc *ac,
-                const bool on, const stdAc::opmode_t mode, const float degrees,
-                const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv & sleep.
+void IRac::technibel(IRTechnibelAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(state.swingv != stdAc::swingv_t::kOff);
   // No Horizontal swing setting available.
   // No Quiet setting available.
   // No Turbo setting available.
@@ -1776,7 +1523,7 @@ void IRac::technibel(IRTechnibelAc *ac,
   // No Filter setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
   ac->send();
 }
@@ -1785,31 +1532,23 @@ void IRac::technibel(IRTechnibelAc *ac,
 #if SEND_TECO
 /// Send a Teco A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRTecoAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::teco(IRTecoAc *ac,
-                const bool on, const stdAc::opmode_t mode, const float degrees,
-                const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                const bool light, const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, light & sleep.
+void IRac::teco(IRTecoAc *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(state.swingv != stdAc::swingv_t::kOff);
   // No Horizontal swing setting available.
   // No Quiet setting available.
   // No Turbo setting available.
-  ac->setLight(light);
+  ac->setLight(state.light);
   // No Filter setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
   ac->send();
 }
@@ -1818,29 +1557,22 @@ void IRac::teco(IRTecoAc *ac,
 #if SEND_TOSHIBA_AC
 /// Send a Toshiba A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRToshibaAC object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-void IRac::toshiba(IRToshibaAC *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees, const stdAc::fanspeed_t fan,
-                   const stdAc::swingv_t swingv,
-                   const bool turbo, const bool econo) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, turbo & econo.
+/// @param[in] sendSwing Do we send the separate swing message as well?
+void IRac::toshiba(IRToshibaAC *ac, const stdAc::state_t &state,
+                   const bool sendSwing) {
   ac->begin();
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
   // The API has no "step" option, so off is off, anything else is on.
-  ac->setSwing((swingv == stdAc::swingv_t::kOff) ? kToshibaAcSwingOff
-                                                 : kToshibaAcSwingOn);
+  ac->setSwing((state.swingv == stdAc::swingv_t::kOff) ? kToshibaAcSwingOff
+                                                       : kToshibaAcSwingOn);
   // No Horizontal swing setting available.
   // No Quiet setting available.
-  ac->setTurbo(turbo);
-  ac->setEcono(econo);
+  ac->setTurbo(state.turbo);
+  ac->setEcono(state.econo);
   // No Light setting available.
   // No Filter setting available.
   // No Clean setting available.
@@ -1848,28 +1580,25 @@ void IRac::toshiba(IRToshibaAC *ac,
   // No Sleep setting available.
   // No Clock setting available.
   // Do this last because Toshiba A/C has an odd quirk with how power off works.
-  ac->setPower(on);
-  ac->send();
+  ac->setPower(state.power);
+  if (sendSwing)
+    ac->send();
+  else
+    ac->sendState();  // The swing hasn't changed, so skip its message.
 }
 #endif  // SEND_TOSHIBA_AC
 
 #if SEND_TROTEC
 /// Send a Trotec A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRTrotecESP object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::trotec(IRTrotecESP *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed & sleep.
+void IRac::trotec(IRTrotecESP *ac, const stdAc::state_t &state) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setSpeed(ac->convertFan(fan));
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setSpeed(ac->convertFan(state.fanspeed));
   // No Vertical swing setting available.
   // No Horizontal swing setting available.
   // No Quiet setting available.
@@ -1878,7 +1607,7 @@ void IRac::trotec(IRTrotecESP *ac,
   // No Filter setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
   ac->send();
 }
@@ -1887,37 +1616,27 @@ void IRac::trotec(IRTrotecESP *ac,
 #if SEND_VESTEL_AC
 /// Send a Vestel A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRVestelAc object to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] filter Turn on the (ion/pollen/etc) filter mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
+/// @param[in] state The settings to send. i.e. Its power, mode, degrees,
+///   fanspeed, swingv, turbo, filter & sleep.
 /// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
 /// @param[in] sendNormal Do we send a Normal settings message at all?
 ///  i.e In addition to the clock/time/timer message
-void IRac::vestel(IRVestelAc *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees,
-                  const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                  const bool turbo, const bool filter, const int16_t sleep,
+void IRac::vestel(IRVestelAc *ac, const stdAc::state_t &state,
                   const int16_t clock, const bool sendNormal) {
   ac->begin();
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(swingv != stdAc::swingv_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(state.swingv != stdAc::swingv_t::kOff);
   // No Horizontal swing setting available.
   // No Quiet setting available.
-  ac->setTurbo(turbo);
+  ac->setTurbo(state.turbo);
   // No Light setting available.
-  ac->setIon(filter);
+  ac->setIon(state.filter);
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   if (sendNormal) ac->send();  // Send the normal message.
   if (clock >= 0) {
     ac->setTime(clock);
@@ -1929,40 +1648,26 @@ void IRac::vestel(IRVestelAc *ac,
 #if SEND_VOLTAS
 /// Send a Voltas A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRVoltas object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] swingh The horizontal swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] econo Run the device in economical mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-void IRac::voltas(IRVoltas *ac,
-                  const voltas_ac_remote_model_t model,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                  const bool turbo, const bool econo, const bool light,
-                  const int16_t sleep) {
+/// @param[in] state The settings to send. i.e. Its model, power, mode, degrees,
+///   fanspeed, swingv, swingh, turbo, econo, light & sleep.
+void IRac::voltas(IRVoltas *ac, const stdAc::state_t &state) {
+  const voltas_ac_remote_model_t model = (voltas_ac_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  ac->setPower(on);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwingV(swingv != stdAc::swingv_t::kOff);
-  ac->setSwingH(swingh != stdAc::swingh_t::kOff);
+  ac->setPower(state.power);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwingV(state.swingv != stdAc::swingv_t::kOff);
+  ac->setSwingH(state.swingh != stdAc::swingh_t::kOff);
   // No Quiet setting available.
-  ac->setTurbo(turbo);
-  ac->setEcono(econo);
-  ac->setLight(light);
+  ac->setTurbo(state.turbo);
+  ac->setEcono(state.econo);
+  ac->setLight(state.light);
   // No Filter setting available.
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
   // No Clock setting available.
   ac->send();
 }
@@ -1971,38 +1676,27 @@ void IRac::voltas(IRVoltas *ac,
 #if SEND_WHIRLPOOL_AC
 /// Send a Whirlpool A/C message with the supplied settings.
 /// @param[in, out] ac A Ptr to an IRWhirlpoolAc object to use.
-/// @param[in] model The A/C model to use.
-/// @param[in] on The power setting.
-/// @param[in] mode The operation mode setting.
-/// @param[in] degrees The temperature setting in degrees.
-/// @param[in] fan The speed setting for the fan.
-/// @param[in] swingv The vertical swing setting.
-/// @param[in] turbo Run the device in turbo/powerful mode.
-/// @param[in] light Turn on the LED/Display mode.
-/// @param[in] sleep Nr. of minutes for sleep mode. -1 is Off, >= 0 is on.
-/// @param[in] clock The time in Nr. of mins since midnight. < 0 is ignore.
-void IRac::whirlpool(IRWhirlpoolAc *ac, const whirlpool_ac_remote_model_t model,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees,
-                     const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                     const bool turbo, const bool light,
-                     const int16_t sleep, const int16_t clock) {
+/// @param[in] state The settings to send. i.e. Its model, power, mode, degrees,
+///   fanspeed, swingv, turbo, light, sleep & clock.
+void IRac::whirlpool(IRWhirlpoolAc *ac, const stdAc::state_t &state) {
+  const whirlpool_ac_remote_model_t model =
+      (whirlpool_ac_remote_model_t)state.model;
   ac->begin();
   ac->setModel(model);
-  ac->setMode(ac->convertMode(mode));
-  ac->setTemp(degrees);
-  ac->setFan(ac->convertFan(fan));
-  ac->setSwing(swingv != stdAc::swingv_t::kOff);
+  ac->setMode(ac->convertMode(state.mode));
+  ac->setTemp(celsiusOf(state));
+  ac->setFan(ac->convertFan(state.fanspeed));
+  ac->setSwing(state.swingv != stdAc::swingv_t::kOff);
   // No Horizontal swing setting available.
   // No Quiet setting available.
-  ac->setSuper(turbo);
-  ac->setLight(light);
+  ac->setSuper(state.turbo);
+  ac->setLight(state.light);
   // No Filter setting available
   // No Clean setting available.
   // No Beep setting available.
-  ac->setSleep(sleep >= 0);  // Sleep is either on/off, so convert to boolean.
-  if (clock >= 0) ac->setClock(clock);
-  ac->setPowerToggle(on);
+  ac->setSleep(state.sleep >= 0);  // Sleep is on/off, so convert to boolean.
+  if (state.clock >= 0) ac->setClock(state.clock);
+  ac->setPowerToggle(state.power);
   ac->send();
 }
 #endif  // SEND_WHIRLPOOL_AC
@@ -2012,12 +1706,18 @@ void IRac::whirlpool(IRWhirlpoolAc *ac, const whirlpool_ac_remote_model_t model,
 ///   the power is off.
 /// @param[in] state The state_t structure describing the desired a/c state.
 /// @return A stdAc::state_t with the needed settings.
-stdAc::state_t IRac::cleanState(const stdAc::state_t state) {
+stdAc::state_t IRac::cleanState(const stdAc::state_t &state) {
   stdAc::state_t result = state;
+  _cleanState(&result);
+  return result;
+}
+
+/// Suitably fix a state in place. See `cleanState()`.
+/// @param[in,out] state The state_t structure to fix.
+void IRac::_cleanState(stdAc::state_t *state) {
   // A hack for Home Assistant, it appears to need/want an Off opmode.
   // So enforce the power is off if the mode is also off.
-  if (state.mode == stdAc::opmode_t::kOff) result.power = false;
-  return result;
+  if (state->mode == stdAc::opmode_t::kOff) state->power = false;
 }
 
 /// Create a new state base on desired & previous states but handle
@@ -2025,60 +1725,68 @@ stdAc::state_t IRac::cleanState(const stdAc::state_t state) {
 /// @param[in] desired The state_t structure describing the desired a/c state.
 /// @param[in] prev A Ptr to the previous state_t structure.
 /// @return A stdAc::state_t with the needed settings.
-stdAc::state_t IRac::handleToggles(const stdAc::state_t desired,
+stdAc::state_t IRac::handleToggles(const stdAc::state_t &desired,
                                    const stdAc::state_t *prev) {
   stdAc::state_t result = desired;
+  _handleToggles(&result, prev);
+  return result;
+}
+
+/// Handle any state changes for options that need to be toggled, in place.
+/// See `handleToggles()`.
+/// @param[in,out] state The desired state_t, to turn into the one to send.
+/// @param[in] prev A Ptr to the previous state_t structure.
+void IRac::_handleToggles(stdAc::state_t *state, const stdAc::state_t *prev) {
   // If we've been given a previous state AND the it's the same A/C basically.
-  if (prev != NULL && desired.protocol == prev->protocol &&
-      desired.model == prev->model) {
+  if (prev != NULL && state->protocol == prev->protocol &&
+      state->model == prev->model) {
     // Check if we have to handle toggle settings for specific A/C protocols.
-    switch (desired.protocol) {
+    switch (state->protocol) {
       case decode_type_t::COOLIX:
-        if ((desired.swingv == stdAc::swingv_t::kOff) ^
+        if ((state->swingv == stdAc::swingv_t::kOff) ^
             (prev->swingv == stdAc::swingv_t::kOff))  // It changed, so toggle.
-          result.swingv = stdAc::swingv_t::kAuto;
+          state->swingv = stdAc::swingv_t::kAuto;
         else
-          result.swingv = stdAc::swingv_t::kOff;  // No change, so no toggle.
-        result.turbo = desired.turbo ^ prev->turbo;
-        result.light = desired.light ^ prev->light;
-        result.clean = desired.clean ^ prev->clean;
-        result.sleep = ((desired.sleep >= 0) ^ (prev->sleep >= 0)) ? 0 : -1;
+          state->swingv = stdAc::swingv_t::kOff;  // No change, so no toggle.
+        state->turbo ^= prev->turbo;
+        state->light ^= prev->light;
+        state->clean ^= prev->clean;
+        state->sleep = ((state->sleep >= 0) ^ (prev->sleep >= 0)) ? 0 : -1;
         break;
       case decode_type_t::DAIKIN128:
-        result.power = desired.power ^ prev->power;
-        result.light = desired.light ^ prev->light;
+        state->power ^= prev->power;
+        state->light ^= prev->light;
         break;
       case decode_type_t::ELECTRA_AC:
-        result.light = desired.light ^ prev->light;
+        state->light ^= prev->light;
         break;
       case decode_type_t::MIDEA:
-        result.econo = desired.econo ^ prev->econo;
+        state->econo ^= prev->econo;
         // FALL THRU
       case decode_type_t::CORONA_AC:
       case decode_type_t::HITACHI_AC344:
       case decode_type_t::HITACHI_AC424:
       case decode_type_t::SHARP_AC:
-        if ((desired.swingv == stdAc::swingv_t::kOff) ^
+        if ((state->swingv == stdAc::swingv_t::kOff) ^
             (prev->swingv == stdAc::swingv_t::kOff))  // It changed, so toggle.
-          result.swingv = stdAc::swingv_t::kAuto;
+          state->swingv = stdAc::swingv_t::kAuto;
         else
-          result.swingv = stdAc::swingv_t::kOff;  // No change, so no toggle.
+          state->swingv = stdAc::swingv_t::kOff;  // No change, so no toggle.
         break;
       case decode_type_t::AIRWELL:
       case decode_type_t::DAIKIN64:
       case decode_type_t::WHIRLPOOL_AC:
-        result.power = desired.power ^ prev->power;
+        state->power ^= prev->power;
         break;
       case decode_type_t::PANASONIC_AC:
         // CKP models use a power mode toggle.
-        if (desired.model == panasonic_ac_remote_model_t::kPanasonicCkp)
-          result.power = desired.power ^ prev->power;
+        if (state->model == panasonic_ac_remote_model_t::kPanasonicCkp)
+          state->power ^= prev->power;
         break;
       default:
         {};
     }
   }
-  return result;
 }
 
 /// Send A/C message for a given device using common A/C settings.
@@ -2120,259 +1828,420 @@ bool IRac::sendAc(const decode_type_t vendor, const int16_t model,
   return this->sendAc(to_send, &to_send);
 }
 
+#if ENABLE_IRAC_FRAME_CACHE
+/// Does what a protocol sends depend on more of the previous state than a
+/// frame cache entry remembers? i.e. It can't be cached.
+/// @param[in] send The state_t to send. i.e. From `handleToggles()`.
+/// @param[in] prev A Ptr to the previous state_t, if any.
+/// @param[in] delta Is `setDeltaSend()` on?
+/// @return true, if it does. Otherwise false.
+static bool needsWholePrev(const stdAc::state_t &send,
+                           const stdAc::state_t *prev, const bool delta) {
+  if (prev == NULL) return false;
+  switch (send.protocol) {
+    case decode_type_t::HAIER_AC_YRW02: return true;  // The button pressed.
+    case decode_type_t::VESTEL_AC: return delta;  // Settings and/or the time.
+    default: return false;
+  }
+}
+#endif  // ENABLE_IRAC_FRAME_CACHE
+
 /// Send A/C message for a given device using state_t structures.
 /// @param[in] desired The state_t structure describing the desired new ac state
 /// @param[in] prev A Ptr to the state_t structure containing the previous state
 /// @return True, if accepted/converted/attempted etc. False, if unsupported.
-bool IRac::sendAc(const stdAc::state_t desired, const stdAc::state_t *prev) {
-  // Convert the temp from Fahrenheit to Celsius if we are not in Celsius mode.
-  float degC __attribute__((unused)) =
-      desired.celsius ? desired.degrees : fahrenheitToCelsius(desired.degrees);
-  // special `state_t` that is required to be sent based on that.
-  stdAc::state_t send = this->handleToggles(this->cleanState(desired), prev);
+bool IRac::sendAc(const stdAc::state_t &desired, const stdAc::state_t *prev) {
+#if ENABLE_MEMORY_PROFILING
+  irutils::MemoryProbe probe(kMemProbeSendAc);
+#endif  // ENABLE_MEMORY_PROFILING
+  // The one working copy of the state. It is cleaned up & has any toggles
+  // applied in place, then everything else uses it by reference.
+  stdAc::state_t send = desired;
+  _cleanState(&send);
+  _handleToggles(&send, prev);
+  if (_delta && _sendDeltaAc(send, prev)) return true;
+#if ENABLE_IRAC_FRAME_CACHE
+  if (_frames != NULL && !needsWholePrev(send, prev, _delta))
+    return _sendCachedAc(send, prev);
+#endif  // ENABLE_IRAC_FRAME_CACHE
+  return _sendAc(send, prev);
+}
+
+/// Does the protocol accept room/sensor temperature reports? e.g. iFeel.
+/// @param[in] protocol The vendor/protocol type.
+/// @return true, if `sendSensorTemp()` can send them. Otherwise false.
+bool IRac::isSensorTempSupported(const decode_type_t protocol) {
+  switch (protocol) {
+#if SEND_ARGO
+    case decode_type_t::ARGO:
+#endif  // SEND_ARGO
+#if SEND_COOLIX
+    case decode_type_t::COOLIX:
+#endif  // SEND_COOLIX
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Send a room/sensor temperature report to an A/C, rather than a whole new
+/// state. e.g. For iFeel or Zone Follow, which use the temperature where the
+/// remote is, rather than at the A/C. Typically sent every few minutes.
+/// @param[in] desired The state the A/C is in. Only its protocol is needed,
+///   unless the report includes the state. (e.g. Coolix)
+/// @param[in] degrees The temperature to report. In the same units as
+///   `desired.celsius`.
+/// @param[in,out] queue Where to add the report to, rather than sending it
+///   now. e.g. To send it in the background. NULL to send it now.
+/// @param[in] priority The queue priority to add it with. The default is the
+///   lowest, so it is sent after any other messages that are waiting.
+/// @return true, if it was sent/added. false if the protocol has no such
+///   report, the A/C is off, or the queue is full.
+bool IRac::sendSensorTemp(const stdAc::state_t &desired, const float degrees,
+                          IRsendQueue *queue, const uint8_t priority) {
+  stdAc::state_t send = desired;
+  _cleanState(&send);
+  float sensorC __attribute__((unused)) =
+      send.celsius ? degrees : fahrenheitToCelsius(degrees);
+  if (sensorC < 0) sensorC = 0;  // The reports can't go below zero.
+  switch (send.protocol) {
+#if SEND_ARGO
+    case decode_type_t::ARGO:
+    {
+      if (queue != NULL) {
+        uint8_t report[kArgoShortStateLength];
+        IRArgoAC::encodeSensorTemp(sensorC, report);
+        return queue->add(decode_type_t::ARGO, report, kArgoShortStateLength,
+                          priority, false);
+      }
+      IRArgoAC ac(_pin, _inverted, _modulation);
+      ac.begin();
+      ac.sendSensorTemp(sensorC);
+      return true;
+    }
+#endif  // SEND_ARGO
+#if SEND_COOLIX
+    case decode_type_t::COOLIX:
+    {
+      if (!send.power) return false;
+      const float degC = celsiusOf(send);
+      IRCoolixAC ac(_pin, _inverted, _modulation);
+      ac.begin();
+      ac.setPower(true);
+      ac.setMode(ac.convertMode(send.mode));
+      ac.setTemp(degC);
+      ac.setFan(ac.convertFan(send.fanspeed));
+      if (queue != NULL) {
+        ac.setSensorTemp(sensorC);
+        return queue->add(decode_type_t::COOLIX, ac.getRaw(), kCoolixBits,
+                          kCoolixDefaultRepeat, priority, false);
+      }
+      ac.sendSensorTemp(sensorC);
+      return true;
+    }
+#endif  // SEND_COOLIX
+    default:
+      return false;
+  }
+}
+
+/// Send only the short message(s) that change the A/C from `prev` to `send`,
+/// if the protocol has them & nothing else has changed. See `setDeltaSend()`.
+/// @param[in] send The state_t to send. i.e. From `handleToggles()`.
+/// @param[in] prev A Ptr to the state_t structure containing the previous state
+/// @return True, if it was sent. False, if a full message is needed instead.
+bool IRac::_sendDeltaAc(const stdAc::state_t &send,
+                        const stdAc::state_t *prev) {
+  if (prev == NULL || !prev->power || !send.power) return false;
+  // Short messages only exist for the swing, turbo, & econo settings, so
+  // everything else must be unchanged.
+  stdAc::state_t others = *prev;
+  others.swingv = send.swingv;
+  others.swingh = send.swingh;
+  others.turbo = send.turbo;
+  others.econo = send.econo;
+  if (cmpStates(others, send)) return false;
+  const bool swingv = (send.swingv == stdAc::swingv_t::kOff) ^
+      (prev->swingv == stdAc::swingv_t::kOff);
+  const bool swingh = (send.swingh == stdAc::swingh_t::kOff) ^
+      (prev->swingh == stdAc::swingh_t::kOff);
+  const bool turbo = send.turbo != prev->turbo;
+  const bool econo = send.econo != prev->econo;
+  switch (send.protocol) {
+#if SEND_FUJITSU_AC
+    case FUJITSU_AC:
+    {
+      if (!swingv && !swingh && !turbo && !econo) return false;
+      if (turbo || econo) {
+        // Only this remote has them, & only as commands that turn them on.
+        if (send.model != fujitsu_ac_remote_model_t::ARREB1E) return false;
+        if ((turbo && !send.turbo) || (econo && !send.econo)) return false;
+      }
+      if (swingh) {
+        switch (send.model) {
+          // Only these remotes have horizontal swing.
+          case fujitsu_ac_remote_model_t::ARRAH2E:
+          case fujitsu_ac_remote_model_t::ARJW2:
+            break;
+          default:
+            return false;
+        }
+      }
+      IRAC_OBJECT(IRFujitsuAC, ac, _pin, (fujitsu_ac_remote_model_t)send.model,
+                  _inverted, _modulation);
+      ac.begin();
+      ac.setModel((fujitsu_ac_remote_model_t)send.model);
+      if (turbo) {
+        ac.setCmd(kFujitsuAcCmdPowerful);
+        ac.send();
+      }
+      if (econo) {
+        ac.setCmd(kFujitsuAcCmdEcono);
+        ac.send();
+      }
+      if (swingv) {
+        ac.setCmd(kFujitsuAcCmdToggleSwingVert);
+        ac.send();
+      }
+      if (swingh) {
+        ac.setCmd(kFujitsuAcCmdToggleSwingHoriz);
+        ac.send();
+      }
+      ac.setCmd(kFujitsuAcCmdStayOn);
+      return true;
+    }
+#endif  // SEND_FUJITSU_AC
+#if SEND_TOSHIBA_AC
+    case TOSHIBA_AC:
+    {
+      // Turbo & Econo need the long message. See `_sendAc()` for the rest.
+      if (!swingv || swingh || turbo || econo) return false;
+      IRAC_OBJECT(IRToshibaAC, ac, _pin, _inverted, _modulation);
+      ac.begin();
+      ac.sendSwing((send.swingv == stdAc::swingv_t::kOff) ? kToshibaAcSwingOff
+                                                          : kToshibaAcSwingOn);
+      return true;
+    }
+#endif  // SEND_TOSHIBA_AC
+    default:
+      return false;
+  }
+}
+
+/// Send A/C message for a given device using the state it needs to be sent.
+/// @param[in] send The state_t to send. i.e. From `handleToggles()`.
+/// @param[in] prev A Ptr to the state_t structure containing the previous state
+/// @return True, if accepted/converted/attempted etc. False, if unsupported.
+bool IRac::_sendAc(const stdAc::state_t &send, const stdAc::state_t *prev) {
   // Per vendor settings & setup.
   switch (send.protocol) {
 #if SEND_AIRWELL
     case AIRWELL:
     {
-      IRAirwellAc ac(_pin, _inverted, _modulation);
-      airwell(&ac, send.power, send.mode, degC, send.fanspeed);
+      IRAC_OBJECT(IRAirwellAc, ac, _pin, _inverted, _modulation);
+      airwell(&ac, send);
       break;
     }
 #endif  // SEND_AIRWELL
 #if SEND_AMCOR
     case AMCOR:
     {
-      IRAmcorAc ac(_pin, _inverted, _modulation);
-      amcor(&ac, send.power, send.mode, degC, send.fanspeed);
+      IRAC_OBJECT(IRAmcorAc, ac, _pin, _inverted, _modulation);
+      amcor(&ac, send);
       break;
     }
 #endif  // SEND_AMCOR
 #if SEND_ARGO
     case ARGO:
     {
-      IRArgoAC ac(_pin, _inverted, _modulation);
-      argo(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-           send.turbo, send.sleep);
+      IRAC_OBJECT(IRArgoAC, ac, _pin, _inverted, _modulation);
+      argo(&ac, send);
       break;
     }
 #endif  // SEND_ARGO
 #if SEND_CARRIER_AC64
     case CARRIER_AC64:
     {
-      IRCarrierAc64 ac(_pin, _inverted, _modulation);
-      carrier64(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                send.sleep);
+      IRAC_OBJECT(IRCarrierAc64, ac, _pin, _inverted, _modulation);
+      carrier64(&ac, send);
       break;
     }
 #endif  // SEND_CARRIER_AC64
 #if SEND_COOLIX
     case COOLIX:
     {
-      IRCoolixAC ac(_pin, _inverted, _modulation);
-      coolix(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-             send.swingh, send.turbo, send.light, send.clean, send.sleep);
+      IRAC_OBJECT(IRCoolixAC, ac, _pin, _inverted, _modulation);
+      coolix(&ac, send, _burst);
       break;
     }
 #endif  // SEND_COOLIX
 #if SEND_CORONA_AC
     case CORONA_AC:
     {
-      IRCoronaAc ac(_pin, _inverted, _modulation);
-      corona(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-             send.econo);
+      IRAC_OBJECT(IRCoronaAc, ac, _pin, _inverted, _modulation);
+      corona(&ac, send);
       break;
     }
 #endif  // SEND_CORONA_AC
 #if SEND_DAIKIN
     case DAIKIN:
     {
-      IRDaikinESP ac(_pin, _inverted, _modulation);
-      daikin(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-             send.swingh, send.quiet, send.turbo, send.econo, send.clean);
+      IRAC_OBJECT(IRDaikinESP, ac, _pin, _inverted, _modulation);
+      daikin(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN
 #if SEND_DAIKIN128
     case DAIKIN128:
     {
-      IRDaikin128 ac(_pin, _inverted, _modulation);
-      daikin128(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                send.quiet, send.turbo, send.light, send.econo, send.sleep,
-                send.clock);
+      IRAC_OBJECT(IRDaikin128, ac, _pin, _inverted, _modulation);
+      daikin128(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN2
 #if SEND_DAIKIN152
     case DAIKIN152:
     {
-      IRDaikin152 ac(_pin, _inverted, _modulation);
-      daikin152(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                send.quiet, send.turbo, send.econo);
+      IRAC_OBJECT(IRDaikin152, ac, _pin, _inverted, _modulation);
+      daikin152(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN152
 #if SEND_DAIKIN160
     case DAIKIN160:
     {
-      IRDaikin160 ac(_pin, _inverted, _modulation);
-      daikin160(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv);
+      IRAC_OBJECT(IRDaikin160, ac, _pin, _inverted, _modulation);
+      daikin160(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN160
 #if SEND_DAIKIN176
     case DAIKIN176:
     {
-      IRDaikin176 ac(_pin, _inverted, _modulation);
-      daikin176(&ac, send.power, send.mode, degC, send.fanspeed, send.swingh);
+      IRAC_OBJECT(IRDaikin176, ac, _pin, _inverted, _modulation);
+      daikin176(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN176
 #if SEND_DAIKIN2
     case DAIKIN2:
     {
-      IRDaikin2 ac(_pin, _inverted, _modulation);
-      daikin2(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-              send.swingh, send.quiet, send.turbo, send.light, send.econo,
-              send.filter, send.clean, send.beep, send.sleep, send.clock);
+      IRAC_OBJECT(IRDaikin2, ac, _pin, _inverted, _modulation);
+      daikin2(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN2
 #if SEND_DAIKIN216
     case DAIKIN216:
     {
-      IRDaikin216 ac(_pin, _inverted, _modulation);
-      daikin216(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                send.swingh, send.quiet, send.turbo);
+      IRAC_OBJECT(IRDaikin216, ac, _pin, _inverted, _modulation);
+      daikin216(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN216
 #if SEND_DAIKIN64
     case DAIKIN64:
     {
-      IRDaikin64 ac(_pin, _inverted, _modulation);
-      daikin64(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-               send.quiet, send.turbo, send.sleep, send.clock);
+      IRAC_OBJECT(IRDaikin64, ac, _pin, _inverted, _modulation);
+      daikin64(&ac, send);
       break;
     }
 #endif  // SEND_DAIKIN64
 #if SEND_DELONGHI_AC
     case DELONGHI_AC:
     {
-      IRDelonghiAc ac(_pin, _inverted, _modulation);
-      delonghiac(&ac, send.power, send.mode, send.celsius, degC, send.fanspeed,
-                 send.turbo, send.sleep);
+      IRAC_OBJECT(IRDelonghiAc, ac, _pin, _inverted, _modulation);
+      delonghiac(&ac, send);
       break;
     }
 #endif  // SEND_DELONGHI_AC
 #if SEND_ELECTRA_AC
     case ELECTRA_AC:
     {
-      IRElectraAc ac(_pin, _inverted, _modulation);
-      electra(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-              send.swingh, send.turbo, send.light, send.clean);
+      IRAC_OBJECT(IRElectraAc, ac, _pin, _inverted, _modulation);
+      electra(&ac, send);
       break;
     }
 #endif  // SEND_ELECTRA_AC
 #if SEND_FUJITSU_AC
     case FUJITSU_AC:
     {
-      IRFujitsuAC ac(_pin, (fujitsu_ac_remote_model_t)send.model, _inverted,
-                     _modulation);
-      fujitsu(&ac, (fujitsu_ac_remote_model_t)send.model, send.power, send.mode,
-              degC, send.fanspeed, send.swingv, send.swingh, send.quiet,
-              send.turbo, send.econo, send.filter, send.clean);
+      IRAC_OBJECT(IRFujitsuAC, ac, _pin, (fujitsu_ac_remote_model_t)send.model,
+                  _inverted, _modulation);
+      fujitsu(&ac, send);
       break;
     }
 #endif  // SEND_FUJITSU_AC
 #if SEND_GOODWEATHER
     case GOODWEATHER:
     {
-      IRGoodweatherAc ac(_pin, _inverted, _modulation);
-      goodweather(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                  send.turbo, send.light, send.sleep);
+      IRAC_OBJECT(IRGoodweatherAc, ac, _pin, _inverted, _modulation);
+      goodweather(&ac, send);
       break;
     }
 #endif  // SEND_GOODWEATHER
 #if SEND_GREE
     case GREE:
     {
-      IRGreeAC ac(_pin, (gree_ac_remote_model_t)send.model, _inverted,
-                  _modulation);
-      gree(&ac, (gree_ac_remote_model_t)send.model, send.power, send.mode,
-           send.celsius, send.degrees, send.fanspeed, send.swingv, send.turbo,
-           send.light, send.clean, send.sleep);
+      IRAC_OBJECT(IRGreeAC, ac, _pin, (gree_ac_remote_model_t)send.model,
+                  _inverted, _modulation);
+      gree(&ac, send);
       break;
     }
 #endif  // SEND_GREE
 #if SEND_HAIER_AC
     case HAIER_AC:
     {
-      IRHaierAC ac(_pin, _inverted, _modulation);
-      haier(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-            send.filter, send.sleep, send.clock);
+      IRAC_OBJECT(IRHaierAC, ac, _pin, _inverted, _modulation);
+      haier(&ac, send);
       break;
     }
 #endif  // SEND_HAIER_AC
 #if SEND_HAIER_AC_YRW02
     case HAIER_AC_YRW02:
     {
-      IRHaierACYRW02 ac(_pin, _inverted, _modulation);
-      haierYrwo2(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                 send.turbo, send.filter, send.sleep);
+      IRAC_OBJECT(IRHaierACYRW02, ac, _pin, _inverted, _modulation);
+      haierYrwo2(&ac, send, prev);
       break;
     }
 #endif  // SEND_HAIER_AC_YRW02
 #if SEND_HITACHI_AC
     case HITACHI_AC:
     {
-      IRHitachiAc ac(_pin, _inverted, _modulation);
-      hitachi(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-              send.swingh);
+      IRAC_OBJECT(IRHitachiAc, ac, _pin, _inverted, _modulation);
+      hitachi(&ac, send);
       break;
     }
 #endif  // SEND_HITACHI_AC
 #if SEND_HITACHI_AC1
     case HITACHI_AC1:
     {
-      IRHitachiAc1 ac(_pin, _inverted, _modulation);
-      bool power_toggle = false;
-      bool swing_toggle = false;
-      if (prev != NULL) {
-        power_toggle = (send.power != prev->power);
-        swing_toggle = (send.swingv != prev->swingv) ||
-                       (send.swingh != prev->swingh);
-      }
-      hitachi1(&ac, (hitachi_ac1_remote_model_t)send.model, send.power,
-               power_toggle, send.mode, degC, send.fanspeed, send.swingv,
-               send.swingh, swing_toggle, send.sleep);
+      IRAC_OBJECT(IRHitachiAc1, ac, _pin, _inverted, _modulation);
+      IRacTraits<HITACHI_AC1>::send(&ac, send, prev, _delta);
       break;
     }
 #endif  // SEND_HITACHI_AC1
 #if SEND_HITACHI_AC344
     case HITACHI_AC344:
     {
-      IRHitachiAc344 ac(_pin, _inverted, _modulation);
-      hitachi344(&ac, send.power, send.mode, degC, send.fanspeed,
-                 send.swingv, send.swingh);
+      IRAC_OBJECT(IRHitachiAc344, ac, _pin, _inverted, _modulation);
+      hitachi344(&ac, send);
       break;
     }
 #endif  // SEND_HITACHI_AC344
 #if SEND_HITACHI_AC424
     case HITACHI_AC424:
     {
-      IRHitachiAc424 ac(_pin, _inverted, _modulation);
-      hitachi424(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv);
+      IRAC_OBJECT(IRHitachiAc424, ac, _pin, _inverted, _modulation);
+      hitachi424(&ac, send);
       break;
     }
 #endif  // SEND_HITACHI_AC424
 #if SEND_KELVINATOR
     case KELVINATOR:
     {
-      IRKelvinatorAC ac(_pin, _inverted, _modulation);
-      kelvinator(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                 send.swingh, send.quiet, send.turbo, send.light, send.filter,
-                 send.clean);
+      IRAC_OBJECT(IRKelvinatorAC, ac, _pin, _inverted, _modulation);
+      kelvinator(&ac, send);
       break;
     }
 #endif  // SEND_KELVINATOR
@@ -2380,185 +2249,158 @@ bool IRac::sendAc(const stdAc::state_t desired, const stdAc::state_t *prev) {
     case LG:
     case LG2:
     {
-      IRLgAc ac(_pin, _inverted, _modulation);
-      lg(&ac, (lg_ac_remote_model_t)send.model, send.power, send.mode,
-         send.degrees, send.fanspeed);
+      IRAC_OBJECT(IRLgAc, ac, _pin, _inverted, _modulation);
+      lg(&ac, send);
       break;
     }
 #endif  // SEND_LG
 #if SEND_MIDEA
     case MIDEA:
     {
-      IRMideaAC ac(_pin, _inverted, _modulation);
-      midea(&ac, send.power, send.mode, send.celsius, send.degrees,
-            send.fanspeed, send.swingv, send.econo, send.sleep);
+      IRAC_OBJECT(IRMideaAC, ac, _pin, _inverted, _modulation);
+      midea(&ac, send);
       break;
     }
 #endif  // SEND_MIDEA
 #if SEND_MITSUBISHI_AC
     case MITSUBISHI_AC:
     {
-      IRMitsubishiAC ac(_pin, _inverted, _modulation);
-      mitsubishi(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-                 send.swingh, send.quiet, send.clock);
+      IRAC_OBJECT(IRMitsubishiAC, ac, _pin, _inverted, _modulation);
+      mitsubishi(&ac, send);
       break;
     }
 #endif  // SEND_MITSUBISHI_AC
 #if SEND_MITSUBISHI112
     case MITSUBISHI112:
     {
-      IRMitsubishi112 ac(_pin, _inverted, _modulation);
-      mitsubishi112(&ac, send.power, send.mode, degC, send.fanspeed,
-                    send.swingv, send.swingh, send.quiet);
+      IRAC_OBJECT(IRMitsubishi112, ac, _pin, _inverted, _modulation);
+      mitsubishi112(&ac, send);
       break;
     }
 #endif  // SEND_MITSUBISHI112
 #if SEND_MITSUBISHI136
     case MITSUBISHI136:
     {
-      IRMitsubishi136 ac(_pin, _inverted, _modulation);
-      mitsubishi136(&ac, send.power, send.mode, degC, send.fanspeed,
-                    send.swingv, send.quiet);
+      IRAC_OBJECT(IRMitsubishi136, ac, _pin, _inverted, _modulation);
+      mitsubishi136(&ac, send);
       break;
     }
 #endif  // SEND_MITSUBISHI136
 #if SEND_MITSUBISHIHEAVY
     case MITSUBISHI_HEAVY_88:
     {
-      IRMitsubishiHeavy88Ac ac(_pin, _inverted, _modulation);
-      mitsubishiHeavy88(&ac, send.power, send.mode, degC, send.fanspeed,
-                        send.swingv, send.swingh, send.turbo, send.econo,
-                        send.clean);
+      IRAC_OBJECT(IRMitsubishiHeavy88Ac, ac, _pin, _inverted, _modulation);
+      mitsubishiHeavy88(&ac, send);
       break;
     }
     case MITSUBISHI_HEAVY_152:
     {
-      IRMitsubishiHeavy152Ac ac(_pin, _inverted, _modulation);
-      mitsubishiHeavy152(&ac, send.power, send.mode, degC, send.fanspeed,
-                         send.swingv, send.swingh, send.quiet, send.turbo,
-                         send.econo, send.filter, send.clean, send.sleep);
+      IRAC_OBJECT(IRMitsubishiHeavy152Ac, ac, _pin, _inverted, _modulation);
+      mitsubishiHeavy152(&ac, send);
       break;
     }
 #endif  // SEND_MITSUBISHIHEAVY
 #if SEND_NEOCLIMA
     case NEOCLIMA:
     {
-      IRNeoclimaAc ac(_pin, _inverted, _modulation);
-      neoclima(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-               send.swingh, send.turbo, send.light, send.filter, send.sleep);
+      IRAC_OBJECT(IRNeoclimaAc, ac, _pin, _inverted, _modulation);
+      neoclima(&ac, send);
       break;
     }
 #endif  // SEND_NEOCLIMA
 #if SEND_PANASONIC_AC
     case PANASONIC_AC:
     {
-      IRPanasonicAc ac(_pin, _inverted, _modulation);
-      panasonic(&ac, (panasonic_ac_remote_model_t)send.model, send.power,
-                send.mode, degC, send.fanspeed, send.swingv, send.swingh,
-                send.quiet, send.turbo, send.clock);
+      IRAC_OBJECT(IRPanasonicAc, ac, _pin, _inverted, _modulation);
+      panasonic(&ac, send);
       break;
     }
 #endif  // SEND_PANASONIC_AC
 #if SEND_SAMSUNG_AC
     case SAMSUNG_AC:
     {
-      IRSamsungAc ac(_pin, _inverted, _modulation);
-      samsung(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-              send.quiet, send.turbo, send.light, send.filter, send.clean,
-              send.beep, prev->power);
+      IRAC_OBJECT(IRSamsungAc, ac, _pin, _inverted, _modulation);
+      IRacTraits<SAMSUNG_AC>::send(&ac, send, prev, _delta);
       break;
     }
 #endif  // SEND_SAMSUNG_AC
 #if SEND_SANYO_AC
     case SANYO_AC:
     {
-      IRSanyoAc ac(_pin, _inverted, _modulation);
-      sanyo(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-            send.beep, send.sleep);
+      IRAC_OBJECT(IRSanyoAc, ac, _pin, _inverted, _modulation);
+      sanyo(&ac, send);
       break;
     }
 #endif  // SEND_SANYO_AC
 #if SEND_SHARP_AC
     case SHARP_AC:
     {
-      IRSharpAc ac(_pin, _inverted, _modulation);
-      bool prev_power = !send.power;
-      if (prev != NULL) prev_power = prev->power;
-      sharp(&ac, send.power, prev_power, send.mode, degC, send.fanspeed,
-            send.swingv, send.turbo, send.filter, send.clean);
+      IRAC_OBJECT(IRSharpAc, ac, _pin, _inverted, _modulation);
+      IRacTraits<SHARP_AC>::send(&ac, send, prev, _delta);
       break;
     }
 #endif  // SEND_SHARP_AC
 #if SEND_TCL112AC
     case TCL112AC:
     {
-      IRTcl112Ac ac(_pin, _inverted, _modulation);
-      tcl112(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-             send.swingh, send.turbo, send.light, send.econo, send.filter);
+      IRAC_OBJECT(IRTcl112Ac, ac, _pin, _inverted, _modulation);
+      tcl112(&ac, send);
       break;
     }
 #endif  // SEND_TCL112AC
 #if SEND_TECHNIBEL_AC
     case TECHNIBEL_AC:
     {
-      IRTechnibelAc ac(_pin, _inverted, _modulation);
-      technibel(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-           send.sleep);
+      IRAC_OBJECT(IRTechnibelAc, ac, _pin, _inverted, _modulation);
+      technibel(&ac, send);
       break;
     }
 #endif  // SEND_TECHNIBEL_AC
 #if SEND_TECO
     case TECO:
     {
-      IRTecoAc ac(_pin, _inverted, _modulation);
-      teco(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-           send.light, send.sleep);
+      IRAC_OBJECT(IRTecoAc, ac, _pin, _inverted, _modulation);
+      teco(&ac, send);
       break;
     }
 #endif  // SEND_TECO
 #if SEND_TOSHIBA_AC
     case TOSHIBA_AC:
     {
-      IRToshibaAC ac(_pin, _inverted, _modulation);
-      toshiba(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-              send.turbo, send.econo);
+      IRAC_OBJECT(IRToshibaAC, ac, _pin, _inverted, _modulation);
+      IRacTraits<TOSHIBA_AC>::send(&ac, send, prev, _delta);
       break;
     }
 #endif  // SEND_TOSHIBA_AC
 #if SEND_TROTEC
     case TROTEC:
     {
-      IRTrotecESP ac(_pin, _inverted, _modulation);
-      trotec(&ac, send.power, send.mode, degC, send.fanspeed, send.sleep);
+      IRAC_OBJECT(IRTrotecESP, ac, _pin, _inverted, _modulation);
+      trotec(&ac, send);
       break;
     }
 #endif  // SEND_TROTEC
 #if SEND_VESTEL_AC
     case VESTEL_AC:
     {
-      IRVestelAc ac(_pin, _inverted, _modulation);
-      vestel(&ac, send.power, send.mode, degC, send.fanspeed, send.swingv,
-             send.turbo, send.filter, send.sleep, send.clock);
+      IRAC_OBJECT(IRVestelAc, ac, _pin, _inverted, _modulation);
+      IRacTraits<VESTEL_AC>::send(&ac, send, prev, _delta);
       break;
     }
 #endif  // SEND_VESTEL_AC
 #if SEND_VOLTAS
     case VOLTAS:
     {
-      IRVoltas ac(_pin, _inverted, _modulation);
-      voltas(&ac, (voltas_ac_remote_model_t)send.model, send.power, send.mode,
-             degC, send.fanspeed, send.swingv, send.swingh, send.turbo,
-             send.econo, send.light, send.sleep);
+      IRAC_OBJECT(IRVoltas, ac, _pin, _inverted, _modulation);
+      voltas(&ac, send);
       break;
     }
 #endif  // SEND_VOLTAS
 #if SEND_WHIRLPOOL_AC
     case WHIRLPOOL_AC:
     {
-      IRWhirlpoolAc ac(_pin, _inverted, _modulation);
-      whirlpool(&ac, (whirlpool_ac_remote_model_t)send.model, send.power,
-                send.mode, degC, send.fanspeed, send.swingv, send.turbo,
-                send.light, send.sleep, send.clock);
+      IRAC_OBJECT(IRWhirlpoolAc, ac, _pin, _inverted, _modulation);
+      whirlpool(&ac, send);
       break;
     }
 #endif  // SEND_WHIRLPOOL_AC
@@ -2568,16 +2410,298 @@ bool IRac::sendAc(const stdAc::state_t desired, const stdAc::state_t *prev) {
   return true;  // Success.
 }
 
+#if ENABLE_IRAC_FRAME_CACHE
+/// Remember the messages `sendAc()` sends, & resend them directly the next
+/// time the same state is asked for. i.e. Skip all of the per protocol work
+/// of working out what to send. It uses an `IRsequence` per message kept.
+/// @param[in] size The max. nr. of messages to remember. When it is full, the
+///   least recently used one is forgotten.
+/// @return true, if the cache could be allocated. Otherwise false.
+/// @note Messages with more than `kIRacFrameCacheMaxLength` marks & spaces
+///   are just sent normally.
+bool IRac::enableFrameCache(const uint8_t size) {
+  disableFrameCache();
+  if (!size) return false;
+  _frames = new irac_frame_t[size];
+  if (_frames == NULL) return false;
+  for (uint8_t i = 0; i < size; i++) {
+    _frames[i].hash = 0;
+    _frames[i].frame = NULL;
+  }
+  _frames_size = size;
+  return true;
+}
+
+/// Forget all of the remembered messages, & stop remembering them.
+/// See `enableFrameCache()`.
+void IRac::disableFrameCache(void) {
+  if (_frames != NULL) {
+    for (uint8_t i = 0; i < _frames_size; i++) delete _frames[i].frame;
+    delete[] _frames;
+  }
+  _frames = NULL;
+  _frames_size = 0;
+  _frames_clock = 0;
+  _frame_hits = 0;
+  _frame_misses = 0;
+}
+
+/// Nr. of `sendAc()` calls that were sent from the frame cache.
+/// @return The nr. since `enableFrameCache()`.
+uint32_t IRac::getFrameCacheHits(void) { return _frame_hits; }
+
+/// Nr. of `sendAc()` calls that weren't in the frame cache.
+/// @return The nr. since `enableFrameCache()`.
+uint32_t IRac::getFrameCacheMisses(void) { return _frame_misses; }
+
+/// Fill out what a frame cache entry is remembered by.
+/// @param[out] frame The entry.
+/// @param[in] send The state_t to send. i.e. From `handleToggles()`.
+/// @param[in] prev A Ptr to the previous state_t, if any.
+/// @note Only the parts of `prev` some protocols use directly are included.
+static void frameKey(irac_frame_t *frame, const stdAc::state_t &send,
+                     const stdAc::state_t *prev) {
+  frame->key = send;
+  frame->has_prev = (prev != NULL);
+  frame->prev_power = (prev != NULL) ? prev->power : false;
+  frame->prev_swingv = (prev != NULL) ? prev->swingv : stdAc::swingv_t::kOff;
+  frame->prev_swingh = (prev != NULL) ? prev->swingh : stdAc::swingh_t::kOff;
+  // A FNV-1a hash of it all, so most entries are rejected cheaply.
+  const int32_t fields[] = {
+      send.protocol, send.model, send.power, (int32_t)send.mode,
+      (int32_t)(send.degrees * 10), send.celsius, (int32_t)send.fanspeed,
+      (int32_t)send.swingv, (int32_t)send.swingh, send.quiet, send.turbo,
+      send.econo, send.light, send.filter, send.clean, send.beep, send.sleep,
+      send.clock, frame->has_prev, frame->prev_power,
+      (int32_t)frame->prev_swingv, (int32_t)frame->prev_swingh};
+  uint32_t hash = 2166136261UL;
+  for (uint8_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+    hash ^= (uint32_t)fields[i];
+    hash *= 16777619UL;
+  }
+  frame->hash = hash ? hash : 1;  // 0 means the entry is unused.
+}
+
+/// Do two frame cache entries have the same key?
+/// @param[in] a An entry.
+/// @param[in] b Another entry.
+/// @return true, if they do. Otherwise false.
+static bool sameFrameKey(const irac_frame_t *a, const irac_frame_t *b) {
+  return a->hash == b->hash && !IRac::cmpStates(a->key, b->key) &&
+      a->key.clock == b->key.clock && a->has_prev == b->has_prev &&
+      a->prev_power == b->prev_power && a->prev_swingv == b->prev_swingv &&
+      a->prev_swingh == b->prev_swingh;
+}
+
+/// Find a message in the frame cache, & mark it as used.
+/// @param[in] wanted The key of the message. See `frameKey()`.
+/// @return A Ptr to the message, or NULL if it isn't there.
+IRsequence *IRac::_findFrame(const irac_frame_t &wanted) {
+  for (uint8_t i = 0; i < _frames_size; i++)
+    if (sameFrameKey(&_frames[i], &wanted)) {
+      _frames[i].used = ++_frames_clock;
+      return _frames[i].frame;
+    }
+  return NULL;
+}
+
+/// Remember a copy of a message in the frame cache. In an unused entry, or
+/// else in place of the least recently used one.
+/// @param[in] wanted The key of the message. See `frameKey()`.
+/// @param[in] recording The message.
+void IRac::_storeFrame(const irac_frame_t &wanted,
+                       const IRsequence *recording) {
+  uint8_t victim = 0;
+  for (uint8_t i = 1; i < _frames_size && _frames[victim].hash; i++)
+    if (!_frames[i].hash || _frames[i].used < _frames[victim].used)
+      victim = i;
+  // Keep a copy that is only as big as it needs to be.
+  IRsequence *frame = new IRsequence(recording->length());
+  if (frame != NULL && frame->set(recording->durations(), recording->length(),
+                                  recording->frequency(),
+                                  recording->dutyCycle())) {
+    delete _frames[victim].frame;
+    _frames[victim] = wanted;
+    _frames[victim].frame = frame;
+    _frames[victim].used = ++_frames_clock;
+  } else {
+    delete frame;
+  }
+}
+
+/// Send A/C message via the frame cache. See `enableFrameCache()`.
+/// @param[in] send The state_t to send. i.e. From `handleToggles()`.
+/// @param[in] prev A Ptr to the state_t structure containing the previous state
+/// @return True, if accepted/converted/attempted etc. False, if unsupported.
+bool IRac::_sendCachedAc(const stdAc::state_t &send,
+                         const stdAc::state_t *prev) {
+  irac_frame_t wanted;
+  frameKey(&wanted, send, prev);
+  const IRsequence *found = _findFrame(wanted);
+  if (found != NULL) {  // Seen it before.
+    _frame_hits++;
+    _irsend.begin();
+    _irsend.sendSequence(found);
+    return true;
+  }
+  _frame_misses++;
+  // Work out what to send, by recording what the protocol class would send.
+  IRsequence *recording = new IRsequence(kIRacFrameCacheMaxLength);
+  if (recording == NULL || !recording->size()) {
+    delete recording;
+    return _sendAc(send, prev);
+  }
+  IRsend::startRecordingAll(recording);
+  const bool success = _sendAc(send, prev);
+  const bool recorded = IRsend::stopRecordingAll();
+  if (!success) {
+    delete recording;
+    return false;
+  }
+  if (!recorded) {  // Too long, or nothing to remember. Send it normally.
+    delete recording;
+    return _sendAc(send, prev);
+  }
+  _storeFrame(wanted, recording);
+  _irsend.begin();
+  _irsend.sendSequence(recording);
+  delete recording;
+  return true;
+}
+#endif  // ENABLE_IRAC_FRAME_CACHE
+
+/// Work out what `sendAc()` would send for a state, without sending it.
+/// i.e. A dry run. The state is cleaned up & has its toggles applied the same
+/// way, & the message the protocol would send is recorded rather than sent.
+/// Nothing else is changed. e.g. `next`, the previous state, or what duplicate
+/// suppression knows. Use it to check a state can be sent, off the hot path,
+/// or to compute the messages of likely states ahead of time. e.g. At boot,
+/// or when idle. If the frame cache is enabled (See `enableFrameCache()`), the
+/// message is remembered in it, so a later `sendAc()` of the same state sends
+/// it straight away.
+/// @param[in] desired The state_t structure describing the desired new ac state
+/// @param[out] frame Where to put the marks, spaces & carrier of the message.
+///   (See `IRsend::sendSequence()`) NULL if it isn't wanted.
+/// @param[in] prev A Ptr to the state_t structure containing the previous state
+/// @return true, if the state can be sent, & its message fit in `frame`.
+///   Otherwise false.
+/// @code
+///   // Ready the likely states, so they are sent without delay.
+///   irac.enableFrameCache(8);
+///   for (int8_t degrees = 20; degrees <= 26; degrees++) {
+///     state.degrees = degrees;
+///     irac.encodeAc(state, NULL, &state);
+///   }
+/// @endcode
+bool IRac::encodeAc(const stdAc::state_t &desired, IRsequence *frame,
+                    const stdAc::state_t *prev) {
+  stdAc::state_t send = desired;
+  _cleanState(&send);
+  _handleToggles(&send, prev);
+  // Somewhere to record it, even if it isn't wanted, so it isn't sent.
+  IRsequence *recording = frame;
+  if (recording == NULL) recording = new IRsequence(kIRacFrameCacheMaxLength);
+  if (recording == NULL || !recording->size()) {
+    if (recording != frame) delete recording;
+    return false;
+  }
+  IRsend::startRecordingAll(recording);
+  const bool delta = _delta && _sendDeltaAc(send, prev);
+  const bool success = delta || _sendAc(send, prev);
+  const bool recorded = IRsend::stopRecordingAll();
+#if ENABLE_IRAC_FRAME_CACHE
+  // As `sendAc()` would remember it.
+  if (success && recorded && !delta && _frames != NULL &&
+      !needsWholePrev(send, prev, _delta)) {
+    irac_frame_t wanted;
+    frameKey(&wanted, send, prev);
+    if (_findFrame(wanted) == NULL) _storeFrame(wanted, recording);
+  }
+#endif  // ENABLE_IRAC_FRAME_CACHE
+  if (recording != frame) delete recording;
+  return success && recorded;
+}
+
 /// Update the previous state to the current one.
 void IRac::markAsSent(void) {
   _prev = next;
 }
 
+/// Set if `sendAc()` should send only the short message(s) for what has
+/// changed from the previous state, rather than the full state, when the
+/// protocol has them. e.g. Toggling the swing of a Fujitsu or Toshiba A/C, or
+/// turning on a Fujitsu's Powerful mode. It also leaves out the separate swing
+/// message a Toshiba A/C normally sends, if the swing hasn't changed, & only
+/// sends a Vestel A/C's settings or time message if that one changed. A
+/// Samsung A/C's extended power message is only sent if the power changed.
+/// This cuts the time spent transmitting, & thus collisions with other IR
+/// devices nearby.
+/// @param[in] on true, to send only the change where possible. Default: false.
+/// @note It is only used when `sendAc()` is given a previous state, & the A/C
+///   is, & stays, on.
+void IRac::setDeltaSend(const bool on) { _delta = on; }
+
+/// Is `sendAc()` sending only what has changed, when it can?
+/// @return true, if it does. Otherwise false.
+bool IRac::getDeltaSend(void) { return _delta; }
+
+/// Set if `sendAc()` should send the separate messages a protocol needs as one
+/// burst, with only the protocol's minimum gap between them, rather than each
+/// followed by its full message gap. e.g. A Coolix A/C's swing, turbo, sleep,
+/// light & clean commands, & then its state.
+/// @param[in] on true, to send them as one burst. Default: false.
+/// @note Some A/Cs may miss a message that follows too closely after another.
+void IRac::setBurstSend(const bool on) { _burst = on; }
+
+/// Is `sendAc()` sending a protocol's separate messages as one burst?
+/// @return true, if it does. Otherwise false.
+bool IRac::getBurstSend(void) { return _burst; }
+
+/// Set if `sendAc()` (with no arguments) should not send a state that the A/C
+/// should already be in. i.e. `next` is the same as what was last sent.
+/// @param[in] on true, to not send such states. Default: false.
+/// @param[in] reassert Send it anyway if nothing has been sent for this many
+///   milliseconds. e.g. In case the A/C missed a message. 0 means never.
+/// @param[in] hysteresis Temperature changes smaller than this (in the units
+///   of the state) don't count as a change. 0 means any change counts.
+/// @note A suppressed send still returns true. The state the A/C is expected
+///   to be in isn't updated, so small temperature changes can add up.
+void IRac::setSuppressDuplicates(const bool on, const uint32_t reassert,
+                                 const float hysteresis) {
+  _suppress = on;
+  _reassert = reassert;
+  _hysteresis = (hysteresis > 0) ? hysteresis : 0;
+}
+
+/// Is `sendAc()` suppressing states the A/C should already be in?
+/// @return true, if it is. Otherwise false.
+bool IRac::getSuppressDuplicates(void) { return _suppress; }
+
+/// Nr. of times `sendAc()` didn't send a state, as it was a duplicate.
+/// @return The nr. since the IRac object was created.
+uint32_t IRac::getSuppressedCount(void) { return _suppressed; }
+
 /// Send an A/C message based soley on our internal state.
 /// @return True, if accepted/converted/attempted. False, if unsupported.
 bool IRac::sendAc(void) {
+  if (_suppress && (!_reassert || _since_sent.elapsed() < _reassert)) {
+    stdAc::state_t desired = next;
+    stdAc::state_t expected = _prev;
+    _cleanState(&desired);
+    _cleanState(&expected);
+    const float change = desired.degrees - expected.degrees;
+    if (change < _hysteresis && -change < _hysteresis)
+      desired.degrees = expected.degrees;
+    if (!cmpStates(desired, expected)) {
+      _suppressed++;
+      return true;
+    }
+  }
   bool success = this->sendAc(next, &_prev);
-  if (success) this->markAsSent();
+  if (success) {
+    this->markAsSent();
+    _since_sent.reset();
+  }
   return success;
 }
 
@@ -2586,7 +2710,7 @@ bool IRac::sendAc(void) {
 /// @param a A state_t to be compared.
 /// @param b A state_t to be compared.
 /// @return True if they differ, False if they don't.
-bool IRac::cmpStates(const stdAc::state_t a, const stdAc::state_t b) {
+bool IRac::cmpStates(const stdAc::state_t &a, const stdAc::state_t &b) {
   return a.protocol != b.protocol || a.model != b.model || a.power != b.power ||
       a.mode != b.mode || a.degrees != b.degrees || a.celsius != b.celsius ||
       a.fanspeed != b.fanspeed || a.swingv != b.swingv ||
@@ -2824,17 +2948,18 @@ bool IRac::strToBool(const char *str, const bool def) {
     return def;
 }
 
-/// Convert the supplied boolean into the appropriate String.
+/// @cond IGNORE
+/// Convert the supplied boolean into the appropriate text.
 /// @param[in] value The boolean value to be converted.
-/// @return The equivilent String for the locale.
-String IRac::boolToString(const bool value) {
+/// @return A ptr to the equivilent text for the locale.
+static const char *boolToChars(const bool value) {
   return value ? kOnStr : kOffStr;
 }
 
-/// Convert the supplied operation mode into the appropriate String.
+/// Convert the supplied operation mode into the appropriate text.
 /// @param[in] mode The enum to be converted.
-/// @return The equivilent String for the locale.
-String IRac::opmodeToString(const stdAc::opmode_t mode) {
+/// @return A ptr to the equivilent text for the locale.
+static const char *opmodeToChars(const stdAc::opmode_t mode) {
   switch (mode) {
     case stdAc::opmode_t::kOff:
       return kOffStr;
@@ -2853,10 +2978,10 @@ String IRac::opmodeToString(const stdAc::opmode_t mode) {
   }
 }
 
-/// Convert the supplied fan speed enum into the appropriate String.
+/// Convert the supplied fan speed enum into the appropriate text.
 /// @param[in] speed The enum to be converted.
-/// @return The equivilent String for the locale.
-String IRac::fanspeedToString(const stdAc::fanspeed_t speed) {
+/// @return A ptr to the equivilent text for the locale.
+static const char *fanspeedToChars(const stdAc::fanspeed_t speed) {
   switch (speed) {
     case stdAc::fanspeed_t::kAuto:
       return kAutoStr;
@@ -2875,10 +3000,10 @@ String IRac::fanspeedToString(const stdAc::fanspeed_t speed) {
   }
 }
 
-/// Convert the supplied enum into the appropriate String.
+/// Convert the supplied enum into the appropriate text.
 /// @param[in] swingv The enum to be converted.
-/// @return The equivilent String for the locale.
-String IRac::swingvToString(const stdAc::swingv_t swingv) {
+/// @return A ptr to the equivilent text for the locale.
+static const char *swingvToChars(const stdAc::swingv_t swingv) {
   switch (swingv) {
     case stdAc::swingv_t::kOff:
       return kOffStr;
@@ -2899,10 +3024,10 @@ String IRac::swingvToString(const stdAc::swingv_t swingv) {
   }
 }
 
-/// Convert the supplied enum into the appropriate String.
+/// Convert the supplied enum into the appropriate text.
 /// @param[in] swingh The enum to be converted.
-/// @return The equivilent String for the locale.
-String IRac::swinghToString(const stdAc::swingh_t swingh) {
+/// @return A ptr to the equivilent text for the locale.
+static const char *swinghToChars(const stdAc::swingh_t swingh) {
   switch (swingh) {
     case stdAc::swingh_t::kOff:
       return kOffStr;
@@ -2924,746 +3049,1056 @@ String IRac::swinghToString(const stdAc::swingh_t swingh) {
       return kUnknownStr;
   }
 }
+/// @endcond
 
-namespace IRAcUtils {
-  /// Display the human readable state of an A/C message if we can.
-  /// @param[in] result A Ptr to the captured `decode_results` that contains an
-  ///   A/C mesg.
-  /// @return A string with the human description of the A/C message.
-  ///   An empty string if we can't.
-  String resultAcToString(const decode_results * const result) {
-    switch (result->decode_type) {
-#if DECODE_AIRWELL
-      case decode_type_t::AIRWELL: {
-        IRAirwellAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // AIRWELL uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_AIRWELL
-#if DECODE_AMCOR
-      case decode_type_t::AMCOR: {
-        IRAmcorAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_AMCOR
-#if DECODE_ARGO
-      case decode_type_t::ARGO: {
-        IRArgoAC ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_ARGO
-#if DECODE_CARRIER_AC64
-      case decode_type_t::CARRIER_AC64: {
-        IRCarrierAc64 ac(kGpioUnused);
-        ac.setRaw(result->value);  // CARRIER_AC64 uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_CARRIER_AC64
-#if DECODE_DAIKIN
-      case decode_type_t::DAIKIN: {
-        IRDaikinESP ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN
-#if DECODE_DAIKIN128
-      case decode_type_t::DAIKIN128: {
-        IRDaikin128 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN128
-#if DECODE_DAIKIN152
-      case decode_type_t::DAIKIN152: {
-        IRDaikin152 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN152
-#if DECODE_DAIKIN160
-      case decode_type_t::DAIKIN160: {
-        IRDaikin160 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN160
-#if DECODE_DAIKIN176
-      case decode_type_t::DAIKIN176: {
-        IRDaikin176 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN160
-#if DECODE_DAIKIN2
-      case decode_type_t::DAIKIN2: {
-        IRDaikin2 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN2
-#if DECODE_DAIKIN216
-      case decode_type_t::DAIKIN216: {
-        IRDaikin216 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN216
-#if DECODE_DAIKIN64
-      case decode_type_t::DAIKIN64: {
-        IRDaikin64 ac(kGpioUnused);
-        ac.setRaw(result->value);  // Daikin64 uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_DAIKIN64
-#if DECODE_DELONGHI_AC
-      case decode_type_t::DELONGHI_AC: {
-        IRDelonghiAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // DelonghiAc uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_DELONGHI_AC
-#if DECODE_ELECTRA_AC
-      case decode_type_t::ELECTRA_AC: {
-        IRElectraAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_ELECTRA_AC
-#if DECODE_FUJITSU_AC
-      case decode_type_t::FUJITSU_AC: {
-        IRFujitsuAC ac(kGpioUnused);
-        ac.setRaw(result->state, result->bits / 8);
-        return ac.toString();
-      }
-#endif  // DECODE_FUJITSU_AC
-#if DECODE_KELVINATOR
-      case decode_type_t::KELVINATOR: {
-        IRKelvinatorAC ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_KELVINATOR
-#if DECODE_MITSUBISHI_AC
-      case decode_type_t::MITSUBISHI_AC: {
-        IRMitsubishiAC ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_MITSUBISHI_AC
-#if DECODE_MITSUBISHI112
-      case decode_type_t::MITSUBISHI112: {
-        IRMitsubishi112 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_MITSUBISHI112
-#if DECODE_MITSUBISHI136
-      case decode_type_t::MITSUBISHI136: {
-        IRMitsubishi136 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_MITSUBISHI136
-#if DECODE_MITSUBISHIHEAVY
-      case decode_type_t::MITSUBISHI_HEAVY_88: {
-        IRMitsubishiHeavy88Ac ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-      case decode_type_t::MITSUBISHI_HEAVY_152: {
-        IRMitsubishiHeavy152Ac ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_MITSUBISHIHEAVY
-#if DECODE_NEOCLIMA
-      case decode_type_t::NEOCLIMA: {
-        IRNeoclimaAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_NEOCLIMA
-#if DECODE_TOSHIBA_AC
-      case decode_type_t::TOSHIBA_AC: {
-        IRToshibaAC ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_TOSHIBA_AC
-#if DECODE_TROTEC
-      case decode_type_t::TROTEC: {
-        IRTrotecESP ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_TROTEC
-#if DECODE_GOODWEATHER
-      case decode_type_t::GOODWEATHER: {
-        IRGoodweatherAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // Goodweather uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_GOODWEATHER
-#if DECODE_GREE
-      case decode_type_t::GREE: {
-        IRGreeAC ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_GREE
-#if DECODE_MIDEA
-      case decode_type_t::MIDEA: {
-        IRMideaAC ac(kGpioUnused);
-        ac.setRaw(result->value);  // Midea uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_MIDEA
-#if DECODE_HAIER_AC
-      case decode_type_t::HAIER_AC: {
-        IRHaierAC ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_HAIER_AC
-#if DECODE_HAIER_AC_YRW02
-      case decode_type_t::HAIER_AC_YRW02: {
-        IRHaierACYRW02 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_HAIER_AC_YRW02
-#if DECODE_SAMSUNG_AC
-      case decode_type_t::SAMSUNG_AC: {
-        IRSamsungAc ac(kGpioUnused);
-        ac.setRaw(result->state, result->bits / 8);
-        return ac.toString();
-      }
-#endif  // DECODE_SAMSUNG_AC
-#if DECODE_SANYO_AC
-      case decode_type_t::SANYO_AC: {
-        IRSanyoAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_SANYO_AC
-#if DECODE_SHARP_AC
-      case decode_type_t::SHARP_AC: {
-        IRSharpAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
+/// Convert the supplied boolean into the appropriate String.
+/// @param[in] value The boolean value to be converted.
+/// @return The equivilent String for the locale.
+String IRac::boolToString(const bool value) { return boolToChars(value); }
+
+/// Convert the supplied enum into the appropriate String.
+/// @param[in] mode The enum to be converted.
+/// @return The equivilent String for the locale.
+String IRac::opmodeToString(const stdAc::opmode_t mode) {
+  return opmodeToChars(mode);
+}
+
+/// Convert the supplied enum into the appropriate String.
+/// @param[in] speed The enum to be converted.
+/// @return The equivilent String for the locale.
+String IRac::fanspeedToString(const stdAc::fanspeed_t speed) {
+  return fanspeedToChars(speed);
+}
+
+/// Convert the supplied enum into the appropriate String.
+/// @param[in] swingv The enum to be converted.
+/// @return The equivilent String for the locale.
+String IRac::swingvToString(const stdAc::swingv_t swingv) {
+  return swingvToChars(swingv);
+}
+
+/// Convert the supplied enum into the appropriate String.
+/// @param[in] swingh The enum to be converted.
+/// @return The equivilent String for the locale.
+String IRac::swinghToString(const stdAc::swingh_t swingh) {
+  return swinghToChars(swingh);
+}
+
+/// @cond IGNORE
+// Layout of the 64 bits after the version byte of a binary state.
+// Values that can be -1 are stored plus one.
+const uint8_t kStateBinProtocolOffset = 0;
+const uint8_t kStateBinProtocolSize = 8;  // + 1
+const uint8_t kStateBinModelOffset = 8;
+const uint8_t kStateBinModelSize = 5;  // + 1
+const uint8_t kStateBinPowerOffset = 13;
+const uint8_t kStateBinModeOffset = 14;
+const uint8_t kStateBinModeSize = 3;  // + 1
+const uint8_t kStateBinDegreesOffset = 17;
+const uint8_t kStateBinDegreesSize = 8;  // Half degrees.
+const uint8_t kStateBinCelsiusOffset = 25;
+const uint8_t kStateBinFanOffset = 26;
+const uint8_t kStateBinFanSize = 3;
+const uint8_t kStateBinSwingVOffset = 29;
+const uint8_t kStateBinSwingVSize = 3;  // + 1
+const uint8_t kStateBinSwingHOffset = 32;
+const uint8_t kStateBinSwingHSize = 3;  // + 1
+const uint8_t kStateBinQuietOffset = 35;
+const uint8_t kStateBinTurboOffset = 36;
+const uint8_t kStateBinEconoOffset = 37;
+const uint8_t kStateBinLightOffset = 38;
+const uint8_t kStateBinFilterOffset = 39;
+const uint8_t kStateBinCleanOffset = 40;
+const uint8_t kStateBinBeepOffset = 41;
+const uint8_t kStateBinSleepOffset = 42;
+const uint8_t kStateBinSleepSize = 11;  // + 1
+const uint8_t kStateBinClockOffset = 53;
+const uint8_t kStateBinClockSize = 11;  // + 1
+/// @endcond
+
+/// Pack a state into 64 bits. i.e. The binary form, less its version byte.
+/// @param[in] state The state to pack.
+/// @param[out] bits Where to store the bits.
+/// @return true, if it was packed. false, if a setting is out of the range
+///   the bits can hold. See `stateToBinary()`.
+bool IRac::_packState(const stdAc::state_t &state, uint64_t *bits) {
+  const int32_t half_degrees = state.degrees * 2 + 0.5;
+  if ((int32_t)state.protocol + 1 > (1 << kStateBinProtocolSize) - 1 ||
+      state.protocol < decode_type_t::UNKNOWN ||
+      state.model + 1 > (1 << kStateBinModelSize) - 1 || state.model < -1 ||
+      (int8_t)state.mode < -1 ||
+      state.mode > stdAc::opmode_t::kLastOpmodeEnum ||
+      half_degrees < 0 || half_degrees > (1 << kStateBinDegreesSize) - 1 ||
+      (int8_t)state.fanspeed < 0 ||
+      state.fanspeed > stdAc::fanspeed_t::kLastFanspeedEnum ||
+      (int8_t)state.swingv < -1 ||
+      state.swingv > stdAc::swingv_t::kLastSwingvEnum ||
+      (int8_t)state.swingh < -1 ||
+      state.swingh > stdAc::swingh_t::kLastSwinghEnum ||
+      state.sleep < -1 || state.sleep + 1 > (1 << kStateBinSleepSize) - 1 ||
+      state.clock < -1 || state.clock + 1 > (1 << kStateBinClockSize) - 1)
+    return false;
+  *bits = 0;
+  setBits(bits, kStateBinProtocolOffset, kStateBinProtocolSize,
+          state.protocol + 1);
+  setBits(bits, kStateBinModelOffset, kStateBinModelSize, state.model + 1);
+  setBit(bits, kStateBinPowerOffset, state.power);
+  setBits(bits, kStateBinModeOffset, kStateBinModeSize,
+          (int8_t)state.mode + 1);
+  setBits(bits, kStateBinDegreesOffset, kStateBinDegreesSize, half_degrees);
+  setBit(bits, kStateBinCelsiusOffset, state.celsius);
+  setBits(bits, kStateBinFanOffset, kStateBinFanSize,
+          (int8_t)state.fanspeed);
+  setBits(bits, kStateBinSwingVOffset, kStateBinSwingVSize,
+          (int8_t)state.swingv + 1);
+  setBits(bits, kStateBinSwingHOffset, kStateBinSwingHSize,
+          (int8_t)state.swingh + 1);
+  setBit(bits, kStateBinQuietOffset, state.quiet);
+  setBit(bits, kStateBinTurboOffset, state.turbo);
+  setBit(bits, kStateBinEconoOffset, state.econo);
+  setBit(bits, kStateBinLightOffset, state.light);
+  setBit(bits, kStateBinFilterOffset, state.filter);
+  setBit(bits, kStateBinCleanOffset, state.clean);
+  setBit(bits, kStateBinBeepOffset, state.beep);
+  setBits(bits, kStateBinSleepOffset, kStateBinSleepSize, state.sleep + 1);
+  setBits(bits, kStateBinClockOffset, kStateBinClockSize, state.clock + 1);
+  return true;
+}
+
+/// Unpack a state from 64 bits. See `_packState()`.
+/// @param[in] bits The packed state.
+/// @param[out] state Where to store the state.
+/// @return true, if it was valid & unpacked. Otherwise false, & `state` is
+///   unchanged.
+bool IRac::_unpackState(const uint64_t bits, stdAc::state_t *state) {
+  stdAc::state_t result;
+  result.protocol = (decode_type_t)((int16_t)GETBITS64(
+      bits, kStateBinProtocolOffset, kStateBinProtocolSize) - 1);
+  result.model = (int16_t)GETBITS64(bits, kStateBinModelOffset,
+                                    kStateBinModelSize) - 1;
+  result.power = GETBIT64(bits, kStateBinPowerOffset);
+  result.mode = (stdAc::opmode_t)((int8_t)GETBITS64(
+      bits, kStateBinModeOffset, kStateBinModeSize) - 1);
+  result.degrees = GETBITS64(bits, kStateBinDegreesOffset,
+                             kStateBinDegreesSize) / 2.0;
+  result.celsius = GETBIT64(bits, kStateBinCelsiusOffset);
+  result.fanspeed = (stdAc::fanspeed_t)GETBITS64(bits, kStateBinFanOffset,
+                                                 kStateBinFanSize);
+  result.swingv = (stdAc::swingv_t)((int8_t)GETBITS64(
+      bits, kStateBinSwingVOffset, kStateBinSwingVSize) - 1);
+  result.swingh = (stdAc::swingh_t)((int8_t)GETBITS64(
+      bits, kStateBinSwingHOffset, kStateBinSwingHSize) - 1);
+  result.quiet = GETBIT64(bits, kStateBinQuietOffset);
+  result.turbo = GETBIT64(bits, kStateBinTurboOffset);
+  result.econo = GETBIT64(bits, kStateBinEconoOffset);
+  result.light = GETBIT64(bits, kStateBinLightOffset);
+  result.filter = GETBIT64(bits, kStateBinFilterOffset);
+  result.clean = GETBIT64(bits, kStateBinCleanOffset);
+  result.beep = GETBIT64(bits, kStateBinBeepOffset);
+  result.sleep = (int16_t)GETBITS64(bits, kStateBinSleepOffset,
+                                    kStateBinSleepSize) - 1;
+  result.clock = (int16_t)GETBITS64(bits, kStateBinClockOffset,
+                                    kStateBinClockSize) - 1;
+  if (result.protocol > kLastDecodeType ||
+      result.mode > stdAc::opmode_t::kLastOpmodeEnum ||
+      result.fanspeed > stdAc::fanspeed_t::kLastFanspeedEnum ||
+      result.swingv > stdAc::swingv_t::kLastSwingvEnum ||
+      result.swingh > stdAc::swingh_t::kLastSwinghEnum) return false;
+  *state = result;
+  return true;
+}
+
+/// Convert a state into a compact, fixed size, binary form. e.g. To store it,
+/// or send it to another device.
+/// @param[in] state The state to convert.
+/// @param[out] data Where to store the `kIRacStateBinaryLength` bytes of it.
+/// @return true, if it was converted. false, if a setting is out of the range
+///   the format can hold. e.g. A model > 30, or a sleep/clock value > 2046.
+/// @note The temperature is kept to the nearest half degree.
+/// @see binaryToState(), stateToBase64()
+bool IRac::stateToBinary(const stdAc::state_t &state, uint8_t *data) {
+  uint64_t bits;
+  if (data == NULL || !_packState(state, &bits)) return false;
+  data[0] = kIRacStateBinaryVersion;
+  for (uint8_t i = 1; i < kIRacStateBinaryLength; i++, bits >>= 8)
+    data[i] = bits;  // Least significant byte first.
+  return true;
+}
+
+/// Convert the binary form of a state back into a state.
+/// @param[in] data The binary form. See `stateToBinary()`.
+/// @param[in] length The nr. of bytes of `data`.
+/// @param[out] state Where to store the state.
+/// @return true, if it was valid & converted. Otherwise false, & `state` is
+///   unchanged.
+bool IRac::binaryToState(const uint8_t *data, const uint16_t length,
+                         stdAc::state_t *state) {
+  if (data == NULL || state == NULL || length != kIRacStateBinaryLength ||
+      data[0] != kIRacStateBinaryVersion) return false;
+  uint64_t bits = 0;
+  for (uint8_t i = kIRacStateBinaryLength - 1; i > 0; i--)
+    bits = (bits << 8) | data[i];
+  return _unpackState(bits, state);
+}
+
+/// Convert a state into a short base64 string. e.g. For a MQTT message.
+/// i.e. Its binary form (See `stateToBinary()`) in base64.
+/// @param[in] state The state to convert.
+/// @return The string, or an empty string if it can't be converted.
+String IRac::stateToBase64(const stdAc::state_t &state) {
+  uint8_t data[kIRacStateBinaryLength];
+  if (!stateToBinary(state, data)) return "";
+  return irutils::base64Encode(data, kIRacStateBinaryLength);
+}
+
+/// Convert a base64 string made by `stateToBase64()` back into a state.
+/// @param[in] str The C string to convert.
+/// @param[out] state Where to store the state.
+/// @return true, if it was valid & converted. Otherwise false, & `state` is
+///   unchanged.
+bool IRac::base64ToState(const char *str, stdAc::state_t *state) {
+  uint8_t data[kIRacStateBinaryLength];
+  const int32_t length = irutils::base64Decode(str, data,
+                                               kIRacStateBinaryLength);
+  return length >= 0 && binaryToState(data, length, state);
+}
+
+/// @cond IGNORE
+// The keys used by `IRac::stateToJson()`. Compatible with IRMQTTServer's.
+const char kJsonAcProtocolKey[] = "protocol";
+const char kJsonAcModelKey[] = "model";
+const char kJsonAcPowerKey[] = "power";
+const char kJsonAcModeKey[] = "mode";
+const char kJsonAcCelsiusKey[] = "use_celsius";
+const char kJsonAcTempKey[] = "temp";
+const char kJsonAcFanspeedKey[] = "fanspeed";
+const char kJsonAcSwingVKey[] = "swingv";
+const char kJsonAcSwingHKey[] = "swingh";
+const char kJsonAcQuietKey[] = "quiet";
+const char kJsonAcTurboKey[] = "turbo";
+const char kJsonAcEconoKey[] = "econo";
+const char kJsonAcLightKey[] = "light";
+const char kJsonAcFilterKey[] = "filter";
+const char kJsonAcCleanKey[] = "clean";
+const char kJsonAcBeepKey[] = "beep";
+const char kJsonAcSleepKey[] = "sleep";
+
+// Write the settings of a state as a JSON object.
+static void addStateJson(irutils::JsonWriter *json,
+                         const stdAc::state_t &state) {
+  json->begin();
+  json->add(kJsonAcProtocolKey, typeToChars(state.protocol));
+  json->add(kJsonAcModelKey, (int32_t)state.model);
+  json->add(kJsonAcPowerKey, boolToChars(state.power));
+  json->add(kJsonAcModeKey, opmodeToChars(state.mode));
+  json->add(kJsonAcCelsiusKey, boolToChars(state.celsius));
+  json->add(kJsonAcTempKey, state.degrees);
+  json->add(kJsonAcFanspeedKey, fanspeedToChars(state.fanspeed));
+  json->add(kJsonAcSwingVKey, swingvToChars(state.swingv));
+  json->add(kJsonAcSwingHKey, swinghToChars(state.swingh));
+  json->add(kJsonAcQuietKey, boolToChars(state.quiet));
+  json->add(kJsonAcTurboKey, boolToChars(state.turbo));
+  json->add(kJsonAcEconoKey, boolToChars(state.econo));
+  json->add(kJsonAcLightKey, boolToChars(state.light));
+  json->add(kJsonAcFilterKey, boolToChars(state.filter));
+  json->add(kJsonAcCleanKey, boolToChars(state.clean));
+  json->add(kJsonAcBeepKey, boolToChars(state.beep));
+  json->add(kJsonAcSleepKey, (int32_t)state.sleep);
+  json->end();
+}
+/// @endcond
+
+/// Serialise the settings of a state as a JSON object, into a caller supplied
+/// buffer. i.e. No heap memory is used.
+/// The values are the same text `opmodeToString()` etc. produce, and the keys
+/// are the same as IRMQTTServer's.
+/// @param[in] state The state to be serialised.
+/// @param[out] output A ptr to the buffer to store the NUL terminated result.
+/// @param[in] size The size of the `output` buffer in bytes.
+///   `kIRacStateJsonSize` should be big enough.
+/// @return The length of the JSON stored, or 0 if it didn't fit.
+uint16_t IRac::stateToJson(const stdAc::state_t &state, char *output,
+                           const uint16_t size) {
+  irutils::JsonWriter json(output, size);
+  addStateJson(&json, state);
+  return json.overflowed() ? 0 : json.length();
+}
+
+#ifdef ARDUINO
+/// Print the settings of a state as a JSON object.
+/// i.e. The same as the other `stateToJson()`, but straight to a stream.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] state The state to be serialised.
+void IRac::stateToJson(Print *output, const stdAc::state_t &state) {
+  irutils::JsonWriter json(output);
+  addStateJson(&json, state);
+}
+#endif  // ARDUINO
+
+/// Constructor for an IRacBatch object.
+/// @param[in] size Nr. of messages that can wait to be sent.
+/// @param[in] frame_size The max. nr. of marks & spaces a message can have.
+///   See `IRsequence`.
+/// @note Each waiting message uses ~2 bytes per mark & space of RAM.
+IRacBatch::IRacBatch(const uint8_t size, const uint16_t frame_size) {
+  _entries = new irac_batch_entry_t[size];
+  _size = (_entries != NULL) ? size : 0;
+  for (uint8_t i = 0; i < _size; i++) _entries[i].frame = NULL;
+  _scratch = new IRsequence(frame_size);
+  _emitter_count = 0;
+  _order = 0;
+  _gap = 0;
+}
+
+/// Destructor for an IRacBatch object.
+IRacBatch::~IRacBatch(void) {
+  clear();
+  delete[] _entries;
+  delete _scratch;
+  for (uint8_t i = 0; i < _emitter_count; i++) {
+    _emitters[i].irsend->~irac_batch_send_t();
+    free(_emitters[i].irsend);
+  }
+}
+
+/// Compute the message to put an A/C in a new state, & add it to the batch.
+/// The A/C is treated as if it was sent. i.e. Its `next` & the state it is
+/// expected to be in are updated, & the message is based on the latter.
+/// @param[in,out] ac A Ptr to the IRac object of the A/C.
+/// @param[in] state The state it should be in.
+/// @return true, if it was added. false if the batch is full, the A/C's
+///   message couldn't be computed or didn't fit, or there are too many GPIOs.
+bool IRacBatch::add(IRac *ac, const stdAc::state_t &state) {
+  if (ac == NULL || _scratch == NULL) return false;
+  irac_batch_entry_t *entry = NULL;
+  for (uint8_t i = 0; i < _size && entry == NULL; i++)
+    if (_entries[i].frame == NULL) entry = &_entries[i];
+  if (entry == NULL) return false;
+  const int8_t emitter = _findEmitter(ac);
+  if (emitter < 0) return false;
+  IRsend::startRecordingAll(_scratch);
+  const bool success = ac->sendAc(state, &ac->_prev);
+  if (!IRsend::stopRecordingAll() || !success) return false;
+  IRsequence *frame = new IRsequence(_scratch->length());
+  if (frame == NULL || !frame->set(_scratch->durations(), _scratch->length(),
+                                   _scratch->frequency(),
+                                   _scratch->dutyCycle())) {
+    delete frame;
+    return false;
+  }
+  ac->next = state;
+  ac->markAsSent();
+  entry->frame = frame;
+  entry->emitter = emitter;
+  entry->order = _order++;
+  return true;
+}
+
+/// Send the next message of each GPIO, if it is time to.
+/// i.e. The previous message from it has been sent, & the gap after it has
+/// passed. Call it often. e.g. From `loop()`.
+/// @return true, if a message was sent (or started). Otherwise false.
+/// @note Every GPIO whose `IRsend` can send in the background (See
+///   `IRsend::enableRmtSend()` or `enableTimerSend()`) is started at once.
+///   Otherwise only one message is sent per call, & it returns once it has
+///   been.
+bool IRacBatch::handle(void) {
+  bool sent = false;
+  for (uint8_t n = 0; n < _emitter_count; n++) {
+    irac_batch_emitter_t *emitter = &_emitters[n];
+    if (emitter->since.elapsed() < emitter->wait) continue;
+#if IRSEND_ASYNC
+    if (emitter->irsend->isBusy()) continue;
+#endif  // IRSEND_ASYNC
+    irac_batch_entry_t *entry = _next(n);
+    if (entry == NULL) continue;
+    emitter->wait = _gap;
+#if IRSEND_ASYNC
+    if (emitter->irsend->beginAsync()) {
+      emitter->irsend->sendSequence(entry->frame);
+      if (emitter->irsend->sendAsync()) {
+        // It is sent in the background, so its length is part of the wait.
+        const uint16_t *durations = entry->frame->durations();
+        for (uint16_t i = 0; i < entry->frame->length(); i++)
+          emitter->wait += durations[i];
+        emitter->since.reset();
+        delete entry->frame;
+        entry->frame = NULL;
+        sent = true;
+        continue;
       }
-#endif  // DECODE_SHARP_AC
+    }
+#endif  // IRSEND_ASYNC
+    emitter->irsend->sendSequence(entry->frame);
+    emitter->since.reset();
+    delete entry->frame;
+    entry->frame = NULL;
+    return true;  // Don't hold up the caller any longer.
+  }
+  return sent;
+}
+
+/// Get the nr. of messages waiting to be sent.
+/// @return The nr. of messages.
+uint8_t IRacBatch::pending(void) {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < _size; i++)
+    if (_entries[i].frame != NULL) count++;
+  return count;
+}
+
+/// Forget every message that is waiting to be sent.
+void IRacBatch::clear(void) {
+  for (uint8_t i = 0; i < _size; i++) {
+    delete _entries[i].frame;
+    _entries[i].frame = NULL;
+  }
+}
+
+/// Set the time to wait between messages from the same GPIO, in addition to
+/// the gap the protocol of a message already ends with.
+/// @param[in] usecs Nr. of microseconds. 0 (the default) for none.
+void IRacBatch::setGap(const uint32_t usecs) { _gap = usecs; }
+
+/// Get the extra time between messages from the same GPIO. See `setGap()`.
+/// @return Nr. of microseconds.
+uint32_t IRacBatch::getGap(void) { return _gap; }
+
+/// Get the `IRsend` object a GPIO's messages are sent with. e.g. To call its
+/// `enableRmtSend()` so they are sent in the background.
+/// @param[in] pin The GPIO.
+/// @return A Ptr to it, or NULL if no A/C on that GPIO has been added yet.
+IRsend *IRacBatch::getEmitter(const uint16_t pin) {
+  for (uint8_t i = 0; i < _emitter_count; i++)
+    if (_emitters[i].pin == pin) return _emitters[i].irsend;
+  return NULL;
+}
+
+/// Find (or add) the emitter for the GPIO of an A/C.
+/// @param[in] ac A Ptr to the IRac object of the A/C.
+/// @return The index of it in `_emitters`, or -1 if there are too many.
+int8_t IRacBatch::_findEmitter(const IRac *ac) {
+  for (uint8_t i = 0; i < _emitter_count; i++)
+    if (_emitters[i].pin == ac->_pin) return i;
+  if (_emitter_count >= kIRacBatchMaxEmitters) return -1;
+  irac_batch_emitter_t *emitter = &_emitters[_emitter_count];
+  void *memory = malloc(sizeof(irac_batch_send_t));
+  if (memory == NULL) return -1;
+  emitter->irsend = new (memory) irac_batch_send_t(ac->_pin, ac->_inverted,
+                                                    ac->_modulation);
+  emitter->irsend->begin();
+  emitter->pin = ac->_pin;
+  emitter->wait = 0;
+  return _emitter_count++;
+}
+
+/// Find the message an emitter should send next. i.e. Its oldest.
+/// @param[in] emitter The index of the emitter.
+/// @return A Ptr to the entry, or NULL if it has none waiting.
+irac_batch_entry_t *IRacBatch::_next(const uint8_t emitter) {
+  irac_batch_entry_t *next = NULL;
+  for (uint8_t i = 0; i < _size; i++) {
+    irac_batch_entry_t *entry = &_entries[i];
+    if (entry->frame == NULL || entry->emitter != emitter) continue;
+    if (next == NULL || (int32_t)(entry->order - next->order) < 0)
+      next = entry;
+  }
+  return next;
+}
+
+/// Constructor for an IRacPackedState object.
+/// i.e. The state of `IRac::initState()`.
+IRacPackedState::IRacPackedState(void) {
+  stdAc::state_t state;
+  IRac::initState(&state);
+  IRac::_packState(state, &_bits);
+}
+
+/// Constructor for an IRacPackedState object.
+/// @param[in] state The state to hold. See `set()`.
+IRacPackedState::IRacPackedState(const stdAc::state_t &state) {
+  stdAc::state_t init;
+  IRac::initState(&init);
+  IRac::_packState(init, &_bits);
+  set(state);
+}
+
+/// Set the state it holds.
+/// @param[in] state The state.
+/// @return true, if it was set. false, if a setting is out of the range it
+///   can hold (See `IRac::stateToBinary()`), & the state is unchanged.
+bool IRacPackedState::set(const stdAc::state_t &state) {
+  return IRac::_packState(state, &_bits);
+}
+
+/// Get the state it holds.
+/// @return A copy of it.
+stdAc::state_t IRacPackedState::get(void) {
+  stdAc::state_t state;
+  IRac::initState(&state);  // Only if the bits were somehow corrupted.
+  IRac::_unpackState(_bits, &state);
+  return state;
+}
+
+/// Is it the same state as another? i.e. Every setting, including the clock.
+bool IRacPackedState::operator==(const IRacPackedState &other) const {
+  return _bits == other._bits;
+}
+
+/// Is it a different state to another? See `operator==`.
+bool IRacPackedState::operator!=(const IRacPackedState &other) const {
+  return _bits != other._bits;
+}
+
+/// Constructor for an IRacEngine object.
+/// @param[in] inverted true, gpio output defaults to high. false, to low.
+/// @param[in] use_modulation true means use frequency modulation.
+/// @param[in] frame_size The max. nr. of marks & spaces a message can have.
+///   See `IRsequence`.
+/// @note It uses ~2 bytes per mark & space of RAM, to compute the messages in.
+IRacEngine::IRacEngine(const bool inverted, const bool use_modulation,
+                       const uint16_t frame_size) : ac(kGpioUnused) {
+  _scratch = new IRsequence(frame_size);
+  _emitter_count = 0;
+  _inverted = inverted;
+  _modulation = use_modulation;
+}
+
+/// Destructor for an IRacEngine object.
+IRacEngine::~IRacEngine(void) {
+  delete _scratch;
+  for (uint8_t i = 0; i < _emitter_count; i++) {
+    _emitters[i]->~irac_batch_send_t();
+    free(_emitters[i]);
+  }
+}
+
+/// Send an A/C message from a GPIO, based on the desired state & the
+/// previous one. i.e. As `IRac::sendAc()` would, if it used that GPIO.
+/// @param[in] pin The GPIO to send it from.
+/// @param[in] desired The state_t we want the device to be in.
+/// @param[in] prev A Ptr to the state_t we believe the device is in, if any.
+/// @return true, if it was sent. false, if it is unsupported, didn't fit, or
+///   there are too many GPIOs.
+bool IRacEngine::sendAc(const uint16_t pin, const stdAc::state_t &desired,
+                        const stdAc::state_t *prev) {
+  IRsend *emitter = getEmitter(pin);
+  if (emitter == NULL || _scratch == NULL) return false;
+  IRsend::startRecordingAll(_scratch);
+  const bool success = ac.sendAc(desired, prev);
+  if (!IRsend::stopRecordingAll() || !success) return false;
+  emitter->sendSequence(_scratch);
+  return true;
+}
+
+/// Get (or add) the `IRsend` object a GPIO's messages are sent with.
+/// e.g. To call its `enableRmtSend()`.
+/// @param[in] pin The GPIO.
+/// @return A Ptr to it, or NULL if there are too many GPIOs.
+IRsend *IRacEngine::getEmitter(const uint16_t pin) {
+  for (uint8_t i = 0; i < _emitter_count; i++)
+    if (_pins[i] == pin) return _emitters[i];
+  if (_emitter_count >= kIRacEngineMaxEmitters) return NULL;
+  void *memory = malloc(sizeof(irac_batch_send_t));
+  if (memory == NULL) return NULL;
+  irac_batch_send_t *emitter = new (memory) irac_batch_send_t(pin, _inverted,
+                                                               _modulation);
+  emitter->begin();
+  _emitters[_emitter_count] = emitter;
+  _pins[_emitter_count++] = pin;
+  return emitter;
+}
+
+/// Constructor for an IRacChannel object.
+/// @param[in] engine A Ptr to the IRacEngine that computes & sends its
+///   messages.
+/// @param[in] pin The GPIO its messages are sent from.
+IRacChannel::IRacChannel(IRacEngine *engine, const uint16_t pin) {
+  _engine = engine;
+  _pin = pin;
+}
+
+/// Set the state we want the A/C to be in. i.e. `IRac::next`.
+/// @param[in] state The state.
+/// @return true, if it was set. false, if a setting is out of the range an
+///   `IRacPackedState` can hold, & it is unchanged.
+bool IRacChannel::setState(const stdAc::state_t &state) {
+  return _next.set(state);
+}
+
+/// Get the state we want the A/C to be in.
+/// @return A copy of it.
+stdAc::state_t IRacChannel::getState(void) { return _next.get(); }
+
+/// Get the state that should have already been sent to the A/C.
+/// @return A copy of it.
+stdAc::state_t IRacChannel::getStatePrev(void) { return _prev.get(); }
+
+/// Is the state we want the A/C to be in different to what was last sent?
+/// @return true, if it is. Otherwise false.
+bool IRacChannel::hasStateChanged(void) {
+  return IRac::cmpStates(_next.get(), _prev.get());
+}
+
+/// Update the previous state to the current one.
+void IRacChannel::markAsSent(void) { _prev = _next; }
+
+/// Send the state we want the A/C to be in, based on what was last sent, &
+/// remember it as sent if it was.
+/// @return true, if it was sent. Otherwise false. See `IRacEngine::sendAc()`.
+bool IRacChannel::sendAc(void) {
+  if (_engine == NULL) return false;
+  const stdAc::state_t prev = _prev.get();
+  if (!_engine->sendAc(_pin, _next.get(), &prev)) return false;
+  markAsSent();
+  return true;
+}
+
+/// Set the state we want the A/C to be in, & send it.
+/// @param[in] desired The state.
+/// @return true, if it was set & sent. Otherwise false.
+bool IRacChannel::sendAc(const stdAc::state_t &desired) {
+  return setState(desired) && sendAc();
+}
+
+namespace IRAcUtils {
+/// @cond IGNORE
+// Ways a captured message is loaded into an A/C object, depending on how the
+// A/C class stores its state.
+struct RawState {
+  template <typename AC>
+  static void load(AC *ac, const decode_results * const decode) {
+    ac->setRaw(decode->state);
+  }
+};
+
+struct RawSized {
+  template <typename AC>
+  static void load(AC *ac, const decode_results * const decode) {
+    ac->setRaw(decode->state, decode->bits / 8);
+  }
+};
+
+struct RawValue {  // Like Coolix, use value instead of state.
+  template <typename AC>
+  static void load(AC *ac, const decode_results * const decode) {
+    ac->setRaw(decode->value);
+  }
+};
+
+template <typename AC, typename RAW>
+String acToString(const decode_results * const decode) {
+  AC ac(kGpioUnused);
+  RAW::load(&ac, decode);
+  return ac.toString();
+}
+
+template <typename AC, typename RAW>
+bool acToCommon(const decode_results * const decode, stdAc::state_t *result,
+                const stdAc::state_t *) {
+  AC ac(kGpioUnused);
+  RAW::load(&ac, decode);
+  *result = ac.toCommon();
+  return true;
+}
+
+template <typename AC, typename RAW>
+bool acToCommonPrev(const decode_results * const decode,
+                    stdAc::state_t *result, const stdAc::state_t *prev) {
+  AC ac(kGpioUnused);
+  RAW::load(&ac, decode);
+  *result = ac.toCommon(prev);
+  return true;
+}
+
 #if DECODE_COOLIX
-      case decode_type_t::COOLIX: {
-        IRCoolixAC ac(kGpioUnused);
-        ac.on();
-        ac.setRaw(result->value);  // Coolix uses value instead of state.
-        return ac.toString();
-      }
+String coolixToString(const decode_results * const decode) {
+  IRCoolixAC ac(kGpioUnused);
+  ac.on();
+  ac.setRaw(decode->value);  // Coolix uses value instead of state.
+  return ac.toString();
+}
 #endif  // DECODE_COOLIX
-#if DECODE_CORONA_AC
-      case decode_type_t::CORONA_AC: {
-        IRCoronaAc ac(kGpioUnused);
-        ac.setRaw(result->state, result->bits / 8);
-        return ac.toString();
-      }
-#endif  // DECODE_CORONA_AC
+
 #if DECODE_PANASONIC_AC
-      case decode_type_t::PANASONIC_AC: {
-        if (result->bits > kPanasonicAcShortBits) {
-          IRPanasonicAc ac(kGpioUnused);
-          ac.setRaw(result->state);
-          return ac.toString();
-        }
-        return "";
-      }
+String panasonicToString(const decode_results * const decode) {
+  if (decode->bits <= kPanasonicAcShortBits) return "";
+  return acToString<IRPanasonicAc, RawState>(decode);
+}
 #endif  // DECODE_PANASONIC_AC
-#if DECODE_HITACHI_AC
-      case decode_type_t::HITACHI_AC: {
-        IRHitachiAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_HITACHI_AC
-#if DECODE_HITACHI_AC1
-      case decode_type_t::HITACHI_AC1: {
-        IRHitachiAc1 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_HITACHI_AC1
-#if DECODE_HITACHI_AC344
-      case decode_type_t::HITACHI_AC344: {
-        IRHitachiAc344 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_HITACHI_AC344
-#if DECODE_HITACHI_AC424
-      case decode_type_t::HITACHI_AC424: {
-        IRHitachiAc424 ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_HITACHI_AC424
-#if DECODE_WHIRLPOOL_AC
-      case decode_type_t::WHIRLPOOL_AC: {
-        IRWhirlpoolAc ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_WHIRLPOOL_AC
-#if DECODE_VESTEL_AC
-      case decode_type_t::VESTEL_AC: {
-        IRVestelAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // Like Coolix, use value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_VESTEL_AC
-#if DECODE_TECHNIBEL_AC
-      case decode_type_t::TECHNIBEL_AC: {
-        IRTechnibelAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // TechnibelAc uses value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_TECHNIBEL_AC
-#if DECODE_VOLTAS
-      case decode_type_t::VOLTAS: {
-        IRVoltas ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_VOLTAS
-#if DECODE_TECO
-      case decode_type_t::TECO: {
-        IRTecoAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // Like Coolix, use value instead of state.
-        return ac.toString();
-      }
-#endif  // DECODE_TECO
-#if DECODE_TCL112AC
-      case decode_type_t::TCL112AC: {
-        IRTcl112Ac ac(kGpioUnused);
-        ac.setRaw(result->state);
-        return ac.toString();
-      }
-#endif  // DECODE_TCL112AC
+
 #if DECODE_LG
-      case decode_type_t::LG:
-      case decode_type_t::LG2: {
-        IRLgAc ac(kGpioUnused);
-        ac.setRaw(result->value);  // Like Coolix, use value instead of state.
-        switch (result->decode_type) {
-          case decode_type_t::LG2:
-            ac.setModel(lg_ac_remote_model_t::AKB75215403);
-            break;
-          default:
-            ac.setModel(lg_ac_remote_model_t::GE6711AR2853M);
-        }
-        return ac.isValidLgAc() ? ac.toString() : "";
-      }
-#endif  // DECODE_LG
+struct RawLg {
+  static void load(IRLgAc *ac, const decode_results * const decode) {
+    ac->setRaw(decode->value);  // Like Coolix, use value instead of state.
+    switch (decode->decode_type) {
+      case decode_type_t::LG2:
+        ac->setModel(lg_ac_remote_model_t::AKB75215403);
+        break;
       default:
-        return "";
+        ac->setModel(lg_ac_remote_model_t::GE6711AR2853M);
     }
   }
+};
 
-  /// Convert a valid IR A/C remote message that we understand enough into a
-  /// Common A/C state.
-  /// @param[in] decode A PTR to a successful raw IR decode object.
-  /// @param[in] result A PTR to a state structure to store the result in.
-  /// @param[in] prev A PTR to a state structure which has the prev. state.
-  /// @return A boolean indicating success or failure.
-  bool decodeToState(const decode_results *decode, stdAc::state_t *result,
-                     const stdAc::state_t *prev
-/// @cond IGNORE
-// *prev flagged as "unused" due to potential compiler warning when some
-// protocols that use it are disabled. It really is used.
-                                                __attribute__((unused))
-/// @endcond
-                    ) {
-    if (decode == NULL || result == NULL) return false;  // Safety check.
-    switch (decode->decode_type) {
-#if DECODE_AIRWELL
-      case decode_type_t::AIRWELL: {
-        IRAirwellAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_AIRWELL
-#if DECODE_AMCOR
-      case decode_type_t::AMCOR: {
-        IRAmcorAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_AMCOR
-#if DECODE_ARGO
-      case decode_type_t::ARGO: {
-        IRArgoAC ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_ARGO
-#if DECODE_COOLIX
-      case decode_type_t::COOLIX: {
-        IRCoolixAC ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon(prev);
-        break;
-      }
-#endif  // DECODE_COOLIX
-#if DECODE_CORONA_AC
-      case decode_type_t::CORONA_AC: {
-        IRCoronaAc ac(kGpioUnused);
-        ac.setRaw(decode->state, decode->bits / 8);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_CARRIER_AC64
-#if DECODE_CARRIER_AC64
-      case decode_type_t::CARRIER_AC64: {
-        IRCarrierAc64 ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_CARRIER_AC64
+String lgToString(const decode_results * const decode) {
+  IRLgAc ac(kGpioUnused);
+  RawLg::load(&ac, decode);
+  return ac.isValidLgAc() ? ac.toString() : "";
+}
+
+bool lgToCommon(const decode_results * const decode, stdAc::state_t *result,
+                const stdAc::state_t *) {
+  IRLgAc ac(kGpioUnused);
+  RawLg::load(&ac, decode);
+  if (!ac.isValidLgAc()) return false;
+  *result = ac.toCommon();
+  return true;
+}
+#endif  // DECODE_LG
+
+// How to describe & convert each A/C protocol we can decode.
+typedef struct {
+  decode_type_t protocol;
+  String (*toString)(const decode_results * const decode);
+  bool (*toCommon)(const decode_results * const decode,
+                   stdAc::state_t *result, const stdAc::state_t *prev);
+} irac_decoder_t;
+
+// The table of decodable A/C protocols. It MUST be sorted by `protocol` value
+// (i.e. the order of `decode_type_t`) as it is binary searched.
+// The leading UNKNOWN entry keeps the table non-empty if every A/C decoder is
+// disabled.
+const irac_decoder_t kDecoders[] PROGMEM = {
+  {decode_type_t::UNKNOWN, NULL, NULL},
+#if DECODE_LG
+  {decode_type_t::LG, lgToString, lgToCommon},
+#endif  // DECODE_LG
+#if DECODE_COOLIX
+  {decode_type_t::COOLIX, coolixToString, acToCommonPrev<IRCoolixAC, RawValue>},
+#endif  // DECODE_COOLIX
 #if DECODE_DAIKIN
-      case decode_type_t::DAIKIN: {
-        IRDaikinESP ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::DAIKIN, acToString<IRDaikinESP, RawState>,
+   acToCommon<IRDaikinESP, RawState>},
 #endif  // DECODE_DAIKIN
-#if DECODE_DAIKIN128
-      case decode_type_t::DAIKIN128: {
-        IRDaikin128 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DAIKIN128
-#if DECODE_DAIKIN152
-      case decode_type_t::DAIKIN152: {
-        IRDaikin152 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DAIKIN152
-#if DECODE_DAIKIN160
-      case decode_type_t::DAIKIN160: {
-        IRDaikin160 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DAIKIN160
-#if DECODE_DAIKIN176
-      case decode_type_t::DAIKIN176: {
-        IRDaikin176 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DAIKIN160
-#if DECODE_DAIKIN2
-      case decode_type_t::DAIKIN2: {
-        IRDaikin2 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DAIKIN2
-#if DECODE_DAIKIN216
-      case decode_type_t::DAIKIN216: {
-        IRDaikin216 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DAIKIN216
-#if DECODE_DAIKIN64
-      case decode_type_t::DAIKIN64: {
-        IRDaikin64 ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon(prev);
-        break;
-      }
-#endif  // DECODE_DAIKIN64
-#if DECODE_DELONGHI_AC
-      case decode_type_t::DELONGHI_AC: {
-        IRDelonghiAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_DELONGHI_AC
-#if DECODE_ELECTRA_AC
-      case decode_type_t::ELECTRA_AC: {
-        IRElectraAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_ELECTRA_AC
-#if DECODE_FUJITSU_AC
-      case decode_type_t::FUJITSU_AC: {
-        IRFujitsuAC ac(kGpioUnused);
-        ac.setRaw(decode->state, decode->bits / 8);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_FUJITSU_AC
-#if DECODE_GOODWEATHER
-      case decode_type_t::GOODWEATHER: {
-        IRGoodweatherAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_GOODWEATHER
+#if DECODE_KELVINATOR
+  {decode_type_t::KELVINATOR, acToString<IRKelvinatorAC, RawState>,
+   acToCommon<IRKelvinatorAC, RawState>},
+#endif  // DECODE_KELVINATOR
+#if DECODE_MITSUBISHI_AC
+  {decode_type_t::MITSUBISHI_AC, acToString<IRMitsubishiAC, RawState>,
+   acToCommon<IRMitsubishiAC, RawState>},
+#endif  // DECODE_MITSUBISHI_AC
 #if DECODE_GREE
-      case decode_type_t::GREE: {
-        IRGreeAC ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::GREE, acToString<IRGreeAC, RawState>,
+   acToCommon<IRGreeAC, RawState>},
 #endif  // DECODE_GREE
+#if DECODE_ARGO
+  {decode_type_t::ARGO, acToString<IRArgoAC, RawState>,
+   acToCommon<IRArgoAC, RawState>},
+#endif  // DECODE_ARGO
+#if DECODE_TROTEC
+  {decode_type_t::TROTEC, acToString<IRTrotecESP, RawState>,
+   acToCommon<IRTrotecESP, RawState>},
+#endif  // DECODE_TROTEC
+#if DECODE_TOSHIBA_AC
+  {decode_type_t::TOSHIBA_AC, acToString<IRToshibaAC, RawState>,
+   acToCommon<IRToshibaAC, RawState>},
+#endif  // DECODE_TOSHIBA_AC
+#if DECODE_FUJITSU_AC
+  {decode_type_t::FUJITSU_AC, acToString<IRFujitsuAC, RawSized>,
+   acToCommon<IRFujitsuAC, RawSized>},
+#endif  // DECODE_FUJITSU_AC
+#if DECODE_MIDEA
+  {decode_type_t::MIDEA, acToString<IRMideaAC, RawValue>,
+   acToCommonPrev<IRMideaAC, RawValue>},
+#endif  // DECODE_MIDEA
 #if DECODE_HAIER_AC
-      case decode_type_t::HAIER_AC: {
-        IRHaierAC ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::HAIER_AC, acToString<IRHaierAC, RawState>,
+   acToCommon<IRHaierAC, RawState>},
 #endif  // DECODE_HAIER_AC
-#if DECODE_HAIER_AC_YRW02
-      case decode_type_t::HAIER_AC_YRW02: {
-        IRHaierACYRW02 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_HAIER_AC_YRW02
 #if (DECODE_HITACHI_AC || DECODE_HITACHI_AC2)
-      case decode_type_t::HITACHI_AC: {
-        IRHitachiAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::HITACHI_AC, acToString<IRHitachiAc, RawState>,
+   acToCommon<IRHitachiAc, RawState>},
 #endif  // (DECODE_HITACHI_AC || DECODE_HITACHI_AC2)
 #if DECODE_HITACHI_AC1
-      case decode_type_t::HITACHI_AC1: {
-        IRHitachiAc1 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::HITACHI_AC1, acToString<IRHitachiAc1, RawState>,
+   acToCommon<IRHitachiAc1, RawState>},
 #endif  // DECODE_HITACHI_AC1
-#if DECODE_HITACHI_AC344
-      case decode_type_t::HITACHI_AC344: {
-        IRHitachiAc344 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_HITACHI_AC344
-#if DECODE_HITACHI_AC424
-      case decode_type_t::HITACHI_AC424: {
-        IRHitachiAc424 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_HITACHI_AC424
-#if DECODE_KELVINATOR
-      case decode_type_t::KELVINATOR: {
-        IRKelvinatorAC ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_KELVINATOR
+#if DECODE_HAIER_AC_YRW02
+  {decode_type_t::HAIER_AC_YRW02, acToString<IRHaierACYRW02, RawState>,
+   acToCommon<IRHaierACYRW02, RawState>},
+#endif  // DECODE_HAIER_AC_YRW02
+#if DECODE_WHIRLPOOL_AC
+  {decode_type_t::WHIRLPOOL_AC, acToString<IRWhirlpoolAc, RawState>,
+   acToCommon<IRWhirlpoolAc, RawState>},
+#endif  // DECODE_WHIRLPOOL_AC
+#if DECODE_SAMSUNG_AC
+  {decode_type_t::SAMSUNG_AC, acToString<IRSamsungAc, RawSized>,
+   acToCommon<IRSamsungAc, RawState>},
+#endif  // DECODE_SAMSUNG_AC
+#if DECODE_ELECTRA_AC
+  {decode_type_t::ELECTRA_AC, acToString<IRElectraAc, RawState>,
+   acToCommon<IRElectraAc, RawState>},
+#endif  // DECODE_ELECTRA_AC
+#if DECODE_PANASONIC_AC
+  {decode_type_t::PANASONIC_AC, panasonicToString,
+   acToCommon<IRPanasonicAc, RawState>},
+#endif  // DECODE_PANASONIC_AC
 #if DECODE_LG
-      case decode_type_t::LG:
-      case decode_type_t::LG2: {
-        IRLgAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        if (!ac.isValidLgAc()) return false;
-        switch (decode->decode_type) {
-          case decode_type_t::LG2:
-            ac.setModel(lg_ac_remote_model_t::AKB75215403);
-            break;
-          default:
-            ac.setModel(lg_ac_remote_model_t::GE6711AR2853M);
-        }
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::LG2, lgToString, lgToCommon},
 #endif  // DECODE_LG
-#if DECODE_MIDEA
-      case decode_type_t::MIDEA: {
-        IRMideaAC ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon(prev);
-        break;
-      }
-#endif  // DECODE_MIDEA
-#if DECODE_MITSUBISHI_AC
-      case decode_type_t::MITSUBISHI_AC: {
-        IRMitsubishiAC ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_MITSUBISHI_AC
-#if DECODE_MITSUBISHI112
-      case decode_type_t::MITSUBISHI112: {
-        IRMitsubishi112 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_MITSUBISHI112
-#if DECODE_MITSUBISHI136
-      case decode_type_t::MITSUBISHI136: {
-        IRMitsubishi136 ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_MITSUBISHI136
+#if DECODE_DAIKIN2
+  {decode_type_t::DAIKIN2, acToString<IRDaikin2, RawState>,
+   acToCommon<IRDaikin2, RawState>},
+#endif  // DECODE_DAIKIN2
+#if DECODE_VESTEL_AC
+  {decode_type_t::VESTEL_AC, acToString<IRVestelAc, RawValue>,
+   acToCommon<IRVestelAc, RawValue>},
+#endif  // DECODE_VESTEL_AC
+#if DECODE_TECO
+  {decode_type_t::TECO, acToString<IRTecoAc, RawValue>,
+   acToCommon<IRTecoAc, RawValue>},
+#endif  // DECODE_TECO
+#if DECODE_TCL112AC
+  {decode_type_t::TCL112AC, acToString<IRTcl112Ac, RawState>,
+   acToCommon<IRTcl112Ac, RawState>},
+#endif  // DECODE_TCL112AC
 #if DECODE_MITSUBISHIHEAVY
-      case decode_type_t::MITSUBISHI_HEAVY_88: {
-        IRMitsubishiHeavy88Ac ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-      case decode_type_t::MITSUBISHI_HEAVY_152: {
-        IRMitsubishiHeavy152Ac ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::MITSUBISHI_HEAVY_88,
+   acToString<IRMitsubishiHeavy88Ac, RawState>,
+   acToCommon<IRMitsubishiHeavy88Ac, RawState>},
 #endif  // DECODE_MITSUBISHIHEAVY
+#if DECODE_MITSUBISHIHEAVY
+  {decode_type_t::MITSUBISHI_HEAVY_152,
+   acToString<IRMitsubishiHeavy152Ac, RawState>,
+   acToCommon<IRMitsubishiHeavy152Ac, RawState>},
+#endif  // DECODE_MITSUBISHIHEAVY
+#if DECODE_DAIKIN216
+  {decode_type_t::DAIKIN216, acToString<IRDaikin216, RawState>,
+   acToCommon<IRDaikin216, RawState>},
+#endif  // DECODE_DAIKIN216
+#if DECODE_SHARP_AC
+  {decode_type_t::SHARP_AC, acToString<IRSharpAc, RawState>,
+   acToCommon<IRSharpAc, RawState>},
+#endif  // DECODE_SHARP_AC
+#if DECODE_GOODWEATHER
+  {decode_type_t::GOODWEATHER, acToString<IRGoodweatherAc, RawValue>,
+   acToCommon<IRGoodweatherAc, RawValue>},
+#endif  // DECODE_GOODWEATHER
+#if DECODE_DAIKIN160
+  {decode_type_t::DAIKIN160, acToString<IRDaikin160, RawState>,
+   acToCommon<IRDaikin160, RawState>},
+#endif  // DECODE_DAIKIN160
 #if DECODE_NEOCLIMA
-      case decode_type_t::NEOCLIMA: {
-        IRNeoclimaAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::NEOCLIMA, acToString<IRNeoclimaAc, RawState>,
+   acToCommon<IRNeoclimaAc, RawState>},
 #endif  // DECODE_NEOCLIMA
-#if DECODE_PANASONIC_AC
-      case decode_type_t::PANASONIC_AC: {
-        IRPanasonicAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_PANASONIC_AC
-#if DECODE_SAMSUNG_AC
-      case decode_type_t::SAMSUNG_AC: {
-        IRSamsungAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_SAMSUNG_AC
+#if DECODE_DAIKIN176
+  {decode_type_t::DAIKIN176, acToString<IRDaikin176, RawState>,
+   acToCommon<IRDaikin176, RawState>},
+#endif  // DECODE_DAIKIN176
+#if DECODE_DAIKIN128
+  {decode_type_t::DAIKIN128, acToString<IRDaikin128, RawState>,
+   acToCommon<IRDaikin128, RawState>},
+#endif  // DECODE_DAIKIN128
+#if DECODE_AMCOR
+  {decode_type_t::AMCOR, acToString<IRAmcorAc, RawState>,
+   acToCommon<IRAmcorAc, RawState>},
+#endif  // DECODE_AMCOR
+#if DECODE_DAIKIN152
+  {decode_type_t::DAIKIN152, acToString<IRDaikin152, RawState>,
+   acToCommon<IRDaikin152, RawState>},
+#endif  // DECODE_DAIKIN152
+#if DECODE_MITSUBISHI136
+  {decode_type_t::MITSUBISHI136, acToString<IRMitsubishi136, RawState>,
+   acToCommon<IRMitsubishi136, RawState>},
+#endif  // DECODE_MITSUBISHI136
+#if DECODE_MITSUBISHI112
+  {decode_type_t::MITSUBISHI112, acToString<IRMitsubishi112, RawState>,
+   acToCommon<IRMitsubishi112, RawState>},
+#endif  // DECODE_MITSUBISHI112
+#if DECODE_HITACHI_AC424
+  {decode_type_t::HITACHI_AC424, acToString<IRHitachiAc424, RawState>,
+   acToCommon<IRHitachiAc424, RawState>},
+#endif  // DECODE_HITACHI_AC424
+#if DECODE_DAIKIN64
+  {decode_type_t::DAIKIN64, acToString<IRDaikin64, RawValue>,
+   acToCommonPrev<IRDaikin64, RawValue>},
+#endif  // DECODE_DAIKIN64
+#if DECODE_AIRWELL
+  {decode_type_t::AIRWELL, acToString<IRAirwellAc, RawValue>,
+   acToCommon<IRAirwellAc, RawValue>},
+#endif  // DECODE_AIRWELL
+#if DECODE_DELONGHI_AC
+  {decode_type_t::DELONGHI_AC, acToString<IRDelonghiAc, RawValue>,
+   acToCommon<IRDelonghiAc, RawValue>},
+#endif  // DECODE_DELONGHI_AC
+#if DECODE_CARRIER_AC64
+  {decode_type_t::CARRIER_AC64, acToString<IRCarrierAc64, RawValue>,
+   acToCommon<IRCarrierAc64, RawValue>},
+#endif  // DECODE_CARRIER_AC64
+#if DECODE_HITACHI_AC344
+  {decode_type_t::HITACHI_AC344, acToString<IRHitachiAc344, RawState>,
+   acToCommon<IRHitachiAc344, RawState>},
+#endif  // DECODE_HITACHI_AC344
+#if DECODE_CORONA_AC
+  {decode_type_t::CORONA_AC, acToString<IRCoronaAc, RawSized>,
+   acToCommon<IRCoronaAc, RawSized>},
+#endif  // DECODE_CORONA_AC
 #if DECODE_SANYO_AC
-      case decode_type_t::SANYO_AC: {
-        IRSanyoAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
+  {decode_type_t::SANYO_AC, acToString<IRSanyoAc, RawState>,
+   acToCommon<IRSanyoAc, RawState>},
 #endif  // DECODE_SANYO_AC
-#if DECODE_SHARP_AC
-      case decode_type_t::SHARP_AC: {
-        IRSharpAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_SHARP_AC
-#if DECODE_TCL112AC
-      case decode_type_t::TCL112AC: {
-        IRTcl112Ac ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_TCL112AC
-#if DECODE_TECHNIBEL_AC
-      case decode_type_t::TECHNIBEL_AC: {
-        IRTechnibelAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_TECHNIBEL_AC
-#if DECODE_TECO
-      case decode_type_t::TECO: {
-        IRTecoAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_TECO
-#if DECODE_TOSHIBA_AC
-      case decode_type_t::TOSHIBA_AC: {
-        IRToshibaAC ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_TOSHIBA_AC
-#if DECODE_TROTEC
-      case decode_type_t::TROTEC: {
-        IRTrotecESP ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_TROTEC
-#if DECODE_VESTEL_AC
-      case decode_type_t::VESTEL_AC: {
-        IRVestelAc ac(kGpioUnused);
-        ac.setRaw(decode->value);  // Uses value instead of state.
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_VESTEL_AC
 #if DECODE_VOLTAS
-      case decode_type_t::VOLTAS: {
-        IRVoltas ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon(prev);
-        break;
-      }
+  {decode_type_t::VOLTAS, acToString<IRVoltas, RawState>,
+   acToCommonPrev<IRVoltas, RawState>},
 #endif  // DECODE_VOLTAS
-#if DECODE_WHIRLPOOL_AC
-      case decode_type_t::WHIRLPOOL_AC: {
-        IRWhirlpoolAc ac(kGpioUnused);
-        ac.setRaw(decode->state);
-        *result = ac.toCommon();
-        break;
-      }
-#endif  // DECODE_WHIRLPOOL_AC
-      default:
-        return false;
-    }
-    return true;
+#if DECODE_TECHNIBEL_AC
+  {decode_type_t::TECHNIBEL_AC, acToString<IRTechnibelAc, RawValue>,
+   acToCommon<IRTechnibelAc, RawValue>},
+#endif  // DECODE_TECHNIBEL_AC
+};
+
+const uint8_t kDecodersSize = sizeof(kDecoders) / sizeof(kDecoders[0]);
+
+// Find the decoder table entry for a protocol.
+// Returns true & a copy of the entry in `entry` if it has a decoder.
+bool findDecoder(const decode_type_t protocol, irac_decoder_t *entry) {
+  uint8_t low = 0;
+  uint8_t high = kDecodersSize;
+  while (low < high) {
+    const uint8_t mid = (low + high) / 2;
+    memcpy_P(entry, &kDecoders[mid], sizeof(*entry));
+    if (entry->protocol == protocol)
+      return entry->toString != NULL;
+    else if (entry->protocol < protocol)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return false;
+}
+/// @endcond
+
+  /// Is there a decoder for the given A/C protocol's messages?
+  /// i.e. Will `resultAcToString()` & `decodeToState()` handle it?
+  /// @param[in] protocol The protocol to check for.
+  /// @return true if we can decode it, false if not.
+  bool isProtocolDecodable(const decode_type_t protocol) {
+    irac_decoder_t entry;
+    return findDecoder(protocol, &entry);
+  }
+
+  /// Display the human readable state of an A/C message if we can.
+  /// @param[in] result A Ptr to the captured `decode_results` that contains an
+  ///   A/C mesg.
+  /// @return A string with the human description of the A/C message.
+  ///   An empty string if we can't.
+  String resultAcToString(const decode_results * const result) {
+#if ENABLE_MEMORY_PROFILING
+    irutils::MemoryProbe probe(kMemProbeResultAcToString);
+#endif  // ENABLE_MEMORY_PROFILING
+    irac_decoder_t entry;
+    if (!findDecoder(result->decode_type, &entry)) return "";
+    return entry.toString(result);
+  }
+
+  /// Convert a valid IR A/C remote message that we understand enough into a
+  /// Common A/C state.
+  /// @param[in] decode A PTR to a successful raw IR decode object.
+  /// @param[in] result A PTR to a state structure to store the result in.
+  /// @param[in] prev A PTR to a state structure which has the prev. state.
+  /// @return A boolean indicating success or failure.
+  bool decodeToState(const decode_results *decode, stdAc::state_t *result,
+                     const stdAc::state_t *prev) {
+#if ENABLE_MEMORY_PROFILING
+    irutils::MemoryProbe probe(kMemProbeDecodeToState);
+#endif  // ENABLE_MEMORY_PROFILING
+    if (decode == NULL || result == NULL) return false;  // Safety check.
+    irac_decoder_t entry;
+    if (!findDecoder(decode->decode_type, &entry)) return false;
+    return entry.toCommon(decode, result, prev);
   }
 }  // namespace IRAcUtils
+
+/// Constructor for an IRAcDecoder object.
+/// @param[in] size Nr. of protocols to remember the last message of.
+/// @note Each one uses ~150 bytes of RAM.
+IRAcDecoder::IRAcDecoder(const uint8_t size) {
+  _entries = new irac_decoded_t[size];
+  _size = (_entries != NULL) ? size : 0;
+  clear();
+}
+
+/// Destructor for an IRAcDecoder object.
+IRAcDecoder::~IRAcDecoder(void) { delete[] _entries; }
+
+/// Forget all the messages seen so far.
+void IRAcDecoder::clear(void) {
+  for (uint8_t i = 0; i < _size; i++) {
+    _entries[i].protocol = decode_type_t::UNKNOWN;
+    _entries[i].used = 0;
+  }
+  _clock = 0;
+}
+
+/// Convert a valid IR A/C remote message that we understand enough into a
+/// Common A/C state, if it isn't the same as the last one of its protocol.
+/// @param[in] decode A PTR to a successful raw IR decode object.
+/// @param[out] result A PTR to a state structure to store the result in.
+/// @param[in] prev A PTR to a state structure which has the prev. state.
+/// @return kIRAcDecodeFailed, if it can't be decoded. `result` is unchanged.
+///   kIRAcDecodeUnchanged, if the message (& `prev`) are the same as the last
+///   time, or it decodes to the same state as it did then.
+///   Otherwise kIRAcDecodeChanged.
+/// @note `result` holds the decoded state in both of the latter cases.
+irac_decode_status_t IRAcDecoder::decode(const decode_results *decode,
+                                         stdAc::state_t *result,
+                                         const stdAc::state_t *prev) {
+  if (decode == NULL || result == NULL ||
+      decode->decode_type == decode_type_t::UNKNOWN) return kIRAcDecodeFailed;
+  // `value` shares its memory with `state`, so this covers both kinds.
+  uint16_t length = (decode->bits + 7) / 8;
+  if (length < sizeof(decode->value)) length = sizeof(decode->value);
+  if (length > kStateSizeMax) return kIRAcDecodeFailed;
+  irac_decoded_t *entry = NULL;
+  uint8_t victim = 0;
+  for (uint8_t i = 0; i < _size; i++) {
+    if (_entries[i].protocol == decode->decode_type) {
+      entry = &_entries[i];
+      break;
+    }
+    // Prefer an unused entry, then the least recently used one.
+    if (_entries[victim].protocol != decode_type_t::UNKNOWN &&
+        (_entries[i].protocol == decode_type_t::UNKNOWN ||
+         _entries[i].used < _entries[victim].used))
+      victim = i;
+  }
+  if (entry != NULL && entry->bits == decode->bits &&
+      entry->has_prev == (prev != NULL) &&
+      (prev == NULL || (!IRac::cmpStates(entry->prev, *prev) &&
+                        entry->prev.clock == prev->clock)) &&
+      !memcmp(entry->raw, decode->state, length)) {  // Same as last time.
+    entry->used = ++_clock;
+    *result = entry->state;
+    return kIRAcDecodeUnchanged;
+  }
+  stdAc::state_t state;
+  if (!IRAcUtils::decodeToState(decode, &state, prev)) return kIRAcDecodeFailed;
+  *result = state;
+  if (entry == NULL) {
+    if (!_size) return kIRAcDecodeChanged;  // Nowhere to remember it.
+    entry = &_entries[victim];
+  }
+  const bool changed = entry->protocol != decode->decode_type ||
+      IRac::cmpStates(entry->state, state) || entry->state.clock != state.clock;
+  entry->protocol = decode->decode_type;
+  entry->bits = decode->bits;
+  memcpy(entry->raw, decode->state, length);
+  entry->has_prev = (prev != NULL);
+  if (prev != NULL) entry->prev = *prev;
+  entry->state = state;
+  entry->used = ++_clock;
+  return changed ? kIRAcDecodeChanged : kIRAcDecodeUnchanged;
+}
@@ -7,6 +7,10 @@
 #include <Arduino.h>
 #endif
 #include "IRremoteESP8266.h"
+#include "IRsend.h"
+#ifdef UNIT_TEST
+#include "IRsend_test.h"
+#endif
 #include "ir_Airwell.h"
 #include "ir_Amcor.h"
 #include "ir_Argo.h"
@@ -42,6 +46,80 @@
 
 // Constants
 const int8_t kGpioUnused = -1;  ///< A placeholder for not using an actual GPIO.
+/// Default nr. of messages `IRac::enableFrameCache()` remembers.
+const uint8_t kIRacFrameCacheDefaultSize = 4;
+/// Max. nr. of marks & spaces a message can have to be remembered.
+const uint16_t kIRacFrameCacheMaxLength = kSequenceDefaultSize;
+
+/// A message `IRac::sendAc()` has sent before. See `IRac::enableFrameCache()`.
+typedef struct {
+  uint32_t hash;  ///< A hash of the rest of the key. 0 if it is unused.
+  stdAc::state_t key;  ///< The state that was sent. After `handleToggles()`.
+  bool has_prev;  ///< Was a previous state given?
+  bool prev_power;  ///< The previous power setting, if given.
+  stdAc::swingv_t prev_swingv;  ///< The previous vertical swing, if given.
+  stdAc::swingh_t prev_swingh;  ///< The previous horizontal swing, if given.
+  uint32_t used;  ///< When it was last sent. For forgetting the oldest one.
+  IRsequence *frame;  ///< What was sent.
+} irac_frame_t;
+
+/// Version of the format `IRac::stateToBinary()` produces.
+const uint8_t kIRacStateBinaryVersion = 1;
+/// Nr. of bytes `IRac::stateToBinary()` produces.
+const uint8_t kIRacStateBinaryLength = 9;
+/// A buffer size that should fit anything `IRac::stateToJson()` produces.
+const uint16_t kIRacStateJsonSize = 512;
+
+/// Default nr. of messages an `IRacBatch` can hold.
+const uint8_t kIRacBatchDefaultSize = 40;
+/// Max. nr. of different GPIOs an `IRacBatch` can send from.
+const uint8_t kIRacBatchMaxEmitters = 8;
+
+/// Max. nr. of different GPIOs an `IRacEngine` can send from.
+const uint8_t kIRacEngineMaxEmitters = 8;
+
+/// Default nr. of protocols an `IRAcDecoder` remembers the last message of.
+const uint8_t kIRAcDecoderDefaultSize = 2;
+
+/// What `IRAcDecoder::decode()` made of a message.
+enum irac_decode_status_t {
+  kIRAcDecodeFailed = 0,  ///< It isn't an A/C message we can decode.
+  kIRAcDecodeChanged,  ///< It is for a different state than last time.
+  kIRAcDecodeUnchanged,  ///< It is for the same state as last time.
+};
+
+/// The last message of a protocol an `IRAcDecoder` has decoded.
+typedef struct {
+  decode_type_t protocol;  ///< The protocol. UNKNOWN if the entry is unused.
+  uint16_t bits;  ///< The nr. of bits in the message.
+  uint8_t raw[kStateSizeMax];  ///< The message. i.e. `decode_results::state`.
+  bool has_prev;  ///< Was it decoded with a previous state?
+  stdAc::state_t prev;  ///< The previous state, if given.
+  stdAc::state_t state;  ///< What it was decoded to.
+  uint32_t used;  ///< When it was last decoded. For forgetting the oldest one.
+} irac_decoded_t;
+
+/// A compiled message waiting to be sent by an `IRacBatch`.
+typedef struct {
+  IRsequence *frame;  ///< What to send. NULL if the entry is unused.
+  uint8_t emitter;  ///< The index of the emitter to send it from.
+  uint32_t order;  ///< When it was added. Earlier is sent first.
+} irac_batch_entry_t;
+
+/// What an `IRacBatch` sends messages with.
+#ifdef UNIT_TEST
+typedef IRsendTest irac_batch_send_t;
+#else  // UNIT_TEST
+typedef IRsend irac_batch_send_t;
+#endif  // UNIT_TEST
+
+/// A GPIO an `IRacBatch` sends from.
+typedef struct {
+  irac_batch_send_t *irsend;  ///< What sends the messages.
+  uint16_t pin;  ///< The GPIO it sends from.
+  uint32_t wait;  ///< Time to wait since `since` before the next message.
+  IRtimer since;  ///< When the last message was started or sent.
+} irac_batch_emitter_t;
 
 // Class
 /// A universal/common/generic interface for controling supported A/Cs.
@@ -49,6 +127,18 @@ class IRac {
  public:
   explicit IRac(const uint16_t pin, const bool inverted = false,
                 const bool use_modulation = true);
+#if ENABLE_IRAC_CACHE || ENABLE_IRAC_FRAME_CACHE
+  ~IRac(void);
+#endif  // ENABLE_IRAC_CACHE || ENABLE_IRAC_FRAME_CACHE
+#if ENABLE_IRAC_CACHE
+  void clearCache(void);
+#endif  // ENABLE_IRAC_CACHE
+#if ENABLE_IRAC_FRAME_CACHE
+  bool enableFrameCache(const uint8_t size = kIRacFrameCacheDefaultSize);
+  void disableFrameCache(void);
+  uint32_t getFrameCacheHits(void);
+  uint32_t getFrameCacheMisses(void);
+#endif  // ENABLE_IRAC_FRAME_CACHE
   static bool isProtocolSupported(const decode_type_t protocol);
   static void initState(stdAc::state_t *state,
                         const decode_type_t vendor, const int16_t model,
@@ -63,8 +153,18 @@ class IRac {
                         const int16_t clock);
   static void initState(stdAc::state_t *state);
   void markAsSent(void);
+  void setDeltaSend(const bool on);
+  bool getDeltaSend(void);
+  void setBurstSend(const bool on);
+  bool getBurstSend(void);
+  void setSuppressDuplicates(const bool on, const uint32_t reassert = 0,
+                             const float hysteresis = 0);
+  bool getSuppressDuplicates(void);
+  uint32_t getSuppressedCount(void);
   bool sendAc(void);
-  bool sendAc(const stdAc::state_t desired, const stdAc::state_t *prev = NULL);
+  bool sendAc(const stdAc::state_t &desired, const stdAc::state_t *prev = NULL);
+  bool encodeAc(const stdAc::state_t &desired, IRsequence *frame,
+                const stdAc::state_t *prev = NULL);
   bool sendAc(const decode_type_t vendor, const int16_t model,
               const bool power, const stdAc::opmode_t mode, const float degrees,
               const bool celsius, const stdAc::fanspeed_t fan,
@@ -73,7 +173,11 @@ class IRac {
               const bool light, const bool filter, const bool clean,
               const bool beep, const int16_t sleep = -1,
               const int16_t clock = -1);
-  static bool cmpStates(const stdAc::state_t a, const stdAc::state_t b);
+  static bool isSensorTempSupported(const decode_type_t protocol);
+  bool sendSensorTemp(const stdAc::state_t &desired, const float degrees,
+                      IRsendQueue *queue = NULL,
+                      const uint8_t priority = kSendQueueDefaultPriority);
+  static bool cmpStates(const stdAc::state_t &a, const stdAc::state_t &b);
   static bool strToBool(const char *str, const bool def = false);
   static int16_t strToModel(const char *str, const int16_t def = -1);
   static stdAc::opmode_t strToOpmode(
@@ -90,6 +194,16 @@ class IRac {
   static String fanspeedToString(const stdAc::fanspeed_t speed);
   static String swingvToString(const stdAc::swingv_t swingv);
   static String swinghToString(const stdAc::swingh_t swingh);
+  static bool stateToBinary(const stdAc::state_t &state, uint8_t *data);
+  static bool binaryToState(const uint8_t *data, const uint16_t length,
+                            stdAc::state_t *state);
+  static String stateToBase64(const stdAc::state_t &state);
+  static bool base64ToState(const char *str, stdAc::state_t *state);
+  static uint16_t stateToJson(const stdAc::state_t &state, char *output,
+                              const uint16_t size);
+#ifdef ARDUINO
+  static void stateToJson(Print *output, const stdAc::state_t &state);
+#endif  // ARDUINO
   stdAc::state_t getState(void);
   stdAc::state_t getStatePrev(void);
   bool hasStateChanged(void);
@@ -102,341 +216,659 @@ class IRac {
   bool _inverted;  ///< IR LED is lit when GPIO is LOW (true) or HIGH (false)?
   bool _modulation;  ///< Is frequency modulation to be used?
   stdAc::state_t _prev;  ///< The state we expect the device to currently be in.
+  bool _delta;  ///< Send only what changed, if the protocol can?
+  bool _burst;  ///< Send a protocol's separate messages as one burst?
+  bool _suppress;  ///< Don't send a state the A/C should already be in?
+  uint32_t _reassert;  ///< Send it again anyway after this long. (msecs)
+  float _hysteresis;  ///< Temp. changes smaller than this aren't a change.
+  uint32_t _suppressed;  ///< Nr. of sends that were suppressed.
+  TimerMs _since_sent;  ///< Time since `sendAc()` last sent something.
+#if ENABLE_IRAC_CACHE
+  void *_cache;  ///< The protocol object kept from the last `sendAc()`.
+  void (*_cache_free)(void *);  ///< How to delete `_cache`.
+  decode_type_t _cache_protocol;  ///< The protocol `_cache` is for.
+  int16_t _cache_model;  ///< The model `_cache` is for.
+  template <typename AC, typename... Args>
+  AC *_cachedAc(const decode_type_t protocol, const int16_t model,
+                Args... args);
+#endif  // ENABLE_IRAC_CACHE
+#if ENABLE_IRAC_FRAME_CACHE
+#ifdef UNIT_TEST
+  IRsendTest _irsend;  ///< Where messages in the frame cache are sent from.
+#else  // UNIT_TEST
+  IRsend _irsend;  ///< Where messages in the frame cache are sent from.
+#endif  // UNIT_TEST
+  irac_frame_t *_frames;  ///< The frame cache. NULL if it isn't enabled.
+  uint8_t _frames_size;  ///< Nr. of entries in `_frames`.
+  uint32_t _frames_clock;  ///< Increases every time an entry is used.
+  uint32_t _frame_hits;  ///< Nr. of `sendAc()` calls found in `_frames`.
+  uint32_t _frame_misses;  ///< Nr. of `sendAc()` calls not in `_frames`.
+  IRsequence *_findFrame(const irac_frame_t &wanted);
+  void _storeFrame(const irac_frame_t &wanted, const IRsequence *recording);
+  bool _sendCachedAc(const stdAc::state_t &send, const stdAc::state_t *prev);
+#endif  // ENABLE_IRAC_FRAME_CACHE
+#if ENABLE_IRAC_CACHE || ENABLE_IRAC_FRAME_CACHE
+  IRac(const IRac &);  // Not copyable, as it owns memory.
+  IRac &operator=(const IRac &);
+#endif  // ENABLE_IRAC_CACHE || ENABLE_IRAC_FRAME_CACHE
+  bool _sendAc(const stdAc::state_t &send, const stdAc::state_t *prev);
+  bool _sendDeltaAc(const stdAc::state_t &send, const stdAc::state_t *prev);
+  static void _cleanState(stdAc::state_t *state);
+  static bool _packState(const stdAc::state_t &state, uint64_t *bits);
+  static bool _unpackState(const uint64_t bits, stdAc::state_t *state);
+  static void _handleToggles(stdAc::state_t *state, const stdAc::state_t *prev);
 #if SEND_AIRWELL
-  void airwell(IRAirwellAc *ac,
-               const bool on, const stdAc::opmode_t mode, const float degrees,
-               const stdAc::fanspeed_t fan);
+  static void airwell(IRAirwellAc *ac, const stdAc::state_t &state);
 #endif  // SEND_AIRWELL
 #if SEND_AMCOR
-  void amcor(IRAmcorAc *ac,
-             const bool on, const stdAc::opmode_t mode, const float degrees,
-             const stdAc::fanspeed_t fan);
+  static void amcor(IRAmcorAc *ac, const stdAc::state_t &state);
 #endif  // SEND_AMCOR
 #if SEND_ARGO
-  void argo(IRArgoAC *ac,
-            const bool on, const stdAc::opmode_t mode, const float degrees,
-            const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-            const bool turbo, const int16_t sleep = -1);
+  static void argo(IRArgoAC *ac, const stdAc::state_t &state);
 #endif  // SEND_ARGO
 #if SEND_CARRIER_AC64
-void carrier64(IRCarrierAc64 *ac,
-               const bool on, const stdAc::opmode_t mode,
-               const float degrees, const stdAc::fanspeed_t fan,
-               const stdAc::swingv_t swingv, const int16_t sleep = -1);
+  static void carrier64(IRCarrierAc64 *ac, const stdAc::state_t &state);
 #endif  // SEND_CARRIER_AC64
 #if SEND_COOLIX
-  void coolix(IRCoolixAC *ac,
-              const bool on, const stdAc::opmode_t mode, const float degrees,
-              const stdAc::fanspeed_t fan,
-              const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-              const bool turbo, const bool light, const bool clean,
-              const int16_t sleep = -1);
+  static void coolix(IRCoolixAC *ac, const stdAc::state_t &state,
+                     const bool burst = false);
 #endif  // SEND_COOLIX
 #if SEND_CORONA_AC
-  void corona(IRCoronaAc *ac,
-              const bool on, const stdAc::opmode_t mode,
-              const float degrees, const stdAc::fanspeed_t fan,
-              const stdAc::swingv_t swingv, const bool econo);
+  static void corona(IRCoronaAc *ac, const stdAc::state_t &state);
 #endif  // SEND_CORONA_AC
 #if SEND_DAIKIN
-  void daikin(IRDaikinESP *ac,
-              const bool on, const stdAc::opmode_t mode, const float degrees,
-              const stdAc::fanspeed_t fan,
-              const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-              const bool quiet, const bool turbo, const bool econo,
-              const bool clean);
+  static void daikin(IRDaikinESP *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN
 #if SEND_DAIKIN128
-  void daikin128(IRDaikin128 *ac,
-                 const bool on, const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv,
-                 const bool quiet, const bool turbo, const bool light,
-                 const bool econo, const int16_t sleep = -1,
-                 const int16_t clock = -1);
+  static void daikin128(IRDaikin128 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN128
 #if SEND_DAIKIN152
-  void daikin152(IRDaikin152 *ac,
-                 const bool on, const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv,
-                 const bool quiet, const bool turbo, const bool econo);
+  static void daikin152(IRDaikin152 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN152
 #if SEND_DAIKIN160
-  void daikin160(IRDaikin160 *ac,
-                 const bool on, const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv);
+  static void daikin160(IRDaikin160 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN160
 #if SEND_DAIKIN176
-  void daikin176(IRDaikin176 *ac,
-                 const bool on, const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingh_t swingh);
+  static void daikin176(IRDaikin176 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN176
 #if SEND_DAIKIN2
-  void daikin2(IRDaikin2 *ac,
-               const bool on, const stdAc::opmode_t mode,
-               const float degrees, const stdAc::fanspeed_t fan,
-               const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-               const bool quiet, const bool turbo, const bool light,
-               const bool econo, const bool filter, const bool clean,
-               const bool beep, const int16_t sleep = -1,
-               const int16_t clock = -1);
+  static void daikin2(IRDaikin2 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN2
 #if SEND_DAIKIN216
-void daikin216(IRDaikin216 *ac,
-               const bool on, const stdAc::opmode_t mode,
-               const float degrees, const stdAc::fanspeed_t fan,
-               const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-               const bool quiet, const bool turbo);
+  static void daikin216(IRDaikin216 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN216
 #if SEND_DAIKIN64
-  void daikin64(IRDaikin64 *ac,
-                 const bool on, const stdAc::opmode_t mode,
-                 const float degrees, const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv,
-                 const bool quiet, const bool turbo,
-                 const int16_t sleep = -1, const int16_t clock = -1);
+  static void daikin64(IRDaikin64 *ac, const stdAc::state_t &state);
 #endif  // SEND_DAIKIN64
 #if SEND_DELONGHI_AC
-  void delonghiac(IRDelonghiAc *ac,
-                  const bool on, const stdAc::opmode_t mode, const bool celsius,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const bool turbo, const int16_t sleep = -1);
+  static void delonghiac(IRDelonghiAc *ac, const stdAc::state_t &state);
 #endif  // SEND_DELONGHI_AC
 #if SEND_ELECTRA_AC
-void electra(IRElectraAc *ac,
-             const bool on, const stdAc::opmode_t mode,
-             const float degrees, const stdAc::fanspeed_t fan,
-             const stdAc::swingv_t swingv,
-             const stdAc::swingh_t swingh, const bool turbo,
-             const bool lighttoggle, const bool clean);
+  static void electra(IRElectraAc *ac, const stdAc::state_t &state);
 #endif  // SEND_ELECTRA_AC
 #if SEND_FUJITSU_AC
-  void fujitsu(IRFujitsuAC *ac, const fujitsu_ac_remote_model_t model,
-               const bool on, const stdAc::opmode_t mode, const float degrees,
-               const stdAc::fanspeed_t fan,
-               const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-               const bool quiet, const bool turbo, const bool econo,
-               const bool filter, const bool clean);
+  static void fujitsu(IRFujitsuAC *ac, const stdAc::state_t &state);
 #endif  // SEND_FUJITSU_AC
 #if SEND_GOODWEATHER
-  void goodweather(IRGoodweatherAc *ac,
-                   const bool on, const stdAc::opmode_t mode,
-                   const float degrees,
-                   const stdAc::fanspeed_t fan,
-                   const stdAc::swingv_t swingv,
-                   const bool turbo, const bool light,
-                   const int16_t sleep = -1);
+  static void goodweather(IRGoodweatherAc *ac, const stdAc::state_t &state);
 #endif  // SEND_GOODWEATHER
 #if SEND_GREE
-  void gree(IRGreeAC *ac, const gree_ac_remote_model_t model,
-            const bool on, const stdAc::opmode_t mode, const bool celsius,
-            const float degrees, const stdAc::fanspeed_t fan,
-            const stdAc::swingv_t swingv, const bool turbo, const bool light,
-            const bool clean, const int16_t sleep = -1);
+  static void gree(IRGreeAC *ac, const stdAc::state_t &state);
 #endif  // SEND_GREE
 #if SEND_HAIER_AC
-  void haier(IRHaierAC *ac,
-             const bool on, const stdAc::opmode_t mode, const float degrees,
-             const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-             const bool filter, const int16_t sleep = -1,
-             const int16_t clock = -1);
+  static void haier(IRHaierAC *ac, const stdAc::state_t &state);
 #endif  // SEND_HAIER_AC
 #if SEND_HAIER_AC_YRW02
-  void haierYrwo2(IRHaierACYRW02 *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv,
-                  const bool turbo, const bool filter,
-                  const int16_t sleep = -1);
+  static void haierYrwo2(IRHaierACYRW02 *ac, const stdAc::state_t &state,
+                         const stdAc::state_t *prev = NULL);
 #endif  // SEND_HAIER_AC_YRW02
 #if SEND_HITACHI_AC
-  void hitachi(IRHitachiAc *ac,
-               const bool on, const stdAc::opmode_t mode,
-               const float degrees, const stdAc::fanspeed_t fan,
-               const stdAc::swingv_t swingv, const stdAc::swingh_t swingh);
+  static void hitachi(IRHitachiAc *ac, const stdAc::state_t &state);
 #endif  // SEND_HITACHI_AC
 #if SEND_HITACHI_AC1
-  void hitachi1(IRHitachiAc1 *ac, const hitachi_ac1_remote_model_t model,
-                const bool on, const bool power_toggle,
-                const stdAc::opmode_t mode,
-                const float degrees, const stdAc::fanspeed_t fan,
-                const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                const bool swing_toggle, const int16_t sleep = -1);
+  static void hitachi1(IRHitachiAc1 *ac, const stdAc::state_t &state,
+                       const bool power_toggle, const bool swing_toggle);
 #endif  // SEND_HITACHI_AC1
 #if SEND_HITACHI_AC344
-  void hitachi344(IRHitachiAc344 *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv,
-                  const stdAc::swingh_t swingh);
+  static void hitachi344(IRHitachiAc344 *ac, const stdAc::state_t &state);
 #endif  // SEND_HITACHI_AC344
 #if SEND_HITACHI_AC424
-  void hitachi424(IRHitachiAc424 *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv);
+  static void hitachi424(IRHitachiAc424 *ac, const stdAc::state_t &state);
 #endif  // SEND_HITACHI_AC424
 #if SEND_KELVINATOR
-  void kelvinator(IRKelvinatorAC *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees, const stdAc::fanspeed_t fan,
-                  const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                  const bool quiet, const bool turbo, const bool light,
-                  const bool filter, const bool clean);
+  static void kelvinator(IRKelvinatorAC *ac, const stdAc::state_t &state);
 #endif  // SEND_KELVINATOR
 #if SEND_LG
-  void lg(IRLgAc *ac, const lg_ac_remote_model_t model,
-          const bool on, const stdAc::opmode_t mode,
-          const float degrees, const stdAc::fanspeed_t fan);
+  static void lg(IRLgAc *ac, const stdAc::state_t &state);
 #endif  // SEND_LG
 #if SEND_MIDEA
-  void midea(IRMideaAC *ac,
-             const bool on, const stdAc::opmode_t mode, const bool celsius,
-             const float degrees, const stdAc::fanspeed_t fan,
-             const stdAc::swingv_t swingv, const bool econo,
-             const int16_t sleep = -1);
+  static void midea(IRMideaAC *ac, const stdAc::state_t &state);
 #endif  // SEND_MIDEA
 #if SEND_MITSUBISHI_AC
-  void mitsubishi(IRMitsubishiAC *ac,
-                  const bool on, const stdAc::opmode_t mode,
-                  const float degrees,
-                  const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                  const stdAc::swingh_t swingh,
-                  const bool quiet, const int16_t clock = -1);
+  static void mitsubishi(IRMitsubishiAC *ac, const stdAc::state_t &state);
 #endif  // SEND_MITSUBISHI_AC
 #if SEND_MITSUBISHI112
-  void mitsubishi112(IRMitsubishi112 *ac,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingv_t swingv,
-                     const stdAc::swingh_t swingh,
-                     const bool quiet);
+  static void mitsubishi112(IRMitsubishi112 *ac, const stdAc::state_t &state);
 #endif  // SEND_MITSUBISHI112
 #if SEND_MITSUBISHI136
-  void mitsubishi136(IRMitsubishi136 *ac,
-                     const bool on, const stdAc::opmode_t mode,
-                     const float degrees, const stdAc::fanspeed_t fan,
-                     const stdAc::swingv_t swingv, const bool quiet);
+  static void mitsubishi136(IRMitsubishi136 *ac, const stdAc::state_t &state);
 #endif  // SEND_MITSUBISHI136
 #if SEND_MITSUBISHIHEAVY
-  void mitsubishiHeavy88(IRMitsubishiHeavy88Ac *ac,
-                         const bool on, const stdAc::opmode_t mode,
-                         const float degrees, const stdAc::fanspeed_t fan,
-                         const stdAc::swingv_t swingv,
-                         const stdAc::swingh_t swingh,
-                         const bool turbo, const bool econo, const bool clean);
-  void mitsubishiHeavy152(IRMitsubishiHeavy152Ac *ac,
-                          const bool on, const stdAc::opmode_t mode,
-                          const float degrees, const stdAc::fanspeed_t fan,
-                          const stdAc::swingv_t swingv,
-                          const stdAc::swingh_t swingh,
-                          const bool quiet, const bool turbo, const bool econo,
-                          const bool filter, const bool clean,
-                          const int16_t sleep = -1);
+  static void mitsubishiHeavy88(IRMitsubishiHeavy88Ac *ac,
+                                const stdAc::state_t &state);
+  static void mitsubishiHeavy152(IRMitsubishiHeavy152Ac *ac,
+                                 const stdAc::state_t &state);
 #endif  // SEND_MITSUBISHIHEAVY
 #if SEND_NEOCLIMA
-  void neoclima(IRNeoclimaAc *ac, const bool on, const stdAc::opmode_t mode,
-                const float degrees, const stdAc::fanspeed_t fan,
-                const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                const bool turbo, const bool light, const bool filter,
-                const int16_t sleep = -1);
+  static void neoclima(IRNeoclimaAc *ac, const stdAc::state_t &state);
 #endif  // SEND_NEOCLIMA
 #if SEND_PANASONIC_AC
-  void panasonic(IRPanasonicAc *ac, const panasonic_ac_remote_model_t model,
-                 const bool on, const stdAc::opmode_t mode, const float degrees,
-                 const stdAc::fanspeed_t fan,
-                 const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-                 const bool quiet, const bool turbo, const bool filter,
-                 const int16_t clock = -1);
+  static void panasonic(IRPanasonicAc *ac, const stdAc::state_t &state);
 #endif  // SEND_PANASONIC_AC
 #if SEND_SAMSUNG_AC
-  void samsung(IRSamsungAc *ac,
-               const bool on, const stdAc::opmode_t mode, const float degrees,
-               const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-               const bool quiet, const bool turbo, const bool light,
-               const bool filter, const bool clean,
-               const bool beep, const bool prevpower = true,
-               const bool forcepower = true);
+  static void samsung(IRSamsungAc *ac, const stdAc::state_t &state,
+                      const bool prevpower = true,
+                      const bool forcepower = true);
 #endif  // SEND_SAMSUNG_AC
 #if SEND_SANYO_AC
-  void sanyo(IRSanyoAc *ac,
-             const bool on, const stdAc::opmode_t mode, const float degrees,
-             const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-             const bool beep, const int16_t sleep = -1);
+  static void sanyo(IRSanyoAc *ac, const stdAc::state_t &state);
 #endif  // SEND_SANYO_AC
 #if SEND_SHARP_AC
-  void sharp(IRSharpAc *ac,
-             const bool on, const bool prev_power, const stdAc::opmode_t mode,
-             const float degrees, const stdAc::fanspeed_t fan,
-             const stdAc::swingv_t swingv, const bool turbo, const bool filter,
-             const bool clean);
+  static void sharp(IRSharpAc *ac, const stdAc::state_t &state,
+                    const bool prev_power);
 #endif  // SEND_SHARP_AC
 #if SEND_TCL112AC
-  void tcl112(IRTcl112Ac *ac,
-              const bool on, const stdAc::opmode_t mode, const float degrees,
-              const stdAc::fanspeed_t fan,
-              const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-              const bool turbo, const bool light, const bool econo,
-              const bool filter);
+  static void tcl112(IRTcl112Ac *ac, const stdAc::state_t &state);
 #endif  // SEND_TCL112AC
 #if SEND_TECHNIBEL_AC
-  void technibel(IRTechnibelAc *ac,
-            const bool on, const stdAc::opmode_t mode, const float degrees,
-            const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-            const int16_t sleep = -1);
+  static void technibel(IRTechnibelAc *ac, const stdAc::state_t &state);
 #endif  // SEND_TECHNIBEL_AC
 #if SEND_TECO
-  void teco(IRTecoAc *ac,
-            const bool on, const stdAc::opmode_t mode, const float degrees,
-            const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-            const bool light, const int16_t sleep = -1);
+  static void teco(IRTecoAc *ac, const stdAc::state_t &state);
 #endif  // SEND_TECO
 #if SEND_TOSHIBA_AC
-  void toshiba(IRToshibaAC *ac,
-               const bool on, const stdAc::opmode_t mode, const float degrees,
-               const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-               const bool turbo, const bool econo);
+  static void toshiba(IRToshibaAC *ac, const stdAc::state_t &state,
+                      const bool sendSwing = true);
 #endif  // SEND_TOSHIBA_AC
 #if SEND_TROTEC
-  void trotec(IRTrotecESP *ac,
-              const bool on, const stdAc::opmode_t mode, const float degrees,
-              const stdAc::fanspeed_t fan, const int16_t sleep = -1);
+  static void trotec(IRTrotecESP *ac, const stdAc::state_t &state);
 #endif  // SEND_TROTEC
 #if SEND_VESTEL_AC
-  void vestel(IRVestelAc *ac,
-              const bool on, const stdAc::opmode_t mode, const float degrees,
-              const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-              const bool turbo, const bool filter,
-              const int16_t sleep = -1, const int16_t clock = -1,
-              const bool sendNormal = true);
+  static void vestel(IRVestelAc *ac, const stdAc::state_t &state,
+                     const int16_t clock = -1, const bool sendNormal = true);
 #endif  // SEND_VESTEL_AC
 #if SEND_VOLTAS
-  void voltas(IRVoltas *ac, const voltas_ac_remote_model_t model,
-              const bool on, const stdAc::opmode_t mode,
-              const float degrees, const stdAc::fanspeed_t fan,
-              const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
-              const bool turbo, const bool econo, const bool light,
-              const int16_t sleep = -1);
+  static void voltas(IRVoltas *ac, const stdAc::state_t &state);
 #endif  // SEND_VOLTAS
 #if SEND_WHIRLPOOL_AC
-  void whirlpool(IRWhirlpoolAc *ac, const whirlpool_ac_remote_model_t model,
-                 const bool on, const stdAc::opmode_t mode, const float degrees,
-                 const stdAc::fanspeed_t fan, const stdAc::swingv_t swingv,
-                 const bool turbo, const bool light,
-                 const int16_t sleep = -1, const int16_t clock = -1);
+  static void whirlpool(IRWhirlpoolAc *ac, const stdAc::state_t &state);
 #endif  // SEND_WHIRLPOOL_AC
-static stdAc::state_t cleanState(const stdAc::state_t state);
-static stdAc::state_t handleToggles(const stdAc::state_t desired,
+static stdAc::state_t cleanState(const stdAc::state_t &state);
+static stdAc::state_t handleToggles(const stdAc::state_t &desired,
                                     const stdAc::state_t *prev = NULL);
+friend class IRacBatch;
+friend class IRacPackedState;
+template <decode_type_t> friend struct IRacTraits;
+template <decode_type_t> friend class IRacT;
 };  // IRac class
 
+/// What `IRacT` (& `IRac`) needs to know about a protocol. i.e. The class it
+/// is sent with (`ac_t`, made with a GPIO, inverted & use_modulation) & how to
+/// send a state with it (`send(ac, state, prev, delta)`, where `delta` is if
+/// only what changed from `prev` needs sending). Unsupported or disabled
+/// protocols have none.
+/// @tparam P The protocol.
+template <decode_type_t P> struct IRacTraits;
+
+// The traits of a protocol that only needs the state to send it.
+#define IRAC_TRAITS(PROTOCOL, CLASS, HELPER) \
+template <> struct IRacTraits<decode_type_t::PROTOCOL> { \
+  typedef CLASS ac_t; \
+  static void send(ac_t *ac, const stdAc::state_t &state, \
+                   const stdAc::state_t *, const bool) { \
+    IRac::HELPER(ac, state); \
+  } \
+}
+
+#if SEND_AIRWELL
+IRAC_TRAITS(AIRWELL, IRAirwellAc, airwell);
+#endif  // SEND_AIRWELL
+#if SEND_AMCOR
+IRAC_TRAITS(AMCOR, IRAmcorAc, amcor);
+#endif  // SEND_AMCOR
+#if SEND_ARGO
+IRAC_TRAITS(ARGO, IRArgoAC, argo);
+#endif  // SEND_ARGO
+#if SEND_CARRIER_AC64
+IRAC_TRAITS(CARRIER_AC64, IRCarrierAc64, carrier64);
+#endif  // SEND_CARRIER_AC64
+#if SEND_COOLIX
+IRAC_TRAITS(COOLIX, IRCoolixAC, coolix);
+#endif  // SEND_COOLIX
+#if SEND_CORONA_AC
+IRAC_TRAITS(CORONA_AC, IRCoronaAc, corona);
+#endif  // SEND_CORONA_AC
+#if SEND_DAIKIN
+IRAC_TRAITS(DAIKIN, IRDaikinESP, daikin);
+#endif  // SEND_DAIKIN
+#if SEND_DAIKIN128
+IRAC_TRAITS(DAIKIN128, IRDaikin128, daikin128);
+#endif  // SEND_DAIKIN128
+#if SEND_DAIKIN152
+IRAC_TRAITS(DAIKIN152, IRDaikin152, daikin152);
+#endif  // SEND_DAIKIN152
+#if SEND_DAIKIN160
+IRAC_TRAITS(DAIKIN160, IRDaikin160, daikin160);
+#endif  // SEND_DAIKIN160
+#if SEND_DAIKIN176
+IRAC_TRAITS(DAIKIN176, IRDaikin176, daikin176);
+#endif  // SEND_DAIKIN176
+#if SEND_DAIKIN2
+IRAC_TRAITS(DAIKIN2, IRDaikin2, daikin2);
+#endif  // SEND_DAIKIN2
+#if SEND_DAIKIN216
+IRAC_TRAITS(DAIKIN216, IRDaikin216, daikin216);
+#endif  // SEND_DAIKIN216
+#if SEND_DAIKIN64
+IRAC_TRAITS(DAIKIN64, IRDaikin64, daikin64);
+#endif  // SEND_DAIKIN64
+#if SEND_DELONGHI_AC
+IRAC_TRAITS(DELONGHI_AC, IRDelonghiAc, delonghiac);
+#endif  // SEND_DELONGHI_AC
+#if SEND_ELECTRA_AC
+IRAC_TRAITS(ELECTRA_AC, IRElectraAc, electra);
+#endif  // SEND_ELECTRA_AC
+#if SEND_FUJITSU_AC
+template <> struct IRacTraits<decode_type_t::FUJITSU_AC> {
+  /// The model is set from the state when it is sent.
+  class ac_t : public IRFujitsuAC {
+   public:
+    ac_t(const uint16_t pin, const bool inverted, const bool use_modulation)
+        : IRFujitsuAC(pin, ARRAH2E, inverted, use_modulation) {}
+  };
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *, const bool) {
+    IRac::fujitsu(ac, state);
+  }
+};
+#endif  // SEND_FUJITSU_AC
+#if SEND_GOODWEATHER
+IRAC_TRAITS(GOODWEATHER, IRGoodweatherAc, goodweather);
+#endif  // SEND_GOODWEATHER
+#if SEND_GREE
+template <> struct IRacTraits<decode_type_t::GREE> {
+  /// The model is set from the state when it is sent.
+  class ac_t : public IRGreeAC {
+   public:
+    ac_t(const uint16_t pin, const bool inverted, const bool use_modulation)
+        : IRGreeAC(pin, gree_ac_remote_model_t::YAW1F, inverted,
+                   use_modulation) {}
+  };
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *, const bool) {
+    IRac::gree(ac, state);
+  }
+};
+#endif  // SEND_GREE
+#if SEND_HAIER_AC
+IRAC_TRAITS(HAIER_AC, IRHaierAC, haier);
+#endif  // SEND_HAIER_AC
+#if SEND_HAIER_AC_YRW02
+template <> struct IRacTraits<decode_type_t::HAIER_AC_YRW02> {
+  typedef IRHaierACYRW02 ac_t;
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *prev, const bool) {
+    IRac::haierYrwo2(ac, state, prev);
+  }
+};
+#endif  // SEND_HAIER_AC_YRW02
+#if SEND_HITACHI_AC
+IRAC_TRAITS(HITACHI_AC, IRHitachiAc, hitachi);
+#endif  // SEND_HITACHI_AC
+#if SEND_HITACHI_AC1
+template <> struct IRacTraits<decode_type_t::HITACHI_AC1> {
+  typedef IRHitachiAc1 ac_t;
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *prev, const bool) {
+    bool power_toggle = false;
+    bool swing_toggle = false;
+    if (prev != NULL) {
+      power_toggle = (state.power != prev->power);
+      swing_toggle = (state.swingv != prev->swingv) ||
+                     (state.swingh != prev->swingh);
+    }
+    IRac::hitachi1(ac, state, power_toggle, swing_toggle);
+  }
+};
+#endif  // SEND_HITACHI_AC1
+#if SEND_HITACHI_AC344
+IRAC_TRAITS(HITACHI_AC344, IRHitachiAc344, hitachi344);
+#endif  // SEND_HITACHI_AC344
+#if SEND_HITACHI_AC424
+IRAC_TRAITS(HITACHI_AC424, IRHitachiAc424, hitachi424);
+#endif  // SEND_HITACHI_AC424
+#if SEND_KELVINATOR
+IRAC_TRAITS(KELVINATOR, IRKelvinatorAC, kelvinator);
+#endif  // SEND_KELVINATOR
+#if SEND_LG
+IRAC_TRAITS(LG, IRLgAc, lg);
+IRAC_TRAITS(LG2, IRLgAc, lg);
+#endif  // SEND_LG
+#if SEND_MIDEA
+IRAC_TRAITS(MIDEA, IRMideaAC, midea);
+#endif  // SEND_MIDEA
+#if SEND_MITSUBISHI_AC
+IRAC_TRAITS(MITSUBISHI_AC, IRMitsubishiAC, mitsubishi);
+#endif  // SEND_MITSUBISHI_AC
+#if SEND_MITSUBISHI112
+IRAC_TRAITS(MITSUBISHI112, IRMitsubishi112, mitsubishi112);
+#endif  // SEND_MITSUBISHI112
+#if SEND_MITSUBISHI136
+IRAC_TRAITS(MITSUBISHI136, IRMitsubishi136, mitsubishi136);
+#endif  // SEND_MITSUBISHI136
+#if SEND_MITSUBISHIHEAVY
+IRAC_TRAITS(MITSUBISHI_HEAVY_88, IRMitsubishiHeavy88Ac, mitsubishiHeavy88);
+IRAC_TRAITS(MITSUBISHI_HEAVY_152, IRMitsubishiHeavy152Ac, mitsubishiHeavy152);
+#endif  // SEND_MITSUBISHIHEAVY
+#if SEND_NEOCLIMA
+IRAC_TRAITS(NEOCLIMA, IRNeoclimaAc, neoclima);
+#endif  // SEND_NEOCLIMA
+#if SEND_PANASONIC_AC
+IRAC_TRAITS(PANASONIC_AC, IRPanasonicAc, panasonic);
+#endif  // SEND_PANASONIC_AC
+#if SEND_SAMSUNG_AC
+template <> struct IRacTraits<decode_type_t::SAMSUNG_AC> {
+  typedef IRSamsungAc ac_t;
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *prev, const bool delta) {
+    bool prev_power = !state.power;
+    if (prev != NULL) prev_power = prev->power;
+    // With `delta`, only send the (twice as long) extended power message when
+    // the power changes. Without a previous state, it is assumed to have.
+    IRac::samsung(ac, state, prev_power, !delta);
+  }
+};
+#endif  // SEND_SAMSUNG_AC
+#if SEND_SANYO_AC
+IRAC_TRAITS(SANYO_AC, IRSanyoAc, sanyo);
+#endif  // SEND_SANYO_AC
+#if SEND_SHARP_AC
+template <> struct IRacTraits<decode_type_t::SHARP_AC> {
+  typedef IRSharpAc ac_t;
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *prev, const bool) {
+    bool prev_power = !state.power;
+    if (prev != NULL) prev_power = prev->power;
+    IRac::sharp(ac, state, prev_power);
+  }
+};
+#endif  // SEND_SHARP_AC
+#if SEND_TCL112AC
+IRAC_TRAITS(TCL112AC, IRTcl112Ac, tcl112);
+#endif  // SEND_TCL112AC
+#if SEND_TECHNIBEL_AC
+IRAC_TRAITS(TECHNIBEL_AC, IRTechnibelAc, technibel);
+#endif  // SEND_TECHNIBEL_AC
+#if SEND_TECO
+IRAC_TRAITS(TECO, IRTecoAc, teco);
+#endif  // SEND_TECO
+#if SEND_TOSHIBA_AC
+template <> struct IRacTraits<decode_type_t::TOSHIBA_AC> {
+  typedef IRToshibaAC ac_t;
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *prev, const bool delta) {
+    // The separate swing message is only needed if the swing changed.
+    const bool swing = !delta || prev == NULL ||
+        ((state.swingv == stdAc::swingv_t::kOff) ^
+         (prev->swingv == stdAc::swingv_t::kOff));
+    IRac::toshiba(ac, state, swing);
+  }
+};
+#endif  // SEND_TOSHIBA_AC
+#if SEND_TROTEC
+IRAC_TRAITS(TROTEC, IRTrotecESP, trotec);
+#endif  // SEND_TROTEC
+#if SEND_VESTEL_AC
+template <> struct IRacTraits<decode_type_t::VESTEL_AC> {
+  typedef IRVestelAc ac_t;
+  static void send(ac_t *ac, const stdAc::state_t &state,
+                   const stdAc::state_t *prev, const bool delta) {
+    // The settings & the time are separate messages. Only send the one(s)
+    // that changed, if we can tell.
+    bool normal = true;
+    int16_t clock = state.clock;
+    if (delta && prev != NULL) {
+      if (IRac::cmpStates(*prev, state)) {  // The settings changed.
+        if (state.clock == prev->clock) clock = -1;  // But not the time.
+      } else if (clock >= 0 && clock != prev->clock) {
+        normal = false;  // Only the time changed.
+      }
+    }
+    IRac::vestel(ac, state, clock, normal);
+  }
+};
+#endif  // SEND_VESTEL_AC
+#if SEND_VOLTAS
+IRAC_TRAITS(VOLTAS, IRVoltas, voltas);
+#endif  // SEND_VOLTAS
+#if SEND_WHIRLPOOL_AC
+IRAC_TRAITS(WHIRLPOOL_AC, IRWhirlpoolAc, whirlpool);
+#endif  // SEND_WHIRLPOOL_AC
+#undef IRAC_TRAITS
+
+/// Control an A/C of a single protocol, chosen at compile time, with the same
+/// `stdAc::state_t` API as `IRac`. e.g. `IRacT<decode_type_t::DAIKIN2> ac(4);`
+/// It keeps & sends with an object of the protocol's class directly, so no
+/// other protocol's code is used, & nothing is looked up per message.
+/// @note The delta sends, duplicate suppression & caches of `IRac` aren't
+///   available. The protocol of the states given to it is ignored.
+/// @tparam P The protocol. One `IRac` supports, that is enabled.
+template <decode_type_t P>
+class IRacT {
+ public:
+  typedef typename IRacTraits<P>::ac_t ac_t;  ///< The protocol's class.
+
+  /// Class constructor
+  /// @param[in] pin Gpio pin to use when transmitting IR messages.
+  /// @param[in] inverted true, gpio output defaults to high. false, to low.
+  /// @param[in] use_modulation true means use frequency modulation.
+  explicit IRacT(const uint16_t pin, const bool inverted = false,
+                 const bool use_modulation = true)
+      : _ac(pin, inverted, use_modulation) {
+    IRac::initState(&next);
+    next.protocol = P;
+    markAsSent();
+  }
+
+  /// Send an A/C message based on the desired state & the previous one.
+  /// @param[in] desired The state_t we want the device to be in.
+  /// @param[in] prev A Ptr to the state_t we believe the device is in, if any.
+  /// @return true. It can always be sent.
+  bool sendAc(const stdAc::state_t &desired,
+              const stdAc::state_t *prev = NULL) {
+    stdAc::state_t send = desired;
+    send.protocol = P;
+    stdAc::state_t was;
+    if (prev != NULL) {
+      was = *prev;
+      was.protocol = P;
+      prev = &was;
+    }
+    IRac::_cleanState(&send);
+    IRac::_handleToggles(&send, prev);
+    IRacTraits<P>::send(&_ac, send, prev, false);
+    return true;
+  }
+
+  /// Send the `next` state, based on what was last sent, then remember it
+  /// as sent.
+  /// @return true. It can always be sent.
+  bool sendAc(void) {
+    sendAc(next, &_prev);
+    markAsSent();
+    return true;
+  }
+
+  /// Update the previous state to the current one.
+  void markAsSent(void) { _prev = next; }
+
+  /// Get the current internal A/C climate state.
+  /// @return A copy of the `next` state.
+  stdAc::state_t getState(void) { return next; }
+
+  /// Get the previous internal A/C climate state that should have already
+  /// been sent to the device.
+  /// @return A copy of the previously sent state.
+  stdAc::state_t getStatePrev(void) { return _prev; }
+
+  stdAc::state_t next;  ///< The state we want the device to be in after we send
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  ac_t _ac;  ///< What sends the messages.
+  stdAc::state_t _prev;  ///< The state we expect the device to currently be in.
+};
+
+/// Send the new states of many A/Cs in as little time as possible.
+/// Every message is computed when it is added, & `handle()` (called from
+/// `loop()`) sends them one after the other from each GPIO. Messages for A/Cs
+/// on different GPIOs are sent at the same time if the `IRsend` objects of
+/// those GPIOs can send in the background. See `getEmitter()`.
+class IRacBatch {
+ public:
+  explicit IRacBatch(const uint8_t size = kIRacBatchDefaultSize,
+                     const uint16_t frame_size = kSequenceDefaultSize);
+  ~IRacBatch(void);
+  bool add(IRac *ac, const stdAc::state_t &state);
+  bool handle(void);
+  uint8_t pending(void);
+  void clear(void);
+  void setGap(const uint32_t usecs);
+  uint32_t getGap(void);
+  IRsend *getEmitter(const uint16_t pin);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  irac_batch_entry_t *_entries;
+  uint8_t _size;
+  IRsequence *_scratch;  // Where a message is computed before it is copied.
+  irac_batch_emitter_t _emitters[kIRacBatchMaxEmitters];
+  uint8_t _emitter_count;
+  uint32_t _order;  // The order of the next message added.
+  uint32_t _gap;  // Extra time between messages from the same GPIO. (usecs)
+  int8_t _findEmitter(const IRac *ac);
+  irac_batch_entry_t *_next(const uint8_t emitter);
+  IRacBatch(const IRacBatch &);  // Not copyable, as it owns memory.
+  IRacBatch &operator=(const IRacBatch &);
+};
+
+/// A common A/C state, bit-packed into 8 bytes of RAM, rather than the ~40 of
+/// a `stdAc::state_t`. e.g. To keep the states of many A/Cs.
+/// It holds what the binary form of `IRac::stateToBinary()` does, so the
+/// temperature is kept to the nearest half degree.
+class IRacPackedState {
+ public:
+  IRacPackedState(void);
+  explicit IRacPackedState(const stdAc::state_t &state);
+  bool set(const stdAc::state_t &state);
+  stdAc::state_t get(void);
+  bool operator==(const IRacPackedState &other) const;
+  bool operator!=(const IRacPackedState &other) const;
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  uint64_t _bits;
+};
+
+/// What many `IRacChannel`s share. i.e. One `IRac` that computes all their
+/// messages, & one `IRsend` per GPIO that sends them.
+class IRacEngine {
+ public:
+  explicit IRacEngine(const bool inverted = false,
+                      const bool use_modulation = true,
+                      const uint16_t frame_size = kSequenceDefaultSize);
+  ~IRacEngine(void);
+  bool sendAc(const uint16_t pin, const stdAc::state_t &desired,
+              const stdAc::state_t *prev = NULL);
+  IRsend *getEmitter(const uint16_t pin);
+  IRac ac;  ///< Computes the messages. Its settings apply to every channel.
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRsequence *_scratch;  // Where a message is computed before it is sent.
+  irac_batch_send_t *_emitters[kIRacEngineMaxEmitters];
+  uint16_t _pins[kIRacEngineMaxEmitters];
+  uint8_t _emitter_count;
+  bool _inverted;  // Is the IR LED lit when a GPIO is LOW?
+  bool _modulation;  // Is frequency modulation to be used?
+  IRacEngine(const IRacEngine &);  // Not copyable, as it owns memory.
+  IRacEngine &operator=(const IRacEngine &);
+};
+
+/// Control one of many A/Cs, with the same `stdAc::state_t` API as `IRac`,
+/// in a few bytes of RAM, rather than a whole `IRac` per A/C.
+/// Its messages are computed & sent by an `IRacEngine`, shared by them all.
+/// e.g.
+/// @code
+///   IRacEngine engine;
+///   IRacChannel lounge(&engine, 4), bedroom(&engine, 4), office(&engine, 5);
+///   stdAc::state_t state = lounge.getState();
+///   state.protocol = decode_type_t::DAIKIN;
+///   state.power = true;
+///   lounge.sendAc(state);
+/// @endcode
+class IRacChannel {
+ public:
+  IRacChannel(IRacEngine *engine, const uint16_t pin);
+  bool setState(const stdAc::state_t &state);
+  stdAc::state_t getState(void);
+  stdAc::state_t getStatePrev(void);
+  bool hasStateChanged(void);
+  void markAsSent(void);
+  bool sendAc(void);
+  bool sendAc(const stdAc::state_t &desired);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRacEngine *_engine;
+  IRacPackedState _next;  // The state we want the A/C to be in.
+  IRacPackedState _prev;  // The state we expect the A/C to currently be in.
+  uint16_t _pin;
+};
+
 /// Common functions for use with all A/Cs supported by the IRac class.
 namespace IRAcUtils {
+  bool isProtocolDecodable(const decode_type_t protocol);
   String resultAcToString(const decode_results * const results);
   bool decodeToState(const decode_results *decode, stdAc::state_t *result,
                      const stdAc::state_t *prev = NULL);
 }  // namespace IRAcUtils
+
+/// Convert A/C messages into common A/C states, like
+/// `IRAcUtils::decodeToState()`, but remember the last message of each
+/// protocol so a repeat of it (e.g. from a remote that sends its whole state
+/// every time) is spotted quickly, without converting it all again.
+class IRAcDecoder {
+ public:
+  explicit IRAcDecoder(const uint8_t size = kIRAcDecoderDefaultSize);
+  ~IRAcDecoder(void);
+  irac_decode_status_t decode(const decode_results *decode,
+                              stdAc::state_t *result,
+                              const stdAc::state_t *prev = NULL);
+  void clear(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  irac_decoded_t *_entries;
+  uint8_t _size;
+  uint32_t _clock;  // Increases every time an entry is used.
+  IRAcDecoder(const IRAcDecoder &);  // Not copyable, as it owns memory.
+  IRAcDecoder &operator=(const IRAcDecoder &);
+};
 #endif  // IRAC_H_
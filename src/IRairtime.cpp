@@ -0,0 +1,334 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRairtime.cpp
+/// @brief Coordinated sending, so overlapping nodes' frames don't collide.
+
+#include "IRairtime.h"
+
+/// Class constructor.
+/// @param[in] node Which node this is. Unique amongst those it shares the air
+///   with. Used to settle clashing reservations.
+/// @param[in] size Max. nr. of frames that can wait for their time.
+IRairtime::IRairtime(const uint8_t node, const uint8_t size) {
+  _entries = new ir_airtime_entry_t[size];
+  _size = (_entries != NULL) ? size : 0;
+  for (uint8_t i = 0; i < _size; i++) _entries[i].frame = NULL;
+  _node = node;
+  _order = 0;
+  _base = 0;
+  _synced = false;
+  _slot_length = 0;
+  _slot_count = 0;
+  _slot = 0;
+  _reserve = false;
+  _lead = kAirtimeDefaultLead;
+  _guard = kAirtimeDefaultGuard;
+  _other_count = 0;
+}
+
+/// Class destructor.
+IRairtime::~IRairtime(void) {
+  clear();
+  delete[] _entries;
+}
+
+/// Set the shared time base. i.e. The time all the nodes agree on. Call it
+/// again from time to time (e.g. Each NTP update) to keep it from drifting.
+/// @param[in] now The shared time now. (mSeconds) e.g. Since the Unix epoch.
+/// @note Set it before frames are added. They are planned in it.
+void IRairtime::setTime(const uint64_t now) {
+  _base = now;
+  _since.reset();
+  _synced = true;
+}
+
+/// Get the shared time. See `setTime()`.
+/// @return The time now. (mSeconds) Since it was created, if never set.
+uint64_t IRairtime::now(void) {
+  const uint32_t elapsed = _since.elapsed();
+  if (elapsed >= (1UL << 30)) {  // Move on the base before the timer wraps.
+    _base += elapsed;
+    _since.reset();
+    return _base;
+  }
+  return _base + elapsed;
+}
+
+/// Has the shared time base been set? See `setTime()`.
+/// @return true, if it has.
+bool IRairtime::isSynced(void) const { return _synced; }
+
+/// Get which node this is.
+/// @return The node.
+uint8_t IRairtime::getNode(void) const { return _node; }
+
+/// Only send in our own time slot. The shared time is split into repeating
+/// cycles of `count` slots, & each node sends only in its own one. Frames
+/// are planned to fit in a slot, so make them at least as long as the
+/// longest frame (incl. repeats).
+/// @param[in] length The length of each slot. (mSeconds) 0 to not use slots.
+/// @param[in] count The nr. of slots in a cycle. i.e. Of nodes.
+/// @param[in] slot Our slot. From 0 to `count` - 1.
+void IRairtime::setSlots(const uint32_t length, const uint8_t count,
+                         const uint8_t slot) {
+  if (count < 2 || slot >= count) {
+    _slot_length = 0;  // Nobody to take turns with. (or a bad slot)
+  } else {
+    _slot_length = length;
+    _slot_count = count;
+    _slot = slot;
+  }
+}
+
+/// Use reservations. i.e. Plan each frame at least `lead` mSeconds ahead, &
+/// hand out the period it needs via `announce()` for the other nodes to hear.
+/// Frames are always planned around the reservations of other nodes that
+/// `addReservation()` was given, whether or not this is set.
+/// @param[in] enable Use them?
+/// @param[in] lead Time the others need to hear of a reservation. (mSeconds)
+void IRairtime::setReservations(const bool enable, const uint16_t lead) {
+  _reserve = enable;
+  _lead = lead;
+}
+
+/// Set the time to keep clear between our frames & other nodes'. i.e. For
+/// their clocks to differ by, & the receivers to settle.
+/// @param[in] guard Nr. of mSeconds.
+void IRairtime::setGuard(const uint16_t guard) { _guard = guard; }
+
+/// Add the reservation of another node. e.g. As heard via MQTT.
+/// Any of our planned frames it clashes with are planned again, unless ours
+/// is the lower node.
+/// @param[in] reservation The other node's reservation.
+/// @return true, if it was added. false if it was our own, is already over,
+///   or too many others are held.
+bool IRairtime::addReservation(const ir_airtime_reservation_t &reservation) {
+  if (reservation.node == _node ||
+      reservation.start + reservation.duration <= now())
+    return false;
+  _forgetPast();
+  if (_other_count >= kAirtimeMaxReservations) return false;
+  _others[_other_count++] = reservation;
+  if (reservation.node < _node) {  // They keep the time. Move ours.
+    for (uint8_t i = 0; i < _size; i++) {
+      ir_airtime_entry_t *entry = &_entries[i];
+      if (entry->frame != NULL && !entry->fixed &&
+          _overlaps(entry->slot, reservation))
+        _replan(entry);
+    }
+  }
+  return true;
+}
+
+/// Get the next reservation for the other nodes to hear of. e.g. To publish
+/// via MQTT. Each is handed out once, & again if its frame is planned again.
+/// @param[out] reservation Where to store it.
+/// @return true, if there was one. Otherwise false.
+bool IRairtime::announce(ir_airtime_reservation_t *reservation) {
+  ir_airtime_entry_t *next = NULL;
+  for (uint8_t i = 0; i < _size; i++) {
+    ir_airtime_entry_t *entry = &_entries[i];
+    if (entry->frame != NULL && !entry->announced &&
+        (next == NULL || entry->slot.start < next->slot.start))
+      next = entry;
+  }
+  if (next == NULL) return false;
+  next->announced = true;
+  *reservation = next->slot;
+  return true;
+}
+
+/// Add a frame to send when it is its time to.
+/// @param[in] irsend A Ptr to the `IRsend` object to send it with.
+/// @param[in] frame A Ptr to the frame. e.g. Recorded with
+///   `IRsend::startRecording()`. It is copied.
+/// @param[in] at When to send it, in the shared time. (mSeconds) 0 means as
+///   soon as it can be. i.e. In our next slot, & clear of the reservations of
+///   the other nodes.
+/// @return true, if it was added. false if there is no room for it.
+/// @note A frame with a given time is sent at it, whatever the slots &
+///   reservations. Other nodes still hear of it via `announce()`.
+bool IRairtime::add(IRsend *irsend, const IRsequence *frame,
+                    const uint64_t at) {
+  if (irsend == NULL || frame == NULL || !frame->length()) return false;
+  ir_airtime_entry_t *entry = NULL;
+  for (uint8_t i = 0; i < _size && entry == NULL; i++)
+    if (_entries[i].frame == NULL) entry = &_entries[i];
+  if (entry == NULL) return false;
+  IRsequence *copy = new IRsequence(frame->length());
+  if (copy == NULL || !copy->set(frame->durations(), frame->length(),
+                                 frame->frequency(), frame->dutyCycle())) {
+    delete copy;
+    return false;
+  }
+  entry->irsend = irsend;
+  entry->slot.duration = (frame->duration() + 999) / 1000;
+  entry->slot.node = _node;
+  entry->fixed = (at != 0);
+  entry->order = _order++;
+  if (entry->fixed) {
+    entry->slot.start = at;
+    entry->announced = !_reserve;
+  } else {
+    _replan(entry);
+  }
+  entry->frame = copy;
+  return true;
+}
+
+/// Get the nr. of frames waiting for their time.
+/// @return The nr. of frames.
+uint8_t IRairtime::pending(void) const {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < _size; i++)
+    if (_entries[i].frame != NULL) count++;
+  return count;
+}
+
+/// Get when the next frame is due to be sent.
+/// @return The shared time (mSeconds), or 0 if no frame is waiting.
+uint64_t IRairtime::nextStart(void) const {
+  uint64_t next = 0;
+  for (uint8_t i = 0; i < _size; i++)
+    if (_entries[i].frame != NULL &&
+        (next == 0 || _entries[i].slot.start < next))
+      next = _entries[i].slot.start;
+  return next;
+}
+
+/// Forget every frame waiting to be sent.
+void IRairtime::clear(void) {
+  for (uint8_t i = 0; i < _size; i++) {
+    delete _entries[i].frame;
+    _entries[i].frame = NULL;
+  }
+}
+
+/// Send the next frame, if it is its time. Call it often. e.g. From `loop()`.
+/// @return true, if a frame was sent (or started). Otherwise false.
+/// @note A planned frame whose slot has passed before it could be sent
+///   (e.g. `handle()` wasn't called for a while) is planned again, rather
+///   than being sent outside of it.
+bool IRairtime::handle(void) {
+  const uint64_t time = now();
+  ir_airtime_entry_t *next = NULL;
+  for (uint8_t i = 0; i < _size; i++) {
+    ir_airtime_entry_t *entry = &_entries[i];
+    if (entry->frame == NULL || entry->slot.start > time) continue;
+    if (next == NULL || entry->slot.start < next->slot.start ||
+        (entry->slot.start == next->slot.start &&
+         (uint8_t)(entry->order - next->order) >= 0x80))
+      next = entry;
+  }
+  if (next == NULL) return false;
+  if (!next->fixed && _inSlot(time, next->slot.duration) != time) {
+    _replan(next);  // Too late for its slot.
+    return false;
+  }
+  return _send(next);
+}
+
+/// Does one reservation clash with another? Incl. the guard time.
+/// @param[in] a A reservation.
+/// @param[in] b Another reservation.
+/// @return true, if they do.
+bool IRairtime::_overlaps(const ir_airtime_reservation_t &a,
+                          const ir_airtime_reservation_t &b) const {
+  return a.start < b.start + b.duration + _guard &&
+         b.start < a.start + a.duration + _guard;
+}
+
+/// Find the earliest time, from a given one, that a frame fits in our slot.
+/// @param[in] start The earliest time. (mSeconds)
+/// @param[in] duration The length of the frame. (mSeconds)
+/// @return The time. `start` itself if slots aren't used.
+/// @note A frame longer than a slot starts at the start of one.
+uint64_t IRairtime::_inSlot(const uint64_t start,
+                            const uint32_t duration) const {
+  if (!_slot_length) return start;
+  const uint64_t period = (uint64_t)_slot_length * _slot_count;
+  uint64_t slot = start - start % period + (uint64_t)_slot * _slot_length;
+  if (slot + _slot_length <= start) slot += period;  // It's past this cycle's.
+  if (start <= slot) return slot;
+  // Part way through our slot. Is there room left?
+  if (start + duration <= slot + _slot_length) return start;
+  return slot + period;
+}
+
+/// Find the earliest time, from a given one, a frame can be sent. i.e. In our
+/// slot, & clear of every reservation (ours & the other nodes').
+/// @param[in] earliest The earliest time. (mSeconds)
+/// @param[in] duration The length of the frame. (mSeconds)
+/// @param[in] skip The entry being planned, if any. It isn't in the way.
+/// @return The time.
+uint64_t IRairtime::_plan(const uint64_t earliest, const uint32_t duration,
+                          const ir_airtime_entry_t *skip) const {
+  ir_airtime_reservation_t plan;
+  plan.start = earliest;
+  plan.duration = duration;
+  // Each move passes a reservation, so this many is enough to be clear of
+  // them all. More if it is a slot that moves it, but then it is a new cycle.
+  const uint16_t limit = 2 * (_size + _other_count + 1);
+  for (uint16_t tries = 0; tries < limit; tries++) {
+    plan.start = _inSlot(plan.start, duration);
+    bool moved = false;
+    for (uint8_t i = 0; i < _other_count; i++) {
+      if (_overlaps(plan, _others[i])) {
+        plan.start = _others[i].start + _others[i].duration + _guard;
+        moved = true;
+      }
+    }
+    for (uint8_t i = 0; i < _size; i++) {
+      const ir_airtime_entry_t *entry = &_entries[i];
+      if (entry == skip || entry->frame == NULL) continue;
+      if (_overlaps(plan, entry->slot)) {
+        plan.start = entry->slot.start + entry->slot.duration + _guard;
+        moved = true;
+      }
+    }
+    if (!moved) break;
+  }
+  return plan.start;
+}
+
+/// Plan when a frame will be sent, from now, & have it announced (again).
+/// @param[in,out] entry A Ptr to the entry of the frame.
+void IRairtime::_replan(ir_airtime_entry_t *entry) {
+  _forgetPast();
+  entry->slot.start = _plan(now() + (_reserve ? _lead : 0),
+                            entry->slot.duration, entry);
+  entry->announced = !_reserve;
+}
+
+/// Forget the reservations of other nodes that are over.
+void IRairtime::_forgetPast(void) {
+  const uint64_t time = now();
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < _other_count; i++)
+    if (_others[i].start + _others[i].duration > time)
+      _others[kept++] = _others[i];
+  _other_count = kept;
+}
+
+/// Send a frame, & forget it.
+/// @param[in,out] entry A Ptr to the entry of the frame.
+/// @return true, if it was sent (or started).
+bool IRairtime::_send(ir_airtime_entry_t *entry) {
+  IRsend *irsend = entry->irsend;
+#if IRSEND_ASYNC
+  if (irsend->isBusy()) return false;  // Still sending the one before it.
+#endif  // IRSEND_ASYNC
+  IRsequence *frame = entry->frame;
+  entry->frame = NULL;
+  bool sent = false;
+#if IRSEND_ASYNC
+  // The backend keeps its own copy of what it sends in the background.
+  if (irsend->beginAsync()) {
+    irsend->sendSequence(frame);
+    sent = irsend->sendAsync();
+  }
+#endif  // IRSEND_ASYNC
+  if (!sent) irsend->sendSequence(frame);
+  delete frame;
+  return true;
+}
@@ -0,0 +1,120 @@
+#ifndef IRAIRTIME_H_
+#define IRAIRTIME_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRtimer.h"
+
+// Constants
+/// Default nr. of frames an `IRairtime` can hold, waiting for their time.
+const uint8_t kAirtimeDefaultSize = 8;
+/// Max. nr. of other nodes' reservations an `IRairtime` remembers.
+const uint8_t kAirtimeMaxReservations = 8;
+/// Default time kept clear between our frames & other nodes'. (mSeconds)
+const uint16_t kAirtimeDefaultGuard = 20;
+/// Default time between announcing a reservation & using it. i.e. Time for
+/// the other nodes to hear of it. (mSeconds)
+const uint16_t kAirtimeDefaultLead = 100;
+
+/// A period of air time a node will transmit in.
+typedef struct {
+  uint64_t start;  ///< When it starts. (mSeconds, in the shared time base)
+  uint32_t duration;  ///< How long it lasts. (mSeconds)
+  uint8_t node;  ///< Whose it is. If two clash, the lower node keeps it.
+} ir_airtime_reservation_t;
+
+/// A frame waiting for its time to be sent.
+typedef struct {
+  IRsequence *frame;  ///< What to send. NULL if the entry is unused.
+  IRsend *irsend;  ///< What to send it with.
+  ir_airtime_reservation_t slot;  ///< When it will be sent.
+  bool fixed;  ///< Was the time given? Otherwise it was planned, & can move.
+  bool announced;  ///< Has `announce()` handed out its reservation yet?
+  uint8_t order;  ///< The order it was added in.
+} ir_airtime_entry_t;
+
+/// Shares the air between several nodes (devices) whose IR emitters overlap.
+/// e.g. IRMQTTServers in an open-plan office. Frames sent at the same time
+/// collide, & repeating them blindly only wastes more air time.
+/// Each node is given a shared time base (e.g. NTP, or the time in an MQTT
+/// message), & then either or both of:
+///  - Time slots: The nodes take turns, `count` slots of `length` mSeconds
+///    each, & only send in their own `slot`. See `setSlots()`.
+///  - Reservations: Before a frame is sent, the period it needs is handed out
+///    by `announce()` for the others to hear (e.g. via MQTT), & theirs are
+///    given to `addReservation()`. Frames are planned around the periods the
+///    others have reserved. If two nodes reserve the same time, the lower
+///    node keeps it, & the other plans its frame again.
+/// Frames can also be sent at an absolute (shared) time.
+/// `handle()` (called from `loop()`) sends each frame when its time comes, in
+/// the background if the `IRsend` object can. See `IRsend::beginAsync()`.
+/// e.g.
+/// @code
+///   IRairtime airtime(kMyNode);
+///   airtime.setTime(ntp_millis);
+///   airtime.setSlots(500, kNrOfNodes, kMyNode);
+///   ...
+///   irsend.startRecording(&frame);
+///   irsend.sendNEC(0x20DF10EF);
+///   irsend.stopRecording();
+///   airtime.add(&irsend, &frame);
+///   ...
+///   void loop() { airtime.handle(); ... }
+/// @endcode
+class IRairtime {
+ public:
+  explicit IRairtime(const uint8_t node = 0,
+                     const uint8_t size = kAirtimeDefaultSize);
+  ~IRairtime(void);
+  void setTime(const uint64_t now);
+  uint64_t now(void);
+  bool isSynced(void) const;
+  uint8_t getNode(void) const;
+  void setSlots(const uint32_t length, const uint8_t count,
+                const uint8_t slot);
+  void setReservations(const bool enable,
+                       const uint16_t lead = kAirtimeDefaultLead);
+  void setGuard(const uint16_t guard);
+  bool addReservation(const ir_airtime_reservation_t &reservation);
+  bool announce(ir_airtime_reservation_t *reservation);
+  bool add(IRsend *irsend, const IRsequence *frame, const uint64_t at = 0);
+  uint8_t pending(void) const;
+  uint64_t nextStart(void) const;
+  void clear(void);
+  bool handle(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  ir_airtime_entry_t *_entries;
+  uint8_t _size;
+  uint8_t _node;
+  uint8_t _order;  // The order of the next entry added.
+  uint64_t _base;  // The shared time when `_since` was reset. (mSeconds)
+  TimerMs _since;
+  bool _synced;
+  uint32_t _slot_length;  // mSeconds. 0 if slots aren't used.
+  uint8_t _slot_count;
+  uint8_t _slot;  // Which slot is ours.
+  bool _reserve;  // Are reservations used?
+  uint16_t _lead;
+  uint16_t _guard;
+  ir_airtime_reservation_t _others[kAirtimeMaxReservations];
+  uint8_t _other_count;
+  bool _overlaps(const ir_airtime_reservation_t &a,
+                 const ir_airtime_reservation_t &b) const;
+  uint64_t _inSlot(const uint64_t start, const uint32_t duration) const;
+  uint64_t _plan(const uint64_t earliest, const uint32_t duration,
+                 const ir_airtime_entry_t *skip) const;
+  void _replan(ir_airtime_entry_t *entry);
+  void _forgetPast(void);
+  bool _send(ir_airtime_entry_t *entry);
+  IRairtime(const IRairtime &);  // Not copyable, as it owns memory.
+  IRairtime &operator=(const IRairtime &);
+};
+
+#endif  // IRAIRTIME_H_
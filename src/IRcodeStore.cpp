@@ -0,0 +1,683 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRcodeStore.cpp
+/// @brief A compact, indexed, read-only store of named IR codes, & an index
+///   of received codes to actions.
+
+#include "IRcodeStore.h"
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif
+#include <string.h>
+#include <algorithm>
+#include "IRutils.h"
+#if defined(UNIT_TEST) && !defined(memcpy_P)
+#define memcpy_P memcpy  // Pretend we have memcpy_P() even if we really don't.
+#endif  // defined(UNIT_TEST) && !defined(memcpy_P)
+
+// FNV-1a. Cheap, & good enough at spreading short names.
+const uint32_t kCodeStoreHashBasis = 2166136261UL;
+const uint32_t kCodeStoreHashPrime = 16777619UL;
+// Nr. of bytes of a record's payload, per kind.
+const uint8_t kCodeStoreValueSize = 14;
+const uint8_t kCodeStoreStateHeaderSize = 4;
+const uint8_t kCodeStoreRawHeaderSize = 7;
+
+/// Class constructor.
+/// @param[in] image The image. It can be in PROGMEM. It isn't copied, so it
+///   has to last as long as the store is used.
+/// @param[in] size Nr. of bytes of `image`.
+/// @note An image that isn't valid is treated as if it holds no codes.
+IRcodeStore::IRcodeStore(const uint8_t *image, const uint32_t size)
+    : _image(image), _size(size), _count(0), _index(0) {
+  if (_image == NULL || _size < kCodeStoreHeaderSize) return;
+  char magic[4];
+  _read(0, magic, sizeof(magic));
+  uint8_t version;
+  _read(4, &version, 1);
+  if (memcmp(magic, kCodeStoreMagic, sizeof(magic)) ||
+      version != kCodeStoreVersion || _read32(12) > _size)
+    return;
+  _size = _read32(12);
+  const uint16_t count = _read16(6);
+  _index = _read32(8);
+  if (_index < kCodeStoreHeaderSize ||
+      _index + (uint32_t)count * kCodeStoreIndexEntrySize > _size)
+    return;
+  _count = count;
+}
+
+/// Is the image a valid one? See `IRcodeStore` for its format.
+/// @return true, if it is. Otherwise false.
+bool IRcodeStore::isValid(void) const { return _index != 0; }
+
+/// Get the nr. of codes in the store.
+/// @return The nr. of codes. 0 if the image isn't valid.
+uint16_t IRcodeStore::count(void) const { return _count; }
+
+/// Read some bytes of the image.
+/// @param[in] offset Where from.
+/// @param[out] dst Where to put them.
+/// @param[in] length Nr. of bytes to read.
+void IRcodeStore::_read(const uint32_t offset, void *dst,
+                        const uint16_t length) const {
+  memcpy_P(dst, _image + offset, length);
+}
+
+/// Read a 16 bit value from the image.
+/// @param[in] offset Where from.
+/// @return The value.
+uint16_t IRcodeStore::_read16(const uint32_t offset) const {
+  uint8_t bytes[2];
+  _read(offset, bytes, sizeof(bytes));
+  return bytes[0] | (uint16_t)bytes[1] << 8;
+}
+
+/// Read a 32 bit value from the image.
+/// @param[in] offset Where from.
+/// @return The value.
+uint32_t IRcodeStore::_read32(const uint32_t offset) const {
+  return _read16(offset) | (uint32_t)_read16(offset + 2) << 16;
+}
+
+/// Calculate the hash a code's name is indexed by.
+/// @param[in] name The name of the code.
+/// @return The hash.
+uint32_t IRcodeStore::hash(const char *name) {
+  uint32_t result = kCodeStoreHashBasis;
+  for (; *name; name++) {
+    result ^= (uint8_t)*name;
+    result *= kCodeStoreHashPrime;
+  }
+  return result;
+}
+
+/// Read the record of a code, if it has the given name.
+/// @param[in] offset Where the record is.
+/// @param[in] name The name it should have. NULL for any name.
+/// @param[out] code Where to store what the record holds.
+/// @return true, if it has the name & is valid. Otherwise false.
+bool IRcodeStore::_parse(const uint32_t offset, const char *name,
+                         ircode_t *code) const {
+  if (offset + 2 > _index) return false;
+  uint8_t header[2];  // The kind, & the length of the name.
+  _read(offset, header, sizeof(header));
+  uint32_t pos = offset + sizeof(header);
+  if (pos + header[1] > _index) return false;
+  if (name != NULL) {
+    for (uint8_t i = 0; i < header[1]; i++) {
+      uint8_t c;
+      _read(pos + i, &c, 1);
+      if (c != (uint8_t)name[i]) return false;
+    }
+    if (name[header[1]]) return false;  // It is longer.
+  }
+  pos += header[1];
+  memset(code, 0, sizeof(*code));
+  code->kind = (ir_code_kind_t)header[0];
+  code->protocol = decode_type_t::UNKNOWN;
+  uint32_t length = 0;  // Nr. of bytes of the data.
+  switch (code->kind) {
+    case kCodeValue:
+      if (pos + kCodeStoreValueSize > _index) return false;
+      code->protocol = (decode_type_t)(int16_t)_read16(pos);
+      code->bits = _read16(pos + 2);
+      code->repeat = _read16(pos + 4);
+      code->value = _read32(pos + 6) | (uint64_t)_read32(pos + 10) << 32;
+      return true;
+    case kCodeState:
+      if (pos + kCodeStoreStateHeaderSize > _index) return false;
+      code->protocol = (decode_type_t)(int16_t)_read16(pos);
+      code->length = _read16(pos + 2);
+      code->data = pos + kCodeStoreStateHeaderSize;
+      length = code->length;
+      break;
+    case kCodeRaw:
+      if (pos + kCodeStoreRawHeaderSize > _index) return false;
+      code->frequency = _read32(pos);
+      _read(pos + 4, &code->duty, 1);
+      code->length = _read16(pos + 5);
+      code->data = pos + kCodeStoreRawHeaderSize;
+      length = code->length * 2;
+      break;
+    case kCodeAc:
+      code->length = kIRacStateBinaryLength;
+      code->data = pos;
+      length = code->length;
+      break;
+    default:
+      return false;
+  }
+  return code->data + length <= _index;
+}
+
+/// Find a code by its name. A binary search of the index, so it takes
+/// O(log n) steps, & only the matching record is read.
+/// @param[in] name The name of the code.
+/// @param[out] code Where to store what it holds. Its data stays in the image.
+/// @return true, if it was found. Otherwise false.
+bool IRcodeStore::find(const char *name, ircode_t *code) const {
+  if (name == NULL || code == NULL) return false;
+  const uint32_t wanted = hash(name);
+  // The first entry with the hash, if there is one.
+  uint16_t low = 0;
+  uint16_t high = _count;
+  while (low < high) {
+    const uint16_t mid = low + (high - low) / 2;
+    if (_read32(_index + (uint32_t)mid * kCodeStoreIndexEntrySize) < wanted)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  // Names with the same hash are next to each other.
+  for (; low < _count; low++) {
+    const uint32_t entry = _index + (uint32_t)low * kCodeStoreIndexEntrySize;
+    if (_read32(entry) != wanted) break;
+    if (_parse(_read32(entry + 4), name, code)) return true;
+  }
+  return false;
+}
+
+/// Get a code by its entry in the index. e.g. To go through all of them, or
+/// for the action an `IRcodeIndex` found.
+/// @param[in] entry The entry. i.e. 0 to `count()` - 1.
+/// @param[out] code Where to store what it holds. Its data stays in the image.
+/// @return true, if there is such a valid code. Otherwise false.
+bool IRcodeStore::get(const uint16_t entry, ircode_t *code) const {
+  if (entry >= _count || code == NULL) return false;
+  return _parse(_read32(_index + (uint32_t)entry * kCodeStoreIndexEntrySize +
+                        4), NULL, code);
+}
+
+/// Get the name of a code by its entry in the index.
+/// @param[in] entry The entry. i.e. 0 to `count()` - 1.
+/// @param[out] name Where to store it. It is always terminated.
+/// @param[in] size Nr. of chars `name` can hold. Longer names are truncated.
+/// @return true, if there is such a code. Otherwise false.
+bool IRcodeStore::getName(const uint16_t entry, char *name,
+                          const uint16_t size) const {
+  if (entry >= _count || name == NULL || !size) return false;
+  const uint32_t offset = _read32(_index +
+                                  (uint32_t)entry * kCodeStoreIndexEntrySize +
+                                  4);
+  if (offset + 2 > _index) return false;
+  uint8_t length;
+  _read(offset + 1, &length, 1);
+  if (offset + 2 + length > _index) return false;
+  if (length >= size) length = size - 1;
+  _read(offset + 2, name, length);
+  name[length] = '\0';
+  return true;
+}
+
+/// Send a code by its name. See `find()`.
+/// @param[in] name The name of the code.
+/// @param[in] irsend What to send it with.
+/// @return true, if it was found & sent. Otherwise false.
+bool IRcodeStore::send(const char *name, IRsend *irsend) const {
+  ircode_t code;
+  return find(name, &code) && send(code, irsend);
+}
+
+/// Send a code. Raw codes are read from the image as they are sent.
+/// @param[in] code The code. See `find()`.
+/// @param[in] irsend What to send it with.
+/// @return true, if it was sent. Otherwise false. e.g. An A/C code, which needs
+///   an `IRac`, or a protocol that isn't enabled.
+bool IRcodeStore::send(const ircode_t &code, IRsend *irsend) const {
+  if (irsend == NULL) return false;
+  switch (code.kind) {
+    case kCodeValue:
+      return irsend->send(code.protocol, code.value,
+                          code.bits ? code.bits
+                                    : IRsend::defaultBits(code.protocol),
+                          code.repeat);
+    case kCodeState: {
+      // N.B. A state can't be sent straight out of PROGMEM.
+      uint8_t state[kSendStateSizeMax ? kSendStateSizeMax : 1];
+      if (code.length > kSendStateSizeMax) return false;
+      _read(code.data, state, code.length);
+      return irsend->send(code.protocol, state, code.length);
+    }
+    case kCodeRaw:
+      if (!code.length) return false;
+      irsend->enableIROut(code.frequency, code.duty);
+      for (uint16_t i = 0; i < code.length; i++) {
+        const uint16_t usecs = _read16(code.data + i * 2);
+        if (i & 1)
+          irsend->space(usecs);
+        else
+          irsend->mark(usecs);  // It leaves the LED off afterwards.
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Send an A/C code by its name. See `find()`.
+/// @param[in] name The name of the code.
+/// @param[in] irac What to send it with.
+/// @return true, if it was found & sent. Otherwise false.
+bool IRcodeStore::send(const char *name, IRac *irac) const {
+  ircode_t code;
+  return find(name, &code) && send(code, irac);
+}
+
+/// Send an A/C code. i.e. Its state, via `IRac::sendAc()`.
+/// @param[in] code The code. See `find()`.
+/// @param[in] irac What to send it with.
+/// @return true, if it was sent. Otherwise false. e.g. It isn't an A/C code.
+bool IRcodeStore::send(const ircode_t &code, IRac *irac) const {
+  if (irac == NULL || code.kind != kCodeAc) return false;
+  uint8_t binary[kIRacStateBinaryLength];
+  _read(code.data, binary, sizeof(binary));
+  stdAc::state_t state;
+  return IRac::binaryToState(binary, sizeof(binary), &state) &&
+      irac->sendAc(state);
+}
+
+/// Compile a code into a sequence, for it to be replayed with
+/// `IRsend::sendSequence()`. e.g. A code that is sent often, or has to be sent
+/// with precise timing.
+/// @param[in] name The name of the code. Not an A/C code.
+/// @param[in] irsend What would send it. Only its settings are used.
+/// @param[out] sequence Where to compile it to.
+/// @return true, if it was found & fitted in the sequence. Otherwise false.
+bool IRcodeStore::compile(const char *name, IRsend *irsend,
+                          IRsequence *sequence) const {
+  if (irsend == NULL || sequence == NULL) return false;
+  irsend->startRecording(sequence);
+  const bool sent = send(name, irsend);
+  return irsend->stopRecording() && sent;
+}
+
+/// Class constructor.
+/// @param[in] buffer Where to build the image.
+/// @param[in] size Nr. of bytes of `buffer`.
+IRcodeStoreBuilder::IRcodeStoreBuilder(uint8_t *buffer, const uint32_t size)
+    : _buffer(buffer), _size(size), _used(kCodeStoreHeaderSize), _count(0),
+      _failed(buffer == NULL || size < kCodeStoreHeaderSize) {}
+
+/// Get the nr. of codes added so far.
+/// @return The nr. of codes.
+uint16_t IRcodeStoreBuilder::count(void) const { return _count; }
+
+/// Add bytes to the record being built.
+/// @param[in] src The bytes.
+/// @param[in] length Nr. of bytes.
+void IRcodeStoreBuilder::_write(const void *src, const uint16_t length) {
+  memcpy(_buffer + _used, src, length);
+  _used += length;
+}
+
+/// Add a 16 bit value to the record being built.
+/// @param[in] value The value.
+void IRcodeStoreBuilder::_write16(const uint16_t value) {
+  const uint8_t bytes[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+  _write(bytes, sizeof(bytes));
+}
+
+/// Add a 32 bit value to the record being built.
+/// @param[in] value The value.
+void IRcodeStoreBuilder::_write32(const uint32_t value) {
+  _write16(value);
+  _write16(value >> 16);
+}
+
+/// Set an entry of the index. Until `finish()`, it is at the end of the
+/// buffer, last entry first.
+/// @param[in] entry Which entry.
+/// @param[in] hash The hash of the code's name.
+/// @param[in] offset Where the code's record is.
+void IRcodeStoreBuilder::_setIndex(const uint16_t entry, const uint32_t hash,
+                                   const uint32_t offset) {
+  const uint32_t used = _used;
+  _used = _size - (uint32_t)(entry + 1) * kCodeStoreIndexEntrySize;
+  _write32(hash);
+  _write32(offset);
+  _used = used;
+}
+
+/// Start adding a code.
+/// @param[in] name The name of the code.
+/// @param[in] kind What it holds.
+/// @param[in] payload Nr. of bytes it holds after its name.
+/// @return true, if it fits. Otherwise false, & nothing is added.
+bool IRcodeStoreBuilder::_begin(const char *name, const ir_code_kind_t kind,
+                                const uint32_t payload) {
+  if (_failed || name == NULL || _count == UINT16_MAX) return false;
+  const size_t length = strlen(name);
+  const uint32_t needed = 2 + length + payload + kCodeStoreIndexEntrySize;
+  if (length > kCodeStoreMaxName ||
+      _used + (uint32_t)_count * kCodeStoreIndexEntrySize + needed > _size) {
+    _failed = true;  // So an image is never missing a code.
+    return false;
+  }
+  _setIndex(_count++, IRcodeStore::hash(name), _used);
+  const uint8_t header[2] = {(uint8_t)kind, (uint8_t)length};
+  _write(header, sizeof(header));
+  _write(name, length);
+  return true;
+}
+
+/// Add a simple (<= 64 bit) message.
+/// @param[in] name The name of the code. Names should be unique.
+/// @param[in] protocol The protocol it uses.
+/// @param[in] value The message.
+/// @param[in] bits Nr. of bits of it. 0 for the protocol's default.
+/// @param[in] repeat Nr. of times to repeat it.
+/// @return true, if it fits. Otherwise false, & the image can't be finished.
+bool IRcodeStoreBuilder::addValue(const char *name,
+                                  const decode_type_t protocol,
+                                  const uint64_t value, const uint16_t bits,
+                                  const uint16_t repeat) {
+  if (!_begin(name, kCodeValue, kCodeStoreValueSize)) return false;
+  _write16(protocol);
+  _write16(bits);
+  _write16(repeat);
+  _write32(value);
+  _write32(value >> 32);
+  return true;
+}
+
+/// Add a state[] message.
+/// @param[in] name The name of the code. Names should be unique.
+/// @param[in] protocol The protocol it uses.
+/// @param[in] state The message.
+/// @param[in] nbytes Nr. of bytes of it.
+/// @return true, if it fits. Otherwise false, & the image can't be finished.
+bool IRcodeStoreBuilder::addState(const char *name,
+                                  const decode_type_t protocol,
+                                  const uint8_t *state, const uint16_t nbytes) {
+  if (state == NULL ||
+      !_begin(name, kCodeState, kCodeStoreStateHeaderSize + nbytes))
+    return false;
+  _write16(protocol);
+  _write16(nbytes);
+  _write(state, nbytes);
+  return true;
+}
+
+/// Add raw marks & spaces. e.g. A capture, or a converted Pronto code.
+/// @param[in] name The name of the code. Names should be unique.
+/// @param[in] durations The marks & spaces, starting with a mark. (uSeconds)
+/// @param[in] length Nr. of entries of `durations`.
+/// @param[in] frequency The carrier. (Hz)
+/// @param[in] duty The carrier's duty cycle. (Percentage)
+/// @return true, if it fits. Otherwise false, & the image can't be finished.
+bool IRcodeStoreBuilder::addRaw(const char *name, const uint16_t *durations,
+                                const uint16_t length,
+                                const uint32_t frequency,
+                                const uint8_t duty) {
+  if (durations == NULL ||
+      !_begin(name, kCodeRaw, kCodeStoreRawHeaderSize + length * 2UL))
+    return false;
+  _write32(frequency);
+  _write(&duty, 1);
+  _write16(length);
+  for (uint16_t i = 0; i < length; i++) _write16(durations[i]);
+  return true;
+}
+
+/// Add an A/C state. It is sent with `IRac::sendAc()`.
+/// @param[in] name The name of the code. Names should be unique.
+/// @param[in] state The state.
+/// @return true, if it fits. Otherwise false, & the image can't be finished.
+bool IRcodeStoreBuilder::addAc(const char *name, const stdAc::state_t &state) {
+  uint8_t binary[kIRacStateBinaryLength];
+  if (!IRac::stateToBinary(state, binary)) return false;
+  if (!_begin(name, kCodeAc, sizeof(binary))) return false;
+  _write(binary, sizeof(binary));
+  return true;
+}
+
+/// Get the hash of an index entry, in the builder's buffer.
+/// @param[in] entry The entry.
+/// @return The hash of its code's name.
+static uint32_t entryHash(const uint8_t *entry) {
+  return entry[0] | (uint32_t)entry[1] << 8 | (uint32_t)entry[2] << 16 |
+      (uint32_t)entry[3] << 24;
+}
+
+/// Finish the image. i.e. Sort the index, & move it after the records.
+/// @return Nr. of bytes of the image, or 0 if a code didn't fit.
+/// @note Nothing more can be added afterwards.
+uint32_t IRcodeStoreBuilder::finish(void) {
+  if (_failed) return 0;
+  const uint32_t index = _used;
+  const uint32_t length = (uint32_t)_count * kCodeStoreIndexEntrySize;
+  memmove(_buffer + index, _buffer + _size - length, length);
+  // An insertion sort, by hash. The entries start out in reverse order.
+  uint8_t *entries = _buffer + index;
+  for (uint16_t i = 1; i < _count; i++) {
+    uint8_t entry[kCodeStoreIndexEntrySize];
+    memcpy(entry, entries + i * kCodeStoreIndexEntrySize, sizeof(entry));
+    uint16_t j = i;
+    for (; j > 0; j--) {
+      const uint8_t *prev = entries + (j - 1) * kCodeStoreIndexEntrySize;
+      if (entryHash(prev) <= entryHash(entry)) break;
+      memcpy(entries + j * kCodeStoreIndexEntrySize, prev, sizeof(entry));
+    }
+    memcpy(entries + j * kCodeStoreIndexEntrySize, entry, sizeof(entry));
+  }
+  _used = 0;
+  _write(kCodeStoreMagic, 4);
+  _write(&kCodeStoreVersion, 1);
+  const uint8_t reserved = 0;
+  _write(&reserved, 1);
+  _write16(_count);
+  _write32(index);
+  _write32(index + length);
+  _used = index + length;
+  _failed = true;  // Nothing more can be added.
+  return _used;
+}
+
+/// Class constructor.
+/// @param[in] size Nr. of codes it can hold. (At most 16384)
+IRcodeIndex::IRcodeIndex(const uint16_t size) : _count(0) {
+  _size = std::min(std::max(size, (uint16_t)1), (uint16_t)16384);
+  uint32_t slots = 2;
+  while (slots < 2UL * _size) slots <<= 1;
+  _mask = slots - 1;
+  _table = new ir_code_index_entry_t[slots];
+  clear();
+}
+
+/// Class destructor.
+IRcodeIndex::~IRcodeIndex(void) { delete[] _table; }
+
+/// Remove all the codes.
+void IRcodeIndex::clear(void) {
+  for (uint32_t i = 0; i <= _mask; i++) _table[i].action = kCodeIndexNoAction;
+  _count = 0;
+}
+
+/// Get the nr. of codes in the index.
+/// @return The nr. of codes.
+uint16_t IRcodeIndex::count(void) const { return _count; }
+
+/// Get the nr. of codes the index can hold.
+/// @return The nr. of codes.
+uint16_t IRcodeIndex::size(void) const { return _size; }
+
+/// Calculate the key of a state[] message.
+/// @param[in] state The message.
+/// @param[in] nbytes Nr. of bytes of it.
+/// @return The hash of it. (FNV-1a)
+uint32_t IRcodeIndex::hashState(const uint8_t *state, const uint16_t nbytes) {
+  uint32_t result = kFnvBasis32;
+  for (uint16_t i = 0; i < nbytes; i++) {
+    result ^= state[i];
+    result *= kFnvPrime32;
+  }
+  return result;
+}
+
+/// Compare two durations, as `decodeHash()` does.
+/// @param[in] oldval A duration.
+/// @param[in] newval The duration two entries later.
+/// @return 0 if newval is shorter, 1 if it is equal, & 2 if it is longer.
+static uint16_t compareDurations(const uint32_t oldval, const uint32_t newval) {
+  if (newval * 5 < oldval * 4)
+    return 0;
+  else if (oldval * 5 < newval * 4)
+    return 2;
+  else
+    return 1;
+}
+
+/// Calculate the key of raw marks & spaces. i.e. The value `decodeHash()`
+/// would give a capture of them.
+/// @param[in] durations The marks & spaces, starting with a mark. (uSeconds)
+/// @param[in] length Nr. of entries of `durations`.
+/// @return The hash of them.
+uint32_t IRcodeIndex::hashRaw(const uint16_t *durations,
+                              const uint16_t length) {
+  uint32_t result = kFnvBasis32;
+  // N.B. The capture also has the gap before it, so this skips its last entry
+  // just like `decodeHash()` does.
+  for (uint16_t i = 0; i + 2 < length; i++)
+    result = (result * kFnvPrime32) ^
+        compareDurations(durations[i], durations[i + 2]);
+  return result;
+}
+
+/// Find the slot a code is in, or would go in.
+/// @param[in] protocol The protocol of the code.
+/// @param[in] key Its value, or hash.
+/// @param[in] bits Nr. of bits of it.
+/// @return The slot. It is empty if the code isn't there.
+uint16_t IRcodeIndex::_slot(const decode_type_t protocol, const uint64_t key,
+                            const uint16_t bits) const {
+  // Fibonacci hashing of all of the key. The high bits are the best mixed.
+  const uint32_t mixed = ((uint32_t)key ^ (uint32_t)(key >> 32) ^
+                          (uint32_t)protocol << 16 ^ bits) * 2654435761UL;
+  uint16_t slot = (mixed >> 16) & _mask;
+  // There is always an empty slot, as the table is never more than half full.
+  for (;; slot = (slot + 1) & _mask) {
+    const ir_code_index_entry_t &entry = _table[slot];
+    if (entry.action == kCodeIndexNoAction ||
+        (entry.key == key && entry.protocol == protocol && entry.bits == bits))
+      return slot;
+  }
+}
+
+/// Add a simple (<= 64 bit) message, or the `decodeHash()` value of an
+/// UNKNOWN one.
+/// @param[in] protocol The protocol of the code.
+/// @param[in] value The value of it.
+/// @param[in] bits Nr. of bits of it. i.e. As `decode()` reports it.
+/// @param[in] action What it should map to. Not `kCodeIndexNoAction`.
+/// @return true, if it was added, or was there & now maps to `action`.
+///   false if the index is full.
+bool IRcodeIndex::add(const decode_type_t protocol, const uint64_t value,
+                      const uint16_t bits, const uint16_t action) {
+  if (action == kCodeIndexNoAction) return false;
+  ir_code_index_entry_t &entry = _table[_slot(protocol, value, bits)];
+  if (entry.action == kCodeIndexNoAction) {
+    if (_count >= _size) return false;
+    _count++;
+    entry.key = value;
+    entry.protocol = protocol;
+    entry.bits = bits;
+  }
+  entry.action = action;
+  return true;
+}
+
+/// Add a state[] message.
+/// @param[in] protocol The protocol of the code.
+/// @param[in] state The message.
+/// @param[in] nbytes Nr. of bytes of it.
+/// @param[in] action What it should map to. Not `kCodeIndexNoAction`.
+/// @return true, if it was added. Otherwise false.
+bool IRcodeIndex::add(const decode_type_t protocol, const uint8_t *state,
+                      const uint16_t nbytes, const uint16_t action) {
+  if (state == NULL) return false;
+  return add(protocol, hashState(state, nbytes), nbytes * 8, action);
+}
+
+/// Add a received code. e.g. To learn what a button of a remote sends.
+/// @param[in] results The result of a `decode()`.
+/// @param[in] action What it should map to. Not `kCodeIndexNoAction`.
+/// @return true, if it was added. Otherwise false.
+bool IRcodeIndex::add(const decode_results *results, const uint16_t action) {
+  if (results == NULL) return false;
+  if (hasACState(results->decode_type))
+    return add(results->decode_type, results->state, results->bits / 8,
+               action);
+  return add(results->decode_type, results->value, results->bits, action);
+}
+
+/// Add a code of an `IRcodeStore`.
+/// Raw codes are added as the UNKNOWN message `decodeHash()` would make of
+/// them, so they only match if no protocol decodes them.
+/// @param[in] store The store.
+/// @param[in] code The code. See `IRcodeStore::find()`.
+/// @param[in] action What it should map to. Not `kCodeIndexNoAction`.
+/// @return true, if it was added. Otherwise false. e.g. An A/C code, as what
+///   `IRac` sends for it isn't known until it is sent.
+bool IRcodeIndex::add(const IRcodeStore &store, const ircode_t &code,
+                      const uint16_t action) {
+  switch (code.kind) {
+    case kCodeValue:
+      return add(code.protocol, code.value,
+                 code.bits ? code.bits : IRsend::defaultBits(code.protocol),
+                 action);
+    case kCodeState: {
+      uint8_t state[kStateSizeMax ? kStateSizeMax : 1];
+      if (code.length > kStateSizeMax) return false;
+      store._read(code.data, state, code.length);
+      return add(code.protocol, state, code.length, action);
+    }
+    case kCodeRaw: {
+      // The same as `hashRaw()`, but read from the image as it goes.
+      uint32_t hash = kFnvBasis32;
+      for (uint16_t i = 0; i + 2 < code.length; i++)
+        hash = (hash * kFnvPrime32) ^
+            compareDurations(store._read16(code.data + i * 2),
+                             store._read16(code.data + (i + 2) * 2));
+      // `decodeHash()`'s nr. of bits. The capture has the gap before it too.
+      return add(decode_type_t::UNKNOWN, hash, (code.length + 1) / 2, action);
+    }
+    default:
+      return false;
+  }
+}
+
+/// Add all the codes of an `IRcodeStore`. e.g. One built from learnt codes.
+/// Each maps to its entry in the store. i.e. Use `IRcodeStore::get()` or
+/// `IRcodeStore::getName()` with what `find()` returns.
+/// @param[in] store The store.
+/// @return Nr. of codes that were added. See `add()` for why some can't be.
+uint16_t IRcodeIndex::addStore(const IRcodeStore &store) {
+  uint16_t added = 0;
+  ircode_t code;
+  for (uint16_t entry = 0; entry < store.count(); entry++)
+    if (store.get(entry, &code) && add(store, code, entry)) added++;
+  return added;
+}
+
+/// Find what a code maps to.
+/// @param[in] protocol The protocol of the code.
+/// @param[in] value Its value, or the hash of its state[] or raw durations.
+/// @param[in] bits Nr. of bits of it.
+/// @return The action, or `kCodeIndexNoAction` if it isn't in the index.
+uint16_t IRcodeIndex::find(const decode_type_t protocol, const uint64_t value,
+                           const uint16_t bits) const {
+  return _table[_slot(protocol, value, bits)].action;
+}
+
+/// Find what a received code maps to.
+/// @param[in] results The result of a `decode()`.
+/// @return The action, or `kCodeIndexNoAction` if it isn't in the index.
+uint16_t IRcodeIndex::find(const decode_results *results) const {
+  if (results == NULL) return kCodeIndexNoAction;
+  if (hasACState(results->decode_type))
+    return find(results->decode_type,
+                hashState(results->state, results->bits / 8),
+                results->bits / 8 * 8);
+  return find(results->decode_type, results->value, results->bits);
+}
@@ -0,0 +1,198 @@
+#ifndef IRCODESTORE_H_
+#define IRCODESTORE_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRsend.h"
+
+// Constants
+/// The first bytes of an `IRcodeStore` image.
+const char kCodeStoreMagic[] = "IRCS";
+/// Version of the `IRcodeStore` image format.
+const uint8_t kCodeStoreVersion = 1;
+/// Nr. of bytes of the header at the start of an image.
+const uint16_t kCodeStoreHeaderSize = 16;
+/// Nr. of bytes of each entry of the index. (name hash, record offset)
+const uint8_t kCodeStoreIndexEntrySize = 8;
+/// Longest name a code can have. (chars)
+const uint8_t kCodeStoreMaxName = 255;
+/// What `IRcodeIndex::find()` returns when nothing matches.
+const uint16_t kCodeIndexNoAction = UINT16_MAX;
+/// Default nr. of codes an `IRcodeIndex` can hold.
+const uint16_t kCodeIndexDefaultSize = 32;
+
+/// What an `IRcodeStore` record holds.
+enum ir_code_kind_t {
+  kCodeNone = 0,
+  kCodeValue = 1,  ///< A simple (<= 64 bit) message. See `IRsend::send()`.
+  kCodeState = 2,  ///< A state[] message. See `IRsend::send()`.
+  kCodeRaw = 3,    ///< Raw marks & spaces. e.g. A capture or a Pronto code.
+  kCodeAc = 4,     ///< An A/C state. See `IRac::stateToBinary()`.
+};
+
+/// A code found in an `IRcodeStore`. Its data is left in the image.
+/// @see IRcodeStore::find()
+typedef struct {
+  ir_code_kind_t kind;
+  decode_type_t protocol;  // UNKNOWN for raw & A/C codes.
+  uint16_t bits;      // Nr. of bits of a value. 0 for the protocol's default.
+  uint16_t length;    // Nr. of state bytes, or raw marks & spaces.
+  uint16_t repeat;    // Nr. of repeats of a value.
+  uint64_t value;     // The value of a simple message.
+  uint32_t frequency;  // Carrier of raw marks & spaces. (Hz)
+  uint8_t duty;        // Duty cycle of raw marks & spaces. (Percentage)
+  uint32_t data;  // Offset in the image of the state, raw, or A/C bytes.
+} ircode_t;
+
+/// A read-only store of named IR codes in a compact binary image. e.g. In
+/// flash (PROGMEM), or a memory mapped flash partition. Codes are found by
+/// a binary search of an index sorted by the hash of their names, & are sent
+/// straight from the image. i.e. Nothing is parsed, or copied into RAM first.
+/// e.g.
+///   IRcodeStore store(kCodes, sizeof(kCodes));  // Made by ir_code_store.py
+///   store.send("tv_power", &irsend);
+///
+/// The image is little-endian:
+///   Header: "IRCS", version (1 byte), 0 (1 byte), nr. of codes (2 bytes),
+///           offset of the index (4 bytes), size of the image (4 bytes).
+///   Records: The kind (1 byte), the length of the name (1 byte), the name,
+///            then per kind:
+///     kCodeValue: protocol (2), bits (2), repeat (2), value (8).
+///     kCodeState: protocol (2), nr. of bytes (2), the bytes.
+///     kCodeRaw:   frequency (4), duty (1), nr. of entries (2), the entries
+///                 (2 each, uSeconds, starting with a mark).
+///     kCodeAc:    `IRac::stateToBinary()`'s bytes.
+///   Index: Per code, its name's hash (4) & its record's offset (4), in order
+///          of hash.
+/// @see IRcodeStoreBuilder, tools/ir_code_store.py
+class IRcodeStore {
+ public:
+  explicit IRcodeStore(const uint8_t *image, const uint32_t size);
+  bool isValid(void) const;
+  uint16_t count(void) const;
+  bool find(const char *name, ircode_t *code) const;
+  bool get(const uint16_t entry, ircode_t *code) const;
+  bool getName(const uint16_t entry, char *name, const uint16_t size) const;
+  bool send(const char *name, IRsend *irsend) const;
+  bool send(const ircode_t &code, IRsend *irsend) const;
+  bool send(const char *name, IRac *irac) const;
+  bool send(const ircode_t &code, IRac *irac) const;
+  bool compile(const char *name, IRsend *irsend, IRsequence *sequence) const;
+  static uint32_t hash(const char *name);
+  friend class IRcodeIndex;  // Reads the state[] codes.
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  const uint8_t *_image;  // May be in PROGMEM.
+  uint32_t _size;
+  uint16_t _count;  // 0 if the image isn't valid.
+  uint32_t _index;  // Offset of the index.
+  void _read(const uint32_t offset, void *dst, const uint16_t length) const;
+  uint16_t _read16(const uint32_t offset) const;
+  uint32_t _read32(const uint32_t offset) const;
+  bool _parse(const uint32_t offset, const char *name, ircode_t *code) const;
+};
+
+/// Builds an `IRcodeStore` image in a buffer. e.g. To save it to a file or a
+/// flash partition, from codes learnt or downloaded at run time.
+/// Offline, `tools/ir_code_store.py` makes one from a JSON file instead.
+/// e.g.
+///   IRcodeStoreBuilder builder(buffer, sizeof(buffer));
+///   builder.addValue("tv_power", NEC, 0x20DF10EF);
+///   const uint32_t size = builder.finish();  // 0 if it didn't fit.
+/// @note The index is kept at the end of the buffer until `finish()`, so no
+///   other memory is needed.
+class IRcodeStoreBuilder {
+ public:
+  explicit IRcodeStoreBuilder(uint8_t *buffer, const uint32_t size);
+  bool addValue(const char *name, const decode_type_t protocol,
+                const uint64_t value, const uint16_t bits = 0,
+                const uint16_t repeat = kNoRepeat);
+  bool addState(const char *name, const decode_type_t protocol,
+                const uint8_t *state, const uint16_t nbytes);
+  bool addRaw(const char *name, const uint16_t *durations,
+              const uint16_t length, const uint32_t frequency = 38000,
+              const uint8_t duty = kDutyDefault);
+  bool addAc(const char *name, const stdAc::state_t &state);
+  uint16_t count(void) const;
+  uint32_t finish(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  uint8_t *_buffer;
+  uint32_t _size;
+  uint32_t _used;  // Nr. of bytes of records so far.
+  uint16_t _count;
+  bool _failed;  // Did anything not fit?
+  bool _begin(const char *name, const ir_code_kind_t kind,
+              const uint32_t payload);
+  void _write(const void *src, const uint16_t length);
+  void _write16(const uint16_t value);
+  void _write32(const uint32_t value);
+  void _setIndex(const uint16_t entry, const uint32_t hash,
+                 const uint32_t offset);
+};
+
+/// An entry of an `IRcodeIndex`.
+typedef struct {
+  uint64_t key;  // The value, or the hash of a state[] or unknown message.
+  int16_t protocol;  // A decode_type_t.
+  uint16_t bits;
+  uint16_t action;  // kCodeIndexNoAction if the slot is empty.
+} ir_code_index_entry_t;
+
+/// Maps received codes to actions, in O(1). i.e. A hash table (open
+/// addressing, with linear probing), instead of comparing each `decode()`
+/// result against a list of codes.
+/// Codes are keyed by their protocol, value & nr. of bits. State[] messages
+/// by a hash of their state, & UNKNOWN ones by their `decodeHash()` value.
+/// e.g.
+///   IRcodeIndex actions;
+///   actions.add(NEC, 0x20DF10EF, 32, kTvPower);
+///   actions.addStore(store);  // The action is the code's entry in the store.
+///   ...
+///   switch (actions.find(&results)) { ... }
+/// @note The table is twice the size it is made for, so it never gets more
+///   than half full, & few lookups need more than a probe or two.
+class IRcodeIndex {
+ public:
+  explicit IRcodeIndex(const uint16_t size = kCodeIndexDefaultSize);
+  ~IRcodeIndex(void);
+  void clear(void);
+  uint16_t count(void) const;
+  uint16_t size(void) const;
+  bool add(const decode_type_t protocol, const uint64_t value,
+           const uint16_t bits, const uint16_t action);
+  bool add(const decode_type_t protocol, const uint8_t *state,
+           const uint16_t nbytes, const uint16_t action);
+  bool add(const decode_results *results, const uint16_t action);
+  bool add(const IRcodeStore &store, const ircode_t &code,
+           const uint16_t action);
+  uint16_t addStore(const IRcodeStore &store);
+  uint16_t find(const decode_type_t protocol, const uint64_t value,
+                const uint16_t bits) const;
+  uint16_t find(const decode_results *results) const;
+  static uint32_t hashState(const uint8_t *state, const uint16_t nbytes);
+  static uint32_t hashRaw(const uint16_t *durations, const uint16_t length);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  ir_code_index_entry_t *_table;
+  uint16_t _mask;  // Nr. of slots - 1. The nr. of slots is a power of 2.
+  uint16_t _size;  // Nr. of codes it can hold.
+  uint16_t _count;
+  uint16_t _slot(const decode_type_t protocol, const uint64_t key,
+                 const uint16_t bits) const;
+  IRcodeIndex(const IRcodeIndex &);  // Not copyable, as it owns its table.
+  IRcodeIndex &operator=(const IRcodeIndex &);
+};
+
+#endif  // IRCODESTORE_H_
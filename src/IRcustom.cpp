@@ -0,0 +1,162 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRcustom.cpp
+/// @brief Simple IR protocols registered at run time, rather than compiled in.
+
+#include "IRcustom.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef ARDUINO
+#include <strings.h>
+#endif
+#include "IRsend.h"
+#include "IRtext.h"
+#include "IRutils.h"
+
+/// @cond IGNORE
+static custom_protocol_t custom_protocols[kMaxCustomProtocols];
+static uint8_t custom_count = 0;
+
+// The fields of a spec for `ircustom::add()`, after the name, in order.
+const uint8_t kCustomSpecFields = 13;
+// The nr. of them that must be given. i.e. Up to & including the gap.
+const uint8_t kCustomSpecRequired = 9;
+// The largest value of each field.
+static const uint32_t kCustomSpecMax[kCustomSpecFields] = {
+    64, UINT16_MAX, UINT32_MAX, UINT16_MAX, UINT32_MAX, UINT16_MAX,
+    UINT32_MAX, UINT16_MAX, UINT32_MAX, UINT16_MAX, 100, 1, UINT16_MAX};
+/// @endcond
+
+namespace ircustom {
+/// Register a protocol, or change one that already has the name.
+/// @param[in] name Its name. Up to `kCustomNameLength` characters, not
+///   starting with a digit, & not the name of a built-in protocol.
+/// @param[in] timing Its description. The `protocol` of it is ignored.
+/// @return The `decode_type_t` it has been given. `UNKNOWN` if it can't be
+///   registered. e.g. The description isn't valid, or too many are.
+decode_type_t add(const char *name, const pulse_distance_t *timing) {
+  if (name == NULL || timing == NULL) return decode_type_t::UNKNOWN;
+  const size_t length = strlen(name);
+  // Not a number either, as `strToDecodeType()` takes those as a type.
+  if (!length || length > kCustomNameLength || strchr(name, ',') != NULL ||
+      (name[0] >= '0' && name[0] <= '9'))
+    return decode_type_t::UNKNOWN;
+  // Its bits must be sent, & be told apart.
+  if (!timing->nbits || timing->nbits > 64 ||
+      !timing->onemark || !timing->zeromark ||
+      (timing->onemark == timing->zeromark &&
+       timing->onespace == timing->zerospace))
+    return decode_type_t::UNKNOWN;
+  decode_type_t type = find(name);
+  if (type == decode_type_t::UNKNOWN) {
+    // A built-in protocol's name would be ambiguous.
+    if (strToDecodeType(name) != decode_type_t::UNKNOWN ||
+        !strcasecmp(name, kUnknownStr))
+      return decode_type_t::UNKNOWN;
+    for (uint8_t i = 0; i < kMaxCustomProtocols; i++)
+      if (!custom_protocols[i].timing.nbits) {
+        type = (decode_type_t)(kFirstCustomType + i);
+        custom_count++;
+        break;
+      }
+    if (type == decode_type_t::UNKNOWN) return type;  // They are all used.
+  }
+  custom_protocol_t *entry = &custom_protocols[type - kFirstCustomType];
+  entry->timing = *timing;
+  entry->timing.protocol = type;
+  strncpy(entry->name, name, kCustomNameLength + 1);
+  return type;
+}
+
+/// Register a protocol described by a string, or change one that already has
+/// the name. e.g. A line of a config file, or an MQTT message.
+/// @param[in] spec The name, & then its `pulse_distance_t` values, separated
+///   by commas. i.e.
+///   "name,nbits,hdrmark,hdrspace,onemark,onespace,zeromark,zerospace,
+///   footermark,gap[,frequency[,dutycycle[,MSBfirst[,minrepeats]]]]"
+///   Timings are in uSeconds. The optional values default to 38000 (Hz),
+///   `kDutyDefault`, 1 (true) & 0.
+/// @return The `decode_type_t` it has been given. `UNKNOWN` if it can't be
+///   registered.
+decode_type_t add(const char *spec) {
+  if (spec == NULL) return decode_type_t::UNKNOWN;
+  const char *comma = strchr(spec, ',');
+  if (comma == NULL || comma - spec > kCustomNameLength)
+    return decode_type_t::UNKNOWN;
+  char name[kCustomNameLength + 1];
+  memcpy(name, spec, comma - spec);
+  name[comma - spec] = '\0';
+  uint32_t values[kCustomSpecFields] = {0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                        38000, kDutyDefault, 1, kNoRepeat};
+  const char *ptr = comma + 1;
+  uint8_t fields = 0;
+  while (true) {
+    char *end;
+    if (fields >= kCustomSpecFields || *ptr < '0' || *ptr > '9')
+      return decode_type_t::UNKNOWN;
+    values[fields] = strtoul(ptr, &end, 10);
+    if (values[fields] > kCustomSpecMax[fields]) return decode_type_t::UNKNOWN;
+    fields++;
+    if (*end == '\0') break;
+    if (*end != ',') return decode_type_t::UNKNOWN;
+    ptr = end + 1;
+  }
+  if (fields < kCustomSpecRequired) return decode_type_t::UNKNOWN;
+  const pulse_distance_t timing = {
+      decode_type_t::UNKNOWN, (uint16_t)values[0],
+      (uint16_t)values[1], values[2],
+      (uint16_t)values[3], values[4],
+      (uint16_t)values[5], values[6],
+      (uint16_t)values[7], values[8],
+      (uint16_t)values[9], (uint8_t)values[10], values[11] != 0,
+      (uint16_t)values[12]};
+  return add(name, &timing);
+}
+
+/// Unregister a protocol.
+/// @param[in] type Its `decode_type_t`.
+/// @return true, if it was registered. Otherwise false.
+bool remove(const decode_type_t type) {
+  if (get(type) == NULL) return false;
+  custom_protocol_t *entry = &custom_protocols[type - kFirstCustomType];
+  entry->timing.nbits = 0;
+  entry->name[0] = '\0';
+  custom_count--;
+  return true;
+}
+
+/// Unregister all of the protocols.
+void clear(void) {
+  for (uint8_t i = 0; i < kMaxCustomProtocols; i++) {
+    custom_protocols[i].timing.nbits = 0;
+    custom_protocols[i].name[0] = '\0';
+  }
+  custom_count = 0;
+}
+
+/// Get a registered protocol.
+/// @param[in] type Its `decode_type_t`.
+/// @return A Ptr to it, or NULL if it isn't registered.
+const custom_protocol_t *get(const decode_type_t type) {
+  const int16_t index = type - kFirstCustomType;
+  if (index < 0 || index >= kMaxCustomProtocols ||
+      !custom_protocols[index].timing.nbits) return NULL;
+  return &custom_protocols[index];
+}
+
+/// Find a registered protocol by its name.
+/// @param[in] name Its name. Case insensitive.
+/// @return Its `decode_type_t`, or `UNKNOWN` if none has that name.
+decode_type_t find(const char *name) {
+  if (name == NULL || !custom_count) return decode_type_t::UNKNOWN;
+  for (uint8_t i = 0; i < kMaxCustomProtocols; i++)
+    if (custom_protocols[i].timing.nbits &&
+        !strcasecmp(name, custom_protocols[i].name))
+      return custom_protocols[i].timing.protocol;
+  return decode_type_t::UNKNOWN;
+}
+
+/// Get the nr. of protocols registered.
+/// @return The count.
+uint8_t count(void) { return custom_count; }
+}  // namespace ircustom
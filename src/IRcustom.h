@@ -0,0 +1,51 @@
+#ifndef IRCUSTOM_H_
+#define IRCUSTOM_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+
+// Constants
+/// The `decode_type_t` of the first protocol registered at run time. Well clear
+/// of the built-in ones, so adding those never changes a registered one's type.
+const int16_t kFirstCustomType = 1000;
+/// Max. nr. of protocols that can be registered at run time.
+const uint8_t kMaxCustomProtocols = 8;
+/// Max. nr. of characters in the name of a protocol registered at run time.
+const uint8_t kCustomNameLength = 15;
+
+/// A protocol registered at run time.
+typedef struct {
+  pulse_distance_t timing;  ///< Its description. `nbits` is 0 if unused.
+  char name[kCustomNameLength + 1];  ///< Its name. e.g. For `typeToString()`.
+} custom_protocol_t;
+
+/// Simple (pulse-distance) protocols registered at run time, rather than
+/// compiled in. e.g. Loaded from a config file, or pushed over MQTT, so a
+/// fleet of devices can gain a site-specific protocol without new firmware.
+/// Each gets a `decode_type_t` of its own (from `kFirstCustomType`), & is then
+/// sent by `IRsend::send()` & decoded by `IRrecv::decode()` (after the
+/// built-in protocols) via the same generic engine as `pulse_distance_t`
+/// protocols like NIKAI. `typeToString()` & `strToDecodeType()` use its name.
+/// They are shared by every `IRsend` & `IRrecv` object.
+/// e.g.
+/// @code
+///   const decode_type_t kGarage = ircustom::add(
+///       "GARAGE,24,3400,1700,420,1270,420,420,420,20000");
+///   ...
+///   irsend.send(kGarage, 0xA1B2C3, 24);
+/// @endcode
+/// @note Register them from the same task/thread as `decode()` & `send()` are
+///   called from. e.g. `loop()`, or an MQTT callback called from it.
+namespace ircustom {
+  decode_type_t add(const char *name, const pulse_distance_t *timing);
+  decode_type_t add(const char *spec);
+  bool remove(const decode_type_t type);
+  void clear(void);
+  const custom_protocol_t *get(const decode_type_t type);
+  decode_type_t find(const char *name);
+  uint8_t count(void);
+}  // namespace ircustom
+
+#endif  // IRCUSTOM_H_
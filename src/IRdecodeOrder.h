@@ -0,0 +1,97 @@
+// Copyright 2026 The IRremoteESP8266 authors
+// The order `IRrecv::decode()` tries the protocols in. See `_IR_DECODE_ORDER_`.
+//
+// WARNING: Do not edit this file! This file is automatically generated by
+//          'tools/generate_decode_order.py'.
+
+#ifndef IRDECODEORDER_H_
+#define IRDECODEORDER_H_
+
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+
+// A case of `IRrecv::_tryProtocol()` per entry. Bytes, to save memory.
+const uint8_t kDecodeOrder[] = {
+  AIWA_RC_T501,
+  SANYO_LC7461,
+  CARRIER_AC,
+  PIONEER,
+  EPSON,
+  NEC,
+  SONY,
+  MITSUBISHI,
+  MITSUBISHI_AC,
+  MITSUBISHI2,
+  RC5,
+  RC6,
+  RCMM,
+  FUJITSU_AC,
+  DENON,
+  PANASONIC,
+  LG,
+  GICABLE,
+  JVC,
+  SAMSUNG,
+  WHYNTER,
+  DISH,
+  SHARP,
+  COOLIX,
+  NIKAI,
+  KELVINATOR,
+  DAIKIN,
+  DAIKIN2,
+  DAIKIN216,
+  TOSHIBA_AC,
+  MIDEA,
+  MAGIQUEST,
+  NEC_LIKE,
+  LASERTAG,
+  HAIER_AC,
+  HAIER_AC_YRW02,
+  HITACHI_AC424,
+  MITSUBISHI136,
+  HITACHI_AC3,
+  HITACHI_AC1,
+  WHIRLPOOL_AC,
+  SAMSUNG_AC,
+  ELECTRA_AC,
+  PANASONIC_AC,
+  LUTRON,
+  MWM,
+  VESTEL_AC,
+  MITSUBISHI112,
+  TECO,
+  LEGOPF,
+  MITSUBISHI_HEAVY_152,
+  ARGO,
+  SHARP_AC,
+  GOODWEATHER,
+  INAX,
+  TROTEC,
+  DAIKIN160,
+  NEOCLIMA,
+  DAIKIN176,
+  DAIKIN128,
+  AMCOR,
+  DAIKIN152,
+  SYMPHONY,
+  DAIKIN64,
+  AIRWELL,
+  DELONGHI_AC,
+  DOSHISHA,
+  MULTIBRACKETS,
+  CARRIER_AC40,
+  CARRIER_AC64,
+  TECHNIBEL_AC,
+  CORONA_AC,
+  MIDEA24,
+  ZEPEAL,
+  SANYO_AC,
+  VOLTAS,
+  METZ,
+  TRANSCOLD,
+};
+const uint16_t kDecodeOrderLength = sizeof(kDecodeOrder) /
+                                    sizeof(kDecodeOrder[0]);
+
+#endif  // IRDECODEORDER_H_
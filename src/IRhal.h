@@ -0,0 +1,65 @@
+#ifndef IRHAL_H_
+#define IRHAL_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file
+/// @brief The interfaces between `IRrecv`/`IRsend` & the hardware they capture
+///   & send with. i.e. To plug in a backend of your own (e.g. I2S, DMA, an
+///   external chip, or a simulator) without touching the protocol code.
+/// @see ENABLE_CUSTOM_BACKENDS
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+
+#if ENABLE_CUSTOM_BACKENDS
+class IRrecv;
+
+/// Where an `IRrecv` gets its edges from, instead of its GPIO interrupt &
+/// timeout timer. See `IRrecv::setCaptureSource()`.
+/// It reports each edge of the signal with `IRrecv::captureEdge()`, & the
+/// end of a message with `IRrecv::captureEnd()`. Either from an interrupt
+/// handler, or with them disabled.
+/// Its timebase: Both are given the time they happened at, in uSeconds. Ideally
+/// as per `micros()`, so echo suppression & the low power wake line up with
+/// it, but any free running 32 bit uSecond clock works for decoding.
+class IRcaptureSource {
+ public:
+  virtual ~IRcaptureSource(void) {}
+  /// Start capturing. Called by `IRrecv::enableIRIn()`.
+  /// @param[in] receiver The `IRrecv` to report the edges to.
+  virtual void begin(IRrecv *receiver) = 0;
+  /// Stop capturing. Called by `IRrecv::disableIRIn()`.
+  /// @param[in] receiver The `IRrecv` it was reporting to.
+  virtual void end(IRrecv *receiver) = 0;
+  /// Report anything captured since it was last called, for sources that
+  /// aren't interrupt driven. e.g. A ring buffer filled by a peripheral.
+  /// Called at the start of each `IRrecv::decode()`.
+  /// @param[in] receiver The `IRrecv` to report the edges to.
+  virtual void poll(IRrecv *receiver) { (void)receiver; }
+};
+
+/// Where an `IRsend` sends its marks & spaces to, instead of its GPIO(s).
+/// See `IRsend::setSink()`.
+/// Its timebase: Durations are in uSeconds. Each call returns once it has
+/// been sent, as with the GPIO(s). i.e. Protocols that pad their messages out
+/// to a fixed length time how long they took with `IRtimer`.
+class IRsendSink {
+ public:
+  virtual ~IRsendSink(void) {}
+  /// Set the carrier of the marks that follow. i.e. At the start of a message.
+  /// @param[in] hz The carrier frequency. (Hz)
+  /// @param[in] duty The carrier's duty cycle. (Percentage)
+  virtual void carrier(const uint32_t hz, const uint8_t duty) = 0;
+  /// Send a mark. i.e. The carrier, for the given duration.
+  /// @param[in] usecs How long for. (uSeconds)
+  /// @return Nr. of carrier pulses sent.
+  virtual uint16_t mark(const uint16_t usecs) = 0;
+  /// Send a space. i.e. Nothing, for the given duration.
+  /// @param[in] usecs How long for. (uSeconds)
+  virtual void space(const uint32_t usecs) = 0;
+};
+#endif  // ENABLE_CUSTOM_BACKENDS
+
+#endif  // IRHAL_H_
@@ -0,0 +1,317 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRmacro.cpp
+/// @brief Compiled multi-device scenes, sent without blocking.
+
+#include "IRmacro.h"
+#include <stdlib.h>
+#include <new>
+
+/// Class constructor.
+/// @param[in] size Max. nr. of steps (incl. waits) it can hold.
+/// @param[in] inverted true, gpio output defaults to high. false, to low.
+/// @param[in] use_modulation true means use frequency modulation.
+/// @param[in] frame_size The max. nr. of marks & spaces a step can have.
+///   See `IRsequence`.
+/// @note Each step uses ~2 bytes per mark & space of RAM.
+IRmacro::IRmacro(const uint8_t size, const bool inverted,
+                 const bool use_modulation, const uint16_t frame_size)
+    : _ac(kGpioUnused) {
+  _steps = new ir_macro_step_t[size];
+  _size = (_steps != NULL) ? size : 0;
+  _length = 0;
+  _scratch = new IRsequence(frame_size);
+  _emitter_count = 0;
+  _inverted = inverted;
+  _modulation = use_modulation;
+  _running = false;
+  _end = 0;
+  _waiting = false;
+}
+
+/// Class destructor.
+IRmacro::~IRmacro(void) {
+  clear();
+  delete[] _steps;
+  delete _scratch;
+  for (uint8_t i = 0; i < _emitter_count; i++) {
+    _emitters[i].irsend->~irac_batch_send_t();
+    free(_emitters[i].irsend);
+  }
+}
+
+/// Add a simple (<= 64 bit) message to send. See `IRsend::send()`.
+/// @param[in] pin The GPIO to send it from.
+/// @param[in] type The protocol.
+/// @param[in] data The message.
+/// @param[in] nbits The nr. of bits of the message.
+/// @param[in] repeat Nr. of times the message is to be repeated.
+/// @param[in] gap Time the device needs after it, before the next message
+///   from the same GPIO can be sent. (uSeconds) e.g. For it to power up.
+/// @return true, if it was added. false if the macro is full or running, the
+///   message couldn't be compiled or didn't fit, or there are too many GPIOs.
+bool IRmacro::add(const uint16_t pin, const decode_type_t type,
+                  const uint64_t data, const uint16_t nbits,
+                  const uint16_t repeat, const uint32_t gap) {
+  const int8_t emitter = _findEmitter(pin);
+  if (emitter < 0) return false;
+  IRsend *irsend = _emitters[emitter].irsend;
+  irsend->startRecording(_scratch);
+  const bool success = irsend->send(type, data, nbits, repeat);
+  return irsend->stopRecording() && success && _add(emitter, gap);
+}
+
+/// Add a complex (state[]) message to send. See `IRsend::send()`.
+/// @param[in] pin The GPIO to send it from.
+/// @param[in] type The protocol.
+/// @param[in] state The message.
+/// @param[in] nbytes The nr. of bytes of the message.
+/// @param[in] gap Time the device needs after it. (uSeconds) See above.
+/// @return true, if it was added. Otherwise false. See above.
+bool IRmacro::add(const uint16_t pin, const decode_type_t type,
+                  const uint8_t *state, const uint16_t nbytes,
+                  const uint32_t gap) {
+  const int8_t emitter = _findEmitter(pin);
+  if (emitter < 0) return false;
+  IRsend *irsend = _emitters[emitter].irsend;
+  irsend->startRecording(_scratch);
+  const bool success = irsend->send(type, state, nbytes);
+  return irsend->stopRecording() && success && _add(emitter, gap);
+}
+
+/// Add an A/C state to send. i.e. All of it, as `IRac::sendAc()` would send
+/// it with no previous state.
+/// @param[in] pin The GPIO to send it from.
+/// @param[in] state The state the A/C should be in.
+/// @param[in] gap Time the device needs after it. (uSeconds) See above.
+/// @return true, if it was added. Otherwise false. See above.
+bool IRmacro::add(const uint16_t pin, const stdAc::state_t &state,
+                  const uint32_t gap) {
+  const int8_t emitter = _findEmitter(pin);
+  if (emitter < 0) return false;
+  IRsend::startRecordingAll(_scratch);
+  const bool success = _ac.sendAc(state);
+  return IRsend::stopRecordingAll() && success && _add(emitter, gap);
+}
+
+/// Add a message that has already been compiled. e.g. A raw capture, or one
+/// from `IRcodeStore::compile()`.
+/// @param[in] pin The GPIO to send it from.
+/// @param[in] sequence A Ptr to the message. It is copied.
+/// @param[in] gap Time the device needs after it. (uSeconds) See above.
+/// @return true, if it was added. Otherwise false. See above.
+bool IRmacro::add(const uint16_t pin, const IRsequence *sequence,
+                  const uint32_t gap) {
+  if (sequence == NULL || !sequence->length() || _scratch == NULL ||
+      !_scratch->set(sequence->durations(), sequence->length(),
+                     sequence->frequency(), sequence->dutyCycle()))
+    return false;
+  const int8_t emitter = _findEmitter(pin);
+  return emitter >= 0 && _add(emitter, gap);
+}
+
+/// Add a wait. i.e. The steps added after it aren't sent until every step
+/// added before it has been sent (incl. their gaps), & `usecs` more.
+/// e.g. So the TV has switched input before the A/V receiver is turned on.
+/// @param[in] usecs Nr. of microseconds.
+/// @return true, if it was added. false if the macro is full or running.
+bool IRmacro::addWait(const uint32_t usecs) {
+  if (_running || _length >= _size) return false;
+  ir_macro_step_t *step = &_steps[_length++];
+  step->frame = NULL;
+  step->emitter = 0;
+  step->gap = usecs;
+  return true;
+}
+
+/// Add what has been compiled into `_scratch` as a step.
+/// @param[in] emitter The index of the emitter to send it from.
+/// @param[in] gap Time the device needs after it. (uSeconds)
+/// @return true, if it was added. Otherwise false.
+bool IRmacro::_add(const int8_t emitter, const uint32_t gap) {
+  if (_running || _length >= _size) return false;
+  IRsequence *frame = new IRsequence(_scratch->length());
+  if (frame == NULL || !frame->set(_scratch->durations(), _scratch->length(),
+                                   _scratch->frequency(),
+                                   _scratch->dutyCycle())) {
+    delete frame;
+    return false;
+  }
+  ir_macro_step_t *step = &_steps[_length++];
+  step->frame = frame;
+  step->emitter = emitter;
+  step->gap = gap;
+  return true;
+}
+
+/// Get the nr. of steps (incl. waits) it has.
+/// @return The nr. of steps.
+uint8_t IRmacro::length(void) { return _length; }
+
+/// Forget every step. It is stopped first, if it is running.
+void IRmacro::clear(void) {
+  stop();
+  for (uint8_t i = 0; i < _length; i++) delete _steps[i].frame;
+  _length = 0;
+}
+
+/// Calculate the least time it can take to run. i.e. If every GPIO sends in
+/// the background.
+/// @return Nr. of microseconds. Incl. the gaps after the last steps.
+uint32_t IRmacro::getDuration(void) {
+  uint32_t total = 0;
+  for (uint16_t from = 0; from <= _length;) {
+    const uint8_t end = _waitAfter(from);
+    uint32_t longest = 0;
+    for (uint8_t n = 0; n < _emitter_count; n++) {
+      uint32_t usecs = 0;
+      for (uint8_t i = from; i < end; i++) {
+        if (_steps[i].emitter != n) continue;
+        const IRsequence *frame = _steps[i].frame;
+        for (uint16_t d = 0; d < frame->length(); d++)
+          usecs += frame->durations()[d];
+        usecs += _steps[i].gap;
+      }
+      if (usecs > longest) longest = usecs;
+    }
+    total += longest;
+    if (end < _length) total += _steps[end].gap;
+    from = end + 1;
+  }
+  return total;
+}
+
+/// Get the `IRsend` object a GPIO's steps are sent with. e.g. To call its
+/// `enableRmtSend()` so they are sent in the background.
+/// @param[in] pin The GPIO.
+/// @return A Ptr to it, or NULL if no step for that GPIO has been added yet.
+IRsend *IRmacro::getEmitter(const uint16_t pin) {
+  for (uint8_t i = 0; i < _emitter_count; i++)
+    if (_emitters[i].pin == pin) return _emitters[i].irsend;
+  return NULL;
+}
+
+/// Start running it, from the first step. If it is already running, it
+/// starts again.
+/// @return true, if it was started. false if it has no steps.
+bool IRmacro::start(void) {
+  if (!_length) return false;
+  for (uint8_t n = 0; n < _emitter_count; n++) {
+    _cursor[n] = 0;
+    _emitters[n].wait = 0;
+  }
+  _end = _waitAfter(0);
+  _waiting = false;
+  _running = true;
+  return true;
+}
+
+/// Send the next step of each GPIO, if it is time to. i.e. The previous step
+/// of that GPIO has been sent, & the gap after it has passed.
+/// Call it often while it is running. e.g. From `loop()`.
+/// @return true, if a step was sent (or started). Otherwise false.
+/// @note Every GPIO whose `IRsend` can send in the background (See
+///   `IRsend::enableRmtSend()` or `enableTimerSend()`) is started at once.
+///   Otherwise only one step is sent per call, & it returns once it has
+///   been.
+bool IRmacro::handle(void) {
+  if (!_running) return false;
+  bool sent = false;
+  bool done = true;  // Has every step before `_end` been sent, & its gap?
+  for (uint8_t n = 0; n < _emitter_count; n++) {
+    irac_batch_emitter_t *emitter = &_emitters[n];
+#if IRSEND_ASYNC
+    if (emitter->irsend->isBusy()) {
+      done = false;
+      continue;
+    }
+#endif  // IRSEND_ASYNC
+    if (emitter->since.elapsed() < emitter->wait) {
+      done = false;
+      continue;
+    }
+    const int16_t next = _nextStep(n);
+    if (next < 0) continue;
+    done = false;
+    const ir_macro_step_t *step = &_steps[next];
+    _cursor[n] = next + 1;
+    emitter->wait = step->gap;
+#if IRSEND_ASYNC
+    if (emitter->irsend->beginAsync()) {
+      emitter->irsend->sendSequence(step->frame);
+      if (emitter->irsend->sendAsync()) {
+        // It is sent in the background, so its length is part of the wait.
+        const uint16_t *durations = step->frame->durations();
+        for (uint16_t i = 0; i < step->frame->length(); i++)
+          emitter->wait += durations[i];
+        emitter->since.reset();
+        sent = true;
+        continue;
+      }
+    }
+#endif  // IRSEND_ASYNC
+    emitter->irsend->sendSequence(step->frame);
+    emitter->since.reset();
+    return true;  // Don't hold up the caller any longer.
+  }
+  if (done) {
+    if (!_waiting) {
+      _waiting = true;
+      _waited.reset();
+    }
+    if (_end >= _length) {
+      _running = false;  // Every step has been sent.
+    } else if (_waited.elapsed() >= _steps[_end].gap) {
+      for (uint8_t n = 0; n < _emitter_count; n++) _cursor[n] = _end + 1;
+      _end = _waitAfter(_end + 1);
+      _waiting = false;
+    }
+  }
+  return sent;
+}
+
+/// Is it running? i.e. Has it been started, & not every step sent yet?
+/// @return true, if it is. Otherwise false.
+bool IRmacro::isRunning(void) { return _running; }
+
+/// Stop running it. A step being sent in the background is finished.
+void IRmacro::stop(void) { _running = false; }
+
+/// Find (or add) the emitter for a GPIO.
+/// @param[in] pin The GPIO.
+/// @return The index of it in `_emitters`, or -1 if there are too many, or
+///   it is running.
+int8_t IRmacro::_findEmitter(const uint16_t pin) {
+  if (_running || _scratch == NULL) return -1;
+  for (uint8_t i = 0; i < _emitter_count; i++)
+    if (_emitters[i].pin == pin) return i;
+  if (_emitter_count >= kMacroMaxEmitters) return -1;
+  irac_batch_emitter_t *emitter = &_emitters[_emitter_count];
+  void *memory = malloc(sizeof(irac_batch_send_t));
+  if (memory == NULL) return -1;
+  emitter->irsend = new (memory) irac_batch_send_t(pin, _inverted,
+                                                    _modulation);
+  emitter->irsend->begin();
+  emitter->pin = pin;
+  emitter->wait = 0;
+  _cursor[_emitter_count] = 0;
+  return _emitter_count++;
+}
+
+/// Find the first wait at, or after, a step.
+/// @param[in] from The index of the step.
+/// @return The index of the wait, or `_length` if there isn't one.
+uint8_t IRmacro::_waitAfter(const uint8_t from) {
+  for (uint8_t i = from; i < _length; i++)
+    if (_steps[i].frame == NULL) return i;
+  return _length;
+}
+
+/// Find the step an emitter should send next, before the current wait.
+/// @param[in] emitter The index of the emitter.
+/// @return The index of the step, or -1 if it has none left to send.
+int16_t IRmacro::_nextStep(const uint8_t emitter) {
+  for (uint8_t i = _cursor[emitter]; i < _end; i++)
+    if (_steps[i].emitter == emitter) return i;
+  return -1;
+}
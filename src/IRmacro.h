@@ -0,0 +1,99 @@
+#ifndef IRMACRO_H_
+#define IRMACRO_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRac.h"
+#include "IRsend.h"
+#include "IRtimer.h"
+
+// Constants
+/// Default nr. of steps an `IRmacro` can hold.
+const uint8_t kMacroDefaultSize = 16;
+/// Max. nr. of different GPIOs an `IRmacro` can send from.
+const uint8_t kMacroMaxEmitters = 8;
+
+/// A compiled step of an `IRmacro`.
+typedef struct {
+  IRsequence *frame;  ///< What to send. NULL if it is a wait. See `addWait()`.
+  uint8_t emitter;  ///< The index of the emitter to send it from.
+  uint32_t gap;  ///< Time after it before the next from its GPIO. (usecs)
+} ir_macro_step_t;
+
+/// A scene for many devices. e.g. "Movie mode": TV on, input HDMI2, AVR on, &
+/// the A/C at 23C & quiet. Each step (a message for a GPIO, & the gap a device
+/// needs after it) is compiled when it is added, so the macro can be run as
+/// often as needed without computing any message again.
+/// When run, `handle()` (called from `loop()`) sends the steps of each GPIO
+/// in order, & the steps of different GPIOs at the same time, if the `IRsend`
+/// objects of those GPIOs can send in the background. See `getEmitter()`.
+/// i.e. The scene takes as little time as it can, & never blocks for a gap.
+/// e.g.
+/// @code
+///   IRmacro movie;
+///   movie.add(kTvGpio, decode_type_t::SAMSUNG, kTvPower, kSamsungBits,
+///             kNoRepeat, 3000000);  // The TV takes 3 seconds to boot.
+///   movie.add(kTvGpio, decode_type_t::SAMSUNG, kTvHdmi2, kSamsungBits);
+///   movie.add(kAvrGpio, decode_type_t::DENON, kAvrOn, kDenonBits);
+///   movie.add(kAcGpio, ac_state);
+///   ...
+///   movie.start();
+///   ...
+///   void loop() { movie.handle(); ... }
+/// @endcode
+class IRmacro {
+ public:
+  explicit IRmacro(const uint8_t size = kMacroDefaultSize,
+                   const bool inverted = false,
+                   const bool use_modulation = true,
+                   const uint16_t frame_size = kSequenceDefaultSize);
+  ~IRmacro(void);
+  bool add(const uint16_t pin, const decode_type_t type, const uint64_t data,
+           const uint16_t nbits, const uint16_t repeat = kNoRepeat,
+           const uint32_t gap = 0);
+  bool add(const uint16_t pin, const decode_type_t type,
+           const uint8_t *state, const uint16_t nbytes,
+           const uint32_t gap = 0);
+  bool add(const uint16_t pin, const stdAc::state_t &state,
+           const uint32_t gap = 0);
+  bool add(const uint16_t pin, const IRsequence *sequence,
+           const uint32_t gap = 0);
+  bool addWait(const uint32_t usecs = 0);
+  uint8_t length(void);
+  void clear(void);
+  uint32_t getDuration(void);
+  IRsend *getEmitter(const uint16_t pin);
+  bool start(void);
+  bool handle(void);
+  bool isRunning(void);
+  void stop(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  ir_macro_step_t *_steps;
+  uint8_t _size;
+  uint8_t _length;  // Nr. of steps added.
+  IRsequence *_scratch;  // Where a step is compiled before it is copied.
+  IRac _ac;  // Compiles the A/C states.
+  irac_batch_emitter_t _emitters[kMacroMaxEmitters];
+  uint8_t _cursor[kMacroMaxEmitters];  // Where each GPIO's next step may be.
+  uint8_t _emitter_count;
+  bool _inverted;  // Is the IR LED lit when a GPIO is LOW?
+  bool _modulation;  // Is frequency modulation to be used?
+  bool _running;
+  uint8_t _end;  // The wait the running steps are before. Or `_length`.
+  bool _waiting;  // Have all the steps before `_end` been sent?
+  IRtimer _waited;  // Since they were.
+  int8_t _findEmitter(const uint16_t pin);
+  bool _add(const int8_t emitter, const uint32_t gap);
+  uint8_t _waitAfter(const uint8_t from);
+  int16_t _nextStep(const uint8_t emitter);
+  IRmacro(const IRmacro &);  // Not copyable, as it owns memory.
+  IRmacro &operator=(const IRmacro &);
+};
+
+#endif  // IRMACRO_H_
@@ -0,0 +1,530 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRrecorder.cpp
+/// @brief Record captures to flash in the background, for field diagnostics.
+
+#include "IRrecorder.h"
+#include <string.h>
+#include <algorithm>
+#include "IRutils.h"
+#if IRRECORDER_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif  // IRRECORDER_TASK
+
+#if IRRECORDER_TASK
+// The staging is shared between `add()` & the recorder's task, on either core.
+static portMUX_TYPE recorder_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif  // IRRECORDER_TASK
+
+/// Start changing/reading where the staged captures start or end.
+static inline void recorderLock(void) {
+#if IRRECORDER_TASK
+  portENTER_CRITICAL(&recorder_mux);
+#endif  // IRRECORDER_TASK
+}
+
+/// Finish changing/reading where the staged captures start or end.
+static inline void recorderUnlock(void) {
+#if IRRECORDER_TASK
+  portEXIT_CRITICAL(&recorder_mux);
+#endif  // IRRECORDER_TASK
+}
+
+/// Read a little-endian 32 bit value.
+/// @param[in] ptr A ptr to the value.
+/// @return The value.
+static uint32_t recorderGet(const uint8_t *ptr) {
+  return ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16) |
+      ((uint32_t)ptr[3] << 24);
+}
+
+#if defined(ESP32) && !defined(UNIT_TEST)
+/// Constructor.
+/// @param[in] label The name of the partition.
+IRpartitionStorage::IRpartitionStorage(const char *label) :
+    _partition(esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                        ESP_PARTITION_SUBTYPE_ANY, label)) {}
+
+uint32_t IRpartitionStorage::size(void) const {
+  if (_partition == NULL) return 0;
+  return _partition->size - _partition->size % kRecorderSectorSize;
+}
+
+bool IRpartitionStorage::erase(const uint32_t offset) {
+  return _partition != NULL && esp_partition_erase_range(
+      _partition, offset, kRecorderSectorSize) == ESP_OK;
+}
+
+bool IRpartitionStorage::write(const uint32_t offset, const uint8_t *data,
+                               const uint32_t length) {
+  return _partition != NULL &&
+      esp_partition_write(_partition, offset, data, length) == ESP_OK;
+}
+
+bool IRpartitionStorage::read(const uint32_t offset, uint8_t *data,
+                              const uint32_t length) {
+  return _partition != NULL &&
+      esp_partition_read(_partition, offset, data, length) == ESP_OK;
+}
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
+#if defined(ESP8266) && !defined(UNIT_TEST)
+/// Constructor.
+/// @param[in] first The nr. of the first sector of the flash to use.
+/// @param[in] sectors Nr. of sectors to use.
+IRsectorStorage::IRsectorStorage(const uint32_t first, const uint32_t sectors)
+    : _first(first), _sectors(sectors) {}
+
+uint32_t IRsectorStorage::size(void) const {
+  return _sectors * kRecorderSectorSize;
+}
+
+bool IRsectorStorage::erase(const uint32_t offset) {
+  return ESP.flashEraseSector(_first + offset / kRecorderSectorSize);
+}
+
+bool IRsectorStorage::write(const uint32_t offset, const uint8_t *data,
+                            const uint32_t length) {
+  return ESP.flashWrite(
+      _first * kRecorderSectorSize + offset,
+      reinterpret_cast<uint32_t *>(const_cast<uint8_t *>(data)), length);
+}
+
+bool IRsectorStorage::read(const uint32_t offset, uint8_t *data,
+                           const uint32_t length) {
+  const uint32_t start = _first * kRecorderSectorSize + offset;
+  // The SDK only reads whole, aligned words.
+  if (!(start % 4) && !(length % 4) &&
+      !(reinterpret_cast<uintptr_t>(data) % 4))
+    return ESP.flashRead(start, reinterpret_cast<uint32_t *>(data), length);
+  for (uint32_t done = 0; done < length;) {
+    const uint32_t address = start + done;
+    const uint8_t skip = address % 4;
+    uint32_t word;
+    if (!ESP.flashRead(address - skip, &word, 4)) return false;
+    const uint32_t nbytes = std::min(length - done, (uint32_t)(4 - skip));
+    memcpy(data + done, reinterpret_cast<uint8_t *>(&word) + skip, nbytes);
+    done += nbytes;
+  }
+  return true;
+}
+#endif  // defined(ESP8266) && !defined(UNIT_TEST)
+
+/// Class constructor.
+/// @param[in] storage Where to record the captures. It is used as a whole.
+/// @param[in] staging Nr. of bytes of RAM to stage captures in, until they
+///   are written. i.e. Enough for those that may arrive during a sector
+///   erase. A capture typically takes 1-2 bytes per `rawbuf[]` entry.
+IRrecorder::IRrecorder(IRflashStorage *storage, const uint16_t staging)
+    : _storage(storage), _staging(NULL), _staging_size(staging & ~3),
+      _head(0), _tail(0), _begun(false), _sectors(0), _sector_size(0),
+      _sector(0), _pos(0), _seq(0), _erased(false), _next_erased(false),
+      _written(0), _recorded(0), _dropped(0) {
+  if (_staging_size) _staging = new uint32_t[_staging_size / 4];
+  if (_staging == NULL) _staging_size = 0;
+  _rewind();
+#if IRRECORDER_TASK
+  _task = NULL;
+  _task_stop = false;
+  _task_running = false;
+#endif  // IRRECORDER_TASK
+}
+
+/// Class destructor. Anything still staged is written first.
+IRrecorder::~IRrecorder(void) {
+  end();
+  delete[] _staging;
+}
+
+/// Start recording, after the newest captures already in the storage.
+/// On the ESP32, it starts the task that writes them to flash.
+/// @return true, if it is recording. false if the storage can't be used.
+///   e.g. It is too small. It needs at least 2 sectors.
+bool IRrecorder::begin(void) {
+  if (_begun) return true;
+  if (_storage == NULL || _staging == NULL) return false;
+  _sector_size = _storage->sectorSize();
+  _sectors = _sector_size ? _storage->size() / _sector_size : 0;
+  // One for the captures, & one erased ahead of them.
+  if (_sectors < 2 ||
+      _sector_size < kRecorderSectorHeaderSize + kCaptureRecordHeaderSize)
+    return false;
+  // Carry on from the newest sector. i.e. Where it left off.
+  _seq = 0;
+  uint32_t newest = _sectors - 1;
+  for (uint32_t sector = 0; sector < _sectors; sector++) {
+    uint32_t seq;
+    if (_sectorStarted(sector, &seq) && seq > _seq) {
+      _seq = seq;
+      newest = sector;
+    }
+  }
+  // The capture it was writing may have been cut short, so start afresh.
+  _sector = (newest + 1) % _sectors;
+  _pos = 0;
+  _erased = false;
+  _next_erased = false;
+  _written = 0;
+  _rewind();
+  _begun = true;
+#if IRRECORDER_TASK
+  _startTask();  // If it can't be, handle() will have to do.
+#endif  // IRRECORDER_TASK
+  return true;
+}
+
+/// Stop recording, once everything staged has been written.
+void IRrecorder::end(void) {
+  if (!_begun) return;
+#if IRRECORDER_TASK
+  _stopTask();
+#endif  // IRRECORDER_TASK
+  flush();
+  _begun = false;
+}
+
+/// Record a capture. It is staged in RAM, to be written to flash in the
+/// background. See `handle()`. It is safe to call before `begin()`.
+/// @param[in] results A ptr to the capture. Its `decode_type` is recorded as
+///   a hint of what protocol it is.
+/// @param[in] frequency The carrier frequency, in kHz.
+/// @param[in] timestamp When it was captured. e.g. `millis()`
+/// @return true, if it was staged. false if it was dropped, as the staging
+///   is too full (or too small) for it.
+bool IRrecorder::add(const decode_results * const results,
+                     const uint16_t frequency, const uint32_t timestamp) {
+  if (results == NULL || _staging == NULL) return false;
+  const uint32_t size = irutils::CaptureWriter::recordSize(results);
+  recorderLock();
+  const uint16_t head = _head;
+  recorderUnlock();
+  uint16_t tail = _tail;
+  // A gap is kept before the oldest, so a full staging isn't an empty one.
+  bool wrap = false;
+  bool fits = _sector_size == 0 ||
+      size <= _sector_size - kRecorderSectorHeaderSize;
+  if (head <= tail) {
+    if (size + (head ? 0 : 4) > (uint32_t)(_staging_size - tail)) {
+      wrap = true;  // It doesn't fit before the end, so try the start.
+      fits = fits && size + 4 <= head;
+    }
+  } else {
+    fits = fits && size + 4 <= (uint32_t)(head - tail);
+  }
+  if (!fits) {
+    _dropped++;
+    return false;
+  }
+  uint8_t *bytes = reinterpret_cast<uint8_t *>(_staging);
+  if (wrap) {
+    memset(bytes + tail, 0, 4);  // i.e. Go back to the start.
+    tail = 0;
+  }
+  irutils::CaptureWriter writer(bytes + tail, size);
+  writer.add(results, frequency, timestamp);
+  tail += size;
+  if (tail >= _staging_size) tail = 0;
+  recorderLock();
+  _tail = tail;
+  recorderUnlock();
+  return true;
+}
+
+/// Do the next step of writing the staged captures to flash. Call it often
+/// from your main loop. Each step erases a sector, or writes up to
+/// `kRecorderChunkSize` bytes. So it never blocks for longer than that does.
+/// @return true, if it did something. false if there was nothing to do.
+/// @note On the ESP32, the recorder's task does it. So it does nothing.
+bool IRrecorder::handle(void) {
+#if IRRECORDER_TASK
+  if (_task != NULL) return false;
+#endif  // IRRECORDER_TASK
+  return _step();
+}
+
+/// Write everything staged so far to flash. It blocks until it is done.
+/// e.g. Before a restart.
+void IRrecorder::flush(void) {
+#if IRRECORDER_TASK
+  if (_task != NULL) {
+    while (pending()) vTaskDelay(1);
+    return;
+  }
+#endif  // IRRECORDER_TASK
+  while (_step()) {}
+}
+
+/// Erase all of the recorded captures. It blocks until it is done.
+/// @return true, if it was successful. false if not.
+bool IRrecorder::clear(void) {
+  if (!_begun) return false;
+#if IRRECORDER_TASK
+  _stopTask();
+#endif  // IRRECORDER_TASK
+  bool success = true;
+  for (uint32_t sector = 0; sector < _sectors; sector++)
+    if (!_storage->erase(sector * _sector_size)) success = false;
+  _sector = 0;
+  _pos = 0;
+  _erased = success;
+  _next_erased = success;
+  _written = 0;  // The capture being written starts again.
+  _rewind();
+#if IRRECORDER_TASK
+  _startTask();
+#endif  // IRRECORDER_TASK
+  return success;
+}
+
+/// Read part of the recorded captures, as a capture file. Oldest first.
+/// e.g. To send it in pieces, over MQTT or HTTP.
+/// @param[in] offset Where in the capture file to read from. It is quickest
+///   to read it in order. Reading from 0 starts a new copy of it.
+/// @param[out] buffer Where to copy it to.
+/// @param[in] size The most bytes to copy.
+/// @return The nr. of bytes copied. 0 at the end of the file.
+/// @note A capture recorded while it is being read is included if it is
+///   written before it is reached. One overwritten while it is being read
+///   (i.e. if the storage fills up) may be garbled. `tools/capture_stream.py`
+///   skips those.
+uint32_t IRrecorder::read(const uint32_t offset, uint8_t *buffer,
+                          const uint32_t size) {
+  if (!_begun || buffer == NULL) return 0;
+  if (!offset || offset < _rd_offset) _rewind();
+  if (offset > _rd_offset) _advance(NULL, offset - _rd_offset);
+  if (offset != _rd_offset) return 0;  // It is past the end.
+  return _advance(buffer, size);
+}
+
+/// Nr. of bytes the capture file of the recorded captures would be now.
+/// e.g. For an HTTP `Content-Length`, or an MQTT message's length.
+/// @return The nr. of bytes.
+uint32_t IRrecorder::length(void) {
+  if (!_begun) return 0;
+  _rewind();
+  const uint32_t total = _advance(NULL, UINT32_MAX);
+  _rewind();
+  return total;
+}
+
+#ifdef ARDUINO
+/// Send the recorded captures, as a capture file. Oldest first.
+/// @param[in,out] output Where to send it. e.g. An HTTP client, or a file.
+/// @return The nr. of bytes sent.
+uint32_t IRrecorder::stream(Print *output) {
+  uint8_t buffer[kRecorderChunkSize];
+  uint32_t total = 0;
+  for (uint32_t nbytes = read(0, buffer, sizeof(buffer)); nbytes;
+       nbytes = read(total, buffer, sizeof(buffer))) {
+    output->write(buffer, nbytes);
+    total += nbytes;
+  }
+  return total;
+}
+#endif  // ARDUINO
+
+/// Get the nr. of captures written to flash.
+/// @return The count.
+uint32_t IRrecorder::getRecorded(void) const { return _recorded; }
+
+/// Get the nr. of captures dropped, as the staging had no room for them.
+/// i.e. They arrived faster than they could be written.
+/// @return The count.
+uint32_t IRrecorder::getDropped(void) const { return _dropped; }
+
+/// Get the nr. of bytes staged, waiting to be written to flash.
+/// @return The nr. of bytes.
+uint16_t IRrecorder::pending(void) const {
+  if (!_staging_size) return 0;
+  recorderLock();
+  const uint16_t used = (_tail + _staging_size - _head) % _staging_size;
+  recorderUnlock();
+  return used;
+}
+
+/// Do the next step of writing the staged captures to flash.
+/// @return true, if it did something. false if there was nothing to do.
+bool IRrecorder::_step(void) {
+  if (!_begun) return false;
+  const uint32_t next = (_sector + 1) % _sectors;
+  if (!_erased) {
+    _erased = _storage->erase(_sector * _sector_size);
+    return true;
+  }
+  if (!_next_erased) {  // So a full sector never has to wait for an erase.
+    _next_erased = _storage->erase(next * _sector_size);
+    return true;
+  }
+  recorderLock();
+  uint16_t head = _head;
+  const uint16_t tail = _tail;
+  recorderUnlock();
+  if (head == tail) return false;
+  const uint32_t size = _staged(head);
+  if (!size) {  // The rest of the staging wasn't used.
+    recorderLock();
+    _head = 0;
+    recorderUnlock();
+    return true;
+  }
+  if (!_written && (!_pos || _pos + size > _sector_size)) {
+    if (_pos) {  // It is full. Move on to the (erased) one after it.
+      _sector = next;
+      _next_erased = false;
+    }
+    uint32_t header[kRecorderSectorHeaderSize / 4];
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(header);
+    memcpy(bytes, kRecorderMagic, 4);
+    for (uint8_t i = 0; i < 4; i++) bytes[4 + i] = (_seq + 1) >> (i * 8);
+    if (_storage->write(_sector * _sector_size, bytes, sizeof(header))) {
+      _seq++;
+      _pos = kRecorderSectorHeaderSize;
+    }
+    return true;
+  }
+  // Its size is written last. So one cut short (e.g. by a reset) isn't read.
+  const uint32_t offset = _sector * _sector_size + _pos;
+  const uint8_t *record = reinterpret_cast<const uint8_t *>(_staging) + head;
+  if (_written + 4 < size) {
+    const uint32_t nbytes = std::min(size - 4 - _written,
+                                     (uint32_t)kRecorderChunkSize);
+    if (_storage->write(offset + 4 + _written, record + 4 + _written, nbytes))
+      _written += nbytes;
+    return true;
+  }
+  if (!_storage->write(offset, record, 4)) return true;
+  _pos += size;
+  _written = 0;
+  _recorded++;
+  head += size;
+  if (head >= _staging_size) head = 0;
+  recorderLock();
+  _head = head;
+  recorderUnlock();
+  return true;
+}
+
+/// Read a value from the staging.
+/// @param[in] offset Where it is.
+/// @return The value.
+uint32_t IRrecorder::_staged(const uint16_t offset) const {
+  return recorderGet(reinterpret_cast<const uint8_t *>(_staging) + offset);
+}
+
+/// Has a sector been started? i.e. Does it hold captures.
+/// @param[in] sector The nr. of the sector.
+/// @param[out] seq Its sequence nr.
+/// @return true, if it has been. Otherwise false.
+bool IRrecorder::_sectorStarted(const uint32_t sector, uint32_t *seq) {
+  uint8_t header[kRecorderSectorHeaderSize];
+  if (!_storage->read(sector * _sector_size, header, sizeof(header)) ||
+      memcmp(header, kRecorderMagic, 4)) return false;
+  *seq = recorderGet(header + 4);
+  return true;
+}
+
+/// Start reading the capture file from the beginning.
+void IRrecorder::_rewind(void) {
+  _rd_offset = 0;
+  _rd_sectors = 0;
+  _rd_pos = 0;
+  _rd_end = 0;
+  _rd_limit = 0;
+}
+
+/// Read the next part of the capture file.
+/// @param[out] buffer Where to copy it to. NULL to skip over it.
+/// @param[in] length The most bytes to read.
+/// @return The nr. of bytes read.
+uint32_t IRrecorder::_advance(uint8_t *buffer, const uint32_t length) {
+  uint8_t header[kCaptureFileHeaderSize];
+  irutils::CaptureWriter writer(header, sizeof(header));
+  writer.begin();
+  uint32_t done = 0;
+  while (done < length) {
+    uint32_t nbytes;
+    if (_rd_offset < kCaptureFileHeaderSize) {
+      nbytes = std::min(kCaptureFileHeaderSize - _rd_offset, length - done);
+      if (buffer != NULL) memcpy(buffer + done, header + _rd_offset, nbytes);
+    } else {
+      if (_rd_pos == _rd_end && !_nextCapture()) break;
+      nbytes = std::min(_rd_end - _rd_pos, length - done);
+      if (buffer != NULL && !_storage->read(_rd_pos, buffer + done, nbytes))
+        break;
+      _rd_pos += nbytes;
+    }
+    _rd_offset += nbytes;
+    done += nbytes;
+  }
+  return done;
+}
+
+/// Find the next capture in the storage to read. Oldest first.
+/// @return true, if there is one. false if there are no more.
+bool IRrecorder::_nextCapture(void) {
+  while (_rd_sectors < _sectors) {
+    if (!_rd_limit) {  // Start on the next sector.
+      const uint32_t sector = (_sector + 1 + _rd_sectors) % _sectors;
+      uint32_t seq;
+      // The one being written holds old captures, until it is started.
+      if ((sector == _sector && !_pos) || !_sectorStarted(sector, &seq)) {
+        _rd_sectors++;
+        continue;
+      }
+      _rd_pos = sector * _sector_size + kRecorderSectorHeaderSize;
+      _rd_limit = (sector + 1) * _sector_size;
+    }
+    uint8_t bytes[4];
+    if (_rd_limit - _rd_pos >= kCaptureRecordHeaderSize &&
+        _storage->read(_rd_pos, bytes, sizeof(bytes))) {
+      const uint32_t size = recorderGet(bytes);
+      // Erased (0xFF) storage, or a capture that isn't finished, ends it.
+      if (size >= kCaptureRecordHeaderSize && !(size % 4) &&
+          size <= _rd_limit - _rd_pos) {
+        _rd_end = _rd_pos + size;
+        return true;
+      }
+    }
+    _rd_limit = 0;
+    _rd_sectors++;
+  }
+  return false;
+}
+
+#if IRRECORDER_TASK
+/// Start the task that writes the staged captures to flash.
+/// @return true, if it was started. Otherwise false.
+bool IRrecorder::_startTask(void) {
+  if (_task != NULL) return true;
+  _task_stop = false;
+  _task_running = true;
+  TaskHandle_t task = NULL;
+  if (xTaskCreate(_recorderTask, "IRrecorder", kRecorderTaskStackSize, this,
+                  kRecorderTaskPriority, &task) != pdPASS) {
+    _task_running = false;
+    return false;
+  }
+  _task = task;
+  return true;
+}
+
+/// Stop the task, once it has finished its current step.
+void IRrecorder::_stopTask(void) {
+  if (_task == NULL) return;
+  _task_stop = true;
+  while (_task_running) vTaskDelay(1);  // It deletes itself.
+  _task = NULL;
+}
+
+/// The body of the recorder's task.
+/// @param[in] arg The IRrecorder instance it is writing for.
+void IRrecorder::_recorderTask(void *arg) {
+  IRrecorder *recorder = static_cast<IRrecorder *>(arg);
+  while (!recorder->_task_stop)
+    // A tick between steps, so lower priority tasks (e.g. idle) still run.
+    vTaskDelay(recorder->_step() ? 1 : pdMS_TO_TICKS(10));
+  recorder->_task_running = false;
+  vTaskDelete(NULL);
+}
+#endif  // IRRECORDER_TASK
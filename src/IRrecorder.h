@@ -0,0 +1,207 @@
+#ifndef IRRECORDER_H_
+#define IRRECORDER_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif  // ARDUINO
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+#if defined(ESP32) && !defined(UNIT_TEST)
+#include <esp_partition.h>
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
+// The recorder writes to flash from a FreeRTOS task of its own on the ESP32.
+#if defined(ESP32) && !defined(UNIT_TEST)
+#define IRRECORDER_TASK true
+#else  // defined(ESP32) && !defined(UNIT_TEST)
+#define IRRECORDER_TASK false
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
+// Constants
+/// The first bytes of each flash sector an `IRrecorder` has started.
+const char kRecorderMagic[] = "IRrs";
+/// Nr. of bytes of the header of each sector. The magic & its sequence nr.
+const uint8_t kRecorderSectorHeaderSize = 8;
+/// Default nr. of bytes of RAM to stage captures in, until they are written.
+const uint16_t kRecorderDefaultStaging = 2048;
+/// Most bytes written to flash by each step of the recorder.
+const uint16_t kRecorderChunkSize = 256;
+/// Size of the erasable sectors of most SPI flash chips. (Bytes)
+const uint16_t kRecorderSectorSize = 4096;
+/// Priority of the recorder's task. The same as `loop()`'s, so it gets the
+/// time it leaves, but never holds up anything more important.
+const uint8_t kRecorderTaskPriority = 1;
+/// Stack size of the recorder's task. (Bytes)
+const uint16_t kRecorderTaskStackSize = 3072;
+
+/// The flash an `IRrecorder` records to. e.g. A partition, or a range of
+/// sectors. Plug in your own for other storage (or a simulation of it).
+/// It must behave like NOR flash: Erasing a sector sets all of its bytes to
+/// 0xFF, & writes can only clear bits.
+class IRflashStorage {
+ public:
+  virtual ~IRflashStorage(void) {}
+  /// Nr. of bytes of storage. A multiple of `sectorSize()`.
+  virtual uint32_t size(void) const = 0;
+  /// Nr. of bytes of each sector. i.e. What `erase()` erases.
+  virtual uint32_t sectorSize(void) const { return kRecorderSectorSize; }
+  /// Erase a sector.
+  /// @param[in] offset Where it starts.
+  /// @return true, if it was erased.
+  virtual bool erase(const uint32_t offset) = 0;
+  /// Write to erased storage.
+  /// @param[in] offset Where to. A multiple of 4.
+  /// @param[in] data What to write. 4 byte aligned.
+  /// @param[in] length Nr. of bytes. A multiple of 4.
+  /// @return true, if it was written.
+  virtual bool write(const uint32_t offset, const uint8_t *data,
+                     const uint32_t length) = 0;
+  /// Read from the storage.
+  /// @param[in] offset Where from. Any offset.
+  /// @param[out] data Where to. Any alignment.
+  /// @param[in] length Nr. of bytes.
+  /// @return true, if it was read.
+  virtual bool read(const uint32_t offset, uint8_t *data,
+                    const uint32_t length) = 0;
+};
+
+#if defined(ESP32) && !defined(UNIT_TEST)
+/// A data partition of the ESP32's flash. e.g. A line in partitions.csv of:
+///   ircapture, data, 0x99, , 256K,
+class IRpartitionStorage : public IRflashStorage {
+ public:
+  explicit IRpartitionStorage(const char *label);
+  uint32_t size(void) const;
+  bool erase(const uint32_t offset);
+  bool write(const uint32_t offset, const uint8_t *data,
+             const uint32_t length);
+  bool read(const uint32_t offset, uint8_t *data, const uint32_t length);
+
+ private:
+  const esp_partition_t *_partition;  // NULL if there isn't one.
+};
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
+#if defined(ESP8266) && !defined(UNIT_TEST)
+/// A range of the ESP8266's flash sectors. e.g. A file system's area, when it
+/// doesn't have one:
+///   IRsectorStorage storage(
+///       ((uint32_t)&_FS_start - 0x40200000) / SPI_FLASH_SEC_SIZE,
+///       ((uint32_t)&_FS_end - (uint32_t)&_FS_start) / SPI_FLASH_SEC_SIZE);
+class IRsectorStorage : public IRflashStorage {
+ public:
+  IRsectorStorage(const uint32_t first, const uint32_t sectors);
+  uint32_t size(void) const;
+  bool erase(const uint32_t offset);
+  bool write(const uint32_t offset, const uint8_t *data,
+             const uint32_t length);
+  bool read(const uint32_t offset, uint8_t *data, const uint32_t length);
+
+ private:
+  uint32_t _first;  // The first sector.
+  uint32_t _sectors;
+};
+#endif  // defined(ESP8266) && !defined(UNIT_TEST)
+
+/// Records every capture it is given to flash, for field diagnostics, without
+/// blocking the caller on flash writes & erases. e.g. As writing text dumps
+/// to SPIFFS from `loop()` does, which drops messages during the erases.
+/// `add()` only serialises the capture into a bounded RAM staging buffer. The
+/// captures are written to flash from there in the background: By a low
+/// priority task on the ESP32, or by small steps of `handle()` called from
+/// `loop()` elsewhere. Each step erases a sector, or writes at most
+/// `kRecorderChunkSize` bytes. A capture that doesn't fit in the staging is
+/// dropped & counted, rather than waited for.
+/// The storage is used as a ring of sectors, with the next one always erased
+/// ahead of time. So the oldest captures are overwritten once it is full, &
+/// every sector is erased equally often. i.e. Wear levelled. Recording
+/// carries on where it left off after a reboot.
+/// The captures are stored in the capture file format (See
+/// `irutils::CaptureWriter`), & read back as one capture file, oldest first.
+/// e.g. To download it over HTTP, for `tools/gc_decode -capture` or
+/// `tools/capture_stream.py`, or to benchmark decoding offline:
+/// @code
+///   IRpartitionStorage storage("ircapture");
+///   IRrecorder recorder(&storage);
+///   ...
+///   recorder.begin();
+///   ...
+///   if (irrecv.decode(&results)) recorder.add(&results, 38, millis());
+///   recorder.handle();  // Not needed on the ESP32.
+///   ...
+///   server.on("/captures.irc", []() {
+///     server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+///     server.send(200, "application/octet-stream", "");
+///     recorder.stream(&server.client());
+///   });
+/// @endcode
+/// Or in pieces of any size, with `read()`. e.g. As MQTT messages.
+class IRrecorder {
+ public:
+  explicit IRrecorder(IRflashStorage *storage,
+                      const uint16_t staging = kRecorderDefaultStaging);
+  ~IRrecorder(void);
+  bool begin(void);
+  void end(void);
+  bool add(const decode_results * const results,
+           const uint16_t frequency = 38, const uint32_t timestamp = 0);
+  bool handle(void);
+  void flush(void);
+  bool clear(void);
+  uint32_t read(const uint32_t offset, uint8_t *buffer, const uint32_t size);
+  uint32_t length(void);
+#ifdef ARDUINO
+  uint32_t stream(Print *output);
+#endif  // ARDUINO
+  uint32_t getRecorded(void) const;
+  uint32_t getDropped(void) const;
+  uint16_t pending(void) const;
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRflashStorage *_storage;
+  uint32_t *_staging;  // Words, so what is written from it is aligned.
+  uint16_t _staging_size;  // Bytes.
+  volatile uint16_t _head;  // Where the oldest staged capture starts.
+  volatile uint16_t _tail;  // Where the next one will be staged.
+  bool _begun;
+  uint32_t _sectors;
+  uint32_t _sector_size;
+  uint32_t _sector;  // The sector being written.
+  uint32_t _pos;  // Where the next capture goes in it. 0 if not started.
+  uint32_t _seq;  // The sequence nr. of the newest sector.
+  bool _erased;  // Is the sector being written erased?
+  bool _next_erased;  // Is the sector after it erased?
+  uint32_t _written;  // Bytes of the oldest staged capture written so far.
+  volatile uint32_t _recorded;
+  volatile uint32_t _dropped;
+  // Where `read()` is up to.
+  uint32_t _rd_offset;  // In the capture file.
+  uint32_t _rd_sectors;  // Nr. of sectors it has finished with.
+  uint32_t _rd_pos;  // In the storage.
+  uint32_t _rd_end;  // Of the capture it is in.
+  uint32_t _rd_limit;  // Of the sector it is in. 0 if none.
+#if IRRECORDER_TASK
+  void *_task;
+  volatile bool _task_stop;
+  volatile bool _task_running;
+  bool _startTask(void);
+  void _stopTask(void);
+  static void _recorderTask(void *arg);
+#endif  // IRRECORDER_TASK
+  bool _step(void);
+  uint32_t _staged(const uint16_t offset) const;
+  bool _sectorStarted(const uint32_t sector, uint32_t *seq);
+  void _rewind(void);
+  uint32_t _advance(uint8_t *buffer, const uint32_t length);
+  bool _nextCapture(void);
+  IRrecorder(const IRrecorder &);  // Not copyable, as it owns the staging.
+  IRrecorder &operator=(const IRrecorder &);
+};
+
+#endif  // IRRECORDER_H_
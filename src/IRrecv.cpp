@@ -5,6 +5,8 @@
 
 #include "IRrecv.h"
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 #ifndef UNIT_TEST
 #if defined(ESP8266)
 extern "C" {
@@ -14,16 +16,65 @@ extern "C" {
 #endif  // ESP8266
 #include <Arduino.h>
 #endif
+#if defined(ESP32) && ENABLE_ESP32_RMT_RECV && !defined(UNIT_TEST)
+#define IRRECV_USE_RMT true
+#include <driver/rmt.h>
+#else  // defined(ESP32) && ENABLE_ESP32_RMT_RECV && !defined(UNIT_TEST)
+#define IRRECV_USE_RMT false
+#endif  // defined(ESP32) && ENABLE_ESP32_RMT_RECV && !defined(UNIT_TEST)
+#if defined(ESP8266) && ENABLE_ESP8266_TIMER_RECV && !defined(UNIT_TEST)
+#define IRRECV_USE_TIMER1 true
+#else  // defined(ESP8266) && ENABLE_ESP8266_TIMER_RECV && !defined(UNIT_TEST)
+#define IRRECV_USE_TIMER1 false
+#endif  // defined(ESP8266) && ENABLE_ESP8266_TIMER_RECV && !defined(UNIT_TEST)
+#if (defined(ESP32) && ENABLE_ESP32_TIMER_REGS && !IRRECV_USE_RMT && \
+     !defined(UNIT_TEST) && !defined(CONFIG_IDF_TARGET_ESP32S2) && \
+     !defined(CONFIG_IDF_TARGET_ESP32S3) && !defined(CONFIG_IDF_TARGET_ESP32C3))
+#define IRRECV_TIMER_REGS true
+#include <soc/soc.h>
+#include <soc/timer_group_reg.h>
+#else  // ESP32 && ENABLE_ESP32_TIMER_REGS && ...
+#define IRRECV_TIMER_REGS false
+#endif  // ESP32 && ENABLE_ESP32_TIMER_REGS && ...
+#if defined(ESP32) && ENABLE_LOW_POWER_RECV && !defined(UNIT_TEST)
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+#endif  // defined(ESP32) && ENABLE_LOW_POWER_RECV && !defined(UNIT_TEST)
+#if IRRECV_DECODE_TASK || IRRECV_DRAIN_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif  // IRRECV_DECODE_TASK || IRRECV_DRAIN_TASK
+#if defined(ESP32) && ENABLE_LARGE_CAPTURE && !defined(UNIT_TEST)
+#include <esp_heap_caps.h>
+#endif  // defined(ESP32) && ENABLE_LARGE_CAPTURE && !defined(UNIT_TEST)
+// Is a capture written by the GPIO interrupt handler where PSRAM may be used?
+// i.e. A large capture buffer needs staging. (Unit tests check it works.)
+#if ENABLE_LARGE_CAPTURE && ((defined(ESP32) && !IRRECV_USE_RMT) || \
+                             defined(UNIT_TEST))
+#define IRRECV_STAGE_CAPTURE true
+#else  // ENABLE_LARGE_CAPTURE && ...
+#define IRRECV_STAGE_CAPTURE false
+#endif  // ENABLE_LARGE_CAPTURE && ...
 #include <algorithm>
 #ifdef UNIT_TEST
 #include <cassert>
 #endif  // UNIT_TEST
+#include "IRcustom.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
+#include "IRsend.h"
 #include "IRutils.h"
+#include "i18n.h"
+#include ENQUOTE(_IR_DECODE_ORDER_)
 
 #ifdef UNIT_TEST
 #undef ICACHE_RAM_ATTR
 #define ICACHE_RAM_ATTR
+#undef USE_IRAM_ATTR
+#define USE_IRAM_ATTR
+// The simulated `micros()` from IRtimer.cpp.
+extern uint32_t _IRtimer_unittest_now;
 #endif
 
 #ifndef USE_IRAM_ATTR
@@ -35,8 +86,46 @@ extern "C" {
 #endif  // ESP32
 #endif  // USE_IRAM_ATTR
 
+// Constant data the interrupt handler reads. It can't be in flash on an ESP32.
+#if defined(ESP32) && !defined(UNIT_TEST)
+#define USE_DRAM_ATTR DRAM_ATTR
+#else  // defined(ESP32) && !defined(UNIT_TEST)
+#define USE_DRAM_ATTR
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
 #define ONCE 0
 
+/// The current time. i.e. `micros()`, or the simulated time in unit tests.
+/// Inlined, so it is safe to use in the interrupt handlers.
+/// @return The time in uSeconds.
+static inline uint32_t USE_IRAM_ATTR now_usecs(void) {
+#ifndef UNIT_TEST
+  return micros();
+#else  // UNIT_TEST
+  return _IRtimer_unittest_now;
+#endif  // UNIT_TEST
+}
+
+#if (DECODE_HASH || ENABLE_REPEAT_COALESCING || ENABLE_CAPTURE_HASH || \
+     ENABLE_DECODE_CACHE)
+/// Compare two tick values, for the decodeHash() hash.
+/// @param[in] oldval Nr. of ticks.
+/// @param[in] newval Nr. of ticks.
+/// @return 0 if newval is shorter, 1 if it is equal, & 2 if it is longer.
+/// @note Uses a tolerance of 20%, in integer maths so it is safe to use in an
+///   interrupt handler. It gives exactly the same answers as `* 0.8` does.
+static uint16_t USE_IRAM_ATTR compare_ticks(const uint32_t oldval,
+                                            const uint32_t newval) {
+  if (newval * 5 < oldval * 4)
+    return 0;
+  else if (oldval * 5 < newval * 4)
+    return 2;
+  else
+    return 1;
+}
+#endif  // (DECODE_HASH || ENABLE_REPEAT_COALESCING || ENABLE_CAPTURE_HASH ||
+        //  ENABLE_DECODE_CACHE)
+
 // Updated by David Conran (https://github.com/crankyoldgit) for receiving IR
 // code on ESP32
 // Updated by Sebastien Warin (http://sebastien.warin.fr) for receiving IR code
@@ -45,95 +134,525 @@ extern "C" {
 // sending IR code on ESP8266
 
 // Globals
+// Everything the interrupt handlers use is kept per receiver (IRrecv instance)
+// as the handlers can't be told which instance they are for. Receiver `n` uses
+// element `n` of each of these.
 #ifndef UNIT_TEST
 #if defined(ESP8266)
-static ETSTimer timer;
+static ETSTimer timer[kMaxReceivers];
 #endif  // ESP8266
+#if IRRECV_USE_TIMER1
+const uint32_t kTimer1TicksPerUsec = 5;  // Timer1 at 80MHz / 16. (TIM_DIV16)
+#endif  // IRRECV_USE_TIMER1
 #if defined(ESP32)
-static hw_timer_t * timer = NULL;
+static hw_timer_t * timer[kMaxReceivers] = {NULL};
 #endif  // ESP32
+#if IRRECV_TIMER_REGS
+// The address of the config register of each receiver's timer. Its other
+// registers are at the same offsets from it as those of timer 0 of group 0.
+static uint32_t timer_regs[kMaxReceivers] = {0};
+// When each receiver's timer was last restarted. (uSeconds, as per `micros()`)
+static uint32_t timer_epoch[kMaxReceivers] = {0};
+#endif  // IRRECV_TIMER_REGS
+#if IRRECV_USE_RMT
+// Where the RMT puts its captures.
+static RingbufHandle_t rmt_ringbuf[kMaxReceivers] = {NULL};
+// Nr. of RMT memory blocks each receiver's channel has claimed.
+static uint8_t rmt_blocks[kMaxReceivers] = {0};
+// Nr. of captures each receiver's RMT queue has room for. See
+// `IRrecv::enableCaptureRing()`. 0 for the default.
+static uint8_t rmt_slots[kMaxReceivers] = {0};
+#endif  // IRRECV_USE_RMT
 #endif  // UNIT_TEST
 
 #if defined(ESP32)
 portMUX_TYPE irremote_mux = portMUX_INITIALIZER_UNLOCKED;
 #endif  // ESP32
-volatile irparams_t irparams;
-irparams_t *irparams_save;  // A copy of the interrupt state while decoding.
+static volatile irparams_t irparams[kMaxReceivers];  // Capture states.
+static IRrecv *receivers[kMaxReceivers] = {NULL};  // The instance using each.
 
-#ifndef UNIT_TEST
-#if defined(ESP8266)
-/// Interrupt handler for when the timer runs out.
+#if ENABLE_HEADER_DISPATCH
+// The long (>= 2ms) header marks of IRrecvTimings.h, in ascending order. A
+// mark that could be one of these is a likely start of a message when smart
+// skipping.
+// Shorter ones are left out as they are too easily confused with noise.
+const uint16_t kDispatchLongHdrMarks[] = {
+    kDispatchZepealHdrMark, kDispatchSonyHdrMark, kDispatchRc6HdrMark,
+    kDispatchHaierAcHdr, kDispatchVestelAcHdrMark,
+    kDispatchMitsubishiHeavyHdrMark, kDispatchHitachiAcHdrMark,
+    kDispatchFujitsuAcHdrMark, kDispatchMitsubishi136HdrMark,
+    kDispatchHitachiAc1HdrMark, kDispatchHitachiAc3HdrMark,
+    kDispatchDoshishaHdrMark, kDispatchDaikin216HdrMark,
+    kDispatchPanasonicHdrMark, kDispatchCoronaAcHdrMark,
+    kDispatchSharpAcHdrMark, kDispatchNikaiHdrMark, kDispatchToshibaAcHdrMark,
+    kDispatchSamsungHdrMark, kDispatchMideaHdrMark, kDispatchSamsung36HdrMark,
+    kDispatchCoolixHdrMark, kDispatchDaikin160HdrMark,
+    kDispatchDaikin176HdrMark, kDispatchTranscoldHdrMark,
+    kDispatchTrotecHdrMark, kDispatchNeoclimaHdrMark, kDispatchArgoHdrMark,
+    kDispatchGoodweatherHdrMark, kDispatchAmcorHdrMark,
+    kDispatchMitsubishi2HdrMark, kDispatchCarrierAc40HdrMark,
+    kDispatchSanyoAcHdrMark, kDispatchPioneerHdrMark, kDispatchCarrierAcHdrMark,
+    kDispatchTechnibelAcHdrMark, kDispatchCarrierAc64HdrMark,
+    kDispatchWhirlpoolAcHdrMark, kDispatchNecHdrMark,
+    kDispatchDelonghiAcHdrMark, kDispatchGicableHdrMark, kDispatchGreeHdrMark,
+    kDispatchInaxHdrMark, kDispatchTecoHdrMark, kDispatchKelvinatorHdrMark,
+    kDispatchElectraAcHdrMark, kDispatchHitachiAc424LdrMark};
+#endif  // ENABLE_HEADER_DISPATCH
+
+// The shape of the NEC family of messages, as `decode()` sees them. i.e. The
+// nr. of data bits in each block, & the nr. of blocks each message has.
+const uint16_t kNecFamilyAiwaRcT501Bits = kAiwaRcT501Bits + 26 + 1;  // Pre/post
+const uint8_t kNecFamilyCarrierAcBlocks = 3;
+const uint8_t kNecFamilyPioneerBlocks = 2;
+const uint8_t kNecFamilyEpsonBlocks = 2;
+
+#if ENABLE_ADAPTIVE_TIMEOUT
+/// The start of a message that has long spaces (gaps) between its sections.
+typedef struct {
+  uint16_t mark;   // Header mark. (uSeconds)
+  uint16_t space;  // Header space. (uSeconds) 0 for a leader. i.e. The space
+                   // straight after the mark is the long one.
+  uint16_t gap;    // The longest space in the message. (uSeconds)
+} long_gap_header_t;
+
+// Headers of messages that need a longer timeout than a short gap to be
+// captured whole. See IRrecvTimings.h.
+// Note: Gree & Kelvinator share NEC's header, so NEC messages wait for them.
+static const long_gap_header_t kLongGapHeaders[] USE_DRAM_ATTR = {
+    {kLongGapDaikinBitMark, kLongGapDaikinZeroSpace, kLongGapDaikinGap},
+    {kLongGapMitsubishiAcHdrMark, kLongGapMitsubishiAcHdrSpace,
+     kLongGapMitsubishiAcRptSpace},
+    {kLongGapDaikin216HdrMark, kLongGapDaikin216HdrSpace, kLongGapDaikin216Gap},
+    {kLongGapPanasonicHdrMark, kLongGapPanasonicHdrSpace,
+     kLongGapPanasonicAcSectionGap},
+    {kLongGapCoronaAcHdrMark, kLongGapCoronaAcHdrSpace,
+     kLongGapCoronaAcSpaceGap},
+    {kLongGapDaikin160HdrMark, kLongGapDaikin160HdrSpace, kLongGapDaikin160Gap},
+    {kLongGapDaikin176HdrMark, kLongGapDaikin176HdrSpace, kLongGapDaikin176Gap},
+    {kLongGapMitsubishi2HdrMark, kLongGapMitsubishi2HdrSpace,
+     kLongGapMitsubishi2MinGap},
+    {kLongGapPioneerHdrMark, kLongGapPioneerHdrSpace, kLongGapPioneerMinGap},
+    {kLongGapCarrierAcHdrMark, kLongGapCarrierAcHdrSpace, kLongGapCarrierAcGap},
+    {kLongGapWhirlpoolAcHdrMark, kLongGapWhirlpoolAcHdrSpace,
+     kLongGapWhirlpoolAcGap},
+    {kLongGapGreeHdrMark, kLongGapGreeHdrSpace, kLongGapGreeMsgSpace},
+    {kLongGapKelvinatorHdrMark, kLongGapKelvinatorHdrSpace,
+     kLongGapKelvinatorGap},
+    {kLongGapDaikin128LeaderMark, kLongGapDaikin128LeaderSpace,
+     kLongGapDaikin128Gap},
+    {kLongGapDaikin2LeaderMark, 0, kLongGapDaikin2LeaderSpace},
+    {kLongGapHitachiAc424LdrMark, 0, kLongGapHitachiAc424LdrSpace}};
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+
+#if !IRRECV_USE_RMT || ENABLE_CUSTOM_BACKENDS
+/// Store an entry of a receiver's capture.
+/// @param[in,out] params The capture state of the receiver.
+/// @param[in] index Where in the capture it goes.
+/// @param[in] ticks The duration of the entry. (in kRawTick units)
+static inline void USE_IRAM_ATTR store_ticks(volatile irparams_t *params,
+                                             const uint16_t index,
+                                             const uint16_t ticks) {
+#if ENABLE_LARGE_CAPTURE
+  // A large capture buffer is filled from it. See `IRrecv::drainCapture()`.
+  if (params->staging != NULL) {
+    if (!index) params->drained = 0;  // A new capture.
+    params->staging[index % params->stagesize] = ticks;
+    return;
+  }
+#endif  // ENABLE_LARGE_CAPTURE
+  params->rawbuf[index] = ticks;
+}
+
+/// End a receiver's capture. i.e. The guts of the timeout interrupt handler.
 /// It signals to the library that capturing of IR data has stopped.
-/// @param[in] arg Unused. (ESP8266 Only)
-static void USE_IRAM_ATTR read_timeout(void *arg __attribute__((unused))) {
+/// @param[in] params The capture state of the receiver.
+/// @param[in] now When it ended. (uSeconds)
+static void USE_IRAM_ATTR capture_end(volatile irparams_t *params,
+                                      const uint32_t now) {
+#if IRRECV_DECODE_TASK
+  bool ended = false;  // Did a capture just finish?
+#endif  // IRRECV_DECODE_TASK
+#if defined(ESP8266)
   os_intr_lock();
 #endif  // ESP8266
-/// @cond IGNORE
 #if defined(ESP32)
-/// Interrupt handler for when the timer runs out.
-/// It signals to the library that capturing of IR data has stopped.
-/// @note ESP32 version
-static void USE_IRAM_ATTR read_timeout(void) {
-/// @endcond
   portENTER_CRITICAL(&irremote_mux);
 #endif  // ESP32
-  if (irparams.rawlen) irparams.rcvstate = kStopState;
+  if (params->rawlen) {
+    params->rcvstate = kStopState;
+    params->stopped = now;
+#if ENABLE_CAPTURE_RING
+    // Close the slot and start capturing into the next one straight away.
+    if (params->slots) IRrecv::_ringCommit(params);
+#endif  // ENABLE_CAPTURE_RING
+#if IRRECV_DECODE_TASK
+    ended = true;
+#endif  // IRRECV_DECODE_TASK
+  }
 #if defined(ESP8266)
   os_intr_unlock();
 #endif  // ESP8266
 #if defined(ESP32)
   portEXIT_CRITICAL(&irremote_mux);
 #endif  // ESP32
+#if IRRECV_DECODE_TASK
+  // Wake up the decode task, if there is one, so it can decode the capture.
+  if (ended && params->task != NULL) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(static_cast<TaskHandle_t>(params->task), &woken);
+    if (woken) portYIELD_FROM_ISR();
+  }
+#endif  // IRRECV_DECODE_TASK
 }
 
-/// Interrupt handler for changes on the GPIO pin handling incoming IR messages.
-static void USE_IRAM_ATTR gpio_intr() {
-  uint32_t now = micros();
-  static uint32_t start = 0;
-
-#if defined(ESP8266)
-  uint32_t gpio_status = GPIO_REG_READ(GPIO_STATUS_ADDRESS);
-  os_timer_disarm(&timer);
-  GPIO_REG_WRITE(GPIO_STATUS_W1TC_ADDRESS, gpio_status);
-#endif  // ESP8266
-
+/// Add an edge to a receiver's capture. i.e. The guts of the GPIO interrupt
+/// handler.
+/// @param[in] params The capture state of the receiver.
+/// @param[in] now When the edge happened. (uSeconds)
+/// @param[out] entry The index of the capture buffer entry it was added at.
+/// @return true, if the capture's timeout needs to be restarted. false if
+///   there is no capture in progress. e.g. It has already stopped.
+static inline bool USE_IRAM_ATTR capture_edge(volatile irparams_t *params,
+                                              uint32_t now, uint16_t *entry) {
   // Grab a local copy of rawlen to reduce instructions used in IRAM.
   // This is an ugly premature optimisation code-wise, but we do everything we
   // can to save IRAM.
   // It seems referencing the value via the structure uses more instructions.
   // Less instructions means faster and less IRAM used.
   // N.B. It saves about 13 bytes of IRAM.
-  uint16_t rawlen = irparams.rawlen;
+  uint16_t rawlen = params->rawlen;
 
-  if (rawlen >= irparams.bufsize) {
-    irparams.overflow = true;
-    irparams.rcvstate = kStopState;
+  if (rawlen >= params->bufsize
+#if ENABLE_COMPACT_CAPTURE
+      || params->packedlen + kPackedEscapeSize > params->bufsize
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+      // The staged entries haven't been drained fast enough.
+      || (params->staging != NULL && rawlen &&
+          (uint16_t)(rawlen - params->drained) >= params->stagesize)
+#endif  // ENABLE_LARGE_CAPTURE
+      ) {
+    params->overflow = true;
+    params->rcvstate = kStopState;
+    params->stopped = now;
+#if ENABLE_CAPTURE_RING
+    if (params->slots) {  // Close the full slot & carry on in the next one.
+      IRrecv::_ringCommit(params);
+      rawlen = 0;
+    }
+#endif  // ENABLE_CAPTURE_RING
   }
 
-  if (irparams.rcvstate == kStopState) return;
+  if (params->rcvstate == kStopState) return false;
 
-  if (irparams.rcvstate == kIdleState) {
-    irparams.rcvstate = kMarkState;
-    irparams.rawbuf[rawlen] = 1;
+  bool dropped = false;  // Is it not to be captured?
+#if ENABLE_ECHO_SUPPRESSION
+  const ir_echo_t *echo = params->echo;
+  if (echo != NULL && now - echo->from < echo->length) {  // Our own echo.
+    if (params->rcvstate == kIdleState) return false;  // Don't start one.
+    dropped = true;  // Nor add it to the one in progress.
+  }
+#endif  // ENABLE_ECHO_SUPPRESSION
+  uint16_t ticks = 1;  // The first entry is a dummy gap.
+  if (params->rcvstate == kIdleState) {
+#if ENABLE_LOW_POWER_RECV
+    now -= params->wake;  // The mark started before we were awake to see it.
+    params->wake = 0;
+#endif  // ENABLE_LOW_POWER_RECV
+    params->rcvstate = kMarkState;
+    params->started = now;
   } else {
-    if (now < start)
-      irparams.rawbuf[rawlen] = (UINT32_MAX - start + now) / kRawTick;
+    if (now < params->lastedge)
+      ticks = (UINT32_MAX - params->lastedge + now) / kRawTick;
     else
-      irparams.rawbuf[rawlen] = (now - start) / kRawTick;
+      ticks = (now - params->lastedge) / kRawTick;
   }
-  irparams.rawlen++;
+#if ENABLE_GLITCH_FILTER
+  if (!dropped && ticks < params->glitch) {  // Too short to be real?
+    dropped = IRrecv::_dropGlitch(params, rawlen, ticks, now);
+    // It was all noise.
+    if (dropped && params->rcvstate == kIdleState) return false;
+  }
+#endif  // ENABLE_GLITCH_FILTER
+  if (!dropped) {
+#if ENABLE_ADAPTIVE_TIMEOUT
+    IRrecv::_adaptTimeout(params, rawlen, ticks);
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if ENABLE_CAPTURE_HASH
+    IRrecv::_hashTicks(params, rawlen, ticks);
+#endif  // ENABLE_CAPTURE_HASH
+#if ENABLE_COMPACT_CAPTURE
+    if (params->packed != NULL) {
+      // The dummy isn't worth storing.
+      if (rawlen) IRrecv::_packTicks(params, ticks);
+    } else {
+      store_ticks(params, rawlen, ticks);
+    }
+#else  // ENABLE_COMPACT_CAPTURE
+    store_ticks(params, rawlen, ticks);
+#endif  // ENABLE_COMPACT_CAPTURE
+    params->rawlen++;
 
-  start = now;
+    params->lastedge = now;
+  }
+  *entry = rawlen;
+  return true;
+}
+#endif  // !IRRECV_USE_RMT || ENABLE_CUSTOM_BACKENDS
+
+#if !IRRECV_USE_RMT
+/// Interrupt handler for when the timer runs out.
+/// @param[in] params The capture state of the receiver the timer is for.
+static void USE_IRAM_ATTR read_timeout(volatile irparams_t *params) {
+#if ENABLE_IR_MIRROR
+  if (params->mirror != NULL && params->mirrored) {  // Never leave it lit.
+    params->mirrored = false;
+    params->mirror->mirrorMark(false);
+  }
+#endif  // ENABLE_IR_MIRROR
+  capture_end(params, now_usecs());
+}
 
+#if defined(ESP8266) && !defined(UNIT_TEST)
+/// (Re)start the timeout of a receiver's capture. See `read_timeout()`.
+/// @param[in] n Which receiver it is for.
+/// @param[in] ms Nr. of milli-Seconds until it runs out.
+static inline void USE_IRAM_ATTR arm_timeout(const uint8_t n,
+                                             const uint32_t ms) {
+#if IRRECV_USE_TIMER1
+  if (n == 0) {  // The first receiver has timer1. See `IRrecv::enableIRIn()`.
+    // What `timer1_write()` does, without the call. It restarts the count.
+    T1L = (MS_TO_USEC(ms) * kTimer1TicksPerUsec) & 0x7FFFFF;
+    TEIE |= TEIE1;
+    return;
+  }
+#endif  // IRRECV_USE_TIMER1
+  os_timer_arm(&timer[n], ms, ONCE);
+}
+#endif  // defined(ESP8266) && !defined(UNIT_TEST)
+
+#if IRRECV_TIMER_REGS
+/// Restart a receiver's timer from zero, & say how long it ran for.
+/// i.e. The time since the last edge. A few register accesses, rather than
+/// `micros()`.
+/// @param[in] n Which receiver it is for.
+/// @return Nr. of uSeconds since it was last restarted.
+static inline uint32_t USE_IRAM_ATTR timer_lap(const uint8_t n) {
+  const uint32_t regs = timer_regs[n];
+  REG_WRITE(regs + (TIMG_T0UPDATE_REG(0) - TIMG_T0CONFIG_REG(0)), 1);  // Latch.
+  const uint32_t usecs = REG_READ(regs +
+                                  (TIMG_T0LO_REG(0) - TIMG_T0CONFIG_REG(0)));
+  // What `timerWrite(timer[n], 0)` does. Its load value is always 0.
+  REG_WRITE(regs + (TIMG_T0LOAD_REG(0) - TIMG_T0CONFIG_REG(0)), 1);
+  return usecs;
+}
+#endif  // IRRECV_TIMER_REGS
+
+#if defined(ESP32) && !defined(UNIT_TEST)
+/// Restart the timeout of a receiver's capture. See `read_timeout()`.
+/// @param[in] n Which receiver it is for.
+static inline void USE_IRAM_ATTR restart_timeout(const uint8_t n) {
+#if IRRECV_TIMER_REGS
+  // The timer was restarted by `timer_lap()`. What `timerAlarmEnable()` does,
+  // without the call & lock.
+  REG_SET_BIT(timer_regs[n], TIMG_T0_ALARM_EN);
+#else  // IRRECV_TIMER_REGS
+  timerWrite(timer[n], 0);
+  timerAlarmEnable(timer[n]);
+#endif  // IRRECV_TIMER_REGS
+}
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
+/// Interrupt handler for changes on the GPIO pin handling incoming IR messages.
+/// @param[in] n Which receiver the change is for.
+static void USE_IRAM_ATTR gpio_intr(const uint8_t n) {
+  volatile irparams_t *params = &irparams[n];
+#if ENABLE_IR_MIRROR
+  if (params->mirror != NULL) {  // Repeat the edge before anything else.
+#ifndef UNIT_TEST
+    params->mirrored = (digitalRead(params->recvpin) == LOW);  // i.e. A mark.
+#else  // UNIT_TEST
+    params->mirrored = !params->mirrored;  // Simulated edges alternate.
+#endif  // UNIT_TEST
+    params->mirror->mirrorMark(params->mirrored);
+  }
+#endif  // ENABLE_IR_MIRROR
+#if IRRECV_TIMER_REGS
+  // The timer is restarted at each edge, so it tells the time from the last
+  // one. `micros()` is only needed for the first edge of a capture.
+  const uint32_t lap = timer_lap(n);
+  uint32_t now = (params->rcvstate == kIdleState) ? now_usecs()
+                                                  : timer_epoch[n] + lap;
+  timer_epoch[n] = now;
+#else  // IRRECV_TIMER_REGS
+  uint32_t now = now_usecs();
+#endif  // IRRECV_TIMER_REGS
+
+#if defined(ESP8266)
+  uint32_t gpio_status = GPIO_REG_READ(GPIO_STATUS_ADDRESS);
+  // Timer1 doesn't need stopping. Re-arming it below restarts it.
+  if (!IRRECV_USE_TIMER1 || n) os_timer_disarm(&timer[n]);
+  // Only clear our pin, so we don't lose changes for any other receivers.
+  GPIO_REG_WRITE(GPIO_STATUS_W1TC_ADDRESS,
+                 gpio_status & (1UL << params->recvpin));
+#endif  // ESP8266
+
+  uint16_t rawlen;  // Where the edge was added.
+  if (!capture_edge(params, now, &rawlen)) return;
+
+#if ENABLE_ADAPTIVE_TIMEOUT
 #if defined(ESP8266)
-  os_timer_arm(&timer, irparams.timeout, ONCE);
+  arm_timeout(n, params->wait);
 #endif  // ESP8266
 #if defined(ESP32)
-  timerWrite(timer, 0);  // Reset the timeout.
-  timerAlarmEnable(timer);
+  // It only changes in the first few entries of a capture.
+  if (rawlen <= 2) timerAlarmWrite(timer[n], MS_TO_USEC(params->wait), ONCE);
+  restart_timeout(n);
 #endif  // ESP32
+#else  // ENABLE_ADAPTIVE_TIMEOUT
+#if defined(ESP8266)
+  arm_timeout(n, params->timeout);
+#endif  // ESP8266
+#if defined(ESP32)
+  restart_timeout(n);
+#endif  // ESP32
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
 }
+
+#ifndef UNIT_TEST
+/// @cond IGNORE
+// Interrupt handlers can't be given an argument, so each receiver gets its own
+// small one to say which it is for.
+// Note: There must be one of each of these per kMaxReceivers.
+static void USE_IRAM_ATTR gpio_intr0(void) { gpio_intr(0); }
+static void USE_IRAM_ATTR gpio_intr1(void) { gpio_intr(1); }
+static void USE_IRAM_ATTR gpio_intr2(void) { gpio_intr(2); }
+static void USE_IRAM_ATTR gpio_intr3(void) { gpio_intr(3); }
+static void (* const gpio_intrs[kMaxReceivers])(void) = {
+    gpio_intr0, gpio_intr1, gpio_intr2, gpio_intr3};
+#if defined(ESP8266)
+// The ESP8266 timers can be given an argument. i.e. The capture state.
+static void USE_IRAM_ATTR read_timeout_arg(void *arg) {
+  read_timeout(static_cast<volatile irparams_t *>(arg));
+}
+#endif  // ESP8266
+#if IRRECV_USE_TIMER1
+static void USE_IRAM_ATTR read_timeout_timer1(void) {
+  read_timeout(&irparams[0]);
+}
+#endif  // IRRECV_USE_TIMER1
+#if defined(ESP32)
+static void USE_IRAM_ATTR read_timeout0(void) { read_timeout(&irparams[0]); }
+static void USE_IRAM_ATTR read_timeout1(void) { read_timeout(&irparams[1]); }
+static void USE_IRAM_ATTR read_timeout2(void) { read_timeout(&irparams[2]); }
+static void USE_IRAM_ATTR read_timeout3(void) { read_timeout(&irparams[3]); }
+static void (* const read_timeouts[kMaxReceivers])(void) = {
+    read_timeout0, read_timeout1, read_timeout2, read_timeout3};
+#endif  // ESP32
+/// @endcond
 #endif  // UNIT_TEST
+#endif  // !IRRECV_USE_RMT
+
+#if IRRECV_USE_RMT
+/// Move the next message captured by the RMT peripheral, if there is one, into
+/// the capture buffer in the same format the GPIO interrupt handler uses.
+/// i.e. Mark & space durations in kRawTick units, with a dummy first entry.
+/// @param[in] n Which receiver to collect the message for.
+/// @note ESP32 RMT version. Called by `decode()`, not from an interrupt.
+static void rmt_read(const uint8_t n) {
+  volatile irparams_t *params = &irparams[n];
+  if (params->rcvstate == kStopState || rmt_ringbuf[n] == NULL) return;
+  size_t size = 0;
+  rmt_item32_t *items = reinterpret_cast<rmt_item32_t *>(
+      xRingbufferReceive(rmt_ringbuf[n], &size, 0));
+  if (items == NULL) return;  // Nothing new has been captured.
+  uint16_t rawlen = 0;
+  uint32_t ticks = 0;  // How long the message was.
+#if ENABLE_GLITCH_FILTER
+  bool merge = false;  // Add the next entry to the previous one?
+  bool merged = false;  // Has any entry been merged?
+#endif  // ENABLE_GLITCH_FILTER
+#if ENABLE_CARRIER_FILTER
+  carrier_demod_t demod;
+  IRrecv::_demodReset(&demod);
+#endif  // ENABLE_CARRIER_FILTER
+#if ENABLE_CAPTURE_HASH
+  IRrecv::_hashTicks(params, rawlen, 1);
+#endif  // ENABLE_CAPTURE_HASH
+  params->rawbuf[rawlen++] = 1;  // Same as the first entry from gpio_intr().
+  params->overflow = false;
+  // Each item holds a mark & a space. A zero duration means the end.
+  for (size_t i = 0; i < size / sizeof(rmt_item32_t); i++) {
+    uint16_t duration[2] = {
+        static_cast<uint16_t>(items[i].duration0),
+        static_cast<uint16_t>(items[i].duration1)};
+#if ENABLE_CARRIER_FILTER
+    if (params->rawinput) {  // A carrier pulse, in uSeconds. Not a mark.
+      uint32_t usecs[2];
+      IRrecv::_demodulate(&demod, duration[0], duration[1], usecs);
+      for (uint8_t j = 0; j < 2; j++)  // Any mark & space it ended.
+        duration[j] = std::min((usecs[j] + kRawTick - 1) / kRawTick,
+                               (uint32_t)UINT16_MAX);
+    }
+#endif  // ENABLE_CARRIER_FILTER
+    for (uint8_t j = 0; j < 2 && duration[j]; j++) {
+      ticks += duration[j];
+#if ENABLE_GLITCH_FILTER
+      // Too short to be real, so it & the entry after it are added to the
+      // entry it interrupted. The same as the GPIO interrupt handler does.
+      if (merge || duration[j] < params->glitch) {
+        merge = !merge;
+        merged = true;
+        if (rawlen > 1)  // Nothing to add to if it is the first mark.
+          params->rawbuf[rawlen - 1] = std::min(
+              (uint32_t)params->rawbuf[rawlen - 1] + duration[j],
+              (uint32_t)UINT16_MAX);
+        continue;
+      }
+#endif  // ENABLE_GLITCH_FILTER
+      if (rawlen >= params->bufsize) {
+        params->overflow = true;
+      } else {
+#if ENABLE_CAPTURE_HASH
+        IRrecv::_hashTicks(params, rawlen, duration[j]);
+#endif  // ENABLE_CAPTURE_HASH
+        params->rawbuf[rawlen++] = duration[j];
+      }
+    }
+  }
+  vRingbufferReturnItem(rmt_ringbuf[n], reinterpret_cast<void *>(items));
+#if ENABLE_GLITCH_FILTER && ENABLE_CAPTURE_HASH
+  if (merged) params->hashed = false;  // It was built from the unmerged ones.
+#endif  // ENABLE_GLITCH_FILTER && ENABLE_CAPTURE_HASH
+  if (rawlen > 1) {
+    params->rawlen = rawlen;
+    params->rcvstate = kStopState;
+#if ENABLE_CARRIER_FILTER
+    params->carrier = IRrecv::_demodCarrier(&demod);
+#endif  // ENABLE_CARRIER_FILTER
+    // We only find out about it now, so work back from the message's length.
+    params->stopped = micros();
+    params->started = params->stopped - ticks * kRawTick;
+  }
+}
+
+/// The RMT channel a receiver uses.
+/// @param[in] n Which receiver.
+/// @return The RMT channel.
+static rmt_channel_t rmt_channel(const uint8_t n) {
+  return static_cast<rmt_channel_t>(std::min(
+      kDefaultESP32RmtChannel + n * kESP32RmtChannelsPerReceiver,
+      kESP32RmtChannels - 1));
+}
+
+/// The RMT receive filter setting that ignores the shortest glitches.
+/// @param[in] usecs Ignore pulses shorter than this. (uSeconds)
+/// @return The nr. of 80MHz (APB clock) ticks. It has to fit in a byte.
+static uint8_t rmt_filter(const uint16_t usecs) {
+  return std::max(std::min((uint32_t)usecs * 80, (uint32_t)UINT8_MAX),
+                  (uint32_t)100);  // Always ignore glitches under ~1.25us.
+}
+#endif  // IRRECV_USE_RMT
 
 // Start of IRrecv class -------------------
 
@@ -148,6 +667,11 @@ static void USE_IRAM_ATTR gpio_intr() {
 /// @param[in] save_buffer Use a second (save) buffer to decode from.
 ///   (Default: false)
 /// @param[in] timer_num Nr. of the ESP32 timer to use (0 to 3) (ESP32 Only)
+///   Unused when capturing via the RMT peripheral. See ENABLE_ESP32_RMT_RECV.
+///   Each receiver needs a different timer.
+/// @note Up to kMaxReceivers instances can capture at the same time, each on
+///   its own GPIO pin. Any more than that can't capture. Their `enableIRIn()`
+///   does nothing, & `decode()` always returns false.
 #if defined(ESP32)
 IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
                const uint8_t timeout, const bool save_buffer,
@@ -170,13 +694,262 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
                const uint8_t timeout, const bool save_buffer) {
 /// @endcond
 #endif  // ESP32
-  irparams.recvpin = recvpin;
-  irparams.bufsize = bufsize;
+#if ENABLE_STATIC_RECV_BUFFERS
+  _static = false;
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+  _claim();
+  _init(recvpin, bufsize, timeout, save_buffer);
+}
+
+#if ENABLE_STATIC_RECV_BUFFERS
+/// Class constructor for an IRrecvStatic. i.e. The caller supplies the
+/// buffers, rather than them being allocated from the heap.
+/// @param[in] recvpin See the class constructor.
+/// @param[in] rawbuf The capture buffer. `bufsize` entries.
+/// @param[in] bufsize See the class constructor.
+/// @param[in] timeout See the class constructor.
+/// @param[in] save The save buffer's state, or NULL for no save buffer.
+/// @param[in] save_rawbuf The save buffer. `bufsize` entries, if `save` isn't
+///   NULL.
+/// @param[in] timer_num See the class constructor. (ESP32 Only)
+/// @note The buffers must outlive the object. They are never freed by it.
+#if defined(ESP32)
+IRrecv::IRrecv(const uint16_t recvpin, uint16_t *rawbuf,
+               const uint16_t bufsize, const uint8_t timeout,
+               irparams_t *save, uint16_t *save_rawbuf,
+               const uint8_t timer_num) {
+  _timer_num = std::min(timer_num, (uint8_t)3);
+#else  // ESP32
+IRrecv::IRrecv(const uint16_t recvpin, uint16_t *rawbuf,
+               const uint16_t bufsize, const uint8_t timeout,
+               irparams_t *save, uint16_t *save_rawbuf) {
+#endif  // ESP32
+  _static = true;
+  _claim();
+  _params->rawbuf = rawbuf;
+  irparams_save = save;
+  if (save != NULL) save->rawbuf = save_rawbuf;
+  _init(recvpin, bufsize, timeout, save != NULL);
+}
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+
+/// Take one of the kMaxReceivers capture states for this instance.
+/// If they are all in use, it gets a capture state of its own, like a decoder.
+/// i.e. Nothing an existing receiver is using is touched, but it can't capture.
+void IRrecv::_claim(void) {
+  for (_id = 0; _id < kMaxReceivers; _id++)
+    if (receivers[_id] == NULL) {
+      receivers[_id] = this;
+      _params = &irparams[_id];
+      return;
+    }
+  DPRINTLN("Too many IRrecv instances. This one can't capture.");
+  _params = new irparams_t;  // N.B. `_id` is now kMaxReceivers.
+}
+
+/// Class constructor for an IRdecoder. i.e. No capture state is shared with
+/// the interrupt handlers or other instances.
+/// @param[in] timeout Nr. of milli-Seconds of no signal before a capture
+///   stops. Only used to cap the gaps decoders will wait for.
+IRrecv::IRrecv(const no_capture_t, const uint8_t timeout) {
+#if defined(ESP32)
+  _timer_num = 0;
+#endif  // ESP32
+  _id = kMaxReceivers;  // Not a receiver.
+#if ENABLE_STATIC_RECV_BUFFERS
+  _static = false;
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+  _params = new irparams_t;
+  _init(0, 1, timeout, false);
+}
+
+/// Set up the capture state & decoding settings. The guts of the constructors.
+/// @param[in] recvpin See the class constructor.
+/// @param[in] bufsize See the class constructor.
+/// @param[in] timeout See the class constructor.
+/// @param[in] save_buffer See the class constructor.
+void IRrecv::_init(const uint16_t recvpin, const uint16_t bufsize,
+                   const uint8_t timeout, const bool save_buffer) {
+  _params->rcvstate = kIdleState;  // Nothing left over from a previous owner.
+  _params->rawlen = 0;
+  _params->overflow = false;
+  _params->recvpin = recvpin;
+  _params->bufsize = bufsize;
   // Ensure we are going to be able to store all possible values in the
   // capture buffer.
-  irparams.timeout = std::min(timeout, (uint8_t)kMaxTimeoutMs);
-  irparams.rawbuf = new uint16_t[bufsize];
-  if (irparams.rawbuf == NULL) {
+  _params->timeout = std::min(timeout, (uint8_t)kMaxTimeoutMs);
+#if ENABLE_STATIC_RECV_BUFFERS
+  if (!_static)  // Otherwise the constructor has supplied them.
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+    _allocBuffers(bufsize, save_buffer);
+#if DECODE_HASH
+  _unknown_threshold = kUnknownThreshold;
+  _hash_only = false;
+#endif  // DECODE_HASH
+#if ENABLE_CAPTURE_HASH
+  _capture_hash = kFnvBasis32;
+  _capture_hashed = false;
+  _params->hashed = false;
+#endif  // ENABLE_CAPTURE_HASH
+#if ENABLE_CUSTOM_BACKENDS
+  _source = NULL;
+#endif  // ENABLE_CUSTOM_BACKENDS
+  _tolerance = kTolerance;
+#if ENABLE_HEADER_DISPATCH
+  _hdr_min = 0;
+  _hdr_max = UINT32_MAX;
+  _hdr_entry = 0;
+  _smart_skip = false;
+#endif  // ENABLE_HEADER_DISPATCH
+#if ENABLE_LENGTH_DISPATCH
+  _entries = UINT16_MAX;
+#endif  // ENABLE_LENGTH_DISPATCH
+  enableAllProtocols();
+  _learning = false;
+  _attempting = UNKNOWN;
+  _scoring = false;
+  _fit_used = 0;
+  _fit_error = 0;
+#if ENABLE_SIGNAL_QUALITY
+  _quality = false;
+  _fit_max = 0;
+  _fit_near = 0;
+#endif  // ENABLE_SIGNAL_QUALITY
+  _excess_adjust = 0;
+#if ENABLE_PROTOCOL_TOLERANCE
+  _protocol_tolerance_count = 0;
+  _protocol_tolerance = NULL;
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+  _calibrating = false;
+  _skew_sum = 0;
+  _skew_count = 0;
+  _calibration_sum = 0;
+  _calibration_count = 0;
+  _early_rawlen = 0;
+#if ENABLE_BUDGETED_DECODE
+  _budgeted = false;
+  _budget = 0;
+  _suspended = false;
+  _resuming = false;
+  _suspended_resumed = false;
+  _resume_offset = kStartOffset;
+  _resume_index = 0;
+#endif  // ENABLE_BUDGETED_DECODE
+#if ENABLE_GLITCH_FILTER
+  _params->glitch = 0;
+#endif  // ENABLE_GLITCH_FILTER
+#if ENABLE_ECHO_SUPPRESSION
+  _params->echo = NULL;
+#endif  // ENABLE_ECHO_SUPPRESSION
+#if ENABLE_IR_MIRROR
+  _params->mirror = NULL;
+  _params->mirrored = false;
+#endif  // ENABLE_IR_MIRROR
+#if ENABLE_LOW_POWER_RECV
+  _params->wake = 0;
+  _wake_latency = kWakeLatency;
+#endif  // ENABLE_LOW_POWER_RECV
+#if ENABLE_LARGE_CAPTURE
+  _params->staging = NULL;
+  _params->stagesize = 0;
+  _params->drained = 0;
+  _small_bufsize = 0;
+#if IRRECV_DRAIN_TASK
+  _drain_task = NULL;
+  _drain_stop = false;
+  _drain_running = false;
+#endif  // IRRECV_DRAIN_TASK
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_CARRIER_FILTER
+  _params->rawinput = false;
+  _params->carrier = 0;
+  _carrier = 0;
+  _carrier_tolerance = kCarrierTolerance;
+#endif  // ENABLE_CARRIER_FILTER
+#if ENABLE_ADAPTIVE_TIMEOUT
+  _params->gap = 0;
+  _params->wait = _params->timeout;
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if IRRECV_DECODE_TASK
+  _params->task = NULL;
+  _task_queue = NULL;
+  _task_callback = NULL;
+  _task_arg = NULL;
+  _task_stop = false;
+  _task_running = false;
+  _task_drops = 0;
+#endif  // IRRECV_DECODE_TASK
+#if ENABLE_REPEAT_COALESCING
+  _coalesced = NULL;
+  _coalesce_window = 0;
+  _coalesce_last = 0;
+  _coalesce_hash = 0;
+  _coalesce_rawlen = 0;
+  _coalesce_count = 0;
+#endif  // ENABLE_REPEAT_COALESCING
+#if ENABLE_GAMING_RECV
+  _gaming = NULL;
+  _gaming_window = 0;
+  _gaming_dupes = 0;
+#endif  // ENABLE_GAMING_RECV
+#if ENABLE_DECODE_CACHE
+  _dcache = NULL;
+  _dcache_size = 0;
+  _dcache_clock = 0;
+  _dcache_hits = 0;
+  _dcache_only = false;
+  _dcache_protocol = UNKNOWN;
+#endif  // ENABLE_DECODE_CACHE
+#if ENABLE_DECODE_TRACE
+  _trace = NULL;
+  _trace_size = 0;
+  _trace_next = 0;
+  _trace_full = false;
+  _trace_offset = 0;
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_COMPACT_CAPTURE
+  _params->packed = NULL;
+  _params->packedlen = 0;
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_DECODE_PROFILING
+  _profile = NULL;
+  _profile_current = NULL;
+#endif  // ENABLE_DECODE_PROFILING
+#if ENABLE_CAPTURE_RING
+  _params->ring = NULL;
+  _params->slots = 0;
+  _params->drops = 0;
+  _params->highwater = 0;
+  _ring_held = false;
+#if ENABLE_PARTIAL_DECODE
+  _params->continued = false;
+  _ring_skip = 0;
+#endif  // ENABLE_PARTIAL_DECODE
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_PARTIAL_DECODE
+  _partial = false;
+  _partial_ok = false;
+  _trunc_frame = NULL;
+  _trunc_nbytes = 0;
+  _trunc_pos = 0;
+  _trunc_section = 0;
+  _trunc_strict = true;
+  _trunc_tolerance = kUseDefTol;
+  _trunc_excess = kMarkExcess;
+#endif  // ENABLE_PARTIAL_DECODE
+#if ENABLE_FAMILY_MATCH_CACHE
+  _family_cache = false;
+  _kaseikyo_offset = 0;
+  _sharp_offset = 0;
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+}
+
+/// Allocate the capture buffer, & the save buffer if asked, from the heap.
+/// @param[in] bufsize See the class constructor.
+/// @param[in] save_buffer See the class constructor.
+void IRrecv::_allocBuffers(const uint16_t bufsize, const bool save_buffer) {
+  _params->rawbuf = new uint16_t[bufsize];
+  if (_params->rawbuf == NULL) {
     DPRINTLN(
         "Could not allocate memory for the primary IR buffer.\n"
         "Try a smaller size for CAPTURE_BUFFER_SIZE.\nRebooting!");
@@ -200,10 +973,6 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
   } else {
     irparams_save = NULL;
   }
-#if DECODE_HASH
-  _unknown_threshold = kUnknownThreshold;
-#endif  // DECODE_HASH
-  _tolerance = kTolerance;
 }
 
 /// Class destructor
@@ -211,11 +980,65 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
 /// e.g. Frees up all memory used by the various buffers, and disables any
 /// timers or interrupts used.
 IRrecv::~IRrecv(void) {
-  disableIRIn();
-#if defined(ESP32)
-  if (timer != NULL) timerEnd(timer);  // Cleanup the ESP32 timeout timer.
-#endif  // ESP32
-  delete[] irparams.rawbuf;
+  // Let go of the capture state, if it is one of the shared ones.
+  if (_id < kMaxReceivers && receivers[_id] == this) {
+#if IRRECV_DECODE_TASK
+    stopDecodeTask();  // It uses everything else, so it goes first.
+#endif  // IRRECV_DECODE_TASK
+    disableIRIn();
+#if defined(ESP32) && !defined(UNIT_TEST)
+    if (timer[_id] != NULL) {  // Cleanup the ESP32 timeout timer.
+      timerEnd(timer[_id]);
+      timer[_id] = NULL;
+    }
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+#if ENABLE_CAPTURE_RING
+    _ringFree();
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+    delete[] _params->packed;
+    _params->packed = NULL;
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+    _freeLargeCapture();  // Leaves `rawbuf` as NULL, if it was one.
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_STATIC_RECV_BUFFERS
+    if (!_static)
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+      delete[] _params->rawbuf;
+    _params->rawbuf = NULL;
+    receivers[_id] = NULL;
+  } else if (_id >= kMaxReceivers) {  // A decoder. The capture state is ours.
+#if ENABLE_CAPTURE_RING
+    _ringFree();
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+    delete[] _params->packed;
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_STATIC_RECV_BUFFERS
+    if (!_static)  // e.g. An IRrecvStatic there wasn't a receiver left for.
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+      delete[] _params->rawbuf;
+    delete const_cast<irparams_t *>(_params);
+  }
+#if ENABLE_DECODE_PROFILING
+  disableDecodeProfiling();
+#endif  // ENABLE_DECODE_PROFILING
+#if ENABLE_REPEAT_COALESCING
+  disableRepeatCoalescing();
+#endif  // ENABLE_REPEAT_COALESCING
+#if ENABLE_GAMING_RECV
+  delete[] _gaming;
+#endif  // ENABLE_GAMING_RECV
+#if ENABLE_DECODE_CACHE
+  disableDecodeCache();
+#endif  // ENABLE_DECODE_CACHE
+#if ENABLE_DECODE_TRACE
+  disableDecodeTrace();
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_STATIC_RECV_BUFFERS
+  if (_static) return;  // The save buffer isn't ours to free either.
+#endif  // ENABLE_STATIC_RECV_BUFFERS
   if (irparams_save != NULL) {
     delete[] irparams_save->rawbuf;
     delete irparams_save;
@@ -225,65 +1048,260 @@ IRrecv::~IRrecv(void) {
 /// Set up and (re)start the IR capture mechanism.
 /// @param[in] pullup A flag indicating should the GPIO use the internal pullup
 /// resistor. (Default: `false`. i.e. No.)
+/// @note ESP8266: With `ENABLE_ESP8266_TIMER_RECV`, the first receiver times
+///   its capture timeout with timer1, rather than an `os_timer`.
+/// @note ESP32: With `ENABLE_ESP32_TIMER_REGS`, the interrupt handler uses the
+///   registers of the receiver's timer directly.
+/// @note With a capture source, it is started instead. See
+///   `setCaptureSource()`.
 void IRrecv::enableIRIn(const bool pullup) {
+  if (_id >= kMaxReceivers) return;  // A decoder. There's nothing to capture.
+#if ENABLE_CUSTOM_BACKENDS
+  if (_source != NULL) {  // It captures, instead of the GPIO & timer.
+#if ENABLE_CAPTURE_RING
+    if (_params->slots) _ringReset();
+#endif  // ENABLE_CAPTURE_RING
+    resume();
+    _source->begin(this);
+    return;
+  }
+#endif  // ENABLE_CUSTOM_BACKENDS
   // ESP32's seem to require explicitly setting the GPIO to INPUT etc.
   // This wasn't required on the ESP8266s, but it shouldn't hurt to make sure.
   if (pullup) {
 #ifndef UNIT_TEST
-    pinMode(irparams.recvpin, INPUT_PULLUP);
+    pinMode(_params->recvpin, INPUT_PULLUP);
   } else {
-    pinMode(irparams.recvpin, INPUT);
+    pinMode(_params->recvpin, INPUT);
 #endif  // UNIT_TEST
   }
-#if defined(ESP32)
+#if IRRECV_USE_RMT
+  // Let the RMT peripheral time the edges & spot the end of the message.
+  rmt_config_t config = {};
+  config.rmt_mode = RMT_MODE_RX;
+  config.channel = rmt_channel(_id);
+  config.gpio_num = static_cast<gpio_num_t>(_params->recvpin);
+  config.clk_div = 80 * kRawTick;  // 80MHz / 160 = 1 RMT tick per kRawTick.
+  uint32_t tick = kRawTick;  // uSeconds per RMT tick.
+#if ENABLE_CARRIER_FILTER
+  // Carrier pulses are only a few uSeconds long, so they need a finer tick.
+  if (_params->rawinput) {
+    config.clk_div = 80;  // 80MHz / 80 = 1 RMT tick per uSecond.
+    tick = 1;
+  }
+#endif  // ENABLE_CARRIER_FILTER
+  // Each memory block holds 64 items. i.e. 128 capture buffer entries.
+  // A channel can use the blocks of the channels after it, so each receiver
+  // only gets the blocks up to where the next receiver's channel starts.
+  config.mem_block_num = std::min(
+      (uint16_t)(kESP32RmtChannels - config.channel),
+      (uint16_t)(_params->bufsize / 128 + 1));
+  config.mem_block_num = std::min(config.mem_block_num,
+                                  kESP32RmtChannelsPerReceiver);
+  // Only those no other channel uses. e.g. An `IRsend`'s, so it can send while
+  // this keeps receiving. See `IRsend::enableRmtSend()`.
+  irutils::releaseRmtBlocks(config.channel, rmt_blocks[_id]);  // Restarting.
+  rmt_blocks[_id] = 0;
+  while (config.mem_block_num &&
+         !irutils::claimRmtBlocks(config.channel, config.mem_block_num))
+    config.mem_block_num--;
+  if (!config.mem_block_num) {
+    DPRINTLN("The IR receiver's RMT channel is already in use.");
+    return;
+  }
+  rmt_blocks[_id] = config.mem_block_num;
+  config.rx_config.filter_en = true;
+#if ENABLE_GLITCH_FILTER
+  config.rx_config.filter_ticks_thresh = rmt_filter(getGlitchFilter());
+#else  // ENABLE_GLITCH_FILTER
+  config.rx_config.filter_ticks_thresh = rmt_filter(0);
+#endif  // ENABLE_GLITCH_FILTER
+#if ENABLE_CARRIER_FILTER
+  // The glitch filter is for marks & spaces, which would be longer than the
+  // carrier pulses. `rmt_read()` applies it once they are demodulated.
+  if (_params->rawinput) config.rx_config.filter_ticks_thresh = rmt_filter(0);
+#endif  // ENABLE_CARRIER_FILTER
+  // Item durations are 15 bits, which limits the longest timeout possible.
+  config.rx_config.idle_threshold = std::min(
+      (uint32_t)(MS_TO_USEC(_params->timeout) / tick), (uint32_t)0x7FFF);
+  rmt_config(&config);
+  // Room for a couple of full messages to queue up while we decode, or as
+  // many as `enableCaptureRing()` asked for. e.g. Whilst the CPU is busy
+  // sending a long message.
+  rmt_driver_install(config.channel,
+                     std::max(rmt_slots[_id], (uint8_t)2) *
+                         ((_params->bufsize + 1) / 2) * sizeof(rmt_item32_t),
+                     0);
+  rmt_get_ringbuf_handle(config.channel, &rmt_ringbuf[_id]);
+  rmt_rx_start(config.channel, true);
+#elif defined(ESP32)
   // Initialize the ESP32 timer.
-  timer = timerBegin(_timer_num, 80, true);  // 80MHz / 80 = 1 uSec granularity.
+  // 80MHz / 80 = 1 uSec granularity.
+  timer[_id] = timerBegin(_timer_num, 80, true);
   // Set the timer so it only fires once, and set it's trigger in uSeconds.
-  timerAlarmWrite(timer, MS_TO_USEC(irparams.timeout), ONCE);
+  timerAlarmWrite(timer[_id], MS_TO_USEC(_params->timeout), ONCE);
   // Note: Interrupt needs to be attached before it can be enabled or disabled.
-  timerAttachInterrupt(timer, &read_timeout, true);
-#endif  // ESP32
+  timerAttachInterrupt(timer[_id], read_timeouts[_id], true);
+#if IRRECV_TIMER_REGS
+  // Where the interrupt handler finds the timer's registers. Timers 0 & 1 are
+  // those of group 0, & 2 & 3 those of group 1. The same as the HAL numbers
+  // them.
+  timer_regs[_id] = TIMG_T0CONFIG_REG(_timer_num >> 1) +
+      (_timer_num & 1) * (TIMG_T1CONFIG_REG(0) - TIMG_T0CONFIG_REG(0));
+  timerWrite(timer[_id], 0);  // i.e. Its load value is 0 from now on.
+#endif  // IRRECV_TIMER_REGS
+#endif  // IRRECV_USE_RMT / ESP32
 
   // Initialize state machine variables
+#if ENABLE_CAPTURE_RING
+  if (_params->slots) _ringReset();
+#endif  // ENABLE_CAPTURE_RING
   resume();
 
-#ifndef UNIT_TEST
+#if !defined(UNIT_TEST) && !IRRECV_USE_RMT
 #if defined(ESP8266)
   // Initialize ESP8266 timer.
-  os_timer_disarm(&timer);
-  os_timer_setfn(&timer, reinterpret_cast<os_timer_func_t *>(read_timeout),
-                 NULL);
+  os_timer_disarm(&timer[_id]);
+  os_timer_setfn(&timer[_id], read_timeout_arg,
+                 const_cast<irparams_t *>(_params));
+#if IRRECV_USE_TIMER1
+  // The first receiver uses the hardware timer instead. It fires once, when
+  // it has counted down from the last edge. See `ENABLE_ESP8266_TIMER_RECV`.
+  if (_id == 0) {
+    timer1_attachInterrupt(read_timeout_timer1);
+    timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+  }
+#endif  // IRRECV_USE_TIMER1
 #endif  // ESP8266
   // Attach Interrupt
-  attachInterrupt(irparams.recvpin, gpio_intr, CHANGE);
-#endif  // UNIT_TEST
+  attachInterrupt(_params->recvpin, gpio_intrs[_id], CHANGE);
+#endif  // !defined(UNIT_TEST) && !IRRECV_USE_RMT
 }
 
 /// Stop collection of any received IR data.
 /// Disable any timers and interrupts.
 void IRrecv::disableIRIn(void) {
-#ifndef UNIT_TEST
+  if (_id >= kMaxReceivers) return;  // A decoder. There's nothing to capture.
+#if ENABLE_CUSTOM_BACKENDS
+  if (_source != NULL) {
+    _source->end(this);
+    return;
+  }
+#endif  // ENABLE_CUSTOM_BACKENDS
+#if IRRECV_USE_RMT
+  if (rmt_ringbuf[_id] != NULL) {
+    rmt_rx_stop(rmt_channel(_id));
+    rmt_driver_uninstall(rmt_channel(_id));
+    rmt_ringbuf[_id] = NULL;
+    irutils::releaseRmtBlocks(rmt_channel(_id), rmt_blocks[_id]);
+    rmt_blocks[_id] = 0;
+  }
+#elif !defined(UNIT_TEST)
 #if defined(ESP8266)
-  os_timer_disarm(&timer);
+  os_timer_disarm(&timer[_id]);
+#if IRRECV_USE_TIMER1
+  if (_id == 0) {
+    timer1_disable();
+    timer1_detachInterrupt();
+  }
+#endif  // IRRECV_USE_TIMER1
 #endif  // ESP8266
 #if defined(ESP32)
-  timerAlarmDisable(timer);
+  if (timer[_id] != NULL) timerAlarmDisable(timer[_id]);
 #endif  // ESP32
-  detachInterrupt(irparams.recvpin);
-#endif  // UNIT_TEST
+  detachInterrupt(_params->recvpin);
+#endif  // IRRECV_USE_RMT / UNIT_TEST
 }
 
+#if ENABLE_CUSTOM_BACKENDS
+/// Capture via a backend of your own, rather than the GPIO & a timer. e.g. An
+/// I2S/DMA driver, another chip's peripheral, or a simulator. It reports the
+/// edges it sees via `captureEdge()` & `captureEnd()`, & the decoding is done
+/// exactly as usual. See `IRcaptureSource` in IRhal.h.
+/// @param[in] source What to capture with. NULL for the GPIO & timer again.
+/// @note Call it before `enableIRIn()`, or while capturing is disabled. It
+///   isn't owned, so it must outlive the `IRrecv`, which stops it when it is
+///   destroyed.
+void IRrecv::setCaptureSource(IRcaptureSource *source) { _source = source; }
+
+/// What is being captured with, if not the GPIO. See `setCaptureSource()`.
+/// @return A ptr to the source, or NULL if there isn't one.
+IRcaptureSource *IRrecv::getCaptureSource(void) const { return _source; }
+
+/// Add an edge of the signal to the capture. i.e. What the GPIO interrupt
+/// handler does, for a capture source. See `setCaptureSource()`.
+/// @param[in] usecs When the edge happened. (uSeconds, in the source's
+///   timebase)
+/// @return Nr. of milli-Seconds of quiet after which the capture is to be
+///   ended with `captureEnd()`. 0 if no capture is in progress. i.e. The
+///   edge was ignored, as the last capture hasn't been decoded yet.
+/// @note Call it from an interrupt handler, or with them disabled.
+uint8_t USE_IRAM_ATTR IRrecv::captureEdge(const uint32_t usecs) {
+  uint16_t entry;
+  if (_id >= kMaxReceivers || !capture_edge(_params, usecs, &entry)) return 0;
+#if ENABLE_ADAPTIVE_TIMEOUT
+  return _params->wait;
+#else  // ENABLE_ADAPTIVE_TIMEOUT
+  return _params->timeout;
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+}
+
+/// End the capture in progress, if there is one. i.e. What the timeout
+/// interrupt handler does, for a capture source. See `captureEdge()`.
+/// @param[in] usecs When it ended. (uSeconds, in the source's timebase)
+/// @note Call it from an interrupt handler, or with them disabled.
+void USE_IRAM_ATTR IRrecv::captureEnd(const uint32_t usecs) {
+  if (_id < kMaxReceivers) capture_end(_params, usecs);
+}
+#endif  // ENABLE_CUSTOM_BACKENDS
+
+#ifdef UNIT_TEST
+/// Run the GPIO interrupt handler, as if the receiver's pin just changed.
+/// i.e. At the simulated time. (Unit tests only)
+void IRrecv::_simulateEdge(void) {
+  if (_id < kMaxReceivers) gpio_intr(_id);
+}
+
+/// Run the timeout interrupt handler, as if its timer just ran out.
+/// i.e. At the simulated time. (Unit tests only)
+void IRrecv::_simulateTimeout(void) {
+  if (_id < kMaxReceivers) read_timeout(_params);
+}
+#endif  // UNIT_TEST
+
 /// Resume collection of received IR data.
 /// @note This is required if `decode()` is successful and `save_buffer` was
 ///   not set when the class was instanciated.
+/// @note When the capture ring is in use, capturing never stops, so this just
+///   hands the slot `decode()` last used back to the interrupt handler.
 /// @see IRrecv class constructor
 void IRrecv::resume(void) {
-  irparams.rcvstate = kIdleState;
-  irparams.rawlen = 0;
-  irparams.overflow = false;
-#if defined(ESP32)
-  timerAlarmDisable(timer);
-#endif  // ESP32
+  _early_rawlen = 0;
+#if ENABLE_BUDGETED_DECODE
+  _suspended = false;  // Any capture part way through decoding is abandoned.
+#endif  // ENABLE_BUDGETED_DECODE
+#if ENABLE_CAPTURE_RING
+  if (_params->slots) {
+    _ringRelease();
+    return;
+  }
+#endif  // ENABLE_CAPTURE_RING
+  _params->rcvstate = kIdleState;
+  _params->rawlen = 0;
+  _params->overflow = false;
+#if ENABLE_COMPACT_CAPTURE
+  _params->packedlen = 0;
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+  _params->drained = 0;
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_CAPTURE_HASH
+  _params->hashed = false;
+#endif  // ENABLE_CAPTURE_HASH
+#if defined(ESP32) && !IRRECV_USE_RMT
+  if (_id < kMaxReceivers && timer[_id] != NULL)
+    timerAlarmDisable(timer[_id]);
+#endif  // defined(ESP32) && !IRRECV_USE_RMT
 }
 
 /// Make a copy of the interrupt state & buffer data.
@@ -313,10 +1331,1159 @@ void IRrecv::copyIrParams(volatile irparams_t *src, irparams_t *dst) {
   for (uint16_t i = 0; i < dst->bufsize; i++) dst->rawbuf[i] = src->rawbuf[i];
 }
 
+/// Move the interrupt state & buffer data to another irparams_t structure,
+/// by swapping the capture buffers rather than copying their contents.
+/// i.e. `dst` takes the filled buffer & `src` gets `dst`'s old buffer to
+/// capture into.
+/// Only call this when you know the interrupt handlers won't modify anything.
+/// i.e. In kStopState.
+/// @param[in,out] src Pointer to an irparams_t structure to move from.
+/// @param[out] dst Pointer to an irparams_t structure to move to.
+/// @note Both buffers MUST be `src->bufsize` entries in size.
+void IRrecv::swapIrParams(volatile irparams_t *src, irparams_t *dst) {
+  // Typecast src and dst addresses to (char *)
+  char *csrc = (char *)src;  // NOLINT(readability/casting)
+  char *cdst = (char *)dst;  // NOLINT(readability/casting)
+
+  // dst's buffer becomes the new capture buffer.
+  uint16_t *dst_rawbuf_ptr;
+  dst_rawbuf_ptr = dst->rawbuf;
+
+  // Copy contents of src[] to dst[]. dst->rawbuf now points to the capture.
+  for (uint16_t i = 0; i < sizeof(irparams_t); i++) cdst[i] = csrc[i];
+
+  src->rawbuf = dst_rawbuf_ptr;
+}
+
 /// Obtain the maximum number of entries possible in the capture buffer.
 /// i.e. It's size.
 /// @return The size of the buffer that is in use by the object.
-uint16_t IRrecv::getBufSize(void) { return irparams.bufsize; }
+uint16_t IRrecv::getBufSize(void) { return _params->bufsize; }
+
+#if ENABLE_CAPTURE_RING
+/// Capture IR messages into a ring of several buffers (slots).
+/// When a message finishes, the interrupt handler closes its slot and moves
+/// straight on to the next free one, rather than stopping until `decode()` is
+/// done with it. `decode()` then works through the completed slots in order.
+/// If no slot is free, the newly completed capture is dropped & counted.
+/// @param[in] slots Nr. of capture buffers to use. Up to `slots - 1` completed
+///   messages can be waiting to be decoded at once. A value less than 2 stops
+///   using the ring and returns to the normal single buffer behaviour.
+/// @return true, if the ring is now in use. Otherwise false.
+/// @note Call this when capturing is disabled. i.e. Before `enableIRIn()` or
+///   after `disableIRIn()`. Each slot uses `getBufSize()` entries of memory.
+/// @note Each slot `decode()` uses is kept until the next call to `decode()`
+///   or `resume()`.
+/// @note With `ENABLE_ESP32_RMT_RECV`, the RMT peripheral queues its own
+///   captures, without the CPU. So no ring is used. Its queue has room for
+///   `slots` captures instead. e.g. Those that arrive while `IRsend` sends.
+///   Captures that don't fit are dropped by it, uncounted.
+bool IRrecv::enableCaptureRing(const uint8_t slots) {
+  _ringFree();
+#if IRRECV_USE_RMT
+  if (_id >= kMaxReceivers) return false;
+  rmt_slots[_id] = (slots < 2) ? 0 : slots;
+  return slots >= 2;
+#endif  // IRRECV_USE_RMT
+  if (slots < 2) return false;
+#if ENABLE_COMPACT_CAPTURE
+  if (_params->packed != NULL) return false;  // Not with a compact capture.
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+  if (_small_bufsize) return false;  // Nor a large one.
+#endif  // ENABLE_LARGE_CAPTURE
+  _params->ring = new ircapture_t[slots];
+  if (_params->ring == NULL) return false;
+  // The existing capture buffer is used as the first slot.
+  _params->ring[0].rawbuf = _params->rawbuf;
+  for (uint8_t i = 1; i < slots; i++) {
+    _params->ring[i].rawbuf = new uint16_t[_params->bufsize];
+    if (_params->ring[i].rawbuf == NULL) {
+      DPRINTLN("Could not allocate memory for the IR capture ring.");
+      _params->slots = i;  // Only free what we have allocated.
+      _ringFree();
+      return false;
+    }
+  }
+  _params->slots = slots;
+  _params->drops = 0;
+  _params->highwater = 0;
+  _ringReset();
+  return true;
+}
+
+/// Obtain the nr. of slots in use by the capture ring.
+/// @return The nr. of slots. 0 if the capture ring is not in use.
+uint8_t IRrecv::getCaptureSlots(void) {
+#if IRRECV_USE_RMT
+  if (_id < kMaxReceivers) return rmt_slots[_id];  // Its queue's.
+#endif  // IRRECV_USE_RMT
+  return _params->slots;
+}
+
+/// Obtain the nr. of completed captures dropped because the ring was full.
+/// @return The nr. of dropped captures since `enableCaptureRing()`.
+uint16_t IRrecv::getCaptureDrops(void) { return _params->drops; }
+
+/// Obtain the most completed captures that were waiting to be decoded at once.
+/// @return The high-water mark of the capture ring since `enableCaptureRing()`.
+uint8_t IRrecv::getCaptureHighWater(void) { return _params->highwater; }
+
+/// Close the slot being captured into & move on to the next free slot.
+/// If there is no free slot, the capture is discarded and counted as a drop.
+/// @param[in,out] params The capture state of the receiver.
+/// @note Called from the interrupt handlers. It is the only code that changes
+///   `head`. i.e. The producer side of the capture ring.
+void USE_IRAM_ATTR IRrecv::_ringCommit(volatile irparams_t *params) {
+  const uint8_t head = params->head;
+  const uint8_t tail = params->tail;
+  const uint8_t next = (head + 1 < params->slots) ? head + 1 : 0;
+  if (next == tail) {  // Nowhere to put it.
+    if (params->drops < UINT16_MAX) params->drops++;
+  } else {
+    params->ring[head].rawlen = params->rawlen;
+    params->ring[head].overflow = params->overflow;
+    params->ring[head].started = params->started;
+    params->ring[head].stopped = params->stopped;
+#if ENABLE_PARTIAL_DECODE
+    params->ring[head].continued = params->continued;
+#endif  // ENABLE_PARTIAL_DECODE
+#if ENABLE_CAPTURE_HASH
+    params->ring[head].hash = params->hash;
+    params->ring[head].hashed = params->hashed;
+#endif  // ENABLE_CAPTURE_HASH
+    params->head = next;
+    params->rawbuf = params->ring[next].rawbuf;
+    const uint8_t waiting = (next >= tail) ? next - tail
+                                           : next + params->slots - tail;
+    if (waiting > params->highwater) params->highwater = waiting;
+  }
+#if ENABLE_PARTIAL_DECODE
+  // An overflowed capture carries straight on in the next slot, if it has one.
+  params->continued = params->overflow && next != tail;
+#endif  // ENABLE_PARTIAL_DECODE
+  params->rawlen = 0;
+  params->overflow = false;
+#if ENABLE_CAPTURE_HASH
+  params->hashed = false;
+#endif  // ENABLE_CAPTURE_HASH
+  params->rcvstate = kIdleState;
+}
+
+/// Empty the capture ring and start capturing into its first slot.
+void IRrecv::_ringReset(void) {
+  _params->head = 0;
+  _params->tail = 0;
+  _params->rawbuf = _params->ring[0].rawbuf;
+  _params->rawlen = 0;
+  _params->overflow = false;
+  _params->rcvstate = kIdleState;
+  _ring_held = false;
+#if ENABLE_PARTIAL_DECODE
+  _params->continued = false;
+  _ring_skip = 0;
+#endif  // ENABLE_PARTIAL_DECODE
+}
+
+/// Hand the slot `decode()` last used back to the interrupt handler.
+/// @note It is the only code that changes `_params->tail`. i.e. The consumer
+///   side of the capture ring.
+void IRrecv::_ringRelease(void) {
+  if (!_ring_held) return;
+  _ring_held = false;
+  uint8_t used = 1;
+#if ENABLE_PARTIAL_DECODE
+  used += _ring_skip;  // The slots `_ringStitch()` finished the message with.
+  _ring_skip = 0;
+#endif  // ENABLE_PARTIAL_DECODE
+  _params->tail = (_params->tail + used) % _params->slots;
+}
+
+/// Point the results at the oldest completed capture in the ring, if any.
+/// @param[out] results A PTR to where the decoded IR message will be stored.
+/// @param[out] save A PTR to an irparams_t instance to copy the capture to.
+///   NULL means decode it in place. i.e. Keep the slot until we are done.
+/// @return true, if there was a completed capture. Otherwise false.
+bool IRrecv::_ringFetch(decode_results *results, irparams_t *save) {
+  _ringRelease();  // We are finished with the previously decoded capture.
+  if (_params->tail == _params->head) return false;  // Nothing has completed.
+  _ring_held = true;
+  ircapture_t *slot = &_params->ring[_params->tail];
+  // Clear the entry after the end of the capture. See `decode()` for why.
+  if (slot->rawlen < _params->bufsize) slot->rawbuf[slot->rawlen] = 0;
+  results->started = slot->started;
+  results->stopped = slot->stopped;
+#if ENABLE_CAPTURE_HASH
+  _capture_hash = slot->hash;
+  _capture_hashed = slot->hashed;
+#endif  // ENABLE_CAPTURE_HASH
+  if (save == NULL) {
+    results->rawbuf = slot->rawbuf;
+    results->rawlen = slot->rawlen;
+    results->overflow = slot->overflow;
+  } else {
+    save->bufsize = _params->bufsize;
+    save->rawlen = slot->rawlen;
+    save->overflow = slot->overflow;
+    save->started = slot->started;
+    save->stopped = slot->stopped;
+    for (uint16_t i = 0; i < _params->bufsize; i++)
+      save->rawbuf[i] = slot->rawbuf[i];
+    _ringRelease();  // It's safe to reuse the slot. We have a copy.
+    results->rawbuf = save->rawbuf;
+    results->rawlen = save->rawlen;
+    results->overflow = save->overflow;
+  }
+  return true;
+}
+
+#if ENABLE_PARTIAL_DECODE
+/// Finish off a truncated multi-section message with the capture(s) that
+/// carried straight on from its overflowed one, if they are next in the ring.
+/// Any captures used are taken out of the ring along with it.
+/// @param[in,out] results The truncated message to add the rest of it to.
+/// @note The entry at each join is lost, as it is the dummy first entry of the
+///   next capture, so it only works if that was the gap between two sections.
+///   e.g. When the capture buffer holds the first section(s) of the message, up
+///   to & including its last footer mark, exactly.
+void IRrecv::_ringStitch(decode_results *results) {
+  while (_trunc_pos) {
+    const uint8_t index = (_params->tail + _ring_held + _ring_skip) %
+        _params->slots;
+    if (index == _params->head) break;  // It hasn't been completed. (Yet?)
+    const ircapture_t *slot = &_params->ring[index];
+    if (!slot->continued || slot->rawlen <= kStartOffset) break;
+    const uint16_t pos = _trunc_pos;
+    _trunc_pos = 0;
+    _partial_ok = _partial && slot->overflow;  // It may need the next one too.
+    if (!_matchSectionsFrom(slot->rawbuf + kStartOffset, results->state,
+                            slot->rawlen - kStartOffset, _trunc_nbytes,
+                            _trunc_frame, _trunc_section, pos, _trunc_strict,
+                            _trunc_tolerance, _trunc_excess)) {
+      memset(results->state + pos, 0, _trunc_nbytes - pos);
+      _trunc_pos = pos;  // That's as far as it goes.
+      break;
+    }
+    _ring_skip++;
+  }
+  if (!_ring_held) {  // We've already let go of its slot, so skip them now.
+    _params->tail = (_params->tail + _ring_skip) % _params->slots;
+    _ring_skip = 0;
+  }
+}
+#endif  // ENABLE_PARTIAL_DECODE
+
+/// Stop using the capture ring and free the memory it used.
+void IRrecv::_ringFree(void) {
+  if (_params->ring != NULL) {
+    // The first slot is the original capture buffer. Keep it.
+    _params->rawbuf = _params->ring[0].rawbuf;
+    for (uint8_t i = 1; i < _params->slots; i++)
+      delete[] _params->ring[i].rawbuf;
+    delete[] _params->ring;
+    _params->ring = NULL;
+  }
+  _params->slots = 0;
+  _ring_held = false;
+#if ENABLE_PARTIAL_DECODE
+  _params->continued = false;
+  _ring_skip = 0;
+#endif  // ENABLE_PARTIAL_DECODE
+}
+#endif  // ENABLE_CAPTURE_RING
+
+#if ENABLE_COMPACT_CAPTURE
+/// Capture into a compact (8-bit) buffer rather than one `uint16_t` per entry.
+/// Most mark & space durations fit in a single byte at a coarser resolution
+/// (kPackedTickRatio * kRawTick uSeconds), with a three byte escape sequence
+/// for longer durations. i.e. It needs about half the memory for a capture.
+/// The compact capture is expanded into the save buffer by `decode()`, so the
+/// decoders & `decode_results` are unchanged.
+/// @param[in] enable Use a compact capture buffer, or go back to a normal one.
+/// @return true, if the compact capture buffer is now in use, false if not.
+/// @note Requires the `save_buffer` option of the IRrecv constructor.
+///   It can't be used with `enableCaptureRing()`, the ESP32 RMT backend, or
+///   an `IRrecvStatic`.
+///   Call it before `enableIRIn()` or after `disableIRIn()`.
+///   The `bufsize` entries of the save buffer and bytes of the compact buffer
+///   are both limits. Long durations use up the compact one faster.
+/// @note e.g. With `save_buffer` & a `bufsize` of 1024, the capture memory
+///   drops from 4096 to 3072 bytes.
+bool IRrecv::enableCompactCapture(const bool enable) {
+  if (enable == (_params->packed != NULL)) return enable;  // No change.
+  if (enable) {
+    if (irparams_save == NULL || IRRECV_USE_RMT) return false;
+#if ENABLE_STATIC_RECV_BUFFERS
+    if (_static) return false;  // The capture buffer isn't ours to free.
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+#if ENABLE_CAPTURE_RING
+    if (_params->slots) return false;
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_LARGE_CAPTURE
+    if (_small_bufsize) return false;
+#endif  // ENABLE_LARGE_CAPTURE
+    _params->packed = new uint8_t[_params->bufsize];
+    if (_params->packed == NULL) return false;
+    delete[] _params->rawbuf;
+    _params->rawbuf = NULL;
+  } else {
+    _params->rawbuf = new uint16_t[_params->bufsize];
+    if (_params->rawbuf == NULL) return true;  // Stay as we are.
+    delete[] _params->packed;
+    _params->packed = NULL;
+  }
+  _params->packedlen = 0;
+  _params->rawlen = 0;
+  _params->rcvstate = kIdleState;
+  return enable;
+}
+
+/// Add an entry to the end of the compact capture buffer.
+/// @param[in,out] params The capture state of the receiver.
+/// @param[in] ticks The duration of the entry. (in kRawTick units)
+/// @note Called from the interrupt handler. Room for it has been checked.
+void USE_IRAM_ATTR IRrecv::_packTicks(volatile irparams_t *params,
+                                      const uint16_t ticks) {
+  uint16_t len = params->packedlen;
+  const uint16_t units = (ticks + kPackedTickRatio / 2) / kPackedTickRatio;
+  if (units < kPackedEscape) {
+    params->packed[len++] = units;
+  } else {  // Too long for a single byte. Store all of it.
+    params->packed[len++] = kPackedEscape;
+    params->packed[len++] = ticks >> 8;
+    params->packed[len++] = ticks;
+  }
+  params->packedlen = len;
+}
+
+/// Expand the start of the compact capture buffer into a normal one.
+/// @param[out] dst Where to expand it to. It must be at least `bufsize` long.
+/// @param[in] entries The nr. of entries to expand, including the dummy first.
+/// @note The interrupt handler only ever adds to the end of the compact
+///   capture, so this is safe to call while it is still capturing.
+void IRrecv::_unpackCapture(irparams_t *dst, const uint16_t entries) {
+  uint16_t pos = 0;
+  dst->rawbuf[0] = 1;  // Same as the first entry from gpio_intr().
+  for (uint16_t i = 1; i < entries; i++) {
+    const uint8_t code = _params->packed[pos++];
+    if (code == kPackedEscape) {
+      dst->rawbuf[i] = (_params->packed[pos] << 8) | _params->packed[pos + 1];
+      pos += 2;
+    } else {
+      dst->rawbuf[i] = code * kPackedTickRatio;
+    }
+  }
+  if (entries < _params->bufsize) dst->rawbuf[entries] = 0;  // End marker.
+  dst->bufsize = _params->bufsize;
+  dst->rawlen = entries;
+  dst->overflow = _params->overflow;
+  dst->started = _params->started;
+  dst->stopped = _params->stopped;
+}
+#endif  // ENABLE_COMPACT_CAPTURE
+
+#if ENABLE_LARGE_CAPTURE
+/// Capture into a large buffer, allocated from PSRAM where there is some,
+/// rather than the `bufsize` entries of internal RAM the receiver was made
+/// with. e.g. To learn the 2000-4000 entry messages of some A/C units, which
+/// won't fit in internal RAM next to WiFi.
+/// On the ESP32, the GPIO interrupt handler can't safely write to PSRAM. e.g.
+/// While the flash is being written. So it captures into a small ring of
+/// internal RAM (`staging`), & a task moves the entries into the large buffer
+/// as they arrive. `decode()` reads the large buffer, so the decoders &
+/// `decode_results` are unchanged.
+/// @param[in] size Nr. of entries the large buffer is to have.
+/// @param[in] staging Nr. of entries the interrupt handler can capture ahead
+///   of the task. i.e. Enough for what may arrive while it can't run. A
+///   capture that gets further ahead than that overflows. 0 means none. i.e.
+///   Only if you know the large buffer will be in internal RAM.
+/// @return true, if the large buffer is now in use. false if not.
+/// @note The capture is decoded in place, as a `save_buffer` would be too
+///   small to copy it to. So it can't be used with that option of the IRrecv
+///   constructor, & `decode()` ignores its `save` argument. Call `resume()`
+///   once it has been decoded.
+///   It can't be used with `enableCaptureRing()`, `enableCompactCapture()`,
+///   or an `IRrecvStatic`.
+///   Call it before `enableIRIn()` or after `disableIRIn()`.
+///   On other platforms, or with the ESP32 RMT receiver
+///   (`ENABLE_ESP32_RMT_RECV`), no interrupt handler writes the capture, so
+///   `staging` is ignored. It is just a larger `bufsize`.
+bool IRrecv::enableLargeCapture(const uint16_t size, const uint16_t staging) {
+  disableLargeCapture();
+  if (!size || _small_bufsize || _id >= kMaxReceivers ||
+      irparams_save != NULL) return false;
+#if ENABLE_STATIC_RECV_BUFFERS
+  if (_static) return false;  // The capture buffer isn't ours to free.
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+#if ENABLE_CAPTURE_RING
+  if (_params->slots) return false;
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+  if (_params->packed != NULL) return false;
+#endif  // ENABLE_COMPACT_CAPTURE
+  const size_t bytes = size * sizeof(uint16_t);
+  uint16_t *large = NULL;
+#if defined(ESP32) && !defined(UNIT_TEST)
+  large = static_cast<uint16_t *>(heap_caps_malloc(
+      bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+  // No (free) PSRAM, so it will have to be internal RAM.
+  if (large == NULL) large = static_cast<uint16_t *>(malloc(bytes));
+  if (large == NULL) return false;
+  const uint16_t stagesize = IRRECV_STAGE_CAPTURE ? staging : 0;
+  uint16_t *stage = NULL;
+  if (stagesize) {
+    stage = new uint16_t[stagesize];
+    if (stage == NULL) {
+      free(large);
+      return false;
+    }
+  }
+  delete[] _params->rawbuf;
+  _small_bufsize = _params->bufsize;
+  _params->rawbuf = large;
+  _params->bufsize = size;
+  _params->staging = stage;
+  _params->stagesize = stagesize;
+  _params->drained = 0;
+  _params->rawlen = 0;
+  _params->rcvstate = kIdleState;
+#if IRRECV_DRAIN_TASK
+  if (stagesize) {
+    _drain_stop = false;
+    _drain_running = true;
+    TaskHandle_t task = NULL;
+    if (xTaskCreate(_drainTask, "IRdrain", kDrainTaskStackSize, this,
+                    kDrainTaskPriority, &task) != pdPASS) {
+      _drain_running = false;
+      disableLargeCapture();
+      return false;
+    }
+    _drain_task = task;
+  }
+#endif  // IRRECV_DRAIN_TASK
+  return true;
+}
+
+/// Go back to the receiver's usual (`bufsize`) capture buffer.
+/// @note Call it before `enableIRIn()` or after `disableIRIn()`.
+void IRrecv::disableLargeCapture(void) {
+  if (!_small_bufsize) return;
+  uint16_t *small = new uint16_t[_small_bufsize];
+  if (small == NULL) return;  // Stay as we are.
+  _freeLargeCapture();
+  _params->rawbuf = small;
+  _params->bufsize = _small_bufsize;
+  _params->rawlen = 0;
+  _params->rcvstate = kIdleState;
+  _small_bufsize = 0;
+}
+
+/// Move the entries the interrupt handler has captured so far into the large
+/// capture buffer. See `enableLargeCapture()`.
+/// `decode()` & (on the ESP32) the drain task call it, so there is usually no
+/// need to. e.g. Only from `loop()` on a platform without the task, if it can
+/// be late to `decode()` a message longer than the `staging` entries.
+/// @return The nr. of entries moved.
+uint16_t IRrecv::drainCapture(void) {
+  volatile irparams_t *params = _params;
+  if (params->staging == NULL) return 0;
+  // Not while the interrupt handler (on either core) or `resume()` changes it.
+#if defined(ESP32) && !defined(UNIT_TEST)
+  portENTER_CRITICAL(&irremote_mux);
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+  const uint16_t end = params->rawlen;
+  const uint16_t start = std::min((uint16_t)params->drained, end);
+  for (uint16_t i = start; i < end; i++)
+    params->rawbuf[i] = params->staging[i % params->stagesize];
+  params->drained = end;
+#if defined(ESP32) && !defined(UNIT_TEST)
+  portEXIT_CRITICAL(&irremote_mux);
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+  return end - start;
+}
+
+/// Free the large capture buffer, its staging, & stop the drain task.
+/// `rawbuf` is left as NULL.
+void IRrecv::_freeLargeCapture(void) {
+  if (!_small_bufsize) return;
+#if IRRECV_DRAIN_TASK
+  if (_drain_task != NULL) {
+    _drain_stop = true;
+    while (_drain_running) vTaskDelay(1);  // It deletes itself.
+    _drain_task = NULL;
+  }
+#endif  // IRRECV_DRAIN_TASK
+  delete[] _params->staging;
+  _params->staging = NULL;
+  _params->stagesize = 0;
+  _params->drained = 0;
+  free(_params->rawbuf);
+  _params->rawbuf = NULL;
+}
+
+#if IRRECV_DRAIN_TASK
+/// The body of the drain task. It keeps the large capture buffer up to date.
+/// @param[in] arg The IRrecv instance it is draining for.
+void IRrecv::_drainTask(void *arg) {
+  IRrecv *irrecv = static_cast<IRrecv *>(arg);
+  while (!irrecv->_drain_stop) {
+    irrecv->drainCapture();
+    vTaskDelay(1);  // The staging holds far more than a tick's worth.
+  }
+  irrecv->_drain_running = false;
+  vTaskDelete(NULL);
+}
+#endif  // IRRECV_DRAIN_TASK
+#endif  // ENABLE_LARGE_CAPTURE
+
+#if ENABLE_GLITCH_FILTER
+/// Drop an entry of a capture that is too short to be real. (See
+/// `setGlitchFilter()`) The entry before it is taken back, so it carries on
+/// from where it started. i.e. The next entry stored is the sum of all three.
+/// @param[in,out] params The capture state of the receiver.
+/// @param[in] index Where the entry would go in the capture.
+/// @param[in] ticks The duration of the entry. (in kRawTick units)
+/// @param[in] now The time of the edge that ended it. (uSeconds)
+/// @return true, if it was dropped. false, if it has to be stored.
+/// @note Called from the interrupt handler.
+bool USE_IRAM_ATTR IRrecv::_dropGlitch(volatile irparams_t *params,
+                                       const uint16_t index,
+                                       const uint16_t ticks,
+                                       const uint32_t now) {
+  if (index == 0) return false;  // The dummy first entry.
+#if ENABLE_COMPACT_CAPTURE
+  if (params->packed != NULL) return false;  // Too late to take any back.
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+  if (params->staging != NULL) return false;  // It may already be drained.
+#endif  // ENABLE_LARGE_CAPTURE
+  if (index == 1) {  // A blip on an idle line. Wait for a real message.
+    params->rawlen = 0;
+    params->rcvstate = kIdleState;
+    return true;
+  }
+  params->rawlen = index - 1;
+  params->lastedge = now - (uint32_t)(params->rawbuf[index - 1] + ticks) *
+      kRawTick;
+#if ENABLE_CAPTURE_HASH
+  params->hashed = false;  // The entry taken back is already in the hash.
+#endif  // ENABLE_CAPTURE_HASH
+  return true;
+}
+#endif  // ENABLE_GLITCH_FILTER
+
+#if ENABLE_CAPTURE_HASH
+/// Add an entry of a capture to its decodeHash() hash.
+/// i.e. Build the hash a step at a time, as each mark/space arrives.
+/// @param[in,out] params The capture state of the receiver.
+/// @param[in] index Where the entry goes in the capture. 0 is the dummy first.
+/// @param[in] ticks The duration of the entry. (in kRawTick units)
+/// @note Called from the interrupt handler.
+void USE_IRAM_ATTR IRrecv::_hashTicks(volatile irparams_t *params,
+                                      const uint16_t index,
+                                      const uint16_t ticks) {
+  if (index == 0) {  // A new capture.
+    params->hash = kFnvBasis32;
+    params->hashed = true;
+  } else if (index >= 3) {  // The same as one step of `_hashCapture()`.
+    params->hash = (params->hash * kFnvPrime32) ^
+        compare_ticks(params->hashticks[index & 1], ticks);
+  }
+  params->hashticks[index & 1] = ticks;  // Compared to two entries later.
+}
+#endif  // ENABLE_CAPTURE_HASH
+
+#if ENABLE_ADAPTIVE_TIMEOUT
+/// End captures after a short gap, rather than the full timeout, unless the
+/// message's header is that of a protocol known to have longer gaps (spaces)
+/// between its sections. e.g. Many A/C protocols.
+/// i.e. The (long) timeout given to the constructor is only waited for when
+///   it is needed, so short messages are ready to decode much sooner.
+/// @param[in] gap_ms Nr. of milliSeconds of quiet that end a capture.
+///   It is capped at the timeout.
+/// @note The capture of a message with a header that is a close match to one
+///   with long gaps waits for the longest of those gaps (plus a margin), or the
+///   timeout, whichever is shorter.
+/// @note Messages with unlisted long gaps (e.g. A protocol with a message
+///   that repeats, but the decoder wants to see them all) may now be split
+///   into several captures. Use `disableAdaptiveTimeout()` for those.
+/// @note Not supported by the ESP32 RMT receiver. It always uses the timeout.
+void IRrecv::enableAdaptiveTimeout(const uint8_t gap_ms) {
+  _params->gap = std::max(std::min(gap_ms, (uint8_t)_params->timeout),
+                           (uint8_t)1);
+}
+
+/// Always wait for the full timeout before ending a capture. (The default)
+void IRrecv::disableAdaptiveTimeout(void) { _params->gap = 0; }
+
+/// Pick how long the interrupt handler waits for the next edge of a capture.
+/// It is decided by the header, i.e. The first couple of entries.
+/// @param[in,out] params The capture state of the receiver.
+/// @param[in] index Where the entry goes in the capture. 0 is the dummy first.
+/// @param[in] ticks The duration of the entry. (in kRawTick units)
+/// @note Called from the interrupt handler.
+void USE_IRAM_ATTR IRrecv::_adaptTimeout(volatile irparams_t *params,
+                                         const uint16_t index,
+                                         const uint16_t ticks) {
+  if (index == 0) {  // A new capture.
+    params->wait = params->gap ? params->gap : params->timeout;
+    return;
+  }
+  if (!params->gap || index > 2) return;  // Nothing (more) to decide.
+  if (index == 1) params->hdrmark = ticks;
+  const uint32_t mark = (uint32_t)params->hdrmark * kRawTick;
+  const uint32_t space = (uint32_t)ticks * kRawTick;
+  uint32_t longest = 0;
+  for (uint8_t i = 0; i < sizeof(kLongGapHeaders) / sizeof(kLongGapHeaders[0]);
+       i++) {
+    const long_gap_header_t *header = &kLongGapHeaders[i];
+    // Within 25% of the nominal values.
+    if (mark * 4 < header->mark * 3UL || mark * 4 > header->mark * 5UL)
+      continue;
+    if (index == 1) {  // Only a leader's space can be long.
+      if (header->space) continue;
+    } else if (!header->space || space * 4 < header->space * 3UL ||
+               space * 4 > header->space * 5UL) {
+      continue;
+    }
+    longest = std::max(longest, (uint32_t)header->gap);
+  }
+  // Allow the gap to be 25% longer than nominal, rounded up to whole mSecs.
+  const uint32_t wait = (longest * 5 / 4 + 999) / 1000;
+  params->wait = std::min(std::max(wait, (uint32_t)params->gap),
+                          (uint32_t)params->timeout);
+}
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+
+#if ENABLE_REPEAT_COALESCING
+/// Coalesce the repeats of a held button into a single report.
+/// Once a message has been decoded, any identical messages (or NEC style
+/// repeat codes) that follow it within `window_ms` of each other are counted
+/// rather than decoded. They are recognised cheaply from the capture's timings
+/// alone. After the repeats stop for `window_ms`, `decode()` reports the
+/// message one more time with `repeat` set & `repeats` holding the count.
+/// i.e. Holding a button gives two reports, rather than one per repeat.
+/// @param[in] window_ms Max. nr. of milliSeconds between repeats.
+/// @return true, if it is in use. false, if there wasn't enough memory.
+/// @note Uses `sizeof(decode_results)` bytes of memory to hold the message.
+/// @note The final report has no capture. i.e. Its `rawlen` is 0.
+///   It is not made if a different message arrives before `window_ms` has
+///   passed. Only the new message is reported then.
+/// @note RC-5/RC-6 repeats are also spotted by their decoded value, as their
+///   toggle bit tells a held button from a new press of the same one.
+bool IRrecv::enableRepeatCoalescing(const uint16_t window_ms) {
+  if (_coalesced == NULL) _coalesced = new decode_results;
+  if (_coalesced == NULL) return false;
+  _coalesce_window = MS_TO_USEC(window_ms);
+  _coalesce_rawlen = 0;
+  _coalesce_count = 0;
+  return true;
+}
+
+/// Stop coalescing repeats, and free the memory it used.
+/// Any repeats not yet reported are discarded.
+void IRrecv::disableRepeatCoalescing(void) {
+  delete _coalesced;
+  _coalesced = NULL;
+  _coalesce_rawlen = 0;
+  _coalesce_count = 0;
+}
+
+/// Check if a captured message is a repeat of the last decoded one, & count it
+/// if it is.
+/// @param[in] results A PTR to the captured message.
+/// @return true, if it was a repeat. i.e. It doesn't need decoding.
+bool IRrecv::_coalesceRepeat(const decode_results *results) {
+  if (_coalesced == NULL || !_coalesce_rawlen) return false;
+  const uint32_t now = now_usecs();
+  if (now - _coalesce_last > _coalesce_window) return false;  // Too late.
+  const bool nec_repeat = results->rawlen == kCoalesceNecRptLength &&
+      matchMark(results->rawbuf[1], kCoalesceNecHdrMark) &&
+      matchSpace(results->rawbuf[2], kCoalesceNecRptSpace) &&
+      matchMark(results->rawbuf[3], kCoalesceNecBitMark);
+#if ENABLE_CAPTURE_HASH
+  const uint32_t hash = _capture_hashed ? _capture_hash
+                                        : _hashCapture(results);
+#else  // ENABLE_CAPTURE_HASH
+  const uint32_t hash = _hashCapture(results);
+#endif  // ENABLE_CAPTURE_HASH
+  if (!nec_repeat && (results->rawlen != _coalesce_rawlen ||
+                      hash != _coalesce_hash))
+    return false;
+  _coalesce_last = now;
+  if (_coalesce_count < UINT16_MAX) _coalesce_count++;
+  return true;
+}
+
+/// Check if a decoded message is a held button of a protocol with a toggle bit,
+/// & count it if it is.
+/// A new press flips the toggle bit (e.g. `IRsend::toggleRC5()`), so the same
+/// value again within the window can only be a repeat, even if its capture
+/// is too jittery for `_coalesceRepeat()` to have spotted it.
+/// @param[in] results A PTR to the decoded message.
+/// @return true, if it was a repeat. i.e. It doesn't need reporting.
+bool IRrecv::_coalesceToggled(const decode_results *results) {
+  if (_coalesced == NULL || !_coalesce_rawlen) return false;
+  switch (results->decode_type) {
+    case RC5:
+    case RC5X:
+    case RC6:
+      break;
+    default:
+      return false;  // No toggle bit, so it could be a new press.
+  }
+  const uint32_t now = now_usecs();
+  if (now - _coalesce_last > _coalesce_window) return false;  // Too late.
+  if (results->decode_type != _coalesced->decode_type ||
+      results->bits != _coalesced->bits ||
+      results->value != _coalesced->value) return false;
+  // Remember this capture too, so an exact copy of it needn't be decoded.
+  _coalesce_hash = _hashCapture(results);
+  _coalesce_rawlen = results->rawlen;
+  _coalesce_last = now;
+  if (_coalesce_count < UINT16_MAX) _coalesce_count++;
+  return true;
+}
+
+/// Remember a newly decoded message, so we can spot any repeats of it.
+/// @param[in] results A PTR to the decoded message.
+void IRrecv::_coalesceStore(const decode_results *results) {
+  if (_coalesced == NULL) return;
+  *_coalesced = *results;
+  _coalesce_hash = _hashCapture(results);
+  _coalesce_rawlen = results->rawlen;
+  _coalesce_last = now_usecs();
+  _coalesce_count = 0;  // Any uncounted repeats of the previous one are lost.
+}
+
+/// Report the repeats of a message once they have stopped arriving.
+/// @param[out] results A PTR to where to store the report.
+/// @return true, if there was a report. Otherwise false.
+bool IRrecv::_coalesceFlush(decode_results *results) {
+  if (_coalesced == NULL || !_coalesce_count) return false;
+  const uint32_t now = now_usecs();
+  if (now - _coalesce_last <= _coalesce_window) return false;  // Still held.
+  *results = *_coalesced;
+  results->rawlen = 0;  // The capture buffer has been reused since.
+  results->repeat = true;
+  results->repeats = _coalesce_count;
+  results->decoded = now;
+  _coalesce_rawlen = 0;  // It was released. The next press is a new message.
+  _coalesce_count = 0;
+  return true;
+}
+#endif  // ENABLE_REPEAT_COALESCING
+
+#if ENABLE_GAMING_RECV
+/// Switch to a receive profile for laser tag & similar gaming protocols.
+/// i.e. Lots of short messages, in rapid bursts, from many wands or players.
+/// It:
+///  - Only attempts the MagiQuest & Lasertag (& optionally Multibrackets)
+///    decoders. See `enableProtocol()`.
+///  - Ends captures after a `kGamingGapMs` gap, rather than the full timeout.
+///    See `enableAdaptiveTimeout()`.
+///  - Captures into the capture ring, so messages that arrive while another
+///    is being decoded aren't lost. See `enableCaptureRing()`.
+///  - Drops an identical copy of a recent message of the same player. i.e.
+///    A wand or gun sending its message several times per shot. Unlike
+///    `enableRepeatCoalescing()` (which it turns off), it remembers the last
+///    message of up to `kGamingPlayers` players, so interleaved messages from
+///    different players don't hide each other's duplicates.
+/// @param[in] dedup_ms Nr. of milliSeconds after a player's message that an
+///   identical one is a duplicate. 0 means don't drop duplicates.
+/// @param[in] multibrackets Also decode Multibrackets messages? Its 5ms bits
+///   & 30ms footer don't fit in the short gap, so it keeps the full timeout.
+/// @param[in] slots Nr. of capture ring slots to use, if the ring isn't
+///   already in use.
+/// @return true, if it is in use. false, if there wasn't enough memory.
+/// @note Call it before `enableIRIn()`. Captures are then at most the
+///   constructor's `timeout` long, so a short one suits this profile best.
+bool IRrecv::enableGamingMode(const uint16_t dedup_ms, const bool multibrackets,
+                              const uint8_t slots) {
+  if (_gaming == NULL) _gaming = new gaming_player_t[kGamingPlayers];
+  if (_gaming == NULL) return false;
+  for (uint8_t i = 0; i < kGamingPlayers; i++) _gaming[i].type = UNKNOWN;
+  _gaming_window = MS_TO_USEC(dedup_ms);
+  _gaming_dupes = 0;
+  disableAllProtocols();
+  enableProtocol(decode_type_t::MAGIQUEST);
+  enableProtocol(decode_type_t::LASERTAG);
+  if (multibrackets) enableProtocol(decode_type_t::MULTIBRACKETS);
+#if ENABLE_ADAPTIVE_TIMEOUT
+  if (multibrackets)
+    disableAdaptiveTimeout();
+  else
+    enableAdaptiveTimeout(kGamingGapMs);
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if ENABLE_REPEAT_COALESCING
+  disableRepeatCoalescing();
+#endif  // ENABLE_REPEAT_COALESCING
+#if ENABLE_CAPTURE_RING
+  if (!getCaptureSlots() && !enableCaptureRing(slots)) return false;
+#else  // ENABLE_CAPTURE_RING
+  (void)slots;  // Not used.
+#endif  // ENABLE_CAPTURE_RING
+  return true;
+}
+
+/// Go back to the default receive profile, from `enableGamingMode()`.
+/// i.e. Attempt every protocol, & wait for the full timeout. The capture ring
+/// is left as it is.
+void IRrecv::disableGamingMode(void) {
+  delete[] _gaming;
+  _gaming = NULL;
+  enableAllProtocols();
+#if ENABLE_ADAPTIVE_TIMEOUT
+  disableAdaptiveTimeout();
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+}
+
+/// Nr. of duplicate messages the gaming receive profile has dropped.
+/// @return The nr. since `enableGamingMode()`.
+uint32_t IRrecv::getGamingDuplicates(void) { return _gaming_dupes; }
+
+/// Check if a decoded message is a copy of its player's last message.
+/// @param[in] results A PTR to the decoded message.
+/// @return true, if it was a duplicate. i.e. It doesn't need reporting.
+bool IRrecv::_gamingDuplicate(const decode_results *results) {
+  if (_gaming == NULL || !_gaming_window) return false;
+  const uint32_t now = now_usecs();
+  uint8_t oldest = 0;
+  for (uint8_t i = 0; i < kGamingPlayers; i++) {
+    gaming_player_t *player = &_gaming[i];
+    if (player->type == results->decode_type &&
+        player->value == results->value &&
+        now - player->seen <= _gaming_window) {
+      player->seen = now;  // A burst of copies is one message.
+      _gaming_dupes++;
+      return true;
+    }
+    // Prefer an unused entry, then the one heard from the longest ago.
+    if (_gaming[oldest].type != UNKNOWN &&
+        (player->type == UNKNOWN || player->seen < _gaming[oldest].seen))
+      oldest = i;
+  }
+  _gaming[oldest].type = results->decode_type;
+  _gaming[oldest].value = results->value;
+  _gaming[oldest].seen = now;
+  return false;
+}
+#endif  // ENABLE_GAMING_RECV
+
+#if ENABLE_DECODE_CACHE
+/// Remember which protocol decoded each of the last few distinct messages.
+/// Most of the time, it is the same handful of buttons that are pressed. So
+/// when a capture has the same `decodeHash()` hash (i.e. The same pattern of
+/// longer/shorter marks & spaces, within tolerance) & length as a message that
+/// was decoded before, only the protocol that decoded it then is attempted,
+/// rather than working through every enabled protocol to get to it.
+/// If that protocol fails to decode it this time, every protocol is attempted
+/// as usual.
+/// @param[in] size The nr. of messages to remember. The least recently used
+///   one is forgotten to make room for a new one.
+/// @return true, if it is in use. false, if there wasn't enough memory.
+/// @note Uses `size * sizeof(decode_cache_entry_t)` bytes of memory.
+/// @note Messages only the `decodeHash()` (UNKNOWN) decoder matched aren't
+///   remembered, as every protocol has to be attempted to know that.
+bool IRrecv::enableDecodeCache(const uint8_t size) {
+  disableDecodeCache();
+  if (!size) return false;
+  _dcache = new decode_cache_entry_t[size];
+  if (_dcache == NULL) return false;
+  for (uint8_t i = 0; i < size; i++) {
+    _dcache[i].rawlen = 0;
+    _dcache[i].used = 0;  // i.e. Older than any that will be used.
+  }
+  _dcache_size = size;
+  _dcache_clock = 0;
+  _dcache_hits = 0;
+  return true;
+}
+
+/// Stop remembering which protocol decoded each message, & free the memory.
+void IRrecv::disableDecodeCache(void) {
+  delete[] _dcache;
+  _dcache = NULL;
+  _dcache_size = 0;
+}
+
+/// Nr. of messages decoded by only attempting the protocol the decode cache
+/// remembered for them. See `enableDecodeCache()`.
+/// @return The nr. since `enableDecodeCache()`.
+uint32_t IRrecv::getDecodeCacheHits(void) { return _dcache_hits; }
+#endif  // ENABLE_DECODE_CACHE
+
+#if ENABLE_DECODE_TRACE
+/// A timestamp for the decode trace. CPU cycles where we can, else uSeconds.
+/// @return The nr. of ticks.
+static inline uint32_t trace_ticks(void) {
+#if (defined(ESP8266) || defined(ESP32)) && !defined(UNIT_TEST)
+  return ESP.getCycleCount();
+#else  // (defined(ESP8266) || defined(ESP32)) && !defined(UNIT_TEST)
+  return now_usecs();
+#endif  // (defined(ESP8266) || defined(ESP32)) && !defined(UNIT_TEST)
+}
+
+/// Record what `decode()` does into a ring buffer of compact binary events.
+/// i.e. Each protocol it attempts (& where in the capture), each one it skips
+/// due to the header mark, each mark & space that fails to match, & what it
+/// decoded, each with a timestamp. It costs a few stores per event, rather
+/// than the serial output of a DEBUG build, so it barely changes the timing of
+/// what it is tracing. Use `decodeTraceToString()` to dump it, &
+/// `tools/decode_trace.py` to pretty-print the dump.
+/// @param[in] size The nr. of events to keep. The oldest are overwritten.
+/// @return true, if it is in use. false, if there wasn't enough memory.
+/// @note Uses `size * sizeof(decode_trace_t)` bytes of memory.
+bool IRrecv::enableDecodeTrace(const uint16_t size) {
+  disableDecodeTrace();
+  if (!size) return false;
+  _trace = new decode_trace_t[size];
+  if (_trace == NULL) return false;
+  _trace_size = size;
+  return true;
+}
+
+/// Stop recording the decode trace, and free the memory it used.
+void IRrecv::disableDecodeTrace(void) {
+  delete[] _trace;
+  _trace = NULL;
+  _trace_size = 0;
+  clearDecodeTrace();
+}
+
+/// Forget the events recorded in the decode trace so far.
+void IRrecv::clearDecodeTrace(void) {
+  _trace_next = 0;
+  _trace_full = false;
+}
+
+/// Nr. of events in the decode trace. See `enableDecodeTrace()`.
+/// @return The nr. of events.
+uint16_t IRrecv::getDecodeTraceLength(void) {
+  return _trace_full ? _trace_size : _trace_next;
+}
+
+/// Obtain an event from the decode trace.
+/// @param[in] index Which event. 0 is the oldest one.
+/// @return A ptr to the event, or NULL if there is no such event.
+const decode_trace_t *IRrecv::getDecodeTraceEntry(const uint16_t index) {
+  if (index >= getDecodeTraceLength()) return NULL;
+  const uint16_t oldest = _trace_full ? _trace_next : 0;
+  return &_trace[(oldest + index) % _trace_size];
+}
+
+/// Nr. of `decode_trace_t.ticks` per uSecond. i.e. The CPU clock in MHz on the
+/// ESP8266 & ESP32, as they are its cycle count.
+/// @return The nr. of ticks.
+uint16_t IRrecv::getDecodeTraceRate(void) {
+#if (defined(ESP8266) || defined(ESP32)) && !defined(UNIT_TEST)
+  return ESP.getCpuFreqMHz();
+#else  // (defined(ESP8266) || defined(ESP32)) && !defined(UNIT_TEST)
+  return 1;
+#endif  // (defined(ESP8266) || defined(ESP32)) && !defined(UNIT_TEST)
+}
+
+/// Add an event to the decode trace, if it is in use.
+/// @param[in] event What happened. A `decode_trace_event_t`.
+/// @param[in] protocol The protocol it is about. UNKNOWN if none.
+/// @param[in] value The event's detail. Capped at 65535.
+void IRrecv::_traceEvent(const uint8_t event, const decode_type_t protocol,
+                         const uint32_t value) {
+  if (_trace == NULL) return;
+  decode_trace_t *entry = &_trace[_trace_next];
+  entry->ticks = trace_ticks();
+  entry->protocol = protocol;
+  entry->offset = _trace_offset;
+  entry->value = std::min(value, (uint32_t)UINT16_MAX);
+  entry->event = event;
+  if (++_trace_next >= _trace_size) {
+    _trace_next = 0;
+    _trace_full = true;
+  }
+}
+#endif  // ENABLE_DECODE_TRACE
+
+#if IRRECV_DECODE_TASK
+/// Decode in the background, in a FreeRTOS task of our own.
+/// The interrupt handlers capture into the capture ring, & wake the task as
+/// each message completes. The task then calls `decode()`, & gives each
+/// decoded message to `callback` (from the task) and/or adds it to a queue
+/// for `readDecoded()`. i.e. Decoding can be done on the other core while
+/// `loop()` gets on with serving the network etc.
+/// @param[in] callback A function to call with each decoded message. Called
+///   from the decode task, so it should be quick & thread safe. NULL for none.
+/// @param[in] arg Passed as is to `callback`.
+/// @param[in] slots Nr. of capture ring slots to use, if the ring isn't
+///   already in use. See `enableCaptureRing()`.
+/// @param[in] queue_length Nr. of decoded messages that can wait to be read by
+///   `readDecoded()`. 0 means don't queue them. i.e. Only use the callback.
+/// @param[in] core Which core to run the task on.
+/// @return true, if the task was started. Otherwise false.
+/// @note ESP32 only. Call this before `enableIRIn()`, and don't call
+///   `decode()` yourself while the task is running.
+/// @note The `rawbuf` of each message is only valid during the callback.
+///   The capture ring slot it points to is reused afterwards.
+/// @note With `ENABLE_ESP32_RMT_RECV`, the RMT peripheral queues the captures
+///   instead of the capture ring, and the task checks it each `timeout`.
+///   `slots` is how many the queue has room for.
+bool IRrecv::startDecodeTask(const decode_callback_t callback, void *arg,
+                             const uint8_t slots, const uint8_t queue_length,
+                             const uint8_t core) {
+  if (_params->task != NULL) return false;  // Already running.
+  if (!getCaptureSlots() && !enableCaptureRing(slots)) return false;
+  if (queue_length) {
+    _task_queue = xQueueCreate(queue_length, sizeof(decode_results));
+    if (_task_queue == NULL) return false;
+  }
+  _task_callback = callback;
+  _task_arg = arg;
+  _task_stop = false;
+  _task_drops = 0;
+  _task_running = true;
+  TaskHandle_t task = NULL;
+  if (xTaskCreatePinnedToCore(_decodeTask, "IRrecv", kDecodeTaskStackSize,
+                              this, kDecodeTaskPriority, &task,
+                              core) != pdPASS) {
+    _task_running = false;
+    if (_task_queue != NULL)
+      vQueueDelete(static_cast<QueueHandle_t>(_task_queue));
+    _task_queue = NULL;
+    return false;
+  }
+  _params->task = task;
+  return true;
+}
+
+/// Stop the decode task, once it has finished what it is doing.
+/// Any decoded messages still waiting in its queue are discarded.
+/// @note The capture ring is left in use.
+void IRrecv::stopDecodeTask(void) {
+  TaskHandle_t task = static_cast<TaskHandle_t>(_params->task);
+  if (task == NULL) return;
+  _params->task = NULL;  // The interrupt handler won't wake it any more.
+  _task_stop = true;
+  xTaskNotifyGive(task);
+  while (_task_running) vTaskDelay(1);  // It deletes itself.
+  if (_task_queue != NULL)
+    vQueueDelete(static_cast<QueueHandle_t>(_task_queue));
+  _task_queue = NULL;
+}
+
+/// Collect the next message the decode task has decoded.
+/// @param[out] results A PTR to where to store the decoded message.
+/// @param[in] wait_ms How long to wait for one. (milliSeconds)
+/// @return true, if there was a message. Otherwise false.
+/// @note Its `rawbuf` is not valid. See `startDecodeTask()`.
+bool IRrecv::readDecoded(decode_results *results, const uint32_t wait_ms) {
+  if (_task_queue == NULL) return false;
+  return xQueueReceive(static_cast<QueueHandle_t>(_task_queue), results,
+                       pdMS_TO_TICKS(wait_ms)) == pdTRUE;
+}
+
+/// Obtain the nr. of decoded messages lost as the queue was full.
+/// i.e. `readDecoded()` wasn't called often enough.
+/// @return The nr. of messages lost since `startDecodeTask()`.
+uint16_t IRrecv::getDecodedDrops(void) { return _task_drops; }
+
+/// The body of the decode task.
+/// @param[in] arg The IRrecv instance it is decoding for.
+void IRrecv::_decodeTask(void *arg) {
+  IRrecv *irrecv = static_cast<IRrecv *>(arg);
+  decode_results results;
+  // The RMT peripheral can't wake us, so check it for captures regularly.
+  const TickType_t wait = IRRECV_USE_RMT ?
+      std::max(pdMS_TO_TICKS(irrecv->_params->timeout), (TickType_t)1) :
+      portMAX_DELAY;
+  while (!irrecv->_task_stop) {
+    ulTaskNotifyTake(pdTRUE, wait);
+    // Work through every completed capture. More may end while we decode.
+    while (!irrecv->_task_stop && irrecv->decode(&results)) {
+      if (irrecv->_task_callback != NULL)
+        irrecv->_task_callback(&results, irrecv->_task_arg);
+      if (irrecv->_task_queue != NULL &&
+          xQueueSend(static_cast<QueueHandle_t>(irrecv->_task_queue),
+                     &results, 0) != pdTRUE &&
+          irrecv->_task_drops < UINT16_MAX)
+        irrecv->_task_drops++;
+    }
+  }
+  irrecv->_task_running = false;
+  vTaskDelete(NULL);
+}
+#endif  // IRRECV_DECODE_TASK
+
+/// Set or clear the bit for a protocol in a protocol bitmask.
+/// @param[in,out] mask The bitmask to modify.
+/// @param[in] protocol The protocol to change.
+/// @param[in] on Set the bit if true, clear it if false.
+void IRrecv::_setProtocolBit(uint8_t *mask, const decode_type_t protocol,
+                             const bool on) {
+  if (protocol < UNKNOWN || protocol > kLastDecodeType) return;
+  const uint16_t index = protocol - UNKNOWN;
+  if (on)
+    mask[index / 8] |= (1 << (index % 8));
+  else
+    mask[index / 8] &= ~(1 << (index % 8));
+}
+
+/// Allow `decode()` to attempt to decode a protocol. (The default)
+/// @param[in] protocol The protocol to enable. `UNKNOWN` is the hash decoder.
+/// @note Protocols not enabled at compile-time (`DECODE_XXX`) are never tried.
+void IRrecv::enableProtocol(const decode_type_t protocol) {
+  _setProtocolBit(_protocols, protocol, true);
+}
+
+/// Stop `decode()` from attempting to decode a protocol.
+/// @param[in] protocol The protocol to disable. `UNKNOWN` is the hash decoder.
+void IRrecv::disableProtocol(const decode_type_t protocol) {
+  _setProtocolBit(_protocols, protocol, false);
+}
+
+/// Allow `decode()` to attempt every protocol enabled at compile-time.
+void IRrecv::enableAllProtocols(void) {
+  for (uint8_t i = 0; i < kProtocolMaskSize; i++) _protocols[i] = 0xFF;
+}
+
+/// Stop `decode()` from attempting any protocol.
+void IRrecv::disableAllProtocols(void) {
+  for (uint8_t i = 0; i < kProtocolMaskSize; i++) _protocols[i] = 0;
+}
+
+/// Will `decode()` attempt to decode a protocol?
+/// @param[in] protocol The protocol to check.
+/// @return true if it is enabled, otherwise false.
+bool IRrecv::isProtocolEnabled(const decode_type_t protocol) {
+#if ENABLE_CUSTOM_PROTOCOLS
+  // Those registered at run time are enabled until they are removed.
+  if (protocol > kLastDecodeType) return ircustom::get(protocol) != NULL;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  if (protocol < UNKNOWN || protocol > kLastDecodeType) return false;
+  const uint16_t index = protocol - UNKNOWN;
+  return _protocols[index / 8] & (1 << (index % 8));
+}
+
+/// Start a training window to learn which protocols are in use.
+/// Until `stopProtocolLearning()` is called, `decode()` attempts every protocol
+/// and records the ones it successfully decodes.
+void IRrecv::startProtocolLearning(void) {
+  for (uint8_t i = 0; i < kProtocolMaskSize; i++) _learned[i] = 0;
+  _learning = true;
+}
+
+/// End the training window started by `startProtocolLearning()`.
+/// @param[in] apply If true, only the protocols decoded during the window are
+///   enabled from now on. Otherwise, which protocols are enabled is unchanged.
+/// @return The nr. of different protocols decoded during the window.
+uint16_t IRrecv::stopProtocolLearning(const bool apply) {
+  _learning = false;
+  uint16_t count = 0;
+  for (uint8_t i = 0; i < kProtocolMaskSize; i++) {
+    count += countBits(_learned[i], 8);
+    if (apply) _protocols[i] = _learned[i];
+  }
+  return count;
+}
 
 #if DECODE_HASH
 /// Set the minimum length we will consider for reporting UNKNOWN message types.
@@ -324,9 +2491,64 @@ uint16_t IRrecv::getBufSize(void) { return irparams.bufsize; }
 void IRrecv::setUnknownThreshold(const uint16_t length) {
   _unknown_threshold = length;
 }
+
+/// Only report the UNKNOWN (`decodeHash()`) hash of messages. i.e. Don't try
+/// to decode them as any protocol. Handy when learning arbitrary remotes.
+/// With `ENABLE_CAPTURE_HASH`, the interrupt handler has already built the
+/// hash, so `decode()` does next to nothing.
+/// @param[in] on Only report the hash if true. Decode as normal if false.
+/// @note Needs the UNKNOWN protocol to be enabled. Messages shorter than the
+///   `setUnknownThreshold()` length are not reported.
+void IRrecv::setHashOnly(const bool on) { _hash_only = on; }
 #endif  // DECODE_HASH
 
 
+/// Set how much longer marks (& shorter spaces) are than they should be, due
+/// to the lag of the IR sensor/demodulator. i.e. Use it in place of
+/// `kMarkExcess`. Protocols with an excess of their own are adjusted by the
+/// same amount. e.g. A setting of 80 adds 30us to `kDaikinMarkExcess`.
+/// @param[in] excess The sensor lag in uSeconds. (Def: kMarkExcess)
+/// @note Use `getMarkExcess()` to save a calibrated value (e.g. to EEPROM or
+///   NVS) & this to restore it, rather than calibrating on every boot.
+/// @see startMarkExcessCalibration()
+void IRrecv::setMarkExcess(const int16_t excess) {
+  _excess_adjust = std::max(std::min(excess, kMaxMarkExcess),
+                            (int16_t)-kMaxMarkExcess) - kMarkExcess;
+}
+
+/// Get the mark excess (sensor lag) in use.
+/// @return The excess in uSeconds.
+int16_t IRrecv::getMarkExcess(void) { return kMarkExcess + _excess_adjust; }
+
+/// Start measuring the lag of the IR sensor, from the messages decoded.
+/// i.e. How much longer the marks, & shorter the spaces, are than what the
+/// protocols say they should be. Only the marks & spaces of successfully
+/// decoded messages are used. e.g. Press a few buttons on known remotes.
+/// @see stopMarkExcessCalibration()
+void IRrecv::startMarkExcessCalibration(void) {
+  _calibration_sum = 0;
+  _calibration_count = 0;
+  _calibrating = true;
+}
+
+/// Stop measuring the lag of the IR sensor, & optionally use what was found.
+/// @param[in] apply Use the measured value from now on? See `setMarkExcess()`.
+/// @return The measured mark excess in uSeconds, or the one in use if fewer
+///   than `kMarkExcessMinSamples` marks & spaces were measured.
+int16_t IRrecv::stopMarkExcessCalibration(const bool apply) {
+  _calibrating = false;
+  if (_calibration_count < kMarkExcessMinSamples) return getMarkExcess();
+  const int64_t half = _calibration_count / 2;  // For rounding to nearest.
+  const int64_t skew = (_calibration_sum + (_calibration_sum < 0 ? -half
+                                                                 : half)) /
+      (int64_t)_calibration_count;
+  const int16_t excess = std::max(
+      std::min(getMarkExcess() + skew, (int64_t)kMaxMarkExcess),
+      (int64_t)-kMaxMarkExcess);
+  if (apply) setMarkExcess(excess);
+  return excess;
+}
+
 /// Set the base tolerance percentage for matching incoming IR messages.
 /// @param[in] percent An integer percentage. (0-100)
 void IRrecv::setTolerance(const uint8_t percent) {
@@ -337,34 +2559,446 @@ void IRrecv::setTolerance(const uint8_t percent) {
 /// @return A integer percentage.
 uint8_t IRrecv::getTolerance(void) { return _tolerance; }
 
+#if ENABLE_PROTOCOL_TOLERANCE
+/// Set the tolerance percentage (& adjust the mark excess) for matching one
+/// protocol, in place of the one its decoder uses. e.g. `setTolerance()` or
+/// its own, like `kDaikinTolerance`. The other protocols are unaffected.
+/// @param[in] protocol The protocol.
+/// @param[in] percent An integer percentage. (0-100)
+/// @param[in] excess Nr. of uSeconds to add to the mark excess the protocol's
+///   decoder (& `setMarkExcess()`) uses. (Def: 0)
+/// @return true, if it was set. false if the protocol isn't valid, or
+///   `kMaxProtocolTolerances` other protocols already have one.
+/// @note The scaling is worked out here, once, so matching that protocol only
+///   needs integer maths.
+bool IRrecv::setProtocolTolerance(const decode_type_t protocol,
+                                  const uint8_t percent,
+                                  const int16_t excess) {
+  if (protocol <= decode_type_t::UNKNOWN || protocol > kLastDecodeType)
+    return false;
+  protocol_tolerance_t *entry = _findProtocolTolerance(protocol);
+  if (entry == NULL) {
+    if (_protocol_tolerance_count >= kMaxProtocolTolerances) return false;
+    entry = &_protocol_tolerances[_protocol_tolerance_count++];
+    entry->protocol = protocol;
+  }
+  entry->tolerance = std::min(percent, (uint8_t)100);
+  entry->excess = std::max(std::min(excess, kMaxMarkExcess),
+                           (int16_t)-kMaxMarkExcess);
+  // Rounded outwards, so the windows are never narrower than the floating
+  // point maths would make them, & within a uSecond or two of them.
+  entry->low = ((uint32_t)(100 - entry->tolerance) << kToleranceScaleBits) /
+      100;
+  entry->high = (((uint32_t)(100 + entry->tolerance) << kToleranceScaleBits) +
+                 99) / 100;
+  _protocol_tolerance = NULL;  // Picked up by the next attempt.
+  return true;
+}
+
+/// Get the tolerance percentage set for matching a protocol.
+/// @param[in] protocol The protocol.
+/// @return A integer percentage, or kUseDefTol if it hasn't got one.
+uint8_t IRrecv::getProtocolTolerance(const decode_type_t protocol) {
+  const protocol_tolerance_t *entry = _findProtocolTolerance(protocol);
+  return (entry != NULL) ? entry->tolerance : kUseDefTol;
+}
+
+/// Go back to the tolerance (& mark excess) a protocol's decoder uses.
+/// @param[in] protocol The protocol.
+void IRrecv::clearProtocolTolerance(const decode_type_t protocol) {
+  protocol_tolerance_t *entry = _findProtocolTolerance(protocol);
+  if (entry == NULL) return;
+  *entry = _protocol_tolerances[--_protocol_tolerance_count];
+  _protocol_tolerance = NULL;  // It may have pointed at the moved entry.
+}
+
+/// Find the tolerance set for a protocol.
+/// @param[in] protocol The protocol.
+/// @return A Ptr to it, or NULL if it hasn't got one.
+protocol_tolerance_t *IRrecv::_findProtocolTolerance(
+    const decode_type_t protocol) {
+  for (uint8_t i = 0; i < _protocol_tolerance_count; i++)
+    if (_protocol_tolerances[i].protocol == protocol)
+      return &_protocol_tolerances[i];
+  return NULL;
+}
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+
+/// The amount to add to the mark excess a decoder uses.
+/// i.e. `setMarkExcess()`'s, & that set for the protocol being attempted.
+/// @return The adjustment in uSeconds.
+int16_t IRrecv::_excessAdjust(void) {
+#if ENABLE_PROTOCOL_TOLERANCE
+  if (_protocol_tolerance != NULL)
+    return _excess_adjust + _protocol_tolerance->excess;
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+  return _excess_adjust;
+}
+
+#if ENABLE_CARRIER_FILTER
+/// @cond IGNORE
+// The carrier each protocol is sent with, in 10Hz units. Shared by all of the
+// receivers, & only allocated once a carrier has been measured.
+static uint16_t *protocol_carriers = NULL;
+const uint16_t kCarrierNotSent = UINT16_MAX;  // No carrier is known for it.
+/// @endcond
+
+/// Set if the input is raw (i.e. not demodulated) carrier pulses, so each
+/// capture's carrier frequency is measured, & decoders of protocols sent with
+/// a different carrier are skipped. e.g. An IR photodiode or transistor, rather
+/// than a TSOP-style IR receiver module.
+/// The pulses are demodulated into the usual marks & spaces as each capture is
+/// read, so `decode()` & `resultToRawArray()` etc are unaffected.
+/// @param[in] raw true, if it is a raw input. false (default) if it isn't.
+/// @note Only the ESP32's RMT peripheral can capture a raw input. See
+///   `ENABLE_ESP32_RMT_RECV`. Call it before `enableIRIn()`.
+///   A capture holds as many carrier pulses as the RMT memory blocks of the
+///   receiver's channel do, so long A/C messages may be cut short.
+void IRrecv::setCarrierInput(const bool raw) {
+  _params->rawinput = raw;
+  _params->carrier = 0;
+}
+
+/// Is the input raw (i.e. not demodulated) carrier pulses?
+/// @return true, if it is. Otherwise false.
+bool IRrecv::getCarrierInput(void) { return _params->rawinput; }
+
+/// Set how close a measured carrier must be to a protocol's, for it to be
+/// decoded as that protocol.
+/// @param[in] percent An integer percentage. 0 means any carrier will do.
+///   i.e. No decoders are skipped.
+void IRrecv::setCarrierTolerance(const uint8_t percent) {
+  _carrier_tolerance = std::min(percent, (uint8_t)100);
+}
+
+/// Get how close a measured carrier must be to a protocol's.
+/// @return An integer percentage.
+uint8_t IRrecv::getCarrierTolerance(void) { return _carrier_tolerance; }
+
+/// Get the carrier frequency measured for the capture last decoded.
+/// @return The frequency in Hz. 0 if it wasn't measured. e.g. The input is
+///   from an IR receiver module, which removes the carrier.
+uint32_t IRrecv::getCarrier(void) { return _carrier; }
+
+/// Get the carrier frequency a protocol is sent with. i.e. What `IRsend` uses.
+/// It is measured from a recording of `IRsend::send()` the first time it is
+/// needed, & remembered.
+/// @param[in] protocol The protocol.
+/// @return The frequency in Hz. 0 if it isn't known. e.g. It can't be sent.
+uint32_t IRrecv::protocolCarrier(const decode_type_t protocol) {
+#if ENABLE_CUSTOM_PROTOCOLS
+  const custom_protocol_t *custom = ircustom::get(protocol);
+  if (custom != NULL) return custom->timing.frequency;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  if (protocol <= decode_type_t::UNKNOWN || protocol > kLastDecodeType)
+    return 0;
+  if (protocol_carriers == NULL) {
+    protocol_carriers = new uint16_t[kLastDecodeType + 1];
+    if (protocol_carriers == NULL) return 0;
+    memset(protocol_carriers, 0, sizeof(uint16_t) * (kLastDecodeType + 1));
+  }
+  if (!protocol_carriers[protocol]) {  // Not measured yet.
+    IRsend irsend(0);  // Only recorded, so the pin is never used.
+    protocol_info_t info;
+    if (irsend.protocolInfo(protocol, &info) && info.frequency)
+      protocol_carriers[protocol] = std::min(
+          (info.frequency + 5) / 10, (uint32_t)kCarrierNotSent - 1);
+    else
+      protocol_carriers[protocol] = kCarrierNotSent;
+  }
+  if (protocol_carriers[protocol] == kCarrierNotSent) return 0;
+  return protocol_carriers[protocol] * 10;
+}
+
+/// Could a protocol have been sent with the carrier measured for the capture?
+/// @param[in] protocol The protocol.
+/// @return true, if it could have. e.g. It is within `getCarrierTolerance()`
+///   of the protocol's, or either of them isn't known. Otherwise false.
+bool IRrecv::_carrierMatches(const decode_type_t protocol) {
+  if (!_carrier || !_carrier_tolerance) return true;
+  const uint32_t nominal = protocolCarrier(protocol);
+  if (!nominal) return true;
+  const uint32_t diff = (_carrier > nominal) ? _carrier - nominal
+                                             : nominal - _carrier;
+  return (uint64_t)diff * 100 <= (uint64_t)nominal * _carrier_tolerance;
+}
+
+/// Start demodulating the carrier pulses of a new capture.
+/// @param[out] demod The state to reset.
+void IRrecv::_demodReset(carrier_demod_t *demod) {
+  memset(demod, 0, sizeof(*demod));
+}
+
+/// Demodulate the next carrier pulse of a raw input. Pulses closer together
+/// than `kCarrierMaxGap` are the same mark. A mark is taken to be a whole nr.
+/// of carrier periods, so its last period's off time is part of it, like a
+/// demodulating IR receiver module would report it.
+/// @param[in,out] demod The state of the capture's demodulation.
+/// @param[in] on How long the pulse was. (uSeconds) 0 if there wasn't one.
+/// @param[in] off How long the input was off after it. (uSeconds) 0 means
+///   the capture has ended.
+/// @param[out] entries The mark & space it ended, if it ended a mark.
+///   (uSeconds) i.e. 0 if it didn't. The space is 0 if the capture ended.
+void IRrecv::_demodulate(carrier_demod_t *demod, const uint16_t on,
+                         const uint16_t off, uint32_t entries[2]) {
+  entries[0] = 0;
+  entries[1] = 0;
+  if (on) {
+    if (!demod->pulses) demod->start = demod->now;  // A new mark.
+    demod->last = demod->now;
+    demod->on = on;
+    demod->pulses++;
+    demod->now += on + off;
+    if (off && off <= kCarrierMaxGap) return;  // The mark carries on.
+  } else if (!demod->pulses) {
+    return;  // There is no mark to end.
+  }
+  uint32_t mark = demod->on;  // A lone pulse has no carrier to go by.
+  if (demod->pulses > 1) {
+    const uint32_t span = demod->last - demod->start;
+    const uint16_t periods = demod->pulses - 1;
+    mark = (span * demod->pulses + periods / 2) / periods;
+    demod->span += span;
+    demod->periods += periods;
+  }
+  entries[0] = mark;
+  const uint32_t end = demod->start + mark;
+  if (on && off)  // Until the next pulse. Never none, as it is a space.
+    entries[1] = (demod->now > end) ? demod->now - end : 1;
+  demod->pulses = 0;
+}
+
+/// Get the carrier frequency of the pulses demodulated so far.
+/// @param[in] demod The state of the capture's demodulation.
+/// @return The frequency in Hz. 0 if there wasn't a mark of 2+ pulses.
+uint32_t IRrecv::_demodCarrier(const carrier_demod_t *demod) {
+  if (!demod->span) return 0;
+  return (1000000ULL * demod->periods + demod->span / 2) / demod->span;
+}
+#endif  // ENABLE_CARRIER_FILTER
+
+#if ENABLE_GLITCH_FILTER
+/// Drop marks & spaces too short to be real (e.g. Noise) as they are captured,
+/// rather than filling up the capture buffer with them. Each one is added to
+/// the entry it interrupted, along with the rest of that entry.
+/// i.e. A glitch in a space makes it one longer space, & a glitch on an idle
+///   line doesn't start a capture.
+/// @param[in] usecs Entries shorter than this are dropped. (uSeconds)
+///   0 turns it off. (The default)
+/// @note Not applied to compact captures. They can't take back an entry.
+/// @note The ESP32 RMT receiver's hardware filter is also set, but it can only
+///   filter pulses up to ~3us, so the rest are merged as each capture is read.
+/// @warning Setting it too high **WILL** break decoding of some protocols.
+///   Stay well under the shortest mark/space of the protocols you use.
+void IRrecv::setGlitchFilter(const uint16_t usecs) {
+  _params->glitch = usecs / kRawTick;
+#if IRRECV_USE_RMT
+#if ENABLE_CARRIER_FILTER
+  // `rmt_read()` applies it to a raw input, as it would remove the carrier.
+  if (_params->rawinput) return;
+#endif  // ENABLE_CARRIER_FILTER
+  if (_id < kMaxReceivers && rmt_ringbuf[_id] != NULL)
+    rmt_set_rx_filter(rmt_channel(_id), true, rmt_filter(usecs));
+#endif  // IRRECV_USE_RMT
+}
+
+/// Get the length of the shortest mark or space that is captured.
+/// @return The nr. of uSeconds. 0 if all of them are.
+uint16_t IRrecv::getGlitchFilter(void) { return _params->glitch * kRawTick; }
+#endif  // ENABLE_GLITCH_FILTER
+
+#if ENABLE_ECHO_SUPPRESSION
+/// Ignore what an `IRsend` on the same device transmits. i.e. Don't capture
+/// (or decode) our own messages. e.g. A device that both sends & receives, or
+/// a repeater that would otherwise repeat itself in a loop.
+/// Edges seen while it is sending each mark (See `IRsend::getEcho()`) are
+/// dropped by the interrupt handler.
+/// @param[in] irsend The transmitter to ignore. NULL stops ignoring it.
+/// @note A message from elsewhere that arrives while we are transmitting is
+///   lost too. It would be garbled by our own anyway.
+/// @note Not for the ESP32 RMT receiver, nor `IRrepeater`'s cut-through mode.
+///   It transmits while the original is still arriving.
+void IRrecv::ignoreEcho(const IRsend *irsend) {
+  _params->echo = (irsend != NULL) ? irsend->getEcho() : NULL;
+}
+#endif  // ENABLE_ECHO_SUPPRESSION
+
+#if ENABLE_IR_MIRROR
+/// Repeat what is received out of an `IRsend`, as it is received. i.e. The
+/// GPIO interrupt handler copies each edge to it before doing anything else,
+/// so the copy lags the original by microseconds, rather than by a whole
+/// message, & protocols we can't decode are repeated too. It is still
+/// captured & decoded as usual.
+/// @param[in] irsend The transmitter to mirror to. `IRsend::beginMirror()` it
+///   first, & only mirror to it if that returned true. NULL stops mirroring.
+/// @note The receiver must not see the mirrored output, or it will mirror it
+///   again, in a loop. `ignoreEcho()` can't help, as the copy is sent while
+///   the original is still arriving. i.e. Shield, or aim, them apart.
+/// @note Only for the GPIO interrupt handler. i.e. Not the ESP32 RMT receiver,
+///   nor a capture source. They don't see each edge as it happens.
+/// @note The timing is copied as is, noise & all. `IRrepeater`'s cut-through
+///   mode cleans it up, at the cost of a longer lag.
+void IRrecv::mirrorTo(IRsend *irsend) {
+  IRsend *previous = _params->mirror;
+  _params->mirror = NULL;  // So the interrupt handler doesn't use it as we do.
+  if (previous != NULL && _params->mirrored) previous->mirrorMark(false);
+  _params->mirrored = false;
+  _params->mirror = irsend;
+}
+#endif  // ENABLE_IR_MIRROR
+
+#if ENABLE_SIGNAL_QUALITY
+/// Report how well the timings of each decoded message fitted its protocol,
+/// in `decode_results::quality`. i.e. The mean & worst timing error, & how
+/// many marks & spaces were near the limit of the tolerance. (See
+/// `signal_quality_t`) A link-quality indicator, at no extra air time.
+/// e.g. To adjust an emitter's power or placement, or to tighten the
+/// tolerance (See `setTolerance()`) while the link is good, so there are
+/// fewer false matches.
+/// @param[in] on Report it, or not.
+/// @note It costs a little time per mark & space when decoding.
+///   The hash (UNKNOWN) decoder has no timings to fit. It reports none.
+void IRrecv::setSignalQuality(const bool on) { _quality = on; }
+
+/// Is the signal quality of each decoded message being reported?
+/// @return true, if it is. Otherwise false.
+bool IRrecv::getSignalQuality(void) { return _quality; }
+#endif  // ENABLE_SIGNAL_QUALITY
+
+#if ENABLE_LOW_POWER_RECV
+/// Set how long it takes a light-sleeping CPU to wake up & see the first edge
+/// of a message. `sleepUntilIR()` adds it to the start of the header mark.
+/// @param[in] usecs The nr. of uSeconds. 0 is no compensation.
+/// @note Measure it for your board. e.g. Compare the header mark of a known
+///   message captured after `sleepUntilIR()` with one captured awake.
+void IRrecv::setWakeLatency(const uint16_t usecs) { _wake_latency = usecs; }
+
+/// Get how long it takes a light-sleeping CPU to wake up.
+/// @return The nr. of uSeconds.
+uint16_t IRrecv::getWakeLatency(void) { return _wake_latency; }
+
+/// Light-sleep the CPU until an IR message (or `max_ms`) wakes it.
+/// The first mark of the message wakes it via a GPIO wakeup, and the capture
+/// then carries on as usual, with the wake latency (See `setWakeLatency()`)
+/// added to the header mark. Call it again once the message is decoded.
+/// e.g. `if (irrecv.decode(&results)) { ... } irrecv.sleepUntilIR();`
+/// @param[in] max_ms The most milli-Seconds to sleep for. 0 is no limit.
+/// @return true, if an IR message woke us. false, if it didn't sleep (e.g. A
+///   capture is in progress or waiting to be decoded), or the time ran out.
+/// @note The IR receiver module is assumed to be active low. As most are.
+/// @note ESP8266: Forced light sleep needs the WiFi to be off. e.g.
+///   `WiFi.mode(WIFI_OFF)` or `wifi_set_opmode_current(NULL_MODE)`.
+/// @note Not for the ESP32 RMT receiver. It doesn't run in light sleep.
+///   Nor for a capture source. See `setCaptureSource()`.
+bool IRrecv::sleepUntilIR(const uint32_t max_ms) {
+  if (_id >= kMaxReceivers || _params->rcvstate != kIdleState
+#if ENABLE_CAPTURE_RING
+      || (_params->slots && _params->head != _params->tail)
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_CUSTOM_BACKENDS
+      || _source != NULL  // Its edges don't come via our GPIO.
+#endif  // ENABLE_CUSTOM_BACKENDS
+      ) return false;
+  _params->wake = _wake_latency;
+#if defined(UNIT_TEST)
+  (void)max_ms;
+  return false;  // No sleep. The next edge is the one that "woke" us.
+#elif IRRECV_USE_RMT || !(defined(ESP8266) || defined(ESP32))
+  (void)max_ms;
+  _params->wake = 0;
+  return false;
+#else  // UNIT_TEST
+  const uint8_t pin = _params->recvpin;
+#if defined(ESP8266)
+  wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+  wifi_fpm_open();
+  gpio_pin_wakeup_enable(GPIO_ID_PIN(pin), GPIO_PIN_INTR_LOLEVEL);
+  // 0xFFFFFFF is "until woken". The sleep starts at the next delay().
+  wifi_fpm_do_sleep(max_ms ? max_ms * 1000 : 0xFFFFFFF);
+  delay(max_ms ? max_ms + 1 : 1);
+  gpio_pin_wakeup_disable();
+  wifi_fpm_close();
+#endif  // ESP8266
+#if defined(ESP32)
+  gpio_wakeup_enable(static_cast<gpio_num_t>(pin), GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  if (max_ms) esp_sleep_enable_timer_wakeup(MS_TO_USEC(max_ms));
+  esp_light_sleep_start();
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  gpio_wakeup_disable(static_cast<gpio_num_t>(pin));
+#endif  // ESP32
+  // The wakeup replaced our interrupt's trigger. Put it back.
+  attachInterrupt(pin, gpio_intrs[_id], CHANGE);
+  // If the interrupt handler missed the edge that woke us, start it ourselves.
+  if (_params->rcvstate == kIdleState && !digitalRead(pin)) {
+    noInterrupts();
+    gpio_intr(_id);
+    interrupts();
+  }
+  const bool woken = (_params->rcvstate != kIdleState);
+  _params->wake = 0;  // Don't credit a capture that didn't wake us.
+  return woken;
+#endif  // UNIT_TEST
+}
+#endif  // ENABLE_LOW_POWER_RECV
+
+#if ENABLE_PARTIAL_DECODE
+/// Make what we can of captures that overflowed the capture buffer part way
+/// through a multi-section A/C message. e.g. A Daikin message with a buffer
+/// too small for all of it.
+/// The complete sections at its start are decoded & reported, with `bits`
+/// covering just those, & the `truncated` flag set. The rest of the `state`
+/// is zeroed.
+/// With the capture ring (See `enableCaptureRing()`) an overflowed capture
+/// carries straight on in the next slot, so the rest of the message is joined
+/// back on from there, if the join fell in the gap between two sections.
+/// @param[in] on Decode the start of overflowed captures? (Off by default.)
+/// @note Only decoders built on `matchSections()` can do this.
+/// @warning A truncated message has no checksums for the missing sections, so
+///   it is less certain to be what it claims. Check `truncated` before acting
+///   on it.
+void IRrecv::setPartialDecode(const bool on) { _partial = on; }
+
+/// Is making what we can of overflowed captures turned on?
+/// @return true, if it is. Otherwise false.
+bool IRrecv::getPartialDecode(void) { return _partial; }
+#endif  // ENABLE_PARTIAL_DECODE
+
 #if ENABLE_NOISE_FILTER_OPTION
 /// Remove or merge pulses in the capture buffer that are too short.
 /// @param[in,out] results Ptr to the decode_results we are going to filter.
 /// @param[in] floor Only allow values in the buffer large than this.
 ///   (in microSeconds)
+/// @note Done in a single pass, with separate read & write positions, rather
+///   than shuffling the rest of the buffer down for each pulse removed.
 void IRrecv::crudeNoiseFilter(decode_results *results, const uint16_t floor) {
   if (floor == 0) return;  // Nothing to do.
   const uint16_t kTickFloor = floor / kRawTick;
   const uint16_t kBufSize = getBufSize();
-  uint16_t offset = kStartOffset;
-  while (offset < results->rawlen && offset + 2 < kBufSize) {
-    uint16_t curr = results->rawbuf[offset];
-    uint16_t next = results->rawbuf[offset + 1];
-    uint16_t addition = curr + next;
+  const uint16_t rawlen = results->rawlen;
+  uint16_t in = kStartOffset;   // Where we are reading from.
+  uint16_t out = kStartOffset;  // Where we are writing to.
+  while (in < rawlen && out + 2 < kBufSize) {
+    const uint16_t curr = results->rawbuf[in];
     if (curr < kTickFloor) {  // Is it too short?
-      // Shuffle the buffer down. i.e. Remove the mark & space pair.
-      // Note: `memcpy()` can't be used as rawbuf is `volatile`.
-      for (uint16_t i = offset + 2; i <= results->rawlen && i < kBufSize; i++)
-        results->rawbuf[i - 2] = results->rawbuf[i];
-      if (offset > 1) {  // There is a previous pair we can add to.
+      // Drop the mark & space pair.
+      const uint16_t next = (in + 1 < kBufSize) ? results->rawbuf[in + 1] : 0;
+      if (out > 1) {  // There is a previous pair we can add to.
         // Merge this pair into into the previous space.
-        results->rawbuf[offset - 1] += addition;
+        results->rawbuf[out - 1] += (uint16_t)(curr + next);
       }
-      results->rawlen -= 2;  // Adjust the length.
+      in += 2;
     } else {
-      offset++;  // Move along.
+      results->rawbuf[out++] = curr;  // Keep it.
+      in++;
     }
   }
+  // Move whatever is left (incl. the end marker) down to where we got to.
+  // Note: `memcpy()` can't be used as rawbuf is `volatile`.
+  if (in != out)
+    for (uint16_t i = in; i <= rawlen && i < kBufSize; i++)
+      results->rawbuf[out + i - in] = results->rawbuf[i];
+  results->rawlen = rawlen - (in - out);  // Adjust the length.
 }
 #endif  // ENABLE_NOISE_FILTER_OPTION
 
@@ -387,7 +3021,7 @@ void IRrecv::crudeNoiseFilter(decode_results *results, const uint16_t floor) {
 ///   e.g. 0 -> 1 will be a 2x increase in cpu usage/time.
 ///        0 -> 2 will be a 3x increase etc.
 ///   If you are going to do this, consider disabling protocol decoding for
-///   protocols you are not expecting.
+///   protocols you are not expecting, or using `setSmartSkip()`.
 /// @param[in] noise_floor Pulses below this size (in usecs) will be removed or
 ///   merged prior to any decoding. This is to try to remove noise/poor
 ///   readings & slighly increase the chances of a successful decode but at the
@@ -408,489 +3042,1753 @@ void IRrecv::crudeNoiseFilter(decode_results *results, const uint16_t floor) {
 /// @return A boolean indicating if an IR message is ready or not.
 bool IRrecv::decode(decode_results *results, irparams_t *save,
                     uint8_t max_skip, uint16_t noise_floor) {
-  // Proceed only if an IR message been received.
+  if (_id >= kMaxReceivers) return false;  // It has nothing to decode.
+#if ENABLE_MEMORY_PROFILING
+  irutils::MemoryProbe probe(kMemProbeDecode);
+#endif  // ENABLE_MEMORY_PROFILING
+#if ENABLE_REPEAT_COALESCING
+#if ENABLE_BUDGETED_DECODE
+  // A held button was released. Not while `results` holds a part decode.
+  if (!_suspended && _coalesceFlush(results)) return true;
+#else  // ENABLE_BUDGETED_DECODE
+  if (_coalesceFlush(results)) return true;  // A held button was released.
+#endif  // ENABLE_BUDGETED_DECODE
+  if (!_finishDecode(results, _decode(results, save, max_skip, noise_floor)))
+    return false;
+  if (_coalesceToggled(results)) return false;  // Counted it as a repeat.
+#if ENABLE_GAMING_RECV
+  if (_gamingDuplicate(results)) return false;  // Already reported it.
+#endif  // ENABLE_GAMING_RECV
+  _coalesceStore(results);
+  return true;
+#else  // ENABLE_REPEAT_COALESCING
+  if (!_finishDecode(results, _decode(results, save, max_skip, noise_floor)))
+    return false;
+#if ENABLE_GAMING_RECV
+  if (_gamingDuplicate(results)) return false;  // Already reported it.
+#endif  // ENABLE_GAMING_RECV
+  return true;
+#endif  // ENABLE_REPEAT_COALESCING
+}
+
+#if ENABLE_BUDGETED_DECODE
+/// Decode the captured IR message, as `decode()` does, but stop trying
+/// protocols once a time budget has been spent. The next call carries on from
+/// the protocol (& offset) after the last one tried, rather than starting
+/// again. i.e. A long capture, decoded with every protocol enabled & a
+/// `max_skip`, can't hold up the main loop for much longer than the budget.
+/// The capture stays where it is until it has been decoded. e.g. In its slot
+/// of the capture ring, or in the capture buffer (capturing stays stopped) if
+/// there is no `save_buffer`. So no message is lost, or overwritten, by
+/// spreading its decode over several calls.
+/// e.g.
+/// @code
+///   void loop() {
+///     if (irrecv.decodeBudget(&results, 2000)) {  // At most ~2ms per loop.
+///       ...
+///     }
+///     server.handleClient();
+///   }
+/// @endcode
+/// @param[in,out] results A PTR to where the decoded IR message will be
+///   stored. The same one must be passed to each call until it is decoded.
+///   See `isDecoding()`.
+/// @param[in] budget How long to try protocols for, this call. (uSeconds)
+///   At least one is tried per call, even if it is 0. The longest a single
+///   decoder takes (& `max_skip`'s offsets) may still overrun it.
+/// @param[in] save See `decode()`. Only used when a new capture is fetched.
+/// @param[in] max_skip See `decode()`. It must be the same for each call.
+/// @param[in] noise_floor See `decode()`. It must be the same for each call.
+/// @return A boolean indicating if an IR message is ready or not.
+/// @note `decode()` finishes a capture part way through decoding, without a
+///   budget. `resume()` abandons it.
+bool IRrecv::decodeBudget(decode_results *results, const uint32_t budget,
+                          irparams_t *save, uint8_t max_skip,
+                          uint16_t noise_floor) {
+  _budgeted = true;
+  _budget = budget;
+  _budget_timer.reset();
+  const bool success = decode(results, save, max_skip, noise_floor);
+  _budgeted = false;
+  return success;
+}
+
+/// Is a capture part way through being decoded? See `decodeBudget()`.
+/// @return true, if the last `decodeBudget()` ran out of time before it was
+///   decoded. Otherwise false.
+bool IRrecv::isDecoding(void) const { return _suspended; }
+
+/// Has the budget of the `decodeBudget()` call in progress been spent?
+/// @return true, if it has. false if it hasn't, or there isn't one.
+bool IRrecv::_budgetSpent(void) {
+#if ENABLE_DECODE_CACHE
+  if (_dcache_only) return false;  // Only one protocol is being tried.
+#endif  // ENABLE_DECODE_CACHE
+  return _budgeted && _budget_timer.elapsed() >= _budget;
+}
+#endif  // ENABLE_BUDGETED_DECODE
+
+/// Attempt to decode an IR message while it may still be arriving.
+/// i.e. Don't wait for the full `timeout` of silence before decoding.
+/// Once the signal has been quiet for `quiet` uSeconds after a mark, the
+/// message so far is copied & decoded as if the capture had ended there. If a
+/// protocol decodes it, the result is returned straight away & capturing
+/// starts afresh. Otherwise, capturing carries on as normal.
+/// Call it as often as you like from your main loop, in place of `decode()`.
+/// @param[out] results A PTR to where the decoded IR message will be stored.
+/// @param[in] quiet Nr. of uSeconds with no signal before we try to decode.
+///   It MUST be longer than any space within the messages you expect,
+///   otherwise shorter versions of a protocol may match the start of a longer
+///   message. e.g. 12 bit vs 20 bit Sony messages.
+/// @param[in] max_skip See `decode()`.
+/// @param[in] noise_floor See `decode()`.
+/// @return A boolean indicating if an IR message is ready or not.
+/// @note Requires the `save_buffer` option of the IRrecv constructor, as
+///   the message is decoded from a copy. Without it, this is just `decode()`.
+///   Messages that only the hash (UNKNOWN) decoder matches are not reported
+///   early. They are reported by `decode()` when the `timeout` is reached.
+bool IRrecv::decodeEarly(decode_results *results, const uint16_t quiet,
+                         uint8_t max_skip, uint16_t noise_floor) {
+  irparams_t *save = irparams_save;
+  if (save == NULL || _params->rcvstate == kStopState
+#if ENABLE_CAPTURE_RING
+      || _params->slots
+#endif  // ENABLE_CAPTURE_RING
+      ) return decode(results, NULL, max_skip, noise_floor);
+  if (_params->rcvstate != kMarkState) return false;  // Nothing has arrived.
+  const uint16_t rawlen = _params->rawlen;
+  // Only try once per space, after a mark. i.e. Where a message could end.
+  if (rawlen % 2 || rawlen == _early_rawlen) return false;
 #ifndef UNIT_TEST
-  if (irparams.rcvstate != kStopState) return false;
-#endif
+  if (micros() - _params->lastedge < quiet) return false;  // Too soon to tell.
+#else  // UNIT_TEST
+  (void)quiet;  // Not used.
+#endif  // UNIT_TEST
+  _early_rawlen = rawlen;
+  // Copy what we have so far. The ISR only writes after rawlen.
+#if ENABLE_COMPACT_CAPTURE
+  if (_params->packed != NULL) {
+    _unpackCapture(save, rawlen);
+  } else {
+#else  // ENABLE_COMPACT_CAPTURE
+  {
+#endif  // ENABLE_COMPACT_CAPTURE
+    save->bufsize = _params->bufsize;
+    for (uint16_t i = 0; i < rawlen; i++) save->rawbuf[i] = _params->rawbuf[i];
+    // The same as `decode()`'s end of the message.
+    if (rawlen < save->bufsize) save->rawbuf[rawlen] = 0;
+    save->rawlen = rawlen;
+  }
+  save->overflow = false;
+  results->rawbuf = save->rawbuf;
+  results->rawlen = save->rawlen;
+  results->overflow = save->overflow;
+  results->started = _params->started;
+  results->stopped = _params->lastedge;  // It hasn't ended, so the last edge.
+  if (!_finishDecode(results,
+                     _decodeCapture(results, max_skip, noise_floor)))
+    return false;
+  if (results->decode_type == UNKNOWN) return false;  // Only a hash. Wait.
+  resume();  // Got it. Discard the rest of it & start on the next message.
+  return true;
+}
+
+/// Check each of the receivers (IRrecv instances) for a message, in turn.
+/// i.e. A round-robin `decode()`, so a single loop can service all of them
+/// without any one receiver starving the others.
+/// @param[out] results A PTR to where the decoded IR message will be stored.
+/// @return The receiver that decoded a message, or NULL if none of them did.
+/// @note Uses the default `decode()` arguments. e.g. Each receiver's own
+///   `save_buffer` setting.
+IRrecv *IRrecv::decodeAny(decode_results *results) {
+  static uint8_t next = 0;  // Which receiver gets the first look.
+  for (uint8_t i = 0; i < kMaxReceivers; i++) {
+    const uint8_t n = (next + i) % kMaxReceivers;
+    if (receivers[n] != NULL && receivers[n]->decode(results)) {
+      next = (n + 1) % kMaxReceivers;  // Start with the one after it next.
+      return receivers[n];
+    }
+  }
+  return NULL;
+}
+
+/// Class constructor.
+/// @param[in] timeout Nr. of milli-Seconds of no signal that ended the
+///   captures. It limits how long a gap decoders will wait for, the same as
+///   the IRrecv constructor's. (Default: kTimeoutMs)
+IRdecoder::IRdecoder(const uint8_t timeout)
+    : IRrecv(no_capture_t(), timeout) {}
+
+/// Decode a capture supplied by the caller.
+/// @param[in,out] results A PTR to the capture. i.e. Its `rawbuf`, `rawlen`,
+///   & `overflow` must be set. The decoded IR message will be stored here.
+/// @param[in] max_skip See `IRrecv::decode()`.
+/// @param[in] noise_floor See `IRrecv::decode()`.
+/// @return true, if a protocol decoded the message. Otherwise false.
+/// @note Nothing is shared with any other instance, so different threads can
+///   safely decode at the same time with their own IRdecoder.
+bool IRdecoder::decode(decode_results *results, uint8_t max_skip,
+                       uint16_t noise_floor) {
+  if (results->rawbuf == NULL || results->rawlen == 0) return false;
+#if ENABLE_CAPTURE_HASH
+  _capture_hashed = false;  // No interrupt handler hashed it for us.
+#endif  // ENABLE_CAPTURE_HASH
+  return _finishDecode(results,
+                       _decodeCapture(results, max_skip, noise_floor));
+}
+
+/// Decode a buffer of ticks supplied by the caller.
+/// @param[out] results A PTR to where the decoded IR message will be stored.
+/// @param[in,out] rawbuf The capture. In the same format as the capture
+///   buffer. i.e. kRawTick units, starting with the gap before the message.
+///   It's modified if `noise_floor` is used, and `results` points to it.
+/// @param[in] rawlen Nr. of entries in `rawbuf`.
+/// @param[in] max_skip See `IRrecv::decode()`.
+/// @param[in] noise_floor See `IRrecv::decode()`.
+/// @return true, if a protocol decoded the message. Otherwise false.
+bool IRdecoder::decode(decode_results *results, uint16_t *rawbuf,
+                       const uint16_t rawlen, uint8_t max_skip,
+                       uint16_t noise_floor) {
+  results->rawbuf = rawbuf;
+  results->rawlen = rawlen;
+  results->overflow = false;
+  results->started = 0;
+  results->stopped = 0;
+  return decode(results, max_skip, noise_floor);
+}
+
+/// Decode the received IR message as every protocol that matches it, rather
+/// than just the first one. e.g. NEC-like protocols such as Sanyo, Pioneer or
+/// Epson. Each candidate is given a score, so the caller can choose between
+/// them.
+/// @param[out] candidates A PTR to an array of where to store the candidates.
+///   They are sorted by score, from most to least likely.
+/// @param[in] max_candidates The size of the `candidates` array.
+/// @param[out] save See `decode()`.
+/// @param[in] max_skip See `decode()`.
+/// @param[in] noise_floor See `decode()`.
+/// @return The nr. of candidates found. 0 if no message is ready.
+/// @note The score is based on how many of the captured marks & spaces the
+///   protocol matched (so more bits beats fewer), and how close they were to
+///   the protocol's nominal timings. Decoders are always run in `strict` mode,
+///   so any checksum or other integrity checks a protocol has must pass for
+///   it to be a candidate at all.
+/// @note Only the first candidate's `rawbuf` is safe to modify. They all
+///   share the same captured message. The hash (UNKNOWN) decoder is only
+///   a candidate if no other protocol matched.
+/// @note It's much slower than `decode()`, as it tries nearly every protocol.
+uint8_t IRrecv::decodeAll(decode_candidate_t *candidates,
+                          const uint8_t max_candidates, irparams_t *save,
+                          uint8_t max_skip, uint16_t noise_floor) {
+  if (candidates == NULL || max_candidates == 0) return 0;
+  decode_results *first = &candidates[0].result;
+  _scoring = true;
+  // The first one also does all the usual collecting of the message.
+  if (!decode(first, save, max_skip, noise_floor)) {
+    _scoring = false;
+    return 0;
+  }
+  _scoreCandidate(&candidates[0]);
+  uint8_t count = 1;
+  // N.B. Coalesced repeats have no capture to decode again.
+  if (first->decode_type != UNKNOWN && !first->repeats) {
+    // Hide each protocol once it has matched, and go again to find the next.
+    uint8_t protocols[kProtocolMaskSize];
+    for (uint8_t i = 0; i < kProtocolMaskSize; i++)
+      protocols[i] = _protocols[i];
+    const bool learning = _learning;
+    _learning = false;
+    _setProtocolBit(_protocols, UNKNOWN, false);  // The hash matches anything.
+    _setProtocolBit(_protocols, _attempting, false);
+    _setProtocolBit(_protocols, first->decode_type, false);
+    while (count < max_candidates) {
+      decode_results *next = &candidates[count].result;
+      *next = *first;  // The message is already filtered, so no noise_floor.
+      if (!_finishDecode(next, _decodeCapture(next, max_skip, 0))) break;
+      _scoreCandidate(&candidates[count++]);
+      _setProtocolBit(_protocols, _attempting, false);
+      _setProtocolBit(_protocols, next->decode_type, false);
+    }
+    for (uint8_t i = 0; i < kProtocolMaskSize; i++)
+      _protocols[i] = protocols[i];
+    _learning = learning;
+  }
+  _scoring = false;
+  // Most likely first. An insertion sort is fine for this few.
+  for (uint8_t i = 1; i < count; i++) {
+    const decode_candidate_t candidate = candidates[i];
+    uint8_t j = i;
+    for (; j > 0 && (candidates[j - 1].score < candidate.score ||
+                     (candidates[j - 1].score == candidate.score &&
+                      candidates[j - 1].result.bits < candidate.result.bits));
+         j--)
+      candidates[j] = candidates[j - 1];
+    candidates[j] = candidate;
+  }
+  return count;
+}
+
+/// Note how well a captured duration fitted what a protocol expected.
+/// @param[in] measured The captured duration.
+/// @param[in] low The shortest duration that would have matched.
+/// @param[in] high The longest duration that would have matched.
+/// @note All three must be in the same units.
+void IRrecv::_scoreFit(const uint32_t measured, const uint32_t low,
+                       const uint32_t high) {
+  if (!_fitting()) return;
+  const uint32_t half = (high - low) / 2;
+  const uint32_t middle = low + half;  // i.e. The nominal duration.
+  const uint32_t off = (measured > middle) ? measured - middle
+                                           : middle - measured;
+  if (_fit_used < UINT16_MAX) _fit_used++;
+  const uint8_t error = half ? std::min(off * 100 / half, (uint32_t)100) : 0;
+  _fit_error += error;
+#if ENABLE_SIGNAL_QUALITY
+  _fit_max = std::max(_fit_max, error);
+  if (error >= kNearTolerance && _fit_near < UINT16_MAX) _fit_near++;
+#endif  // ENABLE_SIGNAL_QUALITY
+}
+
+/// Note how well a data bit fitted what a protocol expected.
+/// @param[in] mark The captured mark of the bit. (ticks)
+/// @param[in] mark_window The window the mark matched.
+/// @param[in] space The captured space of the bit. (ticks)
+/// @param[in] space_window The window the space matched.
+void IRrecv::_fitBit(const uint16_t mark, const match_window_t *mark_window,
+                     const uint16_t space,
+                     const match_window_t *space_window) {
+  _scoreFit(mark, mark_window->low, mark_window->high);
+  _scoreFit(space, space_window->low, space_window->high);
+  if (_calibrating) {  // The middle of a window is the nominal duration.
+    _skewFit(mark * kRawTick,
+             (mark_window->low + mark_window->high) * kRawTick / 2, true);
+    _skewFit(space * kRawTick,
+             (space_window->low + space_window->high) * kRawTick / 2, false);
+  }
+}
+
+/// Note how much longer (or shorter) a captured mark or space was than what a
+/// protocol expected, as the sensor lag makes marks longer & spaces shorter.
+/// @param[in] measured The captured duration. (uSecs)
+/// @param[in] nominal What the protocol expected, including the excess in use.
+/// @param[in] mark Is it a mark? Otherwise, it is a space.
+void IRrecv::_skewFit(const uint32_t measured, const uint32_t nominal,
+                      const bool mark) {
+  const int32_t skew = (int32_t)measured - (int32_t)nominal;
+  _skew_sum += mark ? skew : -skew;
+  if (_skew_count < UINT16_MAX) _skew_count++;
+}
+
+/// Score how likely a successful decode is to be the right protocol.
+/// @param[in,out] candidate A PTR to the candidate to score.
+void IRrecv::_scoreCandidate(decode_candidate_t *candidate) {
+  // Don't count the dummy first entry.
+  const uint16_t entries = std::max(candidate->result.rawlen, (uint16_t)2) - 1;
+  const uint16_t used = std::min(_fit_used, entries);
+  candidate->coverage = (uint32_t)used * 100 / entries;
+  candidate->error = _fit_used ? _fit_error / _fit_used : 100;
+  // Mostly about how much of the message it explains, then how closely.
+  candidate->score = (candidate->coverage * 7 + (100 - candidate->error) * 3) /
+      10;
+}
 
-  // Clear the entry we are currently pointing to when we got the timeout.
-  // i.e. Stopped collecting IR data.
-  // It's junk as we never wrote an entry to it and can only confuse decoding.
-  // This is done here rather than logically the best place in read_timeout()
-  // as it saves a few bytes of ICACHE_RAM as that routine is bound to an
-  // interrupt. decode() is not stored in ICACHE_RAM.
-  // Another better option would be to zero the entire irparams.rawbuf[] on
-  // resume() but that is a much more expensive operation compare to this.
-  irparams.rawbuf[irparams.rawlen] = 0;
+/// Do the bookkeeping on the result of an attempt to decode a message.
+/// @param[in,out] results A PTR to where the decoded IR message was stored.
+///   If it was decoded, the time it was is recorded in it too.
+/// @param[in] success Was a message decoded?
+/// @return The value of `success`.
+bool IRrecv::_finishDecode(decode_results *results, const bool success) {
+  _profileFinish(success);  // The last attempt is the one that decoded it.
+#if ENABLE_DECODE_TRACE
+  if (success)
+    _traceEvent(kTraceDecoded, results->decode_type, results->bits);
+  else
+    _traceEvent(kTraceNotDecoded, UNKNOWN, 0);
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_CAPTURE_HASH
+  _capture_hashed = false;  // It's only for the message we just decoded.
+#endif  // ENABLE_CAPTURE_HASH
+  if (success) results->decoded = now_usecs();
+#if ENABLE_PARTIAL_DECODE
+  if (success && _trunc_pos) {  // Only report what was actually decoded.
+    results->bits = _trunc_pos * 8;
+    results->truncated = true;
+  }
+  _partial_ok = false;  // It's only for the capture we just decoded.
+  _trunc_pos = 0;
+#endif  // ENABLE_PARTIAL_DECODE
+#if ENABLE_SIGNAL_QUALITY
+  if (success && _quality && results->decode_type != UNKNOWN) {
+    results->quality.entries = _fit_used;
+    results->quality.mean = _fit_used ? _fit_error / _fit_used : 0;
+    results->quality.max = _fit_max;
+    results->quality.near = _fit_near;
+  }
+#endif  // ENABLE_SIGNAL_QUALITY
+  if (success && _calibrating) {  // Only trust what a protocol decoded.
+    _calibration_sum += _skew_sum;
+    _calibration_count += _skew_count;
+  }
+  if (success && _learning) {
+    // Both what we attempted, and what it was reported as. e.g. LG & LG2
+    _setProtocolBit(_learned, _attempting, true);
+    _setProtocolBit(_learned, results->decode_type, true);
+  }
+  return success;
+}
 
+/// Decodes the received IR message. i.e. The guts of `decode()`.
+/// @param[out] results A PTR to where the decoded IR message will be stored.
+/// @param[out] save A PTR to an irparams_t instance in which to save
+///   the interrupt's memory/state. NULL means don't save it.
+/// @param[in] max_skip Maximum Nr. of pulses at the begining of a capture we
+///   can skip when attempting to find a protocol we can successfully decode.
+/// @param[in] noise_floor Pulses below this size (in usecs) will be removed or
+///   merged prior to any decoding.
+/// @return A boolean indicating if an IR message is ready or not.
+/// @see decode()
+bool IRrecv::_decode(decode_results *results, irparams_t *save,
+                     uint8_t max_skip, uint16_t noise_floor) {
+#if ENABLE_BUDGETED_DECODE
+  if (_suspended) {  // Carry on with the capture a budget ran out on.
+    _suspended = false;
+    _resuming = true;
+    const bool success = _decodeFetched(results, _suspended_resumed,
+                                        max_skip, noise_floor);
+    _resuming = false;
+    return success;
+  }
+#endif  // ENABLE_BUDGETED_DECODE
   bool resumed = false;  // Flag indicating if we have resumed.
+#if ENABLE_CAPTURE_HASH
+  _capture_hashed = false;  // Until we know where the capture came from.
+#endif  // ENABLE_CAPTURE_HASH
 
   // If we were requested to use a save buffer previously, do so.
   if (save == NULL) save = irparams_save;
+#if ENABLE_CUSTOM_BACKENDS
+  if (_source != NULL) _source->poll(this);  // Collect anything it captured.
+#endif  // ENABLE_CUSTOM_BACKENDS
 
-  if (save == NULL) {
-    // We haven't been asked to copy it so use the existing memory.
+#if ENABLE_CAPTURE_RING
+  if (_params->slots) {  // Use the oldest completed capture in the ring.
+    if (!_ringFetch(results, save)) return false;
+    resumed = (save != NULL);
+#if ENABLE_CARRIER_FILTER
+    _carrier = 0;  // Only the RMT peripheral measures it, & it has no ring.
+#endif  // ENABLE_CARRIER_FILTER
+  } else {
+#else  // ENABLE_CAPTURE_RING
+  {
+#endif  // ENABLE_CAPTURE_RING
+    // Proceed only if an IR message been received.
+#if IRRECV_USE_RMT
+    if (_id < kMaxReceivers)  // Collect anything the RMT peripheral captured.
+      rmt_read(_id);
+#endif  // IRRECV_USE_RMT
 #ifndef UNIT_TEST
-    results->rawbuf = irparams.rawbuf;
-    results->rawlen = irparams.rawlen;
-    results->overflow = irparams.overflow;
+    if (_params->rcvstate != kStopState) return false;
 #endif
-  } else {
-    copyIrParams(&irparams, save);  // Duplicate the interrupt's memory.
-    resume();  // It's now safe to rearm. The IR message won't be overridden.
-    resumed = true;
-    // Point the results at the saved copy.
-    results->rawbuf = save->rawbuf;
-    results->rawlen = save->rawlen;
-    results->overflow = save->overflow;
+#if ENABLE_LARGE_CAPTURE
+    drainCapture();  // Whatever the drain task hasn't got to yet.
+    if (_small_bufsize) save = NULL;  // It's too big to copy. Use it in place.
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_CARRIER_FILTER
+    _carrier = _params->carrier;
+#endif  // ENABLE_CARRIER_FILTER
+#if ENABLE_COMPACT_CAPTURE
+    if (_params->packed != NULL) {  // Expand it into the save buffer.
+      _unpackCapture(save, _params->rawlen);
+      resume();  // It's now safe to rearm. The IR message won't be overridden.
+      results->rawbuf = save->rawbuf;
+      results->rawlen = save->rawlen;
+      results->overflow = save->overflow;
+      results->started = save->started;
+      results->stopped = save->stopped;
+#if ENABLE_REPEAT_COALESCING
+      if (_coalesceRepeat(results)) return false;  // Nothing more to do.
+#endif  // ENABLE_REPEAT_COALESCING
+      return _decodeCapture(results, max_skip, noise_floor);
+    }
+#endif  // ENABLE_COMPACT_CAPTURE
+
+    // Clear the entry we are currently pointing to when we got the timeout.
+    // i.e. Stopped collecting IR data.
+    // It's junk as we never wrote an entry to it and can only confuse decoding.
+    // This is done here rather than logically the best place in read_timeout()
+    // as it saves a few bytes of ICACHE_RAM as that routine is bound to an
+    // interrupt. decode() is not stored in ICACHE_RAM.
+    // Another better option would be to zero the entire _params->rawbuf[] on
+    // resume() but that is a much more expensive operation compare to this.
+    // A full buffer has no such entry.
+    if (_params->rawlen < _params->bufsize)
+      _params->rawbuf[_params->rawlen] = 0;
+
+    if (save == NULL) {
+      // We haven't been asked to copy it so use the existing memory.
+#ifndef UNIT_TEST
+      results->rawbuf = _params->rawbuf;
+      results->rawlen = _params->rawlen;
+      results->overflow = _params->overflow;
+      results->started = _params->started;
+      results->stopped = _params->stopped;
+#if ENABLE_CAPTURE_HASH
+      _capture_hash = _params->hash;
+      _capture_hashed = _params->hashed;
+#endif  // ENABLE_CAPTURE_HASH
+#endif
+    } else {
+      if (save == irparams_save)  // Our own save buffer is the same size.
+        swapIrParams(_params, save);  // So just trade buffers with the ISR.
+      else
+        copyIrParams(_params, save);  // Duplicate the interrupt's memory.
+      resume();  // It's now safe to rearm. The IR message won't be overridden.
+      resumed = true;
+      // Point the results at the saved copy.
+      results->rawbuf = save->rawbuf;
+      results->rawlen = save->rawlen;
+      results->overflow = save->overflow;
+      results->started = save->started;
+      results->stopped = save->stopped;
+#if ENABLE_CAPTURE_HASH
+      _capture_hash = save->hash;
+      _capture_hashed = save->hashed;
+#endif  // ENABLE_CAPTURE_HASH
+    }
   }
+  return _decodeFetched(results, resumed, max_skip, noise_floor);
+}
 
-  // Reset any previously partially processed results.
-  results->decode_type = UNKNOWN;
-  results->bits = 0;
-  results->value = 0;
-  results->address = 0;
-  results->command = 0;
-  results->repeat = false;
+/// Decode the capture `_decode()` has fetched, & let go of it if need be.
+/// @param[in,out] results A PTR to the capture. The decoded IR message will
+///   be stored here.
+/// @param[in] resumed Has capturing already been resumed? i.e. `results`
+///   points at a copy of the capture.
+/// @param[in] max_skip See `decode()`.
+/// @param[in] noise_floor See `decode()`.
+/// @return true, if a protocol decoded the message. Otherwise false.
+bool IRrecv::_decodeFetched(decode_results *results, const bool resumed,
+                            uint8_t max_skip, uint16_t noise_floor) {
+#if ENABLE_REPEAT_COALESCING
+#if ENABLE_BUDGETED_DECODE
+  if (!_resuming && _coalesceRepeat(results)) {  // Counted it. Not decoded.
+#else  // ENABLE_BUDGETED_DECODE
+  if (_coalesceRepeat(results)) {  // Counted it. No need to decode it.
+#endif  // ENABLE_BUDGETED_DECODE
+    if (!resumed) resume();
+    return false;
+  }
+#endif  // ENABLE_REPEAT_COALESCING
+  if (_decodeCapture(results, max_skip, noise_floor)) {
+#if ENABLE_PARTIAL_DECODE && ENABLE_CAPTURE_RING
+    if (_trunc_pos && _params->slots) _ringStitch(results);
+#endif  // ENABLE_PARTIAL_DECODE && ENABLE_CAPTURE_RING
+    return true;
+  }
+#if ENABLE_BUDGETED_DECODE
+  if (_suspended) {  // Keep the capture (& its ring slot) until it's done.
+    _suspended_resumed = resumed;
+    return false;
+  }
+#endif  // ENABLE_BUDGETED_DECODE
+  // Throw away and start over
+  if (!resumed)  // Check if we have already resumed.
+    resume();
+  return false;
+}
+
+/// Try each of the protocol decoders on a captured message.
+/// @param[in,out] results A PTR to the captured message. The decoded IR
+///   message will be stored here.
+/// @param[in] max_skip See `decode()`.
+/// @param[in] noise_floor See `decode()`.
+/// @return true, if a protocol decoded the message. Otherwise false.
+bool IRrecv::_decodeCapture(decode_results *results, uint8_t max_skip,
+                            uint16_t noise_floor) {
+#if ENABLE_DECODE_TRACE
+  _trace_offset = 0;
+  _traceEvent(kTraceCapture, UNKNOWN, results->rawlen);
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_DECODE_CACHE
+  if (_dcache == NULL) return _matchCapture(results, max_skip, noise_floor);
+  // Hashed before any noise filtering, so it is the same each time.
+#if ENABLE_CAPTURE_HASH
+  const uint32_t hash = _capture_hashed ? _capture_hash
+                                        : _hashCapture(results);
+#else  // ENABLE_CAPTURE_HASH
+  const uint32_t hash = _hashCapture(results);
+#endif  // ENABLE_CAPTURE_HASH
+  const uint16_t rawlen = results->rawlen;
+  uint8_t entry = 0;  // The matching entry, or the one to reuse if none do.
+  for (uint8_t i = 0; i < _dcache_size; i++) {
+    if (_dcache[i].rawlen == rawlen && _dcache[i].hash == hash) {
+      entry = i;
+      break;
+    }
+    if (_dcache[i].used < _dcache[entry].used) entry = i;  // Older/unused.
+  }
+  decode_cache_entry_t *cached = &_dcache[entry];
+  _dcache_clock++;
+#if ENABLE_BUDGETED_DECODE
+  // When resuming, it has already been tried.
+  if (cached->rawlen == rawlen && cached->hash == hash && !_resuming) {
+#else  // ENABLE_BUDGETED_DECODE
+  if (cached->rawlen == rawlen && cached->hash == hash) {
+#endif  // ENABLE_BUDGETED_DECODE
+    _dcache_only = true;  // Only attempt what decoded it last time.
+    _dcache_protocol = cached->protocol;
+    const bool success = _matchCapture(results, max_skip, noise_floor);
+    _dcache_only = false;
+    if (success) {
+      cached->used = _dcache_clock;
+      _dcache_hits++;
+      return true;
+    }
+  }
+  if (!_matchCapture(results, max_skip, noise_floor)) return false;
+  if (results->decode_type != UNKNOWN) {
+    cached->hash = hash;
+    cached->rawlen = rawlen;
+    cached->protocol = _attempting;  // e.g. LG, even if it was reported as LG2
+    cached->used = _dcache_clock;
+  }
+  return true;
+#else  // ENABLE_DECODE_CACHE
+  return _matchCapture(results, max_skip, noise_floor);
+#endif  // ENABLE_DECODE_CACHE
+}
+
+/// Try each of the protocol decoders on a captured message. See
+/// `_decodeCapture()`.
+/// @param[in,out] results A PTR to the captured message. The decoded IR
+///   message will be stored here.
+/// @param[in] max_skip See `decode()`.
+/// @param[in] noise_floor See `decode()`.
+/// @return true, if a protocol decoded the message. Otherwise false.
+bool IRrecv::_matchCapture(decode_results *results, uint8_t max_skip,
+                           uint16_t noise_floor) {
+#if ENABLE_FAMILY_MATCH_CACHE
+  // Protocol families may share their matches, but only for this capture, &
+  // only if nothing needs each protocol's own view of how well it matched.
+  _kaseikyo_offset = 0;
+  _sharp_offset = 0;
+  _family_cache = !_fitting();
+#if ENABLE_PROTOCOL_TOLERANCE
+  // Nor if they may be matched with different tolerances or mark excesses.
+  if (_protocol_tolerance_count) _family_cache = false;
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+#if ENABLE_PARTIAL_DECODE
+  if (_partial && results->overflow) _family_cache = false;
+#endif  // ENABLE_PARTIAL_DECODE
+  const bool success = _tryDecoders(results, max_skip, noise_floor);
+  _family_cache = false;  // The capture may change before it's used again.
+  return success;
+#else  // ENABLE_FAMILY_MATCH_CACHE
+  return _tryDecoders(results, max_skip, noise_floor);
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+}
+
+/// Try each of the protocol decoders on a captured message.
+/// @param[in,out] results A PTR to the captured message. The decoded IR
+///   message will be stored here.
+/// @param[in] max_skip See `decode()`.
+/// @param[in] noise_floor See `decode()`.
+/// @return true, if a protocol decoded the message. Otherwise false.
+bool IRrecv::_tryDecoders(decode_results *results, uint8_t max_skip,
+                          uint16_t noise_floor) {
+  uint16_t start = kStartOffset;
+  uint16_t first = 0;  // The first entry of kDecodeOrder to try at `start`.
+#if ENABLE_BUDGETED_DECODE
+  if (_resuming) {  // Carry on from where the budget ran out.
+    start = _resume_offset;
+    first = _resume_index;
+  } else {
+#else  // ENABLE_BUDGETED_DECODE
+  {
+#endif  // ENABLE_BUDGETED_DECODE
+    // Reset any previously partially processed results.
+    results->decode_type = UNKNOWN;
+    results->bits = 0;
+    results->value = 0;
+    results->address = 0;
+    results->command = 0;
+    results->repeat = false;
+    results->repeats = 0;
+    results->truncated = false;
+#if ENABLE_SIGNAL_QUALITY
+    results->quality.entries = 0;
+    results->quality.mean = 0;
+    results->quality.max = 0;
+    results->quality.near = 0;
+#endif  // ENABLE_SIGNAL_QUALITY
+#if ENABLE_PARTIAL_DECODE
+    _partial_ok = _partial && results->overflow;
+    _trunc_pos = 0;
+#endif  // ENABLE_PARTIAL_DECODE
 
 #if ENABLE_NOISE_FILTER_OPTION
-  crudeNoiseFilter(results, noise_floor);
+#if ENABLE_CAPTURE_HASH
+    if (noise_floor) _capture_hashed = false;  // The capture will change.
+#endif  // ENABLE_CAPTURE_HASH
+    crudeNoiseFilter(results, noise_floor);
 #endif  // ENABLE_NOISE_FILTER_OPTION
+#if DECODE_HASH
+    if (_hash_only) return _attempt(UNKNOWN) && decodeHash(results);
+#endif  // DECODE_HASH
+  }
   // Keep looking for protocols until we've run out of entries to skip or we
   // find a valid protocol message.
-  for (uint16_t offset = kStartOffset;
+  for (uint16_t offset = start;
        offset <= (max_skip * 2) + kStartOffset;
        offset += 2) {
+    uint16_t i = first;
+    first = 0;
+#if ENABLE_DECODE_TRACE
+    _trace_offset = offset;
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_LENGTH_DISPATCH
+    _entries = (offset < results->rawlen) ? results->rawlen - offset : 0;
+#endif  // ENABLE_LENGTH_DISPATCH
+#if ENABLE_HEADER_DISPATCH
+    _setHeaderWindow(offset < results->rawlen ? results->rawbuf[offset] : 0);
+    // Only bother with skipped offsets that look like the start of a message.
+    if (_smart_skip && offset > kStartOffset && !_isLikelyHeader()) continue;
+#endif  // ENABLE_HEADER_DISPATCH
+#if ENABLE_NEC_FAMILY_DISPATCH
+    _nec_sized = false;  // Size it up again, but only if something asks.
+#endif  // ENABLE_NEC_FAMILY_DISPATCH
+    for (; i < kDecodeOrderLength; i++) {
+      if (_tryProtocol((decode_type_t)kDecodeOrder[i], results, offset))
+        return true;
+#if ENABLE_BUDGETED_DECODE
+      if (_budgetSpent()) {  // Stop here, & carry on from the next one.
+        _resume_offset = offset;
+        _resume_index = i + 1;
+        _suspended = true;
+        return false;
+      }
+#endif  // ENABLE_BUDGETED_DECODE
+    }
+#if ENABLE_CUSTOM_PROTOCOLS
+    // Those registered at run time, after all of the built-in ones.
+    if (decodeCustom(results, offset)) return true;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  }
+#if DECODE_HASH
+  // decodeHash returns a hash on any input.
+  // Thus, it needs to be last in the list.
+  // If you add any decodes, add them before this.
+  if (_attempt(UNKNOWN) && decodeHash(results)) {
+    return true;
+  }
+#endif  // DECODE_HASH
+  return false;
+}
+
+/// Try the decoder(s) of a protocol on a captured message.
+/// @param[in] protocol The protocol to try. An entry of `kDecodeOrder`.
+/// @param[in,out] results A PTR to the captured message. The decoded IR
+///   message will be stored here.
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data.
+/// @return true, if the protocol decoded the message. Otherwise false.
+/// @note Protocols that are decoded together in one pass (e.g. SAMSUNG &
+///   SAMSUNG36) are tried via the case of the first of them.
+/// @note `tools/generate_decode_order.py` makes `kDecodeOrder` from the cases
+///   here, in the order they are in. Any precedence between them must also
+///   be added to that tool.
+bool IRrecv::_tryProtocol(const decode_type_t protocol,
+                          decode_results *results, const uint16_t offset) {
+  switch (protocol) {
 #if DECODE_AIWA_RC_T501
-    DPRINTLN("Attempting Aiwa RC T501 decode");
-    // Try decodeAiwaRCT501() before decodeSanyoLC7461() & decodeNEC()
-    // because the protocols are similar. This protocol is more specific than
-    // those ones, so should go before them.
-    if (decodeAiwaRCT501(results, offset)) return true;
+    case AIWA_RC_T501:
+      // Try decodeAiwaRCT501() before decodeSanyoLC7461() & decodeNEC()
+      // because the protocols are similar. This protocol is more specific than
+      // those ones, so should go before them.
+      if (_attempt(AIWA_RC_T501) && _headerMayMatch(kDispatchNecHdrMark) &&
+          _necFamilyMayMatch(results, offset, kNecFamilyAiwaRcT501Bits, 1) &&
+          decodeAiwaRCT501(results, offset)) return true;
+      break;
 #endif
 #if DECODE_SANYO
-    DPRINTLN("Attempting Sanyo LC7461 decode");
-    // Try decodeSanyoLC7461() before decodeNEC() because the protocols are
-    // similar in timings & structure, but the Sanyo one is much longer than the
-    // NEC protocol (42 vs 32 bits) so this one should be tried first to try to
-    // reduce false detection as a NEC packet.
-    if (decodeSanyoLC7461(results, offset)) return true;
+    case SANYO_LC7461:
+      // Try decodeSanyoLC7461() before decodeNEC() because the protocols are
+      // similar in timings & structure, but the Sanyo one is much longer than
+      // the NEC protocol (42 vs 32 bits) so this one should be tried first to
+      // try to reduce false detection as a NEC packet.
+      if (_attempt(SANYO_LC7461) && _headerMayMatch(kDispatchNecHdrMark) &&
+          _necFamilyMayMatch(results, offset, kSanyoLC7461Bits, 1) &&
+          decodeSanyoLC7461(results, offset)) return true;
+      break;
 #endif
 #if DECODE_CARRIER_AC
-    DPRINTLN("Attempting Carrier AC decode");
-    // Try decodeCarrierAC() before decodeNEC() because the protocols are
-    // similar in timings & structure, but the Carrier one is much longer than
-    // the NEC protocol (3x32 bits vs 1x32 bits) so this one should be tried
-    // first to try to reduce false detection as a NEC packet.
-    if (decodeCarrierAC(results, offset)) return true;
+    case CARRIER_AC:
+      // Try decodeCarrierAC() before decodeNEC() because the protocols are
+      // similar in timings & structure, but the Carrier one is much longer than
+      // the NEC protocol (3x32 bits vs 1x32 bits) so this one should be tried
+      // first to try to reduce false detection as a NEC packet.
+      if (_attempt(CARRIER_AC) && _headerMayMatch(kDispatchCarrierAcHdrMark) &&
+          _necFamilyMayMatch(results, offset, kCarrierAcBits,
+                             kNecFamilyCarrierAcBlocks) &&
+          decodeCarrierAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_PIONEER
-    DPRINTLN("Attempting Pioneer decode");
-    // Try decodePioneer() before decodeNEC() because the protocols are
-    // similar in timings & structure, but the Pioneer one is much longer than
-    // the NEC protocol (2x32 bits vs 1x32 bits) so this one should be tried
-    // first to try to reduce false detection as a NEC packet.
-    if (decodePioneer(results, offset)) return true;
+    case PIONEER:
+      // Try decodePioneer() before decodeNEC() because the protocols are
+      // similar in timings & structure, but the Pioneer one is much longer than
+      // the NEC protocol (2x32 bits vs 1x32 bits) so this one should be tried
+      // first to try to reduce false detection as a NEC packet.
+      if (_attempt(PIONEER) && _headerMayMatch(kDispatchPioneerHdrMark) &&
+          _necFamilyMayMatch(results, offset, kPioneerBits / 2,
+                             kNecFamilyPioneerBlocks) &&
+          decodePioneer(results, offset)) return true;
+      break;
 #endif
 #if DECODE_EPSON
-  DPRINTLN("Attempting Epson decode");
-  // Try decodeEpson() before decodeNEC() because the protocols are
-  // similar in timings & structure, but the Epson one is much longer than the
-  // NEC protocol (3x32 identical bits vs 1x32 bits) so this one should be tried
-  // first to try to reduce false detection as a NEC packet.
-  if (decodeEpson(results, offset)) return true;
+    case EPSON:
+      // Try decodeEpson() before decodeNEC() because the protocols are
+      // similar in timings & structure, but the Epson one is much longer than
+      // the NEC protocol (3x32 identical bits vs 1x32 bits) so this one should
+      // be tried first to try to reduce false detection as a NEC packet.
+      if (_attempt(EPSON) && _headerMayMatch(kDispatchNecHdrMark) &&
+          _necFamilyMayMatch(results, offset, kEpsonBits,
+                             kNecFamilyEpsonBlocks) &&
+          decodeEpson(results, offset)) return true;
+      break;
 #endif
 #if DECODE_NEC
-    DPRINTLN("Attempting NEC decode");
-    if (decodeNEC(results, offset)) return true;
+    case NEC:
+      if (_attempt(NEC) && _headerMayMatch(kDispatchNecHdrMark) &&
+          decodeNEC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_SONY
-    DPRINTLN("Attempting Sony decode");
-    if (decodeSony(results, offset)) return true;
+    case SONY:
+      if (_attempt(SONY) && _headerMayMatch(kDispatchSonyHdrMark) &&
+          decodeSony(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MITSUBISHI
-    DPRINTLN("Attempting Mitsubishi decode");
-    if (decodeMitsubishi(results, offset)) return true;
+    case MITSUBISHI:
+      // No header, so check the length before walking the bits.
+      if (_attempt(MITSUBISHI) &&
+          _countBits(results, offset) == kMitsubishiBits &&
+          decodeMitsubishi(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MITSUBISHI_AC
-    DPRINTLN("Attempting Mitsubishi AC decode");
-    if (decodeMitsubishiAC(results, offset)) return true;
+    case MITSUBISHI_AC:
+      if (_attempt(MITSUBISHI_AC) &&
+          decodeMitsubishiAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MITSUBISHI2
-    DPRINTLN("Attempting Mitsubishi2 decode");
-    if (decodeMitsubishi2(results, offset)) return true;
+    case MITSUBISHI2:
+      // Two halves of the same 16 bits as Mitsubishi, with a gap in the middle.
+      if (_attempt(MITSUBISHI2) &&
+          _headerMayMatch(kDispatchMitsubishi2HdrMark) &&
+          _countBits(results, offset + kHeader) == kMitsubishiBits / 2 &&
+          decodeMitsubishi2(results, offset)) return true;
+      break;
 #endif
 #if DECODE_RC5
-    DPRINTLN("Attempting RC5 decode");
-    if (decodeRC5(results, offset)) return true;
+    case RC5:
+      if (_attempt(RC5) && decodeRC5(results, offset)) return true;
+      break;
 #endif
 #if DECODE_RC6
-    DPRINTLN("Attempting RC6 decode");
-    if (decodeRC6(results, offset)) return true;
+    case RC6:
+      if (_attempt(RC6) && _headerMayMatch(kDispatchRc6HdrMark) &&
+          decodeRC6(results, offset)) return true;
+      break;
 #endif
 #if DECODE_RCMM
-    DPRINTLN("Attempting RC-MM decode");
-    if (decodeRCMM(results, offset)) return true;
+    case RCMM:
+      if (_attempt(RCMM) && _headerMayMatch(kDispatchRcmmHdrMark) &&
+          decodeRCMM(results, offset)) return true;
+      break;
 #endif
 #if DECODE_FUJITSU_AC
-    // Fujitsu A/C needs to precede Panasonic and Denon as it has a short
-    // message which looks exactly the same as a Panasonic/Denon message.
-    DPRINTLN("Attempting Fujitsu A/C decode");
-    if (decodeFujitsuAC(results, offset)) return true;
+    case FUJITSU_AC:
+      // Fujitsu A/C needs to precede Panasonic and Denon as it has a short
+      // message which looks exactly the same as a Panasonic/Denon message.
+      if (_attempt(FUJITSU_AC) && _headerMayMatch(kDispatchFujitsuAcHdrMark) &&
+          decodeFujitsuAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_DENON
-    // Denon needs to precede Panasonic as it is a special case of Panasonic.
-    DPRINTLN("Attempting Denon decode");
-    if (decodeDenon(results, offset, kDenon48Bits) ||
-        decodeDenon(results, offset, kDenonBits) ||
-        decodeDenon(results, offset, kDenonLegacyBits))
-      return true;
+    case DENON:
+      // Denon needs to precede Panasonic as it is a special case of Panasonic.
+      // Both share the one Kaseikyo match, & Sharp shares Denon's Sharp match.
+      // i.e. They only differ by their manufacturer code & expansion bit.
+      if (_attempt(DENON) &&
+          (decodeDenon(results, offset, kDenon48Bits) ||
+           decodeDenon(results, offset, kDenonBits) ||
+           decodeDenon(results, offset, kDenonLegacyBits)))
+        return true;
+      break;
 #endif
 #if DECODE_PANASONIC
-    DPRINTLN("Attempting Panasonic decode");
-    if (decodePanasonic(results, offset)) return true;
+    case PANASONIC:
+      if (_attempt(PANASONIC) && _headerMayMatch(kDispatchPanasonicHdrMark) &&
+          decodePanasonic(results, offset)) return true;
+      break;
 #endif
 #if DECODE_LG
-    DPRINTLN("Attempting LG (28-bit) decode");
-    if (decodeLG(results, offset, kLgBits, true)) return true;
-    DPRINTLN("Attempting LG (32-bit) decode");
-    // LG32 should be tried before Samsung
-    if (decodeLG(results, offset, kLg32Bits, true)) return true;
+    case LG:
+      // LG32 should be tried before Samsung.
+      // The header is the same length for LG (28-bit) & LG32 (32-bit), so count
+      // the bits once & only decode the variant it can be.
+      if (_attempt(LG)) {
+        const uint16_t lgbits = _countBits(results, offset + kHeader);
+        if ((lgbits == kLgBits || lgbits == kLg32Bits) &&
+            decodeLG(results, offset, lgbits, true)) return true;
+      }
+      break;
 #endif
 #if DECODE_GICABLE
-    // Note: Needs to happen before JVC decode, because it looks similar except
-    //       with a required NEC-like repeat code.
-    DPRINTLN("Attempting GICable decode");
-    if (decodeGICable(results, offset)) return true;
+    case GICABLE:
+      // Note: Needs to happen before JVC decode, because it looks similar
+      //       except with a required NEC-like repeat code.
+      if (_attempt(GICABLE) && _headerMayMatch(kDispatchGicableHdrMark) &&
+          decodeGICable(results, offset)) return true;
+      break;
 #endif
 #if DECODE_JVC
-    DPRINTLN("Attempting JVC decode");
-    if (decodeJVC(results, offset)) return true;
+    case JVC:
+      if (_attempt(JVC) && decodeJVC(results, offset)) return true;
+      break;
 #endif
+#if (DECODE_SAMSUNG || DECODE_SAMSUNG36)
+    case SAMSUNG:
+      // Samsung & Samsung36 have near identical headers, but the first section
+      // of a Samsung36 message is only 16 bits long. Count them once to pick.
+      if (_headerMayMatch(kDispatchSamsungHdrMark) ||
+          _headerMayMatch(kDispatchSamsung36HdrMark)) {
+        const uint16_t samsungbits = _countBits(results, offset + kHeader);
 #if DECODE_SAMSUNG
-    DPRINTLN("Attempting SAMSUNG decode");
-    if (decodeSAMSUNG(results, offset)) return true;
-#endif
+        if (samsungbits == kSamsungBits && _attempt(SAMSUNG) &&
+            _headerMayMatch(kDispatchSamsungHdrMark) &&
+            decodeSAMSUNG(results, offset)) return true;
+#endif  // DECODE_SAMSUNG
 #if DECODE_SAMSUNG36
-    DPRINTLN("Attempting Samsung36 decode");
-    if (decodeSamsung36(results, offset)) return true;
-#endif
+        if (samsungbits == 16 && _attempt(SAMSUNG36) &&
+            _headerMayMatch(kDispatchSamsung36HdrMark) &&
+            decodeSamsung36(results, offset)) return true;
+#endif  // DECODE_SAMSUNG36
+      }
+      break;
+#endif  // (DECODE_SAMSUNG || DECODE_SAMSUNG36)
 #if DECODE_WHYNTER
-    DPRINTLN("Attempting Whynter decode");
-    if (decodeWhynter(results, offset)) return true;
+    case WHYNTER:
+      if (_attempt(WHYNTER) && _headerMayMatch(kDispatchWhynterBitMark) &&
+          decodeWhynter(results, offset)) return true;
+      break;
 #endif
 #if DECODE_DISH
-    DPRINTLN("Attempting DISH decode");
-    if (decodeDISH(results, offset)) return true;
+    case DISH:
+      if (_attempt(DISH) && _headerMayMatch(kDispatchDishHdrMark) &&
+          decodeDISH(results, offset)) return true;
+      break;
 #endif
 #if DECODE_SHARP
-    DPRINTLN("Attempting Sharp decode");
-    if (decodeSharp(results, offset)) return true;
+    case SHARP:
+      if (_attempt(SHARP) && decodeSharp(results, offset)) return true;
+      break;
 #endif
 #if DECODE_COOLIX
-    DPRINTLN("Attempting Coolix decode");
-    if (decodeCOOLIX(results, offset)) return true;
+    case COOLIX:
+      if (_attempt(COOLIX) && _headerMayMatch(kDispatchCoolixHdrMark) &&
+          decodeCOOLIX(results, offset)) return true;
+      break;
 #endif
 #if DECODE_NIKAI
-    DPRINTLN("Attempting Nikai decode");
-    if (decodeNikai(results, offset)) return true;
+    case NIKAI:
+      if (_attempt(NIKAI) && _headerMayMatch(kDispatchNikaiHdrMark) &&
+          decodeNikai(results, offset)) return true;
+      break;
 #endif
-#if DECODE_KELVINATOR
-    // Kelvinator based-devices use a similar code to Gree ones, to avoid false
-    // matches this needs to happen before decodeGree().
-    DPRINTLN("Attempting Kelvinator decode");
-    if (decodeKelvinator(results, offset)) return true;
+#if (DECODE_GREE || DECODE_KELVINATOR)
+    case KELVINATOR:
+      // Kelvinator based-devices use the same frames as Gree ones. One pass
+      // decodes both, telling them apart by whether a second frame follows.
+      if (_headerMayMatch(kDispatchKelvinatorHdrMark)) {
+        const bool kelvinator = DECODE_KELVINATOR && _attempt(KELVINATOR);
+        const bool gree = DECODE_GREE && _attempt(GREE);
+        if (decodeGreeFamily(results, offset, gree, kelvinator)) return true;
+      }
+      break;
 #endif
 #if DECODE_DAIKIN
-    DPRINTLN("Attempting Daikin decode");
-    if (decodeDaikin(results, offset)) return true;
+    case DAIKIN:
+      if (_attempt(DAIKIN) && decodeDaikin(results, offset)) return true;
+      break;
 #endif
 #if DECODE_DAIKIN2
-    DPRINTLN("Attempting Daikin2 decode");
-    if (decodeDaikin2(results, offset)) return true;
+    case DAIKIN2:
+      if (_attempt(DAIKIN2) && decodeDaikin2(results, offset)) return true;
+      break;
 #endif
 #if DECODE_DAIKIN216
-    DPRINTLN("Attempting Daikin216 decode");
-    if (decodeDaikin216(results, offset)) return true;
+    case DAIKIN216:
+      if (_attempt(DAIKIN216) && _headerMayMatch(kDispatchDaikin216HdrMark) &&
+          decodeDaikin216(results, offset)) return true;
+      break;
 #endif
 #if DECODE_TOSHIBA_AC
-    DPRINTLN("Attempting Toshiba AC 72bit decode");
-    if (decodeToshibaAC(results, offset)) return true;
-    DPRINTLN("Attempting Toshiba AC 80bit decode");
-    if (decodeToshibaAC(results, offset, kToshibaACBitsLong)) return true;
-    DPRINTLN("Attempting Toshiba AC 56bit decode");
-    if (decodeToshibaAC(results, offset, kToshibaACBitsShort)) return true;
+    case TOSHIBA_AC:
+      // Handles all the message sizes in one pass via the length byte.
+      if (_attempt(TOSHIBA_AC) && _headerMayMatch(kDispatchToshibaAcHdrMark) &&
+          decodeToshibaAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MIDEA
-    DPRINTLN("Attempting Midea decode");
-    if (decodeMidea(results, offset)) return true;
+    case MIDEA:
+      if (_attempt(MIDEA) && _headerMayMatch(kDispatchMideaHdrMark) &&
+          decodeMidea(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MAGIQUEST
-    DPRINTLN("Attempting Magiquest decode");
-    if (decodeMagiQuest(results, offset)) return true;
+    case MAGIQUEST:
+      if (_attempt(MAGIQUEST) && decodeMagiQuest(results, offset)) return true;
+      break;
 #endif
   /* NOTE: Disabled due to poor quality.
 #if DECODE_SANYO
     // The Sanyo S866500B decoder is very poor quality & depricated.
     // *IF* you are going to enable it, do it near last to avoid false positive
     // matches.
-    DPRINTLN("Attempting Sanyo SA8650B decode");
-    if (decodeSanyo(results, offset))
+    if (_attempt(SANYO) && decodeSanyo(results, offset))
       return true;
 #endif
   */
 #if DECODE_NEC
-    // Some devices send NEC-like codes that don't follow the true NEC spec.
-    // This should detect those. e.g. Apple TV remote etc.
-    // This needs to be done after all other codes that use strict and some
-    // other protocols that are NEC-like as well, as turning off strict may
-    // cause this to match other valid protocols.
-    DPRINTLN("Attempting NEC (non-strict) decode");
-    if (decodeNEC(results, offset, kNECBits, false)) {
-      results->decode_type = NEC_LIKE;
-      return true;
-    }
+    case NEC_LIKE:
+      // Some devices send NEC-like codes that don't follow the true NEC spec.
+      // This should detect those. e.g. Apple TV remote etc.
+      // This needs to be done after all other codes that use strict and some
+      // other protocols that are NEC-like as well, as turning off strict may
+      // cause this to match other valid protocols.
+      if (_attempt(NEC_LIKE) && _headerMayMatch(kDispatchNecHdrMark) &&
+          decodeNEC(results, offset, kNECBits, false)) {
+        results->decode_type = NEC_LIKE;
+        return true;
+      }
+      break;
 #endif
 #if DECODE_LASERTAG
-    DPRINTLN("Attempting Lasertag decode");
-    if (decodeLasertag(results, offset)) return true;
-#endif
-#if DECODE_GREE
-    // Gree based-devices use a similar code to Kelvinator ones, to avoid false
-    // matches this needs to happen after decodeKelvinator().
-    DPRINTLN("Attempting Gree decode");
-    if (decodeGree(results, offset)) return true;
+    case LASERTAG:
+      if (_attempt(LASERTAG) && decodeLasertag(results, offset)) return true;
+      break;
 #endif
 #if DECODE_HAIER_AC
-    DPRINTLN("Attempting Haier AC decode");
-    if (decodeHaierAC(results, offset)) return true;
+    case HAIER_AC:
+      if (_attempt(HAIER_AC) && _headerMayMatch(kDispatchHaierAcHdr) &&
+          decodeHaierAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_HAIER_AC_YRW02
-    DPRINTLN("Attempting Haier AC YR-W02 decode");
-    if (decodeHaierACYRW02(results, offset)) return true;
+    case HAIER_AC_YRW02:
+      if (_attempt(HAIER_AC_YRW02) && _headerMayMatch(kDispatchHaierAcHdr) &&
+          decodeHaierACYRW02(results, offset)) return true;
+      break;
 #endif
 #if DECODE_HITACHI_AC424
-    // HitachiAc424 should be checked before HitachiAC, HitachiAC2,
-    // & HitachiAC184
-    DPRINTLN("Attempting Hitachi AC 424 decode");
-    if (decodeHitachiAc424(results, offset, kHitachiAc424Bits)) return true;
+    case HITACHI_AC424:
+      // HitachiAc424 should be checked before HitachiAC, HitachiAC2,
+      // & HitachiAC184
+      if (_attempt(HITACHI_AC424) &&
+          _headerMayMatch(kDispatchHitachiAc424LdrMark) &&
+          decodeHitachiAc424(results, offset, kHitachiAc424Bits)) return true;
+      break;
 #endif  // DECODE_HITACHI_AC424
 #if DECODE_MITSUBISHI136
-    // Needs to happen before HitachiAc3 decode.
-    DPRINTLN("Attempting Mitsubishi136 decode");
-    if (decodeMitsubishi136(results, offset)) return true;
+    case MITSUBISHI136:
+      // Needs to happen before HitachiAc3 decode.
+      if (_attempt(MITSUBISHI136) &&
+          _headerMayMatch(kDispatchMitsubishi136HdrMark) &&
+          decodeMitsubishi136(results, offset)) return true;
+      break;
 #endif  // DECODE_MITSUBISHI136
+#if (DECODE_HITACHI_AC || DECODE_HITACHI_AC2 || DECODE_HITACHI_AC3 || \
+     DECODE_HITACHI_AC344)
+    case HITACHI_AC3:
+      // HitachiAc3, HitachiAC344, HitachiAC2 & HitachiAC have near identical
+      // headers & timings. They differ in length, so count the bits once & only
+      // decode the one it can be.
+      if (_headerMayMatch(kDispatchHitachiAcHdrMark) ||
+          _headerMayMatch(kDispatchHitachiAc3HdrMark)) {
+        const uint16_t hitachibits = _countBits(results, offset + kHeader);
+        switch (hitachibits) {
 #if DECODE_HITACHI_AC3
-    // HitachiAc3 should be checked before HitachiAC & HitachiAC2
-    // Attempt normal before the short version.
-    DPRINTLN("Attempting Hitachi AC3 decode");
-    // Order these in decreasing bit size, as it is more optimal.
-    if (decodeHitachiAc3(results, offset, kHitachiAc3Bits) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3Bits - 4 * 8) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3Bits - 6 * 8) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3MinBits + 2 * 8) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3MinBits))
-      return true;
+          case kHitachiAc3MinBits:  // Cancel Timer (Min Size)
+          case kHitachiAc3MinBits + 2 * 8:  // Change Temp
+          case kHitachiAc3Bits - 6 * 8:  // Change Mode
+          case kHitachiAc3Bits - 4 * 8:  // Normal
+          case kHitachiAc3Bits:  // Set Temp (Max Size)
+            if (_attempt(HITACHI_AC3) &&
+                _headerMayMatch(kDispatchHitachiAc3HdrMark) &&
+                decodeHitachiAc3(results, offset, hitachibits)) return true;
+            break;
 #endif  // DECODE_HITACHI_AC3
 #if DECODE_HITACHI_AC344
-    // HitachiAC344 should be checked before HitachiAC
-    DPRINTLN("Attempting Hitachi AC344 decode");
-    if (decodeHitachiAC(results, offset, kHitachiAc344Bits, true, false))
-      return true;
+          case kHitachiAc344Bits:
+            if (_attempt(HITACHI_AC344) &&
+                _headerMayMatch(kDispatchHitachiAcHdrMark) &&
+                decodeHitachiAC(results, offset, kHitachiAc344Bits, true,
+                                false))
+              return true;
+            break;
 #endif  // DECODE_HITACHI_AC344
 #if DECODE_HITACHI_AC2
-    // HitachiAC2 should be checked before HitachiAC
-    DPRINTLN("Attempting Hitachi AC2 decode");
-    if (decodeHitachiAC(results, offset, kHitachiAc2Bits)) return true;
+          case kHitachiAc2Bits:
+            if (_attempt(HITACHI_AC2) &&
+                _headerMayMatch(kDispatchHitachiAcHdrMark) &&
+                decodeHitachiAC(results, offset, kHitachiAc2Bits)) return true;
+            break;
 #endif  // DECODE_HITACHI_AC2
 #if DECODE_HITACHI_AC
-    DPRINTLN("Attempting Hitachi AC decode");
-    if (decodeHitachiAC(results, offset, kHitachiAcBits)) return true;
-#endif
+          case kHitachiAcBits:
+            if (_attempt(HITACHI_AC) &&
+                _headerMayMatch(kDispatchHitachiAcHdrMark) &&
+                decodeHitachiAC(results, offset, kHitachiAcBits)) return true;
+            break;
+#endif  // DECODE_HITACHI_AC
+          default:
+            break;
+        }
+      }
+      break;
+#endif  // (DECODE_HITACHI_AC || DECODE_HITACHI_AC2 || DECODE_HITACHI_AC3 ||
+        //  DECODE_HITACHI_AC344)
 #if DECODE_HITACHI_AC1
-    DPRINTLN("Attempting Hitachi AC1 decode");
-    if (decodeHitachiAC(results, offset, kHitachiAc1Bits)) return true;
+    case HITACHI_AC1:
+      if (_attempt(HITACHI_AC1) &&
+          _headerMayMatch(kDispatchHitachiAc1HdrMark) &&
+          decodeHitachiAC(results, offset, kHitachiAc1Bits)) return true;
+      break;
 #endif
 #if DECODE_WHIRLPOOL_AC
-    DPRINTLN("Attempting Whirlpool AC decode");
-    if (decodeWhirlpoolAC(results, offset)) return true;
+    case WHIRLPOOL_AC:
+      if (_attempt(WHIRLPOOL_AC) &&
+          _headerMayMatch(kDispatchWhirlpoolAcHdrMark) &&
+          decodeWhirlpoolAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_SAMSUNG_AC
-    DPRINTLN("Attempting Samsung AC (extended) decode");
-    // Check the extended size first, as it should fail fast due to longer
-    // length.
-    if (decodeSamsungAC(results, offset, kSamsungAcExtendedBits, false))
-      return true;
-    // Now check for the more common length.
-    DPRINTLN("Attempting Samsung AC decode");
-    if (decodeSamsungAC(results, offset, kSamsungAcBits)) return true;
+    case SAMSUNG_AC:
+      // Handles both the normal & extended sizes in one pass.
+      if (_attempt(SAMSUNG_AC) && _headerMayMatch(kDispatchSamsungAcBitMark) &&
+          decodeSamsungAC(results, offset, kSamsungAcBits)) return true;
+      break;
 #endif
 #if DECODE_ELECTRA_AC
-    DPRINTLN("Attempting Electra AC decode");
-    if (decodeElectraAC(results, offset)) return true;
+    case ELECTRA_AC:
+      if (_attempt(ELECTRA_AC) && _headerMayMatch(kDispatchElectraAcHdrMark) &&
+          decodeElectraAC(results, offset)) return true;
+      break;
 #endif
 #if DECODE_PANASONIC_AC
-    DPRINTLN("Attempting Panasonic AC decode");
-    if (decodePanasonicAC(results, offset)) return true;
-    DPRINTLN("Attempting Panasonic AC short decode");
-    if (decodePanasonicAC(results, offset, kPanasonicAcShortBits)) return true;
+    case PANASONIC_AC:
+      if (_attempt(PANASONIC_AC) &&
+          _headerMayMatch(kDispatchPanasonicHdrMark) &&
+          decodePanasonicAC(results, offset)) return true;
+      if (_attempt(PANASONIC_AC) &&
+          _headerMayMatch(kDispatchPanasonicHdrMark) &&
+          decodePanasonicAC(results, offset, kPanasonicAcShortBits))
+        return true;
+      break;
 #endif
 #if DECODE_LUTRON
-    DPRINTLN("Attempting Lutron decode");
-    if (decodeLutron(results, offset)) return true;
+    case LUTRON:
+      if (_attempt(LUTRON) && decodeLutron(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MWM
-    DPRINTLN("Attempting MWM decode");
-    if (decodeMWM(results, offset)) return true;
+    case MWM:
+      if (_attempt(MWM) && decodeMWM(results, offset)) return true;
+      break;
 #endif
 #if DECODE_VESTEL_AC
-    DPRINTLN("Attempting Vestel AC decode");
-    if (decodeVestelAc(results, offset)) return true;
+    case VESTEL_AC:
+      if (_attempt(VESTEL_AC) && _headerMayMatch(kDispatchVestelAcHdrMark) &&
+          decodeVestelAc(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MITSUBISHI112 || DECODE_TCL112AC
-    // Mitsubish112 and Tcl112 share the same decoder.
-    DPRINTLN("Attempting Mitsubishi112/TCL112AC decode");
-    if (decodeMitsubishi112(results, offset)) return true;
+    case MITSUBISHI112:
+      // Mitsubish112 and Tcl112 share the same decoder.
+      if (_attempt(MITSUBISHI112) &&
+          decodeMitsubishi112(results, offset)) return true;
+      break;
 #endif  // DECODE_MITSUBISHI112 || DECODE_TCL112AC
 #if DECODE_TECO
-    DPRINTLN("Attempting Teco decode");
-    if (decodeTeco(results, offset)) return true;
+    case TECO:
+      if (_attempt(TECO) && _headerMayMatch(kDispatchTecoHdrMark) &&
+          decodeTeco(results, offset)) return true;
+      break;
 #endif
 #if DECODE_LEGOPF
-    DPRINTLN("Attempting LEGOPF decode");
-    if (decodeLegoPf(results, offset)) return true;
+    case LEGOPF:
+      if (_attempt(LEGOPF) && _headerMayMatch(kDispatchLegoPfBitMark) &&
+          decodeLegoPf(results, offset)) return true;
+      break;
 #endif
 #if DECODE_MITSUBISHIHEAVY
-    DPRINTLN("Attempting MITSUBISHIHEAVY (152 bit) decode");
-    if (decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy152Bits))
-      return true;
-    DPRINTLN("Attempting MITSUBISHIHEAVY (88 bit) decode");
-    if (decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy88Bits))
-      return true;
+    case MITSUBISHI_HEAVY_152:
+      // The 152 & 88 bit variants share a header & timings, so count the bits
+      // once & only decode the one it can be.
+      if (_headerMayMatch(kDispatchMitsubishiHeavyHdrMark)) {
+        switch (_countBits(results, offset + kHeader)) {
+          case kMitsubishiHeavy152Bits:
+            if (_attempt(MITSUBISHI_HEAVY_152) &&
+                decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy152Bits))
+              return true;
+            break;
+          case kMitsubishiHeavy88Bits:
+            if (_attempt(MITSUBISHI_HEAVY_88) &&
+                decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy88Bits))
+              return true;
+            break;
+        }
+      }
+      break;
 #endif
 #if DECODE_ARGO
-    DPRINTLN("Attempting Argo decode");
-    if (decodeArgo(results, offset)) return true;
+    case ARGO:
+      if (_attempt(ARGO) && _headerMayMatch(kDispatchArgoHdrMark) &&
+          decodeArgo(results, offset)) return true;
+      break;
 #endif  // DECODE_ARGO
 #if DECODE_SHARP_AC
-    DPRINTLN("Attempting SHARP_AC decode");
-    if (decodeSharpAc(results, offset)) return true;
+    case SHARP_AC:
+      if (_attempt(SHARP_AC) && _headerMayMatch(kDispatchSharpAcHdrMark) &&
+          decodeSharpAc(results, offset)) return true;
+      break;
 #endif
 #if DECODE_GOODWEATHER
-    DPRINTLN("Attempting GOODWEATHER decode");
-    if (decodeGoodweather(results, offset)) return true;
+    case GOODWEATHER:
+      if (_attempt(GOODWEATHER) &&
+          _headerMayMatch(kDispatchGoodweatherHdrMark) &&
+          decodeGoodweather(results, offset)) return true;
+      break;
 #endif  // DECODE_GOODWEATHER
 #if DECODE_INAX
-    DPRINTLN("Attempting Inax decode");
-    if (decodeInax(results, offset)) return true;
+    case INAX:
+      if (_attempt(INAX) && _headerMayMatch(kDispatchInaxHdrMark) &&
+          decodeInax(results, offset)) return true;
+      break;
 #endif  // DECODE_INAX
 #if DECODE_TROTEC
-    DPRINTLN("Attempting Trotec decode");
-    if (decodeTrotec(results, offset)) return true;
+    case TROTEC:
+      if (_attempt(TROTEC) && _headerMayMatch(kDispatchTrotecHdrMark) &&
+          decodeTrotec(results, offset)) return true;
+      break;
 #endif  // DECODE_TROTEC
 #if DECODE_DAIKIN160
-    DPRINTLN("Attempting Daikin160 decode");
-    if (decodeDaikin160(results, offset)) return true;
+    case DAIKIN160:
+      if (_attempt(DAIKIN160) && _headerMayMatch(kDispatchDaikin160HdrMark) &&
+          decodeDaikin160(results, offset)) return true;
+      break;
 #endif  // DECODE_DAIKIN160
 #if DECODE_NEOCLIMA
-    DPRINTLN("Attempting Neoclima decode");
-    if (decodeNeoclima(results, offset)) return true;
+    case NEOCLIMA:
+      if (_attempt(NEOCLIMA) && _headerMayMatch(kDispatchNeoclimaHdrMark) &&
+          decodeNeoclima(results, offset)) return true;
+      break;
 #endif  // DECODE_NEOCLIMA
 #if DECODE_DAIKIN176
-    DPRINTLN("Attempting Daikin176 decode");
-    if (decodeDaikin176(results, offset)) return true;
+    case DAIKIN176:
+      if (_attempt(DAIKIN176) && _headerMayMatch(kDispatchDaikin176HdrMark) &&
+          decodeDaikin176(results, offset)) return true;
+      break;
 #endif  // DECODE_DAIKIN176
 #if DECODE_DAIKIN128
-    DPRINTLN("Attempting Daikin128 decode");
-    if (decodeDaikin128(results, offset)) return true;
+    case DAIKIN128:
+      if (_attempt(DAIKIN128) && decodeDaikin128(results, offset)) return true;
+      break;
 #endif  // DECODE_DAIKIN128
 #if DECODE_AMCOR
-    DPRINTLN("Attempting Amcor decode");
-    if (decodeAmcor(results, offset)) return true;
+    case AMCOR:
+      if (_attempt(AMCOR) && _headerMayMatch(kDispatchAmcorHdrMark) &&
+          decodeAmcor(results, offset)) return true;
+      break;
 #endif  // DECODE_AMCOR
 #if DECODE_DAIKIN152
-    DPRINTLN("Attempting Daikin152 decode");
-    if (decodeDaikin152(results, offset)) return true;
+    case DAIKIN152:
+      if (_attempt(DAIKIN152) && decodeDaikin152(results, offset)) return true;
+      break;
 #endif  // DECODE_DAIKIN152
 #if DECODE_SYMPHONY
-    DPRINTLN("Attempting Symphony decode");
-    if (decodeSymphony(results, offset)) return true;
+    case SYMPHONY:
+      if (_attempt(SYMPHONY) && decodeSymphony(results, offset)) return true;
+      break;
 #endif  // DECODE_SYMPHONY
 #if DECODE_DAIKIN64
-    DPRINTLN("Attempting Daikin64 decode");
-    if (decodeDaikin64(results, offset)) return true;
+    case DAIKIN64:
+      if (_attempt(DAIKIN64) && decodeDaikin64(results, offset)) return true;
+      break;
 #endif  // DECODE_DAIKIN64
 #if DECODE_AIRWELL
-    DPRINTLN("Attempting Airwell decode");
-    if (decodeAirwell(results, offset)) return true;
+    case AIRWELL:
+      if (_attempt(AIRWELL) && decodeAirwell(results, offset)) return true;
+      break;
 #endif  // DECODE_AIRWELL
 #if DECODE_DELONGHI_AC
-    DPRINTLN("Attempting Delonghi AC decode");
-    if (decodeDelonghiAc(results, offset)) return true;
+    case DELONGHI_AC:
+      if (_attempt(DELONGHI_AC) &&
+          _headerMayMatch(kDispatchDelonghiAcHdrMark) &&
+          decodeDelonghiAc(results, offset)) return true;
+      break;
 #endif  // DECODE_DELONGHI_AC
 #if DECODE_DOSHISHA
-    DPRINTLN("Attempting Doshisha decode");
-    if (decodeDoshisha(results, offset)) return true;
+    case DOSHISHA:
+      if (_attempt(DOSHISHA) && _headerMayMatch(kDispatchDoshishaHdrMark) &&
+          decodeDoshisha(results, offset)) return true;
+      break;
 #endif  // DECODE_DOSHISHA
 #if DECODE_MULTIBRACKETS
-    DPRINTLN("Attempting Multibrackets decode");
-    if (decodeMultibrackets(results, offset)) return true;
+    case MULTIBRACKETS:
+      if (_attempt(MULTIBRACKETS) &&
+          decodeMultibrackets(results, offset)) return true;
+      break;
 #endif  // DECODE_MULTIBRACKETS
 #if DECODE_CARRIER_AC40
-    DPRINTLN("Attempting Carrier 40bit decode");
-    if (decodeCarrierAC40(results, offset)) return true;
+    case CARRIER_AC40:
+      if (_attempt(CARRIER_AC40) &&
+          _headerMayMatch(kDispatchCarrierAc40HdrMark) &&
+          decodeCarrierAC40(results, offset)) return true;
+      break;
 #endif  // DECODE_CARRIER_AC40
 #if DECODE_CARRIER_AC64
-    DPRINTLN("Attempting Carrier 64bit decode");
-    if (decodeCarrierAC64(results, offset)) return true;
+    case CARRIER_AC64:
+      if (_attempt(CARRIER_AC64) &&
+          _headerMayMatch(kDispatchCarrierAc64HdrMark) &&
+          decodeCarrierAC64(results, offset)) return true;
+      break;
 #endif  // DECODE_CARRIER_AC64
 #if DECODE_TECHNIBEL_AC
-    DPRINTLN("Attempting Technibel AC decode");
-    if (decodeTechnibelAc(results, offset)) return true;
+    case TECHNIBEL_AC:
+      if (_attempt(TECHNIBEL_AC) &&
+          _headerMayMatch(kDispatchTechnibelAcHdrMark) &&
+          decodeTechnibelAc(results, offset)) return true;
+      break;
 #endif  // DECODE_TECHNIBEL_AC
 #if DECODE_CORONA_AC
-    DPRINTLN("Attempting CoronaAc decode");
-    if (decodeCoronaAc(results, offset)) return true;
+    case CORONA_AC:
+      if (_attempt(CORONA_AC) && _headerMayMatch(kDispatchCoronaAcHdrMark) &&
+          decodeCoronaAc(results, offset)) return true;
+      break;
 #endif  // DECODE_CORONA_AC
 #if DECODE_MIDEA24
-    DPRINTLN("Attempting Midea-Nec decode");
-    if (decodeMidea24(results, offset)) return true;
+    case MIDEA24:
+      if (_attempt(MIDEA24) && _headerMayMatch(kDispatchNecHdrMark) &&
+          decodeMidea24(results, offset)) return true;
+      break;
 #endif  // DECODE_MIDEA24
 #if DECODE_ZEPEAL
-    DPRINTLN("Attempting Zepeal decode");
-    if (decodeZepeal(results, offset)) return true;
+    case ZEPEAL:
+      if (_attempt(ZEPEAL) && _headerMayMatch(kDispatchZepealHdrMark) &&
+          decodeZepeal(results, offset)) return true;
+      break;
 #endif  // DECODE_ZEPEAL
 #if DECODE_SANYO_AC
-    DPRINTLN("Attempting Sanyo AC decode");
-    if (decodeSanyoAc(results, offset)) return true;
+    case SANYO_AC:
+      if (_attempt(SANYO_AC) && _headerMayMatch(kDispatchSanyoAcHdrMark) &&
+          decodeSanyoAc(results, offset)) return true;
+      break;
 #endif  // DECODE_SANYO_AC
 #if DECODE_VOLTAS
-  DPRINTLN("Attempting Voltas decode");
-  if (decodeVoltas(results)) return true;
+    case VOLTAS:
+      if (_attempt(VOLTAS) && decodeVoltas(results)) return true;
+      break;
 #endif  // DECODE_VOLTAS
 #if DECODE_METZ
-    DPRINTLN("Attempting Metz decode");
-    if (decodeMetz(results, offset)) return true;
+    case METZ:
+      if (_attempt(METZ) && _headerMayMatch(kDispatchMetzHdrMark) &&
+          decodeMetz(results, offset)) return true;
+      break;
 #endif  // DECODE_METZ
 #if DECODE_TRANSCOLD
-    DPRINTLN("Attempting Transcold decode");
-    if (decodeTranscold(results, offset)) return true;
+    case TRANSCOLD:
+      if (_attempt(TRANSCOLD) && _headerMayMatch(kDispatchTranscoldHdrMark) &&
+          decodeTranscold(results, offset)) return true;
+      break;
 #endif  // DECODE_TRANSCOLD
-  // Typically new protocols are added above this line.
+    // Typically new protocols are added above this line.
+    default:
+      break;
   }
-#if DECODE_HASH
-  // decodeHash returns a hash on any input.
-  // Thus, it needs to be last in the list.
-  // If you add any decodes, add them before this.
-  if (decodeHash(results)) {
-    return true;
+  return false;
+}
+
+#if ENABLE_DECODE_PROFILING
+/// Start collecting per protocol statistics on what `decode()` spends its time
+/// on. Any previously collected statistics are cleared.
+/// @return true, if successful. false, if the memory couldn't be allocated.
+/// @note Uses `sizeof(decode_profile_t)` bytes of memory for each protocol.
+bool IRrecv::enableDecodeProfiling(void) {
+  if (_profile == NULL) _profile = new decode_profile_t[kDecodeTypeCount];
+  if (_profile == NULL) return false;
+  resetDecodeProfile();
+  return true;
+}
+
+/// Stop collecting decode statistics & free the memory they used.
+void IRrecv::disableDecodeProfiling(void) {
+  delete[] _profile;
+  _profile = NULL;
+  _profile_current = NULL;
+}
+
+/// Clear all of the collected decode statistics.
+void IRrecv::resetDecodeProfile(void) {
+  _profile_current = NULL;
+  if (_profile == NULL) return;
+  for (uint16_t i = 0; i < kDecodeTypeCount; i++) {
+    _profile[i].attempts = 0;
+    _profile[i].rejects = 0;
+    _profile[i].successes = 0;
+    _profile[i].usecs = 0;
   }
-#endif  // DECODE_HASH
-  // Throw away and start over
-  if (!resumed)  // Check if we have already resumed.
-    resume();
+}
+
+/// Obtain the decode statistics collected for a protocol.
+/// @param[in] protocol The protocol to look up. `UNKNOWN` is the hash decoder.
+/// @return A ptr to the statistics, or NULL if profiling isn't enabled or the
+///   protocol is out of range.
+const decode_profile_t *IRrecv::getDecodeProfile(
+    const decode_type_t protocol) {
+  if (_profile == NULL || protocol < UNKNOWN || protocol > kLastDecodeType)
+    return NULL;
+  return &_profile[protocol - UNKNOWN];
+}
+#endif  // ENABLE_DECODE_PROFILING
+
+/// The fewest capture entries a protocol's message could ever be captured in.
+/// i.e. A mark & a space for each of the fewest data bits that `decode()` will
+/// attempt the protocol with, less the final space which may be lost in the
+/// gap after the message.
+/// @param[in] protocol The protocol to look up.
+/// @return The min. nr. of `rawbuf` entries from the start of the message.
+///   Zero for protocols with repeat codes or encodings (e.g. Manchester)
+///   that can use fewer entries than that, & for those decoded from a fixed
+///   offset.
+/// @note Used by `decode()` to skip decoders for messages that are too short.
+uint16_t IRrecv::minRawEntries(const decode_type_t protocol) {
+  switch (protocol) {
+    case AIWA_RC_T501: return 2 * kAiwaRcT501Bits - 1;
+    case AMCOR: return 2 * kAmcorBits - 1;
+    case ARGO: return 2 * kArgoBits - 1;
+    case CARRIER_AC: return 2 * kCarrierAcBits - 1;
+    case CARRIER_AC40: return 2 * kCarrierAc40Bits - 1;
+    case CARRIER_AC64: return 2 * kCarrierAc64Bits - 1;
+    case COOLIX: return 2 * kCoolixBits - 1;
+    case DAIKIN: return 2 * kDaikinBits - 1;
+    case DAIKIN128: return 2 * kDaikin128Bits - 1;
+    case DAIKIN152: return 2 * kDaikin152Bits - 1;
+    case DAIKIN160: return 2 * kDaikin160Bits - 1;
+    case DAIKIN176: return 2 * kDaikin176Bits - 1;
+    case DAIKIN2: return 2 * kDaikin2Bits - 1;
+    case DAIKIN216: return 2 * kDaikin216Bits - 1;
+    case DAIKIN64: return 2 * kDaikin64Bits - 1;
+    case DELONGHI_AC: return 2 * kDelonghiAcBits - 1;
+    case DENON: return 2 * kDenonLegacyBits - 1;
+    case DISH: return 2 * kDishBits - 1;
+    case DOSHISHA: return 2 * kDoshishaBits - 1;
+    case ELECTRA_AC: return 2 * kElectraAcBits - 1;
+    case EPSON: return 2 * kEpsonBits - 1;
+    case FUJITSU_AC: return 2 * kFujitsuAcMinBits - 1;
+    case GICABLE: return 2 * kGicableBits - 1;
+    case GOODWEATHER: return 2 * kGoodweatherBits - 1;
+    case GREE: return 2 * kGreeBits - 1;
+    case HAIER_AC: return 2 * kHaierACBits - 1;
+    case HAIER_AC_YRW02: return 2 * kHaierACYRW02Bits - 1;
+    case HITACHI_AC: return 2 * kHitachiAcBits - 1;
+    case HITACHI_AC1: return 2 * kHitachiAc1Bits - 1;
+    case HITACHI_AC2: return 2 * kHitachiAc2Bits - 1;
+    case HITACHI_AC3: return 2 * kHitachiAc3MinBits - 1;
+    case HITACHI_AC344: return 2 * kHitachiAc344Bits - 1;
+    case HITACHI_AC424: return 2 * kHitachiAc424Bits - 1;
+    case INAX: return 2 * kInaxBits - 1;
+    case JVC: return 2 * kJvcBits - 1;
+    case KELVINATOR: return 2 * kKelvinatorBits - 1;
+    case LEGOPF: return 2 * kLegoPfBits - 1;
+    case LG: return 2 * kLgBits - 1;
+    case MAGIQUEST: return 2 * kMagiquestBits - 1;
+    case METZ: return 2 * kMetzBits - 1;
+    case MIDEA: return 2 * kMideaBits - 1;
+    case MIDEA24: return 2 * kMidea24Bits - 1;
+    case MITSUBISHI: return 2 * kMitsubishiBits - 1;
+    case MITSUBISHI2: return 2 * kMitsubishiBits - 1;
+    case MITSUBISHI112: return 2 * kMitsubishi112Bits - 1;
+    case MITSUBISHI136: return 2 * kMitsubishi136Bits - 1;
+    case MITSUBISHI_AC: return 2 * kMitsubishiACBits - 1;
+    case MITSUBISHI_HEAVY_152: return 2 * kMitsubishiHeavy152Bits - 1;
+    case MITSUBISHI_HEAVY_88: return 2 * kMitsubishiHeavy88Bits - 1;
+    case NEOCLIMA: return 2 * kNeoclimaBits - 1;
+    case NIKAI: return 2 * kNikaiBits - 1;
+    case PANASONIC: return 2 * kPanasonicBits - 1;
+    case PANASONIC_AC: return 2 * kPanasonicAcShortBits - 1;
+    case PIONEER: return 2 * kPioneerBits - 1;
+    case SAMSUNG: return 2 * kSamsungBits - 1;
+    case SAMSUNG36: return 2 * kSamsung36Bits - 1;
+    case SAMSUNG_AC: return 2 * kSamsungAcBits - 1;
+    case SANYO_AC: return 2 * kSanyoAcBits - 1;
+    case SHARP: return 2 * kSharpBits - 1;
+    case SHARP_AC: return 2 * kSharpAcBits - 1;
+    case SONY: return 2 * kSony12Bits - 1;
+    case SYMPHONY: return 2 * kSymphonyBits - 1;
+    case TECHNIBEL_AC: return 2 * kTechnibelAcBits - 1;
+    case TECO: return 2 * kTecoBits - 1;
+    case TOSHIBA_AC: return 2 * kToshibaACBitsShort - 1;
+    case TRANSCOLD: return 2 * kTranscoldBits - 1;
+    case TROTEC: return 2 * kTrotecBits - 1;
+    case VESTEL_AC: return 2 * kVestelAcBits - 1;
+    case WHIRLPOOL_AC: return 2 * kWhirlpoolAcBits - 1;
+    case WHYNTER: return 2 * kWhynterBits - 1;
+    case ZEPEAL: return 2 * kZepealBits - 1;
+    default:
+#if ENABLE_CUSTOM_PROTOCOLS
+      if (ircustom::get(protocol) != NULL)
+        return 2 * ircustom::get(protocol)->timing.nbits - 1;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+      return 0;
+  }
+}
+
+/// Should `decode()` attempt a protocol? If so, note the start of the attempt,
+/// ending the previous one.
+/// @param[in] protocol The protocol about to be attempted.
+/// @return true, if the protocol is enabled or we are learning. i.e. Try it.
+bool IRrecv::_attempt(const decode_type_t protocol) {
+#if ENABLE_DECODE_CACHE
+  if (_dcache_only && protocol != _dcache_protocol) return false;
+#endif  // ENABLE_DECODE_CACHE
+  if (!_learning && !isProtocolEnabled(protocol)) return false;
+#if ENABLE_CARRIER_FILTER
+  if (_carrier && !_carrierMatches(protocol)) return false;
+#endif  // ENABLE_CARRIER_FILTER
+#if ENABLE_LENGTH_DISPATCH
+#if ENABLE_PARTIAL_DECODE
+  // An overflowed capture may still hold the start of a longer message.
+  if (_entries < minRawEntries(protocol) && !_partial_ok) return false;
+#else  // ENABLE_PARTIAL_DECODE
+  if (_entries < minRawEntries(protocol)) return false;
+#endif  // ENABLE_PARTIAL_DECODE
+#endif  // ENABLE_LENGTH_DISPATCH
+  _attempting = protocol;
+#if ENABLE_PROTOCOL_TOLERANCE
+  // Looked up once per attempt, rather than for every match.
+  _protocol_tolerance = _protocol_tolerance_count
+      ? _findProtocolTolerance(protocol) : NULL;
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+#if ENABLE_PARTIAL_DECODE
+  _trunc_pos = 0;
+#endif  // ENABLE_PARTIAL_DECODE
+  _fit_used = 0;  // Start afresh on how well this protocol fits.
+  _fit_error = 0;
+#if ENABLE_SIGNAL_QUALITY
+  _fit_max = 0;
+  _fit_near = 0;
+#endif  // ENABLE_SIGNAL_QUALITY
+  _skew_sum = 0;
+  _skew_count = 0;
+#if ENABLE_DECODE_TRACE
+  _traceEvent(kTraceAttempt, protocol, 0);
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_DECODE_PROFILING
+  if (_profile == NULL) return true;
+  _profileFinish(false);  // It got to us, so the previous attempt failed.
+  _profile_current = &_profile[protocol - UNKNOWN];
+  _profile_current->attempts++;
+  _profile_timer.reset();
+#endif  // ENABLE_DECODE_PROFILING
+  return true;
+}
+
+/// Note the end of the attempt to decode a protocol that is in progress.
+/// @param[in] success Did the attempt decode the message?
+void IRrecv::_profileFinish(const bool success) {
+#if ENABLE_DECODE_PROFILING
+  if (_profile_current == NULL) return;
+  _profile_current->usecs += _profile_timer.elapsed();
+  if (success) _profile_current->successes++;
+  _profile_current = NULL;
+#else  // ENABLE_DECODE_PROFILING
+  (void)success;  // Not used.
+#endif  // ENABLE_DECODE_PROFILING
+}
+
+#if ENABLE_HEADER_DISPATCH
+/// Only attempt to decode at skipped offsets (see `max_skip` in `decode()`)
+/// where the mark could be the long header mark of a known protocol, rather
+/// than running every decoder at every skipped offset.
+/// This makes a large `max_skip` value far cheaper, at the cost of not
+/// finding protocols without a long header mark after any skipped pulses.
+/// @param[in] on Enable smart skipping if true, disable it if false.
+void IRrecv::setSmartSkip(const bool on) { _smart_skip = on; }
+
+/// Could the mark at the current offset be a long header mark of a protocol?
+/// @note Uses the window calculated by `_setHeaderWindow()`.
+/// @return true, if it is worth attempting to decode from here.
+bool IRrecv::_isLikelyHeader(void) {
+  const uint16_t *end = kDispatchLongHdrMarks +
+      sizeof(kDispatchLongHdrMarks) / sizeof(kDispatchLongHdrMarks[0]);
+  // Find the shortest header mark that isn't too short.
+  const uint16_t *mark = std::lower_bound(kDispatchLongHdrMarks, end,
+                                          _hdr_min);
+  if (mark != end && *mark <= _hdr_max) return true;
+#if ENABLE_CUSTOM_PROTOCOLS
+  // Those registered at run time have headers too.
+  for (uint8_t i = 0; i < kMaxCustomProtocols && ircustom::count(); i++) {
+    const custom_protocol_t *custom = ircustom::get(
+        (decode_type_t)(kFirstCustomType + i));
+    if (custom != NULL && custom->timing.hdrmark >= _hdr_min &&
+        custom->timing.hdrmark <= _hdr_max) return true;
+  }
+#endif  // ENABLE_CUSTOM_PROTOCOLS
   return false;
 }
+#endif  // ENABLE_HEADER_DISPATCH
+
+/// Calculate the range of nominal header mark durations that could possibly
+/// match a captured mark, given the tolerances the decoders use.
+/// @param[in] entry The captured (header) mark to compare against. (in ticks)
+/// @note Deliberately generous. It only has to rule out decoders that would
+///   reject the message on their very first match anyway.
+void IRrecv::_setHeaderWindow(const uint16_t entry) {
+#if ENABLE_HEADER_DISPATCH
+  _hdr_entry = entry;
+  _headerWindow(_tolerance, _excess_adjust, &_hdr_min, &_hdr_max);
+#else  // ENABLE_HEADER_DISPATCH
+  (void)entry;  // Not used.
+#endif  // ENABLE_HEADER_DISPATCH
+}
+
+#if ENABLE_HEADER_DISPATCH
+/// Calculate the range of nominal header mark durations that could possibly
+/// match the captured mark `_setHeaderWindow()` was given.
+/// @param[in] percent The tolerance percentage the decoder matches with.
+/// @param[in] adjust The adjustment to the mark excess the decoder uses.
+///   See `_excessAdjust()`.
+/// @param[out] min The smallest nominal header mark worth trying. (uSecs)
+/// @param[out] max The largest nominal header mark worth trying. (uSecs)
+void IRrecv::_headerWindow(const uint8_t percent, const int16_t adjust,
+                           uint32_t *min, uint32_t *max) {
+  const uint32_t measured = _hdr_entry * kRawTick;
+  const uint16_t margin = 2 * kMarkExcess + (adjust < 0 ? -adjust : adjust);
+  const uint16_t tolerance = std::max(percent, kTolerance) +
+      kHeaderDispatchExtraTolerance;
+  const uint32_t low = measured * 100 / (100 + tolerance);
+  *min = (low > margin) ? low - margin : 0;
+  if (tolerance >= 100)  // The upper bound is effectively infinite.
+    *max = UINT32_MAX;
+  else
+    *max = measured * 100 / (100 - tolerance) + margin;
+}
+#endif  // ENABLE_HEADER_DISPATCH
+
+/// Could a protocol with the given nominal header mark possibly match the
+/// current capture?
+/// @param[in] hdrmark Nr. of uSeconds of the protocol's first/header mark.
+/// @return true if the protocol's decoder is worth trying, otherwise false.
+/// @note The window is widened for a protocol being attempted with a
+///   tolerance (or mark excess) of its own. See `setProtocolTolerance()`.
+bool IRrecv::_headerMayMatch(const uint32_t hdrmark) {
+#if ENABLE_HEADER_DISPATCH
+  bool possible = hdrmark >= _hdr_min && hdrmark <= _hdr_max;
+#if ENABLE_PROTOCOL_TOLERANCE
+  if (!possible && _protocol_tolerance != NULL) {
+    uint32_t min, max;
+    _headerWindow(std::max(_tolerance, _protocol_tolerance->tolerance),
+                  _excessAdjust(), &min, &max);
+    possible = hdrmark >= min && hdrmark <= max;
+  }
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+#if ENABLE_DECODE_PROFILING
+  if (!possible && _profile_current != NULL) _profile_current->rejects++;
+#endif  // ENABLE_DECODE_PROFILING
+#if ENABLE_DECODE_TRACE
+  if (!possible) _traceEvent(kTraceHeaderReject, _attempting, hdrmark);
+#endif  // ENABLE_DECODE_TRACE
+  return possible;
+#else  // ENABLE_HEADER_DISPATCH
+  (void)hdrmark;  // Not used.
+  return true;
+#endif  // ENABLE_HEADER_DISPATCH
+}
+
+/// Count the data bits of a pulse distance encoded message. i.e. The mark &
+/// space pairs from a point in the capture up to the first space too long to
+/// be a bit, or the end of the capture.
+/// It lets `decode()` tell apart the variants of a protocol that only differ in
+/// length with one pass, then run the decoder of just the matching variant.
+/// @param[in] results The capture to look at.
+/// @param[in] offset The index of the mark of the first bit. e.g. After the
+///   header.
+/// @return The nr. of bits found. A final mark without a space isn't counted.
+uint16_t IRrecv::_countBits(const decode_results *results, uint16_t offset) {
+  uint16_t bits = 0;
+  for (offset++; offset < results->rawlen; offset += 2, bits++)
+    if (results->rawbuf[offset] * kRawTick >= kVariantMaxBitSpace) break;
+  return bits;
+}
+
+/// Count the consecutive blocks of a message that each have a header followed
+/// by the same nr. of data bits & a footer. e.g. A message sent 3 times.
+/// @param[in] results The capture to look at.
+/// @param[in] offset The index of the header mark of the first block.
+/// @param[in] nbits The nr. of data bits in the first block.
+/// @return The nr. of blocks found. At least 1.
+uint8_t IRrecv::_countBlocks(const decode_results *results, uint16_t offset,
+                             const uint16_t nbits) {
+  uint8_t blocks = 1;
+  if (!nbits) return blocks;  // Nothing to tell the blocks apart with.
+  const uint16_t length = kHeader + 2 * nbits + kFooter;
+  for (offset += length;
+       offset + kHeader < results->rawlen && blocks < UINT8_MAX &&
+       _countBits(results, offset + kHeader) == nbits;
+       offset += length) blocks++;
+  return blocks;
+}
+
+/// Could a member of the NEC family of protocols possibly match the current
+/// capture? They share the same header & bit timings (near enough), so they
+/// are only told apart by how many data bits, & blocks of them, they have.
+/// The capture is only sized up once per offset, on the first call.
+/// @param[in] results The capture to look at.
+/// @param[in] offset The index of the header mark of the message.
+/// @param[in] nbits The nr. of data bits in each block of the protocol.
+/// @param[in] blocks The nr. of blocks in each message of the protocol.
+/// @return true if the protocol's decoder is worth trying, otherwise false.
+bool IRrecv::_necFamilyMayMatch(const decode_results *results,
+                                const uint16_t offset, const uint16_t nbits,
+                                const uint8_t blocks) {
+#if ENABLE_NEC_FAMILY_DISPATCH
+  if (!_nec_sized) {
+    _nec_bits = _countBits(results, offset + kHeader);
+    _nec_blocks = _countBlocks(results, offset, _nec_bits);
+    _nec_sized = true;
+  }
+  bool possible = _nec_bits == nbits && _nec_blocks >= blocks;
+#if ENABLE_PARTIAL_DECODE
+  // An overflowed capture may be missing its later blocks.
+  if (_partial_ok && _nec_bits == nbits) possible = true;
+#endif  // ENABLE_PARTIAL_DECODE
+#if ENABLE_DECODE_PROFILING
+  if (!possible && _profile_current != NULL) _profile_current->rejects++;
+#endif  // ENABLE_DECODE_PROFILING
+  return possible;
+#else  // ENABLE_NEC_FAMILY_DISPATCH
+  (void)results;  // Not used.
+  (void)offset;  // Not used.
+  (void)nbits;  // Not used.
+  (void)blocks;  // Not used.
+  return true;
+#endif  // ENABLE_NEC_FAMILY_DISPATCH
+}
 
 /// Convert the tolerance percentage into something valid.
 /// @param[in] percentage An integer percentage.
@@ -903,8 +4801,16 @@ uint8_t IRrecv::_validTolerance(const uint8_t percentage) {
 /// @param[in] tolerance Percent as an integer. e.g. 10 is 10%
 /// @param[in] delta A non-scaling amount to reduce usecs by.
 /// @return Nr. of ticks.
+/// @note A tolerance set for the protocol being attempted is used instead.
 uint32_t IRrecv::ticksLow(const uint32_t usecs, const uint8_t tolerance,
                           const uint16_t delta) {
+#if ENABLE_PROTOCOL_TOLERANCE
+  if (_protocol_tolerance != NULL) {  // Precomputed. No floating point maths.
+    const uint32_t scaled = ((uint64_t)usecs * _protocol_tolerance->low) >>
+        kToleranceScaleBits;
+    return (scaled > delta) ? scaled - delta : 0;
+  }
+#endif  // ENABLE_PROTOCOL_TOLERANCE
   // max() used to ensure the result can't drop below 0 before the cast.
   return ((uint32_t)std::max(
       (int32_t)(usecs * (1.0 - _validTolerance(tolerance) / 100.0) - delta),
@@ -916,12 +4822,42 @@ uint32_t IRrecv::ticksLow(const uint32_t usecs, const uint8_t tolerance,
 /// @param[in] tolerance Percent as an integer. e.g. 10 is 10%
 /// @param[in] delta A non-scaling amount to increase usecs by.
 /// @return Nr. of ticks.
+/// @note A tolerance set for the protocol being attempted is used instead.
 uint32_t IRrecv::ticksHigh(const uint32_t usecs, const uint8_t tolerance,
                            const uint16_t delta) {
+#if ENABLE_PROTOCOL_TOLERANCE
+  if (_protocol_tolerance != NULL)  // Precomputed. No floating point maths.
+    return (uint32_t)(((uint64_t)usecs * _protocol_tolerance->high) >>
+                      kToleranceScaleBits) + 1 + delta;
+#endif  // ENABLE_PROTOCOL_TOLERANCE
   return ((uint32_t)(usecs * (1.0 + _validTolerance(tolerance) / 100.0)) + 1 +
           delta);
 }
 
+/// Precompute the range of captured durations `match()` would accept.
+/// @param[in] desired The expected period (in usecs) we are matching against.
+/// @param[in] tolerance A percentage expressed as an integer. e.g. 10 is 10%.
+/// @param[in] delta A non-scaling (+/-) error margin (in useconds).
+/// @return The window, in ticks. A measured value in [low, high] matches.
+match_window_t IRrecv::_matchWindow(const uint32_t desired,
+                                    const uint8_t tolerance,
+                                    const uint16_t delta) {
+  match_window_t window;
+  // Round inwards so it agrees exactly with `match()` comparing in uSeconds.
+  window.low = (ticksLow(desired, tolerance, delta) + kRawTick - 1) / kRawTick;
+  window.high = ticksHigh(desired, tolerance, delta) / kRawTick;
+  return window;
+}
+
+/// Is a measured duration within a precomputed window?
+/// @param[in] measured The recorded period of the signal pulse. (in ticks)
+/// @param[in] window The range of acceptable durations. (in ticks)
+/// @return A Boolean. true if it matches, false if it doesn't.
+static inline bool inWindow(const uint32_t measured,
+                            const match_window_t *window) {
+  return measured >= window->low && measured <= window->high;
+}
+
 /// Check if we match a pulse(measured) with the desired within
 ///   +/-tolerance percent and/or +/- a fixed delta range.
 /// @param[in] measured The recorded period of the signal pulse.
@@ -949,8 +4885,11 @@ bool IRrecv::match(uint32_t measured, uint32_t desired, uint8_t tolerance,
   // If there is a legit case, then this should be removed.
   assert(ticksHigh(desired, tolerance, delta) >= desired);
 #endif  // UNIT_TEST
-  return (measured >= ticksLow(desired, tolerance, delta) &&
-          measured <= ticksHigh(desired, tolerance, delta));
+  const uint32_t low = ticksLow(desired, tolerance, delta);
+  const uint32_t high = ticksHigh(desired, tolerance, delta);
+  if (measured < low || measured > high) return false;
+  _scoreFit(measured, low, high);
+  return true;
 }
 
 /// Check if we match a pulse(measured) of at least desired within
@@ -970,12 +4909,12 @@ bool IRrecv::matchAtLeast(uint32_t measured, uint32_t desired,
   DPRINT(". Matching: ");
   DPRINT(measured);
   DPRINT(" >= ");
-  DPRINT(ticksLow(std::min(desired, MS_TO_USEC(irparams.timeout)), tolerance,
+  DPRINT(ticksLow(std::min(desired, MS_TO_USEC(_params->timeout)), tolerance,
                   delta));
   DPRINT(" [min(");
   DPRINT(ticksLow(desired, tolerance, delta));
   DPRINT(", ");
-  DPRINT(ticksLow(MS_TO_USEC(irparams.timeout), tolerance, delta));
+  DPRINT(ticksLow(MS_TO_USEC(_params->timeout), tolerance, delta));
   DPRINTLN(")]");
 #ifdef UNIT_TEST
   // Sanity checks that we don't have values that cause integer over/underflow.
@@ -991,8 +4930,10 @@ bool IRrecv::matchAtLeast(uint32_t measured, uint32_t desired,
   // We really should never get a value of 0, except as the last value
   // in the buffer. If that is the case, then assume infinity and return true.
   if (measured == 0) return true;
-  return measured >= ticksLow(std::min(desired, MS_TO_USEC(irparams.timeout)),
-                              tolerance, delta);
+  if (measured < ticksLow(std::min(desired, MS_TO_USEC(_params->timeout)),
+                          tolerance, delta)) return false;
+  _scoreFit(measured, measured, measured);  // Anything longer is a perfect fit.
+  return true;
 }
 
 /// Check if we match a mark signal(measured) with the desired within
@@ -1011,7 +4952,15 @@ bool IRrecv::matchMark(uint32_t measured, uint32_t desired, uint8_t tolerance,
   DPRINT(" + ");
   DPRINT(excess);
   DPRINT(". ");
-  return match(measured, desired + excess, tolerance);
+  const uint32_t nominal = desired + excess + _excessAdjust();
+  if (!match(measured, nominal, tolerance)) {
+#if ENABLE_DECODE_TRACE
+    _traceEvent(kTraceMarkMismatch, _attempting, measured * kRawTick);
+#endif  // ENABLE_DECODE_TRACE
+    return false;
+  }
+  if (_calibrating) _skewFit(measured * kRawTick, nominal, true);
+  return true;
 }
 
 /// Check if we match a space signal(measured) with the desired within
@@ -1030,24 +4979,46 @@ bool IRrecv::matchSpace(uint32_t measured, uint32_t desired, uint8_t tolerance,
   DPRINT(" - ");
   DPRINT(excess);
   DPRINT(". ");
-  return match(measured, desired - excess, tolerance);
+  const uint32_t nominal = desired - excess - _excessAdjust();
+  if (!match(measured, nominal, tolerance)) {
+#if ENABLE_DECODE_TRACE
+    _traceEvent(kTraceSpaceMismatch, _attempting, measured * kRawTick);
+#endif  // ENABLE_DECODE_TRACE
+    return false;
+  }
+  if (_calibrating) _skewFit(measured * kRawTick, nominal, false);
+  return true;
 }
 
-#if DECODE_HASH
+#if DECODE_HASH || ENABLE_REPEAT_COALESCING || ENABLE_DECODE_CACHE
 /// Compare two tick values.
 /// @param[in] oldval Nr. of ticks.
 /// @param[in] newval Nr. of ticks.
 /// @return 0 if newval is shorter, 1 if it is equal, & 2 if it is longer.
 /// @note Use a tolerance of 20%
 uint16_t IRrecv::compare(const uint16_t oldval, const uint16_t newval) {
-  if (newval < oldval * 0.8)
-    return 0;
-  else if (oldval < newval * 0.8)
-    return 2;
-  else
-    return 1;
+  return compare_ticks(oldval, newval);
+}
+
+/// Hash a captured message. See `decodeHash()` for the algorithm.
+/// @param[in] results A PTR to the captured message.
+/// @return The 32-bit hash of the capture.
+uint32_t IRrecv::_hashCapture(const decode_results *results) {
+  int32_t hash = kFnvBasis32;
+  // 'rawlen - 2' to avoid the look ahead from going out of bounds.
+  // Should probably be -3 to avoid comparing the trailing space entry,
+  // however it is left this way for compatibility with previously captured
+  // values.
+  for (uint16_t i = 1; i < results->rawlen - 2; i++) {
+    uint16_t value = compare(results->rawbuf[i], results->rawbuf[i + 2]);
+    // Add value into the hash
+    hash = (hash * kFnvPrime32) ^ value;
+  }
+  return hash & 0xFFFFFFFF;
 }
+#endif  // DECODE_HASH || ENABLE_REPEAT_COALESCING || ENABLE_DECODE_CACHE
 
+#if DECODE_HASH
 /// Decode any arbitrary IR message into a 32-bit code value.
 /// Instead of decoding using a standard encoding scheme
 /// (e.g. Sony, NEC, RC5), the code is hashed to a 32-bit value.
@@ -1063,56 +5034,304 @@ uint16_t IRrecv::compare(const uint16_t oldval, const uint16_t newval) {
 bool IRrecv::decodeHash(decode_results *results) {
   // Require at least some samples to prevent triggering on noise
   if (results->rawlen < _unknown_threshold) return false;
-  int32_t hash = kFnvBasis32;
-  // 'rawlen - 2' to avoid the look ahead from going out of bounds.
-  // Should probably be -3 to avoid comparing the trailing space entry,
-  // however it is left this way for compatibility with previously captured
-  // values.
-  for (uint16_t i = 1; i < results->rawlen - 2; i++) {
-    uint16_t value = compare(results->rawbuf[i], results->rawbuf[i + 2]);
-    // Add value into the hash
-    hash = (hash * kFnvPrime32) ^ value;
+#if ENABLE_CAPTURE_HASH
+  // Use the hash the interrupt handler built, if it is for this message.
+  results->value = _capture_hashed ? _capture_hash : _hashCapture(results);
+#else  // ENABLE_CAPTURE_HASH
+  results->value = _hashCapture(results);
+#endif  // ENABLE_CAPTURE_HASH
+  results->bits = results->rawlen / 2;
+  results->address = 0;
+  results->command = 0;
+  results->decode_type = UNKNOWN;
+  return true;
+}
+#endif  // DECODE_HASH
+
+/// Match & decode the typical data section of an IR message.
+/// The data value is stored in the least significant bits reguardless of the
+/// bit ordering requested.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
+/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
+/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
+/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @param[in] MSBfirst Bit order to save the data in. (Def: true)
+///   true is Most Significant Bit First Order, false is Least Significant First
+/// @return A match_result_t structure containing the success (or not), the
+///   data value, and how many buffer entries were used.
+match_result_t IRrecv::matchData(
+    volatile uint16_t *data_ptr, const uint16_t nbits, const uint16_t onemark,
+    const uint32_t onespace, const uint16_t zeromark, const uint32_t zerospace,
+    const uint8_t tolerance, const int16_t excess, const bool MSBfirst) {
+  const bit_windows_t windows = _bitWindows(onemark, onespace,
+                                            zeromark, zerospace,
+                                            tolerance, excess);
+  return _matchData(data_ptr, nbits, &windows, MSBfirst);
+}
+
+/// Match & decode a data section where each byte is followed by an inverted
+/// copy of itself. e.g. COOLIX & MIDEA24
+/// Up to four pairs are matched at a time, & checked in a single compare.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] nbits Nr. of data bits we expect, excluding the inverted copies.
+///   A multiple of 8, & <= 64.
+/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
+/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
+/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
+/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
+/// @param[in] strict Should the inverted copies be checked? (Default: true)
+///   It stops at the first pair that isn't inverted.
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @return A match_result_t structure containing the success (or not), the
+///   data value (without the inverted copies), and how many buffer entries
+///   were used.
+/// @note The data is in Most Significant Bit First Order.
+match_result_t IRrecv::matchBytePairs(volatile uint16_t *data_ptr,
+                                      const uint16_t nbits,
+                                      const uint16_t onemark,
+                                      const uint32_t onespace,
+                                      const uint16_t zeromark,
+                                      const uint32_t zerospace,
+                                      const bool strict,
+                                      const uint8_t tolerance,
+                                      const int16_t excess) {
+  match_result_t result;
+  result.success = false;
+  result.data = 0;
+  result.used = 0;
+  if (nbits % 8 || nbits > 64) return result;  // Can't fit it in the result.
+  const bit_windows_t windows = _bitWindows(onemark, onespace,
+                                            zeromark, zerospace,
+                                            tolerance, excess);
+  for (uint16_t done = 0; done < nbits;) {
+    // Nr. of data bits this time. i.e. All that fit in 64 bits with the pairs.
+    const uint16_t chunk = std::min((uint16_t)(nbits - done), (uint16_t)32);
+    const match_result_t pairs = _matchData(data_ptr + result.used, chunk * 2,
+                                            &windows);
+    if (!pairs.success) return result;
+    if (strict && !irutils::checkInvertedBytePairs(pairs.data, chunk * 2))
+      return result;
+    result.data = (result.data << chunk) |
+        irutils::dropInvertedBytes(pairs.data, chunk * 2);
+    result.used += pairs.used;
+    done += chunk;
+  }
+  result.success = true;
+  return result;
+}
+
+/// Precompute the windows for matching the bits of a data section.
+/// i.e. The same ranges `matchMark()` & `matchSpace()` would accept.
+/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
+/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
+/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
+/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @return The windows, in ticks.
+bit_windows_t IRrecv::_bitWindows(const uint16_t onemark,
+                                  const uint32_t onespace,
+                                  const uint16_t zeromark,
+                                  const uint32_t zerospace,
+                                  const uint8_t tolerance,
+                                  const int16_t excess) {
+  bit_windows_t windows;
+  const int16_t lag = excess + _excessAdjust();
+  windows.onemark = _matchWindow(onemark + lag, tolerance);
+  windows.onespace = _matchWindow(onespace - lag, tolerance);
+  windows.zeromark = _matchWindow(zeromark + lag, tolerance);
+  windows.zerospace = _matchWindow(zerospace - lag, tolerance);
+  // Checked once here, rather than for every bit.
+  windows.distance = (windows.onemark.low == windows.zeromark.low &&
+                      windows.onemark.high == windows.zeromark.high &&
+                      windows.zerospace.high < windows.onespace.low);
+  windows.width = (windows.zeromark.high < windows.onemark.low ||
+                   windows.onemark.high < windows.zeromark.low);
+  return windows;
+}
+
+/// Match & decode the typical data section of an IR message, using
+/// precomputed windows. i.e. Only integer compares for each bit.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] windows A ptr to the precomputed windows for each bit.
+/// @param[in] MSBfirst Bit order to save the data in. (Def: true)
+///   true is Most Significant Bit First Order, false is Least Significant First
+/// @return A match_result_t structure containing the success (or not), the
+///   data value, and how many buffer entries were used.
+/// @note The bits are collected in the smallest type they fit in, as most
+///   messages don't need 64 bit shifts, which are slow on a 32 bit core.
+match_result_t IRrecv::_matchData(volatile uint16_t *data_ptr,
+                                  const uint16_t nbits,
+                                  const bit_windows_t *windows,
+                                  const bool MSBfirst) {
+  if (nbits <= 8)
+    return _matchDataAs<uint8_t>(data_ptr, nbits, windows, MSBfirst);
+  if (nbits <= 32)
+    return _matchDataAs<uint32_t>(data_ptr, nbits, windows, MSBfirst);
+  return _matchDataAs<uint64_t>(data_ptr, nbits, windows, MSBfirst);
+}
+
+/// The work of `_matchData()`, collecting the bits in a given type.
+/// @tparam T An unsigned type of at least `nbits` bits.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] windows A ptr to the precomputed windows for each bit.
+/// @param[in] MSBfirst Bit order to save the data in.
+/// @return A match_result_t structure containing the success (or not), the
+///   data value, and how many buffer entries were used.
+/// @note Pulse distance encoded data (e.g. NEC, Samsung, LG, most A/Cs) is
+///   told apart by a single compare of each space, via
+///   `_matchDataDistance()`. Pulse width encoded data (e.g. constant bit time)
+///   is told apart by its marks instead, via `_matchDataWidth()`. Everything
+///   else uses `_matchDataStrict()`. All accept & reject exactly the same data.
+template <typename T>
+match_result_t IRrecv::_matchDataAs(volatile uint16_t *data_ptr,
+                                    const uint16_t nbits,
+                                    const bit_windows_t *windows,
+                                    const bool MSBfirst) {
+  if (windows->distance)
+    return _matchDataDistance<T>(data_ptr, nbits, windows, MSBfirst);
+  if (windows->width)
+    return _matchDataWidth<T>(data_ptr, nbits, windows, MSBfirst);
+  return _matchDataStrict(data_ptr, nbits, windows, MSBfirst);
+}
+
+/// Match & decode a pulse distance encoded data section of an IR message,
+/// using precomputed windows. i.e. Where the space alone tells a '1' from a
+/// '0', by a single compare against the start of the '1' space window.
+/// @tparam T An unsigned type of at least `nbits` bits.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] windows A ptr to the precomputed windows for each bit. Their
+///   mark windows must be the same, & the '0' space must be the shorter.
+/// @param[in] MSBfirst Bit order to save the data in.
+/// @return A match_result_t structure containing the success (or not), the
+///   data value, and how many buffer entries were used.
+template <typename T>
+match_result_t IRrecv::_matchDataDistance(volatile uint16_t *data_ptr,
+                                          const uint16_t nbits,
+                                          const bit_windows_t *windows,
+                                          const bool MSBfirst) {
+  const match_window_t mark_window = windows->onemark;  // Same for both bits.
+  const uint32_t one_low = windows->onespace.low;
+  const uint32_t one_high = windows->onespace.high;
+  const uint32_t zero_low = windows->zerospace.low;
+  const uint32_t zero_high = windows->zerospace.high;
+  match_result_t result;
+  result.success = false;  // Fail by default.
+  T data = 0;
+  for (result.used = 0; result.used < nbits * 2;
+       result.used += 2, data_ptr += 2) {
+    const uint16_t mark = *data_ptr;
+    const uint16_t space = *(data_ptr + 1);
+    if (!inWindow(mark, &mark_window)) break;
+    if (space >= one_low) {  // Can only be a '1'.
+      if (space > one_high) break;
+      data = (data << 1) | 1;
+    } else {  // Can only be a '0'.
+      if (space < zero_low || space > zero_high) break;
+      data <<= 1;
+    }
+    if (_fitting()) {
+      const bool one = data & 1;
+      _fitBit(mark, &mark_window, space,
+              one ? &windows->onespace : &windows->zerospace);
+    }
   }
-  results->value = hash & 0xFFFFFFFF;
-  results->bits = results->rawlen / 2;
-  results->address = 0;
-  results->command = 0;
-  results->decode_type = UNKNOWN;
-  return true;
+  result.data = data;
+  if (result.used == nbits * 2) {
+    result.success = true;
+    if (!MSBfirst) result.data = reverseBits(result.data, nbits);
+  } else if (!MSBfirst) {
+    result.data = reverseBits(result.data, result.used / 2);
+  }
+  return result;
 }
-#endif  // DECODE_HASH
 
-/// Match & decode the typical data section of an IR message.
-/// The data value is stored in the least significant bits reguardless of the
-/// bit ordering requested.
+/// Match & decode a pulse width encoded data section of an IR message, using
+/// precomputed windows. i.e. Where the mark alone tells a '1' from a '0'.
+/// @tparam T An unsigned type of at least `nbits` bits.
 /// @param[in] data_ptr A pointer to where we are at in the capture buffer.
 /// @param[in] nbits Nr. of data bits we expect.
-/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
-/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
-/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
-/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
-/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
-/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @param[in] windows A ptr to the precomputed windows for each bit. Their
+///   mark windows must not overlap.
+/// @param[in] MSBfirst Bit order to save the data in.
+/// @return A match_result_t structure containing the success (or not), the
+///   data value, and how many buffer entries were used.
+template <typename T>
+match_result_t IRrecv::_matchDataWidth(volatile uint16_t *data_ptr,
+                                       const uint16_t nbits,
+                                       const bit_windows_t *windows,
+                                       const bool MSBfirst) {
+  // Any mark past the end of the shorter mark's window can only be the longer.
+  const bool one_longer = windows->onemark.low > windows->zeromark.high;
+  const uint32_t longer = one_longer ? windows->onemark.low
+                                     : windows->zeromark.low;
+  match_result_t result;
+  result.success = false;  // Fail by default.
+  T data = 0;
+  for (result.used = 0; result.used < nbits * 2;
+       result.used += 2, data_ptr += 2) {
+    const uint16_t mark = *data_ptr;
+    const uint16_t space = *(data_ptr + 1);
+    const bool one = (mark >= longer) == one_longer;
+    const match_window_t *mark_window = one ? &windows->onemark
+                                            : &windows->zeromark;
+    const match_window_t *space_window = one ? &windows->onespace
+                                             : &windows->zerospace;
+    if (!inWindow(mark, mark_window) || !inWindow(space, space_window)) break;
+    data = (data << 1) | one;
+    if (_fitting())
+      _fitBit(mark, mark_window, space, space_window);
+  }
+  result.data = data;
+  if (result.used == nbits * 2) {
+    result.success = true;
+    if (!MSBfirst) result.data = reverseBits(result.data, nbits);
+  } else if (!MSBfirst) {
+    result.data = reverseBits(result.data, result.used / 2);
+  }
+  return result;
+}
+
+/// Match & decode the typical data section of an IR message, using
+/// precomputed windows. Tries each bit's windows in turn.
+/// i.e. It works for any encoding, including where the windows overlap.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] windows A ptr to the precomputed windows for each bit.
 /// @param[in] MSBfirst Bit order to save the data in. (Def: true)
 ///   true is Most Significant Bit First Order, false is Least Significant First
 /// @return A match_result_t structure containing the success (or not), the
 ///   data value, and how many buffer entries were used.
-match_result_t IRrecv::matchData(
-    volatile uint16_t *data_ptr, const uint16_t nbits, const uint16_t onemark,
-    const uint32_t onespace, const uint16_t zeromark, const uint32_t zerospace,
-    const uint8_t tolerance, const int16_t excess, const bool MSBfirst) {
+match_result_t IRrecv::_matchDataStrict(volatile uint16_t *data_ptr,
+                                        const uint16_t nbits,
+                                        const bit_windows_t *windows,
+                                        const bool MSBfirst) {
   match_result_t result;
   result.success = false;  // Fail by default.
   result.data = 0;
   for (result.used = 0; result.used < nbits * 2;
        result.used += 2, data_ptr += 2) {
+    const uint16_t mark = *data_ptr;
+    const uint16_t space = *(data_ptr + 1);
     // Is the bit a '1'?
-    if (matchMark(*data_ptr, onemark, tolerance, excess) &&
-        matchSpace(*(data_ptr + 1), onespace, tolerance, excess)) {
+    if (inWindow(mark, &windows->onemark) &&
+        inWindow(space, &windows->onespace)) {
       result.data = (result.data << 1) | 1;
-    } else if (matchMark(*data_ptr, zeromark, tolerance, excess) &&
-               matchSpace(*(data_ptr + 1), zerospace, tolerance, excess)) {
+      if (_fitting())
+        _fitBit(mark, &windows->onemark, space, &windows->onespace);
+    } else if (inWindow(mark, &windows->zeromark) &&
+               inWindow(space, &windows->zerospace)) {
       result.data <<= 1;  // The bit is a '0'.
+      if (_fitting())
+        _fitBit(mark, &windows->zeromark, space, &windows->zerospace);
     } else {
       if (!MSBfirst) result.data = reverseBits(result.data, result.used / 2);
       return result;  // It's neither, so fail.
@@ -1123,6 +5342,30 @@ match_result_t IRrecv::matchData(
   return result;
 }
 
+/// Do the checks that can be made now a byte has been matched, pass?
+/// @param[in] checks What to verify. See `byte_checks_t`.
+/// @param[in] state A ptr to the bytes matched so far.
+/// @param[in] pos The index of the byte just matched.
+/// @param[in] nbytes Nr. of bytes that will be matched in all.
+/// @return true, if they do, or there are none. Otherwise false.
+static bool checkByte(const byte_checks_t *checks, const uint8_t *state,
+                      const uint16_t pos, const uint16_t nbytes) {
+  for (uint8_t i = 0; i < checks->nfixed; i++) {
+    const irutils::fixed_byte_t &fixed = checks->fixed[i];
+    if (fixed.index == pos && (state[pos] ^ fixed.value) & fixed.mask)
+      return false;
+  }
+  for (uint8_t i = 0; i < checks->nchecksums; i++) {
+    const irutils::checksum_t &checksum = checks->checksums[i];
+    const uint16_t end = (checksum.length == irutils::kChecksumToEnd) ?
+        nbytes : checksum.start + checksum.length;
+    if (end == pos + 1 &&
+        !irutils::validChecksums(&checksum, 1, state, nbytes))
+      return false;
+  }
+  return true;
+}
+
 /// Match & decode the typical data section of an IR message.
 /// The bytes are stored at result_ptr. The first byte in the result equates to
 /// the first byte encountered, and so on.
@@ -1138,23 +5381,32 @@ match_result_t IRrecv::matchData(
 /// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
 /// @param[in] MSBfirst Bit order to save the data in. (Def: true)
 ///   true is Most Significant Bit First Order, false is Least Significant First
+/// @param[in] checks What to verify as the bytes are matched, if anything.
+///   e.g. Checksums & signature bytes. Indexes are relative to `result_ptr`.
 /// @return If successful, how many buffer entries were used. Otherwise 0.
+/// @note With `checks`, it fails as soon as a byte makes one of them fail.
 uint16_t IRrecv::matchBytes(volatile uint16_t *data_ptr, uint8_t *result_ptr,
                             const uint16_t remaining, const uint16_t nbytes,
                             const uint16_t onemark, const uint32_t onespace,
                             const uint16_t zeromark, const uint32_t zerospace,
                             const uint8_t tolerance, const int16_t excess,
-                            const bool MSBfirst) {
+                            const bool MSBfirst,
+                            const byte_checks_t *checks) {
   // Check if there is enough capture buffer to possibly have the desired bytes.
   if (remaining < nbytes * 8 * 2) return 0;  // Nope, so abort.
+  // Work out the bit timings once, rather than for every byte.
+  const bit_windows_t windows = _bitWindows(onemark, onespace,
+                                            zeromark, zerospace,
+                                            tolerance, excess);
   uint16_t offset = 0;
   for (uint16_t byte_pos = 0; byte_pos < nbytes; byte_pos++) {
-    match_result_t result = matchData(data_ptr + offset, 8, onemark, onespace,
-                                      zeromark, zerospace, tolerance, excess,
-                                      MSBfirst);
+    match_result_t result = _matchDataAs<uint8_t>(data_ptr + offset, 8,
+                                                  &windows, MSBfirst);
     if (result.success == false) return 0;  // Fail
     result_ptr[byte_pos] = (uint8_t)result.data;
     offset += result.used;
+    if (checks != NULL && !checkByte(checks, result_ptr, byte_pos, nbytes))
+      return 0;  // It isn't the message we are looking for.
   }
   return offset;
 }
@@ -1188,6 +5440,8 @@ uint16_t IRrecv::matchBytes(volatile uint16_t *data_ptr, uint8_t *result_ptr,
 /// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
 /// @param[in] MSBfirst Bit order to save the data in. (Def: true)
 ///   true is Most Significant Bit First Order, false is Least Significant First
+/// @param[in] checks What to verify as the bytes are matched, if anything.
+///   Only for bytes. See `matchBytes()`.
 /// @return If successful, how many buffer entries were used. Otherwise 0.
 uint16_t IRrecv::_matchGeneric(volatile uint16_t *data_ptr,
                               uint64_t *result_bits_ptr,
@@ -1206,7 +5460,8 @@ uint16_t IRrecv::_matchGeneric(volatile uint16_t *data_ptr,
                               const bool atleast,
                               const uint8_t tolerance,
                               const int16_t excess,
-                              const bool MSBfirst) {
+                              const bool MSBfirst,
+                              const byte_checks_t *checks) {
   // If we are expecting byte sizes, check it's a factor of 8 or fail.
   if (!use_bits && nbits % 8 != 0)  return 0;
   // Calculate how much remaining buffer is required.
@@ -1242,7 +5497,7 @@ uint16_t IRrecv::_matchGeneric(volatile uint16_t *data_ptr,
                                             remaining - offset, nbits / 8,
                                             onemark, onespace,
                                             zeromark, zerospace, tolerance,
-                                            excess, MSBfirst);
+                                            excess, MSBfirst, checks);
     if (!data_used) return 0;
     offset += data_used;
   }
@@ -1335,6 +5590,8 @@ uint16_t IRrecv::matchGeneric(volatile uint16_t *data_ptr,
 /// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
 /// @param[in] MSBfirst Bit order to save the data in. (Def: true)
 ///   true is Most Significant Bit First Order, false is Least Significant First
+/// @param[in] checks What to verify as the bytes are matched, if anything.
+///   e.g. Checksums & signature bytes. See `matchBytes()`.
 /// @return If successful, how many buffer entries were used. Otherwise 0.
 uint16_t IRrecv::matchGeneric(volatile uint16_t *data_ptr,
                               uint8_t *result_ptr,
@@ -1351,11 +5608,442 @@ uint16_t IRrecv::matchGeneric(volatile uint16_t *data_ptr,
                               const bool atleast,
                               const uint8_t tolerance,
                               const int16_t excess,
-                              const bool MSBfirst) {
+                              const bool MSBfirst,
+                              const byte_checks_t *checks) {
   return _matchGeneric(data_ptr, NULL, result_ptr, false, remaining, nbits,
                        hdrmark, hdrspace, onemark, onespace,
                        zeromark, zerospace, footermark, footerspace, atleast,
-                       tolerance, excess, MSBfirst);
+                       tolerance, excess, MSBfirst, checks);
+}
+
+/// Check a data section is exactly the bits we expect.
+/// Each pulse is only compared against the window of the bit it should be.
+/// i.e. It fails on the first pulse that differs, & nothing is assembled.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] expected The bits we expect.
+/// @param[in] nbits Nr. of data bits we expect. (<= 64)
+/// @param[in] windows A ptr to the precomputed windows for each bit.
+/// @param[in] MSBfirst Bit order of `expected`. (Def: true)
+///   true is Most Significant Bit First Order, false is Least Significant First
+/// @return true, if it matched. i.e. `nbits * 2` entries were used.
+bool IRrecv::_matchExpected(volatile uint16_t *data_ptr,
+                            const uint64_t expected, const uint16_t nbits,
+                            const bit_windows_t *windows,
+                            const bool MSBfirst) {
+  for (uint16_t i = 0; i < nbits; i++, data_ptr += 2) {
+    const uint16_t bit = MSBfirst ? nbits - 1 - i : i;
+    const bool one = (expected >> bit) & 1;
+    const match_window_t *mark = one ? &windows->onemark : &windows->zeromark;
+    const match_window_t *space = one ? &windows->onespace
+                                      : &windows->zerospace;
+    if (!inWindow(*data_ptr, mark) || !inWindow(*(data_ptr + 1), space))
+      return false;
+    if (_fitting())
+      _fitBit(*data_ptr, mark, *(data_ptr + 1), space);
+  }
+  return true;
+}
+
+/// Check that a repeated copy of a message is exactly what we expect.
+/// e.g. The later copies of a message that is sent several times.
+/// @note Values of 0 for hdrmark, hdrspace, footermark, or footerspace mean
+///   skip that requirement.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] expected_bits The bits we expect, if `use_bits`.
+/// @param[in] expected_bytes A ptr to the bytes we expect, if not `use_bits`.
+/// @param[in] use_bits A flag indicating if we are expecting bits or bytes.
+/// @param[in] remaining The size of the capture buffer remaining.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] hdrmark Nr. of uSeconds for the expected header mark signal.
+/// @param[in] hdrspace Nr. of uSeconds for the expected header space signal.
+/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
+/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
+/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
+/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
+/// @param[in] footermark Nr. of uSeconds for the expected footer mark signal.
+/// @param[in] footerspace Nr. of uSeconds for the expected footer space/gap
+///   signal.
+/// @param[in] atleast Is the match on the footerspace a matchAtLeast or
+///   matchSpace?
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @param[in] MSBfirst Bit order of the expected data. (Def: true)
+///   true is Most Significant Bit First Order, false is Least Significant First
+/// @return If it matched, how many buffer entries were used. Otherwise 0.
+uint16_t IRrecv::_matchRepeat(volatile uint16_t *data_ptr,
+                              const uint64_t expected_bits,
+                              const uint8_t *expected_bytes,
+                              const bool use_bits,
+                              const uint16_t remaining,
+                              const uint16_t nbits,
+                              const uint16_t hdrmark,
+                              const uint32_t hdrspace,
+                              const uint16_t onemark,
+                              const uint32_t onespace,
+                              const uint16_t zeromark,
+                              const uint32_t zerospace,
+                              const uint16_t footermark,
+                              const uint32_t footerspace,
+                              const bool atleast,
+                              const uint8_t tolerance,
+                              const int16_t excess,
+                              const bool MSBfirst) {
+  if (use_bits ? nbits > 64 : nbits % 8 != 0) return 0;
+  // Calculate how much remaining buffer is required.
+  uint16_t min_remaining = nbits * 2;
+  if (hdrmark) min_remaining++;
+  if (hdrspace) min_remaining++;
+  if (footermark) min_remaining++;
+  // Don't need to extend for footerspace because it could be the end of message
+  if (remaining < min_remaining) return 0;  // Not enough left to be a copy.
+  uint16_t offset = 0;
+
+  // Header
+  if (hdrmark && !matchMark(*(data_ptr + offset++), hdrmark, tolerance, excess))
+    return 0;
+  if (hdrspace && !matchSpace(*(data_ptr + offset++), hdrspace, tolerance,
+                              excess))
+    return 0;
+
+  // Data
+  const bit_windows_t windows = _bitWindows(onemark, onespace,
+                                            zeromark, zerospace,
+                                            tolerance, excess);
+  if (use_bits) {  // Bits.
+    if (!_matchExpected(data_ptr + offset, expected_bits, nbits, &windows,
+                        MSBfirst))
+      return 0;
+    offset += nbits * 2;
+  } else {  // Bytes. Each in the bit order given, first byte first.
+    for (uint16_t i = 0; i < nbits / 8; i++, offset += 16)
+      if (!_matchExpected(data_ptr + offset, expected_bytes[i], 8, &windows,
+                          MSBfirst))
+        return 0;
+  }
+
+  // Footer
+  if (footermark && !matchMark(*(data_ptr + offset++), footermark, tolerance,
+                               excess))
+    return 0;
+  // If we have something still to match & haven't reached the end of the buffer
+  if (footerspace && offset < remaining) {
+    if (atleast) {
+      if (!matchAtLeast(*(data_ptr + offset), footerspace, tolerance, excess))
+        return 0;
+    } else {
+      if (!matchSpace(*(data_ptr + offset), footerspace, tolerance, excess))
+        return 0;
+    }
+    offset++;
+  }
+  return offset;
+}
+
+/// Check that a repeated copy of a generic/typical <= 64bit IR message is
+/// exactly what we expect. e.g. The value decoded from the first copy.
+/// Faster than decoding the copy & comparing it, & fails on the first pulse
+/// that differs.
+/// @note Values of 0 for hdrmark, hdrspace, footermark, or footerspace mean
+///   skip that requirement.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] expected The bits we expect.
+/// @param[in] remaining The size of the capture buffer remaining.
+/// @param[in] nbits Nr. of data bits we expect.
+/// @param[in] hdrmark Nr. of uSeconds for the expected header mark signal.
+/// @param[in] hdrspace Nr. of uSeconds for the expected header space signal.
+/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
+/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
+/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
+/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
+/// @param[in] footermark Nr. of uSeconds for the expected footer mark signal.
+/// @param[in] footerspace Nr. of uSeconds for the expected footer space/gap
+///   signal.
+/// @param[in] atleast Is the match on the footerspace a matchAtLeast or
+///   matchSpace?
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @param[in] MSBfirst Bit order of `expected`. (Def: true)
+///   true is Most Significant Bit First Order, false is Least Significant First
+/// @return If it matched, how many buffer entries were used. Otherwise 0.
+uint16_t IRrecv::matchRepeat(volatile uint16_t *data_ptr,
+                             const uint64_t expected,
+                             const uint16_t remaining,
+                             const uint16_t nbits,
+                             const uint16_t hdrmark,
+                             const uint32_t hdrspace,
+                             const uint16_t onemark,
+                             const uint32_t onespace,
+                             const uint16_t zeromark,
+                             const uint32_t zerospace,
+                             const uint16_t footermark,
+                             const uint32_t footerspace,
+                             const bool atleast,
+                             const uint8_t tolerance,
+                             const int16_t excess,
+                             const bool MSBfirst) {
+  return _matchRepeat(data_ptr, expected, NULL, true, remaining, nbits,
+                      hdrmark, hdrspace, onemark, onespace,
+                      zeromark, zerospace, footermark, footerspace, atleast,
+                      tolerance, excess, MSBfirst);
+}
+
+/// Check that a repeated copy of a generic/typical > 64bit IR message is
+/// exactly what we expect. e.g. The state decoded from the first copy.
+/// @note Values of 0 for hdrmark, hdrspace, footermark, or footerspace mean
+///   skip that requirement.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[in] expected A ptr to the bytes we expect. The first byte is the
+///   first one in the message.
+/// @param[in] remaining The size of the capture buffer remaining.
+/// @param[in] nbits Nr. of data bits we expect. A multiple of 8.
+/// @param[in] hdrmark Nr. of uSeconds for the expected header mark signal.
+/// @param[in] hdrspace Nr. of uSeconds for the expected header space signal.
+/// @param[in] onemark Nr. of uSeconds in an expected mark signal for a '1' bit.
+/// @param[in] onespace Nr. of uSecs in an expected space signal for a '1' bit.
+/// @param[in] zeromark Nr. of uSecs in an expected mark signal for a '0' bit.
+/// @param[in] zerospace Nr. of uSecs in an expected space signal for a '0' bit.
+/// @param[in] footermark Nr. of uSeconds for the expected footer mark signal.
+/// @param[in] footerspace Nr. of uSeconds for the expected footer space/gap
+///   signal.
+/// @param[in] atleast Is the match on the footerspace a matchAtLeast or
+///   matchSpace?
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @param[in] MSBfirst Bit order of each expected byte. (Def: true)
+///   true is Most Significant Bit First Order, false is Least Significant First
+/// @return If it matched, how many buffer entries were used. Otherwise 0.
+uint16_t IRrecv::matchRepeat(volatile uint16_t *data_ptr,
+                             const uint8_t *expected,
+                             const uint16_t remaining,
+                             const uint16_t nbits,
+                             const uint16_t hdrmark,
+                             const uint32_t hdrspace,
+                             const uint16_t onemark,
+                             const uint32_t onespace,
+                             const uint16_t zeromark,
+                             const uint32_t zerospace,
+                             const uint16_t footermark,
+                             const uint32_t footerspace,
+                             const bool atleast,
+                             const uint8_t tolerance,
+                             const int16_t excess,
+                             const bool MSBfirst) {
+  return _matchRepeat(data_ptr, 0, expected, false, remaining, nbits,
+                      hdrmark, hdrspace, onemark, onespace,
+                      zeromark, zerospace, footermark, footerspace, atleast,
+                      tolerance, excess, MSBfirst);
+}
+
+/// Decode a message of a simple pulse-distance protocol described by a
+/// `pulse_distance_t`.
+/// @param[in,out] results Ptr to the data to decode & where to store the result
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data. Typically/Defaults to kStartOffset.
+/// @param[in] protocol A ptr to the description of the protocol.
+/// @param[in] nbits The number of data bits to expect.
+/// @param[in] strict Flag indicating if we should perform strict matching.
+///   i.e. Only accept the nr. of bits the protocol describes.
+/// @return True if it can decode it, false if it can't.
+bool IRrecv::decodePulseDistance(decode_results *results, uint16_t offset,
+                                 const pulse_distance_t *protocol,
+                                 const uint16_t nbits, const bool strict) {
+  if (strict && nbits != protocol->nbits) return false;
+  if (offset >= results->rawlen) return false;
+
+  uint64_t data = 0;
+  // Match Header + Data + Footer
+  if (!matchGeneric(results->rawbuf + offset, &data,
+                    results->rawlen - offset, nbits,
+                    protocol->hdrmark, protocol->hdrspace,
+                    protocol->onemark, protocol->onespace,
+                    protocol->zeromark, protocol->zerospace,
+                    protocol->footermark, protocol->gap, true,
+                    kUseDefTol, kMarkExcess, protocol->MSBfirst))
+    return false;
+  // Success
+  results->bits = nbits;
+  results->value = data;
+  results->decode_type = protocol->protocol;
+  results->command = 0;
+  results->address = 0;
+  return true;
+}
+
+/// Try to decode a message as each of a table of simple pulse-distance
+/// protocols, in order, at their described sizes.
+/// The first captured mark is measured once, & only the protocols it could
+/// possibly be the first mark of have their data matched.
+/// @param[in,out] results Ptr to the data to decode & where to store the result
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data. Typically/Defaults to kStartOffset.
+/// @param[in] protocols The table of protocol descriptions.
+/// @param[in] count The nr. of entries in the table.
+/// @return True if any of them can decode it, false if none can.
+bool IRrecv::decodePulseDistances(decode_results *results, uint16_t offset,
+                                  const pulse_distance_t protocols[],
+                                  const uint16_t count) {
+  if (offset >= results->rawlen) return false;
+  _setHeaderWindow(results->rawbuf[offset]);
+  for (uint16_t i = 0; i < count; i++) {
+    const pulse_distance_t *protocol = &protocols[i];
+    if (protocol->hdrmark) {
+      if (!_headerMayMatch(protocol->hdrmark)) continue;
+    } else if (!_headerMayMatch(protocol->onemark) &&
+               !_headerMayMatch(protocol->zeromark)) {
+      continue;
+    }
+    if (decodePulseDistance(results, offset, protocol, protocol->nbits))
+      return true;
+  }
+  return false;
+}
+
+#if ENABLE_CUSTOM_PROTOCOLS
+/// Try to decode a message as each of the protocols registered at run time.
+/// See `ircustom::add()`. `decode()` tries them after the built-in ones.
+/// Like `decodePulseDistances()`, only those whose first mark could match are
+/// matched any further.
+/// @param[in,out] results Ptr to the data to decode & where to store the result
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data. Typically/Defaults to kStartOffset.
+/// @return True if any of them can decode it, false if none can.
+bool IRrecv::decodeCustom(decode_results *results, uint16_t offset) {
+  if (!ircustom::count() || offset >= results->rawlen) return false;
+  _setHeaderWindow(results->rawbuf[offset]);
+  for (uint8_t i = 0; i < kMaxCustomProtocols; i++) {
+    const custom_protocol_t *custom = ircustom::get(
+        (decode_type_t)(kFirstCustomType + i));
+    if (custom == NULL) continue;
+    const pulse_distance_t *protocol = &custom->timing;
+    if (!_attempt(protocol->protocol)) continue;
+    if (protocol->hdrmark) {
+      if (!_headerMayMatch(protocol->hdrmark)) continue;
+    } else if (!_headerMayMatch(protocol->onemark) &&
+               !_headerMayMatch(protocol->zeromark)) {
+      continue;
+    }
+    if (decodePulseDistance(results, offset, protocol, protocol->nbits))
+      return true;
+  }
+  return false;
+}
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+
+/// Match & decode a multi-section A/C message described by an `ac_sections_t`.
+/// The data is stored at `state`.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @note `data_ptr` is assumed to be pointing to a "Mark", not a "Space".
+/// @param[out] state A ptr to where to start storing the bytes we decoded.
+/// @param[in] remaining The size of the capture buffer remaining.
+/// @param[in] nbytes Nr. of bytes of data we expect in the whole message.
+/// @param[in] frame A ptr to the description of the message's sections.
+/// @param[in] strict Verify each of the `frame`'s checksums as soon as the
+///   section it ends in has been matched.
+/// @param[in] tolerance Percentage error margin to allow. (Default: kUseDefTol)
+/// @param[in] excess Nr. of uSeconds. (Def: kMarkExcess)
+/// @return If successful, how many buffer entries were used. Otherwise 0.
+/// @note A bad header or checksum in the first section fails the match
+///   without the remaining sections being looked at.
+/// @note If partial decoding is allowed (See `setPartialDecode()`) & the
+///   capture overflowed, it runs out part way through a later section, the
+///   sections before it are a match. `decode()` then reports it as truncated.
+uint16_t IRrecv::matchSections(volatile uint16_t *data_ptr, uint8_t *state,
+                               const uint16_t remaining, const uint16_t nbytes,
+                               const ac_sections_t *frame, const bool strict,
+                               const uint8_t tolerance, const int16_t excess) {
+  return _matchSectionsFrom(data_ptr, state, remaining, nbytes, frame, 0, 0,
+                            strict, tolerance, excess);
+}
+
+/// Match & decode the sections of a multi-section A/C message from a given
+/// section onwards. i.e. The guts of `matchSections()`.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[out] state A ptr to the start of the whole message's bytes.
+/// @param[in] remaining The size of the capture buffer remaining.
+/// @param[in] nbytes Nr. of bytes of data we expect in the whole message.
+/// @param[in] frame A ptr to the description of the message's sections.
+/// @param[in] first The section `data_ptr` is at the start of.
+/// @param[in] start The byte of `state` that section starts at.
+/// @param[in] strict See `matchSections()`.
+/// @param[in] tolerance See `matchSections()`.
+/// @param[in] excess See `matchSections()`.
+/// @return If successful, how many buffer entries were used. Otherwise 0.
+uint16_t IRrecv::_matchSectionsFrom(volatile uint16_t *data_ptr,
+                                    uint8_t *state, const uint16_t remaining,
+                                    const uint16_t nbytes,
+                                    const ac_sections_t *frame,
+                                    const uint8_t first, const uint16_t start,
+                                    const bool strict, const uint8_t tolerance,
+                                    const int16_t excess) {
+  uint16_t offset = 0;
+  uint16_t pos = start;
+  for (uint8_t section = first; section < frame->sections; section++) {
+    const bool last = section + 1 >= frame->sections;
+    if (!last && nbytes < pos + frame->sizes[section]) return 0;
+    const uint16_t size = last ? nbytes - pos : frame->sizes[section];
+    // Section Header + Section Data + Section Footer
+    const uint16_t used = matchGeneric(data_ptr + offset, state + pos,
+                                       remaining - offset, size * 8,
+                                       frame->hdrmark, frame->hdrspace,
+                                       frame->onemark, frame->onespace,
+                                       frame->zeromark, frame->zerospace,
+                                       frame->footermark, frame->gap, last,
+                                       tolerance, excess, frame->MSBfirst);
+    if (used == 0) {
+#if ENABLE_PARTIAL_DECODE
+      // Did an overflowed capture run out part way through this section?
+      if (_partial_ok && section > first &&
+          remaining - offset < 2 * size * 8 + kHeader + kFooter - 1) {
+        memset(state + pos, 0, nbytes - pos);  // We know nothing of the rest.
+        _trunc_frame = frame;
+        _trunc_nbytes = nbytes;
+        _trunc_pos = pos;
+        _trunc_section = section;
+        _trunc_strict = strict;
+        _trunc_tolerance = tolerance;
+        _trunc_excess = excess;
+        return offset;
+      }
+#endif  // ENABLE_PARTIAL_DECODE
+      return 0;
+    }
+    offset += used;
+    if (strict) {
+      // Check any checksum that ends in this section.
+      for (uint8_t i = 0; i < frame->nchecksums; i++) {
+        const irutils::checksum_t &checksum = frame->checksums[i];
+        const uint16_t end = (checksum.length == irutils::kChecksumToEnd) ?
+            nbytes : checksum.start + checksum.length;
+        if (end > pos && end <= pos + size &&
+            !irutils::validChecksums(&checksum, 1, state, nbytes))
+          return 0;
+      }
+    }
+    pos += size;
+  }
+  return offset;
+}
+
+/// Could an overflowed capture, too short for the whole of a multi-section
+/// message, still hold its first section? i.e. Is it worth a partial decode?
+/// @param[in] results Ptr to the data to decode.
+/// @param[in] offset The index of the start of the message's first section.
+/// @param[in] frame A ptr to the description of the message's sections.
+/// @return true, if it is worth trying. Otherwise false.
+/// @see setPartialDecode()
+bool IRrecv::_sectionsMayFit(const decode_results *results,
+                             const uint16_t offset,
+                             const ac_sections_t *frame) {
+#if ENABLE_PARTIAL_DECODE
+  return _partial_ok && frame->sections > 1 &&
+      results->rawlen >= offset + 2 * frame->sizes[0] * 8 + kHeader + kFooter -
+                         1;
+#else  // ENABLE_PARTIAL_DECODE
+  (void)results;
+  (void)offset;
+  (void)frame;
+  return false;
+#endif  // ENABLE_PARTIAL_DECODE
 }
 
 /// Match & decode a generic/typical constant bit time <= 64bit IR message.
@@ -1397,8 +6085,6 @@ uint16_t IRrecv::matchGenericConstBitTime(volatile uint16_t *data_ptr,
                                           const uint8_t tolerance,
                                           const int16_t excess,
                                           const bool MSBfirst) {
-  uint16_t offset = 0;
-  uint64_t result = 0;
   // If we expect a footermark, then this can be processed like normal.
   if (footermark)
     return _matchGeneric(data_ptr, result_ptr, NULL, true, remaining, nbits,
@@ -1406,22 +6092,36 @@ uint16_t IRrecv::matchGenericConstBitTime(volatile uint16_t *data_ptr,
                          footermark, footerspace, atleast,
                          tolerance, excess, MSBfirst);
   // Overwise handle like normal, except for the last bit. and no footer.
-  uint16_t bits = (nbits > 0) ? nbits - 1 : 0;  // Make sure we don't underflow.
-  offset = _matchGeneric(data_ptr, &result, NULL, true, remaining, bits,
-                         hdrmark, hdrspace, one, zero, zero, one, 0, 0, false,
-                         tolerance, excess, true);
-  if (!offset) return 0;  // Didn't match.
+  if (!nbits || nbits > 64) return 0;
+  uint16_t offset = 0;
+  // Header
+  if (hdrmark) {
+    if (remaining <= offset ||
+        !matchMark(*(data_ptr + offset++), hdrmark, tolerance, excess))
+      return 0;
+  }
+  if (hdrspace) {
+    if (remaining <= offset ||
+        !matchSpace(*(data_ptr + offset++), hdrspace, tolerance, excess))
+      return 0;
+  }
+  // Data
+  // Quantize once. i.e. The windows are computed once for all the bits.
+  const bit_windows_t windows = _bitWindows(one, zero, zero, one,
+                                            tolerance, excess);
+  const uint16_t bits = nbits - 1;
+  if (remaining < offset + bits * 2 + 1) return 0;  // Not enough buffer.
+  const match_result_t data = _matchData(data_ptr + offset, bits, &windows);
+  if (!data.success) return 0;  // Didn't match.
+  offset += data.used;
   // Now for the last bit.
-  if (remaining <= offset) return 0;  // Not enough buffer.
-  result <<= 1;
+  uint64_t result = data.data << 1;
   bool last_bit = 0;
   // Is the mark a '1' or a `0`?
   if (matchMark(*(data_ptr + offset), one, tolerance, excess)) {  // 1
     last_bit = 1;
     result |= 1;
-  } else if (matchMark(*(data_ptr + offset), zero, tolerance, excess)) {  // 0
-    last_bit = 0;
-  } else {
+  } else if (!matchMark(*(data_ptr + offset), zero, tolerance, excess)) {  // 0
     return 0;  // It's neither, so fail.
   }
   offset++;
@@ -1673,3 +6373,113 @@ uint16_t IRrecv::matchManchesterData(volatile const uint16_t *data_ptr,
   return offset;
 }
 // End of IRrecv class -------------------
+
+// decode_state_pool class ------------------
+
+/// Class constructor
+/// @param[in] slots Nr. of states the pool can hold at once.
+/// @note If the memory can't be allocated, the pool has no slots.
+decode_state_pool::decode_state_pool(const uint16_t slots) {
+  _states = new uint8_t[slots * kStateSizeMax];
+  _used = new bool[slots];
+  if (_states == NULL || _used == NULL) {
+    delete[] _states;
+    delete[] _used;
+    _states = NULL;
+    _used = NULL;
+    _slots = 0;
+  } else {
+    _slots = slots;
+  }
+  for (uint16_t i = 0; i < _slots; i++) _used[i] = false;
+  _free = _slots;
+}
+
+/// Class destructor
+decode_state_pool::~decode_state_pool(void) {
+  delete[] _states;
+  delete[] _used;
+}
+
+/// Get the nr. of slots in the pool.
+/// @return The nr. of slots. 0 if the memory couldn't be allocated.
+uint16_t decode_state_pool::getSlots(void) const { return _slots; }
+
+/// Get the nr. of slots not in use.
+/// @return The nr. of free slots.
+uint16_t decode_state_pool::getFree(void) const { return _free; }
+
+/// Make a slim copy of a decoded message. Any state is copied into the pool.
+/// @param[in] results A PTR to the decoded message.
+/// @param[out] slim A PTR to where to store the slim copy.
+/// @return true, if it was copied. false, if the pool had no free slot.
+bool decode_state_pool::slim(const decode_results *results,
+                             slim_results_t *slim) {
+  slim->slot = kNoStateSlot;
+  if (hasACState(results->decode_type)) {
+    if (!_free) return false;
+    uint16_t slot = 0;
+    while (_used[slot]) slot++;
+    _used[slot] = true;
+    _free--;
+    slim->slot = slot;
+    memcpy(_states + slot * kStateSizeMax, results->state, kStateSizeMax);
+    slim->value = 0;
+    slim->address = 0;
+    slim->command = 0;
+  } else {
+    slim->value = results->value;
+    slim->address = results->address;
+    slim->command = results->command;
+  }
+  slim->decode_type = results->decode_type;
+  slim->bits = results->bits;
+  slim->repeat = results->repeat;
+  slim->repeats = results->repeats;
+  slim->started = results->started;
+  slim->stopped = results->stopped;
+  slim->decoded = results->decoded;
+  return true;
+}
+
+/// Turn a slim copy back into a decoded message, & free its slot.
+/// @param[in,out] slim A PTR to the slim copy. It no longer has a state after.
+/// @param[out] results A PTR to where to store the decoded message.
+/// @return true, if it was expanded. false, if its state wasn't in the pool.
+/// @note The capture isn't kept, so `rawbuf` is NULL & `rawlen` is 0.
+bool decode_state_pool::expand(slim_results_t *slim,
+                               decode_results *results) {
+  if (slim->slot != kNoStateSlot) {
+    if (slim->slot >= _slots || !_used[slim->slot]) return false;
+    memcpy(results->state, _states + slim->slot * kStateSizeMax,
+           kStateSizeMax);
+    release(slim);
+  } else {
+    results->value = slim->value;
+    results->address = slim->address;
+    results->command = slim->command;
+  }
+  results->decode_type = slim->decode_type;
+  results->bits = slim->bits;
+  results->rawbuf = NULL;
+  results->rawlen = 0;
+  results->overflow = false;
+  results->repeat = slim->repeat;
+  results->repeats = slim->repeats;
+  results->started = slim->started;
+  results->stopped = slim->stopped;
+  results->decoded = slim->decoded;
+  return true;
+}
+
+/// Free the slot holding the state of a slim copy, if it has one.
+/// e.g. When a queued result is discarded rather than expanded.
+/// @param[in,out] slim A PTR to the slim copy. It no longer has a state after.
+void decode_state_pool::release(slim_results_t *slim) {
+  if (slim->slot < _slots && _used[slim->slot]) {
+    _used[slim->slot] = false;
+    _free++;
+  }
+  slim->slot = kNoStateSlot;
+}
+// End of decode_state_pool class -------------------
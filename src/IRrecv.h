@@ -13,6 +13,24 @@
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
 #include "IRremoteESP8266.h"
+#include "IRhal.h"
+#include "IRtimer.h"
+
+// The decode task is handed its captures via the capture ring.
+#if defined(ESP32) && ENABLE_ESP32_DECODE_TASK && ENABLE_CAPTURE_RING && \
+    !defined(UNIT_TEST)
+#define IRRECV_DECODE_TASK true
+#else  // defined(ESP32) && ENABLE_ESP32_DECODE_TASK && ...
+#define IRRECV_DECODE_TASK false
+#endif  // defined(ESP32) && ENABLE_ESP32_DECODE_TASK && ...
+
+// A task fills a large capture buffer, as the GPIO interrupt handler can't.
+#if defined(ESP32) && ENABLE_LARGE_CAPTURE && !ENABLE_ESP32_RMT_RECV && \
+    !defined(UNIT_TEST)
+#define IRRECV_DRAIN_TASK true
+#else  // defined(ESP32) && ENABLE_LARGE_CAPTURE && ...
+#define IRRECV_DRAIN_TASK false
+#endif  // defined(ESP32) && ENABLE_LARGE_CAPTURE && ...
 
 // Constants
 const uint16_t kHeader = 2;        // Usual nr. of header entries.
@@ -22,6 +40,11 @@ const uint16_t kStartOffset = 1;   // Usual rawbuf entry to start from.
 // Marks tend to be 100us too long, and spaces 100us too short
 // when received due to sensor lag.
 const uint16_t kMarkExcess = 50;
+// Largest sensor lag (uSecs) `IRrecv::setMarkExcess()` will accept.
+const int16_t kMaxMarkExcess = 250;
+// Min. nr. of marks & spaces measured before a calibrated excess is used.
+// See: `IRrecv::stopMarkExcessCalibration()`.
+const uint16_t kMarkExcessMinSamples = 32;
 const uint16_t kRawBuf = 100;  // Default length of raw capture buffer
 const uint64_t kRepeat = UINT64_MAX;
 // Default min size of reported UNKNOWN messages.
@@ -34,6 +57,13 @@ const uint8_t kSpaceState = 4;
 const uint8_t kStopState = 5;
 const uint8_t kTolerance = 25;   // default percent tolerance in measurements.
 const uint8_t kUseDefTol = 255;  // Indicate to use the class default tolerance.
+// Extra percentage added to the tolerance when deciding which decoders to try.
+const uint8_t kHeaderDispatchExtraTolerance = 25;
+// Spaces (uSecs) at least this long end the data bits when telling apart the
+// variants of a protocol by length. Longer than the `1` space (+ tolerance) of
+// LG, Samsung, Mitsubishi, Mitsubishi Heavy, Sanyo LC7461 & Hitachi, & shorter
+// than any of their gaps.
+const uint16_t kVariantMaxBitSpace = 3000;
 const uint16_t kRawTick = 2;     // Capture tick to uSec factor.
 #define RAWTICK kRawTick  // Deprecated. For legacy user code support only.
 // How long (ms) before we give up wait for more data?
@@ -44,9 +74,42 @@ const uint16_t kRawTick = 2;     // Capture tick to uSec factor.
 // before we need to start capturing a possible new message.
 // Typically 15ms suits most applications. However, some protocols demand a
 // higher value. e.g. 90ms for XMP-1 and some aircon units.
+// See `IRrecv::enableAdaptiveTimeout()` to only wait that long when the
+// message's header says it needs it.
 const uint8_t kTimeoutMs = 15;  // In MilliSeconds.
 #define TIMEOUT_MS kTimeoutMs   // For legacy documentation.
 const uint16_t kMaxTimeoutMs = kRawTick * (UINT16_MAX / MS_TO_USEC(1));
+// Compact capture buffer encoding. See: `IRrecv::enableCompactCapture()`.
+const uint8_t kPackedTickRatio = 8;  // kRawTick units per byte unit. i.e. 16us
+const uint8_t kPackedEscape = 0xFF;  // The next two bytes are the duration.
+const uint8_t kPackedEscapeSize = 3;  // Nr. of bytes an escaped entry uses.
+// How long (uSecs) of no signal before `decodeEarly()` tries to decode.
+// Longer than the spaces within most simple protocols. e.g. NEC's header.
+const uint16_t kEarlyDecodeQuiet = 5000;
+// How long (ms) after a message (or its last repeat) that an identical message
+// is still a repeat of it. See: `IRrecv::enableRepeatCoalescing()`.
+// Longer than the ~110ms most remotes take between repeats. e.g. NEC.
+const uint16_t kRepeatCoalesceMs = 150;
+// Defaults for the gaming receive profile. See `IRrecv::enableGamingMode()`.
+// How long (ms) of quiet ends a capture. Well past the longest space within a
+// MagiQuest or Lasertag message (<1ms), & well short of the gap between them.
+const uint8_t kGamingGapMs = 3;
+// How long (ms) after a player's message that an identical one is a duplicate.
+const uint16_t kGamingDedupMs = 250;
+const uint8_t kGamingPlayers = 8;  // Nr. of players tracked for duplicates.
+const uint8_t kGamingCaptureSlots = 8;  // Nr. of capture ring slots to use.
+// Default nr. of messages the decode cache remembers the protocol of.
+// See: `IRrecv::enableDecodeCache()`.
+const uint8_t kDecodeCacheSize = 12;
+// Default nr. of events the decode trace holds. See: `IRrecv::enableDecodeTrace()`.
+const uint16_t kDecodeTraceSize = 128;
+// A timing error of at least this (% of the tolerance) is near the limit of
+// matching at all. See: `signal_quality_t`.
+const uint8_t kNearTolerance = 75;
+// How long (uSecs) from the edge that wakes a light-sleeping CPU until the
+// interrupt handler sees it. Only a rough figure. It varies by board & SDK.
+// See: `IRrecv::setWakeLatency()`.
+const uint16_t kWakeLatency = 1000;
 
 // Use FNV hash algorithm: http://isthe.com/chongo/tech/comp/fnv/#FNV-param
 const uint32_t kFnvPrime32 = 16777619UL;
@@ -54,17 +117,92 @@ const uint32_t kFnvBasis32 = 2166136261UL;
 
 // Which of the ESP32 timers to use by default. (0-3)
 const uint8_t kDefaultESP32Timer = 3;
+// Which of the ESP32 RMT channels to use by default when receiving. (0-7)
+// Only used when ENABLE_ESP32_RMT_RECV is set. Any other receivers use the
+// channels after it. See kESP32RmtChannelsPerReceiver.
+const uint8_t kDefaultESP32RmtChannel = 0;
+const uint8_t kESP32RmtChannels = 8;  // Nr. of RMT channels the ESP32 has.
 
-#if DECODE_AC
-// Hitachi AC is the current largest state size.
-const uint16_t kStateSizeMax = kHitachiAc2StateLength;
-#else
-// Just define something
-const uint16_t kStateSizeMax = 0;
-#endif
+// Max. nr. of IRrecv instances that can be capturing at the same time.
+// Note: Each one needs its own interrupt handler in IRrecv.cpp.
+const uint8_t kMaxReceivers = 4;
+// Nr. of RMT channels (& their memory blocks) each receiver can use.
+const uint8_t kESP32RmtChannelsPerReceiver = kESP32RmtChannels / kMaxReceivers;
+// Defaults for the ESP32 decode task. See `IRrecv::startDecodeTask()`.
+const uint8_t kDecodeTaskSlots = 4;  // Nr. of capture ring slots to use.
+const uint8_t kDecodeTaskQueueLength = 4;  // Nr. of decoded messages queued.
+const uint8_t kDecodeTaskCore = 0;   // Arduino runs `loop()` on core 1.
+const uint8_t kDecodeTaskPriority = 2;  // Just above `loop()`'s priority.
+const uint16_t kDecodeTaskStackSize = 4096;  // In bytes.
+// Defaults for large capture buffers. See `IRrecv::enableLargeCapture()`.
+// Nr. of entries the interrupt handler can capture ahead of the drain task.
+const uint16_t kLargeCaptureStaging = 64;
+const uint8_t kDrainTaskPriority = 3;  // Above the decode task's & `loop()`'s.
+const uint16_t kDrainTaskStackSize = 2048;  // In bytes.
+
+// The largest `decode_results::state` any of the enabled decoders produce.
+// i.e. Disabling the protocols with the largest states makes every
+// `decode_results` smaller. Listed from the largest state to the smallest.
+// Note: MWM messages vary in length, so it keeps the old (Hitachi AC) size.
+const uint16_t kStateSizeMax =
+    (DECODE_HITACHI_AC2 || DECODE_MWM) ? kHitachiAc2StateLength :
+    DECODE_HITACHI_AC424 ? kHitachiAc424StateLength :
+    DECODE_HITACHI_AC344 ? kHitachiAc344StateLength :
+    DECODE_DAIKIN2 ? kDaikin2StateLength :
+    DECODE_DAIKIN ? kDaikinStateLength :
+    DECODE_HITACHI_AC ? kHitachiAcStateLength :
+    DECODE_DAIKIN216 ? kDaikin216StateLength :
+    DECODE_HITACHI_AC3 ? kHitachiAc3StateLength :
+    DECODE_PANASONIC_AC ? kPanasonicAcStateLength :
+    DECODE_DAIKIN176 ? kDaikin176StateLength :
+    DECODE_CORONA_AC ? kCoronaAcStateLength :
+    DECODE_SAMSUNG_AC ? kSamsungAcExtendedStateLength :
+    DECODE_WHIRLPOOL_AC ? kWhirlpoolAcStateLength :
+    DECODE_DAIKIN160 ? kDaikin160StateLength :
+    DECODE_DAIKIN152 ? kDaikin152StateLength :
+    DECODE_MITSUBISHIHEAVY ? kMitsubishiHeavy152StateLength :
+    DECODE_MITSUBISHI_AC ? kMitsubishiACStateLength :
+    DECODE_MITSUBISHI136 ? kMitsubishi136StateLength :
+    DECODE_FUJITSU_AC ? kFujitsuAcStateLength :
+    DECODE_KELVINATOR ? kKelvinatorStateLength :
+    DECODE_DAIKIN128 ? kDaikin128StateLength :
+    DECODE_HAIER_AC_YRW02 ? kHaierACYRW02StateLength :
+    DECODE_TCL112AC ? kTcl112AcStateLength :
+    DECODE_MITSUBISHI112 ? kMitsubishi112StateLength :
+    DECODE_HITACHI_AC1 ? kHitachiAc1StateLength :
+    DECODE_ELECTRA_AC ? kElectraAcStateLength :
+    DECODE_SHARP_AC ? kSharpAcStateLength :
+    DECODE_ARGO ? kArgoStateLength :
+    DECODE_NEOCLIMA ? kNeoclimaStateLength :
+    DECODE_TOSHIBA_AC ? kToshibaACStateLengthLong :
+    DECODE_VOLTAS ? kVoltasStateLength :
+    DECODE_HAIER_AC ? kHaierACStateLength :
+    DECODE_TROTEC ? kTrotecStateLength :
+    DECODE_SANYO_AC ? kSanyoAcStateLength :
+    DECODE_GREE ? kGreeStateLength :
+    DECODE_AMCOR ? kAmcorStateLength :
+    0;  // Nothing enabled uses it.
 
 // Types
 
+/// A completed capture held in a slot of the capture ring.
+typedef struct {
+  uint16_t *rawbuf;  // raw data
+  uint16_t rawlen;   // counter of entries in rawbuf.
+  uint8_t overflow;  // Buffer overflow indicator.
+  uint32_t started;  // When the first edge was seen. (uSeconds)
+  uint32_t stopped;  // When the capture ended. (uSeconds)
+#if ENABLE_PARTIAL_DECODE
+  uint8_t continued;  // Did it carry straight on from an overflowed capture?
+#endif  // ENABLE_PARTIAL_DECODE
+#if ENABLE_CAPTURE_HASH
+  uint32_t hash;     // The decodeHash() hash of the capture.
+  uint8_t hashed;    // Is `hash` valid?
+#endif  // ENABLE_CAPTURE_HASH
+} ircapture_t;
+
+class IRsend;  // See IRsend.h
+
 /// Information for the interrupt handler
 typedef struct {
   uint8_t recvpin;   // pin for IR data from detector
@@ -77,6 +215,59 @@ typedef struct {
   uint16_t rawlen;   // counter of entries in rawbuf.
   uint8_t overflow;  // Buffer overflow indicator.
   uint8_t timeout;   // Nr. of milliSeconds before we give up.
+  uint32_t lastedge;  // When the latest edge was seen. (uSeconds)
+  uint32_t started;   // When the first edge of the capture was seen. (uSeconds)
+  uint32_t stopped;   // When the capture ended. e.g. The timeout. (uSeconds)
+#if ENABLE_CAPTURE_RING
+  ircapture_t *ring;  // Capture slots. Only used when `slots` is non-zero.
+  uint8_t slots;      // Nr. of slots in the capture ring. 0 means not in use.
+  uint8_t head;       // Slot the interrupt handler is capturing into.
+  uint8_t tail;       // Oldest completed slot waiting to be decoded.
+  uint8_t highwater;  // Most completed slots that have been waiting at once.
+  uint16_t drops;     // Nr. of completed captures lost as the ring was full.
+#if ENABLE_PARTIAL_DECODE
+  uint8_t continued;  // Is it carrying straight on from an overflowed capture?
+#endif  // ENABLE_PARTIAL_DECODE
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+  uint8_t *packed;     // Compact capture buffer. Only used when non-NULL.
+  uint16_t packedlen;  // Nr. of bytes used in `packed`.
+#endif  // ENABLE_COMPACT_CAPTURE
+#if IRRECV_DECODE_TASK
+  void *task;  // The decode task to wake when a capture ends. NULL if none.
+#endif  // IRRECV_DECODE_TASK
+#if ENABLE_CAPTURE_HASH
+  uint32_t hash;          // The decodeHash() hash of the capture so far.
+  uint16_t hashticks[2];  // The last two entries. i.e. What to compare with.
+  uint8_t hashed;         // Is `hash` valid? i.e. Built from the first entry.
+#endif  // ENABLE_CAPTURE_HASH
+#if ENABLE_ADAPTIVE_TIMEOUT
+  uint8_t gap;       // Nr. of mSecs of quiet that end a capture. 0 if unused.
+  uint8_t wait;      // Nr. of mSecs of quiet that end the current capture.
+  uint16_t hdrmark;  // The first mark of the current capture. (kRawTick units)
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if ENABLE_GLITCH_FILTER
+  uint16_t glitch;  // Entries shorter than this are noise. (kRawTick units)
+#endif  // ENABLE_GLITCH_FILTER
+#if ENABLE_ECHO_SUPPRESSION
+  const ir_echo_t *echo;  // When our own transmitter is sending. NULL if n/a.
+#endif  // ENABLE_ECHO_SUPPRESSION
+#if ENABLE_IR_MIRROR
+  IRsend *mirror;    // Where each edge is repeated to, at once. NULL if n/a.
+  uint8_t mirrored;  // Is the mirror lit?
+#endif  // ENABLE_IR_MIRROR
+#if ENABLE_LOW_POWER_RECV
+  uint16_t wake;  // uSecs to credit the next capture with. i.e. Waking up.
+#endif  // ENABLE_LOW_POWER_RECV
+#if ENABLE_LARGE_CAPTURE
+  uint16_t *staging;   // Where to capture to, if `rawbuf` is large. Else NULL.
+  uint16_t stagesize;  // Nr. of entries in `staging`. i.e. A ring of them.
+  uint16_t drained;    // Nr. of the capture's entries moved into `rawbuf`.
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_CARRIER_FILTER
+  bool rawinput;     // Is the input carrier pulses? i.e. Not demodulated.
+  uint32_t carrier;  // Carrier measured for the capture. (Hz) 0 if unknown.
+#endif  // ENABLE_CARRIER_FILTER
 } irparams_t;
 
 /// Results from a data match
@@ -86,8 +277,150 @@ typedef struct {
   uint16_t used;  // How many buffer positions were used.
 } match_result_t;
 
+/// What `IRrecv::matchBytes()` can verify part way through a message. Each
+/// check is made as soon as the last byte it needs has been matched, so a
+/// message from another protocol is given up on after a few bytes, rather
+/// than after all of them. The indexes are of the bytes being matched.
+typedef struct {
+  const irutils::checksum_t *checksums;  ///< Checked once their byte is in.
+  uint8_t nchecksums;                    ///< Nr. of entries in `checksums`.
+  const irutils::fixed_byte_t *fixed;    ///< Checked as they are matched.
+  uint8_t nfixed;                        ///< Nr. of entries in `fixed`.
+} byte_checks_t;
+
+/// Statistics on the attempts `decode()` made at a protocol.
+/// @see ENABLE_DECODE_PROFILING
+typedef struct {
+  uint32_t attempts;   // Nr. of times the protocol was tried.
+  uint32_t rejects;    // Nr. of those skipped due to the header timing alone.
+  uint32_t successes;  // Nr. of times the protocol was decoded.
+  uint32_t usecs;      // Total time spent trying it. (uSeconds)
+} decode_profile_t;
+
+/// The last message from a player. See `IRrecv::enableGamingMode()`.
+typedef struct {
+  decode_type_t type;  // UNKNOWN if the entry is unused.
+  uint64_t value;      // The whole message. i.e. Player/wand ID & all.
+  uint32_t seen;       // When it, or a duplicate of it, last arrived. (uSecs)
+} gaming_player_t;
+
+/// Which protocol decoded a message. See `IRrecv::enableDecodeCache()`.
+typedef struct {
+  uint32_t hash;           // decodeHash()'s hash of the message's capture.
+  uint16_t rawlen;         // Nr. of entries in its capture. 0 if unused.
+  decode_type_t protocol;  // The decoder that decoded it.
+  uint32_t used;           // When it was last decoded. (Nr. of decodes)
+} decode_cache_entry_t;
+
+/// The things `decode()` can record in the decode trace.
+/// @see IRrecv::enableDecodeTrace()
+enum decode_trace_event_t {
+  kTraceCapture = 0,     // Started on a capture. `value` is its `rawlen`.
+  kTraceAttempt,         // Attempted `protocol` at `offset`.
+  kTraceHeaderReject,    // Skipped it, due to the header mark (`value` usecs).
+  kTraceMarkMismatch,    // A mark of `value` usecs didn't match.
+  kTraceSpaceMismatch,   // A space of `value` usecs didn't match.
+  kTraceDecoded,         // Decoded it as `protocol`. `value` is the nr. of bits.
+  kTraceNotDecoded,      // Nothing decoded it.
+};
+
+/// An event in the decode trace. See `IRrecv::enableDecodeTrace()`.
+typedef struct {
+  uint32_t ticks;   // When. See `IRrecv::getDecodeTraceRate()`.
+  int16_t protocol;  // A decode_type_t. UNKNOWN if it isn't about one.
+  uint16_t offset;  // The capture entry the attempt started at.
+  uint16_t value;   // Depends on the event. e.g. A duration. (Max. 65535)
+  uint8_t event;    // A decode_trace_event_t.
+} decode_trace_t;
+
+// Nr. of entries needed to cover every decode_type_t. i.e. UNKNOWN & up.
+const uint16_t kDecodeTypeCount = kLastDecodeType - UNKNOWN + 1;
+// Nr. of bytes in a bitmask with a bit for every decode_type_t.
+const uint8_t kProtocolMaskSize = (kDecodeTypeCount + 7) / 8;
+
+/// A precomputed range of acceptable captured durations.
+typedef struct {
+  uint32_t low;   // Shortest acceptable duration. (in ticks)
+  uint32_t high;  // Longest acceptable duration. (in ticks)
+} match_window_t;
+
+#if ENABLE_PROTOCOL_TOLERANCE
+// Max. nr. of protocols `IRrecv::setProtocolTolerance()` can be used for.
+const uint8_t kMaxProtocolTolerances = 8;
+// Nr. of bits of fraction in the precomputed tolerance scales.
+const uint8_t kToleranceScaleBits = 16;
+
+/// A run time tolerance (& mark excess) for a protocol.
+typedef struct {
+  decode_type_t protocol;
+  uint8_t tolerance;  // Percent. Used in place of what the decoder asks for.
+  int16_t excess;     // Added to the decoder's mark excess. (uSecs)
+  uint32_t low;   // (100 - tolerance)%, in 1/2^kToleranceScaleBits units.
+  uint32_t high;  // (100 + tolerance)%, in 1/2^kToleranceScaleBits units.
+} protocol_tolerance_t;
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+
+#if ENABLE_CARRIER_FILTER
+// Default % a measured carrier may differ from a protocol's, & still match.
+// i.e. Enough for real remotes, but 36, 38 & 40kHz are still told apart.
+const uint8_t kCarrierTolerance = 5;
+// Longest gap between the carrier pulses of a single mark. (uSeconds)
+// i.e. A couple of periods of the lowest carrier in use. (~30kHz)
+const uint16_t kCarrierMaxGap = 100;
+
+/// The state of demodulating carrier pulses into marks & spaces.
+/// @see IRrecv::_demodulate()
+typedef struct {
+  uint32_t now;      // Time since the first pulse. (uSeconds)
+  uint32_t start;    // When the first pulse of the current mark started.
+  uint32_t last;     // When its latest pulse started.
+  uint16_t on;       // How long its latest pulse was. (uSeconds)
+  uint16_t pulses;   // Nr. of pulses in it. 0 if between marks.
+  uint32_t span;     // Time from the first to the last pulse of all marks.
+  uint32_t periods;  // Nr. of carrier periods in `span`.
+} carrier_demod_t;
+#endif  // ENABLE_CARRIER_FILTER
+
+/// Precomputed windows for matching each bit of a data section.
+typedef struct {
+  match_window_t onemark;
+  match_window_t onespace;
+  match_window_t zeromark;
+  match_window_t zerospace;
+  // Pulse distance encoded. i.e. Both bits have the same mark, and the spaces
+  // windows don't overlap, so a single compare tells a '1' from a '0'.
+  bool distance;
+  // Pulse width encoded. i.e. The marks windows don't overlap, so a single
+  // compare of each mark tells a '1' from a '0'. e.g. Constant bit time.
+  bool width;
+} bit_windows_t;
+
+// Widest run of successive levels `getRClevel()` can find in one entry.
+const uint8_t kRcLevelMaxWidth = 9;
+
+/// Precomputed windows for breaking a Manchester coded capture into levels.
+typedef struct {
+  match_window_t mark[kRcLevelMaxWidth];   // [n] is a run of n + 1 levels.
+  match_window_t space[kRcLevelMaxWidth];  // [n] is a run of n + 1 levels.
+  uint32_t gap;  // Spaces longer than this end the message.
+  uint8_t maxwidth;  // Nr. of usable entries in mark[] & space[].
+} rc_windows_t;
+
 // Classes
 
+#if ENABLE_SIGNAL_QUALITY
+/// How well the timings of a decoded message fitted what its protocol
+/// expected. Errors are a percentage of the matching tolerance. i.e. 0 is
+/// spot on, & 100 is at the very edge of still matching.
+/// See: `IRrecv::setSignalQuality()`.
+typedef struct {
+  uint16_t entries;  // Nr. of marks & spaces measured. 0 if none were.
+  uint8_t mean;      // The mean error.
+  uint8_t max;       // The worst error.
+  uint16_t near;     // Nr. of them with an error of kNearTolerance or more.
+} signal_quality_t;
+#endif  // ENABLE_SIGNAL_QUALITY
+
 /// Results returned from the decoder
 class decode_results {
  public:
@@ -107,11 +440,85 @@ class decode_results {
   volatile uint16_t *rawbuf;  // Raw intervals in .5 us ticks
   uint16_t rawlen;            // Number of records in rawbuf.
   bool overflow;
+  bool truncated;  // Only the start of the message was decoded. See `bits`.
   bool repeat;  // Is the result a repeat code?
+  uint16_t repeats;  // Nr. of repeats coalesced into it, if enabled.
+  // When things happened to the message, as per `micros()`. (uSeconds)
+  // e.g. `decoded - stopped` is how long it waited to be decoded.
+  uint32_t started;  // The first edge of the message was seen.
+  uint32_t stopped;  // The capture ended. i.e. The timeout was reached.
+  uint32_t decoded;  // `decode()` finished decoding it.
+#if ENABLE_SIGNAL_QUALITY
+  signal_quality_t quality;  // How well it fitted. See `setSignalQuality()`.
+#endif  // ENABLE_SIGNAL_QUALITY
 };
 
+// A `slim_results_t` with no state in a `decode_state_pool`.
+const uint16_t kNoStateSlot = UINT16_MAX;
+
+/// A decoded message, without the capture or room for a state of its own.
+/// Far smaller than a `decode_results`. e.g. For queues of results.
+/// Any state is held in a slot of a `decode_state_pool` instead.
+typedef struct {
+  decode_type_t decode_type;
+  uint64_t value;      // Only if it has no state.
+  uint32_t address;    // Only if it has no state.
+  uint32_t command;    // Only if it has no state.
+  uint16_t bits;
+  uint16_t slot;       // Which slot has its state. kNoStateSlot if none.
+  bool repeat;
+  uint16_t repeats;
+  uint32_t started;
+  uint32_t stopped;
+  uint32_t decoded;
+} slim_results_t;
+
+/// A pool of slots for the states of `slim_results_t`s. Each slot is
+/// `kStateSizeMax` bytes, so only the results holding a state pay for one.
+class decode_state_pool {
+ public:
+  explicit decode_state_pool(const uint16_t slots);
+  ~decode_state_pool(void);
+  uint16_t getSlots(void) const;
+  uint16_t getFree(void) const;
+  bool slim(const decode_results *results, slim_results_t *slim);
+  bool expand(slim_results_t *slim, decode_results *results);
+  void release(slim_results_t *slim);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  uint8_t *_states;  // `_slots * kStateSizeMax` bytes. NULL if unallocated.
+  bool *_used;       // Is each slot in use?
+  uint16_t _slots;   // Nr. of slots. 0 if the memory couldn't be allocated.
+  uint16_t _free;    // Nr. of slots not in use.
+};
+
+/// A function to be given each message the ESP32 decode task decodes.
+/// @see IRrecv::startDecodeTask()
+typedef void (*decode_callback_t)(const decode_results *results, void *arg);
+
+/// A possible decoding of an IR message. See `IRrecv::decodeAll()`.
+typedef struct {
+  decode_results result;  // What the protocol decoded the message as.
+  uint8_t score;     // How likely (0-100) this is the right protocol.
+  uint8_t error;     // Average timing error (0-100) as a % of the tolerance.
+  uint8_t coverage;  // % of the captured marks & spaces the protocol matched.
+} decode_candidate_t;
+
+// Max. nr. of candidates `IRrecv::decodeAll()` will look for by default.
+const uint8_t kMaxDecodeCandidates = 4;
+
 /// Class for receiving IR messages.
 class IRrecv {
+  friend class IRdecoder;  // A capture-less IRrecv. See below.
+  friend class IRrepeater;  // Reads the capture while it is still arriving.
+  friend class IRverify;  // Reads the capture state, & lets it see its echo.
+#if ENABLE_STATIC_RECV_BUFFERS
+  // Supplies its own buffers. See below.
+  template <uint16_t kBufSize, bool kSaveBuffer> friend class IRrecvStatic;
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+
  public:
 #if defined(ESP32)
   explicit IRrecv(const uint16_t recvpin, const uint16_t bufsize = kRawBuf,
@@ -126,15 +533,185 @@ class IRrecv {
   ~IRrecv(void);                                                  // Destructor
   void setTolerance(const uint8_t percent = kTolerance);
   uint8_t getTolerance(void);
+#if ENABLE_PROTOCOL_TOLERANCE
+  bool setProtocolTolerance(const decode_type_t protocol,
+                            const uint8_t percent, const int16_t excess = 0);
+  uint8_t getProtocolTolerance(const decode_type_t protocol);
+  void clearProtocolTolerance(const decode_type_t protocol);
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+#if ENABLE_CARRIER_FILTER
+  void setCarrierInput(const bool raw);
+  bool getCarrierInput(void);
+  void setCarrierTolerance(const uint8_t percent = kCarrierTolerance);
+  uint8_t getCarrierTolerance(void);
+  uint32_t getCarrier(void);
+  static uint32_t protocolCarrier(const decode_type_t protocol);
+#endif  // ENABLE_CARRIER_FILTER
+#if ENABLE_GLITCH_FILTER
+  void setGlitchFilter(const uint16_t usecs);
+  uint16_t getGlitchFilter(void);
+#endif  // ENABLE_GLITCH_FILTER
   bool decode(decode_results *results, irparams_t *save = NULL,
               uint8_t max_skip = 0, uint16_t noise_floor = 0);
+  bool decodeEarly(decode_results *results,
+                   const uint16_t quiet = kEarlyDecodeQuiet,
+                   uint8_t max_skip = 0, uint16_t noise_floor = 0);
+#if ENABLE_BUDGETED_DECODE
+  bool decodeBudget(decode_results *results, const uint32_t budget,
+                    irparams_t *save = NULL, uint8_t max_skip = 0,
+                    uint16_t noise_floor = 0);
+  bool isDecoding(void) const;
+#endif  // ENABLE_BUDGETED_DECODE
+  static IRrecv *decodeAny(decode_results *results);
+  static uint16_t minRawEntries(const decode_type_t protocol);
+  uint8_t decodeAll(decode_candidate_t *candidates,
+                    const uint8_t max_candidates = kMaxDecodeCandidates,
+                    irparams_t *save = NULL, uint8_t max_skip = 0,
+                    uint16_t noise_floor = 0);
+  bool decodePulseDistance(decode_results *results, uint16_t offset,
+                           const pulse_distance_t *protocol,
+                           const uint16_t nbits, const bool strict = true);
+  bool decodePulseDistances(decode_results *results, uint16_t offset,
+                            const pulse_distance_t protocols[],
+                            const uint16_t count);
+#if ENABLE_CUSTOM_PROTOCOLS
+  bool decodeCustom(decode_results *results, uint16_t offset = kStartOffset);
+#endif  // ENABLE_CUSTOM_PROTOCOLS
   void enableIRIn(const bool pullup = false);
   void disableIRIn(void);
   void resume(void);
   uint16_t getBufSize(void);
+#if ENABLE_CUSTOM_BACKENDS
+  void setCaptureSource(IRcaptureSource *source);
+  IRcaptureSource *getCaptureSource(void) const;
+  uint8_t captureEdge(const uint32_t usecs);
+  void captureEnd(const uint32_t usecs);
+#endif  // ENABLE_CUSTOM_BACKENDS
+#if ENABLE_CAPTURE_RING
+  bool enableCaptureRing(const uint8_t slots);
+  uint8_t getCaptureSlots(void);
+  uint16_t getCaptureDrops(void);
+  uint8_t getCaptureHighWater(void);
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+  bool enableCompactCapture(const bool enable = true);
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+  bool enableLargeCapture(const uint16_t size,
+                          const uint16_t staging = kLargeCaptureStaging);
+  void disableLargeCapture(void);
+  uint16_t drainCapture(void);
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_ECHO_SUPPRESSION
+  void ignoreEcho(const IRsend *irsend);
+#endif  // ENABLE_ECHO_SUPPRESSION
+#if ENABLE_IR_MIRROR
+  void mirrorTo(IRsend *irsend);
+#endif  // ENABLE_IR_MIRROR
+#if ENABLE_SIGNAL_QUALITY
+  void setSignalQuality(const bool on = true);
+  bool getSignalQuality(void);
+#endif  // ENABLE_SIGNAL_QUALITY
+#if ENABLE_LOW_POWER_RECV
+  void setWakeLatency(const uint16_t usecs = kWakeLatency);
+  uint16_t getWakeLatency(void);
+  bool sleepUntilIR(const uint32_t max_ms = 0);
+#endif  // ENABLE_LOW_POWER_RECV
+#if ENABLE_PARTIAL_DECODE
+  void setPartialDecode(const bool on = true);
+  bool getPartialDecode(void);
+#endif  // ENABLE_PARTIAL_DECODE
+#if ENABLE_ADAPTIVE_TIMEOUT
+  void enableAdaptiveTimeout(const uint8_t gap_ms = kTimeoutMs);
+  void disableAdaptiveTimeout(void);
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if ENABLE_REPEAT_COALESCING
+  bool enableRepeatCoalescing(const uint16_t window_ms = kRepeatCoalesceMs);
+  void disableRepeatCoalescing(void);
+#endif  // ENABLE_REPEAT_COALESCING
+#if ENABLE_GAMING_RECV
+  bool enableGamingMode(const uint16_t dedup_ms = kGamingDedupMs,
+                        const bool multibrackets = false,
+                        const uint8_t slots = kGamingCaptureSlots);
+  void disableGamingMode(void);
+  uint32_t getGamingDuplicates(void);
+#endif  // ENABLE_GAMING_RECV
+#if ENABLE_DECODE_CACHE
+  bool enableDecodeCache(const uint8_t size = kDecodeCacheSize);
+  void disableDecodeCache(void);
+  uint32_t getDecodeCacheHits(void);
+#endif  // ENABLE_DECODE_CACHE
+#if ENABLE_DECODE_TRACE
+  bool enableDecodeTrace(const uint16_t size = kDecodeTraceSize);
+  void disableDecodeTrace(void);
+  void clearDecodeTrace(void);
+  uint16_t getDecodeTraceLength(void);
+  const decode_trace_t *getDecodeTraceEntry(const uint16_t index);
+  uint16_t getDecodeTraceRate(void);
+#endif  // ENABLE_DECODE_TRACE
+#if IRRECV_DECODE_TASK
+  bool startDecodeTask(const decode_callback_t callback = NULL,
+                       void *arg = NULL,
+                       const uint8_t slots = kDecodeTaskSlots,
+                       const uint8_t queue_length = kDecodeTaskQueueLength,
+                       const uint8_t core = kDecodeTaskCore);
+  void stopDecodeTask(void);
+  bool readDecoded(decode_results *results, const uint32_t wait_ms = 0);
+  uint16_t getDecodedDrops(void);
+#endif  // IRRECV_DECODE_TASK
+  // Only for use by the interrupt handlers, which aren't class members.
+#if ENABLE_CAPTURE_RING
+  static void _ringCommit(volatile irparams_t *params);
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+  static void _packTicks(volatile irparams_t *params, const uint16_t ticks);
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_ADAPTIVE_TIMEOUT
+  static void _adaptTimeout(volatile irparams_t *params, const uint16_t index,
+                            const uint16_t ticks);
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if ENABLE_GLITCH_FILTER
+  static bool _dropGlitch(volatile irparams_t *params, const uint16_t index,
+                          const uint16_t ticks, const uint32_t now);
+#endif  // ENABLE_GLITCH_FILTER
+#if ENABLE_CAPTURE_HASH
+  static void _hashTicks(volatile irparams_t *params, const uint16_t index,
+                         const uint16_t ticks);
+#endif  // ENABLE_CAPTURE_HASH
+#if ENABLE_CARRIER_FILTER
+  static void _demodReset(carrier_demod_t *demod);
+  static void _demodulate(carrier_demod_t *demod, const uint16_t on,
+                          const uint16_t off, uint32_t entries[2]);
+  static uint32_t _demodCarrier(const carrier_demod_t *demod);
+#endif  // ENABLE_CARRIER_FILTER
+#ifdef UNIT_TEST
+  void _simulateEdge(void);
+  void _simulateTimeout(void);
+#endif  // UNIT_TEST
+  void enableProtocol(const decode_type_t protocol);
+  void disableProtocol(const decode_type_t protocol);
+  void enableAllProtocols(void);
+  void disableAllProtocols(void);
+  bool isProtocolEnabled(const decode_type_t protocol);
+#if ENABLE_HEADER_DISPATCH
+  void setSmartSkip(const bool on = true);
+#endif  // ENABLE_HEADER_DISPATCH
+  void startProtocolLearning(void);
+  uint16_t stopProtocolLearning(const bool apply = true);
 #if DECODE_HASH
   void setUnknownThreshold(const uint16_t length);
+  void setHashOnly(const bool on = true);
 #endif
+#if ENABLE_DECODE_PROFILING
+  bool enableDecodeProfiling(void);
+  void disableDecodeProfiling(void);
+  void resetDecodeProfile(void);
+  const decode_profile_t *getDecodeProfile(const decode_type_t protocol);
+#endif  // ENABLE_DECODE_PROFILING
+  void setMarkExcess(const int16_t excess = kMarkExcess);
+  int16_t getMarkExcess(void);
+  void startMarkExcessCalibration(void);
+  int16_t stopMarkExcessCalibration(const bool apply = true);
   bool match(const uint32_t measured, const uint32_t desired,
              const uint8_t tolerance = kUseDefTol,
              const uint16_t delta = 0);
@@ -148,18 +725,252 @@ class IRrecv {
 
  private:
 #endif
+  volatile irparams_t *_params;  // Our capture state, shared with the ISRs.
+  uint8_t _id;  // Which of the kMaxReceivers capture states is ours.
+#if ENABLE_CUSTOM_BACKENDS
+  IRcaptureSource *_source;  // Where edges come from, if not the GPIO.
+#endif  // ENABLE_CUSTOM_BACKENDS
+  /// Marks the constructor of a decoder. i.e. It has no receiver/capture state.
+  struct no_capture_t {};
+  IRrecv(const no_capture_t, const uint8_t timeout);
+  void _claim(void);
+  void _init(const uint16_t recvpin, const uint16_t bufsize,
+             const uint8_t timeout, const bool save_buffer);
+  void _allocBuffers(const uint16_t bufsize, const bool save_buffer);
   irparams_t *irparams_save;
+#if ENABLE_STATIC_RECV_BUFFERS
+#if defined(ESP32)
+  IRrecv(const uint16_t recvpin, uint16_t *rawbuf, const uint16_t bufsize,
+         const uint8_t timeout, irparams_t *save, uint16_t *save_rawbuf,
+         const uint8_t timer_num);
+#else  // ESP32
+  IRrecv(const uint16_t recvpin, uint16_t *rawbuf, const uint16_t bufsize,
+         const uint8_t timeout, irparams_t *save, uint16_t *save_rawbuf);
+#endif  // ESP32
+  bool _static;  // Are the buffers someone else's? i.e. Not ours to free.
+#endif  // ENABLE_STATIC_RECV_BUFFERS
   uint8_t _tolerance;
 #if defined(ESP32)
   uint8_t _timer_num;
 #endif  // defined(ESP32)
 #if DECODE_HASH
   uint16_t _unknown_threshold;
+  bool _hash_only;  // Skip all the protocols & just report the UNKNOWN hash?
 #endif
+#if ENABLE_CAPTURE_HASH
+  uint32_t _capture_hash;  // The hash the interrupt handler built for it.
+  bool _capture_hashed;  // Is `_capture_hash` valid for the message decoding?
+#endif  // ENABLE_CAPTURE_HASH
+#if ENABLE_HEADER_DISPATCH
+  uint32_t _hdr_min;  // Smallest nominal header mark worth trying. (uSecs)
+  uint32_t _hdr_max;  // Largest nominal header mark worth trying. (uSecs)
+  uint16_t _hdr_entry;  // The captured mark they were worked out for. (ticks)
+  bool _smart_skip;  // Only try skipped offsets that look like a header?
+  bool _isLikelyHeader(void);
+  void _headerWindow(const uint8_t percent, const int16_t adjust,
+                     uint32_t *min, uint32_t *max);
+#endif  // ENABLE_HEADER_DISPATCH
+#if ENABLE_LENGTH_DISPATCH
+  uint16_t _entries;  // Nr. of capture entries from the current offset.
+#endif  // ENABLE_LENGTH_DISPATCH
+#if ENABLE_NEC_FAMILY_DISPATCH
+  uint16_t _nec_bits;  // Data bits in the first block of a NEC-like message.
+  uint8_t _nec_blocks;  // Nr. of consecutive blocks of `_nec_bits` bits.
+  bool _nec_sized;  // Are the above valid for the current offset?
+#endif  // ENABLE_NEC_FAMILY_DISPATCH
+#if ENABLE_FAMILY_MATCH_CACHE
+  bool _family_cache;  // May the below be used? i.e. Are we in `decode()`?
+  uint16_t _kaseikyo_offset;  // Where the Kaseikyo match was tried. 0 = none.
+  uint16_t _kaseikyo_used;  // Nr. of entries it matched. 0 = no match.
+  uint64_t _kaseikyo_data;  // The data bits it matched.
+  uint16_t _sharp_offset;  // Where the Sharp match was tried. 0 = none.
+  uint16_t _sharp_used;  // Nr. of entries it matched. 0 = no match.
+  uint64_t _sharp_data;  // The data bits it matched.
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+#if ENABLE_CAPTURE_RING
+  bool _ring_held;  // Is decode() still using the slot at the ring's tail?
+  void _ringReset(void);
+  void _ringRelease(void);
+  bool _ringFetch(decode_results *results, irparams_t *save);
+  void _ringFree(void);
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_LOW_POWER_RECV
+  uint16_t _wake_latency;  // Time from an edge to the CPU being awake. (uSecs)
+#endif  // ENABLE_LOW_POWER_RECV
+#if ENABLE_PARTIAL_DECODE
+  bool _partial;  // Decode what we can of overflowed captures?
+  bool _partial_ok;  // May the message being decoded be truncated?
+  // How far a truncated decode of a multi-section message got.
+  const ac_sections_t *_trunc_frame;  // The sections of the message.
+  uint16_t _trunc_nbytes;  // Nr. of bytes in the whole message.
+  uint16_t _trunc_pos;  // Nr. of bytes decoded. 0 if it wasn't truncated.
+  uint8_t _trunc_section;  // The first section that wasn't decoded.
+  bool _trunc_strict;
+  uint8_t _trunc_tolerance;
+  int16_t _trunc_excess;
+#if ENABLE_CAPTURE_RING
+  uint8_t _ring_skip;  // Nr. of slots after the held one that finished it.
+  void _ringStitch(decode_results *results);
+#endif  // ENABLE_CAPTURE_RING
+#endif  // ENABLE_PARTIAL_DECODE
+  bool _sectionsMayFit(const decode_results *results, const uint16_t offset,
+                       const ac_sections_t *frame);
+#if ENABLE_COMPACT_CAPTURE
+  void _unpackCapture(irparams_t *dst, const uint16_t entries);
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+  uint16_t _small_bufsize;  // `bufsize` before a large one. 0 if none is used.
+  void _freeLargeCapture(void);
+#if IRRECV_DRAIN_TASK
+  void *_drain_task;  // The task filling the large capture buffer, if any.
+  volatile bool _drain_stop;  // Should it stop?
+  volatile bool _drain_running;  // Is it still running?
+  static void _drainTask(void *arg);
+#endif  // IRRECV_DRAIN_TASK
+#endif  // ENABLE_LARGE_CAPTURE
+#if ENABLE_REPEAT_COALESCING
+  decode_results *_coalesced;  // The message being repeated. NULL if unused.
+  uint32_t _coalesce_window;  // Max. time between repeats. (uSecs)
+  uint32_t _coalesce_last;    // When it, or its last repeat, was seen. (uSecs)
+  uint32_t _coalesce_hash;    // decodeHash()'s hash of the message's capture.
+  uint16_t _coalesce_rawlen;  // Nr. of entries in its capture. 0 means none.
+  uint16_t _coalesce_count;   // Nr. of repeats of it not yet reported.
+  bool _coalesceRepeat(const decode_results *results);
+  bool _coalesceToggled(const decode_results *results);
+  void _coalesceStore(const decode_results *results);
+  bool _coalesceFlush(decode_results *results);
+#endif  // ENABLE_REPEAT_COALESCING
+#if ENABLE_GAMING_RECV
+  gaming_player_t *_gaming;  // Each player's last message. NULL if unused.
+  uint32_t _gaming_window;  // Max. time between duplicates. (uSecs)
+  uint32_t _gaming_dupes;   // Nr. of duplicates dropped.
+  bool _gamingDuplicate(const decode_results *results);
+#endif  // ENABLE_GAMING_RECV
+#if ENABLE_DECODE_CACHE
+  decode_cache_entry_t *_dcache;  // The cached messages. NULL if unused.
+  uint8_t _dcache_size;  // Nr. of entries in `_dcache`.
+  uint32_t _dcache_clock;  // Nr. of messages decoded while it is in use.
+  uint32_t _dcache_hits;  // Nr. of them only the cached protocol was tried on.
+  bool _dcache_only;  // Is only `_dcache_protocol` to be attempted?
+  decode_type_t _dcache_protocol;
+#endif  // ENABLE_DECODE_CACHE
+#if ENABLE_DECODE_TRACE
+  decode_trace_t *_trace;  // The trace buffer. NULL if it isn't in use.
+  uint16_t _trace_size;  // Nr. of events it can hold.
+  uint16_t _trace_next;  // Where the next event goes.
+  bool _trace_full;  // Has it wrapped? i.e. Older events have been overwritten.
+  uint16_t _trace_offset;  // The capture entry being decoded from.
+  void _traceEvent(const uint8_t event, const decode_type_t protocol,
+                   const uint32_t value);
+#endif  // ENABLE_DECODE_TRACE
+#if IRRECV_DECODE_TASK
+  void *_task_queue;  // Where the decode task puts its results. NULL if none.
+  decode_callback_t _task_callback;  // Given each result. NULL if none.
+  void *_task_arg;  // Passed to `_task_callback`.
+  volatile bool _task_stop;  // Has the decode task been asked to stop?
+  volatile bool _task_running;  // Is the decode task still running?
+  uint16_t _task_drops;  // Nr. of results lost as the queue was full.
+  static void _decodeTask(void *arg);
+#endif  // IRRECV_DECODE_TASK
+#if ENABLE_DECODE_PROFILING
+  decode_profile_t *_profile;  // Per protocol statistics. NULL if not in use.
+  decode_profile_t *_profile_current;  // Stats of the attempt in progress.
+  IRtimer _profile_timer;  // Times the attempt in progress.
+#endif  // ENABLE_DECODE_PROFILING
+  uint8_t _protocols[kProtocolMaskSize];  // Protocols decode() may attempt.
+  uint8_t _learned[kProtocolMaskSize];  // Protocols decoded while learning.
+  bool _learning;  // Are we learning which protocols are in use?
+  decode_type_t _attempting;  // The protocol decode() attempted last.
+  bool _scoring;  // Is decodeAll() collecting how well each attempt fits?
+  uint16_t _fit_used;   // Nr. of entries matched by the current attempt.
+  uint32_t _fit_error;  // Sum of their timing errors. (% of tolerance)
+#if ENABLE_SIGNAL_QUALITY
+  bool _quality;  // Are we reporting the signal quality of each decode?
+  uint8_t _fit_max;  // The worst of their timing errors. (% of tolerance)
+  uint16_t _fit_near;  // Nr. of them at least kNearTolerance out.
+#endif  // ENABLE_SIGNAL_QUALITY
+  /// @return Does anything want to know how well each entry fits?
+  bool _fitting(void) const {
+#if ENABLE_SIGNAL_QUALITY
+    return _scoring || _calibrating || _quality;
+#else  // ENABLE_SIGNAL_QUALITY
+    return _scoring || _calibrating;
+#endif  // ENABLE_SIGNAL_QUALITY
+  }
+  void _scoreFit(const uint32_t measured, const uint32_t low,
+                 const uint32_t high);
+  void _scoreCandidate(decode_candidate_t *candidate);
+  int16_t _excess_adjust;  // Added to every mark excess. (uSecs)
+#if ENABLE_PROTOCOL_TOLERANCE
+  protocol_tolerance_t _protocol_tolerances[kMaxProtocolTolerances];
+  uint8_t _protocol_tolerance_count;
+  // The one for the protocol being attempted. NULL if it has none.
+  const protocol_tolerance_t *_protocol_tolerance;
+  protocol_tolerance_t *_findProtocolTolerance(const decode_type_t protocol);
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+  int16_t _excessAdjust(void);
+#if ENABLE_CARRIER_FILTER
+  uint32_t _carrier;  // Measured for the capture being decoded. (Hz)
+  uint8_t _carrier_tolerance;
+  bool _carrierMatches(const decode_type_t protocol);
+#endif  // ENABLE_CARRIER_FILTER
+  bool _calibrating;  // Are we measuring the sensor lag?
+  int32_t _skew_sum;  // Sum of the lag measured by the current attempt.
+  uint16_t _skew_count;  // Nr. of entries it was measured from.
+  int64_t _calibration_sum;  // Sum of the lag of successful decodes.
+  uint32_t _calibration_count;  // Nr. of entries it was measured from.
+  void _skewFit(const uint32_t measured, const uint32_t nominal,
+                const bool mark);
+  void _fitBit(const uint16_t mark, const match_window_t *mark_window,
+               const uint16_t space, const match_window_t *space_window);
+  void _setProtocolBit(uint8_t *mask, const decode_type_t protocol,
+                       const bool on);
+  uint16_t _early_rawlen;  // The capture length decodeEarly() last tried.
+#if ENABLE_BUDGETED_DECODE
+  bool _budgeted;  // Is a decodeBudget() call in progress?
+  uint32_t _budget;  // Its budget. (uSeconds)
+  IRtimer _budget_timer;  // Since it started.
+  bool _suspended;  // Did a budget run out, part way through a capture?
+  bool _resuming;  // Are we carrying on with that capture?
+  bool _suspended_resumed;  // Had capturing resumed, when it ran out?
+  uint16_t _resume_offset;  // The offset to carry on from.
+  uint16_t _resume_index;  // The entry of kDecodeOrder to carry on from.
+  bool _budgetSpent(void);
+#endif  // ENABLE_BUDGETED_DECODE
+  bool _decode(decode_results *results, irparams_t *save,
+               uint8_t max_skip, uint16_t noise_floor);
+  bool _decodeFetched(decode_results *results, const bool resumed,
+                      uint8_t max_skip, uint16_t noise_floor);
+  bool _decodeCapture(decode_results *results, uint8_t max_skip,
+                      uint16_t noise_floor);
+  bool _matchCapture(decode_results *results, uint8_t max_skip,
+                     uint16_t noise_floor);
+  bool _tryDecoders(decode_results *results, uint8_t max_skip,
+                    uint16_t noise_floor);
+  bool _tryProtocol(const decode_type_t protocol, decode_results *results,
+                    const uint16_t offset);
+  uint16_t _matchKaseikyo(const decode_results *results, const uint16_t offset,
+                          const uint16_t nbits, uint64_t *data);
+  uint16_t _matchSharp(const decode_results *results, const uint16_t offset,
+                       const uint16_t nbits, uint64_t *data);
+  uint16_t _matchSonyFrame(const decode_results *results, uint16_t offset,
+                           uint64_t *data, uint16_t *nbits);
+  bool _finishDecode(decode_results *results, const bool success);
   // These are called by decode
+  bool _attempt(const decode_type_t protocol);
+  void _profileFinish(const bool success);
+  void _setHeaderWindow(const uint16_t entry);
+  bool _headerMayMatch(const uint32_t hdrmark);
+  uint16_t _countBits(const decode_results *results, uint16_t offset);
+  uint8_t _countBlocks(const decode_results *results, uint16_t offset,
+                       const uint16_t nbits);
+  bool _necFamilyMayMatch(const decode_results *results, const uint16_t offset,
+                          const uint16_t nbits, const uint8_t blocks);
   uint8_t _validTolerance(const uint8_t percentage);
   void copyIrParams(volatile irparams_t *src, irparams_t *dst);
+  void swapIrParams(volatile irparams_t *src, irparams_t *dst);
   uint16_t compare(const uint16_t oldval, const uint16_t newval);
+  uint32_t _hashCapture(const decode_results *results);
   uint32_t ticksLow(const uint32_t usecs,
                     const uint8_t tolerance = kUseDefTol,
                     const uint16_t delta = 0);
@@ -169,6 +980,34 @@ class IRrecv {
   bool matchAtLeast(const uint32_t measured, const uint32_t desired,
                     const uint8_t tolerance = kUseDefTol,
                     const uint16_t delta = 0);
+  match_window_t _matchWindow(const uint32_t desired,
+                              const uint8_t tolerance = kUseDefTol,
+                              const uint16_t delta = 0);
+  bit_windows_t _bitWindows(const uint16_t onemark, const uint32_t onespace,
+                            const uint16_t zeromark, const uint32_t zerospace,
+                            const uint8_t tolerance = kUseDefTol,
+                            const int16_t excess = kMarkExcess);
+  match_result_t _matchData(volatile uint16_t *data_ptr, const uint16_t nbits,
+                            const bit_windows_t *windows,
+                            const bool MSBfirst = true);
+  template <typename T>
+  match_result_t _matchDataAs(volatile uint16_t *data_ptr, const uint16_t nbits,
+                              const bit_windows_t *windows,
+                              const bool MSBfirst);
+  template <typename T>
+  match_result_t _matchDataDistance(volatile uint16_t *data_ptr,
+                                    const uint16_t nbits,
+                                    const bit_windows_t *windows,
+                                    const bool MSBfirst);
+  template <typename T>
+  match_result_t _matchDataWidth(volatile uint16_t *data_ptr,
+                                 const uint16_t nbits,
+                                 const bit_windows_t *windows,
+                                 const bool MSBfirst);
+  match_result_t _matchDataStrict(volatile uint16_t *data_ptr,
+                                  const uint16_t nbits,
+                                  const bit_windows_t *windows,
+                                  const bool MSBfirst = true);
   uint16_t _matchGeneric(volatile uint16_t *data_ptr,
                          uint64_t *result_bits_ptr,
                          uint8_t *result_ptr,
@@ -186,20 +1025,52 @@ class IRrecv {
                          const bool atleast = false,
                          const uint8_t tolerance = kUseDefTol,
                          const int16_t excess = kMarkExcess,
-                         const bool MSBfirst = true);
+                         const bool MSBfirst = true,
+                         const byte_checks_t *checks = NULL);
+  bool _matchExpected(volatile uint16_t *data_ptr, const uint64_t expected,
+                      const uint16_t nbits, const bit_windows_t *windows,
+                      const bool MSBfirst = true);
+  uint16_t _matchRepeat(volatile uint16_t *data_ptr,
+                        const uint64_t expected_bits,
+                        const uint8_t *expected_bytes,
+                        const bool use_bits,
+                        const uint16_t remaining,
+                        const uint16_t nbits,
+                        const uint16_t hdrmark,
+                        const uint32_t hdrspace,
+                        const uint16_t onemark,
+                        const uint32_t onespace,
+                        const uint16_t zeromark,
+                        const uint32_t zerospace,
+                        const uint16_t footermark,
+                        const uint32_t footerspace,
+                        const bool atleast = false,
+                        const uint8_t tolerance = kUseDefTol,
+                        const int16_t excess = kMarkExcess,
+                        const bool MSBfirst = true);
   match_result_t matchData(volatile uint16_t *data_ptr, const uint16_t nbits,
                            const uint16_t onemark, const uint32_t onespace,
                            const uint16_t zeromark, const uint32_t zerospace,
                            const uint8_t tolerance = kUseDefTol,
                            const int16_t excess = kMarkExcess,
                            const bool MSBfirst = true);
+  match_result_t matchBytePairs(volatile uint16_t *data_ptr,
+                                const uint16_t nbits,
+                                const uint16_t onemark,
+                                const uint32_t onespace,
+                                const uint16_t zeromark,
+                                const uint32_t zerospace,
+                                const bool strict = true,
+                                const uint8_t tolerance = kUseDefTol,
+                                const int16_t excess = kMarkExcess);
   uint16_t matchBytes(volatile uint16_t *data_ptr, uint8_t *result_ptr,
                       const uint16_t remaining, const uint16_t nbytes,
                       const uint16_t onemark, const uint32_t onespace,
                       const uint16_t zeromark, const uint32_t zerospace,
                       const uint8_t tolerance = kUseDefTol,
                       const int16_t excess = kMarkExcess,
-                      const bool MSBfirst = true);
+                      const bool MSBfirst = true,
+                      const byte_checks_t *checks = NULL);
   uint16_t matchGeneric(volatile uint16_t *data_ptr,
                         uint64_t *result_ptr,
                         const uint16_t remaining, const uint16_t nbits,
@@ -221,7 +1092,45 @@ class IRrecv {
                         const bool atleast = false,
                         const uint8_t tolerance = kUseDefTol,
                         const int16_t excess = kMarkExcess,
-                        const bool MSBfirst = true);
+                        const bool MSBfirst = true,
+                        const byte_checks_t *checks = NULL);
+  uint16_t matchRepeat(volatile uint16_t *data_ptr, const uint64_t expected,
+                       const uint16_t remaining, const uint16_t nbits,
+                       const uint16_t hdrmark, const uint32_t hdrspace,
+                       const uint16_t onemark, const uint32_t onespace,
+                       const uint16_t zeromark, const uint32_t zerospace,
+                       const uint16_t footermark, const uint32_t footerspace,
+                       const bool atleast = false,
+                       const uint8_t tolerance = kUseDefTol,
+                       const int16_t excess = kMarkExcess,
+                       const bool MSBfirst = true);
+  uint16_t matchRepeat(volatile uint16_t *data_ptr,
+                       const uint8_t *expected,
+                       const uint16_t remaining, const uint16_t nbits,
+                       const uint16_t hdrmark, const uint32_t hdrspace,
+                       const uint16_t onemark, const uint32_t onespace,
+                       const uint16_t zeromark, const uint32_t zerospace,
+                       const uint16_t footermark, const uint32_t footerspace,
+                       const bool atleast = false,
+                       const uint8_t tolerance = kUseDefTol,
+                       const int16_t excess = kMarkExcess,
+                       const bool MSBfirst = true);
+  uint16_t matchSections(volatile uint16_t *data_ptr, uint8_t *state,
+                         const uint16_t remaining, const uint16_t nbytes,
+                         const ac_sections_t *frame, const bool strict = true,
+                         const uint8_t tolerance = kUseDefTol,
+                         const int16_t excess = kMarkExcess);
+  uint16_t _matchSectionsFrom(volatile uint16_t *data_ptr, uint8_t *state,
+                              const uint16_t remaining, const uint16_t nbytes,
+                              const ac_sections_t *frame, const uint8_t first,
+                              const uint16_t start, const bool strict,
+                              const uint8_t tolerance, const int16_t excess);
+#if (DECODE_GREE || DECODE_KELVINATOR)
+  uint16_t matchGreeFrame(volatile uint16_t *data_ptr, uint8_t *state,
+                          const uint16_t remaining, const uint16_t nbytes,
+                          const gree_frame_t *frame,
+                          const bool atleast = false);
+#endif  // (DECODE_GREE || DECODE_KELVINATOR)
   uint16_t matchGenericConstBitTime(volatile uint16_t *data_ptr,
                                     uint64_t *result_ptr,
                                     const uint16_t remaining,
@@ -337,6 +1246,13 @@ class IRrecv {
                      uint16_t bitTime, const uint8_t tolerance = kUseDefTol,
                      const int16_t excess = kMarkExcess,
                      const uint16_t delta = 0, const uint8_t maxwidth = 3);
+  int16_t getRClevel(decode_results *results, uint16_t *offset, uint16_t *used,
+                     const rc_windows_t *windows);
+  rc_windows_t _rcWindows(const uint16_t bitTime,
+                          const uint8_t tolerance = kUseDefTol,
+                          const int16_t excess = kMarkExcess,
+                          const uint16_t delta = 0,
+                          const uint8_t maxwidth = 3);
 #endif
 #if DECODE_RC5
   bool decodeRC5(decode_results *results, uint16_t offset = kStartOffset,
@@ -537,6 +1453,12 @@ class IRrecv {
                   const uint16_t nbits = kGreeBits,
                   const bool strict = true);
 #endif
+#if (DECODE_GREE || DECODE_KELVINATOR)
+  bool decodeGreeFamily(decode_results *results,
+                        uint16_t offset = kStartOffset, const bool gree = true,
+                        const bool kelvinator = true,
+                        const bool strict = true);
+#endif  // (DECODE_GREE || DECODE_KELVINATOR)
 #if (DECODE_HAIER_AC | DECODE_HAIER_AC_YRW02)
   bool decodeHaierAC(decode_results *results, uint16_t offset = kStartOffset,
                      const uint16_t nbits = kHaierACBits,
@@ -691,4 +1613,58 @@ bool decodeTranscold(decode_results *results, uint16_t offset = kStartOffset,
 #endif  // DECODE_TRANSCOLD
 };
 
+/// Class for decoding IR messages captured elsewhere. e.g. From files, or
+/// another device. It has no receiver, so it shares no state with the
+/// interrupt handlers or any other instance. i.e. It is reentrant, & each
+/// thread can have its own to decode in parallel.
+/// All the IRrecv decoding methods & settings work the same way, but the
+/// capture methods (e.g. `enableIRIn()`) do nothing.
+class IRdecoder : public IRrecv {
+ public:
+  explicit IRdecoder(const uint8_t timeout = kTimeoutMs);
+  bool decode(decode_results *results, uint8_t max_skip = 0,
+              uint16_t noise_floor = 0);
+  bool decode(decode_results *results, uint16_t *rawbuf,
+              const uint16_t rawlen, uint8_t max_skip = 0,
+              uint16_t noise_floor = 0);
+};
+
+#if ENABLE_STATIC_RECV_BUFFERS
+/// Class for receiving IR messages, without using the heap for its buffers.
+/// They are part of the object instead. e.g. In .bss when it is a global.
+/// Otherwise it is the same as an IRrecv with a `bufsize` of `kBufSize` &
+/// a `save_buffer` of `kSaveBuffer`.
+/// @note e.g. `IRrecvStatic<1024, true> irrecv(kRecvPin, kTimeout);`
+/// @note `enableCompactCapture()` is unavailable, & any extra slots of
+///   `enableCaptureRing()` still come from the heap.
+template <uint16_t kBufSize, bool kSaveBuffer = false>
+class IRrecvStatic : public IRrecv {
+ public:
+#if defined(ESP32)
+  /// Class constructor
+  /// @param[in] recvpin See `IRrecv::IRrecv()`.
+  /// @param[in] timeout See `IRrecv::IRrecv()`.
+  /// @param[in] timer_num See `IRrecv::IRrecv()`.
+  explicit IRrecvStatic(const uint16_t recvpin,
+                        const uint8_t timeout = kTimeoutMs,
+                        const uint8_t timer_num = kDefaultESP32Timer)
+      : IRrecv(recvpin, _rawbuf, kBufSize, timeout,
+               kSaveBuffer ? &_save : NULL, _save_rawbuf, timer_num) {}
+#else  // ESP32
+  /// Class constructor
+  /// @param[in] recvpin See `IRrecv::IRrecv()`.
+  /// @param[in] timeout See `IRrecv::IRrecv()`.
+  explicit IRrecvStatic(const uint16_t recvpin,
+                        const uint8_t timeout = kTimeoutMs)
+      : IRrecv(recvpin, _rawbuf, kBufSize, timeout,
+               kSaveBuffer ? &_save : NULL, _save_rawbuf) {}
+#endif  // ESP32
+
+ private:
+  uint16_t _rawbuf[kBufSize];
+  irparams_t _save;
+  uint16_t _save_rawbuf[kSaveBuffer ? kBufSize : 1];
+};
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+
 #endif  // IRRECV_H_
@@ -0,0 +1,142 @@
+// Copyright 2026 The IRremoteESP8266 authors
+// Copies of the protocols' timing constants that IRrecv.cpp uses, so it
+// doesn't need to depend on every protocol. Each protocol's ir_*.cpp file
+// `static_assert`s that its copies still match the originals.
+
+#ifndef IRRECVTIMINGS_H_
+#define IRRECVTIMINGS_H_
+
+#include <stdint.h>
+
+// Nominal header (first) mark durations, in uSeconds, used by decode() to
+// skip protocol decoders that can't possibly match the captured message.
+// Decoders without a fixed leading mark are always attempted.
+// See `ENABLE_HEADER_DISPATCH`.
+const uint16_t kDispatchLegoPfBitMark = 158;
+const uint16_t kDispatchDishHdrMark = 400;
+const uint16_t kDispatchRcmmHdrMark = 416;
+const uint16_t kDispatchSamsungAcBitMark = 586;
+const uint16_t kDispatchWhynterBitMark = 750;
+const uint16_t kDispatchMetzHdrMark = 880;
+const uint16_t kDispatchZepealHdrMark = 2330;
+const uint16_t kDispatchSonyHdrMark = 2400;
+const uint16_t kDispatchRc6HdrMark = 2664;
+const uint16_t kDispatchHaierAcHdr = 3000;
+const uint16_t kDispatchVestelAcHdrMark = 3110;
+const uint16_t kDispatchMitsubishiHeavyHdrMark = 3140;
+const uint16_t kDispatchHitachiAcHdrMark = 3300;
+const uint16_t kDispatchFujitsuAcHdrMark = 3324;
+const uint16_t kDispatchMitsubishi136HdrMark = 3324;
+const uint16_t kDispatchHitachiAc1HdrMark = 3400;
+const uint16_t kDispatchHitachiAc3HdrMark = 3400;
+const uint16_t kDispatchDoshishaHdrMark = 3412;
+const uint16_t kDispatchDaikin216HdrMark = 3440;
+const uint16_t kDispatchPanasonicHdrMark = 3456;
+const uint16_t kDispatchCoronaAcHdrMark = 3500;
+const uint16_t kDispatchSharpAcHdrMark = 3800;
+const uint16_t kDispatchNikaiHdrMark = 4000;
+const uint16_t kDispatchToshibaAcHdrMark = 4400;
+const uint16_t kDispatchSamsungHdrMark = 4480;
+const uint16_t kDispatchMideaHdrMark = 4480;
+const uint16_t kDispatchSamsung36HdrMark = 4515;
+const uint16_t kDispatchCoolixHdrMark = 4692;
+const uint16_t kDispatchDaikin160HdrMark = 5000;
+const uint16_t kDispatchDaikin176HdrMark = 5070;
+const uint16_t kDispatchTranscoldHdrMark = 5944;
+const uint16_t kDispatchTrotecHdrMark = 5952;
+const uint16_t kDispatchNeoclimaHdrMark = 6112;
+const uint16_t kDispatchArgoHdrMark = 6400;
+const uint16_t kDispatchGoodweatherHdrMark = 6820;
+const uint16_t kDispatchAmcorHdrMark = 8200;
+const uint16_t kDispatchMitsubishi2HdrMark = 8400;
+const uint16_t kDispatchCarrierAc40HdrMark = 8402;
+const uint16_t kDispatchSanyoAcHdrMark = 8500;
+const uint16_t kDispatchPioneerHdrMark = 8506;
+const uint16_t kDispatchCarrierAcHdrMark = 8532;
+const uint16_t kDispatchTechnibelAcHdrMark = 8836;
+const uint16_t kDispatchCarrierAc64HdrMark = 8940;
+const uint16_t kDispatchWhirlpoolAcHdrMark = 8950;
+const uint16_t kDispatchNecHdrMark = 8960;
+const uint16_t kDispatchDelonghiAcHdrMark = 8984;
+const uint16_t kDispatchGicableHdrMark = 9000;
+const uint16_t kDispatchGreeHdrMark = 9000;
+const uint16_t kDispatchInaxHdrMark = 9000;
+const uint16_t kDispatchTecoHdrMark = 9000;
+const uint16_t kDispatchKelvinatorHdrMark = 9010;
+const uint16_t kDispatchElectraAcHdrMark = 9166;
+const uint16_t kDispatchHitachiAc424LdrMark = 29784;
+
+// The start of messages that have long spaces (gaps) between their sections,
+// & the longest gap in each, in uSeconds. Used to lengthen the capture timeout
+// when one of them is arriving. See `ENABLE_ADAPTIVE_TIMEOUT`.
+// Daikin & Daikin152. A 5 bit leader, then the gap.
+const uint16_t kLongGapDaikinBitMark = 428;
+const uint16_t kLongGapDaikinZeroSpace = 428;
+const uint16_t kLongGapDaikinGap = 29000;
+// Mitsubishi AC.
+const uint16_t kLongGapMitsubishiAcHdrMark = 3400;
+const uint16_t kLongGapMitsubishiAcHdrSpace = 1750;
+const uint16_t kLongGapMitsubishiAcRptSpace = 17100;
+// Daikin216.
+const uint16_t kLongGapDaikin216HdrMark = 3440;
+const uint16_t kLongGapDaikin216HdrSpace = 1750;
+const uint16_t kLongGapDaikin216Gap = 29650;
+// Panasonic AC.
+const uint16_t kLongGapPanasonicHdrMark = 3456;
+const uint16_t kLongGapPanasonicHdrSpace = 1728;
+const uint16_t kLongGapPanasonicAcSectionGap = 10000;
+// Corona AC.
+const uint16_t kLongGapCoronaAcHdrMark = 3500;
+const uint16_t kLongGapCoronaAcHdrSpace = 1680;
+const uint16_t kLongGapCoronaAcSpaceGap = 10800;
+// Daikin160.
+const uint16_t kLongGapDaikin160HdrMark = 5000;
+const uint16_t kLongGapDaikin160HdrSpace = 2145;
+const uint16_t kLongGapDaikin160Gap = 29650;
+// Daikin176.
+const uint16_t kLongGapDaikin176HdrMark = 5070;
+const uint16_t kLongGapDaikin176HdrSpace = 2140;
+const uint16_t kLongGapDaikin176Gap = 29410;
+// Mitsubishi2.
+const uint16_t kLongGapMitsubishi2HdrMark = 8400;
+const uint16_t kLongGapMitsubishi2HdrSpace = 4200;
+const uint16_t kLongGapMitsubishi2MinGap = 28500;
+// Pioneer.
+const uint16_t kLongGapPioneerHdrMark = 8506;
+const uint16_t kLongGapPioneerHdrSpace = 4191;
+const uint16_t kLongGapPioneerMinGap = 25181;
+// Carrier AC.
+const uint16_t kLongGapCarrierAcHdrMark = 8532;
+const uint16_t kLongGapCarrierAcHdrSpace = 4228;
+const uint16_t kLongGapCarrierAcGap = 20000;
+// Whirlpool AC.
+const uint16_t kLongGapWhirlpoolAcHdrMark = 8950;
+const uint16_t kLongGapWhirlpoolAcHdrSpace = 4484;
+const uint16_t kLongGapWhirlpoolAcGap = 7920;
+// Gree.
+const uint16_t kLongGapGreeHdrMark = 9000;
+const uint16_t kLongGapGreeHdrSpace = 4500;
+const uint16_t kLongGapGreeMsgSpace = 19000;
+// Kelvinator. Two of its gap spaces.
+const uint16_t kLongGapKelvinatorHdrMark = 9010;
+const uint16_t kLongGapKelvinatorHdrSpace = 4505;
+const uint16_t kLongGapKelvinatorGap = 39950;
+// Daikin64 & Daikin128.
+const uint16_t kLongGapDaikin128LeaderMark = 9800;
+const uint16_t kLongGapDaikin128LeaderSpace = 9800;
+const uint16_t kLongGapDaikin128Gap = 20300;
+// Daikin2. A leader, then the gap.
+const uint16_t kLongGapDaikin2LeaderMark = 10024;
+const uint16_t kLongGapDaikin2LeaderSpace = 25180;
+// Hitachi AC424. A leader, then the gap.
+const uint16_t kLongGapHitachiAc424LdrMark = 29784;
+const uint16_t kLongGapHitachiAc424LdrSpace = 49290;
+
+// An NEC style repeat code. i.e. A header mark, a short space, & a bit mark.
+// See `ENABLE_REPEAT_COALESCING`.
+const uint16_t kCoalesceNecHdrMark = 8960;
+const uint16_t kCoalesceNecRptSpace = 2240;
+const uint16_t kCoalesceNecBitMark = 560;
+const uint16_t kCoalesceNecRptLength = 4;
+
+#endif  // IRRECVTIMINGS_H_
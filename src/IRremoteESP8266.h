@@ -743,6 +743,591 @@
 #define ENABLE_NOISE_FILTER_OPTION true
 #endif  // ENABLE_NOISE_FILTER_OPTION
 
+// Skip protocol decoders whose header mark can't possibly match the header of
+// the captured message, rather than attempting every enabled decoder in turn.
+// The order the decoders are attempted in is unchanged.
+// The option to disable this feature is here in case a remote has a header
+// well outside of spec. i.e. It trades a little decode time for leniency.
+//
+// See: `irrecv::decode()` in IRrecv.cpp for more info.
+#ifndef ENABLE_HEADER_DISPATCH
+#define ENABLE_HEADER_DISPATCH true
+#endif  // ENABLE_HEADER_DISPATCH
+
+// Skip protocol decoders when the captured message is too short to ever be
+// one of their messages, rather than letting each decoder work that out.
+// i.e. One integer compare per decoder, before any of its matching is done.
+//
+// See: `IRrecv::minRawEntries()` in IRrecv.cpp for more info.
+#ifndef ENABLE_LENGTH_DISPATCH
+#define ENABLE_LENGTH_DISPATCH true
+#endif  // ENABLE_LENGTH_DISPATCH
+
+// Size up a NEC-like message once (its nr. of data bits, & how many blocks of
+// them it repeats), then only attempt the members of the NEC family (Aiwa RC
+// T501, Sanyo LC7461, Carrier AC, Pioneer, Epson) whose shape it has, rather
+// than each of them matching the same header & bits in turn.
+//
+// See: `IRrecv::_necFamilyMayMatch()` in IRrecv.cpp for more info.
+#ifndef ENABLE_NEC_FAMILY_DISPATCH
+#define ENABLE_NEC_FAMILY_DISPATCH true
+#endif  // ENABLE_NEC_FAMILY_DISPATCH
+
+// Let `decode()` match the protocols that are built on top of others only once
+// per capture. e.g. Denon & Panasonic are both Kaseikyo messages that only
+// differ by their manufacturer code, & Denon's 15-bit messages are Sharp ones.
+// Costs ~30 bytes of RAM per `IRrecv` object.
+//
+// See: `IRrecv::_matchKaseikyo()` in ir_Panasonic.cpp for more info.
+#ifndef ENABLE_FAMILY_MATCH_CACHE
+#define ENABLE_FAMILY_MATCH_CACHE true
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+
+// Use the smallest `IRrecv` GPIO & timeout interrupt handlers. They only store
+// the time between edges, & restart the timeout. i.e. The least IRAM, & the
+// least time spent per edge, for projects with other interrupt heavy code.
+// It is the default. It makes the default of each of the options that add to
+// the interrupt handlers `false`. Namely: `ENABLE_CAPTURE_RING`,
+// `ENABLE_COMPACT_CAPTURE`, `ENABLE_CAPTURE_HASH`, `ENABLE_ADAPTIVE_TIMEOUT`,
+// `ENABLE_GLITCH_FILTER`, `ENABLE_ECHO_SUPPRESSION`, `ENABLE_IR_MIRROR`,
+// `ENABLE_LOW_POWER_RECV`, & `ENABLE_LARGE_CAPTURE`.
+// Any of them can be turned on individually, at the cost of its share of IRAM.
+// e.g. `-DENABLE_GLITCH_FILTER=true`. Or all of them, with
+// `-DENABLE_MINIMAL_ISR=false`.
+// Note: On the ESP32, `ENABLE_ESP32_RMT_RECV` uses (next to) no IRAM at all.
+//
+// See: `tools/iram_report.py` to measure what the handlers use in a build.
+#ifndef ENABLE_MINIMAL_ISR
+#define ENABLE_MINIMAL_ISR true
+#endif  // ENABLE_MINIMAL_ISR
+
+// Allow the capture of IR messages into a ring of several buffers (slots), so
+// the interrupt handler can keep capturing new messages while older ones are
+// still waiting to be decoded. e.g. A held down button, or several devices
+// sending at once.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::enableCaptureRing()` to use it.
+//       This option is off by default, as it adds a small handful of bytes
+//       of IRAM to the interrupt handler. See `ENABLE_MINIMAL_ISR`.
+//
+// See: `IRrecv::enableCaptureRing()` in IRrecv.cpp for more info.
+#ifndef ENABLE_CAPTURE_RING
+#define ENABLE_CAPTURE_RING !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_CAPTURE_RING
+
+// Use the ESP32's RMT peripheral to capture IR messages, rather than taking a
+// GPIO interrupt per edge plus a hardware timer interrupt. The peripheral
+// timestamps the edges & detects the end of the message itself, so it costs
+// next to no CPU time per edge. e.g. Useful in rooms with noisy lighting.
+// It can run at the same time as sending via another RMT channel.
+// (`ENABLE_ESP32_RMT_SEND`) i.e. Full duplex. Messages that arrive while one
+// is being sent aren't corrupted, as neither takes an interrupt per edge.
+// `IRsend::beginAsync()` & `sendAsync()` don't block `decode()` either.
+// Note: ESP32 only. It has no effect on other platforms.
+//       The longest timeout/space it can measure is ~65ms.
+//       The capture ring (`ENABLE_CAPTURE_RING`) is not used with it. The
+//       peripheral queues the captures itself. `IRrecv::enableCaptureRing()`
+//       sets how many its queue has room for instead.
+//
+// See: `IRrecv::enableIRIn()` in IRrecv.cpp for more info.
+#ifndef ENABLE_ESP32_RMT_RECV
+#define ENABLE_ESP32_RMT_RECV false
+#endif  // ENABLE_ESP32_RMT_RECV
+
+// Have the ESP32's `IRrecv` GPIO interrupt handler restart its timeout timer
+// with direct writes to the timer's registers, rather than via the Arduino
+// HAL's `timerWrite()` & `timerAlarmEnable()`. It also gets the time since
+// the last edge from the same timer, rather than calling `micros()` for each
+// edge. i.e. Much less time spent per edge. e.g. A/C messages of 400+ edges.
+// Note: The original ESP32 only. Other platforms, & ESP32 variants (e.g. -S2,
+//       -S3, -C3) with different timer registers, always use the HAL.
+//       Not used with the ESP32 RMT receiver. (`ENABLE_ESP32_RMT_RECV`)
+//       It is off by default until it has been proven on the supported ESP32
+//       Arduino cores. Build with `-DENABLE_ESP32_TIMER_REGS=true` to try it.
+//
+// See: `IRrecv::enableIRIn()` in IRrecv.cpp for more info.
+#ifndef ENABLE_ESP32_TIMER_REGS
+#define ENABLE_ESP32_TIMER_REGS false
+#endif  // ENABLE_ESP32_TIMER_REGS
+
+// Use the ESP8266's hardware timer (timer1) for the capture timeout of the
+// first `IRrecv` object, rather than an `os_timer` (a software timer run by the
+// SDK). It is re-armed with a single register write per edge, rather than a
+// disarm & arm of the SDK timer, & it fires when the timeout runs out, even
+// if WiFi is busy. i.e. Cheaper edges, & a precise end of the message.
+// Note: ESP8266 only. It has no effect on other platforms.
+//       Any other `IRrecv` objects still use an `os_timer`.
+//       Timer1 is also used by `IRsend::enableTimerSend()`, `analogWrite()`,
+//       `tone()` & the Servo library. None of them can be used with it.
+//
+// See: `IRrecv::enableIRIn()` in IRrecv.cpp for more info.
+#ifndef ENABLE_ESP8266_TIMER_RECV
+#define ENABLE_ESP8266_TIMER_RECV false
+#endif  // ENABLE_ESP8266_TIMER_RECV
+
+// Allow `IRrecv` & `IRsend` objects to capture & send via a backend of your
+// own, rather than the built-in GPIO/timer/RMT/LEDC/UART ones. i.e. Any
+// `IRcaptureSource` or `IRsendSink` (see IRhal.h), chosen per object. e.g. An
+// I2S or DMA driver, another chip's peripheral, or a simulator, without any
+// changes to the protocol code.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::setCaptureSource()` or `IRsend::setSink()` to use it.
+//       The option to disable this feature is here if your project is _really_
+//       tight on resources. i.e. Saves a pointer per object, & a check per
+//       mark/space.
+//
+// See: `IRrecv::setCaptureSource()` in IRrecv.cpp for more info.
+#ifndef ENABLE_CUSTOM_BACKENDS
+#define ENABLE_CUSTOM_BACKENDS true
+#endif  // ENABLE_CUSTOM_BACKENDS
+
+// Allow `IRrecv` to decode in a FreeRTOS task of its own on the ESP32, pinned
+// to the other core from the Arduino `loop()`. Captures are handed to it via
+// the capture ring, and it passes the decoded messages back via a queue and/or
+// a callback. i.e. Decoding doesn't compete with the rest of the application.
+// Note: ESP32 only. It has no effect on other platforms.
+//       Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::startDecodeTask()` to use it.
+//
+// See: `IRrecv::startDecodeTask()` in IRrecv.cpp for more info.
+#ifndef ENABLE_ESP32_DECODE_TASK
+#define ENABLE_ESP32_DECODE_TASK true
+#endif  // ENABLE_ESP32_DECODE_TASK
+
+// Use one of the ESP32's LEDC (PWM) channels to generate the carrier of a
+// mark, rather than toggling the GPIO in software for every cycle of it.
+// The carrier is then exact, and unaffected by interrupts (e.g. WiFi).
+// Note: ESP32 only. It has no effect on other platforms.
+//       `IRsend::calibrate()` is not needed with it.
+//       Each `IRsend` instance needs a channel of its own. The default is
+//       `kDefaultESP32LedcChannel`. See `IRsend::setLedcChannel()`.
+//
+// See: `IRsend::mark()` in IRsend.cpp for more info.
+#ifndef ENABLE_ESP32_LEDC_SEND
+#define ENABLE_ESP32_LEDC_SEND false
+#endif  // ENABLE_ESP32_LEDC_SEND
+
+// Allow `IRsend` to hand whole messages (including any repeats & gaps) to one
+// of the ESP32's RMT channels, which then sends them in the background.
+// i.e. `loop()` isn't blocked for the duration of a long A/C message.
+// Note: ESP32 only. It has no effect on other platforms.
+//       Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRsend::enableRmtSend()` to use it.
+//
+// See: `IRsend::beginAsync()` in IRsend.cpp for more info.
+#ifndef ENABLE_ESP32_RMT_SEND
+#define ENABLE_ESP32_RMT_SEND true
+#endif  // ENABLE_ESP32_RMT_SEND
+
+// Allow `IRsend` to send whole messages in the background on the ESP8266,
+// using the hardware timer (timer1) to time every edge of the marks, spaces,
+// & the carrier from an interrupt handler. i.e. `loop()` isn't blocked.
+// Note: ESP8266 only. It has no effect on other platforms.
+//       Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRsend::enableTimerSend()` to use it.
+//       Timer1 is also used by `analogWrite()`, `tone()` & the Servo library.
+//       They can't be used while a message is being sent.
+//
+// See: `IRsend::enableTimerSend()` in IRsend.cpp for more info.
+#ifndef ENABLE_ESP8266_TIMER_SEND
+#define ENABLE_ESP8266_TIMER_SEND true
+#endif  // ENABLE_ESP8266_TIMER_SEND
+
+// Allow `IRsend` to generate the carrier of each mark on the ESP8266 with the
+// second UART's TX line (UART1 TX, i.e. GPIO2), rather than toggling the GPIO
+// in software for every cycle of it. Each carrier cycle is one (inverted)
+// serial frame, so the hardware times it exactly, & the CPU only has to keep
+// the UART's FIFO topped up.
+// Note: ESP8266 only. It has no effect on other platforms.
+//       Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRsend::enableUartSend()` to use it. Only GPIO2 can use it.
+//       Other GPIOs keep sending with the software generated carrier.
+//       `Serial1` can't be used for anything else while it is enabled.
+//
+// See: `IRsend::enableUartSend()` in IRsend.cpp for more info.
+#ifndef ENABLE_ESP8266_UART_SEND
+#define ENABLE_ESP8266_UART_SEND true
+#endif  // ENABLE_ESP8266_UART_SEND
+
+// Allow `IRsend` to measure how long each mark & space it sends really takes,
+// compared to what was asked for. i.e. To quantify the jitter & drift of the
+// software generated timings on your hardware, & to check `calibrate()`.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRsend::enableSendTiming()` to use it.
+//       The option to disable this feature is here if your project is _really_
+//       tight on resources. i.e. Saves a small handful of bytes.
+//
+// See: `IRsend::enableSendTiming()` in IRsend.cpp for more info.
+#ifndef ENABLE_SEND_TIMING
+#define ENABLE_SEND_TIMING true
+#endif  // ENABLE_SEND_TIMING
+
+// Allow `IRsend` to yield to the rest of the system (e.g. WiFi & TCP/IP on the
+// ESP8266) in the long spaces of a message, such as the gaps between its
+// sections. i.e. So very long messages, or many repeats, don't starve it.
+// The timing error that yielding causes, if any, is measured & reported.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRsend::enableCooperativeSend()` to use it.
+//       The option to disable this feature is here if your project is _really_
+//       tight on resources. i.e. Saves a small handful of bytes.
+//
+// See: `IRsend::enableCooperativeSend()` in IRsend.cpp for more info.
+#ifndef ENABLE_COOPERATIVE_SEND
+#define ENABLE_COOPERATIVE_SEND true
+#endif  // ENABLE_COOPERATIVE_SEND
+
+// Allow `IRsend` to not wait out the trailing gap of each message it sends.
+// i.e. A protocol's minimum gap/command length is still honoured, but only by
+// delaying the next message (from the same `IRsend`) if it comes too soon,
+// rather than blocking at the end of every message. Callers can use the gap.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRsend::enableDeferredGaps()` to use it.
+//       The option to disable this feature is here if your project is _really_
+//       tight on resources. i.e. Saves a small handful of bytes.
+//
+// See: `IRsend::enableDeferredGaps()` in IRsend.cpp for more info.
+#ifndef ENABLE_DEFERRED_GAPS
+#define ENABLE_DEFERRED_GAPS true
+#endif  // ENABLE_DEFERRED_GAPS
+
+// Time the carrier pulses of each mark `IRsend` generates in software with the
+// CPU's cycle counter, rather than `micros()`. It is far cheaper to read, & has
+// a sub-microsecond resolution. e.g. For a more precise 56kHz carrier.
+// Note: ESP8266 & ESP32 only. Other platforms always use `micros()`.
+//       It is off by default until its timing has been measured on hardware.
+//       Without it, the carrier is timed with `micros()`, as it always was.
+//
+// See: `IRcycleTimer` in IRtimer.cpp for more info.
+#ifndef ENABLE_CYCLE_COUNT_TIMER
+#define ENABLE_CYCLE_COUNT_TIMER false
+#endif  // ENABLE_CYCLE_COUNT_TIMER
+
+// Light & turn off the IR LED(s) `IRsend` drives in software with a single
+// GPIO register write each, rather than `digitalWrite()`. They happen twice per
+// carrier cycle, so it noticeably cuts the overhead in each one.
+// Note: ESP8266 & ESP32 only. It has no effect on other platforms.
+//       It is off by default until its `kPeriodOffset` has been measured on
+//       hardware. The default ones assume `digitalWrite()`. With it on, use
+//       `IRsend::calibrate()` to get the carrier frequency right.
+//
+// See: `IRsend::ledOn()` in IRsend.cpp for more info.
+#ifndef ENABLE_FAST_GPIO_SEND
+#define ENABLE_FAST_GPIO_SEND false
+#endif  // ENABLE_FAST_GPIO_SEND
+
+// Keep the protocol object (e.g. `IRDaikin2`) `IRac::sendAc()` uses between
+// calls, rather than constructing & setting up a fresh one on the stack every
+// time. It is created on the heap when first needed, & replaced only when the
+// protocol or model changes. Its state carries over between calls, just like
+// a real remote, so only what is in `stdAc::state_t` is re-applied.
+// Note: This is _off_ by default, as it keeps the object (up to a few hundred
+//       bytes) in use on the heap until `IRac::clearCache()` is called.
+//
+// See: `IRac::clearCache()` in IRac.cpp for more info.
+#ifndef ENABLE_IRAC_CACHE
+#define ENABLE_IRAC_CACHE false
+#endif  // ENABLE_IRAC_CACHE
+
+// Allow `IRac` to remember the messages (i.e. the marks & spaces) it sends for
+// the A/C states it is asked to send most often, & send them again directly.
+// i.e. Skip converting the state, & building the protocol's message again.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRac::enableFrameCache()` to use it.
+//       The option to disable this feature is here if your project is _really_
+//       tight on resources. i.e. Saves an `IRsend` object in every `IRac`.
+//
+// See: `IRac::enableFrameCache()` in IRac.cpp for more info.
+#ifndef ENABLE_IRAC_FRAME_CACHE
+#define ENABLE_IRAC_FRAME_CACHE true
+#endif  // ENABLE_IRAC_FRAME_CACHE
+
+// Collect per protocol statistics on how often `IRrecv::decode()` attempts,
+// skips, & successfully decodes each protocol, and how long it spends doing
+// so. Use it to find which protocols to disable or reorder for your project.
+// Note: This option is off by default, as it is instrumentation. It adds some
+//       RAM for the counters & a check to every `decode()`. Even when it is
+//       enabled, it requires calling `IRrecv::enableDecodeProfiling()` to use.
+//
+// See: `IRrecv::enableDecodeProfiling()` in IRrecv.cpp for more info.
+#ifndef ENABLE_DECODE_PROFILING
+#define ENABLE_DECODE_PROFILING false
+#endif  // ENABLE_DECODE_PROFILING
+
+// The header file, in the `src` directory or the include path, that sets the
+// order `IRrecv::decode()` tries the protocols in. The default order puts the
+// more specific protocols before those they could be mistaken for, but is
+// otherwise arbitrary. `tools/generate_decode_order.py` can make a header from
+// the `decodeProfileToString()` output of your devices, that tries the
+// protocols they actually see first, & still keeps the precedence required.
+// e.g. Build with: -D_IR_DECODE_ORDER_=MyDecodeOrder.h
+//
+// See: `tools/generate_decode_order.py` for more info.
+#ifndef _IR_DECODE_ORDER_
+#define _IR_DECODE_ORDER_ IRdecodeOrder.h
+#endif  // _IR_DECODE_ORDER_
+
+// Allow `IRrecv::decode()` to record what it does into a compact binary trace
+// buffer. i.e. Each protocol attempted, each header it was skipped for, each
+// mark & space that failed to match, and the result, with a (CPU cycle count)
+// timestamp. Unlike the DEBUG output, it is cheap enough to leave on without
+// changing the timings being investigated. Dump it with `decodeTraceToString()`
+// & make it human readable with `tools/decode_trace.py`.
+// Note: This option is off by default, as it is instrumentation. It adds a
+//       check to each step of every `decode()`. Even when it is enabled, it
+//       requires calling `IRrecv::enableDecodeTrace()` to use.
+//
+// See: `IRrecv::enableDecodeTrace()` in IRrecv.cpp for more info.
+#ifndef ENABLE_DECODE_TRACE
+#define ENABLE_DECODE_TRACE false
+#endif  // ENABLE_DECODE_TRACE
+
+// Record the most stack (found by stack painting) & heap that the major entry
+// points use. i.e. `IRrecv::decode()`, `IRac::sendAc()`,
+// `IRAcUtils::decodeToState()`, `IRAcUtils::resultAcToString()`, &
+// `resultToSourceCode()`. Use it to find (or guard against) the cause of
+// out-of-memory crashes & stack overflows.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `enableMemoryProfiling()` to use it. It is disabled by default
+//       as it costs a little time & code in each of those, & painting the
+//       stack costs more whilst it is on.
+//
+// See: `enableMemoryProfiling()` in IRutils.cpp for more info.
+#ifndef ENABLE_MEMORY_PROFILING
+#define ENABLE_MEMORY_PROFILING false
+#endif  // ENABLE_MEMORY_PROFILING
+
+// Allow `IRrecv` to capture into a compact buffer of one byte per mark/space
+// (with an escape code for long durations) instead of two. Handy for trying to
+// capture large A/C messages on boards with little free memory. e.g. ESP-01
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::enableCompactCapture()` to use it.
+//       This option is off by default, as it adds a few bytes of IRAM to the
+//       interrupt handler. See `ENABLE_MINIMAL_ISR`.
+//
+// See: `IRrecv::enableCompactCapture()` in IRrecv.cpp for more info.
+#ifndef ENABLE_COMPACT_CAPTURE
+#define ENABLE_COMPACT_CAPTURE !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_COMPACT_CAPTURE
+
+// Allow `IRrecv` to coalesce the repeats of a held button into a single
+// message with a count, instead of fully decoding & reporting each repeat.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::enableRepeatCoalescing()` to use it.
+//
+// See: `IRrecv::enableRepeatCoalescing()` in IRrecv.cpp for more info.
+#ifndef ENABLE_REPEAT_COALESCING
+#define ENABLE_REPEAT_COALESCING true
+#endif  // ENABLE_REPEAT_COALESCING
+
+// Allow `IRrecv` to switch to a receive profile for laser tag & similar
+// gaming protocols (MagiQuest, Lasertag, & Multibrackets), which arrive in
+// rapid bursts from many wands or players. It only attempts those decoders,
+// ends captures after a short gap, captures into the capture ring, and drops
+// copies of a player's message that arrive within a short window.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::enableGamingMode()` to use it.
+//
+// See: `IRrecv::enableGamingMode()` in IRrecv.cpp for more info.
+#ifndef ENABLE_GAMING_RECV
+#define ENABLE_GAMING_RECV true
+#endif  // ENABLE_GAMING_RECV
+
+// Allow `IRrecv` to remember which protocol decoded each of the last few
+// distinct messages, keyed by the `decodeHash()` hash of their captures.
+// When a capture with the same hash & length arrives (e.g. The same button
+// again) only that protocol's decoder is tried, rather than all of them.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::enableDecodeCache()` to use it.
+//
+// See: `IRrecv::enableDecodeCache()` in IRrecv.cpp for more info.
+#ifndef ENABLE_DECODE_CACHE
+#define ENABLE_DECODE_CACHE true
+#endif  // ENABLE_DECODE_CACHE
+
+// Have the `IRrecv` interrupt handler build the `decodeHash()` (UNKNOWN) hash
+// of a message as each mark/space arrives, rather than `decode()` walking the
+// whole capture for it once every other protocol has failed.
+// Note: This option is off by default, as it adds a few bytes of IRAM & a
+//       little time per edge to the interrupt handler. See
+//       `ENABLE_MINIMAL_ISR`.
+//
+// See: `IRrecv::decodeHash()` & `IRrecv::setHashOnly()` in IRrecv.cpp.
+#ifndef ENABLE_CAPTURE_HASH
+#define ENABLE_CAPTURE_HASH !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_CAPTURE_HASH
+
+// Have the `IRrecv` interrupt handler end a capture after a short gap, unless
+// its header says it is a protocol with long gaps between its sections.
+// i.e. Short (TV) messages aren't held up by a long timeout meant for A/Cs.
+// Note: This option is off by default, as it adds a few bytes of IRAM & a
+//       little time per edge to the interrupt handler. See
+//       `ENABLE_MINIMAL_ISR`.
+//
+// See: `IRrecv::enableAdaptiveTimeout()` in IRrecv.cpp.
+#ifndef ENABLE_ADAPTIVE_TIMEOUT
+#define ENABLE_ADAPTIVE_TIMEOUT !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+
+// Have the `IRrecv` interrupt handler drop pulses too short to be real (e.g.
+// noise), as they arrive, rather than storing them in the capture buffer for
+// `crudeNoiseFilter()` to remove later. i.e. Noise can't fill up the buffer.
+// Note: This option is off by default, as it adds a few bytes of IRAM & a
+//       little time per edge to the interrupt handler. See
+//       `ENABLE_MINIMAL_ISR`. Even when it is compiled in, the filter stays
+//       off until it is turned on at runtime with `setGlitchFilter()`.
+//
+// See: `IRrecv::setGlitchFilter()` in IRrecv.cpp.
+#ifndef ENABLE_GLITCH_FILTER
+#define ENABLE_GLITCH_FILTER !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_GLITCH_FILTER
+
+// Let `IRrecv::decode()` make what it can of an overflowed capture of a multi
+// section A/C message. i.e. Report the complete sections at its start as a
+// truncated result, & (with the capture ring) join it up with the rest of the
+// message from the capture that followed it, if it carried straight on.
+// Note: Even when this option is enabled, it is _off_ by default.
+//
+// See: `IRrecv::setPartialDecode()` in IRrecv.cpp.
+#ifndef ENABLE_PARTIAL_DECODE
+#define ENABLE_PARTIAL_DECODE true
+#endif  // ENABLE_PARTIAL_DECODE
+
+// Let an `IRrecv` ignore what an `IRsend` on the same device transmits. i.e.
+// Its own echo. The `IRsend` publishes when it is transmitting, & the `IRrecv`
+// interrupt handler drops the edges it sees then, so the echo is never
+// captured, let alone decoded.
+// Note: This option is off by default, as it adds a few bytes of IRAM & a
+//       little time per edge to the interrupt handler. See
+//       `ENABLE_MINIMAL_ISR`. Even when it is compiled in, the filter stays
+//       off until it is turned on at runtime with `setGlitchFilter()`.
+//
+// See: `IRrecv::ignoreEcho()` in IRrecv.cpp.
+#ifndef ENABLE_ECHO_SUPPRESSION
+#define ENABLE_ECHO_SUPPRESSION !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_ECHO_SUPPRESSION
+
+// Let an `IRrecv` mirror what it receives straight out of an `IRsend`, edge by
+// edge, from its GPIO interrupt handler. i.e. A repeater whose copy lags the
+// original by microseconds, rather than by a whole message, & that repeats
+// any protocol, known or not. The carrier is regenerated by hardware.
+// Note: This option is off by default, as it adds a few bytes of IRAM & a
+//       little time per edge to the interrupt handler. See
+//       `ENABLE_MINIMAL_ISR`. Even when it is compiled in, the filter stays
+//       off until it is turned on at runtime with `setGlitchFilter()`.
+//
+// See: `IRrecv::mirrorTo()` in IRrecv.cpp for more info.
+#ifndef ENABLE_IR_MIRROR
+#define ENABLE_IR_MIRROR !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_IR_MIRROR
+
+// Offer `IRrecvStatic<bufsize>`. An `IRrecv` whose capture (& save) buffers are
+// part of the object rather than allocated from the heap. e.g. Declared as a
+// global, they are in .bss. So startup is deterministic, & a receiver can be
+// (re)created in a long-running, fragmented heap without the risk of failing.
+// Note: The option to disable this feature is here to save a handful of bytes.
+//
+// See: `IRrecvStatic` in IRrecv.h for more info.
+#ifndef ENABLE_STATIC_RECV_BUFFERS
+#define ENABLE_STATIC_RECV_BUFFERS true
+#endif  // ENABLE_STATIC_RECV_BUFFERS
+
+// Let a battery powered device light-sleep while it waits for an IR message.
+// `IRrecv::sleepUntilIR()` sleeps until the first edge of a message wakes the
+// CPU via a GPIO wakeup, & the capture is credited with the time it took to
+// wake, so the header mark is still the right length.
+// Note: ESP8266 & ESP32 only, & not with the ESP32 RMT receiver.
+//       This option is off by default, as it adds a few bytes of IRAM & a
+//       little time per capture to the interrupt handler. See
+//       `ENABLE_MINIMAL_ISR`.
+//
+// See: `IRrecv::sleepUntilIR()` in IRrecv.cpp for more info.
+#ifndef ENABLE_LOW_POWER_RECV
+#define ENABLE_LOW_POWER_RECV !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_LOW_POWER_RECV
+
+// Report how well the timings of each decoded message fitted its protocol.
+// i.e. The mean & worst timing errors, & how many were close to the limit of
+// the tolerance, in `decode_results::quality`. A link-quality indicator.
+// Note: Even when this option is enabled, it is _off_ by default.
+//       The option to disable this feature is here to save a few bytes per
+//       `decode_results`.
+//
+// See: `IRrecv::setSignalQuality()` in IRrecv.cpp for more info.
+#ifndef ENABLE_SIGNAL_QUALITY
+#define ENABLE_SIGNAL_QUALITY true
+#endif  // ENABLE_SIGNAL_QUALITY
+
+// Let `IRrecv::decodeBudget()` stop trying protocols once a time budget has
+// been spent, & carry on from the next one on a later call. i.e. A long
+// capture decoded with every protocol & a `max_skip` can't hold up the main
+// loop (WiFi, a web server, etc) for longer than the budget, give or take the
+// longest single decoder. The capture is kept until it has been decoded.
+// Note: The option to disable this feature is here to save a few bytes of RAM
+//       per `IRrecv` object.
+//
+// See: `IRrecv::decodeBudget()` in IRrecv.cpp for more info.
+#ifndef ENABLE_BUDGETED_DECODE
+#define ENABLE_BUDGETED_DECODE true
+#endif  // ENABLE_BUDGETED_DECODE
+
+// Let a tolerance & mark excess be set at run time for a few protocols, in
+// place of the ones their decoders use. e.g. To help one flaky remote, without
+// widening `IRrecv::setTolerance()` (& the false matches it brings) for all
+// the other protocols. The scaling of each is worked out when it is set, so
+// matching its protocol needs no floating point maths.
+// Note: The option to disable this feature is here to save a little RAM per
+//       `IRrecv` object.
+//
+// See: `IRrecv::setProtocolTolerance()` in IRrecv.cpp for more info.
+#ifndef ENABLE_PROTOCOL_TOLERANCE
+#define ENABLE_PROTOCOL_TOLERANCE true
+#endif  // ENABLE_PROTOCOL_TOLERANCE
+
+// Let simple (pulse-distance) protocols be registered at run time. e.g. From a
+// config file, or over MQTT. `IRsend::send()` & `IRrecv::decode()` then handle
+// them like the built-in ones, without a new firmware.
+// Note: Even when this option is enabled, nothing extra is decoded until a
+//       protocol is registered via `ircustom::add()`.
+//       The option to disable this feature is here to save a little program
+//       space, & a check per message sent & decoded.
+//
+// See: `IRcustom.h` for more info.
+#ifndef ENABLE_CUSTOM_PROTOCOLS
+#define ENABLE_CUSTOM_PROTOCOLS true
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+
+// Measure the carrier frequency of each message captured from a raw (i.e. not
+// demodulated) input, & skip the decoders of protocols sent with a different
+// one. e.g. A 40kHz capture can't be NEC, & a 56kHz one can't be Sony. So far
+// fewer protocols' timings are matched. A raw input is an IR photodiode or
+// transistor, rather than a TSOP-style IR receiver module, captured by the
+// ESP32's RMT peripheral. (`ENABLE_ESP32_RMT_RECV`) It demodulates the
+// carrier pulses into the usual marks & spaces.
+// Note: Even when this option is enabled, it has no effect until
+//       `IRrecv::setCarrierInput()` is called. Other inputs can't measure it.
+//       The option to disable this feature is here to save a little program
+//       space, & a check per decoder attempted.
+//
+// See: `IRrecv::setCarrierInput()` in IRrecv.cpp for more info.
+#ifndef ENABLE_CARRIER_FILTER
+#define ENABLE_CARRIER_FILTER true
+#endif  // ENABLE_CARRIER_FILTER
+
+// Allow `IRrecv` to capture into a large buffer, allocated from PSRAM on ESP32
+// boards that have it, rather than internal RAM. e.g. Learning the 2000-4000
+// entry messages of some A/C units, which won't fit next to WiFi. The GPIO
+// interrupt handler can't safely write to PSRAM, so it captures into a small
+// ring of internal RAM, which a task drains into the large buffer.
+// Note: Even when this option is enabled, it is _off_ by default, and requires
+//       calling `IRrecv::enableLargeCapture()` to use it.
+//       This option is off by default, as it adds a few bytes of IRAM to the
+//       interrupt handler. See `ENABLE_MINIMAL_ISR`.
+//
+// See: `IRrecv::enableLargeCapture()` in IRrecv.cpp for more info.
+#ifndef ENABLE_LARGE_CAPTURE
+#define ENABLE_LARGE_CAPTURE !ENABLE_MINIMAL_ISR
+#endif  // ENABLE_LARGE_CAPTURE
+
 /// Enumerator for defining and numbering of supported IR protocol.
 /// @note Always add to the end of the list and should never remove entries
 ///  or change order. Projects may save the type number for later usage
@@ -847,6 +1432,168 @@ enum decode_type_t {
   kLastDecodeType = TECHNIBEL_AC,
 };
 
+/// A declarative description of a simple pulse-distance protocol.
+/// i.e. An optional header, a fixed number of data bits, & a footer.
+/// All of the timings are in micro-seconds. A zero duration is not sent, nor
+/// matched.
+/// @see IRsend::sendPulseDistance(), IRrecv::decodePulseDistance()
+typedef struct {
+  decode_type_t protocol;  ///< The protocol a successful decode reports.
+  uint16_t nbits;          ///< The nr. of data bits in a message.
+  uint16_t hdrmark;        ///< Header mark.
+  uint32_t hdrspace;       ///< Header space.
+  uint16_t onemark;        ///< Mark of a one bit.
+  uint32_t onespace;       ///< Space of a one bit.
+  uint16_t zeromark;       ///< Mark of a zero bit.
+  uint32_t zerospace;      ///< Space of a zero bit.
+  uint16_t footermark;     ///< Footer mark.
+  uint32_t gap;            ///< The minimum gap after the footer mark.
+  uint16_t frequency;      ///< Modulation frequency in Hz (or kHz if < 1000)
+  uint8_t dutycycle;       ///< Percentage duty cycle of the carrier.
+  bool MSBfirst;           ///< Are the data bits sent in MSB order?
+  uint16_t minrepeats;     ///< The nr. of repeats a device typically needs.
+} pulse_distance_t;
+
+// N.B. The rest of the irutils namespace is in IRutils.h. These live here so
+// the protocol descriptions below can use them.
+namespace irutils {
+  /// The ways a `checksum_t` section's checksum byte can be calculated.
+  enum checksum_method_t {
+    kSumBytesChecksum = 0,  ///< sumBytes() of the section.
+    kXorBytesChecksum,      ///< xorBytes() of the section.
+    kSumNibblesChecksum,    ///< sumNibbles() of the section.
+  };
+  /// Use as a `checksum_t.length` for a section that runs to the end of the
+  /// state. e.g. For protocols with a variable length last section.
+  const uint16_t kChecksumToEnd = 0;
+  /// How the checksum for a section of a state is calculated.
+  /// The checksum is the last byte of the section, and it covers the rest.
+  /// A protocol declares a table of these once, and uses the `*Checksums()`
+  /// functions to check, set, or update them.
+  typedef struct {
+    uint8_t method;   ///< A `checksum_method_t` value.
+    uint16_t start;   ///< Index of the first byte of the section.
+    uint16_t length;  ///< Nr. of bytes in the section incl. the checksum byte.
+    uint8_t init;     ///< Starting value of the calculation.
+  } checksum_t;
+
+  /// A byte of a state that is always the same, or the bits of it that are.
+  /// e.g. A vendor ID or a signature. Tells a protocol's messages apart from
+  /// others with the same timings. See `IRrecv::matchBytes()`.
+  typedef struct {
+    uint16_t index;  ///< Index of the byte.
+    uint8_t mask;    ///< The bits of it that are fixed.
+    uint8_t value;   ///< What those bits are.
+  } fixed_byte_t;
+
+  /// A mixin for A/C classes whose `getRaw()` fills in the checksum.
+  /// It remembers if the state has changed since the checksum was last set,
+  /// so repeated `getRaw()` calls (e.g. from `IRac`) don't recalculate it.
+  /// Every method that changes the state must call `stateChanged()`, and
+  /// `getRaw()` only calls `checksum()` if `checksumStale()`.
+  class LazyChecksum {
+   protected:
+    LazyChecksum(void) : _checksum_stale(true) {}
+    /// Note the state has changed, so the checksum needs setting again.
+    void stateChanged(void) { _checksum_stale = true; }
+    /// Does the checksum need setting? It is assumed it will be if so.
+    /// @return true, if the state has changed since it was last set.
+    bool checksumStale(void) {
+      const bool stale = _checksum_stale;
+      _checksum_stale = false;
+      return stale;
+    }
+
+   private:
+    bool _checksum_stale;  ///< Has the state changed since the last checksum?
+  };
+}  // namespace irutils
+
+/// A declarative description of a multi-section A/C message.
+/// i.e. A series of sections that share the same header, bit & footer
+/// timings, with a gap after each one.
+/// The last section is whatever remains of the message, so variable length
+/// messages only need a different total length.
+/// All of the timings are in micro-seconds. A zero duration is not sent, nor
+/// matched.
+/// @see IRsend::sendSections(), IRrecv::matchSections()
+typedef struct {
+  uint16_t hdrmark;        ///< Section header mark.
+  uint32_t hdrspace;       ///< Section header space.
+  uint16_t onemark;        ///< Mark of a one bit.
+  uint32_t onespace;       ///< Space of a one bit.
+  uint16_t zeromark;       ///< Mark of a zero bit.
+  uint32_t zerospace;      ///< Space of a zero bit.
+  uint16_t footermark;     ///< Section footer mark.
+  uint32_t gap;            ///< The gap after each section.
+  uint16_t frequency;      ///< Modulation frequency in Hz (or kHz if < 1000)
+  uint8_t dutycycle;       ///< Percentage duty cycle of the carrier.
+  bool MSBfirst;           ///< Are the bits of each byte sent in MSB order?
+  const uint8_t *sizes;    ///< Nr. of bytes in each section, but the last.
+  uint8_t sections;        ///< Nr. of sections in a message.
+  /// The checksums to verify, each as soon as its section has been matched.
+  const irutils::checksum_t *checksums;
+  uint8_t nchecksums;      ///< Nr. of entries in `checksums`.
+} ac_sections_t;
+
+/// When an `IRsend` is transmitting, or last transmitted, so the `IRrecv`s
+/// next to it can ignore the echo. The times are as per `micros()`.
+/// @see IRsend::getEcho(), IRrecv::ignoreEcho()
+typedef struct {
+  volatile uint32_t from;    ///< When the transmission started. (uSeconds)
+  volatile uint32_t length;  ///< How long its echo lasts. 0 if none. (uSecs)
+} ir_echo_t;
+
+/// A constant section of a message, compiled once into its marks & spaces.
+/// e.g. The first section of protocols whose first bytes never change.
+/// It is replayed as is, so those bytes don't need to be encoded each time.
+/// @see IRsend::sendPrecompiled(), IR_PULSES_LSB_BYTE()
+typedef struct {
+  const uint8_t *data;     ///< The bytes the section encodes.
+  uint16_t nbytes;         ///< Nr. of bytes in `data`.
+  const uint16_t *pulses;  ///< PROGMEM array of mark & space durations.
+  uint16_t npulses;        ///< Nr. of entries in `pulses`.
+} precompiled_section_t;
+
+/// The mark & space of one bit of a pulse distance encoded message.
+/// For building the `pulses` of a `precompiled_section_t` at compile time.
+#define IR_PULSES_BIT(mark, one, zero, bit) (mark), ((bit) ? (one) : (zero))
+/// The marks & spaces of one byte, LSB first. See `IR_PULSES_BIT()`.
+#define IR_PULSES_LSB_BYTE(mark, one, zero, byte) \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x01), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x02), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x04), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x08), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x10), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x20), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x40), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x80)
+/// The marks & spaces of one byte, MSB first. See `IR_PULSES_BIT()`.
+#define IR_PULSES_MSB_BYTE(mark, one, zero, byte) \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x80), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x40), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x20), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x10), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x08), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x04), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x02), \
+    IR_PULSES_BIT(mark, one, zero, (byte) & 0x01)
+
+/// The frame shared by the Gree family of protocols. i.e. Gree & Kelvinator.
+/// A header, a 4 byte block, a 3 bit (0b010) footer & a gap, then the rest of
+/// the bytes, a footer mark & the frame gap.
+/// A Gree message is one of these frames. A Kelvinator message is two.
+/// @see IRsend::sendGreeFrame(), IRrecv::matchGreeFrame()
+typedef struct {
+  uint16_t hdrmark;    ///< The header mark.
+  uint32_t hdrspace;   ///< The header space.
+  uint16_t bitmark;    ///< The mark of every bit & of the footers.
+  uint32_t onespace;   ///< The space of a `1` bit.
+  uint32_t zerospace;  ///< The space of a `0` bit.
+  uint32_t blockgap;   ///< The space after the mid-frame footer.
+  uint32_t framegap;   ///< The space after the frame.
+} gree_frame_t;
+
 // Message lengths & required repeat values
 const uint16_t kNoRepeat = 0;
 const uint16_t kSingleRepeat = 1;
@@ -861,6 +1608,8 @@ const uint16_t kAmcorBits = kAmcorStateLength * 8;
 const uint16_t kAmcorDefaultRepeat = kSingleRepeat;
 const uint16_t kArgoStateLength = 12;
 const uint16_t kArgoBits = kArgoStateLength * 8;
+const uint16_t kArgoShortStateLength = 4;
+const uint16_t kArgoShortBits = kArgoShortStateLength * 8;
 const uint16_t kArgoDefaultRepeat = kNoRepeat;
 const uint16_t kCoolixBits = 24;
 const uint16_t kCoolixDefaultRepeat = kSingleRepeat;
@@ -0,0 +1,231 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRrepeater.cpp
+/// @brief Retransmit captured IR messages, with as little delay as possible.
+
+#include "IRrepeater.h"
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif
+#include <algorithm>
+
+#ifdef UNIT_TEST
+extern uint32_t _IRtimer_unittest_now;
+#endif  // UNIT_TEST
+
+/// The current time, on the same clock the capture is timestamped with.
+/// i.e. Not `IRtimer`, which jumps ahead when messages are sent in the
+/// background.
+/// @return The time in uSeconds.
+static uint32_t nowUsecs(void) {
+#ifndef UNIT_TEST
+  return micros();
+#else  // UNIT_TEST
+  return _IRtimer_unittest_now;
+#endif  // UNIT_TEST
+}
+
+/// Class constructor.
+/// @param[in] irrecv The receiver to repeat the messages of. It must already
+///   be capturing. i.e. `enableIRIn()`
+/// @param[in] irsend Where to retransmit them. It must already be `begin()`-ed.
+/// @param[in] frequency The carrier to retransmit at. (Hz)
+/// @param[in] size Nr. of marks & spaces the largest message may have.
+IRrepeater::IRrepeater(IRrecv *irrecv, IRsend *irsend,
+                       const uint16_t frequency, const uint16_t size)
+    : _irrecv(irrecv), _irsend(irsend), _sequence(size), _freq(frequency),
+      _cut_through(0), _next(0), _quiet(0), _latency(0), _repeated(0),
+      _held(false) {}
+
+/// Start retransmitting each message a fixed time after it starts arriving,
+/// rather than waiting until it has ended. i.e. "Cut-through" mode.
+/// @param[in] delay How long after a message starts to start repeating it.
+///   (uSeconds) It should be longer than the longest mark of the messages, as
+///   each mark is only sent once it has arrived in full. 0 turns it off.
+/// @note The receiver must not be able to see the IR LED, as it is still
+///   capturing while the message is being repeated.
+/// @note `handle()` blocks until the message has been repeated, so call it
+///   often. Messages shorter than the delay are repeated once they end.
+void IRrepeater::setCutThrough(const uint32_t delay) { _cut_through = delay; }
+
+/// Get how long after a message starts it is repeated. See `setCutThrough()`.
+/// @return The delay in uSeconds, or 0 if cut-through mode is off.
+uint32_t IRrepeater::getCutThrough(void) { return _cut_through; }
+
+/// How far behind the original the last repeated message started.
+/// i.e. The repeat latency.
+/// @return The time in uSeconds.
+uint32_t IRrepeater::getLatency(void) { return _latency; }
+
+/// Get the nr. of messages that have been repeated.
+/// @return The count.
+uint32_t IRrepeater::getRepeated(void) { return _repeated; }
+
+/// Get the last message repeated without cut-through.
+/// @return A PTR to the sequence. Empty if there hasn't been one.
+const IRsequence *IRrepeater::getSequence(void) { return &_sequence; }
+
+/// Repeat a message if one has arrived (or, in cut-through mode, is still
+/// arriving). Call it often from your main loop.
+/// @param[out] results Where to decode the message to, for logging. It is
+///   decoded after it has been (or while it is being) retransmitted, & is
+///   UNKNOWN if it couldn't be. NULL to not decode it at all.
+/// @return true, if a message was repeated. Otherwise false.
+bool IRrepeater::handle(decode_results *results) {
+  if (_held) {  // Keep the capture until our own message has been sent.
+#if IRSEND_ASYNC
+    if (_irsend->isBusy()) return false;
+#endif  // IRSEND_ASYNC
+    _held = false;
+    _irrecv->resume();
+  }
+  if (!_direct()) return _forward(results);
+  volatile irparams_t *params = _irrecv->_params;
+  // Is it time to start cutting a message through?
+  if (_cut_through && (_next || (params->rcvstate == kMarkState &&
+                                 nowUsecs() - params->started >= _cut_through)))
+    return _stream(results);
+  if (params->rcvstate != kStopState) return false;
+  _compile(params->rawbuf, params->rawlen);
+  _begin(params->started);
+  _send();
+  return _finish(results);
+}
+
+/// Is the capture buffer filled in directly by the interrupt handler?
+/// i.e. Can the capture be read from, while the message may still be arriving?
+/// @return true, if it is. false if it has to be fetched by `decode()`.
+bool IRrepeater::_direct(void) {
+#if defined(ESP32) && ENABLE_ESP32_RMT_RECV && !defined(UNIT_TEST)
+  return false;  // The RMT peripheral's capture is collected by decode().
+#endif  // defined(ESP32) && ENABLE_ESP32_RMT_RECV && !defined(UNIT_TEST)
+#if ENABLE_CAPTURE_RING
+  if (_irrecv->_params->slots) return false;
+#endif  // ENABLE_CAPTURE_RING
+#if ENABLE_COMPACT_CAPTURE
+  if (_irrecv->_params->packed != NULL) return false;
+#endif  // ENABLE_COMPACT_CAPTURE
+#if ENABLE_LARGE_CAPTURE
+  if (_irrecv->_params->staging != NULL) return false;  // Drained by decode().
+#endif  // ENABLE_LARGE_CAPTURE
+  return true;
+}
+
+/// The duration to retransmit an entry of a capture for.
+/// i.e. Corrected for how much longer the receiver makes each mark appear.
+/// @param[in] index Which entry of the capture. Odd entries are marks.
+/// @param[in] ticks Its captured duration. (kRawTick units)
+/// @return The duration in uSeconds. Never 0.
+uint32_t IRrepeater::_usecs(const uint16_t index, const uint16_t ticks) {
+  const int32_t excess = _irrecv->getMarkExcess();
+  const int32_t usecs = ticks * kRawTick + ((index & 1) ? -excess : excess);
+  return std::max(usecs, (int32_t)1);
+}
+
+/// Compile a capture into the sequence to retransmit.
+/// @param[in] rawbuf The capture. The first entry is a dummy, & is skipped.
+/// @param[in] rawlen Nr. of entries in it.
+void IRrepeater::_compile(const uint16_t *rawbuf, const uint16_t rawlen) {
+  _sequence.clear();
+  _sequence.setCarrier(_freq, kDutyDefault);
+  for (uint16_t i = 1; i < rawlen; i++)
+    _sequence.add(i & 1, _usecs(i, rawbuf[i]));
+}
+
+/// Note that a message is starting to be repeated.
+/// @param[in] started When the original started arriving. (uSeconds)
+void IRrepeater::_begin(const uint32_t started) {
+  _latency = nowUsecs() - started;
+  _repeated++;
+}
+
+/// Retransmit the sequence. In the background, if the `IRsend` can.
+void IRrepeater::_send(void) {
+#if IRSEND_ASYNC
+  if (_irsend->beginAsync()) {
+    _irsend->sendSequence(&_sequence);  // Only recorded, not sent.
+    _held = _irsend->sendAsync();
+    if (_held) return;
+  }
+#endif  // IRSEND_ASYNC
+  _irsend->sendSequence(&_sequence);
+}
+
+/// Retransmit the complete entries of the message still arriving, then wait
+/// for more until it has ended. i.e. Cut-through mode.
+/// Each mark is sent once it has arrived in full. The space before each mark
+/// is already under way while that mark arrives, so only the rest of a space
+/// is sent. Hence the output lags the input by the cut-through delay, give or
+/// take, as long as each mark is shorter than it.
+/// @param[out] results See `handle()`.
+/// @return true, if the whole message has been repeated. Otherwise false.
+bool IRrepeater::_stream(decode_results *results) {
+  volatile irparams_t *params = _irrecv->_params;
+  if (!_next) {  // The start of the message.
+    _begin(params->started);
+    _irsend->enableIROut(_freq);
+    _quiet = nowUsecs();
+    _next = 1;  // Skip the dummy entry.
+  }
+  while (true) {
+    // The state is read first. A capture that has stopped has all its entries.
+    const bool stopped = params->rcvstate == kStopState;
+    for (; _next < params->rawlen; _next++) {
+      uint32_t usecs = _usecs(_next, params->rawbuf[_next]);
+      if (_next & 1) {  // A mark.
+        // Only a space can exceed the 16 bits of mark().
+        for (; usecs > UINT16_MAX; usecs -= UINT16_MAX)
+          _irsend->mark(UINT16_MAX);
+        _irsend->mark(usecs);
+        _quiet = nowUsecs();
+      } else {  // A space. It started when the output went quiet.
+        const uint32_t elapsed = nowUsecs() - _quiet;
+        if (usecs > elapsed) _irsend->space(usecs - elapsed);
+      }
+    }
+    if (stopped) break;
+#ifdef UNIT_TEST
+    return false;  // The edges are only delivered between calls.
+#else  // UNIT_TEST
+    yield();  // Wait for the next entry to arrive.
+#endif  // UNIT_TEST
+  }
+  _irsend->space(0);  // Make sure the LED is off.
+  _next = 0;
+  return _finish(results);
+}
+
+/// Repeat a capture that has to be fetched by `decode()` first.
+/// e.g. From the capture ring. It is decoded before it is sent, so is slower.
+/// @param[out] results See `handle()`.
+/// @return true, if a message was repeated. Otherwise false.
+bool IRrepeater::_forward(decode_results *results) {
+  decode_results capture;
+  if (results == NULL) results = &capture;
+  if (!_irrecv->decode(results)) return false;
+  _compile(const_cast<uint16_t *>(results->rawbuf), results->rawlen);
+  _begin(results->started);
+  _send();
+  if (!_held) _irrecv->resume();
+  return true;
+}
+
+/// Finish repeating a message from the capture buffer.
+/// i.e. Decode it (if asked to) & start capturing the next one, unless it is
+/// still being sent in the background.
+/// @param[out] results See `handle()`.
+/// @return Always true. i.e. A message was repeated.
+bool IRrepeater::_finish(decode_results *results) {
+  if (results != NULL) {
+    volatile irparams_t *params = _irrecv->_params;
+    // Decode it from the capture buffer. decode() does the same on a device.
+    results->rawbuf = params->rawbuf;
+    results->rawlen = params->rawlen;
+    results->overflow = params->overflow;
+    results->started = params->started;
+    results->stopped = params->stopped;
+    if (!_irrecv->decode(results)) results->decode_type = UNKNOWN;
+  }
+  if (!_held) _irrecv->resume();
+  return true;
+}
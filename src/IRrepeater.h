@@ -0,0 +1,72 @@
+#ifndef IRREPEATER_H_
+#define IRREPEATER_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+#include "IRsend.h"
+
+// Constants
+/// Default carrier frequency messages are repeated at. (Hz)
+/// The receiver's demodulator removes the original carrier, so it is unknown.
+const uint16_t kRepeaterDefaultFrequency = 38000;
+
+/// Retransmits whatever an `IRrecv` captures out of an `IRsend`, straight
+/// from the capture's raw timings. i.e. Nothing has to be decoded first, so
+/// unknown protocols are repeated as quickly as known ones.
+/// The capture is compiled into an `IRsequence` & sent. It is then decoded
+/// while it is being sent (if the `IRsend` can send in the background), only
+/// so the caller can log what it was.
+/// Optionally, in "cut-through" mode, it starts retransmitting a fixed delay
+/// after a message starts arriving, rather than after it has ended.
+/// e.g.
+///   IRrepeater repeater(&irrecv, &irsend);
+///   repeater.setCutThrough(15000);  // Optional.
+///   ...
+///   if (repeater.handle(&results)) Serial.println(resultToHumanReadableBasic(
+///       &results));
+/// @note The `IRrecv` should be created without a `save_buffer`, so a capture
+///   isn't overwritten (or our own message captured) until it has been sent.
+///   The capture ring, compact capture & the ESP32's RMT receiver aren't read
+///   from directly. Their messages are decoded first, then repeated.
+class IRrepeater {
+ public:
+  explicit IRrepeater(IRrecv *irrecv, IRsend *irsend,
+                      const uint16_t frequency = kRepeaterDefaultFrequency,
+                      const uint16_t size = kSequenceDefaultSize);
+  void setCutThrough(const uint32_t delay);
+  uint32_t getCutThrough(void);
+  bool handle(decode_results *results = NULL);
+  uint32_t getLatency(void);
+  uint32_t getRepeated(void);
+  const IRsequence *getSequence(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRrecv *_irrecv;
+  IRsend *_irsend;
+  IRsequence _sequence;  // The last message repeated. (store & forward)
+  uint16_t _freq;  // Hz
+  uint32_t _cut_through;  // uSecs after a message starts to repeat it. 0: Off
+  uint16_t _next;  // The next capture entry to cut-through. 0 if not started.
+  uint32_t _quiet;  // When the output last went quiet. (uSeconds)
+  uint32_t _latency;  // How far behind the original the last repeat was.
+  uint32_t _repeated;  // Nr. of messages repeated.
+  bool _held;  // Is the capture being kept until a background send is done?
+  bool _direct(void);
+  uint32_t _usecs(const uint16_t index, const uint16_t ticks);
+  void _compile(const uint16_t *rawbuf, const uint16_t rawlen);
+  void _begin(const uint32_t started);
+  void _send(void);
+  bool _stream(decode_results *results);
+  bool _forward(decode_results *results);
+  bool _finish(decode_results *results);
+  IRrepeater(const IRrepeater &);  // Not copyable, as it owns a sequence.
+  IRrepeater &operator=(const IRrepeater &);
+};
+
+#endif  // IRREPEATER_H_
@@ -5,15 +5,85 @@
 #include "IRsend.h"
 #ifndef UNIT_TEST
 #include <Arduino.h>
+#if defined(ESP32)
+#include <soc/gpio_reg.h>
+#include <soc/gpio_sig_map.h>
+#include <soc/soc.h>
+#endif  // ESP32
 #else
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
 #endif
+#include <string.h>
 #include <algorithm>
 #ifdef UNIT_TEST
 #include <cmath>
 #endif
+#include "IRcustom.h"
+#include "IRsendTable.h"
 #include "IRtimer.h"
+#include "IRutils.h"
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#endif
+#if defined(UNIT_TEST) && !defined(memcpy_P)
+#define memcpy_P memcpy  // Pretend we have memcpy_P() even if we really don't.
+#endif  // defined(UNIT_TEST) && !defined(memcpy_P)
+#if defined(ESP32) && ENABLE_ESP32_LEDC_SEND && !defined(UNIT_TEST)
+#define IRSEND_USE_LEDC true
+#else  // defined(ESP32) && ENABLE_ESP32_LEDC_SEND && !defined(UNIT_TEST)
+#define IRSEND_USE_LEDC false
+#endif  // defined(ESP32) && ENABLE_ESP32_LEDC_SEND && !defined(UNIT_TEST)
+// Code called from an `IRrecv`'s GPIO interrupt handler. See `mirrorMark()`.
+#if ENABLE_IR_MIRROR && defined(ESP8266) && !defined(UNIT_TEST)
+#define MIRROR_IRAM_ATTR ICACHE_RAM_ATTR
+#elif ENABLE_IR_MIRROR && defined(ESP32) && !defined(UNIT_TEST)
+#define MIRROR_IRAM_ATTR IRAM_ATTR
+#else  // ENABLE_IR_MIRROR && defined(ESP8266) && !defined(UNIT_TEST)
+#define MIRROR_IRAM_ATTR
+#endif  // ENABLE_IR_MIRROR && defined(ESP8266) && !defined(UNIT_TEST)
+#if defined(ESP32) && !defined(UNIT_TEST)
+// Messages can be added to an IRsendQueue from any task.
+static portMUX_TYPE send_queue_mux = portMUX_INITIALIZER_UNLOCKED;
+#define SEND_QUEUE_LOCK() portENTER_CRITICAL(&send_queue_mux)
+#define SEND_QUEUE_UNLOCK() portEXIT_CRITICAL(&send_queue_mux)
+#else  // defined(ESP32) && !defined(UNIT_TEST)
+#define SEND_QUEUE_LOCK()
+#define SEND_QUEUE_UNLOCK()
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+#if IRSEND_RMT
+#include <driver/rmt.h>
+
+// Longest duration a single RMT item half can hold. (1us ticks)
+const uint16_t kRmtMaxDuration = 0x7FFF;
+// The IRsend instance using each RMT channel, if any.
+static IRsend *rmt_senders[kDefaultESP32RmtSendChannel + 1] = {NULL};
+
+/// Called by the RMT driver (from its interrupt handler) when a channel has
+/// finished sending.
+static void rmt_tx_end(rmt_channel_t channel, void *) {
+  IRsend::_rmtSent(channel);
+}
+#endif  // IRSEND_RMT
+#if IRSEND_TIMER
+const uint32_t kTimerTicksPerUsec = 5;  // Timer1 at 80MHz / 16. (TIM_DIV16)
+// Shortest time to arm the timer for. (Ticks) i.e. ~2us, so the interrupt
+// handler has returned before it fires again.
+const uint32_t kTimerMinTicks = 10;
+// The IRsend instance using timer1, if any.
+static IRsend *timer_sender = NULL;
+#endif  // IRSEND_TIMER
+#if ENABLE_ECHO_SUPPRESSION && defined(UNIT_TEST)
+extern uint32_t _IRtimer_unittest_now;
+#endif  // ENABLE_ECHO_SUPPRESSION && defined(UNIT_TEST)
+
+IRsequence *IRsend::_all_sequence = NULL;
+#if ENABLE_ESP32_LEDC_SEND
+IRsend::ledc_carrier_t IRsend::_ledc_carriers[kESP32LedcChannels] = {};
+#endif  // ENABLE_ESP32_LEDC_SEND
 
 /// Constructor for an IRsend object.
 /// @param[in] IRsendPin Which GPIO pin to use when sending an IR command.
@@ -26,7 +96,30 @@
 ///  i.e. If not, assume a 100% duty cycle. Ignore attempts to change the
 ///  duty cycle etc.
 IRsend::IRsend(uint16_t IRsendPin, bool inverted, bool use_modulation)
-    : IRpin(IRsendPin), periodOffset(kPeriodOffset) {
+    : IRpin(IRsendPin), periodOffset(kPeriodOffset), _sequence(NULL),
+      _pin_mask(0) {
+  clearPeriodOffsets();
+#ifdef UNIT_TEST
+  _freq_unittest = 0;
+  _yield_unittest = 0;
+#endif  // UNIT_TEST
+#if ENABLE_SEND_TIMING
+  _timing_enabled = false;
+  _timing_log = NULL;
+  _timing_log_size = 0;
+  memset(&_timing, 0, sizeof(_timing));
+#endif  // ENABLE_SEND_TIMING
+#if ENABLE_COOPERATIVE_SEND
+  _coop_budget = 0;
+  memset(&_coop, 0, sizeof(_coop));
+#endif  // ENABLE_COOPERATIVE_SEND
+#if ENABLE_DEFERRED_GAPS
+  _defer_gaps = false;
+  _gap_pending = 0;
+#endif  // ENABLE_DEFERRED_GAPS
+#if ENABLE_CUSTOM_BACKENDS
+  _sink = NULL;
+#endif  // ENABLE_CUSTOM_BACKENDS
   if (inverted) {
     outputOn = LOW;
     outputOff = HIGH;
@@ -39,28 +132,268 @@ IRsend::IRsend(uint16_t IRsendPin, bool inverted, bool use_modulation)
     _dutycycle = kDutyDefault;
   else
     _dutycycle = kDutyMax;
+#if ENABLE_ESP32_LEDC_SEND
+  _ledc_channel = kDefaultESP32LedcChannel;
+  _ledc_freq = 0;  // i.e. Not configured yet.
+  _ledc_duty = 0;
+  _ledc_shared = false;
+#endif  // ENABLE_ESP32_LEDC_SEND
+#if IRSEND_RMT
+  _rmt_channel = kDefaultESP32RmtSendChannel;
+  _rmt_items = NULL;
+  _rmt_size = 0;
+  _rmt_halves = 0;
+  _rmt_pending = 0;
+  _rmt_level = false;
+  _rmt_recording = false;
+  _rmt_overflow = false;
+#endif  // IRSEND_RMT
+#if IRSEND_TIMER
+  _timer_sequence = NULL;
+  _timer_durations = NULL;
+  _timer_length = 0;
+  _timer_index = 0;
+  _timer_left = 0;
+  _timer_on = 0;
+  _timer_off = 0;
+  _timer_mask = 0;
+  _timer_lit = false;
+  _timer_busy = false;
+#endif  // IRSEND_TIMER
+#if IRSEND_FAST_GPIO
+  _lit_reg = NULL;
+  _unlit_reg = NULL;
+  _gpio_mask = 0;  // i.e. Use digitalWrite() until begin() is called.
+#endif  // IRSEND_FAST_GPIO
+#if IRSEND_UART
+  _uart_on = false;
+  _uart_freq = 0;  // i.e. Not configured yet.
+  _uart_frame = 0;
+#endif  // IRSEND_UART
+#if IRSEND_ASYNC
+  _async_callback = NULL;
+  _async_arg = NULL;
+#endif  // IRSEND_ASYNC
+#if ENABLE_ECHO_SUPPRESSION
+  _echo.from = 0;
+  _echo.length = 0;
+#endif  // ENABLE_ECHO_SUPPRESSION
 }
 
-/// Enable the pin for output.
+/// Enable the pin(s) for output.
 void IRsend::begin() {
-#ifndef UNIT_TEST
+#if IRSEND_USE_LEDC
+  // Any freq. will do for now. Each send sets the one it needs.
+  if (!_ledc_freq) enableIROut(38000, _dutycycle);
+  if (_ledc_shared) {  // The pins are only routed to the channel in marks.
+    pinMode(IRpin, OUTPUT);
+    for (uint8_t pin = 0; pin <= kSendMaxMaskPin; pin++)
+      if (pin != IRpin && (_pin_mask >> pin) & 1) pinMode(pin, OUTPUT);
+    ledOff();
+    return;
+  }
+  ledcAttachPin(IRpin, _ledc_channel);
+  for (uint8_t pin = 0; pin <= kSendMaxMaskPin; pin++)
+    if (pin != IRpin && (_pin_mask >> pin) & 1)
+      ledcAttachPin(pin, _ledc_channel);
+#elif !defined(UNIT_TEST)
   pinMode(IRpin, OUTPUT);
-#endif
+  for (uint8_t pin = 0; pin <= kSendMaxMaskPin; pin++)
+    if (pin != IRpin && (_pin_mask >> pin) & 1) pinMode(pin, OUTPUT);
+#if IRSEND_FAST_GPIO
+  _cacheGpio();
+#endif  // IRSEND_FAST_GPIO
+#endif  // IRSEND_USE_LEDC
   ledOff();  // Ensure the LED is in a known safe state when we start.
 }
 
+/// Send with another GPIO too, at exactly the same time as the first one.
+/// e.g. To send the same message to IR LEDs in several rooms in one go.
+/// On the ESP8266 & ESP32, all of the pins are set & cleared by a single
+/// register write. With the LEDC or RMT backends, the same channel drives
+/// all of them.
+/// @param[in] pin The extra GPIO to send with. (0 - kSendMaxMaskPin)
+/// @return true, if it can be used. false if it, or the pin the object was
+///   created with, is above `kSendMaxMaskPin`.
+/// @note Call it before `begin()` (& `enableRmtSend()`). The pins share the
+///   same `inverted` & `use_modulation` settings.
+bool IRsend::addPin(const uint16_t pin) {
+  if (pin > kSendMaxMaskPin || IRpin > kSendMaxMaskPin) return false;
+  _pin_mask |= (1UL << IRpin) | (1UL << pin);
+  return true;
+}
+
+/// Get the GPIOs that are sent with. See `addPin()`.
+/// @return A bit mask of the GPIOs. e.g. Bit 4 is GPIO4. 0 if `addPin()`
+///   has not been used. i.e. Only the pin the object was created with.
+uint32_t IRsend::getPinMask(void) { return _pin_mask; }
+
+/// Set the level of the pin(s).
+/// @param[in] level The level to set them to. i.e. HIGH or LOW.
+/// @note Not used for the pins `_cacheGpio()` could cache the registers of.
+void IRsend::_writePins(const uint8_t level) {
+#if defined(ESP8266) && !defined(UNIT_TEST)
+  if (_pin_mask) {  // All of them at once.
+    if (level == HIGH)
+      GPOS = _pin_mask;
+    else
+      GPOC = _pin_mask;
+    return;
+  }
+#elif defined(ESP32) && !defined(UNIT_TEST)
+  if (_pin_mask) {  // All of them at once.
+    REG_WRITE(level == HIGH ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG,
+              _pin_mask);
+    return;
+  }
+#endif  // defined(ESP8266) && !defined(UNIT_TEST)
+#ifndef UNIT_TEST
+  digitalWrite(IRpin, level);
+#else  // UNIT_TEST
+  (void)level;
+#endif  // UNIT_TEST
+}
+
+#if IRSEND_FAST_GPIO
+/// Work out which GPIO register writes light & turn off the LED(s), so
+/// `ledOn()` & `ledOff()` can be a single register write each. They are
+/// called twice per carrier cycle, so `digitalWrite()`'s pin lookups &
+/// branches are a noticeable part of a 26us (38kHz) period.
+/// All of the `addPin()` pins are set or cleared by the same write.
+/// @note `outputOn` decides which of the set & clear registers lights them.
+void IRsend::_cacheGpio(void) {
+  _gpio_mask = 0;  // i.e. Use digitalWrite().
+#if defined(ESP8266)
+  if (IRpin > kSendMaxMaskPin) return;  // GPIO16 isn't in the same register.
+  volatile uint32_t *set = &GPOS;
+  volatile uint32_t *clear = &GPOC;
+  _gpio_mask = _pin_mask ? _pin_mask : (1UL << IRpin);
+#else  // i.e. ESP32
+  volatile uint32_t *set = (volatile uint32_t *)GPIO_OUT_W1TS_REG;
+  volatile uint32_t *clear = (volatile uint32_t *)GPIO_OUT_W1TC_REG;
+  if (IRpin > kSendMaxMaskPin) {  // GPIO32 & up. N.B. `addPin()` refuses them.
+#ifdef GPIO_OUT1_W1TS_REG  // Not all ESP32 variants have that many GPIOs.
+    set = (volatile uint32_t *)GPIO_OUT1_W1TS_REG;
+    clear = (volatile uint32_t *)GPIO_OUT1_W1TC_REG;
+    _gpio_mask = 1UL << (IRpin - (kSendMaxMaskPin + 1));
+#endif  // GPIO_OUT1_W1TS_REG
+  } else {
+    _gpio_mask = _pin_mask ? _pin_mask : (1UL << IRpin);
+  }
+#endif  // defined(ESP8266)
+  _lit_reg = (outputOn == HIGH) ? set : clear;
+  _unlit_reg = (outputOn == HIGH) ? clear : set;
+}
+#endif  // IRSEND_FAST_GPIO
+
+#if ENABLE_ESP32_LEDC_SEND
+/// Set which of the ESP32's LEDC (PWM) channels generates the carrier.
+/// @param[in] channel The LEDC channel to use. (0-15)
+/// @note Call it before `begin()`. Only needed when several `IRsend` instances
+///   are used at once, as each needs a channel of its own. The channels share
+///   their timers in pairs (i.e. 0 & 1, 2 & 3), so use even numbered ones.
+void IRsend::setLedcChannel(const uint8_t channel) {
+  _ledc_channel = channel;
+  _ledc_freq = 0;  // Force it to be configured again.
+}
+
+/// Share the carrier of our LEDC channel with the other `IRsend` instances
+/// that use the same channel, rather than each needing a channel of its own.
+/// The channel then generates the carrier continuously, & each instance only
+/// routes its pin(s) to it (via the GPIO matrix) for the length of a mark. So
+/// several instances (e.g. One per room) can send at the same time, from
+/// different tasks, without N times the CPU cost, or N channels & timers.
+/// @param[in] share true to share it, false to have the channel to ourself.
+/// @note Call it before `begin()`. Every instance sharing a channel must use
+///   the same carrier frequency & duty cycle for messages that overlap, as
+///   changing them affects the others. Changes are only made when needed.
+/// @note e.g. `irsend1.shareLedcCarrier(); irsend2.shareLedcCarrier();`
+///   (with the default channel) then `begin()` them as usual.
+void IRsend::shareLedcCarrier(const bool share) {
+  _ledc_shared = share;
+  _ledc_freq = 0;  // Force it to be configured again.
+}
+
+/// Note the carrier a shared LEDC channel needs to generate.
+/// @param[in] channel The LEDC channel.
+/// @param[in] freq The carrier frequency. (Hz)
+/// @param[in] duty The channel's duty value.
+/// @return What has to be changed. kLedcNewFreq and/or kLedcNewDuty.
+uint8_t IRsend::_ledcCarrier(const uint8_t channel, const uint32_t freq,
+                             const uint32_t duty) {
+  if (channel >= kESP32LedcChannels) return 0;
+  ledc_carrier_t *carrier = &_ledc_carriers[channel];
+  uint8_t changes = 0;
+  if (carrier->freq != freq) {  // Reconfiguring the timer resets the duty.
+    carrier->freq = freq;
+    changes |= kLedcNewFreq | kLedcNewDuty;
+  }
+  if (carrier->duty != duty) changes |= kLedcNewDuty;
+  carrier->duty = duty;
+  return changes;
+}
+
+/// Route our pin(s) to the shared LEDC channel's carrier, or back to their
+/// GPIO output. See `shareLedcCarrier()`.
+/// @param[in] carrier true to connect them to the carrier.
+void MIRROR_IRAM_ATTR IRsend::_ledcRoute(const bool carrier) {
+#if IRSEND_USE_LEDC
+#ifdef LEDC_HS_SIG_OUT0_IDX
+  const uint8_t signal = (_ledc_channel < 8) ?
+      LEDC_HS_SIG_OUT0_IDX + _ledc_channel :
+      LEDC_LS_SIG_OUT0_IDX + _ledc_channel - 8;
+#else  // LEDC_HS_SIG_OUT0_IDX
+  const uint8_t signal = LEDC_LS_SIG_OUT0_IDX + _ledc_channel;
+#endif  // LEDC_HS_SIG_OUT0_IDX
+  for (uint8_t pin = 0; pin <= kSendMaxMaskPin; pin++) {
+    if (pin != IRpin && !((_pin_mask >> pin) & 1)) continue;
+    if (carrier)  // Inverted outputs are lit when the carrier is low.
+      pinMatrixOutAttach(pin, signal, outputOn == LOW, false);
+    else
+      pinMatrixOutDetach(pin, false, false);
+  }
+#else  // IRSEND_USE_LEDC
+  (void)carrier;  // Not used.
+#endif  // IRSEND_USE_LEDC
+}
+#endif  // ENABLE_ESP32_LEDC_SEND
+
 /// Turn off the IR LED.
 void IRsend::ledOff() {
-#ifndef UNIT_TEST
-  digitalWrite(IRpin, outputOff);
-#endif
+#if IRSEND_USE_LEDC
+  if (_ledc_shared) {
+    _ledcRoute(false);
+    _writePins(outputOff);
+    return;
+  }
+  ledcWrite(_ledc_channel, outputOff ? 1 << kESP32LedcResolution : 0);
+#elif IRSEND_FAST_GPIO
+  if (_gpio_mask)
+    *_unlit_reg = _gpio_mask;
+  else
+    _writePins(outputOff);
+#else  // IRSEND_USE_LEDC
+  _writePins(outputOff);
+#endif  // IRSEND_USE_LEDC
 }
 
 /// Turn on the IR LED.
 void IRsend::ledOn() {
-#ifndef UNIT_TEST
-  digitalWrite(IRpin, outputOn);
-#endif
+#if IRSEND_USE_LEDC
+  if (_ledc_shared) {
+    _ledcRoute(false);
+    _writePins(outputOn);
+    return;
+  }
+  ledcWrite(_ledc_channel, outputOn ? 1 << kESP32LedcResolution : 0);
+#elif IRSEND_FAST_GPIO
+  if (_gpio_mask)
+    *_lit_reg = _gpio_mask;
+  else
+    _writePins(outputOn);
+#else  // IRSEND_USE_LEDC
+  _writePins(outputOn);
+#endif  // IRSEND_USE_LEDC
 }
 
 /// Calculate the period for a given frequency.
@@ -74,7 +407,7 @@ uint32_t IRsend::calcUSecPeriod(uint32_t hz, bool use_offset) {
       (1000000UL + hz / 2) / hz;  // The equiv of round(1000000/hz).
   // Apply the offset and ensure we don't result in a <= 0 value.
   if (use_offset)
-    return std::max((uint32_t)1, period + periodOffset);
+    return std::max((uint32_t)1, period + getPeriodOffset(hz));
   else
     return std::max((uint32_t)1, period);
 }
@@ -106,6 +439,66 @@ void IRsend::enableIROut(uint32_t freq, uint8_t duty) {
   onTimePeriod = (period * _dutycycle) / kDutyMax;
   // Nr. of uSeconds the LED will be off per pulse.
   offTimePeriod = period - onTimePeriod;
+  if (_recorder() != NULL) {
+    // Only note it. The hardware is set up when the recording is sent.
+    _recorder()->setCarrier(freq, std::min(duty, kDutyMax));
+    return;
+  }
+#if ENABLE_SEND_TIMING
+  memset(&_timing, 0, sizeof(_timing));  // A new message is about to be sent.
+#endif  // ENABLE_SEND_TIMING
+#if ENABLE_COOPERATIVE_SEND
+  memset(&_coop, 0, sizeof(_coop));  // Ditto.
+#endif  // ENABLE_COOPERATIVE_SEND
+#if ENABLE_CUSTOM_BACKENDS
+  if (_sink != NULL) {  // It generates the carrier, not us.
+    _sink->carrier(freq, _dutycycle);
+    return;
+  }
+#endif  // ENABLE_CUSTOM_BACKENDS
+#if IRSEND_RMT
+  if (_rmt_items != NULL) _rmtCarrier(freq);
+#endif  // IRSEND_RMT
+#if IRSEND_UART
+  if (_uart_on) {
+    // Nr. of bits of each frame the LED is lit for. The stop bit never is.
+    const uint8_t lit = std::max(1, std::min(
+        kESP8266UartBitsPerCycle - 1,
+        (_dutycycle * kESP8266UartBitsPerCycle + kDutyMax / 2) / kDutyMax));
+    // The start bit, then the low order (first sent) data bits, are lit.
+    // Lit is a high output as the UART's output is inverted, unless the LED is.
+    _uart_frame = 0xFF << (lit - 1);
+    if (freq != _uart_freq) {
+      Serial1.updateBaudRate(freq * kESP8266UartBitsPerCycle);
+      _uart_freq = freq;
+    }
+  }
+#endif  // IRSEND_UART
+#if ENABLE_ESP32_LEDC_SEND
+  // The channel's duty value when the LED is lit for `_dutycycle` percent.
+  _ledc_duty = ((uint32_t)_dutycycle << kESP32LedcResolution) / kDutyMax;
+  if (_ledc_shared) {  // Only changed when needed, as others may be using it.
+    // N.B. Inverted outputs are inverted by the GPIO matrix instead.
+    const uint8_t changes = _ledcCarrier(_ledc_channel, freq, _ledc_duty);
+#if IRSEND_USE_LEDC
+    if (changes & kLedcNewFreq)
+      ledcSetup(_ledc_channel, freq, kESP32LedcResolution);
+    if (changes & kLedcNewDuty) ledcWrite(_ledc_channel, _ledc_duty);
+#else  // IRSEND_USE_LEDC
+    (void)changes;  // Not used.
+#endif  // IRSEND_USE_LEDC
+    _ledc_freq = freq;
+    return;
+  }
+  if (outputOn == LOW)  // Inverted. i.e. Lit when the output is low.
+    _ledc_duty = (1 << kESP32LedcResolution) - _ledc_duty;
+#if IRSEND_USE_LEDC
+  if (freq != _ledc_freq) {  // Reconfiguring the timer glitches the output.
+    ledcSetup(_ledc_channel, freq, kESP32LedcResolution);
+    _ledc_freq = freq;
+  }
+#endif  // IRSEND_USE_LEDC
+#endif  // ENABLE_ESP32_LEDC_SEND
 }
 
 #if ALLOW_DELAY_CALLS
@@ -152,9 +545,69 @@ void IRsend::_delayMicroseconds(uint32_t usec) {
 ///   available on a single specific GPIO and only available on some modules.
 ///   e.g. It's not available on the ESP-01 module.
 ///   Hence, for greater compatibility & choice, we don't use that method.
+///   On the ESP32, with `ENABLE_ESP32_LEDC_SEND`, a LEDC (PWM) channel
+///   generates the carrier in hardware instead. It is only gated on & off.
+///   That hack is available as an option on GPIO2. See `enableUartSend()`.
 /// Ref:
 ///   https://www.analysir.com/blog/2017/01/29/updated-esp8266-nodemcu-backdoor-upwm-hack-for-ir-signals/
 uint16_t IRsend::mark(uint16_t usec) {
+#if ENABLE_DEFERRED_GAPS
+  if (_gap_pending && !_recording()) _waitForGap();
+#endif  // ENABLE_DEFERRED_GAPS
+#if ENABLE_SEND_TIMING
+  if (_timing_enabled && !_recording()) {
+    IRtimer timer = IRtimer();
+    const uint16_t pulses = _mark(usec);
+    _timeEntry(true, usec, timer.elapsed(), pulses);
+    return pulses;
+  }
+#endif  // ENABLE_SEND_TIMING
+  return _mark(usec);
+}
+
+/// Modulate the IR LED for the given period. See `mark()`.
+/// @param[in] usec The period of time to modulate the IR LED for, in
+///  microseconds.
+/// @return Nr. of pulses actually sent.
+uint16_t IRsend::_mark(uint16_t usec) {
+  if (_recorder() != NULL) {  // Recording, rather than sending.
+    _recorder()->add(true, usec);
+    IRtimer::add(usec);  // As if it was sent.
+    return 1;
+  }
+#if ENABLE_CUSTOM_BACKENDS
+  if (_sink != NULL) {
+#if ENABLE_ECHO_SUPPRESSION
+    _echoWindow(usec);
+#endif  // ENABLE_ECHO_SUPPRESSION
+    return _sink->mark(usec);
+  }
+#endif  // ENABLE_CUSTOM_BACKENDS
+#if IRSEND_RMT
+  if (_rmt_items != NULL) {
+    if (!_rmt_recording) {  // Send just this mark, & wait for it.
+      rmt_wait_tx_done((rmt_channel_t)_rmt_channel, portMAX_DELAY);
+#if ENABLE_ECHO_SUPPRESSION
+      _echoWindow(usec);
+#endif  // ENABLE_ECHO_SUPPRESSION
+      beginAsync();
+      _rmtAppend(true, usec);
+      sendAsync();
+      rmt_wait_tx_done((rmt_channel_t)_rmt_channel, portMAX_DELAY);
+    } else {
+      _rmtAppend(true, usec);
+      IRtimer::add(usec);  // As if it was sent.
+    }
+    return 1;
+  }
+#endif  // IRSEND_RMT
+#if ENABLE_ECHO_SUPPRESSION
+  _echoWindow(usec);
+#endif  // ENABLE_ECHO_SUPPRESSION
+#if IRSEND_UART
+  // N.B. The UART can't hold the LED on, so a 100% duty cycle is sent as 90%.
+  if (_uart_on) return _uartMark(usec);
+#endif  // IRSEND_UART
   // Handle the simple case of no required frequency modulation.
   if (!modulation || _dutycycle >= 100) {
     ledOn();
@@ -163,9 +616,20 @@ uint16_t IRsend::mark(uint16_t usec) {
     return 1;
   }
 
+#if IRSEND_USE_LEDC
+  if (_ledc_shared)
+    _ledcRoute(true);  // Connect to the carrier that is already running.
+  else
+    ledcWrite(_ledc_channel, _ledc_duty);  // Carrier on.
+  _delayMicroseconds(usec);
+  ledOff();
+  // Nr. of whole carrier pulses the hardware generated.
+  return std::max((uint64_t)1, (uint64_t)usec * _ledc_freq / 1000000UL);
+#endif  // IRSEND_USE_LEDC
+
   // Not simple, so do it assuming frequency modulation.
   uint16_t counter = 0;
-  IRtimer usecTimer = IRtimer();
+  IRcycleTimer usecTimer = IRcycleTimer();
   // Cache the time taken so far. This saves us calling time, and we can be
   // assured that we can't have odd math problems. i.e. unsigned under/overflow.
   uint32_t elapsed = usecTimer.elapsed();
@@ -192,11 +656,560 @@ uint16_t IRsend::mark(uint16_t usec) {
 /// A space is no output, so the PWM output is disabled.
 /// @param[in] time Time in microseconds (us).
 void IRsend::space(uint32_t time) {
+#if ENABLE_SEND_TIMING
+  if (_timing_enabled && !_recording()) {
+    IRtimer timer = IRtimer();
+    _space(time);
+    _timeEntry(false, time, timer.elapsed(), 0);
+    return;
+  }
+#endif  // ENABLE_SEND_TIMING
+  _space(time);
+}
+
+/// Turn the pin (LED) off for a given time. See `space()`.
+/// @param[in] time Time in microseconds (us).
+void IRsend::_space(uint32_t time) {
+  if (_recorder() != NULL) {  // Recording, rather than sending.
+    _recorder()->add(false, time);
+    IRtimer::add(time);  // As if it was sent.
+    return;
+  }
+#if ENABLE_CUSTOM_BACKENDS
+  if (_sink != NULL) {
+    _sink->space(time);
+    return;
+  }
+#endif  // ENABLE_CUSTOM_BACKENDS
+#if IRSEND_RMT
+  if (_rmt_recording) {
+    _rmtAppend(false, time);
+    IRtimer::add(time);  // As if it was sent.
+    return;
+  }
+#endif  // IRSEND_RMT
   ledOff();
   if (time == 0) return;
+#if ENABLE_DEFERRED_GAPS
+  if (_defer_gaps) {  // Waited out before the next mark, if it is needed.
+    if (!_gap_pending) _gap_timer.reset();
+    _gap_pending += time;
+    return;
+  }
+#endif  // ENABLE_DEFERRED_GAPS
+  _sleep(time);
+}
+
+/// Wait for a space to pass. The LED is already off.
+/// @param[in] time Time in microseconds (us).
+void IRsend::_sleep(const uint32_t time) {
+#if ENABLE_COOPERATIVE_SEND
+  if (_coop_budget && time >= _coop_budget) {
+    _cooperativeSpace(time);
+    return;
+  }
+#endif  // ENABLE_COOPERATIVE_SEND
   _delayMicroseconds(time);
 }
 
+#if ENABLE_DEFERRED_GAPS
+/// Don't wait out the spaces that are sent straight away, only when the next
+/// mark is sent. Within a message, that makes no difference. At the end of
+/// one, it means its trailing gap (e.g. A protocol's minimum gap or command
+/// length) no longer blocks the caller. It is only waited for if the next
+/// message is sent before it has passed.
+/// @param[in] enable true to defer them, false to wait them out as usual.
+/// @note The gap is tracked per `IRsend` instance. i.e. Per emitter.
+/// @see gapRemaining()
+void IRsend::enableDeferredGaps(const bool enable) {
+  if (!enable) _waitForGap();
+  _defer_gaps = enable;
+}
+
+/// How much longer the LED has to stay off for, before the next mark can be
+/// sent without waiting. See `enableDeferredGaps()`.
+/// @return Nr. of uSeconds. 0 if a message could be sent right now.
+uint32_t IRsend::gapRemaining(void) {
+  if (!_gap_pending) return 0;
+  const uint32_t elapsed = _gap_timer.elapsed();
+  if (elapsed >= _gap_pending) {
+    _gap_pending = 0;  // It has passed.
+    return 0;
+  }
+  return _gap_pending - elapsed;
+}
+
+/// Wait for what is left of the deferred space(s), if anything.
+void IRsend::_waitForGap(void) {
+  const uint32_t remaining = gapRemaining();
+  _gap_pending = 0;
+  if (remaining) _sleep(remaining);
+}
+#endif  // ENABLE_DEFERRED_GAPS
+
+#if ENABLE_ECHO_SUPPRESSION
+/// Get when we are transmitting, or last transmitted. i.e. When a receiver
+/// next to us would see our own echo. It covers each mark as it is sent (plus
+/// `kEchoMargin`), or the whole of a message sent in the background.
+/// @return A ptr to the window. It is updated as we transmit.
+/// @see IRrecv::ignoreEcho()
+const ir_echo_t *IRsend::getEcho(void) const { return &_echo; }
+
+/// Note that we are about to transmit for a while.
+/// @param[in] usecs How long until the last mark of it ends. (uSeconds)
+/// @note Receivers read the window from their interrupt handlers, so it is
+///   closed while it is changed. They never see half of the change.
+void IRsend::_echoWindow(const uint32_t usecs) {
+  _echo.length = 0;
+#ifndef UNIT_TEST
+  _echo.from = micros();
+#else  // UNIT_TEST
+  _echo.from = _IRtimer_unittest_now;
+#endif  // UNIT_TEST
+  _echo.length = usecs + kEchoMargin;
+}
+#endif  // ENABLE_ECHO_SUPPRESSION
+
+#if ENABLE_IR_MIRROR
+/// Get ready to mirror what an `IRrecv` receives. See `IRrecv::mirrorTo()`.
+/// The LED is turned off, & the carrier of the marks to come is set up, so
+/// each edge only has to turn it on or off.
+/// @param[in] freq The carrier frequency. (Hz)
+/// @param[in] duty The carrier's duty cycle. (Percentage)
+/// @return true, if each edge can be mirrored with a register write or two.
+///   i.e. The carrier is made by hardware, or modulation is disabled. (e.g.
+///   an LED driver with its own oscillator) false if the carrier would need
+///   the CPU to toggle the LED. e.g. On an ESP8266, or an ESP32 that isn't
+///   using a shared LEDC carrier. (See `shareLedcCarrier()`) Don't mirror to
+///   it then.
+/// @note It can't `send*()` anything while it is mirroring.
+bool IRsend::beginMirror(const uint32_t freq, const uint8_t duty) {
+  enableIROut(freq, duty);
+  ledOff();
+#if IRSEND_USE_LEDC
+  // A shared carrier runs all of the time. Each edge (re)routes the pins to it.
+  return _ledc_shared;
+#else  // IRSEND_USE_LEDC
+  return !modulation || _dutycycle >= kDutyMax;
+#endif  // IRSEND_USE_LEDC
+}
+
+/// Turn the mirrored output on or off. i.e. At an edge of what is received.
+/// @param[in] lit true for a mark, false for a space.
+/// @note Called from an `IRrecv`'s GPIO interrupt handler, after
+///   `beginMirror()`.
+void MIRROR_IRAM_ATTR IRsend::mirrorMark(const bool lit) {
+#if IRSEND_USE_LEDC
+  _ledcRoute(lit);  // The pins are left unlit when they aren't routed.
+#elif IRSEND_FAST_GPIO
+  if (_gpio_mask)
+    *(lit ? _lit_reg : _unlit_reg) = _gpio_mask;
+  else
+    digitalWrite(IRpin, lit ? outputOn : outputOff);
+#else  // IRSEND_USE_LEDC
+  if (lit)
+    ledOn();
+  else
+    ledOff();
+#endif  // IRSEND_USE_LEDC
+}
+#endif  // ENABLE_IR_MIRROR
+
+#if IRSEND_RMT
+/// Send via one of the ESP32's RMT channels, rather than the GPIO directly.
+/// The channel generates the carrier & the timing of the marks & spaces in
+/// hardware. Messages can also be sent in the background with it.
+/// @param[in] channel Which RMT channel to use. (0-7)
+/// @param[in] items Size of the buffer (in RMT items, of a mark & a space
+///   each) to build messages in. i.e. The longest message it can send,
+///   including any of its repeats.
+/// @return true, if the channel is ready to use. Otherwise false.
+/// @note Call it after `begin()`. Each mark() sent outside of `beginAsync()` &
+///   `sendAsync()` is sent via the channel too, & waited for.
+/// @see beginAsync()
+bool IRsend::enableRmtSend(const uint8_t channel, const uint16_t items) {
+  if (channel > kDefaultESP32RmtSendChannel || !items) return false;
+  disableRmtSend();
+  // Its memory block can't also be in use by an `IRrecv`'s RMT channel, so
+  // both can run at once. See `ENABLE_ESP32_RMT_RECV`.
+  if (!irutils::claimRmtBlocks(channel, 1)) return false;
+  rmt_config_t config = {};
+  config.rmt_mode = RMT_MODE_TX;
+  config.channel = (rmt_channel_t)channel;
+  config.gpio_num = (gpio_num_t)IRpin;
+  config.clk_div = 80;  // i.e. 1us ticks from the 80MHz APB clock.
+  config.mem_block_num = 1;
+  if (outputOn == LOW) config.flags = RMT_CHANNEL_FLAGS_INVERT_SIG;
+  config.tx_config.idle_output_en = true;
+  config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+  if (rmt_config(&config) != ESP_OK) {
+    irutils::releaseRmtBlocks(channel, 1);
+    return false;
+  }
+  for (uint8_t pin = 0; pin <= kSendMaxMaskPin; pin++)  // Any extra pins.
+    if (pin != IRpin && (_pin_mask >> pin) & 1)
+      rmt_set_gpio(config.channel, RMT_MODE_TX, (gpio_num_t)pin,
+                   outputOn == LOW);
+  if (rmt_driver_install(config.channel, 0, 0) != ESP_OK) {
+    irutils::releaseRmtBlocks(channel, 1);
+    return false;
+  }
+  _rmt_items = malloc(items * sizeof(rmt_item32_t));
+  if (_rmt_items == NULL) {
+    rmt_driver_uninstall(config.channel);
+    irutils::releaseRmtBlocks(channel, 1);
+    return false;
+  }
+  _rmt_channel = channel;
+  _rmt_size = items;
+  rmt_senders[channel] = this;
+  rmt_register_tx_end_callback(rmt_tx_end, NULL);
+  enableIROut(38000, _dutycycle);  // A send sets the freq. it needs later.
+  return true;
+}
+
+/// Stop using the RMT channel, & go back to driving the GPIO directly.
+/// @note It waits for any message still being sent.
+void IRsend::disableRmtSend(void) {
+  if (_rmt_items == NULL) return;
+  rmt_wait_tx_done((rmt_channel_t)_rmt_channel, portMAX_DELAY);
+  rmt_driver_uninstall((rmt_channel_t)_rmt_channel);
+  irutils::releaseRmtBlocks(_rmt_channel, 1);
+  rmt_senders[_rmt_channel] = NULL;
+  free(_rmt_items);
+  _rmt_items = NULL;
+  _rmt_recording = false;
+  begin();  // Take the GPIO(s) back from the RMT channel.
+}
+
+/// Start building a message to send in the background.
+/// Every `mark()` & `space()` (& hence every `send*()` call) from now until
+/// `sendAsync()` is added to it rather than being sent straight away. That
+/// includes the repeats & the gaps between them.
+/// e.g.
+///   `irsend.beginAsync(); irsend.sendDaikin2(state); irsend.sendAsync();`
+/// @return true, if a message can be built. false if RMT sending isn't
+///   enabled, or the previous message is still being sent.
+/// @see enableRmtSend(), sendAsync(), isBusy()
+bool IRsend::beginAsync(void) {
+  if (_rmt_items == NULL || isBusy()) return false;
+  _rmt_halves = 0;
+  _rmt_pending = 0;
+  _rmt_level = false;
+  _rmt_overflow = false;
+  _rmt_recording = true;
+  return true;
+}
+
+/// Start sending the message built since `beginAsync()`, & return at once.
+/// @param[in] callback A function to call once it has been sent. Called from
+///   the RMT interrupt handler, so it must be short & IRAM safe. NULL for none.
+/// @param[in] arg Passed as is to `callback`.
+/// @return true, if it is being sent. false if there is no message, or it was
+///   too long for the buffer. See `enableRmtSend()`.
+bool IRsend::sendAsync(send_callback_t callback, void *arg) {
+  if (!_rmt_recording) return false;
+  _rmt_recording = false;
+  _rmtFlush();
+  if (_rmt_overflow || !_rmt_halves) return false;
+  rmt_item32_t *items = reinterpret_cast<rmt_item32_t *>(_rmt_items);
+  if (_rmt_halves % 2) {  // Finish the last item with an end marker.
+    items[_rmt_halves / 2].duration1 = 0;
+    items[_rmt_halves / 2].level1 = 0;
+  }
+  _async_arg = arg;
+  _async_callback = callback;
+#if ENABLE_ECHO_SUPPRESSION
+  uint32_t usecs = 0;  // How long it takes to send.
+  for (uint16_t i = 0; i < _rmt_halves; i++)
+    usecs += (i % 2) ? items[i / 2].duration1 : items[i / 2].duration0;
+  _echoWindow(usecs);
+#endif  // ENABLE_ECHO_SUPPRESSION
+  if (rmt_write_items((rmt_channel_t)_rmt_channel, items,
+                      (_rmt_halves + 1) / 2, false) == ESP_OK) return true;
+  _async_callback = NULL;
+  return false;
+}
+
+/// Is a message still being sent in the background? See `sendAsync()`.
+/// @return true, if it is. Otherwise false.
+bool IRsend::isBusy(void) {
+  return _rmt_items != NULL &&
+      rmt_wait_tx_done((rmt_channel_t)_rmt_channel, 0) != ESP_OK;
+}
+
+/// A RMT channel has finished sending. Call the callback of its message.
+/// @param[in] channel The RMT channel.
+/// @note Called from an interrupt handler.
+void IRsend::_rmtSent(const uint8_t channel) {
+  if (channel > kDefaultESP32RmtSendChannel) return;
+  IRsend *sender = rmt_senders[channel];
+  if (sender == NULL || sender->_async_callback == NULL) return;
+  const send_callback_t callback = sender->_async_callback;
+  sender->_async_callback = NULL;  // Only once per message.
+  callback(sender->_async_arg);
+}
+
+/// Set the carrier the RMT channel modulates the marks with.
+/// @param[in] freq The carrier frequency in Hz.
+void IRsend::_rmtCarrier(const uint32_t freq) {
+  // The channel can't be changed while it is sending.
+  rmt_wait_tx_done((rmt_channel_t)_rmt_channel, portMAX_DELAY);
+  // The carrier is counted in 80MHz APB clock cycles.
+  const uint32_t period = APB_CLK_FREQ / std::max(freq, (uint32_t)1);
+  const uint32_t high = period * _dutycycle / kDutyMax;
+  rmt_set_tx_carrier((rmt_channel_t)_rmt_channel,
+                     modulation && _dutycycle < kDutyMax,
+                     std::min(high, (uint32_t)UINT16_MAX),
+                     std::min(period - high, (uint32_t)UINT16_MAX),
+                     RMT_CARRIER_LEVEL_HIGH);
+}
+
+/// Add a mark or space to the message being built.
+/// @param[in] mark Is it a mark? Otherwise, it is a space.
+/// @param[in] usec The duration of it in microseconds.
+void IRsend::_rmtAppend(const bool mark, const uint32_t usec) {
+  if (!usec) return;
+  if (mark != _rmt_level) {  // Consecutive marks, or spaces, are merged.
+    _rmtFlush();
+    _rmt_level = mark;
+  }
+  _rmt_pending += usec;
+}
+
+/// Write the pending mark or space into the items of the message.
+/// Durations too long for a single item half are split over several.
+void IRsend::_rmtFlush(void) {
+  rmt_item32_t *items = reinterpret_cast<rmt_item32_t *>(_rmt_items);
+  while (_rmt_pending) {
+    // Leave room for the end marker.
+    if (_rmt_halves >= _rmt_size * 2 - 1) {
+      _rmt_overflow = true;
+      _rmt_pending = 0;
+      return;
+    }
+    const uint16_t duration = std::min(_rmt_pending, (uint32_t)kRmtMaxDuration);
+    rmt_item32_t *item = &items[_rmt_halves / 2];
+    if (_rmt_halves % 2) {
+      item->duration1 = duration;
+      item->level1 = _rmt_level;
+    } else {
+      item->duration0 = duration;
+      item->level0 = _rmt_level;
+    }
+    _rmt_halves++;
+    _rmt_pending -= duration;
+  }
+}
+#endif  // IRSEND_RMT
+
+#if IRSEND_TIMER
+/// Send messages in the background on the ESP8266, by arming the hardware
+/// timer (timer1) for each edge of the marks, spaces & carrier, & changing the
+/// GPIO(s) from its interrupt handler. i.e. Use `beginAsync()` & `sendAsync()`
+/// to send without blocking `loop()`. The timing no longer depends on how long
+/// `digitalWrite()` etc. take either.
+/// @param[in] size The max. nr. of marks & spaces a message (including its
+///   repeats) can have. See `IRsequence`.
+/// @return true, if the timer is able to be used. Otherwise false.
+///   e.g. The GPIO isn't one of GPIO0-15, or the timer is already in use.
+/// @note Call it after `begin()`. Only one IRsend object can use the timer.
+/// @note Timer1 is shared with `analogWrite()`, `tone()` & the Servo library.
+bool IRsend::enableTimerSend(const uint16_t size) {
+  if (IRpin > kSendMaxMaskPin) return false;
+  if (timer_sender != NULL && timer_sender != this) return false;
+#if IRSEND_UART
+  if (_uart_on) return false;  // The GPIO is the UART's TX line.
+#endif  // IRSEND_UART
+  disableTimerSend();
+  _timer_sequence = new IRsequence(size);
+  if (_timer_sequence == NULL || !_timer_sequence->size()) {
+    delete _timer_sequence;
+    _timer_sequence = NULL;
+    return false;
+  }
+  _timer_mask = _pin_mask ? _pin_mask : (1UL << IRpin);
+  timer_sender = this;
+  timer1_attachInterrupt(_timerISR);
+  return true;
+}
+
+/// Stop using the hardware timer to send. See `enableTimerSend()`.
+/// @note It waits for any message still being sent.
+void IRsend::disableTimerSend(void) {
+  if (_timer_sequence == NULL) return;
+  while (_timer_busy) yield();
+  timer1_detachInterrupt();
+  timer_sender = NULL;
+  if (_sequence == _timer_sequence) _sequence = NULL;
+  delete _timer_sequence;
+  _timer_sequence = NULL;
+}
+
+/// Start building a message to send in the background.
+/// Every `mark()` & `space()` (& hence every `send*()` call) from now until
+/// `sendAsync()` is recorded rather than being sent straight away. That
+/// includes the repeats & the gaps between them.
+/// e.g.
+///   `irsend.beginAsync(); irsend.sendDaikin2(state); irsend.sendAsync();`
+/// @return true, if a message can be built. false if timer sending isn't
+///   enabled, or the previous message is still being sent.
+/// @see enableTimerSend(), sendAsync(), isBusy()
+bool IRsend::beginAsync(void) {
+  if (_timer_sequence == NULL || _timer_busy) return false;
+  startRecording(_timer_sequence);
+  return true;
+}
+
+/// Start sending the message built since `beginAsync()`, & return at once.
+/// @param[in] callback A function to call once it has been sent. Called from
+///   the timer's interrupt handler, so it must be short & in IRAM. NULL for
+///   none.
+/// @param[in] arg Passed as is to `callback`.
+/// @return true, if it is being sent. false if there is no message, or it was
+///   too long. See `enableTimerSend()`.
+bool IRsend::sendAsync(send_callback_t callback, void *arg) {
+  if (_timer_sequence == NULL || _sequence != _timer_sequence) return false;
+  if (!stopRecording()) return false;
+  // Work out the carrier in timer ticks, rather than in whole microseconds.
+  const uint32_t period = 1000000UL * kTimerTicksPerUsec /
+      std::max(_timer_sequence->frequency(), (uint32_t)1);
+  const uint8_t duty = modulation ? _timer_sequence->dutyCycle() : kDutyMax;
+  _timer_on = std::max(period * duty / kDutyMax, kTimerMinTicks);
+  _timer_off = std::max(period - _timer_on, kTimerMinTicks);
+  if (duty >= kDutyMax) _timer_off = 0;  // i.e. Unmodulated.
+  _timer_durations = _timer_sequence->durations();
+  _timer_length = _timer_sequence->length();
+  _timer_index = 0;
+  _timer_left = 0;
+  _async_callback = callback;
+  _async_arg = arg;
+#if ENABLE_ECHO_SUPPRESSION
+  _echoWindow(_timer_sequence->duration() - _timer_sequence->gap());
+#endif  // ENABLE_ECHO_SUPPRESSION
+  _timer_busy = true;
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+  timer1_write(kTimerMinTicks);  // Start almost straight away.
+  return true;
+}
+
+/// Is a message still being sent in the background? See `sendAsync()`.
+/// @return true, if it is. Otherwise false.
+bool IRsend::isBusy(void) { return _timer_busy; }
+
+/// The timer1 interrupt handler.
+void ICACHE_RAM_ATTR IRsend::_timerISR(void) {
+  if (timer_sender != NULL) timer_sender->_timerStep();
+}
+
+/// Set the GPIO(s) to the next level, & arm the timer for the edge after it.
+/// @note Called from the timer1 interrupt handler.
+void ICACHE_RAM_ATTR IRsend::_timerStep(void) {
+  uint32_t ticks;
+  if (_timer_left) {  // Part way through a modulated mark.
+    _timer_lit = !_timer_lit;
+    _timerWritePins(_timer_lit);
+    ticks = std::min(_timer_lit ? _timer_on : _timer_off, _timer_left);
+    _timer_left -= ticks;
+  } else {
+    // Skip the empty entries very long spaces are split with.
+    while (_timer_index < _timer_length && !_timer_durations[_timer_index])
+      _timer_index++;
+    if (_timer_index >= _timer_length) {  // All done.
+      _timerWritePins(false);
+      timer1_disable();
+      _timer_busy = false;
+      const send_callback_t callback = _async_callback;
+      _async_callback = NULL;
+      if (callback != NULL) callback(_async_arg);
+      return;
+    }
+    const bool is_mark = !(_timer_index & 1);
+    ticks = _timer_durations[_timer_index++] * kTimerTicksPerUsec;
+    _timer_lit = is_mark;
+    _timerWritePins(_timer_lit);
+    if (is_mark && _timer_off) {  // Modulate it.
+      const uint32_t total = ticks;
+      ticks = std::min(_timer_on, total);
+      _timer_left = total - ticks;
+    }
+  }
+  timer1_write(std::max(ticks, kTimerMinTicks));
+}
+
+/// Light, or turn off, the IR LED(s) with a single register write.
+/// @param[in] lit Turn them on?
+void ICACHE_RAM_ATTR IRsend::_timerWritePins(const bool lit) {
+  if ((lit ? outputOn : outputOff) == HIGH)
+    GPOS = _timer_mask;
+  else
+    GPOC = _timer_mask;
+}
+#endif  // IRSEND_TIMER
+
+#if IRSEND_UART
+/// Generate the carrier of each mark with the ESP8266's second UART (UART1).
+/// Its TX line is GPIO2. Each carrier cycle is one serial frame, at ten times
+/// the carrier frequency in baud, with the first few bits (per the duty cycle)
+/// lit. i.e. The hardware times every cycle, & the CPU only has to keep the
+/// UART's FIFO topped up, rather than toggling the GPIO for every cycle.
+/// The duty cycle is in steps of 10%, from 10% to 90%.
+/// @return true, if the UART is able to be used. Otherwise false.
+///   e.g. The GPIO isn't GPIO2, more pins were added with `addPin()`, or
+///   modulation is disabled. Those carry on sending as they did before.
+/// @note Call it after `begin()`. `Serial1` can't be used for anything else
+///   until `disableUartSend()` is called.
+/// @note It only changes how marks are sent. Spaces are timed as before.
+/// Ref:
+///   https://www.analysir.com/blog/2017/01/29/updated-esp8266-nodemcu-backdoor-upwm-hack-for-ir-signals/
+bool IRsend::enableUartSend(void) {
+  if (IRpin != kESP8266UartSendPin || !modulation) return false;
+  if (_pin_mask && _pin_mask != (1UL << IRpin)) return false;
+#if IRSEND_TIMER
+  if (_timer_sequence != NULL) return false;  // It toggles the GPIO itself.
+#endif  // IRSEND_TIMER
+  // Any freq. will do for now. Each send sets the one it needs.
+  if (!_uart_freq) _uart_freq = 38000;
+  // The UART idles (i.e. Its stop bit is) high, so invert it unless the LED is
+  // lit by a low output.
+  Serial1.begin(_uart_freq * kESP8266UartBitsPerCycle, SERIAL_8N1,
+                SERIAL_TX_ONLY, kESP8266UartSendPin, outputOn == HIGH);
+  _uart_on = true;
+  enableIROut(_uart_freq, _dutycycle);
+  return true;
+}
+
+/// Go back to generating the carrier in software. See `enableUartSend()`.
+void IRsend::disableUartSend(void) {
+  if (!_uart_on) return;
+  Serial1.end();
+  _uart_on = false;
+  pinMode(IRpin, OUTPUT);  // Back from being the UART's TX line.
+  ledOff();
+}
+
+/// Send a mark using UART1 to generate its carrier. See `enableUartSend()`.
+/// @param[in] usec The period of time to modulate the IR LED for, in
+///  microseconds.
+/// @return Nr. of carrier cycles sent.
+uint16_t IRsend::_uartMark(const uint16_t usec) {
+  // Nr. of whole carrier cycles in the mark. At least one.
+  const uint32_t cycles = std::max(
+      (uint64_t)1, ((uint64_t)usec * _uart_freq + 500000UL) / 1000000UL);
+  uint8_t frames[32];  // A run of carrier cycles, to write in as few calls.
+  memset(frames, _uart_frame, sizeof(frames));
+  for (uint32_t left = cycles; left;) {
+    const uint32_t count = std::min(left, (uint32_t)sizeof(frames));
+    Serial1.write(frames, count);  // Waits for room in the FIFO as needed.
+    left -= count;
+  }
+  // Wait for the FIFO to empty, & then for the last frame to be shifted out.
+  while ((USS(1) >> USTXC) & 0xFF) {}
+  delayMicroseconds((1000000UL + _uart_freq / 2) / _uart_freq);
+  return cycles;
+}
+#endif  // IRSEND_UART
+
 /// Calculate & set any offsets to account for execution times during sending.
 ///
 /// @param[in] hz The frequency to calibrate at >= 1000Hz. Default is 38000Hz.
@@ -204,10 +1217,18 @@ void IRsend::space(uint32_t time) {
 ///  e.g. -5.
 /// @note This will generate an 65535us mark() IR LED signal.
 ///  This only needs to be called once, if at all.
+/// @note The offset is stored for `hz`, & used for any carrier within
+///  `kPeriodOffsetMaxDelta` of it. It also becomes the offset for carriers
+///  that haven't been calibrated. So, call it for each frequency you use,
+///  e.g. `calibrate(36000); calibrate(38000); calibrate(56000);`
+/// @see setPeriodOffset(), getPeriodOffset()
 int8_t IRsend::calibrate(uint16_t hz) {
   if (hz < 1000)  // Were we given kHz? Supports the old call usage.
     hz *= 1000;
-  periodOffset = 0;  // Turn off any existing offset while we calibrate.
+  // Turn off any existing offset while we calibrate.
+  for (uint8_t i = 0; i < kPeriodOffsetTableSize; i++)
+    if (_period_offsets[i].hz == hz) _period_offsets[i].hz = 0;
+  periodOffset = 0;
   enableIROut(hz);
   IRtimer usecTimer = IRtimer();  // Start a timer *just* before we do the call.
   uint16_t pulses = mark(UINT16_MAX);  // Generate a PWM of 65,535 us. (Max.)
@@ -229,9 +1250,68 @@ int8_t IRsend::calibrate(uint16_t hz) {
   double_t actualPeriod = (double_t)timeTaken / (double_t)pulses;
   // Store the difference between the actual time per period vs. calculated.
   periodOffset = (int8_t)((double_t)calcPeriod - actualPeriod);
+  setPeriodOffset(periodOffset, hz);
   return periodOffset;
 }
 
+/// Set the period offset to use for a given carrier frequency.
+/// e.g. To restore the results of earlier `calibrate()` calls from storage.
+/// @param[in] offset The offset (in uSeconds) to add to each carrier period.
+/// @param[in] hz The frequency the offset is for. Assumes < 1000 means kHz
+///   else Hz. 0 (the default) sets the offset used for all of the frequencies
+///   without one of their own.
+/// @return true, if it was stored. false if the table is full.
+///   See `kPeriodOffsetTableSize`.
+bool IRsend::setPeriodOffset(const int8_t offset, const uint32_t hz) {
+  if (hz == 0) {
+    periodOffset = offset;
+    return true;
+  }
+  const uint32_t freq = (hz < 1000) ? hz * 1000 : hz;
+  int16_t free_slot = -1;
+  for (uint8_t i = 0; i < kPeriodOffsetTableSize; i++) {
+    if (_period_offsets[i].hz == freq) {
+      _period_offsets[i].offset = offset;
+      return true;
+    }
+    if (!_period_offsets[i].hz && free_slot < 0) free_slot = i;
+  }
+  if (free_slot < 0) return false;
+  _period_offsets[free_slot].hz = freq;
+  _period_offsets[free_slot].offset = offset;
+  return true;
+}
+
+/// Get the period offset that will be used for a given carrier frequency.
+/// @param[in] hz The frequency. Assumes < 1000 means kHz else Hz.
+///   0 (the default) gets the offset for frequencies without one of their own.
+/// @return The offset (in uSeconds) for the nearest stored frequency within
+///   `kPeriodOffsetMaxDelta` Hz of `hz`. Otherwise the default offset.
+int8_t IRsend::getPeriodOffset(const uint32_t hz) {
+  const uint32_t freq = (hz < 1000) ? hz * 1000 : hz;
+  int8_t result = periodOffset;
+  uint32_t best = kPeriodOffsetMaxDelta + 1;
+  for (uint8_t i = 0; hz && i < kPeriodOffsetTableSize; i++) {
+    if (!_period_offsets[i].hz) continue;
+    const uint32_t delta = (freq > _period_offsets[i].hz) ?
+        freq - _period_offsets[i].hz : _period_offsets[i].hz - freq;
+    if (delta < best) {
+      best = delta;
+      result = _period_offsets[i].offset;
+    }
+  }
+  return result;
+}
+
+/// Forget all of the per frequency period offsets.
+/// e.g. From `calibrate()` or `setPeriodOffset()`. The default is kept.
+void IRsend::clearPeriodOffsets(void) {
+  for (uint8_t i = 0; i < kPeriodOffsetTableSize; i++) {
+    _period_offsets[i].hz = 0;
+    _period_offsets[i].offset = 0;
+  }
+}
+
 /// Generic method for sending data that is common to most protocols.
 /// Will send leading or trailing 0's if the nbits is larger than the number
 /// of bits in data.
@@ -246,6 +1326,33 @@ int8_t IRsend::calibrate(uint16_t hz) {
 void IRsend::sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
                       uint32_t zerospace, uint64_t data, uint16_t nbits,
                       bool MSBfirst) {
+  // Most messages fit in a native (32 bit) register, so don't pay for 64 bit
+  // masks & shifts for every bit of them.
+  if (nbits <= 8)
+    _sendBits<uint8_t>(onemark, onespace, zeromark, zerospace, data, nbits,
+                       MSBfirst);
+  else if (nbits <= 32)
+    _sendBits<uint32_t>(onemark, onespace, zeromark, zerospace, data, nbits,
+                        MSBfirst);
+  else
+    _sendBits<uint64_t>(onemark, onespace, zeromark, zerospace, data, nbits,
+                        MSBfirst);
+}
+
+/// The work of `sendData()`, with the data in the smallest type it fits in.
+/// @tparam T An unsigned type. Bits of `data` past `nbits` are ignored.
+/// @param[in] onemark Nr. of usecs for the led to be pulsed for a '1' bit.
+/// @param[in] onespace Nr. of usecs for the led to be fully off for a '1' bit.
+/// @param[in] zeromark Nr. of usecs for the led to be pulsed for a '0' bit.
+/// @param[in] zerospace Nr. of usecs for the led to be fully off for a '0' bit.
+/// @param[in] data The data to be transmitted.
+/// @param[in] nbits Nr. of bits of data to be sent. Leading or trailing 0's
+///   are sent if it is more than the bits in `T`.
+/// @param[in] MSBfirst Flag for bit transmission order.
+template <typename T>
+void IRsend::_sendBits(const uint16_t onemark, const uint32_t onespace,
+                       const uint16_t zeromark, const uint32_t zerospace,
+                       T data, uint16_t nbits, const bool MSBfirst) {
   if (nbits == 0)  // If we are asked to send nothing, just return.
     return;
   if (MSBfirst) {  // Send the MSB first.
@@ -256,7 +1363,7 @@ void IRsend::sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
       nbits--;
     }
     // Send the supplied data.
-    for (uint64_t mask = 1ULL << (nbits - 1); mask; mask >>= 1)
+    for (T mask = (T)1 << (nbits - 1); mask; mask >>= 1)
       if (data & mask) {  // Send a 1
         mark(onemark);
         space(onespace);
@@ -423,8 +1530,8 @@ void IRsend::sendGeneric(const uint16_t headermark, const uint32_t headerspace,
 
     // Data
     for (uint16_t i = 0; i < nbytes; i++)
-      sendData(onemark, onespace, zeromark, zerospace, *(dataptr + i), 8,
-               MSBfirst);
+      _sendBits<uint8_t>(onemark, onespace, zeromark, zerospace,
+                         *(dataptr + i), 8, MSBfirst);
 
     // Footer
     if (footermark) mark(footermark);
@@ -432,6 +1539,77 @@ void IRsend::sendGeneric(const uint16_t headermark, const uint32_t headerspace,
   }
 }
 
+/// Send a message of a simple pulse-distance protocol described by a
+/// `pulse_distance_t`.
+/// @param[in] protocol A ptr to the description of the protocol.
+/// @param[in] data The message to be sent.
+/// @param[in] nbits The number of bits of message to be sent.
+/// @param[in] repeat The number of times the command is to be repeated.
+/// @note `protocol->minrepeats` is only advisory. e.g. As a default `repeat`.
+void IRsend::sendPulseDistance(const pulse_distance_t *protocol,
+                               const uint64_t data, const uint16_t nbits,
+                               const uint16_t repeat) {
+  sendGeneric(protocol->hdrmark, protocol->hdrspace,
+              protocol->onemark, protocol->onespace,
+              protocol->zeromark, protocol->zerospace,
+              protocol->footermark, protocol->gap,
+              data, nbits, protocol->frequency, protocol->MSBfirst,
+              repeat, protocol->dutycycle);
+}
+
+/// Send one copy of a multi-section A/C message described by an
+/// `ac_sections_t`.
+/// @param[in] frame A ptr to the description of the message's sections.
+/// @param[in] data The message to be sent.
+/// @param[in] nbytes The number of bytes of message to be sent.
+/// @note The last section is sent with all of the bytes that remain.
+///   Nothing is sent if there aren't enough bytes for every section.
+void IRsend::sendSections(const ac_sections_t *frame, const uint8_t data[],
+                          const uint16_t nbytes) {
+  uint16_t pos = 0;
+  for (uint8_t section = 0; section + 1 < frame->sections; section++)
+    pos += frame->sizes[section];
+  if (nbytes < pos) return;  // Not enough bytes to send a partial message.
+  pos = 0;
+  for (uint8_t section = 0; section < frame->sections; section++) {
+    const uint16_t size = (section + 1 < frame->sections) ?
+        frame->sizes[section] : nbytes - pos;
+    sendGeneric(frame->hdrmark, frame->hdrspace,
+                frame->onemark, frame->onespace,
+                frame->zeromark, frame->zerospace,
+                frame->footermark, frame->gap,
+                data + pos, size, frame->frequency, frame->MSBfirst, 0,
+                frame->dutycycle);
+    pos += size;
+  }
+}
+
+/// Send a constant section of a message from its precompiled marks & spaces,
+/// if the message starts with the bytes it encodes.
+/// i.e. Replay it, rather than encode it bit by bit.
+/// @param[in] section A ptr to the precompiled section.
+/// @param[in] data The message that is being sent.
+/// @param[in] nbytes The number of bytes of the message.
+/// @param[in] hz Frequency to send the section at. (kHz < 1000; Hz >= 1000)
+/// @param[in] duty Percentage duty cycle of the LED.
+/// @return true, if it was sent. false, if the message doesn't start with the
+///   section's bytes, & nothing was sent. i.e. It has to be encoded as normal.
+bool IRsend::sendPrecompiled(const precompiled_section_t *section,
+                             const uint8_t data[], const uint16_t nbytes,
+                             const uint16_t hz, const uint8_t duty) {
+  if (nbytes < section->nbytes ||
+      memcmp(data, section->data, section->nbytes) != 0)
+    return false;
+  enableIROut(hz, duty);
+  for (uint16_t i = 0; i < section->npulses; i++) {
+    if (i & 1)  // Odd entry.
+      space(pgm_read_word(section->pulses + i));
+    else  // Even entry.
+      mark(pgm_read_word(section->pulses + i));
+  }
+  return true;
+}
+
 /// Generic method for sending Manchester code data.
 /// Will send leading or trailing 0's if the nbits is larger than the number
 /// of bits in data.
@@ -527,6 +1705,376 @@ void IRsend::sendManchester(const uint16_t headermark,
   }
 }
 
+/// Are marks & spaces only being recorded, rather than sent?
+/// @return true, if they are. i.e. For an `IRsequence` or `sendAsync()`.
+bool IRsend::_recording(void) {
+#if IRSEND_RMT
+  if (_rmt_recording) return true;
+#endif  // IRSEND_RMT
+  return _recorder() != NULL;
+}
+
+/// Where are marks & spaces being recorded to, if anywhere?
+/// @return A ptr to the sequence, or NULL if they are being sent.
+IRsequence *IRsend::_recorder(void) {
+  return (_sequence != NULL) ? _sequence : _all_sequence;
+}
+
+#if ENABLE_SEND_TIMING
+/// Start measuring how long each mark & space that is sent really takes,
+/// using `IRtimer`. The statistics are restarted at the start of each message.
+/// i.e. By `enableIROut()`, which every `send*()` call starts with.
+/// @param[in] log Where to also keep the requested & measured durations of
+///   each mark/space of the message, if anywhere. NULL for nowhere.
+/// @param[in] log_size Nr. of entries `log` has room for.
+/// @note Measuring costs a few microseconds per mark/space itself, which is
+///   included in what it reports.
+/// @note Marks & spaces that are only recorded, for `sendAsync()` or an
+///   `IRsequence`, aren't measured.
+/// @see getSendTiming()
+void IRsend::enableSendTiming(send_timing_entry_t *log,
+                              const uint16_t log_size) {
+  _timing_log = log;
+  _timing_log_size = (log != NULL) ? log_size : 0;
+  memset(&_timing, 0, sizeof(_timing));
+  _timing_enabled = true;
+}
+
+/// Stop measuring the marks & spaces that are sent.
+void IRsend::disableSendTiming(void) {
+  _timing_enabled = false;
+  _timing_log = NULL;
+  _timing_log_size = 0;
+}
+
+/// Get how accurately the last (or current) message was sent.
+/// @return A ptr to the statistics. See `enableSendTiming()`.
+const send_timing_t *IRsend::getSendTiming(void) { return &_timing; }
+
+/// Add a measured mark/space to the statistics.
+/// @param[in] is_mark Is it a mark? Otherwise, it is a space.
+/// @param[in] requested The duration that was asked for. (uSeconds)
+/// @param[in] actual The duration that was measured. (uSeconds)
+/// @param[in] pulses Nr. of carrier pulses the mark generated.
+void IRsend::_timeEntry(const bool is_mark, const uint32_t requested,
+                        const uint32_t actual, const uint16_t pulses) {
+  if (is_mark) {
+    _timing.marks++;
+    _timing.pulses += pulses;
+  } else {
+    _timing.spaces++;
+  }
+  _timing.requested += requested;
+  _timing.actual += actual;
+  const int32_t error = (int32_t)(actual - requested);
+  _timing.drift += error;
+  _timing.max_error = std::max(_timing.max_error,
+                               (uint32_t)(error < 0 ? -error : error));
+  _timing.max_drift = std::max(_timing.max_drift, (uint32_t)(
+      _timing.drift < 0 ? -_timing.drift : _timing.drift));
+  if (_timing.logged < _timing_log_size) {
+    _timing_log[_timing.logged].requested = requested;
+    _timing_log[_timing.logged].actual = actual;
+    _timing.logged++;
+  }
+}
+#endif  // ENABLE_SEND_TIMING
+
+#if ENABLE_COOPERATIVE_SEND
+/// Yield to the rest of the system (e.g. the ESP8266's WiFi & TCP/IP stack)
+/// in the long spaces of the messages that are sent. e.g. The gaps between the
+/// sections or repeats of a message. Otherwise a long message can hog the CPU
+/// for long enough to upset them.
+/// Yields are only taken when at least `budget` of the space is left, so a
+/// yield that takes no longer than that doesn't change the timing at all.
+/// Any that take longer make the space too long, & that error is reported.
+/// The statistics are restarted at the start of each message. i.e. By
+/// `enableIROut()`, which every `send*()` call starts with.
+/// @param[in] budget The longest a yield may take. The shortest space that is
+///   yielded in. (uSeconds) 0 disables it.
+/// @note Only spaces are yielded in. Marks are never interrupted.
+/// @note As with `ALLOW_DELAY_CALLS`, don't use it if you send from where
+///   yielding isn't allowed. e.g. The callbacks of the AsyncWebserver library.
+/// @see getCooperativeSend()
+void IRsend::enableCooperativeSend(const uint32_t budget) {
+  _coop_budget = budget;
+  memset(&_coop, 0, sizeof(_coop));
+}
+
+/// Stop yielding in the spaces of the messages that are sent.
+void IRsend::disableCooperativeSend(void) { _coop_budget = 0; }
+
+/// Get how `IRsend` yielded whilst sending the last (or current) message.
+/// @return A ptr to the statistics. See `enableCooperativeSend()`.
+const cooperative_send_t *IRsend::getCooperativeSend(void) { return &_coop; }
+
+/// Turn the LED off for a long period, yielding as much of it as we can.
+/// @param[in] time Time in microseconds (us). At least `_coop_budget`.
+void IRsend::_cooperativeSpace(const uint32_t time) {
+  uint32_t elapsed = 0;
+  while (elapsed < time && time - elapsed >= _coop_budget) {
+    IRtimer timer;
+#ifdef UNIT_TEST
+    IRtimer::add(_yield_unittest);
+#else  // UNIT_TEST
+    yield();
+#endif  // UNIT_TEST
+    const uint32_t took = timer.elapsed();
+    _coop.yields++;
+    _coop.yielded += took;
+    _coop.max_yield = std::max(_coop.max_yield, took);
+    if (took >= _coop_budget) {
+      elapsed += took;
+    } else {  // Let the rest of the budget pass, then see if we can go again.
+      _delayMicroseconds(_coop_budget - took);
+      elapsed += _coop_budget;
+    }
+  }
+  if (elapsed < time) {
+    _delayMicroseconds(time - elapsed);
+  } else if (elapsed > time) {  // A yield took longer than there was left.
+    const uint32_t error = elapsed - time;
+    _coop.overruns++;
+    _coop.error += error;
+    _coop.max_error = std::max(_coop.max_error, error);
+  }
+}
+#endif  // ENABLE_COOPERATIVE_SEND
+
+/// Record the marks & spaces (& carrier) of what is sent from now on into an
+/// `IRsequence`, rather than sending them. e.g. To compute a message that is
+/// sent often only once, & then replay it with `sendSequence()`.
+/// e.g.
+///   `irsend.startRecording(&seq); irsend.sendDaikin2(state);`
+///   `irsend.stopRecording(); ... irsend.sendSequence(&seq);`
+/// @param[in,out] sequence Where to record to. It is cleared first.
+/// @note Only the last carrier set during the recording is kept.
+void IRsend::startRecording(IRsequence *sequence) {
+  if (sequence != NULL) sequence->clear();
+  _sequence = sequence;
+}
+
+/// Stop recording, & go back to sending. See `startRecording()`.
+/// @return true, if a complete message was recorded. false if nothing was,
+///   or it was too long for the sequence.
+bool IRsend::stopRecording(void) {
+  IRsequence *sequence = _sequence;
+  _sequence = NULL;
+  return sequence != NULL && sequence->length() && !sequence->overflowed();
+}
+
+/// Record what every `IRsend` object sends from now on into an `IRsequence`,
+/// rather than sending it. i.e. The same as `startRecording()`, but for the
+/// `IRsend` objects that can't be reached directly. e.g. The one inside an
+/// `IRDaikin2` object.
+/// @param[in,out] sequence Where to record to. It is cleared first.
+/// @note An object's own `startRecording()` takes precedence over this.
+/// @note It isn't thread/interrupt safe. Don't send from elsewhere meanwhile.
+void IRsend::startRecordingAll(IRsequence *sequence) {
+  if (sequence != NULL) sequence->clear();
+  _all_sequence = sequence;
+}
+
+/// Stop recording every `IRsend` object. See `startRecordingAll()`.
+/// @return true, if a complete message was recorded. false if nothing was,
+///   or it was too long for the sequence.
+bool IRsend::stopRecordingAll(void) {
+  IRsequence *sequence = _all_sequence;
+  _all_sequence = NULL;
+  return sequence != NULL && sequence->length() && !sequence->overflowed();
+}
+
+#if ENABLE_CUSTOM_BACKENDS
+/// Send via a backend of your own, rather than the GPIO(s). i.e. Every mark,
+/// space & carrier change is handed to it instead. The protocol code is none
+/// the wiser. e.g. An I2S/DMA driver, or another chip's peripheral.
+/// @param[in] sink What to send with. NULL for the GPIO(s) again.
+/// @note It takes precedence over the RMT, LEDC & UART backends, but not over
+///   `startRecording()`. It isn't owned, so it must outlive its use.
+void IRsend::setSink(IRsendSink *sink) { _sink = sink; }
+
+/// What is being sent with, if not the GPIO(s). See `setSink()`.
+/// @return A ptr to the sink, or NULL if there isn't one.
+IRsendSink *IRsend::getSink(void) const { return _sink; }
+#endif  // ENABLE_CUSTOM_BACKENDS
+
+/// Send a recorded message. See `startRecording()`.
+/// @param[in] sequence The message to send.
+/// @param[in] repeat Nr. of extra times to send it. It usually includes any
+///   repeats the protocol needs already.
+/// @note It is sent via `mark()` & `space()`, so it works with the LEDC & RMT
+///   backends too. e.g. Between `beginAsync()` & `sendAsync()`.
+void IRsend::sendSequence(const IRsequence *sequence, const uint16_t repeat) {
+  if (sequence == NULL || !sequence->length()) return;
+  const uint16_t *durations = sequence->durations();
+  const uint16_t length = sequence->length();
+  enableIROut(sequence->frequency(), sequence->dutyCycle());
+  for (uint16_t r = 0; r <= repeat; r++) {
+    for (uint16_t i = 0; i < length; i++) {
+      uint32_t usec = durations[i];
+      const bool is_mark = !(i & 1);
+      // Join the parts of anything too long for a single entry back together.
+      for (; i + 2 < length && durations[i + 1] == 0; i += 2)
+        usec += durations[i + 2];
+      if (is_mark)
+        mark(usec);  // Only a space can exceed the 16 bits of mark().
+      else
+        space(usec);
+    }
+  }
+  ledOff();  // We potentially have ended with a mark(), so turn off the LED.
+}
+
+/// Constructor for an IRsequence object.
+/// @param[in] size Nr. of marks & spaces it has room for.
+IRsequence::IRsequence(const uint16_t size) {
+  _durations = new uint16_t[size];
+  _size = (_durations != NULL) ? size : 0;
+  clear();
+}
+
+/// Destructor for an IRsequence object.
+IRsequence::~IRsequence(void) { delete[] _durations; }
+
+/// Empty the sequence, & reset its carrier to the defaults.
+void IRsequence::clear(void) {
+  _length = 0;
+  _freq = 38000;
+  _duty = kDutyDefault;
+  _overflow = false;
+  _duration = 0;
+  _gap = 0;
+}
+
+/// Append a mark or a space. Consecutive marks (or spaces) are joined.
+/// @param[in] mark Is it a mark? Otherwise, it is a space.
+/// @param[in] usec The duration of it in microseconds.
+/// @return true, if it fitted. Otherwise false, & the sequence is flagged as
+///   overflowed.
+/// @note Durations too long for one entry are stored as several, separated by
+///   zero length entries of the other kind.
+bool IRsequence::add(const bool mark, uint32_t usec) {
+  _duration += usec;
+  _gap = mark ? 0 : _gap + usec;
+  if (!_length && !mark && !_push(0)) return false;  // Always start on a mark.
+  while (usec) {
+    if (_length && (_length & 1) == mark) {  // Same kind as the last one.
+      const uint32_t room = UINT16_MAX - _durations[_length - 1];
+      const uint32_t extra = std::min(usec, room);
+      _durations[_length - 1] += extra;
+      usec -= extra;
+      if (usec && !_push(0)) return false;  // Full, so start a new entry.
+    } else {
+      const uint16_t entry = std::min(usec, (uint32_t)UINT16_MAX);
+      if (!_push(entry)) return false;
+      usec -= entry;
+    }
+  }
+  return true;
+}
+
+/// Replace the contents of the sequence. e.g. With one saved earlier.
+/// @param[in] durations An array of uSecond durations. Even elements are marks,
+///   odd elements are spaces. i.e. The same as for `IRsend::sendRaw()`.
+/// @param[in] length Nr. of elements in the array.
+/// @param[in] freq The carrier frequency. (kHz < 1000; Hz >= 1000)
+/// @param[in] duty The duty cycle percentage of the carrier.
+/// @return true, if it fitted. Otherwise false.
+bool IRsequence::set(const uint16_t durations[], const uint16_t length,
+                     const uint32_t freq, const uint8_t duty) {
+  clear();
+  setCarrier(freq, duty);
+  if (length > _size) {
+    _overflow = true;
+    return false;
+  }
+  for (_length = 0; _length < length; _length++) {
+    _durations[_length] = durations[_length];
+    _duration += durations[_length];
+    _gap = (_length & 1) ? _gap + durations[_length] : 0;
+  }
+  return true;
+}
+
+/// Set the sequence to a normalised capture. e.g. A learnt message that was
+/// stored in its compact form.
+/// @param[in] code The normalised capture. See `normaliseCapture()`.
+/// @param[in] size The nr. of bytes of `code`.
+/// @param[in] freq The carrier frequency. (kHz < 1000; Hz >= 1000)
+/// @param[in] duty The duty cycle percentage of the carrier.
+/// @return true, if it was valid & fitted. Otherwise false.
+bool IRsequence::setNormalised(const uint8_t code[], const uint16_t size,
+                               const uint32_t freq, const uint8_t duty) {
+  clear();
+  setCarrier(freq, duty);
+  const uint16_t length = normalisedLength(code, size);
+  if (length == 0) return false;
+  if (length > _size) {
+    _overflow = true;
+    return false;
+  }
+  for (_length = 0; _length < length; _length++) {
+    const uint16_t usecs = normalisedDuration(code, _length);
+    _durations[_length] = usecs;
+    _duration += usecs;
+    _gap = (_length & 1) ? _gap + usecs : 0;
+  }
+  return true;
+}
+
+/// Set the carrier to send the sequence with.
+/// @param[in] freq The carrier frequency. (kHz < 1000; Hz >= 1000)
+/// @param[in] duty The duty cycle percentage of the carrier.
+void IRsequence::setCarrier(const uint32_t freq, const uint8_t duty) {
+  _freq = (freq < 1000) ? freq * 1000 : freq;
+  _duty = std::min(duty, kDutyMax);
+}
+
+/// Get the marks & spaces of the sequence.
+/// @return A pointer to the durations. Even elements are marks.
+const uint16_t *IRsequence::durations(void) const { return _durations; }
+
+/// Get the nr. of marks & spaces in the sequence.
+/// @return The nr. of durations.
+uint16_t IRsequence::length(void) const { return _length; }
+
+/// Get the nr. of marks & spaces the sequence has room for.
+/// @return The max. nr. of durations.
+uint16_t IRsequence::size(void) const { return _size; }
+
+/// Get the carrier frequency of the sequence.
+/// @return The frequency in Hz.
+uint32_t IRsequence::frequency(void) const { return _freq; }
+
+/// Get the carrier duty cycle of the sequence.
+/// @return The duty cycle percentage.
+uint8_t IRsequence::dutyCycle(void) const { return _duty; }
+
+/// Did something not fit into the sequence since it was last cleared/set?
+/// @return true, if it did. i.e. The sequence is incomplete.
+bool IRsequence::overflowed(void) const { return _overflow; }
+
+/// Get the total duration of everything added since it was last cleared/set.
+/// @return The duration in uSeconds. Including any that didn't fit.
+/// @note A sequence of size 0 can thus be used to only measure a message.
+uint32_t IRsequence::duration(void) const { return _duration; }
+
+/// Get the duration of the space(s) at the end of the sequence.
+/// @return The duration in uSeconds. i.e. The gap after the last mark.
+uint32_t IRsequence::gap(void) const { return _gap; }
+
+/// Append an entry to the sequence.
+/// @param[in] usec The duration of it in microseconds.
+/// @return true, if it fitted. Otherwise false.
+bool IRsequence::_push(const uint16_t usec) {
+  if (_length >= _size) {
+    _overflow = true;
+    return false;
+  }
+  _durations[_length++] = usec;
+  return true;
+}
+
 #if SEND_RAW
 /// Send a raw IRremote message.
 ///
@@ -549,202 +2097,399 @@ void IRsend::sendRaw(const uint16_t buf[], const uint16_t len,
   }
   ledOff();  // We potentially have ended with a mark(), so turn of the LED.
 }
+
+/// Send a raw IRremote message stored in flash (PROGMEM).
+/// i.e. The same as `sendRaw()`, but `buf[]` doesn't need to be copied into
+/// RAM first.
+/// e.g.
+/// @code{.cpp}
+///   const uint16_t kPowerOn[71] PROGMEM = {9000, 4500, 560, 560, ...};
+///   irsend.sendRaw_P(kPowerOn, 71, 38);
+/// @endcode
+/// @param[in] buf A PROGMEM array of uint16_t's that has microseconds elements.
+/// @param[in] len Nr. of elements in the buf[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+void IRsend::sendRaw_P(const uint16_t buf[], const uint16_t len,
+                       const uint16_t hz) {
+  // Set IR carrier frequency
+  enableIROut(hz);
+  for (uint16_t i = 0; i < len; i++) {
+    if (i & 1)  // Odd bit.
+      space(pgm_read_word(buf + i));
+    else  // Even bit.
+      mark(pgm_read_word(buf + i));
+  }
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+}
+
+/// Send a raw IRremote message directly from an array of capture ticks.
+/// i.e. The same as `sendRaw()`, but it takes a `decode_results.rawbuf`, so
+/// a captured message can be resent without converting it to a new array
+/// first (e.g. via `resultToRawArray()`).
+/// e.g.
+/// @code{.cpp}
+///   irsend.sendRawTicks(results.rawbuf + 1, results.rawlen - 1, 38,
+///                       kRawTick);
+/// @endcode
+/// @param[in] ticks An array of uint16_t's that has elements in `tick` units.
+/// @param[in] len Nr. of elements in the ticks[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @param[in] tick The nr. of microseconds per tick. e.g. `kRawTick`
+/// @note Even elements are Mark times (On), Odd elements are Space times (Off).
+void IRsend::sendRawTicks(const volatile uint16_t ticks[], const uint16_t len,
+                          const uint16_t hz, const uint16_t tick) {
+  // Set IR carrier frequency
+  enableIROut(hz);
+  for (uint16_t i = 0; i < len; i++) {
+    uint32_t usecs = (uint32_t)ticks[i] * tick;
+    if (i & 1) {  // Odd bit.
+      space(usecs);
+    } else {  // Even bit.
+      // mark() only takes 16 bits, so break up any longer ones.
+      for (; usecs > UINT16_MAX; usecs -= UINT16_MAX) mark(UINT16_MAX);
+      mark(usecs);
+    }
+  }
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+}
+
+/// Compress a raw message, for `sendRawCompressed()` or
+/// `sendRawCompressed_P()`.
+/// Most IR messages only use a handful of different durations, so each mark &
+/// space is stored as a 4-bit index into a small palette of them. That is up
+/// to ~4 times smaller than the `uint16_t` array `sendRaw()` uses.
+/// The format (all `uint16_t`s are little endian) is:
+///   1 byte: The nr. of palette entries. (N: 1-16)
+///   N x uint16_t: The palette. i.e. The durations in microseconds.
+///   uint16_t: The nr. of marks & spaces.
+///   The palette index of each mark & space, 2 per byte. High nibble first.
+/// @param[in] raw An array of marks & spaces in microseconds. See `sendRaw()`.
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[out] out Where to store the compressed message.
+/// @param[in] out_size The size (in bytes) of the out[] array.
+/// @param[in] tolerance The % two durations can differ by & still be sent as
+///   the same one. e.g. Captured timings of 560, 580 & 600us are all sent as
+///   the average of them.
+/// @return The nr. of bytes of out[] used. 0 if it would be more than
+///   `out_size`, or it needs more than `kRawCompressedMaxPalette` durations.
+///   i.e. Try a bigger tolerance.
+uint16_t IRsend::compressRaw(const uint16_t raw[], const uint16_t len,
+                             uint8_t out[], const uint16_t out_size,
+                             const uint8_t tolerance) {
+  const uint16_t needed = 3 + (len + 1) / 2;  // Excluding the palette.
+  if (raw == NULL || out == NULL || !len || needed > out_size) return 0;
+  // Group the durations that are near the average of an existing group.
+  uint32_t sums[kRawCompressedMaxPalette];
+  uint16_t counts[kRawCompressedMaxPalette];
+  uint8_t entries = 0;
+  for (uint16_t i = 0; i < len; i++) {
+    uint8_t entry = 0;
+    for (; entry < entries; entry++) {
+      const uint32_t average = sums[entry] / counts[entry];
+      const uint32_t delta = (raw[i] > average) ? raw[i] - average
+                                                : average - raw[i];
+      if (delta * 100 <= average * tolerance) break;
+    }
+    if (entry == entries) {  // A new duration.
+      if (entries == kRawCompressedMaxPalette) return 0;
+      entries++;
+      sums[entry] = 0;
+      counts[entry] = 0;
+    }
+    sums[entry] += raw[i];
+    counts[entry]++;
+  }
+  const uint16_t total = needed + entries * 2;
+  if (total > out_size) return 0;
+  uint8_t *ptr = out;
+  *ptr++ = entries;
+  for (uint8_t entry = 0; entry < entries; entry++) {
+    const uint16_t average = (sums[entry] + counts[entry] / 2) / counts[entry];
+    *ptr++ = average & 0xFF;
+    *ptr++ = average >> 8;
+  }
+  *ptr++ = len & 0xFF;
+  *ptr++ = len >> 8;
+  // Store each duration as the index of the nearest entry in the palette.
+  memset(ptr, 0, (len + 1) / 2);
+  for (uint16_t i = 0; i < len; i++) {
+    uint8_t best = 0;
+    uint32_t best_delta = UINT32_MAX;
+    for (uint8_t entry = 0; entry < entries; entry++) {
+      const uint16_t duration = out[1 + entry * 2] | (out[2 + entry * 2] << 8);
+      const uint32_t delta = (raw[i] > duration) ? raw[i] - duration
+                                                 : duration - raw[i];
+      if (delta < best_delta) {
+        best_delta = delta;
+        best = entry;
+      }
+    }
+    ptr[i / 2] |= (i & 1) ? best : best << 4;
+  }
+  return total;
+}
+
+/// Send a raw message compressed by `compressRaw()`.
+/// @param[in] data The compressed message.
+/// @param[in] size The size (in bytes) of the data[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @return true, if it was sent. false if data[] isn't a valid message.
+bool IRsend::sendRawCompressed(const uint8_t data[], const uint16_t size,
+                               const uint16_t hz) {
+  return _sendRawCompressed(data, size, hz, false);
+}
+
+/// Send a raw message compressed by `compressRaw()` that is stored in flash.
+/// i.e. The same as `sendRawCompressed()`, but data[] is a PROGMEM array.
+/// @param[in] data The PROGMEM compressed message.
+/// @param[in] size The size (in bytes) of the data[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @return true, if it was sent. false if data[] isn't a valid message.
+bool IRsend::sendRawCompressed_P(const uint8_t data[], const uint16_t size,
+                                 const uint16_t hz) {
+  return _sendRawCompressed(data, size, hz, true);
+}
+
+/// Read a byte of a compressed raw message from RAM or flash.
+/// @param[in] data The compressed message.
+/// @param[in] progmem Is data[] stored in flash (PROGMEM)?
+/// @param[in] index The byte to read.
+/// @return The byte.
+static inline uint8_t rawByte(const uint8_t data[], const bool progmem,
+                              const uint16_t index) {
+  return progmem ? pgm_read_byte(data + index) : data[index];
+}
+
+/// Send a compressed raw message. See `compressRaw()` for the format.
+/// @param[in] data The compressed message.
+/// @param[in] size The size (in bytes) of the data[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @param[in] progmem Is data[] stored in flash (PROGMEM)?
+/// @return true, if it was sent. false if data[] isn't a valid message.
+bool IRsend::_sendRawCompressed(const uint8_t data[], const uint16_t size,
+                                const uint16_t hz, const bool progmem) {
+  if (data == NULL || !size) return false;
+  const uint8_t entries = rawByte(data, progmem, 0);
+  if (!entries || entries > kRawCompressedMaxPalette) return false;
+  const uint16_t len_offset = 1 + entries * 2;
+  if (len_offset + 2 > size) return false;
+  const uint16_t len = rawByte(data, progmem, len_offset) |
+      (rawByte(data, progmem, len_offset + 1) << 8);
+  const uint16_t indices = len_offset + 2;
+  if (indices + (len + 1) / 2 > size) return false;
+  // Copy the palette into RAM, so it is only read from flash once.
+  uint16_t palette[kRawCompressedMaxPalette];
+  for (uint8_t entry = 0; entry < entries; entry++)
+    palette[entry] = rawByte(data, progmem, 1 + entry * 2) |
+        (rawByte(data, progmem, 2 + entry * 2) << 8);
+  // Check the indices first, so we never send part of a message.
+  for (uint16_t i = 0; i < len; i++) {
+    const uint8_t pair = rawByte(data, progmem, indices + i / 2);
+    if (((i & 1) ? pair & 0xF : pair >> 4) >= entries) return false;
+  }
+  enableIROut(hz);
+  for (uint16_t i = 0; i < len; i++) {
+    const uint8_t pair = rawByte(data, progmem, indices + i / 2);
+    const uint16_t duration = palette[(i & 1) ? pair & 0xF : pair >> 4];
+    if (i & 1)  // Odd bit.
+      space(duration);
+    else  // Even bit.
+      mark(duration);
+  }
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+  return true;
+}
+
+/// Send a raw message of any length, read from a source a few entries at a
+/// time. i.e. The same as `sendRaw()`, but the message never has to fit in
+/// RAM. e.g. A long learned code in a file.
+/// @code{.cpp}
+///   File file = LittleFS.open("/projector_on.raw", "r");
+///   IRrawStreamSource source(&file);
+///   irsend.sendRawStream(&source, 38);
+///   file.close();
+/// @endcode
+/// @param[in] source Where to read the marks & spaces from.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @return true, if anything was sent. false if the source was empty.
+/// @note The next entries are read during a space, & the time that takes is
+///   taken off it. A source must be fast enough to read `kRawStreamChunkSize`
+///   entries within the space it happens in, or that space will be too long.
+/// @note When building a message for `sendAsync()`, the whole message still
+///   has to fit in the buffer of `enableRmtSend()`/`enableTimerSend()`.
+bool IRsend::sendRawStream(IRrawSource *source, const uint16_t hz) {
+  if (source == NULL) return false;
+  uint16_t chunk[kRawStreamChunkSize];
+  uint16_t length = source->read(chunk, kRawStreamChunkSize);
+  if (!length) return false;
+  // Is it being sent now? Otherwise, reading takes no time from the message.
+  bool live = _recorder() == NULL;
+#if IRSEND_RMT
+  live = live && !_rmt_recording;
+#endif  // IRSEND_RMT
+  enableIROut(hz);
+  uint32_t late = 0;  // How long reading has delayed the next space by.
+  bool is_mark = true;
+  for (uint16_t i = 0; i < length; is_mark = !is_mark) {
+    const uint16_t duration = chunk[i++];
+    if (is_mark) mark(duration);
+    if (i >= length) {  // Read the next entries, before/during the space.
+      IRtimer timer;
+      length = source->read(chunk, kRawStreamChunkSize);
+      i = 0;
+      if (live) late += timer.elapsed();
+    }
+    if (!is_mark) {
+      space(duration > late ? duration - late : 0);
+      late = 0;
+    }
+  }
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+  return true;
+}
+
+/// Constructor of a raw message source that is an array.
+/// @param[in] durations The marks & spaces of the message. (uSeconds)
+/// @param[in] length Nr. of entries of `durations`.
+/// @param[in] progmem Is `durations` stored in flash (PROGMEM)?
+IRrawArraySource::IRrawArraySource(const uint16_t durations[],
+                                   const uint32_t length, const bool progmem)
+    : _durations(durations), _length(length), _index(0), _progmem(progmem) {}
+
+/// Read the next marks & spaces of the message.
+/// @param[out] durations Where to.
+/// @param[in] max Nr. of entries `durations` has room for.
+/// @return Nr. of entries read. 0 when the message has ended.
+uint16_t IRrawArraySource::read(uint16_t durations[], const uint16_t max) {
+  uint16_t count = 0;
+  for (; count < max && _index < _length; count++, _index++)
+    durations[count] = _progmem ? pgm_read_word(_durations + _index)
+                                : _durations[_index];
+  return count;
+}
+
+/// Start reading from the start of the message again. e.g. To resend it.
+void IRrawArraySource::rewind(void) { _index = 0; }
+
+#ifndef UNIT_TEST
+/// Constructor of a raw message source that is an Arduino `Stream`.
+/// @param[in] stream Where to read the message from. From where it is at.
+/// @param[in] length Max. nr. of entries to read. The message also ends
+///   where the stream does.
+IRrawStreamSource::IRrawStreamSource(Stream *stream, const uint32_t length)
+    : _stream(stream), _left(length) {}
+
+/// Read the next marks & spaces of the message.
+/// @param[out] durations Where to.
+/// @param[in] max Nr. of entries `durations` has room for.
+/// @return Nr. of entries read. 0 when the message has ended.
+uint16_t IRrawStreamSource::read(uint16_t durations[], const uint16_t max) {
+  if (_stream == NULL) return 0;
+  const uint16_t wanted = std::min((uint32_t)max, _left);
+  // In one go, straight into place. The ESP8266 & ESP32 are little-endian.
+  const uint16_t count = _stream->readBytes(
+      reinterpret_cast<uint8_t *>(durations),
+      wanted * sizeof(durations[0])) / sizeof(durations[0]);
+  _left -= count;
+  return count;
+}
+#endif  // UNIT_TEST
 #endif  // SEND_RAW
 
+static_assert(kSendTableLength == kLastDecodeType + 2,
+              "src/IRsendTable.h is out of date. Regenerate it with "
+              "tools/generate_send_table.py");
+
+/// Get how a protocol is sent. It is a direct look up, by its number.
+/// @param[in] protocol Protocol number/type of the message.
+/// @param[out] entry Where to store a copy of its `kSendTable` entry.
+/// @return true, if it is a protocol we know of. Otherwise false.
+static bool sendTableEntry(const decode_type_t protocol,
+                           irsend_protocol_t *entry) {
+  const int16_t index = protocol - decode_type_t::UNKNOWN;
+  if (index < 0 || index >= kSendTableLength) return false;
+  memcpy_P(entry, &kSendTable[index], sizeof(*entry));
+  return true;
+}
+
 /// Get the minimum number of repeats for a given protocol.
 /// @param[in] protocol Protocol number/type of the message you want to send.
 /// @return The number of repeats required.
 uint16_t IRsend::minRepeats(const decode_type_t protocol) {
-  switch (protocol) {
-    // Single repeats
-    case AIWA_RC_T501:
-    case AMCOR:
-    case COOLIX:
-    case GICABLE:
-    case INAX:
-    case MIDEA24:
-    case MITSUBISHI:
-    case MITSUBISHI2:
-    case MITSUBISHI_AC:
-    case MULTIBRACKETS:
-    case SHERWOOD:
-    case TOSHIBA_AC:
-      return kSingleRepeat;
-    // Special
-    case AIRWELL:
-      return kAirwellMinRepeats;
-    case CARRIER_AC40:
-      return kCarrierAc40MinRepeat;
-    case DISH:
-      return kDishMinRepeat;
-    case EPSON:
-      return kEpsonMinRepeat;
-    case SONY:
-      return kSonyMinRepeat;
-    case SONY_38K:
-      return kSonyMinRepeat + 1;
-    case SYMPHONY:
-      return kSymphonyDefaultRepeat;
-    case ZEPEAL:
-      return kZepealMinRepeat;
-    default:
-      return kNoRepeat;
-  }
+#if ENABLE_CUSTOM_PROTOCOLS
+  const custom_protocol_t *custom = ircustom::get(protocol);
+  if (custom != NULL) return custom->timing.minrepeats;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  irsend_protocol_t entry;
+  return sendTableEntry(protocol, &entry) ? entry.repeats : kNoRepeat;
 }
 
 /// Get the default number of bits for a given protocol.
 /// @param[in] protocol Protocol number/type you want the default bit size for.
 /// @return The number of bits.
 uint16_t IRsend::defaultBits(const decode_type_t protocol) {
-  switch (protocol) {
-    case MULTIBRACKETS:
-      return 8;
-    case RC5:
-    case SYMPHONY:
-      return 12;
-    case LASERTAG:
-    case RC5X:
-      return 13;
-    case AIWA_RC_T501:
-    case DENON:
-    case SHARP:
-      return 15;
-    case DISH:
-    case GICABLE:
-    case JVC:
-    case LEGOPF:
-    case MITSUBISHI:
-    case MITSUBISHI2:
-    case ZEPEAL:
-      return 16;
-    case METZ:
-      return 19;
-    case RC6:
-    case SONY:
-    case SONY_38K:
-      return 20;
-    case COOLIX:
-    case INAX:
-    case MIDEA24:
-    case NIKAI:
-    case RCMM:
-      return 24;
-    case LG:
-    case LG2:
-      return 28;
-    case CARRIER_AC:
-    case EPSON:
-    case NEC:
-    case NEC_LIKE:
-    case SAMSUNG:
-    case SHERWOOD:
-    case WHYNTER:
-      return 32;
-    case AIRWELL:
-      return 34;
-    case LUTRON:
-    case TECO:
-      return 35;
-    case SAMSUNG36:
-      return 36;
-    case CARRIER_AC40:
-      return kCarrierAc40Bits;  // 40
-    case DOSHISHA:
-      return kDoshishaBits;  // 40
-    case SANYO_LC7461:
-      return kSanyoLC7461Bits;  // 42
-    case GOODWEATHER:
-    case MIDEA:
-    case TRANSCOLD:
-    case PANASONIC:
-      return 48;
-    case MAGIQUEST:
-    case VESTEL_AC:
-    case TECHNIBEL_AC:
-      return 56;
-    case AMCOR:
-    case CARRIER_AC64:
-    case DELONGHI_AC:
-    case PIONEER:
-      return 64;
-    case ARGO:
-      return kArgoBits;
-    case CORONA_AC:
-      return kCoronaAcBits;
-    case DAIKIN:
-      return kDaikinBits;
-    case DAIKIN128:
-      return kDaikin128Bits;
-    case DAIKIN152:
-      return kDaikin152Bits;
-    case DAIKIN160:
-      return kDaikin160Bits;
-    case DAIKIN176:
-      return kDaikin176Bits;
-    case DAIKIN2:
-      return kDaikin2Bits;
-    case DAIKIN216:
-      return kDaikin216Bits;
-    case DAIKIN64:
-      return kDaikin64Bits;
-    case ELECTRA_AC:
-      return kElectraAcBits;
-    case GREE:
-      return kGreeBits;
-    case HAIER_AC:
-      return kHaierACBits;
-    case HAIER_AC_YRW02:
-      return kHaierACYRW02Bits;
-    case HITACHI_AC:
-      return kHitachiAcBits;
-    case HITACHI_AC1:
-      return kHitachiAc1Bits;
-    case HITACHI_AC2:
-      return kHitachiAc2Bits;
-    case HITACHI_AC3:
-      return kHitachiAc3Bits;
-    case HITACHI_AC344:
-      return kHitachiAc344Bits;
-    case HITACHI_AC424:
-      return kHitachiAc424Bits;
-    case KELVINATOR:
-      return kKelvinatorBits;
-    case MITSUBISHI_AC:
-      return kMitsubishiACBits;
-    case MITSUBISHI136:
-      return kMitsubishi136Bits;
-    case MITSUBISHI112:
-      return kMitsubishi112Bits;
-    case MITSUBISHI_HEAVY_152:
-      return kMitsubishiHeavy152Bits;
-    case MITSUBISHI_HEAVY_88:
-      return kMitsubishiHeavy88Bits;
-    case NEOCLIMA:
-      return kNeoclimaBits;
-    case PANASONIC_AC:
-      return kNeoclimaBits;
-    case SAMSUNG_AC:
-      return kSamsungAcBits;
-    case SANYO_AC:
-      return kSanyoAcBits;
-    case SHARP_AC:
-      return kSharpAcBits;
-    case TCL112AC:
-      return kTcl112AcBits;
-    case TOSHIBA_AC:
-      return kToshibaACBits;
-    case TROTEC:
-      return kTrotecBits;
-    case VOLTAS:
-      return kVoltasBits;
-    case WHIRLPOOL_AC:
-      return kWhirlpoolAcBits;
-    // No default amount of bits.
-    case FUJITSU_AC:
-    case MWM:
-    default:
-      return 0;
+#if ENABLE_CUSTOM_PROTOCOLS
+  const custom_protocol_t *custom = ircustom::get(protocol);
+  if (custom != NULL) return custom->timing.nbits;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  irsend_protocol_t entry;
+  return sendTableEntry(protocol, &entry) ? entry.bits : 0;
+}
+
+/// Get how a message of a given type is sent, without sending it.
+/// The message is sent into a recording that only measures it, so the
+/// carrier & timings come from the protocol's own `send*()` routine.
+/// @param[in] type Protocol number/type of the message.
+/// @param[out] info Where to store the details.
+/// @param[in] nbits Nr. of bits of the message. 0 means the default size.
+/// @param[in] repeat Nr. of repeats. At least the protocol's minimum are used.
+///   For A/C (state[]) protocols, it is how many more times it is sent.
+/// @return true, if it is a type we can send. Otherwise false.
+/// @note The message is all 1s, the longest form for most protocols. Hence
+///   it is a reasonable upper bound for a scheduler to plan with.
+bool IRsend::protocolInfo(const decode_type_t type, protocol_info_t *info,
+                          const uint16_t nbits, const uint16_t repeat) {
+  if (info == NULL) return false;
+  const uint16_t bits = nbits ? nbits : defaultBits(type);
+  if (!bits) return false;  // We don't know what size to measure.
+  IRsequence measure(0);  // It has no room, so it only measures.
+  IRsequence *recording = _sequence;
+  startRecording(&measure);
+  bool success;
+  if (hasACState(type)) {
+    uint8_t state[kSendQueueStateSize];
+    const uint16_t nbytes = bits / 8;
+    success = nbytes && nbytes <= kSendQueueStateSize;
+    if (success) memset(state, 0xFF, nbytes);
+    for (uint16_t r = 0; success && r <= repeat; r++)
+      success = send(type, state, nbytes);
+  } else {
+    success = send(type, UINT64_MAX >> (64 - std::min(bits, (uint16_t)64)),
+                   bits, repeat);
   }
+  _sequence = recording;  // Carry on with whatever was happening before.
+  if (!success || !measure.duration()) return false;
+  info->frequency = measure.frequency();
+  info->duty = measure.dutyCycle();
+  info->bits = bits;
+  info->repeats = hasACState(type) ? repeat : std::max(minRepeats(type),
+                                                       repeat);
+  info->duration = measure.duration();
+  info->gap = measure.gap();
+  return true;
+}
+
+/// Estimate how long a message of a given type takes to send.
+/// @param[in] type Protocol number/type of the message.
+/// @param[in] nbits Nr. of bits of the message. 0 means the default size.
+/// @param[in] repeat Nr. of repeats. At least the protocol's minimum are used.
+/// @return The on-air duration in uSeconds, incl. gaps. 0 if unknown.
+/// @see protocolInfo()
+uint32_t IRsend::estimateDuration(const decode_type_t type,
+                                  const uint16_t nbits,
+                                  const uint16_t repeat) {
+  protocol_info_t info;
+  return protocolInfo(type, &info, nbits, repeat) ? info.duration : 0;
 }
 
 /// Send a simple (up to 64 bits) IR message of a given type.
@@ -756,260 +2501,17 @@ uint16_t IRsend::defaultBits(const decode_type_t protocol) {
 /// @return True if it is a type we can attempt to send, false if not.
 bool IRsend::send(const decode_type_t type, const uint64_t data,
                   const uint16_t nbits, const uint16_t repeat) {
-  uint16_t min_repeat __attribute__((unused)) =
-      std::max(IRsend::minRepeats(type), repeat);
-  switch (type) {
-#if SEND_AIRWELL
-    case AIRWELL:
-      sendAirwell(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_AIWA_RC_T501
-    case AIWA_RC_T501:
-      sendAiwaRCT501(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_CARRIER_AC
-    case CARRIER_AC:
-      sendCarrierAC(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_CARRIER_AC40
-    case CARRIER_AC40:
-      sendCarrierAC40(data, nbits, min_repeat);
-      break;
-#endif  // SEND_CARRIER_AC40
-#if SEND_CARRIER_AC64
-    case CARRIER_AC64:
-      sendCarrierAC64(data, nbits, min_repeat);
-      break;
-#endif  // SEND_CARRIER_AC64
-#if SEND_COOLIX
-    case COOLIX:
-      sendCOOLIX(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_DAIKIN64
-    case DAIKIN64:
-      sendDaikin64(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_DELONGHI_AC
-    case DELONGHI_AC:
-      sendDelonghiAc(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_DENON
-    case DENON:
-      sendDenon(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_DISH
-    case DISH:
-      sendDISH(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_DOSHISHA
-    case DOSHISHA:
-      sendDoshisha(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_EPSON
-    case EPSON:
-      sendEpson(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_GICABLE
-    case GICABLE:
-      sendGICable(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_GOODWEATHER
-    case GOODWEATHER:
-      sendGoodweather(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_GREE
-    case GREE:
-      sendGree(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_INAX
-    case INAX:
-      sendInax(data, nbits, min_repeat);
-      break;
-#endif  // SEND_INAX
-#if SEND_JVC
-    case JVC:
-      sendJVC(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_LASERTAG
-    case LASERTAG:
-      sendLasertag(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_LEGOPF
-    case LEGOPF:
-      sendLegoPf(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_LG
-    case LG:
-      sendLG(data, nbits, min_repeat);
-      break;
-    case LG2:
-      sendLG2(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_LUTRON
-    case LUTRON:
-      sendLutron(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_MAGIQUEST
-    case MAGIQUEST:
-      sendMagiQuest(data, nbits, min_repeat);
-      break;
-#endif  // SEND_MAGIQUEST
-#if SEND_METZ
-    case METZ:
-      sendMetz(data, nbits, min_repeat);
-      break;
-#endif  // SEND_METZ
-#if SEND_MIDEA
-    case MIDEA:
-      sendMidea(data, nbits, min_repeat);
-      break;
-#endif  // SEND_MIDEA
-#if SEND_MIDEA24
-    case MIDEA24:
-      sendMidea24(data, nbits, min_repeat);
-      break;
-#endif  // SEND_MIDEA24
-#if SEND_MITSUBISHI
-    case MITSUBISHI:
-      sendMitsubishi(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_MITSUBISHI2
-    case MITSUBISHI2:
-      sendMitsubishi2(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_MULTIBRACKETS
-    case MULTIBRACKETS:
-      sendMultibrackets(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_NIKAI
-    case NIKAI:
-      sendNikai(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_NEC
-    case NEC:
-    case NEC_LIKE:
-      sendNEC(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_PANASONIC
-    case PANASONIC:
-      sendPanasonic64(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_PIONEER
-    case PIONEER:
-      sendPioneer(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_RC5
-    case RC5:
-    case RC5X:
-      sendRC5(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_RC6
-    case RC6:
-      sendRC6(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_RCMM
-    case RCMM:
-      sendRCMM(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SAMSUNG
-    case SAMSUNG:
-      sendSAMSUNG(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SAMSUNG36
-    case SAMSUNG36:
-      sendSamsung36(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SANYO
-    case SANYO_LC7461:
-      sendSanyoLC7461(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SHARP
-    case SHARP:
-      sendSharpRaw(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SHERWOOD
-    case SHERWOOD:
-      sendSherwood(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SONY
-    case SONY:
-      sendSony(data, nbits, min_repeat);
-      break;
-    case SONY_38K:
-      sendSony38(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_SYMPHONY
-    case SYMPHONY:
-      sendSymphony(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_TECHNIBEL_AC
-    case TECHNIBEL_AC:
-      sendTechnibelAc(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_TECO
-    case TECO:
-      sendTeco(data, nbits, min_repeat);
-      break;
-#endif  // SEND_TECO
-#if SEND_TRANSCOLD
-    case TRANSCOLD:
-      sendTranscold(data, nbits, min_repeat);
-      break;
-#endif  // SEND_TRANSCOLD
-#if SEND_VESTEL_AC
-    case VESTEL_AC:
-      sendVestelAc(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_WHYNTER
-    case WHYNTER:
-      sendWhynter(data, nbits, min_repeat);
-      break;
-#endif
-#if SEND_ZEPEAL
-    case ZEPEAL:
-      sendZepeal(data, nbits, min_repeat);
-      break;
-#endif  // SEND_ZEPEAL
-    default:
-      return false;
+#if ENABLE_CUSTOM_PROTOCOLS
+  const custom_protocol_t *custom = ircustom::get(type);
+  if (custom != NULL) {
+    sendPulseDistance(&custom->timing, data, nbits,
+                      std::max(custom->timing.minrepeats, repeat));
+    return true;
   }
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  irsend_protocol_t entry;
+  if (!sendTableEntry(type, &entry) || entry.simple == NULL) return false;
+  (this->*entry.simple)(data, nbits, std::max(entry.repeats, repeat));
   return true;
 }
 
@@ -1021,197 +2523,223 @@ bool IRsend::send(const decode_type_t type, const uint64_t data,
 /// @return True if it is a type we can attempt to send, false if not.
 bool IRsend::send(const decode_type_t type, const uint8_t *state,
                   const uint16_t nbytes) {
-  switch (type) {
-#if SEND_VOLTAS
-    case VOLTAS:
-      sendVoltas(state, nbytes);
-      break;
-#endif  // SEND_VOLTAS
-#if SEND_AMCOR
-    case AMCOR:
-      sendAmcor(state, nbytes);
-      break;
-#endif
-#if SEND_ARGO
-    case ARGO:
-      sendArgo(state, nbytes);
-      break;
-#endif  // SEND_ARGO
-#if SEND_CORONA_AC
-    case CORONA_AC:
-      sendCoronaAc(state, nbytes);
-      break;
-#endif  // SEND_ARGO
-#if SEND_DAIKIN
-    case DAIKIN:
-      sendDaikin(state, nbytes);
-      break;
-#endif  // SEND_DAIKIN
-#if SEND_DAIKIN128
-    case DAIKIN128:
-        sendDaikin128(state, nbytes);
-        break;
-#endif  // SEND_DAIKIN128
-#if SEND_DAIKIN152
-    case DAIKIN152:
-        sendDaikin152(state, nbytes);
-        break;
-#endif  // SEND_DAIKIN152
-#if SEND_DAIKIN160
-    case DAIKIN160:
-      sendDaikin160(state, nbytes);
-      break;
-#endif  // SEND_DAIKIN160
-#if SEND_DAIKIN176
-    case DAIKIN176:
-      sendDaikin176(state, nbytes);
-      break;
-#endif  // SEND_DAIKIN176
-#if SEND_DAIKIN2
-    case DAIKIN2:
-      sendDaikin2(state, nbytes);
-      break;
-#endif  // SEND_DAIKIN2
-#if SEND_DAIKIN216
-    case DAIKIN216:
-      sendDaikin216(state, nbytes);
-      break;
-#endif  // SEND_DAIKIN216
-#if SEND_ELECTRA_AC
-    case ELECTRA_AC:
-      sendElectraAC(state, nbytes);
-      break;
-#endif  // SEND_ELECTRA_AC
-#if SEND_FUJITSU_AC
-    case FUJITSU_AC:
-      sendFujitsuAC(state, nbytes);
-      break;
-#endif  // SEND_FUJITSU_AC
-#if SEND_GREE
-    case GREE:
-      sendGree(state, nbytes);
-      break;
-#endif  // SEND_GREE
-#if SEND_HAIER_AC
-    case HAIER_AC:
-      sendHaierAC(state, nbytes);
-      break;
-#endif  // SEND_HAIER_AC
-#if SEND_HAIER_AC_YRW02
-    case HAIER_AC_YRW02:
-      sendHaierACYRW02(state, nbytes);
-      break;
-#endif  // SEND_HAIER_AC_YRW02
-#if SEND_HITACHI_AC
-    case HITACHI_AC:
-      sendHitachiAC(state, nbytes);
-      break;
-#endif  // SEND_HITACHI_AC
-#if SEND_HITACHI_AC1
-    case HITACHI_AC1:
-      sendHitachiAC1(state, nbytes);
-      break;
-#endif  // SEND_HITACHI_AC1
-#if SEND_HITACHI_AC2
-    case HITACHI_AC2:
-      sendHitachiAC2(state, nbytes);
-      break;
-#endif  // SEND_HITACHI_AC2
-#if SEND_HITACHI_AC3
-    case HITACHI_AC3:
-      sendHitachiAc3(state, nbytes);
-      break;
-#endif  // SEND_HITACHI_AC3
-#if SEND_HITACHI_AC344
-    case HITACHI_AC344:
-      sendHitachiAc344(state, nbytes);
-      break;
-#endif  // SEND_HITACHI_AC344
-#if SEND_HITACHI_AC424
-    case HITACHI_AC424:
-      sendHitachiAc424(state, nbytes);
-      break;
-#endif  // SEND_HITACHI_AC424
-#if SEND_KELVINATOR
-    case KELVINATOR:
-      sendKelvinator(state, nbytes);
-      break;
-#endif  // SEND_KELVINATOR
-#if SEND_MITSUBISHI_AC
-    case MITSUBISHI_AC:
-      sendMitsubishiAC(state, nbytes);
-      break;
-#endif  // SEND_MITSUBISHI_AC
-#if SEND_MITSUBISHI136
-    case MITSUBISHI136:
-      sendMitsubishi136(state, nbytes);
-      break;
-#endif  // SEND_MITSUBISHI136
-#if SEND_MITSUBISHI112
-    case MITSUBISHI112:
-      sendMitsubishi112(state, nbytes);
-      break;
-#endif  // SEND_MITSUBISHI112
-#if SEND_MITSUBISHIHEAVY
-    case MITSUBISHI_HEAVY_88:
-      sendMitsubishiHeavy88(state, nbytes);
-      break;
-    case MITSUBISHI_HEAVY_152:
-      sendMitsubishiHeavy152(state, nbytes);
-      break;
-#endif  // SEND_MITSUBISHIHEAVY
-#if SEND_MWM
-    case MWM:
-      sendMWM(state, nbytes);
-      break;
-#endif  // SEND_MWM
-#if SEND_NEOCLIMA
-    case NEOCLIMA:
-      sendNeoclima(state, nbytes);
-      break;
-#endif  // SEND_NEOCLIMA
-#if SEND_PANASONIC_AC
-    case PANASONIC_AC:
-      sendPanasonicAC(state, nbytes);
-      break;
-#endif  // SEND_PANASONIC_AC
-#if SEND_SAMSUNG_AC
-    case SAMSUNG_AC:
-      sendSamsungAC(state, nbytes);
-      break;
-#endif  // SEND_SAMSUNG_AC
-#if SEND_SANYO_AC
-    case SANYO_AC:
-      sendSanyoAc(state, nbytes);
-      break;
-#endif  // SEND_SANYO_AC
-#if SEND_SHARP_AC
-    case SHARP_AC:
-      sendSharpAc(state, nbytes);
-      break;
-#endif  // SEND_SHARP_AC
-#if SEND_TCL112AC
-    case TCL112AC:
-      sendTcl112Ac(state, nbytes);
-      break;
-#endif  // SEND_TCL112AC
-#if SEND_TOSHIBA_AC
-    case TOSHIBA_AC:
-      sendToshibaAC(state, nbytes);
-      break;
-#endif  // SEND_TOSHIBA_AC
-#if SEND_TROTEC
-    case TROTEC:
-      sendTrotec(state, nbytes);
-      break;
-#endif  // SEND_TROTEC
-#if SEND_WHIRLPOOL_AC
-    case WHIRLPOOL_AC:
-      sendWhirlpoolAC(state, nbytes);
-      break;
-#endif  // SEND_WHIRLPOOL_AC
-    default:
-      return false;
+  irsend_protocol_t entry;
+  if (!sendTableEntry(type, &entry) || entry.state == NULL) return false;
+  (this->*entry.state)(state, nbytes, entry.state_repeats);
+  return true;
+}
+
+/// Constructor for an IRsendQueue object.
+/// @param[in] irsend The IRsend object to send the messages with. It should
+///   already have had `begin()` called.
+/// @param[in] size Nr. of messages that can wait to be sent.
+IRsendQueue::IRsendQueue(IRsend *irsend, const uint8_t size) {
+  _irsend = irsend;
+  _entries = new send_queue_entry_t[size];
+  _size = (_entries != NULL) ? size : 0;
+  _order = 0;
+  _gap = kDefaultMessageGap;
+  _wait = 0;
+  _drops = 0;
+  clear();
+}
+
+/// Destructor for an IRsendQueue object.
+IRsendQueue::~IRsendQueue(void) { delete[] _entries; }
+
+/// Add a simple (<= 64 bits) message to the queue.
+/// @param[in] type Protocol number/type of the message. See `IRsend::send()`.
+/// @param[in] data The message to be sent.
+/// @param[in] nbits The number of bits of the message to be sent.
+/// @param[in] repeat The number of times the command is to be repeated.
+/// @param[in] priority Messages with a higher priority are sent first.
+/// @param[in] replace Replace a message of the same type that is still
+///   waiting to be sent, rather than sending both? e.g. Volume up twice
+///   needs to be sent twice, so the default is not to.
+/// @return true, if it was added. false if the queue is full.
+bool IRsendQueue::add(const decode_type_t type, const uint64_t data,
+                      const uint16_t nbits, const uint16_t repeat,
+                      const uint8_t priority, const bool replace) {
+  send_queue_entry_t entry;
+  entry.type = type;
+  entry.data = data;
+  entry.nbits = nbits;
+  entry.repeat = repeat;
+  entry.sequence = NULL;
+  entry.priority = priority;
+  entry.is_state = false;
+  return _add(&entry, replace);
+}
+
+/// Add a complex (state[]) message to the queue. e.g. An A/C's state.
+/// @param[in] type Protocol number/type of the message. See `IRsend::send()`.
+/// @param[in] state A pointer to the array of bytes that make up the state[].
+///   It is copied.
+/// @param[in] nbytes How many bytes are in the state.
+/// @param[in] priority Messages with a higher priority are sent first.
+/// @param[in] replace Replace a message of the same type that is still
+///   waiting to be sent? i.e. Only the newest state of an A/C gets sent.
+/// @return true, if it was added. false if the queue is full, or the state is
+///   larger than `kSendQueueStateSize`.
+bool IRsendQueue::add(const decode_type_t type, const uint8_t *state,
+                      const uint16_t nbytes, const uint8_t priority,
+                      const bool replace) {
+  if (nbytes > kSendQueueStateSize) {
+    _drops++;
+    return false;
+  }
+  send_queue_entry_t entry;
+  entry.type = type;
+  entry.data = 0;
+  memcpy(entry.state, state, nbytes);
+  entry.nbits = nbytes;
+  entry.repeat = kNoRepeat;
+  entry.sequence = NULL;
+  entry.priority = priority;
+  entry.is_state = true;
+  return _add(&entry, replace);
+}
+
+/// Add a recorded message to the queue. See `IRsend::startRecording()`.
+/// @param[in] sequence The message to be sent. It isn't copied, so it must
+///   be left alone until it has been sent.
+/// @param[in] repeat Nr. of extra times to send it.
+/// @param[in] priority Messages with a higher priority are sent first.
+/// @param[in] replace Replace the same sequence if it is still waiting to be
+///   sent, rather than sending it twice?
+/// @return true, if it was added. false if the queue is full.
+bool IRsendQueue::add(const IRsequence *sequence, const uint16_t repeat,
+                      const uint8_t priority, const bool replace) {
+  if (sequence == NULL) return false;
+  send_queue_entry_t entry;
+  entry.type = UNKNOWN;
+  entry.data = 0;
+  entry.nbits = 0;
+  entry.repeat = repeat;
+  entry.sequence = sequence;
+  entry.priority = priority;
+  entry.is_state = false;
+  return _add(&entry, replace);
+}
+
+/// Put a message in the queue.
+/// @param[in] entry The message.
+/// @param[in] replace Replace a pending message of the same type/sequence?
+///   It then keeps the place of the one it replaces, & the higher priority.
+/// @return true, if it was added. Otherwise false.
+bool IRsendQueue::_add(const send_queue_entry_t *entry, const bool replace) {
+  SEND_QUEUE_LOCK();
+  send_queue_entry_t *slot = NULL;
+  for (uint8_t i = 0; i < _size; i++) {
+    send_queue_entry_t *pending = &_entries[i];
+    if (replace && pending->used && pending->type == entry->type &&
+        pending->sequence == entry->sequence &&
+        pending->is_state == entry->is_state) {
+      const uint32_t order = pending->order;
+      const uint8_t priority = std::max(pending->priority, entry->priority);
+      *pending = *entry;
+      pending->order = order;
+      pending->priority = priority;
+      pending->used = true;
+      SEND_QUEUE_UNLOCK();
+      return true;
+    }
+    if (slot == NULL && !pending->used) slot = pending;
+  }
+  if (slot != NULL) {
+    *slot = *entry;
+    slot->order = _order++;
+    slot->used = true;
+  } else {
+    _drops++;
   }
+  SEND_QUEUE_UNLOCK();
+  return slot != NULL;
+}
+
+/// Send the next message in the queue, if it is time to.
+/// i.e. The previous message has been sent, & the gap after it has passed.
+/// Call it often. e.g. From `loop()`.
+/// @return true, if a message was sent (or started). Otherwise false.
+/// @note If `IRsend::enableRmtSend()` (or `enableTimerSend()`) is in use, the
+///   message is sent in the background, & this returns at once. Otherwise it
+///   returns once the message has been sent.
+bool IRsendQueue::handle(void) {
+  if (_irsend == NULL || _since.elapsed() < _wait) return false;
+#if ENABLE_DEFERRED_GAPS
+  if (_irsend->gapRemaining()) return false;  // Its last message's gap.
+#endif  // ENABLE_DEFERRED_GAPS
+#if IRSEND_ASYNC
+  if (_irsend->isBusy()) return false;
+#endif  // IRSEND_ASYNC
+  send_queue_entry_t entry;
+  send_queue_entry_t *next = NULL;
+  SEND_QUEUE_LOCK();
+  for (uint8_t i = 0; i < _size; i++) {
+    send_queue_entry_t *pending = &_entries[i];
+    if (!pending->used) continue;
+    if (next == NULL || pending->priority > next->priority ||
+        (pending->priority == next->priority &&
+         (int32_t)(pending->order - next->order) < 0))
+      next = pending;
+  }
+  if (next != NULL) {
+    entry = *next;
+    next->used = false;
+  }
+  SEND_QUEUE_UNLOCK();
+  if (next == NULL) return false;
+
+#if IRSEND_ASYNC
+  IRtimer started;
+  const bool async = _irsend->beginAsync();
+#endif  // IRSEND_ASYNC
+  bool success = true;
+  if (entry.sequence != NULL)
+    _irsend->sendSequence(entry.sequence, entry.repeat);
+  else if (entry.is_state)
+    success = _irsend->send(entry.type, entry.state, entry.nbits);
+  else
+    success = _irsend->send(entry.type, entry.data, entry.nbits, entry.repeat);
+  _wait = _gap;
+#if IRSEND_ASYNC
+  // Wait for it to be sent (in the background) too. It was only recorded.
+  if (async && !_irsend->sendAsync()) success = false;
+  if (async && success) _wait += started.elapsed();
+#endif  // IRSEND_ASYNC
+  _since.reset();
+  if (!success) _drops++;
   return true;
 }
+
+/// Get the nr. of messages waiting to be sent.
+/// @return The nr. of messages.
+uint8_t IRsendQueue::pending(void) {
+  uint8_t count = 0;
+  SEND_QUEUE_LOCK();
+  for (uint8_t i = 0; i < _size; i++)
+    if (_entries[i].used) count++;
+  SEND_QUEUE_UNLOCK();
+  return count;
+}
+
+/// Discard all of the messages waiting to be sent.
+void IRsendQueue::clear(void) {
+  SEND_QUEUE_LOCK();
+  for (uint8_t i = 0; i < _size; i++) _entries[i].used = false;
+  SEND_QUEUE_UNLOCK();
+}
+
+/// Set the min. time between the end of a message & the start of the next.
+/// This is on top of any gap the protocol itself has at the end of a message.
+/// @param[in] usecs The gap in microseconds. (Def: kDefaultMessageGap)
+void IRsendQueue::setGap(const uint32_t usecs) { _gap = usecs; }
+
+/// Get the min. time between the end of a message & the start of the next.
+/// @return The gap in microseconds.
+uint32_t IRsendQueue::getGap(void) { return _gap; }
+
+/// Get the nr. of messages that were dropped. i.e. They didn't fit in the
+/// queue, or weren't a type `IRsend::send()` knows how to send.
+/// @return The nr. of messages.
+uint32_t IRsendQueue::getDrops(void) { return _drops; }
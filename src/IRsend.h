@@ -5,8 +5,39 @@
 #define IRSEND_H_
 
 #define __STDC_LIMIT_MACROS
+#include <stddef.h>
 #include <stdint.h>
 #include "IRremoteESP8266.h"
+#include "IRhal.h"
+#include "IRtimer.h"
+#if defined(UNIT_TEST) && !defined(PROGMEM)
+#define PROGMEM  // Pretend we have the PROGMEM macro even if we really don't.
+#endif  // defined(UNIT_TEST) && !defined(PROGMEM)
+
+#if defined(ESP32) && ENABLE_ESP32_RMT_SEND && !defined(UNIT_TEST)
+#define IRSEND_RMT true
+#else  // defined(ESP32) && ENABLE_ESP32_RMT_SEND && !defined(UNIT_TEST)
+#define IRSEND_RMT false
+#endif  // defined(ESP32) && ENABLE_ESP32_RMT_SEND && !defined(UNIT_TEST)
+#if defined(ESP8266) && ENABLE_ESP8266_TIMER_SEND && !defined(UNIT_TEST)
+#define IRSEND_TIMER true
+#else  // defined(ESP8266) && ENABLE_ESP8266_TIMER_SEND && !defined(UNIT_TEST)
+#define IRSEND_TIMER false
+#endif  // defined(ESP8266) && ENABLE_ESP8266_TIMER_SEND && !defined(UNIT_TEST)
+#if defined(ESP8266) && ENABLE_ESP8266_UART_SEND && !defined(UNIT_TEST)
+#define IRSEND_UART true
+#else  // defined(ESP8266) && ENABLE_ESP8266_UART_SEND && !defined(UNIT_TEST)
+#define IRSEND_UART false
+#endif  // defined(ESP8266) && ENABLE_ESP8266_UART_SEND && !defined(UNIT_TEST)
+// Can the GPIO registers be written directly? See `IRsend::ledOn()`.
+#if ((defined(ESP8266) || defined(ESP32)) && ENABLE_FAST_GPIO_SEND && \
+     !defined(UNIT_TEST))
+#define IRSEND_FAST_GPIO true
+#else  // (ESP8266 || ESP32) && ENABLE_FAST_GPIO_SEND && !UNIT_TEST
+#define IRSEND_FAST_GPIO false
+#endif  // (ESP8266 || ESP32) && ENABLE_FAST_GPIO_SEND && !UNIT_TEST
+// Can messages be sent in the background? See `IRsend::beginAsync()`.
+#define IRSEND_ASYNC (IRSEND_RMT || IRSEND_TIMER)
 
 // Originally from https://github.com/shirriff/Arduino-IRremote/
 // Updated by markszabo (https://github.com/crankyoldgit/IRremoteESP8266) for
@@ -21,25 +52,100 @@
 // Constants
 // Offset (in microseconds) to use in Period time calculations to account for
 // code excution time in producing the software PWM signal.
+// These were measured with `digitalWrite()` toggling the pin.
 #if defined(ESP32)
 // Calculated on a generic ESP-WROOM-32 board with v3.2-18 SDK @ 240MHz
-const int8_t kPeriodOffset = -2;
+const int8_t kDigitalWritePeriodOffset = -2;
 #elif (defined(ESP8266) && F_CPU == 160000000L)  // NOLINT(whitespace/parens)
 // Calculated on an ESP8266 NodeMCU v2 board using:
 // v2.6.0 with v2.5.2 ESP core @ 160MHz
-const int8_t kPeriodOffset = -2;
+const int8_t kDigitalWritePeriodOffset = -2;
 #else  // (defined(ESP8266) && F_CPU == 160000000L)
 // Calculated on ESP8266 Wemos D1 mini using v2.4.1 with v2.4.0 ESP core @ 40MHz
-const int8_t kPeriodOffset = -5;
+const int8_t kDigitalWritePeriodOffset = -5;
 #endif  // (defined(ESP8266) && F_CPU == 160000000L)
+// For direct GPIO register writes. See `ENABLE_FAST_GPIO_SEND`.
+// Not measured yet. A register write takes a fraction of a microsecond, so
+// there is next to no overhead to take off. `IRsend::calibrate()` refines it.
+const int8_t kFastGpioPeriodOffset = 0;
+#if IRSEND_FAST_GPIO
+const int8_t kPeriodOffset = kFastGpioPeriodOffset;
+#else  // IRSEND_FAST_GPIO
+const int8_t kPeriodOffset = kDigitalWritePeriodOffset;
+#endif  // IRSEND_FAST_GPIO
+// Max. nr. of frequencies `IRsend::calibrate()` etc. can store an offset for.
+const uint8_t kPeriodOffsetTableSize = 8;
+// How close (in Hz) a carrier has to be to one in the table to use its offset.
+const uint16_t kPeriodOffsetMaxDelta = 500;
 const uint8_t kDutyDefault = 50;  // Percentage
 const uint8_t kDutyMax = 100;     // Percentage
+// Which of the ESP32 LEDC channels to use by default when sending. (0-15)
+// Only used when ENABLE_ESP32_LEDC_SEND is set.
+const uint8_t kDefaultESP32LedcChannel = 0;
+const uint8_t kESP32LedcResolution = 8;  // Bits of duty cycle precision.
+const uint8_t kESP32LedcChannels = 16;  // Nr. of LEDC channels.
+// What a shared LEDC channel needs changed. See `IRsend::shareLedcCarrier()`.
+const uint8_t kLedcNewFreq = 1 << 0;
+const uint8_t kLedcNewDuty = 1 << 1;
+// Which of the ESP32 RMT channels to use by default when sending. (0-7)
+// Only used with `IRsend::enableRmtSend()`. The receivers' RMT channels count
+// up from channel 0, so it is the last one.
+const uint8_t kDefaultESP32RmtSendChannel = 7;
+// Default nr. of RMT items (a mark & a space each) a message can be sent with.
+const uint16_t kDefaultESP32RmtSendItems = 1024;  // i.e. 4KB of RAM.
+// The only GPIO the ESP8266's UART1 TX line (& hence `enableUartSend()`) uses.
+const uint16_t kESP8266UartSendPin = 2;
+// Nr. of UART bits per carrier cycle. i.e. A start bit, 8 data & a stop bit.
+const uint8_t kESP8266UartBitsPerCycle = 10;
 // delayMicroseconds() is only accurate to 16383us.
 // Ref: https://www.arduino.cc/en/Reference/delayMicroseconds
 const uint16_t kMaxAccurateUsecDelay = 16383;
 //  Usecs to wait between messages we don't know the proper gap time.
 const uint32_t kDefaultMessageGap = 100000;
 
+// The largest state any of the enabled senders take. e.g. To size a buffer to
+// hold a state to send. It doesn't depend on which decoders are enabled.
+// See `kStateSizeMax` for what a `decode_results::state` can hold.
+// Note: MWM messages vary in length, so it keeps the old (Hitachi AC) size.
+const uint16_t kSendStateSizeMax =
+    (SEND_HITACHI_AC2 || SEND_MWM) ? kHitachiAc2StateLength :
+    SEND_HITACHI_AC424 ? kHitachiAc424StateLength :
+    SEND_HITACHI_AC344 ? kHitachiAc344StateLength :
+    SEND_DAIKIN2 ? kDaikin2StateLength :
+    SEND_DAIKIN ? kDaikinStateLength :
+    SEND_HITACHI_AC ? kHitachiAcStateLength :
+    SEND_DAIKIN216 ? kDaikin216StateLength :
+    SEND_HITACHI_AC3 ? kHitachiAc3StateLength :
+    SEND_PANASONIC_AC ? kPanasonicAcStateLength :
+    SEND_DAIKIN176 ? kDaikin176StateLength :
+    SEND_CORONA_AC ? kCoronaAcStateLength :
+    SEND_SAMSUNG_AC ? kSamsungAcExtendedStateLength :
+    SEND_WHIRLPOOL_AC ? kWhirlpoolAcStateLength :
+    SEND_DAIKIN160 ? kDaikin160StateLength :
+    SEND_DAIKIN152 ? kDaikin152StateLength :
+    SEND_MITSUBISHIHEAVY ? kMitsubishiHeavy152StateLength :
+    SEND_MITSUBISHI_AC ? kMitsubishiACStateLength :
+    SEND_MITSUBISHI136 ? kMitsubishi136StateLength :
+    SEND_FUJITSU_AC ? kFujitsuAcStateLength :
+    SEND_KELVINATOR ? kKelvinatorStateLength :
+    SEND_DAIKIN128 ? kDaikin128StateLength :
+    SEND_HAIER_AC_YRW02 ? kHaierACYRW02StateLength :
+    SEND_TCL112AC ? kTcl112AcStateLength :
+    SEND_MITSUBISHI112 ? kMitsubishi112StateLength :
+    SEND_HITACHI_AC1 ? kHitachiAc1StateLength :
+    SEND_ELECTRA_AC ? kElectraAcStateLength :
+    SEND_SHARP_AC ? kSharpAcStateLength :
+    SEND_ARGO ? kArgoStateLength :
+    SEND_NEOCLIMA ? kNeoclimaStateLength :
+    SEND_TOSHIBA_AC ? kToshibaACStateLengthLong :
+    SEND_VOLTAS ? kVoltasStateLength :
+    SEND_HAIER_AC ? kHaierACStateLength :
+    SEND_TROTEC ? kTrotecStateLength :
+    SEND_SANYO_AC ? kSanyoAcStateLength :
+    SEND_GREE ? kGreeStateLength :
+    SEND_AMCOR ? kAmcorStateLength :
+    0;  // Nothing enabled sends one.
+
 /// Enumerators and Structures for the Common A/C API.
 namespace stdAc {
   /// Common A/C settings for A/C operating modes.
@@ -169,6 +275,175 @@ enum lg_ac_remote_model_t {
 
 // Classes
 
+// Highest GPIO that can be added to an `IRsend` with `addPin()`. i.e. The
+// ones a single register write can set or clear together.
+#if defined(ESP8266)
+const uint16_t kSendMaxMaskPin = 15;  // GPIO16 isn't in the same register.
+#else  // defined(ESP8266)
+const uint16_t kSendMaxMaskPin = 31;
+#endif  // defined(ESP8266)
+
+// Default nr. of messages an `IRsendQueue` can hold.
+const uint8_t kSendQueueDefaultSize = 8;
+// Default priority of a message in an `IRsendQueue`. Higher is sent sooner.
+const uint8_t kSendQueueDefaultPriority = 0;
+// Largest state[] (in bytes) an `IRsendQueue` message can have.
+// Hitachi AC is the current largest state size.
+const uint16_t kSendQueueStateSize = kHitachiAc2StateLength;
+
+// Max. nr. of distinct durations a compressed raw message can have.
+// i.e. Each mark & space is stored as a 4-bit index into them.
+// See `IRsend::compressRaw()`.
+const uint8_t kRawCompressedMaxPalette = 16;
+// Default % two durations can differ by & still share a palette entry.
+const uint8_t kRawCompressedTolerance = 10;
+
+// Nr. of marks & spaces `IRsend::sendRawStream()` reads from its source at a
+// time. i.e. All the RAM it needs for a message of any length.
+const uint16_t kRawStreamChunkSize = 32;  // i.e. 64 bytes of stack.
+
+// Default nr. of marks & spaces an `IRsequence` can hold.
+const uint16_t kSequenceDefaultSize = 1024;  // i.e. 2KB of RAM.
+
+// How long after a mark ends a receiver may still see it. i.e. The lag of its
+// demodulator, with plenty to spare. (uSeconds) See `IRsend::getEcho()`.
+const uint16_t kEchoMargin = 1000;
+
+/// A recorded IR message. i.e. The carrier & the marks & spaces of it.
+/// @see IRsend::startRecording(), IRsend::sendSequence()
+class IRsequence {
+ public:
+  explicit IRsequence(const uint16_t size = kSequenceDefaultSize);
+  ~IRsequence(void);
+  void clear(void);
+  bool add(const bool mark, uint32_t usec);
+  bool set(const uint16_t durations[], const uint16_t length,
+           const uint32_t freq, const uint8_t duty = kDutyDefault);
+  bool setNormalised(const uint8_t code[], const uint16_t size,
+                     const uint32_t freq, const uint8_t duty = kDutyDefault);
+  void setCarrier(const uint32_t freq, const uint8_t duty);
+  const uint16_t *durations(void) const;
+  uint16_t length(void) const;
+  uint16_t size(void) const;
+  uint32_t frequency(void) const;
+  uint8_t dutyCycle(void) const;
+  bool overflowed(void) const;
+  uint32_t duration(void) const;
+  uint32_t gap(void) const;
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  uint16_t *_durations;  // Even entries are marks, odd are spaces. (usecs)
+  uint16_t _size;
+  uint16_t _length;
+  uint32_t _freq;  // Hz
+  uint8_t _duty;  // Percentage
+  bool _overflow;
+  uint32_t _duration;  // Total of all that was added, even if it didn't fit.
+  uint32_t _gap;  // Total of the trailing space(s).
+  bool _push(const uint16_t usec);
+  IRsequence(const IRsequence &);  // Not copyable, as it owns its buffer.
+  IRsequence &operator=(const IRsequence &);
+};
+
+/// Where `IRsend::sendRawStream()` reads the marks & spaces of a raw message
+/// from, a few at a time. e.g. A file, or a region of flash.
+class IRrawSource {
+ public:
+  virtual ~IRrawSource(void) {}
+  /// Read the next marks & spaces of the message.
+  /// @param[out] durations Where to. (uSeconds) Even entries of the message are
+  ///   marks, odd are spaces.
+  /// @param[in] max Nr. of entries `durations` has room for.
+  /// @return Nr. of entries read. 0 when the message has ended.
+  virtual uint16_t read(uint16_t durations[], const uint16_t max) = 0;
+};
+
+/// A raw message in an array in RAM, or in flash (PROGMEM).
+class IRrawArraySource : public IRrawSource {
+ public:
+  IRrawArraySource(const uint16_t durations[], const uint32_t length,
+                   const bool progmem = false);
+  uint16_t read(uint16_t durations[], const uint16_t max);
+  void rewind(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  const uint16_t *_durations;
+  uint32_t _length;
+  uint32_t _index;  // The next entry to read.
+  bool _progmem;
+};
+
+#ifndef UNIT_TEST
+class Stream;
+
+/// A raw message in an Arduino `Stream`. e.g. A LittleFS/SPIFFS/SD `File`.
+/// Each mark & space is a uint16_t, in little-endian byte order. i.e. The
+/// bytes of the array `IRsend::sendRaw()` would be given, as they are.
+class IRrawStreamSource : public IRrawSource {
+ public:
+  explicit IRrawStreamSource(Stream *stream,
+                             const uint32_t length = UINT32_MAX);
+  uint16_t read(uint16_t durations[], const uint16_t max);
+
+ private:
+  Stream *_stream;
+  uint32_t _left;  // Nr. of entries that may still be read.
+};
+#endif  // UNIT_TEST
+
+/// The requested & measured duration of a mark or space. (uSeconds)
+/// @see IRsend::enableSendTiming()
+typedef struct {
+  uint32_t requested;
+  uint32_t actual;
+} send_timing_entry_t;
+
+/// Statistics on how accurately `IRsend` sent a message.
+/// @see IRsend::enableSendTiming()
+typedef struct {
+  uint16_t marks;      // Nr. of marks sent.
+  uint16_t spaces;     // Nr. of spaces sent.
+  uint32_t pulses;     // Nr. of carrier pulses generated by the marks.
+  uint32_t requested;  // Total duration asked for. (uSeconds)
+  uint32_t actual;     // Total duration measured. (uSeconds)
+  int32_t drift;       // Accumulated error. i.e. actual - requested. (uSecs)
+  uint32_t max_drift;  // Largest accumulated error (+/-) at any point. (uSecs)
+  uint32_t max_error;  // Largest error (+/-) of a single mark/space. (uSecs)
+  uint16_t logged;     // Nr. of entries written to the log. If any.
+} send_timing_t;
+
+// Default longest a yield may take. See `IRsend::enableCooperativeSend()`.
+const uint32_t kCooperativeSendBudget = 5000;  // uSeconds.
+
+/// How `IRsend` yielded to the rest of the system whilst sending a message.
+/// @see IRsend::enableCooperativeSend()
+typedef struct {
+  uint32_t yields;     // Nr. of times it yielded.
+  uint32_t yielded;    // Total time spent yielding. (uSeconds)
+  uint32_t max_yield;  // Longest single yield. (uSeconds)
+  uint16_t overruns;   // Nr. of spaces the yields made too long.
+  uint32_t error;      // Total time the spaces were too long by. (uSeconds)
+  uint32_t max_error;  // Most a single space was too long by. (uSeconds)
+} cooperative_send_t;
+
+/// How a protocol is sent. i.e. Its carrier & how long it takes to send.
+/// @see IRsend::protocolInfo()
+typedef struct {
+  uint32_t frequency;    // Carrier frequency. (Hz)
+  uint8_t duty;          // Carrier duty cycle. (Percentage)
+  uint16_t bits;         // Nr. of bits of the message.
+  uint16_t repeats;      // Nr. of repeats sent. i.e. At least the minimum.
+  uint32_t duration;     // Total on-air time, incl. repeats & gaps. (uSeconds)
+  uint32_t gap;          // The space/gap after the last frame. (uSeconds)
+} protocol_info_t;
+
+/// Callback for when a message queued by `IRsend::sendAsync()` has been sent.
+typedef void (*send_callback_t)(void *arg);
+
 /// Class for sending all basic IR protocols.
 /// @note Originally from https://github.com/shirriff/Arduino-IRremote/
 ///  Updated by markszabo (https://github.com/crankyoldgit/IRremoteESP8266) for
@@ -178,12 +453,85 @@ class IRsend {
   explicit IRsend(uint16_t IRsendPin, bool inverted = false,
                   bool use_modulation = true);
   void begin();
+  bool addPin(const uint16_t pin);
+  uint32_t getPinMask(void);
   void enableIROut(uint32_t freq, uint8_t duty = kDutyDefault);
+#if ENABLE_ESP32_LEDC_SEND
+  void setLedcChannel(const uint8_t channel);
+  void shareLedcCarrier(const bool share = true);
+#endif  // ENABLE_ESP32_LEDC_SEND
+#if IRSEND_RMT
+  bool enableRmtSend(const uint8_t channel = kDefaultESP32RmtSendChannel,
+                     const uint16_t items = kDefaultESP32RmtSendItems);
+  void disableRmtSend(void);
+  static void _rmtSent(const uint8_t channel);
+#endif  // IRSEND_RMT
+#if IRSEND_TIMER
+  bool enableTimerSend(const uint16_t size = kSequenceDefaultSize);
+  void disableTimerSend(void);
+#endif  // IRSEND_TIMER
+#if IRSEND_UART
+  bool enableUartSend(void);
+  void disableUartSend(void);
+#endif  // IRSEND_UART
+#if IRSEND_ASYNC
+  bool beginAsync(void);
+  bool sendAsync(send_callback_t callback = NULL, void *arg = NULL);
+  bool isBusy(void);
+#endif  // IRSEND_ASYNC
+#if ENABLE_ECHO_SUPPRESSION
+  const ir_echo_t *getEcho(void) const;
+#endif  // ENABLE_ECHO_SUPPRESSION
+#if ENABLE_IR_MIRROR
+  bool beginMirror(const uint32_t freq = 38000,
+                   const uint8_t duty = kDutyDefault);
+  void mirrorMark(const bool lit);
+#endif  // ENABLE_IR_MIRROR
+#if ENABLE_CUSTOM_BACKENDS
+  void setSink(IRsendSink *sink);
+  IRsendSink *getSink(void) const;
+#endif  // ENABLE_CUSTOM_BACKENDS
   VIRTUAL void _delayMicroseconds(uint32_t usec);
   VIRTUAL uint16_t mark(uint16_t usec);
   VIRTUAL void space(uint32_t usec);
   int8_t calibrate(uint16_t hz = 38000U);
+  bool setPeriodOffset(const int8_t offset, const uint32_t hz = 0);
+  int8_t getPeriodOffset(const uint32_t hz = 0);
+  void clearPeriodOffsets(void);
   void sendRaw(const uint16_t buf[], const uint16_t len, const uint16_t hz);
+  void sendRaw_P(const uint16_t buf[], const uint16_t len, const uint16_t hz);
+  void sendRawTicks(const volatile uint16_t ticks[], const uint16_t len,
+                    const uint16_t hz, const uint16_t tick);
+  bool sendRawCompressed(const uint8_t data[], const uint16_t size,
+                         const uint16_t hz);
+  bool sendRawStream(IRrawSource *source, const uint16_t hz);
+  bool sendRawCompressed_P(const uint8_t data[], const uint16_t size,
+                           const uint16_t hz);
+  static uint16_t compressRaw(const uint16_t raw[], const uint16_t len,
+                              uint8_t out[], const uint16_t out_size,
+                              const uint8_t tolerance =
+                                  kRawCompressedTolerance);
+#if ENABLE_SEND_TIMING
+  void enableSendTiming(send_timing_entry_t *log = NULL,
+                        const uint16_t log_size = 0);
+  void disableSendTiming(void);
+  const send_timing_t *getSendTiming(void);
+#endif  // ENABLE_SEND_TIMING
+#if ENABLE_COOPERATIVE_SEND
+  void enableCooperativeSend(const uint32_t budget = kCooperativeSendBudget);
+  void disableCooperativeSend(void);
+  const cooperative_send_t *getCooperativeSend(void);
+#endif  // ENABLE_COOPERATIVE_SEND
+#if ENABLE_DEFERRED_GAPS
+  void enableDeferredGaps(const bool enable = true);
+  uint32_t gapRemaining(void);
+#endif  // ENABLE_DEFERRED_GAPS
+  void startRecording(IRsequence *sequence);
+  bool stopRecording(void);
+  static void startRecordingAll(IRsequence *sequence);
+  static bool stopRecordingAll(void);
+  void sendSequence(const IRsequence *sequence,
+                    const uint16_t repeat = kNoRepeat);
   void sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
                 uint32_t zerospace, uint64_t data, uint16_t nbits,
                 bool MSBfirst = true);
@@ -220,8 +568,24 @@ class IRsend {
                    const uint8_t *dataptr, const uint16_t nbytes,
                    const uint16_t frequency, const bool MSBfirst,
                    const uint16_t repeat, const uint8_t dutycycle);
+  void sendPulseDistance(const pulse_distance_t *protocol, const uint64_t data,
+                         const uint16_t nbits, const uint16_t repeat);
+  void sendSections(const ac_sections_t *frame, const uint8_t data[],
+                    const uint16_t nbytes);
+  bool sendPrecompiled(const precompiled_section_t *section,
+                       const uint8_t data[], const uint16_t nbytes,
+                       const uint16_t hz, const uint8_t duty = kDutyDefault);
+#if (SEND_GREE || SEND_KELVINATOR)
+  void sendGreeFrame(const gree_frame_t *frame, const uint8_t data[],
+                     const uint16_t nbytes);
+#endif  // (SEND_GREE || SEND_KELVINATOR)
   static uint16_t minRepeats(const decode_type_t protocol);
   static uint16_t defaultBits(const decode_type_t protocol);
+  bool protocolInfo(const decode_type_t type, protocol_info_t *info,
+                    const uint16_t nbits = 0,
+                    const uint16_t repeat = kNoRepeat);
+  uint32_t estimateDuration(const decode_type_t type, const uint16_t nbits = 0,
+                            const uint16_t repeat = kNoRepeat);
   bool send(const decode_type_t type, const uint64_t data,
             const uint16_t nbits, const uint16_t repeat = kNoRepeat);
   bool send(const decode_type_t type, const uint8_t *state,
@@ -346,6 +710,8 @@ class IRsend {
 #if SEND_COOLIX
   void sendCOOLIX(uint64_t data, uint16_t nbits = kCoolixBits,
                   uint16_t repeat = kCoolixDefaultRepeat);
+  void sendCOOLIXSequence(const uint32_t codes[], const uint16_t ncodes,
+                          const uint16_t repeat = kCoolixDefaultRepeat);
 #endif
 #if SEND_WHYNTER
   void sendWhynter(const uint64_t data, const uint16_t nbits = kWhynterBits,
@@ -394,6 +760,7 @@ class IRsend {
 #endif  // SEND_INAX
 #if SEND_GLOBALCACHE
   void sendGC(uint16_t buf[], uint16_t len);
+  bool sendGC(const char *str);
 #endif
 #if SEND_KELVINATOR
   void sendKelvinator(const unsigned char data[],
@@ -456,6 +823,12 @@ class IRsend {
 #endif  // SEND_GOODWEATHER
 #if SEND_PRONTO
   void sendPronto(uint16_t data[], uint16_t len, uint16_t repeat = kNoRepeat);
+  bool sendPronto(const char *str, uint16_t repeat = kNoRepeat);
+  bool compilePronto(const uint16_t data[], const uint16_t len,
+                     IRsequence *intro, IRsequence *repeats);
+  bool compilePronto(const char *str, IRsequence *intro, IRsequence *repeats);
+  void sendPronto(const IRsequence *intro, const IRsequence *repeats,
+                  uint16_t repeat = kNoRepeat);
 #endif
 #if SEND_ARGO
   void sendArgo(const unsigned char data[],
@@ -479,6 +852,8 @@ class IRsend {
 #if SEND_MIDEA
   void sendMidea(uint64_t data, uint16_t nbits = kMideaBits,
                  uint16_t repeat = kMideaMinRepeat);
+  void sendMideaSequence(const uint64_t codes[], const uint16_t ncodes,
+                         const uint16_t repeat = kMideaMinRepeat);
 #endif  // SEND_MIDEA
 #if SEND_MIDEA24
   void sendMidea24(const uint64_t data, const uint16_t nbits = kMidea24Bits,
@@ -680,18 +1055,240 @@ class IRsend {
  private:
 #else
   uint32_t _freq_unittest;
+  uint32_t _yield_unittest;  // How long a yield takes. (uSeconds)
 #endif  // UNIT_TEST
   uint16_t onTimePeriod;
   uint16_t offTimePeriod;
   uint16_t IRpin;
   int8_t periodOffset;
+  struct {
+    uint32_t hz;  // 0 if unused.
+    int8_t offset;
+  } _period_offsets[kPeriodOffsetTableSize];  // Per frequency. See calibrate().
   uint8_t _dutycycle;
   bool modulation;
+  IRsequence *_sequence;  // Where mark() & space() are recorded to, if any.
+  static IRsequence *_all_sequence;  // Where every IRsend records to, if any.
+  IRsequence *_recorder(void);
+  uint32_t _pin_mask;  // All of the GPIOs to send with, if `addPin()` is used.
+#if ENABLE_CUSTOM_BACKENDS
+  IRsendSink *_sink;  // Where marks & spaces are sent to, if not the GPIO(s).
+#endif  // ENABLE_CUSTOM_BACKENDS
+#if ENABLE_SEND_TIMING
+  bool _timing_enabled;
+  send_timing_t _timing;
+  send_timing_entry_t *_timing_log;
+  uint16_t _timing_log_size;
+  void _timeEntry(const bool is_mark, const uint32_t requested,
+                  const uint32_t actual, const uint16_t pulses);
+#endif  // ENABLE_SEND_TIMING
+#if ENABLE_COOPERATIVE_SEND
+  uint32_t _coop_budget;  // 0 if disabled.
+  cooperative_send_t _coop;
+  void _cooperativeSpace(const uint32_t time);
+#endif  // ENABLE_COOPERATIVE_SEND
+#if ENABLE_DEFERRED_GAPS
+  bool _defer_gaps;
+  uint32_t _gap_pending;  // How long the LED has to stay off for. (uSeconds)
+  IRtimer _gap_timer;  // Since it was turned off.
+  void _waitForGap(void);
+#endif  // ENABLE_DEFERRED_GAPS
+  template <typename T>
+  void _sendBits(const uint16_t onemark, const uint32_t onespace,
+                 const uint16_t zeromark, const uint32_t zerospace,
+                 T data, uint16_t nbits, const bool MSBfirst);
+  void _sleep(const uint32_t time);
+  uint16_t _mark(uint16_t usec);
+  void _space(uint32_t time);
+#if SEND_COOLIX
+  void _sendCOOLIX(const uint64_t data, const uint16_t nbits,
+                   const uint16_t repeat);
+#endif  // SEND_COOLIX
+  bool _recording(void);
+#if ENABLE_ESP32_LEDC_SEND
+  uint8_t _ledc_channel;
+  uint32_t _ledc_freq;  // The carrier freq. the channel is configured for.
+  uint32_t _ledc_duty;  // The channel's duty value of a modulated mark.
+  bool _ledc_shared;  // Is the channel's carrier shared? See shareLedcCarrier.
+  // The carrier each channel is set to, for those that are shared.
+  static struct ledc_carrier_t {
+    uint32_t freq;  // 0 if not set.
+    uint32_t duty;
+  } _ledc_carriers[kESP32LedcChannels];
+  static uint8_t _ledcCarrier(const uint8_t channel, const uint32_t freq,
+                              const uint32_t duty);
+  void _ledcRoute(const bool carrier);
+#endif  // ENABLE_ESP32_LEDC_SEND
+#if IRSEND_RMT
+  uint8_t _rmt_channel;
+  void *_rmt_items;  // The message being built. NULL if RMT isn't enabled.
+  uint16_t _rmt_size;  // Nr. of items `_rmt_items` has room for.
+  uint16_t _rmt_halves;  // Nr. of item halves (marks/spaces) written.
+  uint32_t _rmt_pending;  // Duration of the mark/space not yet written. (us)
+  bool _rmt_level;  // Is the pending duration a mark?
+  bool _rmt_recording;  // Are marks & spaces being added to the message?
+  bool _rmt_overflow;  // Was the message too long for the items?
+  void _rmtCarrier(const uint32_t freq);
+  void _rmtAppend(const bool mark, const uint32_t usec);
+  void _rmtFlush(void);
+#endif  // IRSEND_RMT
+#if IRSEND_TIMER
+  IRsequence *_timer_sequence;  // The message. NULL if it isn't enabled.
+  const uint16_t *_timer_durations;  // Cached for the interrupt handler.
+  uint16_t _timer_length;
+  uint16_t _timer_index;  // The next entry of the message to send.
+  uint32_t _timer_left;  // Ticks left of the current mark.
+  uint32_t _timer_on;  // Ticks the LED is lit for, per carrier cycle.
+  uint32_t _timer_off;  // Ticks the LED is off for, per carrier cycle.
+  uint32_t _timer_mask;  // The GPIO(s) to send with.
+  bool _timer_lit;
+  volatile bool _timer_busy;
+  static void _timerISR(void);
+  void _timerStep(void);
+  void _timerWritePins(const bool lit);
+#endif  // IRSEND_TIMER
+#if IRSEND_UART
+  bool _uart_on;  // Is UART1 generating the carrier?
+  uint32_t _uart_freq;  // The carrier freq. the UART is configured for.
+  uint8_t _uart_frame;  // The byte whose serial frame is one carrier cycle.
+  uint16_t _uartMark(const uint16_t usec);
+#endif  // IRSEND_UART
+#if IRSEND_ASYNC
+  volatile send_callback_t _async_callback;
+  void *_async_arg;
+#endif  // IRSEND_ASYNC
+#if ENABLE_ECHO_SUPPRESSION
+  ir_echo_t _echo;  // When we are transmitting. For receivers to ignore it.
+  void _echoWindow(const uint32_t usecs);
+#endif  // ENABLE_ECHO_SUPPRESSION
   uint32_t calcUSecPeriod(uint32_t hz, bool use_offset = true);
+  bool _sendRawCompressed(const uint8_t data[], const uint16_t size,
+                          const uint16_t hz, const bool progmem);
+  void _writePins(const uint8_t level);
+#if IRSEND_FAST_GPIO
+  volatile uint32_t *_lit_reg;  // Writing `_gpio_mask` here lights the LED(s).
+  volatile uint32_t *_unlit_reg;  // & writing it here turns them off.
+  uint32_t _gpio_mask;  // 0 if the registers can't be used.
+  void _cacheGpio(void);
+#endif  // IRSEND_FAST_GPIO
+#if SEND_MIDEA
+  void _sendMideaFrame(const uint64_t data, const uint16_t nbits);
+#endif  // SEND_MIDEA
 #if SEND_SONY
   void _sendSony(const uint64_t data, const uint16_t nbits,
                  const uint16_t repeat, const uint16_t freq);
 #endif  // SEND_SONY
 };
 
+/// How `IRsend::send()` sends a protocol. See src/IRsendTable.h, which has one
+/// per `decode_type_t`, generated by tools/generate_send_table.py.
+typedef struct {
+  // Sends a simple (<= 64 bit) message. NULL if it can't be sent.
+  void (IRsend::*simple)(uint64_t data, uint16_t nbits, uint16_t repeat);
+  // Sends a complex (state[]) message. NULL if it can't be sent.
+  void (IRsend::*state)(const uint8_t data[], uint16_t nbytes,
+                        uint16_t repeat);
+  uint16_t bits;  // Default nr. of bits of a message. 0 if there isn't one.
+  uint16_t repeats;  // Min. nr. of repeats of a simple message.
+  uint16_t state_repeats;  // Nr. of repeats of a complex message.
+} irsend_protocol_t;
+
+/// A message waiting to be sent by an `IRsendQueue`.
+typedef struct {
+  decode_type_t type;  // UNKNOWN if it is a sequence.
+  uint64_t data;  // For simple (<= 64 bit) messages.
+  uint8_t state[kSendQueueStateSize];  // For complex (state[]) messages.
+  uint16_t nbits;  // Or the nr. of bytes of `state`.
+  uint16_t repeat;
+  const IRsequence *sequence;
+  uint8_t priority;
+  uint32_t order;  // When it was added. Earlier is sent first.
+  bool is_state;
+  bool used;
+} send_queue_entry_t;
+
+/// A queue of messages for an `IRsend` to send, one after the other.
+/// Callers add messages to it, & `handle()` (called from `loop()`, or a task
+/// of its own) sends them when the previous one, & the gap after it, are done.
+class IRsendQueue {
+ public:
+  explicit IRsendQueue(IRsend *irsend,
+                       const uint8_t size = kSendQueueDefaultSize);
+  ~IRsendQueue(void);
+  bool add(const decode_type_t type, const uint64_t data,
+           const uint16_t nbits, const uint16_t repeat = kNoRepeat,
+           const uint8_t priority = kSendQueueDefaultPriority,
+           const bool replace = false);
+  bool add(const decode_type_t type, const uint8_t *state,
+           const uint16_t nbytes,
+           const uint8_t priority = kSendQueueDefaultPriority,
+           const bool replace = true);
+  bool add(const IRsequence *sequence, const uint16_t repeat = kNoRepeat,
+           const uint8_t priority = kSendQueueDefaultPriority,
+           const bool replace = false);
+  bool handle(void);
+  uint8_t pending(void);
+  void clear(void);
+  void setGap(const uint32_t usecs);
+  uint32_t getGap(void);
+  uint32_t getDrops(void);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRsend *_irsend;
+  send_queue_entry_t *_entries;
+  uint8_t _size;
+  uint32_t _order;  // The order of the next message added.
+  uint32_t _gap;  // Min. time between messages. (usecs)
+  uint32_t _wait;  // Time to wait since `_since` before the next message.
+  IRtimer _since;  // When the last message was sent.
+  uint32_t _drops;  // Nr. of messages that didn't fit, or couldn't be sent.
+  bool _add(const send_queue_entry_t *entry, const bool replace);
+  IRsendQueue(const IRsendQueue &);  // Not copyable, as it owns its buffer.
+  IRsendQueue &operator=(const IRsendQueue &);
+};
+
+#if SEND_LEGOPF
+// Nr. of channels a LEGO Power Functions remote/receiver has.
+const uint8_t kLegoPfChannels = 4;
+// Nr. of pending updates an `IRLegoPfScheduler` keeps per channel.
+// i.e. One for output A, one for B, & one for commands of both outputs.
+const uint8_t kLegoPfUpdateSlots = 3;
+
+/// An update waiting to be sent by an `IRLegoPfScheduler`.
+typedef struct {
+  uint16_t data;  // The LEGO PF message.
+  uint8_t copies;  // Nr. of times it is still to be sent. 0 if unused.
+  uint32_t order;  // When it was added. Earlier is sent first.
+} legopf_update_t;
+
+/// Sends the latest LEGO Power Functions command of each channel & output, as
+/// often as the protocol allows. A newer command for the same channel & output
+/// replaces one still waiting to be sent, & the channels take turns to send.
+/// i.e. A channel waits its 5 message slots between messages, like the spec.
+/// requires, but the other channels can send in the meantime.
+/// Call `handle()` often. e.g. From `loop()`.
+class IRLegoPfScheduler {
+ public:
+  explicit IRLegoPfScheduler(IRsend *irsend);
+  bool update(const uint16_t data, const uint8_t copies = 1);
+  bool handle(void);
+  uint8_t pending(void);
+  void clear(void);
+  static uint8_t getChannel(const uint16_t data);
+  static uint8_t getOutputSlot(const uint16_t data);
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRsend *_irsend;
+  legopf_update_t _updates[kLegoPfChannels][kLegoPfUpdateSlots];
+  uint32_t _order;  // The order of the next update added.
+  uint8_t _next;  // The channel whose turn it is to send next.
+  IRtimer _started[kLegoPfChannels];  // When each channel last sent.
+  uint8_t _waiting;  // Bitmask of the channels that have to wait for a slot.
+};
+#endif  // SEND_LEGOPF
+
 #endif  // IRSEND_H_
@@ -0,0 +1,532 @@
+// Copyright 2026 The IRremoteESP8266 authors
+// How `IRsend::send()` sends each protocol. See `irsend_protocol_t`.
+//
+// WARNING: Do not edit this file! This file is automatically generated by
+//          'tools/generate_send_table.py'.
+
+#ifndef IRSENDTABLE_H_
+#define IRSENDTABLE_H_
+
+#include "IRsend.h"
+
+// An entry per `decode_type_t`, in order, starting from UNKNOWN.
+const irsend_protocol_t kSendTable[] PROGMEM = {
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // UNKNOWN
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // UNUSED
+#if SEND_RC5
+  {&IRsend::sendRC5, NULL, 12, kNoRepeat, kNoRepeat},  // RC5
+#else  // SEND_RC5
+  {NULL, NULL, 12, kNoRepeat, kNoRepeat},  // RC5
+#endif  // SEND_RC5
+#if SEND_RC6
+  {&IRsend::sendRC6, NULL, 20, kNoRepeat, kNoRepeat},  // RC6
+#else  // SEND_RC6
+  {NULL, NULL, 20, kNoRepeat, kNoRepeat},  // RC6
+#endif  // SEND_RC6
+#if SEND_NEC
+  {&IRsend::sendNEC, NULL, 32, kNoRepeat, kNoRepeat},  // NEC
+#else  // SEND_NEC
+  {NULL, NULL, 32, kNoRepeat, kNoRepeat},  // NEC
+#endif  // SEND_NEC
+#if SEND_SONY
+  {&IRsend::sendSony, NULL, 20, kSonyMinRepeat, kNoRepeat},  // SONY
+#else  // SEND_SONY
+  {NULL, NULL, 20, kSonyMinRepeat, kNoRepeat},  // SONY
+#endif  // SEND_SONY
+#if SEND_PANASONIC
+  {&IRsend::sendPanasonic64, NULL, 48, kNoRepeat, kNoRepeat},  // PANASONIC
+#else  // SEND_PANASONIC
+  {NULL, NULL, 48, kNoRepeat, kNoRepeat},  // PANASONIC
+#endif  // SEND_PANASONIC
+#if SEND_JVC
+  {&IRsend::sendJVC, NULL, 16, kNoRepeat, kNoRepeat},  // JVC
+#else  // SEND_JVC
+  {NULL, NULL, 16, kNoRepeat, kNoRepeat},  // JVC
+#endif  // SEND_JVC
+#if SEND_SAMSUNG
+  {&IRsend::sendSAMSUNG, NULL, 32, kNoRepeat, kNoRepeat},  // SAMSUNG
+#else  // SEND_SAMSUNG
+  {NULL, NULL, 32, kNoRepeat, kNoRepeat},  // SAMSUNG
+#endif  // SEND_SAMSUNG
+#if SEND_WHYNTER
+  {&IRsend::sendWhynter, NULL, 32, kNoRepeat, kNoRepeat},  // WHYNTER
+#else  // SEND_WHYNTER
+  {NULL, NULL, 32, kNoRepeat, kNoRepeat},  // WHYNTER
+#endif  // SEND_WHYNTER
+#if SEND_AIWA_RC_T501
+  {&IRsend::sendAiwaRCT501, NULL, 15, kSingleRepeat,
+   kNoRepeat},  // AIWA_RC_T501
+#else  // SEND_AIWA_RC_T501
+  {NULL, NULL, 15, kSingleRepeat, kNoRepeat},  // AIWA_RC_T501
+#endif  // SEND_AIWA_RC_T501
+#if SEND_LG
+  {&IRsend::sendLG, NULL, 28, kNoRepeat, kNoRepeat},  // LG
+#else  // SEND_LG
+  {NULL, NULL, 28, kNoRepeat, kNoRepeat},  // LG
+#endif  // SEND_LG
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // SANYO
+#if SEND_MITSUBISHI
+  {&IRsend::sendMitsubishi, NULL, 16, kSingleRepeat, kNoRepeat},  // MITSUBISHI
+#else  // SEND_MITSUBISHI
+  {NULL, NULL, 16, kSingleRepeat, kNoRepeat},  // MITSUBISHI
+#endif  // SEND_MITSUBISHI
+#if SEND_DISH
+  {&IRsend::sendDISH, NULL, 16, kDishMinRepeat, kNoRepeat},  // DISH
+#else  // SEND_DISH
+  {NULL, NULL, 16, kDishMinRepeat, kNoRepeat},  // DISH
+#endif  // SEND_DISH
+#if SEND_SHARP
+  {&IRsend::sendSharpRaw, NULL, 15, kNoRepeat, kNoRepeat},  // SHARP
+#else  // SEND_SHARP
+  {NULL, NULL, 15, kNoRepeat, kNoRepeat},  // SHARP
+#endif  // SEND_SHARP
+#if SEND_COOLIX
+  {&IRsend::sendCOOLIX, NULL, 24, kSingleRepeat, kNoRepeat},  // COOLIX
+#else  // SEND_COOLIX
+  {NULL, NULL, 24, kSingleRepeat, kNoRepeat},  // COOLIX
+#endif  // SEND_COOLIX
+#if SEND_DAIKIN
+  {NULL, &IRsend::sendDaikin, kDaikinBits, kNoRepeat,
+   kDaikinDefaultRepeat},  // DAIKIN
+#else  // SEND_DAIKIN
+  {NULL, NULL, kDaikinBits, kNoRepeat, kDaikinDefaultRepeat},  // DAIKIN
+#endif  // SEND_DAIKIN
+#if SEND_DENON
+  {&IRsend::sendDenon, NULL, 15, kNoRepeat, kNoRepeat},  // DENON
+#else  // SEND_DENON
+  {NULL, NULL, 15, kNoRepeat, kNoRepeat},  // DENON
+#endif  // SEND_DENON
+#if SEND_KELVINATOR
+  {NULL, &IRsend::sendKelvinator, kKelvinatorBits, kNoRepeat,
+   kKelvinatorDefaultRepeat},  // KELVINATOR
+#else  // SEND_KELVINATOR
+  {NULL, NULL, kKelvinatorBits, kNoRepeat,
+   kKelvinatorDefaultRepeat},  // KELVINATOR
+#endif  // SEND_KELVINATOR
+#if SEND_SHERWOOD
+  {&IRsend::sendSherwood, NULL, 32, kSingleRepeat, kNoRepeat},  // SHERWOOD
+#else  // SEND_SHERWOOD
+  {NULL, NULL, 32, kSingleRepeat, kNoRepeat},  // SHERWOOD
+#endif  // SEND_SHERWOOD
+#if SEND_MITSUBISHI_AC
+  {NULL, &IRsend::sendMitsubishiAC, kMitsubishiACBits, kSingleRepeat,
+   kMitsubishiACMinRepeat},  // MITSUBISHI_AC
+#else  // SEND_MITSUBISHI_AC
+  {NULL, NULL, kMitsubishiACBits, kSingleRepeat,
+   kMitsubishiACMinRepeat},  // MITSUBISHI_AC
+#endif  // SEND_MITSUBISHI_AC
+#if SEND_RCMM
+  {&IRsend::sendRCMM, NULL, 24, kNoRepeat, kNoRepeat},  // RCMM
+#else  // SEND_RCMM
+  {NULL, NULL, 24, kNoRepeat, kNoRepeat},  // RCMM
+#endif  // SEND_RCMM
+#if SEND_SANYO
+  {&IRsend::sendSanyoLC7461, NULL, kSanyoLC7461Bits, kNoRepeat,
+   kNoRepeat},  // SANYO_LC7461
+#else  // SEND_SANYO
+  {NULL, NULL, kSanyoLC7461Bits, kNoRepeat, kNoRepeat},  // SANYO_LC7461
+#endif  // SEND_SANYO
+#if SEND_RC5
+  {&IRsend::sendRC5, NULL, 13, kNoRepeat, kNoRepeat},  // RC5X
+#else  // SEND_RC5
+  {NULL, NULL, 13, kNoRepeat, kNoRepeat},  // RC5X
+#endif  // SEND_RC5
+#if SEND_GREE
+  {&IRsend::sendGree, &IRsend::sendGree, kGreeBits, kNoRepeat,
+   kGreeDefaultRepeat},  // GREE
+#else  // SEND_GREE
+  {NULL, NULL, kGreeBits, kNoRepeat, kGreeDefaultRepeat},  // GREE
+#endif  // SEND_GREE
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // PRONTO
+#if SEND_NEC
+  {&IRsend::sendNEC, NULL, 32, kNoRepeat, kNoRepeat},  // NEC_LIKE
+#else  // SEND_NEC
+  {NULL, NULL, 32, kNoRepeat, kNoRepeat},  // NEC_LIKE
+#endif  // SEND_NEC
+#if SEND_ARGO
+  {NULL, &IRsend::sendArgo, kArgoBits, kNoRepeat, kArgoDefaultRepeat},  // ARGO
+#else  // SEND_ARGO
+  {NULL, NULL, kArgoBits, kNoRepeat, kArgoDefaultRepeat},  // ARGO
+#endif  // SEND_ARGO
+#if SEND_TROTEC
+  {NULL, &IRsend::sendTrotec, kTrotecBits, kNoRepeat,
+   kTrotecDefaultRepeat},  // TROTEC
+#else  // SEND_TROTEC
+  {NULL, NULL, kTrotecBits, kNoRepeat, kTrotecDefaultRepeat},  // TROTEC
+#endif  // SEND_TROTEC
+#if SEND_NIKAI
+  {&IRsend::sendNikai, NULL, 24, kNoRepeat, kNoRepeat},  // NIKAI
+#else  // SEND_NIKAI
+  {NULL, NULL, 24, kNoRepeat, kNoRepeat},  // NIKAI
+#endif  // SEND_NIKAI
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // RAW
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // GLOBALCACHE
+#if SEND_TOSHIBA_AC
+  {NULL, &IRsend::sendToshibaAC, kToshibaACBits, kSingleRepeat,
+   kToshibaACMinRepeat},  // TOSHIBA_AC
+#else  // SEND_TOSHIBA_AC
+  {NULL, NULL, kToshibaACBits, kSingleRepeat,
+   kToshibaACMinRepeat},  // TOSHIBA_AC
+#endif  // SEND_TOSHIBA_AC
+#if SEND_FUJITSU_AC
+  {NULL, &IRsend::sendFujitsuAC, 0, kNoRepeat,
+   kFujitsuAcMinRepeat},  // FUJITSU_AC
+#else  // SEND_FUJITSU_AC
+  {NULL, NULL, 0, kNoRepeat, kFujitsuAcMinRepeat},  // FUJITSU_AC
+#endif  // SEND_FUJITSU_AC
+#if SEND_MIDEA
+  {&IRsend::sendMidea, NULL, 48, kNoRepeat, kNoRepeat},  // MIDEA
+#else  // SEND_MIDEA
+  {NULL, NULL, 48, kNoRepeat, kNoRepeat},  // MIDEA
+#endif  // SEND_MIDEA
+#if SEND_MAGIQUEST
+  {&IRsend::sendMagiQuest, NULL, 56, kNoRepeat, kNoRepeat},  // MAGIQUEST
+#else  // SEND_MAGIQUEST
+  {NULL, NULL, 56, kNoRepeat, kNoRepeat},  // MAGIQUEST
+#endif  // SEND_MAGIQUEST
+#if SEND_LASERTAG
+  {&IRsend::sendLasertag, NULL, 13, kNoRepeat, kNoRepeat},  // LASERTAG
+#else  // SEND_LASERTAG
+  {NULL, NULL, 13, kNoRepeat, kNoRepeat},  // LASERTAG
+#endif  // SEND_LASERTAG
+#if SEND_CARRIER_AC
+  {&IRsend::sendCarrierAC, NULL, 32, kNoRepeat, kNoRepeat},  // CARRIER_AC
+#else  // SEND_CARRIER_AC
+  {NULL, NULL, 32, kNoRepeat, kNoRepeat},  // CARRIER_AC
+#endif  // SEND_CARRIER_AC
+#if SEND_HAIER_AC
+  {NULL, &IRsend::sendHaierAC, kHaierACBits, kNoRepeat,
+   kHaierAcDefaultRepeat},  // HAIER_AC
+#else  // SEND_HAIER_AC
+  {NULL, NULL, kHaierACBits, kNoRepeat, kHaierAcDefaultRepeat},  // HAIER_AC
+#endif  // SEND_HAIER_AC
+#if SEND_MITSUBISHI2
+  {&IRsend::sendMitsubishi2, NULL, 16, kSingleRepeat,
+   kNoRepeat},  // MITSUBISHI2
+#else  // SEND_MITSUBISHI2
+  {NULL, NULL, 16, kSingleRepeat, kNoRepeat},  // MITSUBISHI2
+#endif  // SEND_MITSUBISHI2
+#if SEND_HITACHI_AC
+  {NULL, &IRsend::sendHitachiAC, kHitachiAcBits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC
+#else  // SEND_HITACHI_AC
+  {NULL, NULL, kHitachiAcBits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC
+#endif  // SEND_HITACHI_AC
+#if SEND_HITACHI_AC1
+  {NULL, &IRsend::sendHitachiAC1, kHitachiAc1Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC1
+#else  // SEND_HITACHI_AC1
+  {NULL, NULL, kHitachiAc1Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC1
+#endif  // SEND_HITACHI_AC1
+#if SEND_HITACHI_AC2
+  {NULL, &IRsend::sendHitachiAC2, kHitachiAc2Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC2
+#else  // SEND_HITACHI_AC2
+  {NULL, NULL, kHitachiAc2Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC2
+#endif  // SEND_HITACHI_AC2
+#if SEND_GICABLE
+  {&IRsend::sendGICable, NULL, 16, kSingleRepeat, kNoRepeat},  // GICABLE
+#else  // SEND_GICABLE
+  {NULL, NULL, 16, kSingleRepeat, kNoRepeat},  // GICABLE
+#endif  // SEND_GICABLE
+#if SEND_HAIER_AC_YRW02
+  {NULL, &IRsend::sendHaierACYRW02, kHaierACYRW02Bits, kNoRepeat,
+   kHaierAcYrw02DefaultRepeat},  // HAIER_AC_YRW02
+#else  // SEND_HAIER_AC_YRW02
+  {NULL, NULL, kHaierACYRW02Bits, kNoRepeat,
+   kHaierAcYrw02DefaultRepeat},  // HAIER_AC_YRW02
+#endif  // SEND_HAIER_AC_YRW02
+#if SEND_WHIRLPOOL_AC
+  {NULL, &IRsend::sendWhirlpoolAC, kWhirlpoolAcBits, kNoRepeat,
+   kWhirlpoolAcDefaultRepeat},  // WHIRLPOOL_AC
+#else  // SEND_WHIRLPOOL_AC
+  {NULL, NULL, kWhirlpoolAcBits, kNoRepeat,
+   kWhirlpoolAcDefaultRepeat},  // WHIRLPOOL_AC
+#endif  // SEND_WHIRLPOOL_AC
+#if SEND_SAMSUNG_AC
+  {NULL, &IRsend::sendSamsungAC, kSamsungAcBits, kNoRepeat,
+   kSamsungAcDefaultRepeat},  // SAMSUNG_AC
+#else  // SEND_SAMSUNG_AC
+  {NULL, NULL, kSamsungAcBits, kNoRepeat,
+   kSamsungAcDefaultRepeat},  // SAMSUNG_AC
+#endif  // SEND_SAMSUNG_AC
+#if SEND_LUTRON
+  {&IRsend::sendLutron, NULL, 35, kNoRepeat, kNoRepeat},  // LUTRON
+#else  // SEND_LUTRON
+  {NULL, NULL, 35, kNoRepeat, kNoRepeat},  // LUTRON
+#endif  // SEND_LUTRON
+#if SEND_ELECTRA_AC
+  {NULL, &IRsend::sendElectraAC, kElectraAcBits, kNoRepeat,
+   kNoRepeat},  // ELECTRA_AC
+#else  // SEND_ELECTRA_AC
+  {NULL, NULL, kElectraAcBits, kNoRepeat, kNoRepeat},  // ELECTRA_AC
+#endif  // SEND_ELECTRA_AC
+#if SEND_PANASONIC_AC
+  {NULL, &IRsend::sendPanasonicAC, kPanasonicAcBits, kNoRepeat,
+   kPanasonicAcDefaultRepeat},  // PANASONIC_AC
+#else  // SEND_PANASONIC_AC
+  {NULL, NULL, kPanasonicAcBits, kNoRepeat,
+   kPanasonicAcDefaultRepeat},  // PANASONIC_AC
+#endif  // SEND_PANASONIC_AC
+#if SEND_PIONEER
+  {&IRsend::sendPioneer, NULL, 64, kNoRepeat, kNoRepeat},  // PIONEER
+#else  // SEND_PIONEER
+  {NULL, NULL, 64, kNoRepeat, kNoRepeat},  // PIONEER
+#endif  // SEND_PIONEER
+#if SEND_LG
+  {&IRsend::sendLG2, NULL, 28, kNoRepeat, kNoRepeat},  // LG2
+#else  // SEND_LG
+  {NULL, NULL, 28, kNoRepeat, kNoRepeat},  // LG2
+#endif  // SEND_LG
+#if SEND_MWM
+  {NULL, &IRsend::sendMWM, 0, kNoRepeat, kNoRepeat},  // MWM
+#else  // SEND_MWM
+  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // MWM
+#endif  // SEND_MWM
+#if SEND_DAIKIN2
+  {NULL, &IRsend::sendDaikin2, kDaikin2Bits, kNoRepeat,
+   kDaikin2DefaultRepeat},  // DAIKIN2
+#else  // SEND_DAIKIN2
+  {NULL, NULL, kDaikin2Bits, kNoRepeat, kDaikin2DefaultRepeat},  // DAIKIN2
+#endif  // SEND_DAIKIN2
+#if SEND_VESTEL_AC
+  {&IRsend::sendVestelAc, NULL, 56, kNoRepeat, kNoRepeat},  // VESTEL_AC
+#else  // SEND_VESTEL_AC
+  {NULL, NULL, 56, kNoRepeat, kNoRepeat},  // VESTEL_AC
+#endif  // SEND_VESTEL_AC
+#if SEND_TECO
+  {&IRsend::sendTeco, NULL, 35, kNoRepeat, kNoRepeat},  // TECO
+#else  // SEND_TECO
+  {NULL, NULL, 35, kNoRepeat, kNoRepeat},  // TECO
+#endif  // SEND_TECO
+#if SEND_SAMSUNG36
+  {&IRsend::sendSamsung36, NULL, 36, kNoRepeat, kNoRepeat},  // SAMSUNG36
+#else  // SEND_SAMSUNG36
+  {NULL, NULL, 36, kNoRepeat, kNoRepeat},  // SAMSUNG36
+#endif  // SEND_SAMSUNG36
+#if SEND_TCL112AC
+  {NULL, &IRsend::sendTcl112Ac, kTcl112AcBits, kNoRepeat,
+   kTcl112AcDefaultRepeat},  // TCL112AC
+#else  // SEND_TCL112AC
+  {NULL, NULL, kTcl112AcBits, kNoRepeat, kTcl112AcDefaultRepeat},  // TCL112AC
+#endif  // SEND_TCL112AC
+#if SEND_LEGOPF
+  {&IRsend::sendLegoPf, NULL, 16, kNoRepeat, kNoRepeat},  // LEGOPF
+#else  // SEND_LEGOPF
+  {NULL, NULL, 16, kNoRepeat, kNoRepeat},  // LEGOPF
+#endif  // SEND_LEGOPF
+#if SEND_MITSUBISHIHEAVY
+  {NULL, &IRsend::sendMitsubishiHeavy88, kMitsubishiHeavy88Bits, kNoRepeat,
+   kMitsubishiHeavy88MinRepeat},  // MITSUBISHI_HEAVY_88
+#else  // SEND_MITSUBISHIHEAVY
+  {NULL, NULL, kMitsubishiHeavy88Bits, kNoRepeat,
+   kMitsubishiHeavy88MinRepeat},  // MITSUBISHI_HEAVY_88
+#endif  // SEND_MITSUBISHIHEAVY
+#if SEND_MITSUBISHIHEAVY
+  {NULL, &IRsend::sendMitsubishiHeavy152, kMitsubishiHeavy152Bits, kNoRepeat,
+   kMitsubishiHeavy152MinRepeat},  // MITSUBISHI_HEAVY_152
+#else  // SEND_MITSUBISHIHEAVY
+  {NULL, NULL, kMitsubishiHeavy152Bits, kNoRepeat,
+   kMitsubishiHeavy152MinRepeat},  // MITSUBISHI_HEAVY_152
+#endif  // SEND_MITSUBISHIHEAVY
+#if SEND_DAIKIN216
+  {NULL, &IRsend::sendDaikin216, kDaikin216Bits, kNoRepeat,
+   kDaikin216DefaultRepeat},  // DAIKIN216
+#else  // SEND_DAIKIN216
+  {NULL, NULL, kDaikin216Bits, kNoRepeat,
+   kDaikin216DefaultRepeat},  // DAIKIN216
+#endif  // SEND_DAIKIN216
+#if SEND_SHARP_AC
+  {NULL, &IRsend::sendSharpAc, kSharpAcBits, kNoRepeat,
+   kSharpAcDefaultRepeat},  // SHARP_AC
+#else  // SEND_SHARP_AC
+  {NULL, NULL, kSharpAcBits, kNoRepeat, kSharpAcDefaultRepeat},  // SHARP_AC
+#endif  // SEND_SHARP_AC
+#if SEND_GOODWEATHER
+  {&IRsend::sendGoodweather, NULL, 48, kNoRepeat, kNoRepeat},  // GOODWEATHER
+#else  // SEND_GOODWEATHER
+  {NULL, NULL, 48, kNoRepeat, kNoRepeat},  // GOODWEATHER
+#endif  // SEND_GOODWEATHER
+#if SEND_INAX
+  {&IRsend::sendInax, NULL, 24, kSingleRepeat, kNoRepeat},  // INAX
+#else  // SEND_INAX
+  {NULL, NULL, 24, kSingleRepeat, kNoRepeat},  // INAX
+#endif  // SEND_INAX
+#if SEND_DAIKIN160
+  {NULL, &IRsend::sendDaikin160, kDaikin160Bits, kNoRepeat,
+   kDaikin160DefaultRepeat},  // DAIKIN160
+#else  // SEND_DAIKIN160
+  {NULL, NULL, kDaikin160Bits, kNoRepeat,
+   kDaikin160DefaultRepeat},  // DAIKIN160
+#endif  // SEND_DAIKIN160
+#if SEND_NEOCLIMA
+  {NULL, &IRsend::sendNeoclima, kNeoclimaBits, kNoRepeat,
+   kNeoclimaMinRepeat},  // NEOCLIMA
+#else  // SEND_NEOCLIMA
+  {NULL, NULL, kNeoclimaBits, kNoRepeat, kNeoclimaMinRepeat},  // NEOCLIMA
+#endif  // SEND_NEOCLIMA
+#if SEND_DAIKIN176
+  {NULL, &IRsend::sendDaikin176, kDaikin176Bits, kNoRepeat,
+   kDaikin176DefaultRepeat},  // DAIKIN176
+#else  // SEND_DAIKIN176
+  {NULL, NULL, kDaikin176Bits, kNoRepeat,
+   kDaikin176DefaultRepeat},  // DAIKIN176
+#endif  // SEND_DAIKIN176
+#if SEND_DAIKIN128
+  {NULL, &IRsend::sendDaikin128, kDaikin128Bits, kNoRepeat,
+   kDaikin128DefaultRepeat},  // DAIKIN128
+#else  // SEND_DAIKIN128
+  {NULL, NULL, kDaikin128Bits, kNoRepeat,
+   kDaikin128DefaultRepeat},  // DAIKIN128
+#endif  // SEND_DAIKIN128
+#if SEND_AMCOR
+  {NULL, &IRsend::sendAmcor, 64, kSingleRepeat, kAmcorDefaultRepeat},  // AMCOR
+#else  // SEND_AMCOR
+  {NULL, NULL, 64, kSingleRepeat, kAmcorDefaultRepeat},  // AMCOR
+#endif  // SEND_AMCOR
+#if SEND_DAIKIN152
+  {NULL, &IRsend::sendDaikin152, kDaikin152Bits, kNoRepeat,
+   kDaikin152DefaultRepeat},  // DAIKIN152
+#else  // SEND_DAIKIN152
+  {NULL, NULL, kDaikin152Bits, kNoRepeat,
+   kDaikin152DefaultRepeat},  // DAIKIN152
+#endif  // SEND_DAIKIN152
+#if SEND_MITSUBISHI136
+  {NULL, &IRsend::sendMitsubishi136, kMitsubishi136Bits, kNoRepeat,
+   kMitsubishi136MinRepeat},  // MITSUBISHI136
+#else  // SEND_MITSUBISHI136
+  {NULL, NULL, kMitsubishi136Bits, kNoRepeat,
+   kMitsubishi136MinRepeat},  // MITSUBISHI136
+#endif  // SEND_MITSUBISHI136
+#if SEND_MITSUBISHI112
+  {NULL, &IRsend::sendMitsubishi112, kMitsubishi112Bits, kNoRepeat,
+   kMitsubishi112MinRepeat},  // MITSUBISHI112
+#else  // SEND_MITSUBISHI112
+  {NULL, NULL, kMitsubishi112Bits, kNoRepeat,
+   kMitsubishi112MinRepeat},  // MITSUBISHI112
+#endif  // SEND_MITSUBISHI112
+#if SEND_HITACHI_AC424
+  {NULL, &IRsend::sendHitachiAc424, kHitachiAc424Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC424
+#else  // SEND_HITACHI_AC424
+  {NULL, NULL, kHitachiAc424Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC424
+#endif  // SEND_HITACHI_AC424
+#if SEND_SONY
+  {&IRsend::sendSony38, NULL, 20, kSonyMinRepeat + 1, kNoRepeat},  // SONY_38K
+#else  // SEND_SONY
+  {NULL, NULL, 20, kSonyMinRepeat + 1, kNoRepeat},  // SONY_38K
+#endif  // SEND_SONY
+#if SEND_EPSON
+  {&IRsend::sendEpson, NULL, 32, kEpsonMinRepeat, kNoRepeat},  // EPSON
+#else  // SEND_EPSON
+  {NULL, NULL, 32, kEpsonMinRepeat, kNoRepeat},  // EPSON
+#endif  // SEND_EPSON
+#if SEND_SYMPHONY
+  {&IRsend::sendSymphony, NULL, 12, kSymphonyDefaultRepeat,
+   kNoRepeat},  // SYMPHONY
+#else  // SEND_SYMPHONY
+  {NULL, NULL, 12, kSymphonyDefaultRepeat, kNoRepeat},  // SYMPHONY
+#endif  // SEND_SYMPHONY
+#if SEND_HITACHI_AC3
+  {NULL, &IRsend::sendHitachiAc3, kHitachiAc3Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC3
+#else  // SEND_HITACHI_AC3
+  {NULL, NULL, kHitachiAc3Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC3
+#endif  // SEND_HITACHI_AC3
+#if SEND_DAIKIN64
+  {&IRsend::sendDaikin64, NULL, kDaikin64Bits, kNoRepeat,
+   kNoRepeat},  // DAIKIN64
+#else  // SEND_DAIKIN64
+  {NULL, NULL, kDaikin64Bits, kNoRepeat, kNoRepeat},  // DAIKIN64
+#endif  // SEND_DAIKIN64
+#if SEND_AIRWELL
+  {&IRsend::sendAirwell, NULL, 34, kAirwellMinRepeats, kNoRepeat},  // AIRWELL
+#else  // SEND_AIRWELL
+  {NULL, NULL, 34, kAirwellMinRepeats, kNoRepeat},  // AIRWELL
+#endif  // SEND_AIRWELL
+#if SEND_DELONGHI_AC
+  {&IRsend::sendDelonghiAc, NULL, 64, kNoRepeat, kNoRepeat},  // DELONGHI_AC
+#else  // SEND_DELONGHI_AC
+  {NULL, NULL, 64, kNoRepeat, kNoRepeat},  // DELONGHI_AC
+#endif  // SEND_DELONGHI_AC
+#if SEND_DOSHISHA
+  {&IRsend::sendDoshisha, NULL, kDoshishaBits, kNoRepeat,
+   kNoRepeat},  // DOSHISHA
+#else  // SEND_DOSHISHA
+  {NULL, NULL, kDoshishaBits, kNoRepeat, kNoRepeat},  // DOSHISHA
+#endif  // SEND_DOSHISHA
+#if SEND_MULTIBRACKETS
+  {&IRsend::sendMultibrackets, NULL, 8, kSingleRepeat,
+   kNoRepeat},  // MULTIBRACKETS
+#else  // SEND_MULTIBRACKETS
+  {NULL, NULL, 8, kSingleRepeat, kNoRepeat},  // MULTIBRACKETS
+#endif  // SEND_MULTIBRACKETS
+#if SEND_CARRIER_AC40
+  {&IRsend::sendCarrierAC40, NULL, kCarrierAc40Bits, kCarrierAc40MinRepeat,
+   kNoRepeat},  // CARRIER_AC40
+#else  // SEND_CARRIER_AC40
+  {NULL, NULL, kCarrierAc40Bits, kCarrierAc40MinRepeat,
+   kNoRepeat},  // CARRIER_AC40
+#endif  // SEND_CARRIER_AC40
+#if SEND_CARRIER_AC64
+  {&IRsend::sendCarrierAC64, NULL, 64, kNoRepeat, kNoRepeat},  // CARRIER_AC64
+#else  // SEND_CARRIER_AC64
+  {NULL, NULL, 64, kNoRepeat, kNoRepeat},  // CARRIER_AC64
+#endif  // SEND_CARRIER_AC64
+#if SEND_HITACHI_AC344
+  {NULL, &IRsend::sendHitachiAc344, kHitachiAc344Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC344
+#else  // SEND_HITACHI_AC344
+  {NULL, NULL, kHitachiAc344Bits, kNoRepeat,
+   kHitachiAcDefaultRepeat},  // HITACHI_AC344
+#endif  // SEND_HITACHI_AC344
+#if SEND_CORONA_AC
+  {NULL, &IRsend::sendCoronaAc, kCoronaAcBits, kNoRepeat,
+   kNoRepeat},  // CORONA_AC
+#else  // SEND_CORONA_AC
+  {NULL, NULL, kCoronaAcBits, kNoRepeat, kNoRepeat},  // CORONA_AC
+#endif  // SEND_CORONA_AC
+#if SEND_MIDEA24
+  {&IRsend::sendMidea24, NULL, 24, kSingleRepeat, kNoRepeat},  // MIDEA24
+#else  // SEND_MIDEA24
+  {NULL, NULL, 24, kSingleRepeat, kNoRepeat},  // MIDEA24
+#endif  // SEND_MIDEA24
+#if SEND_ZEPEAL
+  {&IRsend::sendZepeal, NULL, 16, kZepealMinRepeat, kNoRepeat},  // ZEPEAL
+#else  // SEND_ZEPEAL
+  {NULL, NULL, 16, kZepealMinRepeat, kNoRepeat},  // ZEPEAL
+#endif  // SEND_ZEPEAL
+#if SEND_SANYO_AC
+  {NULL, &IRsend::sendSanyoAc, kSanyoAcBits, kNoRepeat, kNoRepeat},  // SANYO_AC
+#else  // SEND_SANYO_AC
+  {NULL, NULL, kSanyoAcBits, kNoRepeat, kNoRepeat},  // SANYO_AC
+#endif  // SEND_SANYO_AC
+#if SEND_VOLTAS
+  {NULL, &IRsend::sendVoltas, kVoltasBits, kNoRepeat, kNoRepeat},  // VOLTAS
+#else  // SEND_VOLTAS
+  {NULL, NULL, kVoltasBits, kNoRepeat, kNoRepeat},  // VOLTAS
+#endif  // SEND_VOLTAS
+#if SEND_METZ
+  {&IRsend::sendMetz, NULL, 19, kNoRepeat, kNoRepeat},  // METZ
+#else  // SEND_METZ
+  {NULL, NULL, 19, kNoRepeat, kNoRepeat},  // METZ
+#endif  // SEND_METZ
+#if SEND_TRANSCOLD
+  {&IRsend::sendTranscold, NULL, 48, kNoRepeat, kNoRepeat},  // TRANSCOLD
+#else  // SEND_TRANSCOLD
+  {NULL, NULL, 48, kNoRepeat, kNoRepeat},  // TRANSCOLD
+#endif  // SEND_TRANSCOLD
+#if SEND_TECHNIBEL_AC
+  {&IRsend::sendTechnibelAc, NULL, 56, kNoRepeat, kNoRepeat},  // TECHNIBEL_AC
+#else  // SEND_TECHNIBEL_AC
+  {NULL, NULL, 56, kNoRepeat, kNoRepeat},  // TECHNIBEL_AC
+#endif  // SEND_TECHNIBEL_AC
+};
+const uint16_t kSendTableLength = sizeof(kSendTable) / sizeof(kSendTable[0]);
+
+#endif  // IRSENDTABLE_H_
@@ -4,6 +4,7 @@
 /// @warning If you add or remove an entry in this file, you should run:
 ///   '../tools/generate_irtext_h.sh' to rebuild the `IRtext.h` file.
 
+#include "IRtext.h"
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif  // UNIT_TEST
@@ -14,168 +15,182 @@
 #define PROGMEM  // Pretend we have the PROGMEM macro even if we really don't.
 #endif
 
+// Note: The pointers are `const` too, so they can live in flash rather than
+//       RAM. The strings themselves are left as plain literals, as that lets
+//       the linker share identical strings & common suffixes between them.
+
 // Common
-const PROGMEM char* kUnknownStr = D_STR_UNKNOWN;  ///< "Unknown"
-const PROGMEM char* kProtocolStr = D_STR_PROTOCOL;  ///< "Protocol"
-const PROGMEM char* kPowerStr = D_STR_POWER;  ///< "Power"
-const PROGMEM char* kOnStr = D_STR_ON;  ///< "On"
-const PROGMEM char* kOffStr = D_STR_OFF;  ///< "Off"
-const PROGMEM char* kModeStr = D_STR_MODE;  ///< "Mode"
-const PROGMEM char* kToggleStr = D_STR_TOGGLE;  ///< "Toggle"
-const PROGMEM char* kTurboStr = D_STR_TURBO;  ///< "Turbo"
-const PROGMEM char* kSuperStr = D_STR_SUPER;  ///< "Super"
-const PROGMEM char* kSleepStr = D_STR_SLEEP;  ///< "Sleep"
-const PROGMEM char* kLightStr = D_STR_LIGHT;  ///< "Light"
-const PROGMEM char* kPowerfulStr = D_STR_POWERFUL;  ///< "Powerful"
-const PROGMEM char* kQuietStr = D_STR_QUIET;  ///< "Quiet"
-const PROGMEM char* kEconoStr = D_STR_ECONO;  ///< "Econo"
-const PROGMEM char* kSwingStr = D_STR_SWING;  ///< "Swing"
-const PROGMEM char* kSwingHStr = D_STR_SWINGH;  ///< "SwingH"
-const PROGMEM char* kSwingVStr = D_STR_SWINGV;  ///< "SwingV"
-const PROGMEM char* kBeepStr = D_STR_BEEP;  ///< "Beep"
-const PROGMEM char* kZoneFollowStr = D_STR_ZONEFOLLOW;  ///< "Zone Follow"
-const PROGMEM char* kFixedStr = D_STR_FIXED;  ///< "Fixed"
-const PROGMEM char* kMouldStr = D_STR_MOULD;  ///< "Mould"
-const PROGMEM char* kCleanStr = D_STR_CLEAN;  ///< "Clean"
-const PROGMEM char* kPurifyStr = D_STR_PURIFY;  ///< "Purify"
-const PROGMEM char* kTimerStr = D_STR_TIMER;  ///< "Timer"
-const PROGMEM char* kOnTimerStr = D_STR_ONTIMER;  ///< "OnTimer"
-const PROGMEM char* kOffTimerStr = D_STR_OFFTIMER;  ///< "OffTimer"
-const PROGMEM char* kClockStr = D_STR_CLOCK;  ///< "Clock"
-const PROGMEM char* kCommandStr = D_STR_COMMAND;  ///< "Command"
-const PROGMEM char* kXFanStr = D_STR_XFAN;  ///< "XFan"
-const PROGMEM char* kHealthStr = D_STR_HEALTH;  ///< "Health"
-const PROGMEM char* kModelStr = D_STR_MODEL;  ///< "Model"
-const PROGMEM char* kTempStr = D_STR_TEMP;  ///< "Temp"
-const PROGMEM char* kIFeelStr = D_STR_IFEEL;  ///< "IFeel"
-const PROGMEM char* kHumidStr = D_STR_HUMID;  ///< "Humid"
-const PROGMEM char* kSaveStr = D_STR_SAVE;  ///< "Save"
-const PROGMEM char* kEyeStr = D_STR_EYE;  ///< "Eye"
-const PROGMEM char* kFollowStr = D_STR_FOLLOW;  ///< "Follow"
-const PROGMEM char* kIonStr = D_STR_ION;  ///< "Ion"
-const PROGMEM char* kFreshStr = D_STR_FRESH;  ///< "Fresh"
-const PROGMEM char* kHoldStr = D_STR_HOLD;  ///< "Hold"
-const PROGMEM char* kButtonStr = D_STR_BUTTON;  ///< "Button"
-const PROGMEM char* k8CHeatStr = D_STR_8C_HEAT;  ///< "8CHeat"
-const PROGMEM char* kNightStr = D_STR_NIGHT;  ///< "Night"
-const PROGMEM char* kSilentStr = D_STR_SILENT;  ///< "Silent"
-const PROGMEM char* kFilterStr = D_STR_FILTER;  ///< "Filter"
-const PROGMEM char* k3DStr = D_STR_3D;  ///< "3D"
-const PROGMEM char* kCelsiusStr = D_STR_CELSIUS;  ///< "Celsius"
-const PROGMEM char* kTempUpStr = D_STR_TEMPUP;  ///< "Temp Up"
-const PROGMEM char* kTempDownStr = D_STR_TEMPDOWN;  ///< "Temp Down"
-const PROGMEM char* kStartStr = D_STR_START;  ///< "Start"
-const PROGMEM char* kStopStr = D_STR_STOP;  ///< "Stop"
-const PROGMEM char* kMoveStr = D_STR_MOVE;  ///< "Move"
-const PROGMEM char* kSetStr = D_STR_SET;  ///< "Set"
-const PROGMEM char* kCancelStr = D_STR_CANCEL;  ///< "Cancel"
-const PROGMEM char* kUpStr = D_STR_UP;  ///< "Up"
-const PROGMEM char* kDownStr = D_STR_DOWN;  ///< "Down"
-const PROGMEM char* kChangeStr = D_STR_CHANGE;  ///< "Change"
-const PROGMEM char* kComfortStr = D_STR_COMFORT;  ///< "Comfort"
-const PROGMEM char* kSensorStr = D_STR_SENSOR;  ///< "Sensor"
-const PROGMEM char* kWeeklyTimerStr = D_STR_WEEKLYTIMER;  ///< "WeeklyTimer"
-const PROGMEM char* kWifiStr = D_STR_WIFI;  ///< "Wifi"
-const PROGMEM char* kLastStr = D_STR_LAST;  ///< "Last"
-const PROGMEM char* kFastStr = D_STR_FAST;  ///< "Fast"
-const PROGMEM char* kSlowStr = D_STR_SLOW;  ///< "Slow"
-const PROGMEM char* kAirFlowStr = D_STR_AIRFLOW;  ///< "Air Flow"
-const PROGMEM char* kStepStr = D_STR_STEP;  ///< "Step"
-const PROGMEM char* kNAStr = D_STR_NA;  ///< "N/A"
-const PROGMEM char* kInsideStr = D_STR_INSIDE;  ///< "Inside"
-const PROGMEM char* kOutsideStr = D_STR_OUTSIDE;  ///< "Outside"
-const PROGMEM char* kLoudStr = D_STR_LOUD;  ///< "Loud"
-const PROGMEM char* kLowerStr = D_STR_LOWER;  ///< "Lower"
-const PROGMEM char* kUpperStr = D_STR_UPPER;  ///< "Upper"
-const PROGMEM char* kBreezeStr = D_STR_BREEZE;  ///< "Breeze"
-const PROGMEM char* kCirculateStr = D_STR_CIRCULATE;  ///< "Circulate"
-const PROGMEM char* kCeilingStr = D_STR_CEILING;  ///< "Ceiling"
-const PROGMEM char* kWallStr = D_STR_WALL;  ///< "Wall"
-const PROGMEM char* kRoomStr = D_STR_ROOM;  ///< "Room"
-const PROGMEM char* k6thSenseStr = D_STR_6THSENSE;  ///< "6th Sense"
+const PROGMEM char* const kUnknownStr = D_STR_UNKNOWN;  ///< "Unknown"
+const PROGMEM char* const kProtocolStr = D_STR_PROTOCOL;  ///< "Protocol"
+const PROGMEM char* const kPowerStr = D_STR_POWER;  ///< "Power"
+const PROGMEM char* const kOnStr = D_STR_ON;  ///< "On"
+const PROGMEM char* const kOffStr = D_STR_OFF;  ///< "Off"
+const PROGMEM char* const kModeStr = D_STR_MODE;  ///< "Mode"
+const PROGMEM char* const kToggleStr = D_STR_TOGGLE;  ///< "Toggle"
+const PROGMEM char* const kTurboStr = D_STR_TURBO;  ///< "Turbo"
+const PROGMEM char* const kSuperStr = D_STR_SUPER;  ///< "Super"
+const PROGMEM char* const kSleepStr = D_STR_SLEEP;  ///< "Sleep"
+const PROGMEM char* const kLightStr = D_STR_LIGHT;  ///< "Light"
+const PROGMEM char* const kPowerfulStr = D_STR_POWERFUL;  ///< "Powerful"
+const PROGMEM char* const kQuietStr = D_STR_QUIET;  ///< "Quiet"
+const PROGMEM char* const kEconoStr = D_STR_ECONO;  ///< "Econo"
+const PROGMEM char* const kSwingStr = D_STR_SWING;  ///< "Swing"
+const PROGMEM char* const kSwingHStr = D_STR_SWINGH;  ///< "SwingH"
+const PROGMEM char* const kSwingVStr = D_STR_SWINGV;  ///< "SwingV"
+const PROGMEM char* const kBeepStr = D_STR_BEEP;  ///< "Beep"
+const PROGMEM char* const kZoneFollowStr = D_STR_ZONEFOLLOW;  ///< "Zone Follow"
+const PROGMEM char* const kFixedStr = D_STR_FIXED;  ///< "Fixed"
+const PROGMEM char* const kMouldStr = D_STR_MOULD;  ///< "Mould"
+const PROGMEM char* const kCleanStr = D_STR_CLEAN;  ///< "Clean"
+const PROGMEM char* const kPurifyStr = D_STR_PURIFY;  ///< "Purify"
+const PROGMEM char* const kTimerStr = D_STR_TIMER;  ///< "Timer"
+const PROGMEM char* const kOnTimerStr = D_STR_ONTIMER;  ///< "OnTimer"
+const PROGMEM char* const kOffTimerStr = D_STR_OFFTIMER;  ///< "OffTimer"
+const PROGMEM char* const kClockStr = D_STR_CLOCK;  ///< "Clock"
+const PROGMEM char* const kCommandStr = D_STR_COMMAND;  ///< "Command"
+const PROGMEM char* const kXFanStr = D_STR_XFAN;  ///< "XFan"
+const PROGMEM char* const kHealthStr = D_STR_HEALTH;  ///< "Health"
+const PROGMEM char* const kModelStr = D_STR_MODEL;  ///< "Model"
+const PROGMEM char* const kTempStr = D_STR_TEMP;  ///< "Temp"
+const PROGMEM char* const kIFeelStr = D_STR_IFEEL;  ///< "IFeel"
+const PROGMEM char* const kHumidStr = D_STR_HUMID;  ///< "Humid"
+const PROGMEM char* const kSaveStr = D_STR_SAVE;  ///< "Save"
+const PROGMEM char* const kEyeStr = D_STR_EYE;  ///< "Eye"
+const PROGMEM char* const kFollowStr = D_STR_FOLLOW;  ///< "Follow"
+const PROGMEM char* const kIonStr = D_STR_ION;  ///< "Ion"
+const PROGMEM char* const kFreshStr = D_STR_FRESH;  ///< "Fresh"
+const PROGMEM char* const kHoldStr = D_STR_HOLD;  ///< "Hold"
+const PROGMEM char* const kButtonStr = D_STR_BUTTON;  ///< "Button"
+const PROGMEM char* const k8CHeatStr = D_STR_8C_HEAT;  ///< "8CHeat"
+const PROGMEM char* const kNightStr = D_STR_NIGHT;  ///< "Night"
+const PROGMEM char* const kSilentStr = D_STR_SILENT;  ///< "Silent"
+const PROGMEM char* const kFilterStr = D_STR_FILTER;  ///< "Filter"
+const PROGMEM char* const k3DStr = D_STR_3D;  ///< "3D"
+const PROGMEM char* const kCelsiusStr = D_STR_CELSIUS;  ///< "Celsius"
+const PROGMEM char* const kTempUpStr = D_STR_TEMPUP;  ///< "Temp Up"
+const PROGMEM char* const kTempDownStr = D_STR_TEMPDOWN;  ///< "Temp Down"
+const PROGMEM char* const kStartStr = D_STR_START;  ///< "Start"
+const PROGMEM char* const kStopStr = D_STR_STOP;  ///< "Stop"
+const PROGMEM char* const kMoveStr = D_STR_MOVE;  ///< "Move"
+const PROGMEM char* const kSetStr = D_STR_SET;  ///< "Set"
+const PROGMEM char* const kCancelStr = D_STR_CANCEL;  ///< "Cancel"
+const PROGMEM char* const kUpStr = D_STR_UP;  ///< "Up"
+const PROGMEM char* const kDownStr = D_STR_DOWN;  ///< "Down"
+const PROGMEM char* const kChangeStr = D_STR_CHANGE;  ///< "Change"
+const PROGMEM char* const kComfortStr = D_STR_COMFORT;  ///< "Comfort"
+const PROGMEM char* const kSensorStr = D_STR_SENSOR;  ///< "Sensor"
+const PROGMEM char* const kWeeklyTimerStr = D_STR_WEEKLYTIMER;  ///<
+///< "WeeklyTimer"
+const PROGMEM char* const kWifiStr = D_STR_WIFI;  ///< "Wifi"
+const PROGMEM char* const kLastStr = D_STR_LAST;  ///< "Last"
+const PROGMEM char* const kFastStr = D_STR_FAST;  ///< "Fast"
+const PROGMEM char* const kSlowStr = D_STR_SLOW;  ///< "Slow"
+const PROGMEM char* const kAirFlowStr = D_STR_AIRFLOW;  ///< "Air Flow"
+const PROGMEM char* const kStepStr = D_STR_STEP;  ///< "Step"
+const PROGMEM char* const kNAStr = D_STR_NA;  ///< "N/A"
+const PROGMEM char* const kInsideStr = D_STR_INSIDE;  ///< "Inside"
+const PROGMEM char* const kOutsideStr = D_STR_OUTSIDE;  ///< "Outside"
+const PROGMEM char* const kLoudStr = D_STR_LOUD;  ///< "Loud"
+const PROGMEM char* const kLowerStr = D_STR_LOWER;  ///< "Lower"
+const PROGMEM char* const kUpperStr = D_STR_UPPER;  ///< "Upper"
+const PROGMEM char* const kBreezeStr = D_STR_BREEZE;  ///< "Breeze"
+const PROGMEM char* const kCirculateStr = D_STR_CIRCULATE;  ///< "Circulate"
+const PROGMEM char* const kCeilingStr = D_STR_CEILING;  ///< "Ceiling"
+const PROGMEM char* const kWallStr = D_STR_WALL;  ///< "Wall"
+const PROGMEM char* const kRoomStr = D_STR_ROOM;  ///< "Room"
+const PROGMEM char* const k6thSenseStr = D_STR_6THSENSE;  ///< "6th Sense"
 
-const PROGMEM char* kAutoStr = D_STR_AUTO;  ///< "Auto"
-const PROGMEM char* kAutomaticStr = D_STR_AUTOMATIC;  ///< "Automatic"
-const PROGMEM char* kManualStr = D_STR_MANUAL;  ///< "Manual"
-const PROGMEM char* kCoolStr = D_STR_COOL;  ///< "Cool"
-const PROGMEM char* kHeatStr = D_STR_HEAT;  ///< "Heat"
-const PROGMEM char* kFanStr = D_STR_FAN;  ///< "Fan"
-const PROGMEM char* kDryStr = D_STR_DRY;  ///< "Dry"
-const PROGMEM char* kFanOnlyStr = D_STR_FANONLY;  ///< "fan_only"
+const PROGMEM char* const kAutoStr = D_STR_AUTO;  ///< "Auto"
+const PROGMEM char* const kAutomaticStr = D_STR_AUTOMATIC;  ///< "Automatic"
+const PROGMEM char* const kManualStr = D_STR_MANUAL;  ///< "Manual"
+const PROGMEM char* const kCoolStr = D_STR_COOL;  ///< "Cool"
+const PROGMEM char* const kHeatStr = D_STR_HEAT;  ///< "Heat"
+const PROGMEM char* const kFanStr = D_STR_FAN;  ///< "Fan"
+const PROGMEM char* const kDryStr = D_STR_DRY;  ///< "Dry"
+const PROGMEM char* const kFanOnlyStr = D_STR_FANONLY;  ///< "fan_only"
 
-const PROGMEM char* kMaxStr = D_STR_MAX;  ///< "Max"
-const PROGMEM char* kMaximumStr = D_STR_MAXIMUM;  ///< "Maximum"
-const PROGMEM char* kMinStr = D_STR_MIN;  ///< "Min"
-const PROGMEM char* kMinimumStr = D_STR_MINIMUM;  ///< "Minimum"
-const PROGMEM char* kMedStr = D_STR_MED;  ///< "Med"
-const PROGMEM char* kMediumStr = D_STR_MEDIUM;  ///< "Medium"
+const PROGMEM char* const kMaxStr = D_STR_MAX;  ///< "Max"
+const PROGMEM char* const kMaximumStr = D_STR_MAXIMUM;  ///< "Maximum"
+const PROGMEM char* const kMinStr = D_STR_MIN;  ///< "Min"
+const PROGMEM char* const kMinimumStr = D_STR_MINIMUM;  ///< "Minimum"
+const PROGMEM char* const kMedStr = D_STR_MED;  ///< "Med"
+const PROGMEM char* const kMediumStr = D_STR_MEDIUM;  ///< "Medium"
 
-const PROGMEM char* kHighestStr = D_STR_HIGHEST;  ///< "Highest"
-const PROGMEM char* kHighStr = D_STR_HIGH;  ///< "High"
-const PROGMEM char* kHiStr = D_STR_HI;  ///< "Hi"
-const PROGMEM char* kMidStr = D_STR_MID;  ///< "Mid"
-const PROGMEM char* kMiddleStr = D_STR_MIDDLE;  ///< "Middle"
-const PROGMEM char* kLowStr = D_STR_LOW;  ///< "Low"
-const PROGMEM char* kLoStr = D_STR_LO;  ///< "Lo"
-const PROGMEM char* kLowestStr = D_STR_LOWEST;  ///< "Lowest"
-const PROGMEM char* kMaxRightStr = D_STR_MAXRIGHT;  ///< "Max Right"
-const PROGMEM char* kRightMaxStr = D_STR_RIGHTMAX_NOSPACE;  ///< "RightMax"
-const PROGMEM char* kRightStr = D_STR_RIGHT;  ///< "Right"
-const PROGMEM char* kLeftStr = D_STR_LEFT;  ///< "Left"
-const PROGMEM char* kMaxLeftStr = D_STR_MAXLEFT;  ///< "Max Left"
-const PROGMEM char* kLeftMaxStr = D_STR_LEFTMAX_NOSPACE;  ///< "LeftMax"
-const PROGMEM char* kWideStr = D_STR_WIDE;  ///< "Wide"
-const PROGMEM char* kCentreStr = D_STR_CENTRE;  ///< "Centre"
-const PROGMEM char* kTopStr = D_STR_TOP;  ///< "Top"
-const PROGMEM char* kBottomStr = D_STR_BOTTOM;  ///< "Bottom"
+const PROGMEM char* const kHighestStr = D_STR_HIGHEST;  ///< "Highest"
+const PROGMEM char* const kHighStr = D_STR_HIGH;  ///< "High"
+const PROGMEM char* const kHiStr = D_STR_HI;  ///< "Hi"
+const PROGMEM char* const kMidStr = D_STR_MID;  ///< "Mid"
+const PROGMEM char* const kMiddleStr = D_STR_MIDDLE;  ///< "Middle"
+const PROGMEM char* const kLowStr = D_STR_LOW;  ///< "Low"
+const PROGMEM char* const kLoStr = D_STR_LO;  ///< "Lo"
+const PROGMEM char* const kLowestStr = D_STR_LOWEST;  ///< "Lowest"
+const PROGMEM char* const kMaxRightStr = D_STR_MAXRIGHT;  ///< "Max Right"
+const PROGMEM char* const kRightMaxStr = D_STR_RIGHTMAX_NOSPACE;  ///<
+///< "RightMax"
+const PROGMEM char* const kRightStr = D_STR_RIGHT;  ///< "Right"
+const PROGMEM char* const kLeftStr = D_STR_LEFT;  ///< "Left"
+const PROGMEM char* const kMaxLeftStr = D_STR_MAXLEFT;  ///< "Max Left"
+const PROGMEM char* const kLeftMaxStr = D_STR_LEFTMAX_NOSPACE;  ///< "LeftMax"
+const PROGMEM char* const kWideStr = D_STR_WIDE;  ///< "Wide"
+const PROGMEM char* const kCentreStr = D_STR_CENTRE;  ///< "Centre"
+const PROGMEM char* const kTopStr = D_STR_TOP;  ///< "Top"
+const PROGMEM char* const kBottomStr = D_STR_BOTTOM;  ///< "Bottom"
 
 // Compound words/phrases/descriptions from pre-defined words.
-const PROGMEM char* kEconoToggleStr = D_STR_ECONOTOGGLE;  ///< "Econo Toggle"
-const PROGMEM char* kEyeAutoStr = D_STR_EYEAUTO;  ///< "Eye Auto"
-const PROGMEM char* kLightToggleStr = D_STR_LIGHTTOGGLE;  ///< "Light Toggle"
-const PROGMEM char* kOutsideQuietStr = D_STR_OUTSIDEQUIET;  ///< "Outside Quiet"
-const PROGMEM char* kPowerToggleStr = D_STR_POWERTOGGLE;  ///< "Power Toggle"
-const PROGMEM char* kPowerButtonStr = D_STR_POWERBUTTON;  ///< "Power Button"
-const PROGMEM char* kPreviousPowerStr = D_STR_PREVIOUSPOWER;  ///<
+const PROGMEM char* const kEconoToggleStr = D_STR_ECONOTOGGLE;  ///<
+///< "Econo Toggle"
+const PROGMEM char* const kEyeAutoStr = D_STR_EYEAUTO;  ///< "Eye Auto"
+const PROGMEM char* const kLightToggleStr = D_STR_LIGHTTOGGLE;  ///<
+///< "Light Toggle"
+const PROGMEM char* const kOutsideQuietStr = D_STR_OUTSIDEQUIET;  ///<
+///< "Outside Quiet"
+const PROGMEM char* const kPowerToggleStr = D_STR_POWERTOGGLE;  ///<
+///< "Power Toggle"
+const PROGMEM char* const kPowerButtonStr = D_STR_POWERBUTTON;  ///<
+///< "Power Button"
+const PROGMEM char* const kPreviousPowerStr = D_STR_PREVIOUSPOWER;  ///<
 ///< "Previous Power"
-const PROGMEM char* kDisplayTempStr = D_STR_DISPLAYTEMP;  ///< "Display Temp"
-const PROGMEM char* kSensorTempStr = D_STR_SENSORTEMP;  ///< "Sensor Temp"
-const PROGMEM char* kSleepTimerStr = D_STR_SLEEP_TIMER;  ///< "Sleep Timer"
-const PROGMEM char* kSwingVModeStr = D_STR_SWINGVMODE;  ///< "Swing(V) Mode"
-const PROGMEM char* kSwingVToggleStr = D_STR_SWINGVTOGGLE;  ///<
+const PROGMEM char* const kDisplayTempStr = D_STR_DISPLAYTEMP;  ///<
+///< "Display Temp"
+const PROGMEM char* const kSensorTempStr = D_STR_SENSORTEMP;  ///< "Sensor Temp"
+const PROGMEM char* const kSleepTimerStr = D_STR_SLEEP_TIMER;  ///<
+///< "Sleep Timer"
+const PROGMEM char* const kSwingVModeStr = D_STR_SWINGVMODE;  ///<
+///< "Swing(V) Mode"
+const PROGMEM char* const kSwingVToggleStr = D_STR_SWINGVTOGGLE;  ///<
 ///< "Swing(V) Toggle"
 
 // Separators
 char kTimeSep = D_CHR_TIME_SEP;  ///< ':'
-const PROGMEM char* kSpaceLBraceStr = D_STR_SPACELBRACE;  ///< " ("
-const PROGMEM char* kCommaSpaceStr = D_STR_COMMASPACE;  ///< ", "
-const PROGMEM char* kColonSpaceStr = D_STR_COLONSPACE;  ///< ": "
+const PROGMEM char* const kSpaceLBraceStr = D_STR_SPACELBRACE;  ///< " ("
+const PROGMEM char* const kCommaSpaceStr = D_STR_COMMASPACE;  ///< ", "
+const PROGMEM char* const kColonSpaceStr = D_STR_COLONSPACE;  ///< ": "
 
 // IRutils
 //  - Time
-const PROGMEM char* kDayStr = D_STR_DAY;  ///< "Day"
-const PROGMEM char* kDaysStr = D_STR_DAYS;  ///< "Days"
-const PROGMEM char* kHourStr = D_STR_HOUR;  ///< "Hour"
-const PROGMEM char* kHoursStr = D_STR_HOURS;  ///< "Hours"
-const PROGMEM char* kMinuteStr = D_STR_MINUTE;  ///< "Minute"
-const PROGMEM char* kMinutesStr = D_STR_MINUTES;  ///< "Minutes"
-const PROGMEM char* kSecondStr = D_STR_SECOND;  ///< "Second"
-const PROGMEM char* kSecondsStr = D_STR_SECONDS;  ///< "Seconds"
-const PROGMEM char* kNowStr = D_STR_NOW;  ///< "Now"
-const PROGMEM char* kThreeLetterDayOfWeekStr = D_STR_THREELETTERDAYS;  ///<
-///< "SunMonTueWedThuFriSat"
-const PROGMEM char* kYesStr = D_STR_YES;  ///< "Yes"
-const PROGMEM char* kNoStr = D_STR_NO;  ///< "No"
-const PROGMEM char* kTrueStr = D_STR_TRUE;  ///< "True"
-const PROGMEM char* kFalseStr = D_STR_FALSE;  ///< "False"
+const PROGMEM char* const kDayStr = D_STR_DAY;  ///< "Day"
+const PROGMEM char* const kDaysStr = D_STR_DAYS;  ///< "Days"
+const PROGMEM char* const kHourStr = D_STR_HOUR;  ///< "Hour"
+const PROGMEM char* const kHoursStr = D_STR_HOURS;  ///< "Hours"
+const PROGMEM char* const kMinuteStr = D_STR_MINUTE;  ///< "Minute"
+const PROGMEM char* const kMinutesStr = D_STR_MINUTES;  ///< "Minutes"
+const PROGMEM char* const kSecondStr = D_STR_SECOND;  ///< "Second"
+const PROGMEM char* const kSecondsStr = D_STR_SECONDS;  ///< "Seconds"
+const PROGMEM char* const kNowStr = D_STR_NOW;  ///< "Now"
+const PROGMEM char* const kThreeLetterDayOfWeekStr =
+    D_STR_THREELETTERDAYS;  ///< "SunMonTueWedThuFriSat"
+const PROGMEM char* const kYesStr = D_STR_YES;  ///< "Yes"
+const PROGMEM char* const kNoStr = D_STR_NO;  ///< "No"
+const PROGMEM char* const kTrueStr = D_STR_TRUE;  ///< "True"
+const PROGMEM char* const kFalseStr = D_STR_FALSE;  ///< "False"
 
-const PROGMEM char* kRepeatStr = D_STR_REPEAT;  ///< "Repeat"
-const PROGMEM char* kCodeStr = D_STR_CODE;  ///< "Code"
-const PROGMEM char* kBitsStr = D_STR_BITS;  ///< "Bits"
+const PROGMEM char* const kRepeatStr = D_STR_REPEAT;  ///< "Repeat"
+const PROGMEM char* const kCodeStr = D_STR_CODE;  ///< "Code"
+const PROGMEM char* const kBitsStr = D_STR_BITS;  ///< "Bits"
 
 // Protocol Names
 // Needs to be in decode_type_t order.
-const PROGMEM char *kAllProtocolNamesStr =
+const PROGMEM char* const kAllProtocolNamesStr =
     D_STR_UNUSED "\x0"
     D_STR_RC5 "\x0"
     D_STR_RC6 "\x0"
@@ -1,5 +1,5 @@
 // Copyright 2019 - David Conran (@crankyoldgit)
-// This header file is to be included in files **other than** 'IRtext.cpp'.
+// This header file is to be included in any file that uses the shared text.
 //
 // WARNING: Do not edit this file! This file is automatically generated by
 //          'tools/generate_irtext_h.sh'.
@@ -13,148 +13,148 @@
 // This means there is only one copy of the character/string/text etc.
 
 extern char kTimeSep;
-extern const char* k3DStr;
-extern const char* k6thSenseStr;
-extern const char* k8CHeatStr;
-extern const char* kAirFlowStr;
-extern const char *kAllProtocolNamesStr;
-extern const char* kAutomaticStr;
-extern const char* kAutoStr;
-extern const char* kBeepStr;
-extern const char* kBitsStr;
-extern const char* kBottomStr;
-extern const char* kBreezeStr;
-extern const char* kButtonStr;
-extern const char* kCancelStr;
-extern const char* kCeilingStr;
-extern const char* kCelsiusStr;
-extern const char* kCentreStr;
-extern const char* kChangeStr;
-extern const char* kCirculateStr;
-extern const char* kCleanStr;
-extern const char* kClockStr;
-extern const char* kCodeStr;
-extern const char* kColonSpaceStr;
-extern const char* kComfortStr;
-extern const char* kCommandStr;
-extern const char* kCommaSpaceStr;
-extern const char* kCoolStr;
-extern const char* kDaysStr;
-extern const char* kDayStr;
-extern const char* kDisplayTempStr;
-extern const char* kDownStr;
-extern const char* kDryStr;
-extern const char* kEconoStr;
-extern const char* kEconoToggleStr;
-extern const char* kEyeAutoStr;
-extern const char* kEyeStr;
-extern const char* kFalseStr;
-extern const char* kFanOnlyStr;
-extern const char* kFanStr;
-extern const char* kFastStr;
-extern const char* kFilterStr;
-extern const char* kFixedStr;
-extern const char* kFollowStr;
-extern const char* kFreshStr;
-extern const char* kHealthStr;
-extern const char* kHeatStr;
-extern const char* kHighestStr;
-extern const char* kHighStr;
-extern const char* kHiStr;
-extern const char* kHoldStr;
-extern const char* kHoursStr;
-extern const char* kHourStr;
-extern const char* kHumidStr;
-extern const char* kIFeelStr;
-extern const char* kInsideStr;
-extern const char* kIonStr;
-extern const char* kLastStr;
-extern const char* kLeftMaxStr;
-extern const char* kLeftStr;
-extern const char* kLightStr;
-extern const char* kLightToggleStr;
-extern const char* kLoStr;
-extern const char* kLoudStr;
-extern const char* kLowerStr;
-extern const char* kLowestStr;
-extern const char* kLowStr;
-extern const char* kManualStr;
-extern const char* kMaximumStr;
-extern const char* kMaxLeftStr;
-extern const char* kMaxRightStr;
-extern const char* kMaxStr;
-extern const char* kMediumStr;
-extern const char* kMedStr;
-extern const char* kMiddleStr;
-extern const char* kMidStr;
-extern const char* kMinimumStr;
-extern const char* kMinStr;
-extern const char* kMinutesStr;
-extern const char* kMinuteStr;
-extern const char* kModelStr;
-extern const char* kModeStr;
-extern const char* kMouldStr;
-extern const char* kMoveStr;
-extern const char* kNAStr;
-extern const char* kNightStr;
-extern const char* kNoStr;
-extern const char* kNowStr;
-extern const char* kOffStr;
-extern const char* kOffTimerStr;
-extern const char* kOnStr;
-extern const char* kOnTimerStr;
-extern const char* kOutsideQuietStr;
-extern const char* kOutsideStr;
-extern const char* kPowerButtonStr;
-extern const char* kPowerfulStr;
-extern const char* kPowerStr;
-extern const char* kPowerToggleStr;
-extern const char* kPreviousPowerStr;
-extern const char* kProtocolStr;
-extern const char* kPurifyStr;
-extern const char* kQuietStr;
-extern const char* kRepeatStr;
-extern const char* kRightMaxStr;
-extern const char* kRightStr;
-extern const char* kRoomStr;
-extern const char* kSaveStr;
-extern const char* kSecondsStr;
-extern const char* kSecondStr;
-extern const char* kSensorStr;
-extern const char* kSensorTempStr;
-extern const char* kSetStr;
-extern const char* kSilentStr;
-extern const char* kSleepStr;
-extern const char* kSleepTimerStr;
-extern const char* kSlowStr;
-extern const char* kSpaceLBraceStr;
-extern const char* kStartStr;
-extern const char* kStepStr;
-extern const char* kStopStr;
-extern const char* kSuperStr;
-extern const char* kSwingHStr;
-extern const char* kSwingStr;
-extern const char* kSwingVModeStr;
-extern const char* kSwingVStr;
-extern const char* kSwingVToggleStr;
-extern const char* kTempDownStr;
-extern const char* kTempStr;
-extern const char* kTempUpStr;
-extern const char* kThreeLetterDayOfWeekStr;
-extern const char* kTimerStr;
-extern const char* kToggleStr;
-extern const char* kTopStr;
-extern const char* kTrueStr;
-extern const char* kTurboStr;
-extern const char* kUnknownStr;
-extern const char* kUpperStr;
-extern const char* kUpStr;
-extern const char* kWallStr;
-extern const char* kWeeklyTimerStr;
-extern const char* kWideStr;
-extern const char* kWifiStr;
-extern const char* kXFanStr;
-extern const char* kYesStr;
-extern const char* kZoneFollowStr;
+extern const char* const k3DStr;
+extern const char* const k6thSenseStr;
+extern const char* const k8CHeatStr;
+extern const char* const kAirFlowStr;
+extern const char* const kAllProtocolNamesStr;
+extern const char* const kAutoStr;
+extern const char* const kAutomaticStr;
+extern const char* const kBeepStr;
+extern const char* const kBitsStr;
+extern const char* const kBottomStr;
+extern const char* const kBreezeStr;
+extern const char* const kButtonStr;
+extern const char* const kCancelStr;
+extern const char* const kCeilingStr;
+extern const char* const kCelsiusStr;
+extern const char* const kCentreStr;
+extern const char* const kChangeStr;
+extern const char* const kCirculateStr;
+extern const char* const kCleanStr;
+extern const char* const kClockStr;
+extern const char* const kCodeStr;
+extern const char* const kColonSpaceStr;
+extern const char* const kComfortStr;
+extern const char* const kCommaSpaceStr;
+extern const char* const kCommandStr;
+extern const char* const kCoolStr;
+extern const char* const kDayStr;
+extern const char* const kDaysStr;
+extern const char* const kDisplayTempStr;
+extern const char* const kDownStr;
+extern const char* const kDryStr;
+extern const char* const kEconoStr;
+extern const char* const kEconoToggleStr;
+extern const char* const kEyeAutoStr;
+extern const char* const kEyeStr;
+extern const char* const kFalseStr;
+extern const char* const kFanOnlyStr;
+extern const char* const kFanStr;
+extern const char* const kFastStr;
+extern const char* const kFilterStr;
+extern const char* const kFixedStr;
+extern const char* const kFollowStr;
+extern const char* const kFreshStr;
+extern const char* const kHealthStr;
+extern const char* const kHeatStr;
+extern const char* const kHiStr;
+extern const char* const kHighStr;
+extern const char* const kHighestStr;
+extern const char* const kHoldStr;
+extern const char* const kHourStr;
+extern const char* const kHoursStr;
+extern const char* const kHumidStr;
+extern const char* const kIFeelStr;
+extern const char* const kInsideStr;
+extern const char* const kIonStr;
+extern const char* const kLastStr;
+extern const char* const kLeftMaxStr;
+extern const char* const kLeftStr;
+extern const char* const kLightStr;
+extern const char* const kLightToggleStr;
+extern const char* const kLoStr;
+extern const char* const kLoudStr;
+extern const char* const kLowStr;
+extern const char* const kLowerStr;
+extern const char* const kLowestStr;
+extern const char* const kManualStr;
+extern const char* const kMaxLeftStr;
+extern const char* const kMaxRightStr;
+extern const char* const kMaxStr;
+extern const char* const kMaximumStr;
+extern const char* const kMedStr;
+extern const char* const kMediumStr;
+extern const char* const kMidStr;
+extern const char* const kMiddleStr;
+extern const char* const kMinStr;
+extern const char* const kMinimumStr;
+extern const char* const kMinuteStr;
+extern const char* const kMinutesStr;
+extern const char* const kModeStr;
+extern const char* const kModelStr;
+extern const char* const kMouldStr;
+extern const char* const kMoveStr;
+extern const char* const kNAStr;
+extern const char* const kNightStr;
+extern const char* const kNoStr;
+extern const char* const kNowStr;
+extern const char* const kOffStr;
+extern const char* const kOffTimerStr;
+extern const char* const kOnStr;
+extern const char* const kOnTimerStr;
+extern const char* const kOutsideQuietStr;
+extern const char* const kOutsideStr;
+extern const char* const kPowerButtonStr;
+extern const char* const kPowerStr;
+extern const char* const kPowerToggleStr;
+extern const char* const kPowerfulStr;
+extern const char* const kPreviousPowerStr;
+extern const char* const kProtocolStr;
+extern const char* const kPurifyStr;
+extern const char* const kQuietStr;
+extern const char* const kRepeatStr;
+extern const char* const kRightMaxStr;
+extern const char* const kRightStr;
+extern const char* const kRoomStr;
+extern const char* const kSaveStr;
+extern const char* const kSecondStr;
+extern const char* const kSecondsStr;
+extern const char* const kSensorStr;
+extern const char* const kSensorTempStr;
+extern const char* const kSetStr;
+extern const char* const kSilentStr;
+extern const char* const kSleepStr;
+extern const char* const kSleepTimerStr;
+extern const char* const kSlowStr;
+extern const char* const kSpaceLBraceStr;
+extern const char* const kStartStr;
+extern const char* const kStepStr;
+extern const char* const kStopStr;
+extern const char* const kSuperStr;
+extern const char* const kSwingHStr;
+extern const char* const kSwingStr;
+extern const char* const kSwingVModeStr;
+extern const char* const kSwingVStr;
+extern const char* const kSwingVToggleStr;
+extern const char* const kTempDownStr;
+extern const char* const kTempStr;
+extern const char* const kTempUpStr;
+extern const char* const kThreeLetterDayOfWeekStr;
+extern const char* const kTimerStr;
+extern const char* const kToggleStr;
+extern const char* const kTopStr;
+extern const char* const kTrueStr;
+extern const char* const kTurboStr;
+extern const char* const kUnknownStr;
+extern const char* const kUpStr;
+extern const char* const kUpperStr;
+extern const char* const kWallStr;
+extern const char* const kWeeklyTimerStr;
+extern const char* const kWideStr;
+extern const char* const kWifiStr;
+extern const char* const kXFanStr;
+extern const char* const kYesStr;
+extern const char* const kZoneFollowStr;
 
 #endif  // IRTEXT_H_
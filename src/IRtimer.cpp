@@ -4,11 +4,22 @@
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif
+#include "IRremoteESP8266.h"
+
+#if (defined(ESP8266) || defined(ESP32)) && ENABLE_CYCLE_COUNT_TIMER && \
+    !defined(UNIT_TEST)
+#define IRTIMER_CYCLES true
+#else  // ENABLE_CYCLE_COUNT_TIMER etc.
+#define IRTIMER_CYCLES false
+#endif  // ENABLE_CYCLE_COUNT_TIMER etc.
 
 #ifdef UNIT_TEST
 // Used to help simulate elapsed time in unit tests.
 uint32_t _IRtimer_unittest_now = 0;
 uint32_t _TimerMs_unittest_now = 0;
+#else  // UNIT_TEST
+// Time that passed without really passing. See `IRtimer::add()`.
+static uint32_t _IRtimer_added = 0;
 #endif  // UNIT_TEST
 
 /// Class constructor.
@@ -17,7 +28,7 @@ IRtimer::IRtimer() { reset(); }
 /// Resets the IRtimer object. I.e. The counter starts again from now.
 void IRtimer::reset() {
 #ifndef UNIT_TEST
-  start = micros();
+  start = micros() + _IRtimer_added;
 #else
   start = _IRtimer_unittest_now;
 #endif
@@ -27,7 +38,7 @@ void IRtimer::reset() {
 /// @return Nr. of microseconds.
 uint32_t IRtimer::elapsed() {
 #ifndef UNIT_TEST
-  uint32_t now = micros();
+  uint32_t now = micros() + _IRtimer_added;
 #else
   uint32_t now = _IRtimer_unittest_now;
 #endif
@@ -39,10 +50,47 @@ uint32_t IRtimer::elapsed() {
 
 /// Add time to the timer to simulate elapsed time.
 /// @param[in] usecs Nr. of uSeconds to be added.
-/// @note Only used in unit testing.
+/// @note Used in unit testing, & for marks & spaces that are recorded rather
+///   than sent. e.g. So a protocol's gaps come out the same either way.
+void IRtimer::add(uint32_t usecs) {
 #ifdef UNIT_TEST
-void IRtimer::add(uint32_t usecs) { _IRtimer_unittest_now += usecs; }
+  _IRtimer_unittest_now += usecs;
+#else  // UNIT_TEST
+  _IRtimer_added += usecs;
 #endif  // UNIT_TEST
+}
+
+/// Class constructor.
+IRcycleTimer::IRcycleTimer() { reset(); }
+
+/// Resets the IRcycleTimer object. I.e. The counter starts again from now.
+void IRcycleTimer::reset() {
+#if IRTIMER_CYCLES
+  // The CPU clock can be changed at run time, so check it each time.
+  per_usec = ESP.getCpuFreqMHz();
+  start = ESP.getCycleCount();
+#elif !defined(UNIT_TEST)
+  per_usec = 1;
+  start = micros();
+#else  // IRTIMER_CYCLES
+  per_usec = 1;
+  start = _IRtimer_unittest_now;
+#endif  // IRTIMER_CYCLES
+}
+
+/// Calculate how many microseconds have elapsed since the timer was started.
+/// @return Nr. of microseconds.
+uint32_t IRcycleTimer::elapsed() {
+#if IRTIMER_CYCLES
+  const uint32_t now = ESP.getCycleCount();
+#elif !defined(UNIT_TEST)
+  const uint32_t now = micros();
+#else  // IRTIMER_CYCLES
+  const uint32_t now = _IRtimer_unittest_now;
+#endif  // IRTIMER_CYCLES
+  // Unsigned maths gets it right when the counter has wrapped (once).
+  return (now - start) / per_usec;
+}
 
 /// Class constructor.
 TimerMs::TimerMs() { reset(); }
@@ -74,5 +122,5 @@ uint32_t TimerMs::elapsed() {
 /// @param[in] msecs Nr. of mSeconds to be added.
 /// @note Only used in unit testing.
 #ifdef UNIT_TEST
-void TimerMs::add(uint32_t msecs) { _IRtimer_unittest_now += msecs; }
+void TimerMs::add(uint32_t msecs) { _TimerMs_unittest_now += msecs; }
 #endif  // UNIT_TEST
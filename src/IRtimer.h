@@ -15,14 +15,28 @@ class IRtimer {
   IRtimer();
   void reset();
   uint32_t elapsed();
-#ifdef UNIT_TEST
   static void add(uint32_t usecs);
-#endif  // UNIT_TEST
 
  private:
   uint32_t start;  ///< Time in uSeconds when the class was instantiated/reset.
 };
 
+/// A cheaper, finer grained counter in micro-seconds since instantiated/reset,
+/// for timing short intervals in tight loops. e.g. Each carrier pulse.
+/// It counts CPU cycles where it can, otherwise it is the same as `IRtimer`.
+/// @warning Only for intervals of less than ~17 seconds. The cycle counter
+///   wraps around (more than once) after that at a 240MHz clock.
+class IRcycleTimer {
+ public:
+  IRcycleTimer();
+  void reset();
+  uint32_t elapsed();
+
+ private:
+  uint32_t start;  ///< The count when the class was instantiated/reset.
+  uint32_t per_usec;  ///< Nr. of counts per uSecond.
+};
+
 /// This class offers a simple counter in milli-seconds since instantiated.
 /// @note Handles when the system timer wraps around (once).
 class TimerMs {
@@ -6,16 +6,44 @@
 #endif
 
 #define __STDC_LIMIT_MACROS
+#include <ctype.h>
 #include <stdint.h>
 #include <string.h>
 #include <algorithm>
 #ifndef ARDUINO
 #include <string>
 #endif
+#include "IRcustom.h"
 #include "IRrecv.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
+#if ENABLE_MEMORY_PROFILING
+#if defined(ARDUINO) && defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif  // defined(ARDUINO) && defined(ESP32)
+#endif  // ENABLE_MEMORY_PROFILING
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#endif
+#ifndef PROGMEM
+#define PROGMEM  // Pretend we have the PROGMEM macro even if we really don't.
+#endif
+
+/// @cond IGNORE
+// Reverse the order of all the bits in a 32 bit value, with a swap network.
+// i.e. Swap every adjacent pair of bits, then pairs of pairs etc.
+static uint32_t reverse32(uint32_t x) {
+  x = ((x >> 1) & 0x55555555UL) | ((x & 0x55555555UL) << 1);
+  x = ((x >> 2) & 0x33333333UL) | ((x & 0x33333333UL) << 2);
+  x = ((x >> 4) & 0x0F0F0F0FUL) | ((x & 0x0F0F0F0FUL) << 4);
+  x = ((x >> 8) & 0x00FF00FFUL) | ((x & 0x00FF00FFUL) << 8);
+  return (x >> 16) | (x << 16);
+}
+/// @endcond
 
 /// Reverse the order of the requested least significant nr. of bits.
 /// @param[in] input Bit pattern/integer to reverse.
@@ -25,46 +53,124 @@ uint64_t reverseBits(uint64_t input, uint16_t nbits) {
   if (nbits <= 1) return input;  // Reversing <= 1 bits makes no change at all.
   // Cap the nr. of bits to rotate to the max nr. of bits in the input.
   nbits = std::min(nbits, (uint16_t)(sizeof(input) * 8));
-  uint64_t output = 0;
-  for (uint16_t i = 0; i < nbits; i++) {
-    output <<= 1;
-    output |= (input & 1);
-    input >>= 1;
-  }
+  uint64_t output;
+  if (nbits <= 32)  // Most are. So only use 32 bit maths if we can.
+    output = reverse32(input) >> (32 - nbits);
+  else
+    output = (((uint64_t)reverse32(input) << 32) |
+              reverse32(input >> 32)) >> (64 - nbits);
+  if (nbits == sizeof(input) * 8) return output;
   // Merge any remaining unreversed bits back to the top of the reversed bits.
-  return (input << nbits) | output;
+  return ((input >> nbits) << nbits) | output;
 }
 
-/// Convert a uint64_t (unsigned long long) to a string.
-/// Arduino String/toInt/Serial.print() can't handle printing 64 bit values.
-/// @param[in] input The value to print
+/// Reverse the order of the bits in each byte of an array, in place.
+/// e.g. For converting a whole LSB first state to MSB first, or back.
+/// @param[in,out] data A ptr to the bytes to reverse.
+/// @param[in] length The nr. of bytes.
+void reverseBytes(uint8_t * const data, const uint16_t length) {
+  uint16_t i = 0;
+  // Four bytes at a time, as that costs the same as one.
+  for (; i + 4 <= length; i += 4) {
+    uint32_t word;
+    memcpy(&word, data + i, sizeof(word));
+    // A full reverse also swaps the byte order, so swap them back.
+    word = reverse32(word);
+    word = ((word >> 24) & 0xFF) | ((word >> 8) & 0xFF00) |
+        ((word << 8) & 0xFF0000) | (word << 24);
+    memcpy(data + i, &word, sizeof(word));
+  }
+  for (; i < length; i++) data[i] = reverse32(data[i]) >> 24;
+}
+
+/// @cond IGNORE
+// "00" to "99", for converting two decimal digits at a time.
+static const char kDecimalPairs[] PROGMEM =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+static const char kHexDigits[] PROGMEM = "0123456789ABCDEF";
+
+// Write the decimal digits of a value backwards, ending before `ptr`, with at
+// least `min_digits` (zero padded) digits. Only 32 bit maths is used.
+// Returns where the digits now start.
+static char *decimalDigits(char *ptr, uint32_t value,
+                           const uint8_t min_digits = 1) {
+  const char *end = ptr;
+  while (value >= 100) {
+    const uint8_t pair = (value % 100) * 2;
+    value /= 100;
+    *--ptr = pgm_read_byte(kDecimalPairs + pair + 1);
+    *--ptr = pgm_read_byte(kDecimalPairs + pair);
+  }
+  if (value >= 10) {
+    *--ptr = pgm_read_byte(kDecimalPairs + value * 2 + 1);
+    *--ptr = pgm_read_byte(kDecimalPairs + value * 2);
+  } else {
+    *--ptr = '0' + value;
+  }
+  while (end - ptr < min_digits) *--ptr = '0';
+  return ptr;
+}
+/// @endcond
+
+/// Convert a uint64_t (unsigned long long) to text, in a buffer supplied by
+/// the caller. i.e. Like `uint64ToString()`, but without creating a `String`.
+/// Base 10 & 16 have fast paths that avoid (slow) 64 bit divisions.
+/// @param[out] output Where to write the NUL terminated text. It needs room for
+///   `kUint64ToCharsSize` chars for the worst case. (i.e. Base 2)
+/// @param[in] input The value to convert.
 /// @param[in] base The output base.
-/// @returns A String representation of the integer.
-/// @note Based on Arduino's Print::printNumber()
-String uint64ToString(uint64_t input, uint8_t base) {
-  String result = "";
+/// @return The nr. of chars written, not including the NUL.
+uint8_t uint64ToChars(char *output, uint64_t input, uint8_t base) {
+  char digits[kUint64ToCharsSize];
+  char *ptr = digits + sizeof(digits) - 1;  // Fill it from the end backwards.
+  *ptr = '\0';
   // prevent issues if called with base <= 1
   if (base < 2) base = 10;
   // Check we have a base that we can actually print.
   // i.e. [0-9A-Z] == 36
   if (base > 36) base = 10;
 
-  // Reserve some string space to reduce fragmentation.
-  // 16 bytes should store a uint64 in hex text which is the likely worst case.
-  // 64 bytes would be the worst case (base 2).
-  result.reserve(16);
-
-  do {
-    char c = input % base;
-    input /= base;
+  switch (base) {
+    case 16:
+      do {
+        *--ptr = pgm_read_byte(kHexDigits + (input & 0xF));
+        input >>= 4;
+      } while (input);
+      break;
+    case 10:
+      // Peel off 9 digits at a time until the rest fits in 32 bits.
+      while (input > UINT32_MAX) {
+        ptr = decimalDigits(ptr, input % 1000000000ULL, 9);
+        input /= 1000000000ULL;
+      }
+      ptr = decimalDigits(ptr, input);
+      break;
+    default:
+      do {
+        const char c = input % base;
+        input /= base;
+        *--ptr = (c < 10) ? c + '0' : c + 'A' - 10;
+      } while (input);
+  }
+  const uint8_t length = digits + sizeof(digits) - 1 - ptr;
+  memcpy(output, ptr, length + 1);
+  return length;
+}
 
-    if (c < 10)
-      c += '0';
-    else
-      c += 'A' - 10;
-    result = c + result;
-  } while (input);
-  return result;
+/// Convert a uint64_t (unsigned long long) to a string.
+/// Arduino String/toInt/Serial.print() can't handle printing 64 bit values.
+/// @param[in] input The value to print
+/// @param[in] base The output base.
+/// @returns A String representation of the integer.
+/// @note Based on Arduino's Print::printNumber()
+String uint64ToString(uint64_t input, uint8_t base) {
+  char digits[kUint64ToCharsSize];
+  uint64ToChars(digits, input, base);
+  return String(digits);
 }
 
 #ifdef ARDUINO
@@ -81,21 +187,71 @@ void serialPrintUint64(uint64_t input, uint8_t base) {
 /// @param[in] str A C-style string containing a protocol name or number.
 /// @return A decode_type_t enum. (decode_type_t::UNKNOWN if no match.)
 decode_type_t strToDecodeType(const char * const str) {
+  if (str == NULL) return decode_type_t::UNKNOWN;
+  const uint16_t wanted = strlen(str);
   const char *ptr = kAllProtocolNamesStr;
   uint16_t length = strlen(ptr);
   for (uint16_t i = 0; length; i++) {
-    if (!strcasecmp(str, ptr)) return (decode_type_t)i;
+    // Only names of the same length can match, & checking that is cheap.
+    if (length == wanted && !strcasecmp(str, ptr)) return (decode_type_t)i;
     ptr += length + 1;
     length = strlen(ptr);
   }
+#if ENABLE_CUSTOM_PROTOCOLS
+  const decode_type_t custom = ircustom::find(str);
+  if (custom != decode_type_t::UNKNOWN) return custom;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+
+  // Handle integer values of the type. e.g. "3" for NEC.
+  const int32_t value = atoi(str);
+  if (value > 0 && value <= kLastDecodeType)
+    return (decode_type_t)value;
+#if ENABLE_CUSTOM_PROTOCOLS
+  if (ircustom::get((decode_type_t)value) != NULL)
+    return (decode_type_t)value;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  return decode_type_t::UNKNOWN;
+}
 
-  // Handle integer values of the type by converting to a string and back again.
-  decode_type_t result = strToDecodeType(
-      typeToString((decode_type_t)atoi(str)).c_str());
-  if (result > 0)
-    return result;
-  else
-    return decode_type_t::UNKNOWN;
+/// @cond IGNORE
+// Offsets of each protocol's name in `kAllProtocolNamesStr`, indexed by
+// decode_type_t. Built by the first lookup, so finding a name doesn't need to
+// walk every name before it.
+static uint16_t protocol_name_offsets[kLastDecodeType + 1];
+const uint16_t kNoProtocolName = UINT16_MAX;
+
+static bool buildProtocolNameOffsets(void) {
+  uint16_t offset = 0;
+  for (uint16_t i = 0; i <= kLastDecodeType; i++) {
+    const uint16_t length = strlen(kAllProtocolNamesStr + offset);
+    if (length) {
+      protocol_name_offsets[i] = offset;
+      offset += length + 1;
+    } else {  // We've run out of names.
+      protocol_name_offsets[i] = kNoProtocolName;
+    }
+  }
+  return true;
+}
+/// @endcond
+
+/// Get the name of a protocol type (enum etc) without allocating a String.
+/// @param[in] protocol Nr. (enum) of the protocol.
+/// @return A ptr to a C-style string containing the protocol name.
+///   kUnknownStr if no match.
+const char *typeToChars(const decode_type_t protocol) {
+#if ENABLE_CUSTOM_PROTOCOLS
+  const custom_protocol_t *custom = ircustom::get(protocol);
+  if (custom != NULL) return custom->name;
+#endif  // ENABLE_CUSTOM_PROTOCOLS
+  if (protocol > kLastDecodeType || protocol <= decode_type_t::UNKNOWN)
+    return kUnknownStr;
+  // Built once, even if several threads get here at the same time.
+  static const bool built = buildProtocolNameOffsets();
+  (void)built;
+  const uint16_t offset = protocol_name_offsets[protocol];
+  if (offset == kNoProtocolName) return kUnknownStr;
+  return kAllProtocolNamesStr + offset;
 }
 
 /// Convert a protocol type (enum etc) to a human readable string.
@@ -103,19 +259,7 @@ decode_type_t strToDecodeType(const char * const str) {
 /// @param[in] isRepeat A flag indicating if it is a repeat message.
 /// @return A String containing the protocol name. kUnknownStr if no match.
 String typeToString(const decode_type_t protocol, const bool isRepeat) {
-  String result = "";
-  const char *ptr = kAllProtocolNamesStr;
-  if (protocol > kLastDecodeType || protocol == decode_type_t::UNKNOWN) {
-    result = kUnknownStr;
-  } else {
-    for (uint16_t i = 0; i <= protocol && strlen(ptr); i++) {
-      if (i == protocol) {
-        result = ptr;
-        break;
-      }
-      ptr += strlen(ptr) + 1;
-    }
-  }
+  String result = typeToChars(protocol);
   if (isRepeat) {
     result += kSpaceLBraceStr;
     result += kRepeatStr;
@@ -188,64 +332,117 @@ uint16_t getCorrectedRawLength(const decode_results * const results) {
   return extended_length;
 }
 
-/// Return a String containing the key values of a decode_results structure
-/// in a C/C++ code style format.
-/// @param[in] results A ptr to a decode_results structure.
-/// @return A String containing the code-ified result.
-String resultToSourceCode(const decode_results * const results) {
-  String output = "";
-  // Reserve some space for the string to reduce heap fragmentation.
-  output.reserve(1536);  // 1.5KB should cover most cases.
+/// @cond IGNORE
+// Pass on some text to where a `BufferedOutput` is sending its output.
+static void writeOutput(String *output, const char *str) { *output += str; }
+
+#ifdef ARDUINO
+static void writeOutput(Print *output, const char *str) { output->print(str); }
+#endif  // ARDUINO
+
+// A small, fixed size, buffer the `resultTo*()` functions build their output
+// in. It is passed on to where it is really going (e.g. a `String` or a
+// `Print` stream like `Serial`) each time it fills up, so no matter how big
+// the output is, it needs no more memory than this.
+template <typename SINK>
+class BufferedOutput {
+ public:
+  explicit BufferedOutput(SINK *output) : _output(output), _length(0) {}
+  ~BufferedOutput(void) { flush(); }
+
+  void add(const char c) {
+    if (_length >= sizeof(_buffer) - 1) flush();
+    _buffer[_length++] = c;
+  }
+
+  void add(const char *str) {
+    while (*str) add(*str++);
+  }
+
+#ifdef ARDUINO
+  void add(const __FlashStringHelper *str) {
+    PGM_P ptr = reinterpret_cast<PGM_P>(str);
+    for (char c = pgm_read_byte(ptr); c; c = pgm_read_byte(++ptr)) add(c);
+  }
+#endif  // ARDUINO
+
+  void add(const String &str) { add(str.c_str()); }
+
+  // Like `uint64ToString()`, but padded with `pad` to at least `width` chars.
+  void addUint(const uint64_t value, const uint8_t base = 10,
+               const uint8_t width = 0, const char pad = ' ') {
+    char digits[kUint64ToCharsSize];
+    const uint8_t count = uint64ToChars(digits, value, base);
+    for (uint8_t i = count; i < width; i++) add(pad);
+    add(digits);
+  }
+
+  void flush(void) {
+    if (!_length) return;
+    _buffer[_length] = '\0';
+    writeOutput(_output, _buffer);
+    _length = 0;
+  }
+
+ private:
+  SINK *_output;
+  char _buffer[64];
+  uint8_t _length;
+};
+
+template <typename SINK>
+static void addSourceCode(BufferedOutput<SINK> *output,
+                          const decode_results * const results) {
   // Start declaration
-  output += F("uint16_t ");  // variable type
-  output += F("rawData[");   // array name
-  output += uint64ToString(getCorrectedRawLength(results), 10);
-  // array size
-  output += F("] = {");  // Start declaration
+  output->add(F("uint16_t "));  // variable type
+  output->add(F("rawData["));   // array name
+  output->addUint(getCorrectedRawLength(results));  // array size
+  output->add(F("] = {"));  // Start declaration
 
   // Dump data
   for (uint16_t i = 1; i < results->rawlen; i++) {
     uint32_t usecs;
     for (usecs = results->rawbuf[i] * kRawTick; usecs > UINT16_MAX;
          usecs -= UINT16_MAX) {
-      output += uint64ToString(UINT16_MAX);
+      output->addUint(UINT16_MAX);
       if (i % 2)
-        output += F(", 0,  ");
+        output->add(F(", 0,  "));
       else
-        output += F(",  0, ");
+        output->add(F(",  0, "));
     }
-    output += uint64ToString(usecs, 10);
+    output->addUint(usecs);
     if (i < results->rawlen - 1)
-      output += kCommaSpaceStr;            // ',' not needed on the last one
-    if (i % 2 == 0) output += ' ';  // Extra if it was even.
+      output->add(kCommaSpaceStr);  // ',' not needed on the last one
+    if (i % 2 == 0) output->add(' ');  // Extra if it was even.
   }
 
   // End declaration
-  output += F("};");
+  output->add(F("};"));
 
   // Comment
-  output += F("  // ");
-  output += typeToString(results->decode_type, results->repeat);
+  output->add(F("  // "));
+  output->add(typeToString(results->decode_type, results->repeat));
   // Only display the value if the decode type doesn't have an A/C state.
-  if (!hasACState(results->decode_type))
-    output += ' ' + uint64ToString(results->value, 16);
-  output += F("\n");
+  if (!hasACState(results->decode_type)) {
+    output->add(' ');
+    output->addUint(results->value, 16);
+  }
+  output->add(F("\n"));
 
   // Now dump "known" codes
   if (results->decode_type != UNKNOWN) {
     if (hasACState(results->decode_type)) {
 #if DECODE_AC
       uint16_t nbytes = results->bits / 8;
-      output += F("uint8_t state[");
-      output += uint64ToString(nbytes);
-      output += F("] = {");
+      output->add(F("uint8_t state["));
+      output->addUint(nbytes);
+      output->add(F("] = {"));
       for (uint16_t i = 0; i < nbytes; i++) {
-        output += F("0x");
-        if (results->state[i] < 0x10) output += '0';
-        output += uint64ToString(results->state[i], 16);
-        if (i < nbytes - 1) output += kCommaSpaceStr;
+        output->add(F("0x"));
+        output->addUint(results->state[i], 16, 2, '0');
+        if (i < nbytes - 1) output->add(kCommaSpaceStr);
       }
-      output += F("};\n");
+      output->add(F("};\n"));
 #endif  // DECODE_AC
     } else {
       // Simple protocols
@@ -253,19 +450,143 @@ String resultToSourceCode(const decode_results * const results) {
       // NOTE: It will ignore the atypical case when a message has been
       // decoded but the address & the command are both 0.
       if (results->address > 0 || results->command > 0) {
-        output += F("uint32_t address = 0x");
-        output += uint64ToString(results->address, 16);
-        output += F(";\n");
-        output += F("uint32_t command = 0x");
-        output += uint64ToString(results->command, 16);
-        output += F(";\n");
+        output->add(F("uint32_t address = 0x"));
+        output->addUint(results->address, 16);
+        output->add(F(";\n"));
+        output->add(F("uint32_t command = 0x"));
+        output->addUint(results->command, 16);
+        output->add(F(";\n"));
       }
       // Most protocols have data
-      output += F("uint64_t data = 0x");
-      output += uint64ToString(results->value, 16);
-      output += F(";\n");
+      output->add(F("uint64_t data = 0x"));
+      output->addUint(results->value, 16);
+      output->add(F(";\n"));
     }
   }
+}
+
+template <typename SINK>
+static void addTimingInfo(BufferedOutput<SINK> *output,
+                          const decode_results * const results) {
+  output->add(F("Raw Timing["));
+  output->addUint(results->rawlen - 1);
+  output->add(F("]:\n"));
+
+  for (uint16_t i = 1; i < results->rawlen; i++) {
+    if (i % 2 == 0)
+      output->add('-');  // even
+    else
+      output->add(F("   +"));  // odd
+    // Space pad the value till it is at least 6 chars long.
+    output->addUint(results->rawbuf[i] * kRawTick, 10, 6);
+    if (i < results->rawlen - 1)
+      output->add(kCommaSpaceStr);  // ',' not needed for last one
+    if (!(i % 8)) output->add('\n');  // Newline every 8 entries.
+  }
+  output->add('\n');
+}
+
+template <typename SINK>
+static void addHexidecimal(BufferedOutput<SINK> *output,
+                           const decode_results * const result) {
+  output->add(F("0x"));
+  if (hasACState(result->decode_type)) {
+#if DECODE_AC
+    for (uint16_t i = 0; result->bits > i * 8; i++)
+      output->addUint(result->state[i], 16, 2, '0');  // Zero pad
+#endif  // DECODE_AC
+  } else {
+    output->addUint(result->value, 16);
+  }
+}
+
+template <typename SINK>
+static void addHumanReadableBasic(BufferedOutput<SINK> *output,
+                                  const decode_results * const results) {
+  // Show Encoding standard
+  output->add(kProtocolStr);
+  output->add(F("  : "));
+  output->add(typeToString(results->decode_type, results->repeat));
+  output->add('\n');
+
+  // Show Code & length
+  output->add(kCodeStr);
+  output->add(F("      : "));
+  addHexidecimal(output, results);
+  output->add(kSpaceLBraceStr);
+  output->addUint(results->bits);
+  output->add(' ');
+  output->add(kBitsStr);
+  output->add(F(")\n"));
+}
+
+// Nr. of uSeconds of a captured mark or space. A capture that ends with a
+// mark gets a trailing gap, as the formats need whole mark & space pairs.
+static uint32_t capturedUsecs(const decode_results * const results,
+                              const uint16_t entry) {
+  return entry < results->rawlen ? results->rawbuf[entry] * kRawTick
+                                 : kDefaultMessageGap;
+}
+
+// Nr. of marks & spaces of a capture, once padded to whole pairs.
+static uint16_t capturedPairs(const decode_results * const results) {
+  return results->rawlen / 2;  // i.e. Half of rawlen - 1, rounded up.
+}
+
+template <typename SINK>
+static void addPronto(BufferedOutput<SINK> *output,
+                      const decode_results * const results,
+                      const uint32_t hz) {
+  if (!hz) return;
+  // The carrier is in units of 0.241246 uSeconds. i.e. 1000000 / 0.241246.
+  const uint32_t code = std::min(std::max(4145146UL / hz, 1UL), 0xFFFFUL);
+  // The length of a cycle of it, in picoseconds.
+  const uint64_t cycle = (uint64_t)code * 241246;
+  output->add(F("0000 "));
+  output->addUint(code, 16, 4, '0');
+  // All of it is the repeat sequence, so it is sent once as a whole.
+  output->add(F(" 0000 "));
+  output->addUint(capturedPairs(results), 16, 4, '0');
+  for (uint16_t i = 1; i <= capturedPairs(results) * 2; i++) {
+    const uint64_t cycles = (capturedUsecs(results, i) * 1000000ULL +
+                             cycle / 2) / cycle;
+    output->add(' ');
+    output->addUint(std::min(std::max(cycles, (uint64_t)1),
+                             (uint64_t)UINT16_MAX), 16, 4, '0');
+  }
+}
+
+template <typename SINK>
+static void addGlobalCache(BufferedOutput<SINK> *output,
+                           const decode_results * const results,
+                           const uint32_t hz) {
+  if (!hz) return;
+  output->addUint(hz);
+  output->add(F(",1,1"));  // Sent once, & any repeat starts at the beginning.
+  for (uint16_t i = 1; i <= capturedPairs(results) * 2; i++) {
+    const uint64_t cycles = (capturedUsecs(results, i) * (uint64_t)hz +
+                             500000) / 1000000;
+    output->add(',');
+    output->addUint(std::min(std::max(cycles, (uint64_t)1),
+                             (uint64_t)UINT16_MAX));
+  }
+}
+/// @endcond
+
+/// Return a String containing the key values of a decode_results structure
+/// in a C/C++ code style format.
+/// @param[in] results A ptr to a decode_results structure.
+/// @return A String containing the code-ified result.
+String resultToSourceCode(const decode_results * const results) {
+#if ENABLE_MEMORY_PROFILING
+  irutils::MemoryProbe probe(kMemProbeResultToSourceCode);
+#endif  // ENABLE_MEMORY_PROFILING
+  String output = "";
+  // Reserve some space for the string to reduce heap fragmentation.
+  output.reserve(1536);  // 1.5KB should cover most cases.
+  BufferedOutput<String> buffer(&output);
+  addSourceCode(&buffer, results);
+  buffer.flush();
   return output;
 }
 
@@ -275,28 +596,11 @@ String resultToSourceCode(const decode_results * const results) {
 /// @deprecated This is only for those that want this legacy format.
 String resultToTimingInfo(const decode_results * const results) {
   String output = "";
-  String value = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(2048);  // 2KB should cover most cases.
-  value.reserve(6);  // Max value should be 2^17 = 131072
-  output += F("Raw Timing[");
-  output += uint64ToString(results->rawlen - 1, 10);
-  output += F("]:\n");
-
-  for (uint16_t i = 1; i < results->rawlen; i++) {
-    if (i % 2 == 0)
-      output += '-';  // even
-    else
-      output += F("   +");  // odd
-    value = uint64ToString(results->rawbuf[i] * kRawTick);
-    // Space pad the value till it is at least 6 chars long.
-    while (value.length() < 6) value = ' ' + value;
-    output += value;
-    if (i < results->rawlen - 1)
-      output += kCommaSpaceStr;  // ',' not needed for last one
-    if (!(i % 8)) output += '\n';  // Newline every 8 entries.
-  }
-  output += '\n';
+  BufferedOutput<String> buffer(&output);
+  addTimingInfo(&buffer, results);
+  buffer.flush();
   return output;
 }
 
@@ -304,19 +608,12 @@ String resultToTimingInfo(const decode_results * const results) {
 /// @param[in] result A ptr to a decode_results structure.
 /// @return A String containing the output.
 String resultToHexidecimal(const decode_results * const result) {
-  String output = F("0x");
+  String output = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(2 * kStateSizeMax + 2);  // Should cover worst cases.
-  if (hasACState(result->decode_type)) {
-#if DECODE_AC
-    for (uint16_t i = 0; result->bits > i * 8; i++) {
-      if (result->state[i] < 0x10) output += '0';  // Zero pad
-      output += uint64ToString(result->state[i], 16);
-    }
-#endif  // DECODE_AC
-  } else {
-    output += uint64ToString(result->value, 16);
-  }
+  BufferedOutput<String> buffer(&output);
+  addHexidecimal(&buffer, result);
+  buffer.flush();
   return output;
 }
 
@@ -327,46 +624,561 @@ String resultToHumanReadableBasic(const decode_results * const results) {
   String output = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(2 * kStateSizeMax + 50);  // Should cover most cases.
-  // Show Encoding standard
-  output += kProtocolStr;
-  output += F("  : ");
-  output += typeToString(results->decode_type, results->repeat);
-  output += '\n';
+  BufferedOutput<String> buffer(&output);
+  addHumanReadableBasic(&buffer, results);
+  buffer.flush();
+  return output;
+}
 
-  // Show Code & length
-  output += kCodeStr;
-  output += F("      : ");
-  output += resultToHexidecimal(results);
-  output += kSpaceLBraceStr;
-  output += uint64ToString(results->bits);
-  output += ' ';
-  output += kBitsStr;
-  output +=  F(")\n");
+/// Convert a capture into a Pronto code. e.g. To export a learnt code to
+/// something that only takes those. `IRsend::sendPronto()` can send it.
+/// e.g. "0000 006D 0000 0022 0156 00AB 0015 0015 ..."
+/// @param[in] results A ptr to a decode_results structure.
+/// @param[in] hz The carrier frequency of the capture, as it isn't captured.
+/// @return A String of the code. Empty if `hz` is 0.
+/// @note All of the capture is the "repeat" sequence, so it is sent once.
+///   A trailing gap of `kDefaultMessageGap` is added if it ends with a mark.
+///   i.e. It is the same as `tools/raw_to_pronto_code.py` makes, but only
+///   integer maths is used.
+String resultToPronto(const decode_results * const results,
+                      const uint32_t hz) {
+  String output = "";
+  // Reserve some space for the string to reduce heap fragmentation.
+  output.reserve(5 * (capturedPairs(results) * 2 + 4));  // Enough.
+  BufferedOutput<String> buffer(&output);
+  addPronto(&buffer, results, hz);
+  buffer.flush();
+  return output;
+}
+
+/// Convert a capture into a GlobalCache (GC) code. e.g. For an iTach, or Home
+/// Assistant. `IRsend::sendGC()` can send it.
+/// e.g. "38000,1,1,342,171,21,21,21,64,..."
+/// @param[in] results A ptr to a decode_results structure.
+/// @param[in] hz The carrier frequency of the capture, as it isn't captured.
+/// @return A String of the code. Empty if `hz` is 0.
+/// @note A GC `sendir` command needs "sendir,<module>:<port>,<ID>," before it.
+///   A trailing gap of `kDefaultMessageGap` is added if it ends with a mark.
+String resultToGlobalCache(const decode_results * const results,
+                           const uint32_t hz) {
+  String output = "";
+  // Reserve some space for the string to reduce heap fragmentation.
+  output.reserve(4 * (capturedPairs(results) * 2) + 16);  // Typically enough.
+  BufferedOutput<String> buffer(&output);
+  addGlobalCache(&buffer, results, hz);
+  buffer.flush();
   return output;
 }
 
+#ifdef ARDUINO
+/// Print the key values of a decode_results structure in a C/C++ code style
+/// format. i.e. The same as `resultToSourceCode()`, but straight to a stream
+/// like `Serial`, so it needs very little memory, no matter how big it is.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] results A ptr to a decode_results structure.
+void resultToSourceCode(Print *output, const decode_results * const results) {
+#if ENABLE_MEMORY_PROFILING
+  irutils::MemoryProbe probe(kMemProbeResultToSourceCode);
+#endif  // ENABLE_MEMORY_PROFILING
+  BufferedOutput<Print> buffer(output);
+  addSourceCode(&buffer, results);
+}
+
+/// Print the decode_results structure in the legacy timing format.
+/// i.e. The same as `resultToTimingInfo()`, but straight to a stream.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] results A ptr to a decode_results structure.
+/// @deprecated This is only for those that want this legacy format.
+void resultToTimingInfo(Print *output, const decode_results * const results) {
+  BufferedOutput<Print> buffer(output);
+  addTimingInfo(&buffer, results);
+}
+
+/// Print the decode_results structure's value/state as simple hexadecimal.
+/// i.e. The same as `resultToHexidecimal()`, but straight to a stream.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] result A ptr to a decode_results structure.
+void resultToHexidecimal(Print *output, const decode_results * const result) {
+  BufferedOutput<Print> buffer(output);
+  addHexidecimal(&buffer, result);
+}
+
+/// Print the decode_results structure in a human readable format.
+/// i.e. The same as `resultToHumanReadableBasic()`, but straight to a stream.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] results A ptr to a decode_results structure.
+void resultToHumanReadableBasic(Print *output,
+                                const decode_results * const results) {
+  BufferedOutput<Print> buffer(output);
+  addHumanReadableBasic(&buffer, results);
+}
+
+/// Print a capture as a Pronto code.
+/// i.e. The same as `resultToPronto()`, but straight to a stream, so even a
+/// long capture can be exported with very little memory.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] results A ptr to a decode_results structure.
+/// @param[in] hz The carrier frequency of the capture.
+void resultToPronto(Print *output, const decode_results * const results,
+                    const uint32_t hz) {
+  BufferedOutput<Print> buffer(output);
+  addPronto(&buffer, results, hz);
+}
+
+/// Print a capture as a GlobalCache (GC) code.
+/// i.e. The same as `resultToGlobalCache()`, but straight to a stream.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] results A ptr to a decode_results structure.
+/// @param[in] hz The carrier frequency of the capture.
+void resultToGlobalCache(Print *output, const decode_results * const results,
+                         const uint32_t hz) {
+  BufferedOutput<Print> buffer(output);
+  addGlobalCache(&buffer, results, hz);
+}
+#endif  // ARDUINO
+
+/// @cond IGNORE
+// The keys used by `resultToJson()`. They aren't translated, so machines can
+// rely on them.
+const char kJsonProtocolKey[] = "protocol";
+const char kJsonBitsKey[] = "bits";
+const char kJsonRepeatKey[] = "repeat";
+const char kJsonStateKey[] = "state";
+const char kJsonValueKey[] = "value";
+const char kJsonAddressKey[] = "address";
+const char kJsonCommandKey[] = "command";
+
+// Write the key values of a decode_results structure as a JSON object.
+static void addJson(irutils::JsonWriter *json,
+                    const decode_results * const results) {
+  json->begin();
+  json->add(kJsonProtocolKey, typeToChars(results->decode_type));
+  json->add(kJsonBitsKey, (int32_t)results->bits);
+  json->add(kJsonRepeatKey, results->repeat);
+  if (hasACState(results->decode_type)) {
+    json->addHex(kJsonStateKey, results->state, results->bits / 8);
+  } else {
+    json->addHex(kJsonValueKey, results->value);
+    json->addHex(kJsonAddressKey, (uint64_t)results->address);
+    json->addHex(kJsonCommandKey, (uint64_t)results->command);
+  }
+  json->end();
+}
+/// @endcond
+
+/// Serialise the key values of a decode_results structure as a JSON object,
+/// into a caller supplied buffer. i.e. No heap memory is used.
+/// e.g. `{"protocol":"NEC","bits":32,"repeat":false,"value":"0x20DF10EF",`
+///      `"address":"0x4","command":"0x8"}`
+/// @param[in] results A ptr to a decode_results structure.
+/// @param[out] output A ptr to the buffer to store the NUL terminated result.
+/// @param[in] size The size of the `output` buffer in bytes.
+/// @return The length of the JSON stored, or 0 if it didn't fit.
+uint16_t resultToJson(const decode_results * const results, char *output,
+                      const uint16_t size) {
+  irutils::JsonWriter json(output, size);
+  addJson(&json, results);
+  return json.overflowed() ? 0 : json.length();
+}
+
+#ifdef ARDUINO
+/// Print the key values of a decode_results structure as a JSON object.
+/// i.e. The same as the other `resultToJson()`, but straight to a stream.
+/// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+/// @param[in] results A ptr to a decode_results structure.
+void resultToJson(Print *output, const decode_results * const results) {
+  irutils::JsonWriter json(output);
+  addJson(&json, results);
+}
+#endif  // ARDUINO
+
+#if ENABLE_DECODE_PROFILING
+/// Dump the decode statistics an IRrecv object has collected as a String.
+/// i.e. One line per protocol that has been attempted.
+/// @param[in] irrecv A ptr to the IRrecv object to report on.
+/// @return A human readable String. Empty if profiling isn't enabled.
+/// @see IRrecv::enableDecodeProfiling()
+String decodeProfileToString(IRrecv * const irrecv) {
+  String output = "";
+  for (int16_t i = UNKNOWN; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    const decode_profile_t *stats = irrecv->getDecodeProfile(protocol);
+    if (stats == NULL || stats->attempts == 0) continue;
+    output += typeToString(protocol);
+    output += kColonSpaceStr;
+    output += uint64ToString(stats->attempts);
+    output += F(" attempted, ");
+    output += uint64ToString(stats->rejects);
+    output += F(" rejected, ");
+    output += uint64ToString(stats->successes);
+    output += F(" decoded, ");
+    output += uint64ToString(stats->usecs);
+    output += F(" usecs\n");
+  }
+  return output;
+}
+#endif  // ENABLE_DECODE_PROFILING
+
+#if ENABLE_DECODE_TRACE
+/// Dump the decode trace an IRrecv object has recorded as a String.
+/// i.e. A header line, then one line per event, oldest first, of its:
+///   ticks event protocol offset value
+/// as decimal numbers. `tools/decode_trace.py` makes it human readable.
+/// @param[in] irrecv A ptr to the IRrecv object to report on.
+/// @return A String. Only the header line if nothing has been recorded.
+/// @see IRrecv::enableDecodeTrace()
+String decodeTraceToString(IRrecv * const irrecv) {
+  const uint16_t length = irrecv->getDecodeTraceLength();
+  String output = F("# Decode trace: ");
+  output += uint64ToString(irrecv->getDecodeTraceRate());
+  output += F(" ticks/usec, ");
+  output += uint64ToString(length);
+  output += F(" events\n");
+  for (uint16_t i = 0; i < length; i++) {
+    const decode_trace_t *entry = irrecv->getDecodeTraceEntry(i);
+    output += uint64ToString(entry->ticks);
+    output += ' ';
+    output += uint64ToString(entry->event);
+    output += ' ';
+    if (entry->protocol < 0) output += '-';  // e.g. UNKNOWN
+    output += uint64ToString(entry->protocol < 0 ? -entry->protocol
+                                                : entry->protocol);
+    output += ' ';
+    output += uint64ToString(entry->offset);
+    output += ' ';
+    output += uint64ToString(entry->value);
+    output += '\n';
+  }
+  return output;
+}
+#endif  // ENABLE_DECODE_TRACE
+
+#if ENABLE_MEMORY_PROFILING
+// Stack painting, to find how much of the stack the entry points use.
+// The stack (below where a probe starts) is filled with a known value, & how
+// much of it was overwritten is found when the probe ends. The stack is
+// assumed to grow downwards, as it does on all the supported platforms.
+// On the ESP8266, the core's own painting of its (cont) stack is used.
+const uint8_t kMemStackPaint = 0xA5;  // FreeRTOS's value, so we don't upset it.
+const uint8_t kMemStackGap = 64;  // Bytes below the painter left untouched.
+
+static mem_profile_t mem_profile[kMemProbeCount];
+static uint16_t mem_stack_depth = 0;  // Bytes to paint. 0 means disabled.
+static bool mem_probing = false;  // Is a probe measuring?
+static volatile uint8_t *mem_stack_top = NULL;  // The top of the painting.
+
+#if defined(__SANITIZE_ADDRESS__)
+// The painting is outside any stack frame, on purpose.
+#define MEM_NO_ASAN __attribute__((no_sanitize_address))
+#else  // defined(__SANITIZE_ADDRESS__)
+#define MEM_NO_ASAN
+#endif  // defined(__SANITIZE_ADDRESS__)
+
+/// The state of the heap, as a value that goes down by the nr. of bytes
+/// allocated from it. i.e. The free heap, when it is known.
+/// @return The value. Always 0 if the platform doesn't say.
+static int32_t memHeapFree(void) {
+#if defined(ARDUINO) && (defined(ESP8266) || defined(ESP32))
+  return ESP.getFreeHeap();
+#elif defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 33)
+  return -(int32_t)mallinfo2().uordblks;
+#else  // __GLIBC_PREREQ(2, 33)
+  return -(int32_t)mallinfo().uordblks;
+#endif  // __GLIBC_PREREQ(2, 33)
+#else  // Unknown.
+  return 0;
+#endif
+}
+
+/// Paint the stack below the caller's frame.
+/// @param[in] depth Nr. of bytes to paint.
+/// @return Nr. of bytes actually painted.
+static uint32_t __attribute__((noinline)) MEM_NO_ASAN memPaintStack(
+    uint32_t depth) {
+#if defined(ARDUINO) && defined(ESP8266)
+  (void)depth;  // The core knows how much there is.
+  ESP.resetFreeContStack();
+  return ESP.getFreeContStack();
+#else  // defined(ARDUINO) && defined(ESP8266)
+#if defined(ARDUINO) && defined(ESP32)
+  // Don't go past the deepest the stack has ever been. i.e. What's left.
+  const uint32_t unused = uxTaskGetStackHighWaterMark(NULL);
+  depth = std::min(depth, (unused > 2 * kMemStackGap) ?
+                   unused - 2 * kMemStackGap : 0);
+#endif  // defined(ARDUINO) && defined(ESP32)
+  mem_stack_top = static_cast<volatile uint8_t *>(__builtin_frame_address(0))
+      - kMemStackGap;
+  for (uint32_t i = 1; i <= depth; i++) mem_stack_top[-(int32_t)i] =
+      kMemStackPaint;
+  return depth;
+#endif  // defined(ARDUINO) && defined(ESP8266)
+}
+
+/// Find how much of the stack painted by `memPaintStack()` has been used.
+/// @param[in] painted What `memPaintStack()` returned.
+/// @param[in] start Where in the stack the measurement started.
+/// @return Nr. of bytes used below `start`. If it is all of what was
+///   painted, at least that many.
+static uint32_t MEM_NO_ASAN memStackUsed(const uint32_t painted,
+                                         const uintptr_t start) {
+#if defined(ARDUINO) && defined(ESP8266)
+  (void)start;  // The core measures from where it was painted.
+  const uint32_t unused = ESP.getFreeContStack();
+  return (painted > unused) ? painted - unused : 0;
+#else  // defined(ARDUINO) && defined(ESP8266)
+  uint32_t unused = 0;
+  while (unused < painted &&
+         mem_stack_top[-(int32_t)(painted - unused)] == kMemStackPaint)
+    unused++;
+  return start - (uintptr_t)mem_stack_top + painted - unused;
+#endif  // defined(ARDUINO) && defined(ESP8266)
+}
+
+/// Start recording the most memory each entry point (see `mem_probe_t`) uses.
+/// Any previously recorded usage is cleared.
+/// @param[in] stack_depth Nr. of bytes of the stack below each entry point to
+///   paint & check. More is measured as that much. There MUST be at least
+///   that much free stack below them. On the ESP8266 it is ignored, as its
+///   core knows how much there is. On the ESP32, it is kept to the part of
+///   its task's stack that has never been used.
+/// @return true, if successful.
+/// @note Painting the stack costs time in every call. Only profile when
+///   investigating (or testing) memory usage.
+bool enableMemoryProfiling(const uint16_t stack_depth) {
+  if (!stack_depth) return false;
+  resetMemoryProfile();
+  mem_stack_depth = stack_depth;
+  return true;
+}
+
+/// Stop recording the memory usage of the entry points.
+void disableMemoryProfiling(void) { mem_stack_depth = 0; }
+
+/// Clear all of the recorded memory usage.
+void resetMemoryProfile(void) {
+  for (uint8_t i = 0; i < kMemProbeCount; i++) {
+    mem_profile[i].calls = 0;
+    mem_profile[i].stack = 0;
+    mem_profile[i].heap = 0;
+  }
+}
+
+/// Obtain the most memory an entry point has been seen to use.
+/// @param[in] api The entry point.
+/// @return A ptr to the usage, or NULL if the entry point is out of range.
+const mem_profile_t *getMemoryProfile(const mem_probe_t api) {
+  if (api < 0 || api >= kMemProbeCount) return NULL;
+  return &mem_profile[api];
+}
+
+/// Dump the recorded memory usage of the entry points as a String.
+/// i.e. One line per entry point that has been called.
+/// @return A human readable String. Empty if nothing has been recorded.
+/// @see enableMemoryProfiling()
+String memoryProfileToString(void) {
+  String output = "";
+  for (uint8_t i = 0; i < kMemProbeCount; i++) {
+    const mem_profile_t *usage = &mem_profile[i];
+    if (!usage->calls) continue;
+    switch ((mem_probe_t)i) {
+      case kMemProbeDecode: output += F("IRrecv::decode()"); break;
+      case kMemProbeSendAc: output += F("IRac::sendAc()"); break;
+      case kMemProbeDecodeToState:
+        output += F("IRAcUtils::decodeToState()");
+        break;
+      case kMemProbeResultAcToString:
+        output += F("IRAcUtils::resultAcToString()");
+        break;
+      default: output += F("resultToSourceCode()");
+    }
+    output += kColonSpaceStr;
+    output += uint64ToString(usage->calls);
+    output += F(" calls, ");
+    output += uint64ToString(usage->stack);
+    output += F(" bytes of stack, ");
+    if (usage->heap < 0) output += '-';
+    output += uint64ToString(usage->heap < 0 ? -usage->heap : usage->heap);
+    output += F(" bytes of heap\n");
+  }
+  return output;
+}
+#endif  // ENABLE_MEMORY_PROFILING
+
 /// Convert a decode_results into an array suitable for `sendRaw()`.
 /// @param[in] decode A ptr to a decode_results structure that contains a mesg.
 /// @return A PTR to a dynamically allocated uint16_t sendRaw compatible array.
 /// @note The returned array needs to be delete[]'ed/free()'ed (deallocated)
 ///  after use by caller.
+/// @note Use the version that takes a caller supplied buffer, or
+///  `IRsend::sendRawTicks()`, to avoid the heap allocation.
 uint16_t* resultToRawArray(const decode_results * const decode) {
-  uint16_t *result = new uint16_t[getCorrectedRawLength(decode)];
-  if (result != NULL) {  // The memory was allocated successfully.
-    // Convert the decode data.
-    uint16_t pos = 0;
-    for (uint16_t i = 1; i < decode->rawlen; i++) {
-      uint32_t usecs = decode->rawbuf[i] * kRawTick;
-      while (usecs > UINT16_MAX) {  // Keep truncating till it fits.
-        result[pos++] = UINT16_MAX;
-        result[pos++] = 0;  // A 0 in a sendRaw() array basically means skip.
-        usecs -= UINT16_MAX;
+  const uint16_t length = getCorrectedRawLength(decode);
+  uint16_t *result = new uint16_t[length];
+  if (result != NULL)  // The memory was allocated successfully.
+    resultToRawArray(decode, result, length);
+  return result;
+}
+
+/// Convert a decode_results into a caller supplied array suitable for
+/// `sendRaw()`. i.e. No memory is allocated.
+/// @param[in] decode A ptr to a decode_results structure that contains a mesg.
+/// @param[out] output A ptr to the array to store the result in.
+/// @param[in] size The nr. of uint16_t entries the `output` array can hold.
+/// @return The nr. of entries stored in `output`. i.e. The same as
+///  `getCorrectedRawLength()`. 0 if it didn't fit.
+uint16_t resultToRawArray(const decode_results * const decode,
+                          uint16_t * const output, const uint16_t size) {
+  uint16_t pos = 0;
+  for (uint16_t i = 1; i < decode->rawlen; i++) {
+    uint32_t usecs = decode->rawbuf[i] * kRawTick;
+    while (usecs > UINT16_MAX) {  // Keep truncating till it fits.
+      if (pos + 2 > size) return 0;
+      output[pos++] = UINT16_MAX;
+      output[pos++] = 0;  // A 0 in a sendRaw() array basically means skip.
+      usecs -= UINT16_MAX;
+    }
+    if (pos >= size) return 0;
+    output[pos++] = usecs;
+  }
+  return pos;
+}
+
+/// @cond IGNORE
+// The layout of a normalised capture:
+//   [0]       Nr. of entries in the palette. (n)
+//   [1..2n]   The palette. Each a little-endian uint16_t. (usecs)
+//   [2n+1..2] Nr. of marks & spaces. A little-endian uint16_t.
+//   [2n+3..]  The palette index of each mark & space. 1, 2, or 4 bits each,
+//             depending on the size of the palette. Least significant first.
+static uint8_t normalisedBits(const uint8_t palette_size) {
+  return (palette_size <= 2) ? 1 : (palette_size <= 4) ? 2 : 4;
+}
+/// @endcond
+
+/// Normalise a capture to a few canonical timings, for compact storage.
+/// i.e. The marks & spaces are clustered, as `reduce_list()` in
+/// tools/auto_analyse_raw_data.py does, & each is replaced by the average of
+/// its cluster. The result is the (up to 16) averages, & a 1-4 bit index into
+/// them per mark & space. Typically 4-8 times smaller than a `rawData[]`, &
+/// free of the jitter in it.
+/// @param[in] decode A ptr to a decode_results structure that contains a mesg.
+/// @param[out] output A ptr to where to store the normalised capture.
+/// @param[in] size The nr. of bytes `output` can hold.
+/// @param[in] margin Timings within this of the longest of a cluster are in
+///   it. (usecs)
+/// @return The nr. of bytes stored in `output`. 0 if it didn't fit, or it
+///   needed more than kNormalisePaletteMax timings.
+/// @note Replay it with `IRsequence::setNormalised()` & `sendSequence()`.
+/// @note Timings are capped at 65535 usecs.
+uint16_t normaliseCapture(const decode_results * const decode,
+                          uint8_t * const output, const uint16_t size,
+                          const uint16_t margin) {
+  if (decode->rawlen < 2) return 0;
+  const uint16_t length = decode->rawlen - 1;
+  uint16_t top[kNormalisePaletteMax];  // The longest timing of each cluster.
+  uint32_t total[kNormalisePaletteMax];
+  uint16_t count[kNormalisePaletteMax];
+  uint8_t clusters = 0;
+  uint32_t below = UINT32_MAX;  // Timings not yet in a cluster are below this.
+  while (true) {  // Find the clusters, longest first. No sorting needed.
+    uint32_t longest = 0;
+    bool found = false;
+    for (uint16_t i = 1; i <= length; i++) {
+      const uint32_t usecs = std::min((uint32_t)decode->rawbuf[i] * kRawTick,
+                                      (uint32_t)UINT16_MAX);
+      if (usecs < below && usecs >= longest) {
+        longest = usecs;
+        found = true;
       }
-      result[pos++] = usecs;
     }
+    if (!found) break;
+    if (clusters >= kNormalisePaletteMax) return 0;
+    top[clusters] = longest;
+    total[clusters] = 0;
+    count[clusters] = 0;
+    below = (longest > margin) ? longest - margin : 0;
+    clusters++;
   }
-  return result;
+  const uint8_t bits = normalisedBits(clusters);
+  const uint16_t used = 1 + clusters * 2 + 2 + (length * bits + 7) / 8;
+  if (used > size) return 0;
+  memset(output, 0, used);
+  uint8_t * const indices = output + 1 + clusters * 2 + 2;
+  for (uint16_t i = 0; i < length; i++) {
+    const uint32_t usecs = std::min((uint32_t)decode->rawbuf[i + 1] * kRawTick,
+                                    (uint32_t)UINT16_MAX);
+    uint8_t c = 0;  // The last (shortest) cluster it isn't shorter than.
+    while (c + 1 < clusters && usecs + margin < top[c]) c++;
+    total[c] += usecs;
+    count[c]++;
+    const uint16_t bit = i * bits;
+    indices[bit / 8] |= c << (bit % 8);
+  }
+  output[0] = clusters;
+  for (uint8_t c = 0; c < clusters; c++) {
+    const uint16_t average = (total[c] + count[c] / 2) / count[c];
+    output[1 + c * 2] = average;
+    output[2 + c * 2] = average >> 8;
+  }
+  output[1 + clusters * 2] = length;
+  output[2 + clusters * 2] = length >> 8;
+  return used;
+}
+
+/// The nr. of marks & spaces in a normalised capture.
+/// @param[in] code A ptr to the normalised capture. See `normaliseCapture()`.
+/// @param[in] size The nr. of bytes of it.
+/// @return The nr. of marks & spaces. 0 if it isn't a valid one.
+uint16_t normalisedLength(const uint8_t * const code, const uint16_t size) {
+  if (size < 1 || code[0] == 0 || code[0] > kNormalisePaletteMax) return 0;
+  const uint16_t header = 1 + code[0] * 2 + 2;
+  if (size < header) return 0;
+  const uint16_t length = code[header - 2] | (code[header - 1] << 8);
+  if (size < header + ((uint32_t)length * normalisedBits(code[0]) + 7) / 8)
+    return 0;
+  return length;
+}
+
+/// A mark or space of a normalised capture.
+/// @param[in] code A ptr to the normalised capture. See `normaliseCapture()`.
+///   It must be valid. i.e. Checked with `normalisedLength()`.
+/// @param[in] index Which mark or space. Even ones are marks.
+/// @return Its duration. (usecs)
+uint16_t normalisedDuration(const uint8_t * const code, const uint16_t index) {
+  const uint8_t bits = normalisedBits(code[0]);
+  const uint32_t bit = (uint32_t)index * bits;
+  const uint8_t c = (code[1 + code[0] * 2 + 2 + bit / 8] >> (bit % 8)) &
+      ((1 << bits) - 1);
+  return code[1 + c * 2] | (code[2 + c * 2] << 8);
+}
+
+/// @cond IGNORE
+// Call `byte()` for each byte of an array before the first 4 byte boundary &
+// after the last whole 32 bit word, & `word()` for each whole aligned word in
+// between. i.e. So byte-wise calculations can be done a word at a time.
+// Note: The order bytes are in within a word depends on the CPU, so it is only
+//       for calculations where the order doesn't matter.
+template <typename BYTE, typename WORD>
+static void forEachWord(const uint8_t * const start, const uint16_t length,
+                        BYTE byte, WORD word) {
+  const uint8_t *ptr = start;
+  const uint8_t * const end = start + length;
+  for (; ptr < end && (reinterpret_cast<uintptr_t>(ptr) & 3); ptr++)
+    byte(*ptr);
+  for (; end - ptr >= 4; ptr += 4) {
+    uint32_t value;
+    memcpy(&value, __builtin_assume_aligned(ptr, 4), sizeof(value));
+    word(value);
+  }
+  for (; ptr < end; ptr++) byte(*ptr);
+}
+
+// Sum the four bytes of a word, when each is less than 64.
+static inline uint32_t sumSmallBytes(const uint32_t value) {
+  return (value * 0x01010101UL) >> 24;
 }
+/// @endcond
 
 /// Sum all the bytes of an array and return the least significant 8-bits of
 /// the result.
@@ -376,9 +1188,15 @@ uint16_t* resultToRawArray(const decode_results * const decode) {
 /// @return The 8-bit calculated result of all the bytes and init value.
 uint8_t sumBytes(const uint8_t * const start, const uint16_t length,
                  const uint8_t init) {
-  uint8_t checksum = init;
-  const uint8_t *ptr;
-  for (ptr = start; ptr - start < length; ptr++) checksum += *ptr;
+  uint32_t checksum = init;
+  forEachWord(start, length,
+              [&checksum](const uint8_t value) { checksum += value; },
+              [&checksum](const uint32_t value) {
+                // Add the bytes in pairs, as two 16 bit lanes.
+                const uint32_t pairs = (value & 0x00FF00FFUL) +
+                    ((value >> 8) & 0x00FF00FFUL);
+                checksum += pairs + (pairs >> 16);
+              });
   return checksum;
 }
 
@@ -389,9 +1207,13 @@ uint8_t sumBytes(const uint8_t * const start, const uint16_t length,
 /// @return The 8-bit calculated result of all the bytes and init value.
 uint8_t xorBytes(const uint8_t * const start, const uint16_t length,
                  const uint8_t init) {
-  uint8_t checksum = init;
-  const uint8_t *ptr;
-  for (ptr = start; ptr - start < length; ptr++) checksum ^= *ptr;
+  uint32_t checksum = init;
+  forEachWord(start, length,
+              [&checksum](const uint8_t value) { checksum ^= value; },
+              [&checksum](const uint32_t value) { checksum ^= value; });
+  // Fold the four byte lanes together.
+  checksum ^= checksum >> 16;
+  checksum ^= checksum >> 8;
   return checksum;
 }
 
@@ -404,11 +1226,11 @@ uint8_t xorBytes(const uint8_t * const start, const uint16_t length,
 uint16_t countBits(const uint8_t * const start, const uint16_t length,
                    const bool ones, const uint16_t init) {
   uint16_t count = init;
-  for (uint16_t offset = 0; offset < length; offset++)
-    for (uint8_t currentbyte = *(start + offset);
-         currentbyte;
-         currentbyte >>= 1)
-      if (currentbyte & 1) count++;
+  forEachWord(start, length,
+              [&count](const uint8_t value) {
+                count += __builtin_popcount(value); },
+              [&count](const uint32_t value) {
+                count += __builtin_popcountl(value); });
   if (ones || length == 0)
     return count;
   else
@@ -423,11 +1245,9 @@ uint16_t countBits(const uint8_t * const start, const uint16_t length,
 /// @return The nr. of bits found of the given type found in the Integer.
 uint16_t countBits(const uint64_t data, const uint8_t length, const bool ones,
                    const uint16_t init) {
-  uint16_t count = init;
-  uint8_t bitsSoFar = length;
-  for (uint64_t remainder = data; remainder && bitsSoFar;
-       remainder >>= 1, bitsSoFar--)
-      if (remainder & 1) count++;
+  const uint64_t wanted = (length >= sizeof(data) * 8) ?
+      data : data & ((1ULL << length) - 1);
+  const uint16_t count = init + __builtin_popcountll(wanted);
   if (ones || length == 0)
     return count;
   else
@@ -454,7 +1274,70 @@ float celsiusToFahrenheit(const float deg) { return (deg * 9.0) / 5.0 + 32.0; }
 /// Convert degrees Fahrenheit to degrees Celsius.
 float fahrenheitToCelsius(const float deg) { return (deg - 32.0) * 5.0 / 9.0; }
 
+/// Divide and round to the nearest whole number, with halves rounded away
+/// from zero. Integer only, so it is cheap on cores without an FPU.
+static int32_t divRound(const int32_t num, const int32_t den) {
+  return (num < 0) ? (num - den / 2) / den : (num + den / 2) / den;
+}
+
+/// Convert tenths of a degree Celsius to tenths of a degree Fahrenheit.
+/// @param[in] deg10 The temperature in tenths of a degree Celsius.
+/// @return The temperature in tenths of a degree Fahrenheit. (Rounded)
+/// @note Fixed-point equivalent of `celsiusToFahrenheit()`.
+int16_t celsiusToFahrenheitTenths(const int16_t deg10) {
+  return divRound(static_cast<int32_t>(deg10) * 9, 5) + 320;
+}
+
+/// Convert tenths of a degree Fahrenheit to tenths of a degree Celsius.
+/// @param[in] deg10 The temperature in tenths of a degree Fahrenheit.
+/// @return The temperature in tenths of a degree Celsius. (Rounded)
+/// @note Fixed-point equivalent of `fahrenheitToCelsius()`.
+int16_t fahrenheitToCelsiusTenths(const int16_t deg10) {
+  return divRound((static_cast<int32_t>(deg10) - 320) * 5, 9);
+}
+
 namespace irutils {
+  /// Append a number to a String, without making a String of it first.
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] value The number to append.
+  static void appendUint(String *result, uint32_t value) {
+    char digits[11];  // Enough for UINT32_MAX & a '\0'.
+    uint8_t i = sizeof(digits) - 1;
+    digits[i] = '\0';
+    do {
+      digits[--i] = '0' + value % 10;
+      value /= 10;
+    } while (value);
+    *result += digits + i;
+  }
+
+  /// Append a colon separated "label: value" pair suitable for Humans to a
+  /// String.
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] value The value to come after the label.
+  /// @param[in] label The label to precede the value.
+  /// @param[in] precomma Should the output string start with ", " or not?
+  /// @note The `String *` versions of these functions append in place, so a
+  ///   `toString()` that has reserved enough room needs no more heap.
+  void addLabeledString(String *result, const char *value, const char *label,
+                        const bool precomma) {
+    if (precomma) *result += kCommaSpaceStr;
+    *result += label;
+    *result += kColonSpaceStr;
+    *result += value;
+  }
+
+  /// Append a colon separated "label: value" pair suitable for Humans to a
+  /// String.
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] value The value to come after the label.
+  /// @param[in] label The label to precede the value.
+  /// @param[in] precomma Should the output string start with ", " or not?
+  void addLabeledString(String *result, const String &value, const char *label,
+                        const bool precomma) {
+    addLabeledString(result, value.c_str(), label, precomma);
+  }
+
   /// Create a String with a colon separated "label: value" pair suitable for
   /// Humans.
   /// @param[in] value The value to come after the label.
@@ -464,10 +1347,19 @@ namespace irutils {
   String addLabeledString(const String value, const String label,
                           const bool precomma) {
     String result = "";
-    if (precomma) result += kCommaSpaceStr;
-    result += label;
-    result += kColonSpaceStr;
-    return result + value;
+    addLabeledString(&result, value, label.c_str(), precomma);
+    return result;
+  }
+
+  /// Append a colon separated flag suitable for Humans to a String.
+  /// e.g. "Power: On"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] value The value to come after the label.
+  /// @param[in] label The label to precede the value.
+  /// @param[in] precomma Should the output string start with ", " or not?
+  void addBoolToString(String *result, const bool value, const char *label,
+                       const bool precomma) {
+    addLabeledString(result, value ? kOnStr : kOffStr, label, precomma);
   }
 
   /// Create a String with a colon separated flag suitable for Humans.
@@ -478,7 +1370,21 @@ namespace irutils {
   /// @return The resulting String.
   String addBoolToString(const bool value, const String label,
                          const bool precomma) {
-    return addLabeledString((value ? kOnStr : kOffStr), label, precomma);
+    String result = "";
+    addBoolToString(&result, value, label.c_str(), precomma);
+    return result;
+  }
+
+  /// Append a colon separated labeled Integer suitable for Humans to a String.
+  /// e.g. "Foo: 23"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] value The value to come after the label.
+  /// @param[in] label The label to precede the value.
+  /// @param[in] precomma Should the output string start with ", " or not?
+  void addIntToString(String *result, const uint16_t value, const char *label,
+                      const bool precomma) {
+    addLabeledString(result, "", label, precomma);
+    appendUint(result, value);
   }
 
   /// Create a String with a colon separated labeled Integer suitable for
@@ -490,7 +1396,9 @@ namespace irutils {
   /// @return The resulting String.
   String addIntToString(const uint16_t value, const String label,
                         const bool precomma) {
-    return addLabeledString(uint64ToString(value), label, precomma);
+    String result = "";
+    addIntToString(&result, value, label.c_str(), precomma);
+    return result;
   }
 
   /// Generate the model string for a given Protocol/Model pair.
@@ -561,6 +1469,20 @@ namespace irutils {
     }
   }
 
+  /// Append human output for a given protocol model number to a String.
+  /// e.g. "Model: 4 (JKE)"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] protocol The IR protocol.
+  /// @param[in] model The model number for that protocol.
+  /// @param[in] precomma Should the output string start with ", " or not?
+  void addModelToString(String *result, const decode_type_t protocol,
+                        const int16_t model, const bool precomma) {
+    addIntToString(result, model, kModelStr, precomma);
+    *result += kSpaceLBraceStr;
+    *result += modelToStr(protocol, model);
+    *result += ')';
+  }
+
   /// Create a String of human output for a given protocol model number.
   /// e.g. "Model: JKE"
   /// @param[in] protocol The IR protocol.
@@ -569,10 +1491,22 @@ namespace irutils {
   /// @return The resulting String.
   String addModelToString(const decode_type_t protocol, const int16_t model,
                           const bool precomma) {
-    String result = addIntToString(model, kModelStr, precomma);
-    result += kSpaceLBraceStr;
-    result += modelToStr(protocol, model);
-    return result + ')';
+    String result = "";
+    addModelToString(&result, protocol, model, precomma);
+    return result;
+  }
+
+  /// Append human output for a given temperature to a String.
+  /// e.g. "Temp: 25C"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] degrees The temperature in degrees.
+  /// @param[in] celsius Is the temp Celsius or Fahrenheit.
+  ///  true is C, false is F
+  /// @param[in] precomma Should the output string start with ", " or not?
+  void addTempToString(String *result, const uint16_t degrees,
+                       const bool celsius, const bool precomma) {
+    addIntToString(result, degrees, kTempStr, precomma);
+    *result += celsius ? 'C' : 'F';
   }
 
   /// Create a String of human output for a given temperature.
@@ -584,11 +1518,36 @@ namespace irutils {
   /// @return The resulting String.
   String addTempToString(const uint16_t degrees, const bool celsius,
                          const bool precomma) {
-    String result = addIntToString(degrees, kTempStr, precomma);
-    result += celsius ? 'C' : 'F';
+    String result = "";
+    addTempToString(&result, degrees, celsius, precomma);
     return result;
   }
 
+  /// Append human output for the given operating mode to a String.
+  /// e.g. "Mode: 1 (Cool)"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] mode The operating mode to display.
+  /// @param[in] automatic The numeric value for Auto mode.
+  /// @param[in] cool The numeric value for Cool mode.
+  /// @param[in] heat The numeric value for Heat mode.
+  /// @param[in] dry The numeric value for Dry mode.
+  /// @param[in] fan The numeric value for Fan mode.
+  void addModeToString(String *result, const uint8_t mode,
+                       const uint8_t automatic, const uint8_t cool,
+                       const uint8_t heat, const uint8_t dry,
+                       const uint8_t fan) {
+    addIntToString(result, mode, kModeStr);
+    *result += kSpaceLBraceStr;
+    if (mode == automatic) *result += kAutoStr;
+    else if (mode == cool) *result += kCoolStr;
+    else if (mode == heat) *result += kHeatStr;
+    else if (mode == dry) *result += kDryStr;
+    else if (mode == fan) *result += kFanStr;
+    else
+      *result += kUnknownStr;
+    *result += ')';
+  }
+
   /// Create a String of human output for the given operating mode.
   /// e.g. "Mode: 1 (Cool)"
   /// @param[in] mode The operating mode to display.
@@ -601,16 +1560,30 @@ namespace irutils {
   String addModeToString(const uint8_t mode, const uint8_t automatic,
                          const uint8_t cool, const uint8_t heat,
                          const uint8_t dry, const uint8_t fan) {
-    String result = addIntToString(mode, kModeStr);
-    result += kSpaceLBraceStr;
-    if (mode == automatic) result += kAutoStr;
-    else if (mode == cool) result += kCoolStr;
-    else if (mode == heat) result += kHeatStr;
-    else if (mode == dry) result += kDryStr;
-    else if (mode == fan) result += kFanStr;
-    else
-      result += kUnknownStr;
-    return result + ')';
+    String result = "";
+    addModeToString(&result, mode, automatic, cool, heat, dry, fan);
+    return result;
+  }
+
+  /// Append the 3-letter day of the week from a numerical day of the week to a
+  /// String. e.g. "Day: 1 (Mon)"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] day_of_week A numerical version of the sequential day of the
+  ///  week. e.g. Saturday = 7 etc.
+  /// @param[in] offset Days to offset by.
+  ///  e.g. For different day starting the week.
+  /// @param[in] precomma Should the output string start with ", " or not?
+  void addDayToString(String *result, const uint8_t day_of_week,
+                      const int8_t offset, const bool precomma) {
+    addIntToString(result, day_of_week, kDayStr, precomma);
+    *result += kSpaceLBraceStr;
+    if ((uint8_t)(day_of_week + offset) < 7) {
+      const char *day = kThreeLetterDayOfWeekStr + (day_of_week + offset) * 3;
+      for (uint8_t i = 0; i < 3; i++) *result += day[i];
+    } else {
+      *result += kUnknownStr;
+    }
+    *result += ')';
   }
 
   /// Create a String of the 3-letter day of the week from a numerical day of
@@ -623,19 +1596,34 @@ namespace irutils {
   /// @return The resulting String.
   String addDayToString(const uint8_t day_of_week, const int8_t offset,
                         const bool precomma) {
-    String result = addIntToString(day_of_week, kDayStr, precomma);
-    result += kSpaceLBraceStr;
-    if ((uint8_t)(day_of_week + offset) < 7)
-#if UNIT_TEST
-      result += String(kThreeLetterDayOfWeekStr).substr(
-          (day_of_week + offset) * 3, 3);
-#else  // UNIT_TEST
-      result += String(kThreeLetterDayOfWeekStr).substring(
-          (day_of_week + offset) * 3, (day_of_week + offset) * 3 + 3);
-#endif  // UNIT_TEST
+    String result = "";
+    addDayToString(&result, day_of_week, offset, precomma);
+    return result;
+  }
+
+  /// Append human output for the given fan speed to a String.
+  /// e.g. "Fan: 0 (Auto)"
+  /// @param[in,out] result A Ptr to the String to append to.
+  /// @param[in] speed The numeric speed of the fan to display.
+  /// @param[in] high The numeric value for High speed.
+  /// @param[in] low The numeric value for Low speed.
+  /// @param[in] automatic The numeric value for Auto speed.
+  /// @param[in] quiet The numeric value for Quiet speed.
+  /// @param[in] medium The numeric value for Medium speed.
+  void addFanToString(String *result, const uint8_t speed,
+                      const uint8_t high, const uint8_t low,
+                      const uint8_t automatic, const uint8_t quiet,
+                      const uint8_t medium) {
+    addIntToString(result, speed, kFanStr);
+    *result += kSpaceLBraceStr;
+    if (speed == high) *result += kHighStr;
+    else if (speed == low) *result += kLowStr;
+    else if (speed == automatic) *result += kAutoStr;
+    else if (speed == quiet) *result += kQuietStr;
+    else if (speed == medium) *result += kMediumStr;
     else
-      result += kUnknownStr;
-    return result + ')';
+      *result += kUnknownStr;
+    *result += ')';
   }
 
   /// Create a String of human output for the given fan speed.
@@ -650,16 +1638,9 @@ namespace irutils {
   String addFanToString(const uint8_t speed, const uint8_t high,
                         const uint8_t low, const uint8_t automatic,
                         const uint8_t quiet, const uint8_t medium) {
-    String result = addIntToString(speed, kFanStr);
-    result += kSpaceLBraceStr;
-    if (speed == high) result += kHighStr;
-    else if (speed == low) result += kLowStr;
-    else if (speed == automatic) result += kAutoStr;
-    else if (speed == quiet) result += kQuietStr;
-    else if (speed == medium) result += kMediumStr;
-    else
-     result += kUnknownStr;
-    return result + ')';
+    String result = "";
+    addFanToString(&result, speed, high, low, automatic, quiet, medium);
+    return result;
   }
 
   /// Escape any special HTML (unsafe) characters in a string. e.g. anti-XSS.
@@ -750,13 +1731,134 @@ namespace irutils {
   /// @return The 8-bit calculated result of all the bytes and init value.
   uint8_t sumNibbles(const uint8_t * const start, const uint16_t length,
                      const uint8_t init) {
-    uint8_t sum = init;
-    const uint8_t *ptr;
-    for (ptr = start; ptr - start < length; ptr++)
-      sum += (*ptr >> 4) + (*ptr & 0xF);
+    return sumLowNibbles(start, length, sumHighNibbles(start, length, init));
+  }
+
+  /// Sum the lower nibble of each byte in a series of bytes.
+  /// e.g. For the nibble checksums Kelvinator, Gree etc use.
+  /// @param[in] start A ptr to the start of the byte array to calculate over.
+  /// @param[in] length How many bytes to use in the calculation.
+  /// @param[in] init Starting value of the calculation to use. (Default is 0)
+  /// @return The 8-bit calculated result of all the nibbles and init value.
+  uint8_t sumLowNibbles(const uint8_t * const start, const uint16_t length,
+                        const uint8_t init) {
+    uint32_t sum = init;
+    forEachWord(start, length,
+                [&sum](const uint8_t value) { sum += value & 0xF; },
+                [&sum](const uint32_t value) {
+                  sum += sumSmallBytes(value & 0x0F0F0F0FUL); });
+    return sum;
+  }
+
+  /// Sum the upper nibble of each byte in a series of bytes.
+  /// @param[in] start A ptr to the start of the byte array to calculate over.
+  /// @param[in] length How many bytes to use in the calculation.
+  /// @param[in] init Starting value of the calculation to use. (Default is 0)
+  /// @return The 8-bit calculated result of all the nibbles and init value.
+  uint8_t sumHighNibbles(const uint8_t * const start, const uint16_t length,
+                         const uint8_t init) {
+    uint32_t sum = init;
+    forEachWord(start, length,
+                [&sum](const uint8_t value) { sum += value >> 4; },
+                [&sum](const uint32_t value) {
+                  sum += sumSmallBytes((value >> 4) & 0x0F0F0F0FUL); });
     return sum;
   }
 
+  /// @cond IGNORE
+  // Find the index of the checksum byte of a section of a state.
+  // Returns 0 if the state is too short to hold the section, or the section
+  // has no bytes to calculate the checksum over.
+  static uint16_t checksumIndex(const checksum_t &section,
+                                const uint16_t length) {
+    const uint16_t end = (section.length == kChecksumToEnd) ?
+        length : section.start + section.length;
+    if (end > length || end < section.start + 2) return 0;
+    return end - 1;
+  }
+
+  // The amount a single byte adds to a section's checksum.
+  static uint8_t checksumPart(const uint8_t method, const uint8_t value) {
+    if (method == kSumNibblesChecksum) return (value >> 4) + (value & 0xF);
+    return value;
+  }
+  /// @endcond
+
+  /// Calculate the checksum for a section of a state.
+  /// @param[in] section How the section's checksum is calculated.
+  /// @param[in] state A ptr to the state to calculate over.
+  /// @param[in] length The length of the state in bytes.
+  /// @return The calculated checksum value, or 0 if the state is too short.
+  uint8_t calcChecksum(const checksum_t &section, const uint8_t * const state,
+                       const uint16_t length) {
+    const uint16_t index = checksumIndex(section, length);
+    if (!index) return 0;
+    const uint8_t * const start = state + section.start;
+    const uint16_t size = index - section.start;
+    switch (section.method) {
+      case kXorBytesChecksum: return xorBytes(start, size, section.init);
+      case kSumNibblesChecksum: return sumNibbles(start, size, section.init);
+      default: return sumBytes(start, size, section.init);
+    }
+  }
+
+  /// Verify the checksums of a state.
+  /// @param[in] sections A table of the checksum sections of the protocol.
+  /// @param[in] count The nr. of entries in the `sections` table.
+  /// @param[in] state A ptr to the state to be checked.
+  /// @param[in] length The length of the state in bytes.
+  /// @return true, if every section is present & has a valid checksum.
+  bool validChecksums(const checksum_t sections[], const uint8_t count,
+                      const uint8_t * const state, const uint16_t length) {
+    for (uint8_t i = 0; i < count; i++) {
+      const uint16_t index = checksumIndex(sections[i], length);
+      if (!index || state[index] != calcChecksum(sections[i], state, length))
+        return false;
+    }
+    return true;
+  }
+
+  /// Calculate & set all the checksums of a state.
+  /// @param[in] sections A table of the checksum sections of the protocol.
+  /// @param[in] count The nr. of entries in the `sections` table.
+  /// @param[in,out] state A ptr to the state to be updated.
+  /// @param[in] length The length of the state in bytes.
+  void setChecksums(const checksum_t sections[], const uint8_t count,
+                    uint8_t * const state, const uint16_t length) {
+    for (uint8_t i = 0; i < count; i++) {
+      const uint16_t index = checksumIndex(sections[i], length);
+      if (index) state[index] = calcChecksum(sections[i], state, length);
+    }
+  }
+
+  /// Change a single byte of a state, and adjust the checksums covering it to
+  /// suit, rather than recalculating them from scratch.
+  /// @param[in] sections A table of the checksum sections of the protocol.
+  /// @param[in] count The nr. of entries in the `sections` table.
+  /// @param[in,out] state A ptr to the state to be updated.
+  /// @param[in] length The length of the state in bytes.
+  /// @param[in] index The index of the byte to change.
+  /// @param[in] value The new value of that byte.
+  /// @note The checksums need to be valid beforehand for them to be valid
+  ///   afterwards.
+  void updateChecksums(const checksum_t sections[], const uint8_t count,
+                       uint8_t * const state, const uint16_t length,
+                       const uint16_t index, const uint8_t value) {
+    if (index >= length) return;
+    const uint8_t old = state[index];
+    state[index] = value;
+    for (uint8_t i = 0; i < count; i++) {
+      const uint16_t checksum = checksumIndex(sections[i], length);
+      if (index < sections[i].start || index >= checksum) continue;
+      const uint8_t method = sections[i].method;
+      if (method == kXorBytesChecksum)
+        state[checksum] ^= old ^ value;
+      else
+        state[checksum] += checksumPart(method, value) -
+            checksumPart(method, old);
+    }
+  }
+
   /// Sum all the nibbles together in an integer.
   /// @param[in] data The integer to be summed.
   /// @param[in] count The number of nibbles to sum. Starts from LSB. Max of 16.
@@ -924,6 +2026,522 @@ namespace irutils {
     *dst |= ((data & mask) << offset);
   }
 
+  /// Constructor for writing JSON into a buffer.
+  /// @param[out] buffer A ptr to the buffer to store the NUL terminated JSON.
+  /// @param[in] size The size of the buffer in bytes.
+  JsonWriter::JsonWriter(char *buffer, const uint16_t size) :
+      _buffer(buffer), _size(size), _length(0), _overflow(false),
+      _first(true) {
+#ifdef ARDUINO
+    _print = NULL;
+#endif  // ARDUINO
+    if (_size) _buffer[0] = '\0';
+  }
+
+#ifdef ARDUINO
+  /// Constructor for writing JSON straight to a stream.
+  /// @param[in,out] output A ptr to where to print it. e.g. `&Serial`.
+  JsonWriter::JsonWriter(Print *output) :
+      _buffer(NULL), _size(0), _length(0), _overflow(false), _first(true),
+      _print(output) {}
+#endif  // ARDUINO
+
+  /// Write a single character of JSON.
+  /// @param[in] c The character.
+  void JsonWriter::put(const char c) {
+#ifdef ARDUINO
+    if (_print != NULL) {
+      _print->write(c);
+      _length++;
+      return;
+    }
+#endif  // ARDUINO
+    if (_length + 1 < _size) {
+      _buffer[_length++] = c;
+      _buffer[_length] = '\0';
+    } else {
+      _overflow = true;
+    }
+  }
+
+  /// Write a string of JSON as is.
+  /// @param[in] str A ptr to the NUL terminated string.
+  void JsonWriter::put(const char *str) {
+    for (; *str; str++) put(*str);
+  }
+
+  /// Write a string as the contents of a JSON string, escaping it as needed.
+  /// @param[in] str A ptr to the NUL terminated string.
+  void JsonWriter::putEscaped(const char *str) {
+    for (; *str; str++) {
+      if (*str == '"' || *str == '\\') {
+        put('\\');
+        put(*str);
+      } else if ((uint8_t)*str < ' ') {  // Control chars use \u00XX.
+        put("\\u00");
+        put((char)pgm_read_byte(kHexDigits + (*str >> 4)));
+        put((char)pgm_read_byte(kHexDigits + (*str & 0xF)));
+      } else {
+        put(*str);
+      }
+    }
+  }
+
+  /// Write the key of an entry, and anything needed before it.
+  /// @param[in] key The name of the entry.
+  void JsonWriter::putKey(const char *key) {
+    if (!_first) put(',');
+    _first = false;
+    put('"');
+    putEscaped(key);
+    put("\":");
+  }
+
+  /// Start the JSON object.
+  void JsonWriter::begin(void) {
+    put('{');
+    _first = true;
+  }
+
+  /// Finish the JSON object.
+  void JsonWriter::end(void) {
+    put('}');
+    // Don't leave a truncated object behind.
+    if (_overflow && _size) _buffer[0] = '\0';
+  }
+
+  /// Add a string entry to the JSON object.
+  /// @param[in] key The name of the entry.
+  /// @param[in] value The string value of the entry.
+  void JsonWriter::add(const char *key, const char *value) {
+    putKey(key);
+    put('"');
+    putEscaped(value);
+    put('"');
+  }
+
+  /// Add an unsigned integer entry to the JSON object.
+  /// @param[in] key The name of the entry.
+  /// @param[in] value The value of the entry.
+  void JsonWriter::add(const char *key, const uint64_t value) {
+    char digits[kUint64ToCharsSize];
+    uint64ToChars(digits, value);
+    putKey(key);
+    put(digits);
+  }
+
+  /// Add a signed integer entry to the JSON object.
+  /// @param[in] key The name of the entry.
+  /// @param[in] value The value of the entry.
+  void JsonWriter::add(const char *key, const int32_t value) {
+    char digits[kUint64ToCharsSize];
+    uint64ToChars(digits, (value < 0) ? -(int64_t)value : value);
+    putKey(key);
+    if (value < 0) put('-');
+    put(digits);
+  }
+
+  /// Add a number entry to the JSON object, to 2 decimal places at most.
+  /// @param[in] key The name of the entry.
+  /// @param[in] value The value of the entry.
+  void JsonWriter::add(const char *key, const float value) {
+    const bool negative = value < 0;
+    const uint64_t hundredths = (negative ? -value : value) * 100 + 0.5;
+    char digits[kUint64ToCharsSize];
+    uint64ToChars(digits, hundredths / 100);
+    putKey(key);
+    if (negative && hundredths) put('-');
+    put(digits);
+    const uint8_t fraction = hundredths % 100;
+    if (fraction) {
+      put('.');
+      put('0' + fraction / 10);
+      if (fraction % 10) put('0' + fraction % 10);
+    }
+  }
+
+  /// Add a boolean entry to the JSON object.
+  /// @param[in] key The name of the entry.
+  /// @param[in] value The value of the entry.
+  void JsonWriter::add(const char *key, const bool value) {
+    putKey(key);
+    put(value ? "true" : "false");
+  }
+
+  /// Add an integer entry to the JSON object, as a hexadecimal string.
+  /// @param[in] key The name of the entry.
+  /// @param[in] value The value of the entry.
+  void JsonWriter::addHex(const char *key, const uint64_t value) {
+    char digits[kUint64ToCharsSize];
+    uint64ToChars(digits, value, 16);
+    putKey(key);
+    put("\"0x");
+    put(digits);
+    put('"');
+  }
+
+  /// Add an array of bytes to the JSON object, as a hexadecimal string.
+  /// @param[in] key The name of the entry.
+  /// @param[in] data A ptr to the bytes.
+  /// @param[in] length Nr. of bytes.
+  void JsonWriter::addHex(const char *key, const uint8_t * const data,
+                          const uint16_t length) {
+    putKey(key);
+    put("\"0x");
+    for (uint16_t i = 0; i < length; i++) {
+      put((char)pgm_read_byte(kHexDigits + (data[i] >> 4)));
+      put((char)pgm_read_byte(kHexDigits + (data[i] & 0xF)));
+    }
+    put('"');
+  }
+
+  /// Get the nr. of characters of JSON written so far.
+  /// @return The length.
+  uint16_t JsonWriter::length(void) const { return _length; }
+
+  /// Has the buffer run out of room for the JSON?
+  /// @return true, if the JSON was truncated & is invalid.
+  bool JsonWriter::overflowed(void) const { return _overflow; }
+
+#if ENABLE_MEMORY_PROFILING
+  /// Start measuring the memory an entry point uses, if profiling.
+  /// @param[in] api The entry point.
+  MemoryProbe::MemoryProbe(const mem_probe_t api) :
+      _api(api), _active(mem_stack_depth && !mem_probing), _heap(0),
+      _painted(0) {
+    if (!_active) return;
+    mem_probing = true;
+    _heap = memHeapFree();
+    _painted = memPaintStack(mem_stack_depth);
+  }
+
+  /// Finish measuring, & record it if it is the most the entry point has used.
+  MemoryProbe::~MemoryProbe(void) {
+    if (!_active) return;
+    mem_profile_t *usage = &mem_profile[_api];
+    usage->calls++;
+    usage->stack = std::max(usage->stack,
+                            memStackUsed(_painted, (uintptr_t)this));
+    const int32_t heap = _heap - memHeapFree();
+    if (usage->calls == 1 || heap > usage->heap) usage->heap = heap;
+    mem_probing = false;
+  }
+#endif  // ENABLE_MEMORY_PROFILING
+
+  // Capture files.
+  // A compact container of captures, so field captures can be recorded, &
+  // read in place (e.g. mmap()'ed) rather than pasted in as C arrays.
+  // All values are little-endian. The layout is:
+  //   File header: "IRcf", version (1 byte), 0 (1), usecs per tick (2).
+  //   Captures, each a multiple of 4 bytes so their headers stay aligned:
+  //     Size of the capture incl. its header (4), protocol (2),
+  //     frequency in kHz (2), timestamp (4), rawlen (2), flags (1),
+  //     0 (1), then each `rawbuf[]` entry as the zigzag LEB128 difference
+  //     to the entry two before it. i.e. To the previous mark (or space),
+  //     as they mostly repeat. Then 0 padding.
+  //   Index (optional): The file offset of each capture (4 each), then the
+  //     nr. of captures (4), & "IRix". A file without one (e.g. an
+  //     unfinished recording) can still be read, in order.
+  // e.g. Recording each capture to SPIFFS, as it arrives:
+  //   File file = SPIFFS.open("/captures.irc", "w");
+  //   irutils::CaptureWriter writer(&file);
+  //   writer.begin();
+  //   ... writer.add(&results, 38, millis()); file.flush(); ...
+  //   writer.end();  // Writes the index, if given room for one.
+  const uint8_t kCaptureFileMagic[4] = {'I', 'R', 'c', 'f'};
+  const uint8_t kCaptureIndexMagic[4] = {'I', 'R', 'i', 'x'};
+  const uint8_t kCaptureFlagOverflow = 0b1;
+
+  /// Zigzag encode the difference between two `rawbuf[]` entries.
+  /// @param[in] previous The entry it is relative to.
+  /// @param[in] current The entry.
+  /// @return The difference, as an unsigned value. Small either way.
+  static uint32_t captureDelta(const uint16_t previous,
+                               const uint16_t current) {
+    const int32_t delta = (int32_t)current - previous;
+    return (delta < 0) ? (((uint32_t)-delta) << 1) - 1 : (uint32_t)delta << 1;
+  }
+
+  /// Nr. of bytes a LEB128 encoded value takes.
+  /// @param[in] value The value.
+  /// @return The nr. of bytes.
+  static uint8_t captureVarSize(uint32_t value) {
+    uint8_t nbytes = 1;
+    for (; value > 0x7F; value >>= 7) nbytes++;
+    return nbytes;
+  }
+
+  /// Read a little-endian value.
+  /// @param[in] ptr A ptr to the value.
+  /// @param[in] nbytes The size of it. Up to 4.
+  /// @return The value.
+  static uint32_t captureGet(const uint8_t *ptr, const uint8_t nbytes) {
+    uint32_t value = 0;
+    for (uint8_t i = nbytes; i; i--) value = (value << 8) | ptr[i - 1];
+    return value;
+  }
+
+  /// Constructor for writing a capture file into a buffer.
+  /// @param[out] buffer A ptr to the buffer to store it in.
+  /// @param[in] size The size of the buffer in bytes.
+  /// @param[out] index A ptr to where to keep the offset of each capture, so
+  ///   an index can be written by `end()`. NULL means no index.
+  /// @param[in] index_size Nr. of entries `index` has room for. If there are
+  ///   more captures than that, no index is written.
+  CaptureWriter::CaptureWriter(uint8_t *buffer, const uint32_t size,
+                               uint32_t *index, const uint32_t index_size) :
+      _buffer(buffer), _size(size), _used(0), _length(0), _index(index),
+      _index_size(index_size), _count(0), _overflow(false) {
+#ifdef ARDUINO
+    _print = NULL;
+#endif  // ARDUINO
+  }
+
+#ifdef ARDUINO
+  /// Constructor for writing a capture file straight to a stream.
+  /// @param[in,out] output A ptr to where to write it. e.g. A SPIFFS `File`.
+  /// @param[out] index A ptr to where to keep the offset of each capture, so
+  ///   an index can be written by `end()`. NULL means no index.
+  /// @param[in] index_size Nr. of entries `index` has room for.
+  CaptureWriter::CaptureWriter(Print *output, uint32_t *index,
+                               const uint32_t index_size) :
+      _buffer(NULL), _size(0), _used(0), _length(0), _index(index),
+      _index_size(index_size), _count(0), _overflow(false), _print(output) {}
+#endif  // ARDUINO
+
+  /// Check there is room to write something whole, so a file in a buffer is
+  /// never left with part of something in it.
+  /// @param[in] nbytes The size of it.
+  /// @return true, if there is room.
+  bool CaptureWriter::reserve(const uint32_t nbytes) {
+#ifdef ARDUINO
+    if (_print != NULL) return true;
+#endif  // ARDUINO
+    if (!_overflow && nbytes <= _size - _used) return true;
+    _overflow = true;
+    return false;
+  }
+
+  /// Write a byte of the file.
+  /// @param[in] byte The byte.
+  void CaptureWriter::put(const uint8_t byte) {
+    _length++;
+#ifdef ARDUINO
+    if (_print != NULL) {
+      _print->write(byte);
+      return;
+    }
+#endif  // ARDUINO
+    _buffer[_used++] = byte;
+  }
+
+  /// Write a little-endian value.
+  /// @param[in] value The value.
+  /// @param[in] nbytes The size of it. Up to 4.
+  void CaptureWriter::put(const uint32_t value, const uint8_t nbytes) {
+    for (uint8_t i = 0; i < nbytes; i++) put((uint8_t)(value >> (i * 8)));
+  }
+
+  /// Nr. of bytes a capture takes in a capture file.
+  /// @param[in] results A ptr to the capture.
+  /// @return The nr. of bytes, incl. its header & padding.
+  uint32_t CaptureWriter::recordSize(const decode_results * const results) {
+    uint32_t size = kCaptureRecordHeaderSize;
+    for (uint16_t i = 0; i < results->rawlen; i++)
+      size += captureVarSize(captureDelta(i > 1 ? results->rawbuf[i - 2] : 0,
+                                          results->rawbuf[i]));
+    return (size + 3) & ~(uint32_t)3;
+  }
+
+  /// Start the capture file. i.e. Write its header.
+  void CaptureWriter::begin(void) {
+    if (!reserve(kCaptureFileHeaderSize)) return;
+    for (uint8_t i = 0; i < sizeof(kCaptureFileMagic); i++)
+      put(kCaptureFileMagic[i]);
+    put(kCaptureFileVersion);
+    put((uint8_t)0);
+    put(kRawTick, 2);
+  }
+
+  /// Add a capture to the capture file.
+  /// @param[in] results A ptr to the capture. Its `decode_type` is kept as a
+  ///   hint of what protocol it is.
+  /// @param[in] frequency The carrier frequency, in kHz.
+  /// @param[in] timestamp When it was captured. e.g. `millis()`
+  /// @return true, if it was added. false, if there wasn't room for it.
+  bool CaptureWriter::add(const decode_results * const results,
+                          const uint16_t frequency, const uint32_t timestamp) {
+    const uint32_t size = recordSize(results);
+    if (!reserve(size)) return false;
+    if (_index != NULL && _count < _index_size) _index[_count] = _length;
+    _count++;
+    const uint32_t start = _length;
+    put(size, 4);
+    put((uint16_t)results->decode_type, 2);
+    put(frequency, 2);
+    put(timestamp, 4);
+    put(results->rawlen, 2);
+    put((uint8_t)(results->overflow ? kCaptureFlagOverflow : 0));
+    put((uint8_t)0);
+    for (uint16_t i = 0; i < results->rawlen; i++) {
+      uint32_t value = captureDelta(i > 1 ? results->rawbuf[i - 2] : 0,
+                                    results->rawbuf[i]);
+      for (; value > 0x7F; value >>= 7) put((uint8_t)(value | 0x80));
+      put((uint8_t)value);
+    }
+    while (_length - start < size) put((uint8_t)0);
+    return true;
+  }
+
+  /// Finish the capture file. i.e. Write its index, if it can have one.
+  void CaptureWriter::end(void) {
+    if (_index == NULL || _count > _index_size ||
+        !reserve(_count * 4 + kCaptureIndexTrailerSize)) return;
+    for (uint32_t i = 0; i < _count; i++) put(_index[i], 4);
+    put(_count, 4);
+    for (uint8_t i = 0; i < sizeof(kCaptureIndexMagic); i++)
+      put(kCaptureIndexMagic[i]);
+  }
+
+  /// Nr. of bytes of the capture file written so far.
+  /// @return The nr. of bytes.
+  uint32_t CaptureWriter::length(void) const { return _length; }
+
+  /// Nr. of captures written so far.
+  /// @return The nr. of captures.
+  uint32_t CaptureWriter::count(void) const { return _count; }
+
+  /// Nr. of bytes in the buffer that haven't been `flush()`ed yet.
+  /// @return The nr. of bytes.
+  uint32_t CaptureWriter::pending(void) const { return _used; }
+
+  /// Mark the contents of the buffer as saved elsewhere, so the buffer can be
+  /// reused. e.g. After writing `pending()` bytes of it to a file. This lets
+  /// a buffer smaller than the file be used.
+  void CaptureWriter::flush(void) { _used = 0; }
+
+  /// Did the buffer run out of room? i.e. Was something not written.
+  /// @return true, if it did.
+  bool CaptureWriter::overflowed(void) const { return _overflow; }
+
+  /// Constructor for reading a capture file in place.
+  /// @param[in] data A ptr to the contents of the file.
+  /// @param[in] size The size of the file in bytes.
+  CaptureReader::CaptureReader(const uint8_t *data, const uint32_t size) :
+      _data(data), _end(size), _index(NULL), _count(0),
+      _pos(kCaptureFileHeaderSize), _valid(false) {
+    if (data == NULL || size < kCaptureFileHeaderSize ||
+        memcmp(data, kCaptureFileMagic, sizeof(kCaptureFileMagic)) ||
+        data[4] != kCaptureFileVersion) return;
+    _valid = true;
+    if (size < kCaptureFileHeaderSize + kCaptureIndexTrailerSize ||
+        memcmp(data + size - sizeof(kCaptureIndexMagic), kCaptureIndexMagic,
+               sizeof(kCaptureIndexMagic))) return;  // No index.
+    const uint32_t count = captureGet(data + size - kCaptureIndexTrailerSize,
+                                      4);
+    if (count > (size - kCaptureFileHeaderSize - kCaptureIndexTrailerSize) / 4)
+      return;  // Not really an index then.
+    _count = count;
+    _end = size - kCaptureIndexTrailerSize - count * 4;
+    _index = data + _end;
+  }
+
+  /// Does the data look like a capture file?
+  /// @return true, if it does.
+  bool CaptureReader::valid(void) const { return _valid; }
+
+  /// Does the capture file have an index?
+  /// @return true, if it does. If not, captures are found by reading them all.
+  bool CaptureReader::indexed(void) const { return _index != NULL; }
+
+  /// Read the header of the capture at a given offset.
+  /// @param[in] offset The offset of the capture in the file.
+  /// @param[out] capture Where to store it.
+  /// @return true, if there is a valid capture there.
+  bool CaptureReader::read(const uint32_t offset, capture_t *capture) const {
+    if (!_valid || offset < kCaptureFileHeaderSize || offset % 4 ||
+        offset > _end || _end - offset < kCaptureRecordHeaderSize) return false;
+    const uint8_t *ptr = _data + offset;
+    const uint32_t size = captureGet(ptr, 4);
+    if (size < kCaptureRecordHeaderSize || size % 4 || size > _end - offset)
+      return false;
+    capture->protocol = (decode_type_t)(int16_t)captureGet(ptr + 4, 2);
+    capture->frequency = captureGet(ptr + 6, 2);
+    capture->timestamp = captureGet(ptr + 8, 4);
+    capture->rawlen = captureGet(ptr + 12, 2);
+    capture->overflow = ptr[14] & kCaptureFlagOverflow;
+    capture->ticks = ptr + kCaptureRecordHeaderSize;
+    capture->size = size - kCaptureRecordHeaderSize;
+    return true;
+  }
+
+  /// Nr. of captures in the capture file.
+  /// @return The nr. of captures.
+  uint32_t CaptureReader::count(void) {
+    if (_index == NULL && _valid && !_count) {
+      capture_t capture;
+      for (uint32_t pos = kCaptureFileHeaderSize; read(pos, &capture);
+           pos += kCaptureRecordHeaderSize + capture.size) _count++;
+    }
+    return _count;
+  }
+
+  /// Get a given capture in the capture file.
+  /// @param[in] n Which capture. Starting from 0.
+  /// @param[out] capture Where to store it.
+  /// @return true, if there is such a capture.
+  bool CaptureReader::get(const uint32_t n, capture_t *capture) {
+    if (_index != NULL)
+      return n < _count && read(captureGet(_index + n * 4, 4), capture);
+    uint32_t pos = kCaptureFileHeaderSize;
+    for (uint32_t i = 0; read(pos, capture); i++) {
+      if (i == n) return true;
+      pos += kCaptureRecordHeaderSize + capture->size;
+    }
+    return false;
+  }
+
+  /// Get the next capture in the capture file. i.e. Iterate over them.
+  /// @param[out] capture Where to store it.
+  /// @return true, if there was another capture.
+  bool CaptureReader::next(capture_t *capture) {
+    if (!read(_pos, capture)) return false;
+    _pos += kCaptureRecordHeaderSize + capture->size;
+    return true;
+  }
+
+  /// Start iterating over the captures with `next()` from the first again.
+  void CaptureReader::rewind(void) { _pos = kCaptureFileHeaderSize; }
+
+  /// Decode the `rawbuf[]` entries (ticks) of a capture.
+  /// @param[in] capture The capture.
+  /// @param[out] rawbuf Where to store them. Note: `IRdecoder::decode()`
+  ///   needs room for one more entry than the capture has.
+  /// @param[in] size Nr. of entries `rawbuf` has room for.
+  /// @return Nr. of entries stored. 0, if the capture is corrupt.
+  uint16_t CaptureReader::unpack(const capture_t &capture, uint16_t *rawbuf,
+                                 const uint16_t size) {
+    const uint16_t entries = std::min(capture.rawlen, size);
+    uint32_t pos = 0;
+    for (uint16_t i = 0; i < entries; i++) {
+      uint32_t value = 0;
+      uint8_t byte;
+      uint8_t shift = 0;
+      do {
+        if (pos >= capture.size || shift > 14) return 0;
+        byte = capture.ticks[pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+      } while (byte & 0x80);
+      const int32_t delta = (value & 1) ? -(int32_t)((value + 1) >> 1)
+                                        : (int32_t)(value >> 1);
+      const int32_t entry = (i > 1 ? rawbuf[i - 2] : 0) + delta;
+      if (entry < 0 || entry > UINT16_MAX) return 0;
+      rawbuf[i] = entry;
+    }
+    return entries;
+  }
+
   /// Create byte pairs where the second byte of the pair is a bit
   /// inverted/flipped copy of the first/previous byte of the pair.
   /// @param[in,out] ptr A pointer to the start of array to modify.
@@ -947,7 +2565,15 @@ namespace irutils {
   /// @return true, if every second byte is inverted. Otherwise false.
   bool checkInvertedBytePairs(const uint8_t * const ptr,
                               const uint16_t length) {
-    for (uint16_t i = 1; i < length; i += 2) {
+    uint16_t i = 1;
+    // Check four pairs at a time. Each pair sits in its own 16 bits whatever
+    // the byte order, so the word-wide check works on the copied bytes as-is.
+    for (; i + 7 <= length; i += 8) {
+      uint64_t word;
+      memcpy(&word, ptr + i - 1, sizeof(word));
+      if (!checkInvertedBytePairs(word, 64)) return false;
+    }
+    for (; i < length; i += 2) {
       // Code done this way to avoid a compiler warning bug.
       uint8_t inv = ~*(ptr + i - 1);
       if (*(ptr + i) != inv) return false;
@@ -955,6 +2581,36 @@ namespace irutils {
     return true;
   }
 
+  /// Check a value to see if the second byte of every byte pair is a bit
+  /// inverted/flipped copy of the first byte of the pair. All at once.
+  /// i.e. The value as matched from a message that sends each byte, then its
+  ///   inverse. e.g. COOLIX & MIDEA24
+  /// @param[in] data The value to check. The first byte is the most
+  ///   significant.
+  /// @param[in] nbits Nr. of bits in `data`. A multiple of 16, & <= 64.
+  /// @return true, if every second byte is inverted. Otherwise false.
+  bool checkInvertedBytePairs(const uint64_t data, const uint16_t nbits) {
+    if (nbits == 0) return true;
+    // The second byte of each pair. i.e. 0x00FF00FF...
+    const uint64_t mask = 0x00FF00FF00FF00FFULL >> (64 - nbits);
+    // Each byte should have every bit flipped compared to the one before it.
+    return (((data >> 8) ^ data) & mask) == mask;
+  }
+
+  /// Remove the inverted copies from a value made of byte pairs.
+  /// @param[in] data The value of byte pairs. The first byte is the most
+  ///   significant.
+  /// @param[in] nbits Nr. of bits in `data`. A multiple of 16, & <= 64.
+  /// @return The first byte of each pair, in the same order. i.e. `nbits / 2`
+  ///   bits.
+  uint64_t dropInvertedBytes(const uint64_t data, const uint16_t nbits) {
+    if (nbits == 0) return 0;
+    uint64_t result = (data >> 8) & (0x00FF00FF00FF00FFULL >> (64 - nbits));
+    // Close up the gaps. i.e. 0x00AA00BB00CC00DD -> 0xAABBCCDD
+    result = (result | (result >> 8)) & 0x0000FFFF0000FFFFULL;
+    return (result | (result >> 16)) & 0xFFFFFFFFULL;
+  }
+
   /// Perform a low lovel bit manipulation sanity check for the given cpu
   /// architecture and the compiler operation. Calls to this should return
   /// 0 if everything is as expected, anything else means the library won't work
@@ -1007,4 +2663,165 @@ namespace irutils {
       result |= kEndiannessError;
     return result;
   }
+
+  /// Read the next value from a comma and/or whitespace separated list of
+  /// numbers, in place.
+  /// e.g. "38000,1,1,170,170", "0000, 006D, 0022, 0002" or "0000 006D 0022".
+  /// @param[in,out] str A ptr to the C string ptr to read from. It is moved to
+  ///   the start of the value after it, if one is read.
+  /// @param[out] value Where to store the value read.
+  /// @param[in] base The base the numbers are in. i.e. 10 or 16.
+  /// @return true, if a value was read. Otherwise false, & `str` is unchanged.
+  ///   If `**str` is then `'\0'`, the end of the string has been reached.
+  ///   Anything else means the text at that point isn't a valid value.
+  bool parseValue(const char **str, uint32_t *value, const uint8_t base) {
+    if (str == NULL || *str == NULL) return false;
+    const char *ptr = *str;
+    while (isspace((uint8_t)*ptr)) ptr++;
+    uint32_t result = 0;
+    uint8_t digits = 0;
+    for (;; ptr++, digits++) {
+      uint8_t digit;
+      if (*ptr >= '0' && *ptr <= '9')
+        digit = *ptr - '0';
+      else if (*ptr >= 'a' && *ptr <= 'z')
+        digit = *ptr - 'a' + 10;
+      else if (*ptr >= 'A' && *ptr <= 'Z')
+        digit = *ptr - 'A' + 10;
+      else
+        break;
+      if (digit >= base) break;
+      // Saturate, rather than overflow.
+      if (result > (UINT32_MAX - digit) / base)
+        result = UINT32_MAX;
+      else
+        result = result * base + digit;
+    }
+    if (!digits) {  // No value. Skip the whitespace if it was the end.
+      if (*ptr == '\0') *str = ptr;
+      return false;
+    }
+    if (*ptr != ',' && *ptr != '\0' && !isspace((uint8_t)*ptr))
+      return false;  // Garbage after the value.
+    while (isspace((uint8_t)*ptr)) ptr++;
+    if (*ptr == ',') ptr++;
+    *value = result;
+    *str = ptr;
+    return true;
+  }
+
+  /// Count the values in a comma and/or whitespace separated list of numbers.
+  /// @param[in] str The C string to count the values of.
+  /// @param[in] base The base the numbers are in. i.e. 10 or 16.
+  /// @return The nr. of values, or -1 if it contains anything that isn't one.
+  ///   See `parseValue()`.
+  int32_t countValues(const char *str, const uint8_t base) {
+    int32_t count = 0;
+    uint32_t value;
+    while (parseValue(&str, &value, base)) count++;
+    return (str != NULL && *str == '\0') ? count : -1;
+  }
+
+  /// Encode data as base64. (RFC 4648, with '=' padding)
+  /// @param[in] data The data to encode.
+  /// @param[in] length The nr. of bytes of data.
+  /// @return The base64 text.
+  String base64Encode(const uint8_t * const data, const uint16_t length) {
+    static const char kTable[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    String result = "";
+    result.reserve(((length + 2) / 3) * 4);
+    for (uint16_t i = 0; i < length; i += 3) {
+      uint32_t chunk = (uint32_t)data[i] << 16;
+      if (i + 1 < length) chunk |= (uint32_t)data[i + 1] << 8;
+      if (i + 2 < length) chunk |= data[i + 2];
+      result += kTable[(chunk >> 18) & 0x3F];
+      result += kTable[(chunk >> 12) & 0x3F];
+      result += (i + 1 < length) ? kTable[(chunk >> 6) & 0x3F] : '=';
+      result += (i + 2 < length) ? kTable[chunk & 0x3F] : '=';
+    }
+    return result;
+  }
+
+  /// Decode base64 text. See `base64Encode()`.
+  /// @param[in] str The C string to decode. The '=' padding is optional.
+  /// @param[out] data Where to store the decoded bytes.
+  /// @param[in] size The nr. of bytes `data` can hold.
+  /// @return The nr. of bytes decoded, or -1 if `str` isn't valid base64, or
+  ///   it doesn't fit.
+  int32_t base64Decode(const char *str, uint8_t * const data,
+                       const uint16_t size) {
+    if (str == NULL) return -1;
+    uint32_t chunk = 0;
+    uint8_t sextets = 0;
+    uint16_t length = 0;
+    for (; *str != '\0' && *str != '='; str++) {
+      uint8_t value;
+      if (*str >= 'A' && *str <= 'Z')
+        value = *str - 'A';
+      else if (*str >= 'a' && *str <= 'z')
+        value = *str - 'a' + 26;
+      else if (*str >= '0' && *str <= '9')
+        value = *str - '0' + 52;
+      else if (*str == '+')
+        value = 62;
+      else if (*str == '/')
+        value = 63;
+      else
+        return -1;
+      chunk = (chunk << 6) | value;
+      if (++sextets % 4 == 0) {  // Every 4 characters are 3 bytes.
+        if (length + 3 > size) return -1;
+        data[length++] = chunk >> 16;
+        data[length++] = chunk >> 8;
+        data[length++] = chunk;
+        chunk = 0;
+      }
+    }
+    // Only whole bytes may be left over. i.e. 2 or 3 characters.
+    switch (sextets % 4) {
+      case 0:
+        break;
+      case 2:
+        if (length + 1 > size) return -1;
+        data[length++] = chunk >> 4;
+        break;
+      case 3:
+        if (length + 2 > size) return -1;
+        data[length++] = chunk >> 10;
+        data[length++] = chunk >> 2;
+        break;
+      default:
+        return -1;
+    }
+    for (; *str == '='; str++) {}
+    return (*str == '\0') ? length : -1;
+  }
+
+  /// The ESP32's RMT memory blocks claimed so far. One bit per block.
+  /// i.e. Per channel, as each channel has a block of its own.
+  static uint8_t rmt_claimed = 0;
+
+  /// Claim some of the ESP32's RMT memory blocks for an `IRsend` or `IRrecv`.
+  /// A channel can also use the blocks of the channels after it, so the
+  /// sending & receiving channels have to share them out to run at once.
+  /// @param[in] first The first block. i.e. That of the channel.
+  /// @param[in] count Nr. of blocks, from `first` on.
+  /// @return true, if they were all free & are now claimed. Otherwise false,
+  ///   & none of them are claimed.
+  bool claimRmtBlocks(const uint8_t first, const uint8_t count) {
+    if (!count || first + count > kESP32RmtChannels) return false;
+    const uint8_t blocks = ((1U << count) - 1) << first;
+    if (rmt_claimed & blocks) return false;
+    rmt_claimed |= blocks;
+    return true;
+  }
+
+  /// Release RMT memory blocks claimed with `claimRmtBlocks()`.
+  /// @param[in] first The first block.
+  /// @param[in] count Nr. of blocks, from `first` on.
+  void releaseRmtBlocks(const uint8_t first, const uint8_t count) {
+    if (!count || first + count > kESP32RmtChannels) return;
+    rmt_claimed &= ~(((1U << count) - 1) << first);
+  }
 }  // namespace irutils
@@ -18,8 +18,18 @@ const uint8_t kNibbleSize = 4;
 const uint8_t kLowNibble = 0;
 const uint8_t kHighNibble = 4;
 const uint8_t kModeBitsSize = 3;
+/// Nr. of chars `uint64ToChars()` may need. i.e. 64 bits in base 2, plus a NUL.
+const uint8_t kUint64ToCharsSize = 64 + 1;
+// Capture files. See `irutils::CaptureWriter` for the layout.
+const uint8_t kCaptureFileVersion = 1;
+const uint8_t kCaptureFileHeaderSize = 8;
+const uint8_t kCaptureRecordHeaderSize = 16;
+const uint8_t kCaptureIndexTrailerSize = 8;
 uint64_t reverseBits(uint64_t input, uint16_t nbits);
+void reverseBytes(uint8_t * const data, const uint16_t length);
+uint8_t uint64ToChars(char *output, uint64_t input, uint8_t base = 10);
 String uint64ToString(uint64_t input, uint8_t base = 10);
+const char *typeToChars(const decode_type_t protocol);
 String typeToString(const decode_type_t protocol,
                     const bool isRepeat = false);
 void serialPrintUint64(uint64_t input, uint8_t base = 10);
@@ -27,9 +37,72 @@ String resultToSourceCode(const decode_results * const results);
 String resultToTimingInfo(const decode_results * const results);
 String resultToHumanReadableBasic(const decode_results * const results);
 String resultToHexidecimal(const decode_results * const result);
+String resultToPronto(const decode_results * const results,
+                      const uint32_t hz = 38000);
+String resultToGlobalCache(const decode_results * const results,
+                           const uint32_t hz = 38000);
+#ifdef ARDUINO
+void resultToSourceCode(Print *output, const decode_results * const results);
+void resultToTimingInfo(Print *output, const decode_results * const results);
+void resultToHumanReadableBasic(Print *output,
+                                const decode_results * const results);
+void resultToHexidecimal(Print *output, const decode_results * const result);
+void resultToPronto(Print *output, const decode_results * const results,
+                    const uint32_t hz = 38000);
+void resultToGlobalCache(Print *output, const decode_results * const results,
+                         const uint32_t hz = 38000);
+#endif  // ARDUINO
+uint16_t resultToJson(const decode_results * const results, char *output,
+                      const uint16_t size);
+#ifdef ARDUINO
+void resultToJson(Print *output, const decode_results * const results);
+#endif  // ARDUINO
 bool hasACState(const decode_type_t protocol);
 uint16_t getCorrectedRawLength(const decode_results * const results);
 uint16_t *resultToRawArray(const decode_results * const decode);
+uint16_t resultToRawArray(const decode_results * const decode,
+                          uint16_t * const output, const uint16_t size);
+// Timings within this of each other are the same, when normalising. (usecs)
+const uint16_t kNormaliseMargin = 200;
+// The most different timings a normalised capture can have.
+const uint8_t kNormalisePaletteMax = 16;
+uint16_t normaliseCapture(const decode_results * const decode,
+                          uint8_t * const output, const uint16_t size,
+                          const uint16_t margin = kNormaliseMargin);
+uint16_t normalisedLength(const uint8_t * const code, const uint16_t size);
+uint16_t normalisedDuration(const uint8_t * const code, const uint16_t index);
+#if ENABLE_DECODE_PROFILING
+String decodeProfileToString(IRrecv * const irrecv);
+#endif  // ENABLE_DECODE_PROFILING
+#if ENABLE_DECODE_TRACE
+String decodeTraceToString(IRrecv * const irrecv);
+#endif  // ENABLE_DECODE_TRACE
+#if ENABLE_MEMORY_PROFILING
+/// The entry points whose memory use can be profiled.
+/// @see ENABLE_MEMORY_PROFILING
+enum mem_probe_t {
+  kMemProbeDecode = 0,          ///< `IRrecv::decode()`
+  kMemProbeSendAc,              ///< `IRac::sendAc()`
+  kMemProbeDecodeToState,       ///< `IRAcUtils::decodeToState()`
+  kMemProbeResultAcToString,    ///< `IRAcUtils::resultAcToString()`
+  kMemProbeResultToSourceCode,  ///< `resultToSourceCode()`
+  kMemProbeCount                ///< The nr. of them. Not an entry point.
+};
+/// The most memory an entry point has been seen to use.
+typedef struct {
+  uint32_t calls;  // Nr. of calls measured.
+  uint32_t stack;  // Most stack used, below the caller's. (bytes)
+  int32_t heap;    // Most the heap in use grew by over a call. (bytes)
+                   // i.e. Still in use after it. e.g. A returned String.
+} mem_profile_t;
+// Default nr. of bytes of stack (below the caller's) painted for each call.
+const uint16_t kMemProfileStackDepth = 8192;
+bool enableMemoryProfiling(const uint16_t stack_depth = kMemProfileStackDepth);
+void disableMemoryProfiling(void);
+void resetMemoryProfile(void);
+const mem_profile_t *getMemoryProfile(const mem_probe_t api);
+String memoryProfileToString(void);
+#endif  // ENABLE_MEMORY_PROFILING
 uint8_t sumBytes(const uint8_t * const start, const uint16_t length,
                  const uint8_t init = 0);
 uint8_t xorBytes(const uint8_t * const start, const uint16_t length,
@@ -42,9 +115,42 @@ uint64_t invertBits(const uint64_t data, const uint16_t nbits);
 decode_type_t strToDecodeType(const char *str);
 float celsiusToFahrenheit(const float deg);
 float fahrenheitToCelsius(const float deg);
+int16_t celsiusToFahrenheitTenths(const int16_t deg10);
+int16_t fahrenheitToCelsiusTenths(const int16_t deg10);
 /// Namespace for covering common functions & procedures for advancd protocol
 /// handlers
 namespace irutils {
+  uint8_t calcChecksum(const checksum_t &section, const uint8_t * const state,
+                       const uint16_t length);
+  bool validChecksums(const checksum_t sections[], const uint8_t count,
+                      const uint8_t * const state, const uint16_t length);
+  void setChecksums(const checksum_t sections[], const uint8_t count,
+                    uint8_t * const state, const uint16_t length);
+  void updateChecksums(const checksum_t sections[], const uint8_t count,
+                       uint8_t * const state, const uint16_t length,
+                       const uint16_t index, const uint8_t value);
+  void addLabeledString(String *result, const char *value, const char *label,
+                        const bool precomma = true);
+  void addLabeledString(String *result, const String &value, const char *label,
+                        const bool precomma = true);
+  void addBoolToString(String *result, const bool value, const char *label,
+                       const bool precomma = true);
+  void addIntToString(String *result, const uint16_t value, const char *label,
+                      const bool precomma = true);
+  void addModelToString(String *result, const decode_type_t protocol,
+                        const int16_t model, const bool precomma = true);
+  void addTempToString(String *result, const uint16_t degrees,
+                       const bool celsius = true, const bool precomma = true);
+  void addModeToString(String *result, const uint8_t mode,
+                       const uint8_t automatic, const uint8_t cool,
+                       const uint8_t heat, const uint8_t dry,
+                       const uint8_t fan);
+  void addFanToString(String *result, const uint8_t speed,
+                      const uint8_t high, const uint8_t low,
+                      const uint8_t automatic, const uint8_t quiet,
+                      const uint8_t medium);
+  void addDayToString(String *result, const uint8_t day_of_week,
+                      const int8_t offset = 0, const bool precomma = true);
   String addBoolToString(const bool value, const String label,
                          const bool precomma = true);
   String addIntToString(const uint16_t value, const String label,
@@ -71,6 +177,10 @@ namespace irutils {
                      const uint8_t init = 0);
   uint8_t sumNibbles(const uint64_t data, const uint8_t count = 16,
                      const uint8_t init = 0, const bool nibbleonly = true);
+  uint8_t sumLowNibbles(const uint8_t * const start, const uint16_t length,
+                        const uint8_t init = 0);
+  uint8_t sumHighNibbles(const uint8_t * const start, const uint16_t length,
+                         const uint8_t init = 0);
   uint8_t bcdToUint8(const uint8_t bcd);
   uint8_t uint8ToBcd(const uint8_t integer);
   bool getBit(const uint64_t data, const uint8_t position,
@@ -107,8 +217,182 @@ namespace irutils {
                const uint32_t data);
   void setBits(uint64_t * const dst, const uint8_t offset, const uint8_t nbits,
                const uint64_t data);
+  /// Compile-time version of `setBits()` for a byte. As the position & size
+  /// are template parameters, it inlines into a single mask & merge.
+  /// @tparam offset Nr. of bits from the Least Significant Bit to be ignored.
+  /// @tparam nbits Nr of bits of data to be placed into the destination.
+  /// @param[in,out] dst The ptr to the byte to be changed.
+  /// @param[in] data The value to be placed.
+  template <uint8_t offset, uint8_t nbits>
+  inline void setBits(uint8_t * const dst, const uint8_t data) {
+    static_assert(nbits && offset + nbits <= 8, "Field must fit in a byte.");
+    const uint8_t mask = (UINT8_MAX >> (8 - nbits)) << offset;
+    *dst = (*dst & ~mask) | ((data << offset) & mask);
+  }
+  /// Compile-time version of `GETBITS8()`.
+  /// @tparam offset Nr. of bits from the Least Significant Bit to be ignored.
+  /// @tparam nbits Nr of bits of data to be returned.
+  /// @param[in] data The byte to extract the bits from.
+  /// @return The value of the bits.
+  template <uint8_t offset, uint8_t nbits>
+  inline uint8_t getBits(const uint8_t data) {
+    static_assert(nbits && offset + nbits <= 8, "Field must fit in a byte.");
+    return (data >> offset) & (UINT8_MAX >> (8 - nbits));
+  }
+  /// A field of bits in a byte array state. e.g. `remote_state[]`.
+  /// Lets a protocol declare its layout once, as a typedef per field.
+  /// e.g. `typedef irutils::StateBits<9, 3, 3> VaneField;`
+  /// @tparam byte The index of the byte in the state the field is in.
+  /// @tparam offset Nr. of bits from the Least Significant Bit of the byte.
+  /// @tparam nbits Nr. of bits in the field.
+  template <uint16_t byte, uint8_t offset, uint8_t nbits>
+  struct StateBits {
+    /// Get the value of the field.
+    /// @param[in] state A ptr to the state array.
+    /// @return The value of the field.
+    static inline uint8_t get(const uint8_t * const state) {
+      return getBits<offset, nbits>(state[byte]);
+    }
+    /// Set the value of the field.
+    /// @param[in,out] state A ptr to the state array.
+    /// @param[in] value The value to store. Excess bits are discarded.
+    static inline void set(uint8_t * const state, const uint8_t value) {
+      setBits<offset, nbits>(state + byte, value);
+    }
+  };
+  /// A minimal writer of a flat JSON object, into a fixed size buffer (or a
+  /// stream), so serialising doesn't need the heap.
+  class JsonWriter {
+   public:
+    JsonWriter(char *buffer, const uint16_t size);
+#ifdef ARDUINO
+    explicit JsonWriter(Print *output);
+#endif  // ARDUINO
+    void begin(void);
+    void end(void);
+    void add(const char *key, const char *value);
+    void add(const char *key, const uint64_t value);
+    void add(const char *key, const int32_t value);
+    void add(const char *key, const float value);
+    void add(const char *key, const bool value);
+    void addHex(const char *key, const uint64_t value);
+    void addHex(const char *key, const uint8_t * const data,
+                const uint16_t length);
+    uint16_t length(void) const;
+    bool overflowed(void) const;
+
+   private:
+    char *_buffer;     ///< The buffer to write to, if any.
+    uint16_t _size;    ///< The size of `_buffer`.
+    uint16_t _length;  ///< Nr. of chars written so far.
+    bool _overflow;    ///< Has `_buffer` run out of room?
+    bool _first;       ///< Is the next entry the first in the object?
+#ifdef ARDUINO
+    Print *_print;     ///< The stream to write to, if any.
+#endif  // ARDUINO
+    void put(const char c);
+    void put(const char *str);
+    void putEscaped(const char *str);
+    void putKey(const char *key);
+  };
+  /// A capture, as stored in a capture file. It points into the file's data,
+  /// so it is only valid while that is.
+  typedef struct {
+    decode_type_t protocol;  ///< What it was decoded as. UNKNOWN if nothing.
+    uint16_t frequency;      ///< The carrier frequency. (kHz)
+    uint32_t timestamp;      ///< When it was captured. e.g. `millis()`
+    uint16_t rawlen;         ///< Nr. of `rawbuf[]` entries it has.
+    bool overflow;           ///< Did it overflow the capture buffer?
+    const uint8_t *ticks;    ///< Its delta encoded `rawbuf[]` entries.
+    uint32_t size;           ///< Nr. of bytes of `ticks`.
+  } capture_t;
+  /// A writer of captures into a capture file, in a buffer (or a stream), so
+  /// field captures can be recorded. e.g. To SPIFFS, or over serial.
+  class CaptureWriter {
+   public:
+    CaptureWriter(uint8_t *buffer, const uint32_t size,
+                  uint32_t *index = NULL, const uint32_t index_size = 0);
+#ifdef ARDUINO
+    explicit CaptureWriter(Print *output, uint32_t *index = NULL,
+                           const uint32_t index_size = 0);
+#endif  // ARDUINO
+    void begin(void);
+    bool add(const decode_results * const results,
+             const uint16_t frequency = 38, const uint32_t timestamp = 0);
+    void end(void);
+    uint32_t length(void) const;
+    uint32_t count(void) const;
+    uint32_t pending(void) const;
+    void flush(void);
+    bool overflowed(void) const;
+    static uint32_t recordSize(const decode_results * const results);
+
+   private:
+    uint8_t *_buffer;      ///< The buffer to write to, if any.
+    uint32_t _size;        ///< The size of `_buffer`.
+    uint32_t _used;        ///< Nr. of bytes of `_buffer` used.
+    uint32_t _length;      ///< Nr. of bytes written so far, in total.
+    uint32_t *_index;      ///< Where to keep the offset of each capture.
+    uint32_t _index_size;  ///< Nr. of entries `_index` has room for.
+    uint32_t _count;       ///< Nr. of captures written so far.
+    bool _overflow;        ///< Has `_buffer` run out of room?
+#ifdef ARDUINO
+    Print *_print;         ///< The stream to write to, if any.
+#endif  // ARDUINO
+    bool reserve(const uint32_t nbytes);
+    void put(const uint8_t byte);
+    void put(const uint32_t value, const uint8_t nbytes);
+  };
+  /// A reader of the captures in a capture file, in place. e.g. From a
+  /// mmap()'ed file, or flash. Nothing is copied, except by `unpack()`.
+  class CaptureReader {
+   public:
+    CaptureReader(const uint8_t *data, const uint32_t size);
+    bool valid(void) const;
+    bool indexed(void) const;
+    uint32_t count(void);
+    bool get(const uint32_t n, capture_t *capture);
+    bool next(capture_t *capture);
+    void rewind(void);
+    static uint16_t unpack(const capture_t &capture, uint16_t *rawbuf,
+                           const uint16_t size);
+
+   private:
+    const uint8_t *_data;   ///< The capture file.
+    uint32_t _end;          ///< Offset of the end of its captures.
+    const uint8_t *_index;  ///< Its index, if it has one.
+    uint32_t _count;        ///< Nr. of captures, if known.
+    uint32_t _pos;          ///< Offset of the next capture for `next()`.
+    bool _valid;            ///< Does it look like a capture file?
+    bool read(const uint32_t offset, capture_t *capture) const;
+  };
+#if ENABLE_MEMORY_PROFILING
+  /// Measures the memory an entry point uses, from when it is created until
+  /// it goes out of scope. Only the outermost of nested ones measures.
+  /// @see enableMemoryProfiling()
+  class MemoryProbe {
+   public:
+    explicit MemoryProbe(const mem_probe_t api);
+    ~MemoryProbe(void);
+
+   private:
+    mem_probe_t _api;   ///< What it is measuring.
+    bool _active;       ///< Is it measuring? i.e. The outermost, & enabled.
+    int32_t _heap;      ///< The heap (see `memHeapFree()`) when created.
+    uint32_t _painted;  ///< Nr. of bytes of stack painted below us.
+  };
+#endif  // ENABLE_MEMORY_PROFILING
   uint8_t * invertBytePairs(uint8_t *ptr, const uint16_t length);
   bool checkInvertedBytePairs(const uint8_t * const ptr, const uint16_t length);
+  bool checkInvertedBytePairs(const uint64_t data, const uint16_t nbits);
+  uint64_t dropInvertedBytes(const uint64_t data, const uint16_t nbits);
   uint8_t lowLevelSanityCheck(void);
+  bool parseValue(const char **str, uint32_t *value, const uint8_t base = 10);
+  int32_t countValues(const char *str, const uint8_t base = 10);
+  String base64Encode(const uint8_t * const data, const uint16_t length);
+  int32_t base64Decode(const char *str, uint8_t * const data,
+                       const uint16_t size);
+  bool claimRmtBlocks(const uint8_t first, const uint8_t count);
+  void releaseRmtBlocks(const uint8_t first, const uint8_t count);
 }  // namespace irutils
 #endif  // IRUTILS_H_
@@ -0,0 +1,261 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+/// @file IRverify.cpp
+/// @brief Send IR messages, & only repeat those our own receiver didn't see.
+
+#include "IRverify.h"
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif
+#include <string.h>
+#include <algorithm>
+#include "IRutils.h"
+
+#ifdef UNIT_TEST
+extern uint32_t _IRtimer_unittest_now;
+#endif  // UNIT_TEST
+
+/// The current time. Not `IRtimer`, which jumps ahead when messages are sent
+/// in the background.
+/// @return The time in uSeconds.
+static uint32_t nowUsecs(void) {
+#ifndef UNIT_TEST
+  return micros();
+#else  // UNIT_TEST
+  return _IRtimer_unittest_now;
+#endif  // UNIT_TEST
+}
+
+/// Class constructor.
+/// @param[in] irsend What to send the messages with. It must already be
+///   `begin()`-ed.
+/// @param[in] irrecv A receiver that can see its IR LED. It must already be
+///   capturing. i.e. `enableIRIn()`
+/// @param[in] size Nr. of marks & spaces the largest message may have.
+IRverify::IRverify(IRsend *irsend, IRrecv *irrecv, const uint16_t size)
+    : _irsend(irsend), _irrecv(irrecv), _frame(size),
+      _type(decode_type_t::UNKNOWN), _data(0), _nbits(0), _is_state(false),
+      _left(0), _sent(0), _extra(0), _busy(false), _sending(false),
+      _verified(false), _ended(0), _margin(kVerifyDefaultMargin),
+      _verified_count(0), _failed_count(0), _saved(0), _protocol_count(0),
+      _replace(0) {
+#if ENABLE_ECHO_SUPPRESSION
+  _echo = NULL;
+#endif  // ENABLE_ECHO_SUPPRESSION
+}
+
+/// Send a simple (data) message, & verify it. See `IRsend::send()`.
+/// @param[in] type The protocol.
+/// @param[in] data The message.
+/// @param[in] nbits The nr. of bits of the message.
+/// @param[in] repeat The nr. of repeats the protocol (or user) asks for. It is
+///   the most that will be sent, if the message isn't seen sooner.
+/// @return true, if it is being sent. false if it can't be, or another
+///   message is still being verified. See `isBusy()`.
+bool IRverify::send(const decode_type_t type, const uint64_t data,
+                    const uint16_t nbits, const uint16_t repeat) {
+  if (_busy) return false;
+  _type = type;
+  _data = data;
+  _nbits = nbits;
+  _is_state = false;
+  _irsend->startRecording(&_frame);
+  const bool success = _irsend->send(type, data, nbits, kNoRepeat);
+  return _start(_irsend->stopRecording() && success, repeat);
+}
+
+/// Send a complex (state[]) message, & verify it. See `IRsend::send()`.
+/// @param[in] type The protocol.
+/// @param[in] state The message.
+/// @param[in] nbytes The nr. of bytes of the message.
+/// @param[in] repeat The nr. of repeats the protocol (or user) asks for. It is
+///   the most that will be sent, if the message isn't seen sooner.
+/// @return true, if it is being sent. false if it can't be, or another
+///   message is still being verified. See `isBusy()`.
+/// @note Messages are sent once, & repeated by this class. i.e. Protocols
+///   whose `IRsend::send()` ignores the repeat for state[] messages still
+///   get them.
+bool IRverify::send(const decode_type_t type, const uint8_t *state,
+                    const uint16_t nbytes, const uint16_t repeat) {
+  if (_busy || state == NULL || nbytes > kStateSizeMax) return false;
+  _type = type;
+  memcpy(_state, state, nbytes);
+  _nbits = nbytes * 8;
+  _is_state = true;
+  _irsend->startRecording(&_frame);
+  const bool success = _irsend->send(type, state, nbytes);
+  return _start(_irsend->stopRecording() && success, repeat);
+}
+
+/// Check the captures, & repeat the message if it hasn't been seen in time.
+/// Call it often from your main loop.
+/// @return true, if the message has now been sent for the last time. See
+///   `isVerified()`. Otherwise false.
+bool IRverify::handle(void) {
+  if (!_busy) return false;
+#if IRSEND_ASYNC
+  if (_sending) {
+    if (_irsend->isBusy()) return false;
+    _sending = false;
+    _ended = nowUsecs();  // The wait starts once it has all been sent.
+  }
+#endif  // IRSEND_ASYNC
+  decode_results results;
+  if (_capture(&results) && _matches(&results)) _verified = true;
+  // The captures of a batch of copies are all consumed, before we finish.
+  const bool batch = _sent == _extra + 1 && _extra;
+  if (!_verified || batch) {
+    const int32_t wait = MS_TO_USEC(_irrecv->_params->timeout) + _margin;
+    // Signed, as a capture may be decoded before `_ended` was taken.
+    if ((int32_t)(nowUsecs() - _ended) < wait) return false;
+  }
+  if (!_verified && _left) {  // It wasn't seen, so repeat it.
+    _transmit(1);
+    return false;
+  }
+  _finish();
+  return true;
+}
+
+/// Is a message still being sent or verified?
+/// @return true, if it is. Otherwise false.
+bool IRverify::isBusy(void) const { return _busy; }
+
+/// Was the last message seen by our own receiver?
+/// @return true, if it was. Otherwise false, or it is still being verified.
+bool IRverify::isVerified(void) const { return _verified; }
+
+/// Get the nr. of copies sent of the last message. (or so far)
+/// @return The count.
+uint16_t IRverify::getSent(void) const { return _sent; }
+
+/// Get the nr. of copies learned to be sent straight after the first, for a
+/// protocol. i.e. Those that have usually been needed.
+/// @param[in] type The protocol.
+/// @return The count.
+uint8_t IRverify::getExtra(const decode_type_t type) const {
+  for (uint8_t i = 0; i < _protocol_count; i++)
+    if (_protocols[i].protocol == type) return _protocols[i].extra;
+  return 0;
+}
+
+/// Set how long to wait for a message's capture to be decoded, on top of the
+/// receiver's timeout.
+/// @param[in] usecs The time. (uSeconds) e.g. Longer if `loop()` is slow.
+void IRverify::setMargin(const uint32_t usecs) { _margin = usecs; }
+
+/// Get the nr. of messages our own receiver saw.
+/// @return The count.
+uint32_t IRverify::getVerified(void) const { return _verified_count; }
+
+/// Get the nr. of messages our own receiver didn't see, in all their repeats.
+/// @return The count.
+uint32_t IRverify::getFailed(void) const { return _failed_count; }
+
+/// Get the nr. of copies that weren't sent, as an earlier copy was seen.
+/// i.e. The repeats (& air time) saved.
+/// @return The count.
+uint32_t IRverify::getSaved(void) const { return _saved; }
+
+/// Start sending a message that has been recorded.
+/// @param[in] success Was it recorded?
+/// @param[in] repeat The most repeats to send.
+/// @return true, if it is being sent. Otherwise false.
+bool IRverify::_start(const bool success, const uint16_t repeat) {
+  if (!success || !_frame.length()) return false;
+  _extra = std::min((uint16_t)_learned(_type)->extra, repeat);
+  _left = repeat + 1;
+  _sent = 0;
+  _verified = false;
+  _busy = true;
+#if ENABLE_ECHO_SUPPRESSION
+  _echo = _irrecv->_params->echo;
+  _irrecv->_params->echo = NULL;  // We need to see our own message.
+#endif  // ENABLE_ECHO_SUPPRESSION
+  _transmit(_extra + 1);
+  return true;
+}
+
+/// Send copies of the message. In the background, if the `IRsend` can.
+/// @param[in] copies How many.
+void IRverify::_transmit(const uint16_t copies) {
+  _left -= copies;
+  _sent += copies;
+#if IRSEND_ASYNC
+  if (_irsend->beginAsync()) {
+    _irsend->sendSequence(&_frame, copies - 1);  // Only recorded, not sent.
+    _sending = _irsend->sendAsync();
+    if (_sending) return;
+  }
+#endif  // IRSEND_ASYNC
+  _irsend->sendSequence(&_frame, copies - 1);
+  _ended = nowUsecs();
+}
+
+/// Decode a capture, if one has arrived.
+/// @param[out] results Where to decode it to.
+/// @return true, if one was decoded. Otherwise false.
+bool IRverify::_capture(decode_results *results) {
+  volatile irparams_t *params = _irrecv->_params;
+#ifdef UNIT_TEST
+  // decode() doesn't check if a capture has ended, in unit tests.
+  if (params->rcvstate != kStopState) return false;
+#endif  // UNIT_TEST
+  const bool decoded = _irrecv->decode(results);
+  // Without a save buffer, the capture is still held. We are done with it.
+  if (_irrecv->irparams_save == NULL && params->rcvstate == kStopState)
+    _irrecv->resume();
+  return decoded;
+}
+
+/// Is a decoded capture the message being sent?
+/// @param[in] results The capture.
+/// @return true, if it is. Otherwise false.
+bool IRverify::_matches(const decode_results *results) const {
+  if (results->decode_type != _type || results->bits != _nbits) return false;
+  if (_is_state) return !memcmp(results->state, _state, _nbits / 8);
+  return results->value == _data;
+}
+
+/// Finish with a message, & learn from how many copies it needed.
+void IRverify::_finish(void) {
+  ir_verify_protocol_t *learned = _learned(_type);
+  if (_verified) {
+    _verified_count++;
+    _saved += _left;
+    if (_sent > _extra + 1) {  // The first copies weren't enough.
+      if (learned->extra < UINT8_MAX) learned->extra++;
+      learned->streak = 0;
+    } else if (learned->extra && ++learned->streak >= kVerifyStableSends) {
+      learned->extra--;  // Maybe they aren't needed any more.
+      learned->streak = 0;
+    }
+  } else {
+    _failed_count++;  // More copies wouldn't have been allowed.
+    learned->streak = 0;
+  }
+#if ENABLE_ECHO_SUPPRESSION
+  _irrecv->_params->echo = _echo;
+#endif  // ENABLE_ECHO_SUPPRESSION
+  _busy = false;
+}
+
+/// Find what has been learned about a protocol.
+/// A new protocol is added, replacing the oldest one, if need be.
+/// @param[in] type The protocol.
+/// @return A Ptr to it.
+ir_verify_protocol_t *IRverify::_learned(const decode_type_t type) {
+  for (uint8_t i = 0; i < _protocol_count; i++)
+    if (_protocols[i].protocol == type) return &_protocols[i];
+  ir_verify_protocol_t *entry;
+  if (_protocol_count < kVerifyMaxProtocols) {
+    entry = &_protocols[_protocol_count++];
+  } else {
+    entry = &_protocols[_replace];
+    _replace = (_replace + 1) % kVerifyMaxProtocols;
+  }
+  entry->protocol = type;
+  entry->extra = 0;
+  entry->streak = 0;
+  return entry;
+}
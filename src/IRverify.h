@@ -0,0 +1,109 @@
+#ifndef IRVERIFY_H_
+#define IRVERIFY_H_
+
+// Copyright 2026 The IRremoteESP8266 authors
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+#include "IRsend.h"
+
+// Constants
+/// Max. nr. of protocols an `IRverify` learns the repeat counts of.
+const uint8_t kVerifyMaxProtocols = 8;
+/// Time allowed after a message has been sent, on top of the receiver's
+/// timeout, for its capture to be decoded. (uSeconds)
+const uint32_t kVerifyDefaultMargin = 50000;
+/// Nr. of messages in a row that must get through without their learned
+/// extra copies, before one fewer is sent.
+const uint8_t kVerifyStableSends = 8;
+
+/// What an `IRverify` has learned about a protocol.
+typedef struct {
+  decode_type_t protocol;
+  uint8_t extra;  ///< Nr. of copies sent after the first, without waiting.
+  uint8_t streak;  ///< Nr. of messages in a row that needed none of them.
+} ir_verify_protocol_t;
+
+/// Sends messages from an `IRsend` whose LED an `IRrecv` on the same device
+/// can see, & checks the message it captures back decodes as the one sent.
+/// The message is only repeated if it doesn't. i.e. Rather than always
+/// sending the `repeat` a protocol (or user) asks for, which multiplies the
+/// air time & the time spent blocked, even when the first one got through.
+/// The repeat is the most that will be sent. Per protocol, it also learns how
+/// many copies usually get through in this spot (room), & sends that many
+/// straight away, to save a wait for each that doesn't.
+/// `handle()` (called from `loop()`) checks the captures, & repeats the
+/// message when the wait for it is over.
+/// e.g.
+/// @code
+///   IRverify verify(&irsend, &irrecv);
+///   ...
+///   // Up to 2 repeats, but only if they are needed.
+///   verify.send(decode_type_t::SAMSUNG_AC, state, kSamsungAcStateLength, 2);
+///   ...
+///   void loop() {
+///     if (verify.handle() && !verify.isVerified()) Serial.println("Lost!");
+///     ...
+///   }
+/// @endcode
+/// @note Anything the `IRrecv` captures while a message is being verified is
+///   consumed by it. It is best created with a `save_buffer`.
+class IRverify {
+ public:
+  explicit IRverify(IRsend *irsend, IRrecv *irrecv,
+                    const uint16_t size = kSequenceDefaultSize);
+  bool send(const decode_type_t type, const uint64_t data,
+            const uint16_t nbits, const uint16_t repeat = kNoRepeat);
+  bool send(const decode_type_t type, const uint8_t *state,
+            const uint16_t nbytes, const uint16_t repeat = kNoRepeat);
+  bool handle(void);
+  bool isBusy(void) const;
+  bool isVerified(void) const;
+  uint16_t getSent(void) const;
+  uint8_t getExtra(const decode_type_t type) const;
+  void setMargin(const uint32_t usecs);
+  uint32_t getVerified(void) const;
+  uint32_t getFailed(void) const;
+  uint32_t getSaved(void) const;
+#ifndef UNIT_TEST
+
+ private:
+#endif  // UNIT_TEST
+  IRsend *_irsend;
+  IRrecv *_irrecv;
+  IRsequence _frame;  // The message. Without any repeats.
+  decode_type_t _type;
+  uint64_t _data;
+  uint8_t _state[kStateSizeMax];
+  uint16_t _nbits;
+  bool _is_state;  // Is it a state[] message? Otherwise it is `_data`.
+  uint16_t _left;  // Nr. of copies that may still be sent.
+  uint16_t _sent;  // Nr. of copies sent of the current/last message.
+  uint8_t _extra;  // Nr. of extra copies sent with the first.
+  bool _busy;
+  bool _sending;  // Is a copy still being sent in the background?
+  bool _verified;
+  uint32_t _ended;  // When the last copy was sent. (uSeconds)
+  uint32_t _margin;
+  uint32_t _verified_count;
+  uint32_t _failed_count;
+  uint32_t _saved;  // Nr. of copies not sent, out of the repeats asked for.
+  ir_verify_protocol_t _protocols[kVerifyMaxProtocols];
+  uint8_t _protocol_count;
+  uint8_t _replace;  // The entry to forget next, when they are all used.
+#if ENABLE_ECHO_SUPPRESSION
+  const ir_echo_t *_echo;  // What the receiver ignored, before we started.
+#endif  // ENABLE_ECHO_SUPPRESSION
+  bool _start(const bool success, const uint16_t repeat);
+  void _transmit(const uint16_t copies);
+  bool _capture(decode_results *results);
+  bool _matches(const decode_results *results) const;
+  void _finish(void);
+  ir_verify_protocol_t *_learned(const decode_type_t type);
+  IRverify(const IRverify &);  // Not copyable, as it owns a sequence.
+  IRverify &operator=(const IRverify &);
+};
+
+#endif  // IRVERIFY_H_
@@ -265,12 +265,12 @@ stdAc::state_t IRAirwellAc::toCommon(void) const {
 String IRAirwellAc::toString(void) const {
   String result = "";
   result.reserve(70);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(_.PowerToggle, kPowerToggleStr, false);
-  result += addModeToString(_.Mode, kAirwellAuto, kAirwellCool,
-                            kAirwellHeat, kAirwellDry, kAirwellFan);
-  result += addFanToString(_.Fan, kAirwellFanHigh, kAirwellFanLow,
-                           kAirwellFanAuto, kAirwellFanAuto,
-                           kAirwellFanMedium);
-  result += addTempToString(getTemp());
+  addBoolToString(&result, _.PowerToggle, kPowerToggleStr, false);
+  addModeToString(&result, _.Mode, kAirwellAuto, kAirwellCool,
+                  kAirwellHeat, kAirwellDry, kAirwellFan);
+  addFanToString(&result, _.Fan, kAirwellFanHigh, kAirwellFanLow,
+                 kAirwellFanAuto, kAirwellFanAuto,
+                 kAirwellFanMedium);
+  addTempToString(&result, getTemp());
   return result;
 }
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cstring>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -24,6 +25,9 @@ const uint16_t kAmcorFooterMark = 1900;
 const uint16_t kAmcorGap = 34300;
 const uint8_t  kAmcorTolerance = 40;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchAmcorHdrMark == kAmcorHdrMark, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addModeToString;
 using irutils::addFanToString;
@@ -342,13 +346,13 @@ stdAc::state_t IRAmcorAc::toCommon(void) const {
 String IRAmcorAc::toString(void) const {
   String result = "";
   result.reserve(70);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(_.Mode, kAmcorAuto, kAmcorCool,
-                            kAmcorHeat, kAmcorDry, kAmcorFan);
-  result += addFanToString(_.Fan, kAmcorFanMax, kAmcorFanMin,
-                           kAmcorFanAuto, kAmcorFanAuto,
-                           kAmcorFanMed);
-  result += addTempToString(_.Temp);
-  result += addBoolToString(getMax(), kMaxStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, _.Mode, kAmcorAuto, kAmcorCool,
+                  kAmcorHeat, kAmcorDry, kAmcorFan);
+  addFanToString(&result, _.Fan, kAmcorFanMax, kAmcorFanMin,
+                 kAmcorFanAuto, kAmcorFanAuto,
+                 kAmcorFanMed);
+  addTempToString(&result, _.Temp);
+  addBoolToString(&result, getMax(), kMaxStr);
   return result;
 }
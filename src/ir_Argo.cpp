@@ -10,6 +10,7 @@
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif  // UNIT_TEST
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -23,6 +24,9 @@ const uint16_t kArgoOneSpace = 2200;
 const uint16_t kArgoZeroSpace = 900;
 const uint32_t kArgoGap = kDefaultMessageGap;  // Made up value. Complete guess.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchArgoHdrMark == kArgoHdrMark, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
@@ -40,7 +44,7 @@ using irutils::setBits;
 void IRsend::sendArgo(const unsigned char data[], const uint16_t nbytes,
                       const uint16_t repeat) {
   // Check if we have enough bytes to send a proper message.
-  if (nbytes < kArgoStateLength) return;
+  if (nbytes < kArgoStateLength && nbytes != kArgoShortStateLength) return;
   // TODO(kaschmo): validate
   sendGeneric(kArgoHdrMark, kArgoHdrSpace, kArgoBitMark, kArgoOneSpace,
               kArgoBitMark, kArgoZeroSpace, 0, 0,  // No Footer.
@@ -65,6 +69,17 @@ void IRArgoAC::begin(void) { _irsend.begin(); }
 void IRArgoAC::send(const uint16_t repeat) {
   _irsend.sendArgo(getRaw(), kArgoStateLength, repeat);
 }
+
+/// Send only a sensor (iFeel) temperature report. i.e. The short message the
+/// remote sends periodically, rather than the whole state. The current state
+/// is left as-is.
+/// @param[in] degrees The room temperature in degrees celsius.
+/// @param[in] repeat Nr. of times the message will be repeated.
+void IRArgoAC::sendSensorTemp(const uint8_t degrees, const uint16_t repeat) {
+  uint8_t report[kArgoShortStateLength];
+  encodeSensorTemp(degrees, report);
+  _irsend.sendArgo(report, kArgoShortStateLength, repeat);
+}
 #endif  // SEND_ARGO
 
 /// Verify the checksum is valid for a given state.
@@ -103,8 +118,8 @@ void IRArgoAC::stateReset(void) {
 
   // Argo Message. Store MSB left.
   // Default message:
-  argo[0] = 0b10101100;  // LSB first (as sent) 0b00110101; //const preamble
-  argo[1] = 0b11110101;  // LSB first: 0b10101111; //const preamble
+  argo[0] = kArgoPreamble1;  // LSB first (as sent) 0b00110101; //const preamble
+  argo[1] = kArgoPreamble2;  // LSB first: 0b10101111; //const preamble
   // Keep payload 2-9 at zero
   argo[10] = 0b00000010;  // Const 01, checksum 6bit
   argo[11] = 0b00000000;  // Checksum 2bit
@@ -264,6 +279,21 @@ void IRArgoAC::setRoomTemp(const uint8_t degrees) {
           temp >> kArgoRoomTempLowSize);
 }
 
+/// Build a sensor (iFeel) temperature report message.
+/// @param[in] degrees The room temperature in degrees celsius.
+/// @param[out] state Where to build it. `kArgoShortStateLength` bytes.
+void IRArgoAC::encodeSensorTemp(const uint8_t degrees, uint8_t state[]) {
+  uint8_t temp = std::min(degrees, kArgoMaxRoomTemp);
+  temp = std::max(temp, kArgoTempDelta) - kArgoTempDelta;
+  const uint8_t check = kArgoSensorCheck + temp;
+  state[0] = kArgoPreamble1;
+  state[1] = kArgoPreamble2;
+  state[2] = kArgoSensorFixed;
+  setBits(&state[2], kArgoSensorTempOffset, kArgoSensorTempSize, temp);
+  state[3] = (check << kArgoSensorFixedSize) |
+      (check >> (8 - kArgoSensorFixedSize));
+}
+
 /// Get the currently stored value for the room temperature setting.
 /// @return The current setting for the room temp. in degrees celsius.
 uint8_t IRArgoAC::getRoomTemp(void) {
@@ -386,8 +416,8 @@ stdAc::state_t IRArgoAC::toCommon(void) {
 String IRArgoAC::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addIntToString(getMode(), kModeStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addIntToString(&result, getMode(), kModeStr);
   result += kSpaceLBraceStr;
   switch (getMode()) {
     case kArgoAuto:
@@ -414,7 +444,7 @@ String IRArgoAC::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getFan(), kFanStr);
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (getFan()) {
     case kArgoFanAuto:
@@ -433,14 +463,14 @@ String IRArgoAC::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addTempToString(getTemp());
+  addTempToString(&result, getTemp());
   result += kCommaSpaceStr;
   result += kRoomStr;
   result += ' ';
-  result += addTempToString(getRoomTemp(), true, false);
-  result += addBoolToString(getMax(), kMaxStr);
-  result += addBoolToString(getiFeel(), kIFeelStr);
-  result += addBoolToString(getNight(), kNightStr);
+  addTempToString(&result, getRoomTemp(), true, false);
+  addBoolToString(&result, getMax(), kMaxStr);
+  addBoolToString(&result, getiFeel(), kIFeelStr);
+  addBoolToString(&result, getNight(), kNightStr);
   return result;
 }
 
@@ -36,10 +36,19 @@
   Byte 9: 1bit Timer Program, 1bit Timer 1h, 1 bit Night Mode, 1bit Max Mode, 1bit Filter, 1bit on/off, 1bit const 0, 1bit iFeel
   Byte 10: 2bit const 0 1, 6bit Checksum
   Byte 11: 2bit Checksum
+
+  Sensor (iFeel) temperature report. A short message of its own.
+  Byte 0-1: The same as above.
+  Byte 2: 3bit const 1 1 0, 5bit SensorTemp
+  Byte 3: 8bit Check, rotated 3 bits.
 */
 
 // Constants. Store MSB left.
 
+// byte[0] & byte[1]
+const uint8_t kArgoPreamble1 = 0b10101100;
+const uint8_t kArgoPreamble2 = 0b11110101;
+
 // byte[2]
 const uint8_t kArgoHeatBit =      0b00100000;
 //            kArgoTempLowMask =  0b11000000;
@@ -89,6 +98,14 @@ const uint8_t kArgoMaxBitOffset = 3;
 const uint8_t kArgoPowerBitOffset = 5;
 const uint8_t kArgoIFeelBitOffset = 7;
 
+// Sensor (iFeel) temperature report. byte[2]
+const uint8_t kArgoSensorFixed =   0b011;  // Mask 0b00000111
+const uint8_t kArgoSensorFixedSize = 3;
+const uint8_t kArgoSensorTempOffset = kArgoSensorFixedSize;  // 0b11111000
+const uint8_t kArgoSensorTempSize = 5;
+// byte[3]
+const uint8_t kArgoSensorCheck = 52;  // Plus the temp.
+
 const uint8_t kArgoMinTemp = 10;  // Celsius delta +4
 const uint8_t kArgoMaxTemp = 32;  // Celsius
 
@@ -133,6 +150,8 @@ class IRArgoAC {
 
 #if SEND_ARGO
   void send(const uint16_t repeat = kArgoDefaultRepeat);
+  void sendSensorTemp(const uint8_t degrees,
+                      const uint16_t repeat = kArgoDefaultRepeat);
   /// Run the calibration to calculate uSec timing offsets for this platform.
   /// @return The uSec timing offset needed per modulation of the IR Led.
   /// @note This will produce a 65ms IR signal pulse at 38kHz.
@@ -170,6 +189,7 @@ class IRArgoAC {
   void setTime(void);
   void setRoomTemp(const uint8_t degrees);
   uint8_t getRoomTemp(void);
+  static void encodeSensorTemp(const uint8_t degrees, uint8_t state[]);
 
   uint8_t* getRaw(void);
   void setRaw(const uint8_t state[]);
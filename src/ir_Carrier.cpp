@@ -8,6 +8,7 @@
 #include <algorithm>
 #include "IRac.h"
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -47,6 +48,19 @@ const uint16_t kCarrierAc64OneSpace = 1736;
 const uint16_t kCarrierAc64ZeroSpace = 615;
 const uint32_t kCarrierAc64Gap = kDefaultMessageGap;  // A guess.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchCarrierAc40HdrMark == kCarrierAc40HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchCarrierAcHdrMark == kCarrierAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchCarrierAc64HdrMark == kCarrierAc64HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapCarrierAcHdrMark == kCarrierAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapCarrierAcHdrSpace == kCarrierAcHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapCarrierAcGap == kCarrierAcGap, "See IRrecvTimings.h");
+
 
 #if SEND_CARRIER_AC
 /// Send a Carrier HVAC formatted message.
@@ -89,25 +103,30 @@ bool IRrecv::decodeCarrierAC(decode_results *results, uint16_t offset,
     return false;  // We expect Carrier to be 32 bits of message.
 
   uint64_t data = 0;
-  uint64_t prev_data = 0;
 
   for (uint8_t i = 0; i < 3; i++) {
-    prev_data = data;
     // Match Header + Data + Footer
     uint16_t used;
-    used = matchGeneric(results->rawbuf + offset, &data,
-                        results->rawlen - offset, nbits,
-                        kCarrierAcHdrMark, kCarrierAcHdrSpace,
-                        kCarrierAcBitMark, kCarrierAcOneSpace,
-                        kCarrierAcBitMark, kCarrierAcZeroSpace,
-                        kCarrierAcBitMark, kCarrierAcGap, true);
+    if (i > 0 && strict) {
+      // Compliance.
+      // Each copy should be an inverted copy of the previous one.
+      data = invertBits(data, nbits);
+      used = matchRepeat(results->rawbuf + offset, data,
+                         results->rawlen - offset, nbits,
+                         kCarrierAcHdrMark, kCarrierAcHdrSpace,
+                         kCarrierAcBitMark, kCarrierAcOneSpace,
+                         kCarrierAcBitMark, kCarrierAcZeroSpace,
+                         kCarrierAcBitMark, kCarrierAcGap, true);
+    } else {
+      used = matchGeneric(results->rawbuf + offset, &data,
+                          results->rawlen - offset, nbits,
+                          kCarrierAcHdrMark, kCarrierAcHdrSpace,
+                          kCarrierAcBitMark, kCarrierAcOneSpace,
+                          kCarrierAcBitMark, kCarrierAcZeroSpace,
+                          kCarrierAcBitMark, kCarrierAcGap, true);
+    }
     if (!used) return false;
     offset += used;
-    // Compliance.
-    if (strict) {
-      // Check if the data is an inverted copy of the previous data.
-      if (i > 0 && prev_data != invertBits(data, nbits)) return false;
-    }
   }
 
   // Success
@@ -500,21 +519,21 @@ void IRCarrierAc64::setOffTimer(const uint16_t nr_of_mins) {
 String IRCarrierAc64::toString(void) {
   String result = "";
   result.reserve(120);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), 0xFF, kCarrierAc64Cool,
-                            kCarrierAc64Heat, 0xFF, kCarrierAc64Fan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kCarrierAc64FanHigh, kCarrierAc64FanLow,
-                           kCarrierAc64FanAuto, kCarrierAc64FanAuto,
-                           kCarrierAc64FanMedium);
-  result += addBoolToString(getSwingV(), kSwingVStr);
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addLabeledString(getOnTimer()
-                             ? minsToString(getOnTimer()) : kOffStr,
-                             kOnTimerStr);
-  result += addLabeledString(getOffTimer()
-                             ? minsToString(getOffTimer()) : kOffStr,
-                             kOffTimerStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), 0xFF, kCarrierAc64Cool,
+                  kCarrierAc64Heat, 0xFF, kCarrierAc64Fan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kCarrierAc64FanHigh, kCarrierAc64FanLow,
+                 kCarrierAc64FanAuto, kCarrierAc64FanAuto,
+                 kCarrierAc64FanMedium);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addLabeledString(&result, getOnTimer()
+                   ? minsToString(getOnTimer()) : kOffStr,
+                   kOnTimerStr);
+  addLabeledString(&result, getOffTimer()
+                   ? minsToString(getOffTimer()) : kOffStr,
+                   kOffTimerStr);
   return result;
 }
 
@@ -7,10 +7,12 @@
 
 #include "ir_Coolix.h"
 #include <algorithm>
+#include <cstring>
 #ifndef ARDUINO
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -33,6 +35,53 @@ const uint16_t kCoolixHdrSpace = kCoolixHdrSpaceTicks * kCoolixTick;
 const uint16_t kCoolixMinGapTicks = kCoolixHdrMarkTicks + kCoolixZeroSpaceTicks;
 const uint16_t kCoolixMinGap = kCoolixMinGapTicks * kCoolixTick;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchCoolixHdrMark == kCoolixHdrMark, "See IRrecvTimings.h");
+
+#if SEND_COOLIX
+// The special commands are constant messages. They are precompiled here, incl.
+// their header, footer & gap, so they don't need encoding each time.
+#define COOLIX_PULSES_BYTE(byte) \
+    IR_PULSES_MSB_BYTE(kCoolixBitMark, kCoolixOneSpace, kCoolixZeroSpace, \
+                       byte), \
+    IR_PULSES_MSB_BYTE(kCoolixBitMark, kCoolixOneSpace, kCoolixZeroSpace, \
+                       (byte) ^ 0xFF)
+#define COOLIX_PULSES(code) \
+    kCoolixHdrMark, kCoolixHdrSpace, \
+    COOLIX_PULSES_BYTE(((code) >> 16) & 0xFF), \
+    COOLIX_PULSES_BYTE(((code) >> 8) & 0xFF), \
+    COOLIX_PULSES_BYTE((code) & 0xFF), \
+    kCoolixBitMark, kCoolixMinGap
+#define COOLIX_BYTES(code) \
+    (uint8_t)((code) >> 16), (uint8_t)((code) >> 8), (uint8_t)(code)
+const uint16_t kCoolixPulses = 2 + kCoolixBits * 2 * 2 + 2;
+const uint8_t kCoolixOffBytes[] = {COOLIX_BYTES(kCoolixOff)};
+const uint16_t kCoolixOffPulses[kCoolixPulses] PROGMEM = {
+    COOLIX_PULSES(kCoolixOff)};
+const uint8_t kCoolixSwingBytes[] = {COOLIX_BYTES(kCoolixSwing)};
+const uint16_t kCoolixSwingPulses[kCoolixPulses] PROGMEM = {
+    COOLIX_PULSES(kCoolixSwing)};
+const uint8_t kCoolixTurboBytes[] = {COOLIX_BYTES(kCoolixTurbo)};
+const uint16_t kCoolixTurboPulses[kCoolixPulses] PROGMEM = {
+    COOLIX_PULSES(kCoolixTurbo)};
+const uint8_t kCoolixLedBytes[] = {COOLIX_BYTES(kCoolixLed)};
+const uint16_t kCoolixLedPulses[kCoolixPulses] PROGMEM = {
+    COOLIX_PULSES(kCoolixLed)};
+const uint8_t kCoolixCleanBytes[] = {COOLIX_BYTES(kCoolixClean)};
+const uint16_t kCoolixCleanPulses[kCoolixPulses] PROGMEM = {
+    COOLIX_PULSES(kCoolixClean)};
+const uint8_t kCoolixSleepBytes[] = {COOLIX_BYTES(kCoolixSleep)};
+const uint16_t kCoolixSleepPulses[kCoolixPulses] PROGMEM = {
+    COOLIX_PULSES(kCoolixSleep)};
+const precompiled_section_t kCoolixPrecompiled[] = {
+    {kCoolixOffBytes, kCoolixBits / 8, kCoolixOffPulses, kCoolixPulses},
+    {kCoolixSwingBytes, kCoolixBits / 8, kCoolixSwingPulses, kCoolixPulses},
+    {kCoolixTurboBytes, kCoolixBits / 8, kCoolixTurboPulses, kCoolixPulses},
+    {kCoolixLedBytes, kCoolixBits / 8, kCoolixLedPulses, kCoolixPulses},
+    {kCoolixCleanBytes, kCoolixBits / 8, kCoolixCleanPulses, kCoolixPulses},
+    {kCoolixSleepBytes, kCoolixBits / 8, kCoolixSleepPulses, kCoolixPulses}};
+#endif  // SEND_COOLIX
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
@@ -50,11 +99,53 @@ using irutils::setBits;
 /// @see https://github.com/z3t0/Arduino-IRremote/blob/master/ir_COOLIX.cpp
 void IRsend::sendCOOLIX(uint64_t data, uint16_t nbits, uint16_t repeat) {
   if (nbits % 8 != 0) return;  // nbits is required to be a multiple of 8.
+  _sendCOOLIX(data, nbits, repeat);
+  space(kDefaultMessageGap);
+}
+
+/// Send a sequence of Coolix messages as one burst. e.g. Some special commands
+/// followed by a state.
+/// Each message follows the previous one after only the protocol's minimum
+/// gap, rather than a full message gap.
+/// Status: BETA / Should be working.
+/// @param[in] codes The (24 bit) messages to be sent, in order.
+/// @param[in] ncodes The nr. of messages in `codes`.
+/// @param[in] repeat The number of times each message is to be repeated.
+void IRsend::sendCOOLIXSequence(const uint32_t codes[], const uint16_t ncodes,
+                                const uint16_t repeat) {
+  if (!ncodes) return;
+  for (uint16_t i = 0; i < ncodes; i++)
+    _sendCOOLIX(codes[i], kCoolixBits, repeat);
+  space(kDefaultMessageGap);
+}
+
+/// Send a Coolix message & its repeats, but not the gap after the last one.
+/// The special commands are replayed from their precompiled marks & spaces.
+/// @param[in] data The message to be sent.
+/// @param[in] nbits The number of bits of message to be sent.
+/// @param[in] repeat The number of times the command is to be repeated.
+void IRsend::_sendCOOLIX(const uint64_t data, const uint16_t nbits,
+                         const uint16_t repeat) {
+  // Is it one of the precompiled special commands?
+  const precompiled_section_t *special = NULL;
+  uint8_t bytes[kCoolixBits / 8];
+  if (nbits == kCoolixBits) {
+    for (uint8_t i = 0; i < kCoolixBits / 8; i++)
+      bytes[i] = data >> (nbits - 8 * (i + 1));
+    for (uint8_t i = 0;
+         i < sizeof(kCoolixPrecompiled) / sizeof(kCoolixPrecompiled[0]); i++)
+      if (memcmp(bytes, kCoolixPrecompiled[i].data, sizeof(bytes)) == 0) {
+        special = &kCoolixPrecompiled[i];
+        break;
+      }
+  }
 
   // Set IR carrier frequency
   enableIROut(38);
 
   for (uint16_t r = 0; r <= repeat; r++) {
+    if (special != NULL && sendPrecompiled(special, bytes, sizeof(bytes), 38))
+      continue;
     // Header
     mark(kCoolixHdrMark);
     space(kCoolixHdrSpace);
@@ -77,7 +168,6 @@ void IRsend::sendCOOLIX(uint64_t data, uint16_t nbits, uint16_t repeat) {
     mark(kCoolixBitMark);
     space(kCoolixMinGap);  // Pause before repeating
   }
-  space(kDefaultMessageGap);
 }
 #endif
 
@@ -115,6 +205,32 @@ void IRCoolixAC::send(const uint16_t repeat) {
   // after command has being transmitted.
   recoverSavedState();
 }
+
+/// Send a sequence of messages as one burst. e.g. Some special commands
+/// followed by the state. See `IRsend::sendCOOLIXSequence()`.
+/// @param[in] codes The messages to be sent, in order.
+/// @param[in] ncodes The nr. of messages in `codes`.
+/// @param[in] repeat Nr. of times each message will be repeated.
+void IRCoolixAC::sendSequence(const uint32_t codes[], const uint16_t ncodes,
+                              const uint16_t repeat) {
+  _irsend.sendCOOLIXSequence(codes, ncodes, repeat);
+  // make sure to remove special state from remote_state
+  // after command has being transmitted.
+  recoverSavedState();
+}
+
+/// Send a sensor temperature report. i.e. The current state, with the sensor
+/// temperature (& hence Zone Follow) set, as the remote does periodically.
+/// @param[in] degrees The sensor temperature in degrees celsius.
+/// @param[in] repeat Nr. of times the message will be repeated.
+/// @note It is a normal (24 bit) message, as the protocol has no shorter one.
+///   Nothing is sent if the A/C is set to off.
+void IRCoolixAC::sendSensorTemp(const uint8_t degrees, const uint16_t repeat) {
+  if (remote_state == kCoolixOff) return;
+  recoverSavedState();  // Report against the state, not a special command.
+  setSensorTemp(degrees);
+  send(repeat);
+}
 #endif  // SEND_COOLIX
 
 /// Get a copy of the internal state as a valid code for this protocol.
@@ -559,7 +675,7 @@ stdAc::state_t IRCoolixAC::toCommon(const stdAc::state_t *prev) {
 String IRCoolixAC::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
+  addBoolToString(&result, getPower(), kPowerStr, false);
   if (!getPower()) return result;  // If it's off, there is no other info.
   // Special modes.
   if (getSwing()) {
@@ -597,9 +713,9 @@ String IRCoolixAC::toString(void) {
     result += kToggleStr;
     return result;
   }
-  result += addModeToString(getMode(), kCoolixAuto, kCoolixCool, kCoolixHeat,
-                            kCoolixDry, kCoolixFan);
-  result += addIntToString(getFan(), kFanStr);
+  addModeToString(&result, getMode(), kCoolixAuto, kCoolixCool, kCoolixHeat,
+                  kCoolixDry, kCoolixFan);
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (getFan()) {
     case kCoolixFanAuto:
@@ -629,9 +745,9 @@ String IRCoolixAC::toString(void) {
   }
   result += ')';
   // Fan mode doesn't have a temperature.
-  if (getMode() != kCoolixFan) result += addTempToString(getTemp());
-  result += addBoolToString(getZoneFollow(), kZoneFollowStr);
-  result += addLabeledString(
+  if (getMode() != kCoolixFan) addTempToString(&result, getTemp());
+  addBoolToString(&result, getZoneFollow(), kZoneFollowStr);
+  addLabeledString(&result, 
       (getSensorTemp() > kCoolixSensorTempMax)
           ? kOffStr : uint64ToString(getSensorTemp()) + 'C', kSensorTempStr);
   return result;
@@ -658,10 +774,7 @@ bool IRrecv::decodeCOOLIX(decode_results *results, uint16_t offset,
   if (nbits % 8 != 0)  // nbits has to be a multiple of nr. of bits in a byte.
     return false;
 
-  uint64_t data = 0;
-  uint64_t inverted = 0;
-
-  if (nbits > sizeof(data) * 8)
+  if (nbits > sizeof(results->value) * 8)
     return false;  // We can't possibly capture a Coolix packet that big.
 
   // Header
@@ -674,25 +787,13 @@ bool IRrecv::decodeCOOLIX(decode_results *results, uint16_t offset,
 
   // Data
   // Twice as many bits as there are normal plus inverted bits.
-  for (uint16_t i = 0; i < nbits * 2; i++, offset++) {
-    bool flip = (i / 8) % 2;
-    if (!matchMark(results->rawbuf[offset++], kCoolixBitMarkTicks * m_tick))
-      return false;
-    if (matchSpace(results->rawbuf[offset], kCoolixOneSpaceTicks * s_tick)) {
-      if (flip)
-        inverted = (inverted << 1) | 1;
-      else
-        data = (data << 1) | 1;
-    } else if (matchSpace(results->rawbuf[offset],
-                          kCoolixZeroSpaceTicks * s_tick)) {
-      if (flip)
-        inverted <<= 1;
-      else
-        data <<= 1;
-    } else {
-      return false;
-    }
-  }
+  // Compliance: When strict, every inverted byte is checked as we go.
+  const match_result_t data = matchBytePairs(
+      results->rawbuf + offset, nbits,
+      kCoolixBitMarkTicks * m_tick, kCoolixOneSpaceTicks * s_tick,
+      kCoolixBitMarkTicks * m_tick, kCoolixZeroSpaceTicks * s_tick, strict);
+  if (!data.success) return false;
+  offset += data.used;
 
   // Footer
   if (!matchMark(results->rawbuf[offset++], kCoolixBitMarkTicks * m_tick))
@@ -701,17 +802,10 @@ bool IRrecv::decodeCOOLIX(decode_results *results, uint16_t offset,
       !matchAtLeast(results->rawbuf[offset], kCoolixMinGapTicks * s_tick))
     return false;
 
-  // Compliance
-  uint64_t orig = data;  // Save a copy of the data.
-  if (strict) {
-    for (uint16_t i = 0; i < nbits; i += 8, data >>= 8, inverted >>= 8)
-      if ((data & 0xFF) != ((inverted & 0xFF) ^ 0xFF)) return false;
-  }
-
   // Success
   results->decode_type = COOLIX;
   results->bits = nbits;
-  results->value = orig;
+  results->value = data.data;
   results->address = 0;
   results->command = 0;
   return true;
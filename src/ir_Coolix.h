@@ -97,6 +97,8 @@ const uint32_t kCoolixClean  = 0b101101011111010110101010;  // 0xB5F5AA
 const uint32_t kCoolixCmdFan = 0b101100101011111111100100;  // 0xB2BFE4
 // On, 25C, Mode: Auto, Fan: Auto, Zone Follow: Off, Sensor Temp: Ignore.
 const uint32_t kCoolixDefaultState = 0b101100100001111111001000;  // 0xB21FC8
+// The most messages `IRac::coolix()` sends. i.e. 5 special commands + a state.
+const uint8_t kCoolixMaxSequence = 6;
 
 // Classes
 
@@ -109,6 +111,10 @@ class IRCoolixAC {
   void stateReset();
 #if SEND_COOLIX
   void send(const uint16_t repeat = kCoolixDefaultRepeat);
+  void sendSequence(const uint32_t codes[], const uint16_t ncodes,
+                    const uint16_t repeat = kCoolixDefaultRepeat);
+  void sendSensorTemp(const uint8_t degrees,
+                      const uint16_t repeat = kCoolixDefaultRepeat);
   /// Run the calibration to calculate uSec timing offsets for this platform.
   /// @return The uSec timing offset needed per modulation of the IR Led.
   /// @note This will produce a 65ms IR signal pulse at 38kHz.
@@ -10,6 +10,7 @@
 #include <cstring>
 #include "IRac.h"
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -35,6 +36,16 @@ const uint16_t kCoronaAcOverheadShort = 3;
 const uint16_t kCoronaAcOverhead = 11;  // full message
 const uint8_t kCoronaTolerance = 5;  // +5%
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchCoronaAcHdrMark == kCoronaAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapCoronaAcHdrMark == kCoronaAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapCoronaAcHdrSpace == kCoronaAcHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapCoronaAcSpaceGap == kCoronaAcSpaceGap,
+              "See IRrecvTimings.h");
+
 #if SEND_CORONA_AC
 /// Send a CoronaAc formatted message.
 /// Status: STABLE / Working on real device.
@@ -550,23 +561,23 @@ void IRCoronaAc::setOffTimer(const uint16_t nr_of_mins) {
 String IRCoronaAc::toString(void) {
   String result = "";
   result.reserve(140);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addBoolToString(getPowerButton(), kPowerButtonStr);
-  result += addModeToString(getMode(), 0xFF, kCoronaAcModeCool,
-                            kCoronaAcModeHeat, kCoronaAcModeDry,
-                            kCoronaAcModeFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kCoronaAcFanHigh, kCoronaAcFanLow,
-                           kCoronaAcFanAuto, kCoronaAcFanAuto,
-                           kCoronaAcFanMedium);
-  result += addBoolToString(getSwingVToggle(), kSwingVToggleStr);
-  result += addBoolToString(getEcono(), kEconoStr);
-  result += addLabeledString(getOnTimer()
-                             ? minsToString(getOnTimer()) : kOffStr,
-                             kOnTimerStr);
-  result += addLabeledString(getOffTimer()
-                             ? minsToString(getOffTimer()) : kOffStr,
-                             kOffTimerStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addBoolToString(&result, getPowerButton(), kPowerButtonStr);
+  addModeToString(&result, getMode(), 0xFF, kCoronaAcModeCool,
+                  kCoronaAcModeHeat, kCoronaAcModeDry,
+                  kCoronaAcModeFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kCoronaAcFanHigh, kCoronaAcFanLow,
+                 kCoronaAcFanAuto, kCoronaAcFanAuto,
+                 kCoronaAcFanMedium);
+  addBoolToString(&result, getSwingVToggle(), kSwingVToggleStr);
+  addBoolToString(&result, getEcono(), kEconoStr);
+  addLabeledString(&result, getOnTimer()
+                   ? minsToString(getOnTimer()) : kOffStr,
+                   kOnTimerStr);
+  addLabeledString(&result, getOffTimer()
+                   ? minsToString(getOffTimer()) : kOffStr,
+                   kOffTimerStr);
   return result;
 }
 
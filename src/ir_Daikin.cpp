@@ -28,6 +28,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #ifdef UNIT_TEST
@@ -44,12 +45,277 @@ using irutils::addModeToString;
 using irutils::addTempToString;
 using irutils::addFanToString;
 using irutils::bcdToUint8;
+using irutils::checksum_t;
+using irutils::kChecksumToEnd;
+using irutils::kSumBytesChecksum;
 using irutils::minsToString;
 using irutils::setBit;
 using irutils::setBits;
 using irutils::sumNibbles;
 using irutils::uint8ToBcd;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchDaikin216HdrMark == kDaikin216HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchDaikin160HdrMark == kDaikin160HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchDaikin176HdrMark == kDaikin176HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikinBitMark == kDaikinBitMark, "See IRrecvTimings.h");
+static_assert(kLongGapDaikinZeroSpace == kDaikinZeroSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikinGap == kDaikinGap, "See IRrecvTimings.h");
+static_assert(kLongGapDaikin216HdrMark == kDaikin216HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin216HdrSpace == kDaikin216HdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin216Gap == kDaikin216Gap, "See IRrecvTimings.h");
+static_assert(kLongGapDaikin160HdrMark == kDaikin160HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin160HdrSpace == kDaikin160HdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin160Gap == kDaikin160Gap, "See IRrecvTimings.h");
+static_assert(kLongGapDaikin176HdrMark == kDaikin176HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin176HdrSpace == kDaikin176HdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin176Gap == kDaikin176Gap, "See IRrecvTimings.h");
+static_assert(kLongGapDaikin128LeaderMark == kDaikin128LeaderMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin128LeaderSpace == kDaikin128LeaderSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin128Gap == kDaikin128Gap, "See IRrecvTimings.h");
+static_assert(kLongGapDaikin2LeaderMark == kDaikin2LeaderMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapDaikin2LeaderSpace == kDaikin2LeaderSpace,
+              "See IRrecvTimings.h");
+
+// The checksummed sections of each of the multi-section Daikin protocols.
+// The last section of each runs to the end of the state, as shorter versions
+// of some of the protocols are in the wild.
+const checksum_t kDaikinChecksums[] = {
+    {kSumBytesChecksum, 0, kDaikinSection1Length, 0},
+    {kSumBytesChecksum, kDaikinSection1Length, kDaikinSection2Length, 0},
+    {kSumBytesChecksum, kDaikinSection1Length + kDaikinSection2Length,
+     kChecksumToEnd, 0}};
+const uint8_t kDaikinChecksumsSize =
+    sizeof(kDaikinChecksums) / sizeof(kDaikinChecksums[0]);
+const checksum_t kDaikin2Checksums[] = {
+    {kSumBytesChecksum, 0, kDaikin2Section1Length, 0},
+    {kSumBytesChecksum, kDaikin2Section1Length, kChecksumToEnd, 0}};
+const uint8_t kDaikin2ChecksumsSize =
+    sizeof(kDaikin2Checksums) / sizeof(kDaikin2Checksums[0]);
+const checksum_t kDaikin216Checksums[] = {
+    {kSumBytesChecksum, 0, kDaikin216Section1Length, 0},
+    {kSumBytesChecksum, kDaikin216Section1Length, kChecksumToEnd, 0}};
+const uint8_t kDaikin216ChecksumsSize =
+    sizeof(kDaikin216Checksums) / sizeof(kDaikin216Checksums[0]);
+const checksum_t kDaikin160Checksums[] = {
+    {kSumBytesChecksum, 0, kDaikin160Section1Length, 0},
+    {kSumBytesChecksum, kDaikin160Section1Length, kChecksumToEnd, 0}};
+const uint8_t kDaikin160ChecksumsSize =
+    sizeof(kDaikin160Checksums) / sizeof(kDaikin160Checksums[0]);
+const checksum_t kDaikin176Checksums[] = {
+    {kSumBytesChecksum, 0, kDaikin176Section1Length, 0},
+    {kSumBytesChecksum, kDaikin176Section1Length, kChecksumToEnd, 0}};
+const uint8_t kDaikin176ChecksumsSize =
+    sizeof(kDaikin176Checksums) / sizeof(kDaikin176Checksums[0]);
+const checksum_t kDaikin152Checksums[] = {
+    {kSumBytesChecksum, 0, kChecksumToEnd, 0}};
+const uint8_t kDaikin152ChecksumsSize =
+    sizeof(kDaikin152Checksums) / sizeof(kDaikin152Checksums[0]);
+
+// Section layouts of the multi-section messages. See `ac_sections_t`.
+const uint8_t kDaikinSectionSizes[] = {kDaikinSection1Length,
+                                       kDaikinSection2Length};
+const ac_sections_t kDaikinFrame = {
+    kDaikinHdrMark, kDaikinHdrSpace,
+    kDaikinBitMark, kDaikinOneSpace, kDaikinBitMark, kDaikinZeroSpace,
+    kDaikinBitMark, kDaikinZeroSpace + kDaikinGap, 38, 50, false,
+    kDaikinSectionSizes, kDaikinSections,
+    kDaikinChecksums, kDaikinChecksumsSize};
+const uint8_t kDaikin2SectionSizes[] = {kDaikin2Section1Length};
+const ac_sections_t kDaikin2Frame = {
+    kDaikin2HdrMark, kDaikin2HdrSpace,
+    kDaikin2BitMark, kDaikin2OneSpace, kDaikin2BitMark, kDaikin2ZeroSpace,
+    kDaikin2BitMark, kDaikin2Gap, kDaikin2Freq, 50, false,
+    kDaikin2SectionSizes, kDaikin2Sections,
+    kDaikin2Checksums, kDaikin2ChecksumsSize};
+const uint8_t kDaikin216SectionSizes[] = {kDaikin216Section1Length};
+const ac_sections_t kDaikin216Frame = {
+    kDaikin216HdrMark, kDaikin216HdrSpace,
+    kDaikin216BitMark, kDaikin216OneSpace,
+    kDaikin216BitMark, kDaikin216ZeroSpace,
+    kDaikin216BitMark, kDaikin216Gap, kDaikin216Freq, kDutyDefault, false,
+    kDaikin216SectionSizes, kDaikin216Sections,
+    kDaikin216Checksums, kDaikin216ChecksumsSize};
+const uint8_t kDaikin160SectionSizes[] = {kDaikin160Section1Length};
+const ac_sections_t kDaikin160Frame = {
+    kDaikin160HdrMark, kDaikin160HdrSpace,
+    kDaikin160BitMark, kDaikin160OneSpace,
+    kDaikin160BitMark, kDaikin160ZeroSpace,
+    kDaikin160BitMark, kDaikin160Gap, kDaikin160Freq, kDutyDefault, false,
+    kDaikin160SectionSizes, kDaikin160Sections,
+    kDaikin160Checksums, kDaikin160ChecksumsSize};
+const uint8_t kDaikin176SectionSizes[] = {kDaikin176Section1Length};
+const ac_sections_t kDaikin176Frame = {
+    kDaikin176HdrMark, kDaikin176HdrSpace,
+    kDaikin176BitMark, kDaikin176OneSpace,
+    kDaikin176BitMark, kDaikin176ZeroSpace,
+    kDaikin176BitMark, kDaikin176Gap, kDaikin176Freq, kDutyDefault, false,
+    kDaikin176SectionSizes, kDaikin176Sections,
+    kDaikin176Checksums, kDaikin176ChecksumsSize};
+
+#if SEND_DAIKIN
+// The constant leading parts of a Daikin message, as marks & spaces.
+// See `precompiled_section_t`.
+#define DAIKIN_PULSES_BYTE(byte) \
+    IR_PULSES_LSB_BYTE(kDaikinBitMark, kDaikinOneSpace, kDaikinZeroSpace, byte)
+// The header, 0b00000 (No header for the header)
+const uint16_t kDaikinHeaderPulses[] PROGMEM = {
+    kDaikinBitMark, kDaikinZeroSpace, kDaikinBitMark, kDaikinZeroSpace,
+    kDaikinBitMark, kDaikinZeroSpace, kDaikinBitMark, kDaikinZeroSpace,
+    kDaikinBitMark, kDaikinZeroSpace,
+    kDaikinBitMark, kDaikinZeroSpace + kDaikinGap};
+const precompiled_section_t kDaikinPrecompiledHeader = {
+    NULL, 0, kDaikinHeaderPulses,
+    sizeof(kDaikinHeaderPulses) / sizeof(kDaikinHeaderPulses[0])};
+// Section #1 is always the same. i.e. `kDaikinFirstHeader64`
+const uint8_t kDaikinSection1[kDaikinSection1Length] = {
+    0x11, 0xDA, 0x27, 0x00, 0xC5, 0x00, 0x00, 0xD7};
+const uint16_t kDaikinSection1Pulses[] PROGMEM = {
+    kDaikinHdrMark, kDaikinHdrSpace,
+    DAIKIN_PULSES_BYTE(0x11), DAIKIN_PULSES_BYTE(0xDA),
+    DAIKIN_PULSES_BYTE(0x27), DAIKIN_PULSES_BYTE(0x00),
+    DAIKIN_PULSES_BYTE(0xC5), DAIKIN_PULSES_BYTE(0x00),
+    DAIKIN_PULSES_BYTE(0x00), DAIKIN_PULSES_BYTE(0xD7),
+    kDaikinBitMark, kDaikinZeroSpace + kDaikinGap};
+const precompiled_section_t kDaikinPrecompiledSection1 = {
+    kDaikinSection1, kDaikinSection1Length, kDaikinSection1Pulses,
+    sizeof(kDaikinSection1Pulses) / sizeof(kDaikinSection1Pulses[0])};
+#endif  // SEND_DAIKIN
+
+// Where each protocol keeps its common settings. See `daikin_layout_t`.
+const daikin_layout_t kDaikinLayout = {
+    kDaikinBytePower, kDaikinBytePower, kDaikinModeOffset,
+    kDaikinByteFan, kDaikinFanOffset,
+    kDaikinByteTemp, kDaikinTempOffset, 7, 0};
+const daikin_layout_t kDaikin2Layout = {
+    25, 25, kHighNibble,
+    kDaikin2FanByte, kHighNibble,
+    26, kDaikinTempOffset, 7, 0};
+const daikin_layout_t kDaikin216Layout = {
+    kDaikin216BytePower, kDaikin216ByteMode, kHighNibble,
+    kDaikin216ByteFan, kHighNibble,
+    kDaikin216ByteTemp, kDaikin216TempOffset, kDaikin216TempSize, 0};
+const daikin_layout_t kDaikin160Layout = {
+    kDaikin160BytePower, kDaikin160ByteMode, kHighNibble,
+    kDaikin160ByteFan, kLowNibble,
+    kDaikin160ByteTemp, kDaikin160TempOffset, kDaikin160TempSize, 10};
+const daikin_layout_t kDaikin176Layout = {
+    kDaikin176ByteModePower, kDaikin176ByteModePower, kHighNibble,
+    kDaikin176ByteFan, kHighNibble,
+    kDaikin176ByteTemp, kDaikin176TempOffset, kDaikin176TempSize, 9};
+const daikin_layout_t kDaikin152Layout = {
+    kDaikin152PowerByte, kDaikin152ModeByte, kDaikinModeOffset,
+    kDaikin152FanByte, kHighNibble,
+    kDaikin152TempByte, kDaikinTempOffset, kDaikin152TempSize, 0};
+
+namespace daikin {
+  /// Change the power setting.
+  /// @param[in,out] state A ptr to the state to change.
+  /// @param[in] layout Where the settings are in the state.
+  /// @param[in] on true, the setting is on. false, the setting is off.
+  void setPower(uint8_t * const state, const daikin_layout_t &layout,
+                const bool on) {
+    setBit(&state[layout.powerByte], kDaikinBitPowerOffset, on);
+  }
+
+  /// Get the value of the current power setting.
+  /// @param[in] state A ptr to the state.
+  /// @param[in] layout Where the settings are in the state.
+  /// @return true, the setting is on. false, the setting is off.
+  bool getPower(const uint8_t * const state, const daikin_layout_t &layout) {
+    return GETBIT8(state[layout.powerByte], kDaikinBitPowerOffset);
+  }
+
+  /// Set the operating mode. Unknown modes are treated as `kDaikinAuto`.
+  /// @param[in,out] state A ptr to the state to change.
+  /// @param[in] layout Where the settings are in the state.
+  /// @param[in] mode The desired operating mode.
+  /// @return The operating mode that was set.
+  uint8_t setMode(uint8_t * const state, const daikin_layout_t &layout,
+                  const uint8_t mode) {
+    uint8_t native = mode;
+    switch (native) {
+      case kDaikinAuto:
+      case kDaikinCool:
+      case kDaikinHeat:
+      case kDaikinFan:
+      case kDaikinDry: break;
+      default: native = kDaikinAuto;
+    }
+    setBits(&state[layout.modeByte], layout.modeOffset, kDaikinModeSize,
+            native);
+    return native;
+  }
+
+  /// Get the operating mode setting.
+  /// @param[in] state A ptr to the state.
+  /// @param[in] layout Where the settings are in the state.
+  /// @return The current operating mode setting.
+  uint8_t getMode(const uint8_t * const state, const daikin_layout_t &layout) {
+    return GETBITS8(state[layout.modeByte], layout.modeOffset, kDaikinModeSize);
+  }
+
+  /// Set the speed of the fan.
+  /// @param[in,out] state A ptr to the state to change.
+  /// @param[in] layout Where the settings are in the state.
+  /// @param[in] fan The desired setting.
+  /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
+  void setFan(uint8_t * const state, const daikin_layout_t &layout,
+              const uint8_t fan) {
+    uint8_t fanset;
+    if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
+      fanset = fan;
+    else if (fan < kDaikinFanMin || fan > kDaikinFanMax)
+      fanset = kDaikinFanAuto;
+    else
+      fanset = 2 + fan;
+    setBits(&state[layout.fanByte], layout.fanOffset, kDaikinFanSize, fanset);
+  }
+
+  /// Get the current fan speed setting.
+  /// @param[in] state A ptr to the state.
+  /// @param[in] layout Where the settings are in the state.
+  /// @return The current fan speed.
+  uint8_t getFan(const uint8_t * const state, const daikin_layout_t &layout) {
+    uint8_t fan = GETBITS8(state[layout.fanByte], layout.fanOffset,
+                           kDaikinFanSize);
+    if (fan != kDaikinFanQuiet && fan != kDaikinFanAuto) fan -= 2;
+    return fan;
+  }
+
+  /// Set the temperature.
+  /// @param[in,out] state A ptr to the state to change.
+  /// @param[in] layout Where the settings are in the state.
+  /// @param[in] degrees The temperature in degrees celsius. Already in range.
+  void setTemp(uint8_t * const state, const daikin_layout_t &layout,
+               const uint8_t degrees) {
+    setBits(&state[layout.tempByte], layout.tempOffset, layout.tempSize,
+            degrees - layout.tempBase);
+  }
+
+  /// Get the current temperature setting.
+  /// @param[in] state A ptr to the state.
+  /// @param[in] layout Where the settings are in the state.
+  /// @return The current setting for temp. in degrees celsius.
+  uint8_t getTemp(const uint8_t * const state, const daikin_layout_t &layout) {
+    return GETBITS8(state[layout.tempByte], layout.tempOffset,
+                    layout.tempSize) + layout.tempBase;
+  }
+}  // namespace daikin
+
 #if SEND_DAIKIN
 /// Send a Daikin 280-bit A/C formatted message.
 /// Status: STABLE
@@ -66,22 +332,18 @@ void IRsend::sendDaikin(const unsigned char data[], const uint16_t nbytes,
   for (uint16_t r = 0; r <= repeat; r++) {
     uint16_t offset = 0;
     // Send the header, 0b00000
-    sendGeneric(0, 0,  // No header for the header
-                kDaikinBitMark, kDaikinOneSpace, kDaikinBitMark,
-                kDaikinZeroSpace, kDaikinBitMark, kDaikinZeroSpace + kDaikinGap,
-                (uint64_t)0b00000, kDaikinHeaderLength, 38, false, 0, 50);
+    sendPrecompiled(&kDaikinPrecompiledHeader, data, nbytes, 38, 50);
     // Data #1
     if (nbytes < kDaikinStateLength) {  // Are we using the legacy size?
       // Do this as a constant to save RAM and keep in flash memory
-      sendGeneric(kDaikinHdrMark, kDaikinHdrSpace, kDaikinBitMark,
-                  kDaikinOneSpace, kDaikinBitMark, kDaikinZeroSpace,
-                  kDaikinBitMark, kDaikinZeroSpace + kDaikinGap,
-                  kDaikinFirstHeader64, 64, 38, false, 0, 50);
+      sendPrecompiled(&kDaikinPrecompiledSection1, kDaikinSection1,
+                      kDaikinSection1Length, 38, 50);
     } else {  // We are using the newer/more correct size.
-      sendGeneric(kDaikinHdrMark, kDaikinHdrSpace, kDaikinBitMark,
-                  kDaikinOneSpace, kDaikinBitMark, kDaikinZeroSpace,
-                  kDaikinBitMark, kDaikinZeroSpace + kDaikinGap,
-                  data, kDaikinSection1Length, 38, false, 0, 50);
+      if (!sendPrecompiled(&kDaikinPrecompiledSection1, data, nbytes, 38, 50))
+        sendGeneric(kDaikinHdrMark, kDaikinHdrSpace, kDaikinBitMark,
+                    kDaikinOneSpace, kDaikinBitMark, kDaikinZeroSpace,
+                    kDaikinBitMark, kDaikinZeroSpace + kDaikinGap,
+                    data, kDaikinSection1Length, 38, false, 0, 50);
       offset += kDaikinSection1Length;
     }
     // Data #2
@@ -123,33 +385,14 @@ void IRDaikinESP::send(const uint16_t repeat) {
 /// @param[in] length The length of the state array.
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRDaikinESP::validChecksum(uint8_t state[], const uint16_t length) {
-  // Data #1
-  if (length < kDaikinSection1Length ||
-      state[kDaikinByteChecksum1] != sumBytes(state, kDaikinSection1Length - 1))
-    return false;
-  // Data #2
-  if (length < kDaikinSection1Length + kDaikinSection2Length ||
-      state[kDaikinByteChecksum2] != sumBytes(state + kDaikinSection1Length,
-                                              kDaikinSection2Length - 1))
-    return false;
-  // Data #3
-  if (length < kDaikinSection1Length + kDaikinSection2Length + 2 ||
-      state[length - 1] != sumBytes(state + kDaikinSection1Length +
-                                    kDaikinSection2Length,
-                                    length - (kDaikinSection1Length +
-                                              kDaikinSection2Length) - 1))
-    return false;
-  return true;
+  return irutils::validChecksums(kDaikinChecksums, kDaikinChecksumsSize,
+                                 state, length);
 }
 
 /// Calculate and set the checksum values for the internal state.
 void IRDaikinESP::checksum(void) {
-  remote[kDaikinByteChecksum1] = sumBytes(remote, kDaikinSection1Length - 1);
-  remote[kDaikinByteChecksum2] = sumBytes(remote + kDaikinSection1Length,
-                                          kDaikinSection2Length - 1);
-  remote[kDaikinByteChecksum3] = sumBytes(remote + kDaikinSection1Length +
-                                          kDaikinSection2Length,
-                                          kDaikinSection3Length - 1);
+  irutils::setChecksums(kDaikinChecksums, kDaikinChecksumsSize,
+                        remote, kDaikinStateLength);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -209,13 +452,13 @@ void IRDaikinESP::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setPower(const bool on) {
-  setBit(&remote[kDaikinBytePower], kDaikinBitPowerOffset, on);
+  daikin::setPower(remote, kDaikinLayout, on);
 }
 
 /// Get the value of the current power setting.
 /// @return true, the setting is on. false, the setting is off.
 bool IRDaikinESP::getPower(void) {
-  return GETBIT8(remote[kDaikinBytePower], kDaikinBitPowerOffset);
+  return daikin::getPower(remote, kDaikinLayout);
 }
 
 /// Set the temperature.
@@ -228,53 +471,33 @@ void IRDaikinESP::setTemp(const uint8_t temp) {
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
-uint8_t IRDaikinESP::getTemp(void) { return remote[kDaikinByteTemp] >> 1; }
+uint8_t IRDaikinESP::getTemp(void) {
+  return daikin::getTemp(remote, kDaikinLayout);
+}
 
 /// Set the speed of the fan.
 /// @param[in] fan The desired setting.
 /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
 void IRDaikinESP::setFan(const uint8_t fan) {
-  // Set the fan speed bits, leave low 4 bits alone
-  uint8_t fanset;
-  if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
-    fanset = fan;
-  else if (fan < kDaikinFanMin || fan > kDaikinFanMax)
-    fanset = kDaikinFanAuto;
-  else
-    fanset = 2 + fan;
-  setBits(&remote[kDaikinByteFan], kDaikinFanOffset, kDaikinFanSize, fanset);
+  daikin::setFan(remote, kDaikinLayout, fan);
 }
 
 /// Get the current fan speed setting.
 /// @return The current fan speed.
 uint8_t IRDaikinESP::getFan(void) {
-  uint8_t fan = GETBITS8(remote[kDaikinByteFan], kDaikinFanOffset,
-                         kDaikinFanSize);
-  if (fan != kDaikinFanQuiet && fan != kDaikinFanAuto) fan -= 2;
-  return fan;
+  return daikin::getFan(remote, kDaikinLayout);
 }
 
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRDaikinESP::getMode(void) {
-  return GETBITS8(remote[kDaikinBytePower], kDaikinModeOffset, kDaikinModeSize);
+  return daikin::getMode(remote, kDaikinLayout);
 }
 
 /// Set the operating mode of the A/C.
 /// @param[in] mode The desired operating mode.
 void IRDaikinESP::setMode(const uint8_t mode) {
-  switch (mode) {
-    case kDaikinAuto:
-    case kDaikinCool:
-    case kDaikinHeat:
-    case kDaikinFan:
-    case kDaikinDry:
-      setBits(&remote[kDaikinBytePower], kDaikinModeOffset, kDaikinModeSize,
-              mode);
-      break;
-    default:
-      this->setMode(kDaikinAuto);
-  }
+  daikin::setMode(remote, kDaikinLayout, mode);
 }
 
 /// Set the Vertical Swing mode of the A/C.
@@ -580,28 +803,28 @@ stdAc::state_t IRDaikinESP::toCommon(void) {
 String IRDaikinESP::toString(void) {
   String result = "";
   result.reserve(230);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
-                            kDaikinDry, kDaikinFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikinFanMax, kDaikinFanMin,
-                           kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getSensor(), kSensorStr);
-  result += addBoolToString(getMold(), kMouldStr);
-  result += addBoolToString(getComfort(), kComfortStr);
-  result += addBoolToString(getSwingHorizontal(), kSwingHStr);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
-  result += addLabeledString(minsToString(this->getCurrentTime()), kClockStr);
-  result += addDayToString(getCurrentDay(), -1);
-  result += addLabeledString(getOnTimerEnabled()
-                             ? minsToString(this->getOnTime()) : kOffStr,
-                             kOnTimerStr);
-  result += addLabeledString(getOffTimerEnabled()
-                             ? minsToString(this->getOffTime()) : kOffStr,
-                             kOffTimerStr);
-  result += addBoolToString(getWeeklyTimerEnable(), kWeeklyTimerStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
+                  kDaikinDry, kDaikinFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikinFanMax, kDaikinFanMin,
+                 kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getSensor(), kSensorStr);
+  addBoolToString(&result, getMold(), kMouldStr);
+  addBoolToString(&result, getComfort(), kComfortStr);
+  addBoolToString(&result, getSwingHorizontal(), kSwingHStr);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
+  addLabeledString(&result, minsToString(this->getCurrentTime()), kClockStr);
+  addDayToString(&result, getCurrentDay(), -1);
+  addLabeledString(&result, getOnTimerEnabled()
+                   ? minsToString(this->getOnTime()) : kOffStr,
+                   kOnTimerStr);
+  addLabeledString(&result, getOffTimerEnabled()
+                   ? minsToString(this->getOffTime()) : kOffStr,
+                   kOffTimerStr);
+  addBoolToString(&result, getWeeklyTimerEnable(), kWeeklyTimerStr);
   return result;
 }
 
@@ -621,7 +844,9 @@ bool IRrecv::decodeDaikin(decode_results *results, uint16_t offset,
   // Is there enough data to match successfully?
   if (results->rawlen < (2 * (nbits + kDaikinHeaderLength) +
                          kDaikinSections * (kHeader + kFooter) + kFooter - 1) +
-                         offset)
+                         offset &&
+      !_sectionsMayFit(results, offset + 2 * kDaikinHeaderLength + kFooter,
+                       &kDaikinFrame))
     return false;
 
   // Compliance
@@ -643,31 +868,10 @@ bool IRrecv::decodeDaikin(decode_results *results, uint16_t offset,
   if (!matchSpace(results->rawbuf[offset++], kDaikinZeroSpace + kDaikinGap,
                   kDaikinTolerance, kDaikinMarkExcess)) return false;
   // Sections
-  const uint8_t ksectionSize[kDaikinSections] = {
-      kDaikinSection1Length, kDaikinSection2Length, kDaikinSection3Length};
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikinSections; section++) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikinHdrMark, kDaikinHdrSpace,
-                        kDaikinBitMark, kDaikinOneSpace,
-                        kDaikinBitMark, kDaikinZeroSpace,
-                        kDaikinBitMark, kDaikinZeroSpace + kDaikinGap,
-                        section >= kDaikinSections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
-  // Compliance
-  if (strict) {
-    // Re-check we got the correct size/length due to the way we read the data.
-    if (pos * 8 != kDaikinBits) return false;
-    // Validate the checksum.
-    if (!IRDaikinESP::validChecksum(results->state)) return false;
-  }
+  if (!matchSections(results->rawbuf + offset, results->state,
+                     results->rawlen - offset, nbits / 8, &kDaikinFrame,
+                     strict, kDaikinTolerance, kDaikinMarkExcess))
+    return false;  // N.B. This has checked the checksums if strict.
 
   // Success
   results->decode_type = DAIKIN;
@@ -696,17 +900,8 @@ void IRsend::sendDaikin2(const unsigned char data[], const uint16_t nbytes,
     sendGeneric(kDaikin2LeaderMark, kDaikin2LeaderSpace,
                 0, 0, 0, 0, 0, 0, (uint64_t) 0,  // No data payload.
                 0, kDaikin2Freq, false, 0, 50);
-    // Section #1
-    sendGeneric(kDaikin2HdrMark, kDaikin2HdrSpace, kDaikin2BitMark,
-                kDaikin2OneSpace, kDaikin2BitMark, kDaikin2ZeroSpace,
-                kDaikin2BitMark, kDaikin2Gap, data, kDaikin2Section1Length,
-                kDaikin2Freq, false, 0, 50);
-    // Section #2
-    sendGeneric(kDaikin2HdrMark, kDaikin2HdrSpace, kDaikin2BitMark,
-                kDaikin2OneSpace, kDaikin2BitMark, kDaikin2ZeroSpace,
-                kDaikin2BitMark, kDaikin2Gap, data + kDaikin2Section1Length,
-                nbytes - kDaikin2Section1Length,
-                kDaikin2Freq, false, 0, 50);
+    // Sections
+    sendSections(&kDaikin2Frame, data, nbytes);
   }
 }
 #endif  // SEND_DAIKIN2
@@ -735,25 +930,14 @@ void IRDaikin2::send(const uint16_t repeat) {
 /// @param[in] length The length of the state array.
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRDaikin2::validChecksum(uint8_t state[], const uint16_t length) {
-  // Validate the checksum of section #1.
-  if (length <= kDaikin2Section1Length - 1 ||
-      state[kDaikin2Section1Length - 1] != sumBytes(state,
-                                                    kDaikin2Section1Length - 1))
-    return false;
-  // Validate the checksum of section #2 (a.k.a. the rest)
-  if (length <= kDaikin2Section1Length + 1 ||
-      state[length - 1] != sumBytes(state + kDaikin2Section1Length,
-                                    length - kDaikin2Section1Length - 1))
-    return false;
-  return true;
+  return irutils::validChecksums(kDaikin2Checksums, kDaikin2ChecksumsSize,
+                                 state, length);
 }
 
 /// Calculate and set the checksum values for the internal state.
 void IRDaikin2::checksum(void) {
-  remote_state[kDaikin2Section1Length - 1] = sumBytes(
-      remote_state, kDaikin2Section1Length - 1);
-  remote_state[kDaikin2StateLength -1 ] = sumBytes(
-      remote_state + kDaikin2Section1Length, kDaikin2Section2Length - 1);
+  irutils::setChecksums(kDaikin2Checksums, kDaikin2ChecksumsSize,
+                        remote_state, kDaikin2StateLength);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -813,35 +997,28 @@ void IRDaikin2::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikin2::setPower(const bool on) {
-  setBit(&remote_state[25], kDaikinBitPowerOffset, on);
+  daikin::setPower(remote_state, kDaikin2Layout, on);
   setBit(&remote_state[6], kDaikin2BitPowerOffset, !on);
 }
 
 /// Get the value of the current power setting.
 /// @return true, the setting is on. false, the setting is off.
 bool IRDaikin2::getPower(void) {
-  return GETBIT8(remote_state[25], kDaikinBitPowerOffset) &&
+  return daikin::getPower(remote_state, kDaikin2Layout) &&
          !GETBIT8(remote_state[6], kDaikin2BitPowerOffset);
 }
 
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRDaikin2::getMode(void) {
-  return GETBITS8(remote_state[25], kHighNibble, kModeBitsSize);
+  return daikin::getMode(remote_state, kDaikin2Layout);
 }
 
 /// Set the operating mode of the A/C.
 /// @param[in] desired_mode The desired operating mode.
 void IRDaikin2::setMode(const uint8_t desired_mode) {
-  uint8_t mode = desired_mode;
-  switch (mode) {
-    case kDaikinCool:
-    case kDaikinHeat:
-    case kDaikinFan:
-    case kDaikinDry: break;
-    default: mode = kDaikinAuto;
-  }
-  setBits(&remote_state[25], kHighNibble, kModeBitsSize, mode);
+  const uint8_t mode = daikin::setMode(remote_state, kDaikin2Layout,
+                                       desired_mode);
   // Redo the temp setting as Cool mode has a different min temp.
   if (mode == kDaikinCool) this->setTemp(this->getTemp());
 }
@@ -860,32 +1037,20 @@ void IRDaikin2::setTemp(const uint8_t desired) {
 /// @param[in] fan The desired setting.
 /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
 void IRDaikin2::setFan(const uint8_t fan) {
-  // Set the fan speed bits, leave low 4 bits alone
-  uint8_t fanset;
-  if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
-    fanset = fan;
-  else if (fan < kDaikinFanMin || fan > kDaikinFanMax)
-    fanset = kDaikinFanAuto;
-  else
-    fanset = 2 + fan;
-  setBits(&remote_state[kDaikin2FanByte], kHighNibble, kNibbleSize, fanset);
+  daikin::setFan(remote_state, kDaikin2Layout, fan);
 }
 
 /// Get the current fan speed setting.
 /// @return The current fan speed.
 uint8_t IRDaikin2::getFan(void) {
-  const uint8_t fan = GETBITS8(remote_state[kDaikin2FanByte], kHighNibble,
-                              kNibbleSize);
-  switch (fan) {
-    case kDaikinFanAuto:
-    case kDaikinFanQuiet: return fan;
-    default: return fan - 2;
-  }
+  return daikin::getFan(remote_state, kDaikin2Layout);
 }
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
-uint8_t IRDaikin2::getTemp(void) { return remote_state[26] >> 1; }
+uint8_t IRDaikin2::getTemp(void) {
+  return daikin::getTemp(remote_state, kDaikin2Layout);
+}
 
 /// Set the Vertical Swing mode of the A/C.
 /// @param[in] position The position/mode to set the swing to.
@@ -1290,13 +1455,13 @@ stdAc::state_t IRDaikin2::toCommon(void) {
 String IRDaikin2::toString(void) {
   String result = "";
   result.reserve(310);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
-                            kDaikinDry, kDaikinFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikinFanMax, kDaikinFanMin,
-                           kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
-  result += addIntToString(getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
+                  kDaikinDry, kDaikinFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikinFanMax, kDaikinFanMin,
+                 kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
+  addIntToString(&result, getSwingVertical(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (getSwingVertical()) {
     case kDaikin2SwingVHigh:
@@ -1335,7 +1500,7 @@ String IRDaikin2::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getSwingHorizontal(), kSwingHStr);
+  addIntToString(&result, getSwingHorizontal(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (getSwingHorizontal()) {
     case kDaikin2SwingHAuto:
@@ -1347,16 +1512,16 @@ String IRDaikin2::toString(void) {
     default: result += kUnknownStr;
   }
   result += ')';
-  result += addLabeledString(minsToString(getCurrentTime()), kClockStr);
-  result += addLabeledString(
+  addLabeledString(&result, minsToString(getCurrentTime()), kClockStr);
+  addLabeledString(&result, 
       getOnTimerEnabled() ? minsToString(getOnTime()) : kOffStr, kOnTimerStr);
-  result += addLabeledString(
+  addLabeledString(&result, 
       getOffTimerEnabled() ? minsToString(getOffTime()) : kOffStr,
       kOffTimerStr);
-  result += addLabeledString(
+  addLabeledString(&result, 
       getSleepTimerEnabled() ? minsToString(getSleepTime()) : kOffStr,
       kSleepTimerStr);
-  result += addIntToString(getBeep(), kBeepStr);
+  addIntToString(&result, getBeep(), kBeepStr);
   result += kSpaceLBraceStr;
   switch (getBeep()) {
     case kDaikinBeepLoud:
@@ -1372,7 +1537,7 @@ String IRDaikin2::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getLight(), kLightStr);
+  addIntToString(&result, getLight(), kLightStr);
   result += kSpaceLBraceStr;
   switch (getLight()) {
     case kDaikinLightBright:
@@ -1388,17 +1553,17 @@ String IRDaikin2::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getMold(), kMouldStr);
-  result += addBoolToString(getClean(), kCleanStr);
-  result += addLabeledString(
+  addBoolToString(&result, getMold(), kMouldStr);
+  addBoolToString(&result, getClean(), kCleanStr);
+  addLabeledString(&result, 
       getFreshAir() ? (getFreshAirHigh() ? kHighStr : kOnStr) : kOffStr,
       kFreshStr);
-  result += addBoolToString(getEye(), kEyeStr);
-  result += addBoolToString(getEyeAuto(), kEyeAutoStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
-  result += addBoolToString(getPurify(), kPurifyStr);
-  result += addBoolToString(getEcono(), kEconoStr);
+  addBoolToString(&result, getEye(), kEyeStr);
+  addBoolToString(&result, getEyeAuto(), kEyeAutoStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getPurify(), kPurifyStr);
+  addBoolToString(&result, getEcono(), kEconoStr);
   return result;
 }
 
@@ -1414,15 +1579,13 @@ String IRDaikin2::toString(void) {
 /// @return A boolean. True if it can decode it, false if it can't.
 bool IRrecv::decodeDaikin2(decode_results *results, uint16_t offset,
                            const uint16_t nbits, const bool strict) {
-  if (results->rawlen < 2 * (nbits + kHeader + kFooter) + kHeader - 1 + offset)
+  if (results->rawlen < 2 * (nbits + kHeader + kFooter) + kHeader - 1 + offset &&
+      !_sectionsMayFit(results, offset + kHeader, &kDaikin2Frame))
     return false;
 
   // Compliance
   if (strict && nbits != kDaikin2Bits) return false;
 
-  const uint8_t ksectionSize[kDaikin2Sections] = {kDaikin2Section1Length,
-                                                  kDaikin2Section2Length};
-
   // Leader
   if (!matchMark(results->rawbuf[offset++], kDaikin2LeaderMark,
                  _tolerance + kDaikin2Tolerance)) return false;
@@ -1430,30 +1593,11 @@ bool IRrecv::decodeDaikin2(decode_results *results, uint16_t offset,
                   _tolerance + kDaikin2Tolerance)) return false;
 
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin2Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin2HdrMark, kDaikin2HdrSpace,
-                        kDaikin2BitMark, kDaikin2OneSpace,
-                        kDaikin2BitMark, kDaikin2ZeroSpace,
-                        kDaikin2BitMark, kDaikin2Gap,
-                        section >= kDaikin2Sections - 1,
-                        _tolerance + kDaikin2Tolerance, kDaikinMarkExcess,
-                        false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
-  // Compliance
-  if (strict) {
-    // Re-check we got the correct size/length due to the way we read the data.
-    if (pos * 8 != kDaikin2Bits) return false;
-    // Validate the checksum.
-    if (!IRDaikin2::validChecksum(results->state)) return false;
-  }
+  if (!matchSections(results->rawbuf + offset, results->state,
+                     results->rawlen - offset, nbits / 8, &kDaikin2Frame,
+                     strict, _tolerance + kDaikin2Tolerance,
+                     kDaikinMarkExcess))
+    return false;  // N.B. This has checked the checksums if strict.
 
   // Success
   results->decode_type = DAIKIN2;
@@ -1479,19 +1623,8 @@ void IRsend::sendDaikin216(const unsigned char data[], const uint16_t nbytes,
     return;  // Not enough bytes to send a partial message.
 
   for (uint16_t r = 0; r <= repeat; r++) {
-    // Section #1
-    sendGeneric(kDaikin216HdrMark, kDaikin216HdrSpace, kDaikin216BitMark,
-                kDaikin216OneSpace, kDaikin216BitMark, kDaikin216ZeroSpace,
-                kDaikin216BitMark, kDaikin216Gap, data,
-                kDaikin216Section1Length,
-                kDaikin216Freq, false, 0, kDutyDefault);
-    // Section #2
-    sendGeneric(kDaikin216HdrMark, kDaikin216HdrSpace, kDaikin216BitMark,
-                kDaikin216OneSpace, kDaikin216BitMark, kDaikin216ZeroSpace,
-                kDaikin216BitMark, kDaikin216Gap,
-                data + kDaikin216Section1Length,
-                nbytes - kDaikin216Section1Length,
-                kDaikin216Freq, false, 0, kDutyDefault);
+    // Sections
+    sendSections(&kDaikin216Frame, data, nbytes);
   }
 }
 #endif  // SEND_DAIKIN216
@@ -1520,25 +1653,14 @@ void IRDaikin216::send(const uint16_t repeat) {
 /// @param[in] length The length of the state array.
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRDaikin216::validChecksum(uint8_t state[], const uint16_t length) {
-  // Validate the checksum of section #1.
-  if (length <= kDaikin216Section1Length - 1 ||
-      state[kDaikin216Section1Length - 1] != sumBytes(
-          state, kDaikin216Section1Length - 1))
-    return false;
-  // Validate the checksum of section #2 (a.k.a. the rest)
-  if (length <= kDaikin216Section1Length + 1 ||
-      state[length - 1] != sumBytes(state + kDaikin216Section1Length,
-                                    length - kDaikin216Section1Length - 1))
-    return false;
-  return true;
+  return irutils::validChecksums(kDaikin216Checksums, kDaikin216ChecksumsSize,
+                                 state, length);
 }
 
 /// Calculate and set the checksum values for the internal state.
 void IRDaikin216::checksum(void) {
-  remote_state[kDaikin216Section1Length - 1] = sumBytes(
-      remote_state, kDaikin216Section1Length - 1);
-  remote_state[kDaikin216StateLength - 1] = sumBytes(
-      remote_state + kDaikin216Section1Length, kDaikin216Section2Length - 1);
+  irutils::setChecksums(kDaikin216Checksums, kDaikin216ChecksumsSize,
+                        remote_state, kDaikin216StateLength);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -1578,36 +1700,25 @@ void IRDaikin216::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikin216::setPower(const bool on) {
-  setBit(&remote_state[kDaikin216BytePower], kDaikinBitPowerOffset, on);
+  daikin::setPower(remote_state, kDaikin216Layout, on);
 }
 
 /// Get the value of the current power setting.
 /// @return true, the setting is on. false, the setting is off.
 bool IRDaikin216::getPower(void) {
-  return GETBIT8(remote_state[kDaikin216BytePower], kDaikinBitPowerOffset);
+  return daikin::getPower(remote_state, kDaikin216Layout);
 }
 
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRDaikin216::getMode(void) {
-  return GETBITS8(remote_state[kDaikin216ByteMode], kHighNibble, kModeBitsSize);
+  return daikin::getMode(remote_state, kDaikin216Layout);
 }
 
 /// Set the operating mode of the A/C.
 /// @param[in] mode The desired operating mode.
 void IRDaikin216::setMode(const uint8_t mode) {
-  switch (mode) {
-    case kDaikinAuto:
-    case kDaikinCool:
-    case kDaikinHeat:
-    case kDaikinFan:
-    case kDaikinDry:
-      setBits(&remote_state[kDaikin216ByteMode], kHighNibble, kModeBitsSize,
-              mode);
-      break;
-    default:
-      this->setMode(kDaikinAuto);
-  }
+  daikin::setMode(remote_state, kDaikin216Layout, mode);
 }
 
 /// Convert a stdAc::opmode_t enum into its native mode.
@@ -1622,40 +1733,26 @@ uint8_t IRDaikin216::convertMode(const stdAc::opmode_t mode) {
 void IRDaikin216::setTemp(const uint8_t temp) {
   uint8_t degrees = std::max(temp, kDaikinMinTemp);
   degrees = std::min(degrees, kDaikinMaxTemp);
-  setBits(&remote_state[kDaikin216ByteTemp], kDaikin216TempOffset,
-          kDaikin216TempSize, degrees);
+  daikin::setTemp(remote_state, kDaikin216Layout, degrees);
 }
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
 uint8_t IRDaikin216::getTemp(void) {
-  return GETBITS8(remote_state[kDaikin216ByteTemp], kDaikin216TempOffset,
-                  kDaikin216TempSize);
+  return daikin::getTemp(remote_state, kDaikin216Layout);
 }
 
 /// Set the speed of the fan.
 /// @param[in] fan The desired setting.
 /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
 void IRDaikin216::setFan(const uint8_t fan) {
-  // Set the fan speed bits, leave low 4 bits alone
-  uint8_t fanset;
-  if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
-    fanset = fan;
-  else if (fan < kDaikinFanMin || fan > kDaikinFanMax)
-    fanset = kDaikinFanAuto;
-  else
-    fanset = 2 + fan;
-  setBits(&remote_state[kDaikin216ByteFan], kHighNibble, kDaikinFanSize,
-          fanset);
+  daikin::setFan(remote_state, kDaikin216Layout, fan);
 }
 
 /// Get the current fan speed setting.
 /// @return The current fan speed.
 uint8_t IRDaikin216::getFan(void) {
-  uint8_t fan = GETBITS8(remote_state[kDaikin216ByteFan], kHighNibble,
-                         kDaikinFanSize);
-  if (fan != kDaikinFanQuiet && fan != kDaikinFanAuto) fan -= 2;
-  return fan;
+  return daikin::getFan(remote_state, kDaikin216Layout);
 }
 
 /// Convert a stdAc::fanspeed_t enum into it's native speed.
@@ -1761,16 +1858,16 @@ stdAc::state_t IRDaikin216::toCommon(void) {
 String IRDaikin216::toString(void) {
   String result = "";
   result.reserve(120);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
-                            kDaikinDry, kDaikinFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikinFanMax, kDaikinFanMin,
-                           kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
-  result += addBoolToString(getSwingHorizontal(), kSwingHStr);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
+                  kDaikinDry, kDaikinFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikinFanMax, kDaikinFanMin,
+                 kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
+  addBoolToString(&result, getSwingHorizontal(), kSwingHStr);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
   return result;
 }
 
@@ -1788,37 +1885,18 @@ String IRDaikin216::toString(void) {
 /// @see https://github.com/danny-source/Arduino_DY_IRDaikin
 bool IRrecv::decodeDaikin216(decode_results *results, uint16_t offset,
                              const uint16_t nbits, const bool strict) {
-  if (results->rawlen < 2 * (nbits + kHeader + kFooter) - 1 + offset)
+  if (results->rawlen < 2 * (nbits + kHeader + kFooter) - 1 + offset &&
+      !_sectionsMayFit(results, offset, &kDaikin216Frame))
     return false;
 
   // Compliance
   if (strict && nbits != kDaikin216Bits) return false;
 
-  const uint8_t ksectionSize[kDaikin216Sections] = {kDaikin216Section1Length,
-                                                    kDaikin216Section2Length};
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin216Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin216HdrMark, kDaikin216HdrSpace,
-                        kDaikin216BitMark, kDaikin216OneSpace,
-                        kDaikin216BitMark, kDaikin216ZeroSpace,
-                        kDaikin216BitMark, kDaikin216Gap,
-                        section >= kDaikin216Sections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
-  // Compliance
-  if (strict) {
-    if (pos * 8 != kDaikin216Bits) return false;
-    // Validate the checksum.
-    if (!IRDaikin216::validChecksum(results->state)) return false;
-  }
+  if (!matchSections(results->rawbuf + offset, results->state,
+                     results->rawlen - offset, nbits / 8, &kDaikin216Frame,
+                     strict, kDaikinTolerance, kDaikinMarkExcess))
+    return false;  // N.B. This has checked the checksums if strict.
 
   // Success
   results->decode_type = decode_type_t::DAIKIN216;
@@ -1843,19 +1921,8 @@ void IRsend::sendDaikin160(const unsigned char data[], const uint16_t nbytes,
     return;  // Not enough bytes to send a partial message.
 
   for (uint16_t r = 0; r <= repeat; r++) {
-    // Section #1
-    sendGeneric(kDaikin160HdrMark, kDaikin160HdrSpace, kDaikin160BitMark,
-                kDaikin160OneSpace, kDaikin160BitMark, kDaikin160ZeroSpace,
-                kDaikin160BitMark, kDaikin160Gap, data,
-                kDaikin160Section1Length,
-                kDaikin160Freq, false, 0, kDutyDefault);
-    // Section #2
-    sendGeneric(kDaikin160HdrMark, kDaikin160HdrSpace, kDaikin160BitMark,
-                kDaikin160OneSpace, kDaikin160BitMark, kDaikin160ZeroSpace,
-                kDaikin160BitMark, kDaikin160Gap,
-                data + kDaikin160Section1Length,
-                nbytes - kDaikin160Section1Length,
-                kDaikin160Freq, false, 0, kDutyDefault);
+    // Sections
+    sendSections(&kDaikin160Frame, data, nbytes);
   }
 }
 #endif  // SEND_DAIKIN160
@@ -1876,25 +1943,14 @@ void IRDaikin160::begin(void) { _irsend.begin(); }
 /// @param[in] length The length of the state array.
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRDaikin160::validChecksum(uint8_t state[], const uint16_t length) {
-  // Validate the checksum of section #1.
-  if (length <= kDaikin160Section1Length - 1 ||
-      state[kDaikin160Section1Length - 1] != sumBytes(
-          state, kDaikin160Section1Length - 1))
-    return false;
-  // Validate the checksum of section #2 (a.k.a. the rest)
-  if (length <= kDaikin160Section1Length + 1 ||
-      state[length - 1] != sumBytes(state + kDaikin160Section1Length,
-                                    length - kDaikin160Section1Length - 1))
-    return false;
-  return true;
+  return irutils::validChecksums(kDaikin160Checksums, kDaikin160ChecksumsSize,
+                                 state, length);
 }
 
 /// Calculate and set the checksum values for the internal state.
 void IRDaikin160::checksum(void) {
-  remote_state[kDaikin160Section1Length - 1] = sumBytes(
-      remote_state, kDaikin160Section1Length - 1);
-  remote_state[kDaikin160StateLength - 1] = sumBytes(
-      remote_state + kDaikin160Section1Length, kDaikin160Section2Length - 1);
+  irutils::setChecksums(kDaikin160Checksums, kDaikin160ChecksumsSize,
+                        remote_state, kDaikin160StateLength);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -1948,35 +2004,25 @@ void IRDaikin160::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikin160::setPower(const bool on) {
-  setBit(&remote_state[kDaikin160BytePower], kDaikinBitPowerOffset, on);
+  daikin::setPower(remote_state, kDaikin160Layout, on);
 }
 
 /// Get the value of the current power setting.
 /// @return true, the setting is on. false, the setting is off.
 bool IRDaikin160::getPower(void) {
-  return GETBIT8(remote_state[kDaikin160BytePower], kDaikinBitPowerOffset);
+  return daikin::getPower(remote_state, kDaikin160Layout);
 }
 
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRDaikin160::getMode(void) {
-  return GETBITS8(remote_state[kDaikin160ByteMode], kHighNibble, kModeBitsSize);
+  return daikin::getMode(remote_state, kDaikin160Layout);
 }
 
 /// Set the operating mode of the A/C.
 /// @param[in] mode The desired operating mode.
 void IRDaikin160::setMode(const uint8_t mode) {
-  switch (mode) {
-    case kDaikinAuto:
-    case kDaikinCool:
-    case kDaikinHeat:
-    case kDaikinFan:
-    case kDaikinDry:
-      setBits(&remote_state[kDaikin160ByteMode], kHighNibble, kModeBitsSize,
-              mode);
-      break;
-    default: this->setMode(kDaikinAuto);
-  }
+  daikin::setMode(remote_state, kDaikin160Layout, mode);
 }
 
 /// Convert a stdAc::opmode_t enum into its native mode.
@@ -1990,40 +2036,27 @@ uint8_t IRDaikin160::convertMode(const stdAc::opmode_t mode) {
 /// @param[in] temp The temperature in degrees celsius.
 void IRDaikin160::setTemp(const uint8_t temp) {
   uint8_t degrees = std::max(temp, kDaikinMinTemp);
-  degrees = std::min(degrees, kDaikinMaxTemp) - 10;
-  setBits(&remote_state[kDaikin160ByteTemp], kDaikin160TempOffset,
-          kDaikin160TempSize, degrees);
+  degrees = std::min(degrees, kDaikinMaxTemp);
+  daikin::setTemp(remote_state, kDaikin160Layout, degrees);
 }
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
 uint8_t IRDaikin160::getTemp(void) {
-  return GETBITS8(remote_state[kDaikin160ByteTemp], kDaikin160TempOffset,
-                  kDaikin160TempSize) + 10;
+  return daikin::getTemp(remote_state, kDaikin160Layout);
 }
 
 /// Set the speed of the fan.
 /// @param[in] fan The desired setting.
 /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
 void IRDaikin160::setFan(const uint8_t fan) {
-  uint8_t fanset;
-  if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
-    fanset = fan;
-  else if (fan < kDaikinFanMin || fan > kDaikinFanMax)
-    fanset = kDaikinFanAuto;
-  else
-    fanset = 2 + fan;
-  // Set the fan speed bits, leave *upper* 4 bits alone
-  setBits(&remote_state[kDaikin160ByteFan], kLowNibble, kDaikinFanSize, fanset);
+  daikin::setFan(remote_state, kDaikin160Layout, fan);
 }
 
 /// Get the current fan speed setting.
 /// @return The current fan speed.
 uint8_t IRDaikin160::getFan(void) {
-  uint8_t fan = GETBITS8(remote_state[kDaikin160ByteFan], kLowNibble,
-                         kDaikinFanSize);
-  if (fan != kDaikinFanQuiet && fan != kDaikinFanAuto) fan -= 2;
-  return fan;
+  return daikin::getFan(remote_state, kDaikin160Layout);
 }
 
 /// Convert a stdAc::fanspeed_t enum into it's native speed.
@@ -2127,13 +2160,13 @@ stdAc::state_t IRDaikin160::toCommon(void) {
 String IRDaikin160::toString(void) {
   String result = "";
   result.reserve(150);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
-                            kDaikinDry, kDaikinFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikinFanMax, kDaikinFanMin,
-                           kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
-  result += addIntToString(getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
+                  kDaikinDry, kDaikinFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikinFanMax, kDaikinFanMin,
+                 kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
+  addIntToString(&result, getSwingVertical(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (getSwingVertical()) {
     case kDaikin160SwingVHighest: result += kHighestStr; break;
@@ -2161,37 +2194,18 @@ String IRDaikin160::toString(void) {
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/731
 bool IRrecv::decodeDaikin160(decode_results *results, uint16_t offset,
                              const uint16_t nbits, const bool strict) {
-  if (results->rawlen < 2 * (nbits + kHeader + kFooter) - 1 + offset)
+  if (results->rawlen < 2 * (nbits + kHeader + kFooter) - 1 + offset &&
+      !_sectionsMayFit(results, offset, &kDaikin160Frame))
     return false;
 
   // Compliance
   if (strict && nbits != kDaikin160Bits) return false;
 
-  const uint8_t ksectionSize[kDaikin160Sections] = {kDaikin160Section1Length,
-                                                    kDaikin160Section2Length};
-
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin160Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin160HdrMark, kDaikin160HdrSpace,
-                        kDaikin160BitMark, kDaikin160OneSpace,
-                        kDaikin160BitMark, kDaikin160ZeroSpace,
-                        kDaikin160BitMark, kDaikin160Gap,
-                        section >= kDaikin160Sections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
-  // Compliance
-  if (strict) {
-    // Validate the checksum.
-    if (!IRDaikin160::validChecksum(results->state)) return false;
-  }
+  if (!matchSections(results->rawbuf + offset, results->state,
+                     results->rawlen - offset, nbits / 8, &kDaikin160Frame,
+                     strict, kDaikinTolerance, kDaikinMarkExcess))
+    return false;  // N.B. This has checked the checksums if strict.
 
   // Success
   results->decode_type = decode_type_t::DAIKIN160;
@@ -2215,19 +2229,8 @@ void IRsend::sendDaikin176(const unsigned char data[], const uint16_t nbytes,
     return;  // Not enough bytes to send a partial message.
 
   for (uint16_t r = 0; r <= repeat; r++) {
-    // Section #1
-    sendGeneric(kDaikin176HdrMark, kDaikin176HdrSpace, kDaikin176BitMark,
-                kDaikin176OneSpace, kDaikin176BitMark, kDaikin176ZeroSpace,
-                kDaikin176BitMark, kDaikin176Gap, data,
-                kDaikin176Section1Length,
-                kDaikin176Freq, false, 0, kDutyDefault);
-    // Section #2
-    sendGeneric(kDaikin176HdrMark, kDaikin176HdrSpace, kDaikin176BitMark,
-                kDaikin176OneSpace, kDaikin176BitMark, kDaikin176ZeroSpace,
-                kDaikin176BitMark, kDaikin176Gap,
-                data + kDaikin176Section1Length,
-                nbytes - kDaikin176Section1Length,
-                kDaikin176Freq, false, 0, kDutyDefault);
+    // Sections
+    sendSections(&kDaikin176Frame, data, nbytes);
   }
 }
 #endif  // SEND_DAIKIN176
@@ -2248,25 +2251,14 @@ void IRDaikin176::begin(void) { _irsend.begin(); }
 /// @param[in] length The length of the state array.
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRDaikin176::validChecksum(uint8_t state[], const uint16_t length) {
-  // Validate the checksum of section #1.
-  if (length <= kDaikin176Section1Length - 1 ||
-      state[kDaikin176Section1Length - 1] != sumBytes(
-          state, kDaikin176Section1Length - 1))
-    return false;
-  // Validate the checksum of section #2 (a.k.a. the rest)
-  if (length <= kDaikin176Section1Length + 1 ||
-      state[length - 1] != sumBytes(state + kDaikin176Section1Length,
-                                    length - kDaikin176Section1Length - 1))
-    return false;
-  return true;
+  return irutils::validChecksums(kDaikin176Checksums, kDaikin176ChecksumsSize,
+                                 state, length);
 }
 
 /// Calculate and set the checksum values for the internal state.
 void IRDaikin176::checksum(void) {
-  remote_state[kDaikin176Section1Length - 1] = sumBytes(
-      remote_state, kDaikin176Section1Length - 1);
-  remote_state[kDaikin176StateLength - 1] = sumBytes(
-      remote_state + kDaikin176Section1Length, kDaikin176Section2Length - 1);
+  irutils::setChecksums(kDaikin176Checksums, kDaikin176ChecksumsSize,
+                        remote_state, kDaikin176StateLength);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -2322,20 +2314,19 @@ void IRDaikin176::off(void) { setPower(false); }
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikin176::setPower(const bool on) {
   remote_state[kDaikin176ByteModeButton] = 0;
-  setBit(&remote_state[kDaikin176ByteModePower], kDaikinBitPowerOffset, on);
+  daikin::setPower(remote_state, kDaikin176Layout, on);
 }
 
 /// Get the value of the current power setting.
 /// @return true, the setting is on. false, the setting is off.
 bool IRDaikin176::getPower(void) {
-  return GETBIT8(remote_state[kDaikin176ByteModePower], kDaikinBitPowerOffset);
+  return daikin::getPower(remote_state, kDaikin176Layout);
 }
 
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRDaikin176::getMode(void) {
-  return GETBITS8(remote_state[kDaikin176ByteModePower], kHighNibble,
-                  kModeBitsSize);
+  return daikin::getMode(remote_state, kDaikin176Layout);
 }
 
 /// Set the operating mode of the A/C.
@@ -2400,16 +2391,14 @@ void IRDaikin176::setTemp(const uint8_t temp) {
     case kDaikin176Fan:
       degrees = kDaikin176DryFanTemp;
   }
-  setBits(&remote_state[kDaikin176ByteTemp], kDaikin176TempOffset,
-          kDaikin176TempSize, degrees - 9);
+  daikin::setTemp(remote_state, kDaikin176Layout, degrees);
   remote_state[kDaikin176ByteModeButton] = 0;
 }
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
 uint8_t IRDaikin176::getTemp(void) {
-  return GETBITS8(remote_state[kDaikin176ByteTemp], kDaikin176TempOffset,
-                  kDaikin176TempSize) + 9;
+  return daikin::getTemp(remote_state, kDaikin176Layout);
 }
 
 /// Set the speed of the fan.
@@ -2528,13 +2517,13 @@ stdAc::state_t IRDaikin176::toCommon(void) {
 String IRDaikin176::toString(void) {
   String result = "";
   result.reserve(80);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDaikin176Auto, kDaikin176Cool,
-                            kDaikin176Heat, kDaikin176Dry, kDaikin176Fan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikin176FanMax, kDaikinFanMin,
-                           kDaikinFanMin, kDaikinFanMin, kDaikinFanMin);
-  result += addIntToString(getSwingHorizontal(), kSwingHStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDaikin176Auto, kDaikin176Cool,
+                  kDaikin176Heat, kDaikin176Dry, kDaikin176Fan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikin176FanMax, kDaikinFanMin,
+                 kDaikinFanMin, kDaikinFanMin, kDaikinFanMin);
+  addIntToString(&result, getSwingHorizontal(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (getSwingHorizontal()) {
     case kDaikin176SwingHAuto:
@@ -2563,37 +2552,18 @@ String IRDaikin176::toString(void) {
 bool IRrecv::decodeDaikin176(decode_results *results, uint16_t offset,
                              const uint16_t nbits,
                              const bool strict) {
-  if (results->rawlen < 2 * (nbits + kHeader + kFooter) - 1 + offset)
+  if (results->rawlen < 2 * (nbits + kHeader + kFooter) - 1 + offset &&
+      !_sectionsMayFit(results, offset, &kDaikin176Frame))
     return false;
 
   // Compliance
   if (strict && nbits != kDaikin176Bits) return false;
 
-  const uint8_t ksectionSize[kDaikin176Sections] = {kDaikin176Section1Length,
-                                                    kDaikin176Section2Length};
-
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin176Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin176HdrMark, kDaikin176HdrSpace,
-                        kDaikin176BitMark, kDaikin176OneSpace,
-                        kDaikin176BitMark, kDaikin176ZeroSpace,
-                        kDaikin176BitMark, kDaikin176Gap,
-                        section >= kDaikin176Sections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
-  // Compliance
-  if (strict) {
-    // Validate the checksum.
-    if (!IRDaikin176::validChecksum(results->state)) return false;
-  }
+  if (!matchSections(results->rawbuf + offset, results->state,
+                     results->rawlen - offset, nbits / 8, &kDaikin176Frame,
+                     strict, kDaikinTolerance, kDaikinMarkExcess))
+    return false;  // N.B. This has checked the checksums if strict.
 
   // Success
   results->decode_type = decode_type_t::DAIKIN176;
@@ -3047,24 +3017,24 @@ uint8_t IRDaikin128::getLightToggle(void) {
 String IRDaikin128::toString(void) {
   String result = "";
   result.reserve(240);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPowerToggle(), kPowerToggleStr, false);
-  result += addModeToString(getMode(), kDaikin128Auto, kDaikin128Cool,
-                            kDaikin128Heat, kDaikin128Dry, kDaikin128Fan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikin128FanHigh, kDaikin128FanLow,
-                           kDaikin128FanAuto, kDaikin128FanQuiet,
-                           kDaikin128FanMed);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getEcono(), kEconoStr);
-  result += addLabeledString(minsToString(getClock()), kClockStr);
-  result += addBoolToString(getOnTimerEnabled(), kOnTimerStr);
-  result += addLabeledString(minsToString(getOnTimer()), kOnTimerStr);
-  result += addBoolToString(getOffTimerEnabled(), kOffTimerStr);
-  result += addLabeledString(minsToString(getOffTimer()), kOffTimerStr);
-  result += addIntToString(getLightToggle(), kLightToggleStr);
+  addBoolToString(&result, getPowerToggle(), kPowerToggleStr, false);
+  addModeToString(&result, getMode(), kDaikin128Auto, kDaikin128Cool,
+                  kDaikin128Heat, kDaikin128Dry, kDaikin128Fan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikin128FanHigh, kDaikin128FanLow,
+                 kDaikin128FanAuto, kDaikin128FanQuiet,
+                 kDaikin128FanMed);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getEcono(), kEconoStr);
+  addLabeledString(&result, minsToString(getClock()), kClockStr);
+  addBoolToString(&result, getOnTimerEnabled(), kOnTimerStr);
+  addLabeledString(&result, minsToString(getOnTimer()), kOnTimerStr);
+  addBoolToString(&result, getOffTimerEnabled(), kOffTimerStr);
+  addLabeledString(&result, minsToString(getOffTimer()), kOffTimerStr);
+  addIntToString(&result, getLightToggle(), kLightToggleStr);
   result += kSpaceLBraceStr;
   switch (getLightToggle()) {
     case kDaikin128BitCeiling: result += kCeilingStr; break;
@@ -3277,17 +3247,14 @@ void IRDaikin152::send(const uint16_t repeat) {
 /// @param[in] length The length of the state array.
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRDaikin152::validChecksum(uint8_t state[], const uint16_t length) {
-  // Validate the checksum of the given state.
-  if (length <= 1 || state[length - 1] != sumBytes(state, length - 1))
-    return false;
-  else
-    return true;
+  return irutils::validChecksums(kDaikin152Checksums, kDaikin152ChecksumsSize,
+                                 state, length);
 }
 
 /// Calculate and set the checksum values for the internal state.
 void IRDaikin152::checksum(void) {
-  remote_state[kDaikin152StateLength - 1] = sumBytes(
-      remote_state, kDaikin152StateLength - 1);
+  irutils::setChecksums(kDaikin152Checksums, kDaikin152ChecksumsSize,
+                        remote_state, kDaikin152StateLength);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -3322,20 +3289,19 @@ void IRDaikin152::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikin152::setPower(const bool on) {
-  setBit(&remote_state[kDaikin152PowerByte], kDaikinBitPowerOffset, on);
+  daikin::setPower(remote_state, kDaikin152Layout, on);
 }
 
 /// Get the value of the current power setting.
 /// @return true, the setting is on. false, the setting is off.
 bool IRDaikin152::getPower(void) {
-  return GETBIT8(remote_state[kDaikin152PowerByte], kDaikinBitPowerOffset);
+  return daikin::getPower(remote_state, kDaikin152Layout);
 }
 
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRDaikin152::getMode(void) {
-  return GETBITS8(remote_state[kDaikin152ModeByte], kDaikinModeOffset,
-                  kDaikinModeSize);
+  return daikin::getMode(remote_state, kDaikin152Layout);
 }
 
 /// Set the operating mode of the A/C.
@@ -3348,16 +3314,8 @@ void IRDaikin152::setMode(const uint8_t mode) {
     case kDaikinDry:
       setTemp(kDaikin152DryTemp);  // Handle special temp for dry mode.
       break;
-    case kDaikinAuto:
-    case kDaikinCool:
-    case kDaikinHeat:
-      break;
-    default:
-      this->setMode(kDaikinAuto);
-      return;
   }
-  setBits(&remote_state[kDaikin152ModeByte], kDaikinModeOffset,
-          kDaikinModeSize, mode);
+  daikin::setMode(remote_state, kDaikin152Layout, mode);
 }
 
 /// Convert a stdAc::opmode_t enum into its native mode.
@@ -3374,42 +3332,26 @@ void IRDaikin152::setTemp(const uint8_t temp) {
       temp, (getMode() == kDaikinHeat) ? kDaikinMinTemp : kDaikin2MinCoolTemp);
   degrees = std::min(degrees, kDaikinMaxTemp);
   if (temp == kDaikin152FanTemp) degrees = temp;  // Handle fan only temp.
-  setBits(&remote_state[kDaikin152TempByte], kDaikinTempOffset,
-          kDaikin152TempSize, degrees);
+  daikin::setTemp(remote_state, kDaikin152Layout, degrees);
 }
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
 uint8_t IRDaikin152::getTemp(void) {
-  return GETBITS8(remote_state[kDaikin152TempByte], kDaikinTempOffset,
-                  kDaikin152TempSize);
+  return daikin::getTemp(remote_state, kDaikin152Layout);
 }
 
 /// Set the speed of the fan.
 /// @param[in] fan The desired setting.
 /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
 void IRDaikin152::setFan(const uint8_t fan) {
-  // Set the fan speed bits, leave low 4 bits alone
-  uint8_t fanset;
-  if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
-    fanset = fan;
-  else if (fan < kDaikinFanMin || fan > kDaikinFanMax)
-    fanset = kDaikinFanAuto;
-  else
-    fanset = 2 + fan;
-  setBits(&remote_state[kDaikin152FanByte], kHighNibble, kNibbleSize, fanset);
+  daikin::setFan(remote_state, kDaikin152Layout, fan);
 }
 
 /// Get the current fan speed setting.
 /// @return The current fan speed.
 uint8_t IRDaikin152::getFan(void) {
-  const uint8_t fan = GETBITS8(remote_state[kDaikin152FanByte], kHighNibble,
-                               kNibbleSize);
-  switch (fan) {
-    case kDaikinFanAuto:
-    case kDaikinFanQuiet: return fan;
-    default: return fan - 2;
-  }
+  return daikin::getFan(remote_state, kDaikin152Layout);
 }
 
 /// Convert a stdAc::fanspeed_t enum into it's native speed.
@@ -3543,18 +3485,18 @@ stdAc::state_t IRDaikin152::toCommon(void) {
 String IRDaikin152::toString(void) {
   String result = "";
   result.reserve(180);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
-                            kDaikinDry, kDaikinFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kDaikinFanMax, kDaikinFanMin,
-                           kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
-  result += addBoolToString(getSwingV(), kSwingVStr);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getEcono(), kEconoStr);
-  result += addBoolToString(getSensor(), kSensorStr);
-  result += addBoolToString(getComfort(), kComfortStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDaikinAuto, kDaikinCool, kDaikinHeat,
+                  kDaikinDry, kDaikinFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kDaikinFanMax, kDaikinFanMin,
+                 kDaikinFanAuto, kDaikinFanQuiet, kDaikinFanMed);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getEcono(), kEconoStr);
+  addBoolToString(&result, getSensor(), kSensorStr);
+  addBoolToString(&result, getComfort(), kComfortStr);
   return result;
 }
 
@@ -3967,31 +3909,31 @@ void IRDaikin64::setOffTime(const uint16_t mins_since_midnight) {
 String IRDaikin64::toString(void) {
   String result = "";
   result.reserve(120);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPowerToggle(), kPowerToggleStr, false);
-  result += addModeToString(getMode(), 0xFF, kDaikin64Cool,
-                            0xFF, kDaikin64Dry, kDaikin64Fan);
-  result += addTempToString(getTemp());
+  addBoolToString(&result, getPowerToggle(), kPowerToggleStr, false);
+  addModeToString(&result, getMode(), 0xFF, kDaikin64Cool,
+                  0xFF, kDaikin64Dry, kDaikin64Fan);
+  addTempToString(&result, getTemp());
   if (!getTurbo()) {
-    result += addFanToString(getFan(), kDaikin64FanHigh, kDaikin64FanLow,
-                             kDaikin64FanAuto, kDaikin64FanQuiet,
-                             kDaikin64FanMed);
+    addFanToString(&result, getFan(), kDaikin64FanHigh, kDaikin64FanLow,
+                   kDaikin64FanAuto, kDaikin64FanQuiet,
+                   kDaikin64FanMed);
   } else {
-    result += addIntToString(getFan(), kFanStr);
+    addIntToString(&result, getFan(), kFanStr);
     result += kSpaceLBraceStr;
     result += kTurboStr;
     result += ')';
   }
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addLabeledString(minsToString(getClock()), kClockStr);
-  result += addLabeledString(getOnTimeEnabled()
-                             ? minsToString(getOnTime()) : kOffStr,
-                             kOnTimerStr);
-  result += addLabeledString(getOffTimeEnabled()
-                             ? minsToString(getOffTime()) : kOffStr,
-                             kOffTimerStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addLabeledString(&result, minsToString(getClock()), kClockStr);
+  addLabeledString(&result, getOnTimeEnabled()
+                   ? minsToString(getOnTime()) : kOffStr,
+                   kOnTimerStr);
+  addLabeledString(&result, getOffTimeEnabled()
+                   ? minsToString(getOffTime()) : kOffStr,
+                   kOffTimerStr);
   return result;
 }
 
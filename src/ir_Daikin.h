@@ -509,6 +509,39 @@ const uint8_t kDaikin64PowerToggleBit = 59;
 const uint8_t kDaikin64ChecksumOffset = 60;
 const uint8_t kDaikin64ChecksumSize = 4;  // Mask 0b1111 << 59
 
+/// Where a Daikin protocol keeps the settings most of the Daikin protocols
+/// share, & encode the same way. i.e. The power bit, the (3 bit) mode, the
+/// (4 bit) fan speed, & the temperature.
+/// Each protocol has one of these, & the `daikin::` functions do the work,
+/// so there is only one copy of the code for all of them.
+typedef struct {
+  uint8_t powerByte;   ///< Index of the byte with the power bit.
+  uint8_t modeByte;    ///< Index of the byte with the operating mode.
+  uint8_t modeOffset;  ///< Offset of the operating mode in its byte.
+  uint8_t fanByte;     ///< Index of the byte with the fan speed.
+  uint8_t fanOffset;   ///< Offset of the fan speed in its byte.
+  uint8_t tempByte;    ///< Index of the byte with the temperature.
+  uint8_t tempOffset;  ///< Offset of the temperature in its byte.
+  uint8_t tempSize;    ///< Nr. of bits of the temperature.
+  uint8_t tempBase;    ///< What a native temperature of 0 is in Celsius.
+} daikin_layout_t;
+
+/// The code shared by the Daikin A/C classes. See `daikin_layout_t`.
+namespace daikin {
+  void setPower(uint8_t * const state, const daikin_layout_t &layout,
+                const bool on);
+  bool getPower(const uint8_t * const state, const daikin_layout_t &layout);
+  uint8_t setMode(uint8_t * const state, const daikin_layout_t &layout,
+                  const uint8_t mode);
+  uint8_t getMode(const uint8_t * const state, const daikin_layout_t &layout);
+  void setFan(uint8_t * const state, const daikin_layout_t &layout,
+              const uint8_t fan);
+  uint8_t getFan(const uint8_t * const state, const daikin_layout_t &layout);
+  void setTemp(uint8_t * const state, const daikin_layout_t &layout,
+               const uint8_t degrees);
+  uint8_t getTemp(const uint8_t * const state, const daikin_layout_t &layout);
+}  // namespace daikin
+
 // Legacy defines.
 #define DAIKIN_COOL kDaikinCool
 #define DAIKIN_HEAT kDaikinHeat
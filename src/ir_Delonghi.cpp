@@ -4,6 +4,7 @@
 
 #include "ir_Delonghi.h"
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -27,6 +28,10 @@ const uint32_t kDelonghiAcGap = kDefaultMessageGap;  // A totally made-up guess.
 const uint16_t kDelonghiAcFreq = 38000;  // Hz. (Guess: most common frequency.)
 const uint16_t kDelonghiAcOverhead = 3;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchDelonghiAcHdrMark == kDelonghiAcHdrMark,
+              "See IRrecvTimings.h");
+
 
 #if SEND_DELONGHI_AC
 /// Send a Delonghi A/C formatted message.
@@ -462,22 +467,22 @@ stdAc::state_t IRDelonghiAc::toCommon(void) {
 String IRDelonghiAc::toString(void) {
   String result = "";
   result.reserve(80);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kDelonghiAcAuto, kDelonghiAcCool,
-                            kDelonghiAcAuto, kDelonghiAcDry, kDelonghiAcFan);
-  result += addFanToString(getFan(), kDelonghiAcFanHigh, kDelonghiAcFanLow,
-                           kDelonghiAcFanAuto, kDelonghiAcFanAuto,
-                           kDelonghiAcFanMedium);
-  result += addTempToString(getTemp(), !getTempUnit());
-  result += addBoolToString(getBoost(), kTurboStr);
-  result += addBoolToString(getSleep(), kSleepStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kDelonghiAcAuto, kDelonghiAcCool,
+                  kDelonghiAcAuto, kDelonghiAcDry, kDelonghiAcFan);
+  addFanToString(&result, getFan(), kDelonghiAcFanHigh, kDelonghiAcFanLow,
+                 kDelonghiAcFanAuto, kDelonghiAcFanAuto,
+                 kDelonghiAcFanMedium);
+  addTempToString(&result, getTemp(), !getTempUnit());
+  addBoolToString(&result, getBoost(), kTurboStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
   uint16_t mins = getOnTimer();
-  result += addLabeledString((mins && getOnTimerEnabled()) ? minsToString(mins)
+  addLabeledString(&result, (mins && getOnTimerEnabled()) ? minsToString(mins)
                                                            : kOffStr,
-                             kOnTimerStr);
+                   kOnTimerStr);
   mins = getOffTimer();
-  result += addLabeledString((mins && getOffTimerEnabled()) ? minsToString(mins)
+  addLabeledString(&result, (mins && getOffTimerEnabled()) ? minsToString(mins)
                                                             : kOffStr,
-                             kOffTimerStr);
+                   kOffTimerStr);
   return result;
 }
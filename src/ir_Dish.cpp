@@ -11,6 +11,7 @@
 //   Brand: DISH NETWORK,  Model: echostar 301
 
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -30,6 +31,9 @@ const uint16_t kDishZeroSpace = kDishZeroSpaceTicks * kDishTick;
 const uint16_t kDishRptSpaceTicks = kDishHdrSpaceTicks;
 const uint16_t kDishRptSpace = kDishRptSpaceTicks * kDishTick;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchDishHdrMark == kDishHdrMark, "See IRrecvTimings.h");
+
 #if SEND_DISH
 /// Send a DISH NETWORK formatted message.
 /// Status: STABLE / Working.
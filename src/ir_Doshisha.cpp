@@ -10,6 +10,7 @@
 //   Brand: Doshisha,  Model: RCZ01 remote
 
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -20,6 +21,10 @@ const uint16_t kDoshishaBitMark = 420;
 const uint16_t kDoshishaOneSpace = 1310;
 const uint16_t kDoshishaZeroSpace = 452;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchDoshishaHdrMark == kDoshishaHdrMark,
+              "See IRrecvTimings.h");
+
 // basic structure of bits, and mask
 const uint64_t kRcz01SignatureMask = 0xffffffff00;
 const uint64_t kRcz01Signature =     0x800B304800;
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cstring>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -22,6 +23,10 @@ const uint16_t kElectraAcOneSpace = 1647;
 const uint16_t kElectraAcZeroSpace = 547;
 const uint32_t kElectraAcMessageGap = kDefaultMessageGap;  // Just a guess.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchElectraAcHdrMark == kElectraAcHdrMark,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
@@ -349,18 +354,18 @@ stdAc::state_t IRElectraAc::toCommon(void) {
 String IRElectraAc::toString(void) {
   String result = "";
   result.reserve(130);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kElectraAcAuto, kElectraAcCool,
-                            kElectraAcHeat, kElectraAcDry, kElectraAcFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kElectraAcFanHigh, kElectraAcFanLow,
-                           kElectraAcFanAuto, kElectraAcFanAuto,
-                           kElectraAcFanMed);
-  result += addBoolToString(getSwingV(), kSwingVStr);
-  result += addBoolToString(getSwingH(), kSwingHStr);
-  result += addLabeledString(getLightToggle() ? kToggleStr : "-", kLightStr);
-  result += addBoolToString(getClean(), kCleanStr);
-  result += addBoolToString(getTurbo(), kTurboStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kElectraAcAuto, kElectraAcCool,
+                  kElectraAcHeat, kElectraAcDry, kElectraAcFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kElectraAcFanHigh, kElectraAcFanLow,
+                 kElectraAcFanAuto, kElectraAcFanAuto,
+                 kElectraAcFanMed);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
+  addBoolToString(&result, getSwingH(), kSwingHStr);
+  addLabeledString(&result, getLightToggle() ? kToggleStr : "-", kLightStr);
+  addBoolToString(&result, getClean(), kCleanStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
   return result;
 }
 
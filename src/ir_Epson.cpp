@@ -53,23 +53,26 @@ bool IRrecv::decodeEpson(decode_results *results, uint16_t offset,
     return false;  // Not strictly an Epson message.
 
   uint64_t data = 0;
-  uint64_t first_data = 0;
-  bool first = true;
 
-  for (uint8_t i = 0; i < kEpsonMinMesgsForDecode; i++) {
-    // Match Header + Data + Footer
-    uint16_t delta = matchGeneric(results->rawbuf + offset, &data,
-                                  results->rawlen - offset, nbits,
-                                  kNecHdrMark, kNecHdrSpace,
-                                  kNecBitMark, kNecOneSpace,
-                                  kNecBitMark, kNecZeroSpace,
-                                  kNecBitMark, kNecMinGap, true);
-    if (!delta) return false;
-    offset += delta;
-    if (first)
-      first_data = data;
-    else if (data != first_data) return false;
-    first = false;  // No longer the first message.
+  // Match Header + Data + Footer
+  uint16_t used = matchGeneric(results->rawbuf + offset, &data,
+                               results->rawlen - offset, nbits,
+                               kNecHdrMark, kNecHdrSpace,
+                               kNecBitMark, kNecOneSpace,
+                               kNecBitMark, kNecZeroSpace,
+                               kNecBitMark, kNecMinGap, true);
+  if (!used) return false;
+  offset += used;
+  // The other copies must be exactly the same as the first.
+  for (uint8_t i = 1; i < kEpsonMinMesgsForDecode; i++) {
+    used = matchRepeat(results->rawbuf + offset, data,
+                       results->rawlen - offset, nbits,
+                       kNecHdrMark, kNecHdrSpace,
+                       kNecBitMark, kNecOneSpace,
+                       kNecBitMark, kNecZeroSpace,
+                       kNecBitMark, kNecMinGap, true);
+    if (!used) return false;
+    offset += used;
   }
   // Compliance
   // Calculate command and optionally enforce integrity checking.
@@ -98,7 +101,7 @@ bool IRrecv::decodeEpson(decode_results *results, uint16_t offset,
     // Not inverted, so must be Extended Epson (NEC) protocol,
     // thus 16 bit address.
     results->address = reverseBits((data >> 16) & UINT16_MAX, 16);
-  results->repeat = !first;
+  results->repeat = true;  // We always match at least one repeat.
   return true;
 }
 #endif  // DECODE_EPSON
@@ -10,6 +10,7 @@
 #ifndef ARDUINO
 #include <string>
 #endif
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -23,6 +24,10 @@ const uint16_t kFujitsuAcOneSpace = 1182;
 const uint16_t kFujitsuAcZeroSpace = 390;
 const uint16_t kFujitsuAcMinGap = 8100;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchFujitsuAcHdrMark == kFujitsuAcHdrMark,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
@@ -655,24 +660,24 @@ String IRFujitsuAC::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
   fujitsu_ac_remote_model_t model = this->getModel();
-  result += addModelToString(decode_type_t::FUJITSU_AC, model, false);
-  result += addBoolToString(getPower(), kPowerStr);
-  result += addModeToString(getMode(), kFujitsuAcModeAuto, kFujitsuAcModeCool,
-                            kFujitsuAcModeHeat, kFujitsuAcModeDry,
-                            kFujitsuAcModeFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFanSpeed(), kFujitsuAcFanHigh, kFujitsuAcFanLow,
-                           kFujitsuAcFanAuto, kFujitsuAcFanQuiet,
-                           kFujitsuAcFanMed);
+  addModelToString(&result, decode_type_t::FUJITSU_AC, model, false);
+  addBoolToString(&result, getPower(), kPowerStr);
+  addModeToString(&result, getMode(), kFujitsuAcModeAuto, kFujitsuAcModeCool,
+                  kFujitsuAcModeHeat, kFujitsuAcModeDry,
+                  kFujitsuAcModeFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFanSpeed(), kFujitsuAcFanHigh, kFujitsuAcFanLow,
+                 kFujitsuAcFanAuto, kFujitsuAcFanQuiet,
+                 kFujitsuAcFanMed);
   switch (model) {
     // These models have no internal swing, clean. or filter state.
     case fujitsu_ac_remote_model_t::ARDB1:
     case fujitsu_ac_remote_model_t::ARJW2:
       break;
     default:  // Assume everything else does.
-      result += addBoolToString(getClean(), kCleanStr);
-      result += addBoolToString(getFilter(), kFilterStr);
-      result += addIntToString(this->getSwing(), kSwingStr);
+      addBoolToString(&result, getClean(), kCleanStr);
+      addBoolToString(&result, getFilter(), kFilterStr);
+      addIntToString(&result, this->getSwing(), kSwingStr);
       result += kSpaceLBraceStr;
       switch (this->getSwing()) {
         case kFujitsuAcSwingOff:
@@ -728,7 +733,7 @@ String IRFujitsuAC::toString(void) {
       result += kNAStr;
   }
   if (this->getModel() == fujitsu_ac_remote_model_t::ARREB1E)
-    result += addBoolToString(getOutsideQuiet(), kOutsideQuietStr);
+    addBoolToString(&result, getOutsideQuiet(), kOutsideQuietStr);
   return result;
 }
 
@@ -742,6 +747,8 @@ String IRFujitsuAC::toString(void) {
 /// @param[in] nbits The number of data bits to expect.
 /// @param[in] strict Flag indicating if we should perform strict matching.
 /// @return A boolean. True if it can decode it, false if it can't.
+/// @note The message length is known once the type/length bytes are read, so
+///   the rest of it is decoded in a single pass.
 bool IRrecv::decodeFujitsuAC(decode_results* results, uint16_t offset,
                              const uint16_t nbits,
                              const bool strict) {
@@ -782,15 +789,50 @@ bool IRrecv::decodeFujitsuAC(decode_results* results, uint16_t offset,
   results->state[3] = 0x10;
   results->state[4] = 0x10;
 
-  // Keep reading bytes until we either run out of message or state to fill.
-  for (uint16_t i = 5;
-       offset <= results->rawlen - 16 && i < kFujitsuAcStateLength;
-       i++, dataBitsSoFar += 8, offset += data_result.used) {
-    data_result = matchData(
-        &(results->rawbuf[offset]), 8, kFujitsuAcBitMark, kFujitsuAcOneSpace,
-        kFujitsuAcBitMark, kFujitsuAcZeroSpace, _tolerance, kMarkExcess, false);
-    if (data_result.success == false) break;  // Fail
-    results->state[i] = data_result.data;
+  // The next byte tells us if it is a long or a short message.
+  data_result = matchData(
+      &(results->rawbuf[offset]), 8, kFujitsuAcBitMark, kFujitsuAcOneSpace,
+      kFujitsuAcBitMark, kFujitsuAcZeroSpace, _tolerance, kMarkExcess, false);
+  if (data_result.success == false) return false;  // Fail
+  results->state[5] = data_result.data;
+  dataBitsSoFar += 8;
+  offset += data_result.used;
+  uint16_t length;  // How many bytes the message should have in total.
+  switch (results->state[5]) {
+    case 0xFC:
+    case 0xFE:
+      // Long messages have a length byte, so read it & we know the rest.
+      data_result = matchData(
+          &(results->rawbuf[offset]), 8, kFujitsuAcBitMark, kFujitsuAcOneSpace,
+          kFujitsuAcBitMark, kFujitsuAcZeroSpace, _tolerance, kMarkExcess,
+          false);
+      if (data_result.success == false) return false;  // Fail
+      results->state[6] = data_result.data;
+      dataBitsSoFar += 8;
+      offset += data_result.used;
+      length = results->state[6] + 7;
+      if (length > kFujitsuAcStateLength) return false;  // Too long.
+      break;
+    default:
+      // Short messages may have one more (inverted) byte. If the space after
+      // the next mark is a gap, then they don't.
+      length = kFujitsuAcStateLengthShort;
+      if (offset + 1 >= results->rawlen ||
+          matchAtLeast(results->rawbuf[offset + 1], kFujitsuAcMinGap))
+        length--;
+  }
+  // Rest of the data.
+  const uint16_t nbytes = length - dataBitsSoFar / 8;
+  if (nbytes) {
+    const uint16_t used = matchGeneric(
+        results->rawbuf + offset, results->state + dataBitsSoFar / 8,
+        results->rawlen - offset, nbytes * 8, 0, 0,
+        kFujitsuAcBitMark, kFujitsuAcOneSpace,
+        kFujitsuAcBitMark, kFujitsuAcZeroSpace,
+        0, 0, false, _tolerance, kMarkExcess, false);
+    if (!used) return false;
+    dataBitsSoFar += nbytes * 8;
+    offset += used;
   }
 
   // Footer
@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -28,6 +29,10 @@ const uint32_t kGicableMinGap =
     (kGicableHdrMark + kGicableHdrSpace +
      kGicableBits * (kGicableBitMark + kGicableOneSpace) + kGicableBitMark);
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchGicableHdrMark == kGicableHdrMark,
+              "See IRrecvTimings.h");
+
 #if SEND_GICABLE
 /// Send a raw G.I. Cable formatted message.
 /// Status: Alpha / Untested.
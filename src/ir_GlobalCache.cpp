@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include "IRsend.h"
+#include "IRutils.h"
 
 // Constants
 const uint16_t kGlobalCacheMaxRepeat = 50;
@@ -60,4 +61,61 @@ void IRsend::sendGC(uint16_t buf[], uint16_t len) {
   // It's possible that we've ended on a mark(), thus ensure the LED is off.
   ledOff();
 }
+
+/// Send a shortened GlobalCache (GC) IRdb/control tower formatted message,
+/// straight from its text form.
+/// i.e. The same as `sendGC(uint16_t buf[], uint16_t len)`, but the values are
+/// read from the string as they are sent, rather than needing to be converted
+/// into an array first. That uses a constant (& small) amount of memory, no
+/// matter how long the message is.
+/// Status: BETA / Should work.
+/// @param[in] str A C string of comma separated (decimal) values.
+///   e.g. "38000,1,1,170,170,20,63,20,63,20,63,20,20,20,20,20,20,20,20,20,..."
+/// @return true, if it was sent. false if `str` isn't a valid GC code.
+/// @note Only the leading "sendir,1:1,1," part of a GC command needs to be
+///   removed first.
+bool IRsend::sendGC(const char *str) {
+  // Check the whole thing first, so we never send half of a message.
+  const int32_t count = irutils::countValues(str);
+  if (count <= kGlobalCacheStartIndex) return false;
+  uint32_t hz;
+  uint32_t emits;
+  uint32_t rpt_start;
+  const char *ptr = str;
+  irutils::parseValue(&ptr, &hz);
+  irutils::parseValue(&ptr, &emits);
+  irutils::parseValue(&ptr, &rpt_start);
+  if (hz > UINT16_MAX) return false;
+  const char *start = ptr;  // i.e. kGlobalCacheStartIndex
+  // Find where the repeats start from.
+  const char *rpt_ptr = start;
+  uint32_t value;
+  for (uint32_t i = 1; i < rpt_start; i++)
+    if (!irutils::parseValue(&rpt_ptr, &value)) return false;
+  enableIROut(hz);
+  uint32_t periodic_time = calcUSecPeriod(hz, false);
+  emits = std::min(emits, (uint32_t)kGlobalCacheMaxRepeat);
+  for (uint8_t repeat = 0; repeat < emits; repeat++) {
+    // First time through, start at the beginning (kGlobalCacheStartIndex),
+    // otherwise for repeats, we start a specified offset from that.
+    uint32_t offset = kGlobalCacheStartIndex;
+    if (repeat && rpt_start) offset += rpt_start - 1;
+    ptr = repeat ? rpt_ptr : start;
+    // Data
+    for (; irutils::parseValue(&ptr, &value); offset++) {
+      // Convert periodic units to microseconds.
+      // Minimum is kGlobalCacheMinUsec for actual GC units.
+      uint32_t microseconds = std::max((uint32_t)std::min(
+          value, (uint32_t)UINT16_MAX) * periodic_time, kGlobalCacheMinUsec);
+      // These codes start at an odd index (not even as with sendRaw).
+      if (offset & 1)  // Odd bit.
+        mark(microseconds);
+      else  // Even bit.
+        space(microseconds);
+    }
+  }
+  // It's possible that we've ended on a mark(), thus ensure the LED is off.
+  ledOff();
+  return true;
+}
 #endif
@@ -10,6 +10,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
@@ -24,6 +25,10 @@ using irutils::addTempToString;
 using irutils::setBit;
 using irutils::setBits;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchGoodweatherHdrMark == kGoodweatherHdrMark,
+              "See IRrecvTimings.h");
+
 #if SEND_GOODWEATHER
 /// Send a Goodweather HVAC formatted message.
 /// Status: BETA / Needs testing on real device.
@@ -45,7 +50,7 @@ void IRsend::sendGoodweather(const uint64_t data, const uint16_t nbits,
     // Data
     for (int16_t i = 0; i < nbits; i += 8) {
       uint16_t chunk = (data >> i) & 0xFF;  // Grab a byte at a time.
-      chunk = (~chunk) << 8 | chunk;  // Prepend a inverted copy of the byte.
+      chunk = ((~chunk & 0xFF) << 8) | chunk;  // Prepend an inverted copy.
       sendData(kGoodweatherBitMark, kGoodweatherOneSpace,
                kGoodweatherBitMark, kGoodweatherZeroSpace,
                chunk, 16, false);
@@ -344,17 +349,17 @@ stdAc::state_t IRGoodweatherAc::toCommon(void) {
 String IRGoodweatherAc::toString(void) {
   String result = "";
   result.reserve(150);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kGoodweatherAuto, kGoodweatherCool,
-                            kGoodweatherHeat, kGoodweatherDry, kGoodweatherFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kGoodweatherFanHigh, kGoodweatherFanLow,
-                           kGoodweatherFanAuto, kGoodweatherFanAuto,
-                           kGoodweatherFanMed);
-  result += addLabeledString(getTurbo() ? kToggleStr : "-", kTurboStr);
-  result += addLabeledString(getLight() ? kToggleStr : "-", kLightStr);
-  result += addLabeledString(getSleep() ? kToggleStr : "-", kSleepStr);
-  result += addIntToString(getSwing(), kSwingStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kGoodweatherAuto, kGoodweatherCool,
+                  kGoodweatherHeat, kGoodweatherDry, kGoodweatherFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kGoodweatherFanHigh, kGoodweatherFanLow,
+                 kGoodweatherFanAuto, kGoodweatherFanAuto,
+                 kGoodweatherFanMed);
+  addLabeledString(&result, getTurbo() ? kToggleStr : "-", kTurboStr);
+  addLabeledString(&result, getLight() ? kToggleStr : "-", kLightStr);
+  addLabeledString(&result, getSleep() ? kToggleStr : "-", kSleepStr);
+  addIntToString(&result, getSwing(), kSwingStr);
   result += kSpaceLBraceStr;
   switch (this->getSwing()) {
     case kGoodweatherSwingFast:
@@ -370,7 +375,7 @@ String IRGoodweatherAc::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getCommand(), kCommandStr);
+  addIntToString(&result, getCommand(), kCommandStr);
   result += kSpaceLBraceStr;
   switch (this->getCommand()) {
     case kGoodweatherCmdPower:
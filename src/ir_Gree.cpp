@@ -12,6 +12,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
@@ -27,6 +28,16 @@ const uint16_t kGreeZeroSpace = 540;
 const uint16_t kGreeMsgSpace = 19000;
 const uint8_t kGreeBlockFooter = 0b010;
 const uint8_t kGreeBlockFooterBits = 3;
+const uint8_t kGreeBlockLength = 4;  ///< Bytes before the mid-frame footer.
+const gree_frame_t kGreeFrame = {
+    kGreeHdrMark, kGreeHdrSpace, kGreeBitMark, kGreeOneSpace, kGreeZeroSpace,
+    kGreeMsgSpace, kGreeMsgSpace};
+
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchGreeHdrMark == kGreeHdrMark, "See IRrecvTimings.h");
+static_assert(kLongGapGreeHdrMark == kGreeHdrMark, "See IRrecvTimings.h");
+static_assert(kLongGapGreeHdrSpace == kGreeHdrSpace, "See IRrecvTimings.h");
+static_assert(kLongGapGreeMsgSpace == kGreeMsgSpace, "See IRrecvTimings.h");
 
 using irutils::addBoolToString;
 using irutils::addIntToString;
@@ -48,22 +59,8 @@ void IRsend::sendGree(const uint8_t data[], const uint16_t nbytes,
   if (nbytes < kGreeStateLength)
     return;  // Not enough bytes to send a proper message.
 
-  for (uint16_t r = 0; r <= repeat; r++) {
-    // Block #1
-    sendGeneric(kGreeHdrMark, kGreeHdrSpace, kGreeBitMark, kGreeOneSpace,
-                kGreeBitMark, kGreeZeroSpace, 0, 0,  // No Footer.
-                data, 4, 38, false, 0, 50);
-    // Footer #1
-    sendGeneric(0, 0,  // No Header
-                kGreeBitMark, kGreeOneSpace, kGreeBitMark, kGreeZeroSpace,
-                kGreeBitMark, kGreeMsgSpace, 0b010, 3, 38, false, 0, 50);
-
-    // Block #2
-    sendGeneric(0, 0,  // No Header for Block #2
-                kGreeBitMark, kGreeOneSpace, kGreeBitMark, kGreeZeroSpace,
-                kGreeBitMark, kGreeMsgSpace, data + 4, nbytes - 4, 38, false, 0,
-                50);
-  }
+  for (uint16_t r = 0; r <= repeat; r++)
+    sendGreeFrame(&kGreeFrame, data, nbytes);
 }
 
 /// Send a Gree Heat Pump formatted message.
@@ -102,6 +99,33 @@ void IRsend::sendGree(const uint64_t data, const uint16_t nbits,
 }
 #endif  // SEND_GREE
 
+#if (SEND_GREE || SEND_KELVINATOR)
+/// Send a single Gree style frame. i.e. As used by Gree & Kelvinator.
+/// @param[in] frame The timings of the frame. See `gree_frame_t`.
+/// @param[in] data The bytes to be sent.
+/// @param[in] nbytes The number of bytes in the frame.
+void IRsend::sendGreeFrame(const gree_frame_t *frame, const uint8_t data[],
+                           const uint16_t nbytes) {
+  if (nbytes < kGreeBlockLength) return;
+  // Block #1
+  sendGeneric(frame->hdrmark, frame->hdrspace,
+              frame->bitmark, frame->onespace, frame->bitmark, frame->zerospace,
+              0, 0,  // No Footer.
+              data, kGreeBlockLength, 38, false, 0, 50);
+  // Footer #1 (3 bits (0b010))
+  sendGeneric(0, 0,  // No Header
+              frame->bitmark, frame->onespace, frame->bitmark, frame->zerospace,
+              frame->bitmark, frame->blockgap,
+              kGreeBlockFooter, kGreeBlockFooterBits, 38, false, 0, 50);
+  // Block #2
+  sendGeneric(0, 0,  // No Header for Block #2
+              frame->bitmark, frame->onespace, frame->bitmark, frame->zerospace,
+              frame->bitmark, frame->framegap,
+              data + kGreeBlockLength, nbytes - kGreeBlockLength, 38, false, 0,
+              50);
+}
+#endif  // (SEND_GREE || SEND_KELVINATOR)
+
 /// Class constructor
 /// @param[in] pin GPIO to be used when sending.
 /// @param[in] model The enum of the model to be emulated.
@@ -236,24 +260,27 @@ bool IRGreeAC::getUseFahrenheit(void) const {
 /// @note The unit actually works in Celsius with a special optional
 ///   "extra degree" when sending Fahrenheit.
 void IRGreeAC::setTemp(const uint8_t temp, const bool fahrenheit) {
-  float safecelsius = temp;
+  // Work in tenths of a degree Celsius to avoid (slow) software float maths.
+  int16_t safecelsius10 = temp * 10;
   if (fahrenheit)
     // Covert to F, and add a fudge factor to round to the expected degree.
     // Why 0.6 you ask?! Because it works. Ya'd thing 0.5 would be good for
     // rounding, but Noooooo!
-    safecelsius = fahrenheitToCelsius(temp + 0.6);
+    safecelsius10 = fahrenheitToCelsiusTenths(temp * 10 + 6);
   setUseFahrenheit(fahrenheit);  // Set the correct Temp units.
 
   // Make sure we have desired temp in the correct range.
-  safecelsius = std::max(static_cast<float>(kGreeMinTempC), safecelsius);
-  safecelsius = std::min(static_cast<float>(kGreeMaxTempC), safecelsius);
+  safecelsius10 = std::max(static_cast<int16_t>(kGreeMinTempC * 10),
+                           safecelsius10);
+  safecelsius10 = std::min(static_cast<int16_t>(kGreeMaxTempC * 10),
+                           safecelsius10);
   // An operating mode of Auto locks the temp to a specific value. Do so.
-  if (_.Mode == kGreeAuto) safecelsius = 25;
+  if (_.Mode == kGreeAuto) safecelsius10 = 250;
 
   // Set the "main" Celsius degrees.
-  _.Temp = safecelsius - kGreeMinTempC;
+  _.Temp = safecelsius10 / 10 - kGreeMinTempC;
   // Deal with the extra degree fahrenheit difference.
-  _.TempExtraDegreeF = (static_cast<uint8_t>(safecelsius * 2) & 1);
+  _.TempExtraDegreeF = (safecelsius10 / 5) & 1;
 }
 
 /// Get the set temperature
@@ -261,7 +288,7 @@ void IRGreeAC::setTemp(const uint8_t temp, const bool fahrenheit) {
 uint8_t IRGreeAC::getTemp(void) const {
   uint8_t deg = kGreeMinTempC + _.Temp;
   if (_.UseFahrenheit) {
-    deg = celsiusToFahrenheit(deg);
+    deg = celsiusToFahrenheitTenths(deg * 10) / 10;
     // Retrieve the "extra" fahrenheit from elsewhere in the code.
     if (_.TempExtraDegreeF) deg++;
     deg = std::max(deg, kGreeMinTempF);  // Cover the fact that 61F is < 16C
@@ -595,22 +622,22 @@ stdAc::state_t IRGreeAC::toCommon(void) {
 String IRGreeAC::toString(void) {
   String result = "";
   result.reserve(220);  // Reserve some heap for the string to reduce fragging.
-  result += addModelToString(decode_type_t::GREE, _model, false);
-  result += addBoolToString(_.Power, kPowerStr);
-  result += addModeToString(_.Mode, kGreeAuto, kGreeCool, kGreeHeat,
-                            kGreeDry, kGreeFan);
-  result += addTempToString(getTemp(), !_.UseFahrenheit);
-  result += addFanToString(_.Fan, kGreeFanMax, kGreeFanMin, kGreeFanAuto,
-                           kGreeFanAuto, kGreeFanMed);
-  result += addBoolToString(_.Turbo, kTurboStr);
-  result += addBoolToString(_.IFeel, kIFeelStr);
-  result += addBoolToString(_.WiFi, kWifiStr);
-  result += addBoolToString(_.Xfan, kXFanStr);
-  result += addBoolToString(_.Light, kLightStr);
-  result += addBoolToString(_.Sleep, kSleepStr);
-  result += addLabeledString(_.SwingAuto ? kAutoStr : kManualStr,
-                             kSwingVModeStr);
-  result += addIntToString(_.Swing, kSwingVStr);
+  addModelToString(&result, decode_type_t::GREE, _model, false);
+  addBoolToString(&result, _.Power, kPowerStr);
+  addModeToString(&result, _.Mode, kGreeAuto, kGreeCool, kGreeHeat,
+                  kGreeDry, kGreeFan);
+  addTempToString(&result, getTemp(), !_.UseFahrenheit);
+  addFanToString(&result, _.Fan, kGreeFanMax, kGreeFanMin, kGreeFanAuto,
+                 kGreeFanAuto, kGreeFanMed);
+  addBoolToString(&result, _.Turbo, kTurboStr);
+  addBoolToString(&result, _.IFeel, kIFeelStr);
+  addBoolToString(&result, _.WiFi, kWifiStr);
+  addBoolToString(&result, _.Xfan, kXFanStr);
+  addBoolToString(&result, _.Light, kLightStr);
+  addBoolToString(&result, _.Sleep, kSleepStr);
+  addLabeledString(&result, _.SwingAuto ? kAutoStr : kManualStr,
+                   kSwingVModeStr);
+  addIntToString(&result, _.Swing, kSwingVStr);
   result += kSpaceLBraceStr;
   switch (_.Swing) {
     case kGreeSwingLastPos:
@@ -622,10 +649,10 @@ String IRGreeAC::toString(void) {
     default: result += kUnknownStr;
   }
   result += ')';
-  result += addLabeledString(
+  addLabeledString(&result, 
       _.TimerEnabled ? minsToString(getTimer()) : kOffStr, kTimerStr);
   uint8_t src = _.DisplayTemp;
-  result += addIntToString(src, kDisplayTempStr);
+  addIntToString(&result, src, kDisplayTempStr);
   result += kSpaceLBraceStr;
   switch (src) {
     case kGreeDisplayTempOff:
@@ -658,44 +685,108 @@ String IRGreeAC::toString(void) {
 /// @return A boolean. True if it can decode it, false if it can't.
 bool IRrecv::decodeGree(decode_results* results, uint16_t offset,
                         const uint16_t nbits, bool const strict) {
-  if (results->rawlen <=
-      2 * (nbits + kGreeBlockFooterBits) + (kHeader + kFooter + 1) - 1 + offset)
-    return false;  // Can't possibly be a valid Gree message.
   if (strict && nbits != kGreeBits)
     return false;  // Not strictly a Gree message.
+  return decodeGreeFamily(results, offset, true, false, strict);
+}
+#endif  // DECODE_GREE
 
-  // There are two blocks back-to-back in a full Gree IR message
-  // sequence.
-
-  uint16_t used;
-  // Header + Data Block #1 (32 bits)
-  used = matchGeneric(results->rawbuf + offset, results->state,
-                      results->rawlen - offset, nbits / 2,
-                      kGreeHdrMark, kGreeHdrSpace,
-                      kGreeBitMark, kGreeOneSpace,
-                      kGreeBitMark, kGreeZeroSpace,
-                      0, 0, false,
-                      _tolerance, kMarkExcess, false);
-  if (used == 0) return false;
-  offset += used;
-
+#if (DECODE_GREE || DECODE_KELVINATOR)
+/// Match & decode a single Gree style frame. i.e. As used by Gree & Kelvinator.
+/// @param[in] data_ptr A pointer to where we are at in the capture buffer.
+/// @param[out] state A ptr to where to store the decoded bytes.
+/// @param[in] remaining The length of the capture buffer from `data_ptr`.
+/// @param[in] nbytes The number of bytes in the frame.
+/// @param[in] frame The timings of the frame. See `gree_frame_t`.
+/// @param[in] atleast Is the frame gap a minimum, rather than an exact match?
+/// @return The nr. of entries of the capture buffer it used. 0 if no match.
+uint16_t IRrecv::matchGreeFrame(volatile uint16_t *data_ptr, uint8_t *state,
+                                const uint16_t remaining,
+                                const uint16_t nbytes,
+                                const gree_frame_t *frame,
+                                const bool atleast) {
+  if (nbytes < kGreeBlockLength) return 0;
+  // Header + Block #1
+  uint16_t offset = matchGeneric(data_ptr, state, remaining,
+                                 kGreeBlockLength * 8,
+                                 frame->hdrmark, frame->hdrspace,
+                                 frame->bitmark, frame->onespace,
+                                 frame->bitmark, frame->zerospace,
+                                 0, 0, false,
+                                 _tolerance, kMarkExcess, false);
+  if (offset == 0) return 0;
   // Block #1 footer (3 bits, B010)
-  match_result_t data_result;
-  data_result = matchData(&(results->rawbuf[offset]), kGreeBlockFooterBits,
-                          kGreeBitMark, kGreeOneSpace, kGreeBitMark,
-                          kGreeZeroSpace, _tolerance, kMarkExcess, false);
-  if (data_result.success == false) return false;
-  if (data_result.data != kGreeBlockFooter) return false;
+  if (remaining < offset + 2 * kGreeBlockFooterBits) return 0;
+  match_result_t data_result = matchData(data_ptr + offset,
+                                         kGreeBlockFooterBits,
+                                         frame->bitmark, frame->onespace,
+                                         frame->bitmark, frame->zerospace,
+                                         _tolerance, kMarkExcess, false);
+  if (data_result.success == false) return 0;
+  if (data_result.data != kGreeBlockFooter) return 0;
   offset += data_result.used;
+  // Inter-block gap + Block #2 + Footer
+  const uint16_t used = matchGeneric(data_ptr + offset,
+                                     state + kGreeBlockLength,
+                                     remaining - offset,
+                                     (nbytes - kGreeBlockLength) * 8,
+                                     frame->bitmark, frame->blockgap,
+                                     frame->bitmark, frame->onespace,
+                                     frame->bitmark, frame->zerospace,
+                                     frame->bitmark, frame->framegap, atleast,
+                                     _tolerance, kMarkExcess, false);
+  if (used == 0) return 0;
+  return offset + used;
+}
+
+/// Decode the supplied Gree HVAC or Kelvinator A/C message, in a single pass.
+/// Both send the same style of frame, & Kelvinator sends a second one after a
+/// longer gap. So the first frame is only matched once, & what follows it
+/// decides which of the two protocols it is.
+/// Status: STABLE / Working.
+/// @param[in,out] results Ptr to the data to decode & where to store the decode
+///   result.
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data. Typically/Defaults to kStartOffset.
+/// @param[in] gree Can it be a Gree message?
+/// @param[in] kelvinator Can it be a Kelvinator message?
+/// @param[in] strict Flag indicating if we should perform strict matching.
+/// @return A boolean. True if it can decode it, false if it can't.
+/// @note Gree's timings are within a few percent of Kelvinator's, so the first
+///   frame of either is matched with Gree's when it may be either.
+bool IRrecv::decodeGreeFamily(decode_results* results, uint16_t offset,
+                              const bool gree, const bool kelvinator,
+                              const bool strict) {
+  if (!gree && !kelvinator) return false;
+  if (results->rawlen <=
+      2 * (kGreeBits + kGreeBlockFooterBits) + (kHeader + kFooter + 1) - 1 +
+      offset)
+    return false;  // Can't possibly be a valid Gree or Kelvinator message.
+
+  // First frame. If it can't be Gree, the gap after it must be Kelvinator's.
+  uint16_t used = matchGreeFrame(results->rawbuf + offset, results->state,
+                                 results->rawlen - offset, kGreeStateLength,
+                                 gree ? &kGreeFrame : &kKelvinatorFrame, gree);
+  if (used == 0) return false;
+  offset += used;
 
-  // Inter-block gap + Data Block #2 (32 bits) + Footer
-  if (!matchGeneric(results->rawbuf + offset, results->state + 4,
-                    results->rawlen - offset, nbits / 2,
-                    kGreeBitMark, kGreeMsgSpace,
-                    kGreeBitMark, kGreeOneSpace,
-                    kGreeBitMark, kGreeZeroSpace,
-                    kGreeBitMark, kGreeMsgSpace, true,
-                    _tolerance, kMarkExcess, false)) return false;
+  // Does a second frame follow, after Kelvinator's gap?
+  if (kelvinator && offset < results->rawlen &&
+      (!gree || matchSpace(results->rawbuf[offset - 1],
+                           kKelvinatorFrame.framegap))) {
+    used = matchGreeFrame(results->rawbuf + offset,
+                          results->state + kGreeStateLength,
+                          results->rawlen - offset, kGreeStateLength,
+                          &kKelvinatorFrame, true);
+    // Compliance
+    if (used && (!strict || IRKelvinatorAC::validChecksum(results->state))) {
+      // Success
+      results->decode_type = decode_type_t::KELVINATOR;
+      results->bits = kKelvinatorBits;
+      return true;
+    }
+  }
+  if (!gree) return false;  // A single frame can only be Gree.
 
   // Compliance
   if (strict) {
@@ -705,10 +796,10 @@ bool IRrecv::decodeGree(decode_results* results, uint16_t offset,
 
   // Success
   results->decode_type = GREE;
-  results->bits = nbits;
+  results->bits = kGreeBits;
   // No need to record the state as we stored it as we decoded it.
   // As we use result->state, we don't record value, address, or command as it
   // is a union data type.
   return true;
 }
-#endif  // DECODE_GREE
+#endif  // (DECODE_GREE || DECODE_KELVINATOR)
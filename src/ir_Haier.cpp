@@ -14,6 +14,7 @@
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -26,14 +27,34 @@ const uint16_t kHaierAcOneSpace = 1650;
 const uint16_t kHaierAcZeroSpace = 650;
 const uint32_t kHaierAcMinGap = 150000;  // Completely made up value.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchHaierAcHdr == kHaierAcHdr, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
 using irutils::addModeToString;
 using irutils::addFanToString;
 using irutils::addTempToString;
+using irutils::checksum_t;
+using irutils::fixed_byte_t;
+using irutils::kChecksumToEnd;
+using irutils::kSumBytesChecksum;
 using irutils::minsToString;
 
+// The YRW02 state is a single section, with its checksum as the last byte.
+const checksum_t kHaierAcYrw02Checksums[] = {
+    {kSumBytesChecksum, 0, kChecksumToEnd, 0}};
+const uint8_t kHaierAcYrw02ChecksumsSize =
+    sizeof(kHaierAcYrw02Checksums) / sizeof(kHaierAcYrw02Checksums[0]);
+#if (DECODE_HAIER_AC || DECODE_HAIER_AC_YRW02)
+/// The signature byte of a HAIER_AC message.
+const fixed_byte_t kHaierAcFixed[] = {{0, 0xFF, kHaierAcPrefix}};
+/// What is verified of a HAIER_AC message as it is matched.
+const byte_checks_t kHaierAcChecks = {
+    kHaierAcYrw02Checksums, kHaierAcYrw02ChecksumsSize, kHaierAcFixed, 1};
+#endif  // (DECODE_HAIER_AC || DECODE_HAIER_AC_YRW02)
+
 #define GETTIME(x) _.x##Hours * 60 + _.x##Mins
 #define SETTIME(x, n) do { \
   uint16_t mins = n;\
@@ -107,7 +128,8 @@ void IRHaierAC::checksum(void) {
 /// @return true, if the state has a valid checksum. Otherwise, false.
 bool IRHaierAC::validChecksum(uint8_t state[], const uint16_t length) {
   if (length < 2) return false;  // 1 byte of data can't have a checksum.
-  return (state[length - 1] == sumBytes(state, length - 1));
+  return irutils::validChecksums(kHaierAcYrw02Checksums,
+                                 kHaierAcYrw02ChecksumsSize, state, length);
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -440,7 +462,7 @@ String IRHaierAC::toString(void) const {
   String result = "";
   result.reserve(150);  // Reserve some heap for the string to reduce fragging.
   uint8_t cmd = _.Command;
-  result += addIntToString(cmd, kCommandStr, false);
+  addIntToString(&result, cmd, kCommandStr, false);
   result += kSpaceLBraceStr;
   switch (cmd) {
     case kHaierAcCmdOff:
@@ -484,12 +506,12 @@ String IRHaierAC::toString(void) const {
       result += kUnknownStr;
   }
   result += ')';
-  result += addModeToString(_.Mode, kHaierAcAuto, kHaierAcCool, kHaierAcHeat,
-                            kHaierAcDry, kHaierAcFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kHaierAcFanHigh, kHaierAcFanLow,
-                           kHaierAcFanAuto, kHaierAcFanAuto, kHaierAcFanMed);
-  result += addIntToString(_.Swing, kSwingStr);
+  addModeToString(&result, _.Mode, kHaierAcAuto, kHaierAcCool, kHaierAcHeat,
+                  kHaierAcDry, kHaierAcFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kHaierAcFanHigh, kHaierAcFanLow,
+                 kHaierAcFanAuto, kHaierAcFanAuto, kHaierAcFanMed);
+  addIntToString(&result, _.Swing, kSwingStr);
   result += kSpaceLBraceStr;
   switch (_.Swing) {
     case kHaierAcSwingOff:
@@ -508,12 +530,12 @@ String IRHaierAC::toString(void) const {
       result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(_.Sleep, kSleepStr);
-  result += addBoolToString(_.Health, kHealthStr);
-  result += addLabeledString(minsToString(getCurrTime()), kClockStr);
-  result += addLabeledString(
+  addBoolToString(&result, _.Sleep, kSleepStr);
+  addBoolToString(&result, _.Health, kHealthStr);
+  addLabeledString(&result, minsToString(getCurrTime()), kClockStr);
+  addLabeledString(&result, 
       getOnTimer() >= 0 ? minsToString(getOnTimer()) : kOffStr, kOnTimerStr);
-  result += addLabeledString(
+  addLabeledString(&result, 
       getOffTimer() >= 0 ? minsToString(getOffTimer()) : kOffStr,
       kOffTimerStr);
   return result;
@@ -541,7 +563,8 @@ void IRHaierACYRW02::send(const uint16_t repeat) {
 
 /// Calculate and set the checksum values for the internal state.
 void IRHaierACYRW02::checksum(void) {
-  _.Sum = sumBytes(_.raw, kHaierACYRW02StateLength - 1);
+  irutils::setChecksums(kHaierAcYrw02Checksums, kHaierAcYrw02ChecksumsSize,
+                        _.raw, kHaierACYRW02StateLength);
 }
 
 /// Verify the checksum is valid for a given state.
@@ -871,9 +894,9 @@ stdAc::state_t IRHaierACYRW02::toCommon(void) const {
 String IRHaierACYRW02::toString(void) const {
   String result = "";
   result.reserve(130);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(_.Power, kPowerStr, false);
+  addBoolToString(&result, _.Power, kPowerStr, false);
   uint8_t cmd = _.Button;
-  result += addIntToString(cmd, kButtonStr);
+  addIntToString(&result, cmd, kButtonStr);
   result += kSpaceLBraceStr;
   switch (cmd) {
     case kHaierAcYrw02ButtonPower:
@@ -907,14 +930,14 @@ String IRHaierACYRW02::toString(void) const {
       result += kUnknownStr;
   }
   result += ')';
-  result += addModeToString(_.Mode, kHaierAcYrw02Auto, kHaierAcYrw02Cool,
-                            kHaierAcYrw02Heat, kHaierAcYrw02Dry,
-                            kHaierAcYrw02Fan);
-  result += addTempToString(getTemp());
-  result += addFanToString(_.Fan, kHaierAcYrw02FanHigh, kHaierAcYrw02FanLow,
-                           kHaierAcYrw02FanAuto, kHaierAcYrw02FanAuto,
-                           kHaierAcYrw02FanMed);
-  result += addIntToString(_.Turbo, kTurboStr);
+  addModeToString(&result, _.Mode, kHaierAcYrw02Auto, kHaierAcYrw02Cool,
+                  kHaierAcYrw02Heat, kHaierAcYrw02Dry,
+                  kHaierAcYrw02Fan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, _.Fan, kHaierAcYrw02FanHigh, kHaierAcYrw02FanLow,
+                 kHaierAcYrw02FanAuto, kHaierAcYrw02FanAuto,
+                 kHaierAcYrw02FanMed);
+  addIntToString(&result, _.Turbo, kTurboStr);
   result += kSpaceLBraceStr;
   switch (_.Turbo) {
     case kHaierAcYrw02TurboOff:
@@ -930,7 +953,7 @@ String IRHaierACYRW02::toString(void) const {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(_.Swing, kSwingStr);
+  addIntToString(&result, _.Swing, kSwingStr);
   result += kSpaceLBraceStr;
   switch (_.Swing) {
     case kHaierAcYrw02SwingOff:
@@ -955,8 +978,8 @@ String IRHaierACYRW02::toString(void) const {
       result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(_.Sleep, kSleepStr);
-  result += addBoolToString(_.Health, kHealthStr);
+  addBoolToString(&result, _.Sleep, kSleepStr);
+  addBoolToString(&result, _.Health, kHealthStr);
   return result;
 }
 // End of IRHaierACYRW02 class.
@@ -986,19 +1009,15 @@ bool IRrecv::decodeHaierAC(decode_results* results, uint16_t offset,
   if (!matchSpace(results->rawbuf[offset++], kHaierAcHdr)) return false;
 
   // Match Header + Data + Footer
+  // Strictly, the signature & checksum are verified as they are matched.
   if (!matchGeneric(results->rawbuf + offset, results->state,
                     results->rawlen - offset, nbits,
                     kHaierAcHdr, kHaierAcHdrGap,
                     kHaierAcBitMark, kHaierAcOneSpace,
                     kHaierAcBitMark, kHaierAcZeroSpace,
                     kHaierAcBitMark, kHaierAcMinGap, true,
-                    _tolerance, kMarkExcess)) return false;
-
-  // Compliance
-  if (strict) {
-    if (results->state[0] != kHaierAcPrefix) return false;
-    if (!IRHaierAC::validChecksum(results->state, nbits / 8)) return false;
-  }
+                    _tolerance, kMarkExcess, true,
+                    strict ? &kHaierAcChecks : NULL)) return false;
 
   // Success
   results->decode_type = HAIER_AC;
@@ -15,6 +15,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
@@ -45,6 +46,20 @@ const uint16_t kHitachiAc3BitMark = 460;
 const uint16_t kHitachiAc3OneSpace = 1250;
 const uint16_t kHitachiAc3ZeroSpace = 410;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchHitachiAcHdrMark == kHitachiAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchHitachiAc1HdrMark == kHitachiAc1HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchHitachiAc3HdrMark == kHitachiAc3HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchHitachiAc424LdrMark == kHitachiAc424LdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapHitachiAc424LdrMark == kHitachiAc424LdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapHitachiAc424LdrSpace == kHitachiAc424LdrSpace,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
@@ -405,15 +420,15 @@ stdAc::state_t IRHitachiAc::toCommon(void) {
 String IRHitachiAc::toString(void) {
   String result = "";
   result.reserve(110);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kHitachiAcAuto, kHitachiAcCool,
-                            kHitachiAcHeat, kHitachiAcDry, kHitachiAcFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kHitachiAcFanHigh, kHitachiAcFanLow,
-                           kHitachiAcFanAuto, kHitachiAcFanAuto,
-                           kHitachiAcFanMed);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
-  result += addBoolToString(getSwingHorizontal(), kSwingHStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kHitachiAcAuto, kHitachiAcCool,
+                  kHitachiAcHeat, kHitachiAcDry, kHitachiAcFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kHitachiAcFanHigh, kHitachiAcFanLow,
+                 kHitachiAcFanAuto, kHitachiAcFanAuto,
+                 kHitachiAcFanMed);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getSwingHorizontal(), kSwingHStr);
   return result;
 }
 
@@ -827,24 +842,24 @@ stdAc::state_t IRHitachiAc1::toCommon(void) {
 String IRHitachiAc1::toString(void) {
   String result = "";
   result.reserve(170);  // Reserve some heap for the string to reduce fragging.
-  result += addModelToString(decode_type_t::HITACHI_AC1, getModel(), false);
-  result += addBoolToString(getPower(), kPowerStr);
-  result += addBoolToString(getPowerToggle(), kPowerToggleStr);
-  result += addModeToString(getMode(), kHitachiAc1Auto, kHitachiAc1Cool,
-                            kHitachiAc1Heat, kHitachiAc1Dry, kHitachiAc1Fan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kHitachiAc1FanHigh, kHitachiAc1FanLow,
-                           kHitachiAc1FanAuto, kHitachiAc1FanAuto,
-                           kHitachiAc1FanMed);
-  result += addBoolToString(getSwingToggle(), kSwingVToggleStr);
-  result += addBoolToString(getSwingV(), kSwingVStr);
-  result += addBoolToString(getSwingH(), kSwingHStr);
-  result += addLabeledString(getSleep() ? uint64ToString(getSleep()) : kOffStr,
-                             kSleepStr);
-  result += addLabeledString(getOnTimer() ? minsToString(getOnTimer())
+  addModelToString(&result, decode_type_t::HITACHI_AC1, getModel(), false);
+  addBoolToString(&result, getPower(), kPowerStr);
+  addBoolToString(&result, getPowerToggle(), kPowerToggleStr);
+  addModeToString(&result, getMode(), kHitachiAc1Auto, kHitachiAc1Cool,
+                  kHitachiAc1Heat, kHitachiAc1Dry, kHitachiAc1Fan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kHitachiAc1FanHigh, kHitachiAc1FanLow,
+                 kHitachiAc1FanAuto, kHitachiAc1FanAuto,
+                 kHitachiAc1FanMed);
+  addBoolToString(&result, getSwingToggle(), kSwingVToggleStr);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
+  addBoolToString(&result, getSwingH(), kSwingHStr);
+  addLabeledString(&result, getSleep() ? uint64ToString(getSleep()) : kOffStr,
+                   kSleepStr);
+  addLabeledString(&result, getOnTimer() ? minsToString(getOnTimer())
                                           : kOffStr,
                             kOnTimerStr);
-  result += addLabeledString(getOffTimer() ? minsToString(getOffTimer())
+  addLabeledString(&result, getOffTimer() ? minsToString(getOffTimer())
                                            : kOffStr,
                             kOffTimerStr);
   return result;
@@ -1049,7 +1064,8 @@ void IRHitachiAc424::stateReset(void) {
 
 /// Update the internal consistency check for the protocol.
 void IRHitachiAc424::setInvertedStates(void) {
-  invertBytePairs(remote_state + 3, kHitachiAc424StateLength - 3);
+  invertBytePairs(remote_state + kHitachiAcInvertedStart,
+                  kHitachiAc424StateLength - kHitachiAcInvertedStart);
 }
 
 /// Set up hardware to be able to send a message.
@@ -1303,12 +1319,12 @@ stdAc::state_t IRHitachiAc424::toCommon(void) {
 String IRHitachiAc424::_toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), 0, kHitachiAc424Cool,
-                            kHitachiAc424Heat, kHitachiAc424Dry,
-                            kHitachiAc424Fan);
-  result += addTempToString(getTemp());
-  result += addIntToString(getFan(), kFanStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), 0, kHitachiAc424Cool,
+                  kHitachiAc424Heat, kHitachiAc424Dry,
+                  kHitachiAc424Fan);
+  addTempToString(&result, getTemp());
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (getFan()) {
     case kHitachiAc424FanAuto:   result += kAutoStr; break;
@@ -1320,7 +1336,7 @@ String IRHitachiAc424::_toString(void) {
     default:                     result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getButton(), kButtonStr);
+  addIntToString(&result, getButton(), kButtonStr);
   result += kSpaceLBraceStr;
   switch (getButton()) {
     case kHitachiAc424ButtonPowerMode:
@@ -1403,7 +1419,9 @@ void IRHitachiAc3::stateReset(void) {
 /// @param[in] length The size of the state array.
 /// @note This is this protocols integrity check.
 void IRHitachiAc3::setInvertedStates(const uint16_t length) {
-  if (length > 3) invertBytePairs(remote_state + 3, length - 3);
+  if (length > kHitachiAcInvertedStart)
+    invertBytePairs(remote_state + kHitachiAcInvertedStart,
+                    length - kHitachiAcInvertedStart);
 }
 
 /// Check if every second byte of the state, after the fixed header
@@ -1413,7 +1431,9 @@ void IRHitachiAc3::setInvertedStates(const uint16_t length) {
 /// @note This is this protocols integrity check.
 bool IRHitachiAc3::hasInvertedStates(const uint8_t state[],
                                      const uint16_t length) {
-  return (length <= 3 || checkInvertedBytePairs(state + 3, length - 3));
+  return (length <= kHitachiAcInvertedStart ||
+          checkInvertedBytePairs(state + kHitachiAcInvertedStart,
+                                 length - kHitachiAcInvertedStart));
 }
 
 /// Set up hardware to be able to send a message.
@@ -1594,8 +1614,8 @@ String IRHitachiAc344::toString(void) {
   String result;
   result.reserve(120);  // Reserve some heap for the string to reduce fragging.
   result += _toString();
-  result += addBoolToString(getSwingV(), kSwingVStr);
-  result += addIntToString(getSwingH(), kSwingHStr);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
+  addIntToString(&result, getSwingH(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (getSwingH()) {
     case kHitachiAc344SwingHLeftMax:  result += kLeftMaxStr; break;
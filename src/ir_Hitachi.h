@@ -50,6 +50,10 @@ const uint8_t kHitachiAcMaxTemp = 32;   // 32C
 const uint8_t kHitachiAcAutoTemp = 23;  // 23C
 const uint8_t kHitachiAcPowerOffset = 0;
 const uint8_t kHitachiAcSwingOffset = 7;
+// HitachiAc424, HitachiAc344 & HitachiAc3
+// After the fixed header bytes, every second byte is the inverse of the one
+// before it. i.e. The integrity check.
+const uint8_t kHitachiAcInvertedStart = 3;
 
 // HitachiAc424 & HitachiAc344
 // Byte[11]
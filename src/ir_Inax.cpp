@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -20,6 +21,16 @@ const uint16_t kInaxBitMark = 560;
 const uint16_t kInaxOneSpace = 1675;
 const uint16_t kInaxZeroSpace = kInaxBitMark;
 const uint16_t kInaxMinGap = 40000;
+const pulse_distance_t kInaxProtocol = {
+    decode_type_t::INAX, kInaxBits,
+    kInaxHdrMark, kInaxHdrSpace,
+    kInaxBitMark, kInaxOneSpace,
+    kInaxBitMark, kInaxZeroSpace,
+    kInaxBitMark, kInaxMinGap,
+    38, kDutyDefault, true, kInaxMinRepeat};
+
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchInaxHdrMark == kInaxHdrMark, "See IRrecvTimings.h");
 
 #if SEND_INAX
 /// Send a Inax Toilet formatted message.
@@ -30,11 +41,7 @@ const uint16_t kInaxMinGap = 40000;
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/706
 void IRsend::sendInax(const uint64_t data, const uint16_t nbits,
                       const uint16_t repeat) {
-  sendGeneric(kInaxHdrMark, kInaxHdrSpace,
-              kInaxBitMark, kInaxOneSpace,
-              kInaxBitMark, kInaxZeroSpace,
-              kInaxBitMark, kInaxMinGap,
-              data, nbits, 38, true, repeat, kDutyDefault);
+  sendPulseDistance(&kInaxProtocol, data, nbits, repeat);
 }
 #endif  // SEND_INAX
 
@@ -50,24 +57,6 @@ void IRsend::sendInax(const uint64_t data, const uint16_t nbits,
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/706
 bool IRrecv::decodeInax(decode_results *results, uint16_t offset,
                         const uint16_t nbits, const bool strict) {
-  if (strict && nbits != kInaxBits)
-    return false;  // We expect Inax to be a certain sized message.
-
-  uint64_t data = 0;
-
-  // Match Header + Data + Footer
-  if (!matchGeneric(results->rawbuf + offset, &data,
-                    results->rawlen - offset, nbits,
-                    kInaxHdrMark, kInaxHdrSpace,
-                    kInaxBitMark, kInaxOneSpace,
-                    kInaxBitMark, kInaxZeroSpace,
-                    kInaxBitMark, kInaxMinGap, true)) return false;
-  // Success
-  results->bits = nbits;
-  results->value = data;
-  results->decode_type = decode_type_t::INAX;
-  results->command = 0;
-  results->address = 0;
-  return true;
+  return decodePulseDistance(results, offset, &kInaxProtocol, nbits, strict);
 }
 #endif  // DECODE_INAX
@@ -22,29 +22,12 @@
 #endif
 #include "IRac.h"
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
 
 // Constants
-const uint16_t kKelvinatorTick = 85;
-const uint16_t kKelvinatorHdrMarkTicks = 106;
-const uint16_t kKelvinatorHdrMark = kKelvinatorHdrMarkTicks * kKelvinatorTick;
-const uint16_t kKelvinatorHdrSpaceTicks = 53;
-const uint16_t kKelvinatorHdrSpace = kKelvinatorHdrSpaceTicks * kKelvinatorTick;
-const uint16_t kKelvinatorBitMarkTicks = 8;
-const uint16_t kKelvinatorBitMark = kKelvinatorBitMarkTicks * kKelvinatorTick;
-const uint16_t kKelvinatorOneSpaceTicks = 18;
-const uint16_t kKelvinatorOneSpace = kKelvinatorOneSpaceTicks * kKelvinatorTick;
-const uint16_t kKelvinatorZeroSpaceTicks = 6;
-const uint16_t kKelvinatorZeroSpace =
-    kKelvinatorZeroSpaceTicks * kKelvinatorTick;
-const uint16_t kKelvinatorGapSpaceTicks = 235;
-const uint16_t kKelvinatorGapSpace = kKelvinatorGapSpaceTicks * kKelvinatorTick;
-
-const uint8_t kKelvinatorCmdFooter = 2;
-const uint8_t kKelvinatorCmdFooterBits = 3;
-
 const uint8_t kKelvinatorModeOffset = 0;  // Mask 0b111
 const uint8_t kKelvinatorPowerOffset = 3;
 const uint8_t kKelvinatorFanOffset = 4;  // Mask 0b111
@@ -69,6 +52,16 @@ using irutils::addTempToString;
 using irutils::setBit;
 using irutils::setBits;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchKelvinatorHdrMark == kKelvinatorHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapKelvinatorHdrMark == kKelvinatorHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapKelvinatorHdrSpace == kKelvinatorHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapKelvinatorGap == kKelvinatorGapSpace * 2,
+              "See IRrecvTimings.h");
+
 #if SEND_KELVINATOR
 /// Send a Kelvinator A/C message.
 /// Status: STABLE / Known working.
@@ -81,38 +74,11 @@ void IRsend::sendKelvinator(const unsigned char data[], const uint16_t nbytes,
     return;  // Not enough bytes to send a proper message.
 
   for (uint16_t r = 0; r <= repeat; r++) {
-    // Command Block #1 (4 bytes)
-    sendGeneric(kKelvinatorHdrMark, kKelvinatorHdrSpace, kKelvinatorBitMark,
-                kKelvinatorOneSpace, kKelvinatorBitMark, kKelvinatorZeroSpace,
-                0, 0,  // No Footer yet.
-                data, 4, 38, false, 0, 50);
-    // Send Footer for the command block (3 bits (b010))
-    sendGeneric(0, 0,  // No Header
-                kKelvinatorBitMark, kKelvinatorOneSpace, kKelvinatorBitMark,
-                kKelvinatorZeroSpace, kKelvinatorBitMark, kKelvinatorGapSpace,
-                kKelvinatorCmdFooter, kKelvinatorCmdFooterBits, 38, false, 0,
-                50);
-    // Data Block #1 (4 bytes)
-    sendGeneric(0, 0,  // No header
-                kKelvinatorBitMark, kKelvinatorOneSpace, kKelvinatorBitMark,
-                kKelvinatorZeroSpace, kKelvinatorBitMark,
-                kKelvinatorGapSpace * 2, data + 4, 4, 38, false, 0, 50);
-    // Command Block #2 (4 bytes)
-    sendGeneric(kKelvinatorHdrMark, kKelvinatorHdrSpace, kKelvinatorBitMark,
-                kKelvinatorOneSpace, kKelvinatorBitMark, kKelvinatorZeroSpace,
-                0, 0,  // No Footer yet.
-                data + 8, 4, 38, false, 0, 50);
-    // Send Footer for the command block (3 bits (B010))
-    sendGeneric(0, 0,  // No Header
-                kKelvinatorBitMark, kKelvinatorOneSpace, kKelvinatorBitMark,
-                kKelvinatorZeroSpace, kKelvinatorBitMark, kKelvinatorGapSpace,
-                kKelvinatorCmdFooter, kKelvinatorCmdFooterBits, 38, false, 0,
-                50);
-    // Data Block #2 (4 bytes)
-    sendGeneric(0, 0,  // No header
-                kKelvinatorBitMark, kKelvinatorOneSpace, kKelvinatorBitMark,
-                kKelvinatorZeroSpace, kKelvinatorBitMark,
-                kKelvinatorGapSpace * 2, data + 12, 4, 38, false, 0, 50);
+    // Command Block #1 + Data Block #1 (8 bytes)
+    sendGreeFrame(&kKelvinatorFrame, data, kGreeStateLength);
+    // Command Block #2 + Data Block #2 (8 bytes)
+    sendGreeFrame(&kKelvinatorFrame, data + kGreeStateLength,
+                  kGreeStateLength);
   }
 }
 #endif  // SEND_KELVINATOR
@@ -173,12 +139,13 @@ void IRKelvinatorAC::setRaw(const uint8_t new_code[]) {
 /// @note Many Bothans died to bring us this information.
 uint8_t IRKelvinatorAC::calcBlockChecksum(const uint8_t *block,
                                           const uint16_t length) {
-  uint8_t sum = kKelvinatorChecksumStart;
-  // Sum the lower half of the first 4 bytes of this block.
-  for (uint8_t i = 0; i < 4 && i < length - 1; i++, block++)
-    sum += (*block & 0b1111);
+  // The last byte of the block holds the checksum, so skip it.
+  const uint16_t used = length ? length - 1 : 0;
+  const uint16_t low = std::min(used, (uint16_t)4);
+  // Sum the lower half of the first 4 bytes of this block,
+  uint8_t sum = irutils::sumLowNibbles(block, low, kKelvinatorChecksumStart);
   // then sum the upper half of the next 3 bytes.
-  for (uint8_t i = 4; i < length - 1; i++, block++) sum += (*block >> 4);
+  sum = irutils::sumHighNibbles(block + low, used - low, sum);
   // Trim it down to fit into the 4 bits allowed. i.e. Mod 16.
   return sum & 0b1111;
 }
@@ -459,20 +426,20 @@ stdAc::state_t IRKelvinatorAC::toCommon(void) {
 String IRKelvinatorAC::toString(void) {
   String result = "";
   result.reserve(160);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kKelvinatorAuto, kKelvinatorCool,
-                            kKelvinatorHeat, kKelvinatorDry, kKelvinatorFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kKelvinatorFanMax, kKelvinatorFanMin,
-                           kKelvinatorFanAuto, kKelvinatorFanAuto,
-                           kKelvinatorBasicFanMax);
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getXFan(), kXFanStr);
-  result += addBoolToString(getIonFilter(), kIonStr);
-  result += addBoolToString(getLight(), kLightStr);
-  result += addBoolToString(getSwingHorizontal(), kSwingHStr);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kKelvinatorAuto, kKelvinatorCool,
+                  kKelvinatorHeat, kKelvinatorDry, kKelvinatorFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kKelvinatorFanMax, kKelvinatorFanMin,
+                 kKelvinatorFanAuto, kKelvinatorFanAuto,
+                 kKelvinatorBasicFanMax);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getXFan(), kXFanStr);
+  addBoolToString(&result, getIonFilter(), kIonStr);
+  addBoolToString(&result, getLight(), kLightStr);
+  addBoolToString(&result, getSwingHorizontal(), kSwingHStr);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
   return result;
 }
 
@@ -488,68 +455,9 @@ String IRKelvinatorAC::toString(void) {
 /// @return A boolean. True if it can decode it, false if it can't.
 bool IRrecv::decodeKelvinator(decode_results *results, uint16_t offset,
                               const uint16_t nbits, const bool strict) {
-  if (results->rawlen <=
-      2 * (nbits + kKelvinatorCmdFooterBits) + (kHeader + kFooter + 1) * 2 - 1 +
-      offset)
-    return false;  // Can't possibly be a valid Kelvinator message.
   if (strict && nbits != kKelvinatorBits)
     return false;  // Not strictly a Kelvinator message.
-
-  // There are two messages back-to-back in a full Kelvinator IR message
-  // sequence.
-  int8_t pos = 0;
-  for (uint8_t s = 0; s < 2; s++) {
-    match_result_t data_result;
-
-    uint16_t used;
-    // Header + Data Block #1 (32 bits)
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, 32,
-                        kKelvinatorHdrMark, kKelvinatorHdrSpace,
-                        kKelvinatorBitMark, kKelvinatorOneSpace,
-                        kKelvinatorBitMark, kKelvinatorZeroSpace,
-                        0, 0, false,
-                        _tolerance, kMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += 4;
-
-    // Command data footer (3 bits, B010)
-    data_result = matchData(
-        &(results->rawbuf[offset]), kKelvinatorCmdFooterBits,
-        kKelvinatorBitMark, kKelvinatorOneSpace,
-        kKelvinatorBitMark, kKelvinatorZeroSpace,
-        _tolerance, kMarkExcess, false);
-    if (data_result.success == false) return false;
-    if (data_result.data != kKelvinatorCmdFooter) return false;
-    offset += data_result.used;
-
-    // Gap + Data (Options) (32 bits)
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, 32,
-                        kKelvinatorBitMark, kKelvinatorGapSpace,
-                        kKelvinatorBitMark, kKelvinatorOneSpace,
-                        kKelvinatorBitMark, kKelvinatorZeroSpace,
-                        kKelvinatorBitMark, kKelvinatorGapSpace * 2,
-                        s > 0,
-                        _tolerance, kMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += 4;
-  }
-
-  // Compliance
-  if (strict) {
-    // Verify the message's checksum is correct.
-    if (!IRKelvinatorAC::validChecksum(results->state)) return false;
-  }
-
-  // Success
-  results->decode_type = decode_type_t::KELVINATOR;
-  results->bits = nbits;
-  // No need to record the state as we stored it as we decoded it.
-  // As we use result->state, we don't record value, address, or command as it
-  // is a union data type.
-  return true;
+  // It shares its frames with Gree, so it is decoded by the same code.
+  return decodeGreeFamily(results, offset, false, true, strict);
 }
 #endif  // DECODE_KELVINATOR
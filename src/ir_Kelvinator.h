@@ -30,6 +30,26 @@
 #endif
 
 // Constants
+const uint16_t kKelvinatorTick = 85;
+const uint16_t kKelvinatorHdrMarkTicks = 106;
+const uint16_t kKelvinatorHdrMark = kKelvinatorHdrMarkTicks * kKelvinatorTick;
+const uint16_t kKelvinatorHdrSpaceTicks = 53;
+const uint16_t kKelvinatorHdrSpace = kKelvinatorHdrSpaceTicks * kKelvinatorTick;
+const uint16_t kKelvinatorBitMarkTicks = 8;
+const uint16_t kKelvinatorBitMark = kKelvinatorBitMarkTicks * kKelvinatorTick;
+const uint16_t kKelvinatorOneSpaceTicks = 18;
+const uint16_t kKelvinatorOneSpace = kKelvinatorOneSpaceTicks * kKelvinatorTick;
+const uint16_t kKelvinatorZeroSpaceTicks = 6;
+const uint16_t kKelvinatorZeroSpace =
+    kKelvinatorZeroSpaceTicks * kKelvinatorTick;
+const uint16_t kKelvinatorGapSpaceTicks = 235;
+const uint16_t kKelvinatorGapSpace = kKelvinatorGapSpaceTicks * kKelvinatorTick;
+/// A Kelvinator message is two Gree style frames. See `gree_frame_t`.
+const gree_frame_t kKelvinatorFrame = {
+    kKelvinatorHdrMark, kKelvinatorHdrSpace, kKelvinatorBitMark,
+    kKelvinatorOneSpace, kKelvinatorZeroSpace,
+    kKelvinatorGapSpace, kKelvinatorGapSpace * 2};
+
 const uint8_t kKelvinatorAuto = 0;
 const uint8_t kKelvinatorCool = 1;
 const uint8_t kKelvinatorDry = 2;
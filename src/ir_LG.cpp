@@ -523,14 +523,14 @@ stdAc::state_t IRLgAc::toCommon(void) {
 String IRLgAc::toString(void) {
   String result = "";
   result.reserve(80);  // Reserve some heap for the string to reduce fragging.
-  result += addModelToString(_protocol, getModel(), false);
-  result += addBoolToString(getPower(), kPowerStr);
+  addModelToString(&result, _protocol, getModel(), false);
+  addBoolToString(&result, getPower(), kPowerStr);
   if (getPower()) {  // Only display the rest if is in power on state.
-    result += addModeToString(getMode(), kLgAcAuto, kLgAcCool,
-                              kLgAcHeat, kLgAcDry, kLgAcFan);
-    result += addTempToString(getTemp());
-    result += addFanToString(getFan(), kLgAcFanHigh, kLgAcFanLow,
-                             kLgAcFanAuto, kLgAcFanLowest, kLgAcFanMedium);
+    addModeToString(&result, getMode(), kLgAcAuto, kLgAcCool,
+                    kLgAcHeat, kLgAcDry, kLgAcFan);
+    addTempToString(&result, getTemp());
+    addFanToString(&result, getFan(), kLgAcFanHigh, kLgAcFanLow,
+                   kLgAcFanAuto, kLgAcFanLowest, kLgAcFanMedium);
   }
   return result;
 }
@@ -77,17 +77,15 @@ bool IRrecv::decodeLasertag(decode_results *results, uint16_t offset,
   uint16_t used = 0;
   uint64_t data = 0;
   uint16_t actual_bits = 0;
+  const rc_windows_t windows = _rcWindows(kLasertagTick, kLasertagTolerance,
+                                          kLasertagExcess, kLasertagDelta);
 
   // No Header
 
   // Data
   for (; offset <= results->rawlen; actual_bits++) {
-    int16_t levelA =
-        getRClevel(results, &offset, &used, kLasertagTick, kLasertagTolerance,
-                   kLasertagExcess, kLasertagDelta);
-    int16_t levelB =
-        getRClevel(results, &offset, &used, kLasertagTick, kLasertagTolerance,
-                   kLasertagExcess, kLasertagDelta);
+    int16_t levelA = getRClevel(results, &offset, &used, &windows);
+    int16_t levelB = getRClevel(results, &offset, &used, &windows);
     if (levelA == kSpace && levelB == kMark) {
       data = (data << 1) | 1;  // 1
     } else {
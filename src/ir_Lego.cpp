@@ -11,9 +11,20 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
+#if defined(ESP32) && !defined(UNIT_TEST)
+// Updates can be given to an IRLegoPfScheduler from any task.
+static portMUX_TYPE legopf_mux = portMUX_INITIALIZER_UNLOCKED;
+#define LEGOPF_LOCK() portENTER_CRITICAL(&legopf_mux)
+#define LEGOPF_UNLOCK() portEXIT_CRITICAL(&legopf_mux)
+#else  // defined(ESP32) && !defined(UNIT_TEST)
+#define LEGOPF_LOCK()
+#define LEGOPF_UNLOCK()
+#endif  // defined(ESP32) && !defined(UNIT_TEST)
+
 
 // Constants
 const uint16_t kLegoPfBitMark = 158;
@@ -22,6 +33,9 @@ const uint16_t kLegoPfZeroSpace = 263;
 const uint16_t kLegoPfOneSpace = 553;
 const uint32_t kLegoPfMinCommandLength = 16000;  // 16ms
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchLegoPfBitMark == kLegoPfBitMark, "See IRrecvTimings.h");
+
 
 #if SEND_LEGOPF
 /// Send a LEGO Power Functions message.
@@ -36,6 +50,7 @@ void IRsend::sendLegoPf(const uint64_t data, const uint16_t nbits,
   if (repeat) {
     // We are in repeat mode.
     // Spec says a pause before transmittion.
+    enableIROut(38000, kDutyDefault);
     if (channelid < 4) space((4 - channelid) * kLegoPfMinCommandLength);
     // Spec says there are a minimum of 5 message repeats.
     for (uint16_t r = 0; r < std::max(repeat, (uint16_t)5); r++) {
@@ -57,6 +72,139 @@ void IRsend::sendLegoPf(const uint64_t data, const uint16_t nbits,
                 data, nbits, 38000, true, 0, kDutyDefault);
   }
 }
+
+/// Constructor for an IRLegoPfScheduler object.
+/// @param[in] irsend The IRsend object to send the messages with. It should
+///   already have had `begin()` called.
+IRLegoPfScheduler::IRLegoPfScheduler(IRsend *irsend) {
+  _irsend = irsend;
+  _order = 0;
+  _next = 0;
+  _waiting = 0;
+  clear();
+}
+
+/// Get the channel a LEGO PF message is for.
+/// @param[in] data The message.
+/// @return The channel, counting from 0. i.e. 0-3 is channel 1-4.
+uint8_t IRLegoPfScheduler::getChannel(const uint16_t data) {
+  return (data >> 12) & 0b11;
+}
+
+/// Get which output(s) a LEGO PF message is for, as a slot of its channel.
+/// @param[in] data The message.
+/// @return 0 for output A, 1 for output B, or 2 for both. Only the Single
+///   Output modes are for a single output.
+uint8_t IRLegoPfScheduler::getOutputSlot(const uint16_t data) {
+  const bool escape = (data >> 14) & 1;
+  const bool single = (data >> 10) & 1;  // Mode: 1xO
+  if (!escape && single) return (data >> 8) & 1;  // The O bit.
+  return 2;
+}
+
+/// Set the latest command for a channel & output(s). It replaces any previous
+/// one of them that is still waiting to be sent.
+/// @param[in] data The LEGO PF message. e.g. A Combo PWM command.
+/// @param[in] copies Nr. of times to send it, taking turns with other channels.
+///   The spec. suggests 5 for reliability, at the cost of fewer updates.
+/// @return true, if it replaced a pending command. Otherwise false.
+/// @note A command for both outputs also replaces pending ones for each output,
+///   as it sets them both anyway.
+bool IRLegoPfScheduler::update(const uint16_t data, const uint8_t copies) {
+  if (!copies) return false;
+  const uint8_t channel = getChannel(data);
+  const uint8_t slot = getOutputSlot(data);
+  legopf_update_t *updates = _updates[channel];
+  LEGOPF_LOCK();
+  bool replaced = updates[slot].copies > 0;
+  if (slot == 2) {  // Both outputs.
+    for (uint8_t i = 0; i < slot; i++) {
+      replaced |= updates[i].copies > 0;
+      updates[i].copies = 0;
+    }
+  }
+  updates[slot].data = data;
+  updates[slot].copies = copies;
+  updates[slot].order = _order++;
+  LEGOPF_UNLOCK();
+  return replaced;
+}
+
+/// Send the next pending command, if the previous message has been sent, &
+/// its channel's last message was at least 5 message slots
+/// (`kLegoPfMinCommandLength`) ago. The channels with pending commands take
+/// turns. Each message is followed by a pause of at least one message slot.
+/// Call it often. e.g. From `loop()`.
+/// @return true, if a message was sent (or started). Otherwise false.
+/// @note If `IRsend::enableRmtSend()` (or `enableTimerSend()`) is in use, the
+///   message is sent in the background, & this returns at once. Otherwise it
+///   returns once the message & the pause after it are over.
+bool IRLegoPfScheduler::handle(void) {
+  if (_irsend == NULL) return false;
+#if IRSEND_ASYNC
+  if (_irsend->isBusy()) return false;
+#endif  // IRSEND_ASYNC
+  legopf_update_t *next = NULL;
+  uint16_t data = 0;
+  LEGOPF_LOCK();
+  for (uint8_t i = 0; i < kLegoPfChannels && next == NULL; i++) {
+    const uint8_t channel = (_next + i) % kLegoPfChannels;
+    // A channel can only send once every 5 message slots.
+    if (_waiting & (1 << channel)) {
+      if (_started[channel].elapsed() < 5 * kLegoPfMinCommandLength) continue;
+      _waiting &= ~(1 << channel);
+    }
+    for (uint8_t slot = 0; slot < kLegoPfUpdateSlots; slot++) {
+      legopf_update_t *update = &_updates[channel][slot];
+      if (update->copies && (next == NULL ||
+                             (int32_t)(update->order - next->order) < 0))
+        next = update;
+    }
+    if (next != NULL) {
+      data = next->data;
+      next->copies--;
+      _next = (channel + 1) % kLegoPfChannels;
+      _started[channel].reset();
+      _waiting |= 1 << channel;
+    }
+  }
+  LEGOPF_UNLOCK();
+  if (next == NULL) return false;
+
+#if IRSEND_ASYNC
+  const bool async = _irsend->beginAsync();
+#endif  // IRSEND_ASYNC
+  _irsend->sendGeneric(kLegoPfBitMark, kLegoPfHdrSpace,
+                       kLegoPfBitMark, kLegoPfOneSpace,
+                       kLegoPfBitMark, kLegoPfZeroSpace,
+                       kLegoPfBitMark, kLegoPfMinCommandLength,
+                       data, kLegoPfBits, 38000, true, 0, kDutyDefault);
+#if IRSEND_ASYNC
+  if (async) _irsend->sendAsync();
+#endif  // IRSEND_ASYNC
+  return true;
+}
+
+/// Get the nr. of commands waiting to be sent.
+/// @return The nr. of commands. Each is counted once, whatever its copies.
+uint8_t IRLegoPfScheduler::pending(void) {
+  uint8_t count = 0;
+  LEGOPF_LOCK();
+  for (uint8_t channel = 0; channel < kLegoPfChannels; channel++)
+    for (uint8_t slot = 0; slot < kLegoPfUpdateSlots; slot++)
+      if (_updates[channel][slot].copies) count++;
+  LEGOPF_UNLOCK();
+  return count;
+}
+
+/// Discard all of the commands waiting to be sent.
+void IRLegoPfScheduler::clear(void) {
+  LEGOPF_LOCK();
+  for (uint8_t channel = 0; channel < kLegoPfChannels; channel++)
+    for (uint8_t slot = 0; slot < kLegoPfUpdateSlots; slot++)
+      _updates[channel][slot].copies = 0;
+  LEGOPF_UNLOCK();
+}
 #endif  // SEND_LEGO
 
 #if DECODE_LEGOPF
@@ -92,6 +92,8 @@ bool IRrecv::decodeMWM(decode_results *results, uint16_t offset,
   uint64_t data = 0;
   uint16_t frame_bits = 0;
   uint16_t data_bits = 0;
+  const rc_windows_t windows = _rcWindows(kMWMTick, kMWMTolerance, kMWMExcess,
+                                          kMWMDelta, kMWMMaxWidth);
 
   // No Header
 
@@ -101,8 +103,7 @@ bool IRrecv::decodeMWM(decode_results *results, uint16_t offset,
        frame_bits++) {
     DPRINT("DEBUG: decodeMWM: offset = ");
     DPRINTLN(offset);
-    int16_t level = getRClevel(results, &offset, &used, kMWMTick, kMWMTolerance,
-                               kMWMExcess, kMWMDelta, kMWMMaxWidth);
+    int16_t level = getRClevel(results, &offset, &used, &windows);
     if (level < 0) {
       DPRINTLN("DEBUG: decodeMWM: getRClevel returned error");
       break;
@@ -10,6 +10,7 @@
 //   Brand: Metz,  Model: CH610 TV
 
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -23,6 +24,9 @@ const uint16_t kMetzFreq = 38000;     ///< Hz.
 const uint8_t kMetzAddressBits = 3;
 const uint8_t kMetzCommandBits = 6;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchMetzHdrMark == kMetzHdrMark, "See IRrecvTimings.h");
+
 #if SEND_METZ
 /// Send a Metz formatted message.
 /// Status: Beta / Needs testing against a real device.
@@ -14,6 +14,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -36,12 +37,17 @@ const uint16_t kMideaMinGap = kMideaMinGapTicks * kMideaTick;
 const uint8_t kMideaTolerance = 30;  // Percent
 const uint16_t kMidea24MinGap = 13000;  ///< uSecs
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchMideaHdrMark == kMideaHdrMark, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
 using irutils::addModeToString;
 using irutils::addTempToString;
+using irutils::checkInvertedBytePairs;
+using irutils::dropInvertedBytes;
 
 #if SEND_MIDEA
 /// Send a Midea message
@@ -55,31 +61,52 @@ void IRsend::sendMidea(uint64_t data, uint16_t nbits, uint16_t repeat) {
   // Set IR carrier frequency
   enableIROut(38);
 
-  for (uint16_t r = 0; r <= repeat; r++) {
-    // The protocol sends the message, then follows up with an entirely
-    // inverted payload.
-    for (size_t inner_loop = 0; inner_loop < 2; inner_loop++) {
-      // Header
-      mark(kMideaHdrMark);
-      space(kMideaHdrSpace);
-      // Data
-      //   Break data into byte segments, starting at the Most Significant
-      //   Byte. Each byte then being sent normal, then followed inverted.
-      for (uint16_t i = 8; i <= nbits; i += 8) {
-        // Grab a bytes worth of data.
-        uint8_t segment = (data >> (nbits - i)) & 0xFF;
-        sendData(kMideaBitMark, kMideaOneSpace, kMideaBitMark, kMideaZeroSpace,
-                 segment, 8, true);
-      }
-      // Footer
-      mark(kMideaBitMark);
-      space(kMideaMinGap);  // Pause before repeating
-
-      // Invert the data for the 2nd phase of the message.
-      // As we get called twice in the inner loop, we will always revert
-      // to the original 'data' state.
-      data = ~data;
+  for (uint16_t r = 0; r <= repeat; r++) _sendMideaFrame(data, nbits);
+}
+
+/// Send a sequence of Midea messages as one burst. e.g. The state followed by
+/// some special toggle commands.
+/// Each message follows the previous one after only the protocol's minimum
+/// gap.
+/// Status: Alpha / Needs testing against a real device.
+/// @param[in] codes The (48 bit) messages to be sent, in order.
+/// @param[in] ncodes The nr. of messages in `codes`.
+/// @param[in] repeat The number of times each message is to be repeated.
+void IRsend::sendMideaSequence(const uint64_t codes[], const uint16_t ncodes,
+                               const uint16_t repeat) {
+  if (!ncodes) return;
+  // Set IR carrier frequency
+  enableIROut(38);
+
+  for (uint16_t i = 0; i < ncodes; i++)
+    for (uint16_t r = 0; r <= repeat; r++)
+      _sendMideaFrame(codes[i], kMideaBits);
+}
+
+/// Send a single Midea message. i.e. The data, then an inverted copy of it.
+/// @param[in] data The message to be sent.
+/// @param[in] nbits The number of bits of message to be sent.
+/// @note The carrier frequency needs to be set up first.
+void IRsend::_sendMideaFrame(const uint64_t data, const uint16_t nbits) {
+  // The protocol sends the message, then follows up with an entirely
+  // inverted payload.
+  for (uint8_t copy = 0; copy < 2; copy++) {
+    const uint64_t payload = copy ? ~data : data;
+    // Header
+    mark(kMideaHdrMark);
+    space(kMideaHdrSpace);
+    // Data
+    //   Break data into byte segments, starting at the Most Significant
+    //   Byte.
+    for (uint16_t i = 8; i <= nbits; i += 8) {
+      // Grab a bytes worth of data.
+      uint8_t segment = (payload >> (nbits - i)) & 0xFF;
+      sendData(kMideaBitMark, kMideaOneSpace, kMideaBitMark, kMideaZeroSpace,
+               segment, 8, true);
     }
+    // Footer
+    mark(kMideaBitMark);
+    space(kMideaMinGap);  // Pause before repeating
   }
 }
 #endif  // SEND_MIDEA
@@ -109,12 +136,16 @@ void IRMideaAC::begin(void) { _irsend.begin(); }
 /// Send the current internal state as an IR message.
 /// @param[in] repeat Nr. of times the message will be repeated.
 void IRMideaAC::send(const uint16_t repeat) {
-  _irsend.sendMidea(getRaw(), kMideaBits, repeat);
+  uint64_t codes[3];
+  uint16_t ncodes = 0;
+  codes[ncodes++] = getRaw();
   // Handle toggling the swing & econo mode if we need to.
   if (_SwingVToggle && !isSwingVToggle())
-    _irsend.sendMidea(kMideaACToggleSwingV, kMideaBits, repeat);
+    codes[ncodes++] = kMideaACToggleSwingV;
   if (_EconoToggle && !isEconoToggle())
-    _irsend.sendMidea(kMideaACToggleEcono, kMideaBits, repeat);
+    codes[ncodes++] = kMideaACToggleEcono;
+  // Send them all as one burst.
+  _irsend.sendMideaSequence(codes, ncodes, repeat);
   // The toggle messages has been sent, so reset.
   _SwingVToggle = false;
   _EconoToggle = false;
@@ -178,9 +209,11 @@ void IRMideaAC::setTemp(const uint8_t temp, const bool useCelsius) {
   }
   uint8_t new_temp = std::min(max_temp, std::max(min_temp, temp));
   if (!_.useFahrenheit && !useCelsius)  // Native is in C, new_temp is in F
-    new_temp = fahrenheitToCelsius(new_temp) - kMideaACMinTempC;
+    new_temp = (fahrenheitToCelsiusTenths(new_temp * 10) -
+                kMideaACMinTempC * 10) / 10;
   else if (_.useFahrenheit && useCelsius)  // Native is in F, new_temp is in C
-    new_temp = celsiusToFahrenheit(new_temp) - kMideaACMinTempF;
+    new_temp = (celsiusToFahrenheitTenths(new_temp * 10) -
+                kMideaACMinTempF * 10) / 10;
   else  // Native and desired are the same units.
     new_temp -= min_temp;
   // Set the actual data.
@@ -196,8 +229,11 @@ uint8_t IRMideaAC::getTemp(const bool celsius) const {
     temp += kMideaACMinTempC;
   else
     temp += kMideaACMinTempF;
-  if (celsius && _.useFahrenheit) temp = fahrenheitToCelsius(temp) + 0.5;
-  if (!celsius && !_.useFahrenheit) temp = celsiusToFahrenheit(temp);
+  // Fixed-point (tenths of a degree) conversions. No FPU on the ESP8266.
+  if (celsius && _.useFahrenheit)
+    temp = (fahrenheitToCelsiusTenths(temp * 10) + 5) / 10;
+  if (!celsius && !_.useFahrenheit)
+    temp = celsiusToFahrenheitTenths(temp * 10) / 10;
   return temp;
 }
 
@@ -409,21 +445,21 @@ String IRMideaAC::toString(void) {
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
   bool needComma = false;
   if (!isSwingVToggle() && !isEconoToggle()) {
-    result += addBoolToString(_.Power, kPowerStr, false);
-    result += addModeToString(_.Mode, kMideaACAuto, kMideaACCool,
-                              kMideaACHeat, kMideaACDry, kMideaACFan);
-    result += addBoolToString(!_.useFahrenheit, kCelsiusStr);
-    result += addTempToString(getTemp(true));
+    addBoolToString(&result, _.Power, kPowerStr, false);
+    addModeToString(&result, _.Mode, kMideaACAuto, kMideaACCool,
+                    kMideaACHeat, kMideaACDry, kMideaACFan);
+    addBoolToString(&result, !_.useFahrenheit, kCelsiusStr);
+    addTempToString(&result, getTemp(true));
     result += '/';
     result += uint64ToString(getTemp(false));
     result += 'F';
-    result += addFanToString(_.Fan, kMideaACFanHigh, kMideaACFanLow,
-                             kMideaACFanAuto, kMideaACFanAuto, kMideaACFanMed);
-    result += addBoolToString(_.Sleep, kSleepStr);
+    addFanToString(&result, _.Fan, kMideaACFanHigh, kMideaACFanLow,
+                   kMideaACFanAuto, kMideaACFanAuto, kMideaACFanMed);
+    addBoolToString(&result, _.Sleep, kSleepStr);
     needComma = true;
   }
-  result += addBoolToString(getSwingVToggle(), kSwingVToggleStr, needComma);
-  result += addBoolToString(getEconoToggle(), kEconoToggleStr);
+  addBoolToString(&result, getSwingVToggle(), kSwingVToggleStr, needComma);
+  addBoolToString(&result, getEconoToggle(), kEconoToggleStr);
   return result;
 }
 
@@ -475,8 +511,9 @@ bool IRrecv::decodeMidea(decode_results *results, uint16_t offset,
     // Protocol requires a second message with all the data bits inverted.
     // We should have checked we got a second message in the previous loop.
     // Just need to check it's value is an inverted copy of the first message.
-    uint64_t mask = (1ULL << kMideaBits) - 1;
-    if ((data & mask) != ((inverted ^ mask) & mask)) return false;
+    // i.e. Every bit of the two copies differs, checked all at once.
+    const uint64_t mask = (1ULL << kMideaBits) - 1;
+    if (((data ^ inverted) & mask) != mask) return false;
     if (!IRMideaAC::validChecksum(data)) return false;
   }
 
@@ -542,25 +579,13 @@ bool IRrecv::decodeMidea24(decode_results *results, uint16_t offset,
                     kNecBitMark, kNecZeroSpace,
                     kNecBitMark, kMidea24MinGap, true)) return false;
 
-  // Build the result by checking every second byte is a complement(inversion)
-  // of the previous one.
-  uint32_t data = 0;
-  for (uint8_t i = nbits * 2; i >= 16;) {
-    // Shuffle the data collected so far.
-    data <<= 8;
-    i -= 8;
-    uint8_t current = GETBITS64(longdata, i, 8);
-    i -= 8;
-    uint8_t next = GETBITS64(longdata, i, 8);
-    // Check they are an inverted pair.
-    if (current != (next ^ 0xFF)) return false;  // They are not, so abort.
-    data |= current;
-  }
+  // Check every second byte is a complement(inversion) of the previous one.
+  if (!checkInvertedBytePairs(longdata, nbits * 2)) return false;
 
   // Success
   results->decode_type = decode_type_t::MIDEA24;
   results->bits = nbits;
-  results->value = data;
+  results->value = dropInvertedBytes(longdata, nbits * 2);
   results->address = 0;
   results->command = 0;
   return true;
@@ -23,6 +23,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -62,6 +63,15 @@ const uint16_t kMitsubishiAcZeroSpace = 420;
 const uint16_t kMitsubishiAcRptMark = 440;
 const uint16_t kMitsubishiAcRptSpace = 17100;
 const uint8_t  kMitsubishiAcExtraTolerance = 5;
+// The layout of the fields in the IRMitsubishiAC state.
+typedef irutils::StateBits<6, kMitsubishiAcModeOffset, kModeBitsSize>
+    MitsubishiAcMode;
+typedef irutils::StateBits<8, kHighNibble, kNibbleSize> MitsubishiAcWideVane;
+typedef irutils::StateBits<9, kMitsubishiAcFanOffset, kMitsubishiAcFanSize>
+    MitsubishiAcFan;
+typedef irutils::StateBits<9, kMitsubishiAcVaneOffset, kMitsubishiAcVaneSize>
+    MitsubishiAcVane;
+typedef irutils::StateBits<13, 0, 3> MitsubishiAcTimer;
 
 // Mitsubishi 136 bit A/C
 const uint16_t kMitsubishi136HdrMark = 3324;
@@ -71,6 +81,35 @@ const uint16_t kMitsubishi136OneSpace = 1137;
 const uint16_t kMitsubishi136ZeroSpace = 351;
 const uint32_t kMitsubishi136Gap = kDefaultMessageGap;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchMitsubishi136HdrMark == kMitsubishi136HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchMitsubishi2HdrMark == kMitsubishi2HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapMitsubishiAcHdrMark == kMitsubishiAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapMitsubishiAcHdrSpace == kMitsubishiAcHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapMitsubishiAcRptSpace == kMitsubishiAcRptSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapMitsubishi2HdrMark == kMitsubishi2HdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapMitsubishi2HdrSpace == kMitsubishi2HdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapMitsubishi2MinGap == kMitsubishi2MinGap,
+              "See IRrecvTimings.h");
+
+#if (DECODE_MITSUBISHI136 || DECODE_MITSUBISHI112 || DECODE_TCL112AC)
+/// The signature the MITSUBISHI136, MITSUBISHI112 & TCL112AC messages start
+/// with. i.e. 0x23CB26
+const irutils::fixed_byte_t kMitsubishiSignature[] = {
+    {0, 0xFF, 0x23}, {1, 0xFF, 0xCB}, {2, 0xFF, 0x26}};
+/// What is verified of them as they are matched. The rest of the message
+/// isn't matched at all, if it doesn't start with the signature.
+const byte_checks_t kMitsubishiSignatureChecks = {NULL, 0,
+                                                  kMitsubishiSignature, 3};
+#endif  // (DECODE_MITSUBISHI136 || DECODE_MITSUBISHI112 || DECODE_TCL112AC)
+
 // Mitsubishi 112 bit A/C
 const uint16_t kMitsubishi112HdrMark = 3450;
 const uint16_t kMitsubishi112HdrSpace = 1696;
@@ -349,20 +388,19 @@ bool IRrecv::decodeMitsubishiAC(decode_results *results, uint16_t offset,
         DPRINTLN("Repeat header error.");
         return false;
       }
-      // Payload:
-      for (uint8_t i = 0; i < kMitsubishiACStateLength; i++) {
-        data_result =
-            matchData(&(results->rawbuf[offset]), 8, kMitsubishiAcBitMark,
-                      kMitsubishiAcOneSpace, kMitsubishiAcBitMark,
-                      kMitsubishiAcZeroSpace,
-                      _tolerance + kMitsubishiAcExtraTolerance, 0, false);
-        if (data_result.success == false ||
-            data_result.data != results->state[i]) {
-          DPRINTLN("Repeat payload error.");
-          return false;
-        }
-        offset += data_result.used;
+      // Payload: It must be exactly the same as the first copy.
+      const uint16_t used = matchRepeat(
+          results->rawbuf + offset, results->state, results->rawlen - offset,
+          kMitsubishiACBits, 0, 0,  // No header. It was matched above.
+          kMitsubishiAcBitMark, kMitsubishiAcOneSpace,
+          kMitsubishiAcBitMark, kMitsubishiAcZeroSpace,
+          0, 0,  // No footer.
+          false, _tolerance + kMitsubishiAcExtraTolerance, 0, false);
+      if (!used) {
+        DPRINTLN("Repeat payload error.");
+        return false;
       }
+      offset += used;
     }  // strict repeat check
   } while (failure && rep <= kMitsubishiACMinRepeat);
   results->decode_type = MITSUBISHI_AC;
@@ -481,14 +519,13 @@ void IRMitsubishiAC::setFan(const uint8_t speed) {
          fan == kMitsubishiAcFanAuto);
   if (fan >= kMitsubishiAcFanMax)
     fan--;  // There is no spoon^H^H^Heed 5 (max), pretend it doesn't exist.
-  setBits(&remote_state[9], kMitsubishiAcFanOffset, kMitsubishiAcFanSize, fan);
+  MitsubishiAcFan::set(remote_state, fan);
 }
 
 /// Get the current fan speed setting.
 /// @return The current fan speed/mode.
 uint8_t IRMitsubishiAC::getFan(void) {
-  uint8_t fan = GETBITS8(remote_state[9], kMitsubishiAcFanOffset,
-                         kMitsubishiAcFanSize);
+  uint8_t fan = MitsubishiAcFan::get(remote_state);
   if (fan == kMitsubishiAcFanMax) return kMitsubishiAcFanSilent;
   return fan;
 }
@@ -496,7 +533,7 @@ uint8_t IRMitsubishiAC::getFan(void) {
 /// Get the operating mode setting of the A/C.
 /// @return The current operating mode setting.
 uint8_t IRMitsubishiAC::getMode(void) {
-  return GETBITS8(remote_state[6], kMitsubishiAcModeOffset, kModeBitsSize);
+  return MitsubishiAcMode::get(remote_state);
 }
 
 /// Set the operating mode of the A/C.
@@ -512,7 +549,7 @@ void IRMitsubishiAC::setMode(const uint8_t mode) {
       this->setMode(kMitsubishiAcAuto);
       return;
   }
-  setBits(&remote_state[6], kMitsubishiAcModeOffset, kModeBitsSize, mode);
+  MitsubishiAcMode::set(remote_state, mode);
 }
 
 /// Set the requested vane (Vertical Swing) operation mode of the a/c unit.
@@ -520,28 +557,26 @@ void IRMitsubishiAC::setMode(const uint8_t mode) {
 void IRMitsubishiAC::setVane(const uint8_t position) {
   uint8_t pos = std::min(position, kMitsubishiAcVaneAutoMove);  // bounds check
   setBit(&remote_state[9], kMitsubishiAcVaneBitOffset);
-  setBits(&remote_state[9], kMitsubishiAcVaneOffset, kMitsubishiAcVaneSize,
-          pos);
+  MitsubishiAcVane::set(remote_state, pos);
 }
 
 /// Set the requested wide-vane (Horizontal Swing) operation mode of the a/c.
 /// @param[in] position The position/mode to set the wide vane to.
 void IRMitsubishiAC::setWideVane(const uint8_t position) {
-  setBits(&remote_state[8], kHighNibble, kNibbleSize,
-          std::min(position, kMitsubishiAcWideVaneAuto));
+  MitsubishiAcWideVane::set(remote_state,
+                            std::min(position, kMitsubishiAcWideVaneAuto));
 }
 
 /// Get the Vane (Vertical Swing) mode of the A/C.
 /// @return The native position/mode setting.
 uint8_t IRMitsubishiAC::getVane(void) {
-  return GETBITS8(remote_state[9], kMitsubishiAcVaneOffset,
-                  kMitsubishiAcVaneSize);
+  return MitsubishiAcVane::get(remote_state);
 }
 
 /// Get the Wide Vane (Horizontal Swing) mode of the A/C.
 /// @return The native position/mode setting.
 uint8_t IRMitsubishiAC::getWideVane(void) {
-  return GETBITS8(remote_state[8], kHighNibble, kNibbleSize);
+  return MitsubishiAcWideVane::get(remote_state);
 }
 
 /// Get the clock time of the A/C unit.
@@ -586,7 +621,7 @@ void IRMitsubishiAC::setStopClock(const uint8_t clock) {
 ///   kMitsubishiAcStartTimer, kMitsubishiAcStopTimer,
 ///   kMitsubishiAcStartStopTimer
 uint8_t IRMitsubishiAC::getTimer(void) {
-  return GETBITS8(remote_state[13], 0, 3);
+  return MitsubishiAcTimer::get(remote_state);
 }
 
 /// Set the timers active setting of the A/C.
@@ -595,7 +630,7 @@ uint8_t IRMitsubishiAC::getTimer(void) {
 ///   kMitsubishiAcStartTimer, kMitsubishiAcStopTimer,
 ///   kMitsubishiAcStartStopTimer
 void IRMitsubishiAC::setTimer(uint8_t timer) {
-  setBits(&remote_state[13], 0, 3, timer);
+  MitsubishiAcTimer::set(remote_state, timer);
 }
 
 /// Convert a stdAc::opmode_t enum into its native mode.
@@ -742,16 +777,16 @@ stdAc::state_t IRMitsubishiAC::toCommon(void) {
 String IRMitsubishiAC::toString(void) {
   String result = "";
   result.reserve(110);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kMitsubishiAcAuto, kMitsubishiAcCool,
-                            kMitsubishiAcHeat, kMitsubishiAcDry,
-                            kMitsubishiAcAuto);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kMitsubishiAcFanRealMax,
-                           kMitsubishiAcFanRealMax - 3,
-                           kMitsubishiAcFanAuto, kMitsubishiAcFanQuiet,
-                           kMitsubishiAcFanRealMax - 2);
-  result += addIntToString(this->getVane(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kMitsubishiAcAuto, kMitsubishiAcCool,
+                  kMitsubishiAcHeat, kMitsubishiAcDry,
+                  kMitsubishiAcAuto);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kMitsubishiAcFanRealMax,
+                 kMitsubishiAcFanRealMax - 3,
+                 kMitsubishiAcFanAuto, kMitsubishiAcFanQuiet,
+                 kMitsubishiAcFanRealMax - 2);
+  addIntToString(&result, this->getVane(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (this->getVane()) {
     case kMitsubishiAcVaneAuto:
@@ -766,16 +801,16 @@ String IRMitsubishiAC::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(this->getWideVane(), kSwingHStr);
+  addIntToString(&result, this->getWideVane(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (this->getWideVane()) {
     case kMitsubishiAcWideVaneAuto: result += kAutoStr; break;
     default:                        result += kUnknownStr;
   }
   result += ')';
-  result += addLabeledString(minsToString(getClock() * 10), kClockStr);
-  result += addLabeledString(minsToString(getStartClock() * 10), kOnTimerStr);
-  result += addLabeledString(minsToString(getStopClock() * 10), kOffTimerStr);
+  addLabeledString(&result, minsToString(getClock() * 10), kClockStr);
+  addLabeledString(&result, minsToString(getStartClock() * 10), kOnTimerStr);
+  addLabeledString(&result, minsToString(getStopClock() * 10), kOffTimerStr);
   result += kCommaSpaceStr;
   result += kTimerStr;
   result += kColonSpaceStr;
@@ -845,12 +880,10 @@ bool IRrecv::decodeMitsubishi136(decode_results *results, uint16_t offset,
                                kMitsubishi136BitMark, kMitsubishi136OneSpace,
                                kMitsubishi136BitMark, kMitsubishi136ZeroSpace,
                                kMitsubishi136BitMark, kMitsubishi136Gap,
-                               true, _tolerance, 0, false);
+                               true, _tolerance, 0, false,
+                               strict ? &kMitsubishiSignatureChecks : NULL);
   if (!used) return false;
   if (strict) {
-    // Header validation: Codes start with 0x23CB26
-    if (results->state[0] != 0x23 || results->state[1] != 0xCB ||
-        results->state[2] != 0x26) return false;
     if (!IRMitsubishi136::validChecksum(results->state, nbits / 8))
       return false;
   }
@@ -1150,15 +1183,15 @@ stdAc::state_t IRMitsubishi136::toCommon(void) {
 String IRMitsubishi136::toString(void) {
   String result = "";
   result.reserve(80);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kMitsubishi136Auto, kMitsubishi136Cool,
-                            kMitsubishi136Heat, kMitsubishi136Dry,
-                            kMitsubishi136Fan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kMitsubishi136FanMax,
-                           kMitsubishi136FanLow,  kMitsubishi136FanMax,
-                           kMitsubishi136FanQuiet, kMitsubishi136FanMed);
-  result += addIntToString(getSwingV(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kMitsubishi136Auto, kMitsubishi136Cool,
+                  kMitsubishi136Heat, kMitsubishi136Dry,
+                  kMitsubishi136Fan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kMitsubishi136FanMax,
+                 kMitsubishi136FanLow,  kMitsubishi136FanMax,
+                 kMitsubishi136FanQuiet, kMitsubishi136FanMed);
+  addIntToString(&result, getSwingV(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (getSwingV()) {
     case kMitsubishi136SwingVHighest: result += kHighestStr; break;
@@ -1169,7 +1202,7 @@ String IRMitsubishi136::toString(void) {
     default: result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getQuiet(), kQuietStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
   return result;
 }
 
@@ -1262,12 +1295,10 @@ bool IRrecv::decodeMitsubishi112(decode_results *results, uint16_t offset,
                                0,  // Skip the header as we matched it earlier.
                                hdrspace, bitmark, onespace, bitmark, zerospace,
                                bitmark, gap,
-                               true, tolerance, 0, false);
+                               true, tolerance, 0, false,
+                               strict ? &kMitsubishiSignatureChecks : NULL);
   if (!used) return false;
   if (strict) {
-    // Header validation: Codes start with 0x23CB26
-    if (results->state[0] != 0x23 || results->state[1] != 0xCB ||
-        results->state[2] != 0x26) return false;
     // TCL112 and MITSUBISHI112 share the exact same checksum.
     if (!IRTcl112Ac::validChecksum(results->state, nbits / 8)) return false;
   }
@@ -1627,15 +1658,15 @@ stdAc::state_t IRMitsubishi112::toCommon(void) {
 String IRMitsubishi112::toString(void) {
   String result = "";
   result.reserve(80);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kMitsubishi112Auto, kMitsubishi112Cool,
-                            kMitsubishi112Heat, kMitsubishi112Dry,
-                            kMitsubishi112Auto);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kMitsubishi112FanMax,
-                           kMitsubishi112FanLow,  kMitsubishi112FanMax,
-                           kMitsubishi112FanQuiet, kMitsubishi112FanMed);
-  result += addIntToString(getSwingV(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kMitsubishi112Auto, kMitsubishi112Cool,
+                  kMitsubishi112Heat, kMitsubishi112Dry,
+                  kMitsubishi112Auto);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kMitsubishi112FanMax,
+                 kMitsubishi112FanLow,  kMitsubishi112FanMax,
+                 kMitsubishi112FanQuiet, kMitsubishi112FanMed);
+  addIntToString(&result, getSwingV(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (getSwingV()) {
     case kMitsubishi112SwingVHighest: result += kHighestStr; break;
@@ -1647,7 +1678,7 @@ String IRMitsubishi112::toString(void) {
     default:                          result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getSwingH(), kSwingHStr);
+  addIntToString(&result, getSwingH(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (getSwingH()) {
     case kMitsubishi112SwingHLeftMax:  result += kLeftMaxStr; break;
@@ -1660,6 +1691,6 @@ String IRMitsubishi112::toString(void) {
     default:                           result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getQuiet(), kQuietStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
   return result;
 }
@@ -13,6 +13,7 @@
 #include "ir_MitsubishiHeavy.h"
 #include <algorithm>
 #include <cstring>
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -28,6 +29,10 @@ const uint16_t kMitsubishiHeavyOneSpace = 420;
 const uint16_t kMitsubishiHeavyZeroSpace = 1220;
 const uint32_t kMitsubishiHeavyGap = kDefaultMessageGap;  // Just a guess.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchMitsubishiHeavyHdrMark == kMitsubishiHeavyHdrMark,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addIntToString;
 using irutils::addLabeledString;
@@ -489,12 +494,12 @@ stdAc::state_t IRMitsubishiHeavy152Ac::toCommon(void) {
 String IRMitsubishiHeavy152Ac::toString(void) {
   String result = "";
   result.reserve(180);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kMitsubishiHeavyAuto,
-                            kMitsubishiHeavyCool, kMitsubishiHeavyHeat,
-                            kMitsubishiHeavyDry, kMitsubishiHeavyFan);
-  result += addTempToString(getTemp());
-  result += addIntToString(getFan(), kFanStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kMitsubishiHeavyAuto,
+                  kMitsubishiHeavyCool, kMitsubishiHeavyHeat,
+                  kMitsubishiHeavyDry, kMitsubishiHeavyFan);
+  addTempToString(&result, getTemp());
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (this->getFan()) {
     case kMitsubishiHeavy152FanAuto:
@@ -522,7 +527,7 @@ String IRMitsubishiHeavy152Ac::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getSwingVertical(), kSwingVStr);
+  addIntToString(&result, getSwingVertical(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (this->getSwingVertical()) {
     case kMitsubishiHeavy152SwingVAuto:
@@ -550,7 +555,7 @@ String IRMitsubishiHeavy152Ac::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getSwingHorizontal(), kSwingHStr);
+  addIntToString(&result, getSwingHorizontal(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (this->getSwingHorizontal()) {
     case kMitsubishiHeavy152SwingHAuto:
@@ -588,13 +593,13 @@ String IRMitsubishiHeavy152Ac::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getSilent(), kSilentStr);
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getEcono(), kEconoStr);
-  result += addBoolToString(getNight(), kNightStr);
-  result += addBoolToString(getFilter(), kFilterStr);
-  result += addBoolToString(get3D(), k3DStr);
-  result += addBoolToString(getClean(), kCleanStr);
+  addBoolToString(&result, getSilent(), kSilentStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getEcono(), kEconoStr);
+  addBoolToString(&result, getNight(), kNightStr);
+  addBoolToString(&result, getFilter(), kFilterStr);
+  addBoolToString(&result, get3D(), k3DStr);
+  addBoolToString(&result, getClean(), kCleanStr);
   return result;
 }
 
@@ -994,12 +999,12 @@ stdAc::state_t IRMitsubishiHeavy88Ac::toCommon(void) {
 String IRMitsubishiHeavy88Ac::toString(void) {
   String result = "";
   result.reserve(140);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kMitsubishiHeavyAuto,
-                            kMitsubishiHeavyCool, kMitsubishiHeavyHeat,
-                            kMitsubishiHeavyDry, kMitsubishiHeavyFan);
-  result += addTempToString(getTemp());
-  result += addIntToString(getFan(), kFanStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kMitsubishiHeavyAuto,
+                  kMitsubishiHeavyCool, kMitsubishiHeavyHeat,
+                  kMitsubishiHeavyDry, kMitsubishiHeavyFan);
+  addTempToString(&result, getTemp());
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (this->getFan()) {
     case kMitsubishiHeavy88FanAuto:
@@ -1024,7 +1029,7 @@ String IRMitsubishiHeavy88Ac::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getSwingVertical(), kSwingVStr);
+  addIntToString(&result, getSwingVertical(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (this->getSwingVertical()) {
     case kMitsubishiHeavy88SwingVAuto:
@@ -1052,7 +1057,7 @@ String IRMitsubishiHeavy88Ac::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addIntToString(getSwingHorizontal(), kSwingHStr);
+  addIntToString(&result, getSwingHorizontal(), kSwingHStr);
   result += kSpaceLBraceStr;
   switch (this->getSwingHorizontal()) {
     case kMitsubishiHeavy88SwingHAuto:
@@ -1093,10 +1098,10 @@ String IRMitsubishiHeavy88Ac::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getEcono(), kEconoStr);
-  result += addBoolToString(get3D(), k3DStr);
-  result += addBoolToString(getClean(), kCleanStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getEcono(), kEconoStr);
+  addBoolToString(&result, get3D(), k3DStr);
+  addBoolToString(&result, getClean(), kCleanStr);
   return result;
 }
 
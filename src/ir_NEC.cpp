@@ -11,9 +11,17 @@
 #include <stdint.h>
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchNecHdrMark == kNecHdrMark, "See IRrecvTimings.h");
+static_assert(kCoalesceNecHdrMark == kNecHdrMark, "See IRrecvTimings.h");
+static_assert(kCoalesceNecRptSpace == kNecRptSpace, "See IRrecvTimings.h");
+static_assert(kCoalesceNecBitMark == kNecBitMark, "See IRrecvTimings.h");
+static_assert(kCoalesceNecRptLength == kNecRptLength, "See IRrecvTimings.h");
+
 // This protocol is used by a lot of other protocols, hence the long list.
 #if (SEND_NEC || SEND_SHERWOOD || SEND_AIWA_RC_T501 || SEND_SANYO || \
      SEND_MIDEA24)
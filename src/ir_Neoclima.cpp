@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cstring>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -23,6 +24,10 @@ const uint16_t kNeoclimaOneSpace = 1651;
 const uint16_t kNeoclimaZeroSpace = 571;
 const uint32_t kNeoclimaMinGap = kDefaultMessageGap;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchNeoclimaHdrMark == kNeoclimaHdrMark,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -493,24 +498,24 @@ stdAc::state_t IRNeoclimaAc::toCommon(void) {
 String IRNeoclimaAc::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kNeoclimaAuto, kNeoclimaCool,
-                            kNeoclimaHeat, kNeoclimaDry, kNeoclimaFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kNeoclimaFanHigh, kNeoclimaFanLow,
-                           kNeoclimaFanAuto, kNeoclimaFanAuto, kNeoclimaFanMed);
-  result += addBoolToString(getSwingV(), kSwingVStr);
-  result += addBoolToString(getSwingH(), kSwingHStr);
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getHold(), kHoldStr);
-  result += addBoolToString(getIon(), kIonStr);
-  result += addBoolToString(getEye(), kEyeStr);
-  result += addBoolToString(getLight(), kLightStr);
-  result += addBoolToString(getFollow(), kFollowStr);
-  result += addBoolToString(get8CHeat(), k8CHeatStr);
-  result += addBoolToString(getFresh(), kFreshStr);
-  result += addIntToString(getButton(), kButtonStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kNeoclimaAuto, kNeoclimaCool,
+                  kNeoclimaHeat, kNeoclimaDry, kNeoclimaFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kNeoclimaFanHigh, kNeoclimaFanLow,
+                 kNeoclimaFanAuto, kNeoclimaFanAuto, kNeoclimaFanMed);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
+  addBoolToString(&result, getSwingH(), kSwingHStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getHold(), kHoldStr);
+  addBoolToString(&result, getIon(), kIonStr);
+  addBoolToString(&result, getEye(), kEyeStr);
+  addBoolToString(&result, getLight(), kLightStr);
+  addBoolToString(&result, getFollow(), kFollowStr);
+  addBoolToString(&result, get8CHeat(), k8CHeatStr);
+  addBoolToString(&result, getFresh(), kFreshStr);
+  addIntToString(&result, getButton(), kButtonStr);
   result += kSpaceLBraceStr;
   switch (this->getButton()) {
     case kNeoclimaButtonPower:    result += kPowerStr; break;
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -27,6 +28,16 @@ const uint16_t kNikaiZeroSpaceTicks = 4;
 const uint16_t kNikaiZeroSpace = kNikaiZeroSpaceTicks * kNikaiTick;
 const uint16_t kNikaiMinGapTicks = 17;
 const uint16_t kNikaiMinGap = kNikaiMinGapTicks * kNikaiTick;
+const pulse_distance_t kNikaiProtocol = {
+    NIKAI, kNikaiBits,
+    kNikaiHdrMark, kNikaiHdrSpace,
+    kNikaiBitMark, kNikaiOneSpace,
+    kNikaiBitMark, kNikaiZeroSpace,
+    kNikaiBitMark, kNikaiMinGap,
+    38, 33, true, kNoRepeat};
+
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchNikaiHdrMark == kNikaiHdrMark, "See IRrecvTimings.h");
 
 #if SEND_NIKAI
 /// Send a Nikai formatted message.
@@ -35,9 +46,7 @@ const uint16_t kNikaiMinGap = kNikaiMinGapTicks * kNikaiTick;
 /// @param[in] nbits The number of bits of message to be sent.
 /// @param[in] repeat The number of times the command is to be repeated.
 void IRsend::sendNikai(uint64_t data, uint16_t nbits, uint16_t repeat) {
-  sendGeneric(kNikaiHdrMark, kNikaiHdrSpace, kNikaiBitMark, kNikaiOneSpace,
-              kNikaiBitMark, kNikaiZeroSpace, kNikaiBitMark, kNikaiMinGap, data,
-              nbits, 38, true, repeat, 33);
+  sendPulseDistance(&kNikaiProtocol, data, nbits, repeat);
 }
 #endif  // SEND_NIKAI
 
@@ -51,24 +60,6 @@ void IRsend::sendNikai(uint64_t data, uint16_t nbits, uint16_t repeat) {
 /// @param[in] strict Flag indicating if we should perform strict matching.
 bool IRrecv::decodeNikai(decode_results *results, uint16_t offset,
                          const uint16_t nbits, const bool strict) {
-  if (strict && nbits != kNikaiBits)
-    return false;  // We expect Nikai to be a certain sized message.
-
-  uint64_t data = 0;
-
-  // Match Header + Data + Footer
-  if (!matchGeneric(results->rawbuf + offset, &data,
-                    results->rawlen - offset, nbits,
-                    kNikaiHdrMark, kNikaiHdrSpace,
-                    kNikaiBitMark, kNikaiOneSpace,
-                    kNikaiBitMark, kNikaiZeroSpace,
-                    kNikaiBitMark, kNikaiMinGap, true)) return false;
-  // Success
-  results->bits = nbits;
-  results->value = data;
-  results->decode_type = NIKAI;
-  results->command = 0;
-  results->address = 0;
-  return true;
+  return decodePulseDistance(results, offset, &kNikaiProtocol, nbits, strict);
 }
 #endif  // DECODE_NIKAI
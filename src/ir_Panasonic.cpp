@@ -19,6 +19,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -51,6 +52,47 @@ const uint16_t kPanasonicAcSectionGap = 10000;
 const uint16_t kPanasonicAcSection1Length = 8;
 const uint32_t kPanasonicAcMessageGap = kDefaultMessageGap;  // Just a guess.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchPanasonicHdrMark == kPanasonicHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapPanasonicHdrMark == kPanasonicHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapPanasonicHdrSpace == kPanasonicHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapPanasonicAcSectionGap == kPanasonicAcSectionGap,
+              "See IRrecvTimings.h");
+
+#if DECODE_PANASONIC_AC
+/// The signature each section of a PANASONIC_AC message starts with.
+const irutils::fixed_byte_t kPanasonicAcSignature[] = {{0, 0xFF, 0x02},
+                                                       {1, 0xFF, 0x20}};
+/// What is verified of each section as it is matched. i.e. Anything else
+/// with the same timings is given up on after two bytes.
+const byte_checks_t kPanasonicAcSectionChecks = {NULL, 0,
+                                                 kPanasonicAcSignature, 2};
+#endif  // DECODE_PANASONIC_AC
+
+#if SEND_PANASONIC_AC
+// The first section of a Panasonic A/C message is always the same. It is
+// precompiled here, incl. its header & gap, so it doesn't need encoding.
+#define PANASONIC_AC_PULSES_BYTE(byte) \
+    IR_PULSES_LSB_BYTE(kPanasonicBitMark, kPanasonicOneSpace, \
+                       kPanasonicZeroSpace, byte)
+const uint8_t kPanasonicAcSection1[kPanasonicAcSection1Length] = {
+    0x02, 0x20, 0xE0, 0x04, 0x00, 0x00, 0x00, 0x06};
+const uint16_t kPanasonicAcSection1Pulses[] PROGMEM = {
+    kPanasonicHdrMark, kPanasonicHdrSpace,
+    PANASONIC_AC_PULSES_BYTE(0x02), PANASONIC_AC_PULSES_BYTE(0x20),
+    PANASONIC_AC_PULSES_BYTE(0xE0), PANASONIC_AC_PULSES_BYTE(0x04),
+    PANASONIC_AC_PULSES_BYTE(0x00), PANASONIC_AC_PULSES_BYTE(0x00),
+    PANASONIC_AC_PULSES_BYTE(0x00), PANASONIC_AC_PULSES_BYTE(0x06),
+    kPanasonicBitMark, kPanasonicAcSectionGap};
+const precompiled_section_t kPanasonicAcPrecompiledSection1 = {
+    kPanasonicAcSection1, kPanasonicAcSection1Length,
+    kPanasonicAcSection1Pulses,
+    sizeof(kPanasonicAcSection1Pulses) / sizeof(kPanasonicAcSection1Pulses[0])};
+#endif  // SEND_PANASONIC_AC
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -114,6 +156,41 @@ uint64_t IRsend::encodePanasonic(const uint16_t manufacturer,
 
 // Used by Denon as well.
 #if (DECODE_PANASONIC || DECODE_DENON)
+/// Match the header, data, & footer of a Kaseikyo (Panasonic 48-bit) message.
+/// Panasonic & Denon both use it, & only differ by the manufacturer code in the
+/// data. So inside `decode()` the match of the normal sized message is kept, &
+/// shared by each of them at the same offset.
+/// @param[in] results Ptr to the data to match.
+/// @param[in] offset The starting index of the header in the raw data.
+/// @param[in] nbits The number of data bits to expect.
+/// @param[out] data Where to store the matched data bits.
+/// @return The nr. of entries matched. 0 if it didn't match.
+uint16_t IRrecv::_matchKaseikyo(const decode_results *results,
+                                const uint16_t offset, const uint16_t nbits,
+                                uint64_t *data) {
+#if ENABLE_FAMILY_MATCH_CACHE
+  const bool cacheable = _family_cache && nbits == kPanasonicBits;
+  if (cacheable && _kaseikyo_offset == offset) {
+    *data = _kaseikyo_data;
+    return _kaseikyo_used;
+  }
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+  const uint16_t used = matchGeneric(results->rawbuf + offset, data,
+                                     results->rawlen - offset, nbits,
+                                     kPanasonicHdrMark, kPanasonicHdrSpace,
+                                     kPanasonicBitMark, kPanasonicOneSpace,
+                                     kPanasonicBitMark, kPanasonicZeroSpace,
+                                     kPanasonicBitMark, kPanasonicEndGap, true);
+#if ENABLE_FAMILY_MATCH_CACHE
+  if (cacheable) {
+    _kaseikyo_offset = offset;
+    _kaseikyo_used = used;
+    _kaseikyo_data = *data;
+  }
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+  return used;
+}
+
 /// Decode the supplied Panasonic message.
 /// Status: STABLE / Should be working.
 /// @param[in,out] results Ptr to the data to decode & where to store the result
@@ -136,12 +213,7 @@ bool IRrecv::decodePanasonic(decode_results *results, uint16_t offset,
   uint64_t data = 0;
 
   // Match Header + Data + Footer
-  if (!matchGeneric(results->rawbuf + offset, &data,
-                    results->rawlen - offset, nbits,
-                    kPanasonicHdrMark, kPanasonicHdrSpace,
-                    kPanasonicBitMark, kPanasonicOneSpace,
-                    kPanasonicBitMark, kPanasonicZeroSpace,
-                    kPanasonicBitMark, kPanasonicEndGap, true)) return false;
+  if (!_matchKaseikyo(results, offset, nbits, &data)) return false;
   // Compliance
   uint32_t address = data >> 32;
   uint32_t command = data;
@@ -174,11 +246,13 @@ void IRsend::sendPanasonicAC(const uint8_t data[], const uint16_t nbytes,
                              const uint16_t repeat) {
   if (nbytes < kPanasonicAcSection1Length) return;
   for (uint16_t r = 0; r <= repeat; r++) {
-    // First section. (8 bytes)
-    sendGeneric(kPanasonicHdrMark, kPanasonicHdrSpace, kPanasonicBitMark,
-                kPanasonicOneSpace, kPanasonicBitMark, kPanasonicZeroSpace,
-                kPanasonicBitMark, kPanasonicAcSectionGap, data,
-                kPanasonicAcSection1Length, kPanasonicFreq, false, 0, 50);
+    // First section. (8 bytes) It is normally the precompiled one.
+    if (!sendPrecompiled(&kPanasonicAcPrecompiledSection1, data, nbytes,
+                         kPanasonicFreq, 50))
+      sendGeneric(kPanasonicHdrMark, kPanasonicHdrSpace, kPanasonicBitMark,
+                  kPanasonicOneSpace, kPanasonicBitMark, kPanasonicZeroSpace,
+                  kPanasonicBitMark, kPanasonicAcSectionGap, data,
+                  kPanasonicAcSection1Length, kPanasonicFreq, false, 0, 50);
     // First section. (The rest of the data bytes)
     sendGeneric(kPanasonicHdrMark, kPanasonicHdrSpace, kPanasonicBitMark,
                 kPanasonicOneSpace, kPanasonicBitMark, kPanasonicZeroSpace,
@@ -788,15 +862,15 @@ stdAc::state_t IRPanasonicAc::toCommon(void) {
 String IRPanasonicAc::toString(void) {
   String result = "";
   result.reserve(180);  // Reserve some heap for the string to reduce fragging.
-  result += addModelToString(decode_type_t::PANASONIC_AC, getModel(), false);
-  result += addBoolToString(getPower(), kPowerStr);
-  result += addModeToString(getMode(), kPanasonicAcAuto, kPanasonicAcCool,
-                            kPanasonicAcHeat, kPanasonicAcDry, kPanasonicAcFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kPanasonicAcFanMax, kPanasonicAcFanMin,
-                           kPanasonicAcFanAuto, kPanasonicAcFanAuto,
-                           kPanasonicAcFanMed);
-  result += addIntToString(getSwingVertical(), kSwingVStr);
+  addModelToString(&result, decode_type_t::PANASONIC_AC, getModel(), false);
+  addBoolToString(&result, getPower(), kPowerStr);
+  addModeToString(&result, getMode(), kPanasonicAcAuto, kPanasonicAcCool,
+                  kPanasonicAcHeat, kPanasonicAcDry, kPanasonicAcFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kPanasonicAcFanMax, kPanasonicAcFanMin,
+                 kPanasonicAcFanAuto, kPanasonicAcFanAuto,
+                 kPanasonicAcFanMed);
+  addIntToString(&result, getSwingVertical(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (getSwingVertical()) {
     case kPanasonicAcSwingVAuto:
@@ -827,7 +901,7 @@ String IRPanasonicAc::toString(void) {
     case kPanasonicCkp:
       break;  // No Horizontal Swing support.
     default:
-      result += addIntToString(getSwingHorizontal(), kSwingHStr);
+      addIntToString(&result, getSwingHorizontal(), kSwingHStr);
       result += kSpaceLBraceStr;
       switch (getSwingHorizontal()) {
         case kPanasonicAcSwingHAuto:
@@ -853,15 +927,15 @@ String IRPanasonicAc::toString(void) {
       }
       result += ')';
   }
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
   if (getModel() == kPanasonicDke)
-    result += addBoolToString(getIon(), kIonStr);
-  result += addLabeledString(minsToString(getClock()), kClockStr);
-  result += addLabeledString(
+    addBoolToString(&result, getIon(), kIonStr);
+  addLabeledString(&result, minsToString(getClock()), kClockStr);
+  addLabeledString(&result, 
       isOnTimerEnabled() ? minsToString(getOnTimer()) : kOffStr,
       kOnTimerStr);
-  result += addLabeledString(
+  addLabeledString(&result, 
       isOffTimerEnabled() ? minsToString(getOffTimer()) : kOffStr,
       kOffTimerStr);
   return result;
@@ -896,7 +970,8 @@ bool IRrecv::decodePanasonicAC(decode_results *results, uint16_t offset,
                       kPanasonicBitMark, kPanasonicOneSpace,
                       kPanasonicBitMark, kPanasonicZeroSpace,
                       kPanasonicBitMark, kPanasonicAcSectionGap, false,
-                      kPanasonicAcTolerance, kPanasonicAcExcess, false);
+                      kPanasonicAcTolerance, kPanasonicAcExcess, false,
+                      strict ? &kPanasonicAcSectionChecks : NULL);
   if (!used) return false;
   offset += used;
 
@@ -909,14 +984,11 @@ bool IRrecv::decodePanasonicAC(decode_results *results, uint16_t offset,
                     kPanasonicBitMark, kPanasonicOneSpace,
                     kPanasonicBitMark, kPanasonicZeroSpace,
                     kPanasonicBitMark, kPanasonicAcMessageGap, true,
-                    kPanasonicAcTolerance, kPanasonicAcExcess, false))
+                    kPanasonicAcTolerance, kPanasonicAcExcess, false,
+                    strict ? &kPanasonicAcSectionChecks : NULL))
     return false;
   // Compliance
   if (strict) {
-    // Check the signatures of the section blocks. They start with 0x02& 0x20.
-    if (results->state[0] != 0x02 || results->state[1] != 0x20 ||
-        results->state[8] != 0x02 || results->state[9] != 0x20)
-      return false;
     if (!IRPanasonicAc::validChecksum(results->state, nbits / 8)) return false;
   }
 
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -33,6 +34,14 @@ const uint16_t kPioneerZeroSpace = 487;  ///< uSeconds.
 const uint32_t kPioneerMinCommandLength = 84906;  ///< uSeconds.
 const uint32_t kPioneerMinGap = 25181;  ///< uSeconds.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchPioneerHdrMark == kPioneerHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapPioneerHdrMark == kPioneerHdrMark, "See IRrecvTimings.h");
+static_assert(kLongGapPioneerHdrSpace == kPioneerHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapPioneerMinGap == kPioneerMinGap, "See IRrecvTimings.h");
+
 #if SEND_PIONEER
 /// Send a raw Pioneer formatted message.
 /// Status: STABLE / Expected to be working.
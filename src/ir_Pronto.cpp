@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include "IRsend.h"
+#include "IRutils.h"
 
 // Constants
 const float kProntoFreqFactor = 0.241246;
@@ -104,4 +105,191 @@ void IRsend::sendPronto(uint16_t data[], uint16_t len, uint16_t repeat) {
       }
   }
 }
+
+/// Send a Pronto Code formatted message, straight from its text form.
+/// i.e. The same as `sendPronto(uint16_t data[], uint16_t len, uint16_t)`, but
+/// the (hexadecimal) values are read from the string as they are sent, rather
+/// than needing to be converted into an array first. That uses a constant (&
+/// small) amount of memory, no matter how long the code is.
+/// Status: BETA / Should work.
+/// @param[in] str A C string of comma and/or space separated hex values.
+///   e.g. "0000 0067 0000 0015 0060 0018 0018 0018 0030 0018 0030 0018 ..."
+/// @param[in] repeat Nr. of times to repeat the message.
+/// @return true, if it was sent. false if `str` isn't a supported Pronto code.
+bool IRsend::sendPronto(const char *str, uint16_t repeat) {
+  // Check the whole thing first, so we never send half of a message.
+  const int32_t count = irutils::countValues(str, 16);
+  if (count < kProntoMinLength) return false;
+  uint32_t header[kProntoDataOffset];
+  const char *ptr = str;
+  for (uint16_t i = 0; i < kProntoDataOffset; i++)
+    irutils::parseValue(&ptr, &header[i], 16);
+  // We only know how to deal with 'raw' pronto codes types. Reject all others.
+  if (header[kProntoTypeOffset] != 0) return false;
+  if (header[kProntoFreqOffset] == 0 || header[kProntoFreqOffset] > UINT16_MAX)
+    return false;
+  // Grab the length of the two sequences.
+  const uint32_t seq_1_len = header[kProntoSeq1LenOffset] * 2;
+  const uint32_t seq_2_len = header[kProntoSeq2LenOffset] * 2;
+  // Check we have enough data to send the complete sequences.
+  if (kProntoDataOffset + seq_1_len + seq_2_len > (uint32_t)count)
+    return false;
+
+  // Pronto frequency is in Hz.
+  uint16_t hz =
+      (uint16_t)(1000000U / (header[kProntoFreqOffset] * kProntoFreqFactor));
+  enableIROut(hz);
+  uint32_t periodic_time_x10 = calcUSecPeriod(hz / 10, false);
+  uint32_t on;
+  uint32_t off;
+
+  // Normal (1st sequence) case.
+  if (seq_1_len > 0) {
+    for (uint32_t i = 0; i < seq_1_len; i += 2) {
+      irutils::parseValue(&ptr, &on, 16);
+      irutils::parseValue(&ptr, &off, 16);
+      mark((on * periodic_time_x10) / 10);
+      space((off * periodic_time_x10) / 10);
+    }
+  } else {
+    // There was no first sequence to send, it is implied that we have to send
+    // the 2nd/repeat sequence an additional time. i.e. At least once.
+    repeat++;
+  }
+
+  // Repeat (2nd sequence) case.
+  const char *seq_2_start = ptr;
+  for (uint16_t r = 0; seq_2_len && r < repeat; r++) {
+    ptr = seq_2_start;
+    for (uint32_t i = 0; i < seq_2_len; i += 2) {
+      irutils::parseValue(&ptr, &on, 16);
+      irutils::parseValue(&ptr, &off, 16);
+      mark((on * periodic_time_x10) / 10);
+      space((off * periodic_time_x10) / 10);
+    }
+  }
+  return true;
+}
+
+/// The carrier frequency of a Pronto code.
+/// @param[in] freq The frequency value from the Pronto code's header.
+/// @return The frequency in Hz.
+static uint16_t prontoHz(const uint32_t freq) {
+  return (uint16_t)(1000000U / (freq * kProntoFreqFactor));
+}
+
+/// Add a (mark, space) pair of a Pronto code to a compiled sequence.
+/// @param[in,out] sequence Where to add them.
+/// @param[in] on The mark, in carrier periods.
+/// @param[in] off The space, in carrier periods.
+/// @param[in] periodic_time_x10 Ten times the carrier period. (uSeconds)
+static void addProntoPair(IRsequence *sequence, const uint32_t on,
+                          const uint32_t off,
+                          const uint32_t periodic_time_x10) {
+  sequence->add(true, (on * periodic_time_x10) / 10);
+  sequence->add(false, (off * periodic_time_x10) / 10);
+}
+
+/// Convert a Pronto code into marks & spaces once, ahead of time. i.e. All the
+/// arithmetic `sendPronto()` does as it sends, so it can be replayed with
+/// `sendPronto(const IRsequence *, const IRsequence *, uint16_t)` instead.
+/// e.g. For Pronto codes that are sent often.
+/// @param[in] data An array of uint16_t containing the pronto codes.
+/// @param[in] len Nr. of entries in the data[] array.
+/// @param[out] intro Where to put the 1st (normal) sequence. It is left empty
+///   if the code has none.
+/// @param[out] repeats Where to put the 2nd (repeat) sequence. Ditto.
+/// @return true, if it was compiled. false if it isn't a supported Pronto
+///   code, or either sequence didn't fit.
+bool IRsend::compilePronto(const uint16_t data[], const uint16_t len,
+                           IRsequence *intro, IRsequence *repeats) {
+  if (intro == NULL || repeats == NULL) return false;
+  intro->clear();
+  repeats->clear();
+  // Check we have enough data to work out what to send.
+  if (data == NULL || len < kProntoMinLength) return false;
+  // We only know how to deal with 'raw' pronto codes types. Reject all others.
+  if (data[kProntoTypeOffset] != 0 || data[kProntoFreqOffset] == 0)
+    return false;
+  // Grab the length of the two sequences.
+  const uint32_t seq_1_len = data[kProntoSeq1LenOffset] * 2;
+  const uint32_t seq_2_len = data[kProntoSeq2LenOffset] * 2;
+  // Check we have enough data for the complete sequences.
+  if (kProntoDataOffset + seq_1_len + seq_2_len > len) return false;
+
+  const uint16_t hz = prontoHz(data[kProntoFreqOffset]);
+  const uint32_t periodic_time_x10 = calcUSecPeriod(hz / 10, false);
+  intro->setCarrier(hz, kDutyDefault);
+  repeats->setCarrier(hz, kDutyDefault);
+  const uint16_t *seq = data + kProntoDataOffset;
+  for (uint32_t i = 0; i < seq_1_len; i += 2)
+    addProntoPair(intro, seq[i], seq[i + 1], periodic_time_x10);
+  seq += seq_1_len;
+  for (uint32_t i = 0; i < seq_2_len; i += 2)
+    addProntoPair(repeats, seq[i], seq[i + 1], periodic_time_x10);
+  return !intro->overflowed() && !repeats->overflowed();
+}
+
+/// Convert a Pronto code, in its text form, into marks & spaces once, ahead
+/// of time. See `compilePronto(const uint16_t[], ...)`.
+/// @param[in] str A C string of comma and/or space separated hex values.
+///   e.g. "0000 0067 0000 0015 0060 0018 0018 0018 0030 0018 0030 0018 ..."
+/// @param[out] intro Where to put the 1st (normal) sequence. It is left empty
+///   if the code has none.
+/// @param[out] repeats Where to put the 2nd (repeat) sequence. Ditto.
+/// @return true, if it was compiled. false if `str` isn't a supported Pronto
+///   code, or either sequence didn't fit.
+bool IRsend::compilePronto(const char *str, IRsequence *intro,
+                           IRsequence *repeats) {
+  if (intro == NULL || repeats == NULL) return false;
+  intro->clear();
+  repeats->clear();
+  const int32_t count = irutils::countValues(str, 16);
+  if (count < kProntoMinLength) return false;
+  uint32_t header[kProntoDataOffset];
+  const char *ptr = str;
+  for (uint16_t i = 0; i < kProntoDataOffset; i++)
+    irutils::parseValue(&ptr, &header[i], 16);
+  // We only know how to deal with 'raw' pronto codes types. Reject all others.
+  if (header[kProntoTypeOffset] != 0) return false;
+  if (header[kProntoFreqOffset] == 0 || header[kProntoFreqOffset] > UINT16_MAX)
+    return false;
+  // Grab the length of the two sequences.
+  const uint32_t seq_1_len = header[kProntoSeq1LenOffset] * 2;
+  const uint32_t seq_2_len = header[kProntoSeq2LenOffset] * 2;
+  // Check we have enough data for the complete sequences.
+  if (kProntoDataOffset + seq_1_len + seq_2_len > (uint32_t)count)
+    return false;
+
+  const uint16_t hz = prontoHz(header[kProntoFreqOffset]);
+  const uint32_t periodic_time_x10 = calcUSecPeriod(hz / 10, false);
+  intro->setCarrier(hz, kDutyDefault);
+  repeats->setCarrier(hz, kDutyDefault);
+  uint32_t on;
+  uint32_t off;
+  for (uint32_t i = 0; i < seq_1_len + seq_2_len; i += 2) {
+    irutils::parseValue(&ptr, &on, 16);
+    irutils::parseValue(&ptr, &off, 16);
+    addProntoPair(i < seq_1_len ? intro : repeats, on, off, periodic_time_x10);
+  }
+  return !intro->overflowed() && !repeats->overflowed();
+}
+
+/// Send a Pronto code that was compiled by `compilePronto()`. It is sent
+/// exactly as `sendPronto()` would send the original code, but without any
+/// parsing or arithmetic.
+/// @param[in] intro The 1st (normal) sequence.
+/// @param[in] repeats The 2nd (repeat) sequence.
+/// @param[in] repeat Nr. of times to repeat the message.
+void IRsend::sendPronto(const IRsequence *intro, const IRsequence *repeats,
+                        uint16_t repeat) {
+  if (intro != NULL && intro->length()) {
+    sendSequence(intro);
+  } else {
+    // There was no first sequence to send, it is implied that we have to send
+    // the 2nd/repeat sequence an additional time. i.e. At least once.
+    repeat++;
+  }
+  if (repeat && repeats != NULL) sendSequence(repeats, repeat - 1);
+}
 #endif  // SEND_PRONTO
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtimer.h"
 #include "IRutils.h"
@@ -43,6 +44,9 @@ const uint32_t kRc6RptLength = kRc6RptLengthTicks * kRc6Tick;
 const uint32_t kRc6ToggleMask = 0x10000UL;  // The 17th bit.
 const uint16_t kRc6_36ToggleMask = 0x8000;  // The 16th bit.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchRc6HdrMark == kRc6HdrMark, "See IRrecvTimings.h");
+
 // Common (getRClevel())
 const int16_t kMark = 0;
 const int16_t kSpace = 1;
@@ -240,10 +244,53 @@ void IRsend::sendRC6(const uint64_t data, const uint16_t nbits,
 /// @return MARK, SPACE, or -1 for error.
 ///   (The measured time interval is not a  multiple of t1.)
 /// @see https://en.wikipedia.org/wiki/Manchester_code
+/// @note Decoders should call `_rcWindows()` once, & use the other version.
 int16_t IRrecv::getRClevel(decode_results *results, uint16_t *offset,
                            uint16_t *used, const uint16_t bitTime,
                            const uint8_t tolerance, const int16_t excess,
                            const uint16_t delta, const uint8_t maxwidth) {
+  const rc_windows_t windows = _rcWindows(bitTime, tolerance, excess, delta,
+                                          maxwidth);
+  return getRClevel(results, offset, used, &windows);
+}
+
+/// Precompute the windows `getRClevel()` matches each run of levels against.
+/// Done once per message, rather than for every level of it.
+/// @param[in] bitTime Time interval of single bit in microseconds.
+/// @param[in] tolerance Percent tolerance to be used in matching.
+/// @param[in] excess Extra useconds to add to Marks & removed from Spaces.
+/// @param[in] delta A non-scaling (+/-) error margin (in useconds).
+/// @param[in] maxwidth Maximum number of successive levels to find in a single
+///   level. Capped at kRcLevelMaxWidth. (default is 3)
+/// @return The windows, in ticks.
+rc_windows_t IRrecv::_rcWindows(const uint16_t bitTime,
+                                const uint8_t tolerance, const int16_t excess,
+                                const uint16_t delta, const uint8_t maxwidth) {
+  rc_windows_t windows;
+  windows.maxwidth = std::min(maxwidth, kRcLevelMaxWidth);
+  for (uint8_t width = 1; width <= windows.maxwidth; width++) {
+    windows.mark[width - 1] = _matchWindow(width * bitTime + excess,
+                                           tolerance, delta);
+    windows.space[width - 1] = _matchWindow(width * bitTime - excess,
+                                            tolerance, delta);
+  }
+  // N.B. Compared directly with the entry, as it always has been.
+  windows.gap = std::min((uint32_t)(20000 - delta),
+                         (uint32_t)(maxwidth * bitTime + delta));
+  return windows;
+}
+
+/// Gets one undecoded level at a time from the raw buffer, using precomputed
+/// windows. i.e. Only integer compares for each level.
+/// @param[in,out] results Ptr to the data to decode and where to store the
+///   decode result.
+/// @param[in,out] offset Ptr to the currect offset to the rawbuf.
+/// @param[in,out] used Ptr to the current used counter.
+/// @param[in] windows A ptr to the windows from `_rcWindows()`.
+/// @return MARK, SPACE, or -1 for error.
+///   (The measured time interval is not a  multiple of t1.)
+int16_t IRrecv::getRClevel(decode_results *results, uint16_t *offset,
+                           uint16_t *used, const rc_windows_t *windows) {
   DPRINT("DEBUG: getRClevel: offset = ");
   DPRINTLN(uint64ToString(*offset));
   DPRINT("DEBUG: getRClevel: rawlen = ");
@@ -252,24 +299,26 @@ int16_t IRrecv::getRClevel(decode_results *results, uint16_t *offset,
     DPRINTLN("DEBUG: getRClevel: SPACE, past end of rawbuf");
     return kSpace;  // After end of recorded buffer, assume SPACE.
   }
-  uint16_t width = results->rawbuf[*offset];
+  const uint16_t width = results->rawbuf[*offset];
   //  If the value of offset is odd, it's a MARK. Even, it's a SPACE.
-  uint16_t val = ((*offset) % 2) ? kMark : kSpace;
+  const int16_t val = ((*offset) % 2) ? kMark : kSpace;
   // Check to see if we have hit an inter-message gap (> 20ms).
-  if (val == kSpace &&
-      (width > 20000 - delta || width > maxwidth * bitTime + delta)) {
+  if (val == kSpace && width > windows->gap) {
     DPRINTLN("DEBUG: getRClevel: SPACE, hit end of mesg gap.");
     return kSpace;
   }
-  int16_t correction = (val == kMark) ? excess : -excess;
+  const match_window_t *window = (val == kMark) ? windows->mark
+                                                : windows->space;
 
   // Calculate the look-ahead for our current position in the buffer.
   uint16_t avail;
   // Note: We want to match in greedy order as the other way leads to
   //       mismatches due to overlaps induced by the correction and tolerance
   //       values.
-  for (avail = maxwidth; avail > 0; avail--) {
-    if (match(width, avail * bitTime + correction, tolerance, delta)) {
+  for (avail = windows->maxwidth; avail > 0; avail--) {
+    const match_window_t *run = &window[avail - 1];
+    if (width >= run->low && width <= run->high) {
+      _scoreFit(width, run->low, run->high);
       break;
     }
   }
@@ -317,14 +366,15 @@ bool IRrecv::decodeRC5(decode_results *results, uint16_t offset,
   uint16_t used = 0;
   bool is_rc5x = false;
   uint64_t data = 0;
+  const rc_windows_t windows = _rcWindows(kRc5T1);
 
   // Header
   // Get start bit #1.
-  if (getRClevel(results, &offset, &used, kRc5T1) != kMark) return false;
+  if (getRClevel(results, &offset, &used, &windows) != kMark) return false;
   // Get field/start bit #2 (inverted bit-7 of the command if RC-5X protocol)
   uint16_t actual_bits = 1;
-  int16_t levelA = getRClevel(results, &offset, &used, kRc5T1);
-  int16_t levelB = getRClevel(results, &offset, &used, kRc5T1);
+  int16_t levelA = getRClevel(results, &offset, &used, &windows);
+  int16_t levelB = getRClevel(results, &offset, &used, &windows);
   if (levelA == kSpace && levelB == kMark) {  // Matched a 1.
     is_rc5x = false;
   } else if (levelA == kMark && levelB == kSpace) {  // Matched a 0.
@@ -337,8 +387,8 @@ bool IRrecv::decodeRC5(decode_results *results, uint16_t offset,
 
   // Data
   for (; offset < results->rawlen; actual_bits++) {
-    int16_t levelA = getRClevel(results, &offset, &used, kRc5T1);
-    int16_t levelB = getRClevel(results, &offset, &used, kRc5T1);
+    int16_t levelA = getRClevel(results, &offset, &used, &windows);
+    int16_t levelB = getRClevel(results, &offset, &used, &windows);
     if (levelA == kSpace && levelB == kMark)
       data = (data << 1) | 1;  // 1
     else if (levelA == kMark && levelB == kSpace)
@@ -412,10 +462,11 @@ bool IRrecv::decodeRC6(decode_results *results, uint16_t offset,
     return false;
 
   uint16_t used = 0;
+  const rc_windows_t windows = _rcWindows(tick);
 
   // Get the start bit. e.g. 1.
-  if (getRClevel(results, &offset, &used, tick) != kMark) return false;
-  if (getRClevel(results, &offset, &used, tick) != kSpace) return false;
+  if (getRClevel(results, &offset, &used, &windows) != kMark) return false;
+  if (getRClevel(results, &offset, &used, &windows) != kSpace) return false;
 
   uint16_t actual_bits;
   uint64_t data = 0;
@@ -423,13 +474,15 @@ bool IRrecv::decodeRC6(decode_results *results, uint16_t offset,
   // Data (Warning: Here be dragons^Wpointers!!)
   for (actual_bits = 0; offset < results->rawlen; actual_bits++) {
     int16_t levelA, levelB;  // Next two levels
-    levelA = getRClevel(results, &offset, &used, tick);
+    levelA = getRClevel(results, &offset, &used, &windows);
     // T bit is double wide; make sure second half matches
-    if (actual_bits == 3 && levelA != getRClevel(results, &offset, &used, tick))
+    if (actual_bits == 3 &&
+        levelA != getRClevel(results, &offset, &used, &windows))
       return false;
-    levelB = getRClevel(results, &offset, &used, tick);
+    levelB = getRClevel(results, &offset, &used, &windows);
     // T bit is double wide; make sure second half matches
-    if (actual_bits == 3 && levelB != getRClevel(results, &offset, &used, tick))
+    if (actual_bits == 3 &&
+        levelB != getRClevel(results, &offset, &used, &windows))
       return false;
     if (levelA == kMark && levelB == kSpace)  // reversed compared to RC5
       data = (data << 1) | 1;                 // 1
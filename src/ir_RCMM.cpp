@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtimer.h"
 #include "IRutils.h"
@@ -37,6 +38,9 @@ const uint32_t kRcmmMinGap = 3360;
 const uint8_t kRcmmTolerance = 10;
 const uint16_t kRcmmExcess = 50;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchRcmmHdrMark == kRcmmHdrMark, "See IRrecvTimings.h");
+
 #if SEND_RCMM
 /// Send a Philips RC-MM packet.
 /// Status: STABLE / Should be working.
@@ -15,6 +15,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -53,6 +54,39 @@ const uint16_t kSamsungAcBitMark = 586;
 const uint16_t kSamsungAcOneSpace = 1432;
 const uint16_t kSamsungAcZeroSpace = 436;
 
+#if SEND_SAMSUNG_AC
+// The special extended "On" & "Off" messages.
+// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/604#issuecomment-475020036
+const uint8_t kSamsungAcOnState[kSamsungAcExtendedStateLength] = {
+    0x02, 0x92, 0x0F, 0x00, 0x00, 0x00, 0xF0,
+    0x01, 0xD2, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0xE2, 0xFE, 0x71, 0x80, 0x11, 0xF0};
+const uint8_t kSamsungAcOffState[kSamsungAcExtendedStateLength] = {
+    0x02, 0xB2, 0x0F, 0x00, 0x00, 0x00, 0xC0,
+    0x01, 0xD2, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x02, 0xFF, 0x71, 0x80, 0x11, 0xC0};
+// The middle section of an extended message is normally the same. i.e.
+// `kSamsungAcPowerSection`. It is precompiled here, incl. its header & gap, so
+// it doesn't need encoding.
+#define SAMSUNG_AC_PULSES_BYTE(byte) \
+    IR_PULSES_LSB_BYTE(kSamsungAcBitMark, kSamsungAcOneSpace, \
+                       kSamsungAcZeroSpace, byte)
+const uint8_t kSamsungAcPowerSectionBytes[kSamsungAcSectionLength] = {
+    0x01, 0xD2, 0x0F, 0x00, 0x00, 0x00, 0x00};
+const uint16_t kSamsungAcPowerSectionPulses[] PROGMEM = {
+    kSamsungAcSectionMark, kSamsungAcSectionSpace,
+    SAMSUNG_AC_PULSES_BYTE(0x01), SAMSUNG_AC_PULSES_BYTE(0xD2),
+    SAMSUNG_AC_PULSES_BYTE(0x0F), SAMSUNG_AC_PULSES_BYTE(0x00),
+    SAMSUNG_AC_PULSES_BYTE(0x00), SAMSUNG_AC_PULSES_BYTE(0x00),
+    SAMSUNG_AC_PULSES_BYTE(0x00),
+    kSamsungAcBitMark, kSamsungAcSectionGap};
+const precompiled_section_t kSamsungAcPrecompiledPowerSection = {
+    kSamsungAcPowerSectionBytes, kSamsungAcSectionLength,
+    kSamsungAcPowerSectionPulses,
+    sizeof(kSamsungAcPowerSectionPulses) /
+        sizeof(kSamsungAcPowerSectionPulses[0])};
+#endif  // SEND_SAMSUNG_AC
+
 // Data from https://github.com/crankyoldgit/IRremoteESP8266/issues/1220
 // Values calculated based on the average of ten messages.
 const uint16_t kSamsung36HdrMark = 4515;  /// < uSeconds
@@ -61,6 +95,14 @@ const uint16_t kSamsung36BitMark = 512;  /// < uSeconds
 const uint16_t kSamsung36OneSpace = 1468;  /// < uSeconds
 const uint16_t kSamsung36ZeroSpace = 490;  /// < uSeconds
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchSamsungAcBitMark == kSamsungAcBitMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchSamsungHdrMark == kSamsungHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kDispatchSamsung36HdrMark == kSamsung36HdrMark,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -253,11 +295,15 @@ void IRsend::sendSamsungAC(const uint8_t data[], const uint16_t nbytes,
     // Send in 7 byte sections.
     for (uint16_t offset = 0; offset < nbytes;
          offset += kSamsungAcSectionLength) {
-      sendGeneric(kSamsungAcSectionMark, kSamsungAcSectionSpace,
-                  kSamsungAcBitMark, kSamsungAcOneSpace, kSamsungAcBitMark,
-                  kSamsungAcZeroSpace, kSamsungAcBitMark, kSamsungAcSectionGap,
-                  data + offset, kSamsungAcSectionLength,  // 7 bytes == 56 bits
-                  38000, false, 0, 50);                    // Send in LSBF order
+      // The power section of an extended message is replayed when possible.
+      if (!sendPrecompiled(&kSamsungAcPrecompiledPowerSection, data + offset,
+                           kSamsungAcSectionLength, 38000, 50))
+        sendGeneric(kSamsungAcSectionMark, kSamsungAcSectionSpace,
+                    kSamsungAcBitMark, kSamsungAcOneSpace, kSamsungAcBitMark,
+                    kSamsungAcZeroSpace, kSamsungAcBitMark,
+                    kSamsungAcSectionGap,
+                    data + offset, kSamsungAcSectionLength,  // 7 bytes
+                    38000, false, 0, 50);  // Send in LSBF order
     }
     // Complete made up guess at inter-message gap.
     space(kDefaultMessageGap - kSamsungAcSectionGap);
@@ -272,6 +318,9 @@ void IRsend::sendSamsungAC(const uint8_t data[], const uint16_t nbytes,
 IRSamsungAc::IRSamsungAc(const uint16_t pin, const bool inverted,
                          const bool use_modulation)
     : _irsend(pin, inverted, use_modulation) {
+  _onsequence = NULL;
+  _offsequence = NULL;
+  _powerrepeat = kSamsungAcDefaultRepeat;
   this->stateReset();
 }
 
@@ -383,28 +432,60 @@ void IRSamsungAc::sendExtended(const uint16_t repeat, const bool calcchecksum) {
 /// Send the special extended "On" message as the library can't seem to
 /// reproduce this message automatically.
 /// @param[in] repeat Nr. of times the message will be repeated.
+/// @note It is replayed from its compiled sequence, if it has one for `repeat`.
+///   See `compilePower()`.
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/604#issuecomment-475020036
 void IRSamsungAc::sendOn(const uint16_t repeat) {
-  const uint8_t extended_state[21] = {
-      0x02, 0x92, 0x0F, 0x00, 0x00, 0x00, 0xF0,
-      0x01, 0xD2, 0x0F, 0x00, 0x00, 0x00, 0x00,
-      0x01, 0xE2, 0xFE, 0x71, 0x80, 0x11, 0xF0};
-  _irsend.sendSamsungAC(extended_state, kSamsungAcExtendedStateLength, repeat);
+  if (_onsequence != NULL && repeat == _powerrepeat)
+    _irsend.sendSequence(_onsequence);
+  else
+    _irsend.sendSamsungAC(kSamsungAcOnState, kSamsungAcExtendedStateLength,
+                          repeat);
   _lastsentpowerstate = true;  // On
 }
 
 /// Send the special extended "Off" message as the library can't seem to
 /// reproduce this message automatically.
 /// @param[in] repeat Nr. of times the message will be repeated.
+/// @note It is replayed from its compiled sequence, if it has one for `repeat`.
+///   See `compilePower()`.
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/604#issuecomment-475020036
 void IRSamsungAc::sendOff(const uint16_t repeat) {
-  const uint8_t extended_state[21] = {
-      0x02, 0xB2, 0x0F, 0x00, 0x00, 0x00, 0xC0,
-      0x01, 0xD2, 0x0F, 0x00, 0x00, 0x00, 0x00,
-      0x01, 0x02, 0xFF, 0x71, 0x80, 0x11, 0xC0};
-  _irsend.sendSamsungAC(extended_state, kSamsungAcExtendedStateLength, repeat);
+  if (_offsequence != NULL && repeat == _powerrepeat)
+    _irsend.sendSequence(_offsequence);
+  else
+    _irsend.sendSamsungAC(kSamsungAcOffState, kSamsungAcExtendedStateLength,
+                          repeat);
   _lastsentpowerstate = false;  // Off
 }
+
+/// Encode the special "On" & "Off" messages once, ahead of time. e.g. At
+/// startup. `sendOn()` & `sendOff()` then replay them, so they start sending
+/// straight away.
+/// @param[in,out] on Where to keep the "On" message. It must outlive this
+///   object, or the next call to this.
+/// @param[in,out] off Where to keep the "Off" message. Ditto.
+/// @param[in] repeat Nr. of times the messages will be repeated.
+/// @return true, if both were compiled. false, if either didn't fit, in which
+///   case they are encoded each time they are sent, as normal.
+bool IRSamsungAc::compilePower(IRsequence *on, IRsequence *off,
+                               const uint16_t repeat) {
+  _onsequence = NULL;
+  _offsequence = NULL;
+  if (on == NULL || off == NULL) return false;
+  _irsend.startRecording(on);
+  _irsend.sendSamsungAC(kSamsungAcOnState, kSamsungAcExtendedStateLength,
+                        repeat);
+  const bool compiled = _irsend.stopRecording();
+  _irsend.startRecording(off);
+  _irsend.sendSamsungAC(kSamsungAcOffState, kSamsungAcExtendedStateLength,
+                        repeat);
+  if (!_irsend.stopRecording() || !compiled) return false;
+  _onsequence = on;
+  _offsequence = off;
+  _powerrepeat = repeat;
+  return true;
+}
 #endif  // SEND_SAMSUNG_AC
 
 /// Get a PTR to the internal state/code for this protocol.
@@ -736,12 +817,12 @@ stdAc::state_t IRSamsungAc::toCommon(void) {
 String IRSamsungAc::toString(void) {
   String result = "";
   result.reserve(115);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kSamsungAcAuto, kSamsungAcCool,
-                            kSamsungAcHeat, kSamsungAcDry,
-                            kSamsungAcFan);
-  result += addTempToString(getTemp());
-  result += addIntToString(getFan(), kFanStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kSamsungAcAuto, kSamsungAcCool,
+                  kSamsungAcHeat, kSamsungAcDry,
+                  kSamsungAcFan);
+  addTempToString(&result, getTemp());
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (getFan()) {
     case kSamsungAcFanAuto:
@@ -765,14 +846,14 @@ String IRSamsungAc::toString(void) {
       break;
   }
   result += ')';
-  result += addBoolToString(getSwing(), kSwingStr);
-  result += addBoolToString(getBeep(), kBeepStr);
-  result += addBoolToString(getClean(), kCleanStr);
-  result += addBoolToString(getQuiet(), kQuietStr);
-  result += addBoolToString(getPowerful(), kPowerfulStr);
-  result += addBoolToString(getBreeze(), kBreezeStr);
-  result += addBoolToString(getDisplay(), kLightStr);
-  result += addBoolToString(getIon(), kIonStr);
+  addBoolToString(&result, getSwing(), kSwingStr);
+  addBoolToString(&result, getBeep(), kBeepStr);
+  addBoolToString(&result, getClean(), kCleanStr);
+  addBoolToString(&result, getQuiet(), kQuietStr);
+  addBoolToString(&result, getPowerful(), kPowerfulStr);
+  addBoolToString(&result, getBreeze(), kBreezeStr);
+  addBoolToString(&result, getDisplay(), kLightStr);
+  addBoolToString(&result, getIon(), kIonStr);
   return result;
 }
 
@@ -783,12 +864,16 @@ String IRSamsungAc::toString(void) {
 /// @param[in] offset The starting index to use when attempting to decode the
 ///   raw data. Typically/Defaults to kStartOffset.
 /// @param[in] nbits The number of data bits to expect.
+///   Only legal sizes are accepted. The size decoded is what the message has.
 /// @param[in] strict Flag indicating if we should perform strict matching.
 /// @return True if it can decode it, false if it can't.
+/// @note The sections are read until the gap after one isn't a section gap,
+///   so both the normal & extended sizes are decoded in a single pass.
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/505
 bool IRrecv::decodeSamsungAC(decode_results *results, uint16_t offset,
                              const uint16_t nbits, const bool strict) {
-  if (results->rawlen < 2 * nbits + kHeader * 3 + kFooter * 2 - 1 + offset)
+  if (results->rawlen < 2 * kSamsungAcBits + kHeader * 3 + kFooter * 2 - 1 +
+      offset)
     return false;  // Can't possibly be a valid Samsung A/C message.
   if (nbits != kSamsungAcBits && nbits != kSamsungAcExtendedBits) return false;
 
@@ -796,35 +881,53 @@ bool IRrecv::decodeSamsungAC(decode_results *results, uint16_t offset,
   if (!matchMark(results->rawbuf[offset++], kSamsungAcBitMark)) return false;
   if (!matchSpace(results->rawbuf[offset++], kSamsungAcHdrSpace)) return false;
   // Section(s)
-  for (uint16_t pos = 0; pos <= (nbits / 8) - kSamsungAcSectionLength;
-       pos += kSamsungAcSectionLength) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, kSamsungAcSectionLength * 8,
-                        kSamsungAcSectionMark, kSamsungAcSectionSpace,
-                        kSamsungAcBitMark, kSamsungAcOneSpace,
-                        kSamsungAcBitMark, kSamsungAcZeroSpace,
-                        kSamsungAcBitMark, kSamsungAcSectionGap,
-                        pos + kSamsungAcSectionLength >= nbits / 8,
-                        _tolerance, 0, false);
+  uint16_t pos = 0;
+  while (true) {
+    // Section Header + Section Data (7 bytes) + Section Footer mark
+    const uint16_t used = matchGeneric(
+        results->rawbuf + offset, results->state + pos,
+        results->rawlen - offset, kSamsungAcSectionLength * 8,
+        kSamsungAcSectionMark, kSamsungAcSectionSpace,
+        kSamsungAcBitMark, kSamsungAcOneSpace,
+        kSamsungAcBitMark, kSamsungAcZeroSpace,
+        kSamsungAcBitMark, 0, false, _tolerance, 0, false);
     if (used == 0) return false;
     offset += used;
+    pos += kSamsungAcSectionLength;
+    if (offset >= results->rawlen) break;  // Out of capture.
+    // Is there another section after this one?
+    if (pos < kSamsungAcExtendedStateLength && offset + 1 < results->rawlen &&
+        matchSpace(results->rawbuf[offset], kSamsungAcSectionGap,
+                   _tolerance, 0) &&
+        matchMark(results->rawbuf[offset + 1], kSamsungAcSectionMark,
+                  _tolerance, 0)) {
+      offset++;
+      continue;
+    }
+    // No, so it should be the end of the message.
+    if (!matchAtLeast(results->rawbuf[offset], kSamsungAcSectionGap,
+                      _tolerance, 0)) return false;
+    break;
   }
+  if (pos != kSamsungAcStateLength && pos != kSamsungAcExtendedStateLength)
+    return false;  // Not a legal size.
   // Compliance
   // Is the signature correct?
   DPRINTLN("DEBUG: Checking signature.");
   if (results->state[0] != 0x02 || results->state[2] != 0x0F) return false;
-  if (strict) {
+  // Real extended messages don't always have a valid checksum, so only check
+  // them if they were explicitly asked for.
+  if (strict && (pos == kSamsungAcStateLength ||
+                 nbits == kSamsungAcExtendedBits)) {
     // Is the checksum valid?
-    if (!IRSamsungAc::validChecksum(results->state, nbits / 8)) {
+    if (!IRSamsungAc::validChecksum(results->state, pos)) {
       DPRINTLN("DEBUG: Checksum failed!");
       return false;
     }
   }
   // Success
   results->decode_type = SAMSUNG_AC;
-  results->bits = nbits;
+  results->bits = pos * 8;
   // No need to record the state as we stored it as we decoded it.
   // As we use result->state, we don't record value, address, or command as it
   // is a union data type.
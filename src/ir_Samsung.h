@@ -106,6 +106,8 @@ class IRSamsungAc {
                     const bool calcchecksum = true);
   void sendOn(const uint16_t repeat = kSamsungAcDefaultRepeat);
   void sendOff(const uint16_t repeat = kSamsungAcDefaultRepeat);
+  bool compilePower(IRsequence *on, IRsequence *off,
+                    const uint16_t repeat = kSamsungAcDefaultRepeat);
   /// Run the calibration to calculate uSec timing offsets for this platform.
   /// @return The uSec timing offset needed per modulation of the IR Led.
   /// @note This will produce a 65ms IR signal pulse at 38kHz.
@@ -164,6 +166,9 @@ class IRSamsungAc {
   uint8_t remote_state[kSamsungAcExtendedStateLength];  ///< State in code form.
   bool _forcepower;  ///< Hack to know when we need to send a special power mesg
   bool _lastsentpowerstate;
+  const IRsequence *_onsequence;  ///< Compiled "On" message, if any.
+  const IRsequence *_offsequence;  ///< Compiled "Off" message, if any.
+  uint16_t _powerrepeat;  ///< The repeat the messages were compiled with.
   void checksum(const uint16_t length = kSamsungAcStateLength);
 };
 
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstring>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -68,6 +69,10 @@ const uint16_t kSanyoAcZeroSpace = 550;  ///< uSeconds
 const uint32_t kSanyoAcGap = kDefaultMessageGap;  ///< uSeconds (Guess only)
 const uint16_t kSanyoAcFreq = 38000;  ///< Hz. (Guess only)
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchSanyoAcHdrMark == kSanyoAcHdrMark,
+              "See IRrecvTimings.h");
+
 #if SEND_SANYO
 /// Construct a Sanyo LC7461 message.
 /// @param[in] address The 13 bit value of the address(Custom) portion of the
@@ -651,14 +656,14 @@ stdAc::state_t IRSanyoAc::toCommon(void) {
 String IRSanyoAc::toString(void) {
   String result = "";
   result.reserve(140);
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kSanyoAcAuto, kSanyoAcCool,
-                            kSanyoAcHeat, kSanyoAcDry, kSanyoAcAuto);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kSanyoAcFanHigh, kSanyoAcFanLow,
-                           kSanyoAcFanAuto, kSanyoAcFanAuto,
-                           kSanyoAcFanMedium);
-  result += addIntToString(getSwingV(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kSanyoAcAuto, kSanyoAcCool,
+                  kSanyoAcHeat, kSanyoAcDry, kSanyoAcAuto);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kSanyoAcFanHigh, kSanyoAcFanLow,
+                 kSanyoAcFanAuto, kSanyoAcFanAuto,
+                 kSanyoAcFanMedium);
+  addIntToString(&result, getSwingV(), kSwingVStr);
   result += kSpaceLBraceStr;
   switch (getSwingV()) {
     case kSanyoAcSwingVHighest: result += kHighestStr; break;
@@ -679,15 +684,15 @@ String IRSanyoAc::toString(void) {
     default:                    result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getBeep(), kBeepStr);
-  result += addLabeledString(getSensor() ? kRoomStr : kWallStr, kSensorStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getBeep(), kBeepStr);
+  addLabeledString(&result, getSensor() ? kRoomStr : kWallStr, kSensorStr);
   result += kCommaSpaceStr;
   result += kSensorStr;
   result += ' ';
-  result += addTempToString(getSensorTemp(), true, false);
+  addTempToString(&result, getSensorTemp(), true, false);
   const uint16_t offtime =  getOffTimer();
-  result += addLabeledString(offtime ? minsToString(offtime) : kOffStr,
-                             kOffTimerStr);
+  addLabeledString(&result, offtime ? minsToString(offtime) : kOffStr,
+                   kOffTimerStr);
   return result;
 }
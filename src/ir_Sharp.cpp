@@ -18,6 +18,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -49,6 +50,10 @@ using irutils::minsToString;
 using irutils::setBit;
 using irutils::setBits;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchSharpAcHdrMark == kSharpAcHdrMark,
+              "See IRrecvTimings.h");
+
 // Also used by Denon protocol
 #if (SEND_SHARP || SEND_DENON)
 /// Send a (raw) Sharp message
@@ -139,6 +144,41 @@ void IRsend::sendSharp(const uint16_t address, uint16_t const command,
 
 // Used by decodeDenon too.
 #if (DECODE_SHARP || DECODE_DENON)
+/// Match the data & footer of a Sharp message.
+/// Denon's 15-bit messages are Sharp ones that only differ by the expansion
+/// bit. So inside `decode()` the match of the normal sized message is kept, &
+/// shared by each of them at the same offset.
+/// @param[in] results Ptr to the data to match.
+/// @param[in] offset The starting index of the data in the raw data.
+/// @param[in] nbits The number of data bits to expect.
+/// @param[out] data Where to store the matched data bits.
+/// @return The nr. of entries matched. 0 if it didn't match.
+uint16_t IRrecv::_matchSharp(const decode_results *results,
+                             const uint16_t offset, const uint16_t nbits,
+                             uint64_t *data) {
+#if ENABLE_FAMILY_MATCH_CACHE
+  const bool cacheable = _family_cache && nbits == kSharpBits;
+  if (cacheable && _sharp_offset == offset) {
+    *data = _sharp_data;
+    return _sharp_used;
+  }
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+  const uint16_t used = matchGeneric(results->rawbuf + offset, data,
+                                     results->rawlen - offset, nbits,
+                                     0, 0,  // No Header
+                                     kSharpBitMark, kSharpOneSpace,
+                                     kSharpBitMark, kSharpZeroSpace,
+                                     kSharpBitMark, kSharpGap, true, 35);
+#if ENABLE_FAMILY_MATCH_CACHE
+  if (cacheable) {
+    _sharp_offset = offset;
+    _sharp_used = used;
+    _sharp_data = *data;
+  }
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+  return used;
+}
+
 /// Decode the supplied Sharp message.
 /// Status: STABLE / Working fine.
 /// @param[in,out] results Ptr to the data to decode & where to store the result
@@ -156,7 +196,7 @@ void IRsend::sendSharp(const uint16_t address, uint16_t const command,
 bool IRrecv::decodeSharp(decode_results *results, uint16_t offset,
                          const uint16_t nbits, const bool strict,
                          const bool expansion) {
-  if (results->rawlen <= 2 * nbits + kFooter - 1 + offset)
+  if (results->rawlen < 2 * nbits + kFooter - 1 + offset)
     return false;  // Not enough entries to be a Sharp message.
   // Compliance
   if (strict) {
@@ -165,7 +205,7 @@ bool IRrecv::decodeSharp(decode_results *results, uint16_t offset,
 #ifdef UNIT_TEST
     // An in spec message has the data sent normally, then inverted. So we
     // expect twice as many entries than to just get the results.
-    if (results->rawlen <= (2 * (2 * nbits + kFooter)) - 1 + offset)
+    if (results->rawlen < (2 * (2 * nbits + kFooter)) - 1 + offset)
       return false;
 #endif
   }
@@ -173,13 +213,7 @@ bool IRrecv::decodeSharp(decode_results *results, uint16_t offset,
   uint64_t data = 0;
 
   // Match Data + Footer
-  uint16_t used;
-  used = matchGeneric(results->rawbuf + offset, &data,
-                      results->rawlen - offset, nbits,
-                      0, 0,  // No Header
-                      kSharpBitMark, kSharpOneSpace,
-                      kSharpBitMark, kSharpZeroSpace,
-                      kSharpBitMark, kSharpGap, true, 35);
+  uint16_t used = _matchSharp(results, offset, nbits, &data);
   if (!used) return false;
   offset += used;
   // Compliance
@@ -190,17 +224,14 @@ bool IRrecv::decodeSharp(decode_results *results, uint16_t offset,
     if (data & 0b1) return false;
       // DISABLED - See TODO
 #ifdef UNIT_TEST
-    // Grab the second copy of the data (i.e. inverted)
-    uint64_t second_data = 0;
+    // Check the second copy of the data is inverted correctly.
     // Match Data + Footer
-    if (!matchGeneric(results->rawbuf + offset, &second_data,
-                      results->rawlen - offset, nbits,
-                      0, 0,
-                      kSharpBitMark, kSharpOneSpace,
-                      kSharpBitMark, kSharpZeroSpace,
-                      kSharpBitMark, kSharpGap, true, 35)) return false;
-    // Check that second_data has been inverted correctly.
-    if (data != (second_data ^ kSharpToggleMask)) return false;
+    if (!matchRepeat(results->rawbuf + offset, data ^ kSharpToggleMask,
+                     results->rawlen - offset, nbits,
+                     0, 0,
+                     kSharpBitMark, kSharpOneSpace,
+                     kSharpBitMark, kSharpZeroSpace,
+                     kSharpBitMark, kSharpGap, true, 35)) return false;
 #endif  // UNIT_TEST
   }
 
@@ -288,6 +319,7 @@ void IRSharpAc::stateReset(void) {
       0xAA, 0x5A, 0xCF, 0x10, 0x00, 0x01, 0x00, 0x00, 0x08, 0x80, 0x00, 0xE0,
       0x01};
   memcpy(remote, reset, kSharpAcStateLength);
+  stateChanged();
   _temp = getTemp();
   _mode = getMode();
   _fan = getFan();
@@ -296,7 +328,8 @@ void IRSharpAc::stateReset(void) {
 /// Get a PTR to the internal state/code for this protocol.
 /// @return PTR to a code for this protocol based on the current internal state.
 uint8_t *IRSharpAc::getRaw(void) {
-  this->checksum();  // Ensure correct settings before sending.
+  // Ensure correct settings before sending.
+  if (checksumStale()) this->checksum();
   return remote;
 }
 
@@ -304,12 +337,14 @@ uint8_t *IRSharpAc::getRaw(void) {
 /// @param[in] new_code A valid code for this protocol.
 /// @param[in] length The length/size of the new_code array.
 void IRSharpAc::setRaw(const uint8_t new_code[], const uint16_t length) {
+  stateChanged();
   memcpy(remote, new_code, std::min(length, kSharpAcStateLength));
 }
 
 /// Set the value of the Power Special setting without any checks.
 /// @param[in] value The value to set Power Special to.
 void IRSharpAc::setPowerSpecial(const uint8_t value) {
+  stateChanged();
   setBits(&remote[kSharpAcBytePowerSpecial], kSharpAcPowerSetSpecialOffset,
           kSharpAcPowerSpecialSize, value);
 }
@@ -324,6 +359,7 @@ uint8_t IRSharpAc::getPowerSpecial(void) {
 /// Clear the "special"/non-normal bits in the power section.
 /// e.g. for normal/common command modes.
 void IRSharpAc::clearPowerSpecial(void) {
+  stateChanged();
   setPowerSpecial(getPowerSpecial() & kSharpAcPowerOn);
 }
 
@@ -348,6 +384,7 @@ void IRSharpAc::off(void) { setPower(false); }
 /// @param[in] on true, the setting is on. false, the setting is off.
 /// @param[in] prev_on true, the setting is on. false, the setting is off.
 void IRSharpAc::setPower(const bool on, const bool prev_on) {
+  stateChanged();
   setPowerSpecial(on ? (prev_on ? kSharpAcPowerOn : kSharpAcPowerOnFromOff)
                      : kSharpAcPowerOff);
   // Power operations are incompatible with clean mode.
@@ -368,6 +405,7 @@ bool IRSharpAc::getPower(void) {
 /// Set the value of the Special (button/command?) setting.
 /// @param[in] mode The value to set Special to.
 void IRSharpAc::setSpecial(const uint8_t mode) {
+  stateChanged();
   switch (mode) {
     case kSharpAcSpecialPower:
     case kSharpAcSpecialTurbo:
@@ -391,6 +429,7 @@ uint8_t IRSharpAc::getSpecial(void) { return remote[kSharpAcByteSpecial]; }
 /// @param[in] temp The temperature in degrees celsius.
 /// @param[in] save Do we save this setting as a user set one?
 void IRSharpAc::setTemp(const uint8_t temp, const bool save) {
+  stateChanged();
   switch (this->getMode()) {
     // Auto & Dry don't allow temp changes and have a special temp.
     case kSharpAcAuto:
@@ -426,6 +465,7 @@ uint8_t IRSharpAc::getMode(void) {
 /// @param[in] mode The desired operating mode.
 /// @param[in] save Do we save this setting as a user set one?
 void IRSharpAc::setMode(const uint8_t mode, const bool save) {
+  stateChanged();
   switch (mode) {
     case kSharpAcAuto:
     case kSharpAcDry:
@@ -453,6 +493,7 @@ void IRSharpAc::setMode(const uint8_t mode, const bool save) {
 /// @param[in] speed The desired setting.
 /// @param[in] save Do we save this setting as a user set one?
 void IRSharpAc::setFan(const uint8_t speed, const bool save) {
+  stateChanged();
   switch (speed) {
     case kSharpAcFanAuto:
     case kSharpAcFanMin:
@@ -490,6 +531,7 @@ bool IRSharpAc::getTurbo(void) {
 ///   other changes to the settings, as they may overwrite some of the bits
 ///   used by this setting.
 void IRSharpAc::setTurbo(const bool on) {
+  stateChanged();
   if (on) setFan(kSharpAcFanMax);
   setPowerSpecial(on ? kSharpAcPowerSetSpecialOn : kSharpAcPowerSetSpecialOff);
   setSpecial(kSharpAcSpecialTurbo);
@@ -505,6 +547,7 @@ bool IRSharpAc::getSwingToggle(void) {
 /// Set the (vertical) Swing Toggle setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRSharpAc::setSwingToggle(const bool on) {
+  stateChanged();
   setBits(&remote[kSharpAcByteSwing], kSharpAcSwingOffset, kSharpAcSwingSize,
           on ? kSharpAcSwingToggle : kSharpAcSwingNoToggle);
   if (on) setSpecial(kSharpAcSpecialSwing);
@@ -519,6 +562,7 @@ bool IRSharpAc::getIon(void) {
 /// Set the Ion (Filter) setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRSharpAc::setIon(const bool on) {
+  stateChanged();
   setBit(&remote[kSharpAcByteIon], kSharpAcBitIonOffset, on);
   clearPowerSpecial();
   if (on) setSpecial(kSharpAcSpecialSwing);
@@ -535,6 +579,7 @@ bool IRSharpAc::getEconoToggle(void) {
 /// @param[in] on true, the setting is on. false, the setting is off.
 /// @warning Probably incompatible with `setTurbo()`
 void IRSharpAc::setEconoToggle(const bool on) {
+  stateChanged();
   if (on) setSpecial(kSharpAcSpecialTempEcono);
   setPowerSpecial(on ? kSharpAcPowerSetSpecialOn : kSharpAcPowerSetSpecialOff);
 }
@@ -566,6 +611,7 @@ bool IRSharpAc::getTimerType(void) {
 /// @param[in] mins Nr. of minutes the timer is to be set to.
 /// @note Rounds down to 30 min increments. (max: 720 mins (12h), 0 is Off)
 void IRSharpAc::setTimer(bool enable, bool timer_type, uint16_t mins) {
+  stateChanged();
   uint8_t half_hours = std::min(mins / kSharpAcTimerIncrement,
                                 kSharpAcTimerHoursMax * 2);
   if (half_hours == 0) enable = false;
@@ -593,6 +639,7 @@ bool IRSharpAc::getClean(void) {
 /// @param[in] on true, the setting is on. false, the setting is off.
 /// @note Officially A/C unit needs to be "Off" before clean mode can be entered
 void IRSharpAc::setClean(const bool on) {
+  stateChanged();
   // Clean mode appears to be just default dry mode, with an extra bit set.
   if (on) {
     setMode(kSharpAcDry, false);
@@ -690,22 +737,22 @@ stdAc::state_t IRSharpAc::toCommon(void) {
 String IRSharpAc::toString(void) {
   String result = "";
   result.reserve(135);  // Reserve some heap for the string to reduce fragging.
-  result += addLabeledString(isPowerSpecial() ? "-"
+  addLabeledString(&result, isPowerSpecial() ? "-"
                                               : (getPower() ? kOnStr : kOffStr),
-                             kPowerStr, false);
-  result += addModeToString(getMode(), kSharpAcAuto, kSharpAcCool, kSharpAcHeat,
-                            kSharpAcDry, kSharpAcAuto);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kSharpAcFanMax, kSharpAcFanMin,
-                           kSharpAcFanAuto, kSharpAcFanAuto, kSharpAcFanMed);
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getSwingToggle(), kSwingVToggleStr);
-  result += addBoolToString(getIon(), kIonStr);
-  result += addLabeledString(getEconoToggle() ? kToggleStr : "-", kEconoStr);
-  result += addBoolToString(getClean(), kCleanStr);
+                   kPowerStr, false);
+  addModeToString(&result, getMode(), kSharpAcAuto, kSharpAcCool, kSharpAcHeat,
+                  kSharpAcDry, kSharpAcAuto);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kSharpAcFanMax, kSharpAcFanMin,
+                 kSharpAcFanAuto, kSharpAcFanAuto, kSharpAcFanMed);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getSwingToggle(), kSwingVToggleStr);
+  addBoolToString(&result, getIon(), kIonStr);
+  addLabeledString(&result, getEconoToggle() ? kToggleStr : "-", kEconoStr);
+  addBoolToString(&result, getClean(), kCleanStr);
   if (getTimerEnabled())
-    result += addLabeledString(minsToString(getTimerTime()),
-                               getTimerType() ? kOnTimerStr : kOffTimerStr);
+    addLabeledString(&result, minsToString(getTimerTime()),
+                     getTimerType() ? kOnTimerStr : kOffTimerStr);
   return result;
 }
 
@@ -105,7 +105,7 @@ const uint8_t kSharpAcBitIonOffset = 2;  // Mask 0b00000x00
 
 // Classes
 /// Class for handling detailed Sharp A/C messages.
-class IRSharpAc {
+class IRSharpAc : private irutils::LazyChecksum {
  public:
   explicit IRSharpAc(const uint16_t pin, const bool inverted = false,
                      const bool use_modulation = true);
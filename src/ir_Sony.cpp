@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -35,6 +36,9 @@ const uint16_t kSonyMinGap = kSonyMinGapTicks * kSonyTick;
 const uint16_t kSonyStdFreq = 40000;  // kHz
 const uint16_t kSonyAltFreq = 38000;  // kHz
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchSonyHdrMark == kSonyHdrMark, "See IRrecvTimings.h");
+
 #if SEND_SONY
 /// Send a standard Sony/SIRC(Serial Infra-Red Control) message. (40kHz)
 /// Status: STABLE / Known working.
@@ -70,12 +74,40 @@ void IRsend::sendSony38(const uint64_t data, const uint16_t nbits,
 /// @param[in] nbits The number of bits of message to be sent.
 /// @param[in] repeat The number of times the command is to be repeated.
 /// @param[in] freq Frequency of the modulation to transmit at. (Hz or kHz)
+/// @note The 12, 15 & 20 bit frames are encoded once, and then replayed for
+///   each repeat.
 void IRsend::_sendSony(const uint64_t data, const uint16_t nbits,
                        const uint16_t repeat, const uint16_t freq) {
-  sendGeneric(kSonyHdrMark, kSonySpace, kSonyOneMark, kSonySpace, kSonyZeroMark,
-              kSonySpace,
-              0,  // No Footer mark.
-              kSonyMinGap, kSonyRptLength, data, nbits, freq, true, repeat, 33);
+  if (nbits > kSony20Bits) {  // Too big to pre-encode. Do it the slow way.
+    sendGeneric(kSonyHdrMark, kSonySpace, kSonyOneMark, kSonySpace,
+                kSonyZeroMark, kSonySpace,
+                0,  // No Footer mark.
+                kSonyMinGap, kSonyRptLength, data, nbits, freq, true, repeat,
+                33);
+    return;
+  }
+  // Every space in a Sony frame is the same, so only the marks are needed.
+  uint16_t marks[kSony20Bits + 1];
+  marks[0] = kSonyHdrMark;
+  for (uint16_t i = 1; i <= nbits; i++)  // MSB first.
+    marks[i] = (data >> (nbits - i)) & 1 ? kSonyOneMark : kSonyZeroMark;
+  // Setup
+  enableIROut(freq, 33);
+  IRtimer usecs = IRtimer();
+  // We always send a message, even for repeat=0, hence '<= repeat'.
+  for (uint16_t r = 0; r <= repeat; r++) {
+    usecs.reset();
+    for (uint16_t i = 0; i <= nbits; i++) {
+      mark(marks[i]);
+      space(kSonySpace);
+    }
+    // No Footer mark.
+    const uint32_t elapsed = usecs.elapsed();
+    if (elapsed >= kSonyRptLength)
+      space(kSonyMinGap);
+    else
+      space(std::max(kSonyMinGap, (uint16_t)(kSonyRptLength - elapsed)));
+  }
 }
 
 /// Convert Sony/SIRC command, address, & extended bits into sendSony format.
@@ -108,6 +140,46 @@ uint32_t IRsend::encodeSony(const uint16_t nbits, const uint16_t command,
 #endif  // SEND_SONY
 
 #if DECODE_SONY
+/// Match a single Sony/SIRC frame, of any length, in one pass.
+/// i.e. Its length is found from where the gap after it is.
+/// @param[in] results Ptr to the data to match.
+/// @param[in] offset The starting index of the frame's header mark.
+/// @param[out] data Where to store the data bits of the frame.
+/// @param[out] nbits Where to store the nr. of data bits of the frame.
+/// @return The nr. of entries used, including the gap. 0 if it didn't match.
+uint16_t IRrecv::_matchSonyFrame(const decode_results *results,
+                                 uint16_t offset, uint64_t *data,
+                                 uint16_t *nbits) {
+  const uint16_t start = offset;
+  *data = 0;
+  *nbits = 0;
+  // Header
+  if (offset >= results->rawlen ||
+      !matchMark(results->rawbuf[offset], kSonyHdrMark)) return 0;
+  // Calculate how long the common tick time is based on the header mark.
+  uint32_t tick = results->rawbuf[offset++] * kRawTick / kSonyHdrMarkTicks;
+
+  // Data
+  for (; offset < results->rawlen - 1; (*nbits)++, offset++) {
+    // The gap after a Sony packet for a repeat should be kSonyMinGap according
+    // to the spec.
+    if (matchAtLeast(results->rawbuf[offset], kSonyMinGapTicks * tick)) {
+      offset++;  // Found a repeat space. It is part of this frame.
+      break;
+    }
+    if (!matchSpace(results->rawbuf[offset++], kSonySpaceTicks * tick))
+      return 0;
+    if (matchMark(results->rawbuf[offset], kSonyOneMarkTicks * tick))
+      *data = (*data << 1) | 1;
+    else if (matchMark(results->rawbuf[offset], kSonyZeroMarkTicks * tick))
+      *data <<= 1;
+    else
+      return 0;
+  }
+  // No Footer for Sony.
+  return std::min(offset, results->rawlen) - start;
+}
+
 /// Decode the supplied Sony/SIRC message.
 /// Status: STABLE / Should be working. strict mode is ALPHA / Untested.
 /// @param[in,out] results Ptr to the data to decode & where to store the result
@@ -136,33 +208,29 @@ bool IRrecv::decodeSony(decode_results *results, uint16_t offset,
   }
 
   uint64_t data = 0;
-  uint16_t actualBits;
+  uint16_t actualBits = 0;
 
-  // Header
-  if (!matchMark(results->rawbuf[offset], kSonyHdrMark)) return false;
-  // Calculate how long the common tick time is based on the header mark.
-  uint32_t tick = results->rawbuf[offset++] * kRawTick / kSonyHdrMarkTicks;
+  // The frame's length is wherever the gap after it is.
+  uint16_t used = _matchSonyFrame(results, offset, &data, &actualBits);
+  if (!used) return false;
 
-  // Data
-  for (actualBits = 0; offset < results->rawlen - 1; actualBits++, offset++) {
-    // The gap after a Sony packet for a repeat should be kSonyMinGap according
-    // to the spec.
-    if (matchAtLeast(results->rawbuf[offset], kSonyMinGapTicks * tick))
-      break;  // Found a repeat space.
-    if (!matchSpace(results->rawbuf[offset++], kSonySpaceTicks * tick))
-      return false;
-    if (matchMark(results->rawbuf[offset], kSonyOneMarkTicks * tick))
-      data = (data << 1) | 1;
-    else if (matchMark(results->rawbuf[offset], kSonyZeroMarkTicks * tick))
-      data <<= 1;
-    else
+  // Compliance
+  if (strict) {
+    if (actualBits != nbits) return false;  // We got the wrong number of bits.
+    // Sony remotes send each frame at least 3 times. Any other copies in the
+    // capture have to be the same as the first one.
+    for (offset += used; offset < results->rawlen - 1; offset += used) {
+      uint64_t copy = 0;
+      uint16_t copyBits = 0;
+      used = _matchSonyFrame(results, offset, &copy, &copyBits);
+      if (used && copyBits == actualBits && copy == data) continue;
+      // Allow for the last copy being cut short by the end of the capture.
+      if (used && offset + used >= results->rawlen - 1 &&
+          copyBits < actualBits &&
+          (data >> (actualBits - copyBits)) == copy) break;
       return false;
+    }
   }
-  // No Footer for Sony.
-
-  // Compliance
-  if (strict && actualBits != nbits)
-    return false;  // We got the wrong number of bits.
 
   // Success
   results->bits = actualBits;
@@ -93,12 +93,13 @@ void IRTcl112Ac::stateReset(void) {
       0x23, 0xCB, 0x26, 0x01, 0x00, 0x24, 0x03, 0x07, 0x40, 0x00, 0x00, 0x00,
       0x00, 0x03};
   memcpy(remote_state, reset, kTcl112AcStateLength);
+  stateChanged();
 }
 
 /// Get a PTR to the internal state/code for this protocol.
 /// @return PTR to a code for this protocol based on the current internal state.
 uint8_t* IRTcl112Ac::getRaw(void) {
-  this->checksum();
+  if (checksumStale()) this->checksum();
   return remote_state;
 }
 
@@ -106,6 +107,7 @@ uint8_t* IRTcl112Ac::getRaw(void) {
 /// @param[in] new_code A valid code for this protocol.
 /// @param[in] length The length/size of the new_code array.
 void IRTcl112Ac::setRaw(const uint8_t new_code[], const uint16_t length) {
+  stateChanged();
   memcpy(remote_state, new_code, std::min(length, kTcl112AcStateLength));
 }
 
@@ -118,6 +120,7 @@ void IRTcl112Ac::off(void) { this->setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setPower(const bool on) {
+  stateChanged();
   setBit(&remote_state[5], kTcl112AcPowerOffset, on);
 }
 
@@ -138,6 +141,7 @@ uint8_t IRTcl112Ac::getMode(void) {
 /// @note Fan/Ventilation mode sets the fan speed to high.
 ///   Unknown values default to Auto.
 void IRTcl112Ac::setMode(const uint8_t mode) {
+  stateChanged();
   // If we get an unexpected mode, default to AUTO.
   switch (mode) {
     case kTcl112AcFan:
@@ -158,24 +162,40 @@ void IRTcl112Ac::setMode(const uint8_t mode) {
 /// @param[in] celsius The temperature in degrees celsius.
 /// @note The temperature resolution is 0.5 of a degree.
 void IRTcl112Ac::setTemp(const float celsius) {
+  stateChanged();
+  // Bound it first so the fixed-point conversion can't overflow.
+  setTempTenths(std::min(std::max(celsius, kTcl112AcTempMin - 1),
+                         kTcl112AcTempMax + 1) * 10);
+}
+
+/// Set the temperature in fixed-point, i.e. without any float maths.
+/// @param[in] tenths The temperature in tenths of a degree celsius.
+/// @note The temperature resolution is 0.5 of a degree. e.g. 235 is 23.5C
+void IRTcl112Ac::setTempTenths(const int16_t tenths) {
+  stateChanged();
   // Make sure we have desired temp in the correct range.
-  float safecelsius = std::max(celsius, kTcl112AcTempMin);
-  safecelsius = std::min(safecelsius, kTcl112AcTempMax);
+  int16_t safetenths = std::max(tenths, kTcl112AcTempMinTenths);
+  safetenths = std::min(safetenths, kTcl112AcTempMaxTenths);
   // Convert to integer nr. of half degrees.
-  uint8_t nrHalfDegrees = safecelsius * 2;
+  uint8_t nrHalfDegrees = safetenths / 5;
   // Do we have a half degree celsius?
   setBit(&remote_state[12], kTcl112AcHalfDegreeOffset, nrHalfDegrees & 1);
   setBits(&remote_state[7], kLowNibble, kNibbleSize,
-          (uint8_t)kTcl112AcTempMax - nrHalfDegrees / 2);
+          kTcl112AcTempMaxTenths / 10 - nrHalfDegrees / 2);
 }
 
 /// Get the current temperature setting.
 /// @return The current setting for temp. in degrees celsius.
 /// @note The temperature resolution is 0.5 of a degree.
-float IRTcl112Ac::getTemp(void) {
-  float result = kTcl112AcTempMax - GETBITS8(remote_state[7], kLowNibble,
-                                             kNibbleSize);
-  if (GETBIT8(remote_state[12], kTcl112AcHalfDegreeOffset)) result += 0.5;
+float IRTcl112Ac::getTemp(void) { return getTempTenths() / 10.0; }
+
+/// Get the current temperature setting in fixed-point.
+/// @return The current setting for temp. in tenths of a degree celsius.
+/// @note The temperature resolution is 0.5 of a degree.
+int16_t IRTcl112Ac::getTempTenths(void) {
+  int16_t result = kTcl112AcTempMaxTenths -
+      GETBITS8(remote_state[7], kLowNibble, kNibbleSize) * 10;
+  if (GETBIT8(remote_state[12], kTcl112AcHalfDegreeOffset)) result += 5;
   return result;
 }
 
@@ -183,6 +203,7 @@ float IRTcl112Ac::getTemp(void) {
 /// @param[in] speed The desired setting.
 /// @note Unknown speeds will default to Auto.
 void IRTcl112Ac::setFan(const uint8_t speed) {
+  stateChanged();
   switch (speed) {
     case kTcl112AcFanAuto:
     case kTcl112AcFanLow:
@@ -204,6 +225,7 @@ uint8_t IRTcl112Ac::getFan(void) {
 /// Set the economy setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setEcono(const bool on) {
+  stateChanged();
   setBit(&remote_state[5], kTcl112AcBitEconoOffset, on);
 }
 
@@ -216,6 +238,7 @@ bool IRTcl112Ac::getEcono(void) {
 /// Set the Health (Filter) setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setHealth(const bool on) {
+  stateChanged();
   setBit(&remote_state[6], kTcl112AcBitHealthOffset, on);
 }
 
@@ -228,6 +251,7 @@ bool IRTcl112Ac::getHealth(void) {
 /// Set the Light (LED/Display) setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setLight(const bool on) {
+  stateChanged();
   setBit(&remote_state[5], kTcl112AcBitLightOffset, !on);  // Cleared when on.
 }
 
@@ -240,6 +264,7 @@ bool IRTcl112Ac::getLight(void) {
 /// Set the horizontal swing setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setSwingHorizontal(const bool on) {
+  stateChanged();
   setBit(&remote_state[12], kTcl112AcBitSwingHOffset, on);
 }
 
@@ -252,6 +277,7 @@ bool IRTcl112Ac::getSwingHorizontal(void) {
 /// Set the vertical swing setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setSwingVertical(const bool on) {
+  stateChanged();
   setBits(&remote_state[8], kTcl112AcSwingVOffset, kTcl112AcSwingVSize,
           on ? kTcl112AcSwingVOn : kTcl112AcSwingVOff);
 }
@@ -265,6 +291,7 @@ bool IRTcl112Ac::getSwingVertical(void) {
 /// Set the Turbo setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTcl112Ac::setTurbo(const bool on) {
+  stateChanged();
   setBit(&remote_state[6], kTcl112AcBitTurboOffset, on);
   if (on) {
     this->setFan(kTcl112AcFanHigh);
@@ -363,21 +390,21 @@ stdAc::state_t IRTcl112Ac::toCommon(void) {
 String IRTcl112Ac::toString(void) {
   String result = "";
   result.reserve(140);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kTcl112AcAuto, kTcl112AcCool,
-                            kTcl112AcHeat, kTcl112AcDry, kTcl112AcFan);
-  uint16_t nrHalfDegrees = this->getTemp() * 2;
-  result += addIntToString(nrHalfDegrees / 2, kTempStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kTcl112AcAuto, kTcl112AcCool,
+                  kTcl112AcHeat, kTcl112AcDry, kTcl112AcFan);
+  uint16_t nrHalfDegrees = this->getTempTenths() / 5;
+  addIntToString(&result, nrHalfDegrees / 2, kTempStr);
   if (nrHalfDegrees & 1) result += F(".5");
   result += 'C';
-  result += addFanToString(getFan(), kTcl112AcFanHigh, kTcl112AcFanLow,
-                           kTcl112AcFanAuto, kTcl112AcFanAuto, kTcl112AcFanMed);
-  result += addBoolToString(getEcono(), kEconoStr);
-  result += addBoolToString(getHealth(), kHealthStr);
-  result += addBoolToString(getLight(), kLightStr);
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getSwingHorizontal(), kSwingHStr);
-  result += addBoolToString(getSwingVertical(), kSwingVStr);
+  addFanToString(&result, getFan(), kTcl112AcFanHigh, kTcl112AcFanLow,
+                 kTcl112AcFanAuto, kTcl112AcFanAuto, kTcl112AcFanMed);
+  addBoolToString(&result, getEcono(), kEconoStr);
+  addBoolToString(&result, getHealth(), kHealthStr);
+  addBoolToString(&result, getLight(), kLightStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getSwingHorizontal(), kSwingHStr);
+  addBoolToString(&result, getSwingVertical(), kSwingVStr);
   return result;
 }
 
@@ -46,6 +46,8 @@ const uint8_t kTcl112AcFanHigh = 0b101;
 const uint8_t kTcl112AcHalfDegreeOffset = 5;
 const float   kTcl112AcTempMax    = 31.0;
 const float   kTcl112AcTempMin    = 16.0;
+const int16_t kTcl112AcTempMaxTenths = kTcl112AcTempMax * 10;
+const int16_t kTcl112AcTempMinTenths = kTcl112AcTempMin * 10;
 
 const uint8_t kTcl112AcPowerOffset = 2;
 const uint8_t kTcl112AcBitEconoOffset = 7;
@@ -60,7 +62,7 @@ const uint8_t kTcl112AcBitTurboOffset = 6;
 
 // Classes
 /// Class for handling detailed TCL A/C messages.
-class IRTcl112Ac {
+class IRTcl112Ac : private irutils::LazyChecksum {
  public:
   explicit IRTcl112Ac(const uint16_t pin, const bool inverted = false,
                       const bool use_modulation = true);
@@ -83,6 +85,8 @@ class IRTcl112Ac {
   bool getPower(void);
   void setTemp(const float celsius);  // Celsius in 0.5 increments
   float getTemp(void);
+  void setTempTenths(const int16_t tenths);
+  int16_t getTempTenths(void);
   void setMode(const uint8_t mode);
   uint8_t getMode(void);
   static uint8_t calcChecksum(uint8_t state[],
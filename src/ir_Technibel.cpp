@@ -5,6 +5,7 @@
 
 #include "ir_Technibel.h"
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -28,6 +29,10 @@ const uint32_t kTechnibelAcGap = kDefaultMessageGap;
 const uint16_t kTechnibelAcFreq = 38000;
 const uint16_t kTechnibelAcOverhead = 3;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchTechnibelAcHdrMark == kTechnibelAcHdrMark,
+              "See IRrecvTimings.h");
+
 
 #if SEND_TECHNIBEL_AC
 /// Send an Technibel AC formatted message.
@@ -434,20 +439,20 @@ stdAc::state_t IRTechnibelAc::toCommon(void) {
 String IRTechnibelAc::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kTechnibelAcCool, kTechnibelAcCool,
-                            kTechnibelAcHeat, kTechnibelAcDry,
-                            kTechnibelAcFan);
-  result += addFanToString(getFan(), kTechnibelAcFanHigh, kTechnibelAcFanLow,
-                           kTechnibelAcFanLow, kTechnibelAcFanLow,
-                           kTechnibelAcFanMedium);
-  result += addTempToString(getTemp(), !getTempUnit());
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getSwing(), kSwingVStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kTechnibelAcCool, kTechnibelAcCool,
+                  kTechnibelAcHeat, kTechnibelAcDry,
+                  kTechnibelAcFan);
+  addFanToString(&result, getFan(), kTechnibelAcFanHigh, kTechnibelAcFanLow,
+                 kTechnibelAcFanLow, kTechnibelAcFanLow,
+                 kTechnibelAcFanMedium);
+  addTempToString(&result, getTemp(), !getTempUnit());
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getSwing(), kSwingVStr);
   if (getTimerEnabled())
-    result += addLabeledString(irutils::minsToString(getTimer()),
-                               kTimerStr);
+    addLabeledString(&result, irutils::minsToString(getTimer()),
+                     kTimerStr);
   else
-    result += addBoolToString(false, kTimerStr);
+    addBoolToString(&result, false, kTimerStr);
   return result;
 }
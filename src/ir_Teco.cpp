@@ -5,6 +5,7 @@
 
 #include "ir_Teco.h"
 #include <algorithm>
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -21,6 +22,9 @@ const uint16_t kTecoOneSpace = 1650;
 const uint16_t kTecoZeroSpace = 580;
 const uint32_t kTecoGap = kDefaultMessageGap;  // Made-up value. Just a guess.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchTecoHdrMark == kTecoHdrMark, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -334,22 +338,22 @@ stdAc::state_t IRTecoAc::toCommon(void) {
 String IRTecoAc::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kTecoAuto, kTecoCool, kTecoHeat,
-                            kTecoDry, kTecoFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kTecoFanHigh, kTecoFanLow,
-                           kTecoFanAuto, kTecoFanAuto, kTecoFanMed);
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getSwing(), kSwingStr);
-  result += addBoolToString(getLight(), kLightStr);
-  result += addBoolToString(getHumid(), kHumidStr);
-  result += addBoolToString(getSave(), kSaveStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kTecoAuto, kTecoCool, kTecoHeat,
+                  kTecoDry, kTecoFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kTecoFanHigh, kTecoFanLow,
+                 kTecoFanAuto, kTecoFanAuto, kTecoFanMed);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getSwing(), kSwingStr);
+  addBoolToString(&result, getLight(), kLightStr);
+  addBoolToString(&result, getHumid(), kHumidStr);
+  addBoolToString(&result, getSave(), kSaveStr);
   if (getTimerEnabled())
-    result += addLabeledString(irutils::minsToString(getTimer()),
-                               kTimerStr);
+    addLabeledString(&result, irutils::minsToString(getTimer()),
+                     kTimerStr);
   else
-    result += addBoolToString(false, kTimerStr);
+    addBoolToString(&result, false, kTimerStr);
   return result;
 }
 
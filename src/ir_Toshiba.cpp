@@ -15,6 +15,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -29,6 +30,10 @@ const uint16_t kToshibaAcOneSpace = 1600;
 const uint16_t kToshibaAcZeroSpace = 490;
 const uint16_t kToshibaAcMinGap = 7400;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchToshibaAcHdrMark == kToshibaAcHdrMark,
+              "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -94,6 +99,32 @@ void IRToshibaAC::send(const uint16_t repeat) {
   }
   _send_swing = false;
 }
+
+/// Send only the current internal state as an IR message. i.e. Without the
+/// separate swing message, for when the swing setting hasn't changed.
+/// @param[in] repeat Nr. of times the message will be repeated.
+void IRToshibaAC::sendState(const uint16_t repeat) {
+  _irsend.sendToshibaAC(getRaw(), getStateLength(), repeat);
+  _send_swing = false;
+}
+
+/// Send only the short swing IR message. i.e. Just change the swing setting.
+/// @param[in] setting The swing setting to send.
+/// @param[in] repeat Nr. of times the message will be repeated.
+/// @note The swing setting in the internal state is left unchanged.
+void IRToshibaAC::sendSwing(const uint8_t setting, const uint16_t repeat) {
+  const uint8_t swing_mode = _swing_mode;
+  const bool send_swing = _send_swing;
+  _backupState();
+  setStateLength(kToshibaACStateLengthShort);
+  // Swing settings expect the min temp to be set.
+  setTemp(kToshibaAcMinTemp);
+  setSwing(setting);
+  _irsend.sendToshibaAC(getRaw(), getStateLength(), repeat);
+  _restoreState();
+  _swing_mode = swing_mode;
+  _send_swing = send_swing;
+}
 #endif  // SEND_TOSHIBA_AC
 
 /// Get the length of the supplied Toshiba state per it's protocol structure.
@@ -431,10 +462,10 @@ stdAc::state_t IRToshibaAC::toCommon(void) {
 String IRToshibaAC::toString(void) {
   String result = "";
   result.reserve(80);
-  result += addTempToString(getTemp(), true, false);
+  addTempToString(&result, getTemp(), true, false);
   switch (getStateLength()) {
     case kToshibaACStateLengthShort:
-      result += addIntToString(getSwing(true), kSwingVStr);
+      addIntToString(&result, getSwing(true), kSwingVStr);
       result += kSpaceLBraceStr;
       switch (getSwing(true)) {
         case kToshibaAcSwingOff: result += kOffStr; break;
@@ -447,15 +478,15 @@ String IRToshibaAC::toString(void) {
     case kToshibaACStateLengthLong:
     case kToshibaACStateLength:
     default:
-      result += addBoolToString(getPower(), kPowerStr);
+      addBoolToString(&result, getPower(), kPowerStr);
       if (getPower())
-        result += addModeToString(getMode(), kToshibaAcAuto, kToshibaAcCool,
-                                  kToshibaAcHeat, kToshibaAcDry, kToshibaAcFan);
-      result += addFanToString(getFan(), kToshibaAcFanMax, kToshibaAcFanMin,
-                               kToshibaAcFanAuto, kToshibaAcFanAuto,
-                               kToshibaAcFanMed);
-      result += addBoolToString(getTurbo(), kTurboStr);
-      result += addBoolToString(getEcono(), kEconoStr);
+        addModeToString(&result, getMode(), kToshibaAcAuto, kToshibaAcCool,
+                        kToshibaAcHeat, kToshibaAcDry, kToshibaAcFan);
+      addFanToString(&result, getFan(), kToshibaAcFanMax, kToshibaAcFanMin,
+                     kToshibaAcFanAuto, kToshibaAcFanAuto,
+                     kToshibaAcFanMed);
+      addBoolToString(&result, getTurbo(), kTurboStr);
+      addBoolToString(&result, getEcono(), kEconoStr);
   }
   return result;
 }
@@ -467,13 +498,16 @@ String IRToshibaAC::toString(void) {
 /// @param[in] offset The starting index to use when attempting to decode the
 ///   raw data. Typically/Defaults to kStartOffset.
 /// @param[in] nbits The number of data bits to expect.
+///   Only used to check it is a legal size when `strict` is set.
 /// @param[in] strict Flag indicating if we should perform strict matching.
 /// @return True if it can decode it, false if it can't.
+/// @note The message length is read from its length byte, so all the legal
+///   sizes are decoded in a single pass.
 bool IRrecv::decodeToshibaAC(decode_results* results, uint16_t offset,
                              const uint16_t nbits, const bool strict) {
   // Compliance
   if (strict) {
-    switch (nbits) {  // Must be called with the correct nr. of bits.
+    switch (nbits) {  // Must be called with a legal nr. of bits.
       case kToshibaACBits:
       case kToshibaACBitsShort:
       case kToshibaACBitsLong:
@@ -482,11 +516,37 @@ bool IRrecv::decodeToshibaAC(decode_results* results, uint16_t offset,
         return false;
     }
   }
-
-  // Match Header + Data + Footer
-  if (!matchGeneric(results->rawbuf + offset, results->state,
-                    results->rawlen - offset, nbits,
-                    kToshibaAcHdrMark, kToshibaAcHdrSpace,
+  if (results->rawlen < 2 * kToshibaACBitsShort + kHeader + kFooter - 1 +
+      offset)
+    return false;  // Too short to be any of the legal sizes.
+
+  // Header + Data up to & including the length byte.
+  const uint16_t kLengthBytes = kToshibaAcLengthByte + 1;
+  uint16_t used = matchGeneric(results->rawbuf + offset, results->state,
+                               results->rawlen - offset, kLengthBytes * 8,
+                               kToshibaAcHdrMark, kToshibaAcHdrSpace,
+                               kToshibaAcBitMark, kToshibaAcOneSpace,
+                               kToshibaAcBitMark, kToshibaAcZeroSpace,
+                               0, 0, false, _tolerance, kMarkExcess);
+  if (!used) return false;
+  offset += used;
+  // We now know how long the message says it is.
+  const uint16_t length = IRToshibaAC::getInternalStateLength(results->state,
+                                                              kLengthBytes);
+  if (strict) {
+    switch (length) {
+      case kToshibaACStateLength:
+      case kToshibaACStateLengthShort:
+      case kToshibaACStateLengthLong:
+        break;
+      default:
+        return false;
+    }
+  }
+  // Rest of the Data + Footer
+  if (!matchGeneric(results->rawbuf + offset, results->state + kLengthBytes,
+                    results->rawlen - offset, (length - kLengthBytes) * 8,
+                    0, 0,
                     kToshibaAcBitMark, kToshibaAcOneSpace,
                     kToshibaAcBitMark, kToshibaAcZeroSpace,
                     kToshibaAcBitMark, kToshibaAcMinGap, true,
@@ -494,12 +554,12 @@ bool IRrecv::decodeToshibaAC(decode_results* results, uint16_t offset,
   // Compliance
   if (strict) {
     // Check that the checksum of the message is correct.
-    if (!IRToshibaAC::validChecksum(results->state, nbits / 8)) return false;
+    if (!IRToshibaAC::validChecksum(results->state, length)) return false;
   }
 
   // Success
   results->decode_type = TOSHIBA_AC;
-  results->bits = nbits;
+  results->bits = length * 8;
   // No need to record the state as we stored it as we decoded it.
   // As we use result->state, we don't record value, address, or command as it
   // is a union data type.
@@ -104,6 +104,9 @@ class IRToshibaAC {
   void stateReset(void);
 #if SEND_TOSHIBA_AC
   void send(const uint16_t repeat = kToshibaACMinRepeat);
+  void sendState(const uint16_t repeat = kToshibaACMinRepeat);
+  void sendSwing(const uint8_t setting,
+                 const uint16_t repeat = kToshibaACMinRepeat);
   /// Run the calibration to calculate uSec timing offsets for this platform.
   /// @return The uSec timing offset needed per modulation of the IR Led.
   /// @note This will produce a 65ms IR signal pulse at 38kHz.
@@ -7,6 +7,7 @@
 //   Brand: Transcold,  Model: M1-F-NO-6 A/C
 
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -18,6 +19,10 @@ const uint16_t kTranscoldOneSpace =  3556;  ///< uSeconds.
 const uint16_t kTranscoldZeroSpace = 1526;  ///< uSeconds.
 const uint16_t kTranscoldFreq =     38000;  ///< Hz.
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchTranscoldHdrMark == kTranscoldHdrMark,
+              "See IRrecvTimings.h");
+
 #if SEND_TRANSCOLD
 /// Send a Transcold formatted message.
 /// Status: BETA / Probably works, needs to be tested on a real device.
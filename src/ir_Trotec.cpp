@@ -12,6 +12,7 @@
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -25,6 +26,9 @@ const uint16_t kTrotecZeroSpace = 592;
 const uint16_t kTrotecGap = 6184;
 const uint16_t kTrotecGapEnd = 1500;  // made up value
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchTrotecHdrMark == kTrotecHdrMark, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -102,6 +106,7 @@ void IRTrotecESP::checksum(void) {
 
 /// Reset the state of the remote to a known good state/sequence.
 void IRTrotecESP::stateReset(void) {
+  stateChanged();
   for (uint8_t i = 2; i < kTrotecStateLength; i++) remote_state[i] = 0x0;
 
   remote_state[0] = kTrotecIntro1;
@@ -116,13 +121,14 @@ void IRTrotecESP::stateReset(void) {
 /// Get a PTR to the internal state/code for this protocol.
 /// @return PTR to a code for this protocol based on the current internal state.
 uint8_t* IRTrotecESP::getRaw(void) {
-  this->checksum();
+  if (checksumStale()) this->checksum();
   return remote_state;
 }
 
 /// Set the internal state from a valid code for this protocol.
 /// @param[in] state A valid code for this protocol.
 void IRTrotecESP::setRaw(const uint8_t state[]) {
+  stateChanged();
   memcpy(remote_state, state, kTrotecStateLength);
 }
 
@@ -135,6 +141,7 @@ void IRTrotecESP::off(void) { this->setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTrotecESP::setPower(const bool on) {
+  stateChanged();
   setBit(&remote_state[2], kTrotecPowerBitOffset, on);
 }
 
@@ -147,6 +154,7 @@ bool IRTrotecESP::getPower(void) {
 /// Set the speed of the fan.
 /// @param[in] fan The desired setting.
 void IRTrotecESP::setSpeed(const uint8_t fan) {
+  stateChanged();
   uint8_t speed = std::min(fan, kTrotecFanHigh);
   setBits(&remote_state[2], kTrotecFanOffset, kTrotecFanSize, speed);
 }
@@ -160,6 +168,7 @@ uint8_t IRTrotecESP::getSpeed(void) {
 /// Set the operating mode of the A/C.
 /// @param[in] mode The desired operating mode.
 void IRTrotecESP::setMode(const uint8_t mode) {
+  stateChanged();
   setBits(&remote_state[2], kTrotecModeOffset, kTrotecModeSize,
           (mode > kTrotecFan) ? kTrotecAuto : mode);
 }
@@ -173,6 +182,7 @@ uint8_t IRTrotecESP::getMode(void) {
 /// Set the temperature.
 /// @param[in] celsius The temperature in degrees celsius.
 void IRTrotecESP::setTemp(const uint8_t celsius) {
+  stateChanged();
   uint8_t temp = std::max(celsius, kTrotecMinTemp);
   temp = std::min(temp, kTrotecMaxTemp);
   setBits(&remote_state[3], kTrotecTempOffset, kTrotecTempSize,
@@ -189,6 +199,7 @@ uint8_t IRTrotecESP::getTemp(void) {
 /// Set the Sleep setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRTrotecESP::setSleep(const bool on) {
+  stateChanged();
   setBit(&remote_state[3], kTrotecSleepBitOffset, on);
 }
 
@@ -201,6 +212,7 @@ bool IRTrotecESP::getSleep(void) {
 /// Set the timer time in nr. of Hours.
 /// @param[in] timer Nr. of Hours. Max is `kTrotecMaxTimer`
 void IRTrotecESP::setTimer(const uint8_t timer) {
+  stateChanged();
   setBit(&remote_state[5], kTrotecTimerBitOffset, timer);
   remote_state[6] = (timer > kTrotecMaxTimer) ? kTrotecMaxTimer : timer;
 }
@@ -291,13 +303,13 @@ stdAc::state_t IRTrotecESP::toCommon(void) {
 String IRTrotecESP::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kTrotecAuto, kTrotecCool, kTrotecAuto,
-                            kTrotecDry, kTrotecFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getSpeed(), kTrotecFanHigh, kTrotecFanLow,
-                           kTrotecFanHigh, kTrotecFanHigh, kTrotecFanMed);
-  result += addBoolToString(getSleep(), kSleepStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kTrotecAuto, kTrotecCool, kTrotecAuto,
+                  kTrotecDry, kTrotecFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getSpeed(), kTrotecFanHigh, kTrotecFanLow,
+                 kTrotecFanHigh, kTrotecFanHigh, kTrotecFanMed);
+  addBoolToString(&result, getSleep(), kSleepStr);
   return result;
 }
 
@@ -312,7 +324,7 @@ String IRTrotecESP::toString(void) {
 /// @return True if it can decode it, false if it can't.
 bool IRrecv::decodeTrotec(decode_results *results, uint16_t offset,
                           const uint16_t nbits, const bool strict) {
-  if (results->rawlen <= 2 * nbits + kHeader + 2 * kFooter - 1 + offset)
+  if (results->rawlen < 2 * nbits + kHeader + 2 * kFooter - 1 + offset)
     return false;  // Can't possibly be a valid Trotec A/C message.
   if (strict && nbits != kTrotecBits) return false;
 
@@ -330,7 +342,7 @@ bool IRrecv::decodeTrotec(decode_results *results, uint16_t offset,
 
   // Footer #2
   if (!matchMark(results->rawbuf[offset++], kTrotecBitMark)) return false;
-  if (offset <= results->rawlen &&
+  if (offset < results->rawlen &&
       !matchAtLeast(results->rawbuf[offset++], kTrotecGapEnd)) return false;
   // Compliance
   // Verify we got a valid checksum.
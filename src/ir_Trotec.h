@@ -73,7 +73,7 @@ const uint8_t kTrotecMaxTimer = 23;
 
 // Class
 /// Class for handling detailed Trotec A/C messages.
-class IRTrotecESP {
+class IRTrotecESP : private irutils::LazyChecksum {
  public:
   explicit IRTrotecESP(const uint16_t pin, const bool inverted = false,
                        const bool use_modulation = true);
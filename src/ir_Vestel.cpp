@@ -11,6 +11,7 @@
 #include <Arduino.h>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
@@ -29,6 +30,10 @@ using irutils::minsToString;
 using irutils::setBit;
 using irutils::setBits;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchVestelAcHdrMark == kVestelAcHdrMark,
+              "See IRrecvTimings.h");
+
 #if SEND_VESTEL_AC
 /// Send a Vestel message
 /// Status: STABLE / Working.
@@ -506,25 +511,25 @@ String IRVestelAc::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
   if (this->isTimeCommand()) {
-    result += addLabeledString(minsToString(getTime()), kClockStr, false);
-    result += addLabeledString(
+    addLabeledString(&result, minsToString(getTime()), kClockStr, false);
+    addLabeledString(&result, 
         isTimerActive() ? minsToString(getTimer()) : kOffStr,
         kTimerStr);
-    result += addLabeledString(
+    addLabeledString(&result, 
         (isOnTimerActive() && !isTimerActive()) ?
           minsToString(this->getOnTimer()) : kOffStr,
         kOnTimerStr);
-    result += addLabeledString(
+    addLabeledString(&result, 
         isOffTimerActive() ? minsToString(getOffTimer()) : kOffStr,
         kOffTimerStr);
     return result;
   }
   // Not a time command, it's a normal command.
-  result += addBoolToString(getPower(), kPowerStr, false);
-  result += addModeToString(getMode(), kVestelAcAuto, kVestelAcCool,
-                            kVestelAcHeat, kVestelAcDry, kVestelAcFan);
-  result += addTempToString(getTemp());
-  result += addIntToString(getFan(), kFanStr);
+  addBoolToString(&result, getPower(), kPowerStr, false);
+  addModeToString(&result, getMode(), kVestelAcAuto, kVestelAcCool,
+                  kVestelAcHeat, kVestelAcDry, kVestelAcFan);
+  addTempToString(&result, getTemp());
+  addIntToString(&result, getFan(), kFanStr);
   result += kSpaceLBraceStr;
   switch (this->getFan()) {
     case kVestelAcFanAuto:
@@ -553,10 +558,10 @@ String IRVestelAc::toString(void) {
       result += kUnknownStr;
   }
   result += ')';
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getTurbo(), kTurboStr);
-  result += addBoolToString(getIon(), kIonStr);
-  result += addBoolToString(getSwing(), kSwingStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getTurbo(), kTurboStr);
+  addBoolToString(&result, getIon(), kIonStr);
+  addBoolToString(&result, getSwing(), kSwingStr);
   return result;
 }
 
@@ -491,26 +491,26 @@ stdAc::state_t IRVoltas::toCommon(const stdAc::state_t *prev) {
 String IRVoltas::toString() {
   String result = "";
   result.reserve(200);  // Reserve some heap for the string to reduce fragging.
-  result += addModelToString(decode_type_t::VOLTAS, getModel(), false);
-  result += addBoolToString(_.Power, kPowerStr);
-  result += addModeToString(_.Mode, 255, kVoltasCool, kVoltasHeat,
-                            kVoltasDry, kVoltasFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(_.FanSpeed, kVoltasFanHigh, kVoltasFanLow,
-                           kVoltasFanAuto, kVoltasFanAuto, kVoltasFanMed);
-  result += addBoolToString(getSwingV(), kSwingVStr);
+  addModelToString(&result, decode_type_t::VOLTAS, getModel(), false);
+  addBoolToString(&result, _.Power, kPowerStr);
+  addModeToString(&result, _.Mode, 255, kVoltasCool, kVoltasHeat,
+                  kVoltasDry, kVoltasFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, _.FanSpeed, kVoltasFanHigh, kVoltasFanLow,
+                 kVoltasFanAuto, kVoltasFanAuto, kVoltasFanMed);
+  addBoolToString(&result, getSwingV(), kSwingVStr);
   if (getSwingHChange())
-    result += addBoolToString(_.SwingH, kSwingHStr);
+    addBoolToString(&result, _.SwingH, kSwingHStr);
   else
-    result += addLabeledString(kNAStr, kSwingHStr);
-  result += addBoolToString(_.Turbo, kTurboStr);
-  result += addBoolToString(_.Econo, kEconoStr);
-  result += addBoolToString(_.Wifi, kWifiStr);
-  result += addBoolToString(_.Light, kLightStr);
-  result += addBoolToString(_.Sleep, kSleepStr);
-  result += addLabeledString(_.OnTimerEnable ? minsToString(getOnTime())
+    addLabeledString(&result, kNAStr, kSwingHStr);
+  addBoolToString(&result, _.Turbo, kTurboStr);
+  addBoolToString(&result, _.Econo, kEconoStr);
+  addBoolToString(&result, _.Wifi, kWifiStr);
+  addBoolToString(&result, _.Light, kLightStr);
+  addBoolToString(&result, _.Sleep, kSleepStr);
+  addLabeledString(&result, _.OnTimerEnable ? minsToString(getOnTime())
                                              : kOffStr, kOnTimerStr);
-  result += addLabeledString(_.OffTimerEnable ? minsToString(getOffTime())
+  addLabeledString(&result, _.OffTimerEnable ? minsToString(getOffTime())
                                               : kOffStr, kOffTimerStr);
   return result;
 }
@@ -15,6 +15,7 @@
 #include <string>
 #endif
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
@@ -30,6 +31,15 @@ const uint16_t kWhirlpoolAcGap = 7920;
 const uint32_t kWhirlpoolAcMinGap = kDefaultMessageGap;  // Just a guess.
 const uint8_t kWhirlpoolAcSections = 3;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchWhirlpoolAcHdrMark == kWhirlpoolAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapWhirlpoolAcHdrMark == kWhirlpoolAcHdrMark,
+              "See IRrecvTimings.h");
+static_assert(kLongGapWhirlpoolAcHdrSpace == kWhirlpoolAcHdrSpace,
+              "See IRrecvTimings.h");
+static_assert(kLongGapWhirlpoolAcGap == kWhirlpoolAcGap, "See IRrecvTimings.h");
+
 using irutils::addBoolToString;
 using irutils::addFanToString;
 using irutils::addIntToString;
@@ -563,26 +573,26 @@ stdAc::state_t IRWhirlpoolAc::toCommon(void) {
 String IRWhirlpoolAc::toString(void) {
   String result = "";
   result.reserve(200);  // Reserve some heap for the string to reduce fragging.
-  result += addModelToString(decode_type_t::WHIRLPOOL_AC, getModel(), false);
-  result += addBoolToString(getPowerToggle(), kPowerToggleStr);
-  result += addModeToString(getMode(), kWhirlpoolAcAuto, kWhirlpoolAcCool,
-                            kWhirlpoolAcHeat, kWhirlpoolAcDry, kWhirlpoolAcFan);
-  result += addTempToString(getTemp());
-  result += addFanToString(getFan(), kWhirlpoolAcFanHigh, kWhirlpoolAcFanLow,
-                           kWhirlpoolAcFanAuto, kWhirlpoolAcFanAuto,
-                           kWhirlpoolAcFanMedium);
-  result += addBoolToString(getSwing(), kSwingStr);
-  result += addBoolToString(getLight(), kLightStr);
-  result += addLabeledString(minsToString(getClock()), kClockStr);
-  result += addLabeledString(
+  addModelToString(&result, decode_type_t::WHIRLPOOL_AC, getModel(), false);
+  addBoolToString(&result, getPowerToggle(), kPowerToggleStr);
+  addModeToString(&result, getMode(), kWhirlpoolAcAuto, kWhirlpoolAcCool,
+                  kWhirlpoolAcHeat, kWhirlpoolAcDry, kWhirlpoolAcFan);
+  addTempToString(&result, getTemp());
+  addFanToString(&result, getFan(), kWhirlpoolAcFanHigh, kWhirlpoolAcFanLow,
+                 kWhirlpoolAcFanAuto, kWhirlpoolAcFanAuto,
+                 kWhirlpoolAcFanMedium);
+  addBoolToString(&result, getSwing(), kSwingStr);
+  addBoolToString(&result, getLight(), kLightStr);
+  addLabeledString(&result, minsToString(getClock()), kClockStr);
+  addLabeledString(&result, 
       isOnTimerEnabled() ? minsToString(getOnTimer()) : kOffStr,
       kOnTimerStr);
-  result += addLabeledString(
+  addLabeledString(&result, 
       isOffTimerEnabled() ? minsToString(getOffTimer()) : kOffStr,
       kOffTimerStr);
-  result += addBoolToString(getSleep(), kSleepStr);
-  result += addBoolToString(getSuper(), kSuperStr);
-  result += addIntToString(getCommand(), kCommandStr);
+  addBoolToString(&result, getSleep(), kSleepStr);
+  addBoolToString(&result, getSuper(), kSuperStr);
+  addIntToString(&result, getCommand(), kCommandStr);
   result += kSpaceLBraceStr;
   switch (this->getCommand()) {
     case kWhirlpoolAcCommandLight:
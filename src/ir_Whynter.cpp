@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -35,6 +36,10 @@ const uint16_t kWhynterMinGapTicks =
      kWhynterBits * (kWhynterBitMarkTicks + kWhynterOneSpaceTicks));
 const uint16_t kWhynterMinGap = kWhynterMinGapTicks * kWhynterTick;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchWhynterBitMark == kWhynterBitMark,
+              "See IRrecvTimings.h");
+
 #if SEND_WHYNTER
 /// Send a Whynter message.
 /// Status: STABLE
@@ -73,7 +78,7 @@ void IRsend::sendWhynter(const uint64_t data, const uint16_t nbits,
 /// @see https://github.com/z3t0/Arduino-IRremote/blob/master/ir_Whynter.cpp
 bool IRrecv::decodeWhynter(decode_results *results, uint16_t offset,
                            const uint16_t nbits, const bool strict) {
-  if (results->rawlen <= 2 * nbits + 2 * kHeader + kFooter - 1 + offset)
+  if (results->rawlen < 2 * nbits + 2 * kHeader + kFooter - 1 + offset)
     return false;  // We don't have enough entries to possibly match.
 
   // Compliance
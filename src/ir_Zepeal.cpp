@@ -11,6 +11,7 @@
 //   Brand: Zepeal,  Model: DRT-A3311(BG) 5 button remote
 
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRsend.h"
 #include "IRutils.h"
 
@@ -25,6 +26,9 @@ const uint16_t kZepealZeroSpace = kZepealOneMark;
 const uint16_t kZepealFooterMark = 420;
 const uint16_t kZepealGap = 6750;
 
+// IRrecv.cpp has copies of these. See IRrecvTimings.h.
+static_assert(kDispatchZepealHdrMark == kZepealHdrMark, "See IRrecvTimings.h");
+
 const uint8_t  kZepealTolerance = 40;
 
 // Signature limits possible false possitvies,
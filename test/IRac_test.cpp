@@ -49,11 +49,13 @@ TEST(TestIRac, Airwell) {
       "Power Toggle: On, Mode: 3 (Auto), Fan: 1 (Medium), Temp: 18C";
 
   ac.begin();
-  irac.airwell(&ac,
-               true,                        // Power
-               stdAc::opmode_t::kAuto,      // Mode
-               18,                          // Celsius
-               stdAc::fanspeed_t::kMedium);   // Fan speed
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 18;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  irac.airwell(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -72,11 +74,13 @@ TEST(TestIRac, Amcor) {
       "Power: On, Mode: 5 (Auto), Fan: 3 (High), Temp: 19C, Max: Off";
 
   ac.begin();
-  irac.amcor(&ac,
-             true,                        // Power
-             stdAc::opmode_t::kAuto,      // Mode
-             19,                          // Celsius
-             stdAc::fanspeed_t::kHigh);   // Fan speed
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  irac.amcor(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -92,14 +96,15 @@ TEST(TestIRac, Argo) {
   IRac irac(kGpioUnused);
 
   ac.begin();
-  irac.argo(&ac,
-            true,                        // Power
-            stdAc::opmode_t::kHeat,      // Mode
-            21,                          // Celsius
-            stdAc::fanspeed_t::kHigh,    // Fan speed
-            stdAc::swingv_t::kOff,       // Veritcal swing
-            false,                       // Turbo
-            -1);                         // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.turbo = false;
+  irac.argo(&ac, state);
   EXPECT_TRUE(ac.getPower());
   EXPECT_EQ(kArgoHeat, ac.getMode());
   EXPECT_EQ(21, ac.getTemp());
@@ -118,13 +123,15 @@ TEST(TestIRac, Carrier64) {
       "Sleep: On, On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.carrier64(&ac,
-            true,                        // Power
-            stdAc::opmode_t::kHeat,      // Mode
-            21,                          // Celsius
-            stdAc::fanspeed_t::kHigh,    // Fan speed
-            stdAc::swingv_t::kAuto,      // Veritcal swing
-            1);                         // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.sleep = 1;
+  irac.carrier64(&ac, state);
   EXPECT_TRUE(ac.getPower());  // Power.
   EXPECT_EQ(kCarrierAc64Heat, ac.getMode());  // Operating mode.
   EXPECT_EQ(21, ac.getTemp());  // Temperature.
@@ -151,17 +158,18 @@ TEST(TestIRac, Coolix) {
       "Sensor Temp: Off";
 
   ac.begin();
-  irac.coolix(&ac,
-              true,                        // Power
-              stdAc::opmode_t::kHeat,      // Mode
-              21,                          // Celsius
-              stdAc::fanspeed_t::kHigh,    // Fan speed
-              stdAc::swingv_t::kOff,       // Veritcal swing
-              stdAc::swingh_t::kOff,       // Horizontal swing
-              false,                       // Turbo
-              false,                       // Light
-              false,                       // Clean
-              -1);                         // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kOff;
+  state.turbo = false;
+  state.light = false;
+  state.clean = false;
+  irac.coolix(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -220,13 +228,15 @@ TEST(TestIRac, Corona) {
 
   ac.begin();
   // this sends as well
-  irac.corona(&ac,
-              true,                        // Power
-              stdAc::opmode_t::kHeat,      // Mode
-              21,                          // Celsius
-              stdAc::fanspeed_t::kHigh,    // Fan speed
-              stdAc::swingv_t::kAuto,      // Veritcal swing
-              true);                       // Econo (PowerSave)
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.econo = true;  // Econo (PowerSave)
+  irac.corona(&ac, state);
   EXPECT_TRUE(ac.getPower());  // Power.
   EXPECT_TRUE(ac.getPowerButton());  // Power.button
   EXPECT_EQ(kCoronaAcModeHeat, ac.getMode());  // Operating mode.
@@ -257,17 +267,19 @@ TEST(TestIRac, Daikin) {
       "Off Timer: Off, Weekly Timer: On";
 
   ac.begin();
-  irac.daikin(&ac,
-              true,                        // Power
-              stdAc::opmode_t::kCool,      // Mode
-              19,                          // Celsius
-              stdAc::fanspeed_t::kMax,     // Fan speed
-              stdAc::swingv_t::kOff,       // Veritcal swing
-              stdAc::swingh_t::kOff,       // Horizontal swing
-              false,                       // Quiet
-              false,                       // Turbo
-              true,                        // Filter
-              true);                       // Clean
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kOff;
+  state.quiet = false;
+  state.turbo = false;
+  state.econo = true;
+  state.clean = true;
+  irac.daikin(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -289,18 +301,20 @@ TEST(TestIRac, Daikin128) {
       "Off Timer: Off, Off Timer: 00:00, Light Toggle: 8 (Wall)";
 
   ac.begin();
-  irac.daikin128(&ac,
-                 true,                        // Power
-                 stdAc::opmode_t::kHeat,      // Mode
-                 27,                          // Celsius
-                 stdAc::fanspeed_t::kMin,     // Fan speed
-                 stdAc::swingv_t::kAuto,       // Veritcal swing
-                 true,                        // Quiet
-                 false,                       // Turbo
-                 true,                        // Light
-                 false,                       // Econo
-                 18 * 60,                     // Sleep
-                 21 * 60 + 57);               // Clock
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 27;
+  state.fanspeed = stdAc::fanspeed_t::kMin;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.quiet = true;
+  state.turbo = false;
+  state.light = true;
+  state.econo = false;
+  state.sleep = 18 * 60;
+  state.clock = 21 * 60 + 57;
+  irac.daikin128(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -320,15 +334,17 @@ TEST(TestIRac, Daikin152) {
       "Powerful: Off, Quiet: Off, Econo: On, Sensor: Off, Comfort: Off";
 
   ac.begin();
-  irac.daikin152(&ac,
-                 true,                        // Power
-                 stdAc::opmode_t::kCool,      // Mode
-                 27,                          // Celsius
-                 stdAc::fanspeed_t::kMedium,  // Fan speed
-                 stdAc::swingv_t::kAuto,      // Veritcal swing
-                 false,                       // Quiet
-                 false,                       // Turbo
-                 true);                       // Econo
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 27;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.quiet = false;
+  state.turbo = false;
+  state.econo = true;
+  irac.daikin152(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -348,12 +364,14 @@ TEST(TestIRac, Daikin160) {
       "Swing(V): 3 (Middle)";
 
   ac.begin();
-  irac.daikin160(&ac,
-                 true,                        // Power
-                 stdAc::opmode_t::kDry,       // Mode
-                 23,                          // Celsius
-                 stdAc::fanspeed_t::kMin,     // Fan speed
-                 stdAc::swingv_t::kMiddle);   // Veritcal swing
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kDry;
+  state.degrees = 23;
+  state.fanspeed = stdAc::fanspeed_t::kMin;
+  state.swingv = stdAc::swingv_t::kMiddle;
+  irac.daikin160(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -372,12 +390,14 @@ TEST(TestIRac, Daikin176) {
       "Power: On, Mode: 2 (Cool), Temp: 26C, Fan: 1 (Low), Swing(H): 5 (Auto)";
 
   ac.begin();
-  irac.daikin176(&ac,
-                 true,                        // Power
-                 stdAc::opmode_t::kCool,      // Mode
-                 26,                          // Celsius
-                 stdAc::fanspeed_t::kLow,     // Fan speed
-                 stdAc::swingh_t::kAuto);     // Horizontal swing
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 26;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingh = stdAc::swingh_t::kAuto;
+  irac.daikin176(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -400,22 +420,22 @@ TEST(TestIRac, Daikin2) {
       "Eye Auto: Off, Quiet: Off, Powerful: Off, Purify: On, Econo: Off";
 
   ac.begin();
-  irac.daikin2(&ac,
-               true,                        // Power
-               stdAc::opmode_t::kCool,      // Mode
-               19,                          // Celsius
-               stdAc::fanspeed_t::kLow,     // Fan speed
-               stdAc::swingv_t::kOff,       // Veritcal swing
-               stdAc::swingh_t::kMiddle,    // Horizontal swing
-               false,                       // Quiet
-               false,                       // Turbo
-               true,                        // Light
-               false,                       // Econo
-               true,                        // Filter (aka Purify)
-               true,                        // Clean (aka Mold)
-               true,                        // Beep (Loud)
-               -1,                          // Sleep time
-               -1);                         // Current time
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kMiddle;
+  state.quiet = false;
+  state.turbo = false;
+  state.light = true;
+  state.econo = false;
+  state.filter = true;  // Filter (aka Purify)
+  state.clean = true;  // Clean (aka Mold)
+  state.beep = true;  // Beep (Loud)
+  irac.daikin2(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -435,15 +455,17 @@ TEST(TestIRac, Daikin216) {
       "Swing(H): On, Swing(V): On, Quiet: On, Powerful: Off";
 
   ac.begin();
-  irac.daikin216(&ac,
-                 true,                        // Power
-                 stdAc::opmode_t::kHeat,      // Mode
-                 31,                          // Celsius
-                 stdAc::fanspeed_t::kMedium,  // Fan speed
-                 stdAc::swingv_t::kAuto,      // Veritcal swing
-                 stdAc::swingh_t::kLeft,      // Horizontal swing
-                 true,                        // Quiet
-                 false);                      // Turbo (Powerful)
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 31;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kLeft;
+  state.quiet = true;
+  state.turbo = false;  // Turbo (Powerful)
+  irac.daikin216(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -464,16 +486,18 @@ TEST(TestIRac, Daikin64) {
       "Clock: 17:59, On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.daikin64(&ac,
-                true,                        // Power (Toggle)
-                stdAc::opmode_t::kCool,      // Mode
-                27,                          // Celsius
-                stdAc::fanspeed_t::kLow,     // Fan Speed
-                stdAc::swingv_t::kAuto,      // Veritcal swing
-                false,                       // Quiet
-                false,                       // Turbo
-                360,                         // Sleep
-                17 * 60 + 59);               // Clock
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;  // Power (Toggle)
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 27;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.quiet = false;
+  state.turbo = false;
+  state.sleep = 360;
+  state.clock = 17 * 60 + 59;
+  irac.daikin64(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -491,14 +515,16 @@ TEST(TestIRac, DelonghiAc) {
       "Turbo: On, Sleep: On, On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.delonghiac(&ac,
-                true,                        // Power
-                stdAc::opmode_t::kCool,      // Mode
-                false,                       // Celsius (i.e. Fahrenheit)
-                77,                          // Degrees (F)
-                stdAc::fanspeed_t::kMedium,  // Fan Speed
-                true,                        // Turbo
-                360);                        // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.celsius = false;  // Celsius (i.e. Fahrenheit)
+  state.degrees = 77;  // Degrees (F)
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.turbo = true;
+  state.sleep = 360;
+  irac.delonghiac(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -516,16 +542,18 @@ TEST(TestIRac, Electra) {
       "Swing(V): On, Swing(H): On, Light: Toggle, Clean: On, Turbo: On";
 
   ac.begin();
-  irac.electra(&ac,
-               true,                        // Power
-               stdAc::opmode_t::kFan,       // Mode
-               26,                          // Celsius
-               stdAc::fanspeed_t::kHigh,    // Fan speed
-               stdAc::swingv_t::kAuto,      // Veritcal swing
-               stdAc::swingh_t::kLeft,      // Horizontal swing
-               true,                        // Turbo
-               true,                        // Light (toggle)
-               true);                       // Clean
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kFan;
+  state.degrees = 26;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kLeft;
+  state.turbo = true;
+  state.light = true;  // Light (toggle)
+  state.clean = true;
+  irac.electra(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -549,19 +577,21 @@ TEST(TestIRac, Fujitsu) {
       "Model: 5 (ARRY4), Power: On, Mode: 1 (Cool), Temp: 19C, "
       "Fan: 2 (Medium), Clean: On, Filter: On, Swing: 0 (Off), Command: N/A";
   ac.begin();
-  irac.fujitsu(&ac,
-               ARDB1,                       // Model
-               true,                        // Power
-               stdAc::opmode_t::kCool,      // Mode
-               19,                          // Celsius
-               stdAc::fanspeed_t::kMedium,  // Fan speed
-               stdAc::swingv_t::kOff,       // Veritcal swing
-               stdAc::swingh_t::kOff,       // Horizontal swing
-               false,                       // Quiet
-               false,                       // Turbo (Powerful)
-               false,                       // Econo
-               true,                        // Filter
-               true);                       // Clean
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = ARDB1;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kOff;
+  state.quiet = false;
+  state.turbo = false;  // Turbo (Powerful)
+  state.econo = false;
+  state.filter = true;
+  state.clean = true;
+  irac.fujitsu(&ac, state);
   ASSERT_EQ(ardb1_expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -572,19 +602,8 @@ TEST(TestIRac, Fujitsu) {
   ASSERT_TRUE(IRAcUtils::decodeToState(&ac._irsend.capture, &r, &p));
 
   ac._irsend.reset();
-  irac.fujitsu(&ac,
-               ARRAH2E,                     // Model
-               true,                        // Power
-               stdAc::opmode_t::kCool,      // Mode
-               19,                          // Celsius
-               stdAc::fanspeed_t::kMedium,  // Fan speed
-               stdAc::swingv_t::kOff,       // Veritcal swing
-               stdAc::swingh_t::kOff,       // Horizontal swing
-               false,                       // Quiet
-               false,                       // Turbo (Powerful)
-               false,                       // Econo
-               true,                        // Filter
-               true);                       // Clean
+  state.model = ARRAH2E;
+  irac.fujitsu(&ac, state);
   ASSERT_EQ(arrah2e_expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -593,19 +612,8 @@ TEST(TestIRac, Fujitsu) {
   ASSERT_EQ(arrah2e_expected, IRAcUtils::resultAcToString(&ac._irsend.capture));
   ASSERT_TRUE(IRAcUtils::decodeToState(&ac._irsend.capture, &r, &p));
   ac._irsend.reset();
-  irac.fujitsu(&ac,
-               fujitsu_ac_remote_model_t::ARRY4,  // Model
-               true,                        // Power
-               stdAc::opmode_t::kCool,      // Mode
-               19,                          // Celsius
-               stdAc::fanspeed_t::kMedium,  // Fan speed
-               stdAc::swingv_t::kOff,       // Veritcal swing
-               stdAc::swingh_t::kOff,       // Horizontal swing
-               false,                       // Quiet
-               false,                       // Turbo (Powerful)
-               false,                       // Econo
-               true,                        // Filter
-               true);                       // Clean
+  state.model = fujitsu_ac_remote_model_t::ARRY4;
+  irac.fujitsu(&ac, state);
   ASSERT_EQ(arry4_expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -624,15 +632,17 @@ TEST(TestIRac, Goodweather) {
       "Light: Toggle, Sleep: Toggle, Swing: 1 (Slow), Command: 0 (Power)";
 
   ac.begin();
-  irac.goodweather(&ac,
-                   true,                        // Power
-                   stdAc::opmode_t::kCool,      // Mode
-                   19,                          // Celsius
-                   stdAc::fanspeed_t::kMedium,  // Fan speed
-                   stdAc::swingv_t::kHigh,      // Veritcal swing
-                   true,                        // Turbo
-                   true,                        // Light
-                   8 * 60 + 0);                 // Sleep time
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kHigh;
+  state.turbo = true;
+  state.light = true;
+  state.sleep = 8 * 60 + 0;  // Sleep time
+  irac.goodweather(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -654,18 +664,20 @@ TEST(TestIRac, Gree) {
       "Swing(V): 3 (UNKNOWN), Timer: Off, Display Temp: 0 (Off)";
 
   ac.begin();
-  irac.gree(&ac,
-            gree_ac_remote_model_t::YAW1F,  // Model
-            true,                           // Power
-            stdAc::opmode_t::kCool,         // Mode
-            false,                          // Celsius
-            71,                             // Degrees (F)
-            stdAc::fanspeed_t::kMedium,     // Fan speed
-            stdAc::swingv_t::kHigh,         // Veritcal swing
-            false,                          // Turbo
-            true,                           // Light
-            true,                           // Clean (aka Mold/XFan)
-            8 * 60 + 0);                    // Sleep time
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = gree_ac_remote_model_t::YAW1F;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.celsius = false;
+  state.degrees = 71;  // Degrees (F)
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kHigh;
+  state.turbo = false;
+  state.light = true;
+  state.clean = true;  // Clean (aka Mold/XFan)
+  state.sleep = 8 * 60 + 0;  // Sleep time
+  irac.gree(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -686,15 +698,17 @@ TEST(TestIRac, Haier) {
       "On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.haier(&ac,
-             true,                        // Power
-             stdAc::opmode_t::kCool,      // Mode
-             24,                          // Celsius
-             stdAc::fanspeed_t::kMedium,  // Fan speed
-             stdAc::swingv_t::kHigh,      // Veritcal swing
-             true,                        // Filter
-             8 * 60 + 0,                  // Sleep time
-             13 * 60 + 45);               // Clock
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 24;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kHigh;
+  state.filter = true;
+  state.sleep = 8 * 60 + 0;  // Sleep time
+  state.clock = 13 * 60 + 45;
+  irac.haier(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -716,15 +730,17 @@ TEST(TestIRac, HaierYrwo2) {
       "Health: On";
 
   ac.begin();
-  irac.haierYrwo2(&ac,
-             true,                        // Power
-             stdAc::opmode_t::kCool,      // Mode
-             23,                          // Celsius
-             stdAc::fanspeed_t::kMedium,  // Fan speed
-             stdAc::swingv_t::kHigh,      // Veritcal swing
-             true,                        // Turbo
-             true,                        // Filter
-             8 * 60 + 0);                 // Sleep time
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 23;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kHigh;
+  state.turbo = true;
+  state.filter = true;
+  state.sleep = 8 * 60 + 0;  // Sleep time
+  irac.haierYrwo2(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -733,6 +749,44 @@ TEST(TestIRac, HaierYrwo2) {
   ASSERT_EQ(expected, IRAcUtils::resultAcToString(&ac._irsend.capture));
   stdAc::state_t r, p;
   ASSERT_TRUE(IRAcUtils::decodeToState(&ac._irsend.capture, &r, &p));
+
+  // With a previous state, the button is the setting that changed.
+  stdAc::state_t prev;
+  IRac::initState(&prev);
+  prev.protocol = decode_type_t::HAIER_AC_YRW02;
+  prev.power = true;
+  prev.mode = stdAc::opmode_t::kCool;
+  prev.degrees = 23;
+  prev.fanspeed = stdAc::fanspeed_t::kMedium;
+  prev.swingv = stdAc::swingv_t::kHigh;
+  prev.turbo = true;
+  prev.filter = true;
+  prev.sleep = 8 * 60;
+  const uint8_t nudges[][2] = {
+      {24, kHaierAcYrw02ButtonTempUp}, {22, kHaierAcYrw02ButtonTempDown},
+      {23, kHaierAcYrw02ButtonPower}};  // Nothing changed.
+  for (const uint8_t *nudge : nudges) {
+    ac._irsend.reset();
+    state.degrees = nudge[0];
+    irac.haierYrwo2(&ac, state, &prev);
+    EXPECT_EQ(nudge[1], ac.getButton());
+    EXPECT_EQ(nudge[0], ac.getTemp());
+    ac._irsend.makeDecodeResult();
+    ASSERT_TRUE(capture.decode(&ac._irsend.capture));
+    ASSERT_EQ(HAIER_AC_YRW02, ac._irsend.capture.decode_type);
+  }
+  ac._irsend.reset();
+  state.degrees = 23;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  irac.haierYrwo2(&ac, state, &prev);
+  EXPECT_EQ(kHaierAcYrw02ButtonFan, ac.getButton());
+  // Turning it off is always the Power button.
+  ac._irsend.reset();
+  state.power = false;
+  state.degrees = 24;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  irac.haierYrwo2(&ac, state, &prev);
+  EXPECT_EQ(kHaierAcYrw02ButtonPower, ac.getButton());
 }
 
 TEST(TestIRac, Hitachi) {
@@ -744,13 +798,15 @@ TEST(TestIRac, Hitachi) {
       "Swing(V): Off, Swing(H): On";
 
   ac.begin();
-  irac.hitachi(&ac,
-               true,                        // Power
-               stdAc::opmode_t::kAuto,      // Mode
-               22,                          // Celsius
-               stdAc::fanspeed_t::kMedium,  // Fan speed
-               stdAc::swingv_t::kOff,       // Veritcal swing
-               stdAc::swingh_t::kAuto);     // Horizontal swing
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 22;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kAuto;
+  irac.hitachi(&ac, state);
 
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -773,17 +829,17 @@ TEST(TestIRac, Hitachi1) {
       "On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.hitachi1(&ac,
-                hitachi_ac1_remote_model_t::R_LT0541_HTA_A,  // Model
-                true,                                        // Power
-                false,                                       // Power Toggle
-                stdAc::opmode_t::kCool,                      // Mode
-                19,                                          // Celsius
-                stdAc::fanspeed_t::kMedium,                  // Fan speed
-                stdAc::swingv_t::kAuto,                      // Vertical swing
-                stdAc::swingh_t::kLeft,                      // Horizontal swing
-                true,                                        // Swing toggle
-                5 * 60 + 37);                                // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = hitachi_ac1_remote_model_t::R_LT0541_HTA_A;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kLeft;
+  state.sleep = 5 * 60 + 37;
+  irac.hitachi1(&ac, state, false, true);
 
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -803,13 +859,15 @@ TEST(TestIRac, Hitachi344) {
       "Button: 129 (Swing(V)), Swing(V): Off, Swing(H): 2 (Right)";
 
   ac.begin();
-  irac.hitachi344(&ac,
-                  true,                         // Power
-                  stdAc::opmode_t::kHeat,       // Mode
-                  25,                           // Celsius
-                  stdAc::fanspeed_t::kMax,      // Fan speed
-                  stdAc::swingv_t::kAuto,       // Swing(V)
-                  stdAc::swingh_t::kRight);     // Swing(H)
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 25;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kRight;
+  irac.hitachi344(&ac, state);
 
   ASSERT_EQ(expected_swingon, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -829,13 +887,8 @@ TEST(TestIRac, Hitachi344) {
       "Button: 19 (Power/Mode), Swing(V): Off, Swing(H): 2 (Right)";
 
   ac._irsend.reset();
-  irac.hitachi344(&ac,
-                  true,                         // Power
-                  stdAc::opmode_t::kHeat,       // Mode
-                  25,                           // Celsius
-                  stdAc::fanspeed_t::kMax,      // Fan speed
-                  stdAc::swingv_t::kOff,        // Swing(V)
-                  stdAc::swingh_t::kRight);     // Swing(H)
+  state.swingv = stdAc::swingv_t::kOff;
+  irac.hitachi344(&ac, state);
   ASSERT_EQ(expected_swingoff, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -857,12 +910,14 @@ TEST(TestIRac, Hitachi424) {
       "Button: 129 (Swing(V)), Swing(V) Toggle: On";
 
   ac.begin();
-  irac.hitachi424(&ac,
-                  true,                         // Power
-                  stdAc::opmode_t::kHeat,       // Mode
-                  25,                           // Celsius
-                  stdAc::fanspeed_t::kMax,      // Fan speed
-                  stdAc::swingv_t::kOff);       // Swing(V)
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 25;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kOff;
+  irac.hitachi424(&ac, state);
 
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -874,12 +929,11 @@ TEST(TestIRac, Hitachi424) {
   ASSERT_TRUE(IRAcUtils::decodeToState(&ac._irsend.capture, &r, &p));
 
   ac._irsend.reset();
-  irac.hitachi424(&ac,
-                  true,                         // Power
-                  stdAc::opmode_t::kCool,       // Mode
-                  26,                           // Celsius
-                  stdAc::fanspeed_t::kMin,      // Fan speed
-                  stdAc::swingv_t::kAuto);      // Swing(V)
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 26;
+  state.fanspeed = stdAc::fanspeed_t::kMin;
+  state.swingv = stdAc::swingv_t::kAuto;
+  irac.hitachi424(&ac, state);
 
   ASSERT_EQ(expected_swingv, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -900,18 +954,20 @@ TEST(TestIRac, Kelvinator) {
       "Swing(H): Off, Swing(V): Off";
 
   ac.begin();
-  irac.kelvinator(&ac,
-                  true,                        // Power
-                  stdAc::opmode_t::kCool,      // Mode
-                  19,                          // Celsius
-                  stdAc::fanspeed_t::kMedium,  // Fan speed
-                  stdAc::swingv_t::kOff,       // Veritcal swing
-                  stdAc::swingh_t::kOff,       // Horizontal swing
-                  false,                       // Quiet
-                  false,                       // Turbo
-                  true,                        // Light
-                  true,                        // Filter
-                  true);                       // Clean
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 19;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kOff;
+  state.quiet = false;
+  state.turbo = false;
+  state.light = true;
+  state.filter = true;
+  state.clean = true;
+  irac.kelvinator(&ac, state);
 
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -932,12 +988,14 @@ TEST(TestIRac, LG) {
       "Power: On, Mode: 1 (Dry), Temp: 27C, Fan: 2 (Medium)";
 
   ac.begin();
-  irac.lg(&ac,
-          lg_ac_remote_model_t::GE6711AR2853M,  // Model
-          true,                                 // Power
-          stdAc::opmode_t::kDry,                // Mode
-          27,                                   // Degrees C
-          stdAc::fanspeed_t::kMedium);          // Fan speed
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = lg_ac_remote_model_t::GE6711AR2853M;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kDry;
+  state.degrees = 27;  // Degrees C
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  irac.lg(&ac, state);
 
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -958,15 +1016,17 @@ TEST(TestIRac, Midea) {
       "Sleep: On, Swing(V) Toggle: Off, Econo Toggle: Off";
 
   ac.begin();
-  irac.midea(&ac,
-             true,                        // Power
-             stdAc::opmode_t::kDry,       // Mode
-             true,                        // Celsius
-             27,                          // Degrees
-             stdAc::fanspeed_t::kMedium,  // Fan speed
-             stdAc::swingv_t::kOff,       // Swing(V)
-             false,                       // Econo
-             8 * 60 + 0);                 // Sleep time
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kDry;
+  state.celsius = true;
+  state.degrees = 27;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.econo = false;
+  state.sleep = 8 * 60 + 0;  // Sleep time
+  irac.midea(&ac, state);
 
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -988,15 +1048,17 @@ TEST(TestIRac, Mitsubishi) {
       "Clock: 14:30, On Timer: 00:00, Off Timer: 00:00, Timer: -";
 
   ac.begin();
-  irac.mitsubishi(&ac,
-                  true,                        // Power
-                  stdAc::opmode_t::kCool,      // Mode
-                  20,                          // Celsius
-                  stdAc::fanspeed_t::kMedium,  // Fan speed
-                  stdAc::swingv_t::kOff,       // Veritcal swing
-                  stdAc::swingh_t::kOff,       // Horizontal swing
-                  false,                       // Silent
-                  14 * 60 + 35);               // Clock
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 20;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kOff;
+  state.quiet = false;  // Silent
+  state.clock = 14 * 60 + 35;
+  irac.mitsubishi(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1016,13 +1078,15 @@ TEST(TestIRac, Mitsubishi136) {
       "Swing(V): 3 (Highest), Quiet: Off";
 
   ac.begin();
-  irac.mitsubishi136(&ac,
-                     true,                        // Power
-                     stdAc::opmode_t::kDry,       // Mode
-                     22,                          // Celsius
-                     stdAc::fanspeed_t::kMax,     // Fan speed
-                     stdAc::swingv_t::kHighest,   // Veritcal swing
-                     false);                      // Quiet
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kDry;
+  state.degrees = 22;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kHighest;
+  state.quiet = false;
+  irac.mitsubishi136(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1043,16 +1107,18 @@ TEST(TestIRac, MitsubishiHeavy88) {
       "3D: Off, Clean: On";
 
   ac.begin();
-  irac.mitsubishiHeavy88(&ac,
-                         true,                        // Power
-                         stdAc::opmode_t::kCool,      // Mode
-                         21,                          // Celsius
-                         stdAc::fanspeed_t::kMedium,  // Fan speed
-                         stdAc::swingv_t::kAuto,      // Veritcal swing
-                         stdAc::swingh_t::kOff,       // Horizontal swing
-                         false,                       // Turbo
-                         false,                       // Econo
-                         true);                       // Clean
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kOff;
+  state.turbo = false;
+  state.econo = false;
+  state.clean = true;
+  irac.mitsubishiHeavy88(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1073,19 +1139,21 @@ TEST(TestIRac, MitsubishiHeavy152) {
       "Econo: On, Night: On, Filter: On, 3D: Off, Clean: Off";
 
   ac.begin();
-  irac.mitsubishiHeavy152(&ac,
-                          true,                        // Power
-                          stdAc::opmode_t::kCool,      // Mode
-                          20,                          // Celsius
-                          stdAc::fanspeed_t::kLow,     // Fan speed
-                          stdAc::swingv_t::kOff,       // Veritcal swing
-                          stdAc::swingh_t::kAuto,      // Horizontal swing
-                          true,                        // Silent
-                          false,                       // Turbo
-                          true,                        // Econo
-                          true,                        // Filter
-                          false,                       // Clean
-                          8 * 60);                     // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 20;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kAuto;
+  state.quiet = true;  // Silent
+  state.turbo = false;
+  state.econo = true;
+  state.filter = true;
+  state.clean = false;
+  state.sleep = 8 * 60;
+  irac.mitsubishiHeavy152(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1107,17 +1175,19 @@ TEST(TestIRac, Neoclima) {
       "Button: 0 (Power)";
 
   ac.begin();
-  irac.neoclima(&ac,
-                true,                        // Power
-                stdAc::opmode_t::kCool,      // Mode
-                20,                          // Celsius
-                stdAc::fanspeed_t::kLow,     // Fan speed
-                stdAc::swingv_t::kOff,       // Veritcal swing
-                stdAc::swingh_t::kAuto,      // Horizontal swing
-                false,                       // Turbo
-                true,                        // Light
-                true,                        // Filter
-                8 * 60);                     // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 20;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kAuto;
+  state.turbo = false;
+  state.light = true;
+  state.filter = true;
+  state.sleep = 8 * 60;
+  irac.neoclima(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1138,18 +1208,20 @@ TEST(TestIRac, Panasonic) {
       "Powerful: Off, Clock: 19:17, On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.panasonic(&ac,
-                 kPanasonicNke,               // Model
-                 true,                        // Power
-                 stdAc::opmode_t::kHeat,      // Mode
-                 28,                          // Celsius
-                 stdAc::fanspeed_t::kMedium,  // Fan speed
-                 stdAc::swingv_t::kAuto,      // Veritcal swing
-                 stdAc::swingh_t::kLeft,      // Horizontal swing
-                 true,                        // Quiet
-                 false,                       // Turbo
-                 false,                       // Filter
-                 19 * 60 + 17);               // Clock
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = kPanasonicNke;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 28;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kLeft;
+  state.quiet = true;
+  state.turbo = false;
+  state.filter = false;
+  state.clock = 19 * 60 + 17;
+  irac.panasonic(&ac, state);
   ASSERT_EQ(expected_nke, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1165,18 +1237,16 @@ TEST(TestIRac, Panasonic) {
       "Quiet: Off, Powerful: On, Ion: On, "
       "Clock: 19:17, On Timer: Off, Off Timer: Off";
   ac._irsend.reset();
-  irac.panasonic(&ac,
-               kPanasonicDke,               // Model
-               true,                        // Power
-               stdAc::opmode_t::kCool,      // Mode
-               18,                          // Celsius
-               stdAc::fanspeed_t::kMax,     // Fan speed
-               stdAc::swingv_t::kHigh,      // Veritcal swing
-               stdAc::swingh_t::kMiddle,    // Horizontal swing
-               false,                       // Quiet
-               true,                        // Turbo
-               true,                        // Filter
-               19 * 60 + 17);               // Clock
+  state.model = kPanasonicDke;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 18;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kHigh;
+  state.swingh = stdAc::swingh_t::kMiddle;
+  state.quiet = false;
+  state.turbo = true;
+  state.filter = true;
+  irac.panasonic(&ac, state);
   ASSERT_EQ(expected_dke, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1196,20 +1266,20 @@ TEST(TestIRac, Samsung) {
       "Light: On, Ion: Off";
 
   ac.begin();
-  irac.samsung(&ac,
-               true,                        // Power
-               stdAc::opmode_t::kAuto,      // Mode
-               28,                          // Celsius
-               stdAc::fanspeed_t::kMedium,  // Fan speed
-               stdAc::swingv_t::kAuto,      // Veritcal swing
-               true,                        // Quiet
-               false,                       // Turbo
-               true,                        // Light (Display)
-               false,                       // Filter (Ion)
-               true,                        // Clean
-               true,                        // Beep
-               true,                        // Previous power state
-               false);                      // with dopower Off
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 28;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.quiet = true;
+  state.turbo = false;
+  state.light = true;  // Light (Display)
+  state.filter = false;  // Filter (Ion)
+  state.clean = true;
+  state.beep = true;
+  irac.samsung(&ac, state, true, false);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1220,20 +1290,7 @@ TEST(TestIRac, Samsung) {
   ASSERT_TRUE(IRAcUtils::decodeToState(&ac._irsend.capture, &r, &p));
 
   ac._irsend.reset();
-  irac.samsung(&ac,
-               true,                        // Power
-               stdAc::opmode_t::kAuto,      // Mode
-               28,                          // Celsius
-               stdAc::fanspeed_t::kMedium,  // Fan speed
-               stdAc::swingv_t::kAuto,      // Veritcal swing
-               true,                        // Quiet
-               false,                       // Turbo
-               true,                        // Light (Display)
-               false,                       // Filter (Ion)
-               true,                        // Clean
-               true,                        // Beep
-               true,                        // Previous power state
-               true);                       // with dopower On
+  irac.samsung(&ac, state, true, true);
   ASSERT_EQ(expected, ac.toString());  // Class should be in the desired mode.
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1259,14 +1316,16 @@ TEST(TestIRac, Sanyo) {
       "Sensor: Wall, Sensor Temp: 28C, Off Timer: Off";
 
   ac.begin();
-  irac.sanyo(&ac,
-             true,                         // Power
-             stdAc::opmode_t::kCool,       // Mode
-             28,                           // Celsius
-             stdAc::fanspeed_t::kMedium,   // Fan speed
-             stdAc::swingv_t::kHighest,    // Vertical Swing
-             true,                         // Beep
-             17);                          // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 28;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kHighest;
+  state.beep = true;
+  state.sleep = 17;
+  irac.sanyo(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1277,6 +1336,80 @@ TEST(TestIRac, Sanyo) {
   ASSERT_TRUE(IRAcUtils::decodeToState(&ac._irsend.capture, &r, &p));
 }
 
+// A Samsung A/C state can be sent without a previous state.
+TEST(TestIRac, SamsungWithoutPrevState) {
+  IRac irac(kGpioUnused);
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  IRsequence sent;
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::SAMSUNG_AC;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 24;
+
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state));  // i.e. prev is NULL.
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::SAMSUNG_AC, irsend.capture.decode_type);
+  // The power is assumed to have changed, so the "On" message is sent.
+  EXPECT_EQ(kSamsungAcExtendedBits, irsend.capture.bits);
+}
+
+// Via `sendAc()`, the extended power message is only sent when the power
+// changes.
+TEST(TestIRac, SamsungExtendedPowerMessage) {
+  IRac irac(kGpioUnused);
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  IRsequence sent;
+  stdAc::state_t state, prev;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::SAMSUNG_AC;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 24;
+  prev = state;
+
+  // By default, the extended power message is always sent.
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::SAMSUNG_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kSamsungAcExtendedBits, irsend.capture.bits);
+
+  // When only sending what changed, it is only sent if the power changed.
+  irac.setDeltaSend(true);
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::SAMSUNG_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kSamsungAcBits, irsend.capture.bits);
+
+  prev.power = false;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(kSamsungAcExtendedBits, irsend.capture.bits);
+}
+
 TEST(TestIRac, Sharp) {
   IRSharpAc ac(kGpioUnused);
   IRac irac(kGpioUnused);
@@ -1286,16 +1419,17 @@ TEST(TestIRac, Sharp) {
       "Turbo: Off, Swing(V) Toggle: On, Ion: On, Econo: -, Clean: Off";
 
   ac.begin();
-  irac.sharp(&ac,
-             true,                         // Power
-             true,                         // Previous Power
-             stdAc::opmode_t::kCool,       // Mode
-             28,                           // Celsius
-             stdAc::fanspeed_t::kMedium,   // Fan speed
-             stdAc::swingv_t::kAuto,       // Veritcal swing
-             false,                        // Turbo
-             true,                         // Filter (Ion)
-             false);                       // Clean
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 28;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.turbo = false;
+  state.filter = true;  // Filter (Ion)
+  state.clean = false;
+  irac.sharp(&ac, state, true);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1315,17 +1449,19 @@ TEST(TestIRac, Tcl112) {
       "Health: On, Light: On, Turbo: Off, Swing(H): On, Swing(V): Off";
 
   ac.begin();
-  irac.tcl112(&ac,
-              true,                        // Power
-              stdAc::opmode_t::kCool,      // Mode
-              20,                          // Celsius
-              stdAc::fanspeed_t::kMedium,  // Fan speed
-              stdAc::swingv_t::kOff,       // Veritcal swing
-              stdAc::swingh_t::kAuto,      // Horizontal swing
-              false,                       // Turbo
-              true,                        // Light
-              true,                        // Econo
-              true);                       // Filter (aka. Health)
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 20;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.swingh = stdAc::swingh_t::kAuto;
+  state.turbo = false;
+  state.light = true;
+  state.econo = true;
+  state.filter = true;  // Filter (aka. Health)
+  irac.tcl112(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1345,14 +1481,16 @@ TEST(TestIRac, Teco) {
       "Swing: On, Light: On, Humid: Off, Save: Off, Timer: Off";
 
   ac.begin();
-  irac.teco(&ac,
-            true,                        // Power
-            stdAc::opmode_t::kAuto,      // Mode
-            21,                          // Celsius
-            stdAc::fanspeed_t::kMedium,  // Fan speed
-            stdAc::swingv_t::kAuto,      // Veritcal swing
-            true,                        // Light
-            8 * 60 + 30);                // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.light = true;
+  state.sleep = 8 * 60 + 30;
+  irac.teco(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1372,14 +1510,16 @@ TEST(TestIRac, Toshiba) {
       "Turbo: Off, Econo: On";
 
   ac.begin();
-  irac.toshiba(&ac,
-               true,                      // Power
-               stdAc::opmode_t::kDry,     // Mode
-               29,                        // Celsius
-               stdAc::fanspeed_t::kLow,   // Fan speed
-               stdAc::swingv_t::kOff,     // Vertical Swing
-               false,                     // Turbo
-               true);                     // Econo
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kDry;
+  state.degrees = 29;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingv = stdAc::swingv_t::kOff;
+  state.turbo = false;
+  state.econo = true;
+  irac.toshiba(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ASSERT_EQ(kToshibaACStateLengthLong, ac.getStateLength());
   ac._irsend.makeDecodeResult();
@@ -1444,12 +1584,14 @@ TEST(TestIRac, Trotec) {
       "Power: On, Mode: 1 (Cool), Temp: 18C, Fan: 3 (High), Sleep: On";
 
   ac.begin();
-  irac.trotec(&ac,
-              true,                        // Power
-              stdAc::opmode_t::kCool,      // Mode
-              18,                          // Celsius
-              stdAc::fanspeed_t::kHigh,    // Fan speed
-              8 * 60 + 17);                // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 18;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.sleep = 8 * 60 + 17;
+  irac.trotec(&ac, state);
   EXPECT_TRUE(ac.getPower());
   EXPECT_EQ(kTrotecCool, ac.getMode());
   EXPECT_EQ(18, ac.getTemp());
@@ -1474,15 +1616,17 @@ TEST(TestIRac, Vestel) {
       "Turbo: Off, Ion: On, Swing: On";
 
   ac.begin();
-  irac.vestel(&ac,
-              true,                      // Power
-              stdAc::opmode_t::kAuto,    // Mode
-              22,                        // Celsius
-              stdAc::fanspeed_t::kLow,   // Fan speed
-              stdAc::swingv_t::kHigh,    // Veritcal swing
-              false,                     // Turbo
-              true,                      // Filter
-              8 * 60 + 0);               // Sleep time
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 22;
+  state.fanspeed = stdAc::fanspeed_t::kLow;
+  state.swingv = stdAc::swingv_t::kHigh;
+  state.turbo = false;
+  state.filter = true;
+  state.sleep = 8 * 60 + 0;  // Sleep time
+  irac.vestel(&ac, state);
               // 13 * 60 + 45);             // Clock
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -1498,17 +1642,7 @@ TEST(TestIRac, Vestel) {
       "Clock: 13:45, Timer: Off, On Timer: Off, Off Timer: Off";
 
   ac.begin();
-  irac.vestel(&ac,
-              true,                      // Power
-              stdAc::opmode_t::kAuto,    // Mode
-              22,                        // Celsius
-              stdAc::fanspeed_t::kLow,   // Fan speed
-              stdAc::swingv_t::kHigh,    // Veritcal swing
-              false,                     // Turbo
-              true,                      // Filter
-              8 * 60 + 0,                // Sleep time
-              13 * 60 + 45,              // Clock
-              false);                    // Don't send the normal message.
+  irac.vestel(&ac, state, 13 * 60 + 45, false);
                                          // Just for testing purposes.
   ASSERT_EQ(expected_clocks, ac.toString());
   ac._irsend.makeDecodeResult();
@@ -1522,16 +1656,7 @@ TEST(TestIRac, Vestel) {
   // clock is set.
   ac._irsend.reset();
   ac.begin();
-  irac.vestel(&ac,
-              true,                      // Power
-              stdAc::opmode_t::kAuto,    // Mode
-              22,                        // Celsius
-              stdAc::fanspeed_t::kLow,   // Fan speed
-              stdAc::swingv_t::kHigh,    // Veritcal swing
-              false,                     // Turbo
-              true,                      // Filter
-              8 * 60 + 0,                // Sleep time
-              13 * 60 + 45);             // Clock
+  irac.vestel(&ac, state, 13 * 60 + 45);
 
   EXPECT_EQ(
       "f38000d50"
@@ -1567,18 +1692,20 @@ TEST(TestIRac, Voltas) {
       "Fan: 1 (High), Swing(V): On, Swing(H): On, "
       "Turbo: Off, Econo: Off, WiFi: Off, Light: On, Sleep: On, "
       "On Timer: Off, Off Timer: Off";
-  irac.voltas(&ac,
-              voltas_ac_remote_model_t::kVoltasUnknown,  // Model
-              true,                                      // Power
-              stdAc::opmode_t::kCool,                    // Mode
-              18,                                        // Celsius
-              stdAc::fanspeed_t::kHigh,                  // Fan speed
-              stdAc::swingv_t::kAuto,                    // Vertical Swing
-              stdAc::swingh_t::kAuto,                    // Horizontal Swing
-              false,                                     // Turbo
-              false,                                     // Econo
-              true,                                      // Light
-              3 * 60);                                   // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = voltas_ac_remote_model_t::kVoltasUnknown;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 18;
+  state.fanspeed = stdAc::fanspeed_t::kHigh;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.swingh = stdAc::swingh_t::kAuto;
+  state.turbo = false;
+  state.econo = false;
+  state.light = true;
+  state.sleep = 3 * 60;
+  irac.voltas(&ac, state);
   EXPECT_EQ(voltas_ac_remote_model_t::kVoltasUnknown, ac.getModel());
   EXPECT_TRUE(ac.getPower());
   EXPECT_EQ(kVoltasCool, ac.getMode());
@@ -1604,18 +1731,8 @@ TEST(TestIRac, Voltas) {
       "Fan: 1 (High), Swing(V): On, Swing(H): N/A, "
       "Turbo: Off, Econo: Off, WiFi: Off, Light: On, Sleep: On, "
       "On Timer: Off, Off Timer: Off";
-  irac.voltas(&ac,
-              voltas_ac_remote_model_t::kVoltas122LZF,   // Model
-              true,                                      // Power
-              stdAc::opmode_t::kCool,                    // Mode
-              18,                                        // Celsius
-              stdAc::fanspeed_t::kHigh,                  // Fan speed
-              stdAc::swingv_t::kAuto,                    // Vertical Swing
-              stdAc::swingh_t::kAuto,                    // Horizontal Swing
-              false,                                     // Turbo
-              false,                                     // Econo
-              true,                                      // Light
-              3 * 60);                                   // Sleep
+  state.model = voltas_ac_remote_model_t::kVoltas122LZF;
+  irac.voltas(&ac, state);
   EXPECT_EQ(voltas_ac_remote_model_t::kVoltas122LZF, ac.getModel());
   EXPECT_TRUE(ac.getPower());
   EXPECT_EQ(kVoltasCool, ac.getMode());
@@ -1643,17 +1760,19 @@ TEST(TestIRac, Whirlpool) {
       "Off Timer: Off, Sleep: On, Super: Off, Command: 1 (Power)";
 
   ac.begin();
-  irac.whirlpool(&ac,
-                 DG11J13A,
-                 true,                        // Power
-                 stdAc::opmode_t::kAuto,      // Mode
-                 21,                          // Celsius
-                 stdAc::fanspeed_t::kMedium,  // Fan speed
-                 stdAc::swingv_t::kAuto,      // Veritcal swing
-                 false,                       // Turbo
-                 true,                        // Light
-                 8 * 60 + 30,                 // Sleep
-                 23 * 60 + 58);               // Clock
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.model = DG11J13A;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kAuto;
+  state.degrees = 21;
+  state.fanspeed = stdAc::fanspeed_t::kMedium;
+  state.swingv = stdAc::swingv_t::kAuto;
+  state.turbo = false;
+  state.light = true;
+  state.sleep = 8 * 60 + 30;
+  state.clock = 23 * 60 + 58;
+  irac.whirlpool(&ac, state);
   ASSERT_EQ(expected, ac.toString());
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
@@ -1946,17 +2065,18 @@ TEST(TestIRac, Issue821) {
   ASSERT_TRUE(result.light);
   irac.sendAc(next, &prev);
   ASSERT_TRUE(next.light);
-  irac.coolix(&ac,
-              result.power,     // Power
-              result.mode,      // Mode
-              result.degrees,   // Celsius
-              result.fanspeed,  // Fan speed
-              result.swingv,       // Veritcal swing
-              result.swingh,       // Horizontal swing
-              result.turbo,                       // Turbo
-              result.light,                       // Light
-              result.clean,                       // Clean
-              -1);                         // Sleep
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = result.power;
+  state.mode = result.mode;
+  state.degrees = result.degrees;
+  state.fanspeed = result.fanspeed;
+  state.swingv = result.swingv;
+  state.swingh = result.swingh;
+  state.turbo = result.turbo;
+  state.light = result.light;
+  state.clean = result.clean;
+  irac.coolix(&ac, state);
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
   ASSERT_EQ(COOLIX, ac._irsend.capture.decode_type);
@@ -2000,6 +2120,38 @@ TEST(TestIRac, Issue821) {
       ac._irsend.outputStr());
 }
 
+TEST(TestIRac, CoolixBurstSend) {
+  IRac irac(kGpioUnused);
+  IRCoolixAC ac(kGpioUnused);
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::COOLIX;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 22;
+  state.light = true;
+
+  EXPECT_FALSE(irac.getBurstSend());
+  irac.setBurstSend(true);
+  EXPECT_TRUE(irac.getBurstSend());
+  irac.setBurstSend(false);
+  EXPECT_FALSE(irac.getBurstSend());
+
+  // Normally, each message is followed by its full message gap.
+  ac.begin();
+  irac.coolix(&ac, state);
+  const std::string normal = ac._irsend.outputStr();
+  EXPECT_NE(std::string::npos, normal.find("m552s105244m4692s4416"));
+
+  // As a burst, only the minimum gap separates the light command & the state.
+  ac._irsend.reset();
+  irac.coolix(&ac, state, true);
+  const std::string burst = ac._irsend.outputStr();
+  std::string expected = normal;
+  expected.replace(expected.find("m552s105244m4692s4416"), 11, "m552s5244");
+  EXPECT_EQ(expected, burst);
+}
+
 // Check power toggling in Whirlpool common a/c handling.
 TEST(TestIRac, Issue1001) {
   stdAc::state_t desired;  // New desired state
@@ -2037,16 +2189,7 @@ TEST(TestIRac, Issue1001) {
   ASSERT_TRUE(result.power);
   irac.sendAc(desired, &prev);
   ASSERT_FALSE(desired.power);
-  irac.whirlpool(&ac,
-                 (whirlpool_ac_remote_model_t)result.model,  // Model
-                 result.power,     // Power
-                 result.mode,      // Mode
-                 result.degrees,   // Celsius
-                 result.fanspeed,  // Fan speed
-                 result.swingv,    // Veritcal swing
-                 result.turbo,     // Turbo
-                 result.light,     // Light
-                 result.sleep);    // Sleep
+  irac.whirlpool(&ac, result);
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
   ASSERT_EQ(WHIRLPOOL_AC, ac._irsend.capture.decode_type);
@@ -2068,16 +2211,7 @@ TEST(TestIRac, Issue1001) {
   ASSERT_TRUE(result.power);
   irac.sendAc(desired, &prev);
   ASSERT_TRUE(desired.power);
-  irac.whirlpool(&ac,
-                 (whirlpool_ac_remote_model_t)result.model,  // Model
-                 result.power,     // Power
-                 result.mode,      // Mode
-                 result.degrees,   // Celsius
-                 result.fanspeed,  // Fan speed
-                 result.swingv,    // Veritcal swing
-                 result.turbo,     // Turbo
-                 result.light,     // Light
-                 result.sleep);    // Sleep
+  irac.whirlpool(&ac, result);
   ac._irsend.makeDecodeResult();
   EXPECT_TRUE(capture.decode(&ac._irsend.capture));
   ASSERT_EQ(WHIRLPOOL_AC, ac._irsend.capture.decode_type);
@@ -2186,14 +2320,7 @@ TEST(TestIRac, Issue1250) {
       "Temp: 19C, Power: On, Mode: 4 (Fan), Fan: 0 (Auto), "
       "Turbo: Off, Econo: Off";
   ac._irsend.reset();
-  irac.toshiba(&ac,
-               irac.next.power,     // Power
-               irac.next.mode,      // Mode
-               irac.next.degrees,   // Celsius
-               irac.next.fanspeed,  // Fan speed
-               irac.next.swingv,    // Vertical Swing
-               irac.next.turbo,     // Turbo
-               irac.next.econo);    // Econo
+  irac.toshiba(&ac, irac.next);
   ASSERT_EQ(expected_on, ac.toString());
   ASSERT_EQ(kToshibaACStateLength, ac.getStateLength());
   ac._irsend.makeDecodeResult();
@@ -2211,14 +2338,7 @@ TEST(TestIRac, Issue1250) {
   char expected_off[] =
       "Temp: 19C, Power: Off, Fan: 0 (Auto), Turbo: Off, Econo: Off";
   ac._irsend.reset();
-  irac.toshiba(&ac,
-               irac.next.power,     // Power
-               irac.next.mode,      // Mode
-               irac.next.degrees,   // Celsius
-               irac.next.fanspeed,  // Fan speed
-               irac.next.swingv,    // Vertical Swing
-               irac.next.turbo,     // Turbo
-               irac.next.econo);    // Econo
+  irac.toshiba(&ac, irac.next);
   ASSERT_EQ(expected_off, ac.toString());
   ASSERT_EQ(kToshibaACStateLength, ac.getStateLength());
   ac._irsend.makeDecodeResult();
@@ -2229,3 +2349,878 @@ TEST(TestIRac, Issue1250) {
   // Confirm nothing in the state changed with the send.
   ASSERT_FALSE(IRac::cmpStates(irac.next, copy_of_next_pre_send));
 }
+
+#if ENABLE_IRAC_FRAME_CACHE
+// Check messages sendAc() has sent before are re-sent from the frame cache.
+TEST(TestIRac, FrameCache) {
+  IRac irac(kGpioUnused);
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::DAIKIN2;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 22;
+
+  // What should be sent.
+  IRDaikin2 ac(kGpioUnused);
+  irac.daikin2(&ac, state);
+  const std::string expected = ac._irsend.outputStr();
+
+  ASSERT_TRUE(irac.enableFrameCache(2));
+  irac._irsend.reset();
+  ASSERT_TRUE(irac.sendAc(state, &state));  // Not seen before.
+  EXPECT_EQ(0, irac.getFrameCacheHits());
+  EXPECT_EQ(1, irac.getFrameCacheMisses());
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+  ASSERT_TRUE(irac.sendAc(state, &state));  // Seen before.
+  EXPECT_EQ(1, irac.getFrameCacheHits());
+  EXPECT_EQ(1, irac.getFrameCacheMisses());
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+  // Without a previous state, it is a different message for some protocols.
+  ASSERT_TRUE(irac.sendAc(state));
+  EXPECT_EQ(2, irac.getFrameCacheMisses());
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+
+  // A third state forgets the least recently used one.
+  stdAc::state_t other = state;
+  other.degrees = 26;
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  EXPECT_EQ(2, irac.getFrameCacheHits());
+  ASSERT_TRUE(irac.sendAc(other, &other));
+  EXPECT_EQ(3, irac.getFrameCacheMisses());
+  EXPECT_NE(expected, irac._irsend.outputStr());
+  irac.sendAc(state, &state);
+  EXPECT_EQ(3, irac.getFrameCacheHits());
+  irac.sendAc(state);  // This one was forgotten.
+  EXPECT_EQ(4, irac.getFrameCacheMisses());
+  irac._irsend.reset();
+
+  // Unsupported protocols aren't sent or remembered.
+  state.protocol = decode_type_t::NEC;
+  EXPECT_FALSE(irac.sendAc(state, &state));
+  EXPECT_FALSE(irac.sendAc(state, &state));
+  EXPECT_EQ(6, irac.getFrameCacheMisses());
+  EXPECT_EQ("", irac._irsend.outputStr());
+
+  irac.disableFrameCache();
+  state.protocol = decode_type_t::DAIKIN2;
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  EXPECT_EQ(0, irac.getFrameCacheHits());
+  EXPECT_EQ("", irac._irsend.outputStr());  // Sent the normal way.
+}
+#endif  // ENABLE_IRAC_FRAME_CACHE
+
+// Check encodeAc() works out what sendAc() would send, without sending it.
+TEST(TestIRac, EncodeAc) {
+  IRac irac(kGpioUnused);
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::DAIKIN2;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 22;
+
+  // What should be sent.
+  IRDaikin2 ac(kGpioUnused);
+  irac.daikin2(&ac, state);
+  const std::string expected = ac._irsend.outputStr();
+
+  IRsequence frame(kIRacFrameCacheMaxLength);
+  irac.next = state;
+  const stdAc::state_t prev = irac.getStatePrev();
+  ASSERT_TRUE(irac.encodeAc(state, &frame, &state));
+  IRsendTest irsend(kGpioUnused);
+  irsend.begin();
+  irsend.sendSequence(&frame);
+  EXPECT_EQ(expected, irsend.outputStr());
+  // Nothing else changed.
+  EXPECT_FALSE(IRac::cmpStates(irac.next, state));
+  EXPECT_FALSE(IRac::cmpStates(irac.getStatePrev(), prev));
+  // It is cleaned up like sendAc() does. e.g. The temp. is limited.
+  stdAc::state_t hot = state;
+  hot.degrees = 99;
+  IRDaikin2 hot_ac(kGpioUnused);
+  irac.daikin2(&hot_ac, hot);
+  ASSERT_TRUE(irac.encodeAc(hot, &frame));
+  irsend.reset();
+  irsend.sendSequence(&frame);
+  EXPECT_EQ(hot_ac._irsend.outputStr(), irsend.outputStr());
+  // Unsupported, or too long for the frame.
+  stdAc::state_t nec = state;
+  nec.protocol = decode_type_t::NEC;
+  EXPECT_FALSE(irac.encodeAc(nec, &frame));
+  IRsequence tiny(10);
+  EXPECT_FALSE(irac.encodeAc(state, &tiny));
+  // Just checking it can be sent.
+  EXPECT_TRUE(irac.encodeAc(state, NULL));
+  EXPECT_FALSE(irac.encodeAc(nec, NULL));
+
+#if ENABLE_IRAC_FRAME_CACHE
+  // It warms the frame cache, so sendAc() finds it there.
+  ASSERT_TRUE(irac.enableFrameCache(2));
+  ASSERT_TRUE(irac.encodeAc(state, NULL, &state));
+  EXPECT_EQ("", irac._irsend.outputStr());  // Nothing was sent.
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  EXPECT_EQ(1, irac.getFrameCacheHits());
+  EXPECT_EQ(0, irac.getFrameCacheMisses());
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+#endif  // ENABLE_IRAC_FRAME_CACHE
+}
+
+#if ENABLE_IRAC_CACHE
+// Check the protocol object sendAc() uses is kept between calls.
+TEST(TestIRac, Cache) {
+  IRac irac(kGpioUnused);
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::DAIKIN2;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 22;
+  EXPECT_EQ(NULL, irac._cache);
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  ASSERT_NE(nullptr, irac._cache);
+  void *first = irac._cache;
+  IRDaikin2 *cached = static_cast<IRDaikin2 *>(irac._cache);
+  EXPECT_EQ(22, cached->getTemp());
+  const std::string first_sent = cached->_irsend.outputStr();
+  EXPECT_NE("", first_sent);
+
+  // The same protocol & model re-uses it, & sends the same message as a fresh
+  // object would.
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  EXPECT_EQ(first, irac._cache);
+  EXPECT_EQ(first_sent, cached->_irsend.outputStr());
+  IRDaikin2 ac(kGpioUnused);
+  irac.daikin2(&ac, state);
+  EXPECT_EQ(first_sent, ac._irsend.outputStr());
+
+  // Only the changes need to be sent.
+  state.degrees = 25;
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  EXPECT_EQ(first, irac._cache);
+  EXPECT_EQ(25, cached->getTemp());
+
+  // A different protocol replaces it.
+  state.protocol = decode_type_t::COOLIX;
+  ASSERT_TRUE(irac.sendAc(state, &state));
+  ASSERT_NE(nullptr, irac._cache);
+  EXPECT_EQ(decode_type_t::COOLIX, irac._cache_protocol);
+  irac.clearCache();
+  EXPECT_EQ(NULL, irac._cache);
+}
+#endif  // ENABLE_IRAC_CACHE
+
+// Every protocol IRac can send, we should be able to decode into a state, and
+// vice versa. This also confirms the decoder table's order allows it to be
+// searched.
+TEST(TestIRac, isProtocolDecodable) {
+  for (int16_t i = decode_type_t::UNKNOWN; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    EXPECT_EQ(IRac::isProtocolSupported(protocol),
+              IRAcUtils::isProtocolDecodable(protocol))
+        << typeToString(protocol);
+  }
+  EXPECT_FALSE(IRAcUtils::isProtocolDecodable(decode_type_t::UNKNOWN));
+  EXPECT_FALSE(IRAcUtils::isProtocolDecodable(decode_type_t::NEC));
+  EXPECT_TRUE(IRAcUtils::isProtocolDecodable(decode_type_t::LG2));
+
+  decode_results unknown;
+  unknown.decode_type = decode_type_t::NEC;
+  stdAc::state_t result;
+  EXPECT_EQ("", IRAcUtils::resultAcToString(&unknown));
+  EXPECT_FALSE(IRAcUtils::decodeToState(&unknown, &result));
+}
+
+// Check a batch of A/C messages is sent from the right GPIOs, in order.
+TEST(TestIRac, Batch) {
+  IRac first(4);
+  IRac second(5);
+  IRac third(4);
+  IRrecv capture(kGpioUnused);
+  stdAc::state_t coolix, daikin2, kelvinator;
+  IRac::initState(&coolix);
+  coolix.protocol = decode_type_t::COOLIX;
+  coolix.power = true;
+  coolix.mode = stdAc::opmode_t::kCool;
+  coolix.degrees = 21;
+  daikin2 = coolix;
+  daikin2.protocol = decode_type_t::DAIKIN2;
+  kelvinator = coolix;
+  kelvinator.protocol = decode_type_t::KELVINATOR;
+
+  IRacBatch batch(2);
+  EXPECT_EQ(0, batch.pending());
+  EXPECT_FALSE(batch.handle());  // Nothing to send.
+  ASSERT_TRUE(batch.add(&first, coolix));
+  // It counts as sent.
+  EXPECT_EQ(decode_type_t::COOLIX, first.getStatePrev().protocol);
+  EXPECT_FALSE(first.hasStateChanged());
+  ASSERT_TRUE(batch.add(&second, daikin2));
+  EXPECT_FALSE(batch.add(&third, kelvinator));  // It's full.
+  EXPECT_EQ(decode_type_t::UNKNOWN, third.getStatePrev().protocol);
+  EXPECT_EQ(2, batch.pending());
+  EXPECT_EQ(2, batch._emitter_count);
+  EXPECT_EQ(batch._emitters[0].irsend, batch.getEmitter(4));
+  EXPECT_EQ(batch._emitters[1].irsend, batch.getEmitter(5));
+  EXPECT_EQ(NULL, batch.getEmitter(6));
+  EXPECT_EQ(0, batch.getGap());
+
+  // Nothing is sent until handle() is called, then one at a time.
+  IRsendTest *gpio4 = batch._emitters[0].irsend;
+  IRsendTest *gpio5 = batch._emitters[1].irsend;
+  EXPECT_EQ("", gpio4->outputStr());
+  EXPECT_TRUE(batch.handle());
+  EXPECT_EQ(1, batch.pending());
+  gpio4->makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&gpio4->capture));
+  EXPECT_EQ(decode_type_t::COOLIX, gpio4->capture.decode_type);
+  EXPECT_TRUE(batch.handle());
+  EXPECT_EQ(0, batch.pending());
+  gpio5->makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&gpio5->capture));
+  EXPECT_EQ(decode_type_t::DAIKIN2, gpio5->capture.decode_type);
+  EXPECT_FALSE(batch.handle());
+
+  // A/Cs on the same GPIO share it.
+  gpio4->reset();
+  ASSERT_TRUE(batch.add(&third, kelvinator));
+  EXPECT_EQ(2, batch._emitter_count);
+  EXPECT_TRUE(batch.handle());
+  gpio4->makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&gpio4->capture));
+  EXPECT_EQ(decode_type_t::KELVINATOR, gpio4->capture.decode_type);
+
+  // Unsupported protocols aren't added.
+  coolix.protocol = decode_type_t::NEC;
+  EXPECT_FALSE(batch.add(&first, coolix));
+  EXPECT_EQ(decode_type_t::COOLIX, first.getStatePrev().protocol);
+  EXPECT_EQ(0, batch.pending());
+
+  // Clearing forgets what hasn't been sent yet.
+  ASSERT_TRUE(batch.add(&second, daikin2));
+  batch.clear();
+  EXPECT_EQ(0, batch.pending());
+  EXPECT_FALSE(batch.handle());
+}
+
+// Check a packed state holds the same settings as the state it was set to.
+TEST(TestIRac, PackedState) {
+  stdAc::state_t state, init;
+  IRac::initState(&init);
+  IRacPackedState packed;
+  EXPECT_FALSE(IRac::cmpStates(init, packed.get()));
+  EXPECT_EQ(8, sizeof(packed));
+  state = init;
+  state.protocol = decode_type_t::DAIKIN2;
+  state.model = 3;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 22.5;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kLowest;
+  state.swingh = stdAc::swingh_t::kWide;
+  state.turbo = true;
+  state.sleep = 90;
+  state.clock = 1234;
+  ASSERT_TRUE(packed.set(state));
+  const stdAc::state_t result = packed.get();
+  EXPECT_FALSE(IRac::cmpStates(state, result));
+  EXPECT_EQ(1234, result.clock);
+  EXPECT_TRUE(packed == IRacPackedState(state));
+  EXPECT_TRUE(packed != IRacPackedState(init));
+
+  // What it can't hold is refused, & the state is unchanged.
+  stdAc::state_t bad = state;
+  bad.model = 31;
+  EXPECT_FALSE(packed.set(bad));
+  EXPECT_EQ(3, packed.get().model);
+  EXPECT_TRUE(IRacPackedState(bad) == IRacPackedState());
+}
+
+// Check channels share an engine, & send from the GPIO of each.
+TEST(TestIRac, Channels) {
+  IRacEngine engine;
+  IRacChannel lounge(&engine, 4), bedroom(&engine, 4), office(&engine, 5);
+  IRrecv capture(kGpioUnused);
+  stdAc::state_t state = lounge.getState();
+  EXPECT_EQ(decode_type_t::UNKNOWN, state.protocol);
+  EXPECT_FALSE(lounge.hasStateChanged());
+  state.protocol = decode_type_t::COOLIX;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 21;
+
+  ASSERT_TRUE(lounge.setState(state));
+  EXPECT_TRUE(lounge.hasStateChanged());
+  ASSERT_TRUE(lounge.sendAc());
+  EXPECT_FALSE(lounge.hasStateChanged());
+  EXPECT_EQ(decode_type_t::COOLIX, lounge.getStatePrev().protocol);
+  EXPECT_EQ(1, engine._emitter_count);
+  IRsendTest *gpio4 = engine._emitters[0];
+  EXPECT_EQ(gpio4, engine.getEmitter(4));
+  gpio4->makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&gpio4->capture));
+  EXPECT_EQ(decode_type_t::COOLIX, gpio4->capture.decode_type);
+
+  // Channels on the same GPIO share its IRsend.
+  gpio4->reset();
+  state.protocol = decode_type_t::DAIKIN2;
+  ASSERT_TRUE(bedroom.sendAc(state));
+  EXPECT_EQ(1, engine._emitter_count);
+  gpio4->makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&gpio4->capture));
+  EXPECT_EQ(decode_type_t::DAIKIN2, gpio4->capture.decode_type);
+
+  // Others get their own.
+  state.protocol = decode_type_t::KELVINATOR;
+  ASSERT_TRUE(office.sendAc(state));
+  EXPECT_EQ(2, engine._emitter_count);
+  IRsendTest *gpio5 = engine._emitters[1];
+  gpio5->makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&gpio5->capture));
+  EXPECT_EQ(decode_type_t::KELVINATOR, gpio5->capture.decode_type);
+  EXPECT_EQ(decode_type_t::DAIKIN2, bedroom.getState().protocol);
+
+  // Unsupported protocols aren't sent, or marked as sent.
+  gpio5->reset();
+  state.protocol = decode_type_t::NEC;
+  EXPECT_FALSE(office.sendAc(state));
+  EXPECT_TRUE(office.hasStateChanged());
+  EXPECT_EQ(decode_type_t::KELVINATOR, office.getStatePrev().protocol);
+  EXPECT_EQ("", gpio5->outputStr());
+
+  // A channel without an engine can't send.
+  IRacChannel orphan(NULL, 4);
+  EXPECT_FALSE(orphan.sendAc());
+}
+
+// Check states survive being converted to & from their binary & base64 forms.
+TEST(TestIRac, StateToJson) {
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::DAIKIN2;
+  state.model = 3;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 22.5;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kLowest;
+  state.swingh = stdAc::swingh_t::kWide;
+  state.turbo = true;
+  state.sleep = 90;
+  char json[kIRacStateJsonSize];
+  const char *expected =
+      "{\"protocol\":\"DAIKIN2\",\"model\":3,\"power\":\"On\","
+      "\"mode\":\"Heat\",\"use_celsius\":\"On\",\"temp\":22.5,"
+      "\"fanspeed\":\"Max\",\"swingv\":\"Lowest\",\"swingh\":\"Wide\","
+      "\"quiet\":\"Off\",\"turbo\":\"On\",\"econo\":\"Off\","
+      "\"light\":\"Off\",\"filter\":\"Off\",\"clean\":\"Off\","
+      "\"beep\":\"Off\",\"sleep\":90}";
+  EXPECT_EQ(strlen(expected), IRac::stateToJson(state, json, sizeof(json)));
+  EXPECT_STREQ(expected, json);
+  EXPECT_EQ(0, IRac::stateToJson(state, json, 20));
+  EXPECT_STREQ("", json);
+}
+
+TEST(TestIRac, StateToBinary) {
+  stdAc::state_t state, result;
+  IRac::initState(&state);
+  IRac::initState(&result);
+  uint8_t data[kIRacStateBinaryLength];
+
+  ASSERT_TRUE(IRac::stateToBinary(state, data));
+  EXPECT_EQ(kIRacStateBinaryVersion, data[0]);
+  ASSERT_TRUE(IRac::binaryToState(data, kIRacStateBinaryLength, &result));
+  EXPECT_FALSE(IRac::cmpStates(state, result));
+  EXPECT_EQ(state.clock, result.clock);
+
+  // Everything set to something other than the default.
+  state.protocol = decode_type_t::DAIKIN2;
+  state.model = 3;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kHeat;
+  state.degrees = 22.5;
+  state.celsius = false;
+  state.fanspeed = stdAc::fanspeed_t::kMax;
+  state.swingv = stdAc::swingv_t::kLowest;
+  state.swingh = stdAc::swingh_t::kWide;
+  state.quiet = true;
+  state.turbo = true;
+  state.econo = true;
+  state.light = true;
+  state.filter = true;
+  state.clean = true;
+  state.beep = true;
+  state.sleep = 2046;
+  state.clock = 1439;
+  ASSERT_TRUE(IRac::stateToBinary(state, data));
+  ASSERT_TRUE(IRac::binaryToState(data, kIRacStateBinaryLength, &result));
+  EXPECT_FALSE(IRac::cmpStates(state, result));
+  EXPECT_EQ(1439, result.clock);
+  const String text = IRac::stateToBase64(state);
+  EXPECT_EQ(12, text.length());
+  IRac::initState(&result);
+  ASSERT_TRUE(IRac::base64ToState(text.c_str(), &result));
+  EXPECT_FALSE(IRac::cmpStates(state, result));
+  EXPECT_EQ(1439, result.clock);
+
+  // It's kept to the nearest half degree.
+  state.degrees = 19.8;
+  ASSERT_TRUE(IRac::base64ToState(IRac::stateToBase64(state).c_str(),
+                                  &result));
+  EXPECT_EQ(20, result.degrees);
+
+  // Things it can't hold.
+  stdAc::state_t bad = state;
+  bad.model = 31;
+  EXPECT_FALSE(IRac::stateToBinary(bad, data));
+  EXPECT_EQ("", IRac::stateToBase64(bad));
+  bad = state;
+  bad.degrees = -1;
+  EXPECT_FALSE(IRac::stateToBinary(bad, data));
+  bad = state;
+  bad.sleep = 2047;
+  EXPECT_FALSE(IRac::stateToBinary(bad, data));
+
+  // Things it won't accept.
+  ASSERT_TRUE(IRac::stateToBinary(state, data));
+  result = state;
+  result.degrees = 30;
+  EXPECT_FALSE(IRac::binaryToState(data, kIRacStateBinaryLength - 1, &result));
+  data[0]++;  // An unknown version.
+  EXPECT_FALSE(IRac::binaryToState(data, kIRacStateBinaryLength, &result));
+  data[0]--;
+  data[4] |= 0xE0;  // An impossible swingv.
+  EXPECT_FALSE(IRac::binaryToState(data, kIRacStateBinaryLength, &result));
+  EXPECT_FALSE(IRac::base64ToState("Not base64!", &result));
+  EXPECT_FALSE(IRac::base64ToState("AAAA", &result));  // Too short.
+  EXPECT_FALSE(IRac::base64ToState(NULL, &result));
+  EXPECT_EQ(30, result.degrees);  // Unchanged.
+}
+
+// Check only the short message(s) for what changed are sent, when asked to.
+TEST(TestIRac, DeltaSend) {
+  IRac irac(kGpioUnused);
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  IRsequence sent;
+  stdAc::state_t prev, state;
+  IRac::initState(&prev);
+  prev.protocol = decode_type_t::FUJITSU_AC;
+  prev.model = fujitsu_ac_remote_model_t::ARRAH2E;
+  prev.power = true;
+  prev.mode = stdAc::opmode_t::kCool;
+  prev.degrees = 22;
+  state = prev;
+  state.swingv = stdAc::swingv_t::kAuto;
+
+  EXPECT_FALSE(irac.getDeltaSend());
+  // Normally, the full state is sent.
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::FUJITSU_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kFujitsuAcBits, irsend.capture.bits);
+  const uint16_t full_length = sent.length();
+
+  irac.setDeltaSend(true);
+  EXPECT_TRUE(irac.getDeltaSend());
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_LT(sent.length(), full_length);
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::FUJITSU_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kFujitsuAcMinBits + 8, irsend.capture.bits);
+  EXPECT_EQ(kFujitsuAcCmdToggleSwingVert, irsend.capture.state[5]);
+
+  // Anything else changing needs the full state.
+  state.degrees = 24;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(full_length, sent.length());
+  // As does not having a previous state.
+  state.degrees = prev.degrees;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(full_length, sent.length());
+
+  // Toshiba only sends its short swing message.
+  prev.protocol = decode_type_t::TOSHIBA_AC;
+  prev.model = -1;
+  state = prev;
+  state.swingv = stdAc::swingv_t::kAuto;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::TOSHIBA_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kToshibaACBitsShort, irsend.capture.bits);
+  IRToshibaAC ac(kGpioUnused);
+  ac.setRaw(irsend.capture.state);
+  EXPECT_EQ(kToshibaAcSwingOn, ac.getSwing());
+  // Only one message was sent.
+  EXPECT_EQ(irsend.capture.rawlen - 1, sent.length());
+
+  // A Toshiba change that isn't the swing skips the separate swing message.
+  state = prev;
+  state.degrees = 24;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::TOSHIBA_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kToshibaACBits, irsend.capture.bits);
+  EXPECT_EQ(irsend.capture.rawlen - 1, sent.length());
+  const uint16_t toshiba_length = sent.length();
+  // Without a previous state, it can't tell. So it sends both.
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_GT(sent.length(), toshiba_length);
+
+  // Turning on a Fujitsu ARREB1E's Powerful mode is just its command.
+  prev.protocol = decode_type_t::FUJITSU_AC;
+  prev.model = fujitsu_ac_remote_model_t::ARREB1E;
+  state = prev;
+  state.turbo = true;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::FUJITSU_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kFujitsuAcMinBits + 8, irsend.capture.bits);
+  EXPECT_EQ(kFujitsuAcCmdPowerful, irsend.capture.state[5]);
+  EXPECT_EQ(irsend.capture.rawlen - 1, sent.length());
+  // Turning it off needs the full state.
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(prev, &state));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_GT(irsend.capture.bits, kFujitsuAcMinBits + 8);
+
+  // Vestel only sends the settings or the time message that changed.
+  prev.protocol = decode_type_t::VESTEL_AC;
+  prev.model = -1;
+  prev.clock = 10 * 60;
+  state = prev;
+  state.degrees = 24;
+  IRVestelAc vestel(kGpioUnused);
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::VESTEL_AC, irsend.capture.decode_type);
+  vestel.setRaw(irsend.capture.value);
+  EXPECT_FALSE(vestel.isTimeCommand());
+  EXPECT_EQ(24, vestel.getTemp());
+  const uint16_t settings_length = sent.length();
+  // Just the time.
+  state = prev;
+  state.clock = 11 * 60;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state, &prev));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::VESTEL_AC, irsend.capture.decode_type);
+  vestel.setRaw(irsend.capture.value);
+  EXPECT_TRUE(vestel.isTimeCommand());
+  EXPECT_EQ(11 * 60, vestel.getTime());
+  const uint16_t time_length = sent.length();
+  // Without a previous state, it sends both.
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc(state));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(settings_length + time_length, sent.length());
+}
+
+// Check repeats of the last message of a protocol are spotted.
+TEST(TestIRac, IRAcDecoder) {
+  IRAcDecoder decoder;
+  IRrecv irrecv(kGpioUnused);
+  IRsendTest irsend(kGpioUnused);
+  stdAc::state_t result, prev;
+  IRac::initState(&result);
+
+  IRDaikin2 daikin(kGpioUnused);
+  daikin.begin();
+  daikin.on();
+  daikin.setMode(kDaikinCool);
+  daikin.setTemp(21);
+  irsend.sendDaikin2(daikin.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(decode_type_t::DAIKIN2, irsend.capture.decode_type);
+  EXPECT_EQ(kIRAcDecodeChanged, decoder.decode(&irsend.capture, &result));
+  EXPECT_EQ(decode_type_t::DAIKIN2, result.protocol);
+  EXPECT_EQ(21, result.degrees);
+  // The same message again.
+  IRac::initState(&result);
+  EXPECT_EQ(kIRAcDecodeUnchanged, decoder.decode(&irsend.capture, &result));
+  EXPECT_EQ(decode_type_t::DAIKIN2, result.protocol);
+  EXPECT_EQ(21, result.degrees);
+  // A different one.
+  daikin.setTemp(24);
+  irsend.reset();
+  irsend.sendDaikin2(daikin.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(kIRAcDecodeChanged, decoder.decode(&irsend.capture, &result));
+  EXPECT_EQ(24, result.degrees);
+
+  // Protocols which use `value` rather than `state`, & a previous state.
+  IRCoolixAC coolix(kGpioUnused);
+  coolix.begin();
+  coolix.setMode(kCoolixCool);
+  coolix.setTemp(22);
+  irsend.reset();
+  irsend.sendCOOLIX(coolix.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(decode_type_t::COOLIX, irsend.capture.decode_type);
+  IRac::initState(&prev);
+  EXPECT_EQ(kIRAcDecodeChanged,
+            decoder.decode(&irsend.capture, &result, &prev));
+  EXPECT_EQ(decode_type_t::COOLIX, result.protocol);
+  EXPECT_EQ(22, result.degrees);
+  EXPECT_EQ(kIRAcDecodeUnchanged,
+            decoder.decode(&irsend.capture, &result, &prev));
+  // The result depends on the previous state (e.g. toggles), so a different
+  // one is converted again, even for the same message.
+  stdAc::state_t other = prev;
+  other.protocol = decode_type_t::COOLIX;
+  other.swingv = stdAc::swingv_t::kAuto;
+  EXPECT_EQ(kIRAcDecodeChanged,
+            decoder.decode(&irsend.capture, &result, &other));
+  EXPECT_EQ(stdAc::swingv_t::kAuto, result.swingv);
+  EXPECT_EQ(kIRAcDecodeChanged, decoder.decode(&irsend.capture, &result));
+
+  // Each protocol's last message is remembered separately.
+  irsend.reset();
+  irsend.sendDaikin2(daikin.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(kIRAcDecodeUnchanged, decoder.decode(&irsend.capture, &result));
+  EXPECT_EQ(decode_type_t::DAIKIN2, result.protocol);
+  decoder.clear();
+  EXPECT_EQ(kIRAcDecodeChanged, decoder.decode(&irsend.capture, &result));
+  // But only for as many protocols as it was asked to.
+  IRAcDecoder single(1);
+  EXPECT_EQ(kIRAcDecodeChanged, single.decode(&irsend.capture, &result));
+  EXPECT_EQ(kIRAcDecodeUnchanged, single.decode(&irsend.capture, &result));
+  decode_results daikin2 = irsend.capture;
+  irsend.reset();
+  irsend.sendCOOLIX(coolix.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(kIRAcDecodeChanged, single.decode(&irsend.capture, &result));
+  EXPECT_EQ(kIRAcDecodeChanged, single.decode(&daikin2, &result));
+
+  // Things that aren't A/C messages.
+  irsend.reset();
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  IRac::initState(&result);
+  EXPECT_EQ(kIRAcDecodeFailed, decoder.decode(&irsend.capture, &result));
+  EXPECT_EQ(decode_type_t::UNKNOWN, result.protocol);
+  EXPECT_EQ(kIRAcDecodeFailed, decoder.decode(NULL, &result));
+  EXPECT_EQ(kIRAcDecodeFailed, decoder.decode(&irsend.capture, NULL));
+}
+
+// Check sendAc() can skip sending states the A/C should already be in.
+TEST(TestIRac, SuppressDuplicates) {
+  IRac irac(kGpioUnused);
+  IRsequence sent;
+  EXPECT_FALSE(irac.getSuppressDuplicates());
+  irac.next.protocol = decode_type_t::DAIKIN2;
+  irac.next.power = true;
+  irac.next.mode = stdAc::opmode_t::kCool;
+  irac.next.degrees = 22;
+  // Normally, the same state is sent every time.
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc());
+  EXPECT_TRUE(IRsend::stopRecordingAll());
+  const uint16_t frame_length = sent.length();
+  EXPECT_LT(0, frame_length);
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendAc());
+  EXPECT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(frame_length, sent.length());
+  EXPECT_EQ(0, irac.getSuppressedCount());
+
+  irac.setSuppressDuplicates(true, 60 * 1000, 1.0);
+  EXPECT_TRUE(irac.getSuppressDuplicates());
+  IRsend::startRecordingAll(&sent);
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_FALSE(IRsend::stopRecordingAll());  // Nothing was sent.
+  EXPECT_EQ(0, sent.length());
+  EXPECT_EQ(1, irac.getSuppressedCount());
+  // Small temperature changes don't count, & don't update what was sent, so
+  // they add up.
+  irac.next.degrees = 22.5;
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_EQ(2, irac.getSuppressedCount());
+  EXPECT_EQ(22, irac.getStatePrev().degrees);
+  irac.next.degrees = 23;
+  IRsend::startRecordingAll(&sent);
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(frame_length, sent.length());
+  EXPECT_EQ(2, irac.getSuppressedCount());
+  EXPECT_EQ(23, irac.getStatePrev().degrees);
+  // Any other change is sent.
+  irac.next.fanspeed = stdAc::fanspeed_t::kHigh;
+  IRsend::startRecordingAll(&sent);
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(2, irac.getSuppressedCount());
+  // It is sent again once the re-assert time has passed.
+  TimerMs::add(59 * 1000);
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_EQ(3, irac.getSuppressedCount());
+  TimerMs::add(1000);
+  IRsend::startRecordingAll(&sent);
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(3, irac.getSuppressedCount());
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_EQ(4, irac.getSuppressedCount());
+
+  // Turning it off goes back to sending everything.
+  irac.setSuppressDuplicates(false);
+  IRsend::startRecordingAll(&sent);
+  EXPECT_TRUE(irac.sendAc());
+  EXPECT_TRUE(IRsend::stopRecordingAll());
+  EXPECT_EQ(4, irac.getSuppressedCount());
+}
+
+// Sensor temperature reports are only sent for the protocols that have them,
+// directly or via a queue.
+TEST(TestIRac, SensorTemp) {
+  IRac irac(kGpioUnused);
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  IRsendQueue queue(&irsend);
+  IRsequence sent;
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 24;
+
+  state.protocol = decode_type_t::DAIKIN;
+  EXPECT_FALSE(IRac::isSensorTempSupported(state.protocol));
+  EXPECT_FALSE(irac.sendSensorTemp(state, 25));
+
+  // Argo's report is a short message of its own.
+  state.protocol = decode_type_t::ARGO;
+  ASSERT_TRUE(IRac::isSensorTempSupported(state.protocol));
+  uint8_t report[kArgoShortStateLength];
+  IRArgoAC::encodeSensorTemp(25, report);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendArgo(report, kArgoShortStateLength);
+  const std::string expected = irsend.outputStr();
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(irac.sendSensorTemp(state, 25));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  EXPECT_EQ(expected, irsend.outputStr());
+  irsend.reset();
+  ASSERT_TRUE(irac.sendSensorTemp(state, 25, &queue));
+  EXPECT_EQ("", irsend.outputStr());  // Only queued.
+  EXPECT_EQ(1, queue.pending());
+  ASSERT_TRUE(queue.handle());
+  EXPECT_EQ(expected, irsend.outputStr());
+  IRtimer::add(queue.getGap());
+
+  // Coolix's report is its state, with the sensor temp.
+  state.protocol = decode_type_t::COOLIX;
+  ASSERT_TRUE(IRac::isSensorTempSupported(state.protocol));
+  irsend.reset();
+  ASSERT_TRUE(irac.sendSensorTemp(state, 25, &queue));
+  ASSERT_TRUE(queue.handle());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  ASSERT_EQ(decode_type_t::COOLIX, irsend.capture.decode_type);
+  IRCoolixAC decoded(kGpioUnused);
+  decoded.setRaw(irsend.capture.value);
+  EXPECT_EQ(24, decoded.getTemp());
+  EXPECT_EQ(25, decoded.getSensorTemp());
+  EXPECT_TRUE((irsend.capture.value >> kCoolixZoneFollowMaskOffset) & 1);
+  state.power = false;
+  EXPECT_FALSE(irac.sendSensorTemp(state, 25, &queue));
+}
+
+// Check a single protocol IRacT sends what IRac would.
+TEST(TestIRacT, SameAsIRac) {
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 22;
+
+  IRDaikin2 daikin2(kGpioUnused);
+  IRac::daikin2(&daikin2, state);
+  IRacT<decode_type_t::DAIKIN2> daikin2T(kGpioUnused);
+  ASSERT_TRUE(daikin2T.sendAc(state));  // The protocol of state is ignored.
+  EXPECT_EQ(daikin2._irsend.outputStr(), daikin2T._ac._irsend.outputStr());
+
+  // Classes that are made with a model get it from the state.
+  state.model = fujitsu_ac_remote_model_t::ARRY4;
+  IRacT<decode_type_t::FUJITSU_AC> fujitsuT(kGpioUnused);
+  ASSERT_TRUE(fujitsuT.sendAc(state));
+  EXPECT_EQ(fujitsu_ac_remote_model_t::ARRY4, fujitsuT._ac.getModel());
+  state.model = -1;
+
+  // Toggles are worked out from the previous state.
+  IRacT<decode_type_t::COOLIX> coolixT(kGpioUnused);
+  EXPECT_EQ(decode_type_t::COOLIX, coolixT.getState().protocol);
+  coolixT.next = state;
+  coolixT.next.light = true;
+  ASSERT_TRUE(coolixT.sendAc());
+  EXPECT_TRUE(coolixT.getStatePrev().light);
+  stdAc::state_t prev = state;
+  prev.protocol = decode_type_t::COOLIX;
+  stdAc::state_t desired = prev;
+  desired.light = true;
+  IRCoolixAC coolix(kGpioUnused);
+  IRac::coolix(&coolix, IRac::handleToggles(desired, &prev));
+  EXPECT_EQ(coolix._irsend.outputStr(), coolixT._ac._irsend.outputStr());
+  // Nothing changed, so there is no light toggle this time.
+  coolixT._ac._irsend.reset();
+  coolix._irsend.reset();
+  ASSERT_TRUE(coolixT.sendAc());
+  IRac::coolix(&coolix, IRac::handleToggles(desired, &desired));
+  EXPECT_EQ(coolix._irsend.outputStr(), coolixT._ac._irsend.outputStr());
+}
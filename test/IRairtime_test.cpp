@@ -0,0 +1,173 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRairtime.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRtimer.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRairtime class.
+
+// A frame that lasts 55 mSeconds (54.06 rounded up).
+void makeFrame(IRsequence *frame) {
+  const uint16_t durations[4] = {9000, 4500, 560, 40000};
+  ASSERT_TRUE(frame->set(durations, 4, 38000));
+}
+
+TEST(TestIRairtime, TimeBase) {
+  IRairtime airtime(3);
+  EXPECT_EQ(3, airtime.getNode());
+  EXPECT_FALSE(airtime.isSynced());
+  airtime.setTime(1000000);
+  EXPECT_TRUE(airtime.isSynced());
+  EXPECT_EQ(1000000, airtime.now());
+  TimerMs::add(250);
+  EXPECT_EQ(1000250, airtime.now());
+  airtime.setTime(2000000);  // Resynced.
+  EXPECT_EQ(2000000, airtime.now());
+}
+
+TEST(TestIRairtime, Slots) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  IRsequence frame;
+  makeFrame(&frame);
+  IRairtime airtime(2);
+  airtime.setTime(1000000);  // The start of a cycle.
+  airtime.setSlots(500, 4, 2);  // Ours is from 1000 to 1500 mSecs into it.
+  EXPECT_EQ(0, airtime.nextStart());
+  EXPECT_FALSE(airtime.handle());  // Nothing to send.
+
+  irsend.reset();
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  EXPECT_EQ(1, airtime.pending());
+  EXPECT_EQ(1001000, airtime.nextStart());
+  EXPECT_FALSE(airtime.handle());
+  TimerMs::add(999);
+  EXPECT_FALSE(airtime.handle());
+  TimerMs::add(1);
+  EXPECT_TRUE(airtime.handle());
+  EXPECT_EQ(0, airtime.pending());
+  EXPECT_EQ("f38000d50m9000s4500m560s40000", irsend.outputStr());
+
+  // In our slot, so straight away, & then each after the one before it.
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  EXPECT_EQ(2, airtime.pending());
+  EXPECT_EQ(1001000, airtime.nextStart());
+  EXPECT_TRUE(airtime.handle());
+  EXPECT_EQ(1001075, airtime.nextStart());  // + 55 + the guard time.
+  EXPECT_FALSE(airtime.handle());
+  TimerMs::add(75);
+  EXPECT_TRUE(airtime.handle());
+
+  // Only if the rest of the slot has room for it.
+  TimerMs::add(400);
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  EXPECT_EQ(1003000, airtime.nextStart());  // The next cycle's.
+  // If it wasn't sent in its slot, it waits for the next one.
+  TimerMs::add(2025);  // Past the end of it.
+  EXPECT_FALSE(airtime.handle());
+  EXPECT_EQ(1005000, airtime.nextStart());
+  EXPECT_EQ(1, airtime.pending());
+  airtime.clear();
+  EXPECT_EQ(0, airtime.pending());
+
+  // Without slots, it is sent straight away.
+  airtime.setSlots(500, 1, 0);
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  EXPECT_TRUE(airtime.handle());
+}
+
+TEST(TestIRairtime, Reservations) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  IRsequence frame;
+  makeFrame(&frame);
+  IRairtime airtime(2);
+  ir_airtime_reservation_t reservation;
+  airtime.setTime(5000000);
+  airtime.setReservations(true, 100);
+  EXPECT_FALSE(airtime.announce(&reservation));
+
+  // Planned far enough ahead for the others to hear of it.
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  EXPECT_EQ(5000100, airtime.nextStart());
+  ASSERT_TRUE(airtime.announce(&reservation));
+  EXPECT_EQ(5000100, reservation.start);
+  EXPECT_EQ(55, reservation.duration);
+  EXPECT_EQ(2, reservation.node);
+  EXPECT_FALSE(airtime.announce(&reservation));  // Only once.
+
+  // A lower node keeps the time, so ours moves, & is announced again.
+  reservation.start = 5000080;
+  reservation.duration = 100;
+  reservation.node = 1;
+  EXPECT_TRUE(airtime.addReservation(reservation));
+  EXPECT_EQ(5000200, airtime.nextStart());
+  ASSERT_TRUE(airtime.announce(&reservation));
+  EXPECT_EQ(5000200, reservation.start);
+  // A higher node's doesn't move ours. It moves its own.
+  reservation.start = 5000200;
+  reservation.duration = 50;
+  reservation.node = 7;
+  EXPECT_TRUE(airtime.addReservation(reservation));
+  EXPECT_EQ(5000200, airtime.nextStart());
+  EXPECT_FALSE(airtime.announce(&reservation));
+  // Our own, & those that are over, are ignored.
+  reservation.node = 2;
+  EXPECT_FALSE(airtime.addReservation(reservation));
+  reservation.start = 4000000;
+  reservation.node = 3;
+  EXPECT_FALSE(airtime.addReservation(reservation));
+
+  // A new frame is planned clear of them all. Node 1's, node 7's, & ours.
+  ASSERT_TRUE(airtime.add(&irsend, &frame));
+  ASSERT_TRUE(airtime.announce(&reservation));
+  EXPECT_EQ(5000275, reservation.start);
+
+  TimerMs::add(200);
+  EXPECT_TRUE(airtime.handle());
+  EXPECT_FALSE(airtime.handle());
+  TimerMs::add(75);
+  EXPECT_TRUE(airtime.handle());
+  EXPECT_EQ(0, airtime.pending());
+}
+
+TEST(TestIRairtime, AbsoluteTime) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  IRsequence frame;
+  makeFrame(&frame);
+  IRairtime airtime(1);
+  airtime.setTime(1000);
+  airtime.setSlots(500, 4, 1);
+  ir_airtime_reservation_t reservation;
+
+  // Sent at the given time, whatever the slots.
+  ASSERT_TRUE(airtime.add(&irsend, &frame, 1200));
+  EXPECT_EQ(1200, airtime.nextStart());
+  EXPECT_FALSE(airtime.announce(&reservation));  // Reservations aren't used.
+  TimerMs::add(199);
+  EXPECT_FALSE(airtime.handle());
+  TimerMs::add(1);
+  EXPECT_TRUE(airtime.handle());
+
+  // It is announced, if they are, but isn't moved by a lower node's.
+  airtime.setReservations(true);
+  ASSERT_TRUE(airtime.add(&irsend, &frame, 3000));
+  reservation.start = 2990;
+  reservation.duration = 100;
+  reservation.node = 0;
+  EXPECT_TRUE(airtime.addReservation(reservation));
+  ASSERT_TRUE(airtime.announce(&reservation));
+  EXPECT_EQ(3000, reservation.start);
+  EXPECT_EQ(3000, airtime.nextStart());
+
+  // Nothing is added if it is full.
+  IRairtime small(0, 1);
+  EXPECT_TRUE(small.add(&irsend, &frame));
+  EXPECT_FALSE(small.add(&irsend, &frame));
+  EXPECT_FALSE(small.add(NULL, &frame));
+}
@@ -0,0 +1,341 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRcodeStore.h"
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRcodeStore & IRcodeStoreBuilder classes.
+
+// Made by tools/ir_code_store.py from:
+//   {"tv_power": {"protocol": "NEC", "value": "0x20DF10EF"},
+//    "fan": {"raw": [9000, 4500, 560, 1690, 560], "frequency": 40000},
+//    "sat": {"pronto": "0000 006D 0002 0000 0156 00AB 0015 0040"}}
+// See `IMAGE` in tools/ir_code_store_test.py
+const uint8_t kCodes[] = {
+    0x49, 0x52, 0x43, 0x53, 0x01, 0x00, 0x03, 0x00, 0x52, 0x00, 0x00, 0x00,
+    0x6A, 0x00, 0x00, 0x00, 0x01, 0x08, 0x74, 0x76, 0x5F, 0x70, 0x6F, 0x77,
+    0x65, 0x72, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x10, 0xDF, 0x20,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x66, 0x61, 0x6E, 0x40, 0x9C, 0x00,
+    0x00, 0x32, 0x05, 0x00, 0x28, 0x23, 0x94, 0x11, 0x30, 0x02, 0x9A, 0x06,
+    0x30, 0x02, 0x03, 0x03, 0x73, 0x61, 0x74, 0x8C, 0x94, 0x00, 0x00, 0x32,
+    0x04, 0x00, 0x22, 0x23, 0x91, 0x11, 0x28, 0x02, 0x93, 0x06, 0xC9, 0xAE,
+    0xF3, 0x85, 0x10, 0x00, 0x00, 0x00, 0x72, 0xFA, 0xF7, 0xA8, 0x28, 0x00,
+    0x00, 0x00, 0xD7, 0x92, 0x1C, 0xD6, 0x3E, 0x00, 0x00, 0x00,
+};
+
+TEST(TestIRcodeStore, Find) {
+  IRcodeStore store(kCodes, sizeof(kCodes));
+  ASSERT_TRUE(store.isValid());
+  EXPECT_EQ(3, store.count());
+  ircode_t code;
+
+  ASSERT_TRUE(store.find("tv_power", &code));
+  EXPECT_EQ(kCodeValue, code.kind);
+  EXPECT_EQ(decode_type_t::NEC, code.protocol);
+  EXPECT_EQ(0x20DF10EF, code.value);
+  EXPECT_EQ(0, code.bits);  // i.e. The protocol's default.
+  EXPECT_EQ(0, code.repeat);
+
+  ASSERT_TRUE(store.find("fan", &code));
+  EXPECT_EQ(kCodeRaw, code.kind);
+  EXPECT_EQ(decode_type_t::UNKNOWN, code.protocol);
+  EXPECT_EQ(40000, code.frequency);
+  EXPECT_EQ(50, code.duty);
+  EXPECT_EQ(5, code.length);
+
+  ASSERT_TRUE(store.find("sat", &code));
+  EXPECT_EQ(kCodeRaw, code.kind);
+  EXPECT_EQ(38028, code.frequency);
+  EXPECT_EQ(4, code.length);
+
+  // Only whole names match.
+  EXPECT_FALSE(store.find("fa", &code));
+  EXPECT_FALSE(store.find("fans", &code));
+  EXPECT_FALSE(store.find("", &code));
+  EXPECT_FALSE(store.find(NULL, &code));
+}
+
+TEST(TestIRcodeStore, Send) {
+  IRcodeStore store(kCodes, sizeof(kCodes));
+  IRsendTest irsend(kGpioUnused);
+  IRsendTest expected(kGpioUnused);
+  irsend.begin();
+  expected.begin();
+
+  // The same as sending them directly.
+  ASSERT_TRUE(store.send("tv_power", &irsend));
+  expected.sendNEC(0x20DF10EF);
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+
+  irsend.reset();
+  ASSERT_TRUE(store.send("fan", &irsend));
+  EXPECT_EQ("f40000d50m9000s4500m560s1690m560", irsend.outputStr());
+
+  irsend.reset();
+  expected.reset();
+  ASSERT_TRUE(store.send("sat", &irsend));
+  uint16_t pronto[8] = {0x0000, 0x006D, 0x0002, 0x0000,
+                        0x0156, 0x00AB, 0x0015, 0x0040};
+  expected.sendPronto(pronto, 8);
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+
+  irsend.reset();
+  EXPECT_FALSE(store.send("missing", &irsend));
+  EXPECT_FALSE(store.send("fan", reinterpret_cast<IRsend *>(NULL)));
+  EXPECT_EQ("", irsend.outputStr());
+}
+
+TEST(TestIRcodeStore, Compile) {
+  IRcodeStore store(kCodes, sizeof(kCodes));
+  IRsendTest irsend(kGpioUnused);
+  IRsendTest expected(kGpioUnused);
+  IRsequence sequence;
+
+  ASSERT_TRUE(store.compile("tv_power", &irsend, &sequence));
+  EXPECT_EQ("", irsend.outputStr());  // Nothing was sent.
+  irsend.sendSequence(&sequence);
+  expected.sendNEC(0x20DF10EF);
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+
+  EXPECT_FALSE(store.compile("missing", &irsend, &sequence));
+  IRsequence tiny(2);  // Too small.
+  EXPECT_FALSE(store.compile("fan", &irsend, &tiny));
+}
+
+TEST(TestIRcodeStore, Invalid) {
+  ircode_t code;
+  IRcodeStore none(NULL, 0);
+  EXPECT_FALSE(none.isValid());
+  EXPECT_EQ(0, none.count());
+  EXPECT_FALSE(none.find("fan", &code));
+  // Truncated.
+  IRcodeStore truncated(kCodes, sizeof(kCodes) - 1);
+  EXPECT_FALSE(truncated.isValid());
+  EXPECT_FALSE(truncated.find("fan", &code));
+  // Not an image.
+  uint8_t image[sizeof(kCodes)];
+  memcpy(image, kCodes, sizeof(image));
+  image[0] = 'X';
+  EXPECT_FALSE(IRcodeStore(image, sizeof(image)).isValid());
+  // A newer version.
+  memcpy(image, kCodes, sizeof(image));
+  image[4] = kCodeStoreVersion + 1;
+  EXPECT_FALSE(IRcodeStore(image, sizeof(image)).isValid());
+  // A record that runs into the index.
+  memcpy(image, kCodes, sizeof(image));
+  image[50] = 0xFF;  // The nr. of entries of "fan".
+  IRcodeStore overrun(image, sizeof(image));
+  EXPECT_TRUE(overrun.isValid());
+  EXPECT_FALSE(overrun.find("fan", &code));
+  EXPECT_TRUE(overrun.find("sat", &code));
+}
+
+TEST(TestIRcodeStoreBuilder, SameAsTheTool) {
+  uint8_t buffer[256];
+  IRcodeStoreBuilder builder(buffer, sizeof(buffer));
+  const uint16_t fan[5] = {9000, 4500, 560, 1690, 560};
+  const uint16_t sat[4] = {8994, 4497, 552, 1683};
+  ASSERT_TRUE(builder.addValue("tv_power", decode_type_t::NEC, 0x20DF10EF));
+  ASSERT_TRUE(builder.addRaw("fan", fan, 5, 40000));
+  ASSERT_TRUE(builder.addRaw("sat", sat, 4, 38028));
+  EXPECT_EQ(3, builder.count());
+  ASSERT_EQ(sizeof(kCodes), builder.finish());
+  EXPECT_EQ(0, memcmp(kCodes, buffer, sizeof(kCodes)));
+  // Nothing more can be added.
+  EXPECT_FALSE(builder.addRaw("more", fan, 5));
+  EXPECT_EQ(0, builder.finish());
+}
+
+TEST(TestIRcodeStoreBuilder, StatesAndAc) {
+  uint8_t buffer[128];
+  IRcodeStoreBuilder builder(buffer, sizeof(buffer));
+  const uint8_t gree[kGreeStateLength] = {0x00, 0x09, 0x20, 0x50,
+                                          0x00, 0x20, 0x00, 0x50};
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::SAMSUNG_AC;
+  state.power = true;
+  state.mode = stdAc::opmode_t::kCool;
+  state.degrees = 24;
+  ASSERT_TRUE(builder.addState("gree", decode_type_t::GREE, gree,
+                               kGreeStateLength));
+  ASSERT_TRUE(builder.addAc("cool", state));
+  const uint32_t size = builder.finish();
+  ASSERT_LT(0, size);
+  IRcodeStore store(buffer, size);
+  ASSERT_EQ(2, store.count());
+
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  irsend.begin();
+  ASSERT_TRUE(store.send("gree", &irsend));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::GREE, irsend.capture.decode_type);
+  EXPECT_STATE_EQ(gree, irsend.capture.state, kGreeBits);
+
+  // An A/C code needs an IRac, & the others need an IRsend.
+  IRac irac(kGpioUnused);
+  EXPECT_FALSE(store.send("cool", &irsend));
+  EXPECT_FALSE(store.send("gree", &irac));
+  IRsequence sent;
+  IRsend::startRecordingAll(&sent);
+  ASSERT_TRUE(store.send("cool", &irac));
+  ASSERT_TRUE(IRsend::stopRecordingAll());
+  irsend.reset();
+  irsend.sendSequence(&sent);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::SAMSUNG_AC, irsend.capture.decode_type);
+}
+
+TEST(TestIRcodeStoreBuilder, Full) {
+  uint8_t buffer[kCodeStoreHeaderSize + 30];
+  IRcodeStoreBuilder builder(buffer, sizeof(buffer));
+  // A value takes 2 + the name + 14 bytes, & 8 for its index entry.
+  EXPECT_TRUE(builder.addValue("a", decode_type_t::NEC, 1));
+  EXPECT_FALSE(builder.addValue("b", decode_type_t::NEC, 2));
+  EXPECT_EQ(1, builder.count());
+  EXPECT_EQ(0, builder.finish());  // An image missing a code is no use.
+  IRcodeStoreBuilder small(buffer, kCodeStoreHeaderSize - 1);
+  EXPECT_FALSE(small.addValue("a", decode_type_t::NEC, 1));
+  EXPECT_EQ(0, small.finish());
+  // Names that are too long.
+  char name[kCodeStoreMaxName + 2];
+  memset(name, 'x', sizeof(name) - 1);
+  name[sizeof(name) - 1] = '\0';
+  IRcodeStoreBuilder named(buffer, sizeof(buffer));
+  EXPECT_FALSE(named.addValue(name, decode_type_t::NEC, 1));
+}
+
+// Tests for the IRcodeIndex class.
+
+TEST(TestIRcodeIndex, AddAndFind) {
+  IRcodeIndex index(3);
+  EXPECT_EQ(3, index.size());
+  EXPECT_EQ(0, index.count());
+  EXPECT_TRUE(index.add(decode_type_t::NEC, 0x20DF10EF, 32, 7));
+  EXPECT_TRUE(index.add(decode_type_t::SONY, 0x20DF10EF, 32, 8));
+  EXPECT_EQ(2, index.count());
+  EXPECT_EQ(7, index.find(decode_type_t::NEC, 0x20DF10EF, 32));
+  EXPECT_EQ(8, index.find(decode_type_t::SONY, 0x20DF10EF, 32));
+  // All of the key has to match.
+  EXPECT_EQ(kCodeIndexNoAction, index.find(decode_type_t::NEC, 0x20DF10EF, 24));
+  EXPECT_EQ(kCodeIndexNoAction, index.find(decode_type_t::NEC, 0x20DF10EE, 32));
+  // Adding it again changes its action.
+  EXPECT_TRUE(index.add(decode_type_t::NEC, 0x20DF10EF, 32, 9));
+  EXPECT_EQ(2, index.count());
+  EXPECT_EQ(9, index.find(decode_type_t::NEC, 0x20DF10EF, 32));
+  EXPECT_FALSE(index.add(decode_type_t::NEC, 1, 32, kCodeIndexNoAction));
+  // Full.
+  EXPECT_TRUE(index.add(decode_type_t::NEC, 1, 32, 1));
+  EXPECT_FALSE(index.add(decode_type_t::NEC, 2, 32, 2));
+  EXPECT_EQ(3, index.count());
+  EXPECT_TRUE(index.add(decode_type_t::NEC, 1, 32, 3));  // Not a new one.
+  index.clear();
+  EXPECT_EQ(0, index.count());
+  EXPECT_EQ(kCodeIndexNoAction, index.find(decode_type_t::NEC, 1, 32));
+}
+
+TEST(TestIRcodeIndex, Collisions) {
+  IRcodeIndex index(100);
+  for (uint16_t i = 0; i < 100; i++)
+    ASSERT_TRUE(index.add(decode_type_t::NEC, (uint64_t)i << 32, 32, i));
+  for (uint16_t i = 0; i < 100; i++)
+    EXPECT_EQ(i, index.find(decode_type_t::NEC, (uint64_t)i << 32, 32));
+  EXPECT_EQ(kCodeIndexNoAction,
+            index.find(decode_type_t::NEC, (uint64_t)100 << 32, 32));
+}
+
+TEST(TestIRcodeIndex, ReceivedCodes) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  IRcodeIndex index;
+  irsend.begin();
+
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  EXPECT_EQ(kCodeIndexNoAction, index.find(&irsend.capture));
+  ASSERT_TRUE(index.add(&irsend.capture, 1));
+  EXPECT_EQ(1, index.find(&irsend.capture));
+  EXPECT_EQ(1, index.find(decode_type_t::NEC, 0x20DF10EF, kNECBits));
+
+  // State[] messages.
+  const uint8_t gree[kGreeStateLength] = {0x00, 0x09, 0x20, 0x50,
+                                          0x00, 0x20, 0x00, 0x50};
+  ASSERT_TRUE(index.add(decode_type_t::GREE, gree, kGreeStateLength, 2));
+  irsend.reset();
+  irsend.sendGree(gree);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  ASSERT_EQ(decode_type_t::GREE, irsend.capture.decode_type);
+  EXPECT_EQ(2, index.find(&irsend.capture));
+  irsend.capture.state[0] ^= 1;
+  EXPECT_EQ(kCodeIndexNoAction, index.find(&irsend.capture));
+
+  // Unknown messages, by their `decodeHash()` value.
+  const uint16_t raw[7] = {3000, 1000, 500, 1500, 500, 1500, 2000};
+  EXPECT_TRUE(index.add(decode_type_t::UNKNOWN, IRcodeIndex::hashRaw(raw, 7),
+                        4, 3));
+  irsend.reset();
+  irsend.sendRaw(raw, 7, 38);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  ASSERT_EQ(decode_type_t::UNKNOWN, irsend.capture.decode_type);
+  EXPECT_EQ(IRcodeIndex::hashRaw(raw, 7), irsend.capture.value);
+  EXPECT_EQ(3, index.find(&irsend.capture));
+}
+
+TEST(TestIRcodeIndex, Store) {
+  IRcodeStore store(kCodes, sizeof(kCodes));
+  IRcodeIndex index;
+  EXPECT_EQ(3, index.addStore(store));
+  IRsendTest irsend(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  irsend.begin();
+  char name[kCodeStoreMaxName + 1];
+
+  ASSERT_TRUE(store.send("tv_power", &irsend));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  uint16_t action = index.find(&irsend.capture);
+  ASSERT_TRUE(store.getName(action, name, sizeof(name)));
+  EXPECT_STREQ("tv_power", name);
+
+  irsend.reset();
+  ASSERT_TRUE(store.send("fan", &irsend));  // Raw, & no protocol decodes it.
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&irsend.capture));
+  ASSERT_EQ(decode_type_t::UNKNOWN, irsend.capture.decode_type);
+  action = index.find(&irsend.capture);
+  ASSERT_TRUE(store.getName(action, name, sizeof(name)));
+  EXPECT_STREQ("fan", name);
+  ircode_t code;
+  ASSERT_TRUE(store.get(action, &code));
+  EXPECT_EQ(kCodeRaw, code.kind);
+  EXPECT_EQ(5, code.length);
+
+  // Truncated names.
+  ASSERT_TRUE(store.getName(action, name, 3));
+  EXPECT_STREQ("fa", name);
+  EXPECT_FALSE(store.getName(store.count(), name, sizeof(name)));
+  EXPECT_FALSE(store.get(store.count(), &code));
+
+  // A/C codes can't be added.
+  uint8_t buffer[96];
+  IRcodeStoreBuilder builder(buffer, sizeof(buffer));
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::SAMSUNG_AC;
+  ASSERT_TRUE(builder.addAc("cool", state));
+  ASSERT_TRUE(builder.addValue("tv", decode_type_t::NEC, 1));
+  IRcodeStore learnt(buffer, builder.finish());
+  EXPECT_EQ(1, index.addStore(learnt));
+  EXPECT_EQ(4, index.count());
+}
@@ -0,0 +1,177 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRcustom.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRtext.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+
+// Tests for protocols registered at run time.
+
+const char kGarageSpec[] = "GARAGE,24,6000,3000,500,1500,500,500,500,30000";
+
+TEST(TestIRcustom, Register) {
+  ircustom::clear();
+  EXPECT_EQ(0, ircustom::count());
+  const decode_type_t type = ircustom::add(kGarageSpec);
+  ASSERT_EQ(kFirstCustomType, type);
+  EXPECT_EQ(1, ircustom::count());
+  const custom_protocol_t *custom = ircustom::get(type);
+  ASSERT_NE(nullptr, custom);
+  EXPECT_STREQ("GARAGE", custom->name);
+  EXPECT_EQ(type, custom->timing.protocol);
+  EXPECT_EQ(24, custom->timing.nbits);
+  EXPECT_EQ(6000, custom->timing.hdrmark);
+  EXPECT_EQ(30000, custom->timing.gap);
+  // The optional values.
+  EXPECT_EQ(38000, custom->timing.frequency);
+  EXPECT_EQ(kDutyDefault, custom->timing.dutycycle);
+  EXPECT_TRUE(custom->timing.MSBfirst);
+  EXPECT_EQ(kNoRepeat, custom->timing.minrepeats);
+
+  // Names & numbers work like the built-in ones'.
+  EXPECT_EQ(type, ircustom::find("garage"));
+  EXPECT_EQ(type, strToDecodeType("Garage"));
+  EXPECT_EQ(type, strToDecodeType("1000"));
+  EXPECT_EQ("GARAGE", typeToString(type));
+  EXPECT_EQ("GARAGE (Repeat)", typeToString(type, true));
+  EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType("1001"));
+  EXPECT_EQ(decode_type_t::NEC, strToDecodeType("NEC"));
+  EXPECT_EQ(24, IRsend::defaultBits(type));
+  EXPECT_EQ(kNoRepeat, IRsend::minRepeats(type));
+  EXPECT_FALSE(hasACState(type));
+
+  // Changing it keeps its type.
+  EXPECT_EQ(type, ircustom::add(
+      "Garage,16,6000,3000,500,1500,500,500,500,30000,40000,33,0,2"));
+  EXPECT_EQ(1, ircustom::count());
+  EXPECT_EQ(16, IRsend::defaultBits(type));
+  EXPECT_EQ(2, IRsend::minRepeats(type));
+  EXPECT_FALSE(ircustom::get(type)->timing.MSBfirst);
+  EXPECT_STREQ("Garage", ircustom::get(type)->name);
+
+  EXPECT_EQ(kFirstCustomType + 1, ircustom::add(
+      "BLINDS,32,0,0,400,1200,1200,400,0,20000"));
+  EXPECT_TRUE(ircustom::remove(type));
+  EXPECT_FALSE(ircustom::remove(type));
+  EXPECT_EQ(nullptr, ircustom::get(type));
+  EXPECT_EQ(decode_type_t::UNKNOWN, ircustom::find("GARAGE"));
+  EXPECT_EQ(kUnknownStr, typeToString(type));
+  EXPECT_EQ(0, IRsend::defaultBits(type));
+  // Its type is used again, & the others' don't change.
+  EXPECT_EQ(type, ircustom::add(kGarageSpec));
+  EXPECT_EQ(kFirstCustomType + 1, ircustom::find("BLINDS"));
+  ircustom::clear();
+  EXPECT_EQ(0, ircustom::count());
+  EXPECT_EQ(nullptr, ircustom::get((decode_type_t)(kFirstCustomType + 1)));
+}
+
+TEST(TestIRcustom, BadSpecs) {
+  ircustom::clear();
+  const decode_type_t kNone = decode_type_t::UNKNOWN;
+  EXPECT_EQ(kNone, ircustom::add(NULL));
+  EXPECT_EQ(kNone, ircustom::add(""));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE"));
+  // Too few or too many values.
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,6000,3000,500,1500,500,500,500"));
+  EXPECT_EQ(kNone, ircustom::add(
+      "GARAGE,24,6000,3000,500,1500,500,500,500,30000,38,50,1,0,1"));
+  // Values that aren't numbers, or are too big.
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,6000,3000,500,1500,500,500,,0"));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,6000,3000,500,1500,500,500,5,-1"));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,6000,3000,500,1500,500,500,5,9x"));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,65,6000,3000,500,1500,500,500,5,0"));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,70000,3000,500,1500,500,500,5,0"));
+  // Bits that can't be sent, or told apart.
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,0,6000,3000,500,1500,500,500,5,0"));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,6000,3000,0,1500,500,500,5,0"));
+  EXPECT_EQ(kNone, ircustom::add("GARAGE,24,6000,3000,500,500,500,500,5,0"));
+  // Names that are too long, numbers, or a built-in protocol's.
+  EXPECT_EQ(kNone, ircustom::add(
+      "A_VERY_LONG_NAME,24,6000,3000,500,1500,500,500,500,30000"));
+  EXPECT_EQ(kNone, ircustom::add("2GO,24,6000,3000,500,1500,500,500,5,0"));
+  EXPECT_EQ(kNone, ircustom::add(",24,6000,3000,500,1500,500,500,5,0"));
+  EXPECT_EQ(kNone, ircustom::add("nec,24,6000,3000,500,1500,500,500,5,0"));
+  EXPECT_EQ(kNone, ircustom::add("UNKNOWN,24,6000,3000,500,1500,500,500,5,0"));
+  EXPECT_EQ(0, ircustom::count());
+
+  // Only so many can be registered.
+  char spec[32];
+  for (uint8_t i = 0; i < kMaxCustomProtocols; i++) {
+    snprintf(spec, sizeof(spec), "P%d,8,0,0,500,1500,500,500,500,0", i);
+    EXPECT_EQ(kFirstCustomType + i, ircustom::add(spec));
+  }
+  EXPECT_EQ(kNone, ircustom::add(kGarageSpec));
+  ircustom::clear();
+}
+
+TEST(TestIRcustom, SendAndDecode) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  ircustom::clear();
+
+  // Nothing to send or decode until it is registered.
+  const decode_type_t kGarage = (decode_type_t)kFirstCustomType;
+  EXPECT_FALSE(irsend.send(kGarage, 0xA1B2C3, 24));
+  EXPECT_FALSE(irrecv.isProtocolEnabled(kGarage));
+
+  ASSERT_EQ(kGarage, ircustom::add(kGarageSpec));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(kGarage));
+  EXPECT_EQ(2 * 24 - 1, IRrecv::minRawEntries(kGarage));
+  irsend.reset();
+  ASSERT_TRUE(irsend.send(kGarage, 0xA1B2C3, 24));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(kGarage, irsend.capture.decode_type);
+  EXPECT_EQ(24, irsend.capture.bits);
+  EXPECT_EQ(0xA1B2C3, irsend.capture.value);
+  EXPECT_EQ("GARAGE", typeToString(irsend.capture.decode_type));
+  EXPECT_EQ(
+      "f38000d50"
+      "m6000s3000"
+      "m500s1500m500s500m500s1500m500s500m500s500m500s500m500s500m500s1500"
+      "m500s1500m500s500m500s1500m500s1500m500s500m500s500m500s1500m500s500"
+      "m500s1500m500s1500m500s500m500s500m500s500m500s500m500s1500m500s1500"
+      "m500s30000",
+      irsend.outputStr());
+
+  // Built-in protocols still decode as before.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+
+  // Unregistered, it is just an UNKNOWN message again.
+  irsend.reset();
+  irsend.send(kGarage, 0xA1B2C3, 24);
+  irsend.makeDecodeResult();
+  ircustom::clear();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::UNKNOWN, irsend.capture.decode_type);
+}
+
+TEST(TestIRcustom, HeaderDispatch) {
+  IRrecv irrecv(1);
+  ircustom::clear();
+  // A header mark much longer than any built-in protocol's.
+  irrecv._setHeaderWindow(60000 / kRawTick);
+  EXPECT_FALSE(irrecv._isLikelyHeader());
+  ASSERT_NE(decode_type_t::UNKNOWN, ircustom::add(
+      "LONG,8,60000,3000,500,1500,500,500,500,30000"));
+  EXPECT_TRUE(irrecv._isLikelyHeader());
+  // A capture without its header mark isn't it.
+  decode_results results;
+  uint16_t rawbuf[4] = {0, 1000 / kRawTick, 3000 / kRawTick, 500 / kRawTick};
+  results.rawbuf = rawbuf;
+  results.rawlen = 4;
+  EXPECT_FALSE(irrecv.decodeCustom(&results));
+  ircustom::clear();
+  irrecv._setHeaderWindow(60000 / kRawTick);
+  EXPECT_FALSE(irrecv._isLikelyHeader());
+}
@@ -0,0 +1,123 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRmacro.h"
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRtimer.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRmacro class.
+
+// Decode what a GPIO has sent since it was last reset.
+decode_type_t sentFrom(IRmacro *macro, const uint16_t pin, uint64_t *value) {
+  IRsendTest *irsend = static_cast<IRsendTest *>(macro->getEmitter(pin));
+  IRrecv capture(kGpioUnused);
+  irsend->makeDecodeResult();
+  if (!capture.decode(&irsend->capture)) return decode_type_t::UNKNOWN;
+  if (value != NULL) *value = irsend->capture.value;
+  irsend->reset();
+  return irsend->capture.decode_type;
+}
+
+TEST(TestIRmacro, Compile) {
+  IRmacro macro(4);
+  stdAc::state_t ac;
+  IRac::initState(&ac);
+  ac.protocol = decode_type_t::COOLIX;
+  ac.power = true;
+  ac.degrees = 23;
+  EXPECT_EQ(0, macro.length());
+  EXPECT_FALSE(macro.start());  // Nothing to run.
+  EXPECT_TRUE(macro.add(4, decode_type_t::NEC, 0x20DF10EF, kNECBits));
+  EXPECT_TRUE(macro.add(5, ac));
+  const uint8_t state[kDaikin2StateLength] = {0};
+  EXPECT_FALSE(macro.add(5, decode_type_t::NEC, state, sizeof(state)));
+  ac.protocol = decode_type_t::NEC;  // Not an A/C protocol.
+  EXPECT_FALSE(macro.add(5, ac));
+  EXPECT_TRUE(macro.addWait(1000));
+  EXPECT_EQ(3, macro.length());
+  EXPECT_NE(nullptr, macro.getEmitter(4));
+  EXPECT_NE(nullptr, macro.getEmitter(5));
+  EXPECT_EQ(nullptr, macro.getEmitter(6));
+
+  // A compiled message can be added as is.
+  IRsequence sequence(4);
+  const uint16_t durations[3] = {9000, 4500, 560};
+  ASSERT_TRUE(sequence.set(durations, 3, 38000));
+  EXPECT_TRUE(macro.add(6, &sequence));
+  EXPECT_FALSE(macro.add(6, &sequence));  // It's full.
+  EXPECT_EQ(4, macro.length());
+
+  // Nothing can be added while it runs.
+  macro.clear();
+  EXPECT_EQ(0, macro.length());
+  EXPECT_TRUE(macro.add(6, &sequence));
+  EXPECT_TRUE(macro.start());
+  EXPECT_FALSE(macro.add(6, &sequence));
+  EXPECT_FALSE(macro.addWait());
+  macro.stop();
+  EXPECT_TRUE(macro.add(6, &sequence));
+}
+
+TEST(TestIRmacro, Run) {
+  IRmacro macro;
+  stdAc::state_t ac;
+  IRac::initState(&ac);
+  ac.protocol = decode_type_t::COOLIX;
+  ac.power = true;
+  ac.mode = stdAc::opmode_t::kCool;
+  ac.degrees = 23;
+  ASSERT_TRUE(macro.add(4, decode_type_t::NEC, 0x20DF10EF, kNECBits,
+                        kNoRepeat, 3000000));  // TV on, & let it boot.
+  ASSERT_TRUE(macro.add(4, decode_type_t::NEC, 0x20DFD02F, kNECBits));
+  ASSERT_TRUE(macro.add(5, ac));
+  ASSERT_TRUE(macro.addWait(500000));
+  ASSERT_TRUE(macro.add(5, decode_type_t::SONY, 0x540C, kSony15Bits));
+  EXPECT_LT(3700000, macro.getDuration());
+  EXPECT_GT(4000000, macro.getDuration());
+  uint64_t value;
+
+  EXPECT_FALSE(macro.handle());  // Not started.
+  ASSERT_TRUE(macro.start());
+  EXPECT_TRUE(macro.isRunning());
+  // Each GPIO's first step, one per call.
+  EXPECT_TRUE(macro.handle());
+  EXPECT_EQ(decode_type_t::NEC, sentFrom(&macro, 4, &value));
+  EXPECT_EQ(0x20DF10EF, value);
+  IRtimer booting;  // Since the TV was turned on.
+  EXPECT_TRUE(macro.handle());
+  EXPECT_EQ(decode_type_t::COOLIX, sentFrom(&macro, 5, NULL));
+  // Nothing more is sent until the TV has booted. Not even from GPIO 5, as
+  // its next step is after the wait.
+  while (booting.elapsed() < 3000000) {
+    EXPECT_FALSE(macro.handle());
+    IRtimer::add(1000);
+  }
+  EXPECT_TRUE(macro.handle());
+  EXPECT_EQ(decode_type_t::NEC, sentFrom(&macro, 4, &value));
+  EXPECT_EQ(0x20DFD02F, value);
+  // Then the wait.
+  EXPECT_FALSE(macro.handle());
+  IRtimer::add(499999);
+  EXPECT_FALSE(macro.handle());
+  IRtimer::add(1);
+  EXPECT_FALSE(macro.handle());  // The wait is over.
+  EXPECT_TRUE(macro.handle());
+  EXPECT_EQ(decode_type_t::SONY, sentFrom(&macro, 5, &value));
+  EXPECT_EQ(0x540C, value);
+  EXPECT_TRUE(macro.isRunning());
+  EXPECT_FALSE(macro.handle());
+  EXPECT_FALSE(macro.isRunning());  // It's done.
+  EXPECT_FALSE(macro.handle());
+
+  // It can be run again, without compiling anything again.
+  ASSERT_TRUE(macro.start());
+  EXPECT_TRUE(macro.handle());
+  EXPECT_EQ(decode_type_t::NEC, sentFrom(&macro, 4, NULL));
+  macro.stop();
+  EXPECT_FALSE(macro.handle());
+}
@@ -0,0 +1,265 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRrecorder.h"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+
+// Tests for IRrecorder.
+
+// NOR flash, in RAM. It counts what is done to it.
+class FakeFlash : public IRflashStorage {
+ public:
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> erases;  // Per sector.
+  uint32_t ops;  // Erases & writes.
+  uint32_t largest;  // The longest write.
+  uint32_t sector_size;
+
+  FakeFlash(const uint32_t sectors, const uint32_t sector_size)
+      : data(sectors * sector_size, 0xFF), erases(sectors, 0), ops(0),
+        largest(0), sector_size(sector_size) {}
+  uint32_t size(void) const { return data.size(); }
+  uint32_t sectorSize(void) const { return sector_size; }
+  bool erase(const uint32_t offset) {
+    EXPECT_EQ(0, offset % sector_size);
+    memset(&data[offset], 0xFF, sector_size);
+    erases[offset / sector_size]++;
+    ops++;
+    return true;
+  }
+  bool write(const uint32_t offset, const uint8_t *bytes,
+             const uint32_t length) {
+    EXPECT_EQ(0, offset % 4);
+    EXPECT_EQ(0, length % 4);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(bytes) % 4);
+    EXPECT_LE(offset + length, data.size());
+    for (uint32_t i = 0; i < length; i++) data[offset + i] &= bytes[i];
+    largest = std::max(largest, length);
+    ops++;
+    return true;
+  }
+  bool read(const uint32_t offset, uint8_t *bytes, const uint32_t length) {
+    if (offset + length > data.size()) return false;
+    memcpy(bytes, &data[offset], length);
+    return true;
+  }
+};
+
+// Read all of the recorded captures, as a capture file.
+std::vector<uint8_t> readAll(IRrecorder *recorder, const uint32_t piece) {
+  std::vector<uint8_t> file;
+  uint8_t buffer[1024];
+  for (uint32_t nbytes = recorder->read(0, buffer, piece); nbytes;
+       nbytes = recorder->read(file.size(), buffer, piece))
+    file.insert(file.end(), buffer, buffer + nbytes);
+  return file;
+}
+
+// The timestamps of the captures in a capture file, in order.
+std::vector<uint32_t> timestamps(const std::vector<uint8_t> &file) {
+  std::vector<uint32_t> result;
+  irutils::CaptureReader reader(file.data(), file.size());
+  EXPECT_TRUE(reader.valid());
+  irutils::capture_t capture;
+  while (reader.next(&capture)) result.push_back(capture.timestamp);
+  return result;
+}
+
+// Make a capture of an NEC message.
+void captureNEC(IRsendTest *irsend, const uint32_t data) {
+  irsend->reset();
+  irsend->sendNEC(data);
+  irsend->makeDecodeResult();
+  irsend->capture.decode_type = NEC;
+}
+
+TEST(TestIRrecorder, RecordAndRead) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  FakeFlash flash(4, 512);
+  IRrecorder recorder(&flash);
+  EXPECT_EQ(0, recorder.read(0, NULL, 10));
+  ASSERT_TRUE(recorder.begin());
+
+  // Nothing is written to flash by add().
+  const uint32_t ops = flash.ops;
+  captureNEC(&irsend, 0x807F40BF);
+  std::vector<uint16_t> nec_raw(irsend.capture.rawbuf,
+                                irsend.capture.rawbuf + irsend.capture.rawlen);
+  uint32_t staged = irutils::CaptureWriter::recordSize(&irsend.capture);
+  EXPECT_TRUE(recorder.add(&irsend.capture, 38, 1000));
+  irsend.reset();
+  irsend.sendSony(0x240, kSony12Bits, 2);
+  irsend.makeDecodeResult();
+  irsend.capture.overflow = true;
+  staged += irutils::CaptureWriter::recordSize(&irsend.capture);
+  EXPECT_TRUE(recorder.add(&irsend.capture, 40, 2000));
+  EXPECT_EQ(ops, flash.ops);
+  EXPECT_EQ(staged, recorder.pending());
+  EXPECT_EQ(0, recorder.getRecorded());
+
+  // It is written in small steps. One flash operation each.
+  uint32_t steps = 0;
+  while (recorder.handle()) {
+    steps++;
+    EXPECT_EQ(ops + steps, flash.ops);
+  }
+  EXPECT_LE(flash.largest, kRecorderChunkSize);
+  EXPECT_EQ(0, recorder.pending());
+  EXPECT_EQ(2, recorder.getRecorded());
+  EXPECT_EQ(0, recorder.getDropped());
+
+  // It reads back as a capture file. In pieces of any size.
+  const std::vector<uint8_t> file = readAll(&recorder, 1024);
+  EXPECT_EQ(file.size(), recorder.length());
+  EXPECT_EQ(file, readAll(&recorder, 7));
+  irutils::CaptureReader reader(file.data(), file.size());
+  ASSERT_TRUE(reader.valid());
+  EXPECT_FALSE(reader.indexed());
+  EXPECT_EQ(2, reader.count());
+  irutils::capture_t capture;
+  ASSERT_TRUE(reader.get(0, &capture));
+  EXPECT_EQ(NEC, capture.protocol);
+  EXPECT_EQ(38, capture.frequency);
+  EXPECT_EQ(1000, capture.timestamp);
+  EXPECT_FALSE(capture.overflow);
+  uint16_t rawbuf[200];
+  ASSERT_EQ(nec_raw.size(),
+            irutils::CaptureReader::unpack(capture, rawbuf, 200));
+  EXPECT_EQ(nec_raw, std::vector<uint16_t>(rawbuf, rawbuf + nec_raw.size()));
+  ASSERT_TRUE(reader.get(1, &capture));
+  EXPECT_EQ(40, capture.frequency);
+  EXPECT_EQ(2000, capture.timestamp);
+  EXPECT_TRUE(capture.overflow);
+  EXPECT_EQ(irsend.capture.rawlen, capture.rawlen);
+  // Past the end.
+  uint8_t buffer[8];
+  EXPECT_EQ(0, recorder.read(file.size(), buffer, sizeof(buffer)));
+  EXPECT_EQ(0, recorder.read(file.size() + 10, buffer, sizeof(buffer)));
+  EXPECT_EQ(4, recorder.read(file.size() - 4, buffer, sizeof(buffer)));
+}
+
+TEST(TestIRrecorder, BoundedStaging) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  FakeFlash flash(4, 512);
+  IRrecorder recorder(&flash, 256);
+  ASSERT_TRUE(recorder.begin());
+  captureNEC(&irsend, 0x807F40BF);
+  const uint32_t size = irutils::CaptureWriter::recordSize(&irsend.capture);
+  ASSERT_LT(size, 256);
+  // Without handle(), it fills up, & the rest are dropped.
+  uint32_t staged = 0;
+  for (uint8_t i = 0; i < 10; i++)
+    if (recorder.add(&irsend.capture, 38, i)) staged++;
+  EXPECT_EQ((256 - 4) / size, staged);  // A gap is kept.
+  EXPECT_EQ(10 - staged, recorder.getDropped());
+  EXPECT_LE(recorder.pending(), 256);
+  recorder.flush();
+  EXPECT_EQ(staged, recorder.getRecorded());
+  // The space is reused. Wrapping around the end of the staging.
+  for (uint32_t i = 0; i < 20; i++) {
+    EXPECT_TRUE(recorder.add(&irsend.capture, 38, 100 + i));
+    for (uint8_t step = 0; step < 4; step++) recorder.handle();
+  }
+  recorder.flush();
+  EXPECT_EQ(staged + 20, recorder.getRecorded());
+  // Too big for the staging, or a sector, at all.
+  irsend.reset();
+  for (uint8_t i = 0; i < 10; i++) irsend.sendNEC(0x807F40BF + i);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(recorder.add(&irsend.capture));
+  IRrecorder big_staging(&flash, 4096);
+  ASSERT_TRUE(big_staging.begin());
+  EXPECT_FALSE(big_staging.add(&irsend.capture));
+  EXPECT_EQ(1, big_staging.getDropped());
+  // Nor can storage that is too small be used.
+  FakeFlash tiny(1, 512);
+  IRrecorder no_room(&tiny);
+  EXPECT_FALSE(no_room.begin());
+  IRrecorder no_staging(&flash, 0);
+  EXPECT_FALSE(no_staging.begin());
+}
+
+TEST(TestIRrecorder, WearLevelledRing) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  FakeFlash flash(4, 512);
+  IRrecorder recorder(&flash);
+  ASSERT_TRUE(recorder.begin());
+  captureNEC(&irsend, 0x807F40BF);
+  // Many times what fits. The oldest are overwritten.
+  const uint32_t kCaptures = 200;
+  for (uint32_t i = 0; i < kCaptures; i++) {
+    ASSERT_TRUE(recorder.add(&irsend.capture, 38, i));
+    recorder.flush();
+  }
+  EXPECT_EQ(kCaptures, recorder.getRecorded());
+  // Each sector has been erased as often as the others.
+  const uint32_t least = *std::min_element(flash.erases.begin(),
+                                           flash.erases.end());
+  const uint32_t most = *std::max_element(flash.erases.begin(),
+                                          flash.erases.end());
+  EXPECT_GT(least, 5);
+  EXPECT_LE(most - least, 1);
+  // What is left are the newest, in order. All but the erased sector's worth.
+  const uint32_t per_sector = (512 - kRecorderSectorHeaderSize) /
+      irutils::CaptureWriter::recordSize(&irsend.capture);
+  std::vector<uint32_t> times = timestamps(readAll(&recorder, 100));
+  ASSERT_GE(times.size(), 2 * per_sector);
+  EXPECT_LE(times.size(), 3 * per_sector);
+  EXPECT_EQ(kCaptures - 1, times.back());
+  for (uint32_t i = 1; i < times.size(); i++)
+    EXPECT_EQ(times[i - 1] + 1, times[i]);
+}
+
+TEST(TestIRrecorder, CarriesOnAfterRestart) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  FakeFlash flash(8, 512);
+  captureNEC(&irsend, 0x807F40BF);
+  {
+    IRrecorder recorder(&flash);
+    ASSERT_TRUE(recorder.begin());
+    for (uint32_t i = 0; i < 20; i++) recorder.add(&irsend.capture, 38, i);
+  }  // Anything staged is written when it ends.
+  std::vector<uint32_t> expected;
+  {
+    IRrecorder recorder(&flash);
+    ASSERT_TRUE(recorder.begin());
+    expected = timestamps(readAll(&recorder, 1024));
+    EXPECT_EQ(20, expected.size());
+    // A capture cut short by a reset isn't read back.
+    recorder.add(&irsend.capture, 38, 1000);
+    recorder.handle();  // Erase the sector.
+    recorder.handle();  // Erase the one after it.
+    recorder.handle();  // Start the sector.
+    recorder.handle();  // Write part of the capture.
+    EXPECT_EQ(expected, timestamps(readAll(&recorder, 1024)));
+    recorder._begun = false;  // i.e. It lost power.
+  }
+  IRrecorder recorder(&flash);
+  ASSERT_TRUE(recorder.begin());
+  EXPECT_EQ(expected, timestamps(readAll(&recorder, 1024)));
+  // New captures go after the old ones.
+  recorder.add(&irsend.capture, 38, 2000);
+  recorder.flush();
+  expected.push_back(2000);
+  EXPECT_EQ(expected, timestamps(readAll(&recorder, 1024)));
+
+  // Clearing it.
+  EXPECT_TRUE(recorder.clear());
+  EXPECT_EQ(kCaptureFileHeaderSize, recorder.length());
+  recorder.add(&irsend.capture, 38, 3000);
+  recorder.flush();
+  EXPECT_EQ(std::vector<uint32_t>(1, 3000),
+            timestamps(readAll(&recorder, 1024)));
+}
@@ -1,11 +1,21 @@
 // Copyright 2017 David Conran
 
+#include <algorithm>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 #include "IRrecv_test.h"
+#include "IRdecodeOrder.h"
 #include "IRrecv.h"
+#include "IRrecvTimings.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRsend_test.h"
+#include "IRutils.h"
 #include "gtest/gtest.h"
+#include "ir_Daikin.h"
+#include "ir_NEC.h"
+#include "ir_Panasonic.h"
+#include "simulated_channel.h"
 
 // Tests for the IRrecv object.
 TEST(TestIRrecv, DefaultBufferSize) {
@@ -42,6 +52,39 @@ TEST(TestIRrecv, IRrecvDestructor) {
   delete irrecv_ptr;
 }
 
+TEST(TestIRrecv, StaticBuffers) {
+  IRsendTest irsend(0);
+  IRrecvStatic<200, true> irrecv(0);
+  const uintptr_t start = reinterpret_cast<uintptr_t>(&irrecv);
+  const uintptr_t end = start + sizeof(irrecv);
+  EXPECT_EQ(200, irrecv.getBufSize());
+  EXPECT_FALSE(irrecv.enableCompactCapture());  // It isn't ours to free.
+  irsend.begin();
+  irrecv.enableIRIn();
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  // The capture & save buffers trade places, but are always in the object.
+  for (uint8_t i = 0; i < 3; i++) {
+    irsend.sendNEC(irsend.encodeNEC(0x4, i));
+    channel.transmit(&irsend);
+    ASSERT_TRUE(channel.receive(&results));
+    EXPECT_EQ(NEC, results.decode_type);
+    EXPECT_EQ(irsend.encodeNEC(0x4, i), results.value);
+    uintptr_t buf = reinterpret_cast<uintptr_t>(results.rawbuf);
+    EXPECT_TRUE(buf >= start && buf < end);
+    buf = reinterpret_cast<uintptr_t>(irrecv._params->rawbuf);
+    EXPECT_TRUE(buf >= start && buf < end);
+  }
+
+  // Without a save buffer, & on the heap. Nothing is freed that shouldn't be.
+  IRrecvStatic<100> *irrecv_ptr = new IRrecvStatic<100>(1);
+  EXPECT_EQ(100, irrecv_ptr->getBufSize());
+  EXPECT_EQ(NULL, irrecv_ptr->irparams_save);
+  delete irrecv_ptr;
+}
+
+
 // Tests for copyIrParams()
 
 TEST(TestCopyIrParams, CopyEmpty) {
@@ -108,6 +151,1131 @@ TEST(TestCopyIrParams, CopyNonEmpty) {
   EXPECT_EQ(0xDEAD, dst.rawbuf[test_size - 1]);
 }
 
+// Tests for swapIrParams()
+TEST(TestSwapIrParams, SwapsBuffers) {
+  irparams_t src;
+  irparams_t dst;
+  uint16_t test_size = 1234;
+  uint16_t *src_buf = new uint16_t[test_size];
+  uint16_t *dst_buf = new uint16_t[test_size];
+  src.bufsize = test_size;
+  src.rawlen = 67;
+  src.rawbuf = src_buf;
+  src.rawbuf[0] = 0xF00D;
+  src.rawbuf[66] = 0xBEEF;
+  src.overflow = true;
+  dst.bufsize = 0;
+  dst.rawlen = 0;
+  dst.rawbuf = dst_buf;
+  dst.overflow = false;
+
+  IRrecv irrecv(4);
+  irrecv.swapIrParams(&src, &dst);
+
+  EXPECT_EQ(test_size, dst.bufsize);
+  EXPECT_EQ(67, dst.rawlen);
+  EXPECT_TRUE(dst.overflow);
+  // The buffers have traded places.
+  EXPECT_EQ(src_buf, dst.rawbuf);
+  EXPECT_EQ(dst_buf, src.rawbuf);
+  EXPECT_EQ(0xF00D, dst.rawbuf[0]);
+  EXPECT_EQ(0xBEEF, dst.rawbuf[66]);
+  delete[] src_buf;
+  delete[] dst_buf;
+}
+
+TEST(TestSwapIrParams, SaveBufferDecodeDoesNotCopy) {
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irrecv.enableIRIn();
+  uint16_t *capture_buf = params->rawbuf;
+  uint16_t *save_buf = irrecv.irparams_save->rawbuf;
+  params->rawbuf[1] = 0xBEEF;
+  params->rawlen = 3;
+  params->rcvstate = kStopState;
+  irrecv.decode(&results);
+  // The decoder got the filled buffer, and the ISR has the spare one.
+  EXPECT_EQ(capture_buf, results.rawbuf);
+  EXPECT_EQ(0xBEEF, results.rawbuf[1]);
+  EXPECT_EQ(save_buf, params->rawbuf);
+  EXPECT_EQ(kIdleState, params->rcvstate);
+  EXPECT_EQ(0, params->rawlen);
+}
+
+#if ENABLE_CAPTURE_RING
+// Pretend the interrupt handlers captured a message into the current slot.
+void captureIntoRing(volatile irparams_t *params,
+                     const decode_results &capture) {
+  for (uint16_t i = 0; i < capture.rawlen && i < params->bufsize; i++)
+    params->rawbuf[i] = capture.rawbuf[i];
+  params->rawlen = capture.rawlen;
+  params->rcvstate = kStopState;
+  IRrecv::_ringCommit(params);
+}
+
+// Tests for the capture ring.
+TEST(TestCaptureRing, EnableAndDisable) {
+  IRrecv irrecv(1);
+  EXPECT_EQ(0, irrecv.getCaptureSlots());
+  EXPECT_FALSE(irrecv.enableCaptureRing(1));
+  EXPECT_EQ(0, irrecv.getCaptureSlots());
+  EXPECT_TRUE(irrecv.enableCaptureRing(4));
+  EXPECT_EQ(4, irrecv.getCaptureSlots());
+  EXPECT_EQ(0, irrecv.getCaptureDrops());
+  EXPECT_EQ(0, irrecv.getCaptureHighWater());
+  EXPECT_FALSE(irrecv.enableCaptureRing(0));
+  EXPECT_EQ(0, irrecv.getCaptureSlots());
+}
+
+TEST(TestCaptureRing, DecodesInOrderAndCountsDrops) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableCaptureRing(3));
+  irrecv.enableIRIn();
+  // Nothing captured yet.
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  // Two messages arrive before we get a chance to decode either.
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  irsend.reset();
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  EXPECT_EQ(2, irrecv.getCaptureHighWater());
+  EXPECT_EQ(0, irrecv.getCaptureDrops());
+  // The ring is full, so the next one is lost.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  EXPECT_EQ(1, irrecv.getCaptureDrops());
+  EXPECT_EQ(2, irrecv.getCaptureHighWater());
+  // The capture after a drop starts again from an empty buffer.
+  EXPECT_EQ(0, params->rawlen);
+  EXPECT_EQ(kIdleState, params->rcvstate);
+
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  irrecv.resume();
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SONY, results.decode_type);
+  EXPECT_EQ(kSony12Bits, results.bits);
+  irrecv.resume();
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  // The freed slots are reused, and decoding without resume() still frees them.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+  EXPECT_FALSE(irrecv.decode(&results));
+  EXPECT_EQ(1, irrecv.getCaptureDrops());
+}
+
+#if ENABLE_BUDGETED_DECODE
+TEST(TestCaptureRing, DecodeBudget) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableCaptureRing(3));
+  irrecv.enableIRIn();
+  irsend.reset();
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+
+  EXPECT_FALSE(irrecv.decodeBudget(&results, 0));
+  ASSERT_TRUE(irrecv.isDecoding());
+  // Its slot is kept while it is decoded. Others carry on arriving.
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  EXPECT_EQ(2, irrecv.getCaptureHighWater());
+  EXPECT_EQ(0, irrecv.getCaptureDrops());
+  while (!irrecv.decodeBudget(&results, 0))
+    ASSERT_TRUE(irrecv.isDecoding());
+  EXPECT_EQ(SONY, results.decode_type);
+  // Then the next one.
+  while (!irrecv.decodeBudget(&results, 0))
+    ASSERT_TRUE(irrecv.isDecoding());
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  EXPECT_FALSE(irrecv.decodeBudget(&results, 0));
+  EXPECT_FALSE(irrecv.isDecoding());
+}
+#endif  // ENABLE_BUDGETED_DECODE
+
+TEST(TestCaptureRing, DecodeIntoSaveBuffer) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableCaptureRing(2));
+  irrecv.enableIRIn();
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(irrecv.irparams_save->rawbuf, results.rawbuf);
+  // The slot was copied, so it is already free for the next capture.
+  captureIntoRing(params, irsend.capture);
+  EXPECT_EQ(0, irrecv.getCaptureDrops());
+}
+#endif  // ENABLE_CAPTURE_RING
+
+// Pretend the interrupt handlers captured a message.
+void captureInto(volatile irparams_t *params, const decode_results &capture) {
+  for (uint16_t i = 0; i < capture.rawlen && i < params->bufsize; i++)
+    params->rawbuf[i] = capture.rawbuf[i];
+  params->rawlen = capture.rawlen;
+  params->rcvstate = kStopState;
+}
+
+// Tests for having more than one receiver.
+TEST(TestMultipleReceivers, SeparateCaptureStates) {
+  IRrecv first(1);
+  IRrecv *second = new IRrecv(2, 200);
+  EXPECT_NE(first._params, second->_params);
+  EXPECT_EQ(1, first._params->recvpin);
+  EXPECT_EQ(2, second->_params->recvpin);
+  EXPECT_EQ(kRawBuf, first.getBufSize());
+  EXPECT_EQ(200, second->getBufSize());
+  const uint8_t second_id = second->_id;
+  delete second;
+  // The freed up capture state gets reused.
+  IRrecv third(3);
+  EXPECT_EQ(second_id, third._id);
+  EXPECT_EQ(kRawBuf, first.getBufSize());
+}
+
+TEST(TestMultipleReceivers, TooManyReceivers) {
+  IRsendTest irsend(0);
+  IRrecv *receivers[kMaxReceivers];
+  for (uint8_t i = 0; i < kMaxReceivers; i++) receivers[i] = new IRrecv(i);
+  volatile irparams_t *last = receivers[kMaxReceivers - 1]->_params;
+  uint16_t *last_rawbuf = last->rawbuf;
+  // One too many doesn't take over any of their capture states.
+  IRrecv *extra = new IRrecv(kMaxReceivers);
+  EXPECT_EQ(kMaxReceivers, extra->_id);
+  for (uint8_t i = 0; i < kMaxReceivers; i++)
+    EXPECT_NE(receivers[i]->_params, extra->_params);
+  EXPECT_EQ(kMaxReceivers - 1, last->recvpin);
+  EXPECT_EQ(last_rawbuf, last->rawbuf);
+  // & it can't capture or decode anything.
+  extra->enableIRIn();
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  captureInto(extra->_params, irsend.capture);
+  decode_results results;
+  EXPECT_FALSE(extra->decode(&results));
+  EXPECT_FALSE(extra->decode(&irsend.capture));
+  // The one it would have taken over still works.
+  captureInto(last, irsend.capture);
+  ASSERT_TRUE(receivers[kMaxReceivers - 1]->decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  delete extra;
+  EXPECT_EQ(last_rawbuf, last->rawbuf);
+  // Nor does one with its own buffers. N.B. They aren't freed with it.
+  IRrecvStatic<100, true> *extra_static = new IRrecvStatic<100, true>(1);
+  EXPECT_EQ(kMaxReceivers, extra_static->_id);
+  EXPECT_EQ(last_rawbuf, last->rawbuf);
+  delete extra_static;
+  // Once one is free, the next new one gets it.
+  delete receivers[kMaxReceivers - 1];
+  IRrecv *replacement = new IRrecv(kMaxReceivers);
+  EXPECT_EQ(kMaxReceivers - 1, replacement->_id);
+  EXPECT_EQ(last, replacement->_params);
+  delete replacement;
+  for (uint8_t i = 0; i < kMaxReceivers - 1; i++) delete receivers[i];
+}
+
+TEST(TestMultipleReceivers, DecodeAnyTakesTurns) {
+  IRsendTest irsend(0);
+  IRrecv left(1, kRawBuf, kTimeoutMs, true);
+  IRrecv right(2, kRawBuf, kTimeoutMs, true);
+  decode_results results;
+  irsend.begin();
+  left.enableIRIn();
+  right.enableIRIn();
+  // Nothing has arrived.
+  EXPECT_EQ(nullptr, IRrecv::decodeAny(&results));
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  captureInto(right._params, irsend.capture);
+  EXPECT_EQ(&right, IRrecv::decodeAny(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+  EXPECT_EQ(nullptr, IRrecv::decodeAny(&results));
+
+  // Both have a message. Neither gets to go twice in a row.
+  captureInto(left._params, irsend.capture);
+  captureInto(right._params, irsend.capture);
+  IRrecv *got = IRrecv::decodeAny(&results);
+  ASSERT_NE(nullptr, got);
+  captureInto(got->_params, irsend.capture);  // It gets another straight away.
+  IRrecv *other = IRrecv::decodeAny(&results);
+  ASSERT_NE(nullptr, other);
+  EXPECT_NE(got, other);
+}
+
+// Tests for IRdecoder.
+TEST(TestIRdecoder, DoesNotUseAReceiver) {
+  IRdecoder *decoders[kMaxReceivers + 1];
+  for (uint8_t i = 0; i <= kMaxReceivers; i++) {
+    decoders[i] = new IRdecoder();
+    EXPECT_EQ(kMaxReceivers, decoders[i]->_id);
+    for (uint8_t j = 0; j < i; j++)
+      EXPECT_NE(decoders[j]->_params, decoders[i]->_params);
+  }
+  decoders[0]->enableIRIn();  // Does nothing.
+  decoders[0]->disableIRIn();
+  // A real receiver still gets capture state of its own.
+  IRrecv irrecv(1);
+  EXPECT_GT(kMaxReceivers, irrecv._id);
+  EXPECT_EQ(1, irrecv._params->recvpin);
+  for (uint8_t i = 0; i <= kMaxReceivers; i++) delete decoders[i];
+}
+
+TEST(TestIRdecoder, DecodeSuppliedTicks) {
+  IRsendTest irsend(0);
+  IRdecoder irdecoder;
+  irsend.begin();
+  irsend.reset();
+  irsend.sendSony(0x240, kSony12Bits, kSonyMinRepeat);
+  irsend.makeDecodeResult();
+  std::vector<uint16_t> ticks(irsend.capture.rawbuf,
+                              irsend.capture.rawbuf + irsend.capture.rawlen);
+  decode_results results;
+  ASSERT_TRUE(irdecoder.decode(&results, ticks.data(), ticks.size()));
+  EXPECT_EQ(SONY, results.decode_type);
+  EXPECT_EQ(kSony12Bits, results.bits);
+  EXPECT_EQ(0x240, results.value);
+  EXPECT_EQ(ticks.data(), results.rawbuf);
+  // Settings work the same way as IRrecv's.
+  irdecoder.disableProtocol(SONY);
+  ASSERT_TRUE(irdecoder.decode(&results, ticks.data(), ticks.size()));
+  EXPECT_NE(SONY, results.decode_type);
+  // Including decoding results that were already captured.
+  irdecoder.enableProtocol(SONY);
+  EXPECT_TRUE(irdecoder.decode(&irsend.capture));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_FALSE(irdecoder.decode(&results, ticks.data(), 0));
+}
+
+TEST(TestIRdecoder, DecodeInParallel) {
+  const uint8_t kThreads = 4;
+  const uint16_t kDecodes = 200;
+  const decode_type_t kProtocols[kThreads] = {NEC, SONY, RC6, SAMSUNG};
+  const uint64_t kValues[kThreads] = {0x807FC03F, 0x240, 0x234, 0xE0E09966};
+  std::vector<uint16_t> captures[kThreads];
+  IRsendTest irsend(0);
+  irsend.begin();
+  for (uint8_t i = 0; i < kThreads; i++) {
+    irsend.reset();
+    irsend.send(kProtocols[i], kValues[i], IRsend::defaultBits(kProtocols[i]));
+    irsend.makeDecodeResult();
+    captures[i].assign(irsend.capture.rawbuf,
+                       irsend.capture.rawbuf + irsend.capture.rawlen);
+  }
+  uint16_t decoded[kThreads] = {0};
+  std::vector<std::thread> threads;
+  for (uint8_t i = 0; i < kThreads; i++)
+    threads.push_back(std::thread([&, i]() {
+      IRdecoder irdecoder;
+      decode_results results;
+      for (uint16_t n = 0; n < kDecodes; n++) {
+        std::vector<uint16_t> ticks = captures[(i + n) % kThreads];
+        if (irdecoder.decode(&results, ticks.data(), ticks.size()) &&
+            results.decode_type == kProtocols[(i + n) % kThreads] &&
+            results.value == kValues[(i + n) % kThreads])
+          decoded[i]++;
+      }
+    }));
+  for (uint8_t i = 0; i < kThreads; i++) {
+    threads[i].join();
+    EXPECT_EQ(kDecodes, decoded[i]);
+  }
+}
+
+#if ENABLE_CAPTURE_HASH
+// Pretend the interrupt handler captured a message, hashing it as it went.
+void captureHashed(volatile irparams_t *params, const decode_results &capture) {
+  for (uint16_t i = 0; i < capture.rawlen && i < params->bufsize; i++) {
+    IRrecv::_hashTicks(params, i, capture.rawbuf[i]);
+    params->rawbuf[i] = capture.rawbuf[i];
+  }
+  params->rawlen = capture.rawlen;
+  params->rcvstate = kStopState;
+}
+
+// Tests for building the decodeHash() hash as the message arrives.
+TEST(TestCaptureHash, SameAsDecodeHash) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+
+  uint16_t rawData[71] = {
+      482, 1370, 9082, 1558, 342, 2514, 662, 470, 660, 468, 658, 1588, 662, 466,
+      662, 466, 662, 466, 662, 466, 662, 466, 662, 1586, 660, 1588, 662, 466,
+      662, 1588, 662, 1586, 662, 1586, 660, 1588, 662, 1586, 662, 468, 660,
+      1588, 662, 468, 662, 466, 660, 466, 662, 464, 662, 466, 662, 466, 662,
+      1588, 660, 466, 662, 1586, 662, 1588, 660, 1586, 662, 1586, 662, 1586,
+      664, 1594, 662};  // UNKNOWN B0784C9E
+  irsend.reset();
+  irsend.sendRaw(rawData, 71, 38);
+  irsend.makeDecodeResult();
+  captureHashed(params, irsend.capture);
+  EXPECT_TRUE(params->hashed);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(UNKNOWN, results.decode_type);
+  EXPECT_EQ(0xB0784C9E, results.value);
+
+  // Make sure it's the interrupt handler's hash that gets reported.
+  captureHashed(params, irsend.capture);
+  params->hash = 0x12345678;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(UNKNOWN, results.decode_type);
+  EXPECT_EQ(0x12345678, results.value);
+  // Without it, the capture is hashed by decodeHash() as before.
+  captureInto(params, irsend.capture);
+  EXPECT_FALSE(params->hashed);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(0xB0784C9E, results.value);
+}
+
+TEST(TestCaptureHash, HashOnly) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  irrecv.setHashOnly();
+  captureHashed(params, irsend.capture);
+  const uint32_t hash = params->hash;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(UNKNOWN, results.decode_type);
+  EXPECT_EQ(hash, results.value);
+  irrecv.setHashOnly(false);
+  captureHashed(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+}
+#endif  // ENABLE_CAPTURE_HASH
+
+TEST(TestIRrecv, CompareTicks) {
+  IRrecv irrecv(1);
+  // 20% shorter or longer is the boundary.
+  EXPECT_EQ(1, irrecv.compare(1000, 1000));
+  EXPECT_EQ(1, irrecv.compare(1000, 800));
+  EXPECT_EQ(0, irrecv.compare(1000, 799));
+  EXPECT_EQ(1, irrecv.compare(800, 1000));
+  EXPECT_EQ(2, irrecv.compare(799, 1000));
+  EXPECT_EQ(2, irrecv.compare(0, 1));
+  EXPECT_EQ(0, irrecv.compare(UINT16_MAX, 0));
+  EXPECT_EQ(1, irrecv.compare(UINT16_MAX, UINT16_MAX));
+}
+
+// Simulate the lag of an IR sensor. i.e. Longer marks & shorter spaces.
+void addSensorLag(decode_results *capture, const uint16_t lag) {
+  for (uint16_t i = 1; i < capture->rawlen; i++)
+    if (i % 2)
+      capture->rawbuf[i] += lag / kRawTick;
+    else
+      capture->rawbuf[i] -= lag / kRawTick;
+}
+
+// Tests for measuring & using the mark excess (sensor lag) of a receiver.
+TEST(TestMarkExcess, SetAndGet) {
+  IRrecv irrecv(1);
+  EXPECT_EQ(kMarkExcess, irrecv.getMarkExcess());
+  irrecv.setMarkExcess(120);
+  EXPECT_EQ(120, irrecv.getMarkExcess());
+  irrecv.setMarkExcess(-20);
+  EXPECT_EQ(-20, irrecv.getMarkExcess());
+  irrecv.setMarkExcess(kMaxMarkExcess + 100);
+  EXPECT_EQ(kMaxMarkExcess, irrecv.getMarkExcess());
+  irrecv.setMarkExcess();
+  EXPECT_EQ(kMarkExcess, irrecv.getMarkExcess());
+}
+
+TEST(TestMarkExcess, UsedWhenMatching) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  addSensorLag(&irsend.capture, 300);
+  EXPECT_FALSE(irrecv.decodeNEC(&irsend.capture));
+  EXPECT_FALSE(irrecv.matchMark(irsend.capture.rawbuf[3], 560));
+  irrecv.setMarkExcess(300);
+  ASSERT_TRUE(irrecv.decodeNEC(&irsend.capture));
+  EXPECT_EQ(0x807FC03F, irsend.capture.value);
+  EXPECT_TRUE(irrecv.matchMark(irsend.capture.rawbuf[3], 560));
+  EXPECT_TRUE(irrecv.matchSpace(irsend.capture.rawbuf[4], 1690));
+}
+
+TEST(TestMarkExcess, Calibration) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  // Too few marks & spaces to be trusted, so nothing changes.
+  irrecv.startMarkExcessCalibration();
+  EXPECT_EQ(kMarkExcess, irrecv.stopMarkExcessCalibration());
+  EXPECT_EQ(kMarkExcess, irrecv.getMarkExcess());
+
+  irrecv.startMarkExcessCalibration();
+  for (uint8_t i = 0; i < 4; i++) {
+    irsend.reset();
+    irsend.sendNEC(irsend.encodeNEC(0x04, i));
+    irsend.makeDecodeResult();
+    addSensorLag(&irsend.capture, 150);
+    ASSERT_TRUE(irrecv.decode(&irsend.capture));
+    EXPECT_EQ(NEC, irsend.capture.decode_type);
+  }
+  // Messages that don't decode are ignored.
+  irsend.reset();
+  const uint16_t noise[4] = {2000, 500, 2500, 700};
+  irsend.sendRaw(noise, 4, 38);
+  irsend.makeDecodeResult();
+  irrecv.decode(&irsend.capture);
+  EXPECT_EQ(UNKNOWN, irsend.capture.decode_type);
+
+  // Check without applying it first.
+  const int16_t measured = irrecv.stopMarkExcessCalibration(false);
+  EXPECT_NEAR(150, measured, 3);
+  EXPECT_EQ(kMarkExcess, irrecv.getMarkExcess());
+  EXPECT_EQ(measured, irrecv.stopMarkExcessCalibration());
+  EXPECT_EQ(measured, irrecv.getMarkExcess());
+  // Not calibrating, so it doesn't change any further.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(measured, irrecv.getMarkExcess());
+
+  // A lag free sensor, calibrated from a different protocol.
+  irrecv.setMarkExcess();
+  irrecv.startMarkExcessCalibration();
+  for (uint8_t i = 0; i < 3; i++) {
+    irsend.reset();
+    irsend.sendSAMSUNG(0xE0E09966);
+    irsend.makeDecodeResult();
+    ASSERT_TRUE(irrecv.decode(&irsend.capture));
+    EXPECT_EQ(SAMSUNG, irsend.capture.decode_type);
+  }
+  EXPECT_NEAR(0, irrecv.stopMarkExcessCalibration(), 3);
+}
+
+#if ENABLE_REPEAT_COALESCING
+// Tests for coalescing the repeats of a held button.
+TEST(TestRepeatCoalescing, NecRepeatCodes) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.enableRepeatCoalescing());
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  _IRtimer_unittest_now = 0;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+  EXPECT_FALSE(results.repeat);
+  EXPECT_EQ(0, results.repeats);
+
+  // Three NEC repeat codes, ~108ms apart. None of them are reported.
+  // i.e. A 9ms mark, a 2.25ms space, & a 560us mark. In kRawTick units.
+  uint16_t repeat_code[4] = {1, 4480, 1120, 280};
+  decode_results capture;
+  capture.rawbuf = repeat_code;
+  capture.rawlen = 4;
+  for (uint8_t i = 0; i < 3; i++) {
+    _IRtimer_unittest_now += 108000;
+    captureInto(params, capture);
+    EXPECT_FALSE(irrecv.decode(&results));
+  }
+  // Still held, as far as we know.
+  _IRtimer_unittest_now += 100000;
+  EXPECT_FALSE(irrecv.decode(&results));
+  // Released.
+  _IRtimer_unittest_now += 100000;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+  EXPECT_TRUE(results.repeat);
+  EXPECT_EQ(3, results.repeats);
+  EXPECT_EQ(0, results.rawlen);
+  EXPECT_EQ(_IRtimer_unittest_now, results.decoded);
+  EXPECT_FALSE(irrecv.decode(&results));  // Only reported the once.
+
+  // A repeat code long after the message is decoded normally.
+  _IRtimer_unittest_now += 1000000;
+  captureInto(params, capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(kRepeat, results.value);
+  EXPECT_TRUE(results.repeat);
+  EXPECT_EQ(0, results.repeats);
+}
+
+TEST(TestRepeatCoalescing, IdenticalMessages) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.enableRepeatCoalescing(100));
+
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E09966);
+  irsend.makeDecodeResult();
+  // N.B. Sending moves the simulated time on, so set it after each send.
+  _IRtimer_unittest_now = 0;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SAMSUNG, results.decode_type);
+  EXPECT_EQ(0, results.repeats);
+  _IRtimer_unittest_now = 90000;
+  captureInto(params, irsend.capture);
+  EXPECT_FALSE(irrecv.decode(&results));
+  _IRtimer_unittest_now = 180000;
+  captureInto(params, irsend.capture);
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  // A different message interrupts it. It's reported, the repeats are not.
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E0E01F);
+  irsend.makeDecodeResult();
+  _IRtimer_unittest_now = 270000;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SAMSUNG, results.decode_type);
+  EXPECT_EQ(0xE0E0E01F, results.value);
+  EXPECT_FALSE(results.repeat);
+  EXPECT_EQ(0, results.repeats);
+  _IRtimer_unittest_now += 500000;
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  // When disabled, every message is decoded in full.
+  irrecv.disableRepeatCoalescing();
+  captureInto(params, irsend.capture);
+  EXPECT_TRUE(irrecv.decode(&results));
+  captureInto(params, irsend.capture);
+  EXPECT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(0xE0E0E01F, results.value);
+}
+
+TEST(TestRepeatCoalescing, ToggledMessages) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.enableRepeatCoalescing(200));
+
+  const uint64_t press = irsend.encodeRC6(0xF, 0x22);
+  irsend.reset();
+  irsend.sendRC6(press);
+  irsend.makeDecodeResult();
+  _IRtimer_unittest_now = 0;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(RC6, results.decode_type);
+  EXPECT_EQ(press, results.value);
+  // A repeat with a different capture, but with the same toggle bit.
+  irsend.capture.rawlen--;  // i.e. Without the trailing gap.
+  _IRtimer_unittest_now = 110000;
+  captureInto(params, irsend.capture);
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  // A new press of the same button flips the toggle bit, so it's reported.
+  irsend.reset();
+  irsend.sendRC6(irsend.toggleRC6(press));
+  irsend.makeDecodeResult();
+  _IRtimer_unittest_now = 220000;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(RC6, results.decode_type);
+  EXPECT_EQ(irsend.toggleRC6(press), results.value);
+  EXPECT_FALSE(results.repeat);
+
+  // Protocols without a toggle bit are left to the capture matching.
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E09966);
+  irsend.makeDecodeResult();
+  _IRtimer_unittest_now = 330000;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  irsend.capture.rawlen--;  // A different capture, without the trailing gap.
+  _IRtimer_unittest_now = 440000;
+  captureInto(params, irsend.capture);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SAMSUNG, results.decode_type);
+  EXPECT_FALSE(results.repeat);
+}
+#endif  // ENABLE_REPEAT_COALESCING
+
+#if ENABLE_GAMING_RECV
+// Tests for the gaming receive profile.
+TEST(TestGamingMode, ProfileAndDuplicates) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, 2 * kMagiquestBits + 4);  // Big enough for a MagiQuest.
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableGamingMode(100));
+  irrecv.enableIRIn();
+  EXPECT_TRUE(irrecv.isProtocolEnabled(decode_type_t::MAGIQUEST));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(decode_type_t::LASERTAG));
+  EXPECT_FALSE(irrecv.isProtocolEnabled(decode_type_t::MULTIBRACKETS));
+  EXPECT_FALSE(irrecv.isProtocolEnabled(decode_type_t::NEC));
+#if ENABLE_ADAPTIVE_TIMEOUT
+  EXPECT_EQ(kGamingGapMs, params->gap);
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+#if ENABLE_CAPTURE_RING
+  EXPECT_EQ(kGamingCaptureSlots, irrecv.getCaptureSlots());
+#endif  // ENABLE_CAPTURE_RING
+
+  decode_results wand[2];
+  uint16_t rawbuf[2][2 * kMagiquestBits + 4];
+  for (uint8_t i = 0; i < 2; i++) {
+    irsend.reset();
+    irsend.sendMagiQuest(irsend.encodeMagiQuest(0x01234567 + i, 0x89));
+    irsend.makeDecodeResult();
+    wand[i] = irsend.capture;
+    wand[i].rawbuf = rawbuf[i];
+    for (uint16_t j = 0; j < irsend.capture.rawlen; j++)
+      rawbuf[i][j] = irsend.capture.rawbuf[j];
+  }
+  // N.B. Sending moves the simulated time on, so set it after each send.
+  _IRtimer_unittest_now = 0;
+  captureIntoRing(params, wand[0]);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(MAGIQUEST, results.decode_type);
+  EXPECT_EQ(0x01234567, results.address);
+  // The other wand's message gets through, but their copies don't.
+  _IRtimer_unittest_now = 20000;
+  captureIntoRing(params, wand[1]);
+  _IRtimer_unittest_now = 40000;
+  captureIntoRing(params, wand[0]);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(0x01234568, results.address);
+  EXPECT_FALSE(irrecv.decode(&results));
+  _IRtimer_unittest_now = 60000;
+  captureIntoRing(params, wand[1]);
+  EXPECT_FALSE(irrecv.decode(&results));
+  EXPECT_EQ(2, irrecv.getGamingDuplicates());
+  // Each copy extends the window, but after it the next one is a new shot.
+  _IRtimer_unittest_now = 130000;
+  captureIntoRing(params, wand[0]);
+  EXPECT_FALSE(irrecv.decode(&results));
+  _IRtimer_unittest_now = 300000;
+  captureIntoRing(params, wand[0]);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(0x01234567, results.address);
+  EXPECT_EQ(3, irrecv.getGamingDuplicates());
+
+  // Other protocols aren't decoded.
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  captureIntoRing(params, irsend.capture);
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  irrecv.disableGamingMode();
+  EXPECT_TRUE(irrecv.isProtocolEnabled(decode_type_t::NEC));
+  captureIntoRing(params, wand[0]);
+  EXPECT_TRUE(irrecv.decode(&results));
+  captureIntoRing(params, wand[0]);
+  EXPECT_TRUE(irrecv.decode(&results));
+}
+#endif  // ENABLE_GAMING_RECV
+
+#if ENABLE_DECODE_CACHE
+// Tests for the decode cache.
+TEST(TestDecodeCache, OnlyAttemptsTheCachedProtocol) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  EXPECT_FALSE(irrecv.enableDecodeCache(0));
+  ASSERT_TRUE(irrecv.enableDecodeCache(2));
+#if ENABLE_DECODE_PROFILING
+  ASSERT_TRUE(irrecv.enableDecodeProfiling());
+#endif  // ENABLE_DECODE_PROFILING
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0, irrecv.getDecodeCacheHits());
+#if ENABLE_DECODE_PROFILING
+  // Sanyo is attempted before NEC, when all of them are.
+  const uint32_t sanyo =
+      irrecv.getDecodeProfile(decode_type_t::SANYO_LC7461)->attempts;
+  EXPECT_LT(0, sanyo);
+#endif  // ENABLE_DECODE_PROFILING
+  // The same button again.
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x807F40BF, irsend.capture.value);
+  EXPECT_EQ(1, irrecv.getDecodeCacheHits());
+#if ENABLE_DECODE_PROFILING
+  EXPECT_EQ(sanyo,
+            irrecv.getDecodeProfile(decode_type_t::SANYO_LC7461)->attempts);
+#endif  // ENABLE_DECODE_PROFILING
+
+  // Other buttons take the long way the first time.
+  decode_results first = irsend.capture;
+  uint16_t first_rawbuf[kRawBuf];
+  for (uint16_t i = 0; i < first.rawlen; i++)
+    first_rawbuf[i] = irsend.capture.rawbuf[i];
+  first.rawbuf = first_rawbuf;
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0x807FC03F, irsend.capture.value);
+  irsend.reset();
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.getDecodeCacheHits());
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(2, irrecv.getDecodeCacheHits());
+  // The first button was the least recently used, so it was forgotten.
+  ASSERT_TRUE(irrecv.decode(&first));
+  EXPECT_EQ(0x807F40BF, first.value);
+  EXPECT_EQ(2, irrecv.getDecodeCacheHits());
+  ASSERT_TRUE(irrecv.decode(&first));
+  EXPECT_EQ(3, irrecv.getDecodeCacheHits());
+
+  // If the cached protocol doesn't decode it, they all get a go.
+  for (uint8_t i = 0; i < irrecv._dcache_size; i++)
+    if (irrecv._dcache[i].protocol == NEC)
+      irrecv._dcache[i].protocol = SONY;
+  ASSERT_TRUE(irrecv.decode(&first));
+  EXPECT_EQ(NEC, first.decode_type);
+  EXPECT_EQ(0x807F40BF, first.value);
+  EXPECT_EQ(3, irrecv.getDecodeCacheHits());
+  ASSERT_TRUE(irrecv.decode(&first));
+  EXPECT_EQ(4, irrecv.getDecodeCacheHits());
+
+  irrecv.disableDecodeCache();
+  ASSERT_TRUE(irrecv.decode(&first));
+  EXPECT_EQ(NEC, first.decode_type);
+}
+#endif  // ENABLE_DECODE_CACHE
+
+#if ENABLE_DECODE_TRACE
+// Tests for the decode trace.
+TEST(TestDecodeTrace, RecordsTheDecodeChain) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  // Off by default.
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0, irrecv.getDecodeTraceLength());
+  EXPECT_EQ(NULL, irrecv.getDecodeTraceEntry(0));
+
+  EXPECT_FALSE(irrecv.enableDecodeTrace(0));
+  ASSERT_TRUE(irrecv.enableDecodeTrace(500));
+  EXPECT_EQ(1, irrecv.getDecodeTraceRate());
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  const uint16_t length = irrecv.getDecodeTraceLength();
+  ASSERT_LT(2, length);
+  const decode_trace_t *entry = irrecv.getDecodeTraceEntry(0);
+  EXPECT_EQ(kTraceCapture, entry->event);
+  EXPECT_EQ(irsend.capture.rawlen, entry->value);
+  entry = irrecv.getDecodeTraceEntry(length - 1);
+  EXPECT_EQ(kTraceDecoded, entry->event);
+  EXPECT_EQ(NEC, entry->protocol);
+  EXPECT_EQ(kNECBits, entry->value);
+  EXPECT_EQ(kStartOffset, entry->offset);
+  EXPECT_EQ(NULL, irrecv.getDecodeTraceEntry(length));
+  bool attempted_nec = false;
+  uint32_t ticks = 0;
+  for (uint16_t i = 0; i < length; i++) {
+    entry = irrecv.getDecodeTraceEntry(i);
+    EXPECT_LE(ticks, entry->ticks);  // In order.
+    ticks = entry->ticks;
+    if (entry->event == kTraceAttempt && entry->protocol == NEC)
+      attempted_nec = true;
+  }
+  EXPECT_TRUE(attempted_nec);
+  const String dump = decodeTraceToString(&irrecv);
+  EXPECT_EQ(0, dump.find("# Decode trace: 1 ticks/usec, " +
+                         uint64ToString(length) + " events\n"));
+  EXPECT_NE(std::string::npos, dump.find(" 5 3 1 32\n"));  // Decoded NEC.
+
+  // A full trace keeps the most recent events.
+  ASSERT_TRUE(irrecv.enableDecodeTrace(3));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(3, irrecv.getDecodeTraceLength());
+  EXPECT_EQ(kTraceDecoded, irrecv.getDecodeTraceEntry(2)->event);
+  EXPECT_NE(kTraceCapture, irrecv.getDecodeTraceEntry(0)->event);
+
+  // Garbage isn't decoded, and that is recorded too.
+  irrecv.clearDecodeTrace();
+  EXPECT_EQ(0, irrecv.getDecodeTraceLength());
+  ASSERT_TRUE(irrecv.enableDecodeTrace());
+  irsend.reset();
+  irsend.mark(100);
+  irsend.space(100);
+  irsend.mark(100);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(kTraceNotDecoded,
+            irrecv.getDecodeTraceEntry(
+                irrecv.getDecodeTraceLength() - 1)->event);
+  irrecv.disableDecodeTrace();
+  EXPECT_EQ(0, irrecv.getDecodeTraceLength());
+  EXPECT_EQ("# Decode trace: 1 ticks/usec, 0 events\n",
+            decodeTraceToString(&irrecv));
+}
+#endif  // ENABLE_DECODE_TRACE
+
+// Tests for the timestamps of when a message was captured & decoded.
+TEST(TestCaptureTimestamps, ReportedInResults) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  captureInto(params, irsend.capture);
+  params->started = 1000;
+  params->stopped = 2000;
+  _IRtimer_unittest_now = 2500;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(1000, results.started);
+  EXPECT_EQ(2000, results.stopped);
+  EXPECT_EQ(2500, results.decoded);
+  EXPECT_EQ(500, results.decoded - results.stopped);
+}
+
+#if ENABLE_CAPTURE_RING
+TEST(TestCaptureTimestamps, KeptWithEachCaptureInTheRing) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.enableCaptureRing(3));
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  params->started = 100;
+  params->stopped = 200;
+  captureIntoRing(params, irsend.capture);
+  params->started = 300;
+  params->stopped = 400;
+  captureIntoRing(params, irsend.capture);
+  _IRtimer_unittest_now = 1000;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(100, results.started);
+  EXPECT_EQ(200, results.stopped);
+  EXPECT_EQ(1000, results.decoded);
+  _IRtimer_unittest_now = 1100;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(300, results.started);
+  EXPECT_EQ(400, results.stopped);
+  EXPECT_EQ(1100, results.decoded);
+}
+#endif  // ENABLE_CAPTURE_RING
+
+#if ENABLE_COMPACT_CAPTURE
+// Pretend the interrupt handler captured a message into the compact buffer.
+void captureCompact(volatile irparams_t *params,
+                    const decode_results &capture) {
+  params->packedlen = 0;
+  for (uint16_t i = 1; i < capture.rawlen; i++)
+    IRrecv::_packTicks(params, capture.rawbuf[i]);
+  params->rawlen = capture.rawlen;
+  params->overflow = false;
+  params->rcvstate = kStopState;
+}
+
+TEST(TestCompactCapture, EnableAndDisable) {
+  {
+    IRrecv no_save(1);
+    EXPECT_FALSE(no_save.enableCompactCapture());  // Needs a save buffer.
+  }
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  EXPECT_TRUE(irrecv.enableCompactCapture());
+  EXPECT_NE(nullptr, params->packed);
+  EXPECT_EQ(nullptr, params->rawbuf);
+  EXPECT_TRUE(irrecv.enableCompactCapture());  // Already in use.
+#if ENABLE_CAPTURE_RING
+  EXPECT_FALSE(irrecv.enableCaptureRing(2));  // Not with a compact capture.
+#endif  // ENABLE_CAPTURE_RING
+  EXPECT_FALSE(irrecv.enableCompactCapture(false));
+  EXPECT_EQ(nullptr, params->packed);
+  EXPECT_NE(nullptr, params->rawbuf);
+}
+
+TEST(TestCompactCapture, DecodeLargeMessage) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, 1024, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableCompactCapture());
+  irrecv.enableIRIn();
+  const uint8_t daikin_code[kDaikinStateLength] = {
+      0x11, 0xDA, 0x27, 0x00, 0xC5, 0x00, 0x00, 0xD7,
+      0x11, 0xDA, 0x27, 0x00, 0x42, 0x3A, 0x05, 0x93, 0x11,
+      0xDA, 0x27, 0x00, 0x00, 0x3F, 0x3A, 0x00, 0xA0, 0x00,
+      0x0A, 0x25, 0x17, 0x01, 0x00, 0xC0, 0x00, 0x00, 0x32};
+  irsend.reset();
+  irsend.sendDaikin(daikin_code);
+  irsend.makeDecodeResult();
+  captureCompact(params, irsend.capture);
+  // Only the few long gaps etc. needed more than a byte each.
+  EXPECT_GT(irsend.capture.rawlen + 20, params->packedlen);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(DAIKIN, results.decode_type);
+  EXPECT_EQ(kDaikinBits, results.bits);
+  EXPECT_STATE_EQ(daikin_code, results.state, kDaikinBits);
+  EXPECT_EQ(irsend.capture.rawlen, results.rawlen);
+  EXPECT_EQ(irrecv.irparams_save->rawbuf, results.rawbuf);
+  // Durations are kept to within a compact unit.
+  for (uint16_t i = 1; i < results.rawlen; i++)
+    EXPECT_NEAR(irsend.capture.rawbuf[i], results.rawbuf[i],
+                kPackedTickRatio / 2);
+  // It has been reset, ready for the next capture.
+  EXPECT_EQ(kIdleState, params->rcvstate);
+  EXPECT_EQ(0, params->packedlen);
+}
+#endif  // ENABLE_COMPACT_CAPTURE
+
+#if ENABLE_LARGE_CAPTURE
+TEST(TestLargeCapture, EnableAndDisable) {
+  {
+    IRrecv with_save(1, kRawBuf, kTimeoutMs, true);
+    EXPECT_FALSE(with_save.enableLargeCapture(1000));  // Too big to copy.
+  }
+  IRrecv irrecv(1);
+  volatile irparams_t *params = irrecv._params;
+  EXPECT_FALSE(irrecv.enableLargeCapture(0));
+  EXPECT_EQ(kRawBuf, irrecv.getBufSize());
+  ASSERT_TRUE(irrecv.enableLargeCapture(1000, 32));
+  EXPECT_EQ(1000, irrecv.getBufSize());
+  EXPECT_NE(nullptr, params->rawbuf);
+  EXPECT_NE(nullptr, params->staging);
+  EXPECT_EQ(32, params->stagesize);
+#if ENABLE_CAPTURE_RING
+  EXPECT_FALSE(irrecv.enableCaptureRing(2));  // Not with a large capture.
+#endif  // ENABLE_CAPTURE_RING
+  // It can be resized.
+  ASSERT_TRUE(irrecv.enableLargeCapture(2000, 0));
+  EXPECT_EQ(2000, irrecv.getBufSize());
+  EXPECT_EQ(nullptr, params->staging);
+  irrecv.disableLargeCapture();
+  EXPECT_EQ(kRawBuf, irrecv.getBufSize());
+  EXPECT_NE(nullptr, params->rawbuf);
+  EXPECT_EQ(nullptr, params->staging);
+  irrecv.disableLargeCapture();  // Does nothing.
+  EXPECT_EQ(kRawBuf, irrecv.getBufSize());
+  // It is freed with the receiver.
+  EXPECT_TRUE(irrecv.enableLargeCapture(1000));
+}
+
+TEST(TestLargeCapture, DecodeLargeMessage) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0, kRawBuf, 50);  // Far too small for a Daikin message.
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableLargeCapture(1000, 32));
+  irrecv.enableIRIn();
+  SimulatedChannel channel(&irrecv);
+  const uint8_t daikin_code[kDaikinStateLength] = {
+      0x11, 0xDA, 0x27, 0x00, 0xC5, 0x00, 0x00, 0xD7,
+      0x11, 0xDA, 0x27, 0x00, 0x42, 0x3A, 0x05, 0x93, 0x11,
+      0xDA, 0x27, 0x00, 0x00, 0x3F, 0x3A, 0x00, 0xA0, 0x00,
+      0x0A, 0x25, 0x17, 0x01, 0x00, 0xC0, 0x00, 0x00, 0x32};
+  irsend.sendDaikin(daikin_code);
+  channel.transmit(&irsend);
+  // Drained as it arrives. e.g. By the drain task.
+  uint16_t drained = 0;
+  while (!channel.run(5000)) drained += irrecv.drainCapture();
+  EXPECT_GT(drained, kRawBuf);
+  EXPECT_FALSE(params->overflow);
+  results.rawbuf = params->rawbuf;
+  results.rawlen = params->rawlen;
+  results.overflow = params->overflow;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(DAIKIN, results.decode_type);
+  EXPECT_EQ(kDaikinBits, results.bits);
+  EXPECT_STATE_EQ(daikin_code, results.state, kDaikinBits);
+  EXPECT_EQ(params->rawbuf, results.rawbuf);  // Decoded in place.
+  EXPECT_GT(results.rawlen, kRawBuf);
+  EXPECT_EQ(results.rawlen, params->drained);
+  irrecv.resume();
+
+  // Not drained in time, it overflows the staging.
+  irsend.sendDaikin(daikin_code);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_TRUE(results.overflow);
+  EXPECT_EQ(32, results.rawlen);
+  EXPECT_NE(DAIKIN, results.decode_type);
+}
+#endif  // ENABLE_LARGE_CAPTURE
+
 // Tests for decode().
 
 // Test decode of a NEC message.
@@ -449,6 +1617,115 @@ TEST(TestDecode, DecodeAiwa) {
 }
 
 // Test matchData() on space encoded data.
+// The precomputed windows must accept exactly what match() does.
+TEST(TestMatchData, WindowsAgreeWithMatch) {
+  IRrecv irrecv(1);
+  const uint32_t desired[] = {1, 50, 158, 560, 1690, 4500, 9000, 29784};
+  const uint8_t tolerances[] = {0, 10, kTolerance, 40, kUseDefTol};
+  for (uint8_t d = 0; d < sizeof(desired) / sizeof(desired[0]); d++)
+    for (uint8_t t = 0; t < sizeof(tolerances); t++) {
+      match_window_t window = irrecv._matchWindow(desired[d], tolerances[t]);
+      for (uint32_t ticks = 0; ticks < desired[d]; ticks++)
+        ASSERT_EQ(irrecv.match(ticks, desired[d], tolerances[t]),
+                  ticks >= window.low && ticks <= window.high)
+            << "desired: " << desired[d] << " tolerance: "
+            << (uint16_t)tolerances[t] << " ticks: " << ticks;
+    }
+}
+
+TEST(TestMatchData, FastPathAgreesWithStrict) {
+  IRrecv irrecv(1);
+  // NEC-like. i.e. Pulse distance encoded.
+  const bit_windows_t windows = irrecv._bitWindows(560, 1690, 560, 560);
+  ASSERT_TRUE(windows.distance);
+  // Durations on & either side of the edges of each window.
+  const match_window_t edges[3] = {windows.onemark, windows.onespace,
+                                   windows.zerospace};
+  uint16_t values[3 * 6];
+  uint8_t nvalues = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    values[nvalues++] = edges[i].low - 1;
+    values[nvalues++] = edges[i].low;
+    values[nvalues++] = edges[i].low + 1;
+    values[nvalues++] = edges[i].high - 1;
+    values[nvalues++] = edges[i].high;
+    values[nvalues++] = edges[i].high + 1;
+  }
+  uint16_t data[16];
+  uint32_t seed = 1;
+  for (uint16_t run = 0; run < 2000; run++) {
+    for (uint8_t i = 0; i < 16; i++) {
+      seed = seed * 1103515245 + 12345;  // Any old pseudo random numbers.
+      // Mostly good values, so we don't always fail on the first bit.
+      if ((seed >> 24) % 8)
+        data[i] = (i % 2) ? ((seed >> 16) % 2 ? windows.onespace.low + 1
+                                              : windows.zerospace.high - 1)
+                          : windows.onemark.low + 1;
+      else
+        data[i] = values[(seed >> 16) % nvalues];
+    }
+    for (uint8_t msb = 0; msb < 2; msb++) {
+      const match_result_t fast = irrecv._matchData(data, 8, &windows, msb);
+      const match_result_t strict = irrecv._matchDataStrict(data, 8, &windows,
+                                                            msb);
+      ASSERT_EQ(strict.success, fast.success) << "Run " << run;
+      ASSERT_EQ(strict.data, fast.data) << "Run " << run;
+      ASSERT_EQ(strict.used, fast.used) << "Run " << run;
+    }
+  }
+  // Not pulse distance encoded, so only the strict path can be used.
+  EXPECT_FALSE(irrecv._bitWindows(1200, 600, 600, 600).distance);  // Sony
+  EXPECT_FALSE(irrecv._bitWindows(560, 700, 560, 600).distance);  // Overlaps
+}
+
+TEST(TestMatchData, WidthPathAgreesWithStrict) {
+  IRrecv irrecv(1);
+  // Symphony-like. i.e. Constant bit time, so pulse width encoded.
+  const bit_windows_t windows = irrecv._bitWindows(1250, 400, 400, 1250);
+  ASSERT_FALSE(windows.distance);
+  ASSERT_TRUE(windows.width);
+  // Durations on & either side of the edges of each window.
+  const match_window_t edges[4] = {windows.onemark, windows.onespace,
+                                   windows.zeromark, windows.zerospace};
+  uint16_t values[4 * 6];
+  uint8_t nvalues = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    values[nvalues++] = edges[i].low - 1;
+    values[nvalues++] = edges[i].low;
+    values[nvalues++] = edges[i].low + 1;
+    values[nvalues++] = edges[i].high - 1;
+    values[nvalues++] = edges[i].high;
+    values[nvalues++] = edges[i].high + 1;
+  }
+  uint16_t data[16];
+  uint32_t seed = 1;
+  for (uint16_t run = 0; run < 2000; run++) {
+    for (uint8_t i = 0; i < 16; i += 2) {
+      seed = seed * 1103515245 + 12345;  // Any old pseudo random numbers.
+      // Mostly good values, so we don't always fail on the first bit.
+      if ((seed >> 24) % 8) {
+        const bool one = (seed >> 16) % 2;
+        data[i] = one ? windows.onemark.low + 1 : windows.zeromark.high - 1;
+        data[i + 1] = one ? windows.onespace.high - 1
+                          : windows.zerospace.low + 1;
+      } else {
+        data[i] = values[(seed >> 16) % nvalues];
+        data[i + 1] = values[(seed >> 8) % nvalues];
+      }
+    }
+    for (uint8_t msb = 0; msb < 2; msb++) {
+      const match_result_t fast = irrecv._matchData(data, 8, &windows, msb);
+      const match_result_t strict = irrecv._matchDataStrict(data, 8, &windows,
+                                                            msb);
+      ASSERT_EQ(strict.success, fast.success) << "Run " << run;
+      ASSERT_EQ(strict.data, fast.data) << "Run " << run;
+      ASSERT_EQ(strict.used, fast.used) << "Run " << run;
+    }
+  }
+  // The marks overlap, so only the strict path can be used.
+  EXPECT_FALSE(irrecv._bitWindows(600, 600, 560, 1690).width);
+}
+
 TEST(TestMatchData, SpaceEncoded) {
   IRsendTest irsend(0);
   IRrecv irrecv(1);
@@ -473,6 +1750,38 @@ TEST(TestMatchData, SpaceEncoded) {
   ASSERT_FALSE(result.success);
 }
 
+// Test matchData() gets back what sendData() sent, whatever the nr. of bits.
+TEST(TestMatchData, RoundTripsAllSizes) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  const uint16_t sizes[] = {1, 8, 9, 31, 32, 33, 63, 64};
+  for (const uint16_t nbits : sizes) {
+    const uint64_t data = 0xA5C3F00F0FF03C5A >> (64 - nbits);
+    for (const bool msb : {true, false}) {
+      // Space encoded, then mark encoded.
+      irsend.reset();
+      irsend.sendData(500, 1500, 500, 500, data, nbits, msb);
+      irsend.mark(500);
+      irsend.makeDecodeResult();
+      match_result_t result = irrecv.matchData(irsend.capture.rawbuf + 1,
+                                               nbits, 500, 1500, 500, 500,
+                                               kUseDefTol, 0, msb);
+      ASSERT_TRUE(result.success) << nbits << " bits";
+      EXPECT_EQ(data, result.data) << nbits << " bits";
+      EXPECT_EQ(nbits * 2, result.used);
+      irsend.reset();
+      irsend.sendData(1500, 500, 500, 500, data, nbits, msb);
+      irsend.mark(500);
+      irsend.makeDecodeResult();
+      result = irrecv.matchData(irsend.capture.rawbuf + 1, nbits,
+                                1500, 500, 500, 500, kUseDefTol, 0, msb);
+      ASSERT_TRUE(result.success) << nbits << " bits";
+      EXPECT_EQ(data, result.data) << nbits << " bits";
+    }
+  }
+}
+
 // Test matchData() on mark encoded data.
 TEST(TestMatchData, MarkEncoded) {
   IRsendTest irsend(0);
@@ -1014,6 +2323,78 @@ TEST(TestMatchGeneric, MissingHeaderFooter) {
   EXPECT_EQ(kentries - 2, entries_used);
 }
 
+// Check matchBytes() verifies checks as it goes, & stops at the first failure.
+TEST(TestMatchGeneric, ByteChecks) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  // A checksum of the first two bytes in the third, then a fourth byte.
+  const irutils::checksum_t checksums[] = {
+      {irutils::kSumBytesChecksum, 0, 3, 0}};
+  const irutils::fixed_byte_t fixed[] = {{0, 0xF0, 0xA0}};  // Top nibble.
+  const byte_checks_t checks = {checksums, 1, fixed, 1};
+  uint8_t state[4];
+
+  // It passes them all.
+  irsend.reset();
+  irsend.sendData(500, 2000, 500, 1000, 0xA512B734, 32, true);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(64, irrecv.matchBytes(irsend.capture.rawbuf + kStartOffset, state,
+                                  irsend.capture.rawlen - kStartOffset, 4,
+                                  500, 2000, 500, 1000, 1, 0, true, &checks));
+  EXPECT_EQ(0xA5, state[0]);
+  EXPECT_EQ(0x34, state[3]);
+
+  // A wrong signature. Nothing after it is matched.
+  irsend.reset();
+  irsend.sendData(500, 2000, 500, 1000, 0xB512C734, 32, true);
+  irsend.makeDecodeResult();
+  memset(state, 0xEE, sizeof(state));
+  EXPECT_EQ(0, irrecv.matchBytes(irsend.capture.rawbuf + kStartOffset, state,
+                                 irsend.capture.rawlen - kStartOffset, 4,
+                                 500, 2000, 500, 1000, 1, 0, true, &checks));
+  EXPECT_EQ(0xB5, state[0]);
+  EXPECT_EQ(0xEE, state[1]);
+  // But it is a match without the checks.
+  EXPECT_EQ(64, irrecv.matchBytes(irsend.capture.rawbuf + kStartOffset, state,
+                                  irsend.capture.rawlen - kStartOffset, 4,
+                                  500, 2000, 500, 1000, 1, 0, true));
+
+  // Only the masked bits of the signature matter. A bad checksum stops it at
+  // the checksum byte.
+  irsend.reset();
+  irsend.sendData(500, 2000, 500, 1000, 0xAF120034, 32, true);
+  irsend.makeDecodeResult();
+  memset(state, 0xEE, sizeof(state));
+  EXPECT_EQ(0, irrecv.matchBytes(irsend.capture.rawbuf + kStartOffset, state,
+                                 irsend.capture.rawlen - kStartOffset, 4,
+                                 500, 2000, 500, 1000, 1, 0, true, &checks));
+  EXPECT_EQ(0x00, state[2]);
+  EXPECT_EQ(0xEE, state[3]);
+
+  // Via matchGeneric(), with a checksum of the whole message.
+  const irutils::checksum_t whole[] = {
+      {irutils::kSumBytesChecksum, 0, irutils::kChecksumToEnd, 0}};
+  const byte_checks_t whole_checks = {whole, 1, NULL, 0};
+  irsend.reset();
+  irsend.sendGeneric(8000, 4000, 500, 2000, 500, 1000, 500, 20000,
+                     0x0102030006, 40, 38, true, 0, kDutyDefault);
+  irsend.makeDecodeResult();
+  uint8_t result[5];
+  EXPECT_NE(0, irrecv.matchGeneric(irsend.capture.rawbuf + kStartOffset, result,
+                                   irsend.capture.rawlen - kStartOffset, 40,
+                                   8000, 4000, 500, 2000, 500, 1000, 500, 20000,
+                                   true, 1, 0, true, &whole_checks));
+  irsend.reset();
+  irsend.sendGeneric(8000, 4000, 500, 2000, 500, 1000, 500, 20000,
+                     0x0102030007, 40, 38, true, 0, kDutyDefault);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(0, irrecv.matchGeneric(irsend.capture.rawbuf + kStartOffset, result,
+                                   irsend.capture.rawlen - kStartOffset, 40,
+                                   8000, 4000, 500, 2000, 500, 1000, 500, 20000,
+                                   true, 1, 0, true, &whole_checks));
+}
+
 TEST(TestMatchGeneric, BitOrdering) {
   IRsendTest irsend(0);
   IRrecv irrecv(1);
@@ -1209,41 +2590,685 @@ TEST(TestMatchGeneric, UsingBytes) {
   ASSERT_EQ(0, entries_used);
 }
 
-TEST(TestIRrecv, Tolerance) {
+TEST(TestIRrecv, Tolerance) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  uint16_t equal_encoded_raw[11] = {500,  1500, 1500, 500, 499, 1499,
+                                    1501, 501,  1499, 490, 500};
+  match_result_t result;
+
+  ASSERT_EQ(kTolerance, irrecv.getTolerance());
+  irrecv.setTolerance();
+  ASSERT_EQ(kTolerance, irrecv.getTolerance());
+  irrecv.setTolerance(kTolerance + 1);
+  ASSERT_EQ(kTolerance + 1, irrecv.getTolerance());
+  irrecv.setTolerance(kTolerance - 1);
+  ASSERT_EQ(kTolerance - 1, irrecv.getTolerance());
+
+  irrecv.setTolerance();
+  ASSERT_EQ(kTolerance, irrecv.getTolerance());
+
+  irsend.reset();
+  irsend.sendRaw(equal_encoded_raw, 11, 38000);
+  irsend.makeDecodeResult();
+  result = irrecv.matchData(irsend.capture.rawbuf + 1, 5, 1500, 500, 500, 1500);
+  ASSERT_TRUE(result.success);
+  EXPECT_EQ(0b01011, result.data);
+  EXPECT_EQ(10, result.used);
+
+  irrecv.setTolerance(0);
+  ASSERT_EQ(0, irrecv.getTolerance());
+  irsend.reset();
+  irsend.sendRaw(equal_encoded_raw, 11, 38000);
+  irsend.makeDecodeResult();
+  result = irrecv.matchData(irsend.capture.rawbuf + 1, 5, 1500, 500, 500, 1500);
+  ASSERT_FALSE(result.success);
+}
+
+TEST(TestIRrecv, ProtocolTolerance) {
+  IRrecv irrecv(1);
+  EXPECT_EQ(kUseDefTol, irrecv.getProtocolTolerance(NEC));
+  EXPECT_FALSE(irrecv.setProtocolTolerance(UNKNOWN, 40));
+  EXPECT_TRUE(irrecv.setProtocolTolerance(NEC, 40));
+  EXPECT_EQ(40, irrecv.getProtocolTolerance(NEC));
+  EXPECT_TRUE(irrecv.setProtocolTolerance(NEC, 101));  // Updated & capped.
+  EXPECT_EQ(100, irrecv.getProtocolTolerance(NEC));
+  EXPECT_EQ(kTolerance, irrecv.getTolerance());  // Unchanged.
+  EXPECT_EQ(kUseDefTol, irrecv.getProtocolTolerance(SONY));
+  irrecv.clearProtocolTolerance(NEC);
+  EXPECT_EQ(kUseDefTol, irrecv.getProtocolTolerance(NEC));
+  irrecv.clearProtocolTolerance(NEC);  // Not set, so nothing happens.
+
+  // Only so many protocols can have one.
+  for (uint8_t i = 0; i < kMaxProtocolTolerances; i++)
+    EXPECT_TRUE(irrecv.setProtocolTolerance(
+        (decode_type_t)(kLastDecodeType - i), 30));
+  EXPECT_FALSE(irrecv.setProtocolTolerance(NEC, 30));
+  // Can still be updated.
+  EXPECT_TRUE(irrecv.setProtocolTolerance(kLastDecodeType, 35));
+  irrecv.clearProtocolTolerance(kLastDecodeType);
+  EXPECT_EQ(30, irrecv.getProtocolTolerance(
+      (decode_type_t)(kLastDecodeType - 1)));
+  EXPECT_TRUE(irrecv.setProtocolTolerance(NEC, 30));
+}
+
+TEST(TestIRrecv, ProtocolToleranceWindows) {
+  IRrecv global(1);
+  IRrecv precomputed(1);
+  // The precomputed scaling agrees with the floating point maths, give or
+  // take a uSecond of rounding.
+  for (uint8_t tolerance = 0; tolerance <= 100; tolerance += 5) {
+    global.setTolerance(tolerance);
+    ASSERT_TRUE(precomputed.setProtocolTolerance(NEC, tolerance));
+    ASSERT_TRUE(precomputed._attempt(NEC));
+    for (uint32_t usecs = 0; usecs < 30000; usecs += 13) {
+      ASSERT_NEAR(global.ticksLow(usecs), precomputed.ticksLow(usecs, 0), 1)
+          << usecs << "us at " << (uint16_t)tolerance << "%";
+      ASSERT_NEAR(global.ticksHigh(usecs, kUseDefTol, 20),
+                  precomputed.ticksHigh(usecs, 0, 20), 1)
+          << usecs << "us at " << (uint16_t)tolerance << "%";
+    }
+  }
+  // Only the protocol being attempted uses it.
+  ASSERT_TRUE(precomputed._attempt(SONY));
+  EXPECT_EQ(global.ticksLow(1000, 20), precomputed.ticksLow(1000, 20));
+}
+
+TEST(TestIRrecv, ProtocolToleranceDecoding) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  // An NEC message 35% slower than it should be.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  for (uint16_t i = 1; i < irsend.capture.rawlen; i++)
+    irsend.capture.rawbuf[i] = irsend.capture.rawbuf[i] * 135 / 100;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(NEC, irsend.capture.decode_type);
+  // Widening it for NEC only.
+  ASSERT_TRUE(irrecv.setProtocolTolerance(NEC, 50));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x807FC03F, irsend.capture.value);
+  // Other protocols still use the usual one.
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E09966);
+  irsend.makeDecodeResult();
+  for (uint16_t i = 1; i < irsend.capture.rawlen; i++)
+    irsend.capture.rawbuf[i] = irsend.capture.rawbuf[i] * 135 / 100;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(SAMSUNG, irsend.capture.decode_type);
+  irrecv.clearProtocolTolerance(NEC);
+
+  // A mark excess for just one protocol.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  addSensorLag(&irsend.capture, 300);
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(NEC, irsend.capture.decode_type);
+  ASSERT_TRUE(irrecv.setProtocolTolerance(NEC, kTolerance,
+                                          300 - kMarkExcess));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x807FC03F, irsend.capture.value);
+  EXPECT_EQ(kMarkExcess, irrecv.getMarkExcess());  // Unchanged.
+}
+
+#if ENABLE_HEADER_DISPATCH
+// The header dispatch window must allow for a protocol's own tolerance &
+// mark excess, or the decoder is never tried.
+TEST(TestIRrecv, ProtocolToleranceHeaderDispatch) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  // An NEC message with a very long header mark. Everything else is nominal.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  irsend.capture.rawbuf[1] = 13950 / kRawTick;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(NEC, irsend.capture.decode_type);
+  ASSERT_TRUE(irrecv.setProtocolTolerance(NEC, 60));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x807FC03F, irsend.capture.value);
+  irrecv.clearProtocolTolerance(NEC);
+
+  // A short header mark, lengthened a lot by the sensor's lag.
+  const uint16_t lagged = (kDispatchLegoPfBitMark + 300) / kRawTick;
+  irrecv._setHeaderWindow(lagged);
+  EXPECT_FALSE(irrecv._headerMayMatch(kDispatchLegoPfBitMark));
+  irrecv.setMarkExcess(300);
+  irrecv._setHeaderWindow(lagged);
+  EXPECT_TRUE(irrecv._headerMayMatch(kDispatchLegoPfBitMark));
+  // Or by that of just the protocol being attempted.
+  irrecv.setMarkExcess(kMarkExcess);
+  irrecv._setHeaderWindow(lagged);
+  ASSERT_TRUE(irrecv.setProtocolTolerance(LEGOPF, kTolerance,
+                                          300 - kMarkExcess));
+  ASSERT_TRUE(irrecv._attempt(LEGOPF));
+  EXPECT_TRUE(irrecv._headerMayMatch(kDispatchLegoPfBitMark));
+}
+#endif  // ENABLE_HEADER_DISPATCH
+
+#if ENABLE_CARRIER_FILTER
+// Capture a message from a raw input. i.e. Turn its marks into the carrier
+// pulses a photodiode would see, & demodulate them the way `rmt_read()` does.
+static uint16_t captureCarrier(const IRsequence *message, uint16_t *rawbuf,
+                               const uint16_t size, uint32_t *carrier) {
+  carrier_demod_t demod;
+  IRrecv::_demodReset(&demod);
+  const double period = 1000000.0 / message->frequency();
+  const uint16_t on = period * message->dutyCycle() / 100;
+  const uint16_t *durations = message->durations();
+  uint16_t rawlen = 0;
+  rawbuf[rawlen++] = 1;
+  double when = 0;  // When the current mark started.
+  for (uint16_t i = 0; i < message->length(); i += 2) {
+    const bool last = i + 2 >= message->length();
+    const uint16_t pulses = durations[i] / period + 0.5;
+    const double next = when + durations[i] + durations[i + 1];
+    for (uint16_t p = 0; p < pulses; p++) {
+      // The RMT peripheral times them to the nearest uSecond.
+      const uint32_t start = when + p * period + 0.5;
+      uint32_t stop = when + (p + 1) * period + 0.5;
+      if (p + 1 == pulses) stop = last ? start + on : next + 0.5;
+      uint32_t entries[2];
+      IRrecv::_demodulate(&demod, on, stop - start - on, entries);
+      for (uint8_t j = 0; j < 2 && entries[j] && rawlen < size; j++)
+        rawbuf[rawlen++] = (entries[j] + kRawTick - 1) / kRawTick;
+    }
+    when = next;
+  }
+  *carrier = IRrecv::_demodCarrier(&demod);
+  return rawlen;
+}
+
+TEST(TestIRrecv, CarrierDemodulation) {
+  carrier_demod_t demod;
+  uint32_t entries[2];
+  IRrecv::_demodReset(&demod);
+  EXPECT_EQ(0, IRrecv::_demodCarrier(&demod));
+  // Three 40kHz pulses are a mark of three whole periods.
+  IRrecv::_demodulate(&demod, 8, 17, entries);
+  EXPECT_EQ(0, entries[0]);
+  EXPECT_EQ(0, entries[1]);
+  IRrecv::_demodulate(&demod, 8, 17, entries);
+  IRrecv::_demodulate(&demod, 8, 500, entries);
+  EXPECT_EQ(75, entries[0]);
+  EXPECT_EQ(483, entries[1]);
+  EXPECT_EQ(40000, IRrecv::_demodCarrier(&demod));
+  // A lone pulse has no carrier to measure, & ends the capture.
+  IRrecv::_demodulate(&demod, 10, 0, entries);
+  EXPECT_EQ(10, entries[0]);
+  EXPECT_EQ(0, entries[1]);
+  EXPECT_EQ(40000, IRrecv::_demodCarrier(&demod));
+  // Nothing is left to end.
+  IRrecv::_demodulate(&demod, 0, 0, entries);
+  EXPECT_EQ(0, entries[0]);
+
+  // Whole messages.
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  EXPECT_FALSE(irrecv.getCarrierInput());
+  irrecv.setCarrierInput(true);
+  EXPECT_TRUE(irrecv.getCarrierInput());
+  IRsequence message;
+  uint16_t rawbuf[kRawBuf];
+  decode_results results;
+  results.rawbuf = rawbuf;
+  uint32_t carrier;
+
+  irsend.startRecording(&message);
+  irsend.sendSony(0x240, kSony12Bits);
+  ASSERT_TRUE(irsend.stopRecording());
+  results.rawlen = captureCarrier(&message, rawbuf, kRawBuf, &carrier);
+  EXPECT_NEAR(40000, carrier, 40);
+  irrecv._params->carrier = carrier;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SONY, results.decode_type);
+  EXPECT_EQ(0x240, results.value);
+  EXPECT_EQ(carrier, irrecv.getCarrier());
+
+  irsend.startRecording(&message);
+  irsend.sendNEC(0x807FC03F);
+  ASSERT_TRUE(irsend.stopRecording());
+  results.rawlen = captureCarrier(&message, rawbuf, kRawBuf, &carrier);
+  EXPECT_NEAR(38000, carrier, 38);
+  irrecv._params->carrier = carrier;
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+}
+
+TEST(TestIRrecv, CarrierFilter) {
+  EXPECT_EQ(40000, IRrecv::protocolCarrier(SONY));
+  EXPECT_EQ(38000, IRrecv::protocolCarrier(NEC));
+  EXPECT_EQ(kPanasonicFreq, IRrecv::protocolCarrier(PANASONIC));
+  EXPECT_EQ(0, IRrecv::protocolCarrier(decode_type_t::UNKNOWN));
+  EXPECT_EQ(0, IRrecv::protocolCarrier(PRONTO));  // Its own codes have it.
+
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  EXPECT_EQ(kCarrierTolerance, irrecv.getCarrierTolerance());
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  // Measured as NEC's, or not at all.
+  irrecv._params->carrier = 38000;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(38000, irrecv.getCarrier());
+  irrecv._params->carrier = 0;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0, irrecv.getCarrier());
+  // Sony's carrier. NEC isn't tried.
+  irrecv._params->carrier = 40000;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(NEC, irsend.capture.decode_type);
+  // Unless it is within the tolerance.
+  irrecv.setCarrierTolerance(10);
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  irrecv._params->carrier = 56000;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(NEC, irsend.capture.decode_type);
+  // Or the filter is off.
+  irrecv.setCarrierTolerance(0);
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  irrecv.setCarrierTolerance();
+  EXPECT_EQ(kCarrierTolerance, irrecv.getCarrierTolerance());
+}
+#endif  // ENABLE_CARRIER_FILTER
+
+#if ENABLE_HEADER_DISPATCH
+TEST(TestIRrecv, HeaderDispatchWindow) {
+  IRrecv irrecv(1);
+  // Until a capture has been looked at, everything should be tried.
+  EXPECT_TRUE(irrecv._headerMayMatch(0));
+  EXPECT_TRUE(irrecv._headerMayMatch(UINT16_MAX));
+
+  // A typical NEC header mark.
+  irrecv._setHeaderWindow(9000 / kRawTick);
+  EXPECT_TRUE(irrecv._headerMayMatch(8960));   // NEC
+  EXPECT_TRUE(irrecv._headerMayMatch(8200));   // Amcor
+  EXPECT_FALSE(irrecv._headerMayMatch(3400));  // Hitachi etc.
+  EXPECT_FALSE(irrecv._headerMayMatch(560));   // Headerless protocols.
+  EXPECT_FALSE(irrecv._headerMayMatch(29784));
+
+  // A short mark. e.g. No header at all.
+  irrecv._setHeaderWindow(560 / kRawTick);
+  EXPECT_TRUE(irrecv._headerMayMatch(586));
+  EXPECT_FALSE(irrecv._headerMayMatch(2400));
+  EXPECT_FALSE(irrecv._headerMayMatch(8960));
+
+  // No capture data.
+  irrecv._setHeaderWindow(0);
+  EXPECT_FALSE(irrecv._headerMayMatch(158));
+
+  // A huge tolerance means the window is unbounded at the top.
+  irrecv.setTolerance(80);
+  irrecv._setHeaderWindow(560 / kRawTick);
+  EXPECT_TRUE(irrecv._headerMayMatch(8960));
+  EXPECT_TRUE(irrecv._headerMayMatch(29784));
+}
+
+TEST(TestDecode, HeaderDispatchDoesNotChangeResults) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  // Sanyo LC7461 is NEC-like and must still be found before NEC.
+  irsend.reset();
+  irsend.sendSanyoLC7461(0x2468DCB56A9);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SANYO_LC7461, irsend.capture.decode_type);
+  // Headerless protocols are still attempted.
+  irsend.reset();
+  irsend.sendSharpRaw(0x454A, kSharpBits);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SHARP, irsend.capture.decode_type);
+  // Junk before the real message, found by skipping.
+  irsend.reset();
+  irsend.mark(100);
+  irsend.space(5000);
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  EXPECT_TRUE(irrecv.decode(&irsend.capture, NULL, 1));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_EQ(kSony12Bits, irsend.capture.bits);
+}
+
+TEST(TestDecode, SmartSkip) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  irrecv.setSmartSkip();
+  irrecv.disableProtocol(UNKNOWN);  // Don't let the hash decoder match junk.
+  // A long header after some junk is still found.
+  irsend.reset();
+  irsend.mark(100);
+  irsend.space(100);
+  irsend.mark(120);
+  irsend.space(5000);
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decode(&irsend.capture, NULL, 1));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture, NULL, 2));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x807F40BF, irsend.capture.value);
+  // A protocol without a long header mark isn't looked for after the junk.
+  irsend.reset();
+  irsend.mark(100);
+  irsend.space(5000);
+  irsend.sendSharpRaw(0x454A, kSharpBits);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decode(&irsend.capture, NULL, 1));
+  // Unless smart skipping is turned off.
+  irrecv.setSmartSkip(false);
+  ASSERT_TRUE(irrecv.decode(&irsend.capture, NULL, 1));
+  EXPECT_EQ(SHARP, irsend.capture.decode_type);
+}
+#endif  // ENABLE_HEADER_DISPATCH
+
+#if ENABLE_DECODE_PROFILING
+TEST(TestDecode, DecodeProfiling) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  // Nothing is collected until asked for.
+  EXPECT_EQ(nullptr, irrecv.getDecodeProfile(NEC));
+  EXPECT_EQ("", decodeProfileToString(&irrecv));
+  ASSERT_TRUE(irrecv.enableDecodeProfiling());
+  ASSERT_NE(nullptr, irrecv.getDecodeProfile(NEC));
+  EXPECT_EQ(nullptr,
+            irrecv.getDecodeProfile((decode_type_t)(kLastDecodeType + 1)));
+
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(NEC, irsend.capture.decode_type);
+  irsend.reset();
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(SONY, irsend.capture.decode_type);
+
+  const decode_profile_t *nec = irrecv.getDecodeProfile(NEC);
+  EXPECT_EQ(2, nec->attempts);
+  EXPECT_EQ(1, nec->successes);
+  const decode_profile_t *sony = irrecv.getDecodeProfile(SONY);
+  EXPECT_EQ(1, sony->attempts);
+  EXPECT_EQ(1, sony->successes);
+  EXPECT_EQ(0, sony->rejects);
+  // Never got to these.
+  EXPECT_EQ(0, irrecv.getDecodeProfile(RC5)->attempts);
+  EXPECT_EQ(0, irrecv.getDecodeProfile(UNKNOWN)->attempts);
+#if ENABLE_HEADER_DISPATCH
+  // The Sony message's header ruled out NEC without trying it.
+  EXPECT_EQ(1, nec->rejects);
+#endif  // ENABLE_HEADER_DISPATCH
+  EXPECT_NE(std::string::npos, decodeProfileToString(&irrecv).find(
+      "SONY: 1 attempted, 0 rejected, 1 decoded, 0 usecs\n"));
+
+  irrecv.resetDecodeProfile();
+  EXPECT_EQ(0, nec->attempts);
+  EXPECT_EQ("", decodeProfileToString(&irrecv));
+  irrecv.disableDecodeProfiling();
+  EXPECT_EQ(nullptr, irrecv.getDecodeProfile(NEC));
+}
+#endif  // ENABLE_DECODE_PROFILING
+
+TEST(TestDecode, RuntimeProtocolMask) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  EXPECT_TRUE(irrecv.isProtocolEnabled(NEC));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(UNKNOWN));
+  EXPECT_FALSE(irrecv.isProtocolEnabled((decode_type_t)(kLastDecodeType + 1)));
+
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  irrecv.disableProtocol(NEC);
+  EXPECT_FALSE(irrecv.isProtocolEnabled(NEC));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(NEC, irsend.capture.decode_type);  // Something else had a go.
+  irrecv.disableAllProtocols();
+  EXPECT_FALSE(irrecv.decode(&irsend.capture));
+  irrecv.enableProtocol(NEC);
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  irrecv.enableAllProtocols();
+  EXPECT_TRUE(irrecv.isProtocolEnabled(SONY));
+}
+
+TEST(TestDecode, ProtocolLearning) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  irrecv.disableAllProtocols();
+  irrecv.startProtocolLearning();
+  // Everything is attempted while learning.
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  irsend.reset();
+  irsend.sendLG2(0x880094D);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(LG2, irsend.capture.decode_type);
+  EXPECT_EQ(3, irrecv.stopProtocolLearning());  // NEC, LG & LG2.
+  EXPECT_TRUE(irrecv.isProtocolEnabled(NEC));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(LG));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(LG2));
+  EXPECT_FALSE(irrecv.isProtocolEnabled(SONY));
+  EXPECT_FALSE(irrecv.isProtocolEnabled(UNKNOWN));
+  // Only what was learnt is now attempted.
+  irsend.reset();
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decode(&irsend.capture));
+  // Learning without applying leaves the mask alone.
+  irrecv.startProtocolLearning();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.stopProtocolLearning(false));
+  EXPECT_FALSE(irrecv.isProtocolEnabled(SONY));
+}
+
+// Pretend the interrupt handlers are part way through capturing a message.
+// i.e. They have seen the first `entries` marks & spaces of it.
+void captureInProgress(volatile irparams_t *params,
+                       const decode_results &capture, const uint16_t entries) {
+  params->rawbuf[0] = 1;
+  for (uint16_t i = 1; i <= entries && i < params->bufsize; i++)
+    params->rawbuf[i] = capture.rawbuf[i];
+  params->rawlen = entries + 1;
+  params->rcvstate = kMarkState;
+}
+
+const uint16_t kRawJunk[8] = {1000, 1000, 3000, 500, 700, 2000, 1500, 900};
+
+TEST(TestDecode, DecodeEarly) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  volatile irparams_t *params = irrecv._params;
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+  // Nothing has arrived yet.
+  EXPECT_FALSE(irrecv.decodeEarly(&results));
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  // Only the header & a few bits. Not enough to decode yet.
+  captureInProgress(params, irsend.capture, 10);
+  EXPECT_FALSE(irrecv.decodeEarly(&results));
+  EXPECT_EQ(kMarkState, params->rcvstate);  // Still capturing.
+  // Part way through a mark. i.e. It can't be the end of a message.
+  captureInProgress(params, irsend.capture, irsend.capture.rawlen - 3);
+  EXPECT_FALSE(irrecv.decodeEarly(&results));
+  // The entire message, except the trailing gap, has arrived.
+  captureInProgress(params, irsend.capture, irsend.capture.rawlen - 2);
+  ASSERT_TRUE(irrecv.decodeEarly(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(kNECBits, results.bits);
+  EXPECT_EQ(0x807FC03F, results.value);
+  // It started capturing afresh.
+  EXPECT_EQ(kIdleState, params->rcvstate);
+  EXPECT_EQ(0, params->rawlen);
+
+  // Junk is only tried once, and is left for decode() to deal with.
+  irsend.reset();
+  irsend.sendRaw(kRawJunk, 8, 38);
+  irsend.makeDecodeResult();
+  captureInProgress(params, irsend.capture, irsend.capture.rawlen - 2);
+  EXPECT_FALSE(irrecv.decodeEarly(&results));
+  EXPECT_EQ(kMarkState, params->rcvstate);
+  EXPECT_FALSE(irrecv.decodeEarly(&results));
+  params->rcvstate = kStopState;  // The timeout has happened.
+  ASSERT_TRUE(irrecv.decodeEarly(&results));
+  EXPECT_EQ(UNKNOWN, results.decode_type);
+}
+
+#if ENABLE_BUDGETED_DECODE
+TEST(TestDecode, DecodeBudget) {
   IRsendTest irsend(0);
   IRrecv irrecv(1);
+  volatile irparams_t *params = irrecv._params;
   irsend.begin();
+  irrecv.enableIRIn();
+  irsend.reset();
+  irsend.sendSony(irsend.encodeSony(kSony12Bits, 0x15, 0x1), kSony12Bits);
+  irsend.makeDecodeResult();
+  uint16_t sony = 0;  // Nr. of protocols tried up to & including Sony.
+  while (kDecodeOrder[sony++] != SONY) {}
+
+  // No budget to speak of. One protocol is tried per call, & each carries
+  // on from the one after the last.
+  params->rcvstate = kStopState;
+  EXPECT_FALSE(irrecv.isDecoding());
+  uint16_t calls = 1;
+  while (!irrecv.decodeBudget(&irsend.capture, 0)) {
+    ASSERT_TRUE(irrecv.isDecoding());
+    EXPECT_EQ(kStopState, params->rcvstate);  // The capture is kept.
+    ASSERT_LT(calls++, kDecodeOrderLength);
+  }
+  EXPECT_FALSE(irrecv.isDecoding());
+  EXPECT_EQ(sony, calls);
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_EQ(kSony12Bits, irsend.capture.bits);
+  EXPECT_EQ(0x15, irsend.capture.command);
 
-  uint16_t equal_encoded_raw[11] = {500,  1500, 1500, 500, 499, 1499,
-                                    1501, 501,  1499, 490, 500};
-  match_result_t result;
+  // Plenty of budget. It is done in one.
+  ASSERT_TRUE(irrecv.decodeBudget(&irsend.capture, 1000000));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_FALSE(irrecv.isDecoding());
 
-  ASSERT_EQ(kTolerance, irrecv.getTolerance());
-  irrecv.setTolerance();
-  ASSERT_EQ(kTolerance, irrecv.getTolerance());
-  irrecv.setTolerance(kTolerance + 1);
-  ASSERT_EQ(kTolerance + 1, irrecv.getTolerance());
-  irrecv.setTolerance(kTolerance - 1);
-  ASSERT_EQ(kTolerance - 1, irrecv.getTolerance());
+  // decode() finishes one that is part way through.
+  EXPECT_FALSE(irrecv.decodeBudget(&irsend.capture, 0));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_FALSE(irrecv.isDecoding());
 
-  irrecv.setTolerance();
-  ASSERT_EQ(kTolerance, irrecv.getTolerance());
+  // resume() abandons it.
+  EXPECT_FALSE(irrecv.decodeBudget(&irsend.capture, 0));
+  EXPECT_TRUE(irrecv.isDecoding());
+  irrecv.resume();
+  EXPECT_FALSE(irrecv.isDecoding());
+  EXPECT_EQ(kIdleState, params->rcvstate);
 
+#if DECODE_HASH
+  // Junk is tried with every protocol, then hashed.
   irsend.reset();
-  irsend.sendRaw(equal_encoded_raw, 11, 38000);
+  irsend.sendRaw(kRawJunk, 8, 38);
   irsend.makeDecodeResult();
-  result = irrecv.matchData(irsend.capture.rawbuf + 1, 5, 1500, 500, 500, 1500);
-  ASSERT_TRUE(result.success);
-  EXPECT_EQ(0b01011, result.data);
-  EXPECT_EQ(10, result.used);
+  for (calls = 1; !irrecv.decodeBudget(&irsend.capture, 0); calls++)
+    ASSERT_LT(calls, kDecodeOrderLength + 1);
+  EXPECT_EQ(kDecodeOrderLength + 1, calls);
+  EXPECT_EQ(UNKNOWN, irsend.capture.decode_type);
+#endif  // DECODE_HASH
+}
+#endif  // ENABLE_BUDGETED_DECODE
 
-  irrecv.setTolerance(0);
-  ASSERT_EQ(0, irrecv.getTolerance());
+TEST(TestDecode, DecodeAll) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  decode_candidate_t candidates[kMaxDecodeCandidates];
+  irsend.begin();
+  // Pioneer messages are two NEC messages, so NEC matches it too.
   irsend.reset();
-  irsend.sendRaw(equal_encoded_raw, 11, 38000);
+  irsend.sendPioneer(irsend.encodePioneer(0x659A, 0x0001));
   irsend.makeDecodeResult();
-  result = irrecv.matchData(irsend.capture.rawbuf + 1, 5, 1500, 500, 500, 1500);
-  ASSERT_FALSE(result.success);
+  candidates[0].result = irsend.capture;
+  ASSERT_EQ(3, irrecv.decodeAll(candidates));
+  EXPECT_EQ(PIONEER, candidates[0].result.decode_type);
+  EXPECT_EQ(kPioneerBits, candidates[0].result.bits);
+  EXPECT_EQ(100, candidates[0].coverage);
+  EXPECT_EQ(NEC, candidates[1].result.decode_type);
+  EXPECT_EQ(50, candidates[1].coverage);  // Only the first of the two.
+  EXPECT_GT(candidates[0].score, candidates[1].score);
+  EXPECT_EQ(NEC_LIKE, candidates[2].result.decode_type);
+  EXPECT_EQ(candidates[1].score, candidates[2].score);
+  for (uint8_t i = 0; i < 3; i++)  // They all share the same capture.
+    EXPECT_EQ(irsend.capture.rawbuf, candidates[i].result.rawbuf);
+  // Nothing was left disabled afterwards.
+  EXPECT_TRUE(irrecv.isProtocolEnabled(PIONEER));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(NEC));
+  EXPECT_TRUE(irrecv.isProtocolEnabled(UNKNOWN));
+
+  // Epson is NEC with repeats.
+  irsend.reset();
+  irsend.sendEpson(0xC1AA09F6);
+  irsend.makeDecodeResult();
+  candidates[0].result = irsend.capture;
+  ASSERT_EQ(2, irrecv.decodeAll(candidates, 2));  // Only room for two.
+  EXPECT_EQ(EPSON, candidates[0].result.decode_type);
+  EXPECT_EQ(0xC1AA09F6, candidates[0].result.value);
+  EXPECT_EQ(NEC, candidates[1].result.decode_type);
+  EXPECT_GT(candidates[0].score, candidates[1].score);
+
+  // A clean message has a better fit than a sloppy one.
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  candidates[0].result = irsend.capture;
+  ASSERT_EQ(2, irrecv.decodeAll(candidates));  // NEC & NEC_LIKE.
+  const uint8_t clean = candidates[0].error;
+  for (uint16_t i = 3; i < irsend.capture.rawlen - 1; i += 2)
+    irsend.capture.rawbuf[i] = irsend.capture.rawbuf[i] * 5 / 4;  // +25%
+  candidates[0].result = irsend.capture;
+  ASSERT_EQ(2, irrecv.decodeAll(candidates));
+  EXPECT_EQ(NEC, candidates[0].result.decode_type);
+  EXPECT_GT(candidates[0].error, clean);
+
+  // Junk is only ever UNKNOWN.
+  irsend.reset();
+  irsend.sendRaw(kRawJunk, 8, 38);
+  irsend.makeDecodeResult();
+  candidates[0].result = irsend.capture;
+  ASSERT_EQ(1, irrecv.decodeAll(candidates));
+  EXPECT_EQ(UNKNOWN, candidates[0].result.decode_type);
+  irrecv.disableProtocol(UNKNOWN);
+  candidates[0].result = irsend.capture;
+  EXPECT_EQ(0, irrecv.decodeAll(candidates));
 }
 
 TEST(TestDecode, SkippingInDecode) {
@@ -1590,6 +3615,54 @@ TEST(TestCrudeNoiseFilter, NoiseAtEndOfSample) {
       resultToSourceCode(&irsend.capture));
 }
 
+// The original (buffer shuffling) version of crudeNoiseFilter() to compare to.
+uint16_t referenceNoiseFilter(uint16_t *buf, uint16_t rawlen,
+                              const uint16_t bufsize, const uint16_t floor) {
+  const uint16_t tick_floor = floor / kRawTick;
+  uint16_t offset = kStartOffset;
+  while (offset < rawlen && offset + 2 < bufsize) {
+    uint16_t curr = buf[offset];
+    uint16_t addition = curr + buf[offset + 1];
+    if (curr < tick_floor) {
+      for (uint16_t i = offset + 2; i <= rawlen && i < bufsize; i++)
+        buf[i - 2] = buf[i];
+      if (offset > 1) buf[offset - 1] += addition;
+      rawlen -= 2;
+    } else {
+      offset++;
+    }
+  }
+  return rawlen;
+}
+
+TEST(TestCrudeNoiseFilter, SameAsShufflingVersion) {
+  const uint16_t kSize = 600;
+  IRrecv irrecv(1, kSize);
+  uint16_t buf[kSize];
+  uint16_t expected[kSize];
+  decode_results results;
+  results.rawbuf = buf;
+  uint32_t seed = 1;
+  for (uint8_t run = 0; run < 20; run++) {
+    const uint16_t rawlen = kSize - 1 - run * 17;
+    for (uint16_t i = 0; i < kSize; i++) {
+      seed = seed * 1103515245 + 12345;  // Any old pseudo random numbers.
+      // A mix of normal durations & noise. Some runs even have noise at the
+      // very start & end of the buffer.
+      buf[i] = (seed >> 16) % ((seed >> 8) % 3 ? 2000 : 60);
+    }
+    buf[rawlen] = 0;
+    for (uint16_t i = 0; i < kSize; i++) expected[i] = buf[i];
+    const uint16_t expected_len = referenceNoiseFilter(expected, rawlen, kSize,
+                                                       run * 10);
+    results.rawlen = rawlen;
+    irrecv.crudeNoiseFilter(&results, run * 10);
+    ASSERT_EQ(expected_len, results.rawlen) << "Run " << (int)run;
+    for (uint16_t i = 0; i <= expected_len && i < kSize; i++)
+      ASSERT_EQ(expected[i], buf[i]) << "Run " << (int)run << " i " << i;
+  }
+}
+
 TEST(TestManchesterCode, matchManchester) {
   IRsendTest irsend(0);
   IRrecv irrecv(0);
@@ -1908,3 +3981,1028 @@ TEST(TestMatchManchesterData, SimulateLongFooter) {
   EXPECT_EQ("f38000d50m1000s2000m1000s1000m2000s5000",
             irsend.outputStr());
 }
+
+TEST(TestDecodePulseDistance, Table) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  const pulse_distance_t protocols[] = {
+      {decode_type_t::NIKAI, 24, 4000, 4000, 500, 1000, 500, 2000, 500, 8500,
+       38, 33, true, kNoRepeat},
+      {decode_type_t::INAX, 16, 9000, 4500, 560, 1675, 560, 560, 560, 40000,
+       38, 50, false, kNoRepeat},
+      {decode_type_t::SHARP, 12, 0, 0, 260, 1820, 260, 780, 260, 43602,
+       38, 33, true, kNoRepeat}};
+
+  for (uint8_t i = 0; i < 3; i++) {
+    irsend.reset();
+    irsend.sendPulseDistance(&protocols[i], 0xA5C, protocols[i].nbits, 0);
+    irsend.makeDecodeResult();
+    ASSERT_TRUE(irrecv.decodePulseDistances(&irsend.capture, kStartOffset,
+                                            protocols, 3));
+    EXPECT_EQ(protocols[i].protocol, irsend.capture.decode_type);
+    EXPECT_EQ(protocols[i].nbits, irsend.capture.bits);
+    EXPECT_EQ(0xA5C, irsend.capture.value);
+  }
+  // A single descriptor, at a non-standard size.
+  irsend.reset();
+  irsend.sendPulseDistance(&protocols[1], 0x3F, 8, 0);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodePulseDistance(&irsend.capture, kStartOffset,
+                                          &protocols[1], 8));
+  ASSERT_TRUE(irrecv.decodePulseDistance(&irsend.capture, kStartOffset,
+                                         &protocols[1], 8, false));
+  EXPECT_EQ(0x3F, irsend.capture.value);
+  EXPECT_EQ(8, irsend.capture.bits);
+  EXPECT_EQ(
+      "f38000d50"
+      "m9000s4500"
+      "m560s1675m560s1675m560s1675m560s1675m560s1675m560s1675m560s560m560s560"
+      "m560s40000",
+      irsend.outputStr());
+  // Nothing in the table matches.
+  irsend.reset();
+  irsend.sendNEC(0x12345678);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodePulseDistances(&irsend.capture, kStartOffset,
+                                           protocols, 3));
+}
+
+TEST(TestMatchSections, SendAndMatch) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  const irutils::checksum_t checksums[] = {
+      {irutils::kSumBytesChecksum, 0, 3, 0},
+      {irutils::kXorBytesChecksum, 3, irutils::kChecksumToEnd, 0}};
+  const uint8_t sizes[] = {3};
+  const ac_sections_t frame = {3000, 1500, 400, 1200, 400, 400, 400, 10000,
+                               38, 50, false, sizes, 2, checksums, 2};
+  uint8_t good[6] = {0x01, 0x02, 0x03, 0x10, 0x20, 0x30};
+
+  irutils::setChecksums(checksums, 2, good, 6);
+  EXPECT_EQ(0x03, good[2]);
+  EXPECT_EQ(0x30, good[5]);
+  irsend.reset();
+  irsend.sendSections(&frame, good, 6);
+  EXPECT_EQ(
+      "f38000d50"
+      "m3000s1500"
+      "m400s1200m400s400m400s400m400s400m400s400m400s400m400s400m400s400"
+      "m400s400m400s1200m400s400m400s400m400s400m400s400m400s400m400s400"
+      "m400s1200m400s1200m400s400m400s400m400s400m400s400m400s400m400s400"
+      "m400s10000"
+      "m3000s1500"
+      "m400s400m400s400m400s400m400s400m400s1200m400s400m400s400m400s400"
+      "m400s400m400s400m400s400m400s400m400s400m400s1200m400s400m400s400"
+      "m400s400m400s400m400s400m400s400m400s1200m400s1200m400s400m400s400"
+      "m400s10000",
+      irsend.outputStr());
+  irsend.reset();
+  irsend.sendSections(&frame, good, 6);
+  irsend.makeDecodeResult();
+  uint8_t state[6] = {0};
+  EXPECT_EQ(2 * (2 + 2 * 24 + 2),
+            irrecv.matchSections(irsend.capture.rawbuf + kStartOffset, state,
+                                 irsend.capture.rawlen - kStartOffset, 6,
+                                 &frame));
+  EXPECT_STATE_EQ(good, state, 48);
+
+  // A bad checksum in the first section.
+  uint8_t bad[6] = {0x01, 0x02, 0x04, 0x10, 0x20, 0x30};
+  irsend.reset();
+  irsend.sendSections(&frame, bad, 6);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(0, irrecv.matchSections(irsend.capture.rawbuf + kStartOffset,
+                                    state,
+                                    irsend.capture.rawlen - kStartOffset, 6,
+                                    &frame));
+  EXPECT_EQ(2 * (2 + 2 * 24 + 2),
+            irrecv.matchSections(irsend.capture.rawbuf + kStartOffset, state,
+                                 irsend.capture.rawlen - kStartOffset, 6,
+                                 &frame, false));
+  EXPECT_STATE_EQ(bad, state, 48);
+  // Too short for all of the sections.
+  irsend.reset();
+  irsend.sendSections(&frame, good, 2);
+  EXPECT_EQ("", irsend.outputStr());
+}
+
+TEST(TestMinRawEntries, NoLongerThanARealMessage) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  EXPECT_EQ(0, IRrecv::minRawEntries(decode_type_t::UNKNOWN));
+  EXPECT_EQ(0, IRrecv::minRawEntries(decode_type_t::NEC));  // Repeat codes.
+  EXPECT_EQ(0, IRrecv::minRawEntries(decode_type_t::RC5));  // Manchester.
+  EXPECT_EQ(2 * kSony12Bits - 1, IRrecv::minRawEntries(decode_type_t::SONY));
+  for (int16_t i = 0; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    const uint16_t min = IRrecv::minRawEntries(protocol);
+    if (!min) continue;
+    // i.e. The size of message the entry was calculated from, at least.
+    const uint16_t nbits = std::max(IRsend::defaultBits(protocol),
+                                    (uint16_t)((min + 1) / 2));
+    irsend.reset();
+    if (hasACState(protocol)) {
+      uint8_t state[kStateSizeMax] = {0};
+      ASSERT_TRUE(irsend.send(protocol, state, (nbits + 7) / 8));
+    } else {
+      ASSERT_TRUE(irsend.send(protocol, (uint64_t)0, nbits));
+    }
+    irsend.makeDecodeResult();
+    // The capture won't include the gap after the message.
+    EXPECT_LE(min, irsend.capture.rawlen - kStartOffset - 1)
+        << typeToString(protocol);
+  }
+}
+
+TEST(TestCountBits, VariantsByLength) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendLG(0x4B4AE51, kLgBits);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(kLgBits, irrecv._countBits(&irsend.capture,
+                                       kStartOffset + kHeader));
+  irsend.reset();
+  irsend.sendLG(0xB4B4AE51, kLg32Bits);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(kLg32Bits, irrecv._countBits(&irsend.capture,
+                                         kStartOffset + kHeader));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(LG, irsend.capture.decode_type);
+  EXPECT_EQ(kLg32Bits, irsend.capture.bits);
+
+  // Only the first section of a Samsung36 message.
+  irsend.reset();
+  irsend.sendSamsung36(0x400E00FF);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(16, irrecv._countBits(&irsend.capture, kStartOffset + kHeader));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SAMSUNG36, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendMitsubishi2(0xF82);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(kMitsubishiBits / 2,
+            irrecv._countBits(&irsend.capture, kStartOffset + kHeader));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(MITSUBISHI2, irsend.capture.decode_type);
+
+  // Nothing past the end of the capture.
+  EXPECT_EQ(0, irrecv._countBits(&irsend.capture, irsend.capture.rawlen));
+}
+
+TEST(TestCountBits, NecFamilyShape) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(1, irrecv._countBlocks(&irsend.capture, kStartOffset, kNECBits));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendCarrierAC(0x4CCA541D);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(3, irrecv._countBlocks(&irsend.capture, kStartOffset,
+                                   kCarrierAcBits));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(CARRIER_AC, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendPioneer(0x659A05FAF50AC53A);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(2, irrecv._countBlocks(&irsend.capture, kStartOffset,
+                                   kPioneerBits / 2));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(PIONEER, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendEpson(0x8322EE11);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(3, irrecv._countBlocks(&irsend.capture, kStartOffset, kEpsonBits));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(EPSON, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendSanyoLC7461(0x2468DCB56A9);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SANYO_LC7461, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendAiwaRCT501(0x7F);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(AIWA_RC_T501, irsend.capture.decode_type);
+
+  // No bits to go by, so just the one block.
+  EXPECT_EQ(1, irrecv._countBlocks(&irsend.capture, kStartOffset, 0));
+
+#if ENABLE_NEC_FAMILY_DISPATCH && ENABLE_DECODE_PROFILING
+  // A plain NEC message rules out the rest of the family without trying them.
+  ASSERT_TRUE(irrecv.enableDecodeProfiling());
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(AIWA_RC_T501)->rejects);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(SANYO_LC7461)->rejects);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(EPSON)->rejects);
+#endif  // ENABLE_NEC_FAMILY_DISPATCH && ENABLE_DECODE_PROFILING
+}
+
+TEST(TestStatePool, SlimAndExpand) {
+  // Everything is enabled for the tests, so the largest state is Hitachi's.
+  EXPECT_EQ(kHitachiAc2StateLength, kStateSizeMax);
+  EXPECT_LT(sizeof(slim_results_t), sizeof(decode_results));
+
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  decode_state_pool pool(1);
+  ASSERT_EQ(1, pool.getSlots());
+  EXPECT_EQ(1, pool.getFree());
+
+  // A simple message doesn't need a slot.
+  decode_results nec;
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  slim_results_t slim_nec;
+  ASSERT_TRUE(pool.slim(&irsend.capture, &slim_nec));
+  EXPECT_EQ(kNoStateSlot, slim_nec.slot);
+  EXPECT_EQ(1, pool.getFree());
+
+  // An A/C message does.
+  const uint8_t state[kKelvinatorStateLength] = {
+      0x19, 0x0B, 0x80, 0x50, 0x00, 0x00, 0x00, 0xE0,
+      0x19, 0x0B, 0x80, 0x70, 0x00, 0x00, 0x10, 0xF0};
+  irsend.reset();
+  irsend.sendKelvinator(state);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(KELVINATOR, irsend.capture.decode_type);
+  slim_results_t slim_ac;
+  ASSERT_TRUE(pool.slim(&irsend.capture, &slim_ac));
+  EXPECT_EQ(0, slim_ac.slot);
+  EXPECT_EQ(0, pool.getFree());
+  // The pool is full, so another one can't be slimmed.
+  slim_results_t slim_full;
+  EXPECT_FALSE(pool.slim(&irsend.capture, &slim_full));
+
+  // They expand back to what was decoded, & free the slot.
+  decode_results results;
+  ASSERT_TRUE(pool.expand(&slim_ac, &results));
+  EXPECT_EQ(KELVINATOR, results.decode_type);
+  EXPECT_EQ(kKelvinatorBits, results.bits);
+  EXPECT_STATE_EQ(state, results.state, kKelvinatorBits);
+  EXPECT_EQ(0, results.rawlen);
+  EXPECT_EQ(kNoStateSlot, slim_ac.slot);
+  EXPECT_EQ(1, pool.getFree());
+  ASSERT_TRUE(pool.expand(&slim_nec, &nec));
+  EXPECT_EQ(NEC, nec.decode_type);
+  EXPECT_EQ(0x807FC03F, nec.value);
+  EXPECT_EQ(kNECBits, nec.bits);
+
+  // Releasing frees its slot too.
+  ASSERT_TRUE(pool.slim(&irsend.capture, &slim_ac));
+  EXPECT_EQ(0, pool.getFree());
+  pool.release(&slim_ac);
+  EXPECT_EQ(1, pool.getFree());
+  // A slot it no longer owns can't be expanded.
+  slim_ac.slot = 0;
+  EXPECT_FALSE(pool.expand(&slim_ac, &results));
+}
+
+TEST(TestMatchRepeat, BitsAndBytes) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  // Two copies of a message (bits), then a different one.
+  irsend.reset();
+  irsend.sendGeneric(8000, 4000, 500, 1500, 500, 500, 500, 20000,
+                     0xA5C3, 16, 38, true, 1, kDutyDefault);
+  irsend.sendGeneric(8000, 4000, 500, 1500, 500, 500, 500, 20000,
+                     0xA5C2, 16, 38, true, 0, kDutyDefault);
+  irsend.makeDecodeResult();
+  volatile uint16_t *ptr = irsend.capture.rawbuf + kStartOffset;
+  uint16_t remaining = irsend.capture.rawlen - kStartOffset;
+  uint64_t data = 0;
+  uint16_t used = irrecv.matchGeneric(ptr, &data, remaining, 16,
+                                      8000, 4000, 500, 1500, 500, 500,
+                                      500, 20000, true);
+  ASSERT_EQ(2 * 16 + 4, used);
+  EXPECT_EQ(0xA5C3, data);
+  EXPECT_EQ(used, irrecv.matchRepeat(ptr + used, data, remaining - used, 16,
+                                     8000, 4000, 500, 1500, 500, 500,
+                                     500, 20000, true));
+  // LSB first order.
+  EXPECT_EQ(used, irrecv.matchRepeat(ptr + used, 0xC3A5, remaining - used,
+                                     16, 8000, 4000, 500, 1500, 500, 500,
+                                     500, 20000, true, kUseDefTol,
+                                     kMarkExcess, false));
+  // The third copy differs in the last bit.
+  EXPECT_EQ(0, irrecv.matchRepeat(ptr + 2 * used, data,
+                                  remaining - 2 * used, 16,
+                                  8000, 4000, 500, 1500, 500, 500,
+                                  500, 20000, true));
+  EXPECT_EQ(used, irrecv.matchRepeat(ptr + 2 * used, (uint64_t)0xA5C2,
+                                     remaining - 2 * used, 16,
+                                     8000, 4000, 500, 1500, 500, 500,
+                                     500, 20000, true));
+  // Not enough left for a copy.
+  EXPECT_EQ(0, irrecv.matchRepeat(ptr + 2 * used, (uint64_t)0xA5C2, 10, 16,
+                                  8000, 4000, 500, 1500, 500, 500,
+                                  500, 20000, true));
+
+  // Bytes.
+  const uint8_t state[3] = {0x12, 0x34, 0x56};
+  const uint8_t other[3] = {0x12, 0x34, 0x57};
+  irsend.reset();
+  irsend.sendGeneric(8000, 4000, 500, 1500, 500, 500, 500, 20000,
+                     state, 3, 38, false, 1, kDutyDefault);
+  irsend.makeDecodeResult();
+  ptr = irsend.capture.rawbuf + kStartOffset;
+  remaining = irsend.capture.rawlen - kStartOffset;
+  used = 2 * 24 + 4;
+  EXPECT_EQ(used, irrecv.matchRepeat(ptr, state, remaining, 24,
+                                     8000, 4000, 500, 1500, 500, 500,
+                                     500, 20000, true, kUseDefTol,
+                                     kMarkExcess, false));
+  EXPECT_EQ(used, irrecv.matchRepeat(ptr + used, state, remaining - used, 24,
+                                     8000, 4000, 500, 1500, 500, 500,
+                                     500, 20000, true, kUseDefTol,
+                                     kMarkExcess, false));
+  EXPECT_EQ(0, irrecv.matchRepeat(ptr, other, remaining, 24,
+                                  8000, 4000, 500, 1500, 500, 500,
+                                  500, 20000, true, kUseDefTol,
+                                  kMarkExcess, false));
+  // Wrong bit order.
+  EXPECT_EQ(0, irrecv.matchRepeat(ptr, state, remaining, 24,
+                                  8000, 4000, 500, 1500, 500, 500,
+                                  500, 20000, true));
+}
+
+// Tests of capturing via the interrupt handlers, through a simulated channel.
+TEST(TestSimulatedChannel, PerfectChannel) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  // Sending takes ~108ms, so the clock wraps part way through the message.
+  _IRtimer_unittest_now = UINT32_MAX - 150000;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  irsend.sendNEC(0x807F40BF);
+  const uint32_t start = channel.now();  // Once it has all been sent.
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  EXPECT_FALSE(results.overflow);
+  EXPECT_EQ(kNECBits * 2 + 4, results.rawlen);
+  EXPECT_EQ(1, results.rawbuf[0]);  // The dummy entry.
+  EXPECT_EQ(kNecHdrMark / kRawTick, results.rawbuf[1]);
+  EXPECT_EQ(kNecHdrSpace / kRawTick, results.rawbuf[2]);
+  // It started at the first edge, & it took the timeout to notice it ended.
+  EXPECT_EQ(start, results.started);
+  EXPECT_EQ(channel.lastSent() + MS_TO_USEC(kTimeoutMs), results.stopped);
+  EXPECT_EQ(results.stopped, channel.now());
+  EXPECT_EQ(0, channel.pending());
+  irrecv.resume();
+
+  // Nothing else was sent.
+  EXPECT_FALSE(channel.receive(&results, 100000));
+}
+
+TEST(TestSimulatedChannel, LagAndJitter) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  channel.impairments = kTypicalChannel;
+  decode_results results;
+
+  for (uint16_t i = 0; i < 20; i++) {
+    irsend.sendNEC(irsend.encodeNEC(i, 0xFF - i));
+    channel.transmit(&irsend);
+    ASSERT_TRUE(channel.receive(&results));
+    EXPECT_EQ(NEC, results.decode_type);
+    EXPECT_EQ(irsend.encodeNEC(i, 0xFF - i), results.value);
+    // The marks are longer, & the spaces shorter, by the difference in lag.
+    // Give or take the jitter of each edge.
+    EXPECT_NEAR((kNecHdrMark + kMarkExcess) / kRawTick, results.rawbuf[1],
+                20 / kRawTick + 1);
+    EXPECT_NEAR((kNecHdrSpace - kMarkExcess) / kRawTick, results.rawbuf[2],
+                20 / kRawTick + 1);
+    irrecv.resume();
+  }
+
+  // Too much lag for the bits to survive.
+  channel.impairments.off_lag = 600;
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_NE(NEC, results.decode_type);
+  irrecv.resume();
+}
+
+TEST(TestSimulatedChannel, SignalQuality) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  // Off by default.
+  EXPECT_FALSE(irrecv.getSignalQuality());
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0, results.quality.entries);
+  irrecv.resume();
+
+  // A typical channel fits well.
+  channel.impairments = kTypicalChannel;
+  irrecv.setSignalQuality();
+  EXPECT_TRUE(irrecv.getSignalQuality());
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_LE(kNECBits * 2, results.quality.entries);
+  const uint8_t typical_mean = results.quality.mean;
+  EXPECT_GT(20, typical_mean);
+  EXPECT_GT(kNearTolerance, results.quality.max);
+  EXPECT_EQ(0, results.quality.near);
+  irrecv.resume();
+
+  // Lag & jitter make it a worse fit, but it still decodes.
+  channel.impairments.off_lag = 170;
+  channel.impairments.jitter = 40;
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_LT(typical_mean, results.quality.mean);
+  EXPECT_LE(results.quality.mean, results.quality.max);
+  EXPECT_LT(0, results.quality.near);
+  EXPECT_GE(results.quality.entries, results.quality.near);
+  irrecv.resume();
+
+  // Nothing to report for a message only the hash decoder matched.
+  const uint16_t raw[5] = {1000, 2000, 3000, 4000, 5000};
+  irsend.sendRaw(raw, 5, 38);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(UNKNOWN, results.decode_type);
+  EXPECT_EQ(0, results.quality.entries);
+  irrecv.resume();
+}
+
+TEST(TestSimulatedChannel, Timeouts) {
+  IRsendTest irsend(0);
+  decode_results results;
+  irsend.begin();
+  _IRtimer_unittest_now = 0;
+  {  // The ~40ms gap after a NEC message is shorter than this timeout.
+    IRrecv irrecv(0, 2 * kRawBuf, 90);
+    irrecv.enableIRIn();
+    SimulatedChannel channel(&irrecv);
+    irsend.sendNEC(0x807F40BF);
+    irsend.sendNEC(0x807F40BF);
+    channel.transmit(&irsend);
+    ASSERT_TRUE(channel.receive(&results));
+    // Two whole NEC messages in a capture is an Epson one.
+    EXPECT_EQ(EPSON, results.decode_type);
+    EXPECT_EQ(2 * (kNECBits * 2 + 4), results.rawlen);
+    EXPECT_EQ(0, channel.pending());
+    irrecv.resume();
+  }
+  {  // & longer than this one.
+    IRrecv irrecv(0);
+    irrecv.enableIRIn();
+    SimulatedChannel channel(&irrecv);
+    irsend.sendNEC(0x807F40BF);
+    irsend.sendNEC(0x807F40BF);
+    channel.transmit(&irsend);
+    ASSERT_TRUE(channel.receive(&results));
+    EXPECT_EQ(NEC, results.decode_type);
+    EXPECT_EQ(kNECBits * 2 + 4, results.rawlen);
+    EXPECT_EQ(kNECBits * 2 + 4, channel.pending());  // The 2nd one's edges.
+    irrecv.resume();
+    ASSERT_TRUE(channel.receive(&results));
+    EXPECT_EQ(NEC, results.decode_type);
+    EXPECT_EQ(0x807F40BF, results.value);
+    irrecv.resume();
+  }
+}
+
+#if ENABLE_GLITCH_FILTER
+TEST(TestSimulatedChannel, GlitchFilter) {
+  IRsendTest irsend(0);
+  // Room for a NEC message, plus a little.
+  IRrecv irrecv(0, kNECBits * 2 + 16);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv, 42);
+  channel.impairments = kTypicalChannel;
+  channel.impairments.noise = 100;  // Lots of it.
+  channel.impairments.glitch = 100;
+  decode_results results;
+
+  EXPECT_EQ(0, irrecv.getGlitchFilter());
+  uint16_t overflows = 0;
+  uint16_t decoded = 0;
+  for (uint16_t i = 0; i < 20; i++) {
+    irsend.sendNEC(irsend.encodeNEC(i, i));
+    channel.transmit(&irsend);
+    while (channel.receive(&results)) {
+      if (results.overflow) overflows++;
+      if (results.decode_type == NEC && results.value ==
+          irsend.encodeNEC(i, i))
+        decoded++;
+      irrecv.resume();
+      if (!channel.pending()) break;
+    }
+  }
+  // The noise fills up the buffer.
+  EXPECT_LT(0, overflows);
+  EXPECT_EQ(0, decoded);
+
+  irrecv.setGlitchFilter(150);
+  EXPECT_EQ(150, irrecv.getGlitchFilter());
+  uint16_t captures = 0;
+  overflows = 0;
+  for (uint16_t i = 0; i < 20; i++) {
+    irsend.sendNEC(irsend.encodeNEC(i, i));
+    channel.transmit(&irsend);
+    while (channel.receive(&results)) {
+      captures++;
+      if (results.overflow) overflows++;
+      if (results.decode_type == NEC && results.value ==
+          irsend.encodeNEC(i, i))
+        decoded++;
+      irrecv.resume();
+      if (!channel.pending()) break;
+    }
+  }
+  // Glitches in the gaps no longer start captures of their own, & the ones in
+  // the messages are merged away. Those too close to an edge can still take
+  // part of a real mark or space with them, so not every message decodes.
+  EXPECT_EQ(0, overflows);
+  EXPECT_EQ(20, captures);
+  EXPECT_LT(5, decoded);
+
+  irrecv.setGlitchFilter(0);
+  EXPECT_EQ(0, irrecv.getGlitchFilter());
+}
+#endif  // ENABLE_GLITCH_FILTER
+
+#if ENABLE_ADAPTIVE_TIMEOUT
+TEST(TestSimulatedChannel, AdaptiveTimeout) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0, 1024, 90);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  // Off by default. It waits for the whole timeout.
+  irsend.sendSAMSUNG(0xE0E09966);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(SAMSUNG, results.decode_type);
+  EXPECT_EQ(channel.lastSent() + MS_TO_USEC(90), results.stopped);
+  irrecv.resume();
+
+  irrecv.enableAdaptiveTimeout();
+  // A header without long gaps only waits for the short gap.
+  irsend.sendSAMSUNG(0xE0E09966);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(SAMSUNG, results.decode_type);
+  EXPECT_EQ(0xE0E09966, results.value);
+  EXPECT_EQ(channel.lastSent() + MS_TO_USEC(kTimeoutMs), results.stopped);
+  irrecv.resume();
+
+  // A ~30ms gap between the sections of a Daikin216 message. It is still
+  // captured whole, & the capture ends after that gap plus a margin.
+  const uint8_t daikin[kDaikin216StateLength] = {
+      0x11, 0xDA, 0x27, 0xF0, 0x00, 0x00, 0x00, 0x02,
+      0x11, 0xDA, 0x27, 0x00, 0x00, 0x00, 0x26, 0x00, 0xA0, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x98};
+  irsend.sendDaikin216(daikin);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(DAIKIN216, results.decode_type);
+  EXPECT_STATE_EQ(daikin, results.state, kDaikin216Bits);
+  EXPECT_EQ(channel.lastSent() + MS_TO_USEC(38), results.stopped);
+  irrecv.resume();
+
+  // Never longer than the timeout.
+  irrecv.enableAdaptiveTimeout(200);
+  irsend.sendSAMSUNG(0xE0E09966);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(channel.lastSent() + MS_TO_USEC(90), results.stopped);
+  irrecv.resume();
+
+  irrecv.disableAdaptiveTimeout();
+  irsend.sendSAMSUNG(0xE0E09966);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(channel.lastSent() + MS_TO_USEC(90), results.stopped);
+  irrecv.resume();
+}
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+
+TEST(TestSimulatedChannel, Overflow) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0, 20);  // Too small for a NEC message.
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  channel.receive(&results);
+  // It stopped as soon as it was full. i.e. Well before the end.
+  EXPECT_LT(channel.now(), channel.lastSent());
+  EXPECT_TRUE(results.overflow);
+  EXPECT_EQ(20, results.rawlen);
+  irrecv.resume();
+}
+
+#if ENABLE_PARTIAL_DECODE
+TEST(TestSimulatedChannel, PartialDecode) {
+  IRsendTest irsend(0);
+  // Holds the first section of a Daikin216, but not both of them.
+  IRrecv irrecv(0, 200, 50);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+  const uint8_t daikin[kDaikin216StateLength] = {
+      0x11, 0xDA, 0x27, 0xF0, 0x00, 0x00, 0x00, 0x02,
+      0x11, 0xDA, 0x27, 0x00, 0x00, 0x00, 0x26, 0x00, 0xA0, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x98};
+  const uint8_t start[kDaikin216StateLength] = {
+      0x11, 0xDA, 0x27, 0xF0, 0x00, 0x00, 0x00, 0x02};
+
+  // Off by default. An overflowed capture isn't decoded as a Daikin216.
+  EXPECT_FALSE(irrecv.getPartialDecode());
+  irsend.sendDaikin216(daikin);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_TRUE(results.overflow);
+  EXPECT_NE(DAIKIN216, results.decode_type);
+  EXPECT_FALSE(results.truncated);
+  irrecv.resume();
+  while (channel.receive(&results)) irrecv.resume();  // The rest of it.
+
+  irrecv.setPartialDecode();
+  EXPECT_TRUE(irrecv.getPartialDecode());
+  irsend.sendDaikin216(daikin);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_TRUE(results.overflow);
+  EXPECT_EQ(DAIKIN216, results.decode_type);
+  EXPECT_TRUE(results.truncated);
+  EXPECT_EQ(kDaikin216Section1Length * 8, results.bits);
+  EXPECT_STATE_EQ(start, results.state, kDaikin216Bits);
+  irrecv.resume();
+  while (channel.receive(&results)) irrecv.resume();
+
+  // A capture that isn't overflowed is never truncated.
+  IRrecv big(1, 1024, 50);
+  big.enableIRIn();
+  big.setPartialDecode();
+  SimulatedChannel whole(&big);
+  irsend.sendDaikin216(daikin);
+  whole.transmit(&irsend);
+  ASSERT_TRUE(whole.receive(&results));
+  EXPECT_FALSE(results.overflow);
+  EXPECT_EQ(DAIKIN216, results.decode_type);
+  EXPECT_FALSE(results.truncated);
+  EXPECT_EQ(kDaikin216Bits, results.bits);
+  EXPECT_STATE_EQ(daikin, results.state, kDaikin216Bits);
+}
+
+#if ENABLE_CAPTURE_RING
+TEST(TestSimulatedChannel, PartialDecodeStitched) {
+  IRsendTest irsend(0);
+  // Exactly the leader & first section of a Daikin2, up to its footer mark.
+  IRrecv irrecv(0, kStartOffset + kHeader + 2 * kDaikin2Section1Length * 8 +
+                   kHeader + kFooter - 1, 50);
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableCaptureRing(3));
+  irrecv.enableIRIn();
+  irrecv.setPartialDecode();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+  const uint8_t daikin[kDaikin2StateLength] = {
+      0x11, 0xDA, 0x27, 0x00, 0x01, 0x7A, 0xC3, 0x70, 0x28, 0x0C,
+      0x80, 0x04, 0xB0, 0x16, 0x24, 0x00, 0x00, 0xBE, 0xD5, 0xF5,
+      0x11, 0xDA, 0x27, 0x00, 0x00, 0x08, 0x26, 0x00, 0xA0, 0x00,
+      0x00, 0x06, 0x60, 0x00, 0x00, 0xC1, 0x80, 0x60, 0xE7};
+
+  // The second section carries on in the next slot, & is joined back on.
+  irsend.sendDaikin2(daikin);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_TRUE(results.overflow);
+  EXPECT_EQ(DAIKIN2, results.decode_type);
+  EXPECT_FALSE(results.truncated);
+  EXPECT_EQ(kDaikin2Bits, results.bits);
+  EXPECT_STATE_EQ(daikin, results.state, kDaikin2Bits);
+  irrecv.resume();
+  // Its slot was used up with it.
+  EXPECT_FALSE(irrecv.decode(&results));
+
+  // Without the rest of it, it's only the first section.
+  irrecv.disableIRIn();
+  ASSERT_TRUE(irrecv.enableCaptureRing(2));  // Room for the first part only.
+  irrecv.enableIRIn();
+  irsend.sendDaikin2(daikin);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  EXPECT_EQ(1, irrecv.getCaptureDrops());
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(DAIKIN2, results.decode_type);
+  EXPECT_TRUE(results.truncated);
+  EXPECT_EQ(kDaikin2Section1Length * 8, results.bits);
+  EXPECT_STATE_EQ(daikin, results.state, kDaikin2Section1Length * 8);
+  EXPECT_FALSE(irrecv.decode(&results));
+}
+#endif  // ENABLE_CAPTURE_RING
+#endif  // ENABLE_PARTIAL_DECODE
+
+#if ENABLE_ECHO_SUPPRESSION
+TEST(TestSimulatedChannel, EchoSuppression) {
+  IRsendTest irsend(0);
+  IRsend transmitter(1, false, false);  // Our own, on the same device.
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  // Nothing has been transmitted yet.
+  EXPECT_EQ(0, transmitter.getEcho()->length);
+  // Our transmitter sends a long mark, & its echo is what the receiver sees.
+  irrecv.ignoreEcho(&transmitter);
+  transmitter.mark(50000);
+  EXPECT_EQ(channel.now(), transmitter.getEcho()->from);
+  EXPECT_EQ(50000 + kEchoMargin, transmitter.getEcho()->length);
+  irsend.sendJVC(0xC2B8, kJvcBits, 0);
+  _IRtimer_unittest_now = 0;  // Its "echo" arrives at the same time.
+  channel.transmit(&irsend);
+  EXPECT_FALSE(channel.receive(&results, 50000));  // Not captured.
+  EXPECT_EQ(0, irrecv._params->rawlen);
+
+  // Once we've stopped, anything else is captured as usual.
+  channel.run(100000);
+  irsend.sendJVC(0xC2B8, kJvcBits, 0);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(JVC, results.decode_type);
+  EXPECT_EQ(0xC2B8, results.value);
+  irrecv.resume();
+
+  // Unless we stop ignoring it.
+  irrecv.ignoreEcho(NULL);
+  transmitter.mark(50000);
+  irsend.sendJVC(0xC2B8, kJvcBits, 0);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(JVC, results.decode_type);
+  irrecv.resume();
+}
+#endif  // ENABLE_ECHO_SUPPRESSION
+
+#if ENABLE_IR_MIRROR
+TEST(TestSimulatedChannel, Mirror) {
+  IRsendTest irsend(0);
+  IRsendLowLevelTest mirror(1, false, false);  // Unmodulated.
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  // A modulated mark would need the CPU to make its carrier.
+  IRsendLowLevelTest modulated(2);
+  EXPECT_FALSE(modulated.beginMirror());
+  EXPECT_TRUE(modulated.beginMirror(38000, 100));
+  ASSERT_TRUE(mirror.beginMirror());
+  EXPECT_EQ("[Off]", mirror.low_level_sequence);
+  mirror.reset();
+
+  // Each mark is mirrored as it arrives, & it is still decoded.
+  irrecv.mirrorTo(&mirror);
+  irsend.sendJVC(0xC2B8, kJvcBits, 0);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(JVC, results.decode_type);
+  EXPECT_EQ(0xC2B8, results.value);
+  std::string expected = "";
+  for (uint16_t i = 0; i < kJvcBits + 2; i++) expected += "[On][Off]";
+  EXPECT_EQ(expected, mirror.low_level_sequence);
+  irrecv.resume();
+
+  // It is never left lit. e.g. A missed edge.
+  mirror.reset();
+  irrecv._simulateEdge();
+  EXPECT_EQ("[On]", mirror.low_level_sequence);
+  irrecv._simulateTimeout();
+  EXPECT_EQ("[On][Off]", mirror.low_level_sequence);
+  // Nor when it stops mirroring.
+  irrecv._simulateEdge();
+  irrecv.mirrorTo(NULL);
+  EXPECT_EQ("[On][Off][On][Off]", mirror.low_level_sequence);
+  irrecv._simulateEdge();
+  EXPECT_EQ("[On][Off][On][Off]", mirror.low_level_sequence);
+}
+#endif  // ENABLE_IR_MIRROR
+
+TEST(TestSimulatedChannel, WakeFromSleep) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  decode_results results;
+
+  EXPECT_EQ(kWakeLatency, irrecv.getWakeLatency());
+  irrecv.setWakeLatency(1500);
+  EXPECT_EQ(1500, irrecv.getWakeLatency());
+  // In a unit test, it doesn't sleep. The next message "wakes" it.
+  EXPECT_FALSE(irrecv.sleepUntilIR());
+  EXPECT_EQ(1500, irrecv._params->wake);
+  // We miss the first 1500us of the header mark while waking up.
+  irsend.sendNEC(0x807F40BF);
+  irsend.output[0] -= 1500;
+  const uint32_t start = channel.now();
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  // It was credited back to the header mark.
+  EXPECT_EQ(kNecHdrMark / kRawTick, results.rawbuf[1]);
+  EXPECT_EQ(start - 1500, results.started);
+  EXPECT_EQ(0, irrecv._params->wake);  // Only the once.
+  irrecv.resume();
+  // It won't sleep with a message waiting to be decoded.
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  EXPECT_TRUE(channel.run(200000));
+  EXPECT_FALSE(irrecv.sleepUntilIR());
+  EXPECT_EQ(0, irrecv._params->wake);
+  irrecv.resume();
+
+  // Captured while awake, there's no compensation.
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.receive(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(kNecHdrMark / kRawTick, results.rawbuf[1]);
+  irrecv.resume();
+}
+
+TEST(TestSimulatedChannel, Noise) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv, 42);
+  channel.impairments = kTypicalChannel;
+  channel.impairments.noise = 10;
+  channel.impairments.glitch = 100;
+  decode_results results;
+
+  uint16_t decoded = 0;
+  uint16_t glitched = 0;
+  for (uint16_t i = 0; i < 50; i++) {
+    irsend.sendNEC(irsend.encodeNEC(i, i));
+    channel.transmit(&irsend);
+    // Glitches in the gap after it can start captures of their own.
+    while (channel.receive(&results))  {
+      if (results.decode_type == NEC && results.value ==
+          irsend.encodeNEC(i, i))
+        decoded++;
+      else if (results.rawlen != kNECBits * 2 + 4)
+        glitched++;
+      irrecv.resume();
+      if (!channel.pending()) break;
+    }
+  }
+  // Some, but not all, got through.
+  EXPECT_LT(0, decoded);
+  EXPECT_GT(50, decoded);
+  EXPECT_LT(0, glitched);
+}
+
+#if ENABLE_CUSTOM_BACKENDS
+// Sends straight into an `IRrecv`, as if it was captured. i.e. A send sink &
+// a capture source in one, with a simulated timebase of its own.
+class LoopbackBackend : public IRsendSink, public IRcaptureSource {
+ public:
+  IRrecv *receiver;
+  uint32_t now;  // (uSeconds)
+  uint8_t quiet_ms;  // What the receiver last asked for.
+  uint16_t begins;
+  uint16_t ends;
+  uint16_t polls;
+
+  LoopbackBackend(void) : receiver(NULL), now(1000), quiet_ms(0), begins(0),
+                          ends(0), polls(0) {}
+  void begin(IRrecv *irrecv) {
+    receiver = irrecv;
+    begins++;
+  }
+  void end(IRrecv *irrecv) {
+    (void)irrecv;
+    receiver = NULL;
+    ends++;
+  }
+  // Whatever was sent is over by the time it is decoded.
+  void poll(IRrecv *irrecv) {
+    polls++;
+    now += quiet_ms * 1000;
+    if (quiet_ms) irrecv->captureEnd(now);
+    quiet_ms = 0;
+  }
+  void carrier(const uint32_t hz, const uint8_t duty) { (void)hz, (void)duty; }
+  uint16_t mark(const uint16_t usecs) {
+    if (receiver != NULL) quiet_ms = receiver->captureEdge(now);
+    now += usecs;
+    if (receiver != NULL) quiet_ms = receiver->captureEdge(now);
+    return 1;
+  }
+  void space(const uint32_t usecs) { now += usecs; }
+};
+
+TEST(TestCustomBackends, CaptureSource) {
+  LoopbackBackend backend;  // It has to outlive the IRrecv.
+  IRsend irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  decode_results results;
+  irsend.begin();
+  irsend.setSink(&backend);
+  EXPECT_EQ(NULL, irrecv.getCaptureSource());
+  irrecv.setCaptureSource(&backend);
+  EXPECT_EQ(&backend, irrecv.getCaptureSource());
+  irrecv.enableIRIn();
+  EXPECT_EQ(1, backend.begins);
+  EXPECT_EQ(&irrecv, backend.receiver);
+
+  irsend.sendNEC(0x807FC03F);
+  EXPECT_EQ(kTimeoutMs, backend.quiet_ms);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(1, backend.polls);
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807FC03F, results.value);
+  EXPECT_EQ(kNECBits, results.bits);
+  EXPECT_EQ(1000, results.started);  // In the source's timebase.
+  EXPECT_EQ(backend.now, results.stopped);
+
+  // Nothing more is captured until the last capture has been decoded.
+  irsend.sendNEC(0x807F40BF);
+  backend.poll(&irrecv);  // It has ended.
+  irsend.sendNEC(0x807FC03F);
+  EXPECT_EQ(0, backend.quiet_ms);  // So these edges were ignored.
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+
+  irrecv.disableIRIn();
+  EXPECT_EQ(1, backend.ends);
+  EXPECT_EQ(NULL, backend.receiver);
+}
+#endif  // ENABLE_CUSTOM_BACKENDS
@@ -0,0 +1,165 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRrepeater.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+#include "ir_NEC.h"
+#include "simulated_channel.h"
+
+// Tests for the IRrepeater class.
+
+TEST(TestIRrepeater, StoreAndForward) {
+  IRsendTest irsend(0);  // The original.
+  IRsendTest irout(1);  // The repeat.
+  IRrecv irrecv(0);
+  irsend.begin();
+  irout.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  channel.impairments = kTypicalChannel;
+  IRrepeater repeater(&irrecv, &irout);
+  decode_results results;
+
+  EXPECT_FALSE(repeater.handle(&results));  // Nothing has arrived yet.
+  irsend.sendNEC(0x807F40BF);
+  const uint32_t start = channel.now();
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(repeater.handle(&results));
+  EXPECT_EQ(1, repeater.getRepeated());
+  // It was decoded, for logging.
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  // It was repeated once the receiver's timeout noticed it had ended.
+  EXPECT_NEAR(channel.lastSent() + MS_TO_USEC(kTimeoutMs) - start,
+              repeater.getLatency(), 100);
+  // The receiver's longer marks were corrected for.
+  EXPECT_EQ(kRepeaterDefaultFrequency, repeater.getSequence()->frequency());
+  EXPECT_EQ(kNECBits * 2 + 3, repeater.getSequence()->length());
+  EXPECT_EQ(kNECBits * 2 + 2, irout.last);
+  EXPECT_NEAR(kNecHdrMark, irout.output[0], 25);
+  EXPECT_NEAR(kNecHdrSpace, irout.output[1], 25);
+  EXPECT_NEAR(kNecBitMark, irout.output[2], 25);
+  EXPECT_EQ(kRepeaterDefaultFrequency, irout.freq[0]);
+  // The repeat decodes as the original did.
+  irout.makeDecodeResult();
+  IRrecv decoder(0);
+  ASSERT_TRUE(decoder.decode(&irout.capture));
+  EXPECT_EQ(NEC, irout.capture.decode_type);
+  EXPECT_EQ(0x807F40BF, irout.capture.value);
+  // The receiver is capturing again.
+  EXPECT_EQ(kIdleState, irrecv._params->rcvstate);
+  EXPECT_FALSE(repeater.handle(&results));
+}
+
+TEST(TestIRrepeater, UnknownProtocol) {
+  IRsendTest irsend(0);
+  IRsendTest irout(1);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irout.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  IRrepeater repeater(&irrecv, &irout, 40000);
+  irrecv.setMarkExcess(0);  // A perfect channel.
+
+  // Nothing decodes this, so it is only repeated raw.
+  const uint16_t raw[7] = {3000, 1000, 700, 2300, 1500, 500, 2100};
+  irsend.sendRaw(raw, 7, 40);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(repeater.handle());  // Not decoded at all.
+  ASSERT_EQ(6, irout.last);
+  for (uint16_t i = 0; i < 7; i++) EXPECT_EQ(raw[i], irout.output[i]);
+  EXPECT_EQ(40000, irout.freq[0]);
+
+  // Decoding it, for logging, doesn't stop it being repeated.
+  decode_results results;
+  irout.reset();
+  irsend.sendRaw(raw, 7, 40);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(repeater.handle(&results));
+  EXPECT_EQ(UNKNOWN, results.decode_type);
+  EXPECT_EQ(6, irout.last);
+  EXPECT_EQ(2, repeater.getRepeated());
+}
+
+TEST(TestIRrepeater, CutThrough) {
+  IRsendTest irsend(0);
+  IRsendTest irout(1);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irout.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  IRrepeater repeater(&irrecv, &irout);
+  EXPECT_EQ(0, repeater.getCutThrough());
+  repeater.setCutThrough(15000);
+  EXPECT_EQ(15000, repeater.getCutThrough());
+  decode_results results;
+
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  // Not long enough into the message yet.
+  EXPECT_FALSE(channel.run(10000));
+  EXPECT_FALSE(repeater.handle(&results));
+  EXPECT_EQ(0, irout.output[0]);  // Nothing has been sent.
+  EXPECT_EQ(0, repeater.getRepeated());
+  // It has started repeating before the message has ended.
+  EXPECT_FALSE(channel.run(10000));
+  EXPECT_FALSE(repeater.handle(&results));
+  EXPECT_EQ(1, repeater.getRepeated());
+  EXPECT_EQ(20000, repeater.getLatency());
+  ASSERT_LT(2, irout.last);
+  EXPECT_NEAR(kNecHdrMark, irout.output[0], kMarkExcess + 10);
+  EXPECT_NEAR(kNecHdrSpace, irout.output[1], kMarkExcess + 10);
+  // It finishes once the message has ended.
+  for (uint16_t i = 0; i < 1000 && !repeater.handle(&results); i++)
+    channel.run(1000);
+  EXPECT_EQ(1, repeater.getRepeated());
+  EXPECT_EQ(kIdleState, irrecv._params->rcvstate);
+}
+
+TEST(TestIRrepeater, CutThroughOfCompleteCapture) {
+  IRsendTest irsend(0);
+  IRsendTest irout(1);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irout.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  channel.impairments = kTypicalChannel;
+  IRrepeater repeater(&irrecv, &irout);
+  decode_results results;
+
+  // Messages that have already ended are repeated all at once. The same as
+  // without cut-through.
+  repeater.setCutThrough(15000);
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(repeater.handle(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  EXPECT_EQ(kNECBits * 2 + 2, irout.last);
+  irout.reset();
+
+  repeater.setCutThrough(0);
+  irsend.sendNEC(0x807F40BF);
+  channel.transmit(&irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(repeater.handle(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(kNECBits * 2 + 2, irout.last);
+  EXPECT_EQ(2, repeater.getRepeated());
+}
@@ -1,6 +1,9 @@
 // Copyright 2017,2019 David Conran
 
 #include "IRsend_test.h"
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "IRrecv_test.h"
 #include "IRsend.h"
 #include "IRutils.h"
@@ -71,6 +74,27 @@ TEST(TestSendData, SendOverLargeData) {
       irsend.outputStr());
 }
 
+// Test the bits past nbits are ignored, whatever size the data is sent as.
+TEST(TestSendData, IgnoresBitsPastNbits) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  const uint16_t sizes[] = {1, 7, 8, 9, 31, 32, 33, 63, 64};
+  for (const uint16_t nbits : sizes) {
+    const uint64_t data = 0xA5C3F00F0FF03C5A;
+    const uint64_t mask = (nbits < 64) ? (1ULL << nbits) - 1 : UINT64_MAX;
+    for (const bool msb : {true, false}) {
+      irsend.reset();
+      irsend.sendData(1, 2, 3, 4, data, nbits, msb);
+      const std::string expected = irsend.outputStr();
+      irsend.reset();
+      irsend.sendData(1, 2, 3, 4, data & mask, nbits, msb);
+      EXPECT_EQ(expected, irsend.outputStr()) << nbits << " bits";
+      // One mark & space per bit.
+      EXPECT_EQ(nbits * 4 + 3, expected.size()) << nbits << " bits";
+    }
+  }
+}
+
 // Test inverting the output.
 TEST(TestIRSend, InvertedOutput) {
   IRsendTest irsend(4, true);
@@ -232,6 +256,76 @@ TEST(TestSendRaw, NoTrailingGap) {
   EXPECT_EQ(kNECBits, irsend.capture.bits);
 }
 
+// Test sending a raw message from flash.
+TEST(TestSendRaw, FromProgmem) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  static const uint16_t rawData[6] PROGMEM = {9000, 4500, 650, 550, 650, 1650};
+  irsend.reset();
+  irsend.sendRaw_P(rawData, 6, 38);
+  EXPECT_EQ("f38000d50m9000s4500m650s550m650s1650", irsend.outputStr());
+}
+
+// Test compressing & sending compressed raw messages.
+TEST(TestSendRaw, Compressed) {
+  IRsendTest irsend(4);
+  IRrecv irrecv(4);
+  irsend.begin();
+
+  const uint16_t simple[7] = {9000, 4500, 560, 560, 560, 1690, 560};
+  uint8_t out[20];
+  EXPECT_EQ(15, IRsend::compressRaw(simple, 7, out, sizeof(out)));
+  const uint8_t expected[15] = {
+      4, 0x28, 0x23, 0x94, 0x11, 0x30, 0x02, 0x9A, 0x06,  // Palette
+      7, 0,  // Length
+      0x01, 0x22, 0x23, 0x20};  // Indices
+  for (uint8_t i = 0; i < 15; i++) EXPECT_EQ(expected[i], out[i]);
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendRawCompressed(out, 15, 38));
+  EXPECT_EQ("f38000d50m9000s4500m560s560m560s1690m560", irsend.outputStr());
+  // Too small an output buffer.
+  EXPECT_EQ(0, IRsend::compressRaw(simple, 7, out, 14));
+
+  // NEC C3E0E0E8 as measured in #204
+  uint16_t rawData[67] = {
+      8950, 4500, 550, 1650, 600, 1650, 550, 550,  600, 500,  600, 550,
+      550,  550,  600, 1650, 550, 1650, 600, 1650, 600, 1650, 550, 1700,
+      550,  550,  600, 550,  550, 550,  600, 500,  600, 550,  550, 1650,
+      600,  1650, 600, 1650, 550, 550,  600, 500,  600, 500,  600, 550,
+      550,  550,  600, 1650, 550, 1650, 600, 1650, 600, 500,  650, 1600,
+      600,  500,  600, 550,  550, 550,  600};
+  uint8_t compressed[64];
+  const uint16_t size = IRsend::compressRaw(rawData, 67, compressed,
+                                            sizeof(compressed), 25);
+  EXPECT_EQ(3 + 4 * 2 + 34, size);  // vs. 134 bytes uncompressed.
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendRawCompressed_P(compressed, size, 38));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeNEC(&irsend.capture, kStartOffset, kNECBits, false));
+  EXPECT_EQ(0xC3E0E0E8, irsend.capture.value);
+
+  // Too many different durations.
+  uint16_t varied[kRawCompressedMaxPalette + 1];
+  for (uint8_t i = 0; i <= kRawCompressedMaxPalette; i++)
+    varied[i] = 200 * (i + 1) * (i + 1);  // Always > 10% apart.
+  EXPECT_EQ(0, IRsend::compressRaw(varied, kRawCompressedMaxPalette + 1,
+                                   compressed, sizeof(compressed)));
+  EXPECT_NE(0, IRsend::compressRaw(varied, kRawCompressedMaxPalette,
+                                   compressed, sizeof(compressed)));
+  EXPECT_NE(0, IRsend::compressRaw(varied, kRawCompressedMaxPalette + 1,
+                                   compressed, sizeof(compressed), 100));
+
+  // Invalid data sends nothing.
+  irsend.reset();
+  EXPECT_FALSE(irsend.sendRawCompressed(out, 14, 38));  // Truncated.
+  out[11] = 0xF1;  // Not in the palette.
+  EXPECT_FALSE(irsend.sendRawCompressed(out, 15, 38));
+  out[0] = 0;  // Empty palette.
+  EXPECT_FALSE(irsend.sendRawCompressed(out, 15, 38));
+  EXPECT_FALSE(irsend.sendRawCompressed(NULL, 15, 38));
+  EXPECT_EQ("", irsend.outputStr());
+}
+
 TEST(TestLowLevelSend, MarkFrequencyModulationAt38kHz) {
   IRsendLowLevelTest irsend(0);
 
@@ -785,6 +879,94 @@ TEST(TestSend, defaultBits) {
             ") doesn't have a correct value for it.";
     }
   }
+  EXPECT_EQ(kPanasonicAcBits, IRsend::defaultBits(decode_type_t::PANASONIC_AC));
+}
+
+TEST(TestSend, SendStateSizeMax) {
+  // Everything is enabled for the tests, so the largest state is Hitachi's.
+  EXPECT_EQ(kHitachiAc2StateLength, kSendStateSizeMax);
+}
+
+// Types outside of `decode_type_t` aren't sent, nor have any defaults.
+TEST(TestSend, OutOfRangeTypes) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  const uint8_t state[kStateSizeMax] = {0};
+  const decode_type_t types[] = {decode_type_t::UNKNOWN,
+                                 (decode_type_t)(kLastDecodeType + 1),
+                                 (decode_type_t)(UNKNOWN - 1)};
+  for (const decode_type_t type : types) {
+    irsend.reset();
+    EXPECT_FALSE(irsend.send(type, 0x1234, 16));
+    EXPECT_FALSE(irsend.send(type, state, kStateSizeMax));
+    EXPECT_EQ("", irsend.outputStr());
+    EXPECT_EQ(0, IRsend::defaultBits(type));
+    EXPECT_EQ(kNoRepeat, IRsend::minRepeats(type));
+  }
+}
+
+// Tests for protocolInfo() & estimateDuration().
+TEST(TestSend, ProtocolInfo) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  protocol_info_t info;
+
+  ASSERT_TRUE(irsend.protocolInfo(decode_type_t::NEC, &info));
+  EXPECT_EQ(38000, info.frequency);
+  EXPECT_EQ(33, info.duty);
+  EXPECT_EQ(kNECBits, info.bits);
+  EXPECT_EQ(kNoRepeat, info.repeats);
+  // NEC messages are a fixed length. i.e. kNecMinCommandLength
+  EXPECT_EQ(108080, info.duration);
+  // Hdr + 32 '1' bits + footer mark.
+  EXPECT_EQ(108080 - (8960 + 4480 + 32 * (560 + 1680) + 560), info.gap);
+  EXPECT_EQ(info.duration, irsend.estimateDuration(decode_type_t::NEC));
+  // Nothing was actually sent.
+  EXPECT_EQ("", irsend.outputStr());
+
+  // Repeats are included. Sony always has at least two.
+  ASSERT_TRUE(irsend.protocolInfo(decode_type_t::SONY, &info, kSony12Bits));
+  EXPECT_EQ(40000, info.frequency);
+  EXPECT_EQ(kSonyMinRepeat, info.repeats);
+  EXPECT_EQ(info.duration, irsend.estimateDuration(decode_type_t::SONY,
+                                                    kSony12Bits, kNoRepeat));
+  EXPECT_GT(irsend.estimateDuration(decode_type_t::SONY, kSony12Bits, 3),
+            info.duration);
+
+  // A/C (state[]) based protocols.
+  ASSERT_TRUE(irsend.protocolInfo(decode_type_t::DAIKIN2, &info));
+  EXPECT_EQ(36700, info.frequency);
+  EXPECT_EQ(kDaikin2Bits, info.bits);
+  EXPECT_EQ(2 * info.duration,
+            irsend.estimateDuration(decode_type_t::DAIKIN2, 0, 1));
+  EXPECT_EQ("", irsend.outputStr());
+
+  // A recording in progress is left alone.
+  IRsequence seq;
+  irsend.startRecording(&seq);
+  irsend.sendNEC(0);
+  const uint16_t length = seq.length();
+  EXPECT_NE(0, irsend.estimateDuration(decode_type_t::SAMSUNG));
+  EXPECT_EQ(length, seq.length());
+  EXPECT_EQ(38000, seq.frequency());
+  EXPECT_TRUE(irsend.stopRecording());
+
+  // Things we can't measure.
+  EXPECT_FALSE(irsend.protocolInfo(decode_type_t::UNKNOWN, &info));
+  EXPECT_FALSE(irsend.protocolInfo(decode_type_t::NEC, NULL));
+  EXPECT_EQ(0, irsend.estimateDuration(decode_type_t::FUJITSU_AC));
+  EXPECT_NE(0, irsend.estimateDuration(decode_type_t::FUJITSU_AC,
+                                       kFujitsuAcBits));
+
+  // Every protocol with a default size can be measured.
+  for (int i = 1; i <= kLastDecodeType; i++) {
+    const decode_type_t type = (decode_type_t)i;
+    if (!IRsend::defaultBits(type)) continue;
+    EXPECT_NE(0, irsend.estimateDuration(type)) << "Protocol " <<
+        typeToString(type) << "(" << i << ") couldn't be measured.";
+  }
+  EXPECT_EQ("", irsend.outputStr());
 }
 
 // Tests sendManchester().
@@ -863,3 +1045,599 @@ TEST(TestSendManchester, SendOverLargeData) {
       "m300",
       irsend.outputStr());
 }
+
+// Tests for recording messages into an IRsequence & replaying them.
+// A raw message source that reads a few entries at a time, & slowly.
+class SlowRawSource : public IRrawArraySource {
+ public:
+  SlowRawSource(const uint16_t durations[], const uint32_t length,
+                const uint16_t most, const uint32_t usecs)
+      : IRrawArraySource(durations, length), reads(0), _most(most),
+        _usecs(usecs) {}
+  uint16_t read(uint16_t durations[], const uint16_t max) {
+    reads++;
+    _IRtimer_unittest_now += _usecs;  // i.e. It takes time.
+    return IRrawArraySource::read(durations, std::min(max, _most));
+  }
+  uint16_t reads;
+
+ private:
+  uint16_t _most;
+  uint32_t _usecs;
+};
+
+// Test sending raw messages streamed from a source, a chunk at a time.
+TEST(TestSendRaw, Streamed) {
+  IRsendTest irsend(4);
+  irsend.begin();
+
+  // Longer than any chunk. e.g. A long learned code.
+  std::vector<uint16_t> raw;
+  for (uint16_t i = 0; i < 2001; i++) raw.push_back(300 + (i % 7) * 100);
+  irsend.reset();
+  irsend.sendRaw(raw.data(), raw.size(), 38);
+  const std::string expected = irsend.outputStr();
+  irsend.reset();
+  IRrawArraySource source(raw.data(), raw.size());
+  EXPECT_TRUE(irsend.sendRawStream(&source, 38));
+  EXPECT_EQ(expected, irsend.outputStr());
+  // It has all been read.
+  uint16_t entry;
+  EXPECT_EQ(0, source.read(&entry, 1));
+  // Again.
+  source.rewind();
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendRawStream(&source, 38));
+  EXPECT_EQ(expected, irsend.outputStr());
+
+  // From flash.
+  static const uint16_t rawData[6] PROGMEM = {9000, 4500, 650, 550, 650, 1650};
+  IRrawArraySource flash(rawData, 6, true);
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendRawStream(&flash, 38));
+  EXPECT_EQ("f38000d50m9000s4500m650s550m650s1650", irsend.outputStr());
+
+  // The time taken to read is taken off the space it is read in. Including
+  // when the chunk ends with a mark.
+  SlowRawSource slow(rawData, 6, 3, 100);
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendRawStream(&slow, 38));
+  EXPECT_EQ(3, slow.reads);
+  EXPECT_EQ("f38000d50m9000s4500m650s450m650s1550", irsend.outputStr());
+  // Unless it isn't being sent right now.
+  IRsend recorder(0);
+  IRsequence seq;
+  SlowRawSource recorded(rawData, 6, 3, 100);
+  recorder.startRecording(&seq);
+  EXPECT_TRUE(recorder.sendRawStream(&recorded, 38));
+  EXPECT_TRUE(recorder.stopRecording());
+  irsend.reset();
+  irsend.sendSequence(&seq);
+  EXPECT_EQ("f38000d50m9000s4500m650s550m650s1650", irsend.outputStr());
+
+  // Nothing to send.
+  irsend.reset();
+  IRrawArraySource empty(rawData, 0);
+  EXPECT_FALSE(irsend.sendRawStream(&empty, 38));
+  EXPECT_FALSE(irsend.sendRawStream(NULL, 38));
+  EXPECT_EQ("", irsend.outputStr());
+}
+
+TEST(TestIRsequence, RecordAndReplay) {
+  IRsend recorder(0);
+  IRsendTest irsend(0);
+  IRsequence seq;
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendNEC(0x807FC03F, kNECBits, 1);
+  const std::string expected = irsend.outputStr();
+
+  recorder.startRecording(&seq);
+  recorder.sendNEC(0x807FC03F, kNECBits, 1);
+  EXPECT_TRUE(recorder.stopRecording());
+  EXPECT_FALSE(seq.overflowed());
+  EXPECT_EQ(38000, seq.frequency());
+  EXPECT_EQ(33, seq.dutyCycle());
+  EXPECT_EQ(74, seq.length());  // The 96ms gap needs two entries.
+
+  irsend.reset();
+  irsend.sendSequence(&seq);
+  EXPECT_EQ(expected, irsend.outputStr());
+
+  irsend.reset();
+  irsend.sendSequence(&seq, 1);
+  EXPECT_EQ(expected + expected.substr(std::string("f38000d33").size()),
+            irsend.outputStr());
+
+  EXPECT_FALSE(recorder.stopRecording());  // Not recording any more.
+}
+
+TEST(TestIRsequence, LongDurations) {
+  IRsequence seq(8);
+  EXPECT_TRUE(seq.add(false, 100));  // A leading space needs an empty mark.
+  EXPECT_TRUE(seq.add(true, 500));
+  EXPECT_TRUE(seq.add(true, 500));  // Joined to the previous mark.
+  EXPECT_TRUE(seq.add(false, 150000));  // Too long for a single entry.
+  EXPECT_EQ(8, seq.length());
+  EXPECT_EQ(0, seq.durations()[0]);
+  EXPECT_EQ(100, seq.durations()[1]);
+  EXPECT_EQ(1000, seq.durations()[2]);
+  EXPECT_EQ(UINT16_MAX, seq.durations()[3]);
+  EXPECT_EQ(0, seq.durations()[4]);
+  EXPECT_EQ(UINT16_MAX, seq.durations()[5]);
+  EXPECT_EQ(0, seq.durations()[6]);
+  EXPECT_EQ(150000 - 2 * UINT16_MAX, seq.durations()[7]);
+
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendSequence(&seq);
+  EXPECT_EQ("f38000d50m0s100m1000s150000", irsend.outputStr());
+
+  EXPECT_FALSE(seq.add(true, 200000));  // Doesn't fit.
+  EXPECT_TRUE(seq.overflowed());
+  EXPECT_EQ(8, seq.length());
+  seq.clear();
+  EXPECT_FALSE(seq.overflowed());
+  EXPECT_EQ(0, seq.length());
+}
+
+TEST(TestIRsequence, Set) {
+  IRsequence seq(4);
+  const uint16_t raw[4] = {9000, 4500, 560, 40000};
+  EXPECT_TRUE(seq.set(raw, 4, 40, 25));
+  EXPECT_EQ(4, seq.length());
+  EXPECT_EQ(40000, seq.frequency());
+  EXPECT_EQ(25, seq.dutyCycle());
+
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendSequence(&seq);
+  EXPECT_EQ("f40000d25m9000s4500m560s40000", irsend.outputStr());
+
+  const uint16_t toolong[5] = {1, 2, 3, 4, 5};
+  EXPECT_FALSE(seq.set(toolong, 5, 38));
+  EXPECT_TRUE(seq.overflowed());
+  EXPECT_EQ(0, seq.length());
+}
+
+TEST(TestIRsequence, SetNormalised) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E09966);
+  irsend.makeDecodeResult();
+  // Add some jitter, as a real capture would have.
+  for (uint16_t i = 1; i < irsend.capture.rawlen; i++)
+    irsend.capture.rawbuf[i] += (i % 3) * 20 / kRawTick;
+  uint8_t code[64];
+  const uint16_t size = normaliseCapture(&irsend.capture, code, sizeof(code));
+  ASSERT_LT(0, size);
+  // 4 times smaller than a rawData[] of it, at least.
+  EXPECT_GT((irsend.capture.rawlen - 1) * sizeof(uint16_t), 4U * size);
+
+  IRsequence seq(kSequenceDefaultSize);
+  EXPECT_TRUE(seq.setNormalised(code, size, 38));
+  EXPECT_EQ(irsend.capture.rawlen - 1, seq.length());
+  EXPECT_EQ(38000, seq.frequency());
+  irsend.reset();
+  irsend.sendSequence(&seq);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SAMSUNG, irsend.capture.decode_type);
+  EXPECT_EQ(0xE0E09966, irsend.capture.value);
+
+  EXPECT_FALSE(seq.setNormalised(code, size - 1, 38));  // Truncated.
+  EXPECT_EQ(0, seq.length());
+  IRsequence small(4);
+  EXPECT_FALSE(small.setNormalised(code, size, 38));
+  EXPECT_TRUE(small.overflowed());
+}
+
+// Tests for the IRsendQueue class.
+TEST(TestIRsendQueue, OrderAndPriority) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  IRsendQueue queue(&irsend, 4);
+  irsend.begin();
+  irsend.reset();
+
+  EXPECT_FALSE(queue.handle());  // Nothing to send.
+  EXPECT_TRUE(queue.add(NEC, 0x1, kNECBits, 0));
+  EXPECT_TRUE(queue.add(NEC, 0x2, kNECBits, 0));
+  EXPECT_TRUE(queue.add(NEC, 0x3, kNECBits, 0, 1));  // Higher priority.
+  EXPECT_TRUE(queue.add(NEC, 0x4, kNECBits, 0));
+  EXPECT_FALSE(queue.add(NEC, 0x5, kNECBits, 0));  // Full.
+  EXPECT_EQ(1, queue.getDrops());
+  EXPECT_EQ(4, queue.pending());
+
+  uint64_t expected[4] = {0x3, 0x1, 0x2, 0x4};
+  for (uint8_t i = 0; i < 4; i++) {
+    irsend.reset();
+    ASSERT_TRUE(queue.handle());
+    irsend.makeDecodeResult();
+    ASSERT_TRUE(irrecv.decode(&irsend.capture));
+    EXPECT_EQ(expected[i], irsend.capture.value);
+    // Not until the gap has passed.
+    irsend.reset();
+    EXPECT_EQ(i < 3, queue.pending() > 0);
+    EXPECT_FALSE(queue.handle());
+    EXPECT_EQ("", irsend.outputStr());
+    IRtimer::add(queue.getGap());
+  }
+  EXPECT_EQ(0, queue.pending());
+  EXPECT_FALSE(queue.handle());
+}
+
+TEST(TestIRsendQueue, Replace) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  IRsendQueue queue(&irsend);
+  irsend.begin();
+
+  // A/C states replace any pending state of the same protocol by default.
+  uint8_t state[kMitsubishiACStateLength] = {
+      0x23, 0xCB, 0x26, 0x01, 0x00, 0x20, 0x08, 0x06, 0x30, 0x45, 0x67, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x1F};
+  EXPECT_TRUE(queue.add(NEC, 0x807FC03F, kNECBits));
+  EXPECT_TRUE(queue.add(MITSUBISHI_AC, state, kMitsubishiACStateLength));
+  EXPECT_TRUE(queue.add(NEC, 0x807FC03F, kNECBits));  // Simple ones don't.
+  state[7] = 0x07;  // A newer state.
+  state[17] = 0x1E;
+  EXPECT_TRUE(queue.add(MITSUBISHI_AC, state, kMitsubishiACStateLength));
+  EXPECT_EQ(3, queue.pending());
+  // Unless asked to.
+  EXPECT_TRUE(queue.add(NEC, 0x807F40BF, kNECBits, kNoRepeat,
+                        kSendQueueDefaultPriority, true));
+  EXPECT_EQ(3, queue.pending());
+  queue.setGap(0);
+
+  irsend.reset();
+  ASSERT_TRUE(queue.handle());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0x807F40BF, irsend.capture.value);
+
+  IRsendTest direct(0);
+  direct.begin();
+  direct.reset();
+  direct.sendMitsubishiAC(state);
+  irsend.reset();
+  ASSERT_TRUE(queue.handle());  // It keeps the place of the one it replaced.
+  EXPECT_EQ(direct.outputStr(), irsend.outputStr());
+
+  irsend.reset();
+  ASSERT_TRUE(queue.handle());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0x807FC03F, irsend.capture.value);
+  EXPECT_EQ(0, queue.pending());
+  EXPECT_EQ(0, queue.getDrops());
+
+  // Sequences, & messages that can't be sent.
+  IRsequence seq(4);
+  const uint16_t raw[4] = {9000, 4500, 560, 40000};
+  seq.set(raw, 4, 38);
+  EXPECT_TRUE(queue.add(&seq, 1));
+  EXPECT_TRUE(queue.add(UNUSED, 0x1, 8));
+  irsend.reset();
+  ASSERT_TRUE(queue.handle());
+  EXPECT_EQ("f38000d50m9000s4500m560s40000m9000s4500m560s40000",
+            irsend.outputStr());
+  irsend.reset();
+  ASSERT_TRUE(queue.handle());
+  EXPECT_EQ(1, queue.getDrops());
+  EXPECT_TRUE(queue.add(&seq));
+  queue.clear();
+  EXPECT_EQ(0, queue.pending());
+}
+
+TEST(TestIRSend, AddPin) {
+  IRsend irsend(4);
+  EXPECT_EQ(0, irsend.getPinMask());
+  EXPECT_TRUE(irsend.addPin(5));
+  EXPECT_EQ((1UL << 4) | (1UL << 5), irsend.getPinMask());
+  EXPECT_TRUE(irsend.addPin(12));
+  EXPECT_EQ((1UL << 4) | (1UL << 5) | (1UL << 12), irsend.getPinMask());
+  EXPECT_FALSE(irsend.addPin(kSendMaxMaskPin + 1));
+  EXPECT_EQ((1UL << 4) | (1UL << 5) | (1UL << 12), irsend.getPinMask());
+
+  IRsend toohigh(kSendMaxMaskPin + 1);
+  EXPECT_FALSE(toohigh.addPin(5));
+  EXPECT_EQ(0, toohigh.getPinMask());
+}
+
+// Expose the carrier period calculations.
+class IRsendPeriodTest : public IRsend {
+ public:
+  explicit IRsendPeriodTest(uint16_t x) : IRsend(x) {}
+  using IRsend::calcUSecPeriod;
+  using IRsend::onTimePeriod;
+  using IRsend::offTimePeriod;
+};
+
+// The direct GPIO register writes have their own period offset.
+TEST(TestIRSend, FastGpioPeriodOffset) {
+  IRsendPeriodTest irsend(4);
+  // The tests (& builds without ENABLE_FAST_GPIO_SEND) use digitalWrite().
+  EXPECT_FALSE(IRSEND_FAST_GPIO);
+  EXPECT_EQ(kDigitalWritePeriodOffset, kPeriodOffset);
+  EXPECT_EQ(26 + kDigitalWritePeriodOffset, irsend.calcUSecPeriod(38000, true));
+  // Where the fast path's carrier period ends up. i.e. A full 38kHz period.
+  EXPECT_EQ(0, kFastGpioPeriodOffset);
+  EXPECT_TRUE(irsend.setPeriodOffset(kFastGpioPeriodOffset));
+  EXPECT_EQ(26, irsend.calcUSecPeriod(38000, true));
+  irsend.enableIROut(38000, 50);
+  EXPECT_EQ(13, irsend.onTimePeriod);
+  EXPECT_EQ(13, irsend.offTimePeriod);
+}
+
+TEST(TestIRSend, PeriodOffsets) {
+  IRsendPeriodTest irsend(4);
+  EXPECT_EQ(kPeriodOffset, irsend.getPeriodOffset());
+  EXPECT_EQ(kPeriodOffset, irsend.getPeriodOffset(38000));
+  EXPECT_TRUE(irsend.setPeriodOffset(0));
+  EXPECT_EQ(26, irsend.calcUSecPeriod(38000));
+  EXPECT_EQ(18, irsend.calcUSecPeriod(56000));
+
+  EXPECT_TRUE(irsend.setPeriodOffset(-3, 38000));
+  EXPECT_TRUE(irsend.setPeriodOffset(-1, 56));  // kHz.
+  EXPECT_EQ(-3, irsend.getPeriodOffset(38000));
+  EXPECT_EQ(-3, irsend.getPeriodOffset(38222));  // Close enough.
+  EXPECT_EQ(0, irsend.getPeriodOffset(40000));  // Too far away.
+  EXPECT_EQ(-1, irsend.getPeriodOffset(56000));
+  EXPECT_EQ(0, irsend.getPeriodOffset());
+  EXPECT_EQ(23, irsend.calcUSecPeriod(38000));
+  EXPECT_EQ(26, irsend.calcUSecPeriod(38000, false));
+  EXPECT_EQ(17, irsend.calcUSecPeriod(56000));
+  EXPECT_EQ(25, irsend.calcUSecPeriod(40000));
+
+  // Used when setting up the carrier.
+  irsend.enableIROut(38000, 50);
+  EXPECT_EQ(11, irsend.onTimePeriod);
+  EXPECT_EQ(12, irsend.offTimePeriod);
+  irsend.enableIROut(40000, 50);
+  EXPECT_EQ(12, irsend.onTimePeriod);
+  EXPECT_EQ(13, irsend.offTimePeriod);
+
+  // The nearest one wins.
+  EXPECT_TRUE(irsend.setPeriodOffset(-2, 38400));
+  EXPECT_EQ(-3, irsend.getPeriodOffset(38100));
+  EXPECT_EQ(-2, irsend.getPeriodOffset(38300));
+  // Replacing an existing one.
+  EXPECT_TRUE(irsend.setPeriodOffset(-4, 38000));
+  EXPECT_EQ(-4, irsend.getPeriodOffset(38000));
+
+  // Fill the table.
+  for (uint8_t i = 3; i < kPeriodOffsetTableSize; i++)
+    EXPECT_TRUE(irsend.setPeriodOffset(1, 100000 + i * 10000));
+  EXPECT_FALSE(irsend.setPeriodOffset(1, 33000));
+  EXPECT_EQ(0, irsend.getPeriodOffset(33000));
+  EXPECT_TRUE(irsend.setPeriodOffset(-5, 56000));  // Existing ones still work.
+  EXPECT_EQ(-5, irsend.getPeriodOffset(56000));
+
+  irsend.clearPeriodOffsets();
+  EXPECT_EQ(0, irsend.getPeriodOffset(38000));
+  EXPECT_EQ(0, irsend.getPeriodOffset(56000));
+  EXPECT_TRUE(irsend.setPeriodOffset(1, 33000));
+  EXPECT_EQ(1, irsend.getPeriodOffset(33000));
+}
+
+// An IRsend that takes a little longer than it should to turn the LED on.
+class IRsendSlowTest : public IRsendLowLevelTest {
+ public:
+  explicit IRsendSlowTest(uint16_t x, bool j = true)
+      : IRsendLowLevelTest(x, false, j) {}
+
+ protected:
+  void ledOn() {
+    IRsendLowLevelTest::ledOn();
+    IRtimer::add(2);
+  }
+};
+
+// Tests for measuring the timing of what is sent.
+TEST(TestSendTiming, Unmodulated) {
+  IRsendSlowTest irsend(0, false);
+  send_timing_entry_t log[3];
+  irsend.begin();
+  const uint16_t raw[4] = {1000, 500, 800, 10000};
+
+  irsend.sendRaw(raw, 4, 38);
+  EXPECT_EQ(0, irsend.getSendTiming()->marks);  // Not enabled yet.
+
+  irsend.enableSendTiming(log, 3);
+  irsend.sendRaw(raw, 4, 38);
+  const send_timing_t *timing = irsend.getSendTiming();
+  EXPECT_EQ(2, timing->marks);
+  EXPECT_EQ(2, timing->spaces);
+  EXPECT_EQ(2, timing->pulses);
+  EXPECT_EQ(12300, timing->requested);
+  EXPECT_EQ(12304, timing->actual);
+  EXPECT_EQ(4, timing->drift);
+  EXPECT_EQ(4, timing->max_drift);
+  EXPECT_EQ(2, timing->max_error);
+  EXPECT_EQ(3, timing->logged);
+  EXPECT_EQ(1000, log[0].requested);
+  EXPECT_EQ(1002, log[0].actual);
+  EXPECT_EQ(500, log[1].requested);
+  EXPECT_EQ(500, log[1].actual);
+  EXPECT_EQ(802, log[2].actual);
+
+  // Restarted for each message.
+  irsend.sendRaw(raw, 2, 38);
+  EXPECT_EQ(1, timing->marks);
+  EXPECT_EQ(2, timing->drift);
+
+  irsend.disableSendTiming();
+  irsend.enableIROut(38);
+  irsend.mark(100);
+  EXPECT_EQ(0, timing->marks);
+}
+
+TEST(TestSendTiming, Modulated) {
+  IRsendSlowTest irsend(0);
+  irsend.begin();
+  irsend.enableSendTiming();
+  irsend.enableIROut(38000, 50);
+  irsend.mark(1000);
+  const send_timing_t *timing = irsend.getSendTiming();
+  EXPECT_EQ(1, timing->marks);
+  // Each pulse takes 2us longer than it should, so fewer fit into the mark.
+  EXPECT_EQ(44, timing->pulses);
+  EXPECT_EQ(1000, timing->requested);
+  EXPECT_LE(1000, timing->actual);
+  EXPECT_EQ(0, timing->logged);
+}
+
+// Tests for not waiting out the trailing gap of what is sent.
+TEST(TestDeferredGaps, OnlyWaitedForWhenNeeded) {
+  IRsendLowLevelTest irsend(0, false, false);  // Unmodulated.
+  irsend.begin();
+  irsend.enableDeferredGaps();
+  irsend.reset();
+  irsend.mark(500);
+  irsend.space(1000);
+  irsend.mark(500);
+  irsend.space(40000);  // e.g. A protocol's trailing gap.
+  // The space within the message is the same as usual, but not the gap.
+  EXPECT_EQ("[On]500usecs[Off][Off]1000usecs[On]500usecs[Off][Off]",
+            irsend.low_level_sequence);
+  EXPECT_EQ(40000, irsend.gapRemaining());
+  IRtimer::add(15000);  // The caller did something else for a while.
+  EXPECT_EQ(25000, irsend.gapRemaining());
+  // The next message only waits for what is left of it.
+  irsend.reset();
+  irsend.mark(100);
+  EXPECT_EQ("25000usecs[On]100usecs[Off]", irsend.low_level_sequence);
+  EXPECT_EQ(0, irsend.gapRemaining());
+  irsend.space(40000);
+  IRtimer::add(50000);
+  EXPECT_EQ(0, irsend.gapRemaining());
+  irsend.reset();
+  irsend.mark(100);
+  EXPECT_EQ("[On]100usecs[Off]", irsend.low_level_sequence);
+
+  // Turning it off waits for any that is still pending.
+  irsend.space(3000);
+  irsend.reset();
+  irsend.enableDeferredGaps(false);
+  EXPECT_EQ("3000usecs", irsend.low_level_sequence);
+  irsend.reset();
+  irsend.space(2000);
+  EXPECT_EQ("[Off]2000usecs", irsend.low_level_sequence);
+  EXPECT_EQ(0, irsend.gapRemaining());
+}
+
+// Tests for yielding in the long spaces of what is sent.
+TEST(TestCooperativeSend, YieldsInLongSpaces) {
+  IRsendLowLevelTest irsend(0);
+  irsend.begin();
+  irsend.enableIROut(38);
+  irsend.reset();
+  irsend.space(12000);
+  EXPECT_EQ("[Off]12000usecs", irsend.low_level_sequence);
+  EXPECT_EQ(0, irsend.getCooperativeSend()->yields);  // Not enabled yet.
+
+  irsend.enableCooperativeSend(5000);
+  irsend.reset();
+  irsend.space(4999);  // Too short.
+  EXPECT_EQ("[Off]4999usecs", irsend.low_level_sequence);
+  EXPECT_EQ(0, irsend.getCooperativeSend()->yields);
+  irsend.reset();
+  irsend.space(12000);  // Quick yields. Once per budget, until it runs out.
+  EXPECT_EQ("[Off]5000usecs5000usecs2000usecs", irsend.low_level_sequence);
+  const cooperative_send_t *coop = irsend.getCooperativeSend();
+  EXPECT_EQ(2, coop->yields);
+  EXPECT_EQ(0, coop->yielded);
+  EXPECT_EQ(0, coop->overruns);
+
+  // Slow yields, that still fit.
+  irsend.setYieldTime(6000);
+  irsend.enableIROut(38);  // A new message.
+  EXPECT_EQ(0, coop->yields);
+  irsend.reset();
+  irsend.space(12000);
+  EXPECT_EQ("[Off]", irsend.low_level_sequence);
+  EXPECT_EQ(2, coop->yields);
+  EXPECT_EQ(12000, coop->yielded);
+  EXPECT_EQ(6000, coop->max_yield);
+  EXPECT_EQ(0, coop->overruns);
+  EXPECT_EQ(0, coop->error);
+
+  // Too slow, so the space is too long.
+  irsend.setYieldTime(9000);
+  irsend.reset();
+  irsend.space(14000);
+  EXPECT_EQ(4, coop->yields);
+  EXPECT_EQ(1, coop->overruns);
+  EXPECT_EQ(4000, coop->error);
+  EXPECT_EQ(4000, coop->max_error);
+  irsend.reset();
+  irsend.space(9500);  // Only one yield fits, & it leaves some to wait for.
+  EXPECT_EQ("[Off]500usecs", irsend.low_level_sequence);
+  EXPECT_EQ(5, coop->yields);
+  EXPECT_EQ(1, coop->overruns);
+
+  // It can be turned off again.
+  irsend.disableCooperativeSend();
+  irsend.setYieldTime(0);
+  irsend.reset();
+  irsend.space(12000);
+  EXPECT_EQ("[Off]12000usecs", irsend.low_level_sequence);
+  EXPECT_EQ(5, coop->yields);
+}
+
+#if ENABLE_CUSTOM_BACKENDS
+// A send backend that just notes what it was asked to send.
+class RecordingSink : public IRsendSink {
+ public:
+  std::string sent;
+  void carrier(const uint32_t hz, const uint8_t duty) {
+    sent += "f" + std::to_string(hz) + "d" + std::to_string(duty);
+  }
+  uint16_t mark(const uint16_t usecs) {
+    sent += "m" + std::to_string(usecs);
+    return 1;
+  }
+  void space(const uint32_t usecs) { sent += "s" + std::to_string(usecs); }
+};
+
+TEST(TestCustomBackends, SendSink) {
+  IRsend irsend(0);
+  RecordingSink sink;
+  irsend.begin();
+  EXPECT_EQ(NULL, irsend.getSink());
+  irsend.setSink(&sink);
+  EXPECT_EQ(&sink, irsend.getSink());
+
+  irsend.sendData(1, 2, 3, 4, 0b10, 2, true);
+  EXPECT_EQ("m1s2m3s4", sink.sent);
+  sink.sent.clear();
+  irsend.sendSony(0x240, kSony12Bits, 0);
+  EXPECT_EQ(
+      "f40000d33"
+      "m2400s600"
+      "m600s600m600s600m1200s600m600s600m600s600m1200s600m600s600m600s600"
+      "m600s600m600s600m600s600m600s600"
+      "s45000",  // It took no time, so the gap is the whole message length.
+      sink.sent);
+
+  // Recording still takes precedence over it.
+  IRsequence seq;
+  sink.sent.clear();
+  irsend.startRecording(&seq);
+  irsend.sendSony(0x240, kSony12Bits, 0);
+  EXPECT_TRUE(irsend.stopRecording());
+  EXPECT_EQ("", sink.sent);
+  irsend.sendSequence(&seq);
+  EXPECT_EQ("f40000d33", sink.sent.substr(0, 9));
+
+  // Back to the GPIO.
+  irsend.setSink(NULL);
+  EXPECT_EQ(NULL, irsend.getSink());
+}
+#endif  // ENABLE_CUSTOM_BACKENDS
@@ -102,6 +102,7 @@ class IRsendTest : public IRsend {
   void addGap(uint32_t usecs) { space(usecs); }
 
   uint16_t mark(uint16_t usec) {
+    if (_recorder() != NULL) return IRsend::mark(usec);  // Not being sent.
     IRtimer::add(usec);
     if (last >= OUTPUT_BUF) return 0;
     if (last & 1)  // Is odd? (i.e. last call was a space())
@@ -114,11 +115,16 @@ class IRsendTest : public IRsend {
   }
 
   void space(uint32_t time) {
+    if (_recorder() != NULL) return IRsend::space(time);  // Not being sent.
     IRtimer::add(time);
     if (last >= OUTPUT_BUF) return;
     if (last & 1) {  // Is odd? (i.e. last call was a space())
       output[last] += time;
     } else {
+      if (last == 0 && output[0] == 0) {  // A leading space. i.e. No mark yet.
+        duty[0] = _dutycycle;
+        freq[0] = _freq_unittest;
+      }
       output[++last] = time;
     }
     duty[last] = _dutycycle;
@@ -137,6 +143,8 @@ class IRsendLowLevelTest : public IRsend {
   }
 
   void reset() { low_level_sequence = ""; }
+  // How long a yield takes. (uSeconds) See `IRsend::enableCooperativeSend()`.
+  void setYieldTime(const uint32_t usecs) { _yield_unittest = usecs; }
 
  protected:
   void _delayMicroseconds(uint32_t usec) {
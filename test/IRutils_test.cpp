@@ -2,6 +2,8 @@
 
 #include "IRutils.h"
 #include <stdint.h>
+#include <algorithm>
+#include "IRac.h"
 #include "IRrecv.h"
 #include "IRrecv_test.h"
 #include "IRsend.h"
@@ -39,6 +41,48 @@ TEST(ReverseBitsTest, LessBitsReversedThanInputHasSet) {
   EXPECT_EQ(0x12345678FFFF0000, reverseBits(0x123456780000FFFF, 32));
 }
 
+// The original bit by bit version, to compare the fast one against.
+static uint64_t slowReverseBits(uint64_t input, uint16_t nbits) {
+  if (nbits <= 1) return input;
+  nbits = std::min(nbits, (uint16_t)(sizeof(input) * 8));
+  uint64_t output = 0;
+  for (uint16_t i = 0; i < nbits; i++) {
+    output <<= 1;
+    output |= (input & 1);
+    input >>= 1;
+  }
+  return (input << nbits) | output;
+}
+
+// Tests reverseBits gives the same results as the bit by bit version.
+TEST(ReverseBitsTest, SameAsBitByBit) {
+  uint64_t value = 0x0123456789ABCDEF;
+  for (uint16_t i = 0; i < 1000; i++) {
+    for (uint16_t nbits = 0; nbits <= 65; nbits++)
+      ASSERT_EQ(slowReverseBits(value, nbits), reverseBits(value, nbits))
+          << "value: " << value << " nbits: " << nbits;
+    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+}
+
+// Tests reverseBytes().
+TEST(ReverseBytesTest, General) {
+  uint8_t data[11];
+  uint8_t expected[11];
+  for (uint8_t i = 0; i < sizeof(data); i++) {
+    data[i] = i * 37 + 1;
+    expected[i] = reverseBits(data[i], 8);
+  }
+  reverseBytes(data, sizeof(data));
+  EXPECT_STATE_EQ(expected, data, sizeof(data) * 8);
+  // Doing it again undoes it.
+  reverseBytes(data, 3);  // Fewer than a word's worth.
+  for (uint8_t i = 0; i < 3; i++) EXPECT_EQ(i * 37 + 1, data[i]);
+  EXPECT_EQ(expected[3], data[3]);
+  reverseBytes(data, 0);  // Nothing to do.
+  EXPECT_EQ(expected[3], data[3]);
+}
+
 // Tests for uint64ToString()
 
 TEST(TestUint64ToString, TrivialCases) {
@@ -94,6 +138,48 @@ TEST(TestUint64ToString, SillyBases) {
   EXPECT_EQ("9IX", uint64ToString(12345, 36));     // But we *can* do base-36.
 }
 
+// Tests for uint64ToChars()
+
+TEST(TestUint64ToChars, General) {
+  char buffer[kUint64ToCharsSize];
+  EXPECT_EQ(1, uint64ToChars(buffer, 0));
+  EXPECT_STREQ("0", buffer);
+  EXPECT_EQ(5, uint64ToChars(buffer, 12345));
+  EXPECT_STREQ("12345", buffer);
+  EXPECT_EQ(4, uint64ToChars(buffer, 12345, 16));
+  EXPECT_STREQ("3039", buffer);
+  EXPECT_EQ(3, uint64ToChars(buffer, 12345, 36));
+  EXPECT_STREQ("9IX", buffer);
+  EXPECT_EQ(5, uint64ToChars(buffer, 12345, 1));  // Silly bases are Base-10.
+  EXPECT_STREQ("12345", buffer);
+  // The worst case just fits.
+  EXPECT_EQ(64, uint64ToChars(buffer, UINT64_MAX, 2));
+  EXPECT_EQ(std::string(64, '1'), buffer);
+  EXPECT_EQ(20, uint64ToChars(buffer, UINT64_MAX));
+  EXPECT_STREQ("18446744073709551615", buffer);
+  EXPECT_EQ(16, uint64ToChars(buffer, UINT64_MAX, 16));
+  EXPECT_STREQ("FFFFFFFFFFFFFFFF", buffer);
+  // Around where the fast decimal path changes.
+  EXPECT_EQ(10, uint64ToChars(buffer, UINT32_MAX));
+  EXPECT_STREQ("4294967295", buffer);
+  EXPECT_EQ(10, uint64ToChars(buffer, (uint64_t)UINT32_MAX + 1));
+  EXPECT_STREQ("4294967296", buffer);
+  // Zeros inside the 9 digit chunks are kept.
+  EXPECT_EQ(19, uint64ToChars(buffer, 1000000000000000000ULL));
+  EXPECT_STREQ("1000000000000000000", buffer);
+  EXPECT_EQ(19, uint64ToChars(buffer, 1000000000000000001ULL));
+  EXPECT_STREQ("1000000000000000001", buffer);
+  // Every value a 16 bit raw timing can have, against the slow way.
+  for (uint32_t i = 0; i <= UINT16_MAX; i++) {
+    uint64ToChars(buffer, i);
+    ASSERT_EQ(std::to_string(i), buffer);
+    uint64ToChars(buffer, i, 16);
+    char expected[8];
+    snprintf(expected, sizeof(expected), "%X", i);
+    ASSERT_STREQ(expected, buffer);
+  }
+}
+
 TEST(TestGetCorrectedRawLength, NoLargeValues) {
   IRsendTest irsend(0);
   IRrecv irrecv(1);
@@ -296,6 +382,38 @@ TEST(TestResultToTimingInfo, General) {
       resultToTimingInfo(&irsend.capture));
 }
 
+// Output much larger than the buffer it is built in, comes out the same.
+TEST(TestResultToTimingInfo, LargeCapture) {
+  uint16_t rawbuf[1001];
+  decode_results results;
+  results.decode_type = decode_type_t::UNKNOWN;
+  results.rawbuf = rawbuf;
+  results.rawlen = 1001;
+  results.bits = 0;
+  results.value = 0;
+  results.repeat = false;
+  std::string expected = "Raw Timing[1000]:\n";
+  std::string source = "uint16_t rawData[1000] = {";
+  for (uint16_t i = 1; i < results.rawlen; i++) {
+    rawbuf[i] = i;
+    char value[16];
+    snprintf(value, sizeof(value), "%6d", i * kRawTick);
+    expected += (i % 2) ? "   +" : "-";
+    expected += value;
+    source += std::to_string(i * kRawTick);
+    if (i < results.rawlen - 1) {
+      expected += ", ";
+      source += ", ";
+    }
+    if (!(i % 8)) expected += "\n";
+    if (i % 2 == 0) source += " ";
+  }
+  expected += "\n";
+  source += "};  // UNKNOWN 0\n";
+  EXPECT_EQ(expected, resultToTimingInfo(&results));
+  EXPECT_EQ(source, resultToSourceCode(&results));
+}
+
 TEST(TestResultToHumanReadableBasic, SimpleCodes) {
   IRsendTest irsend(0);
   IRrecv irrecv(1);
@@ -333,6 +451,310 @@ TEST(TestResultToHumanReadableBasic, ComplexCodes) {
       resultToHumanReadableBasic(&irsend.capture));
 }
 
+TEST(TestResultToJson, General) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendNEC(irsend.encodeNEC(0x10, 0x20));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  char json[200];
+  const char *expected = "{\"protocol\":\"NEC\",\"bits\":32,"
+      "\"repeat\":false,\"value\":\"0x8F704FB\",\"address\":\"0x10\","
+      "\"command\":\"0x20\"}";
+  EXPECT_EQ(strlen(expected), resultToJson(&irsend.capture, json,
+                                           sizeof(json)));
+  EXPECT_STREQ(expected, json);
+  // Exactly big enough.
+  EXPECT_EQ(strlen(expected), resultToJson(&irsend.capture, json,
+                                           strlen(expected) + 1));
+  EXPECT_STREQ(expected, json);
+  // Too small. Nothing should be left in the buffer.
+  EXPECT_EQ(0, resultToJson(&irsend.capture, json, strlen(expected)));
+  EXPECT_STREQ("", json);
+
+  uint8_t state[kToshibaACStateLength] = {0xF2, 0x0D, 0x03, 0xFC, 0x01,
+                                          0x00, 0x00, 0x00, 0x01};
+  irsend.reset();
+  irsend.sendToshibaAC(state);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  resultToJson(&irsend.capture, json, sizeof(json));
+  EXPECT_STREQ(
+      "{\"protocol\":\"TOSHIBA_AC\",\"bits\":72,\"repeat\":false,"
+      "\"state\":\"0xF20D03FC0100000001\"}", json);
+}
+
+TEST(TestResultToPronto, General) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  const uint16_t raw[5] = {9000, 4500, 560, 1690, 560};
+  irsend.sendRaw(raw, 5, 38);
+  irsend.makeDecodeResult();
+  // A trailing gap is added, so it is in whole pairs.
+  EXPECT_EQ("0000 006D 0000 0003 0156 00AB 0015 0040 0015 0EDB",
+            resultToPronto(&irsend.capture));
+  EXPECT_EQ("0000 0067 0000 0003 016A 00B5 0017 0044 0017 0FB8",
+            resultToPronto(&irsend.capture, 40000));
+  EXPECT_EQ("", resultToPronto(&irsend.capture, 0));
+
+  // It can be sent as it was captured.
+  IRsendTest resend(0);
+  resend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(resend.sendPronto(resultToPronto(&irsend.capture).c_str()));
+  resend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&resend.capture));
+  EXPECT_EQ(decode_type_t::NEC, resend.capture.decode_type);
+  EXPECT_EQ(0x20DF10EF, resend.capture.value);
+}
+
+TEST(TestResultToGlobalCache, General) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  const uint16_t raw[5] = {9000, 4500, 560, 1690, 560};
+  irsend.sendRaw(raw, 5, 38);
+  irsend.makeDecodeResult();
+  EXPECT_EQ("38000,1,1,342,171,21,64,21,3800",
+            resultToGlobalCache(&irsend.capture));
+  EXPECT_EQ("40000,1,1,360,180,22,68,22,4000",
+            resultToGlobalCache(&irsend.capture, 40000));
+  EXPECT_EQ("", resultToGlobalCache(&irsend.capture, 0));
+
+  // It can be sent as it was captured.
+  IRsendTest resend(0);
+  resend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(resend.sendGC(resultToGlobalCache(&irsend.capture).c_str()));
+  resend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&resend.capture));
+  EXPECT_EQ(decode_type_t::NEC, resend.capture.decode_type);
+  EXPECT_EQ(0x20DF10EF, resend.capture.value);
+}
+
+TEST(TestJsonWriter, Values) {
+  char buffer[200];
+  irutils::JsonWriter json(buffer, sizeof(buffer));
+  json.begin();
+  json.add("str", "a\"b\\c\n");
+  json.add("neg", (int32_t)-42);
+  json.add("big", (uint64_t)UINT64_MAX);
+  json.add("temp", 21.5f);
+  json.add("cold", -0.25f);
+  json.add("whole", 25.0f);
+  json.add("yes", true);
+  json.end();
+  EXPECT_FALSE(json.overflowed());
+  EXPECT_STREQ(
+      "{\"str\":\"a\\\"b\\\\c\\u000A\",\"neg\":-42,"
+      "\"big\":18446744073709551615,\"temp\":21.5,\"cold\":-0.25,"
+      "\"whole\":25,\"yes\":true}", buffer);
+  EXPECT_EQ(strlen(buffer), json.length());
+}
+
+TEST(TestCaptureFile, RoundTrip) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  const decode_results &nec = irsend.capture;
+  uint16_t big_raw[3] = {0, 65535, 1};
+  decode_results big;
+  big.rawbuf = big_raw;
+  big.rawlen = 3;
+  big.decode_type = UNKNOWN;
+  big.overflow = true;
+
+  uint8_t file[300];
+  uint32_t index[2];
+  irutils::CaptureWriter writer(file, sizeof(file), index, 2);
+  writer.begin();
+  EXPECT_TRUE(writer.add(&nec, 38, 1234));
+  EXPECT_TRUE(writer.add(&big, 36));
+  writer.end();
+  EXPECT_FALSE(writer.overflowed());
+  EXPECT_EQ(2, writer.count());
+  // The ticks are delta encoded, so small differences are a byte each.
+  EXPECT_EQ(kCaptureRecordHeaderSize + 84,
+            irutils::CaptureWriter::recordSize(&nec));
+  EXPECT_EQ(kCaptureFileHeaderSize + 100 + 24 + 2 * 4 +
+            kCaptureIndexTrailerSize, writer.length());
+  EXPECT_EQ(writer.length(), writer.pending());
+
+  irutils::CaptureReader reader(file, writer.length());
+  ASSERT_TRUE(reader.valid());
+  EXPECT_TRUE(reader.indexed());
+  EXPECT_EQ(2, reader.count());
+  irutils::capture_t capture;
+  uint16_t rawbuf[kRawBuf + 1];
+  ASSERT_TRUE(reader.get(1, &capture));
+  EXPECT_EQ(UNKNOWN, capture.protocol);
+  EXPECT_EQ(36, capture.frequency);
+  EXPECT_TRUE(capture.overflow);
+  ASSERT_EQ(3, irutils::CaptureReader::unpack(capture, rawbuf, kRawBuf));
+  EXPECT_EQ(0, memcmp(big_raw, rawbuf, sizeof(big_raw)));
+  ASSERT_TRUE(reader.next(&capture));
+  EXPECT_EQ(NEC, capture.protocol);
+  EXPECT_EQ(38, capture.frequency);
+  EXPECT_EQ(1234, capture.timestamp);
+  EXPECT_FALSE(capture.overflow);
+  ASSERT_EQ(nec.rawlen,
+            irutils::CaptureReader::unpack(capture, rawbuf, kRawBuf));
+  for (uint16_t i = 0; i < nec.rawlen; i++) EXPECT_EQ(nec.rawbuf[i], rawbuf[i]);
+  // It can be decoded straight away.
+  IRdecoder irdecoder;
+  decode_results results;
+  ASSERT_TRUE(irdecoder.decode(&results, rawbuf, capture.rawlen));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  ASSERT_TRUE(reader.next(&capture));
+  EXPECT_FALSE(reader.next(&capture));
+  EXPECT_FALSE(reader.get(2, &capture));
+  // Only as much as there is room for is unpacked.
+  EXPECT_EQ(2, irutils::CaptureReader::unpack(capture, rawbuf, 2));
+}
+
+TEST(TestCaptureFile, Unfinished) {
+  uint16_t raw[4] = {0, 100, 200, 100};
+  decode_results results;
+  results.rawbuf = raw;
+  results.rawlen = 4;
+  results.decode_type = UNKNOWN;
+  results.overflow = false;
+  // Written in pieces, with a buffer smaller than the file, & no index.
+  uint8_t buffer[kCaptureFileHeaderSize + kCaptureRecordHeaderSize + 8];
+  uint8_t file[100];
+  uint32_t length = 0;
+  irutils::CaptureWriter writer(buffer, sizeof(buffer));
+  writer.begin();
+  for (uint8_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(writer.add(&results, 38, i));
+    memcpy(file + length, buffer, writer.pending());
+    length += writer.pending();
+    writer.flush();
+  }
+  writer.end();
+  EXPECT_EQ(0, writer.pending());
+  EXPECT_EQ(length, writer.length());
+
+  irutils::CaptureReader reader(file, length);
+  ASSERT_TRUE(reader.valid());
+  EXPECT_FALSE(reader.indexed());
+  EXPECT_EQ(3, reader.count());
+  irutils::capture_t capture;
+  ASSERT_TRUE(reader.get(2, &capture));
+  EXPECT_EQ(2, capture.timestamp);
+  // A truncated capture isn't read.
+  irutils::CaptureReader truncated(file, length - 1);
+  EXPECT_EQ(2, truncated.count());
+  // Nor is something that isn't a capture file.
+  irutils::CaptureReader junk(buffer + 1, sizeof(buffer) - 1);
+  EXPECT_FALSE(junk.valid());
+  EXPECT_EQ(0, junk.count());
+  EXPECT_FALSE(junk.next(&capture));
+}
+
+TEST(TestCaptureFile, Overflow) {
+  uint16_t raw[20] = {0};
+  decode_results results;
+  results.rawbuf = raw;
+  results.rawlen = 20;
+  results.decode_type = UNKNOWN;
+  results.overflow = false;
+  uint8_t file[kCaptureFileHeaderSize + 40];
+  uint32_t index[1];
+  irutils::CaptureWriter writer(file, sizeof(file), index, 1);
+  writer.begin();
+  EXPECT_TRUE(writer.add(&results));
+  EXPECT_FALSE(writer.overflowed());
+  // Nothing is written of what doesn't fit.
+  EXPECT_FALSE(writer.add(&results));
+  writer.end();
+  EXPECT_TRUE(writer.overflowed());
+  EXPECT_EQ(kCaptureFileHeaderSize + 36, writer.length());
+  irutils::CaptureReader reader(file, writer.length());
+  EXPECT_FALSE(reader.indexed());
+  EXPECT_EQ(1, reader.count());
+}
+
+#if ENABLE_MEMORY_PROFILING
+TEST(TestMemoryProfiling, EntryPoints) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  IRac ac(kGpioUnused);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  disableMemoryProfiling();
+  resetMemoryProfile();
+  // It is off by default.
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0, getMemoryProfile(kMemProbeDecode)->calls);
+  EXPECT_EQ("", memoryProfileToString());
+  EXPECT_EQ(nullptr, getMemoryProfile(kMemProbeCount));
+
+  ASSERT_TRUE(enableMemoryProfiling());
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  const mem_profile_t *decode = getMemoryProfile(kMemProbeDecode);
+  EXPECT_EQ(1, decode->calls);
+  EXPECT_LT(0, decode->stack);
+  EXPECT_LE(decode->stack, kMemProfileStackDepth + 1024);
+  // The String returned is still on the heap when it finishes.
+  const String code = resultToSourceCode(&irsend.capture);
+  const mem_profile_t *source = getMemoryProfile(kMemProbeResultToSourceCode);
+  EXPECT_EQ(1, source->calls);
+  EXPECT_LT(0, source->stack);
+  EXPECT_LE((int32_t)code.length(), source->heap);
+
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::DAIKIN2;
+  state.power = true;
+  ASSERT_TRUE(ac.sendAc(state, NULL));
+  EXPECT_EQ(1, getMemoryProfile(kMemProbeSendAc)->calls);
+  EXPECT_LT(0, getMemoryProfile(kMemProbeSendAc)->stack);
+
+  irsend.reset();
+  irsend.sendCOOLIX(0xB21F28);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(COOLIX, irsend.capture.decode_type);
+  EXPECT_EQ(2, decode->calls);
+  ASSERT_TRUE(IRAcUtils::decodeToState(&irsend.capture, &state));
+  EXPECT_EQ(1, getMemoryProfile(kMemProbeDecodeToState)->calls);
+  EXPECT_LT(0, getMemoryProfile(kMemProbeDecodeToState)->stack);
+  EXPECT_NE("", IRAcUtils::resultAcToString(&irsend.capture));
+  EXPECT_EQ(1, getMemoryProfile(kMemProbeResultAcToString)->calls);
+  EXPECT_LT(0, getMemoryProfile(kMemProbeResultAcToString)->heap);
+  const String report = memoryProfileToString();
+  EXPECT_NE(std::string::npos, report.find("IRrecv::decode(): 2 calls, "));
+  EXPECT_NE(std::string::npos, report.find("IRac::sendAc(): 1 calls, "));
+  EXPECT_NE(std::string::npos, report.find("resultToSourceCode(): 1 calls, "));
+
+  // Nothing more is recorded once it is disabled.
+  disableMemoryProfiling();
+  irrecv.decode(&irsend.capture);
+  EXPECT_EQ(2, getMemoryProfile(kMemProbeDecode)->calls);
+  resetMemoryProfile();
+  EXPECT_EQ(0, getMemoryProfile(kMemProbeDecode)->calls);
+  EXPECT_FALSE(enableMemoryProfiling(0));
+}
+#endif  // ENABLE_MEMORY_PROFILING
+
 TEST(TestInvertBits, Normal) {
   ASSERT_EQ(0xAAAA5555AAAA5555, invertBits(0x5555AAAA5555AAAA, 64));
   ASSERT_EQ(0xAAAA5555, invertBits(0x5555AAAA, 32));
@@ -397,10 +819,95 @@ TEST(TestCountBits, Integer) {
   ASSERT_EQ(0, countBits(data, 64, false));
 }
 
+// The word-at-a-time checksums need to give the same results as a simple byte
+// by byte loop, no matter the alignment or length of the data.
+TEST(TestChecksums, SameAsByteByByte) {
+  uint8_t data[67];
+  for (uint8_t i = 0; i < sizeof(data); i++) data[i] = i * 37 + 0xB5;
+  for (uint8_t offset = 0; offset < 4; offset++) {
+    for (uint16_t length = 0; length + offset <= sizeof(data); length++) {
+      const uint8_t *start = data + offset;
+      uint8_t sum = 0x5A;
+      uint8_t xored = 0x5A;
+      uint8_t nibbles = 0x5A;
+      uint8_t low = 0x5A;
+      uint8_t high = 0x5A;
+      uint16_t ones = 3;
+      for (uint16_t i = 0; i < length; i++) {
+        sum += start[i];
+        xored ^= start[i];
+        nibbles += (start[i] >> 4) + (start[i] & 0xF);
+        low += start[i] & 0xF;
+        high += start[i] >> 4;
+        for (uint8_t bit = 0; bit < 8; bit++) ones += (start[i] >> bit) & 1;
+      }
+      EXPECT_EQ(sum, sumBytes(start, length, 0x5A));
+      EXPECT_EQ(xored, xorBytes(start, length, 0x5A));
+      EXPECT_EQ(nibbles, irutils::sumNibbles(start, length, 0x5A));
+      EXPECT_EQ(low, irutils::sumLowNibbles(start, length, 0x5A));
+      EXPECT_EQ(high, irutils::sumHighNibbles(start, length, 0x5A));
+      EXPECT_EQ(ones, countBits(start, length, true, 3));
+      if (length) {
+        EXPECT_EQ((uint16_t)(length * 8 - ones),
+                  countBits(start, length, false, 3));
+      }
+    }
+  }
+}
+
+TEST(TestChecksums, Sections) {
+  const irutils::checksum_t sections[] = {
+      {irutils::kSumBytesChecksum, 0, 4, 0},
+      {irutils::kXorBytesChecksum, 4, 3, 0x5A},
+      {irutils::kSumNibblesChecksum, 7, irutils::kChecksumToEnd, 1}};
+  uint8_t state[12] = {0x11, 0x22, 0x33, 0, 0xF0, 0x0F, 0,
+                       0x12, 0x34, 0x56, 0x78, 0};
+  EXPECT_FALSE(irutils::validChecksums(sections, 3, state, sizeof(state)));
+  irutils::setChecksums(sections, 3, state, sizeof(state));
+  EXPECT_EQ(0x66, state[3]);
+  EXPECT_EQ(0xA5, state[6]);
+  EXPECT_EQ(0x25, state[11]);
+  EXPECT_TRUE(irutils::validChecksums(sections, 3, state, sizeof(state)));
+  EXPECT_EQ(0x25, irutils::calcChecksum(sections[2], state, sizeof(state)));
+  // Too short for the last section to have any data.
+  EXPECT_FALSE(irutils::validChecksums(sections, 3, state, 8));
+  EXPECT_EQ(0, irutils::calcChecksum(sections[2], state, 8));
+  // Too short for the second section.
+  EXPECT_FALSE(irutils::validChecksums(sections, 2, state, 6));
+  EXPECT_TRUE(irutils::validChecksums(sections, 1, state, 6));
+
+  // Changing a byte should adjust the checksums the same as recalculating.
+  uint8_t expected[sizeof(state)];
+  for (uint16_t i = 0; i < sizeof(state); i++) {
+    if (i == 3 || i == 6 || i == 11) continue;  // Skip the checksum bytes.
+    irutils::updateChecksums(sections, 3, state, sizeof(state), i, i * 29);
+    EXPECT_EQ((uint8_t)(i * 29), state[i]);
+    memcpy(expected, state, sizeof(state));
+    irutils::setChecksums(sections, 3, expected, sizeof(expected));
+    EXPECT_EQ(0, memcmp(expected, state, sizeof(state))) << "Index: " << i;
+  }
+  // Out of range changes are ignored.
+  memcpy(expected, state, sizeof(state));
+  irutils::updateChecksums(sections, 3, state, sizeof(state), sizeof(state), 1);
+  EXPECT_EQ(0, memcmp(expected, state, sizeof(state)));
+}
+
 TEST(TestStrToDecodeType, strToDecodeType) {
   EXPECT_EQ(decode_type_t::NEC, strToDecodeType("NEC"));
   EXPECT_EQ(decode_type_t::KELVINATOR, strToDecodeType("KELVINATOR"));
   EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType("foo"));
+  EXPECT_EQ(decode_type_t::DAIKIN2, strToDecodeType("daikin2"));
+  EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType("DAIKIN2X"));
+  EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType(""));
+  EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType(NULL));
+  // By number.
+  EXPECT_EQ(decode_type_t::NEC, strToDecodeType("3"));
+  EXPECT_EQ(kLastDecodeType,
+            strToDecodeType(uint64ToString(kLastDecodeType).c_str()));
+  EXPECT_EQ(decode_type_t::UNKNOWN,
+            strToDecodeType(uint64ToString(kLastDecodeType + 1).c_str()));
+  EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType("0"));
+  EXPECT_EQ(decode_type_t::UNKNOWN, strToDecodeType("-1"));
 }
 
 TEST(TestUtils, htmlEscape) {
@@ -433,6 +940,33 @@ TEST(TestUtils, TemperatureConversion) {
   ASSERT_EQ(-40.0, fahrenheitToCelsius(-40.0));
 }
 
+TEST(TestUtils, TemperatureConversionTenths) {
+  // Freezing point of water.
+  EXPECT_EQ(320, celsiusToFahrenheitTenths(0));
+  EXPECT_EQ(0, fahrenheitToCelsiusTenths(320));
+  // Boiling point of water.
+  EXPECT_EQ(2120, celsiusToFahrenheitTenths(1000));
+  EXPECT_EQ(1000, fahrenheitToCelsiusTenths(2120));
+  // Room Temp. (RTP)
+  EXPECT_EQ(770, celsiusToFahrenheitTenths(250));
+  EXPECT_EQ(250, fahrenheitToCelsiusTenths(770));
+  // Misc
+  EXPECT_EQ(-400, fahrenheitToCelsiusTenths(-400));
+  EXPECT_EQ(-400, celsiusToFahrenheitTenths(-400));
+  // Rounding to the nearest tenth.
+  EXPECT_EQ(211, fahrenheitToCelsiusTenths(700));  // 21.11C
+  EXPECT_EQ(217, fahrenheitToCelsiusTenths(710));  // 21.67C
+  EXPECT_EQ(-178, fahrenheitToCelsiusTenths(0));  // -17.78C
+  EXPECT_EQ(736, celsiusToFahrenheitTenths(231));  // 73.58F
+  // Agrees with the float versions to within a tenth.
+  for (int16_t f = -400; f <= 2120; f += 7) {
+    EXPECT_NEAR(fahrenheitToCelsius(f / 10.0) * 10,
+                fahrenheitToCelsiusTenths(f), 0.5);
+    EXPECT_NEAR(celsiusToFahrenheit(f / 10.0) * 10,
+                celsiusToFahrenheitTenths(f), 0.5);
+  }
+}
+
 TEST(TestResultToRawArray, TypicalCase) {
   IRsendTest irsend(0);
   IRrecv irrecv(1);
@@ -492,6 +1026,80 @@ TEST(TestResultToRawArray, LargeValues) {
   if (result != NULL) delete[] result;
 }
 
+TEST(TestResultToRawArray, CallerBuffer) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  uint16_t test_data[9] = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+  irsend.begin();
+  irsend.reset();
+  irsend.sendRaw(test_data, 9, 38000);
+  irsend.makeDecodeResult();
+  irrecv.decode(&irsend.capture);
+  irsend.capture.rawbuf[3] = 60000;  // Stick in a large value.
+  uint16_t large_test_data[11] = {
+      10, 20, 65535, 0, 54465, 40, 50, 60, 70, 80, 90};
+  uint16_t result[12] = {0};
+  EXPECT_EQ(11, resultToRawArray(&irsend.capture, result, 12));
+  EXPECT_STATE_EQ(large_test_data, result, 11);
+  EXPECT_EQ(11, resultToRawArray(&irsend.capture, result, 11));
+  // Too small.
+  EXPECT_EQ(0, resultToRawArray(&irsend.capture, result, 10));
+  EXPECT_EQ(0, resultToRawArray(&irsend.capture, result, 3));
+  EXPECT_EQ(0, resultToRawArray(&irsend.capture, result, 0));
+
+  // Resend it straight from the capture. The large mark is sent in one go.
+  uint16_t ticks[9];
+  for (uint16_t i = 0; i < 9; i++) ticks[i] = irsend.capture.rawbuf[i + 1];
+  irsend.reset();
+  irsend.sendRawTicks(ticks, 9, 38, kRawTick);
+  EXPECT_EQ("f38000d50m10s20m120000s40m50s60m70s80m90", irsend.outputStr());
+}
+
+TEST(TestNormaliseCapture, ClustersTheTimings) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  const uint16_t raw[9] = {9010, 4480, 580, 530, 560, 1690, 540, 1710, 600};
+  irsend.sendRaw(raw, 9, 38000);
+  irsend.makeDecodeResult();
+  uint8_t code[32] = {0};
+  // 4 timings, so 2 bits per mark & space.
+  const uint16_t expected_size = 1 + 4 * 2 + 2 + 3;
+  ASSERT_EQ(expected_size, normaliseCapture(&irsend.capture, code, 32));
+  EXPECT_EQ(4, code[0]);
+  EXPECT_EQ(9, normalisedLength(code, expected_size));
+  const uint16_t canonical[9] = {9010, 4480, 562, 562, 562, 1700, 562, 1700,
+                                 562};
+  for (uint16_t i = 0; i < 9; i++)
+    EXPECT_EQ(canonical[i], normalisedDuration(code, i)) << "i = " << i;
+  // Too small.
+  EXPECT_EQ(0, normaliseCapture(&irsend.capture, code, expected_size - 1));
+  EXPECT_EQ(0, normalisedLength(code, expected_size - 1));
+  EXPECT_EQ(0, normalisedLength(code, 0));
+
+  // A smaller margin tells more of them apart.
+  EXPECT_EQ(1 + 6 * 2 + 2 + 5,
+            normaliseCapture(&irsend.capture, code, 32, 20));
+  EXPECT_EQ(6, code[0]);
+  EXPECT_EQ(530, normalisedDuration(code, 3));
+  EXPECT_EQ(550, normalisedDuration(code, 4));
+  EXPECT_EQ(590, normalisedDuration(code, 8));
+
+  // Too many different timings.
+  uint16_t many[kNormalisePaletteMax + 1];
+  for (uint16_t i = 0; i <= kNormalisePaletteMax; i++) many[i] = 1000 * (i + 1);
+  irsend.reset();
+  irsend.sendRaw(many, kNormalisePaletteMax + 1, 38000);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(0, normaliseCapture(&irsend.capture, code, 32));
+  irsend.reset();
+  irsend.sendRaw(many, kNormalisePaletteMax, 38000);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(1 + kNormalisePaletteMax * 2 + 2 + kNormalisePaletteMax / 2,
+            normaliseCapture(&irsend.capture, code, 64));
+  EXPECT_EQ(16000, normalisedDuration(code, 15));
+}
+
 TEST(TestUtils, TypeStringConversionRangeTests) {
   ASSERT_EQ("UNKNOWN", typeToString((decode_type_t)(kLastDecodeType + 1)));
   ASSERT_EQ("UNKNOWN", typeToString(decode_type_t::UNKNOWN));
@@ -504,6 +1112,19 @@ TEST(TestUtils, TypeStringConversionRangeTests) {
   }
 }
 
+TEST(TestUtils, typeToChars) {
+  EXPECT_STREQ("UNKNOWN", typeToChars((decode_type_t)(kLastDecodeType + 1)));
+  EXPECT_STREQ("UNKNOWN", typeToChars(decode_type_t::UNKNOWN));
+  EXPECT_STREQ("UNUSED", typeToChars(decode_type_t::UNUSED));
+  EXPECT_STREQ("NEC", typeToChars(decode_type_t::NEC));
+  EXPECT_STRNE("UNKNOWN", typeToChars(decode_type_t::kLastDecodeType));
+  // The same ptr is always returned. i.e. Nothing is allocated.
+  EXPECT_EQ(typeToChars(decode_type_t::DAIKIN),
+            typeToChars(decode_type_t::DAIKIN));
+  for (int i = 0; i <= kLastDecodeType; i++)
+    EXPECT_EQ(typeToString((decode_type_t)i), typeToChars((decode_type_t)i));
+}
+
 TEST(TestUtils, MinsToString) {
   EXPECT_EQ("00:00", irutils::minsToString(0));
   EXPECT_EQ("00:01", irutils::minsToString(1));
@@ -688,6 +1309,36 @@ TEST(TestUtils, setBits8Bit) {
   EXPECT_EQ(0b11010011, data);
 }
 
+TEST(TestUtils, CompileTimeBits) {
+  uint8_t data = 0b10101010;
+  irutils::setBits<1, 3>(&data, 0b011);
+  EXPECT_EQ(0b10100110, data);
+  EXPECT_EQ(0b011, (irutils::getBits<1, 3>(data)));
+  irutils::setBits<4, 4>(&data, 0xFF);  // Excess bits are discarded.
+  EXPECT_EQ(0b11110110, data);
+  irutils::setBits<0, 8>(&data, 0x5A);
+  EXPECT_EQ(0x5A, data);
+  EXPECT_EQ(0x5A, (irutils::getBits<0, 8>(data)));
+  EXPECT_EQ(1, (irutils::getBits<7, 1>(0x80)));
+
+  // Same results as the runtime versions for all values & fields.
+  for (uint16_t value = 0; value <= UINT8_MAX; value++) {
+    uint8_t runtime = 0xC3;
+    uint8_t compiled = 0xC3;
+    irutils::setBits(&runtime, 2, 5, value);
+    irutils::setBits<2, 5>(&compiled, value);
+    EXPECT_EQ(runtime, compiled);
+    EXPECT_EQ(GETBITS8(value, 2, 5), (irutils::getBits<2, 5>(value)));
+  }
+
+  typedef irutils::StateBits<2, 4, 3> Field;
+  uint8_t state[4] = {0};
+  Field::set(state, 5);
+  EXPECT_EQ(5, Field::get(state));
+  EXPECT_EQ(0b01010000, state[2]);
+  EXPECT_EQ(0, state[0] | state[1] | state[3]);
+}
+
 TEST(TestUtils, setBits64Bit) {
   uint64_t data = 1;
   // Trivial/corner cases.
@@ -777,6 +1428,165 @@ TEST(TestUtils, InvertedBytePairs) {
   EXPECT_STATE_EQ(correct, wrong, 6 * 8);
 }
 
+// Arrays long enough to be checked a word at a time, plus a tail.
+TEST(TestUtils, InvertedBytePairsLongArray) {
+  uint8_t state[19] = {0};  // Last byte is unpaired, so is never checked.
+  irutils::invertBytePairs(state, sizeof(state));
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(state, sizeof(state)));
+  for (uint16_t i = 0; i < sizeof(state) - 1; i++) {
+    state[i] ^= 0x10;
+    EXPECT_FALSE(irutils::checkInvertedBytePairs(state, sizeof(state)));
+    EXPECT_EQ(i >= 8, irutils::checkInvertedBytePairs(state, 8));
+    state[i] ^= 0x10;
+  }
+  state[18] ^= 0x10;
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(state, sizeof(state)));
+}
+
+TEST(TestUtils, InvertedBytePairsInAValue) {
+  const uint64_t correct = 0x00FF01FEAA55;
+  const uint64_t wrong = 0x00FF01FDAA55;
+
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(correct, 48));
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(correct, 32));
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(correct, 16));
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(correct, 0));
+  EXPECT_FALSE(irutils::checkInvertedBytePairs(correct, 64));
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(0x00FF01FEAA557788ULL, 64));
+  EXPECT_FALSE(irutils::checkInvertedBytePairs(wrong, 48));
+  EXPECT_FALSE(irutils::checkInvertedBytePairs(wrong, 32));
+  EXPECT_TRUE(irutils::checkInvertedBytePairs(wrong, 16));
+
+  EXPECT_EQ(0x0001AA, irutils::dropInvertedBytes(correct, 48));
+  EXPECT_EQ(0x01AA, irutils::dropInvertedBytes(correct, 32));
+  EXPECT_EQ(0xAA, irutils::dropInvertedBytes(correct, 16));
+  EXPECT_EQ(0, irutils::dropInvertedBytes(correct, 0));
+  EXPECT_EQ(0x12345678, irutils::dropInvertedBytes(0x12ED34CB56A97887ULL, 64));
+}
+
 TEST(TestUtils, lowLevelSanityCheck) {
   ASSERT_EQ(0, irutils::lowLevelSanityCheck());
 }
+
+TEST(TestUtils, parseValue) {
+  const char *str = " 38000,1, 0x, 12 ,\n14";
+  const char *ptr = str;
+  uint32_t value = 0;
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value));
+  EXPECT_EQ(38000, value);
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value));
+  EXPECT_EQ(1, value);
+  EXPECT_EQ(str + 9, ptr);
+  EXPECT_FALSE(irutils::parseValue(&ptr, &value));  // "0x" isn't decimal.
+  EXPECT_EQ(1, value);
+  EXPECT_EQ(str + 9, ptr);
+  ptr = str + 13;
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value));
+  EXPECT_EQ(12, value);
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value));
+  EXPECT_EQ(14, value);
+  EXPECT_FALSE(irutils::parseValue(&ptr, &value));
+  EXPECT_EQ('\0', *ptr);
+
+  ptr = "0067 00aB,FFFFFFFFF";
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value, 16));
+  EXPECT_EQ(0x67, value);
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value, 16));
+  EXPECT_EQ(0xAB, value);
+  EXPECT_TRUE(irutils::parseValue(&ptr, &value, 16));
+  EXPECT_EQ(UINT32_MAX, value);  // Saturated.
+
+  EXPECT_FALSE(irutils::parseValue(NULL, &value));
+  ptr = NULL;
+  EXPECT_FALSE(irutils::parseValue(&ptr, &value));
+}
+
+TEST(TestUtils, countValues) {
+  EXPECT_EQ(0, irutils::countValues(""));
+  EXPECT_EQ(0, irutils::countValues("  \n"));
+  EXPECT_EQ(3, irutils::countValues("1,2,3"));
+  EXPECT_EQ(3, irutils::countValues("1, 2 ,3,"));
+  EXPECT_EQ(4, irutils::countValues("0000 006D 0022 0002", 16));
+  EXPECT_EQ(-1, irutils::countValues("0000 006D 0022 0002"));
+  EXPECT_EQ(-1, irutils::countValues("1,,2"));
+  EXPECT_EQ(-1, irutils::countValues("1,-2"));
+  EXPECT_EQ(-1, irutils::countValues(NULL));
+}
+
+TEST(TestUtils, base64) {
+  const uint8_t data[] = {'M', 'a', 'n', 0x00, 0xFF, 0xFE};
+  EXPECT_EQ("", irutils::base64Encode(data, 0));
+  EXPECT_EQ("TQ==", irutils::base64Encode(data, 1));
+  EXPECT_EQ("TWE=", irutils::base64Encode(data, 2));
+  EXPECT_EQ("TWFu", irutils::base64Encode(data, 3));
+  EXPECT_EQ("TWFuAP/+", irutils::base64Encode(data, 6));
+
+  uint8_t result[6] = {0};
+  EXPECT_EQ(6, irutils::base64Decode("TWFuAP/+", result, sizeof(result)));
+  EXPECT_EQ(0, memcmp(data, result, sizeof(data)));
+  EXPECT_EQ(2, irutils::base64Decode("TWE=", result, sizeof(result)));
+  EXPECT_EQ('a', result[1]);
+  EXPECT_EQ(1, irutils::base64Decode("TQ", result, sizeof(result)));
+  EXPECT_EQ('M', result[0]);
+  EXPECT_EQ(0, irutils::base64Decode("", result, sizeof(result)));
+  EXPECT_EQ(-1, irutils::base64Decode("TWFuAP/+", result, 5));  // Too small.
+  EXPECT_EQ(-1, irutils::base64Decode("TWF", result, 1));
+  EXPECT_EQ(-1, irutils::base64Decode("T", result, sizeof(result)));
+  EXPECT_EQ(-1, irutils::base64Decode("TW-u", result, sizeof(result)));
+  EXPECT_EQ(-1, irutils::base64Decode("TQ==TQ==", result, sizeof(result)));
+  EXPECT_EQ(-1, irutils::base64Decode(NULL, result, sizeof(result)));
+}
+
+TEST(TestUtils, claimRmtBlocks) {
+  // e.g. A receiver on channel 6, wanting its block & channel 7's.
+  EXPECT_TRUE(irutils::claimRmtBlocks(6, 2));
+  EXPECT_FALSE(irutils::claimRmtBlocks(7, 1));  // So a sender can't have 7.
+  EXPECT_FALSE(irutils::claimRmtBlocks(5, 2));
+  EXPECT_TRUE(irutils::claimRmtBlocks(0, 2));
+  EXPECT_TRUE(irutils::claimRmtBlocks(2, 4));
+  EXPECT_FALSE(irutils::claimRmtBlocks(0, 1));  // All in use.
+  irutils::releaseRmtBlocks(6, 2);
+  EXPECT_TRUE(irutils::claimRmtBlocks(7, 1));
+  EXPECT_FALSE(irutils::claimRmtBlocks(6, 2));  // Only part of it is free.
+  EXPECT_TRUE(irutils::claimRmtBlocks(6, 1));
+  // Out of range.
+  EXPECT_FALSE(irutils::claimRmtBlocks(0, 0));
+  EXPECT_FALSE(irutils::claimRmtBlocks(8, 1));
+  EXPECT_FALSE(irutils::claimRmtBlocks(7, 2));
+  irutils::releaseRmtBlocks(0, kESP32RmtChannels);
+  EXPECT_TRUE(irutils::claimRmtBlocks(0, kESP32RmtChannels));
+  irutils::releaseRmtBlocks(0, kESP32RmtChannels);
+}
+
+// The in-place versions should append exactly what the String versions return.
+TEST(TestUtils, inPlaceAddToString) {
+  String result = "Start";
+  irutils::addBoolToString(&result, true, "Power", false);
+  irutils::addIntToString(&result, 65535, "Model");
+  irutils::addTempToString(&result, 25, false);
+  irutils::addModeToString(&result, 2, 1, 2, 3, 4, 5);
+  irutils::addFanToString(&result, 9, 1, 2, 3, 4, 5);
+  irutils::addDayToString(&result, 1, -1);
+  irutils::addDayToString(&result, 7);
+  irutils::addModelToString(&result, decode_type_t::GREE,
+                            gree_ac_remote_model_t::YBOFB);
+  irutils::addLabeledString(&result, "Bar", "Foo");
+  irutils::addLabeledString(&result, String("Qux"), "Baz", false);
+  EXPECT_EQ(
+      "Start" +
+      irutils::addBoolToString(true, "Power", false) +
+      irutils::addIntToString(65535, "Model") +
+      irutils::addTempToString(25, false) +
+      irutils::addModeToString(2, 1, 2, 3, 4, 5) +
+      irutils::addFanToString(9, 1, 2, 3, 4, 5) +
+      irutils::addDayToString(1, -1) +
+      irutils::addDayToString(7) +
+      irutils::addModelToString(decode_type_t::GREE,
+                                gree_ac_remote_model_t::YBOFB) +
+      irutils::addLabeledString("Bar", "Foo") +
+      irutils::addLabeledString("Qux", "Baz", false),
+      result);
+  EXPECT_EQ("StartPower: On, Model: 65535, Temp: 25F, Mode: 2 (Cool), "
+            "Fan: 9 (UNKNOWN), Day: 1 (Sun), Day: 7 (UNKNOWN), "
+            "Model: 2 (YBOFB), Foo: BarBaz: Qux", result);
+}
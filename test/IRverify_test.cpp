@@ -0,0 +1,171 @@
+// Copyright 2026 The IRremoteESP8266 authors
+
+#include "IRverify.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+#include "ir_NEC.h"
+#include "simulated_channel.h"
+
+// Tests for the IRverify class.
+
+// The wait for a message's capture, after it has been sent.
+const uint32_t kWait = MS_TO_USEC(kTimeoutMs) + kVerifyDefaultMargin;
+
+// Transmit what was sent, as it was sent. i.e. Starting before the (blocking)
+// send returned, & advanced the clock.
+void transmit(SimulatedChannel *channel, IRsendTest *irsend) {
+  uint32_t duration = 0;
+  for (uint16_t i = 0; i <= irsend->last && i < OUTPUT_BUF; i++)
+    duration += irsend->output[i];
+  _IRtimer_unittest_now -= duration;
+  channel->transmit(irsend);
+}
+
+TEST(TestIRverify, VerifiedFirstTime) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0, 1024, 50, true);  // Long enough for A/C messages.
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  channel.impairments = kTypicalChannel;
+  IRverify verify(&irsend, &irrecv);
+  EXPECT_FALSE(verify.isBusy());
+  EXPECT_FALSE(verify.handle());  // Nothing is being sent.
+
+  ASSERT_TRUE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits, 3));
+  EXPECT_TRUE(verify.isBusy());
+  EXPECT_EQ(1, verify.getSent());  // Only the one, not the repeats.
+  EXPECT_EQ(kNECBits * 2 + 4, irsend.last + 1);
+  // Only one message at a time.
+  EXPECT_FALSE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits));
+  transmit(&channel, &irsend);
+  EXPECT_FALSE(verify.handle());  // Still arriving.
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(verify.handle());
+  EXPECT_FALSE(verify.isBusy());
+  EXPECT_TRUE(verify.isVerified());
+  EXPECT_EQ(1, verify.getSent());
+  EXPECT_EQ(1, verify.getVerified());
+  EXPECT_EQ(3, verify.getSaved());
+  EXPECT_EQ(0, verify.getExtra(decode_type_t::NEC));
+  EXPECT_EQ(0, irsend.last);  // Nothing more was sent.
+
+  // A state[] message.
+  const uint8_t state[kSamsungAcStateLength] = {
+      0x02, 0x92, 0x0F, 0x00, 0x00, 0x00, 0xF0,
+      0x01, 0x02, 0xAF, 0x71, 0x00, 0x15, 0xF0};
+  ASSERT_TRUE(verify.send(decode_type_t::SAMSUNG_AC, state,
+                          kSamsungAcStateLength));
+  transmit(&channel, &irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(verify.handle());
+  EXPECT_TRUE(verify.isVerified());
+  EXPECT_EQ(2, verify.getVerified());
+
+  // Unknown protocols can't be verified, so aren't sent.
+  EXPECT_FALSE(verify.send(decode_type_t::UNKNOWN, 1, 8));
+  EXPECT_FALSE(verify.isBusy());
+}
+
+TEST(TestIRverify, RepeatedAndLearned) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0, 1024, kTimeoutMs, true);
+  irsend.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  channel.impairments = kTypicalChannel;
+  IRverify verify(&irsend, &irrecv);
+
+  // The first is lost. e.g. It collided with another.
+  ASSERT_TRUE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits, 2));
+  irsend.reset();
+  EXPECT_FALSE(channel.run(kWait - 1));
+  EXPECT_FALSE(verify.handle());
+  EXPECT_EQ(1, verify.getSent());
+  EXPECT_FALSE(channel.run(1));
+  EXPECT_FALSE(verify.handle());  // The wait is over, so it is repeated.
+  EXPECT_EQ(2, verify.getSent());
+  transmit(&channel, &irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(verify.handle());
+  EXPECT_TRUE(verify.isVerified());
+  EXPECT_EQ(1, verify.getSaved());
+  // So this spot usually needs another copy of them.
+  EXPECT_EQ(1, verify.getExtra(decode_type_t::NEC));
+  EXPECT_EQ(0, verify.getExtra(decode_type_t::SONY));
+
+  // Both are sent straight away, & both are captured before it is done.
+  ASSERT_TRUE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits, 2));
+  EXPECT_EQ(2, verify.getSent());
+  transmit(&channel, &irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  EXPECT_FALSE(verify.handle());
+  ASSERT_TRUE(channel.run(1000000));
+  EXPECT_FALSE(verify.handle());
+  EXPECT_EQ(kIdleState, irrecv._params->rcvstate);  // It was consumed.
+  EXPECT_FALSE(channel.run(kWait));
+  EXPECT_FALSE(verify.handle());  // Until the wait after the last is over.
+  EXPECT_FALSE(channel.run(kNecMinCommandLength));
+  ASSERT_TRUE(verify.handle());
+  EXPECT_TRUE(verify.isVerified());
+  EXPECT_EQ(2, verify.getSent());
+
+  // Never more than the repeats asked for.
+  ASSERT_TRUE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits));
+  EXPECT_EQ(1, verify.getSent());
+  irsend.reset();
+  EXPECT_FALSE(channel.run(kWait));
+  ASSERT_TRUE(verify.handle());
+  EXPECT_FALSE(verify.isVerified());
+  EXPECT_EQ(1, verify.getFailed());
+  EXPECT_EQ(1, verify.getExtra(decode_type_t::NEC));
+
+  // When enough get through without them, fewer are sent.
+  for (uint8_t i = 0; i < kVerifyStableSends; i++) {
+    ASSERT_TRUE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits, 1));
+    EXPECT_EQ(2, verify.getSent());
+    transmit(&channel, &irsend);
+    ASSERT_TRUE(channel.run(1000000));
+    EXPECT_FALSE(verify.handle());
+    ASSERT_TRUE(channel.run(1000000));
+    EXPECT_FALSE(verify.handle());
+    EXPECT_FALSE(channel.run(1000000));
+    ASSERT_TRUE(verify.handle());
+    EXPECT_TRUE(verify.isVerified());
+  }
+  EXPECT_EQ(0, verify.getExtra(decode_type_t::NEC));
+}
+
+TEST(TestIRverify, WrongMessage) {
+  IRsendTest irsend(0);
+  IRsendTest other(1);
+  IRrecv irrecv(0, 1024, kTimeoutMs, true);
+  irsend.begin();
+  other.begin();
+  irrecv.enableIRIn();
+  _IRtimer_unittest_now = 0;
+  SimulatedChannel channel(&irrecv);
+  IRverify verify(&irsend, &irrecv);
+
+  // Something else was captured, rather than ours.
+  other.sendNEC(0x807F00FF);
+  ASSERT_TRUE(verify.send(decode_type_t::NEC, 0x807F40BF, kNECBits, 1));
+  irsend.reset();
+  transmit(&channel, &other);
+  ASSERT_TRUE(channel.run(1000000));
+  EXPECT_FALSE(verify.handle());
+  EXPECT_FALSE(channel.run(1000000));
+  EXPECT_FALSE(verify.handle());
+  EXPECT_EQ(2, verify.getSent());  // So it was repeated.
+  transmit(&channel, &irsend);
+  ASSERT_TRUE(channel.run(1000000));
+  ASSERT_TRUE(verify.handle());
+  EXPECT_TRUE(verify.isVerified());
+}
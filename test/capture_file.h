@@ -0,0 +1,129 @@
+// Host helpers to read & write capture files. See irutils::CaptureWriter.
+// Copyright 2026 The IRremoteESP8266 authors
+
+#ifndef TEST_CAPTURE_FILE_H_
+#define TEST_CAPTURE_FILE_H_
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "IRrecv.h"
+#include "IRutils.h"
+
+// Nr. of captures a file written by CaptureFileWriter can have an index of.
+// Any more, & it has no index. It can still be read then, just in order.
+const uint32_t kCaptureFileMaxIndex = 1 << 16;
+
+/// A capture file, mmap()'ed so its captures can be read in place.
+class MappedCaptureFile {
+ public:
+  MappedCaptureFile(void) : _data(NULL), _size(0) {}
+  ~MappedCaptureFile(void) { close(); }
+
+  /// Map a capture file.
+  /// @param[in] path The file.
+  /// @return true, if it could be mapped, & looks like a capture file.
+  bool open(const char *path) {
+    close();
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0 &&
+        (uint64_t)info.st_size <= UINT32_MAX) {
+      void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        _data = static_cast<const uint8_t *>(data);
+        _size = info.st_size;
+      }
+    }
+    ::close(fd);
+    return reader().valid();
+  }
+
+  /// Unmap the file, if one is mapped.
+  void close(void) {
+    if (_data != NULL) munmap(const_cast<uint8_t *>(_data), _size);
+    _data = NULL;
+    _size = 0;
+  }
+
+  /// @return A reader of the captures in the file. Valid while it is open.
+  irutils::CaptureReader reader(void) const {
+    return irutils::CaptureReader(_data, _size);
+  }
+
+ private:
+  const uint8_t *_data;
+  uint32_t _size;
+  MappedCaptureFile(const MappedCaptureFile &);
+  MappedCaptureFile &operator=(const MappedCaptureFile &);
+};
+
+/// Writes a capture file, a capture at a time, so it can be of any length.
+/// Each capture is written as soon as it is added, so if the writer is never
+/// closed (e.g. it is killed) the file is still readable, just without an
+/// index.
+class CaptureFileWriter {
+ public:
+  CaptureFileWriter(void) : _file(NULL), _writer(NULL, 0) {}
+  ~CaptureFileWriter(void) { close(); }
+
+  /// Create a capture file.
+  /// @param[in] path The file.
+  /// @return true, if it could be created.
+  bool open(const char *path) {
+    close();
+    _file = fopen(path, "wb");
+    if (_file == NULL) return false;
+    // Room for the largest capture possible.
+    _buffer.resize(kCaptureRecordHeaderSize + 3 * (UINT16_MAX + 1));
+    _index.resize(kCaptureFileMaxIndex);
+    _writer = irutils::CaptureWriter(_buffer.data(), _buffer.size(),
+                                     _index.data(), _index.size());
+    _writer.begin();
+    return save();
+  }
+
+  /// Add a capture to the file.
+  /// @param[in] results The capture.
+  /// @param[in] frequency The carrier frequency, in kHz.
+  /// @param[in] timestamp When it was captured.
+  /// @return true, if it was written.
+  bool add(const decode_results *results, const uint16_t frequency = 38,
+           const uint32_t timestamp = 0) {
+    return _file != NULL && _writer.add(results, frequency, timestamp) &&
+        save();
+  }
+
+  /// Finish the file. i.e. Write its index, & close it.
+  /// @return true, if it was all written.
+  bool close(void) {
+    if (_file == NULL) return false;
+    _writer.end();
+    bool ok = save();
+    ok &= fclose(_file) == 0;
+    _file = NULL;
+    return ok;
+  }
+
+ private:
+  FILE *_file;
+  std::vector<uint8_t> _buffer;
+  std::vector<uint32_t> _index;
+  irutils::CaptureWriter _writer;
+  CaptureFileWriter(const CaptureFileWriter &);
+  CaptureFileWriter &operator=(const CaptureFileWriter &);
+
+  /// Write out what has been added since the last time.
+  bool save(void) {
+    const bool ok = fwrite(_buffer.data(), 1, _writer.pending(), _file) ==
+        _writer.pending() && fflush(_file) == 0;
+    _writer.flush();
+    return ok;
+  }
+};
+
+#endif  // TEST_CAPTURE_FILE_H_
@@ -0,0 +1,305 @@
+// A fuzzing harness for IRrecv::decode(), to find crashes & slow inputs.
+// Copyright 2026 The IRremoteESP8266 authors
+
+// The input is turned into a capture, which is decoded with every protocol
+// enabled. Its format is:
+//   byte 0:   bits 0-1 are the `max_skip`, bits 2-7 the `noise_floor` / 4.
+//   byte 1-:  The capture's rawbuf[] entries, as little-endian 16 bit ticks.
+//
+// With a fuzzing engine (e.g. libFuzzer, or AFL++ via afl-clang-fast++):
+//   make decode_fuzzer && ./decode_fuzzer -w corpus  # Make a seed corpus.
+//   make clean; make decode_fuzzer CXX=clang++ FUZZER=libfuzzer
+//   ./decode_fuzzer corpus
+// Without one, a built in random (& mutating) fuzzer is used instead. Build
+// it with the sanitizers, so reading past the end of a capture is caught:
+//   make clean; make fuzz FUZZER=asan FUZZ_ARGS="-n 20000 -s 1"
+// Usage of the built in one:
+//   ./decode_fuzzer [-n runs] [-s seed] [-w corpus_dir] [file ...]
+//   -n  Nr. of random inputs to try. Mutations of real messages, mostly.
+//   -s  Seed for the random inputs, so a run can be repeated.
+//   -w  Write a seed corpus (a real message per protocol) to the directory.
+//   Any files given are decoded as inputs, instead of random ones. Capture
+//   files (See capture_file.h) have each of their captures decoded, as is.
+//
+// Either way, the slowest inputs seen are reported when it exits, so the
+// worst case decode time can be tracked. Set the DECODE_FUZZ_SLOWEST
+// environment variable to a path prefix to also save them, for replaying.
+// e.g. DECODE_FUZZ_SLOWEST=/tmp/slow- ./decode_fuzzer -n 100000
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <string>
+#include <vector>
+#include "IRrecv.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "capture_file.h"
+
+const uint16_t kFuzzMaxEntries = 2048;  // Max nr. of rawbuf[] entries used.
+const uint16_t kFuzzBufSize = kFuzzMaxEntries + 1;
+const uint8_t kFuzzSlowest = 10;  // Nr. of the slowest inputs to report.
+
+/// An input that was slow to decode.
+typedef struct {
+  uint64_t nsecs;
+  std::vector<uint8_t> data;
+} slow_input_t;
+
+static std::vector<slow_input_t> slowest;  // Slowest first.
+static uint64_t total_nsecs = 0;
+static uint64_t total_runs = 0;
+
+/// Report (& maybe save) the slowest inputs. Called when the fuzzer exits.
+static void reportSlowest(void) {
+  const char *prefix = getenv("DECODE_FUZZ_SLOWEST");
+  fprintf(stderr, "Decoded %" PRIu64 " inputs, avg. %" PRIu64 " ns/decode.\n",
+          total_runs, total_runs ? total_nsecs / total_runs : 0);
+  fprintf(stderr, "rank,ns,bytes,rawlen,max_skip,noise_floor\n");
+  for (size_t i = 0; i < slowest.size(); i++) {
+    const std::vector<uint8_t> &data = slowest[i].data;
+    fprintf(stderr, "%zu,%" PRIu64 ",%zu,%zu,%u,%u\n", i + 1,
+            slowest[i].nsecs, data.size(),
+            std::min((data.size() - 1) / 2, (size_t)kFuzzMaxEntries),
+            data[0] & 0x3, (data[0] >> 2) * 4);
+    if (prefix == NULL) continue;
+    const std::string name = prefix + uint64ToString(i + 1);
+    FILE *file = fopen(name.c_str(), "wb");
+    if (file == NULL) continue;
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+  }
+}
+
+/// Note how long an input took to decode, keeping the slowest ones.
+static void noteTime(const uint8_t *data, const size_t size,
+                     const uint64_t nsecs) {
+  if (!total_runs++) atexit(reportSlowest);
+  total_nsecs += nsecs;
+  if (slowest.size() == kFuzzSlowest && nsecs <= slowest.back().nsecs) return;
+  if (slowest.empty() || nsecs > slowest.front().nsecs)
+    fprintf(stderr, "New slowest input: %" PRIu64 " ns, %zu bytes.\n",
+            nsecs, size);
+  slow_input_t slow = {nsecs, std::vector<uint8_t>(data, data + size)};
+  std::vector<slow_input_t>::iterator it = slowest.begin();
+  while (it != slowest.end() && it->nsecs >= nsecs) it++;
+  slowest.insert(it, slow);
+  if (slowest.size() > kFuzzSlowest) slowest.pop_back();
+}
+
+/// Decode the fuzzer's input as if it was a capture. The fuzzing engine's
+/// entry point.
+/// @param[in] data The input. See the top of this file for its format.
+/// @param[in] size Nr. of bytes of input.
+/// @return Always 0.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  static IRrecv irrecv(0, kFuzzBufSize);
+  if (size < 3) return 0;
+  const uint8_t max_skip = data[0] & 0x3;
+  const uint16_t noise_floor = (data[0] >> 2) * 4;
+  const uint16_t rawlen = std::min((size - 1) / 2, (size_t)kFuzzMaxEntries);
+  // Exactly the size of a capture, so a decoder reading past the end of it
+  // is caught by the sanitizers. decode() ensures rawbuf[rawlen] is 0.
+  uint16_t *rawbuf = new uint16_t[rawlen + 1];
+  for (uint16_t i = 0; i < rawlen; i++)
+    rawbuf[i] = data[1 + i * 2] | (data[2 + i * 2] << 8);
+  rawbuf[rawlen] = 0;
+  decode_results results;
+  results.rawbuf = rawbuf;
+  results.rawlen = rawlen;
+  results.overflow = false;
+  results.started = 0;
+  results.stopped = 0;
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  irrecv.decode(&results, NULL, max_skip, noise_floor);
+  noteTime(data, size, std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count());
+  delete[] rawbuf;
+  return 0;
+}
+
+#ifndef FUZZING_ENGINE
+/// A pseudo random number generator, so runs with the same seed repeat.
+static uint32_t nextRandom(uint32_t *seed) {
+  *seed = *seed * 1103515245 + 12345;
+  return *seed >> 8;
+}
+
+/// Make an input of a real message of the given protocol.
+/// @return The input. Empty if the protocol can't be sent.
+static std::vector<uint8_t> messageInput(const decode_type_t protocol,
+                                         uint32_t *seed) {
+  std::vector<uint8_t> input;
+  const uint16_t bits = IRsend::defaultBits(protocol);
+  if (!bits || (hasACState(protocol) && bits / 8 > kStateSizeMax))
+    return input;
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  bool sent;
+  if (hasACState(protocol)) {
+    uint8_t state[kStateSizeMax];
+    for (uint16_t i = 0; i < bits / 8; i++) state[i] = nextRandom(seed);
+    sent = irsend.send(protocol, state, bits / 8);
+  } else {
+    const uint64_t value = ((uint64_t)nextRandom(seed) << 32) |
+        nextRandom(seed);
+    sent = irsend.send(protocol, value, bits, kNoRepeat);
+  }
+  if (!sent) return input;
+  irsend.makeDecodeResult();
+  input.push_back(0);  // No skipping or noise filtering.
+  for (uint16_t i = 0; i < std::min(irsend.capture.rawlen, kFuzzMaxEntries);
+       i++) {
+    input.push_back(irsend.capture.rawbuf[i] & 0xFF);
+    input.push_back(irsend.capture.rawbuf[i] >> 8);
+  }
+  return input;
+}
+
+/// Make a random input. Usually a mangled real message, sometimes junk.
+static std::vector<uint8_t> randomInput(uint32_t *seed) {
+  std::vector<uint8_t> input;
+  if (nextRandom(seed) % 8) {
+    input = messageInput((decode_type_t)(1 + nextRandom(seed) %
+                                         kLastDecodeType), seed);
+  }
+  if (input.size() < 3) {  // Junk then.
+    input.resize(1 + 2 * (1 + nextRandom(seed) % kFuzzMaxEntries));
+    for (size_t i = 0; i < input.size(); i++) input[i] = nextRandom(seed);
+    return input;
+  }
+  const uint16_t entries = (input.size() - 1) / 2;
+  switch (nextRandom(seed) % 4) {
+    case 0:  // Stretch or shrink the timings.
+      for (uint16_t i = 1; i <= entries; i++) {
+        uint32_t ticks = input[i * 2 - 1] | (input[i * 2] << 8);
+        ticks = std::min(ticks * (80 + nextRandom(seed) % 41) / 100,
+                         (uint32_t)UINT16_MAX);
+        input[i * 2 - 1] = ticks & 0xFF;
+        input[i * 2] = ticks >> 8;
+      }
+      break;
+    case 1:  // Truncate it.
+      input.resize(1 + 2 * (1 + nextRandom(seed) % entries));
+      break;
+    case 2:  // Skip & filter noise.
+      input[0] = nextRandom(seed);
+      break;
+  }
+  // Mangle a few bytes of it.
+  for (uint8_t n = nextRandom(seed) % 4; n; n--)
+    input[1 + nextRandom(seed) % (input.size() - 1)] = nextRandom(seed);
+  return input;
+}
+
+/// Write a file per protocol, of a real message of it.
+/// @return true, if they were all written.
+static bool writeCorpus(const std::string &dir) {
+  uint32_t seed = 1;
+  for (int i = 1; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    const std::vector<uint8_t> input = messageInput(protocol, &seed);
+    if (input.empty()) continue;
+    const std::string name = dir + "/" + typeToString(protocol).c_str();
+    FILE *file = fopen(name.c_str(), "wb");
+    if (file == NULL) return false;
+    fwrite(input.data(), 1, input.size(), file);
+    fclose(file);
+  }
+  return true;
+}
+
+/// Decode each capture in a capture file as an input.
+/// @return Nr. of captures decoded.
+static uint32_t decodeCaptures(const MappedCaptureFile &captures) {
+  irutils::CaptureReader reader = captures.reader();
+  irutils::capture_t capture;
+  std::vector<uint16_t> rawbuf(kFuzzMaxEntries);
+  uint32_t count = 0;
+  while (reader.next(&capture)) {
+    const uint16_t rawlen = irutils::CaptureReader::unpack(
+        capture, rawbuf.data(), kFuzzMaxEntries);
+    std::vector<uint8_t> input(1, 0);  // No skipping or noise filtering.
+    for (uint16_t i = 0; i < rawlen; i++) {
+      input.push_back(rawbuf[i] & 0xFF);
+      input.push_back(rawbuf[i] >> 8);
+    }
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    count++;
+  }
+  return count;
+}
+
+/// Decode the contents of a file as an input, or its captures if it is a
+/// capture file.
+/// @return true, if the file could be read.
+static bool decodeFile(const char *name) {
+  MappedCaptureFile captures;
+  if (captures.open(name)) {
+    decodeCaptures(captures);
+    return true;
+  }
+  FILE *file = fopen(name, "rb");
+  if (file == NULL) return false;
+  std::vector<uint8_t> input;
+  int c;
+  while ((c = fgetc(file)) != EOF) input.push_back(c);
+  fclose(file);
+  LLVMFuzzerTestOneInput(input.data(), input.size());
+  return true;
+}
+
+void usage_error(char *name) {
+  fprintf(stderr, "Usage: %s [-n runs] [-s seed] [-w corpus_dir] [file ...]\n"
+          "Decodes random (or the given) captures & reports the slowest.\n",
+          name);
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t runs = 10000;
+  uint32_t seed = 1;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp("-w", argv[i]) == 0 && i + 1 < argc) {
+      if (writeCorpus(argv[++i])) return 0;
+      fprintf(stderr, "Can't write the corpus to: %s\n", argv[i]);
+      return 1;
+    }
+    if ((strcmp("-n", argv[i]) && strcmp("-s", argv[i])) || i + 1 >= argc) {
+      usage_error(argv[0]);
+      return 1;
+    }
+    char *end;
+    errno = 0;
+    intmax_t val = strtoimax(argv[i + 1], &end, 10);
+    if (errno == ERANGE || val < 0 || val > UINT32_MAX || *end != '\0') {
+      usage_error(argv[0]);
+      return 1;
+    }
+    if (argv[i++][1] == 'n')
+      runs = val;
+    else
+      seed = val;
+  }
+  if (i < argc) {  // Decode the files given.
+    for (; i < argc; i++)
+      if (!decodeFile(argv[i])) {
+        fprintf(stderr, "Can't read: %s\n", argv[i]);
+        return 1;
+      }
+    return 0;
+  }
+  for (uint32_t n = 0; n < runs; n++) {
+    const std::vector<uint8_t> input = randomInput(&seed);
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+  }
+  return 0;
+}
+#endif  // FUZZING_ENGINE
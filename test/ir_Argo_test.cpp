@@ -221,6 +221,31 @@ TEST(TestArgoACClass, Max) {
   ASSERT_FALSE(ac.getMax());
 }
 
+TEST(TestArgoACClass, SensorTemp) {
+  IRArgoAC ac(kGpioUnused);
+  IRsendTest irsend(kGpioUnused);
+  uint8_t report[kArgoShortStateLength];
+
+  IRArgoAC::encodeSensorTemp(25, report);
+  const uint8_t expected[kArgoShortStateLength] = {0xAC, 0xF5, 0xAB, 0x4A};
+  EXPECT_STATE_EQ(expected, report, kArgoShortBits);
+  IRArgoAC::encodeSensorTemp(0, report);  // Below the min.
+  EXPECT_EQ(0x03, report[2]);
+  IRArgoAC::encodeSensorTemp(99, report);  // Above the max.
+  EXPECT_EQ(0xFB, report[2]);
+
+  // Only the short report is sent, & the state is left alone.
+  ac.begin();
+  ac.setTemp(22);
+  ac._irsend.reset();
+  ac.sendSensorTemp(25);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendArgo(expected, kArgoShortStateLength);
+  EXPECT_EQ(irsend.outputStr(), ac._irsend.outputStr());
+  EXPECT_EQ(22, ac.getTemp());
+}
+
 TEST(TestUtils, Housekeeping) {
   ASSERT_EQ("ARGO", typeToString(decode_type_t::ARGO));
   ASSERT_EQ(decode_type_t::ARGO, strToDecodeType("ARGO"));
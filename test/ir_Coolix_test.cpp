@@ -203,6 +203,50 @@ TEST(TestSendCoolix, SendUnusualSize) {
   EXPECT_EQ("", irsend.outputStr());
 }
 
+// The marks & spaces of a 24 bit message, encoded bit by bit.
+std::string coolixMessage(const uint32_t code) {
+  std::string message = "m4692s4416";
+  for (int8_t shift = 16; shift >= 0; shift -= 8) {
+    const uint8_t segment = code >> shift;
+    for (int8_t bit = 7; bit >= 0; bit--)  // Normal.
+      message += ((segment >> bit) & 1) ? "m552s1656" : "m552s552";
+    for (int8_t bit = 7; bit >= 0; bit--)  // Inverted.
+      message += ((segment >> bit) & 1) ? "m552s552" : "m552s1656";
+  }
+  return message;
+}
+
+// The precompiled special commands must be sent as if they were encoded.
+TEST(TestSendCoolix, PrecompiledSpecialCommands) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  const uint32_t specials[] = {kCoolixOff, kCoolixSwing, kCoolixTurbo,
+                               kCoolixLed, kCoolixClean, kCoolixSleep};
+  for (const uint32_t code : specials) {
+    irsend.reset();
+    irsend.sendCOOLIX(code);
+    EXPECT_EQ("f38000d50" + coolixMessage(code) + "m552s5244" +
+              coolixMessage(code) + "m552s105244", irsend.outputStr());
+  }
+}
+
+TEST(TestSendCoolix, SendSequence) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  const uint32_t codes[] = {kCoolixSwing, kCoolixTurbo, kCoolixDefaultState};
+
+  irsend.reset();
+  irsend.sendCOOLIXSequence(codes, 3, kNoRepeat);
+  // Only the minimum gap between each message, & a full one at the end.
+  EXPECT_EQ("f38000d50" + coolixMessage(kCoolixSwing) + "m552s5244" +
+            coolixMessage(kCoolixTurbo) + "m552s5244" +
+            coolixMessage(kCoolixDefaultState) + "m552s105244",
+            irsend.outputStr());
+  irsend.reset();
+  irsend.sendCOOLIXSequence(codes, 0);
+  EXPECT_EQ("", irsend.outputStr());
+}
+
 // Tests for decodeCOOLIX().
 
 // Decode normal Coolix messages.
@@ -854,3 +898,29 @@ TEST(TestCoolixACClass, PowerStateWithSetRaw) {
   ASSERT_FALSE(ac.getPower());
   EXPECT_FALSE(ac.toCommon().power);
 }
+
+TEST(TestCoolixACClass, SendSensorTemp) {
+  IRCoolixAC ac(kGpioUnused);
+  IRrecv capture(kGpioUnused);
+  ac.begin();
+  ac.setPower(true);
+  ac.setMode(kCoolixCool);
+  ac.setTemp(24);
+  ac._irsend.reset();
+  ac.sendSensorTemp(19);
+  ac._irsend.makeDecodeResult();
+  ASSERT_TRUE(capture.decode(&ac._irsend.capture));
+  ASSERT_EQ(COOLIX, ac._irsend.capture.decode_type);
+  IRCoolixAC decoded(kGpioUnused);
+  decoded.setRaw(ac._irsend.capture.value);
+  EXPECT_EQ(24, decoded.getTemp());
+  EXPECT_EQ(19, decoded.getSensorTemp());
+  EXPECT_TRUE((ac._irsend.capture.value >> kCoolixZoneFollowMaskOffset) & 1);
+  EXPECT_EQ(19, ac.getSensorTemp());
+
+  // Nothing is reported while it is off.
+  ac.setPower(false);
+  ac._irsend.reset();
+  ac.sendSensorTemp(19);
+  EXPECT_EQ("", ac._irsend.outputStr());
+}
@@ -3723,3 +3723,36 @@ TEST(TestDecodeDaikin64, Issue1092) {
   stdAc::state_t result, prev;
   ASSERT_TRUE(IRAcUtils::decodeToState(&irsend.capture, &result, &prev));
 }
+
+// The settings shared by the Daikin protocols, via a layout descriptor.
+TEST(TestDaikinClass, SharedLayout) {
+  // Power in byte 0, mode in the high nibble of byte 0, fan in the low nibble
+  // of byte 1, & the temperature in bits 1-6 of byte 2, 10C based.
+  const daikin_layout_t layout = {0, 0, kHighNibble, 1, kLowNibble,
+                                  2, 1, 6, 10};
+  uint8_t state[3] = {0x00, 0xF0, 0x01};
+
+  daikin::setPower(state, layout, true);
+  EXPECT_TRUE(daikin::getPower(state, layout));
+  EXPECT_EQ(0x01, state[0]);
+  daikin::setPower(state, layout, false);
+  EXPECT_FALSE(daikin::getPower(state, layout));
+
+  EXPECT_EQ(kDaikinCool, daikin::setMode(state, layout, kDaikinCool));
+  EXPECT_EQ(kDaikinCool, daikin::getMode(state, layout));
+  // Unknown modes are set as Auto.
+  EXPECT_EQ(kDaikinAuto, daikin::setMode(state, layout, 7));
+  EXPECT_EQ(kDaikinAuto, daikin::getMode(state, layout));
+
+  daikin::setFan(state, layout, kDaikinFanMax);
+  EXPECT_EQ(kDaikinFanMax, daikin::getFan(state, layout));
+  EXPECT_EQ(0xF7, state[1]);  // The high nibble is left alone.
+  daikin::setFan(state, layout, kDaikinFanQuiet);
+  EXPECT_EQ(kDaikinFanQuiet, daikin::getFan(state, layout));
+  daikin::setFan(state, layout, 0);  // Out of range.
+  EXPECT_EQ(kDaikinFanAuto, daikin::getFan(state, layout));
+
+  daikin::setTemp(state, layout, 25);
+  EXPECT_EQ(25, daikin::getTemp(state, layout));
+  EXPECT_EQ((25 - 10) << 1 | 0x01, state[2]);  // Bit 0 is left alone.
+}
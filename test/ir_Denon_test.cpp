@@ -292,3 +292,82 @@ TEST(TestDecodeDenon, FailToDecodeNonDenonExample) {
   ASSERT_FALSE(irrecv.decodeDenon(&irsend.capture, kStartOffset, kDenon48Bits,
                                   false));
 }
+
+// Denon & Panasonic share the one Kaseikyo match, & Denon & Sharp share the one
+// Sharp match, when decode() tries them at the same offset.
+TEST(TestDecodeDenon, SharedFamilyMatches) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendPanasonic64(0x40040190ED7C);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(PANASONIC, irsend.capture.decode_type);
+  EXPECT_EQ(0x40040190ED7C, irsend.capture.value);
+#if ENABLE_FAMILY_MATCH_CACHE
+  EXPECT_EQ(kStartOffset, irrecv._kaseikyo_offset);
+  EXPECT_NE(0, irrecv._kaseikyo_used);
+  EXPECT_EQ(0x40040190ED7C, irrecv._kaseikyo_data);
+  // Only kept for use inside decode().
+  EXPECT_FALSE(irrecv._family_cache);
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+
+  irsend.reset();
+  irsend.sendDenon(0x2A4C028D6CE3, kDenon48Bits);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(DENON, irsend.capture.decode_type);
+  EXPECT_EQ(0x2A4C028D6CE3, irsend.capture.value);
+  // A direct call isn't fooled by what decode() matched before.
+  irsend.reset();
+  irsend.sendPanasonic64(0x40040190ED7C);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodeDenon(&irsend.capture, kStartOffset,
+                                  kDenon48Bits));
+  EXPECT_TRUE(irrecv.decodePanasonic(&irsend.capture));
+
+  irsend.reset();
+  irsend.sendSharpRaw(0x454A, kSharpBits);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SHARP, irsend.capture.decode_type);
+  EXPECT_EQ(0x454A, irsend.capture.value);
+#if ENABLE_FAMILY_MATCH_CACHE
+  // Denon tried the Sharp match first.
+  EXPECT_EQ(kStartOffset, irrecv._sharp_offset);
+  EXPECT_EQ(0x454A, irrecv._sharp_data);
+#endif  // ENABLE_FAMILY_MATCH_CACHE
+
+  irsend.reset();
+  irsend.sendDenon(0x2278);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(DENON, irsend.capture.decode_type);
+  EXPECT_EQ(0x2278, irsend.capture.value);
+}
+
+#if ENABLE_PROTOCOL_TOLERANCE
+// A family member with a tolerance of its own doesn't reuse the match of one
+// tried before it with another tolerance. e.g. Denon is tried before Panasonic.
+TEST(TestDecodeDenon, SharedFamilyMatchesWithProtocolTolerance) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendPanasonic64(0x40040190ED7C);
+  irsend.makeDecodeResult();
+  // Stretch the one spaces by 45%.
+  for (uint16_t i = 4; i < irsend.capture.rawlen - 1; i += 2)
+    if (irsend.capture.rawbuf[i] > 1000 / kRawTick)
+      irsend.capture.rawbuf[i] = irsend.capture.rawbuf[i] * 145 / 100;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_NE(PANASONIC, irsend.capture.decode_type);
+  ASSERT_TRUE(irrecv.setProtocolTolerance(PANASONIC, 60));
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(PANASONIC, irsend.capture.decode_type);
+  EXPECT_EQ(0x40040190ED7C, irsend.capture.value);
+}
+#endif  // ENABLE_PROTOCOL_TOLERANCE
@@ -71,3 +71,45 @@ TEST(TestSendGlobalCache, RepeatCode) {
       "m8866s2210m546s94822",
       irsend.outputStr());
 }
+
+// Test sending straight from the text form of a code.
+TEST(TestSendGlobalCache, FromString) {
+  IRsendTest irsend(4);
+  IRsendTest expected(4);
+  IRrecv irrecv(4);
+  irsend.begin();
+  expected.begin();
+
+  // Sherwood (NEC-like) "Power On" from Global Cache with 2 repeats
+  uint16_t gc_test[75] = {
+      38000, 2,  69, 341, 171, 21, 64, 21, 64, 21, 21,   21,  21, 21, 21,
+      21,    21, 21, 21,  21,  64, 21, 64, 21, 21, 21,   64,  21, 21, 21,
+      21,    21, 21, 21,  64,  21, 21, 21, 64, 21, 21,   21,  21, 21, 21,
+      21,    64, 21, 21,  21,  21, 21, 21, 21, 21, 21,   64,  21, 64, 21,
+      64,    21, 21, 21,  64,  21, 64, 21, 64, 21, 1600, 341, 85, 21, 3647};
+  const char gc_str[] =
+      "38000,2,69,341,171,21,64,21,64,21,21,21,21,21,21,"
+      "21,21,21,21,21,64,21,64,21,21,21,64,21,21,21,"
+      "21,21,21,21,64,21,21,21,64,21,21,21,21,21,21,\n"
+      "21,64,21,21,21,21,21,21,21,21,21,64,21,64,21,\n"
+      "64, 21, 21, 21, 64, 21, 64, 21, 64, 21, 1600, 341, 85, 21, 3647";
+  expected.reset();
+  expected.sendGC(gc_test, 75);
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendGC(gc_str));
+  irsend.makeDecodeResult();
+  EXPECT_TRUE(irrecv.decodeNEC(&irsend.capture));
+  EXPECT_EQ(0xC1A28877, irsend.capture.value);
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+
+  // Invalid codes send nothing.
+  irsend.reset();
+  EXPECT_FALSE(irsend.sendGC("38000,1,1"));
+  EXPECT_FALSE(irsend.sendGC("38000,1,1,342,172,21,x"));
+  EXPECT_FALSE(irsend.sendGC("38000,1,1,342,172,21,2-2"));
+  EXPECT_FALSE(irsend.sendGC("380000,1,1,342,172"));
+  EXPECT_FALSE(irsend.sendGC("38000,2,80,342,172"));  // Repeat past the end.
+  EXPECT_FALSE(irsend.sendGC(""));
+  EXPECT_FALSE(irsend.sendGC(NULL));
+  EXPECT_EQ("", irsend.outputStr());
+}
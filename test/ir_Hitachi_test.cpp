@@ -1513,6 +1513,41 @@ TEST(TestDecodeHitachiAc3, SyntheticChangeModeExample) {
   EXPECT_STATE_EQ(expected, irsend.capture.state, irsend.capture.bits);
 }
 
+#if ENABLE_DECODE_PROFILING
+// The Hitachi A/Cs that only differ in length are told apart by one count of
+// the bits, so only the matching decoder is attempted.
+TEST(TestDecodeHitachiAc3, OnlyTheMatchingLengthIsAttempted) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableDecodeProfiling());
+
+  const uint16_t expectedLength = kHitachiAc3MinStateLength + 2;
+  uint8_t expected[expectedLength] = {
+      0x01, 0x10, 0x00, 0x40, 0xBF, 0xFF, 0x00, 0xE3, 0x1C, 0x89, 0x76, 0x08,
+      0xF7, 0x3F, 0xC0, 0x15, 0xEA};
+
+  irsend.reset();
+  irsend.sendHitachiAc3(expected, expectedLength);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(HITACHI_AC3, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(HITACHI_AC3)->attempts);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(HITACHI_AC3)->successes);
+
+  IRHitachiAc344 ac(kGpioUnused);
+  irsend.reset();
+  irsend.sendHitachiAc344(ac.getRaw(), kHitachiAc344StateLength);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(HITACHI_AC344, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(HITACHI_AC344)->successes);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(HITACHI_AC3)->attempts);
+  EXPECT_EQ(0, irrecv.getDecodeProfile(HITACHI_AC2)->attempts);
+  EXPECT_EQ(0, irrecv.getDecodeProfile(HITACHI_AC)->attempts);
+}
+#endif  // ENABLE_DECODE_PROFILING
+
 TEST(TestHitachiAc3Class, hasInvertedStates) {
   const uint8_t good_state[kHitachiAc3StateLength] = {
       0x01, 0x10, 0x00, 0x40, 0xBF, 0xFF, 0x00, 0xE8, 0x17, 0x89, 0x76, 0x0B,
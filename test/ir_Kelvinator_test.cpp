@@ -529,6 +529,38 @@ TEST(TestDecodeKelvinator, NormalSynthetic) {
   ASSERT_TRUE(IRAcUtils::decodeToState(&irsend.capture, &r, &p));
 }
 
+// A Kelvinator message starts with a Gree style frame. Make sure the shared
+// decoder only calls it Gree when no second frame follows.
+TEST(TestDecodeKelvinator, GreeFamilyClassification) {
+  IRsendTest irsend(4);
+  IRrecv irrecv(4);
+  irsend.begin();
+
+  uint8_t kelv_code[kKelvinatorStateLength] = {
+      0x19, 0x0B, 0x80, 0x50, 0x00, 0x00, 0x00, 0xE0,
+      0x19, 0x0B, 0x80, 0x70, 0x00, 0x00, 0x10, 0xf0};
+  irsend.reset();
+  irsend.sendKelvinator(kelv_code);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeGreeFamily(&irsend.capture));
+  EXPECT_EQ(KELVINATOR, irsend.capture.decode_type);
+  EXPECT_EQ(kKelvinatorBits, irsend.capture.bits);
+  EXPECT_STATE_EQ(kelv_code, irsend.capture.state, kKelvinatorBits);
+
+  uint8_t gree_code[kGreeStateLength] = {
+      0x00, 0x09, 0x20, 0x50, 0x00, 0x20, 0x00, 0x50};
+  irsend.reset();
+  irsend.sendGree(gree_code);
+  irsend.makeDecodeResult();
+  // Only one frame, so it can't be a Kelvinator message.
+  EXPECT_FALSE(irrecv.decodeGreeFamily(&irsend.capture, kStartOffset, false,
+                                       true));
+  ASSERT_TRUE(irrecv.decodeGreeFamily(&irsend.capture));
+  EXPECT_EQ(GREE, irsend.capture.decode_type);
+  EXPECT_EQ(kGreeBits, irsend.capture.bits);
+  EXPECT_STATE_EQ(gree_code, irsend.capture.state, kGreeBits);
+}
+
 TEST(TestKelvinatorClass, toCommon) {
   IRKelvinatorAC ac(0);
   ac.setPower(true);
@@ -194,3 +194,79 @@ TEST(TestDecodeLegoPf, SyntheticDecodeWithRepeat) {
   EXPECT_EQ(4, irsend.capture.address);
   EXPECT_EQ(0x30, irsend.capture.command);
 }
+
+// Tests for the IRLegoPfScheduler class.
+
+TEST(TestLegoPfScheduler, Classify) {
+  EXPECT_EQ(0, IRLegoPfScheduler::getChannel(0x047C));
+  EXPECT_EQ(1, IRLegoPfScheduler::getChannel(0x1428));
+  EXPECT_EQ(3, IRLegoPfScheduler::getChannel(0x3000));
+  EXPECT_EQ(3, IRLegoPfScheduler::getChannel(0xB000));  // Toggle bit is set.
+  EXPECT_EQ(0, IRLegoPfScheduler::getOutputSlot(0x047C));  // Single A
+  EXPECT_EQ(1, IRLegoPfScheduler::getOutputSlot(0x057D));  // Single B
+  EXPECT_EQ(2, IRLegoPfScheduler::getOutputSlot(0x435D));  // Combo PWM
+  EXPECT_EQ(2, IRLegoPfScheduler::getOutputSlot(0x0135));  // Combo direct
+}
+
+TEST(TestLegoPfScheduler, CoalesceAndInterleave) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  IRLegoPfScheduler scheduler(&irsend);
+  irsend.begin();
+
+  EXPECT_FALSE(scheduler.handle());  // Nothing to send.
+  EXPECT_FALSE(scheduler.update(0x047C));  // Ch 1, A
+  EXPECT_FALSE(scheduler.update(0x057D));  // Ch 1, B
+  EXPECT_FALSE(scheduler.update(0x1428));  // Ch 2, A
+  EXPECT_TRUE(scheduler.update(0x1439));  // Ch 2, A. Replaces the last one.
+  EXPECT_EQ(3, scheduler.pending());
+
+  // The channels take turns, & only the latest for each output is sent.
+  irsend.reset();
+  ASSERT_TRUE(scheduler.handle());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(LEGOPF, irsend.capture.decode_type);
+  EXPECT_EQ(0x047C, irsend.capture.value);
+  irsend.reset();
+  ASSERT_TRUE(scheduler.handle());  // Ch 2 doesn't have to wait for Ch 1.
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0x1439, irsend.capture.value);
+  // Ch 1 has to wait 5 message slots before it can send again.
+  irsend.reset();
+  EXPECT_FALSE(scheduler.handle());
+  EXPECT_EQ("", irsend.outputStr());
+  IRtimer::add(5 * 16000);
+  ASSERT_TRUE(scheduler.handle());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(0x057D, irsend.capture.value);
+  EXPECT_EQ(0, scheduler.pending());
+  EXPECT_FALSE(scheduler.handle());
+
+  // A command for both outputs supersedes those for either.
+  IRtimer::add(5 * 16000);
+  EXPECT_FALSE(scheduler.update(0x047C));
+  EXPECT_TRUE(scheduler.update(0x435D));
+  EXPECT_EQ(1, scheduler.pending());
+  // Extra copies still take turns with the other channels. It's Ch 2's turn.
+  EXPECT_FALSE(scheduler.update(0x1428, 2));
+  const uint16_t copies[3] = {0x1428, 0x435D, 0x1428};
+  for (uint8_t i = 0; i < 3; i++) {
+    irsend.reset();
+    ASSERT_TRUE(scheduler.handle());
+    irsend.makeDecodeResult();
+    ASSERT_TRUE(irrecv.decode(&irsend.capture));
+    EXPECT_EQ(copies[i], irsend.capture.value);
+    IRtimer::add(5 * 16000);
+  }
+  EXPECT_FALSE(scheduler.handle());
+
+  EXPECT_FALSE(scheduler.update(0x047C, 0));  // No copies, is nothing to send.
+  EXPECT_EQ(0, scheduler.pending());
+  EXPECT_FALSE(scheduler.update(0x047C, 5));
+  EXPECT_EQ(1, scheduler.pending());
+  scheduler.clear();
+  EXPECT_EQ(0, scheduler.pending());
+}
@@ -225,6 +225,40 @@ TEST(TestSendMidea, SendUnusualSize) {
   EXPECT_EQ("", irsend.outputStr());
 }
 
+TEST(TestSendMidea, SendSequence) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  const uint64_t codes[] = {0xA1826FFFFF62, kMideaACToggleSwingV,
+                            kMideaACToggleEcono};
+  const std::string freq = "f38000d50";
+  std::string expected = freq;
+  for (const uint64_t code : codes) {
+    irsend.reset();
+    irsend.sendMidea(code);
+    expected += irsend.outputStr().substr(freq.size());
+  }
+
+  irsend.reset();
+  irsend.sendMideaSequence(codes, 3, kNoRepeat);
+  // The same as sending each one on its own, but as one burst.
+  EXPECT_EQ(expected, irsend.outputStr());
+  irsend.reset();
+  irsend.sendMideaSequence(codes, 0);
+  EXPECT_EQ("", irsend.outputStr());
+
+  // The class sends the state & the toggles it needs in one burst.
+  IRMideaAC ac(kGpioUnused);
+  ac.begin();
+  ac._irsend.reset();
+  ac.setRaw(codes[0]);
+  ac.setSwingVToggle(true);
+  ac.setEconoToggle(true);
+  ac.send(kNoRepeat);
+  EXPECT_EQ(expected, ac._irsend.outputStr());
+  EXPECT_FALSE(ac.getSwingVToggle());
+  EXPECT_FALSE(ac.getEconoToggle());
+}
+
 // Tests for IRMideaAC class.
 
 // Tests for controlling the power state.
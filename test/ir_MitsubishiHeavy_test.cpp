@@ -923,3 +923,32 @@ TEST(TestMitsubishiHeavy88AcClass, toCommon) {
   ASSERT_EQ(-1, ac.toCommon().sleep);
   ASSERT_EQ(-1, ac.toCommon().clock);
 }
+
+#if ENABLE_DECODE_PROFILING
+// The 152 & 88 bit variants are told apart by one count of the bits, so only
+// the matching decoder is attempted.
+TEST(TestDecodeMitsubishiHeavy, OnlyTheMatchingLengthIsAttempted) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  irsend.begin();
+  ASSERT_TRUE(irrecv.enableDecodeProfiling());
+
+  IRMitsubishiHeavy88Ac ac88(kGpioUnused);
+  irsend.reset();
+  irsend.sendMitsubishiHeavy88(ac88.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(MITSUBISHI_HEAVY_88, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(MITSUBISHI_HEAVY_88)->successes);
+  EXPECT_EQ(0, irrecv.getDecodeProfile(MITSUBISHI_HEAVY_152)->attempts);
+
+  IRMitsubishiHeavy152Ac ac152(kGpioUnused);
+  irsend.reset();
+  irsend.sendMitsubishiHeavy152(ac152.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  ASSERT_EQ(MITSUBISHI_HEAVY_152, irsend.capture.decode_type);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(MITSUBISHI_HEAVY_152)->attempts);
+  EXPECT_EQ(1, irrecv.getDecodeProfile(MITSUBISHI_HEAVY_88)->attempts);
+}
+#endif  // ENABLE_DECODE_PROFILING
@@ -542,6 +542,33 @@ TEST(TestSendPanasonicAC, SendDataOnly) {
       irsend.outputStr());
 }
 
+// The first section is normally replayed from its precompiled form. Make sure
+// an unusual first section is still encoded the same way as normal.
+TEST(TestSendPanasonicAC, UnusualFirstSection) {
+  IRsendTest irsend(0);
+  irsend.begin();
+
+  uint8_t state[kPanasonicAcStateShortLength] = {
+      0x02, 0x20, 0xE0, 0x04, 0x00, 0x00, 0x00, 0x06,
+      0x02, 0x20, 0xE0, 0x04, 0x80, 0x9B, 0x32, 0x53};
+  irsend.reset();
+  irsend.sendPanasonicAC(state, kPanasonicAcStateShortLength);
+  const std::string usual = irsend.outputStr();
+
+  state[7] = 0x07;  // Not the expected first section anymore.
+  irsend.reset();
+  irsend.sendPanasonicAC(state, kPanasonicAcStateShortLength);
+  const std::string unusual = irsend.outputStr();
+  EXPECT_NE(usual, unusual);
+  // Only the last bit of the first section differs.
+  const std::string expected_lastbyte =
+      "m432s1296m432s1296m432s1296m432s432m432s432m432s432m432s432m432s432"
+      "m432s10000";
+  EXPECT_NE(std::string::npos, unusual.find(expected_lastbyte));
+  EXPECT_EQ(std::string::npos, usual.find(expected_lastbyte));
+  EXPECT_EQ(usual.size(), unusual.size() - 1);
+}
+
 // Tests for the IRPanasonicAc class.
 
 TEST(TestIRPanasonicAcClass, ChecksumCalculation) {
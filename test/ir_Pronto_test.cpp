@@ -435,3 +435,123 @@ TEST(TestSendPronto, Issue1103) {
       "f38028d50m20066s20435m15069s30665m20066s20435m15069s29982",
       irsend.outputStr());
 }
+
+// Test sending straight from the text form of a code.
+TEST(TestSendPronto, FromString) {
+  IRsendTest irsend(4);
+  IRsendTest expected(4);
+  IRrecv irrecv(4);
+  irsend.begin();
+  expected.begin();
+
+  // NEC 32 bit power on command.
+  uint16_t pronto_test[76] = {
+      0x0000, 0x006D, 0x0022, 0x0002, 0x0156, 0x00AB, 0x0015, 0x0015, 0x0015,
+      0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0015,
+      0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015,
+      0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040,
+      0x0015, 0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015,
+      0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015,
+      0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0015, 0x0015,
+      0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x05FD,
+      0x0156, 0x0055, 0x0015, 0x0E4E};
+  const char pronto_str[] =
+      "0000 006D 0022 0002 0156 00AB 0015 0015 0015 0015 0015 0015 0015 0040 "
+      "0015 0040 0015 0015 0015 0015 0015 0015 0015 0040 0015 0040 0015 0040 "
+      "0015 0015 0015 0015 0015 0040 0015 0040 0015 0040 0015 0015 0015 0015 "
+      "0015 0015 0015 0040 0015 0015 0015 0015 0015 0015 0015 0015 0015 0040 "
+      "0015 0040 0015 0040 0015 0015 0015 0040 0015 0040 0015 0040 0015 0040 "
+      "0015 05fd 0156 0055 0015 0e4e";
+
+  expected.reset();
+  expected.sendPronto(pronto_test, 76, 2);
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendPronto(pronto_str, 2));
+  irsend.makeDecodeResult();
+  EXPECT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x18E710EF, irsend.capture.value);
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+
+  // Comma separated, & only a repeat sequence.
+  uint16_t pronto_repeat[12] = {
+      0x0000, 0x006D, 0x0000, 0x0004, 0x02fb, 0x0309, 0x023d, 0x048e, 0x02fb,
+      0x0309, 0x023d, 0x0474};
+  expected.reset();
+  expected.sendPronto(pronto_repeat, 12, 1);
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendPronto(
+      "0000,006D,0000,0004,02fb,0309,023d,048e,02fb,0309,023d,0474", 1));
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+
+  // Invalid codes send nothing.
+  irsend.reset();
+  EXPECT_FALSE(irsend.sendPronto("0000 006D 0000 0001 0015"));  // Too short.
+  EXPECT_FALSE(irsend.sendPronto("0100 006D 0001 0000 0015 0015"));  // Type.
+  EXPECT_FALSE(irsend.sendPronto("0000 0000 0001 0000 0015 0015"));  // Freq.
+  EXPECT_FALSE(irsend.sendPronto("0000 006D 0001 0001 0015 0015"));  // Length.
+  EXPECT_FALSE(irsend.sendPronto("0000 006D 0001 0000 0015 00G5"));
+  EXPECT_FALSE(irsend.sendPronto(NULL));
+  EXPECT_EQ("", irsend.outputStr());
+}
+
+// A compiled Pronto code is sent exactly as the original would be.
+TEST(TestSendPronto, Compiled) {
+  IRsendTest irsend(4);
+  IRsendTest expected(4);
+  irsend.begin();
+  expected.begin();
+  IRsequence intro;
+  IRsequence repeats;
+
+  // NEC 32 bit power on command.
+  uint16_t pronto_test[76] = {
+      0x0000, 0x006D, 0x0022, 0x0002, 0x0156, 0x00AB, 0x0015, 0x0015, 0x0015,
+      0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0015,
+      0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015,
+      0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040,
+      0x0015, 0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015,
+      0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015,
+      0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0015, 0x0015,
+      0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x05FD,
+      0x0156, 0x0055, 0x0015, 0x0E4E};
+  ASSERT_TRUE(irsend.compilePronto(pronto_test, 76, &intro, &repeats));
+  EXPECT_EQ("", irsend.outputStr());  // Nothing is sent.
+  EXPECT_EQ(68, intro.length());
+  EXPECT_EQ(6, repeats.length());  // Its long gap needs two entries.
+  for (uint16_t repeat = 0; repeat <= 2; repeat++) {
+    expected.reset();
+    expected.sendPronto(pronto_test, 76, repeat);
+    irsend.reset();
+    irsend.sendPronto(&intro, &repeats, repeat);
+    EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+  }
+
+  // From its text form, & with only a repeat sequence.
+  uint16_t pronto_repeat[12] = {
+      0x0000, 0x006D, 0x0000, 0x0004, 0x02fb, 0x0309, 0x023d, 0x048e, 0x02fb,
+      0x0309, 0x023d, 0x0474};
+  ASSERT_TRUE(irsend.compilePronto(
+      "0000,006D,0000,0004,02fb,0309,023d,048e,02fb,0309,023d,0474",
+      &intro, &repeats));
+  EXPECT_EQ(0, intro.length());
+  EXPECT_EQ(8, repeats.length());
+  for (uint16_t repeat = 0; repeat <= 2; repeat++) {
+    expected.reset();
+    expected.sendPronto(pronto_repeat, 12, repeat);
+    irsend.reset();
+    irsend.sendPronto(&intro, &repeats, repeat);
+    EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+  }
+
+  // Invalid codes don't compile.
+  EXPECT_FALSE(irsend.compilePronto(pronto_test, 75, &intro, &repeats));
+  EXPECT_EQ(0, intro.length() + repeats.length());
+  EXPECT_FALSE(irsend.compilePronto("0100 006D 0001 0000 0015 0015", &intro,
+                                    &repeats));
+  EXPECT_FALSE(irsend.compilePronto("0000 006D 0001 0000 0015 0015", NULL,
+                                    &repeats));
+  // Nor do ones too large for the sequences.
+  IRsequence tiny(4);
+  EXPECT_FALSE(irsend.compilePronto(pronto_test, 76, &tiny, &repeats));
+}
@@ -1586,3 +1586,42 @@ TEST(TestIRSamsungAcClass, SetAndGetBreeze) {
       "Light: On, Ion: Off",
       ac.toString());
 }
+
+// The "On" & "Off" messages can be compiled ahead of time, & are then sent
+// exactly as if they were encoded.
+TEST(TestIRSamsungAcClass, CompilePower) {
+  IRSamsungAc encoded(kGpioUnused);
+  IRSamsungAc compiled(kGpioUnused);
+  IRsequence on;
+  IRsequence off;
+  encoded.begin();
+  compiled.begin();
+
+  EXPECT_FALSE(compiled.compilePower(NULL, &off));
+  ASSERT_TRUE(compiled.compilePower(&on, &off));
+  EXPECT_EQ("", compiled._irsend.outputStr());  // Nothing was sent.
+
+  encoded.sendOn();
+  compiled.sendOn();
+  EXPECT_EQ(encoded._irsend.outputStr(), compiled._irsend.outputStr());
+  encoded._irsend.reset();
+  compiled._irsend.reset();
+  encoded.sendOff();
+  compiled.sendOff();
+  EXPECT_EQ(encoded._irsend.outputStr(), compiled._irsend.outputStr());
+  // A different repeat isn't what was compiled, so it is encoded as normal.
+  encoded._irsend.reset();
+  compiled._irsend.reset();
+  encoded.sendOn(0);
+  compiled.sendOn(0);
+  EXPECT_EQ(encoded._irsend.outputStr(), compiled._irsend.outputStr());
+
+  // It still decodes.
+  compiled._irsend.reset();
+  compiled.sendOff();
+  compiled._irsend.makeDecodeResult();
+  IRrecv irrecv(kGpioUnused);
+  ASSERT_TRUE(irrecv.decode(&compiled._irsend.capture));
+  EXPECT_EQ(SAMSUNG_AC, compiled._irsend.capture.decode_type);
+  EXPECT_EQ(kSamsungAcExtendedBits, compiled._irsend.capture.bits);
+}
@@ -231,6 +231,16 @@ TEST(TestDecodeSharp, NormalDecodeWithStrict) {
   EXPECT_EQ(0x1, irsend.capture.address);
   EXPECT_EQ(0x1, irsend.capture.command);
   EXPECT_FALSE(irsend.capture.repeat);
+
+  // A real capture ends with the last mark. i.e. It has no trailing gap.
+  irsend.reset();
+  irsend.sendSharpRaw(0x454A);
+  irsend.makeDecodeResult();
+  irsend.capture.rawlen--;
+  ASSERT_TRUE(irrecv.decodeSharp(&irsend.capture, kStartOffset, kSharpBits,
+                                 true));
+  EXPECT_EQ(SHARP, irsend.capture.decode_type);
+  EXPECT_EQ(0x454A, irsend.capture.value);
 }
 
 // Decode normal repeated Sharp messages.
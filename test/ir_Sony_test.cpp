@@ -183,6 +183,48 @@ TEST(TestDecodeSony, NormalSonyDecodeWithStrict) {
   EXPECT_EQ(21, irsend.capture.command);
 }
 
+// Strict decoding checks all the copies of the frame in one pass.
+TEST(TestDecodeSony, StrictChecksAllCopies) {
+  IRsendTest irsend(4);
+  IRrecv irrecv(4);
+  irsend.begin();
+
+  // Three identical copies.
+  irsend.reset();
+  irsend.sendSony(0xA90, kSony12Bits, 2);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeSony(&irsend.capture, kStartOffset, kSony12Bits,
+                                true));
+  EXPECT_EQ(0xA90, irsend.capture.value);
+  EXPECT_EQ(kSony12Bits, irsend.capture.bits);
+
+  // The last copy is cut short by the end of the capture.
+  irsend.capture.rawlen -= 6;
+  ASSERT_TRUE(irrecv.decodeSony(&irsend.capture, kStartOffset, kSony12Bits,
+                                true));
+  EXPECT_EQ(0xA90, irsend.capture.value);
+
+  // A copy that differs from the first one.
+  irsend.reset();
+  irsend.sendSony(0xA90, kSony12Bits, 1);
+  irsend.sendSony(0xA91, kSony12Bits, 0);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodeSony(&irsend.capture, kStartOffset, kSony12Bits,
+                                 true));
+  // But the first frame is still fine when not being strict.
+  ASSERT_TRUE(irrecv.decodeSony(&irsend.capture, kStartOffset, kSony12Bits,
+                                false));
+  EXPECT_EQ(0xA90, irsend.capture.value);
+
+  // A copy of a different size.
+  irsend.reset();
+  irsend.sendSony(0xA90, kSony12Bits, 1);
+  irsend.sendSony(0x5480, kSony15Bits, 0);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodeSony(&irsend.capture, kStartOffset, kSony12Bits,
+                                 true));
+}
+
 // Decode unexpected Sony messages. i.e longer than minimum etc.
 TEST(TestDecodeSony, SonyDecodeWithUnexpectedLegalSize) {
   IRsendTest irsend(4);
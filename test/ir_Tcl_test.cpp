@@ -158,6 +158,19 @@ TEST(TestTcl112AcClass, Temperature) {
 
   ac.setTemp(255);
   EXPECT_EQ(kTcl112AcTempMax, ac.getTemp());
+
+  // Fixed-point (tenths of a degree) versions.
+  ac.setTempTenths(235);
+  EXPECT_EQ(235, ac.getTempTenths());
+  EXPECT_EQ(23.5, ac.getTemp());
+  ac.setTempTenths(259);
+  EXPECT_EQ(255, ac.getTempTenths());
+  ac.setTempTenths(-100);
+  EXPECT_EQ(160, ac.getTempTenths());
+  ac.setTempTenths(1000);
+  EXPECT_EQ(310, ac.getTempTenths());
+  ac.setTemp(19.5);
+  EXPECT_EQ(195, ac.getTempTenths());
 }
 
 TEST(TestTcl112AcClass, OperatingMode) {
@@ -687,6 +687,37 @@ TEST(TestDecodeToshibaAC, SyntheticLongExample) {
       irsend.outputStr());
 }
 
+// The message size comes from its length byte, not what the decoder was
+// asked for.
+TEST(TestDecodeToshibaAC, SizeFromLengthByte) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+
+  const uint8_t longState[kToshibaACStateLengthLong] = {
+        0xF2, 0x0D, 0x04, 0xFB, 0x09, 0x50, 0x00, 0x00, 0x01, 0x58};
+  irsend.reset();
+  irsend.sendToshibaAC(longState, kToshibaACStateLengthLong);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeToshibaAC(&irsend.capture, kStartOffset,
+                                     kToshibaACBits));
+  EXPECT_EQ(kToshibaACBitsLong, irsend.capture.bits);
+  EXPECT_STATE_EQ(longState, irsend.capture.state, irsend.capture.bits);
+  // Must still be called with a legal size when strict.
+  EXPECT_FALSE(irrecv.decodeToshibaAC(&irsend.capture, kStartOffset,
+                                      kToshibaACBits + 1));
+
+  const uint8_t shortState[kToshibaACStateLengthShort] = {
+        0xF2, 0x0D, 0x01, 0xFE, 0x21, 0x00, 0x21};
+  irsend.reset();
+  irsend.sendToshibaAC(shortState, kToshibaACStateLengthShort);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeToshibaAC(&irsend.capture, kStartOffset,
+                                     kToshibaACBitsLong));
+  EXPECT_EQ(kToshibaACBitsShort, irsend.capture.bits);
+  EXPECT_STATE_EQ(shortState, irsend.capture.state, irsend.capture.bits);
+}
+
 /// Decode a "real" short example message.
 TEST(TestDecodeToshibaAC, RealShortExample) {
   IRsendTest irsend(kGpioUnused);
@@ -739,3 +770,28 @@ TEST(TestToshibaACClass, ConstructLongState) {
   EXPECT_STATE_EQ(expectedState, ac.getRaw(), kToshibaACBitsLong);
   EXPECT_EQ(kToshibaACStateLengthLong, ac.getStateLength());
 }
+
+TEST(TestToshibaACClass, SendSwing) {
+  IRToshibaAC ac(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  ac.begin();
+  ac.setTemp(25);
+  ac.setSwing(kToshibaAcSwingOff);
+  const uint8_t expectedState[kToshibaACStateLengthShort] = {
+        0xF2, 0x0D, 0x01, 0xFE, 0x21, 0x00, 0x21};
+  ac._irsend.reset();
+  ac.sendSwing(kToshibaAcSwingStep);
+  ac._irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&ac._irsend.capture));
+  EXPECT_EQ(decode_type_t::TOSHIBA_AC, ac._irsend.capture.decode_type);
+  EXPECT_EQ(kToshibaACBitsShort, ac._irsend.capture.bits);
+  EXPECT_STATE_EQ(expectedState, ac._irsend.capture.state,
+                  ac._irsend.capture.bits);
+  // Only the one (repeated) message was sent.
+  EXPECT_EQ(1 + 2 * (2 + 2 * kToshibaACBitsShort + 2),
+            ac._irsend.capture.rawlen);
+  // The rest of the state is untouched.
+  EXPECT_EQ(25, ac.getTemp());
+  EXPECT_EQ(kToshibaACStateLength, ac.getStateLength());
+  EXPECT_EQ(kToshibaAcSwingOff, ac.getSwing(false));
+}
@@ -103,6 +103,13 @@ TEST(TestDecodeTrotec, SyntheticDecode) {
       IRAcUtils::resultAcToString(&irsend.capture));
   stdAc::state_t r, p;
   ASSERT_TRUE(IRAcUtils::decodeToState(&irsend.capture, &r, &p));
+
+  // A real capture ends with the last mark. i.e. It has no trailing gap.
+  irsend.makeDecodeResult();
+  irsend.capture.rawlen--;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::TROTEC, irsend.capture.decode_type);
+  EXPECT_STATE_EQ(expectedState, irsend.capture.state, irsend.capture.bits);
 }
 
 
@@ -173,6 +180,24 @@ TEST(TestTrotecESPClass, Power) {
   ASSERT_FALSE(ac.getPower());
 }
 
+TEST(TestTrotecESPClass, ChecksumOnlyAfterChanges) {
+  IRTrotecESP ac(0);
+  EXPECT_TRUE(IRTrotecESP::validChecksum(ac.getRaw()));
+  // The checksum isn't recalculated if nothing has changed.
+  ac.remote_state[kTrotecStateLength - 1] = 0;
+  EXPECT_FALSE(IRTrotecESP::validChecksum(ac.getRaw()));
+  // But it is after any change.
+  ac.setTemp(20);
+  EXPECT_TRUE(IRTrotecESP::validChecksum(ac.getRaw()));
+  const uint8_t bad[kTrotecStateLength] = {
+      0x12, 0x34, 0x29, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+  ac.setRaw(bad);
+  EXPECT_TRUE(IRTrotecESP::validChecksum(ac.getRaw()));
+  ac.remote_state[kTrotecStateLength - 1] = 0;
+  ac.stateReset();
+  EXPECT_TRUE(IRTrotecESP::validChecksum(ac.getRaw()));
+}
+
 TEST(TestUtils, Housekeeping) {
   ASSERT_EQ("TROTEC", typeToString(decode_type_t::TROTEC));
   ASSERT_EQ(decode_type_t::TROTEC, strToDecodeType("TROTEC"));
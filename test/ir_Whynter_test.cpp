@@ -158,6 +158,13 @@ TEST(TestDecodeWhynter, NormalDecodeWithStrict) {
   EXPECT_EQ(0x0, irsend.capture.address);
   EXPECT_EQ(0x0, irsend.capture.command);
   EXPECT_FALSE(irsend.capture.repeat);
+
+  // A real capture ends with the last mark. i.e. It has no trailing gap.
+  irsend.makeDecodeResult();
+  irsend.capture.rawlen--;
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(WHYNTER, irsend.capture.decode_type);
+  EXPECT_EQ(0x87654321, irsend.capture.value);
 }
 
 // Decode normal repeated Whynter messages.
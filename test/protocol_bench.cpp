@@ -0,0 +1,626 @@
+// Micro-benchmarks of the library's hot paths, to spot performance regressions.
+// Copyright 2026 The IRremoteESP8266 authors
+
+// Usage example:
+// ./protocol_bench [-n iterations] [-p protocol] [-s suite]
+//                  [-b baseline.csv] [-t percent] [-c captures]
+//
+// Output is CSV, one row per protocol per suite. i.e.
+//   suite,protocol,bits,iterations,ns_per_op,ok
+// `ok` is 1 if every operation succeeded. e.g. The message was decoded.
+// Protocols that can't be decoded have no decode (or later) rows.
+//
+// With a baseline (i.e. The output of an earlier run), it exits with an error
+// if any row is more than `-t` percent (Default: 25) slower than in it, or no
+// longer ok. A failed round-trip is always an error. e.g.
+//   ./protocol_bench -s roundtrip > baseline.csv
+//   (change something)
+//   ./protocol_bench -s roundtrip -b baseline.csv
+//
+// Suites:
+//   send        IRsend::send() of a message, into the IRsendTest fake.
+//   decode_all  IRrecv::decode() of that message, with every protocol
+//               enabled. i.e. The full decode chain.
+//   decode      IRrecv::decode() of it, with only the protocol it decoded as
+//               enabled. i.e. The decoder in isolation.
+//   ac_build    IRac::sendAc() building (& recording) each A/C vendor's
+//               message from a common state.
+//   human       resultToHumanReadableBasic() of the decoded message.
+//   ac_string   IRAcUtils::resultAcToString() of the decoded A/C message.
+//   roundtrip   IRsend::send() then IRrecv::decode() (all protocols enabled)
+//               of random, but valid, messages, checking it decodes as what
+//               was sent. A/C messages are built by IRac from random settings.
+//   capture     IRdecoder::decode() (all protocols enabled) of the field
+//               captures in a capture file (`-c`, see capture_file.h), by the
+//               protocol they were recorded as. Checking they still decode as
+//               it.
+//   channel     The roundtrip messages, but through a simulated channel with
+//               a typical receiver's lag & jitter (see simulated_channel.h),
+//               captured by IRrecv's interrupt handlers & decoded as they
+//               end. The time is the CPU cost per message. A summary of the
+//               latency (from the message's first mark, to it being decoded)
+//               is written to stderr. Some protocols can't survive it. e.g.
+//               Those that end with a space are cut short by the capture's
+//               timeout. So only a row that is no longer ok is an error.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "capture_file.h"
+#include "simulated_channel.h"
+
+const uint32_t kDefaultIterations = 1000;
+// Data to send for the simple (<= 64 bit) protocols.
+const uint64_t kBenchData = 0xA55A3CC30FF01234ULL;
+const uint16_t kRoundTripMessages = 16;  // Random messages per protocol.
+const uint8_t kDefaultThreshold = 25;  // Percent slower than the baseline.
+// The receiver settings used for the channel suite. As IRrecvDumpV2 uses.
+const uint16_t kChannelBufferSize = 1024;
+const uint8_t kChannelTimeoutMs = 50;
+
+/// A previous result, to compare with.
+typedef struct {
+  uint64_t nsecs;  // Per operation.
+  bool ok;
+} baseline_t;
+
+/// Where to time things, & what to report.
+typedef struct {
+  uint32_t iterations;
+  std::string protocol;  // Only this protocol, if not empty.
+  std::string suite;  // Only this suite, if not empty.
+  std::map<std::string, baseline_t> baseline;  // By "suite,protocol".
+  uint8_t threshold;  // Percent.
+} bench_options_t;
+
+/// A message to round-trip, & what it should decode as.
+typedef struct {
+  decode_type_t protocol;  // What to send it as.
+  decode_type_t decodes_as;
+  uint16_t bits;
+  uint64_t value;
+  uint8_t state[kStateSizeMax];
+  uint16_t repeat;
+} message_t;
+
+static bool failed = false;  // Did a round-trip fail, or a row regress?
+// Totals of the channel suite.
+static uint32_t channel_messages = 0;
+static uint32_t channel_decoded = 0;
+static uint64_t channel_latency_sum = 0;  // (uSeconds)
+static uint32_t channel_latency_max = 0;  // (uSeconds)
+
+void usage_error(char *name) {
+  std::cerr << "Usage: " << name << " [-n iterations] [-p protocol] "
+            << "[-s suite] [-b baseline.csv] [-t percent] [-c captures]"
+            << std::endl
+            << "Times the library's send, decode, A/C & string code for "
+               "each protocol, & outputs the results as CSV." << std::endl
+            << "Suites: send, decode, decode_all, ac_build, human, ac_string, "
+               "roundtrip, capture, channel" << std::endl;
+}
+
+/// A running timer for a suite's operations.
+class BenchTimer {
+ public:
+  BenchTimer(void) : _start(std::chrono::steady_clock::now()) {}
+  /// @return Nr. of nanoseconds since the timer was created.
+  uint64_t elapsed(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _start).count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point _start;
+};
+
+bool wanted(const bench_options_t &options, const char *suite,
+            const decode_type_t protocol) {
+  return (options.suite.empty() || options.suite == suite) &&
+      (options.protocol.empty() ||
+       strToDecodeType(options.protocol.c_str()) == protocol);
+}
+
+/// Output a row of results, & check it against the baseline (if any).
+void report(const bench_options_t &options, const char *suite,
+            const decode_type_t protocol, const uint16_t bits,
+            const uint64_t nsecs, const bool ok) {
+  const uint64_t per_op = nsecs / options.iterations;
+  const std::string name = typeToString(protocol).c_str();
+  printf("%s,%s,%" PRIu16 ",%" PRIu32 ",%" PRIu64 ",%d\n", suite,
+         name.c_str(), bits, options.iterations, per_op, ok);
+  if (!ok && (strcmp(suite, "roundtrip") == 0 ||
+              strcmp(suite, "capture") == 0)) {
+    fprintf(stderr, "FAIL: %s,%s didn't decode as what was sent.\n", suite,
+            name.c_str());
+    failed = true;
+  }
+  std::map<std::string, baseline_t>::const_iterator it =
+      options.baseline.find(std::string(suite) + "," + name);
+  if (it == options.baseline.end()) return;
+  if (it->second.ok && !ok) {
+    fprintf(stderr, "FAIL: %s,%s is no longer ok.\n", suite, name.c_str());
+    failed = true;
+  }
+  if (per_op * 100 > it->second.nsecs * (100 + options.threshold)) {
+    fprintf(stderr, "FAIL: %s,%s took %" PRIu64 " ns/op. Was %" PRIu64
+            " ns/op.\n", suite, name.c_str(), per_op, it->second.nsecs);
+    failed = true;
+  }
+}
+
+/// Load the results of an earlier run, to compare with.
+/// @return true, if it could be read.
+bool loadBaseline(const char *path, bench_options_t *options) {
+  std::ifstream file(path);
+  if (!file) return false;
+  std::string line;
+  while (std::getline(file, line)) {
+    char suite[64], protocol[64];
+    uint64_t nsecs;
+    int ok;
+    if (sscanf(line.c_str(), "%63[^,],%63[^,],%*u,%*u,%" SCNu64 ",%d", suite,
+               protocol, &nsecs, &ok) != 4)
+      continue;  // e.g. The header.
+    baseline_t result = {nsecs, ok != 0};
+    options->baseline[std::string(suite) + "," + protocol] = result;
+  }
+  return true;
+}
+
+/// Send a message of the given protocol. Either via IRac for A/C vendors, so
+/// it is a valid message, or via IRsend::send() otherwise.
+/// @return true, if it was sent.
+bool sendMessage(IRsendTest *irsend, const decode_type_t protocol,
+                 const uint16_t bits, IRsequence *ac_message) {
+  if (ac_message != NULL && ac_message->length()) {
+    irsend->sendSequence(ac_message);
+    return true;
+  }
+  if (hasACState(protocol)) {
+    uint8_t state[kStateSizeMax] = {0};
+    return irsend->send(protocol, state, bits / 8);
+  }
+  return irsend->send(protocol,
+                      kBenchData >> (64 - std::min(bits, (uint16_t)64)),
+                      bits, kNoRepeat);
+}
+
+/// A pseudo random number generator, so runs are repeatable.
+static uint32_t nextRandom(uint32_t *seed) {
+  *seed = *seed * 1103515245 + 12345;
+  return *seed >> 8;
+}
+
+/// Make a random A/C message of a protocol, as IRac would send it.
+/// @return true, if it decoded as a message of the protocol.
+bool randomAcMessage(IRsendTest *irsend, IRrecv *irrecv, uint32_t *seed,
+                     message_t *message) {
+  IRac ac(0);
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = message->protocol;
+  state.model = 1;
+  state.power = nextRandom(seed) % 4;  // Mostly on.
+  state.mode = (stdAc::opmode_t)(nextRandom(seed) % 5);
+  state.degrees = 18 + nextRandom(seed) % 13;
+  state.fanspeed = (stdAc::fanspeed_t)(nextRandom(seed) %
+      ((int)stdAc::fanspeed_t::kLastFanspeedEnum + 1));
+  state.swingv = (stdAc::swingv_t)(nextRandom(seed) %
+      ((int)stdAc::swingv_t::kLastSwingvEnum + 2) - 1);
+  IRsequence sent;
+  IRsend::startRecordingAll(&sent);
+  const bool ok = ac.sendAc(state, NULL);
+  IRsend::stopRecordingAll();
+  if (!ok) return false;
+  irsend->reset();
+  irsend->sendSequence(&sent);
+  irsend->makeDecodeResult();
+  if (!irrecv->decode(&irsend->capture) ||
+      irsend->capture.decode_type != message->protocol)
+    return false;
+  // That is what the protocol's class makes, so it is valid.
+  message->bits = irsend->capture.bits;
+  message->value = irsend->capture.value;
+  memcpy(message->state, irsend->capture.state, message->bits / 8);
+  return true;
+}
+
+/// Make a random, but valid, message of a protocol. i.e. One its decoder
+/// accepts, & doesn't mistake for another protocol.
+/// @return true, if one could be made.
+bool randomMessage(IRsendTest *irsend, IRrecv *irrecv, uint32_t *seed,
+                   message_t *message) {
+  const decode_type_t protocol = message->protocol;
+  message->decodes_as = protocol;
+  message->bits = IRsend::defaultBits(protocol);
+  message->repeat = IRsend::minRepeats(protocol);
+  if (hasACState(protocol) && message->bits / 8 > kStateSizeMax) return false;
+  if (IRac::isProtocolSupported(protocol))
+    return randomAcMessage(irsend, irrecv, seed, message);
+  if (hasACState(protocol)) {
+    for (uint16_t i = 0; i < message->bits / 8; i++)
+      message->state[i] = nextRandom(seed);
+    if (protocol == HITACHI_AC3)  // Everything after the header is inverted.
+      irutils::invertBytePairs(message->state + 3, message->bits / 8 - 3);
+    return true;
+  }
+  const uint16_t bits = std::min(message->bits, (uint16_t)64);
+  uint64_t value = ((uint64_t)nextRandom(seed) << 40) ^
+      ((uint64_t)nextRandom(seed) << 20) ^ nextRandom(seed);
+  if (bits < 64) value &= (1ULL << bits) - 1;
+  switch (protocol) {  // Those with checksums, or fixed parts.
+    case SHERWOOD:
+      message->decodes_as = NEC;  // It is NEC, but repeated.
+      // FALL THRU
+    case NEC:
+    case EPSON:
+      value = irsend->encodeNEC(value >> 8, value & 0xFF);
+      break;
+    case SAMSUNG:
+      value = irsend->encodeSAMSUNG(value >> 8, value);
+      break;
+    case LG:
+    case LG2:
+      value = irsend->encodeLG((value >> 16) & 0xFF, value);
+      break;
+    case SHARP:
+      value = irsend->encodeSharp((value >> 8) & 0x1F, value & 0xFF);
+      break;
+    case DENON:  // The legacy 15 bit version. i.e. Sharp without expansion.
+      value = irsend->encodeSharp((value >> 8) & 0x1F, value & 0xFF, 0);
+      break;
+    case SANYO_LC7461:
+      value = irsend->encodeSanyoLC7461(value >> 8, value);
+      break;
+    case PIONEER:
+      value = irsend->encodePioneer(value >> 16, value);
+      break;
+    case DOSHISHA:
+      value = irsend->encodeDoshisha(value, value >> 8);
+      break;
+    case METZ:
+      value = IRsend::encodeMetz(value >> 8, value, (value >> 16) & 1);
+      break;
+    case MAGIQUEST:
+      value = irsend->encodeMagiQuest(value >> 16, value);
+      break;
+    case RC5X:  // The command must be over 63, or it is just RC5.
+      value = irsend->encodeRC5X(value >> 8, 64 | value);
+      break;
+    case LEGOPF: {  // The last nibble is a check of the others.
+      value &= 0xFFF0;
+      uint8_t lrc = 0xF;
+      for (uint16_t data = value; data; data >>= 4) lrc ^= data & 0xF;
+      value |= lrc;
+      break;
+    }
+    case LASERTAG:  // A leading 1 starts with a space, which is lost.
+      value &= 0x0FFF;
+      break;
+    case ZEPEAL:
+      value = 0x6C00 | (value & 0xFF);  // A fixed signature.
+      break;
+    case SONY_38K:
+      message->decodes_as = SONY;  // They only differ by frequency.
+      break;
+    default:
+      break;
+  }
+  message->value = value;
+  return true;
+}
+
+/// Make the random messages of a protocol to round-trip.
+/// @return true, if all of them could be made.
+bool randomMessages(const decode_type_t protocol,
+                    std::vector<message_t> *messages) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  uint32_t seed = protocol;
+  for (uint16_t i = 0; i < kRoundTripMessages; i++) {
+    message_t message;
+    message.protocol = protocol;
+    if (!randomMessage(&irsend, &irrecv, &seed, &message)) break;
+    messages->push_back(message);
+  }
+  return messages->size() == kRoundTripMessages;
+}
+
+/// Set up a receiver to decode round-tripped messages of a protocol.
+void roundTripProtocols(IRrecv *irrecv, const decode_type_t protocol) {
+  // Some protocols' messages are valid messages of others too. So only their
+  // own decoder can be expected to decode them as them.
+  // e.g. Some Sharp ones are legacy Denon ones too.
+  if (protocol == SHARP || protocol == LASERTAG || protocol == MULTIBRACKETS) {
+    irrecv->disableAllProtocols();
+    irrecv->enableProtocol(protocol);
+  }
+}
+
+/// Send a round-trip message.
+/// @return true, if it was sent.
+bool sendRoundTrip(IRsendTest *irsend, const message_t &message) {
+  irsend->reset();
+  if (hasACState(message.protocol))
+    return irsend->send(message.protocol, message.state, message.bits / 8);
+  return irsend->send(message.protocol, message.value, message.bits,
+                      message.repeat);
+}
+
+/// @return Did it decode as the round-trip message?
+bool decodedAs(const decode_results &capture, const message_t &message) {
+  return capture.decode_type == message.decodes_as &&
+      capture.bits == message.bits &&
+      (hasACState(message.protocol) ?
+       memcmp(capture.state, message.state, message.bits / 8) == 0 :
+       capture.value == message.value);
+}
+
+/// Benchmark sending & decoding random messages of a protocol, checking
+/// they decode as what was sent.
+void benchRoundTrip(const bench_options_t &options,
+                    const decode_type_t protocol) {
+  std::vector<message_t> messages;
+  bool ok = randomMessages(protocol, &messages);
+  if (messages.empty()) return;
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  roundTripProtocols(&irrecv, protocol);
+  BenchTimer timer;
+  for (uint32_t n = 0; n < options.iterations; n++) {
+    const message_t &message = messages[n % messages.size()];
+    ok &= sendRoundTrip(&irsend, message);
+    irsend.makeDecodeResult();
+    ok &= irrecv.decode(&irsend.capture) &&
+        decodedAs(irsend.capture, message);
+  }
+  report(options, "roundtrip", protocol, messages[0].bits, timer.elapsed(),
+         ok);
+}
+
+/// Benchmark the random messages of a protocol going through a simulated
+/// channel, & the receiver's capture state machine, checking they decode as
+/// what was sent.
+void benchChannel(const bench_options_t &options,
+                  const decode_type_t protocol) {
+  std::vector<message_t> messages;
+  bool ok = randomMessages(protocol, &messages);
+  if (messages.empty()) return;
+  IRsendTest irsend(0);
+  IRrecv irrecv(0, kChannelBufferSize, kChannelTimeoutMs);
+  irsend.begin();
+  irrecv.enableIRIn();
+  roundTripProtocols(&irrecv, protocol);
+  SimulatedChannel channel(&irrecv, protocol);
+  channel.impairments = kTypicalChannel;
+  decode_results results;
+  BenchTimer timer;
+  for (uint32_t n = 0; n < options.iterations; n++) {
+    const message_t &message = messages[n % messages.size()];
+    ok &= sendRoundTrip(&irsend, message);
+    channel.transmit(&irsend);
+    bool decoded = false;
+    // Anything left over from the last one could end up in its own capture.
+    while (!decoded && channel.receive(&results)) {
+      decoded = decodedAs(results, message);
+      irrecv.resume();
+    }
+    ok &= decoded;
+    channel_messages++;
+    if (!decoded) continue;
+    channel_decoded++;
+    const uint32_t latency = channel.now() - results.started;
+    channel_latency_sum += latency;
+    channel_latency_max = std::max(channel_latency_max, latency);
+  }
+  report(options, "channel", protocol, messages[0].bits, timer.elapsed(), ok);
+}
+
+/// Benchmark everything that can be done with a given protocol.
+void benchProtocol(const bench_options_t &options,
+                   const decode_type_t protocol) {
+  const uint16_t bits = IRsend::defaultBits(protocol);
+  if (!bits || (hasACState(protocol) && bits / 8 > kStateSizeMax)) return;
+  if (wanted(options, "roundtrip", protocol)) benchRoundTrip(options, protocol);
+  if (wanted(options, "channel", protocol)) benchChannel(options, protocol);
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  bool ok = true;
+
+  // A valid message for the A/C vendors, as built by IRac.
+  IRsequence ac_message;
+  if (IRac::isProtocolSupported(protocol)) {
+    IRac ac(0);
+    stdAc::state_t state;
+    IRac::initState(&state);
+    state.protocol = protocol;
+    state.model = 1;
+    state.power = true;
+    state.mode = stdAc::opmode_t::kCool;
+    state.degrees = 24;
+    IRsend::startRecordingAll(&ac_message);
+    ok = ac.sendAc(state, NULL);
+    IRsend::stopRecordingAll();
+    if (wanted(options, "ac_build", protocol)) {
+      IRsequence sent;
+      BenchTimer timer;
+      for (uint32_t n = 0; n < options.iterations; n++) {
+        IRsend::startRecordingAll(&sent);
+        ok &= ac.sendAc(state, NULL);
+        IRsend::stopRecordingAll();
+      }
+      report(options, "ac_build", protocol, bits, timer.elapsed(), ok);
+    }
+  }
+
+  if (wanted(options, "send", protocol)) {
+    BenchTimer timer;
+    for (uint32_t n = 0; n < options.iterations; n++) {
+      irsend.reset();
+      ok = sendMessage(&irsend, protocol, bits, NULL);
+    }
+    report(options, "send", protocol, bits, timer.elapsed(), ok);
+  }
+
+  irsend.reset();
+  if (!sendMessage(&irsend, protocol, bits, &ac_message)) return;
+  irsend.makeDecodeResult();
+  const uint16_t rawlen = irsend.capture.rawlen;
+
+  ok = true;
+  BenchTimer timer;
+  for (uint32_t n = 0; n < options.iterations; n++) {
+    irsend.capture.rawlen = rawlen;
+    ok &= irrecv.decode(&irsend.capture);
+  }
+  if (wanted(options, "decode_all", protocol))
+    report(options, "decode_all", protocol, bits, timer.elapsed(), ok);
+  if (!ok) return;  // The rest need a decoded message.
+  // What it decodes as. e.g. SHERWOOD messages are decoded as NEC ones.
+  const decode_type_t decoded = irsend.capture.decode_type;
+
+  if (wanted(options, "decode", protocol)) {
+    irrecv.disableAllProtocols();
+    irrecv.enableProtocol(decoded);
+    // Some protocols share a decoder, which is gated by the other protocol.
+    if (decoded == RC5X) irrecv.enableProtocol(RC5);
+    if (decoded == TCL112AC) irrecv.enableProtocol(MITSUBISHI112);
+    BenchTimer timer;
+    for (uint32_t n = 0; n < options.iterations; n++) {
+      irsend.capture.rawlen = rawlen;
+      ok &= irrecv.decode(&irsend.capture);
+    }
+    report(options, "decode", protocol, bits, timer.elapsed(), ok);
+    irrecv.enableAllProtocols();
+  }
+
+  if (wanted(options, "human", protocol)) {
+    size_t length = 0;
+    BenchTimer timer;
+    for (uint32_t n = 0; n < options.iterations; n++)
+      length += resultToHumanReadableBasic(&irsend.capture).length();
+    report(options, "human", protocol, bits, timer.elapsed(), length > 0);
+  }
+
+  if (hasACState(protocol) && wanted(options, "ac_string", protocol)) {
+    size_t length = 0;
+    BenchTimer timer;
+    for (uint32_t n = 0; n < options.iterations; n++)
+      length += IRAcUtils::resultAcToString(&irsend.capture).length();
+    report(options, "ac_string", protocol, bits, timer.elapsed(), length > 0);
+  }
+}
+
+/// Benchmark decoding the captures in a capture file, by protocol.
+/// @param[in] options What to benchmark.
+/// @param[in] path The capture file.
+/// @return true, if it could be read.
+bool benchCaptures(const bench_options_t &options, const char *path) {
+  MappedCaptureFile file;
+  if (!file.open(path)) return false;
+  irutils::CaptureReader reader = file.reader();
+  std::map<decode_type_t, std::vector<std::vector<uint16_t> > > captures;
+  irutils::capture_t capture;
+  while (reader.next(&capture)) {
+    if (!wanted(options, "capture", capture.protocol)) continue;
+    // Room for one more entry, for the decoders.
+    std::vector<uint16_t> rawbuf(capture.rawlen + 1);
+    if (irutils::CaptureReader::unpack(capture, rawbuf.data(),
+                                       capture.rawlen) != capture.rawlen)
+      return false;
+    captures[capture.protocol].push_back(rawbuf);
+  }
+  IRdecoder irdecoder;
+  decode_results results;
+  for (std::map<decode_type_t, std::vector<std::vector<uint16_t> > >::
+       iterator it = captures.begin(); it != captures.end(); it++) {
+    std::vector<std::vector<uint16_t> > &rawbufs = it->second;
+    bool ok = true;
+    uint16_t bits = 0;
+    BenchTimer timer;
+    for (uint32_t n = 0; n < options.iterations; n++) {
+      std::vector<uint16_t> &rawbuf = rawbufs[n % rawbufs.size()];
+      irdecoder.decode(&results, rawbuf.data(), rawbuf.size() - 1);
+      ok &= results.decode_type == it->first;
+      bits = std::max(bits, results.bits);
+    }
+    report(options, "capture", it->first, bits, timer.elapsed(), ok);
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  bench_options_t options;
+  options.iterations = kDefaultIterations;
+  options.threshold = kDefaultThreshold;
+  const char *captures = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp("-n", argv[i], 2) == 0 && i + 1 < argc) {
+      char *end;
+      errno = 0;
+      intmax_t val = strtoimax(argv[++i], &end, 10);
+      if (errno == ERANGE || val <= 0 || val > UINT32_MAX || *end != '\0') {
+        usage_error(argv[0]);
+        return 1;
+      }
+      options.iterations = (uint32_t)val;
+    } else if (strncmp("-p", argv[i], 2) == 0 && i + 1 < argc) {
+      options.protocol = argv[++i];
+    } else if (strncmp("-s", argv[i], 2) == 0 && i + 1 < argc) {
+      options.suite = argv[++i];
+    } else if (strncmp("-b", argv[i], 2) == 0 && i + 1 < argc) {
+      if (!loadBaseline(argv[++i], &options)) {
+        std::cerr << "Can't read the baseline: " << argv[i] << std::endl;
+        return 1;
+      }
+    } else if (strncmp("-t", argv[i], 2) == 0 && i + 1 < argc) {
+      const int val = atoi(argv[++i]);
+      if (val <= 0 || val > UINT8_MAX) {
+        usage_error(argv[0]);
+        return 1;
+      }
+      options.threshold = val;
+    } else if (strncmp("-c", argv[i], 2) == 0 && i + 1 < argc) {
+      captures = argv[++i];
+    } else {
+      usage_error(argv[0]);
+      return 1;
+    }
+  }
+
+  printf("suite,protocol,bits,iterations,ns_per_op,ok\n");
+  for (int i = 1; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    if (!options.protocol.empty() &&
+        strToDecodeType(options.protocol.c_str()) != protocol) continue;
+    benchProtocol(options, protocol);
+  }
+  if (captures != NULL && !benchCaptures(options, captures)) {
+    std::cerr << "Can't read the capture file: " << captures << std::endl;
+    return 1;
+  }
+  if (channel_decoded)
+    std::cerr << "channel: " << channel_decoded << " of " << channel_messages
+              << " messages decoded. Latency avg "
+              << channel_latency_sum / channel_decoded << " usecs, max "
+              << channel_latency_max << " usecs." << std::endl;
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+// A simulated IR channel, from an IRsendTest to an IRrecv's capture state.
+// Copyright 2026 The IRremoteESP8266 authors
+
+#ifndef TEST_SIMULATED_CHANNEL_H_
+#define TEST_SIMULATED_CHANNEL_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include <algorithm>
+#include <deque>
+#include "IRrecv.h"
+#include "IRsend_test.h"
+
+/// How the channel, & the receiver module's demodulator, distort a message.
+/// All zero is a perfect channel.
+typedef struct {
+  uint16_t on_lag;   // How late the receiver sees each mark start. (uSeconds)
+  uint16_t off_lag;  // How late it sees each mark end. (uSeconds)
+  uint16_t jitter;   // Most each edge is randomly moved, either way. (uSecs)
+  uint16_t noise;    // Average nr. of glitches per second. e.g. Sunlight.
+  uint16_t glitch;   // How long each glitch inverts the signal for. (uSecs)
+} channel_impairments_t;
+
+/// A typical IR receiver module, indoors. Its marks are `kMarkExcess` longer,
+/// & its edges are a little noisy. Everything should decode through it.
+const channel_impairments_t kTypicalChannel = {80, 80 + kMarkExcess, 10, 0,
+                                               0};
+
+/// Feeds what an IRsendTest sent through a model of the channel, into the
+/// GPIO & timeout interrupt handlers of an IRrecv, on the simulated clock.
+/// i.e. The capture is built by the library's own capture state machine, just
+/// as it would be on a device, timeouts & all.
+/// e.g.
+///   irsend.sendNEC(0x807F40BF);
+///   channel.transmit(&irsend);
+///   channel.receive(&results);  // Calls irrecv.decode() when it's captured.
+///   latency = channel.now() - channel.lastSent();
+/// @note The clock is `_IRtimer_unittest_now`. It may wrap, as `micros()` does.
+class SimulatedChannel {
+ public:
+  channel_impairments_t impairments;
+
+  /// @param[in] irrecv The receiver. It must be capturing. i.e. enableIRIn()
+  /// @param[in] seed The start of the pseudo random sequence. Runs with the
+  ///   same seed are the same.
+  explicit SimulatedChannel(IRrecv *irrecv, const uint32_t seed = 1)
+      : _irrecv(irrecv), _seed(seed), _busy(_IRtimer_unittest_now),
+        _sent(_IRtimer_unittest_now) {
+    impairments = {0, 0, 0, 0, 0};
+  }
+
+  /// @return The simulated time. (uSeconds)
+  uint32_t now(void) const { return _IRtimer_unittest_now; }
+  /// @return When the last mark transmitted so far ended. (uSeconds)
+  uint32_t lastSent(void) const { return _sent; }
+  /// @return Nr. of edges the receiver hasn't seen yet.
+  size_t pending(void) const { return _edges.size(); }
+
+  /// Transmit what an IRsendTest has sent (& recorded) since it was last reset.
+  /// It starts after anything transmitted earlier, including its final gap.
+  /// @param[in,out] irsend What to transmit. It is reset afterwards.
+  void transmit(IRsendTest *irsend) {
+    uint32_t at = _atOrAfter(_busy, now()) ? _busy : now();
+    const uint32_t start = at;
+    // Output alternates mark, space, mark, ... The last entry is a space.
+    for (uint16_t i = 0; i <= irsend->last && i < OUTPUT_BUF; i++) {
+      const uint32_t duration = irsend->output[i];
+      if (i % 2 == 0 && duration) {
+        _edge(at + impairments.on_lag);
+        _edge(at + duration + impairments.off_lag);
+        _sent = at + duration;
+      }
+      at += duration;
+    }
+    _busy = at;
+    // Glitches, anywhere from the start to the end of the final gap.
+    const uint64_t span = at - start;
+    uint64_t glitches = span * impairments.noise / 1000000;
+    if (_random() % 1000000 < span * impairments.noise % 1000000) glitches++;
+    for (; glitches; glitches--) {
+      const uint32_t when = start + _random() % std::max(span, (uint64_t)1);
+      _edge(when);
+      _edge(when + impairments.glitch);
+    }
+    // In time order. None can be more than the jitter before now.
+    const uint32_t base = now() - UINT16_MAX;
+    std::sort(_edges.begin(), _edges.end(),
+              [base](const uint32_t a, const uint32_t b) {
+                return a - base < b - base; });
+    irsend->reset();
+  }
+
+  /// Run the simulated clock forward, delivering edges & timeouts to the
+  /// receiver as they are due. It stops early if a capture ends.
+  /// @param[in] usecs The most to run it for. (uSeconds)
+  /// @return true, if a capture ended. i.e. It is ready for decode().
+  bool run(const uint32_t usecs) {
+    const uint32_t until = now() + usecs;
+    volatile irparams_t *params = _irrecv->_params;
+    while (true) {
+      uint32_t next = until;
+      const bool edge = !_edges.empty() && _atOrAfter(next, _edges.front());
+      if (edge)  // It may have been jittered to before now.
+        next = _atOrAfter(_edges.front(), now()) ? _edges.front() : now();
+      // The timeout timer is (re)started by every edge seen while capturing.
+      if (params->rcvstate == kMarkState) {
+#if ENABLE_ADAPTIVE_TIMEOUT
+        const uint32_t deadline = params->lastedge + MS_TO_USEC(params->wait);
+#else  // ENABLE_ADAPTIVE_TIMEOUT
+        const uint32_t deadline = params->lastedge +
+            MS_TO_USEC(params->timeout);
+#endif  // ENABLE_ADAPTIVE_TIMEOUT
+        if (_atOrAfter(next, deadline)) {
+          if (_atOrAfter(deadline, now())) _IRtimer_unittest_now = deadline;
+          _irrecv->_simulateTimeout();
+          return true;
+        }
+      }
+      _IRtimer_unittest_now = next;
+      if (!edge) return false;
+      _edges.pop_front();
+      const uint8_t state = params->rcvstate;
+      _irrecv->_simulateEdge();
+      // The buffer filled up. That ends the capture straight away.
+      if (state != kStopState && params->rcvstate == kStopState) return true;
+    }
+  }
+
+  /// Run the channel until a capture ends, then decode it. As a main loop
+  /// calling decode() would.
+  /// @param[out] results Where to decode it to. It is UNKNOWN if decode()
+  ///   failed.
+  /// @param[in] limit The most time to wait for a capture. (uSeconds)
+  /// @return true, if a capture ended in time.
+  bool receive(decode_results *results, const uint32_t limit = 1000000) {
+    if (!run(limit)) return false;
+    // In unit tests, decode() uses whatever capture `results` points at, if
+    // the receiver has no save buffer. So point it at the receiver's.
+    volatile irparams_t *params = _irrecv->_params;
+    results->rawbuf = params->rawbuf;
+    results->rawlen = params->rawlen;
+    results->overflow = params->overflow;
+    results->started = params->started;
+    results->stopped = params->stopped;
+    if (!_irrecv->decode(results)) results->decode_type = UNKNOWN;
+    return true;
+  }
+
+ private:
+  IRrecv *_irrecv;
+  uint32_t _seed;
+  uint32_t _busy;  // When what has been transmitted so far ends.
+  uint32_t _sent;  // When the last mark transmitted ended.
+  std::deque<uint32_t> _edges;  // When the receiver's output changes.
+
+  /// @return Is time `a` the same as, or later than, time `b`?
+  static bool _atOrAfter(const uint32_t a, const uint32_t b) {
+    return static_cast<int32_t>(a - b) >= 0;
+  }
+
+  /// A pseudo random number generator, so runs are repeatable.
+  uint32_t _random(void) {
+    _seed = _seed * 1103515245 + 12345;
+    return _seed >> 8;
+  }
+
+  /// Add an edge, moved by up to the jitter either way.
+  /// As edges only toggle the output, the order they arrive in is all that
+  /// matters. e.g. A glitch in a mark is a drop out.
+  void _edge(const uint32_t when) {
+    const uint32_t range = 2 * impairments.jitter + 1;
+    _edges.push_back(when + _random() % range - impairments.jitter);
+  }
+};
+
+#endif  // TEST_SIMULATED_CHANNEL_H_
@@ -0,0 +1,964 @@
+// Analyse raw IR timings, to help add support for an unknown protocol.
+// Copyright 2026 The IRremoteESP8266 authors
+
+// A native companion to auto_analyse_raw_data.py. It clusters the mark &
+// space durations of a capture, guesses the header, bit, footer & gap
+// timings from them, then checks its guess with the library's own matching
+// routines. It is built against the library, so it can analyse thousands of
+// captures a second. e.g. A whole log of them, to mine for protocols.
+//
+// Usage example:
+//   ./analyse_raw captures.txt
+//   ./analyse_raw -g -name Foo < capture.txt
+//   ./analyse_raw -csv ~/ir-logs/*.txt > analysis.csv
+//
+// Usage: ./analyse_raw [-margin usecs] [-all] [-csv] [-g] [-name Name] [file]
+//   -margin  Timings within this of each other are the same. (Default: 200)
+//   -all     Analyse captures the library can already decode too.
+//   -csv     Output a line of CSV per capture, instead of a report.
+//   -g       Generate the constants, & the send & decode code for it.
+//   -name    The protocol's name, for the generated code. (Default: TBD)
+//   Each line of the input (the files given, or stdin) is a capture. Either
+//   a `rawData[]` dump as output by IRrecvDumpV2 etc., or a plain comma
+//   separated list of the timings (in uSeconds), starting with a mark.
+//   Lines without any timings are ignored.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "IRrecv.h"
+#include "IRutils.h"
+
+const uint16_t kDefaultMargin = 200;  // uSeconds. Same as the Python version.
+const uint16_t kMaxTimings = 10000;  // Per capture. The rest are ignored.
+
+/// What a cluster of timings is used for.
+enum role_t {
+  kRoleNone = 0,
+  kRoleLeader,  // A mark before the header. i.e. A longer "header".
+  kRoleHeader,
+  kRoleOne,   // The mark or space of a '1' bit.
+  kRoleZero,  // The mark or space of a '0' bit.
+  kRoleBit,   // The mark or space of both '1' & '0' bits.
+  kRoleGap,
+};
+
+/// How the bits of a message are encoded.
+enum encoding_t {
+  kEncodingUnknown = 0,
+  kEncodingSpace,         // By the length of the space. e.g. NEC
+  kEncodingMark,          // By the length of the mark. e.g. Sony
+  kEncodingConstBitTime,  // By the mark, but each bit is as long. e.g. Zepeal
+};
+
+/// A group of similar timings. i.e. A mark or space "candidate".
+typedef struct {
+  uint32_t max;  // The largest timing in it.
+  uint64_t sum;
+  uint32_t count;
+  role_t role;
+} cluster_t;
+
+/// A header (optional), some bits, a footer mark (optional) & a gap.
+typedef struct {
+  uint16_t start;      // Index of its first timing.
+  uint16_t length;     // Nr. of timings in it. Including the gap.
+  int16_t hdr_mark;    // Index of the mark cluster of its header. -1 if none.
+  int16_t hdr_space;   // Index of the space cluster of its header.
+  std::string bits;    // MSB first. A '?' for a mark & space that isn't a bit.
+  int16_t footer;      // Index of the mark cluster of its footer. -1 if none.
+  int16_t gap;         // Index of the space cluster of its gap. -1 if none.
+  uint32_t gap_usecs;  // The gap, as the match & send routines want it.
+  bool verified;       // Did the library's matching routines agree with us?
+} section_t;
+
+/// The analysis of a capture. Reused, so the buffers are only grown once.
+typedef struct {
+  uint32_t number;                // Which capture of the input it is.
+  std::vector<uint32_t> timings;  // uSeconds. Marks are at the even indices.
+  std::vector<uint16_t> rawbuf;   // The timings as a capture. i.e. In ticks.
+  std::vector<uint16_t> order;    // Scratch space for sorting the timings.
+  std::vector<int16_t> cluster;   // Which cluster each timing is in.
+  std::vector<cluster_t> marks;   // Largest first.
+  std::vector<cluster_t> spaces;  // Largest first.
+  encoding_t encoding;
+  uint32_t one_mark;  // The average timings of the bits.
+  uint32_t one_space;
+  uint32_t zero_mark;
+  uint32_t zero_space;
+  std::vector<section_t> sections;
+  decode_results known;  // What the library decoded it as, if anything.
+} analysis_t;
+
+/// What to do with the captures.
+typedef struct {
+  uint16_t margin;
+  bool all;
+  bool csv;
+  bool generate;
+  std::string name;
+} analyse_options_t;
+
+void usage_error(char *name) {
+  std::cerr << "Usage: " << name << " [-margin usecs] [-all] [-csv] [-g] "
+               "[-name Name] [file ...]" << std::endl
+            << "Analyses each line of the files (or stdin) as a capture of "
+               "raw timings." << std::endl;
+}
+
+uint32_t average(const cluster_t &cluster) {
+  return cluster.count ? cluster.sum / cluster.count : 0;
+}
+
+/// Parse a line of input into the timings of a capture.
+/// @param[in] line e.g. "uint16_t rawData[3] = {9000, 4500, 560};  // NEC"
+/// @param[out] timings Where to put the timings found.
+void parseTimings(const std::string &line, std::vector<uint32_t> *timings) {
+  timings->clear();
+  const char *ptr = line.c_str();
+  const char *end = ptr + line.length();
+  const char *brace = strchr(ptr, '{');
+  if (brace != NULL) {
+    ptr = brace + 1;
+    const char *close = strchr(ptr, '}');
+    if (close != NULL) end = close;
+  } else if (strstr(ptr, "//") != NULL) {
+    end = strstr(ptr, "//");
+  }
+  while (ptr < end) {
+    if (*ptr < '0' || *ptr > '9') {
+      ptr++;
+      continue;
+    }
+    uint32_t value = 0;
+    while (ptr < end && *ptr >= '0' && *ptr <= '9') {
+      value = std::min(value * 10 + (*ptr++ - '0'), (uint32_t)UINT32_MAX / 10);
+    }
+    if (timings->size() < kMaxTimings) timings->push_back(value);
+  }
+}
+
+/// Group the marks (or spaces) of a capture into clusters of similar timings.
+/// i.e. Sorted largest first, a timing more than `margin` smaller than the
+/// largest of the current cluster starts a new one.
+/// @param[in,out] analysis The capture. Its `cluster` entries are set.
+/// @param[in] first 0 for the marks, 1 for the spaces.
+/// @param[in] margin How close the timings in a cluster must be. (uSeconds)
+/// @param[out] clusters Where to put the clusters, largest first.
+void clusterTimings(analysis_t *analysis, const uint8_t first,
+                    const uint16_t margin, std::vector<cluster_t> *clusters) {
+  const std::vector<uint32_t> &timings = analysis->timings;
+  std::vector<uint16_t> &order = analysis->order;
+  order.clear();
+  for (uint16_t i = first; i < timings.size(); i += 2) order.push_back(i);
+  std::sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b) {
+    return timings[a] > timings[b];
+  });
+  clusters->clear();
+  for (uint16_t i = 0; i < order.size(); i++) {
+    const uint32_t usecs = timings[order[i]];
+    if (clusters->empty() || usecs + margin < clusters->back().max) {
+      cluster_t cluster = {usecs, 0, 0, kRoleNone};
+      clusters->push_back(cluster);
+    }
+    clusters->back().sum += usecs;
+    clusters->back().count++;
+    analysis->cluster[order[i]] = clusters->size() - 1;
+  }
+}
+
+/// Is the timing at the given index of the capture in a cluster of the role?
+bool hasRole(const analysis_t &analysis, const uint16_t index,
+             const role_t role) {
+  if (index >= analysis.timings.size()) return false;
+  const std::vector<cluster_t> &clusters = (index % 2) ? analysis.spaces
+                                                       : analysis.marks;
+  const role_t actual = clusters[analysis.cluster[index]].role;
+  return actual == role ||  // A bit is both a one & a zero.
+      (actual == kRoleBit && (role == kRoleOne || role == kRoleZero));
+}
+
+/// Guess what each cluster is used for, & hence how the bits are encoded.
+/// The same rules as auto_analyse_raw_data.py, plus mark encoding.
+/// @param[in,out] analysis The clustered capture.
+/// @param[in] margin How close timings must be to be the same. (uSeconds)
+void assignRoles(analysis_t *analysis, const uint16_t margin) {
+  std::vector<cluster_t> &marks = analysis->marks;
+  std::vector<cluster_t> &spaces = analysis->spaces;
+  const size_t nmarks = marks.size();
+  const size_t nspaces = spaces.size();
+  size_t headers = 0;  // Nr. of the largest marks that aren't bits.
+  analysis->encoding = kEncodingUnknown;
+  if (nmarks >= 2 && nspaces >= 2) {
+    const int64_t long_mark = average(marks[nmarks - 2]);
+    const int64_t short_mark = average(marks[nmarks - 1]);
+    const int64_t long_space = average(spaces[nspaces - 2]);
+    const int64_t short_space = average(spaces[nspaces - 1]);
+    if (std::abs((long_mark + short_space) - (short_mark + long_space)) <=
+        margin)
+      analysis->encoding = kEncodingConstBitTime;
+  }
+  if (analysis->encoding == kEncodingConstBitTime) {
+    marks[nmarks - 2].role = kRoleOne;
+    marks[nmarks - 1].role = kRoleZero;
+    spaces[nspaces - 2].role = kRoleZero;
+    spaces[nspaces - 1].role = kRoleOne;
+    headers = nmarks - 2;
+  } else if (nspaces > nmarks && nspaces >= 2) {
+    analysis->encoding = kEncodingSpace;
+    marks[nmarks - 1].role = kRoleBit;
+    spaces[nspaces - 2].role = kRoleOne;
+    spaces[nspaces - 1].role = kRoleZero;
+    headers = nmarks - 1;
+  } else if (nmarks >= 2 && nspaces >= 1) {
+    analysis->encoding = kEncodingMark;
+    marks[nmarks - 2].role = kRoleOne;
+    marks[nmarks - 1].role = kRoleZero;
+    spaces[nspaces - 1].role = kRoleBit;
+    headers = nmarks - 2;
+  } else {
+    return;  // Too few different timings to tell.
+  }
+  // The smallest of the rest of the marks is the header, any others leaders.
+  for (size_t i = 0; i < headers; i++)
+    marks[i].role = (i + 1 == headers) ? kRoleHeader : kRoleLeader;
+  // Whatever space follows a header (or leader) mark, is a header space.
+  for (uint16_t i = 1; i < analysis->timings.size(); i += 2)
+    if (hasRole(*analysis, i - 1, kRoleHeader) ||
+        hasRole(*analysis, i - 1, kRoleLeader)) {
+      cluster_t &space = spaces[analysis->cluster[i]];
+      if (space.role == kRoleNone) space.role = kRoleHeader;
+    }
+  // & the rest of the spaces are gaps.
+  for (size_t i = 0; i < nspaces; i++)
+    if (spaces[i].role == kRoleNone) spaces[i].role = kRoleGap;
+
+  analysis->one_mark = analysis->zero_mark = 0;
+  analysis->one_space = analysis->zero_space = 0;
+  for (size_t i = 0; i < nmarks; i++) {
+    if (marks[i].role == kRoleOne || marks[i].role == kRoleBit)
+      analysis->one_mark = average(marks[i]);
+    if (marks[i].role == kRoleZero || marks[i].role == kRoleBit)
+      analysis->zero_mark = average(marks[i]);
+  }
+  for (size_t i = 0; i < nspaces; i++) {
+    if (spaces[i].role == kRoleOne || spaces[i].role == kRoleBit)
+      analysis->one_space = average(spaces[i]);
+    if (spaces[i].role == kRoleZero || spaces[i].role == kRoleBit)
+      analysis->zero_space = average(spaces[i]);
+  }
+}
+
+/// Split the capture into sections at the headers & gaps, & collect the
+/// bits of each.
+void findSections(analysis_t *analysis) {
+  const uint16_t length = analysis->timings.size();
+  std::vector<section_t> &sections = analysis->sections;
+  sections.clear();
+  if (analysis->encoding == kEncodingUnknown) return;
+  section_t section;
+  section.start = 0;
+  section.hdr_mark = section.hdr_space = section.footer = section.gap = -1;
+  section.gap_usecs = 0;
+  section.verified = false;
+  for (uint16_t i = 0; i < length; i += 2) {
+    const bool is_header = hasRole(*analysis, i, kRoleHeader) ||
+        hasRole(*analysis, i, kRoleLeader);
+    const bool started = section.hdr_mark >= 0 || section.hdr_space >= 0 ||
+        !section.bits.empty();
+    if (is_header && started) {
+      // An unexpected header. So the section so far had no footer or gap.
+      section.length = i - section.start;
+      sections.push_back(section);
+      section.bits.clear();
+      section.hdr_mark = section.hdr_space = -1;
+    }
+    if (!started || is_header) section.start = i;
+    if (is_header) {
+      section.hdr_mark = analysis->cluster[i];
+      if (i + 1 < length) section.hdr_space = analysis->cluster[i + 1];
+      continue;
+    }
+    const bool is_gap = i + 1 >= length || hasRole(*analysis, i + 1, kRoleGap);
+    if (is_gap || hasRole(*analysis, i + 1, kRoleHeader)) {
+      // The end of the section. Is this last mark a footer, or a bit?
+      // Its space is the gap, for protocols without a footer. e.g. Sony
+      const uint16_t nbits = section.bits.size();
+      const bool footer = !is_gap || analysis->encoding == kEncodingSpace ||
+          (nbits && nbits % 8 == 0) ||
+          !(hasRole(*analysis, i, kRoleOne) ||
+            hasRole(*analysis, i, kRoleZero));
+      if (footer)
+        section.footer = analysis->cluster[i];
+      else
+        section.bits += hasRole(*analysis, i, kRoleOne) ? '1' : '0';
+      section.gap = (is_gap && i + 1 < length) ? analysis->cluster[i + 1] : -1;
+      if (section.gap >= 0) {
+        section.gap_usecs = average(analysis->spaces[section.gap]);
+        if (!footer) {  // The space of the last bit is part of the gap.
+          const uint32_t bit_space = hasRole(*analysis, i, kRoleOne) ?
+              analysis->one_space : analysis->zero_space;
+          section.gap_usecs -= std::min(bit_space, section.gap_usecs);
+        }
+      }
+      section.length = std::min(i + (is_gap ? 2 : 1), (int)length) -
+          section.start;
+      sections.push_back(section);
+      section.bits.clear();
+      section.hdr_mark = section.hdr_space = section.footer = section.gap = -1;
+      section.gap_usecs = 0;
+      if (!is_gap) {  // A header without a mark. It starts the next section.
+        section.start = i + 1;
+        section.hdr_space = analysis->cluster[i + 1];
+      }
+      continue;
+    }
+    const bool one = hasRole(*analysis, i, kRoleOne) &&
+        hasRole(*analysis, i + 1, kRoleOne);
+    const bool zero = hasRole(*analysis, i, kRoleZero) &&
+        hasRole(*analysis, i + 1, kRoleZero);
+    section.bits += (one != zero) ? (one ? '1' : '0') : '?';
+  }
+  if (section.hdr_mark >= 0 || section.hdr_space >= 0 ||
+      !section.bits.empty()) {  // Left over.
+    section.length = length - section.start;
+    sections.push_back(section);
+  }
+}
+
+/// @return The value of up to 64 bits. MSB first.
+uint64_t bitsToValue(const std::string &bits) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bits.size(); i++)
+    value = (value << 1) | (bits[i] == '1');
+  return value;
+}
+
+/// @return The bits as hexadecimal. MSB first.
+std::string bitsToHex(const std::string &bits) {
+  std::string hex;
+  const size_t pad = (4 - bits.size() % 4) % 4;
+  uint8_t nibble = 0;
+  for (size_t i = 0; i < bits.size() + pad; i++) {
+    nibble = (nibble << 1) | (i >= pad && bits[i - pad] == '1');
+    if (i % 4 == 3) {
+      hex += "0123456789ABCDEF"[nibble];
+      nibble = 0;
+    }
+  }
+  return hex;
+}
+
+/// Check a section matches what we think the protocol is, with the library's
+/// matching routines. i.e. Like a decoder generated from it would.
+/// @return true, if it matched & the data was the same as the bits found.
+bool verifySection(IRdecoder *irdecoder, const analysis_t &analysis,
+                   const section_t &section) {
+  const uint16_t nbits = section.bits.size();
+  if (!nbits || section.bits.find('?') != std::string::npos) return false;
+  volatile uint16_t *data = const_cast<uint16_t *>(
+      analysis.rawbuf.data()) + section.start + 1;
+  const uint16_t remaining = analysis.rawbuf.size() - section.start - 2;
+  const uint16_t hdr_mark = (section.hdr_mark >= 0) ?
+      std::min(average(analysis.marks[section.hdr_mark]), (uint32_t)0xFFFF) : 0;
+  const uint32_t hdr_space = (section.hdr_space >= 0) ?
+      average(analysis.spaces[section.hdr_space]) : 0;
+  const uint16_t footer = (section.footer >= 0) ?
+      std::min(average(analysis.marks[section.footer]), (uint32_t)0xFFFF) : 0;
+  const uint16_t one_mark = std::min(analysis.one_mark, (uint32_t)0xFFFF);
+  const uint16_t zero_mark = std::min(analysis.zero_mark, (uint32_t)0xFFFF);
+  uint64_t value = 0;
+  if (footer || analysis.encoding == kEncodingSpace) {
+    if (nbits <= 64) {
+      return irdecoder->matchGeneric(data, &value, remaining, nbits,
+                                     hdr_mark, hdr_space,
+                                     one_mark, analysis.one_space,
+                                     zero_mark, analysis.zero_space,
+                                     footer, section.gap_usecs, true) &&
+          value == bitsToValue(section.bits);
+    }
+    std::vector<uint8_t> state(nbits / 8);
+    if (nbits % 8 ||
+        !irdecoder->matchGeneric(data, state.data(), remaining, nbits,
+                                 hdr_mark, hdr_space,
+                                 one_mark, analysis.one_space,
+                                 zero_mark, analysis.zero_space,
+                                 footer, section.gap_usecs, true))
+      return false;
+    for (uint16_t i = 0; i < state.size(); i++)
+      if (state[i] != bitsToValue(section.bits.substr(i * 8, 8))) return false;
+    return true;
+  }
+  if (nbits > 64) return false;
+  if (analysis.encoding == kEncodingConstBitTime)
+    return irdecoder->matchGenericConstBitTime(data, &value, remaining, nbits,
+                                               hdr_mark, hdr_space,
+                                               one_mark, zero_mark,
+                                               0, section.gap_usecs, true) &&
+        value == bitsToValue(section.bits);
+  // Mark encoded, & the last bit's space is the gap. e.g. Sony
+  // So match all but the last bit, then it by hand.
+  uint16_t used = 0;
+  if (nbits > 1) {
+    used = irdecoder->matchGeneric(data, &value, remaining, nbits - 1,
+                                   hdr_mark, hdr_space,
+                                   one_mark, analysis.one_space,
+                                   zero_mark, analysis.zero_space, 0, 0);
+    if (!used) return false;
+  } else {
+    used = (hdr_mark ? 1 : 0) + (hdr_space ? 1 : 0);
+  }
+  value <<= 1;
+  if (irdecoder->matchMark(data[used], one_mark))
+    value |= 1;
+  else if (!irdecoder->matchMark(data[used], zero_mark))
+    return false;
+  used++;
+  if (used < remaining &&
+      !irdecoder->matchAtLeast(data[used], analysis.one_space +
+                               section.gap_usecs))
+    return false;
+  return value == bitsToValue(section.bits);
+}
+
+/// Analyse the timings of a capture.
+/// @param[in,out] analysis The capture. The results are stored in it too.
+/// @param[in] options How to analyse it.
+/// @param[in,out] irdecoder What to decode (& match) it with.
+void analyse(analysis_t *analysis, const analyse_options_t &options,
+             IRdecoder *irdecoder) {
+  const std::vector<uint32_t> &timings = analysis->timings;
+  std::vector<uint16_t> &rawbuf = analysis->rawbuf;
+  // As a capture, for the library to decode. i.e. A gap before it, & a 0
+  // after it, as decode() wants.
+  rawbuf.resize(timings.size() + 2);
+  rawbuf[0] = 0;
+  for (uint16_t i = 0; i < timings.size(); i++)
+    rawbuf[i + 1] = std::min(timings[i] / kRawTick, (uint32_t)0xFFFF);
+  rawbuf[rawbuf.size() - 1] = 0;
+  irdecoder->decode(&analysis->known, rawbuf.data(), rawbuf.size() - 1);
+  analysis->cluster.resize(timings.size());
+  clusterTimings(analysis, 0, options.margin, &analysis->marks);
+  clusterTimings(analysis, 1, options.margin, &analysis->spaces);
+  analysis->sections.clear();
+  if (analysis->known.decode_type != UNKNOWN && !options.all) return;
+  assignRoles(analysis, options.margin);
+  findSections(analysis);
+  for (size_t i = 0; i < analysis->sections.size(); i++)
+    analysis->sections[i].verified = verifySection(irdecoder, *analysis,
+                                                   analysis->sections[i]);
+}
+
+const char *encodingToString(const encoding_t encoding) {
+  switch (encoding) {
+    case kEncodingSpace: return "space";
+    case kEncodingMark: return "mark";
+    case kEncodingConstBitTime: return "const_bit_time";
+    default: return "unknown";
+  }
+}
+
+std::string clustersToString(const std::vector<cluster_t> &clusters) {
+  std::string result;
+  for (size_t i = 0; i < clusters.size(); i++) {
+    if (i) result += ", ";
+    result += uint64ToString(average(clusters[i])).c_str();
+    result += " x";
+    result += uint64ToString(clusters[i].count).c_str();
+  }
+  return result;
+}
+
+/// Output the analysis of a capture as a report.
+void reportText(const analysis_t &analysis) {
+  printf("Capture #%" PRIu32 ": %zu timings.\n", analysis.number,
+         analysis.timings.size());
+  const decode_results &known = analysis.known;
+  if (known.decode_type != UNKNOWN) {
+    printf("  Decodes as: %s, %" PRIu16 " bits, %s\n",
+           typeToString(known.decode_type).c_str(), known.bits,
+           resultToHexidecimal(&known).c_str());
+    if (analysis.sections.empty()) {
+      printf("\n");
+      return;
+    }
+  }
+  printf("  Mark clusters (usecs x count):  %s\n"
+         "  Space clusters (usecs x count): %s\n"
+         "  Encoding: %s\n", clustersToString(analysis.marks).c_str(),
+         clustersToString(analysis.spaces).c_str(),
+         encodingToString(analysis.encoding));
+  if (analysis.encoding == kEncodingUnknown) {
+    printf("  Too few different timings to tell how it is encoded.\n\n");
+    return;
+  }
+  printf("  One:  mark %" PRIu32 ", space %" PRIu32 "\n"
+         "  Zero: mark %" PRIu32 ", space %" PRIu32 "\n",
+         analysis.one_mark, analysis.one_space, analysis.zero_mark,
+         analysis.zero_space);
+  uint32_t total = 0;
+  for (size_t i = 0; i < analysis.sections.size(); i++) {
+    const section_t &section = analysis.sections[i];
+    printf("  Section #%zu:", i + 1);
+    if (section.hdr_mark >= 0 || section.hdr_space >= 0) {
+      printf(" header ");
+      if (section.hdr_mark >= 0)
+        printf("%" PRIu32, average(analysis.marks[section.hdr_mark]));
+      if (section.hdr_space >= 0)
+        printf("/%" PRIu32, average(analysis.spaces[section.hdr_space]));
+      printf(",");
+    }
+    printf(" %zu bits", section.bits.size());
+    if (section.footer >= 0)
+      printf(", footer %" PRIu32, average(analysis.marks[section.footer]));
+    if (section.gap >= 0)
+      printf(", gap %" PRIu32, average(analysis.spaces[section.gap]));
+    printf(". %s\n", section.verified ? "Verified." : "NOT verified!");
+    if (section.bits.empty()) continue;
+    const size_t unknown = std::count(section.bits.begin(), section.bits.end(),
+                                      '?');
+    if (unknown) printf("    Unexpected timings: %zu\n", unknown);
+    printf("    Bits: %s\n    Hex:  0x%s (MSB first)\n", section.bits.c_str(),
+           bitsToHex(section.bits).c_str());
+    total += section.bits.size();
+  }
+  printf("  Total nr. of bits: %" PRIu32 "\n\n", total);
+}
+
+/// Output the analysis of a capture as a line of CSV.
+void reportCsv(const analysis_t &analysis) {
+  const decode_results &known = analysis.known;
+  std::string bits, values;
+  uint32_t hdr_mark = 0, hdr_space = 0, gap = 0;
+  uint16_t verified = 0;
+  for (size_t i = 0; i < analysis.sections.size(); i++) {
+    const section_t &section = analysis.sections[i];
+    if (i) {
+      bits += ";";
+      values += ";";
+    }
+    bits += uint64ToString(section.bits.size()).c_str();
+    values += "0x" + bitsToHex(section.bits);
+    if (!hdr_mark && section.hdr_mark >= 0)
+      hdr_mark = average(analysis.marks[section.hdr_mark]);
+    if (!hdr_space && section.hdr_space >= 0)
+      hdr_space = average(analysis.spaces[section.hdr_space]);
+    if (!gap && section.gap >= 0)
+      gap = average(analysis.spaces[section.gap]);
+    verified += section.verified;
+  }
+  const bool analysed = !analysis.sections.empty();
+  printf("%" PRIu32 ",%zu,%s,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32
+         ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%zu,%s,%s,%" PRIu16 "\n",
+         analysis.number, analysis.timings.size(),
+         typeToString(known.decode_type).c_str(),
+         analysed ? encodingToString(analysis.encoding) : "",
+         hdr_mark, hdr_space, analysed ? analysis.one_mark : 0,
+         analysed ? analysis.one_space : 0,
+         analysed ? analysis.zero_mark : 0,
+         analysed ? analysis.zero_space : 0, gap, analysis.sections.size(),
+         bits.c_str(), values.c_str(), verified);
+}
+
+/// The names of the generated constants, for each cluster.
+typedef struct {
+  std::vector<std::string> marks;
+  std::vector<std::string> spaces;
+} names_t;
+
+/// Name the constants of the clusters that are used. e.g. "kFooHdrMark"
+names_t nameClusters(const analysis_t &analysis, const std::string &name) {
+  names_t names;
+  const bool const_bit = analysis.encoding == kEncodingConstBitTime;
+  uint16_t leaders = 0, headers = 0, gaps = 0;
+  for (size_t i = 0; i < analysis.marks.size(); i++) {
+    std::string suffix;
+    switch (analysis.marks[i].role) {
+      case kRoleLeader:
+        suffix = "LdrMark";
+        if (leaders++) suffix += uint64ToString(leaders).c_str();
+        break;
+      case kRoleHeader: suffix = "HdrMark"; break;
+      case kRoleOne: suffix = "OneMark"; break;
+      case kRoleZero: suffix = "ZeroMark"; break;
+      case kRoleBit: suffix = "BitMark"; break;
+      default: break;
+    }
+    names.marks.push_back(suffix.empty() ? "" : "k" + name + suffix);
+  }
+  for (size_t i = 0; i < analysis.spaces.size(); i++) {
+    std::string suffix;
+    switch (analysis.spaces[i].role) {
+      case kRoleHeader:
+        suffix = "HdrSpace";
+        if (headers++) suffix += uint64ToString(headers).c_str();
+        break;
+      // The library describes constant bit time bits by their marks alone.
+      case kRoleOne: suffix = const_bit ? "ZeroMark" : "OneSpace"; break;
+      case kRoleZero: suffix = const_bit ? "OneMark" : "ZeroSpace"; break;
+      case kRoleBit: suffix = "BitSpace"; break;
+      case kRoleGap:
+        suffix = "Gap";
+        if (gaps++) suffix += uint64ToString(gaps).c_str();
+        break;
+      default: break;
+    }
+    names.spaces.push_back(suffix.empty() ? "" : "k" + name + suffix);
+  }
+  return names;
+}
+
+/// Output the constants, & the send & decode routines, for a capture.
+/// In the style of the library's protocols. e.g. ir_Zepeal.cpp
+void generateCode(const analysis_t &analysis, const std::string &name) {
+  const std::vector<section_t> &all = analysis.sections;
+  if (all.empty() || analysis.encoding == kEncodingUnknown) return;
+  const names_t names = nameClusters(analysis, name);
+  const bool const_bit = analysis.encoding == kEncodingConstBitTime;
+  // Are the sections all copies of the first? i.e. A repeated message.
+  size_t nsections = all.size();
+  for (size_t i = 1; i < all.size(); i++)
+    if (all[i].bits != all[0].bits || all[i].hdr_mark != all[0].hdr_mark ||
+        all[i].hdr_space != all[0].hdr_space ||
+        all[i].footer != all[0].footer) {
+      nsections = 0;
+      break;
+    }
+  const bool repeated = nsections > 1;
+  const std::vector<section_t> sections(all.begin(),
+                                        repeated ? all.begin() + 1 : all.end());
+  uint32_t nbits = 0;
+  int32_t overhead = 0;
+  for (size_t i = 0; i < sections.size(); i++) {
+    nbits += sections[i].bits.size();
+    overhead += sections[i].length - 2 * sections[i].bits.size();
+  }
+  if (sections.back().gap >= 0) overhead--;  // It may be the end of a capture.
+  const bool use_state = nbits > 64;
+  std::string upper = name;
+  for (size_t i = 0; i < upper.size(); i++) upper[i] = toupper(upper[i]);
+  const char *n = name.c_str();
+  const char *u = upper.c_str();
+
+  printf("// Generated by analyse_raw from capture #%" PRIu32 ".\n",
+         analysis.number);
+  if (repeated)
+    printf("// It is %zu copies of the message. i.e. repeat = %zu\n",
+           nsections, nsections - 1);
+  printf("// Constants\n");
+  for (size_t i = 0; i < analysis.marks.size(); i++)
+    if (!names.marks[i].empty())
+      printf("const uint16_t %s = %" PRIu32 ";\n", names.marks[i].c_str(),
+             std::min(average(analysis.marks[i]), (uint32_t)0xFFFF));
+  for (size_t i = 0; i < analysis.spaces.size(); i++) {
+    const role_t role = analysis.spaces[i].role;
+    if (names.spaces[i].empty() ||
+        (const_bit && (role == kRoleOne || role == kRoleZero)))
+      continue;
+    const uint32_t usecs = average(analysis.spaces[i]);
+    printf("const %s %s = %" PRIu32 ";\n",
+           usecs > 0xFFFF ? "uint32_t" : "uint16_t", names.spaces[i].c_str(),
+           usecs);
+  }
+  printf("const uint16_t k%sFreq = 38000;  // Hz. (Guessing the most common"
+         " frequency.)\n", n);
+  printf("const uint16_t k%sBits = %" PRIu32 ";  // Move to "
+         "IRremoteESP8266.h\n", n, nbits);
+  if (use_state)
+    printf("const uint16_t k%sStateLength = %" PRIu32 ";  // Move to "
+           "IRremoteESP8266.h\n", n, nbits / 8);
+  printf("const uint16_t k%sOverhead = %" PRId32 ";\n",
+         n, std::max(overhead, (int32_t)0));
+
+  // The timings of each part of a section, as the names of the constants.
+  std::vector<std::string> hdr_mark, hdr_space, footer, gap;
+  for (size_t i = 0; i < sections.size(); i++) {
+    const section_t &section = sections[i];
+    hdr_mark.push_back(section.hdr_mark >= 0 ?
+                       names.marks[section.hdr_mark] : "0");
+    hdr_space.push_back(section.hdr_space >= 0 ?
+                        names.spaces[section.hdr_space] : "0");
+    footer.push_back(section.footer >= 0 ? names.marks[section.footer] : "0");
+  }
+  std::string ones, zeros;  // The mark & space constants of the bits.
+  for (size_t i = 0; i < analysis.marks.size(); i++) {
+    if (analysis.marks[i].role == kRoleOne ||
+        analysis.marks[i].role == kRoleBit)
+      ones = names.marks[i];
+    if (analysis.marks[i].role == kRoleZero ||
+        analysis.marks[i].role == kRoleBit)
+      zeros = names.marks[i];
+  }
+  std::string one_space = zeros, zero_space = ones;  // Constant bit time.
+  for (size_t i = 0; !const_bit && i < analysis.spaces.size(); i++) {
+    if (analysis.spaces[i].role == kRoleOne ||
+        analysis.spaces[i].role == kRoleBit)
+      one_space = names.spaces[i];
+    if (analysis.spaces[i].role == kRoleZero ||
+        analysis.spaces[i].role == kRoleBit)
+      zero_space = names.spaces[i];
+  }
+  for (size_t i = 0; i < sections.size(); i++) {
+    const section_t &section = sections[i];
+    if (section.gap >= 0) {
+      gap.push_back(names.spaces[section.gap]);
+      // The last bit's space is part of the gap, unless we match it by hand.
+      if (section.footer < 0 && const_bit)
+        gap.back() += " - " + (*section.bits.rbegin() == '1' ? one_space
+                                                            : zero_space);
+    } else if (i + 1 < sections.size() && sections[i + 1].hdr_mark < 0) {
+      gap.push_back("0");  // The next section's header space follows it.
+    } else {
+      gap.push_back("kDefaultMessageGap");
+    }
+  }
+  const std::string bit_timings =
+      ones + ", " + one_space + ",\n" + "%*s" + zeros + ", " + zero_space;
+
+  // Send
+  printf("\n#if SEND_%s\n/// Send a %s formatted message.\n"
+         "/// Status: ALPHA / Untested.\n", u, n);
+  if (use_state)
+    printf("/// @param[in] data An array of bytes containing the IR command.\n"
+           "///                 It is assumed to be in MSB order.\n"
+           "/// @param[in] nbytes Nr. of bytes of data in the array."
+           " (>=k%sStateLength)\n"
+           "/// @param[in] repeat Nr. of times the message is to be repeated.\n"
+           "void IRsend::send%s(const uint8_t data[], const uint16_t nbytes,\n"
+           "%*sconst uint16_t repeat) {\n"
+           "  for (uint16_t r = 0; r <= repeat; r++) {\n"
+           "    uint16_t pos = 0;\n", n, n, (int)name.size() + 18, "");
+  else
+    printf("/// @param[in] data The message to be sent.\n"
+           "/// @param[in] nbits The bit size of the message being sent."
+           " Typically k%sBits.\n"
+           "/// @param[in] repeat The number of times the message is to be"
+           " repeated.\n"
+           "void IRsend::send%s(const uint64_t data, const uint16_t nbits,\n"
+           "%*sconst uint16_t repeat) {\n", n, n, (int)name.size() + 18, "");
+  // A single section can be sent (& repeated) by sendGeneric() alone.
+  const bool simple = !use_state && sections.size() == 1 &&
+      (sections[0].footer >= 0 || const_bit ||
+       analysis.encoding == kEncodingSpace);
+  const char *indent = simple ? "  " : "    ";
+  if (!use_state && !simple)
+    printf("  for (uint16_t r = 0; r <= repeat; r++) {\n");
+  const int align = strlen(indent) + 12;
+  uint32_t after = nbits;  // Nr. of bits after the current section.
+  for (size_t i = 0; i < sections.size(); i++) {
+    const section_t &section = sections[i];
+    const uint16_t bits = section.bits.size();
+    after -= bits;
+    const bool last_by_hand = section.footer < 0 && !const_bit &&
+        analysis.encoding == kEncodingMark;
+    printf("%s// Data Section #%zu\n", indent, i + 1);
+    if (use_state) {
+      printf("%s// e.g.\n%s//   bits = %u; bytes = %u;\n"
+             "%s//   *(data + pos) = {0x%s};\n", indent, indent, bits, bits / 8,
+             indent, bitsToHex(section.bits).c_str());
+      if (bits % 8 || last_by_hand)
+        printf("%s// DANGER: This section isn't whole bytes with a footer. "
+               "It won't work!\n", indent);
+    } else {
+      printf("%s// e.g. data = 0x%s, nbits = %u\n", indent,
+             bitsToHex(section.bits).c_str(), bits);
+    }
+    printf("%ssendGeneric(%s, %s,\n%*s", indent, hdr_mark[i].c_str(),
+           hdr_space[i].c_str(), align, "");
+    printf(bit_timings.c_str(), align, "");
+    printf(",\n%*s%s, %s,\n%*s", align, "",
+           last_by_hand ? "0" : footer[i].c_str(),
+           last_by_hand ? "0" : gap[i].c_str(), align, "");
+    std::string data = "data";
+    if (after) data = "(data >> " + std::string(uint64ToString(after).c_str()) +
+        ")";
+    if (use_state)
+      printf("data + pos, %u,  // Bytes\n%*sk%sFreq, true, kNoRepeat, "
+             "kDutyDefault);\n%spos += %u;  // Adjust by how many bytes of "
+             "data we sent\n", bits / 8, align, "", n, indent, bits / 8);
+    else if (simple)
+      printf("data, nbits, k%sFreq, true, repeat, kDutyDefault);\n", n);
+    else
+      printf("%s%s, %u, k%sFreq, true, 0, kDutyDefault);\n", data.c_str(),
+             last_by_hand ? " >> 1" : "", bits - last_by_hand, n);
+    if (last_by_hand && !use_state)
+      printf("%s// The last bit has no space of its own. It is the gap.\n"
+             "%smark((%s & 1) ? %s : %s);\n%sspace(%s);\n", indent,
+             indent, data.c_str(), ones.c_str(), zeros.c_str(), indent,
+             gap[i].c_str());
+  }
+  if (!simple) printf("  }\n");
+  printf("}\n#endif  // SEND_%s\n", u);
+
+  // Decode
+  printf("\n#if DECODE_%s\n/// Decode the supplied %s message.\n"
+         "/// Status: ALPHA / Untested.\n"
+         "/// @param[in,out] results Ptr to the data to decode & where to store"
+         " the decode\n///   result.\n"
+         "/// @param[in] offset The starting index to use when attempting to"
+         " decode the\n///   raw data. Typically/Defaults to kStartOffset.\n"
+         "/// @param[in] nbits The number of data bits to expect."
+         " Typically k%sBits.\n"
+         "/// @param[in] strict Flag indicating if we should perform strict"
+         " matching.\n"
+         "/// @return A boolean. True if it can decode it, false if it can't.\n"
+         "bool IRrecv::decode%s(decode_results *results, uint16_t offset,\n"
+         "%*sconst uint16_t nbits, const bool strict) {\n"
+         "  if (results->rawlen < 2 * nbits + k%sOverhead + offset)\n"
+         "    return false;  // Too short a message to match.\n"
+         "  if (strict && nbits != k%sBits)\n"
+         "    return false;\n\n", u, n, n, n, (int)name.size() + 20, "", n, n);
+  if (use_state)
+    printf("  uint16_t pos = 0;\n");
+  else
+    printf("  uint64_t data = 0;\n");
+  if (!use_state && sections.size() > 1) printf("  uint64_t section = 0;\n");
+  printf("  uint16_t used;\n");
+  for (size_t i = 0; i < sections.size(); i++) {
+    const section_t &section = sections[i];
+    const uint16_t bits = section.bits.size();
+    const bool last_by_hand = section.footer < 0 && !const_bit &&
+        analysis.encoding == kEncodingMark;
+    const bool const_last = section.footer < 0 && const_bit;
+    const char *result = use_state ? "results->state + pos" :
+        (sections.size() > 1 ? "&section" : "&data");
+    printf("\n  // Data Section #%zu\n", i + 1);
+    if (use_state) {
+      printf("  // e.g.\n  //   bits = %u; bytes = %u;\n"
+             "  //   *(results->state + pos) = {0x%s};\n", bits, bits / 8,
+             bitsToHex(section.bits).c_str());
+      if (bits % 8 || last_by_hand || const_last)
+        printf("  // WARNING: This section isn't whole bytes with a footer. "
+               "It won't work!\n");
+    } else {
+      printf("  // e.g. %s = 0x%s, nbits = %u\n", result + 1,
+             bitsToHex(section.bits).c_str(), bits);
+    }
+    if (const_last && !use_state) {
+      printf("  used = matchGenericConstBitTime(results->rawbuf + offset, "
+             "%s,\n%*sresults->rawlen - offset, %u,\n%*s%s, %s,\n%*s%s, %s,\n"
+             "%*s0, %s, true);\n", result, 34, "", bits, 34, "",
+             hdr_mark[i].c_str(), hdr_space[i].c_str(), 34, "", ones.c_str(),
+             zeros.c_str(), 34, "", gap[i].c_str());
+    } else {
+      printf("  used = matchGeneric(results->rawbuf + offset, %s,\n"
+             "%*sresults->rawlen - offset, %u,\n%*s%s, %s,\n%*s", result, 22,
+             "", bits - last_by_hand, 22, "", hdr_mark[i].c_str(),
+             hdr_space[i].c_str(), 22, "");
+      printf(bit_timings.c_str(), 22, "");
+      printf(",\n%*s%s, %s, true);\n", 22, "",
+             last_by_hand ? "0" : footer[i].c_str(),
+             last_by_hand ? "0" : gap[i].c_str());
+    }
+    printf("  if (!used) return false;\n  offset += used;\n");
+    if (last_by_hand && !use_state) {
+      const char *value = result + 1;
+      printf("  // The last bit has no space of its own. It is the gap.\n"
+             "  %s <<= 1;\n"
+             "  if (matchMark(results->rawbuf[offset], %s))\n"
+             "    %s |= 1;\n"
+             "  else if (!matchMark(results->rawbuf[offset], %s))\n"
+             "    return false;\n"
+             "  offset++;\n"
+             "  if (offset < results->rawlen &&\n"
+             "      !matchAtLeast(results->rawbuf[offset++], %s))\n"
+             "    return false;\n", value, ones.c_str(), value, zeros.c_str(),
+             gap[i].c_str());
+    }
+    if (use_state)
+      printf("  pos += %u;  // Adjust by how many bytes of data we read\n",
+             bits / 8);
+    else if (sections.size() > 1)
+      printf("  data <<= %u;  // Make room for the new bits of data.\n"
+             "  data |= section;\n", bits);
+  }
+  printf("\n  // Success\n  results->decode_type = decode_type_t::%s;\n"
+         "  results->bits = nbits;\n", u);
+  if (!use_state)
+    printf("  results->value = data;\n  results->command = 0;\n"
+           "  results->address = 0;\n");
+  printf("  return true;\n}\n#endif  // DECODE_%s\n\n", u);
+}
+
+/// Analyse & report each capture in a stream.
+/// @return The nr. of captures analysed.
+uint32_t analyseStream(std::istream *input, const analyse_options_t &options,
+                       analysis_t *analysis, IRdecoder *irdecoder) {
+  std::string line;
+  uint32_t count = 0;
+  while (std::getline(*input, line)) {
+    parseTimings(line, &analysis->timings);
+    if (analysis->timings.empty()) continue;
+    analysis->number++;
+    count++;
+    analyse(analysis, options, irdecoder);
+    if (options.csv)
+      reportCsv(*analysis);
+    else
+      reportText(*analysis);
+    if (options.generate) generateCode(*analysis, options.name);
+  }
+  return count;
+}
+
+int main(int argc, char *argv[]) {
+  analyse_options_t options;
+  options.margin = kDefaultMargin;
+  options.all = false;
+  options.csv = false;
+  options.generate = false;
+  options.name = "TBD";
+
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-' && argv[i][1]; i++) {
+    if (strcmp("-margin", argv[i]) == 0 && i + 1 < argc) {
+      char *end;
+      errno = 0;
+      intmax_t val = strtoimax(argv[++i], &end, 10);
+      if (errno == ERANGE || val < 0 || val > UINT16_MAX || *end != '\0') {
+        usage_error(argv[0]);
+        return 1;
+      }
+      options.margin = val;
+    } else if (strcmp("-all", argv[i]) == 0) {
+      options.all = true;
+    } else if (strcmp("-csv", argv[i]) == 0) {
+      options.csv = true;
+    } else if (strcmp("-g", argv[i]) == 0) {
+      options.generate = true;
+    } else if (strcmp("-name", argv[i]) == 0 && i + 1 < argc) {
+      options.name = argv[++i];
+    } else {
+      usage_error(argv[0]);
+      return 1;
+    }
+  }
+
+  IRdecoder irdecoder;
+  analysis_t analysis;
+  analysis.number = 0;
+  if (options.csv)
+    printf("capture,timings,protocol,encoding,hdr_mark,hdr_space,one_mark,"
+           "one_space,zero_mark,zero_space,gap,sections,bits,values,"
+           "verified\n");
+  if (i >= argc) {
+    analyseStream(&std::cin, options, &analysis, &irdecoder);
+    return 0;
+  }
+  for (; i < argc; i++) {
+    std::ifstream file(argv[i]);
+    if (!file) {
+      std::cerr << "Can't read: " << argv[i] << std::endl;
+      return 1;
+    }
+    analyseStream(&file, options, &analysis, &irdecoder);
+  }
+  return 0;
+}
@@ -22,6 +22,8 @@ class RawIRMessage():
     self.bit_mark = None
     self.zero_space = None
     self.one_space = None
+    self.one_mark = None
+    self.zero_mark = None
     self.gaps = []
     self.margin = margin
     self.marks = []
@@ -225,7 +227,9 @@ class RawIRMessage():
       # Probably no header mark.
       self.hdr_mark = 0
 
-    if self.is_space_encoded() and len(self.spaces) >= 2:
+    if self.is_const_bit_time():
+      self._calc_const_bit_time_values()
+    elif self.is_space_encoded() and len(self.spaces) >= 2:
       if self.verbose and len(self.marks) > 2:
         self.output.write("DANGER: Unusual number of mark timings!")
       # We should have 3 space candidates at least.
@@ -240,6 +244,57 @@ class RawIRMessage():
       # Rest are probably message gaps
       self.gaps = spaces
 
+  def _calc_const_bit_time_values(self):
+    """Calculate the timings for a constant bit time (mark) encoding.
+       i.e. The length of the mark is the bit value & the space pads it out."""
+    self.ldr_mark = None
+    self.one_mark = self.marks[-2]
+    self.zero_mark = self.marks[-1]
+    self.one_space = self.spaces[-1]  # A '1' has a long mark & short space.
+    self.zero_space = self.spaces[-2]  # A '0' has a short mark & long space.
+    # Anything larger than the bit marks is probably the header mark.
+    self.hdr_mark = self.marks[-3] if len(self.marks) > 2 else 0
+    self.hdr_space = None
+    if self.hdr_mark:
+      # The header space is the one that follows the first header mark.
+      for index in range(0, self.rawlen - 1, 2):
+        if self.is_hdr_mark(self.timings[index]):
+          self.hdr_space = self._bucket(self.timings[index + 1],
+                                        self.space_buckets)
+          break
+    # Rest are probably message gaps.
+    self.gaps = [x for x in self.spaces[:-2] if x != self.hdr_space]
+
+  def _bucket(self, usec, buckets):
+    """Find which bucket key a timing value belongs to."""
+    for key, values in buckets.items():
+      if usec in values:
+        return key
+    return None
+
+  def is_const_bit_time(self):
+    """Make an educated guess if the message uses constant bit time encoding.
+       i.e. A '1' (long mark & short space) takes as long as a '0'
+       (short mark & long space)."""
+    if len(self.marks) < 2 or len(self.spaces) < 2:
+      return False
+    long_mark = avg_list(self.mark_buckets[self.marks[-2]])
+    short_mark = avg_list(self.mark_buckets[self.marks[-1]])
+    long_space = avg_list(self.space_buckets[self.spaces[-2]])
+    short_space = avg_list(self.space_buckets[self.spaces[-1]])
+    return abs((long_mark + short_space) -
+               (short_mark + long_space)) <= self.margin
+
+  def is_one_mark(self, usec):
+    """Is usec the mark of a '1' bit? (constant bit time only)"""
+    return self.one_mark is not None and self._usec_compare(usec,
+                                                            self.one_mark)
+
+  def is_zero_mark(self, usec):
+    """Is usec the mark of a '0' bit? (constant bit time only)"""
+    return self.zero_mark is not None and self._usec_compare(usec,
+                                                             self.zero_mark)
+
   def is_space_encoded(self):
     """Make an educated guess if the message is space encoded."""
     return len(self.spaces) > len(self.marks)
@@ -377,36 +432,25 @@ def parse_and_report(rawdata_str, margin, gen_code=False, name="",
 
   message = RawIRMessage(margin, rawdata, output)
   output.write("\nGuessing encoding type:\n")
-  if message.is_space_encoded():
+  if message.is_const_bit_time():
+    output.write("Looks like it uses constant bit time (mark) encoding.\n\n")
+    dump_const_bit_time_constants(message, defines, name, output)
+    total_bits = decode_const_bit_time_data(message, defines, code, name,
+                                            output)
+  elif message.is_space_encoded():
     output.write("Looks like it uses space encoding. Yay!\n\n")
     dump_constants(message, defines, name, output)
+    total_bits = decode_data(message, defines, code, name, output)
   else:
     output.write("Sorry, it looks like it is Mark encoded. "
                  "I can't do that yet. Exiting.\n")
     sys.exit(1)
-  total_bits = decode_data(message, defines, code, name, output)
   if gen_code:
     generate_code(defines, code, total_bits, name, output)
 
 
-def decode_data(message, defines, code, name="", output=sys.stdout):
-  """Decode the data sequence with the given values in mind."""
-  # pylint: disable=too-many-branches,too-many-statements
-
-  # Now we have likely candidates for the key values, go through the original
-  # sequence and break it up and indicate accordingly.
-
-  output.write("\nDecoding protocol based on analysis so far:\n\n")
-  state = ""
-  code_info = {}
-  count = 1
-  total_bits = ""
-  binary_value = binary64_value = add_bit("", "reset")
-  if name:
-    def_name = name
-  else:
-    def_name = "TBD"
-
+def add_common_code(code, name, def_name):
+  """Add the code outline shared by all the encodings & decoding types."""
   code["sendcomhead"].extend([
       "",
       "#if SEND_%s" % def_name.upper(),
@@ -462,16 +506,37 @@ def decode_data(message, defines, code, name="", output=sys.stdout):
       "  if (strict && nbits != k%sBits)" % name,
       "    return false;",
       ""])
+  code["recvcomfoot"].extend([
+      "  return true;",
+      "}",
+      "#endif  // DECODE_%s" % def_name.upper()])
+
+
+def decode_data(message, defines, code, name="", output=sys.stdout):
+  """Decode the data sequence with the given values in mind."""
+  # pylint: disable=too-many-branches,too-many-statements
+
+  # Now we have likely candidates for the key values, go through the original
+  # sequence and break it up and indicate accordingly.
+
+  output.write("\nDecoding protocol based on analysis so far:\n\n")
+  state = ""
+  code_info = {}
+  count = 1
+  total_bits = ""
+  binary_value = binary64_value = add_bit("", "reset")
+  if name:
+    def_name = name
+  else:
+    def_name = "TBD"
+
+  add_common_code(code, name, def_name)
   code["recv"].extend([
       "  uint64_t data = 0;",
       "  match_result_t data_result;"])
   code["recv64+"].extend([
       "  uint16_t pos = 0;",
       "  uint16_t used = 0;"])
-  code["recvcomfoot"].extend([
-      "  return true;",
-      "}",
-      "#endif  // DECODE_%s" % def_name.upper()])
 
   # states are:
   #  HM:  Header/Leader mark
@@ -634,6 +699,194 @@ def decode_data(message, defines, code, name="", output=sys.stdout):
   return total_bits
 
 
+def dump_const_bit_time_constants(message, defines, name="",
+                                  output=sys.stdout):
+  """Dump the key constants and generate the C++ #defines for a constant bit
+     time (mark) encoded message."""
+  hdr_mark = 0
+  hdr_space = 0
+  if message.hdr_mark != 0:
+    hdr_mark = avg_list(message.mark_buckets[message.hdr_mark])
+  if message.hdr_space is not None:
+    hdr_space = avg_list(message.space_buckets[message.hdr_space])
+  one_mark = avg_list(message.mark_buckets[message.one_mark])
+  zero_mark = avg_list(message.mark_buckets[message.zero_mark])
+
+  output.write("Guessing key value:\n"
+               "k%sHdrMark   = %d\n"
+               "k%sHdrSpace  = %d\n"
+               "k%sOneMark   = %d\n"
+               "k%sZeroMark  = %d\n" % (name, hdr_mark, name, hdr_space,
+                                        name, one_mark, name, zero_mark))
+  defines.append("const uint16_t k%sHdrMark = %d;" % (name, hdr_mark))
+  defines.append("const uint16_t k%sHdrSpace = %d;" % (name, hdr_space))
+  defines.append("const uint16_t k%sOneMark = %d;  // Also the space of a '0'."
+                 % (name, one_mark))
+  defines.append("const uint16_t k%sZeroMark = %d;  // Also the space of a '1'."
+                 % (name, zero_mark))
+  defines.append("const uint16_t k%sFreq = 38000;  "
+                 "// Hz. (Guessing the most common frequency.)" % name)
+
+
+def add_const_bit_time_section(message, bin_str, firstmark, firstspace,
+                               gap_name, code, name=""):
+  """Add the send & decode code for a constant bit time data section."""
+  nbits = len(bin_str)
+  code["send"].extend([
+      "    // Data Section #%d" % message.section_count,
+      "    // e.g. data = 0x%X, nbits = %d" % (int(bin_str, 2), nbits),
+      "    sendGeneric(%s, %s," % (firstmark, firstspace),
+      "                k%sOneMark, k%sZeroMark," % (name, name),
+      "                k%sZeroMark, k%sOneMark," % (name, name),
+      "                0, %s," % gap_name,
+      "                send_data, %d, k%sFreq, true, 0, kDutyDefault);" % (
+          nbits, name),
+      "    send_data >>= %d;" % nbits])
+  code["recv"].extend([
+      "",
+      "  // Data Section #%d" % message.section_count,
+      "  // e.g. section = 0x%X, nbits = %d" % (int(bin_str, 2), nbits),
+      "  used = matchGenericConstBitTime(results->rawbuf + offset, &section,",
+      "                                  results->rawlen - offset, %d," % nbits,
+      "                                  %s, %s," % (firstmark, firstspace),
+      "                                  k%sOneMark, k%sZeroMark," % (name,
+                                                                      name),
+      "                                  0, %s, true);" % (
+          gap_name if gap_name != "kDefaultMessageGap" else "0"),
+      "  if (!used) return false;",
+      "  offset += used;",
+      "  data <<= %d;  // Make room for the new bits of data." % nbits,
+      "  data |= section;"])
+  message.section_count = message.section_count + 1
+
+
+def decode_const_bit_time_data(message, defines, code, name="",
+                               output=sys.stdout):
+  """Decode a constant bit time (mark) encoded data sequence with the given
+     values in mind."""
+  # pylint: disable=too-many-branches,too-many-statements
+  output.write("\nDecoding protocol based on analysis so far:\n\n")
+  if name:
+    def_name = name
+  else:
+    def_name = "TBD"
+  add_common_code(code, name, def_name)
+  code["recv"].extend([
+      "  uint64_t data = 0;",
+      "  uint64_t section = 0;",
+      "  uint16_t used = 0;"])
+  not_supported = ("  // TODO: Constant bit time encoding isn't supported over"
+                   " 64 bits yet.")
+  code["send64+"].append("  " + not_supported)
+  code["recv64+"].append(not_supported)
+
+  one_space = avg_list(message.space_buckets[message.one_space])
+  zero_space = avg_list(message.space_buckets[message.zero_space])
+  gaps = []
+  total_bits = ""
+  binary_value = add_bit("", "reset")
+  firstmark = firstspace = "0"
+  state = ""
+  bit = None
+  count = 1
+
+  def gap_name(index):
+    """The constant name for the given (1-based) gap."""
+    if index == 1:
+      return "k%sSpaceGap" % name
+    return "k%sSpaceGap%d" % (name, index)
+
+  # states are:
+  #  HM:  Header mark
+  #  HS:  Header space
+  #  BM:  Bit mark
+  #  BS:  Bit space
+  #  GS:  Gap space
+  #  UNK: Unknown state.
+  for usec in message.timings:
+    if count % 2:  # A mark.
+      if (message.hdr_mark and message.is_hdr_mark(usec) and
+          not message.is_one_mark(usec)):
+        if binary_value:  # A header with no gap before it. Flush the data.
+          message.display_binary(binary_value)
+          add_const_bit_time_section(message, binary_value, firstmark,
+                                     firstspace, "0", code, name)
+          total_bits = total_bits + binary_value
+          binary_value = add_bit(binary_value, "reset")
+        output.write("k%sHdrMark+" % name)
+        firstmark = "k%sHdrMark" % name
+        firstspace = "0"
+        state = "HM"
+      elif message.is_one_mark(usec) or message.is_zero_mark(usec):
+        if state not in ("", "HS", "BS", "GS"):
+          output.write("(UNEXPECTED)")
+        bit = 1 if message.is_one_mark(usec) else 0
+        state = "BM"
+      else:
+        output.write("UNKNOWN(%d)" % usec)
+        state = "UNK"
+    elif state == "HM" and message.is_hdr_space(usec):
+      output.write("k%sHdrSpace+" % name)
+      firstspace = "k%sHdrSpace" % name
+      state = "HS"
+    elif state == "BM":
+      binary_value = add_bit(binary_value, bit, output)
+      bit_space = one_space if bit else zero_space
+      if (message.is_one_space(usec) and bit) or (
+          message.is_zero_space(usec) and not bit):
+        state = "BS"
+      elif usec > bit_space + message.margin:  # The end of a section.
+        gap = usec - bit_space
+        output.write("GAP(%d)" % gap)
+        index = 0
+        for seen, known in enumerate(gaps):
+          if abs(known - gap) <= message.margin:
+            index = seen + 1
+        if not index:
+          gaps.append(gap)
+          index = len(gaps)
+        message.display_binary(binary_value)
+        add_const_bit_time_section(message, binary_value, firstmark,
+                                   firstspace, gap_name(index), code, name)
+        total_bits = total_bits + binary_value
+        binary_value = add_bit(binary_value, "reset")
+        firstmark = firstspace = "0"
+        state = "GS"
+      else:
+        output.write("(UNEXPECTED)")
+        state = "BS"
+    else:
+      output.write("UNKNOWN(%d)" % usec)
+      state = "UNK"
+    count = count + 1
+  if state == "BM":  # The last bit has no space after it.
+    binary_value = add_bit(binary_value, bit, output)
+  if binary_value:
+    message.display_binary(binary_value)
+    add_const_bit_time_section(message, binary_value, firstmark, firstspace,
+                               "kDefaultMessageGap", code, name)
+    total_bits = total_bits + binary_value
+  code["recv"].extend([
+      "",
+      "  // Success",
+      "  results->decode_type = decode_type_t::%s;" % def_name.upper(),
+      "  results->bits = nbits;",
+      "  results->value = data;",
+      "  results->command = 0;",
+      "  results->address = 0;"])
+
+  for index, gap in enumerate(gaps):
+    output.write("\n%s = %d" % (gap_name(index + 1), gap))
+    defines.append("const uint16_t %s = %d;" % (gap_name(index + 1), gap))
+  output.write("\nTotal Nr. of suspected bits: %d\n" % len(total_bits))
+  defines.append("const uint16_t k%sBits = %d;"
+                 "  // Move to IRremoteESP8266.h" % (name, len(total_bits)))
+  # The final bit may not have a space, so don't let the overhead go negative.
+  defines.append("const uint16_t k%sOverhead = %d;" %
+                 (name, max(message.rawlen - 2 * len(total_bits), 0)))
+  return total_bits
+
+
 def generate_code(defines, code, bits_str, name="", output=sys.stdout):
   """Output the estimated C++ code to reproduce & decode the IR message."""
   # pylint: disable=too-many-branches
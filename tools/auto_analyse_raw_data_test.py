@@ -1496,5 +1496,75 @@ class TestAutoAnalyseRawData(unittest.TestCase):
         '#endif  // DECODE_TBD\n')
 
 
+  def test_const_bit_time(self):
+    """Tests for constant bit time (mark) encoded messages."""
+
+    # Real Symphony message. (Ref: ir_Symphony_test.cpp)
+    output = StringIO()
+    input_str = """
+      uint16_t rawData[47] = {
+        1296, 412, 1294, 386, 420, 1224, 1322, 390, 1290, 390, 420, 1224, 452,
+        1220, 1314, 394, 420, 1222, 482, 1190, 480, 1192, 452, 7960,
+        1290, 420, 1290, 390, 418, 1226, 1318, 394, 1262, 416, 420, 1224, 454,
+        1220, 1292, 416, 422, 1222, 450, 1222, 452, 1218, 454};"""
+    analyse.parse_and_report(input_str, 200, False, "", output)
+    self.assertEqual(
+        output.getvalue(),
+        'Found 47 timing entries.\n'
+        'Potential Mark Candidates:\n'
+        '[1322, 482]\n'
+        'Potential Space Candidates:\n'
+        '[7960, 1226, 420]\n'
+        '\n'
+        'Guessing encoding type:\n'
+        'Looks like it uses constant bit time (mark) encoding.\n'
+        '\n'
+        'Guessing key value:\n'
+        'kHdrMark   = 0\n'
+        'kHdrSpace  = 0\n'
+        'kOneMark   = 1296\n'
+        'kZeroMark  = 442\n'
+        '\n'
+        'Decoding protocol based on analysis so far:\n'
+        '\n'
+        '110110010000GAP(6743)\n'
+        '  Bits: 12\n'
+        '  Hex:  0xD90 (MSB first)\n'
+        '        0x09B (LSB first)\n'
+        '  Dec:  3472 (MSB first)\n'
+        '        155 (LSB first)\n'
+        '  Bin:  0b110110010000 (MSB first)\n'
+        '        0b000010011011 (LSB first)\n'
+        '110110010000\n'
+        '  Bits: 12\n'
+        '  Hex:  0xD90 (MSB first)\n'
+        '        0x09B (LSB first)\n'
+        '  Dec:  3472 (MSB first)\n'
+        '        155 (LSB first)\n'
+        '  Bin:  0b110110010000 (MSB first)\n'
+        '        0b000010011011 (LSB first)\n'
+        '\n'
+        'kSpaceGap = 6743\n'
+        'Total Nr. of suspected bits: 24\n')
+    output = StringIO()
+    analyse.parse_and_report(input_str, 200, True, "Symphony", output)
+    self.assertIn(
+        '    sendGeneric(0, 0,\n'
+        '                kSymphonyOneMark, kSymphonyZeroMark,\n'
+        '                kSymphonyZeroMark, kSymphonyOneMark,\n'
+        '                0, kSymphonySpaceGap,\n'
+        '                send_data, 12, kSymphonyFreq, true, 0, kDutyDefault);'
+        '\n', output.getvalue())
+    self.assertIn(
+        '  used = matchGenericConstBitTime(results->rawbuf + offset, &section,'
+        '\n'
+        '                                  results->rawlen - offset, 12,\n'
+        '                                  0, 0,\n'
+        '                                  kSymphonyOneMark, kSymphonyZeroMark,'
+        '\n'
+        '                                  0, kSymphonySpaceGap, true);\n',
+        output.getvalue())
+
+
 if __name__ == '__main__':
   unittest.main(verbosity=2)
@@ -0,0 +1,134 @@
+// Quick and dirty tool to benchmark the bit twiddling helpers in IRutils
+// Copyright 2026 The IRremoteESP8266 authors
+
+// Usage example:
+// ./bits_bench [-n iterations]
+
+// Compares `reverseBits()` & `reverseBytes()` against the original bit by bit
+// version of `reverseBits()`, for the sizes the protocols typically use, and
+// the checksum helpers against the original byte by byte loops.
+// Note: This runs on the host, so the ratios are only a rough guide to what an
+//       ESP8266 or ESP32 would see.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <iostream>
+#include "IRutils.h"
+
+const uint32_t kDefaultIterations = 1000000;
+const uint8_t kStateSize = 53;  // The largest A/C state we have.
+
+// The original bit by bit version of `reverseBits()`.
+uint64_t slowReverseBits(uint64_t input, uint16_t nbits) {
+  if (nbits <= 1) return input;
+  nbits = std::min(nbits, (uint16_t)(sizeof(input) * 8));
+  uint64_t output = 0;
+  for (uint16_t i = 0; i < nbits; i++) {
+    output <<= 1;
+    output |= (input & 1);
+    input >>= 1;
+  }
+  return (input << nbits) | output;
+}
+
+void usage_error(char *name) {
+  std::cerr << "Usage: " << name << " [-n iterations]" << std::endl;
+}
+
+// Time `iterations` calls of `func` on changing values. Returns ns per call.
+template <typename FUNC>
+double timeIt(const uint32_t iterations, FUNC func) {
+  volatile uint64_t sink = 0;  // Stop the calls being optimised away.
+  uint64_t value = 0x0123456789ABCDEF;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    sink = sink + func(value);
+    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      stop - start).count() / (double)iterations;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t iterations = kDefaultIterations;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp("-n", argv[i], 2) == 0 && i + 1 < argc) {
+      char *end;
+      errno = 0;
+      intmax_t val = strtoimax(argv[++i], &end, 10);
+      if (errno == ERANGE || val <= 0 || val > UINT32_MAX || *end != '\0') {
+        usage_error(argv[0]);
+        return 1;
+      }
+      iterations = (uint32_t)val;
+    } else {
+      usage_error(argv[0]);
+      return 1;
+    }
+  }
+
+  printf("%-28s %10s %10s %8s\n", "Function", "old ns", "new ns", "speedup");
+  const uint16_t sizes[] = {8, 16, 32, 48, 64};
+  for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const uint16_t nbits = sizes[s];
+    const double old_ns = timeIt(iterations, [nbits](uint64_t value) {
+        return slowReverseBits(value, nbits); });
+    const double new_ns = timeIt(iterations, [nbits](uint64_t value) {
+        return reverseBits(value, nbits); });
+    printf("reverseBits(x, %-2" PRIu16 ")            %10.2f %10.2f %7.1fx\n",
+           nbits, old_ns, new_ns, old_ns / new_ns);
+  }
+
+  uint8_t state[kStateSize];
+  memset(state, 0xA5, sizeof(state));
+  const uint32_t state_iterations = std::max(iterations / kStateSize, 1U);
+  const double old_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      for (uint8_t i = 0; i < kStateSize; i++)
+        state[i] = slowReverseBits(state[i], 8);
+      return state[kStateSize - 1]; });
+  const double new_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      reverseBytes(state, kStateSize);
+      return state[kStateSize - 1]; });
+  printf("reverseBytes(state, %-2" PRIu8 ")       %10.2f %10.2f %7.1fx\n",
+         kStateSize, old_ns, new_ns, old_ns / new_ns);
+
+  const double sum_old_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      uint8_t sum = 0;
+      for (uint8_t i = 0; i < kStateSize; i++) sum += state[i];
+      return sum; });
+  const double sum_new_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      return sumBytes(state, kStateSize); });
+  printf("sumBytes(state, %-2" PRIu8 ")           %10.2f %10.2f %7.1fx\n",
+         kStateSize, sum_old_ns, sum_new_ns, sum_old_ns / sum_new_ns);
+  const double xor_old_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      uint8_t sum = 0;
+      for (uint8_t i = 0; i < kStateSize; i++) sum ^= state[i];
+      return sum; });
+  const double xor_new_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      return xorBytes(state, kStateSize); });
+  printf("xorBytes(state, %-2" PRIu8 ")           %10.2f %10.2f %7.1fx\n",
+         kStateSize, xor_old_ns, xor_new_ns, xor_old_ns / xor_new_ns);
+  const double bit_old_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      uint16_t count = 0;
+      for (uint8_t i = 0; i < kStateSize; i++)
+        for (uint8_t b = 0; b < 8; b++) count += (state[i] >> b) & 1;
+      return count; });
+  const double bit_new_ns = timeIt(state_iterations, [&state](uint64_t value) {
+      state[0] ^= value;
+      return countBits(state, kStateSize); });
+  printf("countBits(state, %-2" PRIu8 ")          %10.2f %10.2f %7.1fx\n",
+         kStateSize, bit_old_ns, bit_new_ns, bit_old_ns / bit_new_ns);
+  return 0;
+}
@@ -0,0 +1,234 @@
+#!/usr/bin/python3
+"""Read the binary capture stream of IRrecvDumpV2/V3's BINARY_DUMP mode.
+
+The stream is a capture file (See `irutils::CaptureWriter`) written straight
+to the serial port, so captures are sent in a fraction of the time their text
+takes, & none are lost during bursts. Any noise before it (e.g. the ESP8266's
+boot messages), a reset (a new header), or bytes lost on the way are skipped.
+e.g. Record it to a capture file, listing each capture as it arrives:
+  tools/capture_stream.py /dev/ttyUSB0 --baud 921600 -o captures.irc
+then decode it with `tools/gc_decode -capture captures.irc`.
+Or print the timings of each capture in an earlier recording of the port:
+  tools/capture_stream.py recording.bin --raw
+"""
+#
+# Copyright 2026 The IRremoteESP8266 authors
+import argparse
+import struct
+import sys
+import decode_trace
+
+# See IRutils.h & IRutils.cpp
+FILE_MAGIC = b"IRcf"
+FILE_VERSION = 1
+FILE_HEADER_SIZE = 8
+RECORD_HEADER_SIZE = 16
+FLAG_OVERFLOW = 0b1
+DEFAULT_TICK = 2  # kRawTick. uSeconds per `rawbuf[]` tick.
+# The longest capture we accept, so a corrupt size can't stall the stream.
+MAX_RECORD_SIZE = RECORD_HEADER_SIZE + 3 * 0x10000
+
+
+def unpack(ticks, rawlen):
+  """Decode the delta encoded `rawbuf[]` entries of a capture.
+
+  Args:
+    ticks: The bytes of them.
+    rawlen: Nr. of entries.
+  Returns:
+    A list of the entries, or None if they are corrupt. Only zeros may follow.
+  """
+  rawbuf = []
+  pos = 0
+  for i in range(rawlen):
+    value = 0
+    shift = 0
+    while True:
+      if pos >= len(ticks) or shift > 14:
+        return None
+      byte = ticks[pos]
+      pos += 1
+      value |= (byte & 0x7F) << shift
+      shift += 7
+      if not byte & 0x80:
+        break
+    delta = -((value + 1) >> 1) if value & 1 else value >> 1
+    entry = (rawbuf[i - 2] if i > 1 else 0) + delta
+    if not 0 <= entry <= 0xFFFF:
+      return None
+    rawbuf.append(entry)
+  if any(ticks[pos:]) or len(ticks) - pos > 3:
+    return None
+  return rawbuf
+
+
+def parse_record(data, pos):
+  """Parse the capture record at a position of the stream.
+
+  Args:
+    data: The stream so far.
+    pos: The offset of the record.
+  Returns:
+    A tuple of the capture (a dict) & its size, (None, 0) if there isn't a
+    valid one there, or (None, None) if there isn't enough data yet to tell.
+  """
+  if len(data) - pos < RECORD_HEADER_SIZE:
+    return None, None
+  size, protocol, frequency, timestamp, rawlen, flags, reserved = (
+      struct.unpack_from("<IhHIHBB", data, pos))
+  if (size < RECORD_HEADER_SIZE or size % 4 or size > MAX_RECORD_SIZE or
+      flags & ~FLAG_OVERFLOW or reserved or
+      size - RECORD_HEADER_SIZE < rawlen):
+    return None, 0
+  if len(data) - pos < size:
+    return None, None
+  rawbuf = unpack(data[pos + RECORD_HEADER_SIZE:pos + size], rawlen)
+  if rawbuf is None:
+    return None, 0
+  return {"protocol": protocol, "frequency": frequency,
+          "timestamp": timestamp, "overflow": bool(flags & FLAG_OVERFLOW),
+          "rawbuf": rawbuf, "record": bytes(data[pos:pos + size])}, size
+
+
+class StreamParser:
+  """Splits a capture stream into its captures, skipping what isn't one."""
+
+  def __init__(self):
+    self.data = bytearray()
+    self.tick = None  # uSeconds per tick. None until a header is seen.
+    self.skipped = 0  # Nr. of bytes that weren't part of a capture.
+    self.resets = 0  # Nr. of headers seen.
+
+  def feed(self, chunk):
+    """Add more of the stream.
+
+    Args:
+      chunk: The bytes.
+    Returns:
+      A list of the captures completed by them.
+    """
+    self.data += chunk
+    captures = []
+    pos = 0
+    while pos < len(self.data):
+      if self.data[pos:pos + len(FILE_MAGIC)] == FILE_MAGIC:
+        if len(self.data) - pos < FILE_HEADER_SIZE:
+          break  # Wait for the rest of it.
+        if self.data[pos + 4] == FILE_VERSION:
+          self.tick = struct.unpack_from("<H", self.data, pos + 6)[0]
+          self.resets += 1
+          pos += FILE_HEADER_SIZE
+          continue
+      elif FILE_MAGIC.startswith(bytes(self.data[pos:])):
+        break  # Maybe the start of a header.
+      capture, size = parse_record(self.data, pos)
+      if size is None:
+        break  # Wait for more.
+      if capture is None:
+        pos += 1
+        self.skipped += 1
+        continue
+      captures.append(capture)
+      pos += size
+    del self.data[:pos]
+    return captures
+
+  def usecs(self, capture):
+    """The marks & spaces of a capture, in uSeconds.
+
+    Args:
+      capture: The capture.
+    Returns:
+      A list of them. i.e. Without the gap before the capture.
+    """
+    tick = self.tick or DEFAULT_TICK
+    return [entry * tick for entry in capture["rawbuf"][1:]]
+
+
+def describe(capture, names, parser, raw=False):
+  """Describe a capture in a line (or two) of text.
+
+  Args:
+    capture: The capture.
+    names: A dict of the protocol names, by their value.
+    parser: The StreamParser it came from.
+    raw: Include its timings?
+  Returns:
+    The text.
+  """
+  timestamp = capture["timestamp"]
+  text = "%06u.%03u %s, %d entries, %d kHz%s" % (
+      timestamp // 1000, timestamp % 1000,
+      names.get(capture["protocol"], str(capture["protocol"])),
+      len(capture["rawbuf"]), capture["frequency"],
+      ", OVERFLOWED" if capture["overflow"] else "")
+  if raw:
+    usecs = parser.usecs(capture)
+    text += "\nuint16_t rawData[%d] = {%s};" % (
+        len(usecs), ", ".join(str(value) for value in usecs))
+  return text
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument("input",
+                          help="The serial port, or a recording of it. "
+                          "'-' for stdin.")
+  arg_parser.add_argument("--baud", type=int,
+                          help="Open the input as a serial port at this baud "
+                          "rate. (Needs pyserial)")
+  arg_parser.add_argument("-o", "--output",
+                          help="Write the captures to this capture file.")
+  arg_parser.add_argument("--raw", action="store_true",
+                          help="Print the timings of each capture too.")
+  arg_parser.add_argument("-q", "--quiet", action="store_true",
+                          help="Don't print the captures.")
+  arg_parser.add_argument("--header", default=decode_trace.DEFAULT_HEADER,
+                          help="Path to IRremoteESP8266.h, for the protocol "
+                          "names. (Default: %(default)s)")
+  args = arg_parser.parse_args()
+  with open(args.header) as header:
+    names = decode_trace.protocol_names(header.read())
+  if args.baud:
+    import serial  # pylint: disable=import-outside-toplevel
+    stream = serial.Serial(args.input, args.baud, timeout=0.1)
+  elif args.input == "-":
+    stream = sys.stdin.buffer
+  else:
+    stream = open(args.input, "rb")
+  output = None
+  if args.output:
+    output = open(args.output, "wb")
+    output.write(FILE_MAGIC + struct.pack("<BBH", FILE_VERSION, 0,
+                                          DEFAULT_TICK))
+  parser = StreamParser()
+  count = 0
+  try:
+    while True:
+      chunk = stream.read(4096)
+      if not chunk:
+        if args.baud:
+          continue  # Just a quiet moment.
+        break
+      for capture in parser.feed(chunk):
+        count += 1
+        if parser.tick not in (None, DEFAULT_TICK):
+          sys.exit("Unsupported tick size: %d" % parser.tick)
+        if output:
+          output.write(capture["record"])
+          output.flush()
+        if not args.quiet:
+          print(describe(capture, names, parser, args.raw), flush=True)
+  except KeyboardInterrupt:
+    pass
+  finally:
+    if output:
+      output.close()
+  print("%d captures, %d bytes skipped, %d resets." % (
+      count, parser.skipped, parser.resets), file=sys.stderr)
+
+
+if __name__ == "__main__":
+  main()
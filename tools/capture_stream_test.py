@@ -0,0 +1,92 @@
+#!/usr/bin/python3
+"""Unit tests for capture_stream.py"""
+import struct
+import unittest
+import capture_stream
+
+# What `irutils::CaptureWriter::begin()` writes.
+HEADER = b"IRcf" + bytes([1, 0, 2, 0])
+NAMES = {-1: "UNKNOWN", 0: "UNUSED", 3: "NEC"}
+
+
+def record(rawbuf, protocol=3, frequency=38, timestamp=1234, flags=0):
+  """A capture record, as `irutils::CaptureWriter::add()` writes it."""
+  ticks = b""
+  for i, entry in enumerate(rawbuf):
+    delta = entry - (rawbuf[i - 2] if i > 1 else 0)
+    value = ((-delta) << 1) - 1 if delta < 0 else delta << 1
+    while value > 0x7F:
+      ticks += bytes([(value & 0x7F) | 0x80])
+      value >>= 7
+    ticks += bytes([value])
+  size = (capture_stream.RECORD_HEADER_SIZE + len(ticks) + 3) & ~3
+  ticks += bytes(size - capture_stream.RECORD_HEADER_SIZE - len(ticks))
+  return struct.pack("<IhHIHBB", size, protocol, frequency, timestamp,
+                     len(rawbuf), flags, 0) + ticks
+
+
+class TestCaptureStream(unittest.TestCase):
+  """Unit tests for the methods in capture_stream."""
+
+  def test_unpack(self):
+    """The `rawbuf[]` entries are delta encoded from two entries before."""
+    rawbuf = [50000, 4500, 2250, 280, 845, 280, 280]
+    self.assertEqual(capture_stream.unpack(record(rawbuf)[16:], 7), rawbuf)
+    self.assertIsNone(capture_stream.unpack(b"\x04", 2))  # Too short.
+    self.assertIsNone(capture_stream.unpack(b"\x04\x04\x01", 2))  # Not 0.
+    self.assertIsNone(capture_stream.unpack(b"\x01", 1))  # Negative.
+
+  def test_parse_record(self):
+    """Records are checked, & complete."""
+    data = record([100, 200, 300])
+    capture, size = capture_stream.parse_record(data, 0)
+    self.assertEqual(size, 24)
+    self.assertEqual(capture["rawbuf"], [100, 200, 300])
+    self.assertEqual(capture["protocol"], 3)
+    self.assertEqual(capture["timestamp"], 1234)
+    self.assertFalse(capture["overflow"])
+    self.assertEqual(capture["record"], data)
+    self.assertEqual(capture_stream.parse_record(data[:23], 0), (None, None))
+    self.assertEqual(capture_stream.parse_record(b"x" * 24, 0), (None, 0))
+    capture, _ = capture_stream.parse_record(record([1], flags=1), 0)
+    self.assertTrue(capture["overflow"])
+
+  def test_stream(self):
+    """Captures are found in a stream, whatever is around them."""
+    first = record([1000, 4500, 2250, 280], timestamp=1)
+    second = record([2000, 300, 400], timestamp=2)
+    stream = b"ets Jan  8 2013,rst cause:2\r\n" + HEADER + first + second
+    parser = capture_stream.StreamParser()
+    captures = []
+    for i in range(0, len(stream), 5):  # In small pieces, as from a port.
+      captures += parser.feed(stream[i:i + 5])
+    self.assertEqual([capture["timestamp"] for capture in captures], [1, 2])
+    self.assertEqual(parser.tick, 2)
+    self.assertEqual(parser.resets, 1)
+    self.assertEqual(parser.skipped, 29)
+    self.assertEqual(parser.usecs(captures[0]), [9000, 4500, 560])
+
+    # Bytes lost from a capture lose only it. A reset is a new header.
+    parser = capture_stream.StreamParser()
+    captures = parser.feed(HEADER + first[:10] + first[11:] + second +
+                           HEADER + first)
+    self.assertEqual([capture["timestamp"] for capture in captures], [2, 1])
+    self.assertEqual(parser.resets, 2)
+    self.assertEqual(parser.skipped, len(first) - 1)
+
+  def test_describe(self):
+    """A line per capture, & optionally its timings."""
+    parser = capture_stream.StreamParser()
+    capture, _ = capture_stream.parse_record(record([1000, 4500, 2250],
+                                                    timestamp=61234), 0)
+    self.assertEqual(capture_stream.describe(capture, NAMES, parser),
+                     "000061.234 NEC, 3 entries, 38 kHz")
+    capture["protocol"] = 42
+    capture["overflow"] = True
+    self.assertEqual(capture_stream.describe(capture, NAMES, parser, raw=True),
+                     "000061.234 42, 3 entries, 38 kHz, OVERFLOWED\n"
+                     "uint16_t rawData[2] = {9000, 4500};")
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
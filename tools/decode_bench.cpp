@@ -0,0 +1,191 @@
+// Quick and dirty tool to benchmark decode() against a corpus of raw captures
+// Copyright 2026 The IRremoteESP8266 authors
+
+// Usage example:
+// ./decode_bench [-n iterations] [-v] decode_bench_corpus.txt
+
+/* Sample input (The rawData[] arrays as output by resultToSourceCode()):
+uint16_t rawData[71] = {8990, 4510,  562, 1686,  562, 562, ...};  // NEC 20DF10EF
+uint16_t rawData[25] = {2400, 600,  1200, 600,  600, 600, ...};  // SONY 240
+*/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "IRrecv.h"
+#include "IRutils.h"
+
+const uint16_t kMaxCaptureLength = 10000;
+const uint32_t kDefaultIterations = 100;
+
+/// A single raw capture from the corpus, in rawbuf[] format. i.e. Ticks.
+typedef struct {
+  std::vector<uint16_t> rawbuf;
+  uint32_t line;
+} capture_t;
+
+/// The per capture timings, grouped by the protocol it decoded as.
+typedef struct {
+  std::vector<uint64_t> nsecs;
+  uint32_t decodes;
+} latency_t;
+
+void usage_error(char *name) {
+  std::cerr << "Usage: " << name << " [-n iterations] [-v] [corpus_file ...]"
+            << std::endl
+            << "Reads the uint16_t rawData[] arrays output by "
+               "resultToSourceCode() from the files (or stdin if none are "
+               "given) and times decode() on each of them." << std::endl;
+}
+
+// Extract every `rawData[] = {...};` array in the stream into `corpus`.
+void parse_corpus(std::istream &in, std::vector<capture_t> *corpus) {
+  std::string line;
+  uint32_t lineno = 0;
+  bool inside = false;
+  capture_t capture;
+  while (getline(in, line)) {
+    lineno++;
+    size_t pos = 0;
+    if (!inside) {
+      pos = line.find("rawData[");
+      if (pos == std::string::npos) continue;
+      pos = line.find('{', pos);
+      if (pos == std::string::npos) continue;
+      pos++;
+      inside = true;
+      capture.rawbuf.assign(1, 0);  // rawbuf[0] is never used by decode().
+      capture.line = lineno;
+    }
+    size_t end = line.find('}', pos);
+    std::string values = line.substr(pos, end == std::string::npos ?
+                                          std::string::npos : end - pos);
+    size_t comment = values.find("//");
+    if (comment != std::string::npos) values.erase(comment);
+    std::replace(values.begin(), values.end(), ',', ' ');
+    std::istringstream iss(values);
+    uint32_t usecs;
+    while (iss >> usecs &&
+           capture.rawbuf.size() <= kMaxCaptureLength)
+      capture.rawbuf.push_back(std::min(usecs / kRawTick,
+                                        (uint32_t)UINT16_MAX));
+    if (end != std::string::npos) {
+      inside = false;
+      if (capture.rawbuf.size() > 1) corpus->push_back(capture);
+    }
+  }
+}
+
+uint64_t percentile(const std::vector<uint64_t> &sorted, uint8_t pct) {
+  if (sorted.empty()) return 0;
+  return sorted[(sorted.size() - 1) * pct / 100];
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t iterations = kDefaultIterations;
+  bool verbose = false;
+  std::vector<capture_t> corpus;
+  bool read_file = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp("-n", argv[i], 2) == 0 && i + 1 < argc) {
+      char *end;
+      errno = 0;
+      intmax_t val = strtoimax(argv[++i], &end, 10);
+      if (errno == ERANGE || val <= 0 || val > UINT32_MAX || *end != '\0') {
+        usage_error(argv[0]);
+        return 1;
+      }
+      iterations = (uint32_t)val;
+    } else if (strncmp("-v", argv[i], 2) == 0) {
+      verbose = true;
+    } else if (argv[i][0] == '-') {
+      usage_error(argv[0]);
+      return 1;
+    } else {
+      std::ifstream file(argv[i]);
+      if (!file) {
+        std::cerr << "Unable to open: " << argv[i] << std::endl;
+        return 1;
+      }
+      parse_corpus(file, &corpus);
+      read_file = true;
+    }
+  }
+  if (!read_file) parse_corpus(std::cin, &corpus);
+  if (corpus.empty()) {
+    std::cerr << "No rawData[] arrays found." << std::endl;
+    usage_error(argv[0]);
+    return 1;
+  }
+
+  IRrecv irrecv(4);
+  irrecv.enableDecodeProfiling();
+  std::vector<latency_t> latency(kDecodeTypeCount);
+  decode_results results;
+  uint64_t total_ns = 0;
+  uint64_t total_decodes = 0;
+
+  for (size_t c = 0; c < corpus.size(); c++) {
+    std::vector<uint16_t> &rawbuf = corpus[c].rawbuf;
+    decode_type_t protocol = UNKNOWN;
+    std::vector<uint64_t> nsecs;
+    for (uint32_t n = 0; n < iterations; n++) {
+      results.rawbuf = rawbuf.data();
+      results.rawlen = rawbuf.size();
+      results.overflow = false;
+      auto start = std::chrono::steady_clock::now();
+      irrecv.decode(&results);
+      auto stop = std::chrono::steady_clock::now();
+      nsecs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          stop - start).count());
+      protocol = results.decode_type;
+    }
+    latency_t &entry = latency[protocol - UNKNOWN];
+    entry.decodes++;
+    entry.nsecs.insert(entry.nsecs.end(), nsecs.begin(), nsecs.end());
+    for (size_t i = 0; i < nsecs.size(); i++) total_ns += nsecs[i];
+    total_decodes += iterations;
+    if (verbose) {
+      std::sort(nsecs.begin(), nsecs.end());
+      std::cout << "Line " << corpus[c].line << ": "
+                << typeToString(protocol, results.repeat) << " ("
+                << results.bits << " bits) median "
+                << percentile(nsecs, 50) << " ns" << std::endl;
+    }
+  }
+
+  uint64_t attempts = 0;
+  for (uint16_t i = 0; i < kDecodeTypeCount; i++)
+    attempts += irrecv.getDecodeProfile((decode_type_t)(i + UNKNOWN))->attempts;
+
+  std::cout << "Captures        " << corpus.size() << std::endl
+            << "Iterations      " << iterations << std::endl
+            << "Decodes/sec     "
+            << (total_ns ? total_decodes * 1000000000ULL / total_ns : 0)
+            << std::endl
+            << "Attempts        " << attempts << std::endl
+            << "ns per attempt  " << (attempts ? total_ns / attempts : 0)
+            << std::endl << std::endl;
+  printf("%-24s %8s %10s %10s %10s %10s\n", "Protocol", "Captures",
+         "min ns", "median ns", "p95 ns", "max ns");
+  for (uint16_t i = 0; i < kDecodeTypeCount; i++) {
+    latency_t &entry = latency[i];
+    if (!entry.decodes) continue;
+    std::sort(entry.nsecs.begin(), entry.nsecs.end());
+    printf("%-24s %8" PRIu32 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64
+           " %10" PRIu64 "\n",
+           typeToString((decode_type_t)(i + UNKNOWN)).c_str(), entry.decodes,
+           entry.nsecs.front(), percentile(entry.nsecs, 50),
+           percentile(entry.nsecs, 95), entry.nsecs.back());
+  }
+  return 0;
+}
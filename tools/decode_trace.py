@@ -0,0 +1,118 @@
+#!/usr/bin/python3
+"""Pretty-print a decode trace dumped by the IRremoteESP8266 library.
+
+Record & dump a trace on the device with e.g.
+  irrecv.enableDecodeTrace();
+  ...
+  if (irrecv.decode(&results)) Serial.print(decodeTraceToString(&irrecv));
+then capture the serial output, and:
+  tools/decode_trace.py serial.log
+"""
+#
+# Copyright 2020 David Conran
+import argparse
+import os
+import re
+import sys
+
+# The header line of a dump. e.g. "# Decode trace: 80 ticks/usec, 5 events"
+HEADER_LINE = re.compile(r"^# Decode trace: (?P<rate>\d+) ticks/usec")
+# An event line of a dump: ticks event protocol offset value
+EVENT_LINE = re.compile(r"^(\d+) (\d+) (-?\d+) (\d+) (\d+)$")
+# How each decode_trace_event_t is described. Indexed by its value.
+EVENTS = (
+    "Capture of {value} entries",
+    "Attempting {protocol}",
+    "{protocol} skipped, due to a {value} usec header mark",
+    "{protocol} failed on a {value} usec mark",
+    "{protocol} failed on a {value} usec space",
+    "Decoded as {protocol} ({value} bits)",
+    "Not decoded",
+)
+# Where the decode_type_t enum is.
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "src", "IRremoteESP8266.h")
+
+
+def protocol_names(header_text):
+  """Find the name of each protocol in the `decode_type_t` enum.
+
+  Args:
+    header_text: The text of IRremoteESP8266.h.
+  Returns:
+    A dict of the names, by their value.
+  """
+  enum = re.search(r"enum decode_type_t \{(.*?)\};", header_text, re.DOTALL)
+  names = {}
+  value = 0
+  for line in enum.group(1).splitlines() if enum else []:
+    match = re.match(r"^\s*([A-Z][A-Z0-9_]*)\s*(?:=\s*(-?\d+))?\s*,", line)
+    if not match:
+      continue
+    if match.group(2) is not None:
+      value = int(match.group(2))
+    names[value] = match.group(1)
+    value += 1
+  return names
+
+
+def parse_trace(text):
+  """Extract the decode trace(s) from a dump, e.g. a serial log.
+
+  Args:
+    text: The text containing the dump.
+  Returns:
+    A list of (rate, list of (ticks, event, protocol, offset, value)) of each
+    trace found.
+  """
+  traces = []
+  for line in text.splitlines():
+    line = line.strip()
+    header = HEADER_LINE.match(line)
+    if header:
+      traces.append((int(header.group("rate")), []))
+      continue
+    event = EVENT_LINE.match(line)
+    if event and traces:
+      traces[-1][1].append(tuple(int(field) for field in event.groups()))
+  return traces
+
+
+def report(traces, names, output=sys.stdout):
+  """Write the decode trace(s) in a human readable form.
+
+  Args:
+    traces: The output of parse_trace().
+    names: The output of protocol_names().
+    output: Where to write the report.
+  """
+  for rate, events in traces:
+    start = events[0][0] if events else 0
+    for ticks, event, protocol, offset, value in events:
+      usecs = ((ticks - start) & 0xFFFFFFFF) / max(rate, 1)
+      text = EVENTS[event] if event < len(EVENTS) else "Event %d" % event
+      output.write("%10.1f us  [%3d]  %s\n" % (
+          usecs, offset, text.format(
+              protocol=names.get(protocol, "Protocol %d" % protocol),
+              value=value)))
+    output.write("\n")
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument(
+      "file", nargs="?", type=argparse.FileType("r"), default=sys.stdin,
+      help="The dump. e.g. A serial log. (Default: stdin)")
+  arg_parser.add_argument(
+      "--header", default=DEFAULT_HEADER,
+      help="Where the decode_type_t enum is. (Default: %(default)s)")
+  args = arg_parser.parse_args()
+  with open(args.header) as header:
+    names = protocol_names(header.read())
+  report(parse_trace(args.file.read()), names)
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,64 @@
+#!/usr/bin/python3
+"""Unit tests for decode_trace.py"""
+from io import StringIO
+import unittest
+import decode_trace
+
+HEADER = """
+enum decode_type_t {
+  UNKNOWN = -1,
+  UNUSED = 0,
+  RC5,
+  RC6,
+  NEC,  // 3
+  SONY,
+  // Add new entries before this one, and update it to point to the last entry.
+  kLastDecodeType = SONY,
+};
+"""
+DUMP = """
+Some other serial output.
+# Decode trace: 80 ticks/usec, 5 events
+1000 0 -1 0 68
+1800 1 1 1 0
+2600 2 1 1 8960
+3400 1 3 1 0
+9000 5 3 1 32
+"""
+
+
+class TestDecodeTrace(unittest.TestCase):
+  """Unit tests for the methods in decode_trace."""
+
+  def test_protocol_names(self):
+    """The values of the enum are worked out like the compiler does."""
+    self.assertEqual(
+        decode_trace.protocol_names(HEADER),
+        {-1: "UNKNOWN", 0: "UNUSED", 1: "RC5", 2: "RC6", 3: "NEC", 4: "SONY"})
+    self.assertEqual(decode_trace.protocol_names(""), {})
+
+  def test_parse_trace(self):
+    """Tests for the parse_trace() function."""
+    self.assertEqual(
+        decode_trace.parse_trace(DUMP),
+        [(80, [(1000, 0, -1, 0, 68), (1800, 1, 1, 1, 0), (2600, 2, 1, 1, 8960),
+               (3400, 1, 3, 1, 0), (9000, 5, 3, 1, 32)])])
+    self.assertEqual(decode_trace.parse_trace("1 2 3 4 5\n"), [])
+
+  def test_report(self):
+    """Tests for the report() function."""
+    output = StringIO()
+    decode_trace.report(decode_trace.parse_trace(DUMP),
+                        decode_trace.protocol_names(HEADER), output=output)
+    self.assertEqual(
+        output.getvalue(),
+        "       0.0 us  [  0]  Capture of 68 entries\n"
+        "      10.0 us  [  1]  Attempting RC5\n"
+        "      20.0 us  [  1]  RC5 skipped, due to a 8960 usec header mark\n"
+        "      30.0 us  [  1]  Attempting NEC\n"
+        "     100.0 us  [  1]  Decoded as NEC (32 bits)\n"
+        "\n")
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
@@ -6,13 +6,34 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
+#include <deque>
+#include <iostream>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 #include "IRac.h"
+#include "IRrecv.h"
 #include "IRsend.h"
 #include "IRsend_test.h"
 #include "IRutils.h"
+#include "capture_file.h"
 
 const uint16_t kMaxGcCodeLength = 10000;
+const uint16_t kStreamBatchSize = 256;  // Nr. of lines decoded at a time.
+
+/// How to decode the codes.
+typedef struct {
+  decode_type_t input_type;
+  int repeats;
+  bool dumpraw;
+} decode_options_t;
+
+/// A reusable workspace to decode codes with. One per thread.
+typedef struct {
+  std::vector<uint16_t> code;
+  IRsendTest *irsend;
+  IRdecoder *irdecoder;
+} decoder_t;
 
 void str_to_uint16(char *str, uint16_t *res, uint8_t base) {
   char *end;
@@ -30,91 +51,303 @@ void usage_error(char *name) {
             << "Usage: " << name
             << " -prontohex [-rawdump] [-repeats num] <prontohex_code>"
             << std::endl
-            << "Usage: " << name << " -raw [-rawdump] <raw_code>" << std::endl;
+            << "Usage: " << name << " -raw [-rawdump] <raw_code>" << std::endl
+            << "Usage: " << name << " [-gc|-prontohex|-raw] [-rawdump] "
+               "[-repeats num] -stdin [-threads num]" << std::endl
+            << "Usage: " << name << " [-rawdump] -capture <capture_file>"
+            << std::endl
+            << "  -stdin decodes each line of stdin as a code, & outputs a "
+               "JSON line for each." << std::endl
+            << "  -capture does the same for each capture in a capture file."
+            << std::endl;
+}
+
+/// Parse a code into a list of numbers, & send it.
+/// @param[in,out] str The code. It is modified.
+/// @param[in] options How to decode it.
+/// @param[in,out] decoder Where to put it.
+/// @return The nr. of numbers in the code.
+int sendCode(char *str, const decode_options_t &options, decoder_t *decoder) {
+  char *pch;
+  char *saveptr1;
+  char *sep = const_cast<char *>(",");
+  int codebase = 10;
+  if (options.input_type == PRONTO) {
+    sep = const_cast<char *>(" ");
+    codebase = 16;
+  }
+
+  std::vector<uint16_t> &code = decoder->code;
+  code.clear();
+  pch = strtok_r(str, sep, &saveptr1);
+  while (pch != NULL && code.size() < kMaxGcCodeLength) {
+    code.push_back(0);
+    str_to_uint16(pch, &code.back(), codebase);
+    pch = strtok_r(NULL, sep, &saveptr1);
+  }
+  uint16_t none = 0;
+  uint16_t *data = code.empty() ? &none : code.data();
+
+  IRsendTest *irsend = decoder->irsend;
+  const uint16_t raw_freq = 38;
+  irsend->reset();
+  switch (options.input_type) {
+    case GLOBALCACHE:
+      irsend->sendGC(data, code.size());
+      break;
+    case PRONTO:
+      irsend->sendPronto(data, code.size(), options.repeats);
+      break;
+    case RAW:
+      irsend->sendRaw(data, code.size(), raw_freq);
+      break;
+    default:
+      break;
+  }
+  irsend->makeDecodeResult();
+  return code.size();
+}
+
+/// Escape a string for use in JSON.
+std::string jsonEscape(const std::string &str) {
+  std::string result;
+  for (size_t i = 0; i < str.length(); i++) {
+    const char c = str[i];
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if ((uint8_t)c < ' ') {
+      char hex[8];
+      snprintf(hex, sizeof(hex), "\\u%04x", c);
+      result += hex;
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+/// Describe a decoded capture as a line of JSON.
+/// @param[in] capture The decoded capture.
+/// @param[in] number Which line (or capture) of the input it is.
+/// @param[in] length Nr. of numbers in the code.
+/// @param[in] options How it was decoded.
+/// @return The line of JSON.
+std::string resultToJsonLine(const decode_results *capture,
+                             const uint32_t number, const int length,
+                             const decode_options_t &options) {
+  std::string json = "{\"line\":" + uint64ToString(number) +
+      ",\"length\":" + uint64ToString(length) + ",\"type\":\"" +
+      typeToString(capture->decode_type).c_str() + "\",\"bits\":" +
+      uint64ToString(capture->bits);
+  if (hasACState(capture->decode_type)) {
+    json += ",\"state\":\"";
+    for (uint16_t i = 0; i < capture->bits / 8; i++) {
+      char hex[3];
+      snprintf(hex, sizeof(hex), "%02X", capture->state[i]);
+      json += hex;
+    }
+    json += "\"";
+    const String description = IRAcUtils::resultAcToString(capture);
+    if (description.length())
+      json += ",\"description\":\"" + jsonEscape(description.c_str()) + "\"";
+  } else {
+    json += ",\"value\":\"0x" +
+        std::string(uint64ToString(capture->value, 16).c_str()) +
+        "\",\"address\":\"0x" +
+        std::string(uint64ToString(capture->address, 16).c_str()) +
+        "\",\"command\":\"0x" +
+        std::string(uint64ToString(capture->command, 16).c_str()) + "\"";
+  }
+  if (options.dumpraw) {
+    json += ",\"raw\":[";
+    for (uint16_t i = 1; i < capture->rawlen; i++) {
+      if (i > 1) json += ",";
+      json += uint64ToString(capture->rawbuf[i] * kRawTick).c_str();
+    }
+    json += "]";
+  }
+  return json + "}";
+}
+
+/// Decode a line of input as a code.
+/// @param[in] line The line. i.e. The code.
+/// @param[in] number Which line of the input it is.
+/// @param[in] options How to decode it.
+/// @param[in,out] decoder What to decode it with.
+/// @return The result as a line of JSON.
+std::string decodeLine(const std::string &line, const uint32_t number,
+                       const decode_options_t &options, decoder_t *decoder) {
+  std::vector<char> str(line.begin(), line.end());
+  str.push_back('\0');
+  const int length = sendCode(str.data(), options, decoder);
+  decode_results *capture = &decoder->irsend->capture;
+  decoder->irdecoder->decode(capture);
+  return resultToJsonLine(capture, number, length, options);
+}
+
+/// Decode each capture in a capture file, outputting a JSON line for each.
+/// @param[in] path The capture file.
+/// @param[in] options How to output them.
+/// @return true, if the file could be read.
+bool decodeCaptures(const char *path, const decode_options_t &options) {
+  MappedCaptureFile file;
+  if (!file.open(path)) {
+    std::cerr << "Can't read the capture file: " << path << std::endl;
+    return false;
+  }
+  irutils::CaptureReader reader = file.reader();
+  IRdecoder irdecoder;
+  std::vector<uint16_t> rawbuf(UINT16_MAX + 1);
+  irutils::capture_t capture;
+  decode_results results;
+  for (uint32_t number = 1; reader.next(&capture); number++) {
+    const uint16_t rawlen = irutils::CaptureReader::unpack(
+        capture, rawbuf.data(), UINT16_MAX);
+    irdecoder.decode(&results, rawbuf.data(), rawlen);
+    results.overflow = capture.overflow;
+    // The code's length, as if it was raw. i.e. Without the leading gap.
+    std::cout << resultToJsonLine(&results, number, rawlen ? rawlen - 1 : 0,
+                                  options) << "\n";
+  }
+  return true;
+}
+
+/// Decode each line of stdin, in batches, outputting a JSON line for each.
+/// @param[in] options How to decode them.
+/// @param[in] threads Nr. of threads to decode each batch with.
+void decodeStream(const decode_options_t &options, const uint16_t threads) {
+  // Deques, as their elements don't move & can't be copied cheaply.
+  std::deque<IRsendTest> irsends;
+  std::deque<IRdecoder> irdecoders;
+  std::vector<decoder_t> decoders(threads);
+  for (uint16_t t = 0; t < threads; t++) {
+    irsends.emplace_back(0);
+    irsends.back().begin();
+    irdecoders.emplace_back();
+    decoders[t].irsend = &irsends.back();
+    decoders[t].irdecoder = &irdecoders.back();
+  }
+  std::vector<std::string> lines;
+  std::vector<uint32_t> numbers;
+  std::vector<std::string> results(kStreamBatchSize);
+  uint32_t number = 0;
+  std::string line;
+  bool more = true;
+  while (more) {
+    lines.clear();
+    numbers.clear();
+    while (lines.size() < kStreamBatchSize &&
+           (more = static_cast<bool>(std::getline(std::cin, line)))) {
+      number++;
+      if (!line.empty() && line[line.length() - 1] == '\r')
+        line.erase(line.length() - 1);
+      if (line.empty() || line[0] == '#') continue;  // Blank or a comment.
+      lines.push_back(line);
+      numbers.push_back(number);
+    }
+    if (threads > 1) {
+      std::vector<std::thread> workers;
+      for (uint16_t t = 0; t < threads; t++)
+        workers.push_back(std::thread([&, t]() {
+          for (size_t i = t; i < lines.size(); i += threads)
+            results[i] = decodeLine(lines[i], numbers[i], options,
+                                    &decoders[t]);
+        }));
+      for (uint16_t t = 0; t < threads; t++) workers[t].join();
+    } else {
+      for (size_t i = 0; i < lines.size(); i++)
+        results[i] = decodeLine(lines[i], numbers[i], options, &decoders[0]);
+    }
+    for (size_t i = 0; i < lines.size(); i++)
+      std::cout << results[i] << "\n";
+  }
 }
 
 int main(int argc, char *argv[]) {
   int argv_offset = 1;
-  int repeats = 0;
-  bool dumpraw = false;
-  enum decode_type_t input_type = GLOBALCACHE;
-  const uint16_t raw_freq = 38;
+  decode_options_t options;
+  options.input_type = GLOBALCACHE;
+  options.repeats = 0;
+  options.dumpraw = false;
+  bool stream = false;
+  uint16_t threads = 1;
   // Check the invocation/calling usage.
-  if (argc < 2 || argc > 6) {
+  if (argc < 2 || argc > 8) {
     usage_error(argv[0]);
     return 1;
   }
   if (strncmp("-gc", argv[argv_offset], 3) == 0) {
     argv_offset++;
   } else if (strncmp("-prontohex", argv[argv_offset], 10) == 0) {
-    input_type = PRONTO;
+    options.input_type = PRONTO;
     argv_offset++;
-  } else if (strncmp("-raw", argv[argv_offset], 4) == 0) {
-    input_type = RAW;
+  } else if (strncmp("-raw", argv[argv_offset], 4) == 0 &&
+             strncmp("-rawdump", argv[argv_offset], 8) != 0) {
+    options.input_type = RAW;
     argv_offset++;
   }
 
-  if (strncmp("-rawdump", argv[argv_offset], 8) == 0) {
-    dumpraw = true;
+  if (argv_offset < argc && strncmp("-rawdump", argv[argv_offset], 8) == 0) {
+    options.dumpraw = true;
     argv_offset++;
   }
 
-  if (input_type == PRONTO && strncmp("-repeats", argv[argv_offset], 8) == 0) {
+  if (options.input_type == PRONTO && argv_offset < argc &&
+      strncmp("-repeats", argv[argv_offset], 8) == 0) {
     argv_offset++;
     if (argc - argv_offset <= 1) {
       usage_error(argv[0]);
       return 1;
     }
-    repeats = atoi(argv[argv_offset++]);
-    if (repeats < 0) {
+    options.repeats = atoi(argv[argv_offset++]);
+    if (options.repeats < 0) {
       usage_error(argv[0]);
       return 1;
     }
   }
 
-  if (argc - argv_offset != 1) {
-    usage_error(argv[0]);
-    return 1;
+  if (argv_offset < argc && strcmp("-capture", argv[argv_offset]) == 0) {
+    if (argc - argv_offset != 2 || options.input_type != GLOBALCACHE) {
+      usage_error(argv[0]);
+      return 1;
+    }
+    return decodeCaptures(argv[argv_offset + 1], options) ? 0 : 1;
   }
 
-  uint16_t gc_test[kMaxGcCodeLength];
-  int index = 0;
-  char *pch;
-  char *saveptr1;
-  char *sep = const_cast<char *>(",");
-  int codebase = 10;
-  if (input_type == PRONTO) {
-    sep = const_cast<char *>(" ");
-    codebase = 16;
+  if (argv_offset < argc && strncmp("-stdin", argv[argv_offset], 6) == 0) {
+    stream = true;
+    argv_offset++;
+    if (argv_offset < argc &&
+        strncmp("-threads", argv[argv_offset], 8) == 0) {
+      argv_offset++;
+      const int value = argv_offset < argc ? atoi(argv[argv_offset++]) : 0;
+      if (value < 1 || value > 256) {
+        usage_error(argv[0]);
+        return 1;
+      }
+      threads = value;
+    }
   }
 
-  pch = strtok_r(argv[argv_offset], sep, &saveptr1);
-  while (pch != NULL && index < kMaxGcCodeLength) {
-    str_to_uint16(pch, &gc_test[index], codebase);
-    pch = strtok_r(NULL, sep, &saveptr1);
-    index++;
+  if (argc - argv_offset != (stream ? 0 : 1)) {
+    usage_error(argv[0]);
+    return 1;
+  }
+
+  if (stream) {
+    decodeStream(options, threads);
+    return 0;
   }
 
   IRsendTest irsend(0);
-  IRrecv irrecv(0);
+  IRdecoder irdecoder;
   irsend.begin();
-  irsend.reset();
-
-  switch (input_type) {
-    case GLOBALCACHE:
-      irsend.sendGC(gc_test, index);
-      break;
-    case PRONTO:
-      irsend.sendPronto(gc_test, index, repeats);
-      break;
-    case RAW:
-      irsend.sendRaw(gc_test, index, raw_freq);
-      break;
-    default:
-      break;
-  }
-  irsend.makeDecodeResult();
-  irrecv.decode(&irsend.capture);
+  decoder_t decoder;
+  decoder.irsend = &irsend;
+  decoder.irdecoder = &irdecoder;
+  const int index = sendCode(argv[argv_offset], options, &decoder);
+  irdecoder.decode(&irsend.capture);
 
   std::cout << "Code length " << index << std::endl
             << "Code type      " << irsend.capture.decode_type << " ("
@@ -138,7 +371,8 @@ int main(int argc, char *argv[]) {
               << std::endl;
   }
 
-  if (dumpraw || irsend.capture.decode_type == UNKNOWN) irsend.dumpRawResult();
+  if (options.dumpraw || irsend.capture.decode_type == UNKNOWN)
+    irsend.dumpRawResult();
 
   return 0;
 }
@@ -0,0 +1,202 @@
+#!/usr/bin/python3
+"""Generate a header of the order `IRrecv::decode()` tries the protocols in.
+
+The protocols are those of the cases of `IRrecv::_tryProtocol()` in
+src/IRrecv.cpp. With no profiles, they are in the order they are there. i.e.
+The library's default order of src/IRdecodeOrder.h. Regenerate it with:
+  tools/generate_decode_order.py > src/IRdecodeOrder.h
+
+Given the `decodeProfileToString()` output of your devices, those they decode
+most are tried first, while the protocols that need to be tried before others
+(see PRECEDENCE) still are. e.g.
+  tools/generate_decode_order.py dev1.log dev2.log > src/MyDecodeOrder.h
+then build the firmware with: -D_IR_DECODE_ORDER_=MyDecodeOrder.h
+"""
+#
+# Copyright 2026 The IRremoteESP8266 authors
+import argparse
+import os
+import re
+import sys
+
+DEFAULT_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "src", "IRrecv.cpp")
+
+# Pairs of (earlier, later) protocols. The earlier one must be tried first, as
+# its messages could otherwise be decoded as the later one.
+PRECEDENCE = [
+    ("AIWA_RC_T501", "SANYO_LC7461"),  # Aiwa is the more specific of them.
+    ("AIWA_RC_T501", "NEC"),
+    ("SANYO_LC7461", "NEC"),  # Longer messages with NEC-like timings.
+    ("CARRIER_AC", "NEC"),
+    ("PIONEER", "NEC"),
+    ("EPSON", "NEC"),
+    ("NEC", "MIDEA24"),  # Shares the NEC header.
+    ("FUJITSU_AC", "DENON"),  # A short Fujitsu message looks like them.
+    ("FUJITSU_AC", "PANASONIC"),
+    ("DENON", "PANASONIC"),  # Denon is a special case of Panasonic.
+    ("DENON", "SHARP"),  # Denon shares its Sharp match with Sharp.
+    ("PANASONIC", "PANASONIC_AC"),  # Shares the Panasonic header.
+    ("LG", "SAMSUNG"),  # LG32 looks like Samsung.
+    ("GICABLE", "JVC"),  # Like JVC, plus a NEC-like repeat.
+    ("HAIER_AC", "HAIER_AC_YRW02"),  # Shares the Haier header.
+    ("HITACHI_AC424", "HITACHI_AC"),
+    ("MITSUBISHI136", "HITACHI_AC3"),
+]
+# Protocols decoded so loosely they could match any of those before them. They
+# are kept after all of the protocols they are after by default.
+FALLBACKS = ["NEC_LIKE"]
+
+PROFILE_RE = re.compile(r"^\s*(\w+): (\d+) attempted, (\d+) rejected, "
+                        r"(\d+) decoded, (\d+) usecs\s*$")
+
+
+def decoders(source):
+  """The protocols `IRrecv::_tryProtocol()` tries, in order.
+
+  Args:
+    source: The text of IRrecv.cpp.
+  Returns:
+    A list of a (case, [protocols attempted in it]) tuple per case.
+  """
+  body = source.split("bool IRrecv::_tryProtocol(", 1)
+  if len(body) < 2:
+    raise ValueError("Can't find IRrecv::_tryProtocol().")
+  body = body[1].split("\n    default:", 1)[0]
+  body = re.sub(r"/\*.*?\*/|//[^\n]*", "", body, flags=re.S)  # No comments.
+  parts = re.split(r"^    case (\w+):", body, flags=re.M)[1:]
+  result = []
+  for case, chunk in zip(parts[0::2], parts[1::2]):
+    members = []
+    for protocol in re.findall(r"_attempt\((\w+)\)", chunk):
+      if protocol not in members:
+        members.append(protocol)
+    result.append((case, members or [case]))
+  return result
+
+
+def parse_profiles(text, decoded=None):
+  """Add up the nr. of messages each protocol decoded in profile dumps.
+
+  Args:
+    text: The `decodeProfileToString()` output. Other lines are ignored.
+    decoded: A dict of the counts so far, to add to.
+  Returns:
+    A dict of protocol name to nr. of messages decoded.
+  """
+  if decoded is None:
+    decoded = {}
+  for line in text.splitlines():
+    match = PROFILE_RE.match(line)
+    if match:
+      decoded[match.group(1)] = (decoded.get(match.group(1), 0) +
+                                 int(match.group(4)))
+  return decoded
+
+
+def decode_order(cases, decoded=None):
+  """The order to try the protocols in.
+
+  Args:
+    cases: The result of decoders().
+    decoded: The result of parse_profiles().
+  Returns:
+    The list of cases, the most decoded first, that honours the precedence.
+  Raises:
+    ValueError: If the precedence can't be honoured.
+  """
+  decoded = decoded or {}
+  keys = [case for case, _ in cases]
+  group = {protocol: case for case, members in cases for protocol in members}
+  score = {case: sum(decoded.get(protocol, 0) for protocol in members)
+           for case, members in cases}
+  before = {case: set() for case in keys}  # What must be tried before each.
+  for earlier, later in PRECEDENCE:
+    if (earlier in group and later in group and
+        group[earlier] != group[later]):
+      before[group[later]].add(group[earlier])
+  for fallback in FALLBACKS:
+    if fallback in group:
+      before[group[fallback]].update(keys[:keys.index(group[fallback])])
+  # A protocol is as urgent as the most decoded one it has to be tried before.
+  urgency = dict(score)
+  changed = True
+  while changed:
+    changed = False
+    for case in keys:
+      for earlier in before[case]:
+        if urgency[earlier] < urgency[case]:
+          urgency[earlier] = urgency[case]
+          changed = True
+  order = []
+  remaining = list(keys)
+  while remaining:
+    ready = [case for case in remaining if before[case].issubset(order)]
+    if not ready:
+      raise ValueError("The precedence of %s is circular." %
+                       ", ".join(remaining))
+    best = max(ready, key=lambda case: (urgency[case], score[case],
+                                        -keys.index(case)))
+    order.append(best)
+    remaining.remove(best)
+  return order
+
+
+def generate(order, decoded=None, output=sys.stdout):
+  """Write the header of a decode order.
+
+  Args:
+    order: The result of decode_order().
+    decoded: The result of parse_profiles(), if it was made from profiles.
+    output: Where to write it.
+  """
+  output.write(
+      "// Copyright 2026 The IRremoteESP8266 authors\n"
+      "// The order `IRrecv::decode()` tries the protocols in. "
+      "See `_IR_DECODE_ORDER_`.\n"
+      "//\n"
+      "// WARNING: Do not edit this file! This file is automatically "
+      "generated by\n"
+      "//          'tools/generate_decode_order.py'.\n")
+  if decoded:
+    output.write("//\n// Made from the profiles of %d decoded messages.\n" %
+                 sum(decoded.values()))
+  output.write(
+      "\n#ifndef IRDECODEORDER_H_\n"
+      "#define IRDECODEORDER_H_\n"
+      "\n"
+      "#include <stdint.h>\n"
+      "#include \"IRremoteESP8266.h\"\n"
+      "\n"
+      "// A case of `IRrecv::_tryProtocol()` per entry. Bytes, to save memory.\n"
+      "const uint8_t kDecodeOrder[] = {\n")
+  for case in order:
+    output.write("  %s,\n" % case)
+  output.write(
+      "};\n"
+      "const uint16_t kDecodeOrderLength = sizeof(kDecodeOrder) /\n"
+      "                                    sizeof(kDecodeOrder[0]);\n"
+      "\n"
+      "#endif  // IRDECODEORDER_H_\n")
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument(
+      "profiles", nargs="*", type=argparse.FileType("r"),
+      help="Files of `decodeProfileToString()` output. '-' for stdin.")
+  arg_parser.add_argument("--source", default=DEFAULT_SOURCE,
+                          help="IRrecv.cpp. (Default: %(default)s)")
+  args = arg_parser.parse_args()
+  with open(args.source) as source:
+    cases = decoders(source.read())
+  decoded = {}
+  for profile in args.profiles:
+    parse_profiles(profile.read(), decoded)
+  generate(decode_order(cases, decoded), decoded)
+
+
+if __name__ == "__main__":
+  main()
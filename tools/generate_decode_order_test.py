@@ -0,0 +1,134 @@
+#!/usr/bin/python3
+"""Unit tests for generate_decode_order.py"""
+from io import StringIO
+import unittest
+import generate_decode_order
+
+SOURCE = """
+bool IRrecv::_tryProtocol(const decode_type_t protocol,
+                          decode_results *results, const uint16_t offset) {
+  switch (protocol) {
+#if DECODE_SANYO
+    case SANYO_LC7461:
+      if (_attempt(SANYO_LC7461) && decodeSanyoLC7461(results, offset))
+        return true;
+      break;
+#endif
+#if DECODE_NEC
+    case NEC:
+      if (_attempt(NEC) && decodeNEC(results, offset)) return true;
+      break;
+#endif
+#if DECODE_SONY
+    case SONY:
+      if (_attempt(SONY) && decodeSony(results, offset)) return true;
+      break;
+#endif
+  /* NOTE: Disabled.
+    if (_attempt(SANYO) && decodeSanyo(results, offset)) return true;
+  */
+#if DECODE_SAMSUNG
+    case SAMSUNG:
+      switch (_countBits(results, offset + kHeader)) {
+        case kSamsungBits:
+          if (_attempt(SAMSUNG) && decodeSAMSUNG(results, offset)) return true;
+          break;
+        case 16:
+          if (_attempt(SAMSUNG36) && decodeSamsung36(results, offset))
+            return true;
+          break;
+      }
+      break;
+#endif
+#if DECODE_NEC
+    case NEC_LIKE:
+      if (_attempt(NEC_LIKE) && decodeNEC(results, offset, kNECBits, false))
+        return true;
+      break;
+#endif
+#if DECODE_RC5
+    case RC5:
+      if (_attempt(RC5) && decodeRC5(results, offset)) return true;
+      break;
+#endif
+    // Typically new protocols are added above this line.
+    default:
+      break;
+  }
+  return false;
+}
+"""
+CASES = [("SANYO_LC7461", ["SANYO_LC7461"]), ("NEC", ["NEC"]),
+         ("SONY", ["SONY"]), ("SAMSUNG", ["SAMSUNG", "SAMSUNG36"]),
+         ("NEC_LIKE", ["NEC_LIKE"]), ("RC5", ["RC5"])]
+
+
+class TestGenerateDecodeOrder(unittest.TestCase):
+  """Unit tests for the methods in generate_decode_order."""
+
+  def test_decoders(self):
+    """Tests for the decoders() function."""
+    self.assertEqual(generate_decode_order.decoders(SOURCE), CASES)
+    with self.assertRaises(ValueError):
+      generate_decode_order.decoders("")
+
+  def test_parse_profiles(self):
+    """The decodes of each protocol are added up across the profiles."""
+    decoded = generate_decode_order.parse_profiles(
+        "Some other serial output.\n"
+        "NEC: 40 attempted, 2 rejected, 30 decoded, 1000 usecs\n"
+        "SAMSUNG36: 9 attempted, 0 rejected, 5 decoded, 300 usecs\n")
+    decoded = generate_decode_order.parse_profiles(
+        "NEC: 10 attempted, 1 rejected, 3 decoded, 90 usecs\n", decoded)
+    self.assertEqual(decoded, {"NEC": 33, "SAMSUNG36": 5})
+
+  def test_decode_order(self):
+    """The most decoded protocols go first, but keep their precedence."""
+    # With nothing profiled, it is the order of the cases.
+    self.assertEqual(generate_decode_order.decode_order(CASES),
+                     [case for case, _ in CASES])
+    # Sanyo stays before NEC, & NEC_LIKE stays after all of those before it.
+    self.assertEqual(
+        generate_decode_order.decode_order(
+            CASES, {"RC5": 50, "SAMSUNG36": 40, "NEC": 30, "SONY": 2}),
+        ["RC5", "SAMSUNG", "SANYO_LC7461", "NEC", "SONY", "NEC_LIKE"])
+    self.assertEqual(
+        generate_decode_order.decode_order(CASES, {"NEC_LIKE": 9, "RC5": 1}),
+        ["SANYO_LC7461", "NEC", "SONY", "SAMSUNG", "NEC_LIKE", "RC5"])
+
+  def test_generate(self):
+    """Tests for the generate() function."""
+    output = StringIO()
+    generate_decode_order.generate(["RC5", "NEC"], {"RC5": 3}, output=output)
+    self.assertEqual(
+        output.getvalue(),
+        "// Copyright 2026 The IRremoteESP8266 authors\n"
+        "// The order `IRrecv::decode()` tries the protocols in. "
+        "See `_IR_DECODE_ORDER_`.\n"
+        "//\n"
+        "// WARNING: Do not edit this file! This file is automatically "
+        "generated by\n"
+        "//          'tools/generate_decode_order.py'.\n"
+        "//\n"
+        "// Made from the profiles of 3 decoded messages.\n"
+        "\n"
+        "#ifndef IRDECODEORDER_H_\n"
+        "#define IRDECODEORDER_H_\n"
+        "\n"
+        "#include <stdint.h>\n"
+        "#include \"IRremoteESP8266.h\"\n"
+        "\n"
+        "// A case of `IRrecv::_tryProtocol()` per entry. Bytes, to save "
+        "memory.\n"
+        "const uint8_t kDecodeOrder[] = {\n"
+        "  RC5,\n"
+        "  NEC,\n"
+        "};\n"
+        "const uint16_t kDecodeOrderLength = sizeof(kDecodeOrder) /\n"
+        "                                    sizeof(kDecodeOrder[0]);\n"
+        "\n"
+        "#endif  // IRDECODEORDER_H_\n")
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
@@ -10,7 +10,7 @@ fi
 # Header
 cat >${OUTPUT} << EOF
 // Copyright 2019 - David Conran (@crankyoldgit)
-// This header file is to be included in files **other than** 'IRtext.cpp'.
+// This header file is to be included in any file that uses the shared text.
 //
 // WARNING: Do not edit this file! This file is automatically generated by
 //          'tools/generate_irtext_h.sh'.
@@ -0,0 +1,307 @@
+#!/usr/bin/python3
+"""Generate the table of how `IRsend::send()` sends each protocol.
+
+It has an entry per protocol of `decode_type_t` (in src/IRremoteESP8266.h), in
+order, so `send()`, `defaultBits()` & `minRepeats()` only need to index it.
+Regenerate it whenever a protocol is added or SENDERS, BITS or MIN_REPEATS
+are changed, with:
+  tools/generate_send_table.py > src/IRsendTable.h
+"""
+#
+# Copyright 2026 The IRremoteESP8266 authors
+import argparse
+import os
+import re
+import sys
+
+SRC_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
+                       "src")
+
+# Per protocol: (The SEND_* flag it needs, its `send*()` of a simple (<= 64 bit)
+# message, its `send*()` of a state[] message). Either can be None.
+SENDERS = {
+    "RC5": ("SEND_RC5", "sendRC5", None),
+    "RC6": ("SEND_RC6", "sendRC6", None),
+    "NEC": ("SEND_NEC", "sendNEC", None),
+    "SONY": ("SEND_SONY", "sendSony", None),
+    "PANASONIC": ("SEND_PANASONIC", "sendPanasonic64", None),
+    "JVC": ("SEND_JVC", "sendJVC", None),
+    "SAMSUNG": ("SEND_SAMSUNG", "sendSAMSUNG", None),
+    "WHYNTER": ("SEND_WHYNTER", "sendWhynter", None),
+    "AIWA_RC_T501": ("SEND_AIWA_RC_T501", "sendAiwaRCT501", None),
+    "LG": ("SEND_LG", "sendLG", None),
+    "MITSUBISHI": ("SEND_MITSUBISHI", "sendMitsubishi", None),
+    "DISH": ("SEND_DISH", "sendDISH", None),
+    "SHARP": ("SEND_SHARP", "sendSharpRaw", None),
+    "COOLIX": ("SEND_COOLIX", "sendCOOLIX", None),
+    "DAIKIN": ("SEND_DAIKIN", None, "sendDaikin"),
+    "DENON": ("SEND_DENON", "sendDenon", None),
+    "KELVINATOR": ("SEND_KELVINATOR", None, "sendKelvinator"),
+    "SHERWOOD": ("SEND_SHERWOOD", "sendSherwood", None),
+    "MITSUBISHI_AC": ("SEND_MITSUBISHI_AC", None, "sendMitsubishiAC"),
+    "RCMM": ("SEND_RCMM", "sendRCMM", None),
+    "SANYO_LC7461": ("SEND_SANYO", "sendSanyoLC7461", None),
+    "RC5X": ("SEND_RC5", "sendRC5", None),
+    "GREE": ("SEND_GREE", "sendGree", "sendGree"),
+    "NEC_LIKE": ("SEND_NEC", "sendNEC", None),
+    "ARGO": ("SEND_ARGO", None, "sendArgo"),
+    "TROTEC": ("SEND_TROTEC", None, "sendTrotec"),
+    "NIKAI": ("SEND_NIKAI", "sendNikai", None),
+    "TOSHIBA_AC": ("SEND_TOSHIBA_AC", None, "sendToshibaAC"),
+    "FUJITSU_AC": ("SEND_FUJITSU_AC", None, "sendFujitsuAC"),
+    "MIDEA": ("SEND_MIDEA", "sendMidea", None),
+    "MAGIQUEST": ("SEND_MAGIQUEST", "sendMagiQuest", None),
+    "LASERTAG": ("SEND_LASERTAG", "sendLasertag", None),
+    "CARRIER_AC": ("SEND_CARRIER_AC", "sendCarrierAC", None),
+    "HAIER_AC": ("SEND_HAIER_AC", None, "sendHaierAC"),
+    "MITSUBISHI2": ("SEND_MITSUBISHI2", "sendMitsubishi2", None),
+    "HITACHI_AC": ("SEND_HITACHI_AC", None, "sendHitachiAC"),
+    "HITACHI_AC1": ("SEND_HITACHI_AC1", None, "sendHitachiAC1"),
+    "HITACHI_AC2": ("SEND_HITACHI_AC2", None, "sendHitachiAC2"),
+    "GICABLE": ("SEND_GICABLE", "sendGICable", None),
+    "HAIER_AC_YRW02": ("SEND_HAIER_AC_YRW02", None, "sendHaierACYRW02"),
+    "WHIRLPOOL_AC": ("SEND_WHIRLPOOL_AC", None, "sendWhirlpoolAC"),
+    "SAMSUNG_AC": ("SEND_SAMSUNG_AC", None, "sendSamsungAC"),
+    "LUTRON": ("SEND_LUTRON", "sendLutron", None),
+    "ELECTRA_AC": ("SEND_ELECTRA_AC", None, "sendElectraAC"),
+    "PANASONIC_AC": ("SEND_PANASONIC_AC", None, "sendPanasonicAC"),
+    "PIONEER": ("SEND_PIONEER", "sendPioneer", None),
+    "LG2": ("SEND_LG", "sendLG2", None),
+    "MWM": ("SEND_MWM", None, "sendMWM"),
+    "DAIKIN2": ("SEND_DAIKIN2", None, "sendDaikin2"),
+    "VESTEL_AC": ("SEND_VESTEL_AC", "sendVestelAc", None),
+    "TECO": ("SEND_TECO", "sendTeco", None),
+    "SAMSUNG36": ("SEND_SAMSUNG36", "sendSamsung36", None),
+    "TCL112AC": ("SEND_TCL112AC", None, "sendTcl112Ac"),
+    "LEGOPF": ("SEND_LEGOPF", "sendLegoPf", None),
+    "MITSUBISHI_HEAVY_88": ("SEND_MITSUBISHIHEAVY", None,
+                            "sendMitsubishiHeavy88"),
+    "MITSUBISHI_HEAVY_152": ("SEND_MITSUBISHIHEAVY", None,
+                             "sendMitsubishiHeavy152"),
+    "DAIKIN216": ("SEND_DAIKIN216", None, "sendDaikin216"),
+    "SHARP_AC": ("SEND_SHARP_AC", None, "sendSharpAc"),
+    "GOODWEATHER": ("SEND_GOODWEATHER", "sendGoodweather", None),
+    "INAX": ("SEND_INAX", "sendInax", None),
+    "DAIKIN160": ("SEND_DAIKIN160", None, "sendDaikin160"),
+    "NEOCLIMA": ("SEND_NEOCLIMA", None, "sendNeoclima"),
+    "DAIKIN176": ("SEND_DAIKIN176", None, "sendDaikin176"),
+    "DAIKIN128": ("SEND_DAIKIN128", None, "sendDaikin128"),
+    "AMCOR": ("SEND_AMCOR", None, "sendAmcor"),
+    "DAIKIN152": ("SEND_DAIKIN152", None, "sendDaikin152"),
+    "MITSUBISHI136": ("SEND_MITSUBISHI136", None, "sendMitsubishi136"),
+    "MITSUBISHI112": ("SEND_MITSUBISHI112", None, "sendMitsubishi112"),
+    "HITACHI_AC424": ("SEND_HITACHI_AC424", None, "sendHitachiAc424"),
+    "SONY_38K": ("SEND_SONY", "sendSony38", None),
+    "EPSON": ("SEND_EPSON", "sendEpson", None),
+    "SYMPHONY": ("SEND_SYMPHONY", "sendSymphony", None),
+    "HITACHI_AC3": ("SEND_HITACHI_AC3", None, "sendHitachiAc3"),
+    "DAIKIN64": ("SEND_DAIKIN64", "sendDaikin64", None),
+    "AIRWELL": ("SEND_AIRWELL", "sendAirwell", None),
+    "DELONGHI_AC": ("SEND_DELONGHI_AC", "sendDelonghiAc", None),
+    "DOSHISHA": ("SEND_DOSHISHA", "sendDoshisha", None),
+    "MULTIBRACKETS": ("SEND_MULTIBRACKETS", "sendMultibrackets", None),
+    "CARRIER_AC40": ("SEND_CARRIER_AC40", "sendCarrierAC40", None),
+    "CARRIER_AC64": ("SEND_CARRIER_AC64", "sendCarrierAC64", None),
+    "HITACHI_AC344": ("SEND_HITACHI_AC344", None, "sendHitachiAc344"),
+    "CORONA_AC": ("SEND_CORONA_AC", None, "sendCoronaAc"),
+    "MIDEA24": ("SEND_MIDEA24", "sendMidea24", None),
+    "ZEPEAL": ("SEND_ZEPEAL", "sendZepeal", None),
+    "SANYO_AC": ("SEND_SANYO_AC", None, "sendSanyoAc"),
+    "VOLTAS": ("SEND_VOLTAS", None, "sendVoltas"),
+    "METZ": ("SEND_METZ", "sendMetz", None),
+    "TRANSCOLD": ("SEND_TRANSCOLD", "sendTranscold", None),
+    "TECHNIBEL_AC": ("SEND_TECHNIBEL_AC", "sendTechnibelAc", None),
+}
+# The default nr. of bits of a message of each protocol. Otherwise 0.
+BITS = {
+    "RC5": 12, "RC6": 20, "NEC": 32, "SONY": 20, "PANASONIC": 48, "JVC": 16,
+    "SAMSUNG": 32, "WHYNTER": 32, "AIWA_RC_T501": 15, "LG": 28,
+    "MITSUBISHI": 16, "DISH": 16, "SHARP": 15, "COOLIX": 24,
+    "DAIKIN": "kDaikinBits", "DENON": 15, "KELVINATOR": "kKelvinatorBits",
+    "SHERWOOD": 32, "MITSUBISHI_AC": "kMitsubishiACBits", "RCMM": 24,
+    "SANYO_LC7461": "kSanyoLC7461Bits", "RC5X": 13, "GREE": "kGreeBits",
+    "NEC_LIKE": 32, "ARGO": "kArgoBits", "TROTEC": "kTrotecBits", "NIKAI": 24,
+    "TOSHIBA_AC": "kToshibaACBits", "MIDEA": 48, "MAGIQUEST": 56,
+    "LASERTAG": 13, "CARRIER_AC": 32, "HAIER_AC": "kHaierACBits",
+    "MITSUBISHI2": 16, "HITACHI_AC": "kHitachiAcBits",
+    "HITACHI_AC1": "kHitachiAc1Bits", "HITACHI_AC2": "kHitachiAc2Bits",
+    "GICABLE": 16, "HAIER_AC_YRW02": "kHaierACYRW02Bits",
+    "WHIRLPOOL_AC": "kWhirlpoolAcBits", "SAMSUNG_AC": "kSamsungAcBits",
+    "LUTRON": 35, "ELECTRA_AC": "kElectraAcBits",
+    "PANASONIC_AC": "kPanasonicAcBits", "PIONEER": 64, "LG2": 28,
+    "DAIKIN2": "kDaikin2Bits", "VESTEL_AC": 56, "TECO": 35, "SAMSUNG36": 36,
+    "TCL112AC": "kTcl112AcBits", "LEGOPF": 16,
+    "MITSUBISHI_HEAVY_88": "kMitsubishiHeavy88Bits",
+    "MITSUBISHI_HEAVY_152": "kMitsubishiHeavy152Bits",
+    "DAIKIN216": "kDaikin216Bits", "SHARP_AC": "kSharpAcBits",
+    "GOODWEATHER": 48, "INAX": 24, "DAIKIN160": "kDaikin160Bits",
+    "NEOCLIMA": "kNeoclimaBits", "DAIKIN176": "kDaikin176Bits",
+    "DAIKIN128": "kDaikin128Bits", "AMCOR": 64, "DAIKIN152": "kDaikin152Bits",
+    "MITSUBISHI136": "kMitsubishi136Bits",
+    "MITSUBISHI112": "kMitsubishi112Bits",
+    "HITACHI_AC424": "kHitachiAc424Bits", "SONY_38K": 20, "EPSON": 32,
+    "SYMPHONY": 12, "HITACHI_AC3": "kHitachiAc3Bits",
+    "DAIKIN64": "kDaikin64Bits", "AIRWELL": 34, "DELONGHI_AC": 64,
+    "DOSHISHA": "kDoshishaBits", "MULTIBRACKETS": 8,
+    "CARRIER_AC40": "kCarrierAc40Bits", "CARRIER_AC64": 64,
+    "HITACHI_AC344": "kHitachiAc344Bits", "CORONA_AC": "kCoronaAcBits",
+    "MIDEA24": 24, "ZEPEAL": 16, "SANYO_AC": "kSanyoAcBits",
+    "VOLTAS": "kVoltasBits", "METZ": 19, "TRANSCOLD": 48, "TECHNIBEL_AC": 56
+}
+# The min. nr. of repeats of a simple message of each protocol. Otherwise
+# kNoRepeat.
+MIN_REPEATS = {
+    "SONY": "kSonyMinRepeat", "AIWA_RC_T501": "kSingleRepeat",
+    "MITSUBISHI": "kSingleRepeat", "DISH": "kDishMinRepeat",
+    "COOLIX": "kSingleRepeat", "SHERWOOD": "kSingleRepeat",
+    "MITSUBISHI_AC": "kSingleRepeat", "TOSHIBA_AC": "kSingleRepeat",
+    "MITSUBISHI2": "kSingleRepeat", "GICABLE": "kSingleRepeat",
+    "INAX": "kSingleRepeat", "AMCOR": "kSingleRepeat",
+    "SONY_38K": "kSonyMinRepeat + 1", "EPSON": "kEpsonMinRepeat",
+    "SYMPHONY": "kSymphonyDefaultRepeat", "AIRWELL": "kAirwellMinRepeats",
+    "MULTIBRACKETS": "kSingleRepeat", "CARRIER_AC40": "kCarrierAc40MinRepeat",
+    "MIDEA24": "kSingleRepeat", "ZEPEAL": "kZepealMinRepeat"
+}
+
+
+def protocols(header):
+  """The protocols of `decode_type_t`, in order.
+
+  Args:
+    header: The text of IRremoteESP8266.h.
+  Returns:
+    A list of their names. From UNKNOWN (-1) to the last one.
+  Raises:
+    ValueError: If `decode_type_t` can't be found.
+  """
+  match = re.search(r"enum decode_type_t \{(.*?)kLastDecodeType =", header,
+                    re.S)
+  if not match:
+    raise ValueError("Can't find decode_type_t.")
+  body = re.sub(r"//[^\n]*", "", match.group(1))  # No comments.
+  return re.findall(r"\b([A-Z][A-Z0-9_]*)\b", body)
+
+
+def state_repeats(header):
+  """The default nr. of repeats of each `send*()` of a state[] message.
+
+  Args:
+    header: The text of IRsend.h.
+  Returns:
+    A dict of the `send*()` name to its default `repeat` argument.
+  """
+  result = {}
+  for name, args in re.findall(
+      r"void (send\w+)\(\s*const (?:unsigned char|uint8_t) "
+      r"(?:\w+\[\]|\*\s*\w+),([^;]*?)\);", header):
+    match = re.search(r"repeat\s*=\s*([^,)]+)", args)
+    if match:
+      result[name] = " ".join(match.group(1).split())
+  return result
+
+
+def entries(names, repeats):
+  """The entries of the table.
+
+  Args:
+    names: The result of protocols().
+    repeats: The result of state_repeats().
+  Returns:
+    A list of a (protocol, SEND_* flag or None, fields) tuple per protocol.
+  Raises:
+    ValueError: If SENDERS has an unknown protocol, or a `send*()` of a state[]
+      with no default repeat.
+  """
+  unknown = set(SENDERS).union(BITS, MIN_REPEATS).difference(names)
+  if unknown:
+    raise ValueError("Unknown protocols: %s" % ", ".join(sorted(unknown)))
+  result = []
+  for protocol in names:
+    flag, simple, state = SENDERS.get(protocol, (None, None, None))
+    if state is not None and state not in repeats:
+      raise ValueError("%s() has no default repeat." % state)
+    fields = [str(BITS.get(protocol, 0)),
+              str(MIN_REPEATS.get(protocol, "kNoRepeat")),
+              repeats[state] if state else "kNoRepeat"]
+    result.append((protocol, flag, ["&IRsend::" + simple if simple else "NULL",
+                                    "&IRsend::" + state if state else "NULL"] +
+                   fields))
+  return result
+
+
+def entry_lines(protocol, fields):
+  """Format an entry of the table, wrapped to fit the line length.
+
+  Args:
+    protocol: The protocol of it, for a comment.
+    fields: Its fields.
+  Returns:
+    A list of lines.
+  """
+  lines = ["  {"]
+  for i, field in enumerate(fields):
+    text = field + ("," if i < len(fields) - 1 else "},  // " + protocol)
+    if len(lines[-1]) + len(text) + 1 > 80 and lines[-1] != "  {":
+      lines.append("   " + text)
+    else:
+      lines[-1] += ("" if lines[-1] == "  {" else " ") + text
+  return lines
+
+
+def generate(table, output=sys.stdout):
+  """Write the header of the table.
+
+  Args:
+    table: The result of entries().
+    output: Where to write it.
+  """
+  output.write(
+      "// Copyright 2026 The IRremoteESP8266 authors\n"
+      "// How `IRsend::send()` sends each protocol. See `irsend_protocol_t`.\n"
+      "//\n"
+      "// WARNING: Do not edit this file! This file is automatically "
+      "generated by\n"
+      "//          'tools/generate_send_table.py'.\n"
+      "\n"
+      "#ifndef IRSENDTABLE_H_\n"
+      "#define IRSENDTABLE_H_\n"
+      "\n"
+      "#include \"IRsend.h\"\n"
+      "\n"
+      "// An entry per `decode_type_t`, in order, starting from UNKNOWN.\n"
+      "const irsend_protocol_t kSendTable[] PROGMEM = {\n")
+  for protocol, flag, fields in table:
+    if flag is None:
+      output.write("\n".join(entry_lines(protocol, fields)) + "\n")
+      continue
+    output.write("#if %s\n" % flag)
+    output.write("\n".join(entry_lines(protocol, fields)) + "\n")
+    output.write("#else  // %s\n" % flag)
+    output.write("\n".join(entry_lines(protocol, ["NULL", "NULL"] +
+                                       fields[2:])) + "\n")
+    output.write("#endif  // %s\n" % flag)
+  output.write(
+      "};\n"
+      "const uint16_t kSendTableLength = sizeof(kSendTable) / "
+      "sizeof(kSendTable[0]);\n"
+      "\n"
+      "#endif  // IRSENDTABLE_H_\n")
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument("--src", default=SRC_DIR,
+                          help="The library's src/ directory. "
+                          "(Default: %(default)s)")
+  args = arg_parser.parse_args()
+  with open(os.path.join(args.src, "IRremoteESP8266.h")) as header:
+    names = protocols(header.read())
+  with open(os.path.join(args.src, "IRsend.h")) as header:
+    repeats = state_repeats(header.read())
+  generate(entries(names, repeats))
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,128 @@
+#!/usr/bin/python3
+"""Unit tests for generate_send_table.py"""
+from io import StringIO
+import os
+import unittest
+import generate_send_table
+
+ENUM = """
+enum decode_type_t {
+  UNKNOWN = -1,
+  UNUSED = 0,
+  RC5,
+  RC6,  // A comment. NOT_A_PROTOCOL
+  NEC,
+  // Add new entries before this one, and update it to point to the last entry.
+  kLastDecodeType = NEC,
+};
+"""
+DECLARATIONS = """
+  void sendNEC(uint64_t data, uint16_t nbits = kNECBits,
+               uint16_t repeat = kNoRepeat);
+  void sendDaikin(const unsigned char data[],
+                  const uint16_t nbytes = kDaikinStateLength,
+                  const uint16_t repeat = kDaikinDefaultRepeat);
+  void sendKelvinator(
+      const unsigned char data[], const uint16_t nbytes = kKelvinatorStateLength,
+      const uint16_t repeat = kKelvinatorDefaultRepeat);
+  void sendTeco(const uint8_t *data, const uint16_t nbytes = kTecoStateLength,
+                const uint16_t repeat = kNoRepeat);
+  void sendNoRepeat(const uint8_t data[], const uint16_t nbytes);
+"""
+
+
+class TestGenerateSendTable(unittest.TestCase):
+  """Unit tests for the methods in generate_send_table."""
+
+  def test_protocols(self):
+    """Tests for the protocols() function."""
+    self.assertEqual(generate_send_table.protocols(ENUM),
+                     ["UNKNOWN", "UNUSED", "RC5", "RC6", "NEC"])
+    with self.assertRaises(ValueError):
+      generate_send_table.protocols("")
+
+  def test_state_repeats(self):
+    """Only the `send*()` of a state[] with a default repeat are found."""
+    self.assertEqual(generate_send_table.state_repeats(DECLARATIONS),
+                     {"sendDaikin": "kDaikinDefaultRepeat",
+                      "sendKelvinator": "kKelvinatorDefaultRepeat",
+                      "sendTeco": "kNoRepeat"})
+
+  def test_entries(self):
+    """Tests for the entries() function."""
+    src = generate_send_table.SRC_DIR
+    with open(os.path.join(src, "IRremoteESP8266.h")) as header:
+      names = generate_send_table.protocols(header.read())
+    with open(os.path.join(src, "IRsend.h")) as header:
+      repeats = generate_send_table.state_repeats(header.read())
+    table = generate_send_table.entries(names, repeats)
+    self.assertEqual([protocol for protocol, _, _ in table], names)
+    self.assertEqual(table[0], ("UNKNOWN", None, ["NULL", "NULL", "0",
+                                                  "kNoRepeat", "kNoRepeat"]))
+    entry = dict((protocol, (flag, fields)) for protocol, flag, fields in table)
+    self.assertEqual(entry["NEC"], ("SEND_NEC", [
+        "&IRsend::sendNEC", "NULL", "32", "kNoRepeat", "kNoRepeat"]))
+    self.assertEqual(entry["DAIKIN"][1][1], "&IRsend::sendDaikin")
+    self.assertEqual(entry["DAIKIN"][1][4], "kDaikinDefaultRepeat")
+    # A protocol it doesn't know of.
+    with self.assertRaises(ValueError):
+      generate_send_table.entries(names[:-1], repeats)
+    # A `send*()` of a state[] with no default repeat.
+    with self.assertRaises(ValueError):
+      generate_send_table.entries(names, {})
+
+  def test_entry_lines(self):
+    """Entries are wrapped to fit the line length."""
+    self.assertEqual(
+        generate_send_table.entry_lines("NEC", ["&IRsend::sendNEC", "NULL",
+                                                "kNECBits", "kNoRepeat",
+                                                "kNoRepeat"]),
+        ["  {&IRsend::sendNEC, NULL, kNECBits, kNoRepeat, kNoRepeat},  // NEC"])
+    self.assertEqual(
+        generate_send_table.entry_lines(
+            "MITSUBISHI_HEAVY_152", ["NULL", "&IRsend::sendMitsubishiHeavy152",
+                                     "kMitsubishiHeavy152Bits", "kNoRepeat",
+                                     "kMitsubishiHeavy152MinRepeat"]),
+        ["  {NULL, &IRsend::sendMitsubishiHeavy152, kMitsubishiHeavy152Bits, "
+         "kNoRepeat,",
+         "   kMitsubishiHeavy152MinRepeat},  // MITSUBISHI_HEAVY_152"])
+
+  def test_generate(self):
+    """Tests for the generate() function."""
+    output = StringIO()
+    generate_send_table.generate(
+        [("UNKNOWN", None, ["NULL", "NULL", "0", "kNoRepeat", "kNoRepeat"]),
+         ("NEC", "SEND_NEC", ["&IRsend::sendNEC", "NULL", "kNECBits",
+                              "kNoRepeat", "kNoRepeat"])], output=output)
+    self.assertEqual(
+        output.getvalue(),
+        "// Copyright 2026 The IRremoteESP8266 authors\n"
+        "// How `IRsend::send()` sends each protocol. "
+        "See `irsend_protocol_t`.\n"
+        "//\n"
+        "// WARNING: Do not edit this file! This file is automatically "
+        "generated by\n"
+        "//          'tools/generate_send_table.py'.\n"
+        "\n"
+        "#ifndef IRSENDTABLE_H_\n"
+        "#define IRSENDTABLE_H_\n"
+        "\n"
+        "#include \"IRsend.h\"\n"
+        "\n"
+        "// An entry per `decode_type_t`, in order, starting from UNKNOWN.\n"
+        "const irsend_protocol_t kSendTable[] PROGMEM = {\n"
+        "  {NULL, NULL, 0, kNoRepeat, kNoRepeat},  // UNKNOWN\n"
+        "#if SEND_NEC\n"
+        "  {&IRsend::sendNEC, NULL, kNECBits, kNoRepeat, kNoRepeat},  // NEC\n"
+        "#else  // SEND_NEC\n"
+        "  {NULL, NULL, kNECBits, kNoRepeat, kNoRepeat},  // NEC\n"
+        "#endif  // SEND_NEC\n"
+        "};\n"
+        "const uint16_t kSendTableLength = sizeof(kSendTable) / "
+        "sizeof(kSendTable[0]);\n"
+        "\n"
+        "#endif  // IRSENDTABLE_H_\n")
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
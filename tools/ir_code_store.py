@@ -0,0 +1,222 @@
+#!/usr/bin/python3
+"""Make an `IRcodeStore` image from a JSON file of named IR codes.
+
+The image can be compiled into the firmware (as a PROGMEM array), or written
+to a flash partition or file, & codes are then sent straight out of it. i.e.
+The JSON never has to be parsed on the device.
+The JSON is an object of names to codes. Each code is one of:
+  {"protocol": "NEC", "value": "0x20DF10EF", "bits": 32, "repeat": 0}
+      A simple message. "bits" (default: the protocol's) & "repeat" are
+      optional.
+  {"protocol": "DAIKIN", "state": "0x11DA2700..."}
+      A state[] message.
+  {"raw": [9000, 4500, 560, ...], "frequency": 38000, "duty": 50}
+      Raw marks & spaces (uSeconds), starting with a mark. "frequency" &
+      "duty" are optional.
+  {"pronto": "0000 006D 0022 0000 ..."}
+      A Pronto code. Stored as raw, as `IRsend::sendPronto()` would send it.
+  {"ac": "<IRac::stateToBase64() of an A/C state>"}
+      An A/C state, for `IRac::sendAc()`.
+e.g.
+  tools/ir_code_store.py codes.json -o codes.bin
+  tools/ir_code_store.py codes.json --array kCodes > codes.h
+"""
+#
+# Copyright 2026 The IRremoteESP8266 authors
+import argparse
+import base64
+import json
+import os
+import struct
+import sys
+import generate_send_table
+
+SRC_DIR = generate_send_table.SRC_DIR
+# See IRcodeStore.h
+MAGIC = b"IRCS"
+VERSION = 1
+HEADER_SIZE = 16
+MAX_NAME = 255
+KIND_VALUE = 1
+KIND_STATE = 2
+KIND_RAW = 3
+KIND_AC = 4
+AC_STATE_LENGTH = 9  # kIRacStateBinaryLength
+# See ir_Pronto.cpp
+PRONTO_FREQ_FACTOR = 0.241246
+DEFAULT_FREQUENCY = 38000
+DEFAULT_DUTY = 50
+
+
+def name_hash(name):
+  """The hash a name is indexed by. i.e. `IRcodeStore::hash()`. (FNV-1a)"""
+  result = 2166136261
+  for byte in name.encode("utf-8"):
+    result = ((result ^ byte) * 16777619) & 0xFFFFFFFF
+  return result
+
+
+def protocol_numbers(header):
+  """The `decode_type_t` value of each protocol.
+
+  Args:
+    header: The text of IRremoteESP8266.h.
+  Returns:
+    A dict of protocol names to their numbers.
+  """
+  names = generate_send_table.protocols(header)
+  return dict((name, number - 1) for number, name in enumerate(names))
+
+
+def pronto_to_raw(pronto):
+  """Convert a Pronto code to what `IRsend::sendPronto()` sends of it.
+
+  Args:
+    pronto: The text of the code. e.g. "0000 006D 0022 0000 ..."
+  Returns:
+    A tuple of the frequency (Hz), & a list of marks & spaces (uSeconds).
+  Raises:
+    ValueError: If it isn't a raw Pronto code, or is too short.
+  """
+  words = [int(word, 16) for word in pronto.replace(",", " ").split()]
+  if len(words) < 6 or words[0] != 0 or not words[1]:
+    raise ValueError("Not a raw Pronto code: %s" % pronto)
+  hz = int(1000000 / (words[1] * PRONTO_FREQ_FACTOR))
+  tenth = max(hz // 10, 1)
+  period_x10 = max((1000000 + tenth // 2) // tenth, 1)
+  intro = words[2] * 2
+  repeat = words[3] * 2
+  if 4 + intro + repeat > len(words):
+    raise ValueError("Pronto code is too short: %s" % pronto)
+  units = words[4:4 + intro] if intro else words[4:4 + repeat]
+  return hz, [unit * period_x10 // 10 for unit in units]
+
+
+def record(name, code, numbers):
+  """The record of a code.
+
+  Args:
+    name: Its name.
+    code: The JSON object of the code.
+    numbers: The result of protocol_numbers().
+  Returns:
+    The bytes of the record.
+  Raises:
+    ValueError: If the code isn't valid.
+  """
+  encoded = name.encode("utf-8")
+  if not encoded or len(encoded) > MAX_NAME:
+    raise ValueError("Bad name: %r" % name)
+
+  def protocol():
+    if code.get("protocol") not in numbers:
+      raise ValueError("%s: Unknown protocol %r" % (name, code.get("protocol")))
+    return numbers[code["protocol"]]
+
+  def number(value):
+    return int(value, 0) if isinstance(value, str) else int(value)
+
+  if "value" in code:
+    kind = KIND_VALUE
+    payload = struct.pack("<hHHQ", protocol(), code.get("bits", 0),
+                          code.get("repeat", 0), number(code["value"]))
+  elif "state" in code:
+    kind = KIND_STATE
+    state = code["state"]
+    if isinstance(state, str):
+      state = bytes.fromhex(state[2:] if state.lower().startswith("0x")
+                            else state)
+    payload = struct.pack("<hH", protocol(), len(state)) + bytes(state)
+  elif "raw" in code or "pronto" in code:
+    kind = KIND_RAW
+    if "pronto" in code:
+      frequency, durations = pronto_to_raw(code["pronto"])
+    else:
+      frequency = code.get("frequency", DEFAULT_FREQUENCY)
+      durations = code["raw"]
+    payload = struct.pack("<IBH", frequency, code.get("duty", DEFAULT_DUTY),
+                          len(durations))
+    payload += struct.pack("<%dH" % len(durations), *durations)
+  elif "ac" in code:
+    kind = KIND_AC
+    payload = base64.b64decode(code["ac"])
+    if len(payload) != AC_STATE_LENGTH:
+      raise ValueError("%s: Not an A/C state: %r" % (name, code["ac"]))
+  else:
+    raise ValueError("%s: Unknown kind of code: %r" % (name, code))
+  return struct.pack("<BB", kind, len(encoded)) + encoded + payload
+
+
+def build(codes, numbers):
+  """Build the image of some codes.
+
+  Args:
+    codes: A dict of names to the JSON object of each code.
+    numbers: The result of protocol_numbers().
+  Returns:
+    The bytes of the image.
+  """
+  records = b""
+  index = []
+  for name, code in codes.items():
+    index.append((name_hash(name), HEADER_SIZE + len(records)))
+    records += record(name, code, numbers)
+  index.sort(key=lambda entry: entry[0])
+  offset = HEADER_SIZE + len(records)
+  size = offset + 8 * len(index)
+  header = MAGIC + struct.pack("<BBHII", VERSION, 0, len(index), offset, size)
+  return header + records + b"".join(struct.pack("<II", *entry)
+                                     for entry in index)
+
+
+def array(image, name, output=sys.stdout):
+  """Write the image as a C header of a PROGMEM array.
+
+  Args:
+    image: The bytes of the image.
+    name: The name of the array.
+    output: Where to write it.
+  """
+  output.write(
+      "// An IRcodeStore image. See IRcodeStore.h\n"
+      "//\n"
+      "// WARNING: Do not edit this file! This file is automatically "
+      "generated by\n"
+      "//          'tools/ir_code_store.py'.\n"
+      "\n"
+      "#include <stdint.h>\n"
+      "\n"
+      "const uint8_t %s[] PROGMEM = {\n" % name)
+  for start in range(0, len(image), 12):
+    output.write("    " + " ".join("0x%02X," % byte
+                                   for byte in image[start:start + 12]) + "\n")
+  output.write("};\n")
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument("codes", help="The JSON file of the codes.")
+  output = arg_parser.add_mutually_exclusive_group(required=True)
+  output.add_argument("-o", "--output", help="Write the image to this file.")
+  output.add_argument("--array",
+                      help="Write a C header of a PROGMEM array of this name, "
+                      "to stdout.")
+  arg_parser.add_argument("--src", default=SRC_DIR,
+                          help="The library's src/ directory. "
+                          "(Default: %(default)s)")
+  args = arg_parser.parse_args()
+  with open(os.path.join(args.src, "IRremoteESP8266.h")) as header:
+    numbers = protocol_numbers(header.read())
+  with open(args.codes) as codes:
+    image = build(json.load(codes), numbers)
+  if args.output:
+    with open(args.output, "wb") as output:
+      output.write(image)
+  else:
+    array(image, args.array)
+
+
+if __name__ == "__main__":
+  main()
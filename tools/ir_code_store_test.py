@@ -0,0 +1,116 @@
+#!/usr/bin/python3
+"""Unit tests for ir_code_store.py"""
+from io import StringIO
+import base64
+import unittest
+import ir_code_store
+
+ENUM = """
+enum decode_type_t {
+  UNKNOWN = -1,
+  UNUSED = 0,
+  RC5,
+  RC6,
+  NEC,
+  // Add new entries before this one, and update it to point to the last entry.
+  kLastDecodeType = NEC,
+};
+"""
+NUMBERS = {"UNKNOWN": -1, "UNUSED": 0, "RC5": 1, "RC6": 2, "NEC": 3}
+CODES = {
+    "tv_power": {"protocol": "NEC", "value": "0x20DF10EF"},
+    "fan": {"raw": [9000, 4500, 560, 1690, 560], "frequency": 40000},
+    "sat": {"pronto": "0000 006D 0002 0000 0156 00AB 0015 0040"},
+}
+# The same image is read by the `TestIRcodeStore` tests in
+# test/IRcodeStore_test.cpp.
+IMAGE = bytes.fromhex(
+    "4952435301000300520000006a000000010874765f706f776572030000000000ef10df20"
+    "00000000030366616e409c00003205002823941130029a06300203037361748c94000032"
+    "04002223911128029306c9aef3851000000072faf7a828000000d7921cd63e000000")
+
+
+class TestIRCodeStore(unittest.TestCase):
+  """Unit tests for the methods in ir_code_store."""
+
+  def test_name_hash(self):
+    """It is 32 bit FNV-1a."""
+    self.assertEqual(ir_code_store.name_hash(""), 0x811C9DC5)
+    self.assertEqual(ir_code_store.name_hash("a"), 0xE40C292C)
+    self.assertEqual(ir_code_store.name_hash("fan"), 0xA8F7FA72)
+
+  def test_protocol_numbers(self):
+    """Each protocol is numbered as per decode_type_t."""
+    self.assertEqual(ir_code_store.protocol_numbers(ENUM), NUMBERS)
+
+  def test_pronto_to_raw(self):
+    """Pronto codes are converted as IRsend::sendPronto() sends them."""
+    self.assertEqual(
+        ir_code_store.pronto_to_raw("0000 006D 0002 0000 0156 00AB 0015 0040"),
+        (38028, [8994, 4497, 552, 1683]))
+    # With no intro, the repeat is sent once.
+    self.assertEqual(
+        ir_code_store.pronto_to_raw("0000 006D 0000 0001 0156 00AB"),
+        (38028, [8994, 4497]))
+    with self.assertRaises(ValueError):  # Not a raw code.
+      ir_code_store.pronto_to_raw("0100 006D 0000 0001 0156 00AB")
+    with self.assertRaises(ValueError):  # Too short.
+      ir_code_store.pronto_to_raw("0000 006D 0002 0000 0156 00AB")
+
+  def test_record(self):
+    """Each kind of code, & the ones that aren't valid."""
+    self.assertEqual(
+        ir_code_store.record("a", {"protocol": "RC5", "value": 12, "bits": 13,
+                                   "repeat": 1}, NUMBERS),
+        bytes.fromhex("010161" "0100" "0d00" "0100" "0c00000000000000"))
+    self.assertEqual(
+        ir_code_store.record("b", {"protocol": "RC6", "state": "0x0102"},
+                             NUMBERS),
+        bytes.fromhex("020162" "0200" "0200" "0102"))
+    self.assertEqual(
+        ir_code_store.record("c", {"raw": [1, 2], "duty": 33}, NUMBERS),
+        bytes.fromhex("030163" "70940000" "21" "0200" "0100" "0200"))
+    state = bytes(range(1, 10))
+    self.assertEqual(
+        ir_code_store.record("d", {"ac": base64.b64encode(state).decode()},
+                             NUMBERS),
+        bytes.fromhex("040164") + state)
+    with self.assertRaises(ValueError):  # Unknown protocol.
+      ir_code_store.record("e", {"protocol": "SONY", "value": 1}, NUMBERS)
+    with self.assertRaises(ValueError):  # Unknown kind.
+      ir_code_store.record("e", {"protocol": "NEC"}, NUMBERS)
+    with self.assertRaises(ValueError):  # Too short for an A/C state.
+      ir_code_store.record("e", {"ac": "AQID"}, NUMBERS)
+    with self.assertRaises(ValueError):  # No name.
+      ir_code_store.record("", {"raw": [1]}, NUMBERS)
+
+  def test_build(self):
+    """The index is sorted by hash, after the records."""
+    self.assertEqual(ir_code_store.build(CODES, NUMBERS), IMAGE)
+    self.assertEqual(ir_code_store.build({}, NUMBERS),
+                     bytes.fromhex("49524353" "01" "00" "0000" "10000000"
+                                   "10000000"))
+
+  def test_array(self):
+    """Tests for the array() function."""
+    output = StringIO()
+    ir_code_store.array(bytes(range(14)), "kCodes", output=output)
+    self.assertEqual(
+        output.getvalue(),
+        "// An IRcodeStore image. See IRcodeStore.h\n"
+        "//\n"
+        "// WARNING: Do not edit this file! This file is automatically "
+        "generated by\n"
+        "//          'tools/ir_code_store.py'.\n"
+        "\n"
+        "#include <stdint.h>\n"
+        "\n"
+        "const uint8_t kCodes[] PROGMEM = {\n"
+        "    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, "
+        "0x0B,\n"
+        "    0x0C, 0x0D,\n"
+        "};\n")
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
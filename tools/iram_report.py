@@ -0,0 +1,93 @@
+#!/usr/bin/python3
+"""Report how much IRAM the IRremoteESP8266 library uses in a firmware build.
+
+Compare builds with different interrupt handler options. e.g.
+  pio run -e nodemcuv2 && cp .pio/build/nodemcuv2/firmware.elf minimal.elf
+  PLATFORMIO_BUILD_FLAGS=-DENABLE_MINIMAL_ISR=false pio run -e nodemcuv2
+  tools/iram_report.py minimal.elf .pio/build/nodemcuv2/firmware.elf
+"""
+#
+# Copyright 2020 David Conran
+import argparse
+import re
+import subprocess
+import sys
+
+# The output sections that hold code run from IRAM. ESP8266 & ESP32.
+IRAM_SECTIONS = (".text", ".iram0.text")
+# The (demangled) symbols of the library's code that may be in IRAM.
+LIBRARY_SYMBOLS = re.compile(
+    r"^(IRrecv::|IRsend::|gpio_intr|read_timeout|now_usecs|compare_ticks)")
+# A function's line of `objdump -t`. e.g.
+#   40100a4c l     F .text	00000068 gpio_intr(unsigned char)
+SYMBOL_LINE = re.compile(
+    r"^[0-9a-fA-F]+\s.{7}\s(?P<section>\S+)\s+(?P<size>[0-9a-fA-F]+)\s+"
+    r"(?P<name>.+)$")
+# The objdump tools to try, in order, if one isn't given.
+OBJDUMPS = ("xtensa-lx106-elf-objdump", "xtensa-esp32-elf-objdump", "objdump")
+
+
+def iram_symbols(symbol_table):
+  """Find the library's IRAM functions in the output of `objdump -t -C`.
+
+  Args:
+    symbol_table: The text of the symbol table.
+  Returns:
+    A dict of the size (in bytes) of each function, by name.
+  """
+  result = {}
+  for line in symbol_table.splitlines():
+    match = SYMBOL_LINE.match(line)
+    if not match or " F " not in line:  # Only functions.
+      continue
+    name = match.group("name").strip()
+    if (match.group("section") in IRAM_SECTIONS and
+        LIBRARY_SYMBOLS.match(name)):
+      result[name] = result.get(name, 0) + int(match.group("size"), 16)
+  return result
+
+
+def read_symbol_table(elf, objdump=None):
+  """Get the (demangled) symbol table of an ELF file."""
+  for tool in ([objdump] if objdump else OBJDUMPS):
+    try:
+      return subprocess.run([tool, "-t", "-C", elf], check=True,
+                            stdout=subprocess.PIPE,
+                            universal_newlines=True).stdout
+    except FileNotFoundError:
+      continue
+  raise FileNotFoundError("No objdump found. Use --objdump to give one.")
+
+
+def report(tables, verbose=False, output=sys.stdout):
+  """Write the IRAM used by the library in each build.
+
+  Args:
+    tables: A list of (name, symbol table text) of each build.
+    verbose: List each function as well as the total.
+    output: Where to write the report.
+  """
+  for name, table in tables:
+    symbols = iram_symbols(table)
+    output.write("%s: %d bytes of IRAM in %d functions.\n" % (
+        name, sum(symbols.values()), len(symbols)))
+    if verbose:
+      for symbol in sorted(symbols, key=lambda s: (-symbols[s], s)):
+        output.write("  %6d  %s\n" % (symbols[symbol], symbol))
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument("elf", nargs="+", help="Firmware ELF file(s).")
+  arg_parser.add_argument("--objdump", help="The objdump tool to use.")
+  arg_parser.add_argument("-v", "--verbose", action="store_true",
+                          help="List the size of each function too.")
+  args = arg_parser.parse_args()
+  report([(elf, read_symbol_table(elf, args.objdump)) for elf in args.elf],
+         args.verbose)
+
+
+if __name__ == "__main__":
+  main()
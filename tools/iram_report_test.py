@@ -0,0 +1,68 @@
+#!/usr/bin/python3
+"""Unit tests for iram_report.py"""
+from io import StringIO
+import unittest
+import iram_report
+
+# Trimmed `objdump -t -C` output of an ESP8266 & an ESP32 build.
+# pylint: disable=line-too-long
+ESP8266_TABLE = """
+firmware.elf:     file format elf32-xtensa-le
+
+SYMBOL TABLE:
+40100000 l    d  .text	00000000 .text
+40100a4c l     F .text	00000068 gpio_intr(unsigned char)
+40100ab4 l     F .text	0000000c gpio_intr0()
+40100ac0 l     F .text	0000002a read_timeout_arg(void*)
+40100aec g     F .text	00000040 IRrecv::_hashTicks(irparams_t volatile*, unsigned short, unsigned short)
+40100b2c g     F .text	00000080 __wrap_spi_flash_read
+40201010 g     F .irom0.text	00000100 IRrecv::decode(decode_results*, irparams_t*, unsigned char, unsigned short)
+3ffe8000 g     O .data	00000004 IRrecv::something
+"""
+ESP32_TABLE = """
+40080400 l     F .iram0.text	00000070 gpio_intr(unsigned char)
+40080470 g     F .iram0.text	00000020 IRsend::_timerISR()
+400d1000 g     F .flash.text	00000200 IRsend::sendNEC(unsigned long long, unsigned short, unsigned short)
+"""
+# pylint: enable=line-too-long
+
+
+class TestIramReport(unittest.TestCase):
+  """Unit tests for the methods in iram_report."""
+
+  def test_iram_symbols(self):
+    """Only the library's functions that are in IRAM are counted."""
+    self.assertEqual(
+        iram_report.iram_symbols(ESP8266_TABLE),
+        {"gpio_intr(unsigned char)": 0x68,
+         "gpio_intr0()": 0x0c,
+         "read_timeout_arg(void*)": 0x2a,
+         "IRrecv::_hashTicks(irparams_t volatile*, unsigned short, "
+         "unsigned short)": 0x40})
+    self.assertEqual(
+        iram_report.iram_symbols(ESP32_TABLE),
+        {"gpio_intr(unsigned char)": 0x70, "IRsend::_timerISR()": 0x20})
+    self.assertEqual(iram_report.iram_symbols(""), {})
+
+  def test_report(self):
+    """Tests for the report() function."""
+    output = StringIO()
+    iram_report.report(
+        [("full.elf", ESP8266_TABLE), ("esp32.elf", ESP32_TABLE)],
+        output=output)
+    self.assertEqual(
+        output.getvalue(),
+        "full.elf: 222 bytes of IRAM in 4 functions.\n"
+        "esp32.elf: 144 bytes of IRAM in 2 functions.\n")
+    output = StringIO()
+    iram_report.report([("esp32.elf", ESP32_TABLE)], verbose=True,
+                       output=output)
+    self.assertEqual(
+        output.getvalue(),
+        "esp32.elf: 144 bytes of IRAM in 2 functions.\n"
+        "     112  gpio_intr(unsigned char)\n"
+        "      32  IRsend::_timerISR()\n")
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
@@ -0,0 +1,106 @@
+// A C API to the library's decoders, for host applications.
+// Copyright 2026 The IRremoteESP8266 authors
+//
+// See irdecode.h. Each irdecode_t wraps an IRdecoder, which shares nothing
+// with any other, so separate threads can each decode with their own.
+
+#include "irdecode.h"
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+#include "IRrecv.h"
+#include "IRutils.h"
+
+static_assert(IRDECODE_STATE_SIZE >= kStateSizeMax,
+              "IRDECODE_STATE_SIZE is too small for a decode_results state.");
+
+struct irdecode {
+  explicit irdecode(const uint8_t timeout) : decoder(timeout) {}
+  IRdecoder decoder;
+  std::vector<uint16_t> rawbuf;  // The capture being decoded, in ticks.
+  std::string name;  // Storage for what irdecode_protocol_name() returns.
+};
+
+/// The version of the API the library has.
+/// @return The version. See IRDECODE_API_VERSION.
+int irdecode_api_version(void) { return IRDECODE_API_VERSION; }
+
+/// Create a decoder.
+/// @param[in] timeout Nr. of milli-Seconds of no signal that ended the
+///   captures. e.g. IRDECODE_DEFAULT_TIMEOUT.
+/// @return The decoder, or NULL if there wasn't enough memory.
+irdecode_t *irdecode_new(const uint8_t timeout) {
+  return new (std::nothrow) irdecode(timeout);
+}
+
+/// Free a decoder made by `irdecode_new()`.
+/// @param[in] decoder The decoder. NULL is ignored.
+void irdecode_free(irdecode_t *decoder) { delete decoder; }
+
+/// Decode a capture.
+/// @param[in] decoder The decoder to use.
+/// @param[in] usecs The capture. The duration of each mark & space, starting
+///   with a mark, in uSeconds. i.e. As per a `rawData[]` dump.
+/// @param[in] length Nr. of entries in `usecs`. At most 65534 are used.
+/// @param[out] result Where to store the result.
+/// @return 1 if it was decoded, otherwise 0.
+int irdecode_one(irdecode_t *decoder, const uint16_t *usecs,
+                 const uint32_t length, irdecode_result_t *result) {
+  memset(result, 0, sizeof(*result));
+  result->protocol = decode_type_t::UNKNOWN;
+  if (decoder == NULL || usecs == NULL || length == 0) return 0;
+  const uint16_t entries = std::min(length, (uint32_t)(UINT16_MAX - 1));
+  // In the capture buffer's format. i.e. Ticks, after the gap before it.
+  decoder->rawbuf.resize(entries + 1);
+  decoder->rawbuf[0] = 0;
+  for (uint16_t i = 0; i < entries; i++)
+    decoder->rawbuf[i + 1] = usecs[i] / kRawTick;
+  decode_results results;
+  if (!decoder->decoder.decode(&results, decoder->rawbuf.data(),
+                               entries + 1)) return 0;
+  result->protocol = results.decode_type;
+  result->bits = results.bits;
+  result->decoded = 1;
+  result->repeat = results.repeat;
+  result->has_state = hasACState(results.decode_type);
+  if (result->has_state) {
+    memcpy(result->state, results.state, sizeof(results.state));
+  } else {
+    result->value = results.value;
+    result->address = results.address;
+    result->command = results.command;
+  }
+  return 1;
+}
+
+/// Decode a batch of captures.
+/// @param[in] decoder The decoder to use.
+/// @param[in] usecs The captures, one after the other. See `irdecode_one()`.
+/// @param[in] lengths Nr. of entries in `usecs` of each capture.
+/// @param[in] count Nr. of captures.
+/// @param[out] results An array of `count` results. One per capture.
+/// @return Nr. of captures that were decoded.
+size_t irdecode_batch(irdecode_t *decoder, const uint16_t *usecs,
+                      const uint32_t *lengths, const size_t count,
+                      irdecode_result_t *results) {
+  size_t decoded = 0;
+  for (size_t i = 0; i < count; i++) {
+    decoded += irdecode_one(decoder, usecs, lengths[i], &results[i]);
+    usecs += lengths[i];
+  }
+  return decoded;
+}
+
+/// The name of a protocol.
+/// @param[in] decoder The decoder. The name is valid until it is next called
+///   with the same decoder.
+/// @param[in] protocol A `irdecode_result_t.protocol`.
+/// @return The name. e.g. "NEC"
+const char *irdecode_protocol_name(irdecode_t *decoder,
+                                   const int16_t protocol) {
+  if (decoder == NULL) return "";
+  decoder->name = typeToString((decode_type_t)protocol);
+  return decoder->name.c_str();
+}
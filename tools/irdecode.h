@@ -0,0 +1,66 @@
+// A C API to the library's decoders, for host applications. e.g. Services or
+// Python (via ctypes) that decode captures in bulk.
+// Copyright 2026 The IRremoteESP8266 authors
+//
+// Build the shared library with: `make libirdecode.so` (in tools/)
+//
+// Example:
+//   irdecode_t *decoder = irdecode_new(IRDECODE_DEFAULT_TIMEOUT);
+//   irdecode_result_t results[2];
+//   // Two captures, of 4 & 68 timings, one after the other in `usecs`.
+//   const uint32_t lengths[2] = {4, 68};
+//   size_t decoded = irdecode_batch(decoder, usecs, lengths, 2, results);
+//   irdecode_free(decoder);
+//
+// The API, & the layout of its structures, only change along with
+// IRDECODE_API_VERSION.
+
+#ifndef TOOLS_IRDECODE_H_
+#define TOOLS_IRDECODE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// What `irdecode_api_version()` returns for this version of the API.
+#define IRDECODE_API_VERSION 1
+// Nr. of bytes of `irdecode_result_t.state`. The largest state of any protocol.
+#define IRDECODE_STATE_SIZE 64
+// Nr. of milli-Seconds of no signal that ends a capture. As per IRrecv.
+#define IRDECODE_DEFAULT_TIMEOUT 15
+
+/// A decoder. Each thread needs its own.
+typedef struct irdecode irdecode_t;
+
+/// The result of decoding a capture.
+typedef struct {
+  int16_t protocol;  // A decode_type_t. e.g. -1 is UNKNOWN, if not decoded.
+  uint16_t bits;     // Nr. of bits in the message.
+  uint8_t decoded;   // 1 if it was decoded, otherwise 0.
+  uint8_t repeat;    // 1 if it is a repeat code, otherwise 0.
+  uint8_t has_state;  // 1 if `state` holds the message, otherwise `value`.
+  uint8_t reserved;
+  uint32_t address;  // The device address, if the protocol has one.
+  uint32_t command;  // The command, if the protocol has one.
+  uint64_t value;    // The message, if it has no state.
+  uint8_t state[IRDECODE_STATE_SIZE];  // The message, if it has a state.
+} irdecode_result_t;
+
+int irdecode_api_version(void);
+irdecode_t *irdecode_new(uint8_t timeout);
+void irdecode_free(irdecode_t *decoder);
+int irdecode_one(irdecode_t *decoder, const uint16_t *usecs, uint32_t length,
+                 irdecode_result_t *result);
+size_t irdecode_batch(irdecode_t *decoder, const uint16_t *usecs,
+                      const uint32_t *lengths, size_t count,
+                      irdecode_result_t *results);
+const char *irdecode_protocol_name(irdecode_t *decoder, int16_t protocol);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // TOOLS_IRDECODE_H_
@@ -0,0 +1,118 @@
+#!/usr/bin/python3
+"""Decode captures in bulk via the libirdecode.so C API (irdecode.h).
+
+Build the library first, with `make libirdecode.so` (in tools/). e.g.
+  tools/irdecode.py "9024, 4512, 564, 564, ..." "..."
+or, in Python:
+  import irdecode
+  decoder = irdecode.Decoder()
+  for result in decoder.decode([[9024, 4512, 564, ...], ...]):
+    print(result)
+"""
+#
+# Copyright 2026 The IRremoteESP8266 authors
+import argparse
+import ctypes
+import os
+
+API_VERSION = 1  # IRDECODE_API_VERSION
+STATE_SIZE = 64  # IRDECODE_STATE_SIZE
+DEFAULT_TIMEOUT = 15  # IRDECODE_DEFAULT_TIMEOUT
+DEFAULT_LIBRARY = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "libirdecode.so")
+
+
+class Result(ctypes.Structure):
+  """An irdecode_result_t."""
+  # pylint: disable=too-few-public-methods
+  _fields_ = [("protocol", ctypes.c_int16),
+              ("bits", ctypes.c_uint16),
+              ("decoded", ctypes.c_uint8),
+              ("repeat", ctypes.c_uint8),
+              ("has_state", ctypes.c_uint8),
+              ("reserved", ctypes.c_uint8),
+              ("address", ctypes.c_uint32),
+              ("command", ctypes.c_uint32),
+              ("value", ctypes.c_uint64),
+              ("state", ctypes.c_uint8 * STATE_SIZE)]
+
+
+class Decoder:
+  """A decoder of the library. Each thread needs its own."""
+
+  def __init__(self, library=DEFAULT_LIBRARY, timeout=DEFAULT_TIMEOUT):
+    self.lib = ctypes.CDLL(library)
+    if self.lib.irdecode_api_version() != API_VERSION:
+      raise ImportError("%s isn't version %d of the API." % (library,
+                                                              API_VERSION))
+    self.lib.irdecode_new.restype = ctypes.c_void_p
+    self.lib.irdecode_new.argtypes = [ctypes.c_uint8]
+    self.lib.irdecode_free.argtypes = [ctypes.c_void_p]
+    self.lib.irdecode_batch.restype = ctypes.c_size_t
+    self.lib.irdecode_batch.argtypes = [
+        ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16),
+        ctypes.POINTER(ctypes.c_uint32), ctypes.c_size_t,
+        ctypes.POINTER(Result)]
+    self.lib.irdecode_protocol_name.restype = ctypes.c_char_p
+    self.lib.irdecode_protocol_name.argtypes = [ctypes.c_void_p,
+                                                ctypes.c_int16]
+    self.decoder = self.lib.irdecode_new(timeout)
+    if not self.decoder:
+      raise MemoryError("Couldn't create a decoder.")
+
+  def __del__(self):
+    if getattr(self, "decoder", None):
+      self.lib.irdecode_free(self.decoder)
+      self.decoder = None
+
+  def decode(self, captures):
+    """Decode a batch of captures, in a single call to the library.
+
+    Args:
+      captures: A list of captures. Each a list of mark & space durations in
+        uSeconds, starting with a mark.
+    Returns:
+      A list of dicts of the result of each capture. Those that weren't
+      decoded have a protocol of "UNKNOWN".
+    """
+    timings = [min(max(int(usecs), 0), 0xFFFF)
+               for capture in captures for usecs in capture]
+    usecs = (ctypes.c_uint16 * max(len(timings), 1))(*timings)
+    lengths = (ctypes.c_uint32 * max(len(captures), 1))(
+        *[len(capture) for capture in captures])
+    results = (Result * max(len(captures), 1))()
+    self.lib.irdecode_batch(self.decoder, usecs, lengths, len(captures),
+                            results)
+    output = []
+    for result in results[:len(captures)]:
+      decoded = {"protocol": self.lib.irdecode_protocol_name(
+          self.decoder, result.protocol).decode(), "bits": result.bits,
+                 "repeat": bool(result.repeat)}
+      if result.has_state:
+        decoded["state"] = bytes(result.state[:(result.bits + 7) // 8])
+      else:
+        decoded.update(value=result.value, address=result.address,
+                       command=result.command)
+      output.append(decoded)
+    return output
+
+
+def main():
+  """Parse the commandline arguments and call the method."""
+  arg_parser = argparse.ArgumentParser(
+      description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  arg_parser.add_argument(
+      "captures", nargs="+",
+      help="Captures. Each a comma separated list of uSecond timings.")
+  arg_parser.add_argument("--library", default=DEFAULT_LIBRARY,
+                          help="The library. (Default: %(default)s)")
+  args = arg_parser.parse_args()
+  decoder = Decoder(args.library)
+  captures = [[int(usecs) for usecs in capture.replace("{", "").replace(
+      "}", "").split(",") if usecs.strip()] for capture in args.captures]
+  for result in decoder.decode(captures):
+    print(result)
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,53 @@
+#!/usr/bin/python3
+"""Unit tests for irdecode.py & the libirdecode.so it uses."""
+import os
+import unittest
+import irdecode
+
+
+def nec_capture(value):
+  """The timings of a (32 bit) NEC message."""
+  capture = [9000, 4500]
+  for bit in range(31, -1, -1):
+    capture += [560, 1690 if value >> bit & 1 else 560]
+  return capture + [560]
+
+
+@unittest.skipUnless(os.path.exists(irdecode.DEFAULT_LIBRARY),
+                     "libirdecode.so hasn't been built.")
+class TestIrdecode(unittest.TestCase):
+  """Unit tests for irdecode.Decoder."""
+
+  def test_decode(self):
+    """Decode a batch of captures in one go."""
+    decoder = irdecode.Decoder()
+    results = decoder.decode([nec_capture(0x00FF807F), [100, 100, 100],
+                              [9000, 2250, 560], nec_capture(0x20DF10EF)])
+    self.assertEqual(len(results), 4)
+    self.assertEqual(results[0]["protocol"], "NEC")
+    self.assertEqual(results[0]["bits"], 32)
+    self.assertEqual(results[0]["value"], 0x00FF807F)
+    self.assertEqual(results[0]["command"], 0x01)
+    self.assertEqual(results[1]["protocol"], "UNKNOWN")
+    self.assertEqual(results[2]["protocol"], "NEC")
+    self.assertTrue(results[2]["repeat"])
+    self.assertEqual(results[3]["value"], 0x20DF10EF)
+    self.assertEqual(decoder.decode([]), [])
+
+  def test_state(self):
+    """Protocols with a state return it instead of a value."""
+    # A Trotec message. Header, then 9 bytes, LSB first.
+    state = [0x12, 0x34, 0x29, 0x82, 0x00, 0x00, 0x00, 0x00, 0xAB]
+    capture = [5952, 7364]
+    for byte in state:
+      for bit in range(8):
+        capture += [592, 1560 if byte >> bit & 1 else 592]
+    capture += [592, 6184, 592]
+    result = irdecode.Decoder().decode([capture])[0]
+    self.assertEqual(result["protocol"], "TROTEC")
+    self.assertEqual(result["state"], bytes(state))
+    self.assertNotIn("value", result)
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)
@@ -4,6 +4,26 @@
 
 // Usage example:
 // mode2 -H udp -d 5000 | ./mode2_decode
+// Or straight from a LIRC device, reporting how long each frame took:
+// ./mode2_decode -device /dev/lirc0 -stats
+//
+// Or recording each frame into a capture file, to replay later:
+// ./mode2_decode -device /dev/lirc0 -save captures.irc
+//
+// Usage: ./mode2_decode [-raw] [-gap usecs] [-stats] [-device path]
+//                       [-save path]
+//   -raw     Dump the raw timings of every frame.
+//   -gap     A space longer than this ends a frame. (Default: 20000)
+//   -stats   Report each frame's latency, & a summary on exit (to stderr).
+//            i.e. From when the frame's last pulse arrived, to it being
+//            decoded. It includes waiting for the gap that ends it.
+//   -device  Read the binary mode2 samples of a LIRC device (e.g. /dev/lirc0)
+//            rather than the text of the `mode2` tool from stdin. The device
+//            must be in mode2 mode, which is the default for raw receivers.
+//            Its timeout reports also end a frame.
+//   -save    Add every frame to a capture file. (See capture_file.h) Each is
+//            written as soon as it ends, with the Unix time as its timestamp.
+// Frames are decoded as soon as they end, so it can be left running.
 
 /* Sample input (alternating space and pulse durations in microseconds):
 space 500000
@@ -18,105 +38,264 @@ space 500000
 */
 
 #include <errno.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
 #include <iostream>
 #include <sstream>
 #include <string>
+#include "IRrecv.h"
 #include "IRsend.h"
 #include "IRsend_test.h"
 #include "IRutils.h"
+#include "capture_file.h"
 
 const uint16_t kMaxGcCodeLength = 10000;
+const uint32_t kDefaultFrameGap = 20000;  // uSeconds.
+// The types of the samples of a LIRC device in mode2 mode. (linux/lirc.h)
+const uint32_t kLircMode2Space = 0x00000000;
+const uint32_t kLircMode2Pulse = 0x01000000;
+const uint32_t kLircMode2Timeout = 0x03000000;
+const uint32_t kLircMode2Overflow = 0x04000000;
+const uint32_t kLircMode2TypeMask = 0xFF000000;
+const uint32_t kLircMode2ValueMask = 0x00FFFFFF;
 
-void str_to_uint16(char *str, uint16_t *res, uint8_t base) {
-  char *end;
-  errno = 0;
-  intmax_t val = strtoimax(str, &end, base);
-  if (errno == ERANGE || val < 0 || val > UINT16_MAX || end == str ||
-      *end != '\0')
-    return;
-  *res = (uint16_t)val;
-}
+typedef std::chrono::steady_clock::time_point time_point_t;
+
+/// The frame being built up, & the stats of the frames so far.
+typedef struct {
+  IRsendTest *irsend;
+  IRdecoder *irdecoder;
+  CaptureFileWriter *saver;  // Where to save the frames, if anywhere.
+  bool dumpraw;
+  bool stats;
+  uint32_t gap;        // Spaces longer than this end a frame. (uSeconds)
+  int index;           // Nr. of pulses & spaces in the frame so far.
+  time_point_t last;   // When the frame's last pulse arrived.
+  uint32_t frames;     // Nr. of frames decoded.
+  uint32_t decoded;    // Nr. of them a protocol decoded.
+  uint64_t latency_sum;  // (uSeconds)
+  uint64_t latency_max;  // (uSeconds)
+  uint64_t decode_sum;   // Total time spent decoding. (uSeconds)
+} mode2_state_t;
 
 void usage_error(char *name) {
-  std::cerr << "Usage: " << name << " [-raw]" << std::endl;
+  std::cerr << "Usage: " << name
+            << " [-raw] [-gap usecs] [-stats] [-device path] [-save path]"
+            << std::endl;
 }
 
-int main(int argc, char *argv[]) {
-  bool dumpraw = false;
+uint64_t usecsSince(const time_point_t start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+/// Decode & report the frame built up so far, then start a new one.
+void endFrame(mode2_state_t *state) {
+  IRsendTest *irsend = state->irsend;
+  // Skip long spaces at beginning
+  if (state->index > 1) {
+    const time_point_t start = std::chrono::steady_clock::now();
+    irsend->makeDecodeResult();
+    state->irdecoder->decode(&irsend->capture);
+    const uint64_t decode_time = usecsSince(start);
+    const uint64_t latency = usecsSince(state->last);
 
-  // Check the invocation/calling usage.
-  if (argc > 2) {
-    usage_error(argv[0]);
-    return 1;
+    std::cout << "Code length " << state->index << std::endl
+              << "Code type      " << irsend->capture.decode_type << " ("
+              << typeToString(irsend->capture.decode_type) << ")"
+              << std::endl
+              << "Code bits      " << irsend->capture.bits << std::endl;
+    if (hasACState(irsend->capture.decode_type)) {
+      std::cout << "State value    0x";
+      for (uint16_t i = 0; i < irsend->capture.bits / 8; i++)
+        printf("%02X", irsend->capture.state[i]);
+      std::cout << std::endl;
+    } else {
+      std::cout << "Code value     0x" << std::hex << irsend->capture.value
+                << std::endl
+                << "Code address   0x" << std::hex << irsend->capture.address
+                << std::endl
+                << "Code command   0x" << std::hex << irsend->capture.command
+                << std::dec << std::endl;
+    }
+    if (state->stats)
+      std::cout << "Latency        " << latency << " usecs (decode "
+                << decode_time << " usecs)" << std::endl;
+
+    if (state->dumpraw || irsend->capture.decode_type == UNKNOWN)
+      irsend->dumpRawResult();
+    if (state->saver != NULL &&
+        !state->saver->add(&irsend->capture, 38, time(NULL)))
+      std::cerr << "Can't save the frame." << std::endl;
+    std::cout.flush();  // It may be a while before the next one.
+
+    state->frames++;
+    if (irsend->capture.decode_type != UNKNOWN) state->decoded++;
+    state->latency_sum += latency;
+    state->latency_max = std::max(state->latency_max, latency);
+    state->decode_sum += decode_time;
   }
 
-  if (argc == 2 && strncmp("-raw", argv[1], 4) == 0) {
-    dumpraw = true;
+  irsend->reset();
+  state->index = 0;
+}
+
+/// Add a pulse or a space to the frame, ending it if need be.
+/// @param[in,out] state The frame.
+/// @param[in] pulse Is it a pulse? Otherwise it's a space.
+/// @param[in] duration How long it was. (uSeconds)
+void addDuration(mode2_state_t *state, const bool pulse,
+                 const uint32_t duration) {
+  // Clamp duration to int16_t
+  const uint16_t clamped = std::min(duration, (uint32_t)0xFFFF);
+  if (pulse) {
+    state->irsend->mark(clamped);
+    state->last = std::chrono::steady_clock::now();
+  } else {
+    state->irsend->space(clamped);
   }
+  state->index++;
+
+  if ((!pulse && duration > state->gap) || state->index >= kMaxGcCodeLength)
+    endFrame(state);
+}
 
-  int index = 0;
+/// Decode the text output of the LIRC `mode2` tool.
+void readText(mode2_state_t *state) {
   std::string line, type;
   std::string pulse = "pulse";
   std::string space = "space";
-  int duration;
-
-  IRsendTest irsend(4);
-  IRrecv irrecv(4);
-  irsend.begin();
-  irsend.reset();
+  std::string timeout = "timeout";
+  uint32_t duration;
 
   while (getline(std::cin, line)) {
     std::istringstream iss1(line);
     iss1 >> type;
-    iss1 >> duration;
+    if (!(iss1 >> duration)) continue;  // Not a duration. e.g. A header.
 
-    // Clamp duration to int16_t
-    if (duration > 0xFFFF) {
-      duration = 0xFFFF;
-    }
     if (pulse.compare(type) == 0) {
-      irsend.mark(duration);
+      addDuration(state, true, duration);
     } else if (space.compare(type) == 0) {
-      irsend.space(duration);
+      addDuration(state, false, duration);
+    } else if (timeout.compare(type) == 0) {
+      endFrame(state);
     }
-    index++;
-
-    if (duration > 20000 || index >= kMaxGcCodeLength) {
-      // Skip long spaces at beginning
-      if (index > 1) {
-        irsend.makeDecodeResult();
-        irrecv.decode(&irsend.capture);
-
-        std::cout << "Code length " << index << std::endl
-                  << "Code type      " << irsend.capture.decode_type << " ("
-                  << typeToString(irsend.capture.decode_type) << ")"
-                  << std::endl
-                  << "Code bits      " << irsend.capture.bits << std::endl;
-        if (hasACState(irsend.capture.decode_type)) {
-          std::cout << "State value    0x";
-          for (uint16_t i = 0; i < irsend.capture.bits / 8; i++)
-            printf("%02X", irsend.capture.state[i]);
-          std::cout << std::endl;
-        } else {
-          std::cout << "Code value     0x" << std::hex << irsend.capture.value
-                    << std::endl
-                    << "Code address   0x" << std::hex << irsend.capture.address
-                    << std::endl
-                    << "Code command   0x" << std::hex << irsend.capture.command
-                    << std::endl;
-        }
-
-        if (dumpraw || irsend.capture.decode_type == UNKNOWN)
-          irsend.dumpRawResult();
+  }
+}
+
+/// Decode the binary mode2 samples of a LIRC device.
+/// @return true, if it was read until the end without an error.
+bool readDevice(mode2_state_t *state, const char *path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Can't open " << path << ": " << strerror(errno) << std::endl;
+    return false;
+  }
+  uint32_t samples[256];
+  ssize_t length;
+  while ((length = read(fd, samples, sizeof(samples))) > 0 ||
+         (length < 0 && errno == EINTR)) {
+    for (ssize_t i = 0; i < length / (ssize_t)sizeof(samples[0]); i++) {
+      const uint32_t value = samples[i] & kLircMode2ValueMask;
+      switch (samples[i] & kLircMode2TypeMask) {
+        case kLircMode2Pulse:
+          addDuration(state, true, value);
+          break;
+        case kLircMode2Space:
+          addDuration(state, false, value);
+          break;
+        case kLircMode2Timeout:
+        case kLircMode2Overflow:
+          endFrame(state);
+          break;
+        default:  // e.g. The carrier frequency.
+          break;
       }
+    }
+  }
+  const bool ok = length == 0;
+  if (!ok) std::cerr << "Can't read " << path << ": " << strerror(errno)
+                     << std::endl;
+  close(fd);
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  mode2_state_t state;
+  state.dumpraw = false;
+  state.stats = false;
+  state.gap = kDefaultFrameGap;
+  const char *device = NULL;
+  const char *save = NULL;
 
-      irsend.reset();
-      index = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp("-raw", argv[i], 4) == 0) {
+      state.dumpraw = true;
+    } else if (strcmp("-stats", argv[i]) == 0) {
+      state.stats = true;
+    } else if (strcmp("-gap", argv[i]) == 0 && i + 1 < argc) {
+      char *end;
+      errno = 0;
+      intmax_t val = strtoimax(argv[++i], &end, 10);
+      if (errno == ERANGE || val <= 0 || val > UINT32_MAX || *end != '\0') {
+        usage_error(argv[0]);
+        return 1;
+      }
+      state.gap = val;
+    } else if (strcmp("-device", argv[i]) == 0 && i + 1 < argc) {
+      device = argv[++i];
+    } else if (strcmp("-save", argv[i]) == 0 && i + 1 < argc) {
+      save = argv[++i];
+    } else {
+      usage_error(argv[0]);
+      return 1;
     }
   }
 
-  return 0;
+  IRsendTest irsend(4);
+  IRdecoder irdecoder;
+  irsend.begin();
+  irsend.reset();
+  state.irsend = &irsend;
+  state.irdecoder = &irdecoder;
+  CaptureFileWriter saver;
+  state.saver = NULL;
+  if (save != NULL) {
+    if (!saver.open(save)) {
+      std::cerr << "Can't create " << save << std::endl;
+      return 1;
+    }
+    state.saver = &saver;
+  }
+  state.index = 0;
+  state.last = std::chrono::steady_clock::now();
+  state.frames = 0;
+  state.decoded = 0;
+  state.latency_sum = 0;
+  state.latency_max = 0;
+  state.decode_sum = 0;
+
+  bool ok = true;
+  if (device != NULL)
+    ok = readDevice(&state, device);
+  else
+    readText(&state);
+  endFrame(&state);  // Whatever was left when the input ended.
+  if (save != NULL && !saver.close()) {
+    std::cerr << "Can't write " << save << std::endl;
+    ok = false;
+  }
+
+  if (state.stats && state.frames)
+    std::cerr << "Frames " << state.frames << ", decoded " << state.decoded
+              << ". Latency avg " << state.latency_sum / state.frames
+              << " usecs, max " << state.latency_max << " usecs. Decode avg "
+              << state.decode_sum / state.frames << " usecs." << std::endl;
+  return ok ? 0 : 1;
 }
@@ -0,0 +1,214 @@
+#!/usr/bin/python3
+"""Generate a header of the static files of an example's web app, compressed.
+
+Each file is gzip compressed into a PROGMEM array, so the web server can send
+it straight from flash, as it is, with "Content-Encoding: gzip". i.e. It isn't
+built or compressed per request, & far fewer bytes are sent over WiFi.
+Each has a version (a hash of its contents), for its ETag. Links to the other
+files in the html files get it added as "?v=<version>", so a browser can cache
+them for as long as it likes. A new version of a file has a new link.
+e.g.
+  tools/web_assets.py -o examples/Web-AC-control/web_assets.h \\
+      examples/Web-AC-control/data/*
+"""
+#
+# Copyright 2026 The IRremoteESP8266 authors
+import argparse
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+# The Content-Type of each kind of file.
+CONTENT_TYPES = {
+    ".css": "text/css",
+    ".htm": "text/html",
+    ".html": "text/html",
+    ".ico": "image/x-icon",
+    ".jpg": "image/jpeg",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".png": "image/png",
+    ".svg": "image/svg+xml",
+    ".txt": "text/plain",
+}
+# Files whose links to the other files get their version added.
+LINKING_TYPES = ("text/html",)
+BYTES_PER_LINE = 12
+
+
+def content_type(name):
+  """The Content-Type of a file.
+
+  Args:
+    name: Its name.
+  Returns:
+    A string of it.
+  """
+  return CONTENT_TYPES.get(os.path.splitext(name)[1].lower(),
+                           "application/octet-stream")
+
+
+def version(data):
+  """The version of a file's contents.
+
+  Args:
+    data: The contents.
+  Returns:
+    A short hash of them, as a hex string.
+  """
+  return hashlib.sha1(data).hexdigest()[:8]
+
+
+def compress(data):
+  """Gzip compress a file's contents. The same contents always give the same
+  bytes. i.e. No name or time is stored, so the header only changes when
+  the files do.
+
+  Args:
+    data: The contents.
+  Returns:
+    The compressed bytes.
+  """
+  return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def add_versions(text, versions):
+  """Add the versions of the files to the (quoted) links to them.
+
+  Args:
+    text: The contents of a file that links to others. e.g. An html file.
+    versions: A dict of the version of each file, by name.
+  Returns:
+    The contents, with the links changed.
+  """
+  for name, ver in versions.items():
+    text = re.sub(r"""(["'])%s\1""" % re.escape(name),
+                  r"\g<1>%s?v=%s\g<1>" % (name, ver), text)
+  return text
+
+
+def assets(files, prefix="/"):
+  """Prepare the files to be served.
+
+  Args:
+    files: A list of (name, contents) tuples.
+    prefix: The URL path the files are under.
+  Returns:
+    A list of dicts of each file's path, type, version, size & data. In the
+    order given.
+  """
+  versions = {}
+  result = {}
+  # The files that link to others are done last, so theirs are known.
+  for name, data in sorted(files, key=lambda f: (
+      content_type(f[0]) in LINKING_TYPES, f[0])):
+    kind = content_type(name)
+    if kind in LINKING_TYPES:
+      data = add_versions(data.decode("utf-8"), versions).encode("utf-8")
+    versions[name] = version(data)
+    result[name] = {"path": prefix + name, "type": kind,
+                    "version": versions[name], "size": len(data),
+                    "data": compress(data)}
+  return [result[name] for name, _ in files]
+
+
+def generate(files, guard, command, prefix="/"):
+  """Generate the header.
+
+  Args:
+    files: A list of (name, contents) tuples.
+    guard: The name of its include guard.
+    command: The command that regenerates it.
+    prefix: The URL path the files are under.
+  Returns:
+    The contents of the header, as a string.
+  """
+  output = [
+      "// Copyright 2026 The IRremoteESP8266 authors",
+      "// The static files of the web app, gzip compressed. See `web_asset_t`.",
+      "//",
+      "// WARNING: Do not edit this file! This file is automatically generated"
+      " by",
+      "//          'tools/web_assets.py'. Regenerate it whenever the files"
+      " change,",
+      "//          with:",
+      "//   " + command,
+      "",
+      "#ifndef %s" % guard,
+      "#define %s" % guard,
+      "",
+      "#include <Arduino.h>",
+      "",
+      "// A static file of the web app.",
+      "typedef struct {",
+      "  const char *path;  // Its URL.",
+      "  const char *type;  // Its Content-Type.",
+      "  const char *version;  // A hash of its contents.",
+      "  const uint8_t *data;  // Its gzip compressed contents. (PROGMEM)",
+      "  uint32_t size;  // Nr. of bytes of `data`.",
+      "} web_asset_t;",
+      ""]
+  prepared = assets(files, prefix)
+  for i, asset in enumerate(prepared):
+    output.append("// %s: %d bytes, %d compressed." % (
+        asset["path"], asset["size"], len(asset["data"])))
+    output.append("const uint8_t kWebAsset%d[] PROGMEM = {" % i)
+    data = asset["data"]
+    for start in range(0, len(data), BYTES_PER_LINE):
+      output.append("  " + ", ".join(
+          "0x%02X" % byte for byte in data[start:start + BYTES_PER_LINE]) +
+                    ",")
+    output.append("};")
+    output.append("")
+  output.append("const web_asset_t kWebAssets[] = {")
+  for i, asset in enumerate(prepared):
+    output.append('  {"%s", "%s", "%s", kWebAsset%d, %d},' % (
+        asset["path"], asset["type"], asset["version"], i,
+        len(asset["data"])))
+  output.append("};")
+  output.append("const uint8_t kWebAssetCount = "
+                "sizeof(kWebAssets) / sizeof(kWebAssets[0]);")
+  output.append("")
+  output.append("#endif  // %s" % guard)
+  return "\n".join(output) + "\n"
+
+
+def guard_name(path):
+  """The include guard of a header, as cpplint would have it.
+
+  Args:
+    path: The header's path.
+  Returns:
+    The name of the guard.
+  """
+  path = os.path.relpath(os.path.abspath(path))
+  return re.sub(r"[^A-Z0-9]", "_", path.upper()) + "_"
+
+
+def main():
+  """Parse the command line & generate the header."""
+  parser = argparse.ArgumentParser(
+      description="Generate a header of an example's static web files.")
+  parser.add_argument("-o", "--output", required=True,
+                      help="The header to write.")
+  parser.add_argument("--prefix", default="/",
+                      help="The URL path the files are under. (default: /)")
+  parser.add_argument("files", nargs="+", help="The files to serve.")
+  args = parser.parse_args()
+  files = []
+  for path in args.files:
+    with open(path, "rb") as file:
+      files.append((os.path.basename(path), file.read()))
+  command = " ".join(["tools/web_assets.py", "-o", args.output] +
+                     (["--prefix", args.prefix] if args.prefix != "/" else [])
+                     + args.files)
+  with open(args.output, "w") as header:
+    header.write(generate(files, guard_name(args.output), command,
+                          args.prefix))
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())
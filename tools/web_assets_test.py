@@ -0,0 +1,100 @@
+#!/usr/bin/python3
+"""Unit tests for web_assets.py"""
+import gzip
+import unittest
+import web_assets
+
+HTML = (b"<link href='style.css'><img src=\"a.svg\"><script src='ui.js'>"
+        b"</script><a href='ui.jsx'>ui.js</a>")
+
+
+class TestWebAssets(unittest.TestCase):
+  """Unit tests for the methods in web_assets."""
+
+  def test_content_type(self):
+    """Tests for the content_type() function."""
+    self.assertEqual(web_assets.content_type("ui.html"), "text/html")
+    self.assertEqual(web_assets.content_type("UI.JS"),
+                     "application/javascript")
+    self.assertEqual(web_assets.content_type("level_1_on.svg"),
+                     "image/svg+xml")
+    self.assertEqual(web_assets.content_type("blob"),
+                     "application/octet-stream")
+
+  def test_compress(self):
+    """Tests for the compress() function."""
+    data = b"var state = {};\n" * 100
+    compressed = web_assets.compress(data)
+    self.assertEqual(gzip.decompress(compressed), data)
+    self.assertLess(len(compressed), len(data) / 10)
+    # The same every time. i.e. No time or name.
+    self.assertEqual(compressed, web_assets.compress(data))
+
+  def test_add_versions(self):
+    """Tests for the add_versions() function."""
+    self.assertEqual(
+        web_assets.add_versions(HTML.decode(), {"ui.js": "12345678",
+                                                "a.svg": "abcdef01"}),
+        "<link href='style.css'><img src=\"a.svg?v=abcdef01\">"
+        "<script src='ui.js?v=12345678'></script><a href='ui.jsx'>ui.js</a>")
+
+  def test_assets(self):
+    """Tests for the assets() function."""
+    files = [("ui.html", HTML), ("ui.js", b"var a = 1;"), ("a.svg", b"<svg>")]
+    result = web_assets.assets(files, "/app/")
+    self.assertEqual([a["path"] for a in result],
+                     ["/app/ui.html", "/app/ui.js", "/app/a.svg"])
+    self.assertEqual([a["type"] for a in result],
+                     ["text/html", "application/javascript",
+                      "image/svg+xml"])
+    js_version = web_assets.version(b"var a = 1;")
+    self.assertEqual(result[1]["version"], js_version)
+    self.assertEqual(result[1]["size"], 10)
+    html = gzip.decompress(result[0]["data"]).decode()
+    self.assertIn("src='ui.js?v=%s'" % js_version, html)
+    self.assertIn("src=\"a.svg?v=%s\"" % result[2]["version"], html)
+    self.assertEqual(result[0]["version"], web_assets.version(html.encode()))
+    self.assertEqual(result[0]["size"], len(html))
+
+  def test_generate(self):
+    """Tests for the generate() function."""
+    output = web_assets.generate([("ui.js", b"var a = 1;")],
+                                 "EXAMPLES_WEB_ASSETS_H_",
+                                 "tools/web_assets.py -o web_assets.h ui.js")
+    compressed = web_assets.compress(b"var a = 1;")
+    self.assertIn(
+        "// Copyright 2026 The IRremoteESP8266 authors\n"
+        "// The static files of the web app, gzip compressed. "
+        "See `web_asset_t`.\n"
+        "//\n"
+        "// WARNING: Do not edit this file! This file is automatically "
+        "generated by\n"
+        "//          'tools/web_assets.py'. Regenerate it whenever the files "
+        "change,\n"
+        "//          with:\n"
+        "//   tools/web_assets.py -o web_assets.h ui.js\n"
+        "\n"
+        "#ifndef EXAMPLES_WEB_ASSETS_H_\n"
+        "#define EXAMPLES_WEB_ASSETS_H_\n", output)
+    self.assertIn("// /ui.js: 10 bytes, %d compressed.\n"
+                  "const uint8_t kWebAsset0[] PROGMEM = {\n"
+                  "  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,"
+                  % len(compressed), output)
+    self.assertIn(
+        "const web_asset_t kWebAssets[] = {\n"
+        "  {\"/ui.js\", \"application/javascript\", \"%s\", kWebAsset0, "
+        "%d},\n"
+        "};\n"
+        "const uint8_t kWebAssetCount = "
+        "sizeof(kWebAssets) / sizeof(kWebAssets[0]);\n"
+        "\n"
+        "#endif  // EXAMPLES_WEB_ASSETS_H_\n" % (
+            web_assets.version(b"var a = 1;"), len(compressed)), output)
+    # Every byte is there.
+    hex_bytes = output.split("PROGMEM = {\n")[1].split("};")[0]
+    self.assertEqual(bytes(int(b, 16) for b in hex_bytes.replace(
+        ",", " ").split()), compressed)
+
+
+if __name__ == "__main__":
+  unittest.main(verbosity=2)